@@ -57,6 +57,27 @@ if (BUILD_NVJPEG2K)
   endif()
 endif ()
 
+# nvCOMP library, not a part of the CUDA toolkit
+if (BUILD_NVCOMP)
+  find_path(NVCOMP_INCLUDE_DIR nvcomp.h
+            PATHS ${NVCOMP_ROOT_DIR} "/usr/local" ${CMAKE_SYSTEM_PREFIX_PATH}
+            PATH_SUFFIXES include)
+  find_library(NVCOMP_LIBRARY
+               NAMES nvcomp
+               PATHS ${NVCOMP_ROOT_DIR} "/usr/local" ${CMAKE_SYSTEM_PREFIX_PATH}
+               PATH_SUFFIXES lib lib64)
+  if (${NVCOMP_LIBRARY} STREQUAL "NVCOMP_LIBRARY-NOTFOUND" OR
+      ${NVCOMP_INCLUDE_DIR} STREQUAL "NVCOMP_INCLUDE_DIR-NOTFOUND")
+    message(WARNING "nvCOMP not found - disabled. Try to specify it's location with `-DNVCOMP_ROOT_DIR`.")
+    set(BUILD_NVCOMP OFF CACHE BOOL INTERNAL)
+    set(BUILD_NVCOMP OFF)
+  else()
+    message(STATUS "Found nvCOMP: ${NVCOMP_LIBRARY}")
+    include_directories(SYSTEM ${NVCOMP_INCLUDE_DIR})
+    list(APPEND DALI_LIBS ${NVCOMP_LIBRARY})
+  endif()
+endif ()
+
 # NVIDIA NPP library
 if (NOT WITH_DYNAMIC_CUDA_TOOLKIT)
   CUDA_find_library(CUDA_nppicc_LIBRARY nppicc_static)
@@ -145,3 +166,18 @@ if(BUILD_NVOF)
 endif()
 
 include_directories(SYSTEM ${CMAKE_CUDA_TOOLKIT_INCLUDE_DIRECTORIES})
+
+##################################################################
+# cuFile batch API (available since GDS 1.4)
+##################################################################
+if(BUILD_CUFILE)
+  file(STRINGS "${CMAKE_CUDA_TOOLKIT_INCLUDE_DIRECTORIES}/cufile.h" CUFILE_BATCH_API
+       REGEX "cuFileBatchIOSubmit")
+  if(CUFILE_BATCH_API)
+    message(STATUS "cuFile batch API -- ON")
+    add_definitions(-DCUFILE_BATCH_API_ENABLED=1)
+  else()
+    message(STATUS "cuFile batch API -- OFF")
+    add_definitions(-DCUFILE_BATCH_API_ENABLED=0)
+  endif()
+endif()
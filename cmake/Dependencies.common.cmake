@@ -78,6 +78,26 @@ if (BUILD_LIBTIFF)
   list(APPEND DALI_LIBS ${TIFF_LIBRARY})
 endif()
 
+##################################################################
+# libwebp
+##################################################################
+if (BUILD_LIBWEBP)
+  find_package(PkgConfig REQUIRED)
+  pkg_check_modules(LIBWEBP REQUIRED libwebp)
+  include_directories(SYSTEM ${LIBWEBP_INCLUDE_DIRS})
+  message("Using libwebp at ${LIBWEBP_LINK_LIBRARIES}")
+  list(APPEND DALI_LIBS ${LIBWEBP_LINK_LIBRARIES})
+endif()
+
+##################################################################
+# libavif (built with dav1d for the AV1 decoding)
+##################################################################
+if (BUILD_LIBAVIF)
+  find_package(libavif 1.0 REQUIRED)
+  message("Using libavif ${libavif_VERSION}")
+  list(APPEND DALI_LIBS avif)
+endif()
+
 ##################################################################
 # PyBind
 ##################################################################
@@ -111,6 +131,16 @@ if(BUILD_LIBSND)
   list(APPEND DALI_LIBS ${libsnd_LIBS})
 endif()
 
+##################################################################
+# zlib
+##################################################################
+if(BUILD_ZLIB)
+  find_package(ZLIB REQUIRED)
+  message(STATUS "Found zlib: ${ZLIB_LIBRARIES}")
+  include_directories(SYSTEM ${ZLIB_INCLUDE_DIRS})
+  list(APPEND DALI_LIBS ${ZLIB_LIBRARIES})
+endif()
+
 ##################################################################
 # libtar
 ##################################################################
@@ -127,6 +157,15 @@ if(BUILD_LIBTAR)
   list(APPEND DALI_EXCLUDES libtar.a)
 endif()
 
+##################################################################
+# libcurl
+##################################################################
+if(BUILD_CURL)
+  find_package(CURL REQUIRED)
+  include_directories(SYSTEM ${CURL_INCLUDE_DIRS})
+  list(APPEND DALI_LIBS ${CURL_LIBRARIES})
+endif()
+
 
 ##################################################################
 # FFmpeg
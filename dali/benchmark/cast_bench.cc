@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <benchmark/benchmark.h>
+#include <vector>
 #include "dali/benchmark/operator_bench.h"
 #include "dali/benchmark/dali_bench.h"
 
@@ -40,4 +41,49 @@ BENCHMARK_REGISTER_F(OperatorBench, CastGPU)->Iterations(100)
   {500, 1000},
 });
 
+// Many tiny samples, e.g. labels or token ids
+BENCHMARK_DEFINE_F(OperatorBench, CastGPU_SmallSamples)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int sample_volume = st.range(1);
+
+  this->RunGPU<int32_t>(st,
+                        OpSpec("Cast")
+                          .AddArg("max_batch_size", batch_size)
+                          .AddArg("num_threads", 1)
+                          .AddArg("device", "gpu")
+                          .AddArg("dtype", DALI_INT64),
+                        batch_size, uniform_list_shape(batch_size, {1, 1, sample_volume}));
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, CastGPU_SmallSamples)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->ArgsProduct({
+  {256, 1024, 4096, 16384},
+  {1, 16, 256},
+});
+
+BENCHMARK_DEFINE_F(OperatorBench, LookupTableGPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int sample_volume = st.range(1);
+
+  this->RunGPU<uint8_t>(st,
+                        OpSpec("LookupTable")
+                          .AddArg("max_batch_size", batch_size)
+                          .AddArg("num_threads", 1)
+                          .AddArg("device", "gpu")
+                          .AddArg("dtype", DALI_FLOAT)
+                          .AddArg("keys", std::vector<int>{0, 1, 2, 3})
+                          .AddArg("values", std::vector<float>{0.5f, 1.5f, 2.5f, 3.5f}),
+                        batch_size, uniform_list_shape(batch_size, {1, 1, sample_volume}));
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, LookupTableGPU)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->ArgsProduct({
+  {16, 256, 4096},
+  {1, 1000, 1000000},
+});
+
 }  // namespace dali
@@ -0,0 +1,108 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "dali/benchmark/dali_bench.h"
+#include "dali/benchmark/operator_bench.h"
+#include "dali/kernels/imgproc/color_manipulation/color_transform_cpu.h"
+
+namespace dali {
+
+namespace {
+
+const mat3 kRgbToYCbCr = {{{0.299f, 0.587f, 0.114f},
+                           {-0.16873589f, -0.33126411f, 0.5f},
+                           {0.5f, -0.41868759f, -0.08131241f}}};
+const vec3 kYCbCrOffset(0, 128, 128);
+
+template <typename Out, typename In, bool vectorized>
+void BM_TransformPixels3(benchmark::State &st) {
+  int64_t npixels = st.range(0);
+  std::vector<In> in(npixels * 3);
+  std::vector<Out> out(npixels * 3);
+  std::mt19937 rng(123);
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (auto &x : in)
+    x = dist(rng);
+
+  for (auto _ : st) {
+    if (vectorized) {
+      kernels::color::TransformPixels3(out.data(), in.data(), npixels, kRgbToYCbCr, kYCbCrOffset);
+    } else {
+      for (int64_t i = 0; i < npixels; i++)
+        kernels::color::detail::TransformPixel3(&out[i * 3], &in[i * 3], kRgbToYCbCr,
+                                                kYCbCrOffset);
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  st.SetBytesProcessed(st.iterations() * npixels * 3 * (sizeof(In) + sizeof(Out)));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_TransformPixels3, uint8_t, uint8_t, false)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_TransformPixels3, uint8_t, uint8_t, true)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_TransformPixels3, float, uint8_t, false)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_TransformPixels3, float, uint8_t, true)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_TransformPixels3, float, float, false)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_TransformPixels3, float, float, true)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_DEFINE_F(OperatorBench, ColorSpaceConversionCPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int H = st.range(1);
+  int W = st.range(1);
+  int C = 3;
+
+  this->RunCPU<uint8_t>(
+    st,
+    OpSpec("ColorSpaceConversion")
+      .AddArg("max_batch_size", batch_size)
+      .AddArg("num_threads", 1)
+      .AddArg("device", "cpu")
+      .AddArg("image_type", DALI_RGB)
+      .AddArg("output_type", DALI_YCbCr),
+    batch_size, H, W, C, true, 1);
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, ColorSpaceConversionCPU)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Ranges({{1, 32}, {128, 1024}});
+
+BENCHMARK_DEFINE_F(OperatorBench, HsvCPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int H = st.range(1);
+  int W = st.range(1);
+  int C = 3;
+
+  this->RunCPU<uint8_t>(
+    st,
+    OpSpec("Hsv")
+      .AddArg("max_batch_size", batch_size)
+      .AddArg("num_threads", 1)
+      .AddArg("device", "cpu")
+      .AddArg("hue", 10.f)
+      .AddArg("saturation", 1.2f)
+      .AddArg("value", 0.9f),
+    batch_size, H, W, C, true, 1);
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, HsvCPU)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Ranges({{1, 32}, {128, 1024}});
+
+}  // namespace dali
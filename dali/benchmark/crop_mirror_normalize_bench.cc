@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,7 +21,7 @@ namespace dali {
 static void CropMirrorNormalizeCPUArgs(benchmark::internal::Benchmark *b) {
   int batch_size = 8;
   int mean = 128, std = 1;
-  for (auto &dtype : {DALI_FLOAT}) {
+  for (auto &dtype : {DALI_FLOAT, DALI_FLOAT16}) {
     for (auto nchw : {0, 1}) {
       for (int mirror : {0, 1}) {
         for (int pad : {0, 1}) {
@@ -0,0 +1,69 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include "dali/benchmark/operator_bench.h"
+#include "dali/benchmark/dali_bench.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Runs a displacement filter (Water, Sphere, Jitter) on a batch of HWC images of type T
+ *
+ * The arguments are: batch size, image size (height and width) and the interpolation type.
+ */
+template <typename T>
+void DisplacementGPU(OperatorBench &bench, benchmark::State &st, const std::string &op_name) {
+  int batch_size = st.range(0);
+  int size = st.range(1);
+  auto interp_type = static_cast<DALIInterpType>(st.range(2));
+
+  bench.RunGPU<T>(st,
+                  OpSpec(op_name)
+                    .AddArg("max_batch_size", batch_size)
+                    .AddArg("num_threads", 1)
+                    .AddArg("device", "gpu")
+                    .AddArg("interp_type", interp_type),
+                  batch_size, size, size);
+}
+
+}  // namespace
+
+#define DALI_BENCHMARK_DISPLACEMENT_GPU(OP_NAME, TYPE)                          \
+BENCHMARK_DEFINE_F(OperatorBench, OP_NAME##GPU_##TYPE)(benchmark::State& st) {  \
+  DisplacementGPU<TYPE>(*this, st, #OP_NAME);                                   \
+}                                                                               \
+BENCHMARK_REGISTER_F(OperatorBench, OP_NAME##GPU_##TYPE)->Iterations(100)       \
+->Unit(benchmark::kMicrosecond)                                                 \
+->UseRealTime()                                                                 \
+->ArgsProduct({                                                                 \
+  {1, 16, 128},                                                                 \
+  {256, 1024},                                                                  \
+  {DALI_INTERP_NN, DALI_INTERP_LINEAR},                                         \
+});
+
+DALI_BENCHMARK_DISPLACEMENT_GPU(Water, uint8_t)
+DALI_BENCHMARK_DISPLACEMENT_GPU(Water, float)
+DALI_BENCHMARK_DISPLACEMENT_GPU(Water, float16)
+DALI_BENCHMARK_DISPLACEMENT_GPU(Sphere, uint8_t)
+DALI_BENCHMARK_DISPLACEMENT_GPU(Sphere, float)
+DALI_BENCHMARK_DISPLACEMENT_GPU(Sphere, float16)
+DALI_BENCHMARK_DISPLACEMENT_GPU(Jitter, uint8_t)
+DALI_BENCHMARK_DISPLACEMENT_GPU(Jitter, float)
+DALI_BENCHMARK_DISPLACEMENT_GPU(Jitter, float16)
+
+}  // namespace dali
@@ -0,0 +1,113 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/benchmark/dali_bench.h"
+#include "dali/core/cuda_error.h"
+#include "dali/pipeline/pipeline.h"
+
+namespace dali {
+
+class LowLatency : public DALIBenchmark {
+};
+
+/**
+ * @brief Measures the time from feeding a batch to having the results on the GPU,
+ *        one batch at a time, as in online inference.
+ *
+ * Executors: 0 - simple, 1 - asynchronous pipelined, 2 - low latency.
+ */
+BENCHMARK_DEFINE_F(LowLatency, Iteration)(benchmark::State& st) { // NOLINT
+  int executor = st.range(0);
+  int batch_size = st.range(1);
+  int num_thread = st.range(2);
+  bool async = executor == 1;
+
+  Pipeline pipe(batch_size, num_thread, 0, -1, async, 1, async);
+  if (executor == 2)
+    pipe.SetExecutionTypes(false, false, false, false, true);
+
+  TensorList<CPUBackend> data;
+  data.Resize(uniform_list_shape(batch_size, {224, 224, 3}), DALI_UINT8);
+  for (int i = 0; i < batch_size; i++)
+    std::memset(data.mutable_tensor<uint8_t>(i), i, 224 * 224 * 3);
+  data.SetLayout("HWC");
+  pipe.AddExternalInput("data");
+
+  pipe.AddOperator(
+      OpSpec("Flip")
+      .AddArg("device", "cpu")
+      .AddArg("horizontal", 1)
+      .AddInput("data", "cpu")
+      .AddOutput("flipped", "cpu"));
+
+  pipe.AddOperator(
+      OpSpec("CropMirrorNormalize")
+      .AddArg("device", "gpu")
+      .AddArg("dtype", DALI_FLOAT)
+      .AddArg("crop", vector<float>{200, 200})
+      .AddArg("mean", vector<float>{128, 128, 128})
+      .AddArg("std", vector<float>{64, 64, 64})
+      .AddInput("flipped", "gpu")
+      .AddOutput("normalized", "gpu"));
+
+  pipe.AddOperator(
+      OpSpec("Cast")
+      .AddArg("device", "gpu")
+      .AddArg("dtype", DALI_FLOAT16)
+      .AddInput("normalized", "gpu")
+      .AddOutput("out", "gpu"));
+
+  vector<std::pair<string, string>> outputs = {{"out", "gpu"}};
+  pipe.Build(outputs);
+
+  DeviceWorkspace ws;
+  auto run_once = [&]() {
+    pipe.SetExternalInput("data", data);
+    pipe.RunCPU();
+    pipe.RunGPU();
+    pipe.Outputs(&ws);
+    CUDA_CALL(cudaDeviceSynchronize());
+  };
+
+  // Warm up, so that the memory is allocated
+  for (int i = 0; i < 3; i++)
+    run_once();
+
+  for (auto _ : st)
+    run_once();
+
+  st.counters["FPS"] = benchmark::Counter(batch_size * st.iterations(),
+                                          benchmark::Counter::kIsRate);
+}
+
+static void LowLatencyArgs(benchmark::internal::Benchmark *b) {
+  for (int executor = 0; executor < 3; executor++) {
+    for (int batch_size = 1; batch_size <= 4; batch_size *= 2) {
+      b->Args({executor, batch_size, 2});
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(LowLatency, Iteration)->Iterations(1000)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(LowLatencyArgs);
+
+}  // namespace dali
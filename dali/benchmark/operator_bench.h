@@ -16,14 +16,97 @@
 #define DALI_BENCHMARK_OPERATOR_BENCH_H_
 
 #include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <memory>
+#include <random>
 #include <vector>
 #include "dali/benchmark/dali_bench.h"
+#include "dali/core/cuda_error.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/pipeline/operator/operator.h"
 
 namespace dali {
 
+/**
+ * @brief Distribution of the sample shapes in a benchmarked batch
+ */
+enum class ShapeDistribution : int {
+  Constant = 0,   ///< all samples have the maximum shape
+  Uniform = 1,    ///< the extents are uniformly distributed between 1/4 and all of the maximum
+  LogNormal = 2,  ///< the extents are log-normally distributed, with a median of a half
+};
+
+/**
+ * @brief Generates the shapes of a batch with given distribution
+ *
+ * The first `varying_dims` extents of each sample are drawn from the distribution, scaled
+ * to the extents of `max_shape`; the remaining ones (e.g. the channels) are kept.
+ * The shapes are deterministic for given arguments.
+ */
+inline TensorListShape<> RandomListShape(int batch_size, const TensorShape<> &max_shape,
+                                         ShapeDistribution dist, int varying_dims = 2,
+                                         int seed = 4321) {
+  TensorListShape<> shape = uniform_list_shape(batch_size, max_shape);
+  if (dist == ShapeDistribution::Constant)
+    return shape;
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<float> uniform(0.25f, 1.0f);
+  std::lognormal_distribution<float> lognormal(std::log(0.5f), 0.5f);
+  for (int i = 0; i < batch_size; i++) {
+    auto sample_shape = shape.tensor_shape_span(i);
+    for (int d = 0; d < varying_dims; d++) {
+      float scale = dist == ShapeDistribution::Uniform ? uniform(rng) : lognormal(rng);
+      int64_t extent = std::lround(max_shape[d] * std::min(scale, 1.0f));
+      sample_shape[d] = std::max<int64_t>(extent, 1);
+    }
+  }
+  return shape;
+}
+
+/**
+ * @brief The theoretical peak memory bandwidth and FP32 throughput of a device
+ */
+struct DevicePeak {
+  double bytes_per_s = 0;
+  double flops = 0;
+
+  static DevicePeak Get(int device_id) {
+    int mem_clock_khz = 0, bus_width = 0, clock_khz = 0, sm_count = 0, major = 0, minor = 0;
+    CUDA_CALL(cudaDeviceGetAttribute(&mem_clock_khz, cudaDevAttrMemoryClockRate, device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&bus_width, cudaDevAttrGlobalMemoryBusWidth, device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&clock_khz, cudaDevAttrClockRate, device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&sm_count, cudaDevAttrMultiProcessorCount, device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&major, cudaDevAttrComputeCapabilityMajor, device_id));
+    CUDA_CALL(cudaDeviceGetAttribute(&minor, cudaDevAttrComputeCapabilityMinor, device_id));
+    DevicePeak peak;
+    // double data rate
+    peak.bytes_per_s = 2.0 * mem_clock_khz * 1e3 * bus_width / 8;
+    // a fused multiply-add counts as 2 operations
+    peak.flops = 2.0 * clock_khz * 1e3 * sm_count * Fp32CoresPerSM(major, minor);
+    return peak;
+  }
+
+ private:
+  static int Fp32CoresPerSM(int major, int minor) {
+    switch (major) {
+      case 3:
+        return 192;
+      case 5:
+        return 128;
+      case 6:
+        return minor == 0 ? 64 : 128;
+      case 7:
+        return 64;
+      case 8:
+        return minor == 0 ? 64 : 128;
+      default:
+        return 128;
+    }
+  }
+};
+
 class OperatorBench : public DALIBenchmark {
  public:
   template <typename OutputContainer, typename OperatorPtr, typename Workspace>
@@ -118,6 +201,7 @@ class OperatorBench : public DALIBenchmark {
 
     int64_t batches = 0;
 
+    auto start = std::chrono::steady_clock::now();
     while (st.KeepRunning()) {
       op_ptr->Run(ws);
       batches++;
@@ -126,8 +210,56 @@ class OperatorBench : public DALIBenchmark {
         CUDA_CALL(cudaStreamSynchronize(0));
       }
     }
+    CUDA_CALL(cudaStreamSynchronize(0));
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
     st.counters["FPS"] = benchmark::Counter(batch_size * st.iterations(),
                                             benchmark::Counter::kIsRate);
+
+    last_run_ = {};
+    last_run_.seconds = elapsed.count();
+    last_run_.batches = batches;
+    last_run_.in_elements = data_in_gpu->shape().num_elements();
+    last_run_.bytes = last_run_.in_elements * data_in_gpu->type_info().size();
+    for (int i = 0; i < ws.NumOutput(); i++) {
+      const auto &out = ws.template Output<GPUBackend>(i);
+      last_run_.out_elements += out.shape().num_elements();
+      last_run_.bytes += out.shape().num_elements() * out.type_info().size();
+    }
+    ReportRoofline(st, 0);
+  }
+
+  /**
+   * @brief Reports the throughput of the last `RunGPU` against the device peak
+   *
+   * The memory traffic is estimated as reading the inputs and writing the outputs once,
+   * which is the minimum for an operator that is not compute-bound. The counters are:
+   *  - GB/s, %peak_BW - achieved bandwidth
+   *  - GFLOP/s, %peak_FLOPS - achieved FP32 throughput, if the number of operations is given
+   *
+   * `RunGPU` reports the bandwidth; benchmarks call this again to add the FLOPs.
+   *
+   * @param flops_per_output  number of arithmetic operations per output element
+   * @param flops_per_input   number of arithmetic operations per input element
+   */
+  void ReportRoofline(benchmark::State &st, double flops_per_output,
+                      double flops_per_input = 0) {
+    if (last_run_.seconds <= 0)
+      return;
+    if (peak_.bytes_per_s == 0) {
+      int device_id = 0;
+      CUDA_CALL(cudaGetDevice(&device_id));
+      peak_ = DevicePeak::Get(device_id);
+    }
+    double bytes_per_s = last_run_.bytes * last_run_.batches / last_run_.seconds;
+    st.counters["GB/s"] = bytes_per_s * 1e-9;
+    st.counters["%peak_BW"] = 100 * bytes_per_s / peak_.bytes_per_s;
+    double flops_per_batch = flops_per_output * last_run_.out_elements +
+                             flops_per_input * last_run_.in_elements;
+    if (flops_per_batch > 0) {
+      double flops = flops_per_batch * last_run_.batches / last_run_.seconds;
+      st.counters["GFLOP/s"] = flops * 1e-9;
+      st.counters["%peak_FLOPS"] = 100 * flops / peak_.flops;
+    }
   }
 
   template <typename T>
@@ -144,6 +276,17 @@ class OperatorBench : public DALIBenchmark {
               bool fill_in_data = false, int64_t sync_each_n = -1) {
     RunGPU<T>(st, op_spec, batch_size, {H, W, C}, "HWC", fill_in_data, sync_each_n);
   }
+
+ private:
+  struct RunStats {
+    double seconds = 0;
+    int64_t batches = 0;
+    int64_t bytes = 0;
+    int64_t in_elements = 0;
+    int64_t out_elements = 0;
+  };
+  RunStats last_run_;
+  DevicePeak peak_;
 };
 
 }  // namespace dali
@@ -0,0 +1,190 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "dali/benchmark/operator_bench.h"
+#include "dali/benchmark/dali_bench.h"
+
+/**
+ * Batch-shape sweeps of the kernel-heavy GPU operators.
+ *
+ * Each benchmark runs over batch sizes and sample shape distributions (see ShapeDistribution)
+ * and reports the achieved bandwidth and FP32 throughput against the device peak, to show how
+ * far the kernels are from the roofline. The numbers of operations are per output element
+ * (unless noted otherwise), counting only the arithmetic of the algorithm - e.g. the taps of
+ * a filter - and not the indexing.
+ */
+
+namespace dali {
+
+namespace {
+
+const char *kDistNames[] = {"constant", "uniform", "lognormal"};
+
+void SweepArgs(benchmark::internal::Benchmark *b) {
+  for (int batch_size : {256, 64, 16, 1}) {
+    for (int dist = 0; dist < 3; dist++) {
+      b->Args({batch_size, dist});
+    }
+  }
+}
+
+/// Full HD images, HWC
+TensorListShape<> ImageShapes(const benchmark::State &st) {
+  return RandomListShape(st.range(0), {1080, 1920, 3}, static_cast<ShapeDistribution>(st.range(1)));
+}
+
+OpSpec GPUSpec(const std::string &name, int batch_size) {
+  return OpSpec(name)
+      .AddArg("max_batch_size", batch_size)
+      .AddArg("num_threads", 1)
+      .AddArg("device", "gpu");
+}
+
+}  // namespace
+
+#define DALI_REGISTER_SWEEP(name) \
+  BENCHMARK_REGISTER_F(OperatorBench, name)->Iterations(100) \
+  ->Unit(benchmark::kMicrosecond) \
+  ->UseRealTime() \
+  ->Apply(SweepArgs)
+
+BENCHMARK_DEFINE_F(OperatorBench, ResizeSweepGPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  this->RunGPU<uint8_t>(
+    st,
+    GPUSpec("Resize", batch_size)
+      .AddArg("resize_x", 640.0f)
+      .AddArg("resize_y", 480.0f)
+      .AddArg("antialias", false),
+    batch_size, ImageShapes(st), "HWC");
+  // separable linear filter: 2 taps in each of the 2 passes
+  this->ReportRoofline(st, 8);
+  st.SetLabel(kDistNames[st.range(1)]);
+}
+
+DALI_REGISTER_SWEEP(ResizeSweepGPU);
+
+BENCHMARK_DEFINE_F(OperatorBench, WarpAffineSweepGPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  std::vector<float> mtx = {
+    1.1f, 0.2f, -10.0f,
+    -0.15f, 0.9f, 5.0f
+  };
+  this->RunGPU<uint8_t>(
+    st,
+    GPUSpec("WarpAffine", batch_size)
+      .AddArg("matrix", mtx)
+      .AddArg("fill_value", 42),
+    batch_size, ImageShapes(st), "HWC");
+  // bilinear interpolation: 4 taps
+  this->ReportRoofline(st, 8);
+  st.SetLabel(kDistNames[st.range(1)]);
+}
+
+DALI_REGISTER_SWEEP(WarpAffineSweepGPU);
+
+BENCHMARK_DEFINE_F(OperatorBench, SliceSweepGPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  this->RunGPU<uint8_t>(
+    st,
+    GPUSpec("Slice", batch_size)
+      .AddArg("axes", std::vector<int>{0, 1})
+      .AddArg("rel_start", std::vector<float>{0.1f, 0.1f})
+      .AddArg("rel_shape", std::vector<float>{0.8f, 0.8f}),
+    batch_size, ImageShapes(st), "HWC");
+  st.SetLabel(kDistNames[st.range(1)]);
+}
+
+DALI_REGISTER_SWEEP(SliceSweepGPU);
+
+BENCHMARK_DEFINE_F(OperatorBench, TransposeSweepGPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  this->RunGPU<uint8_t>(
+    st,
+    GPUSpec("Transpose", batch_size)
+      .AddArg("perm", std::vector<int>{2, 0, 1}),
+    batch_size, ImageShapes(st), "HWC");
+  st.SetLabel(kDistNames[st.range(1)]);
+}
+
+DALI_REGISTER_SWEEP(TransposeSweepGPU);
+
+BENCHMARK_DEFINE_F(OperatorBench, ReduceSumSweepGPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  this->RunGPU<uint8_t>(
+    st,
+    GPUSpec("reductions__Sum", batch_size)
+      .AddArg("axes", std::vector<int>{0, 1}),
+    batch_size, ImageShapes(st), "HWC");
+  // one addition per input element
+  this->ReportRoofline(st, 0, 1);
+  st.SetLabel(kDistNames[st.range(1)]);
+}
+
+DALI_REGISTER_SWEEP(ReduceSumSweepGPU);
+
+BENCHMARK_DEFINE_F(OperatorBench, ArithmeticSweepGPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  this->RunGPU<uint8_t>(
+    st,
+    GPUSpec("ArithmeticGenericOp", batch_size)
+      .AddArg("expression_desc", std::string("add(mul(&0 $0:float32) $1:float32)"))
+      .AddArg("real_constants", std::vector<float>{0.5f, 1.0f}),
+    batch_size, ImageShapes(st), "HWC");
+  this->ReportRoofline(st, 2);
+  st.SetLabel(kDistNames[st.range(1)]);
+}
+
+DALI_REGISTER_SWEEP(ArithmeticSweepGPU);
+
+BENCHMARK_DEFINE_F(OperatorBench, GaussianBlurSweepGPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  const int window_size = 7;
+  this->RunGPU<uint8_t>(
+    st,
+    GPUSpec("GaussianBlur", batch_size)
+      .AddArg("window_size", window_size)
+      .AddArg("sigma", 1.5f),
+    batch_size, ImageShapes(st), "HWC");
+  // separable convolution: a multiply-add per tap in each of the 2 passes
+  this->ReportRoofline(st, 2 * 2 * window_size);
+  st.SetLabel(kDistNames[st.range(1)]);
+}
+
+DALI_REGISTER_SWEEP(GaussianBlurSweepGPU);
+
+BENCHMARK_DEFINE_F(OperatorBench, SpectrogramSweepGPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  const int nfft = 512;
+  // 10 s of 16 kHz audio
+  auto shape = RandomListShape(batch_size, {160000}, static_cast<ShapeDistribution>(st.range(1)),
+                               1);
+  this->RunGPU<float>(
+    st,
+    GPUSpec("Spectrogram", batch_size)
+      .AddArg("nfft", nfft)
+      .AddArg("window_length", 400)
+      .AddArg("window_step", 160),
+    batch_size, shape, "t");
+  // 5 N log2(N) per real FFT of N = nfft, over nfft / 2 + 1 output bins, and the power (3)
+  this->ReportRoofline(st, 5.0 * nfft * std::log2(nfft) / (nfft / 2 + 1) + 3);
+  st.SetLabel(kDistNames[st.range(1)]);
+}
+
+DALI_REGISTER_SWEEP(SpectrogramSweepGPU);
+
+}  // namespace dali
@@ -0,0 +1,451 @@
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+"""End-to-end pipeline benchmarks over reproducible synthetic datasets.
+
+Runs the canonical pipelines - RN50 training (``rn50``), SSD detection (``ssd``), speech
+recognition front-end (``asr``) and video classification (``video``) - and reports the
+throughput, the iteration latency percentiles, the number of CPU cores used and the peak GPU
+memory usage as JSON, so that the results of different DALI versions can be compared.
+
+The datasets are generated in ``--data_dir`` from ``--seed`` and the size distribution
+arguments. A dataset is reused as long as its generation parameters match.
+
+Example::
+
+    python pipeline_bench.py --pipelines rn50 ssd -b 128 -j 8 --output results.json
+"""
+
+import argparse
+import json
+import os
+import resource
+import subprocess
+import shutil
+import tempfile
+import threading
+import time
+import wave
+from math import sqrt
+
+import numpy as np
+import nvidia.dali as dali
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+from nvidia.dali.pipeline import pipeline_def
+
+ALL_PIPELINES = ['rn50', 'ssd', 'asr', 'video']
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description='DALI end-to-end pipeline benchmark')
+    parser.add_argument('--pipelines', nargs='+', choices=ALL_PIPELINES, default=ALL_PIPELINES,
+                        help='pipelines to run')
+    parser.add_argument('-b', dest='batch_size', default=64, type=int, help='batch size')
+    parser.add_argument('-j', dest='num_threads', default=4, type=int, help='number of threads')
+    parser.add_argument('-d', dest='device_id', default=0, type=int, help='device id')
+    parser.add_argument('-i', dest='iterations', default=100, type=int,
+                        help='number of measured iterations')
+    parser.add_argument('-w', dest='warmup', default=10, type=int,
+                        help='number of warmup iterations')
+    parser.add_argument('--data_dir',
+                        default=os.path.join(tempfile.gettempdir(), 'dali_bench_data'),
+                        help='directory where the synthetic datasets are stored')
+    parser.add_argument('--seed', default=1234, type=int,
+                        help='seed of the dataset generation and of the pipelines')
+    parser.add_argument('--num_samples', default=1000, type=int,
+                        help='number of samples in the image and audio datasets')
+    parser.add_argument('--num_videos', default=16, type=int,
+                        help='number of files in the video dataset')
+    parser.add_argument('--size_dist', choices=['uniform', 'lognormal'], default='uniform',
+                        help='distribution of the sample sizes between the given bounds')
+    parser.add_argument('--image_size', nargs=2, default=[256, 1024], type=int,
+                        help='range of the image width and height, in pixels')
+    parser.add_argument('--audio_length', nargs=2, default=[2.0, 16.0], type=float,
+                        help='range of the audio duration, in seconds')
+    parser.add_argument('--video_frames', nargs=2, default=[64, 256], type=int,
+                        help='range of the number of frames of the videos')
+    parser.add_argument('--video_size', nargs=2, default=[320, 240], type=int,
+                        help='width and height of the videos')
+    parser.add_argument('--output', default=None,
+                        help='path of the JSON report; printed to stdout if not given')
+    return parser.parse_args()
+
+
+# Synthetic datasets ###############################################################################
+
+
+def draw_sizes(rng, n, lo, hi, dist):
+    """Draws `n` sizes in the range [lo, hi]"""
+    if dist == 'uniform':
+        sizes = rng.uniform(lo, hi, size=n)
+    else:
+        # centered in the log domain, so that 95% of the values fall within the range
+        mu, sigma = (np.log(lo) + np.log(hi)) / 2, (np.log(hi) - np.log(lo)) / 4
+        sizes = np.clip(rng.lognormal(mu, sigma, size=n), lo, hi)
+    return sizes
+
+
+def synthetic_image(rng, w, h):
+    """Smooth color gradients with noise - compresses like a natural image, unlike pure noise"""
+    y, x = np.mgrid[0:h, 0:w].astype(np.float32)
+    img = np.empty((h, w, 3), dtype=np.float32)
+    for c in range(3):
+        fx, fy, phase = rng.uniform(0.002, 0.05), rng.uniform(0.002, 0.05), rng.uniform(0, 6.3)
+        img[:, :, c] = 127.5 + 100 * np.sin(fx * x + fy * y + phase)
+    img += rng.normal(0, 8, size=img.shape)
+    return np.clip(img, 0, 255).astype(np.uint8)
+
+
+def encode_jpeg(img, path):
+    try:
+        import cv2
+        cv2.imwrite(path, img[:, :, ::-1], [int(cv2.IMWRITE_JPEG_QUALITY), 90])
+    except ImportError:
+        from PIL import Image
+        Image.fromarray(img).save(path, quality=90)
+
+
+def dataset_dir(args, name, params):
+    """Returns the dataset directory and whether the dataset needs to be (re)generated"""
+    path = os.path.join(args.data_dir, name)
+    manifest = os.path.join(path, 'dataset.json')
+    if os.path.exists(manifest):
+        with open(manifest) as f:
+            if json.load(f) == params:
+                return path, False
+        shutil.rmtree(path)
+    os.makedirs(path)
+    return path, True
+
+
+def write_manifest(path, params):
+    with open(os.path.join(path, 'dataset.json'), 'w') as f:
+        json.dump(params, f)
+
+
+def make_image_dataset(args, with_boxes):
+    params = {'kind': 'images', 'seed': args.seed, 'num_samples': args.num_samples,
+              'size': args.image_size, 'dist': args.size_dist, 'boxes': with_boxes}
+    name = 'coco' if with_boxes else 'imagenet'
+    path, generate = dataset_dir(args, name, params)
+    if not generate:
+        return path
+    rng = np.random.default_rng(args.seed)
+    widths = draw_sizes(rng, args.num_samples, *args.image_size, args.size_dist).astype(int)
+    heights = draw_sizes(rng, args.num_samples, *args.image_size, args.size_dist).astype(int)
+    images, annotations = [], []
+    for i in range(args.num_samples):
+        w, h = int(widths[i]), int(heights[i])
+        # 10 classes, as subdirectories, for the file reader
+        rel_path = os.path.join(str(i % 10), f'{i:07d}.jpg')
+        os.makedirs(os.path.join(path, str(i % 10)), exist_ok=True)
+        encode_jpeg(synthetic_image(rng, w, h), os.path.join(path, rel_path))
+        images.append({'id': i, 'file_name': rel_path, 'width': w, 'height': h})
+        for _ in range(rng.integers(1, 11) if with_boxes else 0):
+            bw, bh = rng.uniform(0.05, 0.5) * w, rng.uniform(0.05, 0.5) * h
+            x, y = rng.uniform(0, w - bw), rng.uniform(0, h - bh)
+            annotations.append({'id': len(annotations), 'image_id': i,
+                                'category_id': int(rng.integers(1, 81)),
+                                'bbox': [x, y, bw, bh], 'area': bw * bh, 'iscrowd': 0})
+    if with_boxes:
+        coco = {'images': images, 'annotations': annotations,
+                'categories': [{'id': k, 'name': str(k)} for k in range(1, 81)]}
+        with open(os.path.join(path, 'annotations.json'), 'w') as f:
+            json.dump(coco, f)
+    write_manifest(path, params)
+    return path
+
+
+def make_audio_dataset(args):
+    params = {'kind': 'audio', 'seed': args.seed, 'num_samples': args.num_samples,
+              'length': args.audio_length, 'dist': args.size_dist}
+    path, generate = dataset_dir(args, 'audio', params)
+    if not generate:
+        return path
+    rng = np.random.default_rng(args.seed)
+    sample_rate = 16000
+    lengths = draw_sizes(rng, args.num_samples, *args.audio_length, args.size_dist)
+    with open(os.path.join(path, 'file_list.txt'), 'w') as file_list:
+        for i, length in enumerate(lengths):
+            t = np.arange(int(length * sample_rate)) / sample_rate
+            # a few tones with a slowly varying amplitude and noise
+            signal = sum(rng.uniform(0.05, 0.2) * np.sin(2 * np.pi * rng.uniform(100, 4000) * t)
+                         for _ in range(4))
+            signal *= 0.5 + 0.5 * np.sin(2 * np.pi * rng.uniform(0.2, 2) * t)
+            signal += rng.normal(0, 0.02, size=t.shape)
+            name = f'{i:07d}.wav'
+            with wave.open(os.path.join(path, name), 'wb') as f:
+                f.setnchannels(1)
+                f.setsampwidth(2)
+                f.setframerate(sample_rate)
+                f.writeframes((np.clip(signal, -1, 1) * 32767).astype('<i2').tobytes())
+            file_list.write(f'{name} {i % 10}\n')
+    write_manifest(path, params)
+    return path
+
+
+def make_video_dataset(args):
+    """Generates H.264 videos with ffmpeg; returns None if ffmpeg is not available"""
+    if shutil.which('ffmpeg') is None:
+        return None
+    params = {'kind': 'video', 'seed': args.seed, 'num_videos': args.num_videos,
+              'frames': args.video_frames, 'size': args.video_size, 'dist': args.size_dist}
+    path, generate = dataset_dir(args, 'video', params)
+    if not generate:
+        return path
+    rng = np.random.default_rng(args.seed)
+    frames = draw_sizes(rng, args.num_videos, *args.video_frames, args.size_dist).astype(int)
+    w, h = args.video_size
+    for i, n in enumerate(frames):
+        # the test pattern is animated, so the frames are not trivially compressible
+        source = f'testsrc2=size={w}x{h}:rate=25,noise=alls={int(rng.integers(5, 30))}:allf=t'
+        subprocess.run(['ffmpeg', '-loglevel', 'error', '-y', '-f', 'lavfi', '-i', source,
+                        '-frames:v', str(n), '-c:v', 'libx264', '-pix_fmt', 'yuv420p',
+                        '-g', '25', os.path.join(path, f'{i:05d}.mp4')], check=True)
+    write_manifest(path, params)
+    return path
+
+
+# Pipelines ########################################################################################
+
+
+def pipe_kwargs(args):
+    return {'batch_size': args.batch_size, 'num_threads': args.num_threads,
+            'device_id': args.device_id, 'seed': args.seed, 'prefetch_queue_depth': 2,
+            'enable_memory_stats': True}
+
+
+def rn50_pipeline(args, data_dir):
+    @pipeline_def(**pipe_kwargs(args))
+    def pipe():
+        jpegs, labels = fn.readers.file(file_root=data_dir, random_shuffle=True, name='Reader')
+        images = fn.decoders.image_random_crop(jpegs, device='mixed', output_type=types.RGB)
+        images = fn.resize(images, resize_x=224, resize_y=224)
+        images = fn.crop_mirror_normalize(images, dtype=types.FLOAT16, output_layout='CHW',
+                                          crop=(224, 224),
+                                          mean=[0.485 * 255, 0.456 * 255, 0.406 * 255],
+                                          std=[0.229 * 255, 0.224 * 255, 0.225 * 255],
+                                          mirror=fn.random.coin_flip(probability=0.5))
+        return images, labels.gpu()
+    return pipe()
+
+
+def ssd_anchors():
+    # the default boxes of SSD300
+    fig_size, feat_sizes = 300, [38, 19, 10, 5, 3, 1]
+    steps = [8., 16., 32., 64., 100., 300.]
+    scales = [21., 45., 99., 153., 207., 261., 315.]
+    aspect_ratios = [[2], [2, 3], [2, 3], [2, 3], [2], [2]]
+    anchors = []
+    for idx, feat_size in enumerate(feat_sizes):
+        sk1, sk2 = scales[idx] / fig_size, scales[idx + 1] / fig_size
+        sizes = [[sk1, sk1], [sqrt(sk1 * sk2)] * 2]
+        for alpha in aspect_ratios[idx]:
+            w, h = sk1 * sqrt(alpha), sk1 / sqrt(alpha)
+            sizes += [[w, h], [h, w]]
+        fk = fig_size / steps[idx]
+        for i in range(feat_size):
+            for j in range(feat_size):
+                for w, h in sizes:
+                    cx, cy = (j + 0.5) / fk, (i + 0.5) / fk
+                    anchors += [min(max(v, 0), 1) for v in (cx - w / 2, cy - h / 2,
+                                                            cx + w / 2, cy + h / 2)]
+    return anchors
+
+
+def ssd_pipeline(args, data_dir):
+    anchors = ssd_anchors()
+
+    @pipeline_def(**pipe_kwargs(args))
+    def pipe():
+        jpegs, boxes, labels = fn.readers.coco(
+            file_root=data_dir, annotations_file=os.path.join(data_dir, 'annotations.json'),
+            ratio=True, ltrb=True, skip_empty=True, random_shuffle=True, name='Reader')
+        crop_begin, crop_size, boxes, labels = fn.random_bbox_crop(
+            boxes, labels, bbox_layout='xyXY', allow_no_crop=True, num_attempts=50,
+            thresholds=[0, 0.1, 0.3, 0.5, 0.7, 0.9], scaling=[0.3, 1.0],
+            aspect_ratio=[0.5, 2.0])
+        images = fn.decoders.image_slice(jpegs, crop_begin, crop_size, device='mixed',
+                                         output_type=types.RGB)
+        flip = fn.random.coin_flip(probability=0.5)
+        boxes = fn.bb_flip(boxes, ltrb=True, horizontal=flip)
+        images = fn.resize(images, resize_x=300, resize_y=300)
+        images = fn.hsv(images, hue=fn.random.uniform(range=[-0.05, 0.05]) * 180,
+                        saturation=fn.random.uniform(range=[0.5, 1.5]))
+        images = fn.brightness_contrast(images, brightness=fn.random.uniform(range=[0.875, 1.125]),
+                                        contrast=fn.random.uniform(range=[0.5, 1.5]))
+        images = fn.crop_mirror_normalize(images, dtype=types.FLOAT16, output_layout='CHW',
+                                          mean=[0.485 * 255, 0.456 * 255, 0.406 * 255],
+                                          std=[0.229 * 255, 0.224 * 255, 0.225 * 255],
+                                          mirror=flip)
+        boxes, labels = fn.box_encoder(boxes, labels, anchors=anchors, criteria=0.5)
+        return images, boxes.gpu(), labels.gpu()
+    return pipe()
+
+
+def asr_pipeline(args, data_dir):
+    sample_rate, nfft, window = 16000, 512, 320
+
+    @pipeline_def(**pipe_kwargs(args))
+    def pipe():
+        encoded, labels = fn.readers.file(file_root=data_dir,
+                                          file_list=os.path.join(data_dir, 'file_list.txt'),
+                                          random_shuffle=True, name='Reader')
+        audio, _ = fn.decoders.audio(encoded, sample_rate=sample_rate, downmix=True,
+                                     dtype=types.FLOAT)
+        audio = fn.preemphasis_filter(audio, preemph_coeff=0.97)
+        spec = fn.spectrogram(audio.gpu(), nfft=nfft, window_length=window, window_step=160)
+        mel = fn.mel_filter_bank(spec, sample_rate=sample_rate, nfilter=80)
+        mel = fn.to_decibels(mel, multiplier=10, reference=1.0, cutoff_db=-80)
+        mel = fn.normalize(mel, axes=[1])
+        mel = fn.pad(mel, axes=[1], align=16)
+        return mel, labels.gpu()
+    return pipe()
+
+
+def video_pipeline(args, data_dir):
+    files = sorted(os.path.join(data_dir, name) for name in os.listdir(data_dir)
+                   if name.endswith('.mp4'))
+
+    @pipeline_def(**pipe_kwargs(args))
+    def pipe():
+        frames = fn.readers.video(device='gpu', filenames=files, sequence_length=16, stride=2,
+                                  random_shuffle=True, initial_fill=16, name='Reader')
+        frames = fn.resize(frames, resize_x=171, resize_y=128)
+        frames = fn.crop_mirror_normalize(frames, dtype=types.FLOAT, output_layout='CFHW',
+                                          crop=(112, 112),
+                                          crop_pos_x=fn.random.uniform(range=[0, 1]),
+                                          crop_pos_y=fn.random.uniform(range=[0, 1]),
+                                          mean=[0.43 * 255, 0.4 * 255, 0.37 * 255],
+                                          std=[0.23 * 255, 0.22 * 255, 0.22 * 255],
+                                          mirror=fn.random.coin_flip(probability=0.5))
+        return frames
+    return pipe()
+
+
+# Measurements #####################################################################################
+
+
+class GpuMemoryMonitor:
+    """Samples the GPU memory used on the device in a background thread
+
+    Requires ``pynvml``; without it, the peak is reported as None.
+    """
+
+    def __init__(self, device_id, interval=0.01):
+        self.peak = None
+        self._stop = threading.Event()
+        self._thread = None
+        try:
+            import pynvml
+            pynvml.nvmlInit()
+            self._nvml = pynvml
+            self._handle = pynvml.nvmlDeviceGetHandleByIndex(device_id)
+        except Exception:
+            self._nvml = None
+        self._interval = interval
+
+    def _used(self):
+        return self._nvml.nvmlDeviceGetMemoryInfo(self._handle).used
+
+    def _run(self):
+        while not self._stop.is_set():
+            self.peak = max(self.peak, self._used())
+            time.sleep(self._interval)
+
+    def __enter__(self):
+        if self._nvml is not None:
+            self.peak = self._used()
+            self._thread = threading.Thread(target=self._run, daemon=True)
+            self._thread.start()
+        return self
+
+    def __exit__(self, *exc):
+        if self._thread is not None:
+            self._stop.set()
+            self._thread.join()
+
+
+def cpu_time():
+    usage = resource.getrusage(resource.RUSAGE_SELF)
+    return usage.ru_utime + usage.ru_stime
+
+
+def run_benchmark(pipe, args):
+    pipe.build()
+    for _ in range(args.warmup):
+        pipe.run()
+    latencies = []
+    with GpuMemoryMonitor(args.device_id) as memory:
+        cpu_start, start = cpu_time(), time.perf_counter()
+        for _ in range(args.iterations):
+            iter_start = time.perf_counter()
+            pipe.run()
+            latencies.append(time.perf_counter() - iter_start)
+        wall, cpu = time.perf_counter() - start, cpu_time() - cpu_start
+    latencies_ms = np.array(latencies) * 1000
+    stats = pipe.executor_statistics()
+    reserved = sum(sum(op.get('max_reserved_memory_size', [])) for op in stats.values())
+    return {
+        'samples_per_s': args.iterations * args.batch_size / wall,
+        'latency_ms': {
+            'mean': float(np.mean(latencies_ms)),
+            'p50': float(np.percentile(latencies_ms, 50)),
+            'p99': float(np.percentile(latencies_ms, 99)),
+        },
+        'cpu_cores': cpu / wall,
+        'gpu_memory_peak_bytes': memory.peak,
+        'output_memory_reserved_bytes': reserved,
+        'epoch_size': pipe.epoch_size('Reader'),
+    }
+
+
+def main():
+    args = parse_args()
+    builders = {
+        'rn50': (rn50_pipeline, lambda: make_image_dataset(args, with_boxes=False)),
+        'ssd': (ssd_pipeline, lambda: make_image_dataset(args, with_boxes=True)),
+        'asr': (asr_pipeline, lambda: make_audio_dataset(args)),
+        'video': (video_pipeline, lambda: make_video_dataset(args)),
+    }
+    results = {}
+    for name in args.pipelines:
+        make_pipeline, make_dataset = builders[name]
+        data_dir = make_dataset()
+        if data_dir is None:
+            results[name] = {'skipped': 'the dataset could not be generated (ffmpeg not found)'}
+            continue
+        pipe = make_pipeline(args, data_dir)
+        results[name] = run_benchmark(pipe, args)
+        del pipe
+
+    config = {k: v for k, v in vars(args).items() if k not in ('output', 'pipelines')}
+    report = {
+        'dali_version': dali.__version__,
+        'timestamp': time.strftime('%Y-%m-%dT%H:%M:%S%z'),
+        'config': config,
+        'results': results,
+    }
+    text = json.dumps(report, indent=2)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text + '\n')
+    else:
+        print(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,91 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "dali/benchmark/dali_bench.h"
+#include "dali/kernels/reduce/reduce_cpu.h"
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+
+namespace {
+
+// H, W, C and the reduced axes (as a bit mask)
+const int64_t kReduceCases[][4] = {
+  { 1080, 1920, 3, 0b111 },  // full reduction
+  { 1080, 1920, 3, 0b011 },  // per-channel, e.g. the mean of the image
+  { 1080, 1920, 1, 0b010 },  // rows
+  { 1080, 1920, 1, 0b001 },  // columns
+};
+
+static void ReduceArgs(benchmark::internal::Benchmark *b) {
+  for (int c = 0; c < 4; c++)
+    for (int num_threads : { 1, 4 })
+      b->Args({c, num_threads});
+}
+
+template <typename Kernel, typename Out, typename In>
+void BM_ReduceCPU(benchmark::State &st) {
+  const int64_t *test_case = kReduceCases[st.range(0)];
+  int num_threads = st.range(1);
+  TensorShape<> in_shape = { test_case[0], test_case[1], test_case[2] };
+  SmallVector<int, 3> axes;
+  TensorShape<> out_shape;
+  for (int d = 0; d < 3; d++) {
+    if (test_case[3] & (1 << d))
+      axes.push_back(d);
+    else
+      out_shape.shape.push_back(in_shape[d]);
+  }
+  if (out_shape.empty())
+    out_shape = { 1 };
+
+  std::vector<In> in(volume(in_shape));
+  std::vector<Out> out(volume(out_shape));
+  std::mt19937 rng(123);
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (auto &x : in)
+    x = dist(rng);
+
+  ThreadPool tp(num_threads, CPU_ONLY_DEVICE_ID, false, "ReduceBench");
+  Kernel kernel;
+  auto in_view = make_tensor_cpu(in.data(), in_shape);
+  auto out_view = make_tensor_cpu(out.data(), out_shape);
+  for (auto _ : st) {
+    kernel.Setup(out_view, in_view, make_cspan(axes));
+    if (num_threads > 1)
+      kernel.RunParallel(tp);
+    else
+      kernel.Run();
+    benchmark::DoNotOptimize(out.data());
+  }
+  st.SetBytesProcessed(st.iterations() * in.size() * sizeof(In));
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ReduceCPU, kernels::SumCPU<float, float>, float, float)
+    ->Apply(ReduceArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ReduceCPU, kernels::SumCPU<int64_t, uint8_t>, int64_t, uint8_t)
+    ->Apply(ReduceArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ReduceCPU, kernels::MeanCPU<float, uint8_t>, float, uint8_t)
+    ->Apply(ReduceArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ReduceCPU, kernels::MaxCPU<float, float>, float, float)
+    ->Apply(ReduceArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ReduceCPU, kernels::RootMeanSquareCPU<float, float>, float, float)
+    ->Apply(ReduceArgs)->UseRealTime();
+
+}  // namespace dali
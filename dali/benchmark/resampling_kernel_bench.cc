@@ -0,0 +1,94 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "dali/benchmark/dali_bench.h"
+#include "dali/kernels/imgproc/resample/separable_impl.h"
+#include "dali/kernels/scratch.h"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+
+class ResamplingBenchGPU : public DALIBenchmark {
+ public:
+  kernels::TestTensorList<uint8_t, 3> in_data;
+  kernels::TestTensorList<uint8_t, 3> out_data;
+
+  void RunGPU(benchmark::State& st) {
+    int H = st.range(0);
+    int W = st.range(1);
+    int out_size = st.range(2);
+    int batch_size = st.range(3);
+    bool fuse_passes = st.range(4);
+    int C = 3;
+
+    in_data.reshape(uniform_list_shape<3>(batch_size, {H, W, C}));
+    std::mt19937_64 rng(1234);
+    UniformRandomFill(in_data.cpu(), rng, 0, 255);
+    auto in_tv = in_data.gpu();
+
+    std::vector<kernels::ResamplingParams2D> params(batch_size);
+    for (auto &p : params) {
+      for (int d = 0; d < 2; d++) {
+        p[d].output_size = out_size;
+        p[d].min_filter.type = kernels::ResamplingFilterType::Triangular;
+        p[d].mag_filter.type = kernels::ResamplingFilterType::Cubic;
+      }
+    }
+
+    kernels::resampling::SeparableResamplingGPUImpl<uint8_t, uint8_t, 2> kernel;
+    kernel.setup.fuse_passes = fuse_passes;
+
+    kernels::KernelContext ctx;
+    ctx.gpu.stream = 0;
+    auto req = kernel.Setup(ctx, in_tv, make_span(params));
+    out_data.reshape(req.output_shapes[0].to_static<3>());
+    auto out_tv = out_data.gpu();
+
+    kernels::ScratchpadAllocator scratch_alloc;
+    scratch_alloc.Reserve(req.scratch_sizes);
+
+    for (auto _ : st) {
+      auto scratchpad = scratch_alloc.GetScratchpad();
+      ctx.scratchpad = &scratchpad;
+      kernel.Run(ctx, out_tv, in_tv, make_span(params));
+      CUDA_CALL(cudaStreamSynchronize(ctx.gpu.stream));
+      st.counters["FPS"] = benchmark::Counter(st.iterations() * batch_size + 1,
+        benchmark::Counter::kIsRate);
+    }
+  }
+};
+
+static void ResamplingKernelArgs_GPU(benchmark::internal::Benchmark *b) {
+  for (int fused = 0; fused <= 1; fused++) {
+    b->Args({1080, 1920, 224, 64, fused});
+    b->Args({480, 640, 224, 64, fused});
+    b->Args({375, 500, 224, 256, fused});
+    b->Args({224, 224, 448, 64, fused});
+  }
+}
+
+BENCHMARK_DEFINE_F(ResamplingBenchGPU, Resampling_GPU)(benchmark::State& st) {
+  this->RunGPU(st);
+}
+
+BENCHMARK_REGISTER_F(ResamplingBenchGPU, Resampling_GPU)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(ResamplingKernelArgs_GPU);
+
+}  // namespace dali
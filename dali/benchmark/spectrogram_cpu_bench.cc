@@ -0,0 +1,45 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <benchmark/benchmark.h>
+#include "dali/benchmark/operator_bench.h"
+#include "dali/benchmark/dali_bench.h"
+
+namespace dali {
+
+BENCHMARK_DEFINE_F(OperatorBench, SpectrogramCPU)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int N = st.range(1);
+  bool time_major = st.range(2);
+
+  // the (degenerate) 1 x N x 1 input is treated as a 1D signal of length N
+  this->RunCPU<float>(
+    st,
+    OpSpec("Spectrogram")
+      .AddArg("max_batch_size", batch_size)
+      .AddArg("num_threads", 1)
+      .AddArg("device", "cpu")
+      .AddArg("window_length", 400)
+      .AddArg("window_step", 160)
+      .AddArg("nfft", 512)
+      .AddArg("layout", time_major ? "tf" : "ft"),
+    batch_size, 1, N, 1, true, 1);
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, SpectrogramCPU)->Iterations(100)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Ranges({{1, 64}, {16000, 320000}, {0, 1}});
+
+}  // namespace dali
@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <thread>
+#include <vector>
 #include "dali/benchmark/dali_bench.h"
 #include "dali/pipeline/util/thread_pool.h"
 
@@ -103,4 +106,53 @@ BENCHMARK_REGISTER_F(ThreadPoolBench, AddWorkDeferred)->Iterations(1000)
 ->UseRealTime()
 ->Apply(ThreadPoolArgs);
 
+
+static void ThreadPoolManySmallTasksArgs(benchmark::internal::Benchmark *b) {
+  int max_threads = std::max<int>(4, std::thread::hardware_concurrency());
+  for (int type : {static_cast<int>(ThreadPoolType::SharedQueue),
+                   static_cast<int>(ThreadPoolType::WorkStealing),
+                   static_cast<int>(ThreadPoolType::ProcessShared)}) {
+    for (int num_tasks : {1000, 10000, 100000}) {
+      for (int nthreads = 4; nthreads <= max_threads; nthreads *= 2) {
+        b->Args({type, num_tasks, nthreads});
+      }
+    }
+  }
+}
+
+/**
+ * @brief Simulates per-sample loops with a large number of tiny tasks, where the cost
+ *        of scheduling dominates the cost of the work itself.
+ */
+BENCHMARK_DEFINE_F(ThreadPoolBench, ManySmallTasks)(benchmark::State& st) {
+  auto type = static_cast<ThreadPoolType>(st.range(0));
+  int num_tasks = st.range(1);
+  int nthreads = st.range(2);
+
+  ThreadPool thread_pool(nthreads, 0, false, "ThreadPoolBench", type);
+  std::vector<int64_t> data(num_tasks);
+  while (st.KeepRunning()) {
+    for (int i = 0; i < num_tasks; i++) {
+      thread_pool.AddWork([&data, i](int thread_id) {
+        int64_t acc = i;
+        for (int k = 0; k < 64; k++)
+          acc = acc * 6364136223846793005LL + 1442695040888963407LL;
+        data[i] = acc;
+      }, i);
+    }
+    thread_pool.RunAll();
+  }
+  st.counters["Tasks"] = benchmark::Counter(static_cast<double>(num_tasks) * st.iterations(),
+                                            benchmark::Counter::kIsRate);
+  st.SetLabel(type == ThreadPoolType::WorkStealing  ? "work_stealing" :
+              type == ThreadPoolType::ProcessShared ? "process_shared" :
+                                                      "shared_queue");
+}
+
+BENCHMARK_REGISTER_F(ThreadPoolBench, ManySmallTasks)->Iterations(50)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(ThreadPoolManySmallTasksArgs);
+
+
 }  // namespace dali
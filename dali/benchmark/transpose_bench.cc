@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <benchmark/benchmark.h>
+#include <vector>
 #include "dali/benchmark/operator_bench.h"
 #include "dali/benchmark/dali_bench.h"
 
@@ -65,4 +66,43 @@ BENCHMARK_REGISTER_F(OperatorBench, TransposeGPU)->Iterations(1000)
 ->UseRealTime()
 ->Apply(TransposeGPUArgs);
 
+static void TransposeGPUSmallChannelsArgs(benchmark::internal::Benchmark *b) {
+  for (int batch_size : {64, 16, 1}) {
+    for (int H : {480, 1080}) {
+      for (int C = 2; C <= 4; C++) {
+        b->Args({batch_size, H, H * 16 / 9, C});
+      }
+    }
+  }
+}
+
+/**
+ * @brief HWC -> CHW transposition of images with few channels
+ *
+ * Reports the achieved bandwidth (read + write) as the bytes processed.
+ */
+BENCHMARK_DEFINE_F(OperatorBench, TransposeGPUSmallChannels)(benchmark::State& st) {
+  int batch_size = st.range(0);
+  int H = st.range(1);
+  int W = st.range(2);
+  int C = st.range(3);
+
+  this->RunGPU<uint8_t>(
+    st,
+    OpSpec("Transpose")
+      .AddArg("max_batch_size", batch_size)
+      .AddArg("num_threads", 1)
+      .AddArg("device", "gpu")
+      .AddArg("perm", std::vector<int>{2, 0, 1}),
+    batch_size, H, W, C);
+
+  int64_t batch_bytes = static_cast<int64_t>(batch_size) * H * W * C * sizeof(uint8_t);
+  st.SetBytesProcessed(2 * batch_bytes * st.iterations());
+}
+
+BENCHMARK_REGISTER_F(OperatorBench, TransposeGPUSmallChannels)->Iterations(1000)
+->Unit(benchmark::kMicrosecond)
+->UseRealTime()
+->Apply(TransposeGPUSmallChannelsArgs);
+
 }  // namespace dali
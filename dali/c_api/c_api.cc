@@ -19,14 +19,23 @@
 #include <utility>
 #include <vector>
 #include <map>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
 
 #include "dali/core/common.h"
 #include "dali/core/cuda_stream_pool.h"
+#include "dali/core/device_guard.h"
 #include "dali/core/format.h"
+#include "dali/core/metrics.h"
+#include "dali/core/mm/callback_resource.h"
+#include "dali/core/mm/default_resources.h"
+#include "dali/core/small_vector.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/pipeline/init.h"
 
 #include "dali/pipeline/pipeline.h"
+#include "dali/pipeline/util/cross_device_sum.h"
 #include "dali/plugin/plugin_manager.h"
 #include "dali/pipeline/data/tensor_list.h"
 #include "dali/pipeline/data/backend.h"
@@ -40,6 +49,9 @@ namespace {
 
 bool dali_initialized = false;
 
+/// The alignment of the memory allocated with daliDeviceAlloc
+constexpr size_t kDeviceAllocAlignment = 256;
+
 /**
  * Maps operator name to the batch size set prior to daliSetExternal... call.
  * Typically, this operator will be BatchSizeProvider.
@@ -172,6 +184,17 @@ inline dali::mm::memory_kind_id GetMemKind(device_type_t device_type, bool is_pi
         : (is_pinned ? dali::mm::memory_kind_id::pinned : dali::mm::memory_kind_id::host);
 }
 
+void CopyTimeHistogram(daliTimeHistogram &out, const dali::TimeHistogram &in) {
+  static_assert(DALI_TIME_HISTOGRAM_BUCKETS == dali::TimeHistogram::kNumBuckets,
+                "daliTimeHistogram must match dali::TimeHistogram");
+  out.count = in.count;
+  out.total_ns = in.total_ns;
+  out.min_ns = in.min_ns;
+  out.max_ns = in.max_ns;
+  for (int b = 0; b < DALI_TIME_HISTOGRAM_BUCKETS; b++)
+    out.buckets[b] = in.buckets[b];
+}
+
 }  // namespace
 
 
@@ -366,6 +389,19 @@ void daliRun(daliPipelineHandle *pipe_handle) {
 }
 
 
+int64_t daliRunWithId(daliPipelineHandle *pipe_handle) {
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
+  daliRun(pipe_handle);
+  return pipeline->NumScheduledIterations() - 1;
+}
+
+
+int64_t daliGetScheduledIterations(daliPipelineHandle *pipe_handle) {
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
+  return pipeline->NumScheduledIterations();
+}
+
+
 void daliOutput(daliPipelineHandle *pipe_handle) {
   dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
   dali::DeviceWorkspace *ws = reinterpret_cast<dali::DeviceWorkspace *>(pipe_handle->ws);
@@ -385,6 +421,24 @@ void daliOutputRelease(daliPipelineHandle *pipe_handle) {
   pipeline->ReleaseOutputs();
 }
 
+
+void daliOutputOfIteration(daliPipelineHandle *pipe_handle, int64_t iteration) {
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
+  dali::DeviceWorkspace *ws = reinterpret_cast<dali::DeviceWorkspace *>(pipe_handle->ws);
+  pipeline->OutputsOf(iteration, ws);
+}
+
+void daliShareOutputAsync(daliPipelineHandle *pipe_handle, cudaStream_t stream) {
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
+  dali::DeviceWorkspace *ws = reinterpret_cast<dali::DeviceWorkspace *>(pipe_handle->ws);
+  pipeline->ShareOutputs(ws, dali::AccessOrder(stream));
+}
+
+void daliOutputReleaseAsync(daliPipelineHandle *pipe_handle, cudaStream_t stream) {
+  dali::Pipeline *pipeline = reinterpret_cast<dali::Pipeline *>(pipe_handle->pipe);
+  pipeline->ReleaseOutputs(dali::AccessOrder(stream));
+}
+
 int64_t daliOutputHasUniformShape(daliPipelineHandle* pipe_handle, int i) {
   dali::DeviceWorkspace* ws = reinterpret_cast<dali::DeviceWorkspace*>(pipe_handle->ws);
   if (ws->OutputIsType<CPUBackend>(i)) {
@@ -547,6 +601,15 @@ device_type_t daliGetOutputDevice(daliPipelineHandle *pipe_handle, int id) {
   return device_type_t::CPU;
 }
 
+const void *daliOutputRawData(daliPipelineHandle *pipe_handle, int output_idx) {
+  dali::DeviceWorkspace *ws = reinterpret_cast<dali::DeviceWorkspace *>(pipe_handle->ws);
+  if (ws->OutputIsType<CPUBackend>(output_idx)) {
+    return unsafe_raw_data(ws->Output<CPUBackend>(output_idx));
+  } else {
+    return unsafe_raw_data(ws->Output<GPUBackend>(output_idx));
+  }
+}
+
 void daliOutputCopy(daliPipelineHandle *pipe_handle, void *dst, int output_idx,
                     device_type_t dst_type, cudaStream_t stream, unsigned int flags) {
   dali::DomainTimeRange tr("[DALI][C API] daliOutputCopy", dali::DomainTimeRange::kGreen);
@@ -578,6 +641,93 @@ void daliOutputCopy(daliPipelineHandle *pipe_handle, void *dst, int output_idx,
   wait_order.wait(copy_order);
 }
 
+template <typename Backend>
+static void FillOutputDesc(daliOutputDesc &desc, const dali::TensorList<Backend> &out) {
+  desc.device = std::is_same<Backend, dali::GPUBackend>::value ? device_type_t::GPU
+                                                              : device_type_t::CPU;
+  desc.dtype = static_cast<dali_data_type_t>(static_cast<int>(out.type()));
+  desc.num_samples = out.num_samples();
+  desc.ndim = out.sample_dim();
+  desc.shape = out.shape().shapes.data();
+  auto layout = out.GetLayout();
+  memcpy(desc.layout, layout.c_str(), layout.size() + 1);
+  desc.data = unsafe_raw_data(out);
+  desc.nbytes = out.nbytes();
+}
+
+void daliGetOutputDescs(daliPipelineHandle *pipe_handle, daliOutputDesc *descs) {
+  dali::DeviceWorkspace *ws = reinterpret_cast<dali::DeviceWorkspace *>(pipe_handle->ws);
+  assert(ws != nullptr);
+  const auto &ready_events = ws->ParentEvents();
+  for (int i = 0; i < ws->NumOutput(); i++) {
+    if (ws->OutputIsType<CPUBackend>(i))
+      FillOutputDesc(descs[i], ws->Output<CPUBackend>(i));
+    else
+      FillOutputDesc(descs[i], ws->Output<GPUBackend>(i));
+    descs[i].ready_event = i < static_cast<int>(ready_events.size()) ? ready_events[i] : nullptr;
+  }
+}
+
+void daliOutputSampleOffsets(daliPipelineHandle *pipe_handle, int output_idx,
+                             int64_t *offsets) {
+  dali::DeviceWorkspace *ws = reinterpret_cast<dali::DeviceWorkspace *>(pipe_handle->ws);
+  assert(ws != nullptr);
+  const auto &shape = ws->OutputIsType<CPUBackend>(output_idx)
+                    ? ws->Output<CPUBackend>(output_idx).shape()
+                    : ws->Output<GPUBackend>(output_idx).shape();
+  int64_t offset = 0;
+  for (int i = 0; i < shape.num_samples(); i++) {
+    offsets[i] = offset;
+    offset += shape.tensor_size(i);
+  }
+  offsets[shape.num_samples()] = offset;
+}
+
+void daliOutputCopyAll(daliPipelineHandle *pipe_handle, void **dsts, device_type_t dst_type,
+                       cudaStream_t stream, unsigned int flags) {
+  dali::DomainTimeRange tr("[DALI][C API] daliOutputCopyAll", dali::DomainTimeRange::kGreen);
+
+  bool is_pinned = flags & DALI_ext_pinned;
+  bool host_sync = flags & DALI_ext_force_sync;
+  bool use_copy_kernel = flags & DALI_use_copy_kernel;
+  auto dst_mem_kind = GetMemKind(dst_type, is_pinned);
+
+  dali::DeviceWorkspace *ws = reinterpret_cast<dali::DeviceWorkspace *>(pipe_handle->ws);
+  assert(ws != nullptr);
+
+  // The copies are issued back to back; then the host or the orders of the copied buffers
+  // (each of them once) wait for all of them.
+  AccessOrder copy_order = stream;
+  dali::SmallVector<AccessOrder, 4> src_orders;
+  auto copied_from = [&](AccessOrder src_order) {
+    if (std::find(src_orders.begin(), src_orders.end(), src_order) == src_orders.end())
+      src_orders.push_back(src_order);
+  };
+  for (int i = 0; i < ws->NumOutput(); i++) {
+    if (!dsts[i])
+      continue;
+    if (ws->OutputIsType<CPUBackend>(i)) {
+      auto &src = ws->Output<CPUBackend>(i);
+      CopyToExternal(dsts[i], dst_mem_kind, src,
+                     is_pinned ? copy_order : AccessOrder::host(), use_copy_kernel);
+      if (is_pinned)
+        copied_from(src.order());
+    } else {
+      auto &src = ws->Output<GPUBackend>(i);
+      CopyToExternal(dsts[i], dst_mem_kind, src, copy_order, use_copy_kernel);
+      copied_from(src.order());
+    }
+  }
+  if (src_orders.empty())
+    return;
+  if (host_sync) {
+    AccessOrder::host().wait(copy_order);
+  } else {
+    for (auto &src_order : src_orders)
+      src_order.wait(copy_order);
+  }
+}
+
 void daliOutputCopySamples(daliPipelineHandle *pipe_handle, void **dsts, int output_idx,
                            device_type_t dst_type, cudaStream_t stream, unsigned int flags) {
   dali::DomainTimeRange tr("[DALI][C API] daliOutputCopySamples", dali::DomainTimeRange::kGreen);
@@ -667,6 +817,37 @@ void daliGetReaderMetadata(daliPipelineHandle* pipe_handle, const char *reader_n
   meta->stick_to_shard = returned_meta.stick_to_shard;
 }
 
+void daliGetReaderState(daliPipelineHandle* pipe_handle, const char *reader_name,
+                        char **state, size_t *size) {
+  DALI_ENFORCE(state && size, "Provided pointers to the state and its size cannot be NULL.");
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  std::string returned_state = pipeline->GetReaderState(reader_name);
+  *size = returned_state.size();
+  *state = static_cast<char*>(malloc(returned_state.size()));
+  memcpy(*state, returned_state.data(), returned_state.size());
+}
+
+void daliGetMetrics(char **text, size_t *size) {
+  DALI_ENFORCE(text, "Provided pointer to the text cannot be NULL.");
+  std::string metrics = dali::metrics::MetricsRegistry::instance().Prometheus();
+  if (size)
+    *size = metrics.size();
+  *text = static_cast<char*>(malloc(metrics.size() + 1));
+  memcpy(*text, metrics.c_str(), metrics.size() + 1);
+}
+
+void daliRestoreReaderState(daliPipelineHandle* pipe_handle, const char *reader_name,
+                            const char *state, size_t size) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  pipeline->RestoreReaderState(reader_name, std::string(state, size));
+}
+
+void daliReshardReader(daliPipelineHandle* pipe_handle, const char *reader_name,
+                       int num_shards, int shard_id, int64_t at_sample) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  pipeline->ReshardReader(reader_name, num_shards, shard_id, at_sample);
+}
+
 dali_backend_t daliGetOperatorBackend(daliPipelineHandle* pipe_handle, const char *operator_name) {
   dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
   auto *node = pipeline->GetOperatorNode(operator_name);
@@ -682,10 +863,60 @@ dali_backend_t daliGetOperatorBackend(daliPipelineHandle* pipe_handle, const cha
   }
 }
 
+void daliEnableExecutorTimingStats(daliPipelineHandle* pipe_handle, int enable) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  pipeline->EnableExecutorTimingStats(enable);
+}
+
+void daliGetExecutorStageStatistics(daliPipelineHandle* pipe_handle,
+                                    daliExecutorStageStatistics *stage_stats) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  auto timing = pipeline->GetExecutorTimingStats();
+  int i = 0;
+  for (auto stage : {dali::OpType::CPU, dali::OpType::MIXED, dali::OpType::GPU}) {
+    const auto &stats = timing.stages[static_cast<int>(stage)];
+    CopyTimeHistogram(stage_stats[i].queue_wait, stats.queue_wait);
+    CopyTimeHistogram(stage_stats[i].run_time, stats.run_time);
+    stage_stats[i].thread_pool_busy_ns = stats.thread_pool_busy_ns;
+    stage_stats[i].thread_pool_capacity_ns = stats.thread_pool_capacity_ns;
+    ++i;
+  }
+}
+
+void daliEnableBottleneckAnalysis(daliPipelineHandle* pipe_handle, double interval_s) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  pipeline->EnableBottleneckAnalysis(interval_s);
+}
+
+void daliGetBottleneckReport(daliPipelineHandle* pipe_handle, daliBottleneckReport *report) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  auto bottleneck = pipeline->GetBottleneckReport();
+  report->verdict = static_cast<dali_bottleneck_t>(bottleneck.verdict);
+  report->iterations = bottleneck.iterations;
+  report->window_s = bottleneck.window_s;
+  report->consumer_wait_fraction = bottleneck.consumer_wait_fraction;
+  report->ready_outputs = bottleneck.ready_outputs;
+  report->thread_pool_utilization = bottleneck.thread_pool_utilization;
+  report->io_fraction = bottleneck.io_fraction;
+  int i = 0;
+  for (auto stage : {dali::OpType::CPU, dali::OpType::MIXED, dali::OpType::GPU}) {
+    report->stage_time_s[i] = bottleneck.stage_time_s[static_cast<int>(stage)];
+    report->stage_wait_fraction[i] = bottleneck.stage_wait_fraction[static_cast<int>(stage)];
+    ++i;
+  }
+}
+
 void daliGetExecutorMetadata(daliPipelineHandle* pipe_handle, daliExecutorMetadata **operator_meta,
                              size_t *operator_meta_num) {
   dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
   auto returned_meta = pipeline->GetExecutorMeta();
+  auto timing = pipeline->GetExecutorTimingStats().operators;
+  std::unordered_map<std::string, double> critical_path_share;
+  for (const auto &op : pipeline->GetBottleneckReport().operators)
+    critical_path_share[op.name] = op.critical_path_share;
+  // the operators with timing, but no memory statistics, have no outputs reported
+  for (const auto &stat : timing)
+    returned_meta.insert({stat.first, {}});
   *operator_meta_num = returned_meta.size();
   *operator_meta = static_cast<daliExecutorMetadata*>(malloc(sizeof(daliExecutorMetadata) *
                                                      returned_meta.size()));
@@ -712,10 +943,24 @@ void daliGetExecutorMetadata(daliPipelineHandle* pipe_handle, daliExecutorMetada
       op_meta.reserved[j] = entry.reserved;
       op_meta.max_reserved[j] = entry.max_reserved;
     }
+    auto op_timing = timing.find(stat.first);
+    const dali::OperatorTimingStats empty_timing = {};
+    const auto &op_timing_stats = op_timing != timing.end() ? op_timing->second : empty_timing;
+    CopyTimeHistogram(op_meta.host_time, op_timing_stats.host_time);
+    CopyTimeHistogram(op_meta.gpu_time, op_timing_stats.gpu_time);
+    auto op_share = critical_path_share.find(stat.first);
+    op_meta.critical_path_share = op_share != critical_path_share.end() ? op_share->second : 0;
     ++i;
   }
 }
 
+void daliGetCurrentQueueSizes(daliPipelineHandle* pipe_handle, int *cpu_size, int *gpu_size) {
+  dali::Pipeline* pipeline = reinterpret_cast<dali::Pipeline*>(pipe_handle->pipe);
+  auto sizes = pipeline->GetCurrentQueueSizes();
+  *cpu_size = sizes.cpu_size;
+  *gpu_size = sizes.gpu_size;
+}
+
 void daliFreeExecutorMetadata(daliExecutorMetadata *operator_meta, size_t operator_meta_num) {
   for (size_t i = 0; i < operator_meta_num; ++i) {
     free(operator_meta[i].operator_name);
@@ -726,3 +971,52 @@ void daliFreeExecutorMetadata(daliExecutorMetadata *operator_meta, size_t operat
   }
   free(operator_meta);
 }
+
+void daliSetDeviceAllocator(int device_id, daliDeviceAllocFn alloc_fn, daliDeviceFreeFn free_fn) {
+  if (device_id < 0)
+    CUDA_CALL(cudaGetDevice(&device_id));
+  if (!alloc_fn && !free_fn) {
+    dali::mm::SetDefaultDeviceResource(device_id,
+                                       std::shared_ptr<dali::mm::device_async_resource>());
+    return;
+  }
+  DALI_ENFORCE(alloc_fn && free_fn,
+               "Both allocation and deallocation functions must be provided (or neither).");
+  auto rsrc = std::make_shared<dali::mm::callback_device_resource>(alloc_fn, free_fn, device_id);
+  dali::mm::SetDefaultDeviceResource(device_id, std::move(rsrc));
+}
+
+void *daliDeviceAlloc(size_t size, int device_id, cudaStream_t stream) {
+  if (device_id < 0)
+    CUDA_CALL(cudaGetDevice(&device_id));
+  dali::DeviceGuard dg(device_id);
+  try {
+    return dali::mm::GetDefaultDeviceResource(device_id)->allocate_async(
+        size, kDeviceAllocAlignment, dali::mm::stream_view(stream));
+  } catch (const std::bad_alloc &) {
+    return nullptr;
+  }
+}
+
+void daliDeviceFree(void *ptr, size_t size, int device_id, cudaStream_t stream) {
+  if (device_id < 0)
+    CUDA_CALL(cudaGetDevice(&device_id));
+  dali::DeviceGuard dg(device_id);
+  dali::mm::GetDefaultDeviceResource(device_id)->deallocate_async(
+      ptr, size, kDeviceAllocAlignment, dali::mm::stream_view(stream));
+}
+
+size_t daliReleaseUnusedMemory() {
+  return dali::mm::ReleaseUnusedMemory();
+}
+
+void daliSetCrossDeviceSum(const char *group, daliCrossDeviceSumFn sum_fn, void *user_data) {
+  DALI_ENFORCE(group, "The group name cannot be NULL.");
+  dali::CrossDeviceSum sum;
+  if (sum_fn) {
+    sum = [sum_fn, user_data](double *data, size_t count, cudaStream_t stream) {
+      sum_fn(data, count, stream, user_data);
+    };
+  }
+  dali::SetCrossDeviceSum(group, std::move(sum));
+}
@@ -638,6 +638,7 @@ TYPED_TEST(CApiTest, TestExecutorMeta) {
   daliCreatePipeline(&handle, serialized.c_str(), serialized.size(), batch_size, num_thread,
                      this->device_id_, false, prefetch_queue_depth, prefetch_queue_depth,
                      prefetch_queue_depth, true);
+  daliEnableExecutorTimingStats(&handle, true);
 
   daliRun(&handle);
   daliOutput(&handle);
@@ -660,8 +661,24 @@ TYPED_TEST(CApiTest, TestExecutorMeta) {
     for (size_t j = 0; j < meta_entry.out_num; ++j) {
       EXPECT_LE(meta_entry.real_size[j], meta_entry.reserved[j]);
     }
+    EXPECT_GE(meta_entry.host_time.count, 1);
+    int64_t bucket_total = 0;
+    for (auto count : meta_entry.host_time.buckets)
+      bucket_total += count;
+    EXPECT_EQ(bucket_total, meta_entry.host_time.count);
+    EXPECT_LE(meta_entry.host_time.min_ns, meta_entry.host_time.max_ns);
   }
   daliFreeExecutorMetadata(meta, N);
+
+  daliExecutorStageStatistics stage_stats[3];
+  daliGetExecutorStageStatistics(&handle, stage_stats);
+  for (auto &stats : stage_stats)
+    EXPECT_GE(stats.run_time.count, 1);
+
+  int cpu_size = 0, gpu_size = 0;
+  daliGetCurrentQueueSizes(&handle, &cpu_size, &gpu_size);
+  EXPECT_EQ(cpu_size, prefetch_queue_depth);
+  EXPECT_EQ(gpu_size, prefetch_queue_depth);
   daliDeletePipeline(&handle);
 }
 
@@ -973,6 +990,91 @@ TYPED_TEST(CApiTest, daliOutputCopySamples) {
 }
 
 
+TYPED_TEST(CApiTest, daliGetOutputDescsAndCopyAll) {
+  auto pipe_ptr = GetTestPipeline<TypeParam>(true, this->output_device_);
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+
+  daliPipelineHandle handle;
+  daliDeserializeDefault(&handle, serialized.c_str(), serialized.size());
+
+  daliRun(&handle);
+  daliOutput(&handle);
+  const int num_output = daliGetNumOutput(&handle);
+  std::vector<daliOutputDesc> descs(num_output);
+  daliGetOutputDescs(&handle, descs.data());
+
+  std::vector<Tensor<TypeParam>> outputs(num_output);
+  std::vector<void *> dsts(num_output);
+  for (int out_idx = 0; out_idx < num_output; out_idx++) {
+    auto &desc = descs[out_idx];
+    EXPECT_EQ(desc.device, backend_to_device_type<TypeParam>::value);
+    EXPECT_EQ(desc.dtype, daliTypeAt(&handle, out_idx));
+    EXPECT_EQ(desc.num_samples, daliNumTensors(&handle, out_idx));
+    EXPECT_EQ(desc.nbytes, daliTensorSize(&handle, out_idx));
+    EXPECT_EQ(desc.ready_event == nullptr, std::is_same_v<TypeParam, CPUBackend>);
+    EXPECT_NE(desc.data, nullptr);
+    for (int sample_idx = 0; sample_idx < desc.num_samples; sample_idx++) {
+      auto *shape = daliShapeAtSample(&handle, out_idx, sample_idx);
+      for (int d = 0; d < desc.ndim; d++)
+        EXPECT_EQ(desc.shape[sample_idx * desc.ndim + d], shape[d]);
+      EXPECT_EQ(shape[desc.ndim], 0);
+      free(shape);
+    }
+    outputs[out_idx].set_pinned(false);
+    outputs[out_idx].Resize({static_cast<int64_t>(desc.nbytes)}, DALI_UINT8);
+    Clear(outputs[out_idx]);
+    dsts[out_idx] = outputs[out_idx].raw_mutable_data();
+  }
+
+  daliOutputCopyAll(&handle, dsts.data(), backend_to_device_type<TypeParam>::value, cuda_stream,
+                    DALI_ext_force_sync);
+
+  for (int out_idx = 0; out_idx < num_output; out_idx++) {
+    Tensor<TypeParam> ref;
+    ref.set_pinned(false);
+    ref.Resize({static_cast<int64_t>(descs[out_idx].nbytes)}, DALI_UINT8);
+    daliOutputCopy(&handle, ref.raw_mutable_data(), out_idx,
+                   backend_to_device_type<TypeParam>::value, cuda_stream, DALI_ext_force_sync);
+    // Unnecessary copy in case of CPUBackend, makes the code generic across Backends
+    Tensor<CPUBackend> ref_cpu, output_cpu;
+    ref_cpu.Copy(ref, this->order_);
+    output_cpu.Copy(outputs[out_idx], this->order_);
+    if (std::is_same_v<TypeParam, GPUBackend>)
+      CUDA_CALL(cudaDeviceSynchronize());
+    Check(view<uint8_t>(ref_cpu), view<uint8_t>(output_cpu));
+  }
+  daliDeletePipeline(&handle);
+}
+
+
+TYPED_TEST(CApiTest, daliOutputSampleOffsets) {
+  auto pipe_ptr = GetTestPipeline<TypeParam>(true, this->output_device_);
+  auto serialized = pipe_ptr->SerializeToProtobuf();
+
+  daliPipelineHandle handle;
+  daliDeserializeDefault(&handle, serialized.c_str(), serialized.size());
+
+  daliRun(&handle);
+  daliOutput(&handle);
+  for (int out_idx = 0; out_idx < static_cast<int>(daliGetNumOutput(&handle)); out_idx++) {
+    int num_samples = daliNumTensors(&handle, out_idx);
+    std::vector<int64_t> offsets(num_samples + 1, -1);
+    daliOutputSampleOffsets(&handle, out_idx, offsets.data());
+    EXPECT_EQ(offsets[0], 0);
+    for (int sample_idx = 0; sample_idx < num_samples; sample_idx++) {
+      auto *shape = daliShapeAtSample(&handle, out_idx, sample_idx);
+      int64_t volume = 1;
+      for (int d = 0; shape[d] != 0; d++)
+        volume *= shape[d];
+      EXPECT_EQ(offsets[sample_idx + 1] - offsets[sample_idx], volume);
+      free(shape);
+    }
+    EXPECT_EQ(offsets[num_samples], static_cast<int64_t>(daliNumElements(&handle, out_idx)));
+  }
+  daliDeletePipeline(&handle);
+}
+
+
 TYPED_TEST(CApiTest, IsDeserializableTest) {
   using namespace std;  // NOLINT
   vector<tuple<string /* serialized pipeline */, bool /* is deserializable? */>> test_cases;
@@ -0,0 +1,100 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include "dali/core/bfloat16.h"
+#include "dali/core/convert.h"
+
+namespace dali {
+
+namespace {
+
+uint32_t FloatBits(float f) {
+  uint32_t u;
+  std::memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+float BitsToFloat(uint32_t u) {
+  float f;
+  std::memcpy(&f, &u, sizeof(f));
+  return f;
+}
+
+}  // namespace
+
+TEST(BFloat16, Construction) {
+  bfloat16 a = {};
+  EXPECT_EQ(a.bits, 0);
+  bfloat16 b = 42;
+  EXPECT_EQ(static_cast<float>(b), 42.0f);
+  bfloat16 c = -5.5f;
+  EXPECT_EQ(static_cast<float>(c), -5.5f);
+  bfloat16 d = float16(0.25f);
+  EXPECT_EQ(static_cast<float>(d), 0.25f);
+  EXPECT_EQ(static_cast<float>(-c), 5.5f);
+  EXPECT_EQ(bfloat16::from_bits(0x3f80).bits, 0x3f80);
+  EXPECT_EQ(static_cast<float>(bfloat16::from_bits(0x3f80)), 1.0f);
+}
+
+TEST(BFloat16, ExactValues) {
+  // every bfloat16 value, except NaNs, is a float and is converted back to the same bits
+  for (uint32_t bits = 0; bits < 0x10000u; bits++) {
+    float f = BitsToFloat(bits << 16);
+    if (std::isnan(f))
+      continue;
+    ASSERT_EQ(bfloat16(f).bits, bits) << "for " << f;
+  }
+}
+
+TEST(BFloat16, RoundToNearestEven) {
+  // 1 + 2^-8 is halfway between 1 and the next bfloat16 - rounded down to the even 1
+  EXPECT_EQ(bfloat16(BitsToFloat(0x3f808000u)).bits, 0x3f80);
+  // 1 + 3 * 2^-8 is halfway between 2 values - rounded up to the even one
+  EXPECT_EQ(bfloat16(BitsToFloat(0x3f818000u)).bits, 0x3f82);
+  // just above and below the midpoint
+  EXPECT_EQ(bfloat16(BitsToFloat(0x3f808001u)).bits, 0x3f81);
+  EXPECT_EQ(bfloat16(BitsToFloat(0x3f807fffu)).bits, 0x3f80);
+  // the largest float rounds up to infinity
+  EXPECT_TRUE(std::isinf(static_cast<float>(bfloat16(std::numeric_limits<float>::max()))));
+}
+
+TEST(BFloat16, NaN) {
+  float nan = std::numeric_limits<float>::quiet_NaN();
+  EXPECT_TRUE(std::isnan(static_cast<float>(bfloat16(nan))));
+  // a NaN with the payload only in the discarded bits must remain a NaN
+  float snan = BitsToFloat(0x7f800001u);
+  EXPECT_TRUE(std::isnan(static_cast<float>(bfloat16(snan))));
+  EXPECT_EQ(FloatBits(static_cast<float>(bfloat16::from_bits(0x7fc0))), 0x7fc00000u);
+}
+
+TEST(BFloat16, Convert) {
+  EXPECT_EQ(static_cast<float>(ConvertSat<bfloat16>(1e39)), 3.38953139e38f);
+  EXPECT_EQ(static_cast<float>(ConvertSat<bfloat16>(-1e39)), -3.38953139e38f);
+  EXPECT_TRUE(std::isinf(static_cast<float>(Convert<bfloat16>(1e39))));
+  EXPECT_EQ(static_cast<float>(ConvertSat<bfloat16>(255)), 255.0f);
+  EXPECT_EQ(static_cast<float>(ConvertSat<bfloat16>(257)), 256.0f);
+  EXPECT_EQ(ConvertSat<uint8_t>(bfloat16(300.0f)), 255);
+  EXPECT_EQ(ConvertSat<int8_t>(bfloat16(-2.5f)), -3);
+  EXPECT_EQ(ConvertNorm<uint8_t>(bfloat16(1.0f)), 255);
+  EXPECT_EQ(static_cast<float>(ConvertSatNorm<bfloat16>(uint8_t(255))), 1.0f);
+  EXPECT_EQ(static_cast<float>(Convert<float16>(bfloat16(0.5f))), 0.5f);
+  EXPECT_EQ(ConvertSat<bfloat16>(bfloat16(3.0f)).bits, bfloat16(3.0f).bits);
+}
+
+}  // namespace dali
@@ -172,6 +172,20 @@ void TestBitmaskAppend(int first_bits, int second_bits) {
   }
 }
 
+TEST(Bitmask, Count) {
+  bitmask m;
+  EXPECT_EQ(m.count(), 0);
+  m.resize(200, false);
+  EXPECT_EQ(m.count(), 0);
+  EXPECT_EQ(m.count(false), 200);
+  m.fill(3, 150, true);
+  m[199] = true;
+  EXPECT_EQ(m.count(), 148);
+  EXPECT_EQ(m.count(false), 52);
+  m.resize(170);
+  EXPECT_EQ(m.count(), 147);
+}
+
 TEST(Bitmask, AppendToAligned) {
   TestBitmaskAppend(128, 1);
   TestBitmaskAppend(64, 63);
@@ -0,0 +1,158 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/core/convert_bulk.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DALI_F16C_AVAILABLE 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define DALI_NEON_FP16_AVAILABLE 1
+#endif
+
+namespace dali {
+
+namespace {
+
+static_assert(sizeof(float16) == sizeof(uint16_t), "float16 must be a 16-bit type");
+
+using FloatToFloat16Func = void (*)(float16 *, const float *, int64_t);
+using Float16ToFloatFunc = void (*)(float *, const float16 *, int64_t);
+
+void FloatToFloat16Scalar(float16 *out, const float *in, int64_t n) {
+  for (int64_t i = 0; i < n; i++)
+    out[i] = float16(in[i]);
+}
+
+void Float16ToFloatScalar(float *out, const float16 *in, int64_t n) {
+  for (int64_t i = 0; i < n; i++)
+    out[i] = static_cast<float>(in[i]);
+}
+
+/*
+ * The hardware conversions round the ties to even, but float16(float) rounds them away from zero.
+ * A tie which was rounded towards zero is detected by comparing the input with the midpoint
+ * between the result and the next float16 value of greater magnitude (the bit pattern + 1);
+ * such results are then incremented.
+ */
+
+#ifdef DALI_F16C_AVAILABLE
+
+__attribute__((target("avx,f16c")))
+void FloatToFloat16F16C(float16 *out, const float *in, int64_t n) {
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  const __m128i one = _mm_set1_epi16(1);
+  const __m256 half = _mm256_set1_ps(0.5f);
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 x = _mm256_loadu_ps(in + i);
+    __m128i h = _mm256_cvtps_ph(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 rounded = _mm256_cvtph_ps(h);
+    __m256 next = _mm256_cvtph_ps(_mm_add_epi16(h, one));
+    __m256 towards_zero = _mm256_cmp_ps(_mm256_and_ps(rounded, abs_mask),
+                                        _mm256_and_ps(x, abs_mask), _CMP_LT_OQ);
+    __m256 tie = _mm256_cmp_ps(x, _mm256_mul_ps(_mm256_add_ps(rounded, next), half), _CMP_EQ_OQ);
+    __m256i fix = _mm256_castps_si256(_mm256_and_ps(towards_zero, tie));
+    // the mask is -1 where the result must be incremented
+    __m128i fix16 = _mm_packs_epi32(_mm256_castsi256_si128(fix), _mm256_extractf128_si256(fix, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_sub_epi16(h, fix16));
+  }
+  FloatToFloat16Scalar(out + i, in + i, n - i);
+}
+
+__attribute__((target("avx,f16c")))
+void Float16ToFloatF16C(float *out, const float16 *in, int64_t n) {
+  int64_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+  }
+  Float16ToFloatScalar(out + i, in + i, n - i);
+}
+
+bool HasF16C() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+}
+
+FloatToFloat16Func SelectFloatToFloat16() {
+  return HasF16C() ? FloatToFloat16F16C : FloatToFloat16Scalar;
+}
+
+Float16ToFloatFunc SelectFloat16ToFloat() {
+  return HasF16C() ? Float16ToFloatF16C : Float16ToFloatScalar;
+}
+
+#elif defined(DALI_NEON_FP16_AVAILABLE)
+
+void FloatToFloat16Neon(float16 *out, const float *in, int64_t n) {
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t x = vld1q_f32(in + i);
+    float16x4_t h = vcvt_f16_f32(x);
+    uint16x4_t bits = vreinterpret_u16_f16(h);
+    float32x4_t rounded = vcvt_f32_f16(h);
+    float32x4_t next = vcvt_f32_f16(vreinterpret_f16_u16(vadd_u16(bits, vdup_n_u16(1))));
+    uint32x4_t towards_zero = vcltq_f32(vabsq_f32(rounded), vabsq_f32(x));
+    uint32x4_t tie = vceqq_f32(x, vmulq_n_f32(vaddq_f32(rounded, next), 0.5f));
+    // the mask is 0xffff (-1) where the result must be incremented
+    uint16x4_t fix = vmovn_u32(vandq_u32(towards_zero, tie));
+    vst1_u16(reinterpret_cast<uint16_t *>(out + i), vsub_u16(bits, fix));
+  }
+  FloatToFloat16Scalar(out + i, in + i, n - i);
+}
+
+void Float16ToFloatNeon(float *out, const float16 *in, int64_t n) {
+  int64_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    uint16x4_t bits = vld1_u16(reinterpret_cast<const uint16_t *>(in + i));
+    vst1q_f32(out + i, vcvt_f32_f16(vreinterpret_f16_u16(bits)));
+  }
+  Float16ToFloatScalar(out + i, in + i, n - i);
+}
+
+FloatToFloat16Func SelectFloatToFloat16() {
+  return FloatToFloat16Neon;
+}
+
+Float16ToFloatFunc SelectFloat16ToFloat() {
+  return Float16ToFloatNeon;
+}
+
+#else
+
+FloatToFloat16Func SelectFloatToFloat16() {
+  return FloatToFloat16Scalar;
+}
+
+Float16ToFloatFunc SelectFloat16ToFloat() {
+  return Float16ToFloatScalar;
+}
+
+#endif
+
+}  // namespace
+
+void FloatToFloat16(float16 *out, const float *in, int64_t n) {
+  static const FloatToFloat16Func impl = SelectFloatToFloat16();
+  impl(out, in, n);
+}
+
+void Float16ToFloat(float *out, const float16 *in, int64_t n) {
+  static const Float16ToFloatFunc impl = SelectFloat16ToFloat();
+  impl(out, in, n);
+}
+
+}  // namespace dali
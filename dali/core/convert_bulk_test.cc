@@ -0,0 +1,128 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "dali/core/convert_bulk.h"
+
+namespace dali {
+
+namespace {
+
+uint16_t bits(float16 h) {
+  uint16_t b;
+  std::memcpy(&b, &h, sizeof(b));
+  return b;
+}
+
+float16 from_bits(uint16_t b) {
+  float16 h;
+  std::memcpy(&h, &b, sizeof(b));
+  return h;
+}
+
+float float_from_bits(uint32_t b) {
+  float f;
+  std::memcpy(&f, &b, sizeof(f));
+  return f;
+}
+
+}  // namespace
+
+TEST(ConvertBulk, FloatToFloat16) {
+  std::vector<float> in;
+  // the values representable as float16, the ties between them and their neighbours
+  for (uint32_t h = 0; h < 0x10000; h++) {
+    float16 f16 = from_bits(h);
+    float x = static_cast<float>(f16);
+    if (std::isnan(x) || std::isinf(x))
+      continue;
+    float next = static_cast<float>(from_bits(h + 1));
+    in.push_back(x);
+    if (std::isfinite(next) && (h & 0x7fff) != 0x7fff) {
+      float mid = (x + next) * 0.5f;
+      in.push_back(mid);
+      in.push_back(std::nextafter(mid, 0.0f));
+      in.push_back(std::nextafter(mid, x + (next - x) * 4));
+    }
+  }
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<uint32_t> dist;
+  for (int i = 0; i < 100000; i++)
+    in.push_back(float_from_bits(dist(rng)));
+  in.push_back(65504.0f);
+  in.push_back(65519.0f);
+  in.push_back(65520.0f);
+  in.push_back(1e10f);
+  in.push_back(-1e10f);
+
+  // a size which is not a multiple of the vector width
+  in.push_back(0.1f);
+  std::vector<float16> out(in.size());
+  FloatToFloat16(out.data(), in.data(), in.size());
+  for (size_t i = 0; i < in.size(); i++) {
+    float16 ref(in[i]);
+    if (std::isnan(in[i]))
+      EXPECT_TRUE(std::isnan(static_cast<float>(out[i])));
+    else
+      ASSERT_EQ(bits(out[i]), bits(ref)) << "for " << in[i] << " at " << i;
+  }
+}
+
+TEST(ConvertBulk, Float16ToFloat) {
+  std::vector<float16> in(0x10001);
+  for (uint32_t h = 0; h < in.size(); h++)
+    in[h] = from_bits(h);
+  std::vector<float> out(in.size());
+  Float16ToFloat(out.data(), in.data(), in.size());
+  for (size_t i = 0; i < in.size(); i++) {
+    float ref = static_cast<float>(in[i]);
+    if (std::isnan(ref))
+      EXPECT_TRUE(std::isnan(out[i]));
+    else
+      ASSERT_EQ(out[i], ref) << "for float16 bits " << i;
+  }
+}
+
+template <typename Out, typename In>
+void TestConvertSatBulk(double lo, double hi) {
+  const int n = 1000;
+  std::vector<In> in(n);
+  std::mt19937 rng(4321);
+  std::uniform_real_distribution<double> dist(lo, hi);
+  for (auto &x : in)
+    x = ConvertSat<In>(dist(rng));
+  std::vector<Out> out(n);
+  ConvertSatBulk(out.data(), in.data(), n);
+  for (int i = 0; i < n; i++) {
+    Out ref = ConvertSat<Out>(in[i]);
+    ASSERT_EQ(static_cast<double>(out[i]), static_cast<double>(ref)) << "at " << i;
+  }
+}
+
+TEST(ConvertBulk, ConvertSatBulk) {
+  TestConvertSatBulk<float16, float>(-70000, 70000);
+  TestConvertSatBulk<float16, uint8_t>(0, 255);
+  TestConvertSatBulk<float16, int32_t>(-100000, 100000);
+  TestConvertSatBulk<float, float16>(-60000, 60000);
+  TestConvertSatBulk<uint8_t, float16>(-100, 300);
+  TestConvertSatBulk<int16_t, float16>(-60000, 60000);
+  TestConvertSatBulk<double, float16>(-1, 1);
+  TestConvertSatBulk<int32_t, float>(-1e6, 1e6);
+}
+
+}  // namespace dali
@@ -0,0 +1,34 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/core/cuda_graph.h"
+#include "dali/core/cuda_error.h"
+
+namespace dali {
+
+void CUDAGraph::DestroyHandle(cudaGraph_t graph) {
+  CUDA_DTOR_CALL(cudaGraphDestroy(graph));
+}
+
+CUDAGraphExec CUDAGraphExec::Instantiate(cudaGraph_t graph) {
+  cudaGraphExec_t exec;
+  CUDA_CALL(cudaGraphInstantiateWithFlags(&exec, graph, 0));
+  return CUDAGraphExec(exec);
+}
+
+void CUDAGraphExec::DestroyHandle(cudaGraphExec_t exec) {
+  CUDA_DTOR_CALL(cudaGraphExecDestroy(exec));
+}
+
+}  // namespace dali
@@ -28,14 +28,14 @@ CUDAStreamPool::CUDAStreamPool() {
   dev_streams_.reserve(128);  // to avoid allocation in 1st call
 }
 
-CUDAStreamLease CUDAStreamPool::Get(int device_id) {
+CUDAStreamLease CUDAStreamPool::Get(int device_id, int priority) {
   if (device_id < 0)
     CUDA_CALL(cudaGetDevice(&device_id));
 
-  CUDAStream s = GetFromPool(device_id);
+  CUDAStream s = GetFromPool(device_id, priority);
   if (!s)
-    s = CUDAStream::Create(true, device_id);
-  return { std::move(s), device_id, this };
+    s = CUDAStream::CreateWithPriority(true, priority, device_id);
+  return { std::move(s), device_id, priority, this };
 }
 
 void CUDAStreamPool::Purge() {
@@ -62,12 +62,12 @@ void CUDAStreamPool::Init() {
   dev_streams_.resize(num_devices);
 }
 
-CUDAStream CUDAStreamPool::GetFromPool(int device_id) {
+CUDAStream CUDAStreamPool::GetFromPool(int device_id, int priority) {
   std::lock_guard<spinlock> guard(lock_);
   if (dev_streams_.empty())
     Init();
   assert(device_id >= 0 && device_id < static_cast<int>(dev_streams_.size()));
-  StreamEntry *e = Pop(dev_streams_[device_id]);
+  StreamEntry *e = Pop(dev_streams_[device_id], priority);
   if (!e)
     return {};
   CUDAStream ev = std::move(e->stream);
@@ -75,7 +75,7 @@ CUDAStream CUDAStreamPool::GetFromPool(int device_id) {
   return ev;
 }
 
-void CUDAStreamPool::Put(CUDAStream &&stream, int device_id) {
+void CUDAStreamPool::Put(CUDAStream &&stream, int device_id, int priority) {
   if (!stream)
     throw std::invalid_argument("Cannot put a null stream in the pool.");
   if (device_id < 0) {
@@ -99,10 +99,11 @@ void CUDAStreamPool::Put(CUDAStream &&stream, int device_id) {
   StreamEntry *e = Pop(unused_);
   if (!e) {
     lock.unlock();
-    e = new StreamEntry(std::move(stream));
+    e = new StreamEntry(std::move(stream), priority);
     lock.lock();
   } else {
     e->stream = std::move(stream);
+    e->priority = priority;
   }
   Push(dev_streams_[device_id], e);
 }
@@ -73,6 +73,42 @@ class CUDAStreamPoolTest : public ::testing::Test {
       t.join();
     ASSERT_EQ(0, pool.lease_count_.load());
   }
+
+  void TestPriority() {
+    int devices = 0;
+    (void)cudaGetDeviceCount(&devices);
+    if (devices == 0) {
+      (void)cudaGetLastError();  // No CUDA devices - we don't care about the error
+      GTEST_SKIP();
+    }
+    int least = 0, greatest = 0;
+    CUDA_CALL(cudaDeviceGetStreamPriorityRange(&least, &greatest));
+    if (least == greatest)
+      GTEST_SKIP() << "Stream priorities are not supported";
+
+    CUDAStreamPool pool;
+    cudaStream_t low_handle, high_handle;
+    {
+      CUDAStreamLease low = pool.Get(0, least);
+      CUDAStreamLease high = pool.Get(0, greatest);
+      EXPECT_EQ(low.priority(), least);
+      EXPECT_EQ(high.priority(), greatest);
+      int p = 0;
+      CUDA_CALL(cudaStreamGetPriority(low, &p));
+      EXPECT_EQ(p, least);
+      CUDA_CALL(cudaStreamGetPriority(high, &p));
+      EXPECT_EQ(p, greatest);
+      low_handle = low;
+      high_handle = high;
+    }
+    // the streams are returned to the pool and reused only for the same priority
+    CUDAStreamLease high = pool.Get(0, greatest);
+    CUDAStreamLease low = pool.Get(0, least);
+    EXPECT_EQ(static_cast<cudaStream_t>(high), high_handle);
+    EXPECT_EQ(static_cast<cudaStream_t>(low), low_handle);
+    CUDAStreamLease another_high = pool.Get(0, greatest);
+    EXPECT_NE(static_cast<cudaStream_t>(another_high), low_handle);
+  }
 };
 
 namespace test {
@@ -81,5 +117,9 @@ TEST_F(CUDAStreamPoolTest, PutGet) {
   TestPutGet();
 }
 
+TEST_F(CUDAStreamPoolTest, Priority) {
+  TestPriority();
+}
+
 }  // namespace test
 }  // namespace dali
@@ -0,0 +1,190 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/core/metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+
+namespace dali {
+namespace metrics {
+
+int Counter::ShardIndex() noexcept {
+  static std::atomic<int> next_thread{0};
+  static thread_local int index = next_thread.fetch_add(1, std::memory_order_relaxed) %
+                                  kNumShards;
+  return index;
+}
+
+namespace {
+
+std::string LabelsKey(const Labels &labels) {
+  std::string key;
+  for (auto &label : labels) {
+    key += label.first;
+    key += '\0';
+    key += label.second;
+    key += '\0';
+  }
+  return key;
+}
+
+void WriteEscaped(std::ostream &os, const std::string &str, bool quotes) {
+  for (char c : str) {
+    if (c == '\\')
+      os << "\\\\";
+    else if (c == '\n')
+      os << "\\n";
+    else if (c == '"' && quotes)
+      os << "\\\"";
+    else
+      os << c;
+  }
+}
+
+void WriteValue(std::ostream &os, double value) {
+  if (std::isnan(value)) {
+    os << "NaN";
+  } else if (std::isinf(value)) {
+    os << (value > 0 ? "+Inf" : "-Inf");
+  } else if (value == std::floor(value) && std::abs(value) < 1e15) {
+    os << static_cast<int64_t>(value);
+  } else {
+    auto precision = os.precision(17);
+    os << value;
+    os.precision(precision);
+  }
+}
+
+}  // namespace
+
+class MetricsRegistry::Impl {
+ public:
+  struct Series {
+    Labels labels;
+    std::unique_ptr<Counter> counter;
+  };
+
+  struct Family {
+    std::string help;
+    MetricType type;
+    std::unordered_map<std::string, Series> series;
+  };
+
+  mutable std::mutex mutex;
+  std::map<std::string, Family> families;
+  std::map<int, Collector> collectors;
+  int next_collector_id = 0;
+};
+
+MetricsRegistry::MetricsRegistry() : impl_(std::make_unique<Impl>()) {}
+
+MetricsRegistry::~MetricsRegistry() = default;
+
+MetricsRegistry &MetricsRegistry::instance() {
+  // Never destroyed - the counters are updated until the very end of the process,
+  // e.g. by the memory released by static objects
+  static MetricsRegistry *registry = new MetricsRegistry();
+  return *registry;
+}
+
+Counter &MetricsRegistry::GetCounter(const std::string &name, const std::string &help,
+                                     const Labels &labels, MetricType type) {
+  std::lock_guard<std::mutex> g(impl_->mutex);
+  auto it = impl_->families.find(name);
+  if (it == impl_->families.end())
+    it = impl_->families.emplace(name, Impl::Family{help, type, {}}).first;
+  auto &series = it->second.series[LabelsKey(labels)];
+  if (!series.counter) {
+    series.labels = labels;
+    series.counter = std::make_unique<Counter>();
+  }
+  return *series.counter;
+}
+
+int MetricsRegistry::AddCollector(Collector collector) {
+  std::lock_guard<std::mutex> g(impl_->mutex);
+  int id = impl_->next_collector_id++;
+  impl_->collectors.emplace(id, std::move(collector));
+  return id;
+}
+
+void MetricsRegistry::RemoveCollector(int id) {
+  std::lock_guard<std::mutex> g(impl_->mutex);
+  impl_->collectors.erase(id);
+}
+
+std::vector<MetricSample> MetricsRegistry::Collect() const {
+  std::vector<MetricSample> samples;
+  {
+    // The collectors are called with the lock held, so that they can't be removed (and their
+    // owners destroyed) in the meantime
+    std::lock_guard<std::mutex> g(impl_->mutex);
+    for (auto &family : impl_->families) {
+      for (auto &series : family.second.series) {
+        samples.push_back({family.first, family.second.help, family.second.type,
+                           series.second.labels,
+                           static_cast<double>(series.second.counter->Value())});
+      }
+    }
+    for (auto &collector : impl_->collectors)
+      collector.second(samples);
+  }
+  std::stable_sort(samples.begin(), samples.end(), [](const auto &a, const auto &b) {
+    return a.name < b.name;
+  });
+  return samples;
+}
+
+void MetricsRegistry::WritePrometheus(std::ostream &os) const {
+  auto samples = Collect();
+  const std::string *family = nullptr;
+  for (auto &sample : samples) {
+    if (!family || *family != sample.name) {
+      family = &sample.name;
+      os << "# HELP " << sample.name << " ";
+      WriteEscaped(os, sample.help, false);
+      os << "\n# TYPE " << sample.name << " "
+         << (sample.type == MetricType::Counter ? "counter" : "gauge") << "\n";
+    }
+    os << sample.name;
+    if (!sample.labels.empty()) {
+      os << "{";
+      for (size_t i = 0; i < sample.labels.size(); i++) {
+        if (i)
+          os << ",";
+        os << sample.labels[i].first << "=\"";
+        WriteEscaped(os, sample.labels[i].second, true);
+        os << "\"";
+      }
+      os << "}";
+    }
+    os << " ";
+    WriteValue(os, sample.value);
+    os << "\n";
+  }
+}
+
+std::string MetricsRegistry::Prometheus() const {
+  std::stringstream ss;
+  WritePrometheus(ss);
+  return ss.str();
+}
+
+}  // namespace metrics
+}  // namespace dali
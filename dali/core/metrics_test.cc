@@ -0,0 +1,76 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dali/core/metrics.h"
+
+namespace dali {
+namespace metrics {
+namespace test {
+
+TEST(Metrics, CounterThreads) {
+  auto &counter = GetCounter("dali_test_counter_threads_total", "Test counter");
+  int64_t initial = counter.Value();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < 10000; i++)
+        counter.Add();
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  EXPECT_EQ(counter.Value() - initial, 80000);
+  // the same name and labels give the same counter
+  EXPECT_EQ(&GetCounter("dali_test_counter_threads_total", "Test counter"), &counter);
+}
+
+TEST(Metrics, Prometheus) {
+  GetCounter("dali_test_reads_total", "Test \\ reads", {{"reader", "a\"b"}}).Add(3);
+  GetCounter("dali_test_reads_total", "Test \\ reads", {{"reader", "c"}}).Add(5);
+  GetGauge("dali_test_bytes", "Test bytes").Add(-7);
+  auto text = MetricsRegistry::instance().Prometheus();
+  EXPECT_NE(text.find("# HELP dali_test_reads_total Test \\\\ reads\n"
+                      "# TYPE dali_test_reads_total counter\n"), std::string::npos) << text;
+  EXPECT_NE(text.find("dali_test_reads_total{reader=\"a\\\"b\"} 3\n"), std::string::npos);
+  EXPECT_NE(text.find("dali_test_reads_total{reader=\"c\"} 5\n"), std::string::npos);
+  EXPECT_NE(text.find("# TYPE dali_test_bytes gauge\ndali_test_bytes -7\n"), std::string::npos);
+}
+
+TEST(Metrics, Collector) {
+  auto has_sample = []() {
+    for (auto &sample : MetricsRegistry::instance().Collect()) {
+      if (sample.name == "dali_test_collected")
+        return true;
+    }
+    return false;
+  };
+  {
+    CollectorHandle handle([](std::vector<MetricSample> &samples) {
+      samples.push_back({"dali_test_collected", "Test gauge", MetricType::Gauge,
+                         {{"stage", "cpu"}}, 0.5});
+    });
+    EXPECT_TRUE(has_sample());
+    auto text = MetricsRegistry::instance().Prometheus();
+    EXPECT_NE(text.find("dali_test_collected{stage=\"cpu\"} 0.5\n"), std::string::npos) << text;
+  }
+  EXPECT_FALSE(has_sample());
+}
+
+}  // namespace test
+}  // namespace metrics
+}  // namespace dali
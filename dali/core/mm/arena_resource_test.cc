@@ -0,0 +1,95 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include "dali/core/mm/arena_resource.h"
+#include "dali/core/mm/mm_test_utils.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMTest, HostArenaResource) {
+  test_host_resource upstream;
+  {
+    host_arena_resource arena(&upstream, 1024);
+    void *m1 = arena.allocate(100);
+    ASSERT_NE(m1, nullptr);
+    memset(m1, 0xff, 100);
+    void *m2 = arena.allocate(256, 32);
+    EXPECT_TRUE(detail::is_aligned(m2, 32));
+    EXPECT_GE(static_cast<char *>(m2), static_cast<char *>(m1) + 100);
+    memset(m2, 0xfe, 256);
+    arena.deallocate(m1, 100);  // no-op
+    EXPECT_EQ(arena.stats().upstream_allocations, 1u);
+    // doesn't fit in the first block
+    void *m3 = arena.allocate(4000);
+    ASSERT_NE(m3, nullptr);
+    memset(m3, 0xfd, 4000);
+    EXPECT_EQ(arena.stats().upstream_allocations, 2u);
+    EXPECT_EQ(arena.stats().allocations, 3u);
+
+    // the blocks are merged, so that the same allocations fit in a single block
+    arena.reset();
+    EXPECT_GE(arena.stats().peak_bytes, 100u + 256u + 4000u);
+    EXPECT_EQ(arena.stats().upstream_allocations, 3u);
+    for (int iter = 0; iter < 3; iter++) {
+      void *a1 = arena.allocate(100);
+      arena.allocate(256, 32);
+      arena.allocate(4000);
+      arena.reset();
+      void *a2 = arena.allocate(100);
+      EXPECT_EQ(a1, a2);
+      arena.reset();
+    }
+    EXPECT_EQ(arena.stats().upstream_allocations, 3u);
+  }
+  upstream.check_leaks();
+}
+
+TEST(MMTest, ArenaAllocator) {
+  test_host_resource upstream;
+  {
+    host_arena_resource arena(&upstream, 256);
+    for (int iter = 0; iter < 4; iter++) {
+      arena_vector<int> v{arena_allocator<int>(&arena)};
+      for (int i = 0; i < 1000; i++)
+        v.push_back(i);
+      for (int i = 0; i < 1000; i++)
+        ASSERT_EQ(v[i], i);
+      arena_vector<double> w(v.begin(), v.end(), arena_allocator<double>(v.get_allocator()));
+      EXPECT_EQ(w.size(), 1000u);
+      EXPECT_EQ(w.back(), 999.0);
+      arena.reset();
+    }
+    // the first iteration grows the arena, the next ones reuse the merged block
+    auto upstream_allocs = arena.stats().upstream_allocations;
+    arena_vector<int> v(1000, 0, arena_allocator<int>(&arena));
+    EXPECT_EQ(arena.stats().upstream_allocations, upstream_allocs);
+  }
+  upstream.check_leaks();
+}
+
+TEST(MMTest, ArenaAllocatorNoArena) {
+  arena_vector<int> v;
+  for (int i = 0; i < 1000; i++)
+    v.push_back(i);
+  EXPECT_EQ(v.size(), 1000u);
+  EXPECT_EQ(v.back(), 999);
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
@@ -0,0 +1,94 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "dali/core/mm/callback_resource.h"
+#include "dali/core/mm/default_resources.h"
+#include "dali/core/cuda_stream.h"
+#include "dali/core/dev_buffer.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+namespace {
+
+int num_allocs = 0;
+int num_frees = 0;
+cudaStream_t last_stream = nullptr;
+
+void *TestAlloc(size_t size, int device_id, cudaStream_t stream) {
+  int dev = -1;
+  CUDA_CALL(cudaGetDevice(&dev));
+  EXPECT_EQ(dev, device_id);
+  void *ptr = nullptr;
+  if (cudaMalloc(&ptr, size) != cudaSuccess) {
+    (void)cudaGetLastError();
+    return nullptr;
+  }
+  num_allocs++;
+  last_stream = stream;
+  return ptr;
+}
+
+void TestFree(void *ptr, size_t size, int device_id, cudaStream_t stream) {
+  EXPECT_EQ(stream, last_stream);
+  num_frees++;
+  CUDA_CALL(cudaFree(ptr));
+}
+
+}  // namespace
+
+TEST(MMCallbackResource, StreamOrdered) {
+  num_allocs = num_frees = 0;
+  callback_device_resource rsrc(TestAlloc, TestFree, -1);
+  CUDAStream stream = CUDAStream::Create(true);
+  void *mem = rsrc.allocate_async(1000, 256, stream_view(stream));
+  ASSERT_NE(mem, nullptr);
+  EXPECT_EQ(last_stream, stream.get());
+  CUDA_CALL(cudaMemsetAsync(mem, 0, 1000, stream));
+  rsrc.deallocate_async(mem, 1000, 256, stream_view(stream));
+  EXPECT_EQ(num_allocs, 1);
+  EXPECT_EQ(num_frees, 1);
+
+  mem = rsrc.allocate(1000);
+  EXPECT_EQ(last_stream, nullptr) << "Synchronous allocations should use the default stream";
+  rsrc.deallocate(mem, 1000);
+  EXPECT_EQ(num_frees, 2);
+
+  EXPECT_THROW(rsrc.allocate(1000, 4096), std::bad_alloc)
+      << "The alignment above the guaranteed one should not be accepted";
+  EXPECT_THROW(rsrc.allocate(size_t(1) << 62), std::bad_alloc);
+}
+
+TEST(MMCallbackResource, AsDefaultDeviceResource) {
+  num_allocs = num_frees = 0;
+  int dev = 0;
+  CUDA_CALL(cudaGetDevice(&dev));
+  auto prev = ShareDefaultDeviceResource(dev);
+  SetDefaultDeviceResource(dev, std::make_shared<callback_device_resource>(TestAlloc, TestFree,
+                                                                          dev));
+  {
+    DeviceBuffer<float> buf;
+    buf.resize(1000);
+    EXPECT_EQ(num_allocs, 1);
+  }
+  EXPECT_EQ(num_frees, 1);
+  SetDefaultDeviceResource(dev, prev);
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
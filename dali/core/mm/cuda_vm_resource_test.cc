@@ -1,4 +1,4 @@
-// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -252,6 +252,45 @@ class VMResourceTest : public ::testing::Test {
     EXPECT_EQ(res.stat_.allocated_blocks, 6);
   }
 
+  void TestReleaseUnused() {
+    size_t block_size = 32_uz << 20;
+    memory_budget budget;
+    cuda_vm_resource res(-1, block_size, 0, &budget);
+    size_t size1 = 4*block_size + (4<<20);  // ends past 4 blocks
+    size_t size2 = 2*block_size;            // shares the 5th block with the first allocation
+    void *p1 = res.allocate(size1);
+    void *p2 = res.allocate(size2);
+    auto &region = res.va_regions_[0];
+    EXPECT_EQ(region.mapped.find(false), 7);
+    EXPECT_EQ(budget.used(), 7 * block_size);
+    EXPECT_EQ(res.release_unused(), 0u);
+
+    res.deallocate(p1, size1);
+    EXPECT_EQ(region.available_blocks, 4);
+    // only the blocks not shared with the other allocation are released
+    EXPECT_EQ(res.release_unused(), 4 * block_size);
+    EXPECT_EQ(region.available_blocks, 0);
+    EXPECT_EQ(region.mapped.find(true), 4);
+    EXPECT_EQ(region.mapped.find(false), 0);
+    EXPECT_EQ(res.stat_.allocated_blocks, 3);
+    EXPECT_EQ(budget.used(), 3 * block_size);
+
+    // the virtual address space is kept and mapped again
+    void *p3 = res.allocate(size1);
+    EXPECT_EQ(p3, p1);
+    EXPECT_EQ(region.mapped.find(false), 7);
+    EXPECT_EQ(res.stat_.allocated_blocks, 7);
+    CUDA_CALL(cudaMemset(p3, 0, size1));
+
+    res.deallocate(p2, size2);
+    res.deallocate(p3, size1);
+    EXPECT_EQ(res.release_unused(), 7 * block_size);
+    EXPECT_EQ(region.mapped.find(true), region.mapped.ssize());
+    EXPECT_EQ(res.stat_.allocated_blocks, 0);
+    EXPECT_EQ(res.stat_.curr_free, 0u);
+    EXPECT_EQ(budget.used(), 0u);
+  }
+
   std::mt19937_64 rng_{12345};
 };
 
@@ -401,6 +440,12 @@ TEST_F(VMResourceTest, ExceptionSafety) {
   this->TestExceptionSafety();
 }
 
+TEST_F(VMResourceTest, ReleaseUnused) {
+  if (!cuvm::IsSupported())
+    GTEST_SKIP() << "CUDA Virtual Memory Management not supported on this platform";
+  this->TestReleaseUnused();
+}
+
 }  // namespace test
 }  // namespace mm
 }  // namespace dali
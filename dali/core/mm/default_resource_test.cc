@@ -23,6 +23,7 @@
 #include "dali/core/cuda_error.h"
 #include "dali/core/device_guard.h"
 #include "dali/core/dev_buffer.h"
+#include "dali/core/os/numa.h"
 
 namespace dali {
 namespace mm {
@@ -165,6 +166,24 @@ TEST(MMDefaultResource, GetResource_MultiGPU) {
   }
 }
 
+TEST(MMDefaultResource, GetResource_Pinned_NUMA) {
+  int ndev = 0;
+  CUDA_CALL(cudaGetDeviceCount(&ndev));
+  DeviceGuard dg;
+  vector<pinned_async_resource*> resources(ndev, nullptr);
+  for (int i = 0; i < ndev; i++) {
+    CUDA_CALL(cudaSetDevice(i));
+    resources[i] = GetDefaultResource<memory_kind::pinned>();
+    ASSERT_NE(resources[i], nullptr);
+    EXPECT_EQ(GetDefaultResource<memory_kind::pinned>(), resources[i]);
+    // the devices attached to the same NUMA node share the pinned memory
+    for (int j = 0; j < i; j++) {
+      if (numa::DeviceNode(i) == numa::DeviceNode(j))
+        EXPECT_EQ(resources[i], resources[j]);
+    }
+  }
+}
+
 template <typename Kind, bool async = !std::is_same<Kind, memory_kind::host>::value>
 class DummyResource : public memory_resource<Kind> {
   void *do_allocate(size_t, size_t) override {
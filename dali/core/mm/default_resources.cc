@@ -12,17 +12,28 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <condition_variable>
 #include <stdexcept>
 #include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include "dali/core/mm/default_resources.h"
 #include "dali/core/error_handling.h"
 #include "dali/core/format.h"
+#include "dali/core/metrics.h"
 #include "dali/core/mm/malloc_resource.h"
 #include "dali/core/device_guard.h"
 #include "dali/core/mm/async_pool.h"
 #include "dali/core/mm/composite_resource.h"
 #include "dali/core/mm/cuda_vm_resource.h"
+#include "dali/core/mm/memory_budget.h"
 #include "dali/core/call_at_exit.h"
+#include "dali/core/os/numa.h"
 
 namespace dali {
 namespace mm {
@@ -52,6 +63,10 @@ struct DefaultResources {
 
   std::shared_ptr<host_memory_resource> host;
   std::shared_ptr<pinned_async_resource> pinned_async;
+  /// NUMA node + 1 -> pinned resource; the entry 0 is used by the devices with unknown node
+  std::unique_ptr<std::shared_ptr<pinned_async_resource>[]> pinned_numa;
+  /// device id -> NUMA node
+  std::unique_ptr<int[]> device_numa_node;
   std::shared_ptr<managed_async_resource> managed;
   std::unique_ptr<std::shared_ptr<device_async_resource>[]> device;
   int num_devices = 0;
@@ -59,6 +74,7 @@ struct DefaultResources {
 
   void ReleasePinned() {
     Release(pinned_async);
+    Release(pinned_numa);
   }
 
   void ReleaseManaged() {
@@ -88,6 +104,24 @@ struct DefaultResources {
     }
   }
 
+  void InitPinnedNUMAArray() {
+    if (!pinned_numa) {
+      std::lock_guard<std::mutex> lock(mtx);
+      if (!pinned_numa) {
+        int ndevs = 0;
+        CUDA_CALL(cudaGetDeviceCount(&ndevs));
+        decltype(device_numa_node) nodes(new int[ndevs]);
+        for (int i = 0; i < ndevs; i++)
+          nodes[i] = numa::DeviceNode(i);
+        decltype(pinned_numa) tmp(new std::shared_ptr<pinned_async_resource>[numa::NumNodes() + 1]);
+        std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+        device_numa_node = std::move(nodes);
+        std::atomic_thread_fence(std::memory_order::memory_order_seq_cst);
+        pinned_numa = std::move(tmp);
+      }
+    }
+  }
+
   void CheckDeviceIndex(int device_id) const {
     if (device_id < 0 || device_id >= num_devices) {
       throw std::out_of_range(make_string(device_id, " is not a valid CUDA device index. "
@@ -155,6 +189,17 @@ bool UsePinnedMemoryPool() {
   return value;
 }
 
+/**
+ * @brief Whether the default pinned memory is allocated on the NUMA node of the current device
+ */
+bool UseNUMAPinnedMemory() {
+  static bool value = []() {
+    const char *env = std::getenv("DALI_USE_NUMA_PINNED_MEM");
+    return (!env || atoi(env)) && numa::NumNodes() > 1;
+  }();
+  return value;
+}
+
 bool UseVMM() {
   static bool value = []() {
     const char *env = std::getenv("DALI_USE_VMM");
@@ -163,6 +208,203 @@ bool UseVMM() {
   return value;
 }
 
+/**
+ * @brief Reads a memory size, e.g. 512M or 2.5G, from an environment variable
+ */
+size_t MemoryBudgetFromEnv(const char *name) {
+  const char *env = std::getenv(name);
+  if (!env || !*env)
+    return memory_budget::unlimited;
+  char *end = nullptr;
+  double value = std::strtod(env, &end);
+  double multiplier = 1;
+  switch (*end) {
+    case 'k': case 'K': multiplier = 1 << 10; end++; break;
+    case 'm': case 'M': multiplier = 1 << 20; end++; break;
+    case 'g': case 'G': multiplier = 1 << 30; end++; break;
+    default: break;
+  }
+  if (end == env || *end || !(value >= 0))
+    throw std::invalid_argument(make_string("Invalid memory size in ", name, ": \"", env,
+        "\". Expected a number of bytes, optionally followed by k, M or G."));
+  return static_cast<size_t>(value * multiplier);
+}
+
+/**
+ * @brief The budgets are never destroyed, so that they outlive the resources, including
+ *        the ones abandoned at exit.
+ */
+memory_budget &DeviceMemoryBudget(int device_id) {
+  static auto *budgets = []() {
+    int ndevs = 0;
+    CUDA_CALL(cudaGetDeviceCount(&ndevs));
+    size_t limit = MemoryBudgetFromEnv("DALI_DEVICE_MEM_BUDGET");
+    auto *v = new std::vector<std::unique_ptr<memory_budget>>();
+    for (int i = 0; i < ndevs; i++)
+      v->push_back(std::make_unique<memory_budget>(limit));
+    return v;
+  }();
+  if (device_id < 0 || device_id >= static_cast<int>(budgets->size()))
+    throw std::out_of_range(make_string(device_id, " is not a valid CUDA device index."));
+  return *(*budgets)[device_id];
+}
+
+memory_budget &PinnedMemoryBudget() {
+  static auto *budget = new memory_budget(MemoryBudgetFromEnv("DALI_PINNED_MEM_BUDGET"));
+  return *budget;
+}
+
+/**
+ * @brief The time (in seconds) without allocations after which a default pool returns its
+ *        unused memory; 0 (the default) disables the trimming.
+ */
+double PoolTrimIdleTime() {
+  static double value = []() {
+    const char *env = std::getenv("DALI_MEM_TRIM_IDLE_TIME");
+    double t = env ? std::atof(env) : 0;
+    return t > 0 ? t : 0;
+  }();
+  return value;
+}
+
+/**
+ * @brief Keeps track of the default pools, so that their unused memory can be released
+ *        on request or, with DALI_MEM_TRIM_IDLE_TIME, after a period in which they're not used.
+ *        Also reports the free memory statistics of the pools.
+ */
+class UnusedMemoryReleaser {
+ public:
+  static UnusedMemoryReleaser &instance() {
+    static UnusedMemoryReleaser releaser;
+    return releaser;
+  }
+
+  ~UnusedMemoryReleaser() {
+    {
+      std::lock_guard<std::mutex> g(mtx_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    if (trimmer_.joinable())
+      trimmer_.join();
+  }
+
+  template <typename Pool>
+  void Add(const std::shared_ptr<Pool> &pool, std::string name) {
+    std::weak_ptr<Pool> weak = pool;
+    PoolEntry e;
+    e.name = std::move(name);
+    e.release = [weak](bool sync) -> size_t {
+      auto p = weak.lock();
+      if (!p)
+        return 0;
+      if (sync)
+        p->synchronize();
+      return p->release_unused();
+    };
+    e.num_allocations = [weak]() -> int64_t {
+      auto p = weak.lock();
+      return p ? static_cast<int64_t>(p->num_allocations()) : -1;
+    };
+    e.free_stats = [weak](free_list_stats &stats) {
+      auto p = weak.lock();
+      if (!p)
+        return false;
+      stats = p->free_stats();
+      return true;
+    };
+    std::lock_guard<std::mutex> g(mtx_);
+    pools_.push_back(std::move(e));
+    if (PoolTrimIdleTime() > 0 && !trimmer_.joinable())
+      trimmer_ = std::thread([this]() { TrimmerLoop(); });
+  }
+
+  size_t ReleaseAll() {
+    std::lock_guard<std::mutex> g(mtx_);
+    size_t released = 0;
+    for (auto &e : pools_)
+      released += e.release(true);
+    return released;
+  }
+
+  std::vector<pool_free_stat> FreeStats() {
+    std::lock_guard<std::mutex> g(mtx_);
+    std::vector<pool_free_stat> stats;
+    for (auto &e : pools_) {
+      pool_free_stat stat;
+      stat.pool = e.name;
+      if (e.free_stats(stat.free))
+        stats.push_back(std::move(stat));
+    }
+    return stats;
+  }
+
+ private:
+  struct PoolEntry {
+    std::string name;
+    std::function<size_t(bool sync)> release;
+    /// -1 when the pool no longer exists
+    std::function<int64_t()> num_allocations;
+    /// false when the pool no longer exists
+    std::function<bool(free_list_stats &)> free_stats;
+    int64_t last_allocations = 0;
+    bool trimmed = false;
+  };
+
+  /**
+   * @brief The pools in which no allocations were made since the previous check are trimmed,
+   *        once per period of inactivity.
+   */
+  void TrimmerLoop() {
+    auto period = std::chrono::duration<double>(PoolTrimIdleTime());
+    std::unique_lock<std::mutex> lock(mtx_);
+    while (!cv_.wait_for(lock, period, [&]() { return stop_; })) {
+      for (auto it = pools_.begin(); it != pools_.end(); ) {
+        int64_t n = it->num_allocations();
+        if (n < 0) {
+          it = pools_.erase(it);
+          continue;
+        }
+        if (n != it->last_allocations) {
+          it->last_allocations = n;
+          it->trimmed = false;
+        } else if (!it->trimmed) {
+          try {
+            it->release(false);
+            it->trimmed = true;
+          } catch (const std::exception &) {
+            // the trimming is an optimization - try again in the next period
+          }
+        }
+        ++it;
+      }
+    }
+  }
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::vector<PoolEntry> pools_;
+  std::thread trimmer_;
+  bool stop_ = false;
+};
+
+/**
+ * @brief When the budget is exceeded, the pool returns its unused memory, so that it can be
+ *        used by the other pools charged to the same budget.
+ *
+ * The pool is also registered in the UnusedMemoryReleaser.
+ */
+template <typename Pool>
+void AddReleaseUnusedHandler(memory_budget &budget, const std::shared_ptr<Pool> &pool,
+                             std::string name) {
+  std::weak_ptr<Pool> weak = pool;
+  budget.add_pressure_handler([weak]() {
+    if (auto p = weak.lock())
+      p->release_unused();
+  });
+  UnusedMemoryReleaser::instance().Add(pool, std::move(name));
+}
+
 inline std::shared_ptr<device_async_resource> CreateDefaultDeviceResource() {
   static CUDARTLoader CUDAInit;
   CUDAEventPool::instance();
@@ -170,33 +412,60 @@ inline std::shared_ptr<device_async_resource> CreateDefaultDeviceResource() {
     static auto rsrc = std::make_shared<mm::cuda_malloc_memory_resource>();
     return rsrc;
   }
+  int device_id = 0;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  auto &budget = DeviceMemoryBudget(device_id);
   #if DALI_USE_CUDA_VM_MAP
   if (cuvm::IsSupported() && UseVMM()) {
     using resource_type = mm::async_pool_resource<mm::memory_kind::device, cuda_vm_resource,
                                                   std::mutex, void>;
-    return std::make_shared<resource_type>();
+    auto rsrc = std::make_shared<resource_type>(-1, 0, 0, &budget);
+    AddReleaseUnusedHandler(budget, rsrc, make_string("device pool (VM, device ", device_id, ")"));
+    return rsrc;
   }
   #endif  // DALI_USE_CUDA_VM_MAP
   {
     static auto upstream = std::make_shared<mm::cuda_malloc_memory_resource>();
 
+    auto budgeted = std::make_shared<budget_resource<memory_kind::device>>(
+        upstream.get(), &budget, "device pool");
     using resource_type = mm::async_pool_resource<mm::memory_kind::device,
             pool_resource_base<memory_kind::device, coalescing_free_tree, spinlock>>;
-    auto rsrc = std::make_shared<resource_type>(upstream.get());
-    return make_shared_composite_resource(std::move(rsrc), upstream);
+    auto rsrc = std::make_shared<resource_type>(budgeted.get());
+    AddReleaseUnusedHandler(budget, rsrc, make_string("device pool (device ", device_id, ")"));
+    return make_shared_composite_resource(std::move(rsrc), upstream, std::move(budgeted));
   }
 }
 
-inline std::shared_ptr<pinned_async_resource> CreateDefaultPinnedResource() {
+inline std::shared_ptr<pinned_async_resource> CreateDefaultPinnedResource(int numa_node = -1) {
+  if (numa_node >= 0) {
+    // each node gets its own pool, so that the memory is never shared between the nodes
+    auto upstream = std::make_shared<pinned_malloc_memory_resource>(numa_node);
+    if (!UsePinnedMemoryPool())
+      return upstream;
+    auto budgeted = std::make_shared<budget_resource<memory_kind::pinned>>(
+        upstream.get(), &PinnedMemoryBudget(),
+        make_string("pinned pool (NUMA node ", numa_node, ")"));
+    using resource_type = mm::async_pool_resource<mm::memory_kind::pinned,
+        pool_resource_base<memory_kind::pinned, coalescing_free_tree, spinlock>>;
+    auto rsrc = std::make_shared<resource_type>(budgeted.get());
+    AddReleaseUnusedHandler(PinnedMemoryBudget(), rsrc,
+                            make_string("pinned pool (NUMA node ", numa_node, ")"));
+    return make_shared_composite_resource(std::move(rsrc), std::move(upstream),
+                                          std::move(budgeted));
+  }
   if (!UsePinnedMemoryPool()) {
     static auto upstream = std::make_shared<mm::pinned_malloc_memory_resource>();
     return upstream;
   }
   static auto upstream = std::make_shared<pinned_malloc_memory_resource>();
+  auto budgeted = std::make_shared<budget_resource<memory_kind::pinned>>(
+      upstream.get(), &PinnedMemoryBudget(), "pinned pool");
   using resource_type = mm::async_pool_resource<mm::memory_kind::pinned,
       pool_resource_base<memory_kind::pinned, coalescing_free_tree, spinlock>>;
-  auto rsrc = std::make_shared<resource_type>(upstream.get());
-  return make_shared_composite_resource(std::move(rsrc), upstream);
+  auto rsrc = std::make_shared<resource_type>(budgeted.get());
+  AddReleaseUnusedHandler(PinnedMemoryBudget(), rsrc, "pinned pool");
+  return make_shared_composite_resource(std::move(rsrc), upstream, std::move(budgeted));
 }
 
 inline std::shared_ptr<managed_async_resource> CreateDefaultManagedResource() {
@@ -218,8 +487,33 @@ const std::shared_ptr<host_memory_resource> &ShareDefaultResourceImpl<memory_kin
   return g_resources.host;
 }
 
+/**
+ * @brief Returns the pinned resource for the NUMA node of the current device
+ */
+const std::shared_ptr<pinned_async_resource> &ShareDefaultPinnedNUMAResourceImpl() {
+  static CUDARTLoader init_cuda;  // force initialization of CUDA before creating the resource
+  g_resources.InitPinnedNUMAArray();
+  int device_id = 0;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  int node = g_resources.device_numa_node[device_id];
+  auto &rsrc = g_resources.pinned_numa[node + 1];
+  if (!rsrc) {
+    std::lock_guard<std::mutex> lock(g_resources.mtx);
+    if (!rsrc) {
+      rsrc = CreateDefaultPinnedResource(node);
+      static auto cleanup = AtScopeExit([] {
+        g_resources.ReleasePinned();
+      });
+    }
+  }
+  return rsrc;
+}
+
 template <>
 const std::shared_ptr<pinned_async_resource> &ShareDefaultResourceImpl<memory_kind::pinned>() {
+  // the resource set by the user takes precedence over the per-node ones
+  if (!g_resources.pinned_async && UseNUMAPinnedMemory())
+    return ShareDefaultPinnedNUMAResourceImpl();
   if (!g_resources.pinned_async) {
     std::lock_guard<std::mutex> lock(g_resources.mtx);
     if (!g_resources.pinned_async) {
@@ -364,5 +658,40 @@ device_async_resource *GetDefaultDeviceResource(int device_id) {
   return ShareDefaultDeviceResourceImpl(device_id).get();
 }
 
+DLL_PUBLIC
+memory_budget &GetDeviceMemoryBudget(int device_id) {
+  if (device_id < 0) {
+    CUDA_CALL(cudaGetDevice(&device_id));
+  }
+  return DeviceMemoryBudget(device_id);
+}
+
+DLL_PUBLIC
+memory_budget &GetPinnedMemoryBudget() {
+  return PinnedMemoryBudget();
+}
+
+DLL_PUBLIC
+size_t ReleaseUnusedMemory() {
+  return UnusedMemoryReleaser::instance().ReleaseAll();
+}
+
+DLL_PUBLIC
+std::vector<pool_free_stat> GetPoolFreeStats() {
+  return UnusedMemoryReleaser::instance().FreeStats();
+}
+
+namespace {
+
+metrics::CollectorHandle pool_metrics_collector([](std::vector<metrics::MetricSample> &samples) {
+  for (auto &stat : GetPoolFreeStats()) {
+    samples.push_back({"dali_memory_pool_free_bytes", "The free memory held by a memory pool",
+                       metrics::MetricType::Gauge, {{"pool", stat.pool}},
+                       static_cast<double>(stat.free.free_bytes)});
+  }
+});
+
+}  // namespace
+
 }  // namespace mm
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -214,6 +214,55 @@ TEST(MMCoalescingFreeTree, RemoveIf) {
   TestCoalescingRemoveIf<coalescing_free_tree>();
 }
 
+template <typename FreeList>
+void TestCoalescingStats() {
+  FreeList fl;
+  char a alignas(16)[1000];
+  auto stats = fl.stats();
+  EXPECT_EQ(stats.free_bytes, 0u);
+  EXPECT_EQ(stats.fragmentation(), 0);
+
+  fl.put(a, 100);
+  fl.put(a + 200, 300);
+  stats = fl.stats();
+  EXPECT_EQ(stats.free_bytes, 400u);
+  EXPECT_EQ(stats.free_blocks, 2u);
+  EXPECT_EQ(stats.largest_block, 300u);
+  EXPECT_DOUBLE_EQ(stats.fragmentation(), 0.25);
+
+  fl.put(a + 100, 100);  // joins the blocks
+  stats = fl.stats();
+  EXPECT_EQ(stats.free_bytes, 500u);
+  EXPECT_EQ(stats.free_blocks, 1u);
+  EXPECT_EQ(stats.largest_block, 500u);
+  EXPECT_EQ(stats.fragmentation(), 0);
+
+  EXPECT_EQ(fl.get(50, 1), a);
+  stats = fl.stats();
+  EXPECT_EQ(stats.free_bytes, 450u);
+  EXPECT_EQ(stats.largest_block, 450u);
+}
+
+TEST(MMCoalescingFreeList, Stats) {
+  TestCoalescingStats<coalescing_free_list>();
+}
+
+TEST(MMCoalescingFreeTree, Stats) {
+  TestCoalescingStats<coalescing_free_tree>();
+}
+
+TEST(MMBestFitFreeTree, Stats) {
+  best_fit_free_tree fl;
+  char a alignas(16)[1000];
+  fl.put(a, 100);
+  fl.put(a + 100, 300);
+  auto stats = fl.stats();
+  EXPECT_EQ(stats.free_bytes, 400u);
+  EXPECT_EQ(stats.free_blocks, 2u);  // not joined
+  EXPECT_EQ(stats.largest_block, 300u);
+  EXPECT_DOUBLE_EQ(stats.fragmentation(), 0.25);
+}
+
 TEST(MMCoalescingFreeTree, Contains) {
   coalescing_free_tree fl;
   char a alignas(16)[4000];
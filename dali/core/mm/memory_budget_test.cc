@@ -0,0 +1,127 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "dali/core/mm/memory_budget.h"
+#include "dali/core/mm/mm_test_utils.h"
+#include "dali/core/mm/pool_resource.h"
+#include "dali/core/spinlock.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMMemoryBudget, ChargeAndRelease) {
+  memory_budget budget(1000);
+  int a = budget.add_component("a");
+  int b = budget.add_component("b");
+  EXPECT_TRUE(budget.try_charge(a, 600));
+  EXPECT_TRUE(budget.try_charge(b, 300));
+  EXPECT_FALSE(budget.try_charge(b, 200));
+  EXPECT_FALSE(budget.charge(b, 200)) << "No handlers - the charge must fail";
+  budget.release(a, 600);
+  EXPECT_TRUE(budget.try_charge(b, 200));
+  EXPECT_EQ(budget.used(), 500u);
+  EXPECT_EQ(budget.peak(), 900u);
+
+  auto stats = budget.stats();
+  ASSERT_EQ(stats.size(), 2u);
+  EXPECT_EQ(stats[0].component, "a");
+  EXPECT_EQ(stats[0].current, 0u);
+  EXPECT_EQ(stats[0].peak, 600u);
+  EXPECT_EQ(stats[1].component, "b");
+  EXPECT_EQ(stats[1].current, 500u);
+  EXPECT_EQ(stats[1].peak, 500u);
+  budget.release(b, 500);
+}
+
+TEST(MMMemoryBudget, PressureHandlers) {
+  memory_budget budget(1000);
+  int c = budget.add_component("c");
+  ASSERT_TRUE(budget.try_charge(c, 900));
+  std::vector<int> calls;
+  budget.add_pressure_handler([&]() { calls.push_back(2); }, 2);
+  budget.add_pressure_handler([&]() { calls.push_back(0); budget.release(c, 100); });
+  int id = budget.add_pressure_handler([&]() { calls.push_back(1); budget.release(c, 100); }, 1);
+  budget.add_pressure_handler([&]() { calls.push_back(3); }, 3);
+
+  // the handlers are called in the order of priority, until the charge fits
+  EXPECT_TRUE(budget.charge(c, 250));
+  EXPECT_EQ(calls, (std::vector<int>{0, 1}));
+  EXPECT_EQ(budget.used(), 950u);
+
+  calls.clear();
+  budget.remove_pressure_handler(id);
+  EXPECT_FALSE(budget.charge(c, 200));
+  EXPECT_EQ(calls, (std::vector<int>{0, 2, 3}));
+  EXPECT_EQ(budget.used(), 850u);
+  budget.release(c, 850);
+}
+
+TEST(MMMemoryBudget, PoolsReleaseUnusedMemory) {
+  using pool_t = pool_resource_base<memory_kind::host, coalescing_free_tree, spinlock>;
+  test_host_resource upstream;
+  memory_budget budget(1 << 20);
+  budget_resource<memory_kind::host> upstream1(&upstream, &budget, "pool1");
+  budget_resource<memory_kind::host> upstream2(&upstream, &budget, "pool2");
+  auto opt = default_host_pool_opts();
+  opt.min_block_size = 1 << 16;
+  pool_t pool1(&upstream1, opt), pool2(&upstream2, opt);
+  budget.add_pressure_handler([&]() { pool1.release_unused(); });
+  budget.add_pressure_handler([&]() { pool2.release_unused(); });
+
+  size_t size = 600 << 10;
+  void *mem1 = pool1.allocate(size, 64);
+  pool1.deallocate(mem1, size, 64);
+  EXPECT_GE(budget.used(), size) << "The pool should keep the memory";
+
+  // the unused memory of pool1 is released to make room for the one of pool2
+  void *mem2 = nullptr;
+  ASSERT_NO_THROW(mem2 = pool2.allocate(size, 64));
+  EXPECT_LE(budget.used(), budget.limit());
+
+  // nothing left to release
+  EXPECT_THROW(pool1.allocate(size, 64), std::bad_alloc);
+  pool2.deallocate(mem2, size, 64);
+  EXPECT_NO_THROW(mem1 = pool1.allocate(size, 64));
+  pool1.deallocate(mem1, size, 64);
+
+  auto stats = budget.stats();
+  ASSERT_EQ(stats.size(), 2u);
+  EXPECT_GE(stats[0].peak, size);
+  EXPECT_GE(stats[1].peak, size);
+}
+
+TEST(MMMemoryBudget, UpstreamOutOfMemory) {
+  test_host_resource upstream;
+  memory_budget budget;
+  budget_resource<memory_kind::host> rsrc(&upstream, &budget, "test");
+  int handler_calls = 0;
+  budget.add_pressure_handler([&]() {
+    handler_calls++;
+    upstream.simulate_out_of_memory(false);
+  });
+  upstream.simulate_out_of_memory(true);
+  void *mem = nullptr;
+  ASSERT_NO_THROW(mem = rsrc.allocate(1000));
+  EXPECT_EQ(handler_calls, 1);
+  EXPECT_EQ(budget.used(), 1000u);
+  rsrc.deallocate(mem, 1000);
+  EXPECT_EQ(budget.used(), 0u);
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
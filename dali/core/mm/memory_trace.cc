@@ -0,0 +1,193 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/core/mm/memory_trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include "dali/core/access_order.h"
+
+namespace dali {
+namespace mm {
+
+namespace {
+
+int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char *kind_name(memory_kind_id kind) {
+  switch (kind) {
+    case memory_kind_id::host:
+      return "host";
+    case memory_kind_id::pinned:
+      return "pinned";
+    case memory_kind_id::device:
+      return "device";
+    case memory_kind_id::managed:
+      return "managed";
+    default:
+      return "unknown";
+  }
+}
+
+}  // namespace
+
+metrics::Counter &allocated_memory_metric(memory_kind_id kind) {
+  static metrics::Counter *counters[memory_kind_id::count] = {};
+  static std::once_flag once;
+  std::call_once(once, []() {
+    for (int k = 0; k < memory_kind_id::count; k++) {
+      counters[k] = &metrics::GetGauge(
+          "dali_memory_allocated_bytes", "The memory allocated by DALI, per kind",
+          {{"kind", kind_name(static_cast<memory_kind_id>(k))}});
+    }
+  });
+  return *counters[kind];
+}
+
+namespace {
+
+void write_json_string(std::ostream &os, const char *str) {
+  os << '"';
+  for (; *str; str++) {
+    char c = *str;
+    if (c == '"' || c == '\\')
+      os << '\\' << c;
+    else if (static_cast<unsigned char>(c) >= 0x20)
+      os << c;
+  }
+  os << '"';
+}
+
+}  // namespace
+
+std::atomic<bool> alloc_tracer::enabled_{false};
+
+alloc_tracer &alloc_tracer::instance() {
+  static alloc_tracer tracer;
+  return tracer;
+}
+
+const char *&alloc_trace_owner::current() noexcept {
+  static thread_local const char *owner = nullptr;
+  return owner;
+}
+
+void alloc_tracer::start(size_t capacity) {
+  std::lock_guard<spinlock> g(lock_);
+  ring_.clear();
+  ring_.resize(std::max<size_t>(capacity, 1));
+  next_ = 0;
+  total_ = 0;
+  start_time_ = now_ns();
+  enabled_ = true;
+}
+
+void alloc_tracer::stop() {
+  enabled_ = false;
+}
+
+void alloc_tracer::record(alloc_trace_event::event_type type, memory_kind_id kind,
+                          const void *ptr, size_t size, cudaStream_t stream) {
+  if (!ptr)
+    return;
+  const char *owner = alloc_trace_owner::current();
+  int64_t time = now_ns();
+  std::lock_guard<spinlock> g(lock_);
+  if (!enabled_ || ring_.empty())
+    return;
+  auto &e = ring_[next_];
+  e.timestamp = time - start_time_;
+  e.ptr = ptr;
+  e.size = size;
+  e.stream = stream;
+  e.kind = kind;
+  e.type = type;
+  if (owner) {
+    std::strncpy(e.owner, owner, alloc_trace_event::kMaxOwnerLength);
+    e.owner[alloc_trace_event::kMaxOwnerLength] = '\0';
+  } else {
+    e.owner[0] = '\0';
+  }
+  if (++next_ == ring_.size())
+    next_ = 0;
+  total_++;
+}
+
+std::vector<alloc_trace_event> alloc_tracer::events() const {
+  std::lock_guard<spinlock> g(lock_);
+  std::vector<alloc_trace_event> ret;
+  size_t n = std::min(total_, ring_.size());
+  ret.reserve(n);
+  size_t first = total_ > ring_.size() ? next_ : 0;
+  for (size_t i = 0; i < n; i++)
+    ret.push_back(ring_[(first + i) % ring_.size()]);
+  return ret;
+}
+
+size_t alloc_tracer::dropped() const {
+  std::lock_guard<spinlock> g(lock_);
+  return total_ > ring_.size() ? total_ - ring_.size() : 0;
+}
+
+void alloc_tracer::write_chrome_trace(std::ostream &os) const {
+  auto trace = events();
+  os << "{\"traceEvents\":[";
+  // one "thread" per memory kind
+  for (int k = 0; k < memory_kind_id::count; k++) {
+    os << (k ? "," : "") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << k
+       << ",\"args\":{\"name\":\"" << kind_name(static_cast<memory_kind_id>(k)) << "\"}}";
+  }
+  // the memory in use counts only the allocations made while tracing
+  std::unordered_map<const void *, size_t> live;
+  size_t in_use[memory_kind_id::count] = {};
+  for (auto &e : trace) {
+    double ts = e.timestamp * 1e-3;  // microseconds
+    os << ",\n{\"name\":\"" << (e.type == alloc_trace_event::alloc ? "alloc" : "free")
+       << "\",\"cat\":\"memory\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0,\"tid\":" << e.kind
+       << ",\"ts\":" << ts << ",\"args\":{\"size\":" << e.size
+       << ",\"ptr\":\"" << e.ptr << "\",\"stream\":";
+    if (e.stream == AccessOrder::host_sync_stream())
+      os << "\"host\"";
+    else
+      os << "\"" << static_cast<const void *>(e.stream) << "\"";
+    os << ",\"owner\":";
+    write_json_string(os, e.owner);
+    os << "}}";
+
+    if (e.type == alloc_trace_event::alloc) {
+      live[e.ptr] = e.size;
+      in_use[e.kind] += e.size;
+    } else {
+      auto it = live.find(e.ptr);
+      if (it == live.end())
+        continue;
+      in_use[e.kind] -= it->second;
+      live.erase(it);
+    }
+    os << ",\n{\"name\":\"" << kind_name(e.kind) << " memory in use\",\"ph\":\"C\",\"pid\":0"
+       << ",\"ts\":" << ts << ",\"args\":{\"bytes\":" << in_use[e.kind] << "}}";
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":" << dropped()
+     << "}}\n";
+}
+
+}  // namespace mm
+}  // namespace dali
@@ -0,0 +1,92 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "dali/core/mm/memory.h"
+#include "dali/core/mm/memory_trace.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMAllocTrace, RecordsAllocations) {
+  auto &tracer = alloc_tracer::instance();
+  tracer.start(16);
+  auto a = [&]() {
+    alloc_trace_owner owner("test_op");
+    return alloc_raw_unique<char, memory_kind::host>(100);
+  }();
+  auto b = alloc_raw_unique<char, memory_kind::host>(200);
+  const void *a_ptr = a.get();
+  a.reset();
+  tracer.stop();
+  b.reset();  // not recorded
+
+  auto events = tracer.events();
+  ASSERT_EQ(events.size(), 3u);
+  EXPECT_EQ(events[0].type, alloc_trace_event::alloc);
+  EXPECT_EQ(events[0].ptr, a_ptr);
+  EXPECT_EQ(events[0].size, 100u);
+  EXPECT_EQ(events[0].kind, memory_kind_id::host);
+  EXPECT_STREQ(events[0].owner, "test_op");
+  EXPECT_EQ(events[1].type, alloc_trace_event::alloc);
+  EXPECT_EQ(events[1].size, 200u);
+  EXPECT_STREQ(events[1].owner, "");
+  EXPECT_EQ(events[2].type, alloc_trace_event::free);
+  EXPECT_EQ(events[2].ptr, a_ptr);
+  for (size_t i = 1; i < events.size(); i++)
+    EXPECT_GE(events[i].timestamp, events[i - 1].timestamp);
+  EXPECT_EQ(tracer.dropped(), 0u);
+
+  std::stringstream ss;
+  tracer.write_chrome_trace(ss);
+  std::string json = ss.str();
+  EXPECT_NE(json.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(json.find("\"owner\":\"test_op\""), std::string::npos);
+  EXPECT_NE(json.find("\"host memory in use\""), std::string::npos);
+  EXPECT_NE(json.find("\"bytes\":300"), std::string::npos);
+}
+
+TEST(MMAllocTrace, RingBuffer) {
+  auto &tracer = alloc_tracer::instance();
+  tracer.start(2);
+  std::vector<uptr<char>> bufs;
+  for (int i = 1; i <= 3; i++)
+    bufs.push_back(alloc_raw_unique<char, memory_kind::host>(i * 10));
+  tracer.stop();
+  auto events = tracer.events();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].size, 20u);
+  EXPECT_EQ(events[1].size, 30u);
+  EXPECT_EQ(tracer.dropped(), 1u);
+}
+
+TEST(MMAllocTrace, Disabled) {
+  auto &tracer = alloc_tracer::instance();
+  tracer.start(16);
+  tracer.stop();
+  EXPECT_FALSE(alloc_tracer::enabled());
+  alloc_trace_owner owner("test_op");
+  EXPECT_EQ(alloc_trace_owner::current(), nullptr);
+  auto buf = alloc_raw_unique<char, memory_kind::host>(100);
+  EXPECT_TRUE(tracer.events().empty());
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
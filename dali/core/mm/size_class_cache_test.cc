@@ -0,0 +1,94 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "dali/core/mm/detail/size_class_cache.h"
+
+namespace dali {
+namespace mm {
+namespace test {
+
+TEST(MMSizeClassCache, ClassSizes) {
+  using cache = size_class_cache;
+  EXPECT_EQ(cache::class_size(cache::class_index(1)), 256u);
+  EXPECT_EQ(cache::class_size(cache::class_index(256)), 256u);
+  EXPECT_EQ(cache::class_size(cache::class_index(257)), 320u);
+  EXPECT_EQ(cache::class_size(cache::class_index(512)), 512u);
+  EXPECT_EQ(cache::class_size(cache::class_index(1000)), 1024u);
+  EXPECT_EQ(cache::class_size(cache::class_index(1025)), 1280u);
+  for (size_t size = 1; size < (1 << 20); size = size * 3 / 2 + 1) {
+    int c = cache::class_index(size);
+    EXPECT_GE(cache::class_size(c), size);
+    if (c > 0)
+      EXPECT_LT(cache::class_size(c - 1), size);
+    // the rounding wastes at most a quarter of the allocation
+    EXPECT_LE(cache::class_size(c), std::max<size_t>(size + size / 4, 256u));
+    if (size >= 256) {
+      int f = cache::floor_class_index(size);
+      EXPECT_LE(cache::class_size(f), size);
+      EXPECT_GT(cache::class_size(f + 1), size);
+    }
+  }
+  EXPECT_EQ(cache::floor_class_index(255), -1);
+}
+
+TEST(MMSizeClassCache, PutGet) {
+  size_class_cache cache(1 << 20);
+  std::vector<size_class_cache::block> evicted;
+  auto evict = [&](size_class_cache::block b) { evicted.push_back(b); };
+  char a, b, c;
+  cache.put(&a, 1000, evict);
+  cache.put(&b, 4096, evict);
+  cache.put(&c, 100, evict);  // too small to be cached
+  ASSERT_EQ(evicted.size(), 1u);
+  EXPECT_EQ(evicted[0].mem, &c);
+  EXPECT_EQ(cache.bytes(), 5096u);
+
+  // 1000 bytes fall into the class of 896 bytes, which is too small for 1000 bytes
+  EXPECT_EQ(cache.get(1000).mem, nullptr);
+  EXPECT_EQ(cache.get(800).mem, &a);
+  // more than twice the requested size - not reused
+  EXPECT_EQ(cache.get(1500).mem, nullptr);
+  auto blk = cache.get(2500);
+  EXPECT_EQ(blk.mem, &b);
+  EXPECT_EQ(blk.size, 4096u);
+  EXPECT_EQ(cache.bytes(), 0u);
+  EXPECT_EQ(cache.peak_bytes(), 5096u);
+}
+
+TEST(MMSizeClassCache, EvictLargestFirst) {
+  size_class_cache cache(10000);
+  std::vector<void *> evicted;
+  auto evict = [&](size_class_cache::block b) { evicted.push_back(b.mem); };
+  char a, b, c, d;
+  cache.put(&a, 3000, evict);
+  cache.put(&b, 6000, evict);
+  EXPECT_TRUE(evicted.empty());
+  cache.put(&c, 2000, evict);
+  EXPECT_EQ(evicted, std::vector<void *>{&b});
+  cache.put(&d, 20000, evict);  // larger than the capacity
+  EXPECT_EQ(evicted, (std::vector<void *>{&b, &d}));
+  EXPECT_EQ(cache.bytes(), 5000u);
+
+  cache.trim(2500, evict);
+  EXPECT_EQ(evicted, (std::vector<void *>{&b, &d, &a}));
+  cache.set_capacity(0, evict);
+  EXPECT_EQ(evicted, (std::vector<void *>{&b, &d, &a, &c}));
+  EXPECT_EQ(cache.bytes(), 0u);
+}
+
+}  // namespace test
+}  // namespace mm
+}  // namespace dali
@@ -0,0 +1,141 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/core/os/numa.h"
+#include <cuda_runtime_api.h>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace dali {
+namespace numa {
+
+namespace {
+
+constexpr int kMaxNodes = 1024;
+
+/**
+ * @brief Parses a node list, e.g. "0-3" or "0,2", and returns the highest node index + 1
+ */
+int ParseNodeCount(const std::string &list) {
+  int count = 0, value = 0;
+  bool has_value = false;
+  for (char c : list) {
+    if (std::isdigit(static_cast<unsigned char>(c))) {
+      value = value * 10 + (c - '0');
+      has_value = true;
+    } else {
+      if (has_value)
+        count = std::max(count, value + 1);
+      value = 0;
+      has_value = false;
+    }
+  }
+  if (has_value)
+    count = std::max(count, value + 1);
+  return count;
+}
+
+int ReadNumNodes() {
+  std::ifstream f("/sys/devices/system/node/possible");
+  std::string list;
+  if (!f || !std::getline(f, list))
+    return 1;
+  return std::max(ParseNodeCount(list), 1);
+}
+
+int ReadDeviceNode(int device_id) {
+  char bus_id[32] = {};
+  if (cudaDeviceGetPCIBusId(bus_id, sizeof(bus_id), device_id) != cudaSuccess) {
+    (void)cudaGetLastError();
+    return -1;
+  }
+  std::string id = bus_id;
+  std::transform(id.begin(), id.end(), id.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  std::ifstream f("/sys/bus/pci/devices/" + id + "/numa_node");
+  int node = -1;
+  if (!f || !(f >> node))
+    return -1;
+  return node < NumNodes() ? node : -1;
+}
+
+}  // namespace
+
+int NumNodes() {
+  static const int num_nodes = ReadNumNodes();
+  return num_nodes;
+}
+
+int DeviceNode(int device_id) {
+  if (device_id < 0)
+    return -1;
+  static std::mutex mtx;
+  static std::unordered_map<int, int> nodes;
+  std::lock_guard<std::mutex> g(mtx);
+  auto it = nodes.find(device_id);
+  if (it == nodes.end())
+    it = nodes.emplace(device_id, ReadDeviceNode(device_id)).first;
+  return it->second;
+}
+
+#if defined(__linux__)
+
+bool SetPreferredNode(int node) {
+  constexpr int kBits = 8 * sizeof(unsigned long);  // NOLINT
+  if (node >= NumNodes())
+    return false;
+  if (node < 0)
+    return syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0) == 0;
+  unsigned long mask[kMaxNodes / kBits] = {};  // NOLINT
+  mask[node / kBits] = 1ul << (node % kBits);
+  return syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask, node + 2) == 0;
+}
+
+PreferredNodeScope::PreferredNodeScope(int node) {
+  if (node < 0 || NumNodes() < 2)
+    return;
+  if (syscall(SYS_get_mempolicy, &prev_mode_, prev_mask_, kMaxNodes + 1, nullptr, 0) != 0)
+    return;
+  active_ = SetPreferredNode(node);
+}
+
+PreferredNodeScope::~PreferredNodeScope() {
+  if (active_)
+    syscall(SYS_set_mempolicy, prev_mode_, prev_mask_, kMaxNodes + 1);
+}
+
+#else
+
+bool SetPreferredNode(int) {
+  return false;
+}
+
+PreferredNodeScope::PreferredNodeScope(int) {}
+
+PreferredNodeScope::~PreferredNodeScope() = default;
+
+#endif
+
+}  // namespace numa
+}  // namespace dali
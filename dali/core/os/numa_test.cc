@@ -0,0 +1,70 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cuda_runtime_api.h>
+#include "dali/core/os/numa.h"
+#include "dali/core/cuda_error.h"
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace dali {
+namespace numa {
+namespace test {
+
+TEST(NUMA, DeviceNode) {
+  int num_nodes = NumNodes();
+  EXPECT_GE(num_nodes, 1);
+  EXPECT_EQ(DeviceNode(-1), -1);
+  int ndev = 0;
+  CUDA_CALL(cudaGetDeviceCount(&ndev));
+  for (int i = 0; i < ndev; i++) {
+    int node = DeviceNode(i);
+    EXPECT_GE(node, -1);
+    EXPECT_LT(node, num_nodes);
+    EXPECT_EQ(DeviceNode(i), node) << "The node should not change";
+  }
+}
+
+#if defined(__linux__)
+
+TEST(NUMA, PreferredNodeScope) {
+  if (NumNodes() < 2)
+    GTEST_SKIP() << "At least 2 NUMA nodes needed for the test";
+  auto get_mode = []() {
+    int mode = -1;
+    EXPECT_EQ(syscall(SYS_get_mempolicy, &mode, nullptr, 0, nullptr, 0), 0);
+    return mode;
+  };
+  int prev_mode = get_mode();
+  {
+    PreferredNodeScope scope(NumNodes() - 1);
+    EXPECT_EQ(get_mode(), MPOL_PREFERRED);
+  }
+  EXPECT_EQ(get_mode(), prev_mode);
+  {
+    PreferredNodeScope scope(-1);
+    EXPECT_EQ(get_mode(), prev_mode);
+  }
+}
+
+#endif
+
+}  // namespace test
+}  // namespace numa
+}  // namespace dali
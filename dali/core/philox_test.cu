@@ -0,0 +1,88 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/core/philox.h"  // NOLINT
+#include <gtest/gtest.h>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/dev_buffer.h"
+#include "dali/core/util.h"
+
+namespace dali {
+
+TEST(Philox4x32_10, KnownAnswers) {
+  // test vectors from the Random123 library
+  struct {
+    uint32_t counter[4];
+    uint32_t key[2];
+    uint32_t out[4];
+  } vectors[] = {
+    { { 0, 0, 0, 0 }, { 0, 0 }, { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 } },
+    { { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, { 0xffffffff, 0xffffffff },
+      { 0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd } },
+    { { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 }, { 0xa4093822, 0x299f31d0 },
+      { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 } },
+  };
+  for (auto &v : vectors) {
+    uint32_t out[4];
+    Philox4x32_10::Block(out, v.counter, v.key);
+    for (int i = 0; i < 4; i++)
+      EXPECT_EQ(out[i], v.out[i]);
+  }
+}
+
+TEST(Philox4x32_10, Sequence) {
+  uint64_t key = 0x299f31d0a4093822_u64;
+  uint64_t subsequence = 0x037073441319_u64;
+  Philox4x32_10 rng(key, subsequence, 0xffffffff);
+  uint32_t counter[4] = { 0xffffffff, 0, 0x73441319, 0x0370 };
+  uint32_t key_words[2] = { 0xa4093822, 0x299f31d0 };
+  for (int block = 0; block < 3; block++) {
+    uint32_t out[4];
+    Philox4x32_10::Block(out, counter, key_words);
+    for (int i = 0; i < 4; i++)
+      EXPECT_EQ(rng(), out[i]) << " at block " << block << " word " << i;
+    // the offset is a 64-bit number in the two lower words of the counter
+    if (++counter[0] == 0)
+      counter[1]++;
+  }
+}
+
+__global__ void PhiloxKernel(uint32_t *out, uint64_t key, int n, int per_element) {
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= n)
+    return;
+  Philox4x32_10 rng(key, i);
+  for (int j = 0; j < per_element; j++)
+    out[i * per_element + j] = rng();
+}
+
+TEST(Philox4x32_10, HostDeviceEquality) {
+  const int n = 1000, per_element = 7;
+  const uint64_t key = splitmix64(1234);
+  DeviceBuffer<uint32_t> gpu;
+  gpu.resize(n * per_element);
+  PhiloxKernel<<<div_ceil(n, 256), 256>>>(gpu.data(), key, n, per_element);
+  CUDA_CALL(cudaGetLastError());
+  std::vector<uint32_t> from_gpu(n * per_element);
+  CUDA_CALL(cudaMemcpy(from_gpu.data(), gpu.data(), n * per_element * sizeof(uint32_t),
+                       cudaMemcpyDeviceToHost));
+  for (int i = 0; i < n; i++) {
+    Philox4x32_10 rng(key, i);
+    for (int j = 0; j < per_element; j++)
+      ASSERT_EQ(from_gpu[i * per_element + j], rng()) << " at element " << i << ", " << j;
+  }
+}
+
+}  // namespace dali
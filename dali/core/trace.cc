@@ -0,0 +1,429 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/core/trace.h"
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_event_pool.h"
+
+namespace dali {
+
+namespace {
+
+void WriteJsonString(std::ostream &os, const char *str) {
+  os << '"';
+  for (; *str; str++) {
+    char c = *str;
+    if (c == '"' || c == '\\')
+      os << '\\' << c;
+    else if (static_cast<unsigned char>(c) >= 0x20)
+      os << c;
+  }
+  os << '"';
+}
+
+struct TraceChunk {
+  static constexpr int kSize = 4096;
+  TraceRecord records[kSize];
+  /// The number of the complete records; the owner thread publishes them with a release store
+  std::atomic<int> count{0};
+  std::atomic<TraceChunk *> next{nullptr};
+};
+
+/**
+ * @brief The events of one thread
+ *
+ * The records are appended by the owner thread only. The chunk list is replaced (when a new
+ * session starts) only with the tracer's lock held, which is also held while exporting.
+ */
+struct ThreadTrace {
+  ThreadTrace() : head(new TraceChunk()), tail(head) {}
+
+  ~ThreadTrace() {
+    FreeChunks();
+  }
+
+  void FreeChunks() {
+    for (TraceChunk *c = head; c;) {
+      TraceChunk *next = c->next.load(std::memory_order_acquire);
+      delete c;
+      c = next;
+    }
+    head = tail = nullptr;
+  }
+
+  TraceChunk *head, *tail;
+  int64_t recorded = 0;
+  int64_t session = -1;
+  std::atomic<int64_t> dropped{0};
+  int64_t tid = 0;
+  std::string name;
+  bool alive = true;
+};
+
+/// The name set with `Tracer::SetThreadName` before the thread registered its buffer
+thread_local char tl_thread_name[64] = "";
+
+constexpr int kMaxDevices = 64;
+
+}  // namespace
+
+class Tracer::Impl {
+ public:
+  struct ThreadHandle {
+    ~ThreadHandle() {
+      if (trace) {
+        std::lock_guard<std::mutex> g(impl->mutex);
+        trace->alive = false;
+      }
+    }
+    Impl *impl = nullptr;
+    std::shared_ptr<ThreadTrace> trace;
+  };
+
+  ThreadTrace &ThisThread() {
+    static thread_local ThreadHandle handle;
+    if (!handle.trace) {
+      auto trace = std::make_shared<ThreadTrace>();
+      trace->tid = syscall(SYS_gettid);
+      trace->name = tl_thread_name;
+      std::lock_guard<std::mutex> g(mutex);
+      threads.push_back(trace);
+      handle.impl = this;
+      handle.trace = std::move(trace);
+    }
+    return *handle.trace;
+  }
+
+  /// Discards the records of the previous session; called by the owner thread
+  void ResetThread(ThreadTrace &t, int64_t new_session) {
+    std::lock_guard<std::mutex> g(mutex);
+    ReleaseEvents(t);
+    t.FreeChunks();
+    t.head = t.tail = new TraceChunk();
+    t.recorded = 0;
+    t.dropped = 0;
+    t.session = new_session;
+  }
+
+  void ReleaseEvents(ThreadTrace &t) {
+    for (TraceChunk *c = t.head; c; c = c->next.load(std::memory_order_acquire)) {
+      int n = c->count.load(std::memory_order_acquire);
+      for (int i = 0; i < n; i++)
+        ReleaseEvents(c->records[i]);
+    }
+  }
+
+  void ReleaseEvents(TraceRecord &r) {
+    if (r.begin_event)
+      event_pool->Put(CUDAEvent(r.begin_event), r.device_id);
+    if (r.end_event)
+      event_pool->Put(CUDAEvent(r.end_event), r.device_id);
+    r.begin_event = r.end_event = nullptr;
+  }
+
+  CUDAEventPool &EventPool() {
+    std::call_once(event_pool_once, [&]() {
+      event_pool = std::make_unique<CUDAEventPool>(cudaEventDefault);
+    });
+    return *event_pool;
+  }
+
+  /**
+   * @brief Makes sure that there's a reference point on the device timeline for this session
+   *
+   * The reference event is recorded in `stream` and synchronized, so that its host time is
+   * known (up to the latency of the synchronization).
+   */
+  bool EnsureDeviceReference(int device_id, cudaStream_t stream) {
+    if (device_id < 0 || device_id >= kMaxDevices)
+      return false;
+    int64_t s = session.load(std::memory_order_relaxed);
+    if (ref_session[device_id].load(std::memory_order_acquire) == s)
+      return true;
+    std::lock_guard<std::mutex> g(ref_mutex);
+    if (ref_session[device_id].load(std::memory_order_relaxed) == s)
+      return true;
+    auto &ref = refs[device_id];
+    if (!ref.event)
+      ref.event = EventPool().Get(device_id);
+    if (cudaEventRecord(ref.event, stream) != cudaSuccess ||
+        cudaEventSynchronize(ref.event) != cudaSuccess)
+      return false;
+    ref.host_ns = now_ns();
+    ref_session[device_id].store(s, std::memory_order_release);
+    return true;
+  }
+
+  /// Converts the CUDA events of a device range to host times; returns false on failure
+  bool ResolveDeviceRange(TraceRecord &r) {
+    if (!r.begin_event)
+      return true;
+    int64_t s = session.load(std::memory_order_relaxed);
+    if (ref_session[r.device_id].load(std::memory_order_acquire) != s)
+      return false;
+    const auto &ref = refs[r.device_id];
+    float begin_ms = 0, end_ms = 0;
+    if (cudaEventSynchronize(r.end_event) != cudaSuccess ||
+        cudaEventElapsedTime(&begin_ms, ref.event, r.begin_event) != cudaSuccess ||
+        cudaEventElapsedTime(&end_ms, ref.event, r.end_event) != cudaSuccess) {
+      cudaGetLastError();
+      return false;
+    }
+    r.begin_ns = ref.host_ns + static_cast<int64_t>(begin_ms * 1e6);
+    r.end_ns = ref.host_ns + static_cast<int64_t>(end_ms * 1e6);
+    ReleaseEvents(r);
+    return true;
+  }
+
+  void WriteChromeTrace(std::ostream &os);
+
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadTrace>> threads;
+  std::atomic<int64_t> session{0};
+  int64_t start_ns = 0;
+  int64_t max_thread_events = kDefaultMaxThreadEvents;
+
+  std::mutex intern_mutex;
+  std::unordered_set<std::string> interned;
+
+  std::once_flag event_pool_once;
+  std::unique_ptr<CUDAEventPool> event_pool;
+
+  struct DeviceReference {
+    CUDAEvent event;
+    int64_t host_ns = 0;
+  };
+  std::mutex ref_mutex;
+  DeviceReference refs[kMaxDevices];
+  std::atomic<int64_t> ref_session[kMaxDevices];
+};
+
+void Tracer::Impl::WriteChromeTrace(std::ostream &os) {
+  std::lock_guard<std::mutex> g(mutex);
+  int64_t s = session.load(std::memory_order_relaxed);
+  int pid = getpid();
+  int64_t dropped = 0;
+  // the device ranges are shown in a track per stream
+  std::map<std::pair<int, cudaStream_t>, int64_t> device_tracks;
+  constexpr int64_t kDeviceTrackBase = 1 << 30;
+
+  auto flags = os.flags();
+  os << std::fixed << std::setprecision(3);
+  os << "{\"traceEvents\":[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+     << ",\"args\":{\"name\":\"DALI\"}}";
+  for (auto &t : threads) {
+    if (t->session != s)
+      continue;
+    dropped += t->dropped.load(std::memory_order_relaxed);
+    os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << t->tid
+       << ",\"args\":{\"name\":";
+    WriteJsonString(os, t->name.empty() ? "thread" : t->name.c_str());
+    os << "}}";
+    for (TraceChunk *c = t->head; c; c = c->next.load(std::memory_order_acquire)) {
+      int n = c->count.load(std::memory_order_acquire);
+      for (int i = 0; i < n; i++) {
+        auto &r = c->records[i];
+        if (!ResolveDeviceRange(r))
+          continue;
+        int64_t tid = t->tid;
+        if (r.device_id >= 0) {
+          auto key = std::make_pair(r.device_id, r.stream);
+          auto it = device_tracks.find(key);
+          if (it == device_tracks.end()) {
+            tid = kDeviceTrackBase + device_tracks.size();
+            device_tracks.emplace(key, tid);
+            os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":"
+               << tid << ",\"args\":{\"name\":\"GPU " << r.device_id << " stream "
+               << static_cast<const void *>(r.stream) << "\"}}";
+          } else {
+            tid = it->second;
+          }
+        }
+        // the ranges with a detail (e.g. the operators) are named after it
+        const auto &info = GetTraceEventInfo(r.event);
+        os << ",\n{\"name\":";
+        WriteJsonString(os, r.detail ? r.detail : info.name);
+        os << ",\"cat\":\"" << info.category << "\",\"args\":{\"event\":\"" << info.name << "\"";
+        if (r.arg >= 0)
+          os << ",\"arg\":" << r.arg;
+        os << "},\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << tid
+           << ",\"ts\":" << (r.begin_ns - start_ns) * 1e-3
+           << ",\"dur\":" << (r.end_ns - r.begin_ns) * 1e-3 << "}";
+      }
+    }
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":" << dropped
+     << "}}\n";
+  os.flags(flags);
+}
+
+std::atomic<bool> Tracer::enabled_{false};
+
+Tracer::Tracer() : impl_(new Impl()) {
+  for (auto &s : impl_->ref_session)
+    s = -1;
+}
+
+Tracer::~Tracer() {
+  delete impl_;
+}
+
+Tracer &Tracer::instance() {
+  // never destroyed - the threads may record until the very end of the process
+  static Tracer *tracer = new Tracer();
+  return *tracer;
+}
+
+void Tracer::Start(int64_t max_thread_events) {
+  std::lock_guard<std::mutex> g(impl_->mutex);
+  // the buffers of the finished threads are not needed anymore
+  for (auto it = impl_->threads.begin(); it != impl_->threads.end();) {
+    if (!(*it)->alive) {
+      impl_->ReleaseEvents(**it);
+      it = impl_->threads.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  impl_->max_thread_events = max_thread_events;
+  impl_->start_ns = now_ns();
+  impl_->session++;
+  enabled_ = true;
+}
+
+void Tracer::Stop() {
+  enabled_ = false;
+}
+
+void Tracer::WriteChromeTrace(std::ostream &os) {
+  impl_->WriteChromeTrace(os);
+}
+
+const char *Tracer::Intern(const std::string &str) {
+  std::lock_guard<std::mutex> g(impl_->intern_mutex);
+  return impl_->interned.insert(str).first->c_str();
+}
+
+int64_t Tracer::dropped() const {
+  std::lock_guard<std::mutex> g(impl_->mutex);
+  int64_t s = impl_->session.load(std::memory_order_relaxed);
+  int64_t dropped = 0;
+  for (auto &t : impl_->threads) {
+    if (t->session == s)
+      dropped += t->dropped.load(std::memory_order_relaxed);
+  }
+  return dropped;
+}
+
+void Tracer::Record(const TraceRecord &record) {
+  auto &t = impl_->ThisThread();
+  int64_t s = impl_->session.load(std::memory_order_relaxed);
+  if (t.session != s)
+    impl_->ResetThread(t, s);
+  if (t.recorded >= impl_->max_thread_events) {
+    t.dropped.fetch_add(1, std::memory_order_relaxed);
+    TraceRecord r = record;
+    impl_->ReleaseEvents(r);
+    return;
+  }
+  TraceChunk *c = t.tail;
+  int n = c->count.load(std::memory_order_relaxed);
+  if (n == TraceChunk::kSize) {
+    auto *next = new TraceChunk();
+    c->next.store(next, std::memory_order_release);
+    t.tail = c = next;
+    n = 0;
+  }
+  c->records[n] = record;
+  c->count.store(n + 1, std::memory_order_release);
+  t.recorded++;
+}
+
+void Tracer::SetThreadName(const char *name) {
+  snprintf(tl_thread_name, sizeof(tl_thread_name), "%s", name);
+  if (!enabled())
+    return;
+  auto &t = impl_->ThisThread();
+  std::lock_guard<std::mutex> g(impl_->mutex);
+  t.name = tl_thread_name;
+}
+
+bool Tracer::BeginDeviceRange(TraceRecord &record, cudaStream_t stream) try {
+  int device_id = -1;
+  if (cudaGetDevice(&device_id) != cudaSuccess) {
+    cudaGetLastError();
+    return false;
+  }
+  if (!impl_->EnsureDeviceReference(device_id, stream))
+    return false;
+  record.begin_event = impl_->EventPool().Get(device_id).release();
+  if (cudaEventRecord(record.begin_event, stream) != cudaSuccess) {
+    impl_->ReleaseEvents(record);
+    return false;
+  }
+  record.begin_ns = now_ns();
+  record.stream = stream;
+  record.device_id = device_id;
+  return true;
+} catch (...) {
+  return false;
+}
+
+void Tracer::EndDeviceRange(TraceRecord &record) noexcept try {
+  record.end_event = impl_->EventPool().Get(record.device_id).release();
+  if (cudaEventRecord(record.end_event, record.stream) != cudaSuccess) {
+    impl_->ReleaseEvents(record);
+    return;
+  }
+  record.end_ns = now_ns();
+  Record(record);
+} catch (...) {
+}
+
+namespace {
+
+/// Traces the whole process when DALI_TRACE_FILE is set; the trace is written at exit
+struct TraceFromEnv {
+  TraceFromEnv() {
+    const char *path = std::getenv("DALI_TRACE_FILE");
+    if (!path || !*path)
+      return;
+    Tracer::instance().Start();
+    std::atexit([]() {
+      try {
+        std::ofstream f(std::getenv("DALI_TRACE_FILE"));
+        Tracer::instance().Stop();
+        Tracer::instance().WriteChromeTrace(f);
+      } catch (...) {
+      }
+    });
+  }
+} trace_from_env;
+
+}  // namespace
+
+}  // namespace dali
@@ -0,0 +1,106 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dali/core/cuda_stream.h"
+#include "dali/core/trace.h"
+
+namespace dali {
+namespace test {
+
+namespace {
+
+std::string GetTrace() {
+  std::stringstream ss;
+  Tracer::instance().WriteChromeTrace(ss);
+  return ss.str();
+}
+
+int CountOccurrences(const std::string &str, const std::string &pattern) {
+  int n = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+    n++;
+  return n;
+}
+
+}  // namespace
+
+TEST(Trace, HostRanges) {
+  auto &tracer = Tracer::instance();
+  tracer.Start();
+  const char *name = tracer.Intern("my_op");
+  EXPECT_EQ(name, tracer.Intern("my_op"));
+  {
+    TraceScope op(TraceEvent::CPUOp, -1, name);
+    TraceScope prefetch(TraceEvent::ReaderPrefetch, 42);
+  }
+  tracer.Stop();
+  {
+    TraceScope not_recorded(TraceEvent::ReaderRun);
+  }
+  std::string json = GetTrace();
+  EXPECT_EQ(CountOccurrences(json, "\"ph\":\"X\""), 2);
+  EXPECT_NE(json.find("\"name\":\"my_op\",\"cat\":\"operator\""), std::string::npos);
+  EXPECT_NE(json.find("\"args\":{\"event\":\"Prefetch\",\"arg\":42}"), std::string::npos);
+  EXPECT_EQ(json.find("\"Run\""), std::string::npos);
+  EXPECT_EQ(tracer.dropped(), 0);
+}
+
+TEST(Trace, Threads) {
+  auto &tracer = Tracer::instance();
+  tracer.Start(100);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([t]() {
+      Tracer::instance().SetThreadName(("trace_test_" + std::to_string(t)).c_str());
+      for (int i = 0; i < 150; i++)
+        TraceScope task(TraceEvent::ThreadPoolTask, i);
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  tracer.Stop();
+  std::string json = GetTrace();
+  EXPECT_EQ(CountOccurrences(json, "\"ph\":\"X\""), 4 * 100);
+  EXPECT_EQ(tracer.dropped(), 4 * 50);
+  for (int t = 0; t < 4; t++)
+    EXPECT_NE(json.find("\"name\":\"trace_test_" + std::to_string(t) + "\""), std::string::npos);
+
+  // a new session discards the previous one
+  tracer.Start();
+  tracer.Stop();
+  EXPECT_EQ(CountOccurrences(GetTrace(), "\"ph\":\"X\""), 0);
+}
+
+TEST(Trace, DeviceRanges) {
+  auto stream = CUDAStream::Create(true);
+  auto &tracer = Tracer::instance();
+  tracer.Start();
+  {
+    TraceDeviceScope range(TraceEvent::GPUOpDevice, stream, 7, tracer.Intern("gpu_op"));
+  }
+  TraceDeviceScope not_started;
+  tracer.Stop();
+  std::string json = GetTrace();
+  EXPECT_EQ(CountOccurrences(json, "\"ph\":\"X\""), 1);
+  EXPECT_NE(json.find("\"name\":\"gpu_op\",\"cat\":\"cuda\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"GPU "), std::string::npos);
+}
+
+}  // namespace test
+}  // namespace dali
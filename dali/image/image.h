@@ -98,6 +98,19 @@ class Image {
     return use_fast_idct_;
   }
 
+  /**
+   * Sets the size to which the decoded image is going to be resized. The decoders which
+   * can scale the image down while decoding (JPEG) may then produce an image smaller than
+   * requested, but not smaller than this size. 0 means that the extent is not constrained.
+   */
+  inline void SetDecodeSizeHint(int height, int width) {
+    decode_size_hint_ = {height, width};
+  }
+
+  inline std::array<int, 2> DecodeSizeHint() const {
+    return decode_size_hint_;
+  }
+
   virtual ~Image() = default;
   DISABLE_COPY_MOVE_ASSIGN(Image);
 
@@ -135,6 +148,7 @@ class Image {
   const DALIImageType image_type_;
   bool decoded_ = false;
   bool use_fast_idct_ = false;
+  std::array<int, 2> decode_size_hint_ = {0, 0};
   Shape shape_;
   CropWindowGenerator crop_window_generator_;
   std::shared_ptr<uint8_t> decoded_image_ = nullptr;
@@ -13,11 +13,14 @@
 // limitations under the License.
 
 #include "dali/image/jpeg.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <memory>
 #include "dali/imgcodec/decoders/jpeg/jpeg_mem.h"
 #include "dali/util/ocv.h"
 #include "dali/core/byte_io.h"
+#include "dali/core/util.h"
 
 namespace dali {
 
@@ -58,6 +61,28 @@ bool get_jpeg_size(const uint8 *data, size_t data_size, int *height, int *width,
 }
 #endif
 
+#ifdef DALI_USE_JPEG_TURBO
+namespace {
+
+/**
+ * @brief Returns the largest DCT scaling denominator (1, 2, 4 or 8) which keeps the decoded
+ *        region of the given size at least as large as the hint
+ */
+int DctScaleRatio(int height, int width, std::array<int, 2> hint) {
+  int ratio = 8;
+  auto too_small = [&](int extent, int hint_extent) {
+    return hint_extent > 0 && extent / ratio < hint_extent;
+  };
+  if (hint[0] <= 0 && hint[1] <= 0)
+    return 1;
+  while (ratio > 1 && (too_small(height, hint[0]) || too_small(width, hint[1])))
+    ratio /= 2;
+  return ratio;
+}
+
+}  // namespace
+#endif  // DALI_USE_JPEG_TURBO
+
 std::pair<std::shared_ptr<uint8_t>, Image::Shape>
 JpegImage::DecodeImpl(DALIImageType type, const uint8 *jpeg, size_t length) const {
   const auto shape = PeekShapeImpl(jpeg, length);
@@ -88,16 +113,40 @@ JpegImage::DecodeImpl(DALIImageType type, const uint8 *jpeg, size_t length) cons
   flags.components = c;
 
   flags.crop = false;
+  int crop_y = 0, crop_x = 0, crop_h = h, crop_w = w;
   auto crop_window_generator = GetCropWindowGenerator();
   if (crop_window_generator) {
     flags.crop = true;
     TensorShape<> shape{h, w};
     auto crop = crop_window_generator(shape, "HW");
     crop.EnforceInRange(shape);
-    flags.crop_y = crop.anchor[0];
-    flags.crop_x = crop.anchor[1];
-    flags.crop_height = target_shape[0] = crop.shape[0];
-    flags.crop_width  = target_shape[1] = crop.shape[1];
+    crop_y = crop.anchor[0];
+    crop_x = crop.anchor[1];
+    crop_h = crop.shape[0];
+    crop_w = crop.shape[1];
+  }
+
+  // The image scaled down in the DCT domain is 1/ratio of the original, rounded up, and the
+  // crop window is expressed in the scaled coordinates
+  flags.ratio = DctScaleRatio(crop_h, crop_w, DecodeSizeHint());
+  if (flags.ratio > 1) {
+    int r = flags.ratio;
+    int scaled_h = div_ceil(h, r), scaled_w = div_ceil(w, r);
+    int y0 = crop_y / r, x0 = crop_x / r;
+    int y1 = std::min(div_ceil(crop_y + crop_h, r), scaled_h);
+    int x1 = std::min(div_ceil(crop_x + crop_w, r), scaled_w);
+    crop_y = y0;
+    crop_x = x0;
+    crop_h = y1 - y0;
+    crop_w = x1 - x0;
+  }
+  target_shape[0] = crop_h;
+  target_shape[1] = crop_w;
+  if (flags.crop) {
+    flags.crop_y = crop_y;
+    flags.crop_x = crop_x;
+    flags.crop_height = crop_h;
+    flags.crop_width = crop_w;
   }
 
   DALI_ENFORCE(type == DALI_RGB || type == DALI_BGR || type == DALI_GRAY,
@@ -0,0 +1,142 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/imgcodec/decoders/libavif/avif_libavif.h"
+#include <avif/avif.h>
+#include <algorithm>
+#include <utility>
+#include "dali/imgcodec/parsers/avif.h"
+#include "dali/imgcodec/util/convert.h"
+#include "dali/imgcodec/registry.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/core/common.h"
+
+namespace dali {
+namespace imgcodec {
+
+namespace {
+
+void CheckAvif(avifResult result, const char *action) {
+  DALI_ENFORCE(result == AVIF_RESULT_OK,
+               make_string("Failed to ", action, " the AVIF image: ", avifResultToString(result)));
+}
+
+/**
+ * @brief dav1d is the fastest AV1 decoder; other decoders are only used when libavif
+ *        is built without it
+ */
+avifCodecChoice PreferredCodec() {
+  static const avifCodecChoice choice =
+      avifCodecName(AVIF_CODEC_CHOICE_DAV1D, AVIF_CODEC_FLAG_CAN_DECODE) ?
+      AVIF_CODEC_CHOICE_DAV1D : AVIF_CODEC_CHOICE_AUTO;
+  return choice;
+}
+
+using AvifDecoderHandle = std::unique_ptr<avifDecoder, decltype(&avifDecoderDestroy)>;
+using AvifImageHandle = std::unique_ptr<avifImage, decltype(&avifImageDestroy)>;
+
+}  // namespace
+
+FutureDecodeResults LibAvifDecoderInstance::ScheduleDecode(DecodeContext ctx,
+                                                           span<SampleView<CPUBackend>> out,
+                                                           cspan<ImageSource *> in,
+                                                           DecodeParams opts,
+                                                           cspan<ROI> rois) {
+  // Large batches keep all the threads busy with separate images; small ones leave
+  // the spare threads to the tile and frame threading of the AV1 decoder
+  int num_threads = ctx.tp ? ctx.tp->NumThreads() : 1;
+  threads_per_image_ = std::max<int>(1, num_threads / std::max<int>(1, in.size()));
+  return Base::ScheduleDecode(std::move(ctx), out, in, std::move(opts), rois);
+}
+
+DecodeResult LibAvifDecoderInstance::DecodeImplTask(int thread_idx,
+                                                    SampleView<CPUBackend> out,
+                                                    ImageSource *in,
+                                                    DecodeParams opts,
+                                                    const ROI &requested_roi) {
+  if (in->Kind() != InputKind::HostMemory)
+    DALI_FAIL(make_string("InputKind not supported: ", static_cast<int>(in->Kind())));
+
+  AvifDecoderHandle decoder(avifDecoderCreate(), avifDecoderDestroy);
+  DALI_ENFORCE(decoder, "Could not create the AVIF decoder");
+  decoder->codecChoice = PreferredCodec();
+  decoder->maxThreads = threads_per_image_;
+  decoder->ignoreExif = AVIF_TRUE;
+  decoder->ignoreXMP = AVIF_TRUE;
+  CheckAvif(avifDecoderSetIOMemory(decoder.get(), in->RawData<uint8_t>(), in->Size()), "read");
+  CheckAvif(avifDecoderParse(decoder.get()), "parse");
+  CheckAvif(avifDecoderNextImage(decoder.get()), "decode");
+  const avifImage *image = decoder->image;
+  int64_t height = image->height;
+  int64_t width = image->width;
+
+  // The alpha channel is only kept when the raw data is requested
+  int channels = opts.format == DALI_ANY_DATA && decoder->alphaPresent ? 4 : 3;
+  DALIImageType in_format = opts.format == DALI_ANY_DATA ? DALI_ANY_DATA : DALI_RGB;
+
+  // The orientation is applied while converting the decoded image, so the ROI (given in
+  // the output space) is mapped to the region of the stored image
+  Orientation orientation = opts.use_orientation ? AvifParser{}.GetInfo(in).orientation
+                                                 : Orientation{};
+  ROI in_roi = InputRoi(requested_roi, orientation, TensorShape<>{height, width});
+  ROI roi;
+  roi.begin = in_roi.begin.sample_dim() ? in_roi.begin : TensorShape<>{0, 0};
+  roi.end = in_roi.end.sample_dim() ? in_roi.end : TensorShape<>{height, width};
+  DALI_ENFORCE(roi.begin[0] >= 0 && roi.begin[1] >= 0 &&
+               roi.end[0] <= height && roi.end[1] <= width,
+               make_string("ROI ", roi.begin, "-", roi.end, " is out of the image bounds ",
+                           TensorShape<>{height, width}));
+
+  // AV1 has no partial decoding, but the color conversion is limited to the ROI. The view
+  // must start at even offsets when the chroma planes are subsampled; the excess is skipped
+  // in Convert.
+  int64_t crop_y = roi.begin[0] & ~1;
+  int64_t crop_x = roi.begin[1] & ~1;
+  avifCropRect rect;
+  rect.x = crop_x;
+  rect.y = crop_y;
+  rect.width = roi.end[1] - crop_x;
+  rect.height = roi.end[0] - crop_y;
+  AvifImageHandle view(avifImageCreateEmpty(), avifImageDestroy);
+  DALI_ENFORCE(view, "Could not create the AVIF image view");
+  CheckAvif(avifImageSetViewRect(view.get(), image, &rect), "crop");
+
+  avifRGBImage rgb;
+  avifRGBImageSetDefaults(&rgb, view.get());
+  rgb.format = channels == 4 ? AVIF_RGB_FORMAT_RGBA : AVIF_RGB_FORMAT_RGB;
+  // Higher bit depths are scaled to the full 16-bit range, as expected by Convert
+  rgb.depth = image->depth > 8 ? 16 : 8;
+  DALIDataType decoded_type = rgb.depth == 8 ? DALI_UINT8 : DALI_UINT16;
+  TensorShape<> decoded_shape = {rect.height, rect.width, channels};
+  rgb.rowBytes = rect.width * channels * (rgb.depth / 8);
+
+  kernels::DynamicScratchpad scratchpad;
+  rgb.pixels = static_cast<uint8_t *>(scratchpad.Alloc(mm::memory_kind_id::host,
+                                                       rgb.rowBytes * rect.height, 2));
+  CheckAvif(avifImageYUVToRGB(view.get(), &rgb), "convert");
+
+  SampleView<CPUBackend> decoded_view(rgb.pixels, decoded_shape, decoded_type);
+  ROI convert_roi;
+  convert_roi.begin = {roi.begin[0] - crop_y, roi.begin[1] - crop_x};
+  convert_roi.end = {decoded_shape[0], decoded_shape[1]};
+  TensorLayout layout = "HWC";
+  Convert(out, layout, opts.format, decoded_view, layout, in_format,
+          OutputRoi(convert_roi, orientation, decoded_shape), orientation);
+  return {true, nullptr};
+}
+
+REGISTER_DECODER("AVIF", LibAvifDecoderFactory, HostDecoderPriority);
+
+}  // namespace imgcodec
+}  // namespace dali
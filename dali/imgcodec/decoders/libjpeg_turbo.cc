@@ -49,12 +49,16 @@ DecodeResult LibJpegTurboDecoderInstance::DecodeImplTask(int thread_idx,
     flags.dct_method = JDCT_FASTEST;
   }
 
+  // The orientation is applied while converting the decoded image, so the ROI (given in
+  // the output space) is mapped to the region of the stored image
+  Orientation orientation = opts.use_orientation ? info.orientation : Orientation{};
   if (roi) {
+    auto crop = InputRoi(roi, orientation, info.shape);
     flags.crop = true;
-    flags.crop_y = roi.begin[0];
-    flags.crop_x = roi.begin[1];
-    flags.crop_height = target_shape[0] = roi.shape()[0];
-    flags.crop_width  = target_shape[1] = roi.shape()[1];
+    flags.crop_y = crop.begin[0];
+    flags.crop_x = crop.begin[1];
+    flags.crop_height = target_shape[0] = crop.shape()[0];
+    flags.crop_width  = target_shape[1] = crop.shape()[1];
   }
 
   const uint8_t *encoded_data;
@@ -73,7 +77,7 @@ DecodeResult LibJpegTurboDecoderInstance::DecodeImplTask(int thread_idx,
       // JPEG images are always 8-bit, in HWC format
       SampleView<CPUBackend> in(decoded_image.get(), target_shape, DALI_UINT8);
       TensorLayout layout = "HWC";
-      Convert(out, layout, out_type, in, layout, flags.color_space, {}, {});
+      Convert(out, layout, out_type, in, layout, flags.color_space, {}, orientation);
     }
   } catch (...) {
     res.exception = std::current_exception();
@@ -0,0 +1,179 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/imgcodec/decoders/libtiff/tiff_cuda.h"
+#include <tiffio.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include "dali/core/util.h"
+#include "dali/imgcodec/decoders/libtiff/tiff_utils.h"
+#include "dali/imgcodec/parsers/tiff.h"
+#include "dali/imgcodec/util/convert.h"
+#include "dali/imgcodec/util/convert_gpu.h"
+#include "dali/imgcodec/registry.h"
+
+namespace dali {
+namespace imgcodec {
+
+namespace {
+
+DecodeResult Unsupported(const std::string &message) {
+  return {false, std::make_exception_ptr(std::logic_error(message))};
+}
+
+}  // namespace
+
+TiffCudaDecoderInstance::TiffCudaDecoderInstance(int device_id,
+                                                 const std::map<std::string, any> &params)
+: BatchParallelDecoderImpl(device_id, params) {
+  SetParams(params);
+  DeviceGuard dg(device_id_);
+  tp_ = std::make_unique<ThreadPool>(num_threads_, device_id, true, "TiffCudaDecoderInstance");
+  resources_.reserve(tp_->NumThreads());
+  for (int i = 0; i < tp_->NumThreads(); i++)
+    resources_.emplace_back(device_id_);
+}
+
+TiffCudaDecoderInstance::~TiffCudaDecoderInstance() {
+  tp_.reset();
+  for (auto &res : resources_)
+    CUDA_CALL(cudaStreamSynchronize(res.stream));
+}
+
+DecodeResult TiffCudaDecoderInstance::DecodeImplTask(int thread_idx,
+                                                     cudaStream_t stream,
+                                                     SampleView<GPUBackend> out,
+                                                     ImageSource *in,
+                                                     DecodeParams opts,
+                                                     const ROI &requested_roi) {
+  auto &res = resources_[thread_idx];
+  try {
+    auto tiff = detail::OpenTiff(in);
+    auto info = detail::GetTiffInfo(tiff.get());
+
+    if (info.photometric_interpretation != PHOTOMETRIC_RGB &&
+        info.photometric_interpretation != PHOTOMETRIC_MINISBLACK)
+      return Unsupported(make_string("Unsupported photometric interpretation: ",
+                                     info.photometric_interpretation));
+    if (info.bit_depth != 8 && info.bit_depth != 16)
+      return Unsupported(make_string("Unsupported bit depth: ", info.bit_depth));
+    if (info.fill_order != FILLORDER_MSB2LSB)
+      return Unsupported("Only FILL_ORDER=1 is supported");
+    if (!TIFFIsCODECConfigured(info.compression))
+      return Unsupported(make_string("Unsupported compression: ", info.compression));
+
+    // The requested ROI is in the output space, `roi` is the region of the stored image
+    Orientation orientation = opts.use_orientation ? TiffParser{}.GetInfo(in).orientation
+                                                   : Orientation{};
+    TensorShape<> image_shape = {info.image_height, info.image_width};
+    ROI roi;
+    if (!requested_roi.use_roi()) {
+      roi.begin = {0, 0};
+      roi.end = image_shape;
+    } else {
+      roi = InputRoi(requested_roi, orientation, image_shape);
+    }
+
+    // The strips are read as tiles spanning the whole width
+    const int64_t height = info.image_height, width = info.image_width;
+    const int64_t chunk_h = info.is_tiled ? info.tile_height
+                                          : std::min<int64_t>(info.rows_per_strip, height);
+    const int64_t chunk_w = info.is_tiled ? info.tile_width : width;
+    const int planes = info.is_planar ? info.channels : 1;
+    const int chunk_channels = info.is_planar ? 1 : info.channels;
+    const int64_t type_size = info.bit_depth / 8;
+    const int64_t pixel_size = chunk_channels * type_size;
+    const size_t chunk_bytes = info.is_tiled ? TIFFTileSize(tiff.get())
+                                             : TIFFStripSize(tiff.get());
+
+    // The chunks intersecting the ROI
+    const int64_t y0 = roi.begin[0] / chunk_h * chunk_h;
+    const int64_t x0 = roi.begin[1] / chunk_w * chunk_w;
+    const int64_t y1 = std::min(div_ceil(roi.end[0], chunk_h) * chunk_h, height);
+    const int64_t x1 = std::min(div_ceil(roi.end[1], chunk_w) * chunk_w, width);
+    const int64_t box_h = y1 - y0, box_w = x1 - x0;
+    const int64_t nchunks = planes * div_ceil(box_h, chunk_h) * div_ceil(box_w, chunk_w);
+
+    // The buffers may still be used by the previous image
+    CUDA_CALL(cudaEventSynchronize(res.event));
+    if (res.chunks_capacity < nchunks * chunk_bytes) {
+      res.chunks_capacity = nchunks * chunk_bytes;
+      res.chunks = mm::alloc_raw_unique<uint8_t, mm::memory_kind::pinned>(res.chunks_capacity);
+    }
+    res.image.resize(planes * box_h * box_w * pixel_size);
+
+    uint8_t *chunk = res.chunks.get();
+    for (int p = 0; p < planes; p++) {
+      for (int64_t cy = y0; cy < y1; cy += chunk_h) {
+        for (int64_t cx = x0; cx < x1; cx += chunk_w) {
+          tmsize_t nbytes;
+          if (info.is_tiled) {
+            nbytes = TIFFReadEncodedTile(tiff.get(), TIFFComputeTile(tiff.get(), cx, cy, 0, p),
+                                         chunk, chunk_bytes);
+          } else {
+            nbytes = TIFFReadEncodedStrip(tiff.get(), TIFFComputeStrip(tiff.get(), cy, p),
+                                          chunk, chunk_bytes);
+          }
+          DALI_ENFORCE(nbytes > 0, make_string("Failed to read TIFF ",
+                                               info.is_tiled ? "tile" : "strip", " at (", cy,
+                                               ", ", cx, ")."));
+
+          // The tiles at the edges are padded
+          int64_t rows = std::min(chunk_h, height - cy), cols = std::min(chunk_w, width - cx);
+          uint8_t *dst = res.image.data() + ((p * box_h + cy - y0) * box_w + cx - x0) * pixel_size;
+          CUDA_CALL(cudaMemcpy2DAsync(dst, box_w * pixel_size, chunk, chunk_w * pixel_size,
+                                      cols * pixel_size, rows, cudaMemcpyHostToDevice,
+                                      res.stream));
+          chunk += chunk_bytes;
+        }
+      }
+    }
+
+    DALIImageType in_format;
+    if (info.channels == 1)
+      in_format = DALI_GRAY;
+    else if (opts.format != DALI_ANY_DATA && info.channels >= 3)
+      in_format = DALI_RGB;
+    else
+      in_format = DALI_ANY_DATA;
+
+    DALIDataType in_type = info.bit_depth == 8 ? DALI_UINT8 : DALI_UINT16;
+    TensorShape<> box_shape = info.is_planar
+                            ? TensorShape<>{info.channels, box_h, box_w}
+                            : TensorShape<>{box_h, box_w, info.channels};
+    ConstSampleView<GPUBackend> box(res.image.data(), box_shape, in_type);
+    // The ROI relative to the box, both in the output space
+    ROI out_roi = OutputRoi(roi, orientation, image_shape);
+    ROI out_box = OutputRoi({{y0, x0}, {y1, x1}}, orientation, image_shape);
+    ROI box_roi;
+    box_roi.begin = {out_roi.begin[0] - out_box.begin[0], out_roi.begin[1] - out_box.begin[1]};
+    box_roi.end = {out_roi.end[0] - out_box.begin[0], out_roi.end[1] - out_box.begin[1]};
+    Convert(out, opts, box, info.is_planar ? "CHW" : "HWC", in_format, res.stream, box_roi,
+            1.0f, orientation);
+
+    CUDA_CALL(cudaEventRecord(res.event, res.stream));
+    CUDA_CALL(cudaStreamWaitEvent(stream, res.event, 0));
+  } catch (...) {
+    // don't reuse the buffers before the already scheduled copies complete
+    CUDA_CALL(cudaEventRecord(res.event, res.stream));
+    return {false, std::current_exception()};
+  }
+  return {true, nullptr};
+}
+
+REGISTER_DECODER("TIFF", TiffCudaDecoderFactory, CUDADecoderPriority);
+
+}  // namespace imgcodec
+}  // namespace dali
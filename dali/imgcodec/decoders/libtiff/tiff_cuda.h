@@ -0,0 +1,127 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_IMGCODEC_DECODERS_LIBTIFF_TIFF_CUDA_H_
+#define DALI_IMGCODEC_DECODERS_LIBTIFF_TIFF_CUDA_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/core/cuda_event.h"
+#include "dali/core/cuda_stream_pool.h"
+#include "dali/core/dev_buffer.h"
+#include "dali/core/mm/memory.h"
+#include "dali/imgcodec/decoders/decoder_parallel_impl.h"
+#include "dali/imgcodec/image_decoder_interfaces.h"
+
+namespace dali {
+namespace imgcodec {
+
+/**
+ * @brief TIFF decoder with the output in the GPU memory.
+ *
+ * The strips (or tiles) intersecting the ROI are decompressed by libtiff on the host (which
+ * also reverts the predictor and the byte order) into a pinned buffer. They are then copied
+ * into their places in the image on the device - the copies do the untiling - and the layout
+ * (planar to interleaved), type and color space conversion is done on the GPU.
+ *
+ * Only 8 and 16-bit grayscale and RGB images are supported, the others are left for
+ * the fallback decoders.
+ */
+class DLL_PUBLIC TiffCudaDecoderInstance : public BatchParallelDecoderImpl {
+ public:
+  explicit TiffCudaDecoderInstance(int device_id, const std::map<std::string, any> &params);
+  ~TiffCudaDecoderInstance();
+
+  FutureDecodeResults ScheduleDecode(DecodeContext ctx,
+                                     span<SampleView<GPUBackend>> out,
+                                     cspan<ImageSource *> in,
+                                     DecodeParams opts,
+                                     cspan<ROI> rois = {}) override {
+    ctx.tp = tp_.get();
+    return BatchParallelDecoderImpl::ScheduleDecode(ctx, out, in, opts, rois);
+  }
+
+  using BatchParallelDecoderImpl::DecodeImplTask;
+  DecodeResult DecodeImplTask(int thread_idx,
+                              cudaStream_t stream,
+                              SampleView<GPUBackend> out,
+                              ImageSource *in,
+                              DecodeParams opts,
+                              const ROI &roi) override;
+
+  bool SetParam(const char *name, const any &value) override {
+    if (strcmp(name, "tiff_num_threads") == 0) {
+      num_threads_ = any_cast<size_t>(value);
+      return true;
+    }
+    return false;
+  }
+
+  any GetParam(const char *name) const override {
+    if (strcmp(name, "tiff_num_threads") == 0)
+      return num_threads_;
+    return {};
+  }
+
+ private:
+  struct PerThreadResources {
+    explicit PerThreadResources(int device_id)
+    : stream(CUDAStreamPool::instance().Get(device_id))
+    , event(CUDAEvent::Create(device_id)) {
+      CUDA_CALL(cudaEventRecord(event, stream));
+    }
+
+    CUDAStreamLease stream;
+    /** @brief Recorded when the buffers are no longer used */
+    CUDAEvent event;
+    mm::uptr<uint8_t> chunks;
+    size_t chunks_capacity = 0;
+    DeviceBuffer<uint8_t> image;
+  };
+
+  size_t num_threads_ = 4;
+  std::unique_ptr<ThreadPool> tp_;
+  std::vector<PerThreadResources> resources_;
+};
+
+class TiffCudaDecoderFactory : public ImageDecoderFactory {
+ public:
+  ImageDecoderProperties GetProperties() const override {
+    static const auto props = []() {
+      ImageDecoderProperties props;
+      props.supported_input_kinds = InputKind::Stream | InputKind::HostMemory | InputKind::Filename;
+      props.supports_partial_decoding = true;
+      props.gpu_output = true;
+      props.fallback = true;
+      return props;
+    }();
+    return props;
+  }
+
+  bool IsSupported(int device_id) const override {
+    return device_id >= 0;
+  }
+
+  std::shared_ptr<ImageDecoderInstance> Create(
+        int device_id, const std::map<std::string, any> &params = {}) const override {
+    return std::make_shared<TiffCudaDecoderInstance>(device_id, params);
+  }
+};
+
+}  // namespace imgcodec
+}  // namespace dali
+
+#endif  // DALI_IMGCODEC_DECODERS_LIBTIFF_TIFF_CUDA_H_
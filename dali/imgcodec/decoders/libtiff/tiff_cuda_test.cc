@@ -0,0 +1,199 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/tensor_shape_print.h"
+#include "dali/core/tensor_view.h"
+#include "dali/imgcodec/decoders/decoder_test_helper.h"
+#include "dali/imgcodec/decoders/libtiff/tiff_cuda.h"
+#include "dali/imgcodec/parsers/tiff.h"
+#include "dali/test/dali_test.h"
+#include "dali/test/dali_test_config.h"
+
+namespace dali {
+namespace imgcodec {
+namespace test {
+
+namespace {
+const auto &dali_extra = dali::testing::dali_extra_path();
+auto img_dir = dali_extra + "/db/single/tiff/0/";
+auto ref_dir = dali_extra + "/db/single/reference/tiff/0/";
+
+auto rgb_path = img_dir + "/cat-111793_640.tiff";
+auto rgb_ref_path = ref_dir + "/cat-111793_640.tiff.npy";
+
+auto gray_path = img_dir + "/cat-111793_640_gray.tiff";
+auto gray_ref_path = ref_dir + "/cat-111793_640_gray.tiff.npy";
+
+auto palette_path = img_dir + "/cat-300572_640_palette.tiff";
+
+auto tiled_dir = dali_extra + "/db/imgcodec/tiff/tiled/";
+auto tiled_path = tiled_dir + "/cat-111793_640_tiled_16x48.tiff";
+auto tiled_one_big_tile_path = tiled_dir + "/cat-111793_640_tiled_1024x1024.tiff";
+
+auto rgb_path1 = img_dir + "/cat-3449999_640.tiff";
+auto rgb_ref_path1 = ref_dir + "/cat-3449999_640.tiff.npy";
+
+auto rgb_path2 = img_dir + "/cat-3504008_640.tiff";
+auto rgb_ref_path2 = ref_dir + "/cat-3504008_640.tiff.npy";
+
+std::string depth_path(int depth) {
+  return make_string(dali_extra, "/db/imgcodec/tiff/bitdepths/rgb_", depth, "bit.tiff");
+}
+
+std::string depth_ref_path(int depth) {
+  return make_string(dali_extra + "/db/imgcodec/tiff/bitdepths/reference/rgb_",
+                     depth, "bit.tiff.npy");
+}
+}  // namespace
+
+TEST(TiffCudaDecoderTest, Factory) {
+  int device_id;
+  CUDA_CALL(cudaGetDevice(&device_id));
+
+  TiffCudaDecoderFactory decoder;
+  EXPECT_TRUE(decoder.IsSupported(device_id));
+  EXPECT_FALSE(decoder.IsSupported(CPU_ONLY_DEVICE_ID));
+  auto props = decoder.GetProperties();
+  EXPECT_TRUE(props.gpu_output);
+  EXPECT_TRUE(props.supports_partial_decoding);
+  EXPECT_TRUE(!!(props.supported_input_kinds & InputKind::HostMemory));
+  EXPECT_TRUE(!!(props.supported_input_kinds & InputKind::Filename));
+  EXPECT_FALSE(!!(props.supported_input_kinds & InputKind::DeviceMemory));
+
+  auto instance = decoder.Create(device_id);
+  EXPECT_NE(instance, nullptr);
+}
+
+template <typename OutType>
+class TiffCudaDecoderTest : public NumpyDecoderTestBase<GPUBackend, OutType> {
+ protected:
+  std::shared_ptr<ImageDecoderInstance> CreateDecoder() override {
+    return TiffCudaDecoderFactory().Create(this->GetDeviceId());
+  }
+  std::shared_ptr<ImageParser> CreateParser() override {
+    return std::make_shared<TiffParser>();
+  }
+  static const auto dtype = type2id<OutType>::value;
+};
+
+using TiffCudaDecoderTypes = ::testing::Types<uint8_t, uint16_t, float>;
+TYPED_TEST_SUITE(TiffCudaDecoderTest, TiffCudaDecoderTypes);
+
+TYPED_TEST(TiffCudaDecoderTest, FromFilename) {
+  auto ref = this->ReadReferenceFrom(rgb_ref_path);
+  auto src = ImageSource::FromFilename(rgb_path);
+  auto img = this->Decode(&src, {this->dtype});
+  AssertEqualSatNorm(img, ref);
+}
+
+TYPED_TEST(TiffCudaDecoderTest, FromHostMem) {
+  auto ref = this->ReadReferenceFrom(rgb_ref_path);
+  auto stream = FileStream::Open(rgb_path, false, false);
+  std::vector<uint8_t> data(stream->Size());
+  stream->ReadBytes(data.data(), data.size());
+  auto src = ImageSource::FromHostMem(data.data(), data.size());
+  auto img = this->Decode(&src, {this->dtype});
+  AssertEqualSatNorm(img, ref);
+}
+
+TYPED_TEST(TiffCudaDecoderTest, ROI) {
+  auto ref = this->ReadReferenceFrom(rgb_ref_path);
+  auto src = ImageSource::FromFilename(rgb_path);
+  auto info = this->Parser()->GetInfo(&src);
+
+  ROI roi = {{13, 17}, {info.shape[0] - 55, info.shape[1] - 10}};
+  auto img = this->Decode(&src, {this->dtype}, roi);
+  AssertEqualSatNorm(img, Crop(ref, roi));
+}
+
+TYPED_TEST(TiffCudaDecoderTest, BatchedAPI) {
+  auto ref0 = this->ReadReferenceFrom(rgb_ref_path);
+  auto ref1 = this->ReadReferenceFrom(rgb_ref_path1);
+  auto ref2 = this->ReadReferenceFrom(rgb_ref_path2);
+  auto src0 = ImageSource::FromFilename(rgb_path);
+  auto src1 = ImageSource::FromFilename(rgb_path1);
+  auto src2 = ImageSource::FromFilename(rgb_path2);
+  std::vector<ImageSource*> srcs = {&src0, &src1, &src2};
+  auto img = this->Decode(make_span(srcs), {this->dtype});
+  AssertEqualSatNorm(img[0], ref0);
+  AssertEqualSatNorm(img[1], ref1);
+  AssertEqualSatNorm(img[2], ref2);
+}
+
+TYPED_TEST(TiffCudaDecoderTest, Gray) {
+  auto ref = this->ReadReferenceFrom(gray_ref_path);
+  auto src = ImageSource::FromFilename(gray_path);
+  auto img = this->Decode(&src, {this->dtype, DALI_GRAY});
+  AssertEqualSatNorm(img, ref);
+}
+
+TYPED_TEST(TiffCudaDecoderTest, Depth8) {
+  auto ref = this->ReadReferenceFrom(depth_ref_path(8));
+  auto src = ImageSource::FromFilename(depth_path(8));
+  auto img = this->Decode(&src, {this->dtype});
+  AssertEqualSatNorm(img, ref);
+}
+
+TYPED_TEST(TiffCudaDecoderTest, Depth16) {
+  auto ref = this->ReadReferenceFrom(depth_ref_path(16));
+  auto src = ImageSource::FromFilename(depth_path(16));
+  auto img = this->Decode(&src, {this->dtype});
+  AssertEqualSatNorm(img, ref);
+}
+
+TYPED_TEST(TiffCudaDecoderTest, TiledWholeImage) {
+  auto ref = this->ReadReferenceFrom(rgb_ref_path);
+  auto src = ImageSource::FromFilename(tiled_path);
+  auto img = this->Decode(&src, {this->dtype, DALI_RGB});
+  AssertEqualSatNorm(img, ref);
+}
+
+TYPED_TEST(TiffCudaDecoderTest, TiledRoi) {
+  auto ref = this->ReadReferenceFrom(rgb_ref_path);
+  auto src = ImageSource::FromFilename(tiled_path);
+  ROI roi = {{123, 100}, {321, 400}};
+  auto img = this->Decode(&src, {this->dtype, DALI_RGB}, roi);
+  AssertEqualSatNorm(img, Crop(ref, roi));
+}
+
+TYPED_TEST(TiffCudaDecoderTest, TiledSmallRoi) {
+  auto ref = this->ReadReferenceFrom(rgb_ref_path);
+  auto src = ImageSource::FromFilename(tiled_path);
+  ROI roi = {{3*48+17, 7*16+5}, {3*48+27, 7*16+15}};  // This fits in a single tile
+  auto img = this->Decode(&src, {this->dtype, DALI_RGB}, roi);
+  AssertEqualSatNorm(img, Crop(ref, roi));
+}
+
+TYPED_TEST(TiffCudaDecoderTest, TiledOneBigTile) {
+  auto ref = this->ReadReferenceFrom(rgb_ref_path);
+  auto src = ImageSource::FromFilename(tiled_one_big_tile_path);
+  auto img = this->Decode(&src, {this->dtype, DALI_RGB});
+  AssertEqualSatNorm(img, ref);
+}
+
+TYPED_TEST(TiffCudaDecoderTest, PaletteNotSupported) {
+  // Left for the fallback decoders
+  auto src = ImageSource::FromFilename(palette_path);
+  SampleView<GPUBackend> view(nullptr, 0, type2id<TypeParam>::value);
+  DecodeResult decode_result = this->Decoder()->Decode(this->Context(), view, &src, {}, {});
+  EXPECT_FALSE(decode_result.success);
+}
+
+}  // namespace test
+}  // namespace imgcodec
+}  // namespace dali
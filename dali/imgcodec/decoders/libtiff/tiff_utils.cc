@@ -0,0 +1,131 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/imgcodec/decoders/libtiff/tiff_utils.h"
+
+namespace dali {
+namespace imgcodec {
+
+namespace detail {
+
+class DecoderHelper {
+ public:
+  explicit DecoderHelper(ImageSource *in) : stream_(in->Open()), in_(in) {}
+
+  static tmsize_t read(thandle_t handle, void *buffer, tmsize_t n) {
+    DecoderHelper *helper = reinterpret_cast<DecoderHelper *>(handle);
+    return helper->stream_->Read(buffer, n);
+  }
+
+  static tmsize_t write(thandle_t, void *, tmsize_t) {
+    // Not used for decoding.
+    return 0;
+  }
+
+  static toff_t seek(thandle_t handle, toff_t offset, int whence) {
+    DecoderHelper *helper = reinterpret_cast<DecoderHelper *>(handle);
+    helper->stream_->SeekRead(offset, whence);
+    return helper->stream_->TellRead();
+  }
+
+  static int map(thandle_t handle, void **base, toff_t *size) {
+    // This function will be used by LibTIFF only if input is InputKind::HostMemory.
+    DecoderHelper *helper = reinterpret_cast<DecoderHelper *>(handle);
+    if (helper->in_->Kind() != InputKind::HostMemory)
+      return -1;
+    *base = const_cast<void*>(helper->in_->RawData());
+    *size = helper->in_->Size();
+    return 0;
+  }
+
+  static toff_t size(thandle_t handle) {
+    DecoderHelper *helper = reinterpret_cast<DecoderHelper *>(handle);
+    return helper->stream_->Size();
+  }
+
+  static int close(thandle_t handle) {
+    DecoderHelper *helper = reinterpret_cast<DecoderHelper *>(handle);
+    delete helper;
+    return 0;
+  }
+
+ private:
+  std::shared_ptr<InputStream> stream_;
+  ImageSource *in_;
+};
+
+std::unique_ptr<TIFF, void (*)(TIFF *)> OpenTiff(ImageSource *in) {
+  TIFF *tiffptr;
+
+  if (in->Kind() == InputKind::Filename) {
+    tiffptr = TIFFOpen(in->Filename(), "r");
+  } else {
+    TIFFMapFileProc mapproc;
+    if (in->Kind() == InputKind::HostMemory)
+      mapproc = &DecoderHelper::map;
+    else
+      mapproc = nullptr;
+
+    tiffptr = TIFFClientOpen("", "r", reinterpret_cast<thandle_t>(new DecoderHelper(in)),
+                             &DecoderHelper::read,
+                             &DecoderHelper::write,
+                             &DecoderHelper::seek,
+                             &DecoderHelper::close,
+                             &DecoderHelper::size,
+                             mapproc,
+                             /* unmap */ 0);
+  }
+
+  DALI_ENFORCE(tiffptr != nullptr, make_string("Unable to open TIFF image: ", in->SourceInfo()));
+  return {tiffptr, &TIFFClose};
+}
+
+TiffInfo GetTiffInfo(TIFF *tiffptr) {
+  TiffInfo info = {};
+
+  LIBTIFF_CALL(TIFFGetField(tiffptr, TIFFTAG_IMAGEWIDTH, &info.image_width));
+  LIBTIFF_CALL(TIFFGetField(tiffptr, TIFFTAG_IMAGELENGTH, &info.image_height));
+  LIBTIFF_CALL(TIFFGetFieldDefaulted(tiffptr, TIFFTAG_SAMPLESPERPIXEL, &info.channels));
+  LIBTIFF_CALL(TIFFGetFieldDefaulted(tiffptr, TIFFTAG_BITSPERSAMPLE, &info.bit_depth));
+  LIBTIFF_CALL(TIFFGetFieldDefaulted(tiffptr, TIFFTAG_ORIENTATION, &info.orientation));
+  LIBTIFF_CALL(TIFFGetFieldDefaulted(tiffptr, TIFFTAG_COMPRESSION, &info.compression));
+  LIBTIFF_CALL(TIFFGetFieldDefaulted(tiffptr, TIFFTAG_ROWSPERSTRIP, &info.rows_per_strip));
+  LIBTIFF_CALL(TIFFGetFieldDefaulted(tiffptr, TIFFTAG_FILLORDER, &info.fill_order));
+
+  info.is_tiled = TIFFIsTiled(tiffptr);
+  if (info.is_tiled) {
+    LIBTIFF_CALL(TIFFGetField(tiffptr, TIFFTAG_TILEWIDTH, &info.tile_width));
+    LIBTIFF_CALL(TIFFGetField(tiffptr, TIFFTAG_TILELENGTH, &info.tile_height));
+  } else {
+    // We will be reading data line-by-line and pretend that lines are tiles
+    info.tile_width = info.image_width;
+    info.tile_height = 1;
+  }
+
+  if (TIFFGetField(tiffptr, TIFFTAG_PHOTOMETRIC, &info.photometric_interpretation)) {
+    info.is_palette = (info.photometric_interpretation == PHOTOMETRIC_PALETTE);
+  } else {
+    info.photometric_interpretation = PHOTOMETRIC_MINISBLACK;
+  }
+
+  uint16_t planar_config;
+  LIBTIFF_CALL(TIFFGetFieldDefaulted(tiffptr, TIFFTAG_PLANARCONFIG, &planar_config));
+  info.is_planar = (planar_config == PLANARCONFIG_SEPARATE);
+
+  return info;
+}
+
+}  // namespace detail
+}  // namespace imgcodec
+}  // namespace dali
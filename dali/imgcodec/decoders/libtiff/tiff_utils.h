@@ -0,0 +1,68 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_IMGCODEC_DECODERS_LIBTIFF_TIFF_UTILS_H_
+#define DALI_IMGCODEC_DECODERS_LIBTIFF_TIFF_UTILS_H_
+
+#include <tiffio.h>
+#include <memory>
+#include <string>
+#include "dali/core/error_handling.h"
+#include "dali/imgcodec/image_source.h"
+
+#define LIBTIFF_CALL_SUCCESS 1
+#define LIBTIFF_CALL(call)                                \
+  do {                                                    \
+    int retcode = (call);                                 \
+    DALI_ENFORCE(LIBTIFF_CALL_SUCCESS == retcode,         \
+      "libtiff call failed with code "                    \
+      + std::to_string(retcode) + ": " #call);            \
+  } while (0)
+
+namespace dali {
+namespace imgcodec {
+namespace detail {
+
+struct TiffInfo {
+  uint32_t image_width, image_height;
+  uint16_t channels;
+
+  uint32_t rows_per_strip;
+  uint16_t bit_depth;
+  uint16_t orientation;
+  uint16_t compression;
+  uint16_t photometric_interpretation;
+  uint16_t fill_order;
+
+  bool is_tiled;
+  bool is_palette;
+  bool is_planar;
+  uint32_t tile_width, tile_height;
+};
+
+/**
+ * @brief Opens the TIFF image with libtiff, reading it from the file, memory or stream
+ */
+std::unique_ptr<TIFF, void (*)(TIFF *)> OpenTiff(ImageSource *in);
+
+/**
+ * @brief Reads the properties of the current directory of the TIFF image
+ */
+TiffInfo GetTiffInfo(TIFF *tiffptr);
+
+}  // namespace detail
+}  // namespace imgcodec
+}  // namespace dali
+
+#endif  // DALI_IMGCODEC_DECODERS_LIBTIFF_TIFF_UTILS_H_
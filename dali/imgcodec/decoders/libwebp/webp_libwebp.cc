@@ -0,0 +1,127 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/imgcodec/decoders/libwebp/webp_libwebp.h"
+#include <webp/decode.h>
+#include <utility>
+#include "dali/imgcodec/parsers/webp.h"
+#include "dali/imgcodec/util/convert.h"
+#include "dali/imgcodec/registry.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/core/common.h"
+
+namespace dali {
+namespace imgcodec {
+
+FutureDecodeResults LibWebpDecoderInstance::ScheduleDecode(DecodeContext ctx,
+                                                           span<SampleView<CPUBackend>> out,
+                                                           cspan<ImageSource *> in,
+                                                           DecodeParams opts,
+                                                           cspan<ROI> rois) {
+  // With large batches all the threads are busy decoding separate images and the additional
+  // filtering thread would only compete with them
+  use_threads_ = ctx.tp && in.size() < ctx.tp->NumThreads();
+  return Base::ScheduleDecode(std::move(ctx), out, in, std::move(opts), rois);
+}
+
+DecodeResult LibWebpDecoderInstance::DecodeImplTask(int thread_idx,
+                                                    SampleView<CPUBackend> out,
+                                                    ImageSource *in,
+                                                    DecodeParams opts,
+                                                    const ROI &requested_roi) {
+  if (in->Kind() != InputKind::HostMemory)
+    DALI_FAIL(make_string("InputKind not supported: ", static_cast<int>(in->Kind())));
+  const uint8_t *encoded = in->RawData<uint8_t>();
+  size_t encoded_size = in->Size();
+
+  WebPDecoderConfig config;
+  DALI_ENFORCE(WebPInitDecoderConfig(&config), "libwebp version mismatch");
+  VP8StatusCode status = WebPGetFeatures(encoded, encoded_size, &config.input);
+  DALI_ENFORCE(status == VP8_STATUS_OK,
+               make_string("Failed to parse the WebP image, status: ", static_cast<int>(status)));
+  DALI_ENFORCE(!config.input.has_animation, "Animated WebP images are not supported");
+  int64_t height = config.input.height;
+  int64_t width = config.input.width;
+
+  // The alpha channel is only kept when the raw data is requested
+  int channels = opts.format == DALI_ANY_DATA && config.input.has_alpha ? 4 : 3;
+  DALIImageType in_format = opts.format == DALI_ANY_DATA ? DALI_ANY_DATA : DALI_RGB;
+
+  // The orientation is applied while converting the decoded image, so the ROI (given in
+  // the output space) is mapped to the region of the stored image
+  Orientation orientation = opts.use_orientation ? WebpParser{}.GetInfo(in).orientation
+                                                 : Orientation{};
+  ROI in_roi = InputRoi(requested_roi, orientation, TensorShape<>{height, width});
+  ROI roi;
+  roi.begin = in_roi.begin.sample_dim() ? in_roi.begin : TensorShape<>{0, 0};
+  roi.end = in_roi.end.sample_dim() ? in_roi.end : TensorShape<>{height, width};
+  DALI_ENFORCE(roi.begin[0] >= 0 && roi.begin[1] >= 0 &&
+               roi.end[0] <= height && roi.end[1] <= width,
+               make_string("ROI ", roi.begin, "-", roi.end, " is out of the image bounds ",
+                           TensorShape<>{height, width}));
+
+  // libwebp crops at even offsets only (the chroma planes are subsampled), so the decoded
+  // window starts at the preceding even row and column and the excess is skipped in Convert
+  int64_t crop_y = roi.begin[0] & ~1;
+  int64_t crop_x = roi.begin[1] & ~1;
+  TensorShape<> decoded_shape = {roi.end[0] - crop_y, roi.end[1] - crop_x, channels};
+  if (decoded_shape[0] != height || decoded_shape[1] != width) {
+    config.options.use_cropping = 1;
+    config.options.crop_top = crop_y;
+    config.options.crop_left = crop_x;
+    config.options.crop_height = decoded_shape[0];
+    config.options.crop_width = decoded_shape[1];
+  }
+  config.options.use_threads = use_threads_;
+
+  // Decode directly to the output, when no conversion is needed
+  bool direct = out.type() == DALI_UINT8 && crop_y == roi.begin[0] && crop_x == roi.begin[1] &&
+                GetOrientationSwizzle(orientation).is_identity() &&
+                (opts.format == DALI_ANY_DATA || opts.format == DALI_RGB);
+  kernels::DynamicScratchpad scratchpad;
+  uint8_t *decoded;
+  size_t decoded_size = volume(decoded_shape);
+  if (direct) {
+    decoded = out.mutable_data<uint8_t>();
+  } else {
+    decoded = static_cast<uint8_t *>(scratchpad.Alloc(mm::memory_kind_id::host, decoded_size));
+  }
+
+  config.output.colorspace = channels == 4 ? MODE_RGBA : MODE_RGB;
+  config.output.is_external_memory = 1;
+  config.output.u.RGBA.rgba = decoded;
+  config.output.u.RGBA.stride = decoded_shape[1] * channels;
+  config.output.u.RGBA.size = decoded_size;
+
+  status = WebPDecode(encoded, encoded_size, &config);
+  WebPFreeDecBuffer(&config.output);
+  DALI_ENFORCE(status == VP8_STATUS_OK,
+               make_string("Failed to decode the WebP image, status: ", static_cast<int>(status)));
+
+  if (!direct) {
+    SampleView<CPUBackend> decoded_view(decoded, decoded_shape, DALI_UINT8);
+    ROI convert_roi;
+    convert_roi.begin = {roi.begin[0] - crop_y, roi.begin[1] - crop_x};
+    convert_roi.end = {decoded_shape[0], decoded_shape[1]};
+    TensorLayout layout = "HWC";
+    Convert(out, layout, opts.format, decoded_view, layout, in_format,
+            OutputRoi(convert_roi, orientation, decoded_shape), orientation);
+  }
+  return {true, nullptr};
+}
+
+REGISTER_DECODER("WebP", LibWebpDecoderFactory, HostDecoderPriority);
+
+}  // namespace imgcodec
+}  // namespace dali
@@ -0,0 +1,128 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "dali/imgcodec/decoders/libwebp/webp_libwebp.h"
+#include "dali/imgcodec/parsers/webp.h"
+#include "dali/test/dali_test.h"
+#include "dali/test/dali_test_config.h"
+#include "dali/imgcodec/decoders/decoder_test_helper.h"
+
+namespace dali {
+namespace imgcodec {
+namespace test {
+
+namespace {
+const auto &dali_extra = dali::testing::dali_extra_path();
+auto webp_dir = dali_extra + "/db/single/webp/";
+auto lossy_path = webp_dir + "lossy/kitty-2948404_640.webp";
+auto lossless_path = webp_dir + "lossless/domestic-cat-726989_640.webp";
+auto alpha_path = webp_dir + "lossless-alpha/camel-1987672_640.webp";
+
+std::vector<uint8_t> ReadFile(const std::string &path) {
+  auto stream = FileStream::Open(path, false, false);
+  std::vector<uint8_t> data(stream->Size());
+  stream->ReadBytes(data.data(), data.size());
+  return data;
+}
+}  // namespace
+
+class LibWebpDecoderTest : public NumpyDecoderTestBase<CPUBackend, uint8_t> {
+ protected:
+  std::shared_ptr<ImageDecoderInstance> CreateDecoder() override {
+    return LibWebpDecoderFactory().Create(CPU_ONLY_DEVICE_ID);
+  }
+  std::shared_ptr<ImageParser> CreateParser() override {
+    return std::make_shared<WebpParser>();
+  }
+
+  std::vector<uint8_t> DecodeToVector(ImageSource *src, const DecodeParams &opts,
+                                      const ROI &roi = {}) {
+    auto img = Decode(src, opts, roi);
+    return {img.data, img.data + img.num_elements()};
+  }
+
+  /**
+   * @brief Checks that decoding a ROI gives the same result as cropping the full image
+   *
+   * @param eps allowed difference; the chroma upsampling of lossy images may differ at
+   *            the edges of the crop window
+   */
+  void TestRoi(const std::string &path, const ROI &roi, int eps = 0) {
+    auto data = ReadFile(path);
+    auto src = ImageSource::FromHostMem(data.data(), data.size());
+    auto full_shape = Parser()->GetInfo(&src).shape;
+    auto full = DecodeToVector(&src, {DALI_UINT8, DALI_RGB});
+    auto img = Decode(&src, {DALI_UINT8, DALI_RGB}, roi);
+    ASSERT_EQ(img.shape, TensorShape<>(roi.shape()[0], roi.shape()[1], 3));
+    for (int64_t y = 0; y < img.shape[0]; y++)
+      for (int64_t x = 0; x < img.shape[1]; x++)
+        for (int c = 0; c < 3; c++)
+          ASSERT_NEAR(img.data[(y * img.shape[1] + x) * 3 + c],
+                      full[((y + roi.begin[0]) * full_shape[1] + x + roi.begin[1]) * 3 + c], eps)
+              << "at " << y << ", " << x << ", " << c;
+  }
+};
+
+TEST_F(LibWebpDecoderTest, Lossy) {
+  auto data = ReadFile(lossy_path);
+  auto src = ImageSource::FromHostMem(data.data(), data.size());
+  auto img = Decode(&src, {DALI_UINT8});
+  EXPECT_EQ(img.shape, TensorShape<>(433, 640, 3));
+}
+
+TEST_F(LibWebpDecoderTest, Alpha) {
+  auto data = ReadFile(alpha_path);
+  auto src = ImageSource::FromHostMem(data.data(), data.size());
+  EXPECT_EQ(Decode(&src, {DALI_UINT8, DALI_ANY_DATA}).shape, TensorShape<>(426, 640, 4));
+  EXPECT_EQ(Decode(&src, {DALI_UINT8, DALI_RGB}).shape, TensorShape<>(426, 640, 3));
+}
+
+TEST_F(LibWebpDecoderTest, RoiLossless) {
+  TestRoi(lossless_path, {{13, 17}, {400, 601}});
+  TestRoi(lossless_path, {{20, 0}, {21, 640}});
+}
+
+TEST_F(LibWebpDecoderTest, RoiLossy) {
+  TestRoi(lossy_path, {{13, 17}, {400, 601}}, 16);
+  TestRoi(lossy_path, {{0, 1}, {433, 2}}, 16);
+}
+
+TEST_F(LibWebpDecoderTest, BatchedAPI) {
+  std::vector<std::vector<uint8_t>> data = {
+    ReadFile(lossy_path), ReadFile(lossless_path), ReadFile(alpha_path)
+  };
+  std::vector<ImageSource> srcs;
+  srcs.reserve(data.size());
+  std::vector<std::vector<uint8_t>> refs;
+  for (auto &d : data) {
+    srcs.push_back(ImageSource::FromHostMem(d.data(), d.size()));
+    refs.push_back(DecodeToVector(&srcs.back(), {DALI_UINT8, DALI_RGB}));
+  }
+  std::vector<ImageSource *> src_ptrs;
+  for (auto &s : srcs)
+    src_ptrs.push_back(&s);
+
+  auto imgs = Decode(make_span(src_ptrs), {DALI_UINT8, DALI_RGB});
+  for (int i = 0; i < imgs.num_samples(); i++) {
+    auto img = imgs[i];
+    ASSERT_EQ(std::vector<uint8_t>(img.data, img.data + img.num_elements()), refs[i]);
+  }
+}
+
+}  // namespace test
+}  // namespace imgcodec
+}  // namespace dali
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <cassert>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -21,6 +22,7 @@
 #include <unordered_map>
 #include "dali/imgcodec/decoders/memory_pool.h"
 #include "dali/core/cuda_error.h"
+#include "dali/core/small_vector.h"
 #include "dali/core/mm/malloc_resource.h"
 #include "dali/pipeline/data/buffer.h"
 
@@ -32,6 +34,14 @@ template <typename MemoryKind>
 void *GetBuffer(std::thread::id thread_id, size_t size) {
   return BufferPoolManager::instance().GetBuffer<MemoryKind>(thread_id, size);
 }
+
+size_t BufferCacheCapacity() {
+  static size_t capacity = []() -> size_t {
+    const char *env = std::getenv("DALI_NVJPEG_BUFFER_CACHE_MB");
+    return (env ? std::atoll(env) : 256) << 20;
+  }();
+  return capacity;
+}
 }  // namespace
 
 std::unordered_map<void*, AllocInfo> alloc_info_;
@@ -52,6 +62,15 @@ void Deleter::operator()(void *p) const {
 Buffer::Buffer(unique_ptr_t unq_ptr, mm::memory_kind_id kind, size_t sz)
 : ptr(std::move(unq_ptr)), kind(kind), size(sz) {}
 
+BufferPoolManager::BufferPoolManager() {
+  for (auto &cache : cache_)
+    cache = mm::size_class_cache(BufferCacheCapacity());
+}
+
+BufferPoolManager::~BufferPoolManager() {
+  ReleaseCachedBuffers();
+}
+
 BufferPoolManager& BufferPoolManager::instance() {
   // ensure proper destruction order
   (void)mm::GetDefaultResource<mm::memory_kind::host>();
@@ -76,6 +95,15 @@ void BufferPoolManager::AddMemStats(size_t size) {
   }
 }
 
+void BufferPoolManager::AddCacheStats(mm::memory_kind_id kind, size_t hits, size_t evictions) {
+  if (mem_stats_enabled_ && (hits || evictions)) {
+    std::lock_guard<std::mutex> lock(mem_stats_mutex_);
+    auto &stats = mem_stats_[static_cast<size_t>(kind)];
+    stats.cache_hits += hits;
+    stats.cache_evictions += evictions;
+  }
+}
+
 void BufferPoolManager::PrintMemStats() {
   if (mem_stats_enabled_) {
     std::lock_guard<std::mutex> lock(mem_stats_mutex_);
@@ -95,6 +123,16 @@ void BufferPoolManager::PrintMemStats() {
     auto &host_mem_stats = mem_stats_[static_cast<size_t>(mm::memory_kind_id::host)];
     out << "Host (regular) memory: " << host_mem_stats.nallocs
         << " allocations, largest = " << host_mem_stats.biggest_alloc << " bytes\n";
+    std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+    const char *kind_names[] = {"device", "host (pinned)", "host (regular)"};
+    const mm::memory_kind_id kinds[] = {
+        mm::memory_kind_id::device, mm::memory_kind_id::pinned, mm::memory_kind_id::host};
+    for (int i = 0; i < 3; i++) {
+      auto k = static_cast<size_t>(kinds[i]);
+      out << "Cached " << kind_names[i] << " memory: " << mem_stats_[k].cache_hits
+          << " reused, " << mem_stats_[k].cache_evictions << " released, peak = "
+          << cache_[k].peak_bytes() << " bytes\n";
+    }
     out << "################## END NVJPEG STATS ##################" << std::endl;
   }
 }
@@ -146,9 +184,19 @@ void* BufferPoolManager::GetBuffer(std::thread::id thread_id, size_t size) {
       buffers.pop_back();
     }
   }
-  // Couldn't find a preallocated buffer, proceed to allocate
-  AddMemStats<MemoryKind>(size);
-  return Allocate<MemoryKind>(thread_id, size).release();
+  // Couldn't find a preallocated buffer, try the ones freed by any thread
+  std::unique_lock<std::mutex> cache_lock(cache_mutex_);
+  auto block = cache_[static_cast<size_t>(kind)].get(size);
+  cache_lock.unlock();
+  if (block.mem) {
+    AddCacheStats(kind, 1, 0);
+    return block.mem;
+  }
+  // Allocate, rounding up to the size class, so that the buffer can be reused for
+  // slightly larger requests
+  size_t alloc_size = mm::size_class_cache::class_size(mm::size_class_cache::class_index(size));
+  AddMemStats<MemoryKind>(alloc_size);
+  return Allocate<MemoryKind>(thread_id, alloc_size).release();
 }
 
 template void* BufferPoolManager::GetBuffer<mm::memory_kind::device>(std::thread::id thread_id,
@@ -162,26 +210,34 @@ int BufferPoolManager::ReturnBufferToPool(void *raw_ptr) {
   std::shared_lock<std::shared_timed_mutex> info_lock(alloc_info_mutex_);
   auto info_it = alloc_info_.find(raw_ptr);
   assert(info_it != alloc_info_.end());
-  auto info = info_it->second;
+  mm::memory_kind_id kind = info_it->second.kind;
+  size_t size = info_it->second.size;
   info_lock.unlock();
-  std::unique_ptr<char, Deleter> ptr(reinterpret_cast<char*>(raw_ptr), {});
-  std::shared_lock<std::shared_timed_mutex> lock(buffer_pool_mutex_);
-  auto it = buffer_pool_.find(info.thread_id);
-  auto end_it =  buffer_pool_.end();
-  lock.unlock();
-  MemoryPool *pool;
-  if (it != end_it) {
-    pool = &(it->second);
-  } else {
-    // if nothing has been preallocated create a pool for given thread_id
-    std::unique_lock<std::shared_timed_mutex> lock(buffer_pool_mutex_);
-    pool = &(buffer_pool_[info.thread_id]);
+  SmallVector<void *, 4> evicted;
+  {
+    std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+    cache_[static_cast<size_t>(kind)].put(raw_ptr, size, [&](mm::size_class_cache::block b) {
+      evicted.push_back(b.mem);
+    });
   }
-  auto &buffers = (*pool)[static_cast<size_t>(info.kind)];
-  buffers.emplace_back(std::move(ptr), info.kind, info.size);
+  // free the evicted buffers outside of the lock
+  for (void *p : evicted)
+    Deleter()(p);
+  AddCacheStats(kind, 0, evicted.size());
   return 0;
 }
 
+void BufferPoolManager::ReleaseCachedBuffers() {
+  SmallVector<void *, 16> evicted;
+  {
+    std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+    for (auto &cache : cache_)
+      cache.trim(0, [&](mm::size_class_cache::block b) { evicted.push_back(b.mem); });
+  }
+  for (void *p : evicted)
+    Deleter()(p);
+}
+
 template <typename MemoryKind>
 void BufferPoolManager::AddBuffer(std::thread::id thread_id, size_t size) {
   std::unique_lock<std::shared_timed_mutex> lock(buffer_pool_mutex_);
@@ -22,6 +22,7 @@
 #include <memory>
 #include <mutex>
 #include <vector>
+#include "dali/core/mm/detail/size_class_cache.h"
 #include "dali/core/mm/memory.h"
 #include "dali/core/mm/memory_kind.h"
 
@@ -51,19 +52,37 @@ struct Buffer {
 using MemoryPool = std::array<std::vector<Buffer>, static_cast<size_t>(mm::memory_kind_id::count)>;
 using BufferPool = std::map<std::thread::id, MemoryPool>;
 
+/**
+ * @brief Hands out the buffers for nvJPEG and nvJPEG2000
+ *
+ * The buffers preallocated for a thread (see AddBuffer) are used by that thread first. The
+ * buffers released by the libraries are kept in a cache shared by all the threads, binned by
+ * size classes, up to a capacity per memory kind (DALI_NVJPEG_BUFFER_CACHE_MB environment
+ * variable, 256 MiB by default).
+ */
 struct BufferPoolManager {
+  static constexpr size_t kNumKinds = static_cast<size_t>(mm::memory_kind_id::count);
+
   BufferPool buffer_pool_;
   std::shared_timed_mutex buffer_pool_mutex_;
 
+  std::array<mm::size_class_cache, kNumKinds> cache_;
+  std::mutex cache_mutex_;
+
   struct MemoryStats {
     size_t nallocs = 0;
     size_t biggest_alloc = 0;
+    size_t cache_hits = 0;
+    size_t cache_evictions = 0;
   };
 
-  std::array<MemoryStats, static_cast<size_t>(mm::memory_kind_id::count)> mem_stats_;
+  std::array<MemoryStats, kNumKinds> mem_stats_;
   std::mutex mem_stats_mutex_;
   std::atomic<bool> mem_stats_enabled_ = {true};
 
+  BufferPoolManager();
+  ~BufferPoolManager();
+
   static BufferPoolManager &instance();
 
   void SetEnableMemStats(bool enabled);
@@ -71,6 +90,8 @@ struct BufferPoolManager {
   template <typename MemoryKind>
   void AddMemStats(size_t size);
 
+  void AddCacheStats(mm::memory_kind_id kind, size_t hits, size_t evictions);
+
   void PrintMemStats();
 
   template <typename MemoryKind>
@@ -89,6 +110,9 @@ struct BufferPoolManager {
   void AddBuffer(std::thread::id thread_id, size_t size);
 
   void DeleteAllBuffers(std::thread::id thread_id);
+
+  /// @brief Frees the buffers kept in the cache
+  void ReleaseCachedBuffers();
 };
 
 template <>
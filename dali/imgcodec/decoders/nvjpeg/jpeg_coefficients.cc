@@ -0,0 +1,151 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/imgcodec/decoders/nvjpeg/jpeg_coefficients.h"
+#include <setjmp.h>
+#include <cstring>
+#include <stdexcept>
+#include "dali/core/format.h"
+#include "dali/imgcodec/decoders/jpeg/jpeg_handle.h"
+#include "dali/imgcodec/decoders/jpeg/jpeg_utils.h"
+
+namespace dali {
+namespace imgcodec {
+
+static_assert(sizeof(JCOEF) == sizeof(int16_t) && sizeof(JBLOCK) == 64 * sizeof(int16_t),
+              "The coefficients are copied as blocks of 64 int16 values");
+
+struct JpegCoefficientReader::Impl {
+  jpeg_decompress_struct cinfo{};
+  jpeg_error_mgr jerr{};
+  jmp_buf jpeg_jmpbuf;
+  char message[JMSG_LENGTH_MAX] = {};
+  jvirt_barray_ptr *coefs = nullptr;
+  bool created = false;
+
+  // Unlike jpeg::CatchError, leaves the destruction to Reset
+  static void ErrorExit(j_common_ptr cinfo) {
+    auto *impl = static_cast<Impl *>(cinfo->client_data);
+    (*cinfo->err->format_message)(cinfo, impl->message);
+    longjmp(impl->jpeg_jmpbuf, 1);
+  }
+};
+
+JpegCoefficientReader::JpegCoefficientReader() : impl_(std::make_unique<Impl>()) {}
+
+JpegCoefficientReader::~JpegCoefficientReader() {
+  Reset();
+}
+
+void JpegCoefficientReader::Reset() {
+  if (impl_->created)
+    jpeg_destroy_decompress(&impl_->cinfo);
+  impl_->created = false;
+  impl_->coefs = nullptr;
+}
+
+void JpegCoefficientReader::Read(const void *data, size_t size) {
+  Reset();
+  auto &cinfo = impl_->cinfo;
+  cinfo.err = jpeg_std_error(&impl_->jerr);
+  impl_->jerr.error_exit = Impl::ErrorExit;
+  cinfo.client_data = impl_.get();
+  if (setjmp(impl_->jpeg_jmpbuf)) {
+    Reset();
+    throw std::runtime_error(make_string("Failed to decode the JPEG image: ", impl_->message));
+  }
+  jpeg_create_decompress(&cinfo);
+  impl_->created = true;
+  jpeg::SetSrc(&cinfo, data, size, false);
+  jpeg_read_header(&cinfo, TRUE);
+
+  bool supported = (cinfo.num_components == 1 && cinfo.jpeg_color_space == JCS_GRAYSCALE) ||
+                   (cinfo.num_components == 3 && (cinfo.jpeg_color_space == JCS_YCbCr ||
+                                                  cinfo.jpeg_color_space == JCS_RGB));
+  if (!supported || cinfo.data_precision != 8) {
+    Reset();
+    throw std::logic_error("Only the 8-bit grayscale, YCbCr and RGB images are supported");
+  }
+  impl_->coefs = jpeg_read_coefficients(&cinfo);
+}
+
+void JpegCoefficientReader::CopyCoefficients(int16_t *blocks, uint16_t *quant_tables) {
+  auto &cinfo = impl_->cinfo;
+  if (!impl_->coefs)
+    throw std::logic_error("No image was read");
+  if (setjmp(impl_->jpeg_jmpbuf)) {
+    Reset();
+    throw std::runtime_error(make_string("Failed to read the JPEG coefficients: ",
+                                         impl_->message));
+  }
+  for (int c = 0; c < cinfo.num_components; c++) {
+    const jpeg_component_info &comp = cinfo.comp_info[c];
+    int rows_per_access = comp.v_samp_factor;
+    size_t row_size = comp.width_in_blocks * sizeof(JBLOCK);
+    // The coefficient arrays are padded to whole MCUs, only the blocks of the image are copied
+    for (JDIMENSION row = 0; row < comp.height_in_blocks; row += rows_per_access) {
+      JBLOCKARRAY rows = (*cinfo.mem->access_virt_barray)(
+          reinterpret_cast<j_common_ptr>(&cinfo), impl_->coefs[c], row, rows_per_access, FALSE);
+      for (int r = 0; r < rows_per_access && row + r < comp.height_in_blocks; r++) {
+        memcpy(blocks, rows[r], row_size);
+        blocks += comp.width_in_blocks * DCTSIZE2;
+      }
+    }
+    if (!comp.quant_table)
+      throw std::runtime_error("A component of the JPEG image is missing");
+    for (int k = 0; k < DCTSIZE2; k++)
+      quant_tables[k] = comp.quant_table->quantval[k];
+    quant_tables += DCTSIZE2;
+  }
+}
+
+int JpegCoefficientReader::width() const {
+  return impl_->cinfo.image_width;
+}
+
+int JpegCoefficientReader::height() const {
+  return impl_->cinfo.image_height;
+}
+
+int JpegCoefficientReader::num_components() const {
+  return impl_->cinfo.num_components;
+}
+
+bool JpegCoefficientReader::ycbcr() const {
+  return impl_->cinfo.jpeg_color_space == JCS_YCbCr;
+}
+
+JpegComponentInfo JpegCoefficientReader::component(int c) const {
+  const jpeg_component_info &comp = impl_->cinfo.comp_info[c];
+  JpegComponentInfo info;
+  info.h_samp_factor = comp.h_samp_factor;
+  info.v_samp_factor = comp.v_samp_factor;
+  info.width = comp.downsampled_width;
+  info.height = comp.downsampled_height;
+  info.width_in_blocks = comp.width_in_blocks;
+  info.height_in_blocks = comp.height_in_blocks;
+  return info;
+}
+
+int64_t JpegCoefficientReader::NumBlocks() const {
+  int64_t nblocks = 0;
+  for (int c = 0; c < num_components(); c++) {
+    const jpeg_component_info &comp = impl_->cinfo.comp_info[c];
+    nblocks += static_cast<int64_t>(comp.width_in_blocks) * comp.height_in_blocks;
+  }
+  return nblocks;
+}
+
+}  // namespace imgcodec
+}  // namespace dali
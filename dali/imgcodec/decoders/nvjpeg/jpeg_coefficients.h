@@ -0,0 +1,87 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_IMGCODEC_DECODERS_NVJPEG_JPEG_COEFFICIENTS_H_
+#define DALI_IMGCODEC_DECODERS_NVJPEG_JPEG_COEFFICIENTS_H_
+
+#include <cstdint>
+#include <memory>
+#include "dali/core/api_helper.h"
+
+namespace dali {
+namespace imgcodec {
+
+/**
+ * @brief The geometry of a component of a JPEG image
+ */
+struct JpegComponentInfo {
+  int h_samp_factor, v_samp_factor;
+  /** @brief The size of the component, in pixels */
+  int width, height;
+  /** @brief The size of the component, in 8x8 blocks - a multiple of 8 pixels */
+  int width_in_blocks, height_in_blocks;
+};
+
+/**
+ * @brief Reads the quantized DCT coefficients of a JPEG image with libjpeg
+ *
+ * The entropy decoding, which for the progressive images means decoding all the scans, is done
+ * by Read. The coefficients are kept by libjpeg until they're copied out with CopyCoefficients,
+ * so that the caller can size the destination after reading the headers of a whole batch.
+ *
+ * Only the grayscale, YCbCr and RGB images are supported.
+ */
+class DLL_PUBLIC JpegCoefficientReader {
+ public:
+  JpegCoefficientReader();
+  ~JpegCoefficientReader();
+
+  /**
+   * @brief Decodes the coefficients of the image
+   *
+   * Throws if the image is invalid or not supported.
+   */
+  void Read(const void *data, size_t size);
+
+  /**
+   * @brief Copies the coefficients and the quantization tables of the image read last
+   *
+   * @param blocks receives NumBlocks() blocks of 64 coefficients, in the natural order, component
+   *               by component and row by row
+   * @param quant_tables receives a table of 64 quantization steps, in the natural order,
+   *                     for each component
+   */
+  void CopyCoefficients(int16_t *blocks, uint16_t *quant_tables);
+
+  /** @brief Frees the coefficients of the image read last */
+  void Reset();
+
+  int width() const;
+  int height() const;
+  int num_components() const;
+  /** @brief Whether the components are YCbCr (as opposed to RGB or grayscale) */
+  bool ycbcr() const;
+  JpegComponentInfo component(int c) const;
+  /** @brief The total number of the blocks of coefficients of all the components */
+  int64_t NumBlocks() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace imgcodec
+}  // namespace dali
+
+#endif  // DALI_IMGCODEC_DECODERS_NVJPEG_JPEG_COEFFICIENTS_H_
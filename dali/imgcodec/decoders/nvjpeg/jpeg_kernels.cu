@@ -0,0 +1,158 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/imgcodec/decoders/nvjpeg/jpeg_kernels.h"
+#include <algorithm>
+#include "dali/core/convert.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/util.h"
+
+namespace dali {
+namespace imgcodec {
+
+namespace {
+
+/** @brief The number of the 8x8 blocks transformed by a thread block, a thread per coefficient */
+constexpr int kIdctBlocksPerCta = 4;
+constexpr int kColorBlockSize = 256;
+constexpr int kMaxColorBlocksPerImage = 1024;
+
+__device__ int FindPlane(const JpegPlaneDesc *planes, int nplanes, int64_t block) {
+  int lo = 0, hi = nplanes - 1;
+  while (lo < hi) {
+    int mid = (lo + hi + 1) / 2;
+    if (planes[mid].first_block <= block)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+__global__ void IdctKernel(const JpegPlaneDesc *planes, int nplanes, int64_t total_blocks) {
+  // basis[x * 8 + u] = C(u) / 2 * cos((2x + 1) * u * pi / 16), with C(0) = 1/sqrt(2), else 1
+  __shared__ float basis[64];
+  __shared__ float coefs[kIdctBlocksPerCta][64];
+  __shared__ float columns[kIdctBlocksPerCta][64];
+  const int b = threadIdx.x / 64;
+  const int k = threadIdx.x % 64;
+  const int y = k / 8, x = k % 8;
+  if (threadIdx.x < 64) {
+    float c = x == 0 ? M_SQRT1_2 : 1.0f;
+    basis[threadIdx.x] = 0.5f * c * cospif((2 * y + 1) * x / 16.0f);
+  }
+
+  const int64_t block = static_cast<int64_t>(blockIdx.x) * kIdctBlocksPerCta + b;
+  const bool active = block < total_blocks;
+  const JpegPlaneDesc *plane = nullptr;
+  int64_t block_in_plane = 0;
+  float coef = 0;
+  if (active) {
+    plane = &planes[FindPlane(planes, nplanes, block)];
+    block_in_plane = block - plane->first_block;
+    coef = static_cast<float>(plane->coefs[block_in_plane * 64 + k]) * plane->quant[k];
+  }
+  coefs[b][k] = coef;
+  __syncthreads();
+
+  // The vertical pass - the thread (y, x) computes the sum over the vertical frequencies v
+  float sum = 0;
+  #pragma unroll
+  for (int v = 0; v < 8; v++)
+    sum += basis[y * 8 + v] * coefs[b][v * 8 + x];
+  columns[b][k] = sum;
+  __syncthreads();
+
+  // The horizontal pass - and the sum over the horizontal frequencies u
+  sum = 0;
+  #pragma unroll
+  for (int u = 0; u < 8; u++)
+    sum += basis[x * 8 + u] * columns[b][y * 8 + u];
+
+  if (active) {
+    int64_t pitch = plane->width_in_blocks * 8;
+    int64_t block_y = block_in_plane / plane->width_in_blocks;
+    int64_t block_x = block_in_plane - block_y * plane->width_in_blocks;
+    plane->plane[(block_y * 8 + y) * pitch + block_x * 8 + x] = ConvertSat<uint8_t>(sum + 128);
+  }
+}
+
+__device__ float SampleComponent(const JpegComponentDesc &comp, int x, int y) {
+  if (comp.scale_x == 1 && comp.scale_y == 1)
+    return comp.plane[y * comp.pitch + x];
+  // The samples of the subsampled components are centered between the pixels, as in JFIF
+  float fx = fminf(fmaxf((x + 0.5f) * comp.scale_x - 0.5f, 0.0f), comp.width - 1);
+  float fy = fminf(fmaxf((y + 0.5f) * comp.scale_y - 0.5f, 0.0f), comp.height - 1);
+  int x0 = static_cast<int>(fx), y0 = static_cast<int>(fy);
+  int x1 = min(x0 + 1, comp.width - 1), y1 = min(y0 + 1, comp.height - 1);
+  float ax = fx - x0, ay = fy - y0;
+  const uint8_t *row0 = comp.plane + y0 * comp.pitch;
+  const uint8_t *row1 = comp.plane + y1 * comp.pitch;
+  float top = row0[x0] + ax * (row0[x1] - row0[x0]);
+  float bottom = row1[x0] + ax * (row1[x1] - row1[x0]);
+  return top + ay * (bottom - top);
+}
+
+__global__ void ColorConvertKernel(const JpegImageDesc *images) {
+  const JpegImageDesc &image = images[blockIdx.y];
+  const int64_t npixels = static_cast<int64_t>(image.width) * image.height;
+  for (int64_t i = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x; i < npixels;
+       i += static_cast<int64_t>(gridDim.x) * blockDim.x) {
+    int y = i / image.width;
+    int x = i - static_cast<int64_t>(y) * image.width;
+    uint8_t *out = image.image + i * image.num_components;
+    if (image.num_components == 1) {
+      out[0] = ConvertSat<uint8_t>(SampleComponent(image.components[0], x, y));
+      continue;
+    }
+    float c0 = SampleComponent(image.components[0], x, y);
+    float c1 = SampleComponent(image.components[1], x, y);
+    float c2 = SampleComponent(image.components[2], x, y);
+    if (image.ycbcr) {
+      // JFIF YCbCr, with the full range of all the components
+      float cb = c1 - 128.0f, cr = c2 - 128.0f;
+      out[0] = ConvertSat<uint8_t>(c0 + 1.402f * cr);
+      out[1] = ConvertSat<uint8_t>(c0 - 0.344136f * cb - 0.714136f * cr);
+      out[2] = ConvertSat<uint8_t>(c0 + 1.772f * cb);
+    } else {
+      out[0] = ConvertSat<uint8_t>(c0);
+      out[1] = ConvertSat<uint8_t>(c1);
+      out[2] = ConvertSat<uint8_t>(c2);
+    }
+  }
+}
+
+}  // namespace
+
+void JpegIdctBatch(const JpegPlaneDesc *planes_gpu, int nplanes, int64_t total_blocks,
+                   cudaStream_t stream) {
+  if (total_blocks == 0)
+    return;
+  int64_t nctas = div_ceil(total_blocks, kIdctBlocksPerCta);
+  IdctKernel<<<nctas, kIdctBlocksPerCta * 64, 0, stream>>>(planes_gpu, nplanes, total_blocks);
+  CUDA_CALL(cudaGetLastError());
+}
+
+void JpegColorConvertBatch(const JpegImageDesc *images_gpu, int nimages, int64_t max_pixels,
+                           cudaStream_t stream) {
+  if (nimages == 0 || max_pixels == 0)
+    return;
+  dim3 grid(std::min<int64_t>(div_ceil(max_pixels, kColorBlockSize), kMaxColorBlocksPerImage),
+            nimages);
+  ColorConvertKernel<<<grid, kColorBlockSize, 0, stream>>>(images_gpu);
+  CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace imgcodec
+}  // namespace dali
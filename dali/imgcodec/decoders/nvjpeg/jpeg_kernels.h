@@ -0,0 +1,84 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_IMGCODEC_DECODERS_NVJPEG_JPEG_KERNELS_H_
+#define DALI_IMGCODEC_DECODERS_NVJPEG_JPEG_KERNELS_H_
+
+#include <cuda_runtime.h>
+#include <cstdint>
+
+namespace dali {
+namespace imgcodec {
+
+/**
+ * @brief A component of a JPEG image, transformed from the DCT coefficients to a plane of pixels
+ */
+struct JpegPlaneDesc {
+  /** @brief The blocks of 64 quantized coefficients, in the natural order, row by row */
+  const int16_t *coefs;
+  /** @brief The 64 quantization steps, in the natural order */
+  const uint16_t *quant;
+  /** @brief The output, `width_in_blocks * 8` pixels wide and `height_in_blocks * 8` high */
+  uint8_t *plane;
+  int width_in_blocks, height_in_blocks;
+  /** @brief The number of the blocks in the preceding planes of the batch */
+  int64_t first_block;
+};
+
+struct JpegComponentDesc {
+  const uint8_t *plane;
+  int64_t pitch;
+  /** @brief The size of the component, in pixels */
+  int width, height;
+  /** @brief The size of the component relative to the image */
+  float scale_x, scale_y;
+};
+
+/**
+ * @brief A JPEG image assembled from its (possibly subsampled) components
+ */
+struct JpegImageDesc {
+  /** @brief The output, interleaved RGB or grayscale */
+  uint8_t *image;
+  int width, height;
+  /** @brief 1 or 3 */
+  int num_components;
+  /** @brief Whether the components are converted from YCbCr to RGB */
+  bool ycbcr;
+  JpegComponentDesc components[3];
+};
+
+/**
+ * @brief Dequantizes the coefficients and computes the inverse DCT of the blocks of
+ *        a batch of planes
+ *
+ * @param planes_gpu the planes, in the order of `first_block`
+ * @param total_blocks the number of the blocks in all the planes
+ */
+void JpegIdctBatch(const JpegPlaneDesc *planes_gpu, int nplanes, int64_t total_blocks,
+                   cudaStream_t stream);
+
+/**
+ * @brief Upsamples the subsampled components (with the "fancy", i.e. linear, interpolation)
+ *        and converts the images to RGB
+ *
+ * @param max_pixels the number of the pixels in the largest image
+ */
+void JpegColorConvertBatch(const JpegImageDesc *images_gpu, int nimages, int64_t max_pixels,
+                           cudaStream_t stream);
+
+}  // namespace imgcodec
+}  // namespace dali
+
+#endif  // DALI_IMGCODEC_DECODERS_NVJPEG_JPEG_KERNELS_H_
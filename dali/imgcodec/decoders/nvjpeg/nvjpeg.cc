@@ -12,14 +12,21 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 #include "dali/core/device_guard.h"
 #include "dali/imgcodec/decoders/nvjpeg/nvjpeg.h"
 #include "dali/imgcodec/decoders/nvjpeg/nvjpeg_helper.h"
 #include "dali/imgcodec/decoders/nvjpeg/nvjpeg_memory.h"
 #include "dali/imgcodec/decoders/nvjpeg/permute_layout.h"
+#include "dali/imgcodec/parsers/jpeg.h"
+#include "dali/imgcodec/registry.h"
+#include "dali/imgcodec/util/convert.h"
+#include "dali/imgcodec/util/convert_gpu.h"
 
 namespace dali {
 namespace imgcodec {
@@ -53,6 +60,8 @@ NvJpegDecoderInstance(int device_id, const std::map<std::string, any> &params)
   for (int i = 0; i < tp_->NumThreads(); i++) {
     resources_.emplace_back(nvjpeg_handle_, &device_allocator_, &pinned_allocator_, device_id_);
   }
+
+  progressive_.event = CUDAEvent::Create(device_id_);
 }
 
 NvJpegDecoderInstance::
@@ -83,7 +92,8 @@ NvJpegDecoderInstance::PerThreadResources::PerThreadResources(PerThreadResources
 , jpeg_stream(other.jpeg_stream)
 , stream(std::move(other.stream))
 , decode_event(std::move(other.decode_event))
-, params(std::move(other.params)) {
+, params(std::move(other.params))
+, intermediate_buffer(std::move(other.intermediate_buffer)) {
   other.decoder_data = {};
   other.device_buffer = nullptr;
   other.pinned_buffer = nullptr;
@@ -100,8 +110,10 @@ NvJpegDecoderInstance::~NvJpegDecoderInstance() {
 
   // Call destructors of all thread resources.
   resources_.clear();
+  CUDA_CALL(cudaEventSynchronize(progressive_.event));
 
   CUDA_CALL(nvjpegDestroy(nvjpeg_handle_));
+  nvjpeg_memory::ReleaseCachedBuffers();
 }
 
 NvJpegDecoderInstance::PerThreadResources::~PerThreadResources() {
@@ -156,6 +168,235 @@ any NvJpegDecoderInstance::GetParam(const char *name) const {
   }
 }
 
+bool NvJpegDecoderInstance::CanDecode(DecodeContext ctx, ImageSource *in, DecodeParams opts,
+                                      const ROI &roi) {
+  try {
+    auto frame = GetJpegFrameInfo(in);
+    return frame.precision == 8 && !frame.lossless();
+  } catch (...) {
+    return false;
+  }
+}
+
+FutureDecodeResults NvJpegDecoderInstance::ScheduleDecode(DecodeContext ctx,
+                                                          span<SampleView<GPUBackend>> out,
+                                                          cspan<ImageSource *> in,
+                                                          DecodeParams opts,
+                                                          cspan<ROI> rois) {
+  assert(out.size() == in.size());
+  assert(rois.empty() || rois.size() == in.size());
+  int nsamples = in.size();
+  DecodeResultsPromise promise(nsamples);
+  std::vector<int> progressive;
+  ROI no_roi;
+  for (int i = 0; i < nsamples; i++) {
+    bool is_progressive = false;
+    try {
+      auto frame = GetJpegFrameInfo(in[i]);
+      // the CMYK images are left to nvJPEG
+      is_progressive = frame.progressive() &&
+                       (frame.num_components == 1 || frame.num_components == 3);
+    } catch (...) {
+      // let nvJPEG report the error
+    }
+    if (is_progressive) {
+      progressive.push_back(i);
+      continue;
+    }
+    auto roi = rois.empty() ? no_roi : rois[i];
+    tp_->AddWork([=, out = out[i], in = in[i]](int tid) mutable {
+        try {
+          promise.set(i, DecodeImplTask(tid, ctx.stream, out, in, opts, roi));
+        } catch (...) {
+          promise.set(i, DecodeResult::Failure(std::current_exception()));
+        }
+      }, volume(out[i].shape()));
+  }
+  if (progressive.empty()) {
+    tp_->RunAll(false);
+  } else {
+    // runs the work added above, too
+    DecodeProgressive(ctx.stream, out, in, opts, rois, make_cspan(progressive), promise);
+  }
+  return promise.get_future();
+}
+
+void NvJpegDecoderInstance::DecodeProgressive(cudaStream_t stream,
+                                              span<SampleView<GPUBackend>> out,
+                                              cspan<ImageSource *> in,
+                                              const DecodeParams &opts,
+                                              cspan<ROI> rois,
+                                              span<const int> indices,
+                                              DecodeResultsPromise &promise) {
+  auto &res = progressive_;
+  int n = indices.size();
+  while (static_cast<int>(res.readers.size()) < n)
+    res.readers.push_back(std::make_unique<JpegCoefficientReader>());
+  res.errors.clear();
+  res.errors.resize(n);
+  std::vector<Orientation> orientation(n);
+  for (int k = 0; k < n; k++) {
+    tp_->AddWork([&, k](int) {
+      ImageSource *image = in[indices[k]];
+      try {
+        if (opts.use_orientation)
+          orientation[k] = JpegParser{}.GetInfo(image).orientation;
+        res.readers[k]->Read(image->RawData<uint8_t>(), image->Size());
+      } catch (...) {
+        res.errors[k] = std::current_exception();
+      }
+    }, volume(out[indices[k]].shape()));
+  }
+  tp_->RunAll();
+
+  DeviceGuard dg(device_id_);
+  // The buffers may still be used by the previous batch
+  CUDA_CALL(cudaEventSynchronize(res.event));
+
+  // The coefficients, the planes and the images are placed one after another in the buffers
+  std::vector<int64_t> first_block(n), first_plane(n), plane_offset(n), image_offset(n);
+  std::vector<bool> direct(n);
+  int64_t nblocks = 0, nplanes = 0, planes_size = 0, images_size = 0, max_pixels = 0;
+  int ndecoded = 0;
+  for (int k = 0; k < n; k++) {
+    if (res.errors[k])
+      continue;
+    auto &reader = *res.readers[k];
+    int i = indices[k];
+    first_block[k] = nblocks;
+    first_plane[k] = nplanes;
+    plane_offset[k] = planes_size;
+    image_offset[k] = images_size;
+    nblocks += reader.NumBlocks();
+    nplanes += reader.num_components();
+    planes_size += reader.NumBlocks() * 64;
+    int64_t npixels = static_cast<int64_t>(reader.width()) * reader.height();
+    max_pixels = std::max(max_pixels, npixels);
+    DALIImageType format = reader.num_components() == 1 ? DALI_GRAY : DALI_RGB;
+    direct[k] = opts.dtype == DALI_UINT8 && !opts.needs_postprocessing() &&
+                (rois.empty() || !rois[i]) &&
+                GetOrientationSwizzle(orientation[k]).is_identity() &&
+                (opts.format == DALI_ANY_DATA || opts.format == format);
+    if (!direct[k])
+      images_size += npixels * reader.num_components();
+    ndecoded++;
+  }
+
+  int16_t *coefs_host = res.coefs_host.Resize(nblocks * 64);
+  uint16_t *quant_host = res.quant_host.Resize(nplanes * 64);
+  for (int k = 0; k < n; k++) {
+    if (res.errors[k])
+      continue;
+    tp_->AddWork([&, k](int) {
+      try {
+        res.readers[k]->CopyCoefficients(coefs_host + first_block[k] * 64,
+                                         quant_host + first_plane[k] * 64);
+      } catch (...) {
+        res.errors[k] = std::current_exception();
+      }
+      res.readers[k]->Reset();
+    }, res.readers[k]->NumBlocks());
+  }
+  tp_->RunAll();
+
+  for (int k = 0; k < n; k++) {
+    if (res.errors[k])
+      promise.set(indices[k], DecodeResult::Failure(res.errors[k]));
+  }
+  if (ndecoded == 0)
+    return;
+
+  // No work is pending, the buffers can be reallocated without preserving the contents
+  res.planes.clear();
+  res.images.clear();
+  res.coefs.clear();
+  res.coefs.resize(nblocks * 64);
+  res.quant.resize(nplanes * 64);
+  res.planes.resize(planes_size);
+  res.images.resize(images_size);
+  res.plane_descs.resize(nplanes);
+  res.image_descs.resize(n);
+
+  JpegPlaneDesc *plane_descs = res.planes_host.Resize(nplanes);
+  JpegImageDesc *image_descs = res.images_host.Resize(n);
+  int nimages = 0;
+  for (int k = 0; k < n; k++) {
+    if (res.errors[k])
+      continue;
+    auto &reader = *res.readers[k];
+    auto &image = image_descs[nimages++];
+    image.image = direct[k] ? out[indices[k]].mutable_data<uint8_t>()
+                            : res.images.data() + image_offset[k];
+    image.width = reader.width();
+    image.height = reader.height();
+    image.num_components = reader.num_components();
+    image.ycbcr = reader.ycbcr();
+    int max_h_samp = 1, max_v_samp = 1;
+    for (int c = 0; c < reader.num_components(); c++) {
+      max_h_samp = std::max(max_h_samp, reader.component(c).h_samp_factor);
+      max_v_samp = std::max(max_v_samp, reader.component(c).v_samp_factor);
+    }
+    int64_t block = first_block[k];
+    uint8_t *plane = res.planes.data() + plane_offset[k];
+    for (int c = 0; c < reader.num_components(); c++) {
+      auto comp = reader.component(c);
+      auto &plane_desc = plane_descs[first_plane[k] + c];
+      plane_desc.coefs = res.coefs.data() + block * 64;
+      plane_desc.quant = res.quant.data() + (first_plane[k] + c) * 64;
+      plane_desc.plane = plane;
+      plane_desc.width_in_blocks = comp.width_in_blocks;
+      plane_desc.height_in_blocks = comp.height_in_blocks;
+      plane_desc.first_block = block;
+
+      auto &comp_desc = image.components[c];
+      comp_desc.plane = plane;
+      comp_desc.pitch = comp.width_in_blocks * 8;
+      comp_desc.width = comp.width;
+      comp_desc.height = comp.height;
+      comp_desc.scale_x = static_cast<float>(comp.h_samp_factor) / max_h_samp;
+      comp_desc.scale_y = static_cast<float>(comp.v_samp_factor) / max_v_samp;
+
+      int64_t comp_blocks = static_cast<int64_t>(comp.width_in_blocks) * comp.height_in_blocks;
+      block += comp_blocks;
+      plane += comp_blocks * 64;
+    }
+  }
+
+  // The planes of the images which failed in CopyCoefficients are transformed, too,
+  // but not used
+  CUDA_CALL(cudaMemcpyAsync(res.coefs.data(), coefs_host, nblocks * 64 * sizeof(int16_t),
+                            cudaMemcpyHostToDevice, stream));
+  CUDA_CALL(cudaMemcpyAsync(res.quant.data(), quant_host, nplanes * 64 * sizeof(uint16_t),
+                            cudaMemcpyHostToDevice, stream));
+  CUDA_CALL(cudaMemcpyAsync(res.plane_descs.data(), plane_descs,
+                            nplanes * sizeof(JpegPlaneDesc), cudaMemcpyHostToDevice, stream));
+  CUDA_CALL(cudaMemcpyAsync(res.image_descs.data(), image_descs,
+                            nimages * sizeof(JpegImageDesc), cudaMemcpyHostToDevice, stream));
+  JpegIdctBatch(res.plane_descs.data(), nplanes, nblocks, stream);
+  JpegColorConvertBatch(res.image_descs.data(), nimages, max_pixels, stream);
+
+  int image_idx = 0;
+  for (int k = 0; k < n; k++) {
+    if (res.errors[k])
+      continue;
+    const auto &image = image_descs[image_idx++];
+    int i = indices[k];
+    try {
+      if (!direct[k]) {
+        DALIImageType format = image.num_components == 1 ? DALI_GRAY : DALI_RGB;
+        TensorShape<> shape = {image.height, image.width, image.num_components};
+        ConstSampleView<GPUBackend> decoded(image.image, shape, DALI_UINT8);
+        Convert(out[i], opts, decoded, "HWC", format, stream, rois.empty() ? ROI{} : rois[i],
+                1.0f, orientation[k]);
+      }
+      promise.set(i, DecodeResult::Success());
+    } catch (...) {
+      promise.set(i, DecodeResult::Failure(std::current_exception()));
+    }
+  }
+  CUDA_CALL(cudaEventRecord(res.event, stream));
+}
+
 DecodeResult NvJpegDecoderInstance::DecodeImplTask(int thread_idx,
                                                    cudaStream_t stream,
                                                    SampleView<GPUBackend> out,
@@ -173,7 +414,25 @@ DecodeResult NvJpegDecoderInstance::DecodeImplTask(int thread_idx,
     }
 
     ParseJpegSample(*in, opts, ctx);
-    DecodeJpegSample(*in, out.mutable_data<uint8_t>(), opts, ctx);
+    // nvJPEG writes interleaved uint8 pixels in the requested color space
+    ctx.shape[2] = NumberOfChannels(opts.format, ctx.shape[2]);
+    // the orientation is applied while converting the decoded image
+    Orientation orientation = opts.use_orientation ? JpegParser{}.GetInfo(in).orientation
+                                                   : Orientation{};
+    if (opts.dtype != DALI_UINT8 || opts.needs_postprocessing() ||
+        !GetOrientationSwizzle(orientation).is_identity()) {
+      // The intermediate buffer may still be used by the previous image
+      auto &buffer = ctx.resources.intermediate_buffer;
+      CUDA_CALL(cudaEventSynchronize(ctx.resources.decode_event));
+      buffer.resize(volume(ctx.shape));
+      DecodeJpegSample(*in, buffer.data(), opts, ctx);
+      ConstSampleView<GPUBackend> decoded(buffer.data(), ctx.shape, DALI_UINT8);
+      Convert(out, opts, decoded, "HWC", opts.format, ctx.resources.stream, {}, 1.0f,
+              orientation);
+      CUDA_CALL(cudaEventRecord(ctx.resources.decode_event, ctx.resources.stream));
+    } else {
+      DecodeJpegSample(*in, out.mutable_data<uint8_t>(), opts, ctx);
+    }
   } catch (...) {
     return {false, std::current_exception()};
   }
@@ -229,5 +488,7 @@ void NvJpegDecoderInstance::DecodeJpegSample(ImageSource& in, uint8_t *out, Deco
   CUDA_CALL(cudaEventRecord(decode_event, stream));
 }
 
+REGISTER_DECODER("JPEG", NvJpegDecoderFactory, CUDADecoderPriority);
+
 }  // namespace imgcodec
 }  // namespace dali
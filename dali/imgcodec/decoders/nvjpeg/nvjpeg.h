@@ -16,6 +16,7 @@
 #define DALI_IMGCODEC_DECODERS_NVJPEG_NVJPEG_H_
 
 #include <nvjpeg.h>
+#include <exception>
 #include <map>
 #include <memory>
 #include <string>
@@ -24,7 +25,10 @@
 #include "dali/core/cuda_stream_pool.h"
 #include "dali/core/dev_buffer.h"
 #include "dali/imgcodec/decoders/decoder_parallel_impl.h"
+#include "dali/imgcodec/decoders/nvjpeg/jpeg_coefficients.h"
+#include "dali/imgcodec/decoders/nvjpeg/jpeg_kernels.h"
 #include "dali/imgcodec/decoders/nvjpeg/nvjpeg_memory.h"
+#include "dali/imgcodec/util/pinned_buffer.h"
 
 namespace dali {
 namespace imgcodec {
@@ -34,19 +38,24 @@ class DLL_PUBLIC NvJpegDecoderInstance : public BatchParallelDecoderImpl {
   explicit NvJpegDecoderInstance(int device_id, const std::map<std::string, any> &params);
 
   // NvjpegDecoderInstance has to operate on its own thread pool instead of the
-  // one passed by the DecodeContext. Overriding thread pool pointer caried in
-  // the context argument of this variant of
-  // BatchParallelDecoderImpl::ScheduleDecode is enough to cover all the Decode
-  // and ScheduleDecode functions. This is because all that functions
-  // eventually call this variant of ScheduleDecode.
+  // one passed by the DecodeContext. All the Decode and ScheduleDecode functions
+  // eventually call this variant of ScheduleDecode, which uses tp_.
+  //
+  // The progressive images are decoded in a batch (see DecodeProgressive), the others
+  // one by one, with nvJPEG, in the same thread pool.
+  using BatchParallelDecoderImpl::ScheduleDecode;
   FutureDecodeResults ScheduleDecode(DecodeContext ctx,
                                      span<SampleView<GPUBackend>> out,
                                      cspan<ImageSource *> in,
                                      DecodeParams opts,
-                                     cspan<ROI> rois = {}) override {
-    ctx.tp = tp_.get();
-    return BatchParallelDecoderImpl::ScheduleDecode(ctx, out, in, opts, rois);
-  }
+                                     cspan<ROI> rois = {}) override;
+
+  using BatchParallelDecoderImpl::CanDecode;
+  /**
+   * @brief Accepts the 8-bit lossy images; the lossless and 12-bit JPEGs are left to the other
+   *        decoders
+   */
+  bool CanDecode(DecodeContext ctx, ImageSource *in, DecodeParams opts, const ROI &roi) override;
 
   DecodeResult DecodeImplTask(int thread_idx,
                               cudaStream_t stream,
@@ -85,6 +94,9 @@ class DLL_PUBLIC NvJpegDecoderInstance : public BatchParallelDecoderImpl {
 
     nvjpegDecodeParams_t params;
 
+    /** @brief The decoded image, when it's converted while writing the output */
+    DeviceBuffer<uint8_t> intermediate_buffer;
+
     PerThreadResources(nvjpegHandle_t, nvjpegDevAllocator_t*, nvjpegPinnedAllocator_t*,
                        int device_id);
     PerThreadResources(PerThreadResources&&);
@@ -103,6 +115,40 @@ class DLL_PUBLIC NvJpegDecoderInstance : public BatchParallelDecoderImpl {
 
   void ParseJpegSample(ImageSource& in, DecodeParams opts, DecodingContext& ctx);
   void DecodeJpegSample(ImageSource& in, uint8_t *out, DecodeParams opts, DecodingContext &ctx);
+
+  /**
+   * @brief Decodes the progressive images on the GPU
+   *
+   * nvJPEG decodes the progressive images on the host. Instead, the entropy decoding of all
+   * the scans is done by libjpeg in the thread pool (concurrently with the host part of decoding
+   * the other images), and the dequantization, the inverse DCT, the upsampling and the color
+   * conversion are done for the whole batch with a few kernel launches.
+   *
+   * @param indices the indices of the progressive images in the batch
+   */
+  void DecodeProgressive(cudaStream_t stream, span<SampleView<GPUBackend>> out,
+                         cspan<ImageSource *> in, const DecodeParams &opts, cspan<ROI> rois,
+                         span<const int> indices, DecodeResultsPromise &promise);
+
+  struct ProgressiveResources {
+    std::vector<std::unique_ptr<JpegCoefficientReader>> readers;
+    std::vector<std::exception_ptr> errors;
+    /** @brief Recorded when the buffers are no longer used */
+    CUDAEvent event;
+
+    PinnedBuffer<int16_t> coefs_host;
+    PinnedBuffer<uint16_t> quant_host;
+    PinnedBuffer<JpegPlaneDesc> planes_host;
+    PinnedBuffer<JpegImageDesc> images_host;
+    DeviceBuffer<int16_t> coefs;
+    DeviceBuffer<uint16_t> quant;
+    DeviceBuffer<JpegPlaneDesc> plane_descs;
+    DeviceBuffer<JpegImageDesc> image_descs;
+    /** @brief The components, transformed to pixels */
+    DeviceBuffer<uint8_t> planes;
+    /** @brief The decoded images, which are converted while writing the output */
+    DeviceBuffer<uint8_t> images;
+  } progressive_;
 };
 
 class NvJpegDecoderFactory : public ImageDecoderFactory {
@@ -0,0 +1,171 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/imgcodec/decoders/nvjpeg/nvjpeg_lossless.h"
+#include <climits>
+#include <map>
+#include <string>
+#include <vector>
+#include "dali/core/device_guard.h"
+#include "dali/imgcodec/decoders/nvjpeg/nvjpeg_helper.h"
+#include "dali/imgcodec/decoders/nvjpeg/nvjpeg_memory.h"
+#include "dali/imgcodec/parsers/jpeg.h"
+#include "dali/imgcodec/registry.h"
+#include "dali/imgcodec/util/convert.h"
+#include "dali/imgcodec/util/convert_gpu.h"
+
+namespace dali {
+namespace imgcodec {
+
+#if NVJPEG_LOSSLESS_SUPPORTED
+
+NvJpegLosslessDecoderInstance::
+NvJpegLosslessDecoderInstance(int device_id, const std::map<std::string, any> &params)
+: BatchParallelDecoderImpl(device_id, params)
+, device_allocator_(nvjpeg_memory::GetDeviceAllocator())
+, pinned_allocator_(nvjpeg_memory::GetPinnedAllocator()) {
+  SetParams(params);
+
+  DeviceGuard dg(device_id_);
+  CUDA_CALL(nvjpegCreateEx(NVJPEG_BACKEND_LOSSLESS_JPEG, &device_allocator_, &pinned_allocator_,
+                           0, &nvjpeg_handle_));
+  CUDA_CALL(nvjpegJpegStateCreate(nvjpeg_handle_, &state_));
+  CUDA_CALL(nvjpegJpegStreamCreate(nvjpeg_handle_, &jpeg_stream_));
+  decode_event_ = CUDAEvent::Create(device_id_);
+}
+
+NvJpegLosslessDecoderInstance::~NvJpegLosslessDecoderInstance() {
+  DeviceGuard dg(device_id_);
+  CUDA_CALL(cudaEventSynchronize(decode_event_));
+  CUDA_CALL(nvjpegJpegStreamDestroy(jpeg_stream_));
+  CUDA_CALL(nvjpegJpegStateDestroy(state_));
+  CUDA_CALL(nvjpegDestroy(nvjpeg_handle_));
+}
+
+bool NvJpegLosslessDecoderInstance::CanDecode(DecodeContext ctx, ImageSource *in,
+                                              DecodeParams opts, const ROI &roi) {
+  if (roi)
+    return false;
+  try {
+    auto frame = GetJpegFrameInfo(in);
+    if (!frame.lossless() || frame.precision > 16)
+      return false;
+    // nvJPEG supports a subset of the lossless images (e.g. only some of the predictors)
+    std::lock_guard<std::mutex> guard(parse_mutex_);
+    CUDA_CALL(nvjpegJpegStreamParseHeader(nvjpeg_handle_, in->RawData<unsigned char>(),
+                                          in->Size(), jpeg_stream_));
+    int is_supported = -1;
+    CUDA_CALL(nvjpegDecodeBatchedSupported(nvjpeg_handle_, jpeg_stream_, &is_supported));
+    return is_supported == 0;
+  } catch (...) {
+    return false;
+  }
+}
+
+FutureDecodeResults NvJpegLosslessDecoderInstance::ScheduleDecode(DecodeContext ctx,
+                                                                  span<SampleView<GPUBackend>> out,
+                                                                  cspan<ImageSource *> in,
+                                                                  DecodeParams opts,
+                                                                  cspan<ROI> rois) {
+  assert(out.size() == in.size());
+  assert(rois.empty() || rois.size() == in.size());
+  DecodeResultsPromise promise(in.size());
+  try {
+    DecodeBatch(ctx.stream, out, in, opts);
+    for (int i = 0; i < in.size(); i++)
+      promise.set(i, {true, nullptr});
+  } catch (...) {
+    // the batch is decoded at once - the samples can only fail together
+    for (int i = 0; i < in.size(); i++)
+      promise.set(i, DecodeResult::Failure(std::current_exception()));
+  }
+  return promise.get_future();
+}
+
+void NvJpegLosslessDecoderInstance::DecodeBatch(cudaStream_t stream,
+                                                span<SampleView<GPUBackend>> out,
+                                                cspan<ImageSource *> in,
+                                                const DecodeParams &opts) {
+  int nsamples = in.size();
+  if (nsamples == 0)
+    return;
+  DeviceGuard dg(device_id_);
+
+  std::vector<const unsigned char *> data(nsamples);
+  std::vector<size_t> sizes(nsamples);
+  std::vector<TensorShape<>> shapes(nsamples);
+  std::vector<int> precision(nsamples);
+  std::vector<bool> direct(nsamples);
+  std::vector<Orientation> orientation(nsamples);
+  int64_t intermediate_size = 0;
+  for (int i = 0; i < nsamples; i++) {
+    data[i] = in[i]->RawData<unsigned char>();
+    sizes[i] = in[i]->Size();
+    int widths[NVJPEG_MAX_COMPONENT], heights[NVJPEG_MAX_COMPONENT], c;
+    nvjpegChromaSubsampling_t subsampling;
+    CUDA_CALL(nvjpegGetImageInfo(nvjpeg_handle_, data[i], sizes[i], &c, &subsampling,
+                                 widths, heights));
+    shapes[i] = {heights[0], widths[0], c};
+    precision[i] = GetJpegFrameInfo(in[i]).precision;
+    if (opts.use_orientation)
+      orientation[i] = JpegParser{}.GetInfo(in[i]).orientation;
+    DALIImageType format = c == 1 ? DALI_GRAY : DALI_RGB;
+    // nvJPEG writes interleaved uint16 samples, in the range given by the precision
+    direct[i] = opts.dtype == DALI_UINT16 && precision[i] == 16 && !opts.needs_postprocessing() &&
+                GetOrientationSwizzle(orientation[i]).is_identity() &&
+                (opts.format == DALI_ANY_DATA || opts.format == format);
+    if (!direct[i])
+      intermediate_size += volume(shapes[i]);
+  }
+
+  // The intermediate buffer may still be used by the previous batch
+  CUDA_CALL(cudaEventSynchronize(decode_event_));
+  intermediate_buffer_.resize(intermediate_size);
+
+  std::vector<nvjpegImage_t> images(nsamples);
+  int64_t offset = 0;
+  for (int i = 0; i < nsamples; i++) {
+    uint16_t *decoded = direct[i] ? out[i].mutable_data<uint16_t>()
+                                  : intermediate_buffer_.data() + offset;
+    if (!direct[i])
+      offset += volume(shapes[i]);
+    images[i] = {};
+    images[i].channel[0] = reinterpret_cast<unsigned char *>(decoded);
+    images[i].pitch[0] = shapes[i][1] * shapes[i][2] * sizeof(uint16_t);
+  }
+
+  CUDA_CALL(nvjpegDecodeBatchedInitialize(nvjpeg_handle_, state_, nsamples, 1,
+                                          NVJPEG_OUTPUT_UNCHANGEDI_U16));
+  CUDA_CALL(nvjpegDecodeBatched(nvjpeg_handle_, state_, data.data(), sizes.data(),
+                                images.data(), stream));
+
+  for (int i = 0; i < nsamples; i++) {
+    if (direct[i])
+      continue;
+    DALIImageType format = shapes[i][2] == 1 ? DALI_GRAY : DALI_RGB;
+    ConstSampleView<GPUBackend> decoded(reinterpret_cast<uint16_t *>(images[i].channel[0]),
+                                        shapes[i], DALI_UINT16);
+    // scale the samples of lower precision to the full range of uint16
+    float multiplier = static_cast<float>(UINT16_MAX) / ((1 << precision[i]) - 1);
+    Convert(out[i], opts, decoded, "HWC", format, stream, {}, multiplier, orientation[i]);
+  }
+  CUDA_CALL(cudaEventRecord(decode_event_, stream));
+}
+
+REGISTER_DECODER("JPEG", NvJpegLosslessDecoderFactory, CUDADecoderPriority);
+
+#endif  // NVJPEG_LOSSLESS_SUPPORTED
+
+}  // namespace imgcodec
+}  // namespace dali
@@ -0,0 +1,107 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_IMGCODEC_DECODERS_NVJPEG_NVJPEG_LOSSLESS_H_
+#define DALI_IMGCODEC_DECODERS_NVJPEG_NVJPEG_LOSSLESS_H_
+
+#include <nvjpeg.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "dali/core/cuda_event.h"
+#include "dali/core/dev_buffer.h"
+#include "dali/imgcodec/decoders/decoder_parallel_impl.h"
+
+// The lossless (process 14) decoding was added in nvJPEG 12.2
+#if NVJPEG_VER_MAJOR > 12 || (NVJPEG_VER_MAJOR == 12 && NVJPEG_VER_MINOR >= 2)
+  #define NVJPEG_LOSSLESS_SUPPORTED 1
+#else
+  #define NVJPEG_LOSSLESS_SUPPORTED 0
+#endif
+
+namespace dali {
+namespace imgcodec {
+
+#if NVJPEG_LOSSLESS_SUPPORTED
+
+/**
+ * @brief Decodes the lossless JPEG images (up to 16 bits per sample) with nvJPEG
+ *
+ * Unlike NvJpegDecoderInstance, the whole batch is decoded with a single call to the batched
+ * nvJPEG API, with both the Huffman decoding and the prediction done on the GPU.
+ * The images are decoded to uint16, with the samples of lower precision scaled to the full range.
+ */
+class DLL_PUBLIC NvJpegLosslessDecoderInstance : public BatchParallelDecoderImpl {
+ public:
+  explicit NvJpegLosslessDecoderInstance(int device_id, const std::map<std::string, any> &params);
+  ~NvJpegLosslessDecoderInstance();
+
+  using BatchParallelDecoderImpl::CanDecode;
+  bool CanDecode(DecodeContext ctx, ImageSource *in, DecodeParams opts, const ROI &roi) override;
+
+  using BatchParallelDecoderImpl::ScheduleDecode;
+  FutureDecodeResults ScheduleDecode(DecodeContext ctx,
+                                     span<SampleView<GPUBackend>> out,
+                                     cspan<ImageSource *> in,
+                                     DecodeParams opts,
+                                     cspan<ROI> rois = {}) override;
+
+ private:
+  void DecodeBatch(cudaStream_t stream, span<SampleView<GPUBackend>> out,
+                   cspan<ImageSource *> in, const DecodeParams &opts);
+
+  nvjpegDevAllocator_t device_allocator_;
+  nvjpegPinnedAllocator_t pinned_allocator_;
+  nvjpegHandle_t nvjpeg_handle_ = nullptr;
+  nvjpegJpegState_t state_ = nullptr;
+  /** @brief Used by CanDecode, which may run concurrently */
+  std::mutex parse_mutex_;
+  nvjpegJpegStream_t jpeg_stream_ = nullptr;
+  /** @brief The decoded images which are converted while writing the output */
+  DeviceBuffer<uint16_t> intermediate_buffer_;
+  CUDAEvent decode_event_;
+};
+
+#endif  // NVJPEG_LOSSLESS_SUPPORTED
+
+class NvJpegLosslessDecoderFactory : public ImageDecoderFactory {
+ public:
+  ImageDecoderProperties GetProperties() const override {
+    ImageDecoderProperties props;
+    props.supports_partial_decoding = false;
+    props.supported_input_kinds = InputKind::HostMemory;
+    props.gpu_output = true;
+    props.fallback = true;
+    return props;
+  }
+
+  bool IsSupported(int device_id) const override {
+    return NVJPEG_LOSSLESS_SUPPORTED && device_id >= 0;
+  }
+
+  std::shared_ptr<ImageDecoderInstance>
+  Create(int device_id, const std::map<std::string, any> &params = {}) const override {
+#if NVJPEG_LOSSLESS_SUPPORTED
+    return std::make_shared<NvJpegLosslessDecoderInstance>(device_id, params);
+#else
+    return nullptr;
+#endif
+  }
+};
+
+}  // namespace imgcodec
+}  // namespace dali
+
+#endif  // DALI_IMGCODEC_DECODERS_NVJPEG_NVJPEG_LOSSLESS_H_
@@ -0,0 +1,187 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "dali/imgcodec/decoders/decoder_test_helper.h"
+#include "dali/imgcodec/decoders/nvjpeg/nvjpeg_lossless.h"
+#include "dali/imgcodec/parsers/jpeg.h"
+
+namespace dali {
+namespace imgcodec {
+namespace test {
+
+namespace {
+
+class BitWriter {
+ public:
+  explicit BitWriter(std::vector<uint8_t> &out) : out_(out) {}
+
+  void Write(uint32_t bits, int nbits) {
+    for (int i = nbits - 1; i >= 0; i--) {
+      byte_ = (byte_ << 1) | ((bits >> i) & 1);
+      if (++nbits_ == 8)
+        Flush();
+    }
+  }
+
+  /** @brief Pads the last byte with ones */
+  void Finish() {
+    while (nbits_ != 0)
+      Write(1, 1);
+  }
+
+ private:
+  void Flush() {
+    out_.push_back(byte_);
+    if (byte_ == 0xff)
+      out_.push_back(0);  // byte stuffing
+    byte_ = 0;
+    nbits_ = 0;
+  }
+
+  std::vector<uint8_t> &out_;
+  uint8_t byte_ = 0;
+  int nbits_ = 0;
+};
+
+/**
+ * @brief Encodes a grayscale image as a lossless JPEG with the predictor 1
+ *
+ * The Huffman table assigns 5-bit codes to all the difference categories, 0 to 16.
+ */
+std::vector<uint8_t> EncodeLosslessJpeg(const std::vector<uint16_t> &img, int height, int width,
+                                        int precision) {
+  std::vector<uint8_t> out = {0xff, 0xd8};
+  // DHT: a DC table 0 with 17 codes of length 5
+  out.insert(out.end(), {0xff, 0xc4, 0, 36, 0x00});
+  for (int len = 1; len <= 16; len++)
+    out.push_back(len == 5 ? 17 : 0);
+  for (int ssss = 0; ssss <= 16; ssss++)
+    out.push_back(ssss);
+  // SOF3
+  out.insert(out.end(), {0xff, 0xc3, 0, 11, static_cast<uint8_t>(precision),
+                         static_cast<uint8_t>(height >> 8), static_cast<uint8_t>(height),
+                         static_cast<uint8_t>(width >> 8), static_cast<uint8_t>(width),
+                         1, 1, 0x11, 0});
+  // SOS: the predictor 1, no point transform
+  out.insert(out.end(), {0xff, 0xda, 0, 8, 1, 1, 0x00, 1, 0, 0});
+
+  BitWriter writer(out);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int pred = x > 0 ? img[y * width + x - 1]
+               : y > 0 ? img[(y - 1) * width]
+               : 1 << (precision - 1);
+      int diff = (img[y * width + x] - pred) & 0xffff;
+      if (diff > 32768)
+        diff -= 65536;
+      int ssss = 0;
+      while (ssss < 16 && (1 << ssss) <= std::abs(diff))
+        ssss++;
+      writer.Write(ssss, 5);
+      if (ssss > 0 && ssss < 16)
+        writer.Write(diff > 0 ? diff : diff + (1 << ssss) - 1, ssss);
+    }
+  }
+  writer.Finish();
+  out.insert(out.end(), {0xff, 0xd9});
+  return out;
+}
+
+}  // namespace
+
+class NvJpegLosslessDecoderTest : public NumpyDecoderTestBase<GPUBackend, uint16_t> {
+ protected:
+  void SetUp() override {
+    if (!NvJpegLosslessDecoderFactory().IsSupported(GetDeviceId()))
+      GTEST_SKIP() << "Lossless JPEG decoding is not supported by this version of nvJPEG";
+  }
+
+  std::shared_ptr<ImageDecoderInstance> CreateDecoder() override {
+    return NvJpegLosslessDecoderFactory().Create(GetDeviceId());
+  }
+
+  std::shared_ptr<ImageParser> CreateParser() override {
+    return std::make_shared<JpegParser>();
+  }
+
+  std::vector<uint16_t> RandomImage(int height, int width, int precision) {
+    std::vector<uint16_t> img(height * width);
+    std::uniform_int_distribution<int> dist(0, (1 << precision) - 1);
+    for (auto &x : img)
+      x = dist(rng_);
+    return img;
+  }
+
+  DecodeParams GetParams() {
+    DecodeParams opts{};
+    opts.dtype = DALI_UINT16;
+    opts.format = DALI_ANY_DATA;
+    return opts;
+  }
+
+  std::mt19937 rng_{1234};
+};
+
+TEST_F(NvJpegLosslessDecoderTest, Decode16Bit) {
+  int height = 13, width = 17;
+  auto img = RandomImage(height, width, 16);
+  auto encoded = EncodeLosslessJpeg(img, height, width, 16);
+  auto src = ImageSource::FromHostMem(encoded.data(), encoded.size());
+  auto decoded = Decode(&src, GetParams());
+  ASSERT_EQ(decoded.shape, TensorShape<>(height, width, 1));
+  for (int i = 0; i < height * width; i++)
+    ASSERT_EQ(decoded.data[i], img[i]) << "at pixel " << i;
+}
+
+TEST_F(NvJpegLosslessDecoderTest, Decode12BitBatch) {
+  // the samples of lower precision are scaled to the full range of the output type
+  int height = 20, width = 9, nsamples = 3;
+  std::vector<std::vector<uint16_t>> imgs;
+  std::vector<std::vector<uint8_t>> encoded;
+  std::vector<ImageSource> srcs;
+  for (int i = 0; i < nsamples; i++) {
+    imgs.push_back(RandomImage(height, width, 12));
+    encoded.push_back(EncodeLosslessJpeg(imgs[i], height, width, 12));
+  }
+  for (auto &e : encoded)
+    srcs.push_back(ImageSource::FromHostMem(e.data(), e.size()));
+  std::vector<ImageSource *> in;
+  for (auto &src : srcs)
+    in.push_back(&src);
+
+  auto decoded = Decode(make_cspan(in), GetParams());
+  for (int s = 0; s < nsamples; s++) {
+    ASSERT_EQ(decoded[s].shape, TensorShape<>(height, width, 1));
+    for (int i = 0; i < height * width; i++) {
+      float expected = imgs[s][i] * 65535.0f / 4095;
+      ASSERT_NEAR(decoded[s].data[i], expected, 1) << "sample " << s << ", pixel " << i;
+    }
+  }
+}
+
+TEST_F(NvJpegLosslessDecoderTest, RejectsLossy) {
+  std::vector<uint8_t> lossy = {0xff, 0xd8,
+                                0xff, 0xc0, 0, 11, 8, 0, 20, 0, 30, 1, 1, 0x11, 0,
+                                0xff, 0xda, 0, 8, 1, 1, 0, 0, 63, 0, 0xff, 0xd9};
+  auto src = ImageSource::FromHostMem(lossy.data(), lossy.size());
+  EXPECT_FALSE(Decoder()->CanDecode(Context(), &src, GetParams()));
+}
+
+}  // namespace test
+}  // namespace imgcodec
+}  // namespace dali
@@ -66,6 +66,10 @@ void DeleteAllBuffers(std::thread::id thread_id) {
   BufferPoolManager::instance().DeleteAllBuffers(thread_id);
 }
 
+void ReleaseCachedBuffers() {
+  BufferPoolManager::instance().ReleaseCachedBuffers();
+}
+
 void SetEnableMemStats(bool enabled) {
   BufferPoolManager::instance().SetEnableMemStats(enabled);
 }
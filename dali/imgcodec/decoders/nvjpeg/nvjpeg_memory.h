@@ -55,6 +55,11 @@ void AddHostBuffer(std::thread::id thread_id, size_t size);
  */
 void DeleteAllBuffers(std::thread::id thread_id);
 
+/**
+ * @brief Frees the buffers kept for reuse after being released by the libraries
+ */
+void ReleaseCachedBuffers();
+
 /**
  * @brief Enables/disables nvJPEG allocation statistics collection
  */
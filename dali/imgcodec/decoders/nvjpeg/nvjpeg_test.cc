@@ -13,8 +13,11 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <cstdlib>
 #include <string>
+#include <vector>
 #include "dali/imgcodec/decoders/decoder_test_helper.h"
+#include "dali/imgcodec/decoders/jpeg/jpeg_mem.h"
 #include "dali/imgcodec/decoders/nvjpeg/nvjpeg.h"
 #include "dali/imgcodec/parsers/jpeg.h"
 #include "dali/test/dali_test.h"
@@ -55,6 +58,35 @@ struct ImageBuffer {
   }
 };
 
+std::vector<uint8_t> EncodeJpeg(const uint8_t *pixels, int width, int height, int channels,
+                                bool progressive) {
+  jpeg_compress_struct cinfo;
+  jpeg_error_mgr jerr;
+  cinfo.err = jpeg_std_error(&jerr);
+  jpeg_create_compress(&cinfo);
+  unsigned char *buffer = nullptr;
+  unsigned long size = 0;  // NOLINT(runtime/int)
+  jpeg_mem_dest(&cinfo, &buffer, &size);
+  cinfo.image_width = width;
+  cinfo.image_height = height;
+  cinfo.input_components = channels;
+  cinfo.in_color_space = channels == 1 ? JCS_GRAYSCALE : JCS_RGB;
+  jpeg_set_defaults(&cinfo);
+  jpeg_set_quality(&cinfo, 90, TRUE);
+  if (progressive)
+    jpeg_simple_progression(&cinfo);
+  jpeg_start_compress(&cinfo, TRUE);
+  for (int y = 0; y < height; y++) {
+    JSAMPROW row = const_cast<uint8_t *>(pixels) + y * width * channels;
+    jpeg_write_scanlines(&cinfo, &row, 1);
+  }
+  jpeg_finish_compress(&cinfo);
+  jpeg_destroy_compress(&cinfo);
+  std::vector<uint8_t> encoded(buffer, buffer + size);
+  free(buffer);
+  return encoded;
+}
+
 template<typename OutputType>
 class NvJpegDecoderTest : public NumpyDecoderTestBase<GPUBackend, OutputType> {
  public:
@@ -125,6 +157,38 @@ class NvJpegDecoderTest : public NumpyDecoderTestBase<GPUBackend, OutputType> {
 
     this->AssertSimilar(decoded, ref);
   }
+
+  /**
+   * @brief Decodes a progressive image, in a batch with a baseline one (for RGB), and compares
+   *        it with the image decoded by libjpeg
+   */
+  void RunProgressiveTest(int channels) {
+    ImageBuffer baseline(from_dali_extra("db/single/jpeg/134/site-1534685_1280.jpg"));
+    int width, height;
+    ASSERT_TRUE(jpeg::GetImageInfo(baseline.buffer.data(), baseline.buffer.size(),
+                                   &width, &height, nullptr));
+    jpeg::UncompressFlags flags;
+    flags.components = channels;
+    auto pixels = jpeg::Uncompress(baseline.buffer.data(), baseline.buffer.size(), flags);
+    ASSERT_NE(pixels, nullptr);
+    auto encoded = EncodeJpeg(pixels.get(), width, height, channels, true);
+    auto src = ImageSource::FromHostMem(encoded.data(), encoded.size());
+    ASSERT_TRUE(GetJpegFrameInfo(&src).progressive());
+    auto ref = jpeg::Uncompress(encoded.data(), encoded.size(), flags);
+    ASSERT_NE(ref, nullptr);
+    TensorView<StorageCPU, const uint8_t> ref_view(ref.get(),
+                                                   TensorShape<>{height, width, channels});
+
+    auto params = this->GetParams();
+    params.format = channels == 1 ? DALI_GRAY : DALI_RGB;
+    std::vector<ImageSource *> in = {&src, &src};
+    if (channels == 3)
+      in.push_back(&baseline.src);
+    auto decoded = this->Decode(make_cspan(in), params);
+    // the inverse DCT and the upsampling differ from libjpeg only in rounding
+    Check(decoded[0], ref_view, EqualEps(4));
+    Check(decoded[1], ref_view, EqualEps(4));
+  }
 };
 
 using DecodeOutputTypes = ::testing::Types<uint8_t>;
@@ -138,6 +202,14 @@ TYPED_TEST(NvJpegDecoderTest, DecodeSingleYCbCr) {
   this->RunSingleYCbCrTest();
 }
 
+TYPED_TEST(NvJpegDecoderTest, DecodeProgressive) {
+  this->RunProgressiveTest(3);
+}
+
+TYPED_TEST(NvJpegDecoderTest, DecodeProgressiveGray) {
+  this->RunProgressiveTest(1);
+}
+
 }  // namespace test
 }  // namespace imgcodec
 }  // namespace dali
@@ -85,6 +85,7 @@ NvJpeg2000DecoderInstance::~NvJpeg2000DecoderInstance() {
     CUDA_CALL(cudaStreamSynchronize(res.cuda_stream));
   for (const auto &thread_id : tp_->GetThreadIds())
     nvjpeg_memory::DeleteAllBuffers(thread_id);
+  nvjpeg_memory::ReleaseCachedBuffers();
 }
 
 bool NvJpeg2000DecoderInstance::ParseJpeg2000Info(ImageSource *in, Context &ctx) {
@@ -147,72 +148,99 @@ nvjpeg2kImage_t NvJpeg2000DecoderInstance::PrepareOutputArea(void *out,
 }
 
 bool NvJpeg2000DecoderInstance::DecodeJpeg2000(ImageSource *in, void *out, const Context &ctx) {
+  if (ctx.roi)
+    return DecodeJpeg2000Tiles(in, out, ctx.roi, ctx);
+
+  auto &image_info = ctx.image_info;
+  if (image_info.num_tiles_x * image_info.num_tiles_y > 1) {
+    // The tiles are decoded in parallel
+    ROI whole_image = {{0, 0}, {ctx.shape[1], ctx.shape[2]}};
+    return DecodeJpeg2000Tiles(in, out, whole_image, ctx);
+  }
+
+  void *pixel_data[NVJPEG_MAX_COMPONENT] = {};
+  size_t pitch_in_bytes[NVJPEG_MAX_COMPONENT] = {};
+  auto output_image = PrepareOutputArea(out, pixel_data, pitch_in_bytes, 0, 0, ctx);
+  auto ret = nvjpeg2kDecode(nvjpeg2k_handle_, ctx.nvjpeg2k_decode_state,
+                            ctx.nvjpeg2k_stream, &output_image, ctx.cuda_stream);
+  return check_status(ret, in);
+}
+
+bool NvJpeg2000DecoderInstance::DecodeJpeg2000Tiles(ImageSource *in, void *out, const ROI &roi,
+                                                    const Context &ctx) {
   // allocating buffers
   void *pixel_data[NVJPEG_MAX_COMPONENT] = {};
   size_t pitch_in_bytes[NVJPEG_MAX_COMPONENT] = {};
 
-  if (!ctx.roi) {
-    auto output_image = PrepareOutputArea(out, pixel_data, pitch_in_bytes, 0, 0, ctx);
-    auto ret = nvjpeg2kDecode(nvjpeg2k_handle_, ctx.nvjpeg2k_decode_state,
-                              ctx.nvjpeg2k_stream, &output_image, ctx.cuda_stream);
-    return check_status(ret, in);
-  } else {
-    // Decode tile by tile: nvjpeg2kDecodeImage seems to be bugged
-    auto &image_info = ctx.image_info;
-    auto &roi = ctx.roi;
-    std::array tile_shape = {image_info.tile_height, image_info.tile_width};
-
-    int state_idx = 0;
-    for (uint32_t tile_y = 0; tile_y < image_info.num_tiles_y; tile_y++) {
-     for (uint32_t tile_x = 0; tile_x < image_info.num_tiles_x; tile_x++) {
-        auto calc_one_dimension = [&](int dim) {
-          uint32_t tile_nr = (dim == 1 ? tile_x : tile_y);
-          uint32_t tile_begin = tile_nr * tile_shape[dim];
-          uint32_t tile_end = tile_begin + tile_shape[dim];
-          uint32_t roi_begin = roi.begin[dim];
-          uint32_t roi_end = roi.end[dim];
-
-          // Intersection of roi and tile
-          uint32_t decode_begin = std::max(roi_begin, tile_begin);
-          uint32_t decode_end = std::min(roi_end, tile_end);
-          uint32_t output_offset = tile_begin > roi_begin ? tile_begin - roi_begin : 0;
-
-          return std::tuple{decode_begin, decode_end, output_offset};
-        };
-
-        auto [begin_x, end_x, output_offset_x] = calc_one_dimension(1);
-        auto [begin_y, end_y, output_offset_y] = calc_one_dimension(0);
-
-        if (begin_x < end_x && begin_y < end_y) {
-          const TileDecodingResources &per_tile_ctx = ctx.tile_dec_res[state_idx];
-          state_idx = (state_idx + 1) % ctx.tile_dec_res.size();
-
-          CUDA_CALL(cudaEventSynchronize(per_tile_ctx.decode_event));
-
-          NvJpeg2kDecodeParams params;
-          CUDA_CALL(nvjpeg2kDecodeParamsSetDecodeArea(params, begin_x, end_x, begin_y, end_y));
-
-          auto output_image = PrepareOutputArea(out, pixel_data, pitch_in_bytes, output_offset_x,
-                                                output_offset_y, ctx);
-
-          auto ret = nvjpeg2kDecodeTile(nvjpeg2k_handle_,
-                                        per_tile_ctx.state,
-                                        ctx.nvjpeg2k_stream,
-                                        params,
-                                        tile_x + tile_y * image_info.num_tiles_x,
-                                        0,
-                                        &output_image,
-                                        ctx.cuda_stream);
-
-          if (ret != NVJPEG2K_STATUS_SUCCESS)
-            return check_status(ret, in);
-
-          CUDA_CALL(cudaEventRecord(per_tile_ctx.decode_event, ctx.cuda_stream));
+  // Decode tile by tile: nvjpeg2kDecodeImage seems to be bugged
+  auto &image_info = ctx.image_info;
+  std::array tile_shape = {image_info.tile_height, image_info.tile_width};
+
+  // The tile streams wait for the work already scheduled for the output
+  CUDA_CALL(cudaEventRecord(ctx.decode_event, ctx.cuda_stream));
+  std::vector<bool> used(ctx.tile_dec_res.size(), false);
+  auto join = [&]() {
+    for (size_t i = 0; i < used.size(); i++) {
+      if (used[i])
+        CUDA_CALL(cudaStreamWaitEvent(ctx.cuda_stream, ctx.tile_dec_res[i].decode_event, 0));
+    }
+  };
+
+  int state_idx = 0;
+  for (uint32_t tile_y = 0; tile_y < image_info.num_tiles_y; tile_y++) {
+    for (uint32_t tile_x = 0; tile_x < image_info.num_tiles_x; tile_x++) {
+      auto calc_one_dimension = [&](int dim) {
+        uint32_t tile_nr = (dim == 1 ? tile_x : tile_y);
+        uint32_t tile_begin = tile_nr * tile_shape[dim];
+        uint32_t tile_end = tile_begin + tile_shape[dim];
+        uint32_t roi_begin = roi.begin[dim];
+        uint32_t roi_end = roi.end[dim];
+
+        // Intersection of roi and tile
+        uint32_t decode_begin = std::max(roi_begin, tile_begin);
+        uint32_t decode_end = std::min(roi_end, tile_end);
+        uint32_t output_offset = tile_begin > roi_begin ? tile_begin - roi_begin : 0;
+
+        return std::tuple{decode_begin, decode_end, output_offset};
+      };
+
+      auto [begin_x, end_x, output_offset_x] = calc_one_dimension(1);
+      auto [begin_y, end_y, output_offset_y] = calc_one_dimension(0);
+
+      if (begin_x < end_x && begin_y < end_y) {
+        const TileDecodingResources &per_tile_ctx = ctx.tile_dec_res[state_idx];
+        used[state_idx] = true;
+        state_idx = (state_idx + 1) % ctx.tile_dec_res.size();
+
+        // the decoding state may still be used by the previous tile
+        CUDA_CALL(cudaEventSynchronize(per_tile_ctx.decode_event));
+        CUDA_CALL(cudaStreamWaitEvent(per_tile_ctx.cuda_stream, ctx.decode_event, 0));
+
+        NvJpeg2kDecodeParams params;
+        CUDA_CALL(nvjpeg2kDecodeParamsSetDecodeArea(params, begin_x, end_x, begin_y, end_y));
+
+        auto output_image = PrepareOutputArea(out, pixel_data, pitch_in_bytes, output_offset_x,
+                                              output_offset_y, ctx);
+
+        auto ret = nvjpeg2kDecodeTile(nvjpeg2k_handle_,
+                                      per_tile_ctx.state,
+                                      ctx.nvjpeg2k_stream,
+                                      params,
+                                      tile_x + tile_y * image_info.num_tiles_x,
+                                      0,
+                                      &output_image,
+                                      per_tile_ctx.cuda_stream);
+
+        CUDA_CALL(cudaEventRecord(per_tile_ctx.decode_event, per_tile_ctx.cuda_stream));
+        if (ret != NVJPEG2K_STATUS_SUCCESS) {
+          join();
+          return check_status(ret, in);
         }
       }
     }
-    return true;
   }
+  join();
+  return true;
 }
 
 DecodeResult NvJpeg2000DecoderInstance::DecodeImplTask(int thread_idx,
@@ -236,7 +264,8 @@ DecodeResult NvJpeg2000DecoderInstance::DecodeImplTask(int thread_idx,
     channels > 1 ||  // nvJPEG2000 decodes into planar layout
     ctx.pixel_type != opts.dtype ||
     format != opts.format ||
-    (ctx.bpp != 8 && ctx.bpp != 16);
+    (ctx.bpp != 8 && ctx.bpp != 16) ||
+    opts.needs_postprocessing();
 
   try {
     auto decode_out = out;
@@ -250,7 +279,7 @@ DecodeResult NvJpeg2000DecoderInstance::DecodeImplTask(int thread_idx,
 
     if (is_processing_needed) {
       auto multiplier = calc_bpp_adjustment_multiplier(ctx.bpp, ctx.pixel_type);
-      Convert(out, "HWC", opts.format, decode_out, "CHW", format, ctx.cuda_stream, {}, multiplier);
+      Convert(out, opts, decode_out, "CHW", format, ctx.cuda_stream, {}, multiplier);
     }
   } catch (...) {
     result.success = false;
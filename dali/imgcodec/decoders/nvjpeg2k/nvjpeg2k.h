@@ -77,13 +77,19 @@ class DLL_PUBLIC NvJpeg2000DecoderInstance : public BatchParallelDecoderImpl {
     }
   }
 
+  /**
+   * @brief Resources for decoding a single tile; each one has its own stream, so that
+   *        the tiles of an image are decoded concurrently.
+   */
   struct TileDecodingResources {
     NvJpeg2kDecodeState state;
     CUDAEvent decode_event;
+    CUDAStreamLease cuda_stream;
 
-    explicit TileDecodingResources(const NvJpeg2kHandle &nvjpeg2k_handle, int device_id,
-                                   cudaStream_t cuda_stream)
-        : state(nvjpeg2k_handle), decode_event(CUDAEvent::Create(device_id)) {
+    explicit TileDecodingResources(const NvJpeg2kHandle &nvjpeg2k_handle, int device_id)
+        : state(nvjpeg2k_handle)
+        , decode_event(CUDAEvent::Create(device_id))
+        , cuda_stream(CUDAStreamPool::instance().Get(device_id)) {
       CUDA_CALL(cudaEventRecord(decode_event, cuda_stream));
     }
   };
@@ -103,7 +109,7 @@ class DLL_PUBLIC NvJpeg2000DecoderInstance : public BatchParallelDecoderImpl {
       constexpr int kNumParallelTiles = 10;
       tile_dec_res.reserve(kNumParallelTiles);
       for (int i = 0; i < kNumParallelTiles; i++) {
-        tile_dec_res.emplace_back(nvjpeg2k_handle, device_id, cuda_stream);
+        tile_dec_res.emplace_back(nvjpeg2k_handle, device_id);
       }
     }
 
@@ -150,6 +156,15 @@ class DLL_PUBLIC NvJpeg2000DecoderInstance : public BatchParallelDecoderImpl {
   bool ParseJpeg2000Info(ImageSource *in, Context &ctx);
   bool DecodeJpeg2000(ImageSource *in, void *out, const Context &ctx);
 
+  /**
+   * @brief Decodes the tiles intersecting the ROI, spreading them across the streams of
+   *        the tile decoding resources.
+   *
+   * The work is ordered after the previous work in ctx.cuda_stream and all of the tiles are
+   * decoded when ctx.cuda_stream reaches the end of the work scheduled by this function.
+   */
+  bool DecodeJpeg2000Tiles(ImageSource *in, void *out, const ROI &roi, const Context &ctx);
+
   /**
    * @brief Sets up nvjpeg2kImage_t, so it points to specific output area
    *
@@ -185,7 +200,7 @@ class NvJpeg2000DecoderFactory : public ImageDecoderFactory {
     static const auto props = []() {
       ImageDecoderProperties props;
       props.supported_input_kinds = InputKind::HostMemory;
-      props.supports_partial_decoding = false;  // roi support requires decoding the whole file
+      props.supports_partial_decoding = true;  // only the tiles intersecting the ROI
       props.gpu_output = true;
       props.fallback = true;
       return props;
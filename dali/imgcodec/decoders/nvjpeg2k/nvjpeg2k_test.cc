@@ -70,6 +70,12 @@ const std::vector<std::pair<std::string, ROI>> roi_images = {
   {"2/tiled-cat-3113513_640", {{2, 1}, {200, 600}}},
 };
 
+const std::vector<std::string> tiled_images = {
+  "2/tiled-cat-1046544_640",
+  "2/tiled-cat-111793_640",
+  "2/tiled-cat-3113513_640",
+};
+
 const char bitdepth_converted_imgname[] = "0/cat-1245673_640";
 
 struct ImageTestingData {
@@ -184,6 +190,11 @@ TYPED_TEST(NvJpeg2000DecoderTest, DecodeSingleRoi) {
     this->RunTest(from_regular_file(name, roi));
 }
 
+TYPED_TEST(NvJpeg2000DecoderTest, DecodeSingleTiled) {
+  for (const auto &name : tiled_images)
+    this->RunTest(from_regular_file(name));
+}
+
 TYPED_TEST(NvJpeg2000DecoderTest, DecodeBatchSingleThread) {
   std::vector<ImageTestingData> data;
   for (const auto &name : images)
@@ -80,6 +80,13 @@ DecodeResult OpenCVDecoderInstance::DecodeImplTask(int thread_idx,
 
   DecodeResult res;
   try {
+    // The images loaded with IMREAD_UNCHANGED are oriented while converting them
+    Orientation orientation = {};
+    if (adjust_orientation) {
+      if (auto *format = ImageFormatRegistry::instance().GetImageFormat(in))
+        orientation = format->Parser()->GetInfo(in).orientation;
+    }
+
     cv::Mat cvimg;
     if (in->Kind() == InputKind::Filename) {
       cvimg = cv::imread(in->Filename(), flags);
@@ -89,9 +96,6 @@ DecodeResult OpenCVDecoderInstance::DecodeImplTask(int thread_idx,
       cvimg = cv::imdecode(cv::_InputArray(raw, in->Size()), flags);
     }
 
-    // TODO(michalz): correct the orientation of images loaded with IMREAD_UNCHANGED
-    (void)adjust_orientation;
-
     res.success = cvimg.ptr(0) != nullptr;
     if (res.success) {
       DALI_ENFORCE(cvimg.dims + 1 == out.shape().sample_dim(), make_string(
@@ -114,7 +118,7 @@ DecodeResult OpenCVDecoderInstance::DecodeImplTask(int thread_idx,
 
       Convert(out, layout, opts.format,
               in, layout, in_format,
-              roi);
+              roi, cvimg.dims == 2 ? orientation : Orientation{});
     }
   } catch (...) {
     res.exception = std::current_exception();
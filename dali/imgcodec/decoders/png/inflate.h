@@ -0,0 +1,379 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_IMGCODEC_DECODERS_PNG_INFLATE_H_
+#define DALI_IMGCODEC_DECODERS_PNG_INFLATE_H_
+
+#include <cstdint>
+#include "dali/core/host_dev.h"
+
+namespace dali {
+namespace imgcodec {
+namespace inflate {
+
+// https://www.rfc-editor.org/rfc/rfc1950 (zlib) and https://www.rfc-editor.org/rfc/rfc1951
+
+enum InflateStatus : int {
+  kOk = 0,
+  kBadHeader,
+  kInputOverrun,
+  kOutputOverrun,
+  kInvalidData,
+};
+
+/**
+ * @brief Canonical Huffman code - the number of codes of each length and the symbols
+ *        ordered by their codes
+ */
+struct HuffmanTable {
+  uint16_t counts[16];
+  uint16_t symbols[288];
+};
+
+/**
+ * @brief The working memory of Inflate
+ *
+ * When decoding with a warp, it should be placed in the shared memory.
+ */
+struct InflateTables {
+  HuffmanTable lit, dist;
+  uint8_t lengths[288 + 32];
+};
+
+DALI_HOST_DEV inline void LaneSync() {
+#ifdef __CUDA_ARCH__
+  __syncwarp();
+#endif
+}
+
+namespace detail {
+
+class BitReader {
+ public:
+  DALI_HOST_DEV BitReader(const uint8_t *in, int64_t size) : in_(in), end_(in + size) {}
+
+  DALI_HOST_DEV uint32_t Bits(int n) {
+    while (count_ < n) {
+      if (in_ < end_) {
+        buffer_ |= static_cast<uint32_t>(*in_++) << count_;
+      } else {
+        overrun_ = true;
+      }
+      count_ += 8;
+    }
+    uint32_t value = buffer_ & ((1u << n) - 1);
+    buffer_ >>= n;
+    count_ -= n;
+    return value;
+  }
+
+  DALI_HOST_DEV uint32_t Bit() {
+    return Bits(1);
+  }
+
+  /** @brief Skips to the byte boundary and returns the pointer to the next byte */
+  DALI_HOST_DEV const uint8_t *AlignToByte() {
+    // the whole bytes left in the buffer are given back
+    in_ -= count_ / 8;
+    buffer_ = 0;
+    count_ = 0;
+    return in_;
+  }
+
+  DALI_HOST_DEV void Advance(int64_t n) {
+    in_ += n;
+  }
+
+  DALI_HOST_DEV int64_t Remaining() const {
+    return end_ - in_;
+  }
+
+  DALI_HOST_DEV bool Overrun() const {
+    return overrun_;
+  }
+
+ private:
+  const uint8_t *in_;
+  const uint8_t *end_;
+  uint32_t buffer_ = 0;
+  int count_ = 0;
+  bool overrun_ = false;
+};
+
+/**
+ * @brief Builds the table from the code lengths; the lanes compute the same
+ *        (so there's no need to broadcast the counts), only the first one writes.
+ */
+DALI_HOST_DEV inline bool BuildTable(HuffmanTable *table, const uint8_t *lengths, int n,
+                                     int lane) {
+  uint16_t counts[16] = {};
+  for (int i = 0; i < n; i++)
+    counts[lengths[i]]++;
+  counts[0] = 0;
+
+  // over-subscribed codes are invalid; incomplete ones are allowed (e.g. single distance code)
+  int left = 1;
+  for (int len = 1; len < 16; len++) {
+    left = 2 * left - counts[len];
+    if (left < 0)
+      return false;
+  }
+
+  uint16_t offsets[16];
+  offsets[1] = 0;
+  for (int len = 1; len < 15; len++)
+    offsets[len + 1] = offsets[len] + counts[len];
+
+  if (lane == 0) {
+    for (int len = 0; len < 16; len++)
+      table->counts[len] = counts[len];
+    for (int i = 0; i < n; i++) {
+      if (lengths[i])
+        table->symbols[offsets[lengths[i]]++] = i;
+    }
+  }
+  LaneSync();
+  return true;
+}
+
+/** @brief Decodes a symbol bit by bit; returns -1 for an invalid code */
+DALI_HOST_DEV inline int DecodeSymbol(BitReader &reader, const HuffmanTable &table) {
+  int code = 0, first = 0, index = 0;
+  for (int len = 1; len < 16; len++) {
+    code |= reader.Bit();
+    int count = table.counts[len];
+    if (code - first < count)
+      return table.symbols[index + code - first];
+    index += count;
+    first = (first + count) << 1;
+    code <<= 1;
+  }
+  return -1;
+}
+
+DALI_HOST_DEV inline void BuildFixedTables(InflateTables *tables, int lane) {
+  if (lane == 0) {
+    int i = 0;
+    for (; i < 144; i++) tables->lengths[i] = 8;
+    for (; i < 256; i++) tables->lengths[i] = 9;
+    for (; i < 280; i++) tables->lengths[i] = 7;
+    for (; i < 288; i++) tables->lengths[i] = 8;
+    for (; i < 288 + 30; i++) tables->lengths[i] = 5;
+  }
+  LaneSync();
+  BuildTable(&tables->lit, tables->lengths, 288, lane);
+  BuildTable(&tables->dist, tables->lengths + 288, 30, lane);
+}
+
+DALI_HOST_DEV inline int BuildDynamicTables(BitReader &reader, InflateTables *tables, int lane) {
+  const uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+  int hlit = reader.Bits(5) + 257;
+  int hdist = reader.Bits(5) + 1;
+  int hclen = reader.Bits(4) + 4;
+  if (hlit > 286 || hdist > 30)
+    return kInvalidData;
+
+  uint8_t *lengths = tables->lengths;
+  for (int i = 0; i < 19; i++) {
+    uint32_t len = i < hclen ? reader.Bits(3) : 0;
+    if (lane == 0)
+      lengths[order[i]] = len;
+  }
+  LaneSync();
+  // the code length code goes to the distance table, which is built last
+  if (!BuildTable(&tables->dist, lengths, 19, lane))
+    return kInvalidData;
+
+  int prev = -1;
+  for (int n = 0; n < hlit + hdist;) {
+    int sym = DecodeSymbol(reader, tables->dist);
+    if (sym < 0 || reader.Overrun())
+      return reader.Overrun() ? kInputOverrun : kInvalidData;
+    int value, repeat;
+    if (sym < 16) {
+      value = sym;
+      repeat = 1;
+    } else if (sym == 16) {
+      if (prev < 0)
+        return kInvalidData;
+      value = prev;
+      repeat = 3 + reader.Bits(2);
+    } else if (sym == 17) {
+      value = 0;
+      repeat = 3 + reader.Bits(3);
+    } else {
+      value = 0;
+      repeat = 11 + reader.Bits(7);
+    }
+    if (n + repeat > hlit + hdist)
+      return kInvalidData;
+    if (lane == 0) {
+      for (int i = 0; i < repeat; i++)
+        lengths[n + i] = value;
+    }
+    n += repeat;
+    prev = value;
+  }
+  LaneSync();
+
+  if (lengths[256] == 0)
+    return kInvalidData;  // no end of block code
+  if (!BuildTable(&tables->lit, lengths, hlit, lane) ||
+      !BuildTable(&tables->dist, lengths + hlit, hdist, lane))
+    return kInvalidData;
+  return kOk;
+}
+
+DALI_HOST_DEV inline int LengthBase(int k) {
+  if (k < 4) return k + 3;
+  if (k == 28) return 258;
+  int extra = k < 8 ? 0 : (k >> 2) - 1;
+  return 3 + (((k & 3) + 4) << extra);
+}
+
+DALI_HOST_DEV inline int LengthExtraBits(int k) {
+  return k < 8 || k == 28 ? 0 : (k >> 2) - 1;
+}
+
+DALI_HOST_DEV inline int DistanceBase(int k) {
+  if (k < 4) return k + 1;
+  return 1 + (((k & 1) + 2) << ((k >> 1) - 1));
+}
+
+DALI_HOST_DEV inline int DistanceExtraBits(int k) {
+  return k < 4 ? 0 : (k >> 1) - 1;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Decompresses a zlib stream.
+ *
+ * The function is meant to be executed by `nlanes` threads (the lanes of a warp) at once,
+ * all with the same arguments, except for `lane`. All the lanes decode the symbols (so that
+ * the control flow doesn't diverge and no broadcasts are needed), but the writes are split
+ * between them - the back-references and the stored blocks are copied in parallel.
+ *
+ * @param out       the output buffer
+ * @param out_size  the size of the output buffer; the stream must not decompress to more
+ * @param in        the zlib stream
+ * @param in_size   the size of the zlib stream
+ * @param tables    the working memory, shared by the lanes
+ * @param lane      the index of the lane
+ * @param nlanes    the number of lanes
+ * @param produced  receives the number of bytes written to the output
+ * @return InflateStatus
+ */
+DALI_HOST_DEV inline int Inflate(uint8_t *out, int64_t out_size, const uint8_t *in,
+                                 int64_t in_size, InflateTables *tables, int lane, int nlanes,
+                                 int64_t *produced) {
+  using namespace detail;  // NOLINT
+  *produced = 0;
+  if (in_size < 2)
+    return kInputOverrun;
+  int cmf = in[0], flg = in[1];
+  if ((cmf & 0xf) != 8 || (cmf >> 4) > 7 || (cmf * 256 + flg) % 31 != 0 || (flg & 0x20))
+    return kBadHeader;
+
+  BitReader reader(in + 2, in_size - 2);
+  int64_t pos = 0;
+  bool last = false;
+  while (!last) {
+    last = reader.Bit();
+    int type = reader.Bits(2);
+    if (reader.Overrun())
+      return kInputOverrun;
+    if (type == 0) {
+      const uint8_t *data = reader.AlignToByte();
+      if (reader.Remaining() < 4)
+        return kInputOverrun;
+      int len = data[0] | (data[1] << 8);
+      int nlen = data[2] | (data[3] << 8);
+      if (len != (~nlen & 0xffff))
+        return kInvalidData;
+      data += 4;
+      reader.Advance(4);
+      if (reader.Remaining() < len)
+        return kInputOverrun;
+      if (pos + len > out_size)
+        return kOutputOverrun;
+      for (int i = lane; i < len; i += nlanes)
+        out[pos + i] = data[i];
+      reader.Advance(len);
+      pos += len;
+      continue;
+    } else if (type == 1) {
+      BuildFixedTables(tables, lane);
+    } else if (type == 2) {
+      int status = BuildDynamicTables(reader, tables, lane);
+      if (status != kOk)
+        return status;
+    } else {
+      return kInvalidData;
+    }
+
+    while (true) {
+      int sym = DecodeSymbol(reader, tables->lit);
+      if (reader.Overrun())
+        return kInputOverrun;
+      if (sym < 0)
+        return kInvalidData;
+      if (sym < 256) {
+        if (pos >= out_size)
+          return kOutputOverrun;
+        if (lane == 0)
+          out[pos] = sym;
+        pos++;
+        continue;
+      }
+      if (sym == 256)
+        break;
+      sym -= 257;
+      if (sym > 28)
+        return kInvalidData;
+      int len = LengthBase(sym) + reader.Bits(LengthExtraBits(sym));
+      int dsym = DecodeSymbol(reader, tables->dist);
+      if (dsym < 0 || dsym > 29)
+        return kInvalidData;
+      int dist = DistanceBase(dsym) + reader.Bits(DistanceExtraBits(dsym));
+      if (reader.Overrun())
+        return kInputOverrun;
+      if (dist > pos)
+        return kInvalidData;
+      if (pos + len > out_size)
+        return kOutputOverrun;
+      // the literals written by the first lane are read by the others
+      LaneSync();
+      // the bytes at most `dist` back can be copied at once
+      int step = dist < nlanes ? dist : nlanes;
+      for (int base = 0; base < len; base += step) {
+        int i = base + lane;
+        if (lane < step && i < len)
+          out[pos + i] = out[pos - dist + i];
+        LaneSync();
+      }
+      pos += len;
+    }
+    LaneSync();
+  }
+  *produced = pos;
+  return reader.Overrun() ? kInputOverrun : kOk;
+}
+
+}  // namespace inflate
+}  // namespace imgcodec
+}  // namespace dali
+
+#endif  // DALI_IMGCODEC_DECODERS_PNG_INFLATE_H_
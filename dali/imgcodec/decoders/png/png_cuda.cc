@@ -0,0 +1,204 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/imgcodec/decoders/png/png_cuda.h"
+#include <stdexcept>
+#include "dali/core/device_guard.h"
+#include "dali/imgcodec/decoders/png/inflate.h"
+#include "dali/imgcodec/registry.h"
+#include "dali/imgcodec/util/convert_gpu.h"
+
+namespace dali {
+namespace imgcodec {
+
+PngCudaDecoderInstance::PngCudaDecoderInstance(int device_id,
+                                               const std::map<std::string, any> &params)
+: BatchParallelDecoderImpl(device_id, params) {
+  SetParams(params);
+  DeviceGuard dg(device_id_);
+  tp_ = std::make_unique<ThreadPool>(num_threads_, device_id, true, "PngCudaDecoderInstance");
+  stream_ = CUDAStreamPool::instance().Get(device_id_);
+  event_ = CUDAEvent::Create(device_id_);
+  CUDA_CALL(cudaEventRecord(event_, stream_));
+}
+
+PngCudaDecoderInstance::~PngCudaDecoderInstance() {
+  tp_.reset();
+  CUDA_CALL(cudaStreamSynchronize(stream_));
+}
+
+PngCudaDecoderInstance::SampleInfo PngCudaDecoderInstance::ParseSample(ImageSource *in,
+                                                                       bool use_orientation) {
+  SampleInfo sample;
+  try {
+    sample.png = ParsePngStructure(in);
+    if (use_orientation)
+      sample.orientation = PngParser{}.GetInfo(in).orientation;
+    const auto &png = sample.png;
+    png.NumberOfSamples();  // validates the color type
+    if (png.color_type == PNG_COLOR_TYPE_PALETTE)
+      throw std::logic_error("Palette images are not supported");
+    if (png.bit_depth != 8 && png.bit_depth != 16)
+      throw std::logic_error(make_string("Unsupported bit depth: ", static_cast<int>(png.bit_depth)));
+    if (png.interlace_method != 0)
+      throw std::logic_error("Interlaced images are not supported");
+  } catch (...) {
+    sample.error = std::current_exception();
+  }
+  return sample;
+}
+
+FutureDecodeResults PngCudaDecoderInstance::ScheduleDecode(DecodeContext ctx,
+                                                           span<SampleView<GPUBackend>> out,
+                                                           cspan<ImageSource *> in,
+                                                           DecodeParams opts,
+                                                           cspan<ROI> rois) {
+  assert(out.size() == in.size());
+  assert(rois.empty() || rois.size() == in.size());
+  int nsamples = in.size();
+  DecodeResultsPromise promise(nsamples);
+  DeviceGuard dg(device_id_);
+  // The buffers may still be used by the previous batch
+  CUDA_CALL(cudaEventSynchronize(event_));
+
+  samples_.clear();
+  samples_.resize(nsamples);
+  for (int i = 0; i < nsamples; i++)
+    tp_->AddWork([&, i](int) { samples_[i] = ParseSample(in[i], opts.use_orientation); });
+  tp_->RunAll();
+
+  // The images are placed one after another in the buffers
+  int64_t compressed_size = 0, filtered_size = 0, image_size = 0;
+  decoded_.clear();
+  for (int i = 0; i < nsamples; i++) {
+    auto &sample = samples_[i];
+    if (sample.error) {
+      promise.set(i, DecodeResult::Failure(sample.error));
+      continue;
+    }
+    const auto &png = sample.png;
+    int64_t row_bytes = int64_t(png.width) * png.NumberOfSamples() * png.bit_depth / 8;
+    sample.compressed_offset = compressed_size;
+    sample.filtered_offset = filtered_size;
+    sample.image_offset = image_size;
+    compressed_size += png.CompressedSize();
+    filtered_size += png.height * (row_bytes + 1);
+    image_size += png.height * row_bytes;
+    decoded_.push_back(i);
+  }
+
+  uint8_t *compressed_host = compressed_host_.Resize(compressed_size);
+  for (int i : decoded_) {
+    tp_->AddWork([&, i](int) {
+      auto &sample = samples_[i];
+      try {
+        auto stream = in[i]->Open();
+        uint8_t *dst = compressed_host + sample.compressed_offset;
+        for (auto &chunk : sample.png.idat) {
+          stream->SeekRead(chunk.first);
+          stream->ReadAll(dst, chunk.second);
+          dst += chunk.second;
+        }
+      } catch (...) {
+        sample.error = std::current_exception();
+      }
+    }, samples_[i].png.CompressedSize());
+  }
+  tp_->RunAll();
+
+  int ndecoded = 0;
+  for (int i : decoded_) {
+    if (samples_[i].error)
+      promise.set(i, DecodeResult::Failure(samples_[i].error));
+    else
+      decoded_[ndecoded++] = i;
+  }
+  decoded_.resize(ndecoded);
+  if (decoded_.empty())
+    return promise.get_future();
+
+  // No work is pending, the buffers can be reallocated without preserving the contents
+  for (auto *buf : {&compressed_, &filtered_, &image_})
+    buf->clear();
+  compressed_.resize(compressed_size);
+  filtered_.resize(filtered_size);
+  image_.resize(image_size);
+  descs_.resize(ndecoded);
+  status_.resize(ndecoded);
+
+  PngSampleDesc *descs = descs_host_.Resize(ndecoded);
+  for (int k = 0; k < ndecoded; k++) {
+    const auto &sample = samples_[decoded_[k]];
+    const auto &png = sample.png;
+    auto &desc = descs[k];
+    desc.compressed = compressed_.data() + sample.compressed_offset;
+    desc.compressed_size = png.CompressedSize();
+    desc.filtered = filtered_.data() + sample.filtered_offset;
+    desc.image = image_.data() + sample.image_offset;
+    desc.height = png.height;
+    desc.sample_bytes = png.bit_depth / 8;
+    desc.pixel_bytes = png.NumberOfSamples() * desc.sample_bytes;
+    desc.row_bytes = int64_t(png.width) * desc.pixel_bytes;
+  }
+
+  CUDA_CALL(cudaMemcpyAsync(compressed_.data(), compressed_host, compressed_size,
+                            cudaMemcpyHostToDevice, stream_));
+  CUDA_CALL(cudaMemcpyAsync(descs_.data(), descs, ndecoded * sizeof(PngSampleDesc),
+                            cudaMemcpyHostToDevice, stream_));
+  InflateBatch(descs_.data(), status_.data(), ndecoded, stream_);
+  UnfilterBatch(descs_.data(), status_.data(), ndecoded, stream_);
+  int *status = status_host_.Resize(ndecoded);
+  CUDA_CALL(cudaMemcpyAsync(status, status_.data(), ndecoded * sizeof(int),
+                            cudaMemcpyDeviceToHost, stream_));
+  CUDA_CALL(cudaStreamSynchronize(stream_));
+
+  // The outputs can be written after the work already scheduled in the caller's stream
+  CUDA_CALL(cudaEventRecord(event_, ctx.stream));
+  CUDA_CALL(cudaStreamWaitEvent(stream_, event_, 0));
+  for (int k = 0; k < ndecoded; k++) {
+    int i = decoded_[k];
+    if (status[k] != inflate::kOk) {
+      auto error = std::runtime_error(make_string(
+          "Failed to decompress the PNG image data, error code: ", status[k]));
+      promise.set(i, DecodeResult::Failure(std::make_exception_ptr(error)));
+      continue;
+    }
+    try {
+      const auto &png = samples_[i].png;
+      int channels = png.NumberOfSamples();
+      DALIImageType in_format;
+      if (opts.format == DALI_ANY_DATA)
+        in_format = DALI_ANY_DATA;
+      else
+        in_format = channels <= 2 ? DALI_GRAY : DALI_RGB;  // the alpha channel is dropped
+      TensorShape<> shape = {png.height, png.width, channels};
+      ConstSampleView<GPUBackend> image(descs[k].image, shape,
+                                        png.bit_depth == 8 ? DALI_UINT8 : DALI_UINT16);
+      Convert(out[i], opts, image, "HWC", in_format, stream_, rois.empty() ? ROI{} : rois[i],
+              1.0f, samples_[i].orientation);
+      promise.set(i, DecodeResult::Success());
+    } catch (...) {
+      promise.set(i, DecodeResult::Failure(std::current_exception()));
+    }
+  }
+  CUDA_CALL(cudaEventRecord(event_, stream_));
+  CUDA_CALL(cudaStreamWaitEvent(ctx.stream, event_, 0));
+  return promise.get_future();
+}
+
+REGISTER_DECODER("PNG", PngCudaDecoderFactory, CUDADecoderPriority);
+
+}  // namespace imgcodec
+}  // namespace dali
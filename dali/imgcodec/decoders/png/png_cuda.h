@@ -0,0 +1,134 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_IMGCODEC_DECODERS_PNG_PNG_CUDA_H_
+#define DALI_IMGCODEC_DECODERS_PNG_PNG_CUDA_H_
+
+#include <cstring>
+#include <exception>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/core/cuda_event.h"
+#include "dali/core/cuda_stream_pool.h"
+#include "dali/core/dev_buffer.h"
+#include "dali/imgcodec/decoders/decoder_parallel_impl.h"
+#include "dali/imgcodec/decoders/png/png_kernels.h"
+#include "dali/imgcodec/image_decoder_interfaces.h"
+#include "dali/imgcodec/parsers/png.h"
+#include "dali/imgcodec/util/pinned_buffer.h"
+
+namespace dali {
+namespace imgcodec {
+
+/**
+ * @brief PNG decoder with the output in the GPU memory.
+ *
+ * The chunks are parsed and the compressed data is gathered on the host (in the decoder's
+ * thread pool). The whole batch is then decompressed with one kernel launch - a warp per
+ * image - and the row filters are reverted with another one, before the type and color
+ * space conversion.
+ *
+ * Only non-interlaced 8 and 16-bit grayscale and RGB images (with or without alpha) are
+ * supported, the others are left for the fallback decoders.
+ */
+class DLL_PUBLIC PngCudaDecoderInstance : public BatchParallelDecoderImpl {
+ public:
+  explicit PngCudaDecoderInstance(int device_id, const std::map<std::string, any> &params);
+  ~PngCudaDecoderInstance();
+
+  using BatchParallelDecoderImpl::ScheduleDecode;
+  FutureDecodeResults ScheduleDecode(DecodeContext ctx,
+                                     span<SampleView<GPUBackend>> out,
+                                     cspan<ImageSource *> in,
+                                     DecodeParams opts,
+                                     cspan<ROI> rois = {}) override;
+
+  bool SetParam(const char *name, const any &value) override {
+    if (strcmp(name, "png_num_threads") == 0) {
+      num_threads_ = any_cast<size_t>(value);
+      return true;
+    }
+    return false;
+  }
+
+  any GetParam(const char *name) const override {
+    if (strcmp(name, "png_num_threads") == 0)
+      return num_threads_;
+    return {};
+  }
+
+ private:
+  struct SampleInfo {
+    PngStructure png;
+    /** @brief Applied while converting the decoded image, if requested */
+    Orientation orientation = {};
+    /** @brief Set if the image can't be decoded by this decoder */
+    std::exception_ptr error;
+    int64_t compressed_offset = 0;
+    int64_t filtered_offset = 0;
+    int64_t image_offset = 0;
+  };
+
+  SampleInfo ParseSample(ImageSource *in, bool use_orientation);
+
+  size_t num_threads_ = 4;
+  std::unique_ptr<ThreadPool> tp_;
+  CUDAStreamLease stream_;
+  /** @brief Recorded when the buffers are no longer used */
+  CUDAEvent event_;
+
+  std::vector<SampleInfo> samples_;
+  /** @brief The indices of the samples decoded on the GPU */
+  std::vector<int> decoded_;
+  PinnedBuffer<uint8_t> compressed_host_;
+  PinnedBuffer<PngSampleDesc> descs_host_;
+  PinnedBuffer<int> status_host_;
+  DeviceBuffer<uint8_t> compressed_;
+  DeviceBuffer<uint8_t> filtered_;
+  DeviceBuffer<uint8_t> image_;
+  DeviceBuffer<PngSampleDesc> descs_;
+  DeviceBuffer<int> status_;
+};
+
+class PngCudaDecoderFactory : public ImageDecoderFactory {
+ public:
+  ImageDecoderProperties GetProperties() const override {
+    static const auto props = []() {
+      ImageDecoderProperties props;
+      props.supported_input_kinds = InputKind::Stream | InputKind::HostMemory | InputKind::Filename;
+      props.supports_partial_decoding = true;
+      props.gpu_output = true;
+      props.fallback = true;
+      return props;
+    }();
+    return props;
+  }
+
+  bool IsSupported(int device_id) const override {
+    return device_id >= 0;
+  }
+
+  std::shared_ptr<ImageDecoderInstance> Create(
+        int device_id, const std::map<std::string, any> &params = {}) const override {
+    return std::make_shared<PngCudaDecoderInstance>(device_id, params);
+  }
+};
+
+}  // namespace imgcodec
+}  // namespace dali
+
+#endif  // DALI_IMGCODEC_DECODERS_PNG_PNG_CUDA_H_
@@ -0,0 +1,147 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/imgcodec/decoders/decoder_test_helper.h"
+#include "dali/imgcodec/decoders/opencv_fallback.h"
+#include "dali/imgcodec/decoders/png/png_cuda.h"
+#include "dali/imgcodec/parsers/png.h"
+#include "dali/test/dali_test.h"
+#include "dali/test/dali_test_config.h"
+
+namespace dali {
+namespace imgcodec {
+namespace test {
+
+namespace {
+const auto &dali_extra = dali::testing::dali_extra_path();
+auto cat_path = dali_extra + "/db/single/png/0/domestic-cat-726989_640.png";
+auto bicycle_path = dali_extra +
+                    "/db/imgcodec/png/orientation/bicycle-161524_1280_no_orientation.png";
+}  // namespace
+
+TEST(PngCudaDecoderTest, Factory) {
+  int device_id;
+  CUDA_CALL(cudaGetDevice(&device_id));
+
+  PngCudaDecoderFactory decoder;
+  EXPECT_TRUE(decoder.IsSupported(device_id));
+  EXPECT_FALSE(decoder.IsSupported(CPU_ONLY_DEVICE_ID));
+  auto props = decoder.GetProperties();
+  EXPECT_TRUE(props.gpu_output);
+  EXPECT_TRUE(props.fallback);
+  EXPECT_TRUE(!!(props.supported_input_kinds & InputKind::HostMemory));
+  EXPECT_TRUE(!!(props.supported_input_kinds & InputKind::Filename));
+  EXPECT_FALSE(!!(props.supported_input_kinds & InputKind::DeviceMemory));
+
+  auto instance = decoder.Create(device_id);
+  EXPECT_NE(instance, nullptr);
+}
+
+template <typename OutType>
+class PngCudaDecoderTest : public NumpyDecoderTestBase<GPUBackend, OutType> {
+ protected:
+  std::shared_ptr<ImageDecoderInstance> CreateDecoder() override {
+    return PngCudaDecoderFactory().Create(this->GetDeviceId());
+  }
+  std::shared_ptr<ImageParser> CreateParser() override {
+    return std::make_shared<PngParser>();
+  }
+
+  /**
+   * @brief Decodes the image with the OpenCV decoder.
+   */
+  Tensor<CPUBackend> DecodeReference(ImageSource *src, DecodeParams opts, const ROI &roi = {}) {
+    auto info = this->Parser()->GetInfo(src);
+    auto shape = AdjustToRoi(info.shape, roi);
+    *(shape.end() - 1) = NumberOfChannels(opts.format, *(shape.end() - 1));
+    Tensor<CPUBackend> ref;
+    ref.Resize(shape, dtype);
+    SampleView<CPUBackend> view(ref.raw_mutable_data(), shape, dtype);
+    auto decoder = OpenCVDecoderFactory().Create(CPU_ONLY_DEVICE_ID);
+    auto result = decoder->Decode(this->Context(), view, src, opts, roi);
+    EXPECT_TRUE(result.success);
+    return ref;
+  }
+
+  static const auto dtype = type2id<OutType>::value;
+};
+
+using PngCudaDecoderTypes = ::testing::Types<uint8_t, uint16_t>;
+TYPED_TEST_SUITE(PngCudaDecoderTest, PngCudaDecoderTypes);
+
+TYPED_TEST(PngCudaDecoderTest, FromFilename) {
+  auto src = ImageSource::FromFilename(cat_path);
+  auto ref = this->DecodeReference(&src, {this->dtype});
+  auto img = this->Decode(&src, {this->dtype});
+  AssertEqualSatNorm(img, ref);
+}
+
+TYPED_TEST(PngCudaDecoderTest, FromHostMem) {
+  auto stream = FileStream::Open(cat_path, false, false);
+  std::vector<uint8_t> data(stream->Size());
+  stream->ReadBytes(data.data(), data.size());
+  auto src = ImageSource::FromHostMem(data.data(), data.size());
+  auto ref = this->DecodeReference(&src, {this->dtype});
+  auto img = this->Decode(&src, {this->dtype});
+  AssertEqualSatNorm(img, ref);
+}
+
+TYPED_TEST(PngCudaDecoderTest, ROI) {
+  auto src = ImageSource::FromFilename(cat_path);
+  auto info = this->Parser()->GetInfo(&src);
+  ROI roi = {{13, 17}, {info.shape[0] - 55, info.shape[1] - 10}};
+  auto ref = this->DecodeReference(&src, {this->dtype});
+  auto img = this->Decode(&src, {this->dtype}, roi);
+  AssertEqualSatNorm(img, Crop(ref, roi));
+}
+
+TYPED_TEST(PngCudaDecoderTest, Gray) {
+  auto src = ImageSource::FromFilename(cat_path);
+  auto ref = this->DecodeReference(&src, {this->dtype, DALI_GRAY});
+  auto img = this->Decode(&src, {this->dtype, DALI_GRAY});
+  AssertClose(img, ref, 0.01 * max_value<TypeParam>());
+}
+
+TYPED_TEST(PngCudaDecoderTest, BatchedAPI) {
+  auto src0 = ImageSource::FromFilename(cat_path);
+  auto src1 = ImageSource::FromFilename(bicycle_path);
+  auto src2 = ImageSource::FromFilename(cat_path);
+  auto ref0 = this->DecodeReference(&src0, {this->dtype});
+  auto ref1 = this->DecodeReference(&src1, {this->dtype});
+  std::vector<ImageSource*> srcs = {&src0, &src1, &src2};
+  auto img = this->Decode(make_span(srcs), {this->dtype});
+  AssertEqualSatNorm(img[0], ref0);
+  AssertEqualSatNorm(img[1], ref1);
+  AssertEqualSatNorm(img[2], ref0);
+}
+
+TYPED_TEST(PngCudaDecoderTest, TrimmedFile) {
+  auto stream = FileStream::Open(cat_path, false, false);
+  std::vector<uint8_t> data(stream->Size());
+  stream->ReadBytes(data.data(), data.size());
+  auto src = ImageSource::FromHostMem(data.data(), data.size() / 2);
+
+  SampleView<GPUBackend> view(nullptr, 0, type2id<TypeParam>::value);
+  DecodeResult decode_result = this->Decoder()->Decode(this->Context(), view, &src, {}, {});
+  EXPECT_FALSE(decode_result.success);
+}
+
+}  // namespace test
+}  // namespace imgcodec
+}  // namespace dali
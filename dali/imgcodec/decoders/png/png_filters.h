@@ -0,0 +1,99 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_IMGCODEC_DECODERS_PNG_PNG_FILTERS_H_
+#define DALI_IMGCODEC_DECODERS_PNG_PNG_FILTERS_H_
+
+#include <cstdint>
+#include "dali/core/host_dev.h"
+
+namespace dali {
+namespace imgcodec {
+
+// https://www.w3.org/TR/2003/REC-PNG-20031110/#9Filters
+
+enum PngFilterType : uint8_t {
+  PNG_FILTER_NONE    = 0,
+  PNG_FILTER_SUB     = 1,
+  PNG_FILTER_UP      = 2,
+  PNG_FILTER_AVERAGE = 3,
+  PNG_FILTER_PAETH   = 4,
+};
+
+DALI_HOST_DEV inline uint8_t PaethPredictor(int a, int b, int c) {
+  int p = a + b - c;
+  int pa = p > a ? p - a : a - p;
+  int pb = p > b ? p - b : b - p;
+  int pc = p > c ? p - c : c - p;
+  if (pa <= pb && pa <= pc)
+    return a;
+  return pb <= pc ? b : c;
+}
+
+/**
+ * @brief Reverts the filter of a scanline.
+ *
+ * The function is executed by `nthreads` threads at once. The filters which don't depend on
+ * the preceding bytes of the row are reverted by all the threads, the other ones - by one
+ * thread per byte of a pixel.
+ *
+ * @param dst          the reconstructed row
+ * @param src          the filtered row, without the filter type byte
+ * @param prev         the previous reconstructed row or nullptr for the first one
+ * @param row_bytes    the size of the row
+ * @param pixel_bytes  the size of a complete pixel (at least 1)
+ * @return false, if the filter type is invalid
+ */
+DALI_HOST_DEV inline bool UnfilterRow(uint8_t *dst, const uint8_t *src, const uint8_t *prev,
+                                      int64_t row_bytes, int pixel_bytes, uint8_t filter,
+                                      int tid, int nthreads) {
+  switch (filter) {
+    case PNG_FILTER_NONE:
+      for (int64_t i = tid; i < row_bytes; i += nthreads)
+        dst[i] = src[i];
+      return true;
+    case PNG_FILTER_UP:
+      for (int64_t i = tid; i < row_bytes; i += nthreads)
+        dst[i] = src[i] + (prev ? prev[i] : 0);
+      return true;
+    case PNG_FILTER_SUB:
+    case PNG_FILTER_AVERAGE:
+    case PNG_FILTER_PAETH:
+      for (int lane = tid; lane < pixel_bytes; lane += nthreads) {
+        int a = 0, c = 0;
+        for (int64_t i = lane; i < row_bytes; i += pixel_bytes) {
+          int b = prev ? prev[i] : 0;
+          uint8_t x = src[i];
+          if (filter == PNG_FILTER_SUB)
+            x += a;
+          else if (filter == PNG_FILTER_AVERAGE)
+            x += (a + b) >> 1;
+          else
+            x += PaethPredictor(a, b, c);
+          dst[i] = x;
+          a = x;
+          c = b;
+        }
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace imgcodec
+}  // namespace dali
+
+#endif  // DALI_IMGCODEC_DECODERS_PNG_PNG_FILTERS_H_
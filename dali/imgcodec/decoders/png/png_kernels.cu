@@ -0,0 +1,91 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/imgcodec/decoders/png/png_kernels.h"
+#include "dali/core/cuda_error.h"
+#include "dali/imgcodec/decoders/png/inflate.h"
+#include "dali/imgcodec/decoders/png/png_filters.h"
+
+namespace dali {
+namespace imgcodec {
+
+namespace {
+
+constexpr int kInflateLanes = 32;
+constexpr int kUnfilterBlockSize = 256;
+
+__global__ void InflateKernel(const PngSampleDesc *samples, int *status) {
+  __shared__ inflate::InflateTables tables;
+  const PngSampleDesc &sample = samples[blockIdx.x];
+  int64_t produced;
+  int result = inflate::Inflate(sample.filtered, sample.filtered_size(),
+                                sample.compressed, sample.compressed_size,
+                                &tables, threadIdx.x, blockDim.x, &produced);
+  if (result == inflate::kOk && produced != sample.filtered_size())
+    result = inflate::kInputOverrun;  // truncated image data
+  if (threadIdx.x == 0)
+    status[blockIdx.x] = result;
+}
+
+__global__ void UnfilterKernel(const PngSampleDesc *samples, int *status) {
+  if (status[blockIdx.x] != inflate::kOk)
+    return;
+  const PngSampleDesc &sample = samples[blockIdx.x];
+  const int64_t row_bytes = sample.row_bytes;
+  for (int64_t y = 0; y < sample.height; y++) {
+    const uint8_t *src = sample.filtered + y * (row_bytes + 1);
+    uint8_t *dst = sample.image + y * row_bytes;
+    const uint8_t *prev = y > 0 ? dst - row_bytes : nullptr;
+    // the filter type is the same for all the threads, so is the return
+    if (!UnfilterRow(dst, src + 1, prev, row_bytes, sample.pixel_bytes, src[0],
+                     threadIdx.x, blockDim.x)) {
+      if (threadIdx.x == 0)
+        status[blockIdx.x] = inflate::kInvalidData;
+      return;
+    }
+    __syncthreads();
+  }
+
+  if (sample.sample_bytes == 2) {
+    int64_t n = sample.height * row_bytes / 2;
+    for (int64_t i = threadIdx.x; i < n; i += blockDim.x) {
+      uint8_t *p = sample.image + 2 * i;
+      uint8_t hi = p[0];
+      p[0] = p[1];
+      p[1] = hi;
+    }
+  }
+}
+
+}  // namespace
+
+void InflateBatch(const PngSampleDesc *samples_gpu, int *status_gpu, int nsamples,
+                  cudaStream_t stream) {
+  if (nsamples == 0)
+    return;
+  InflateKernel<<<nsamples, kInflateLanes, 0, stream>>>(samples_gpu, status_gpu);
+  CUDA_CALL(cudaGetLastError());
+}
+
+void UnfilterBatch(const PngSampleDesc *samples_gpu, int *status_gpu, int nsamples,
+                   cudaStream_t stream) {
+  if (nsamples == 0)
+    return;
+  UnfilterKernel<<<nsamples, kUnfilterBlockSize, 0, stream>>>(samples_gpu, status_gpu);
+  CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace imgcodec
+}  // namespace dali
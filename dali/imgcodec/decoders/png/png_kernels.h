@@ -0,0 +1,70 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_IMGCODEC_DECODERS_PNG_PNG_KERNELS_H_
+#define DALI_IMGCODEC_DECODERS_PNG_PNG_KERNELS_H_
+
+#include <cuda_runtime.h>
+#include <cstdint>
+#include "dali/core/host_dev.h"
+
+namespace dali {
+namespace imgcodec {
+
+/**
+ * @brief The buffers and the geometry of a PNG image decoded on the GPU
+ */
+struct PngSampleDesc {
+  /** @brief The zlib stream - the concatenated IDAT chunks */
+  const uint8_t *compressed;
+  int64_t compressed_size;
+  /** @brief The decompressed scanlines, each preceded by the filter type byte */
+  uint8_t *filtered;
+  /** @brief The reconstructed image, in HWC layout */
+  uint8_t *image;
+  int64_t height;
+  int64_t row_bytes;
+  /** @brief The size of a pixel, in bytes */
+  int pixel_bytes;
+  /** @brief The size of a sample, in bytes - the 16-bit samples are big endian in PNG */
+  int sample_bytes;
+
+  DALI_HOST_DEV int64_t filtered_size() const {
+    return height * (row_bytes + 1);
+  }
+};
+
+/**
+ * @brief Decompresses the scanlines of a batch of images, one warp per image.
+ *
+ * @param status  receives an inflate::InflateStatus per image
+ */
+void InflateBatch(const PngSampleDesc *samples_gpu, int *status_gpu, int nsamples,
+                  cudaStream_t stream);
+
+/**
+ * @brief Reverts the filters and converts the samples to the native byte order,
+ *        one block per image.
+ *
+ * The images with a non-zero status are skipped; the status of those with an invalid
+ * filter type is set to inflate::kInvalidData.
+ */
+void UnfilterBatch(const PngSampleDesc *samples_gpu, int *status_gpu, int nsamples,
+                   cudaStream_t stream);
+
+}  // namespace imgcodec
+}  // namespace dali
+
+#endif  // DALI_IMGCODEC_DECODERS_PNG_PNG_KERNELS_H_
@@ -0,0 +1,508 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/imgcodec/image_decoder.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "dali/core/cuda_error.h"
+#include "dali/core/format.h"
+#include "dali/core/metrics.h"
+#include "dali/core/util.h"
+#include "dali/imgcodec/registry.h"
+#include "dali/imgcodec/util/convert_gpu.h"
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+namespace imgcodec {
+
+namespace {
+
+/**
+ * @brief The initial estimate of the decoding time, in seconds per pixel
+ *
+ * It's used until the time is measured. The host decoders decode the samples in parallel.
+ */
+double DefaultCost(float priority, int host_threads) {
+  if (priority <= HWDecoderPriority)
+    return 2e-9;
+  if (priority <= CUDADecoderPriority)
+    return 4e-9;
+  if (priority <= HostDecoderPriority)
+    return 20e-9 / host_threads;
+  return 100e-9 / host_threads;
+}
+
+// The weight of the last measurement in the estimated cost
+constexpr double kCostUpdateRate = 0.25;
+
+constexpr size_t kStagingAlignment = 256;
+
+/**
+ * @brief Counts an image which couldn't be decoded by any of the decoders
+ */
+void CountDecodeFailure(const ImageFormat *format) {
+  metrics::GetCounter("dali_decode_failures_total",
+                      "The number of images which could not be decoded, per format",
+                      {{"format", format ? format->Name() : "unknown"}}).Add();
+}
+
+/**
+ * @brief The shape of the interleaved image decoded by the host decoders, when the
+ *        postprocessing of the output is done on the GPU
+ */
+TensorShape<> StagedShape(const TensorShape<> &out_shape, const DecodeParams &opts) {
+  if (!opts.planar || out_shape.sample_dim() != 3)
+    return out_shape;
+  return {out_shape[1], out_shape[2], out_shape[0]};
+}
+
+std::exception_ptr MakeError(const std::string &message) {
+  return std::make_exception_ptr(std::runtime_error(message));
+}
+
+}  // namespace
+
+struct ImageDecoder::SubBatch {
+  int slot = -1;
+  std::vector<int> samples;
+  int64_t pixels = 0;
+  std::vector<ImageSource *> in;
+  std::vector<ROI> rois;
+  // the outputs of the host decoders - the staging buffer, if decoding to the GPU
+  std::vector<SampleView<CPUBackend>> host_out;
+  std::vector<SampleView<GPUBackend>> gpu_out;
+  bool staged = false;
+  std::chrono::high_resolution_clock::time_point start;
+  std::optional<FutureDecodeResults> future;
+};
+
+ImageDecoder::ImageDecoder(int device_id, bool lazy_init,
+                           const std::map<std::string, any> &params,
+                           const ImageFormatRegistry *registry)
+    : device_id_(device_id),
+      registry_(registry ? registry : &ImageFormatRegistry::instance()),
+      params_(params) {
+  // a factory can be registered for many formats - it gets one instance
+  std::map<ImageDecoderFactory *, int> slot_of;
+  for (auto *format : registry_->Formats()) {
+    auto factories = format->Decoders();
+    auto priorities = format->DecoderPriorities();
+    auto &decoders = format_decoders_[format];
+    for (int i = 0; i < factories.size(); i++) {
+      auto *factory = factories[i];
+      auto it = slot_of.find(factory);
+      if (it == slot_of.end()) {
+        DecoderSlot slot;
+        slot.factory = factory;
+        slot.props = factory->GetProperties();
+        slot.priority = priorities[i];
+        if (slot.props.gpu_output) {
+          if (device_id_ < 0 || !factory->IsSupported(device_id_))
+            continue;
+          slot.device_id = device_id_;
+        } else if (!factory->IsSupported(CPU_ONLY_DEVICE_ID)) {
+          continue;
+        }
+        it = slot_of.emplace(factory, slots_.size()).first;
+        slots_.push_back(std::move(slot));
+      }
+      decoders.push_back(it->second);
+    }
+  }
+  if (!lazy_init) {
+    for (int i = 0; i < static_cast<int>(slots_.size()); i++)
+      GetInstance(i);
+  }
+}
+
+ImageDecoder::~ImageDecoder() = default;
+
+ImageDecoderInstance *ImageDecoder::GetInstance(int slot) {
+  auto &s = slots_[slot];
+  if (!s.instance)
+    s.instance = s.factory->Create(s.device_id, params_);
+  return s.instance.get();
+}
+
+const ImageFormat *ImageDecoder::GetFormat(ImageSource *encoded) const {
+  return registry_->GetImageFormat(encoded);
+}
+
+ImageInfo ImageDecoder::GetInfo(ImageSource *encoded) const {
+  auto *format = GetFormat(encoded);
+  if (!format)
+    DALI_FAIL(make_string("Unsupported image format: ", encoded->SourceInfo()));
+  return format->Parser()->GetInfo(encoded);
+}
+
+std::vector<std::vector<int>> ImageDecoder::GetCandidates(DecodeContext ctx,
+                                                          cspan<ImageSource *> in,
+                                                          DecodeParams opts, cspan<ROI> rois,
+                                                          bool gpu_output) {
+  int n = in.size();
+  std::vector<std::vector<int>> candidates(n);
+  // the samples checked by each decoder
+  std::map<int, std::vector<int>> checked;
+  for (int i = 0; i < n; i++) {
+    auto format = format_decoders_.find(GetFormat(in[i]));
+    if (format == format_decoders_.end())
+      continue;
+    for (int slot : format->second) {
+      auto &props = slots_[slot].props;
+      if (props.gpu_output && !gpu_output)
+        continue;
+      if (!(props.supported_input_kinds & in[i]->Kind()))
+        continue;
+      checked[slot].push_back(i);
+    }
+  }
+
+  for (auto &[slot, samples] : checked) {
+    std::vector<ImageSource *> slot_in;
+    std::vector<ROI> slot_rois;
+    for (int i : samples) {
+      slot_in.push_back(in[i]);
+      if (!rois.empty())
+        slot_rois.push_back(rois[i]);
+    }
+    auto can_decode = GetInstance(slot)->CanDecode(ctx, make_cspan(slot_in), opts,
+                                                   make_cspan(slot_rois));
+    for (size_t j = 0; j < samples.size(); j++) {
+      if (can_decode[j])
+        candidates[samples[j]].push_back(slot);
+    }
+  }
+
+  for (auto &sample_candidates : candidates) {
+    std::stable_sort(sample_candidates.begin(), sample_candidates.end(), [&](int a, int b) {
+      return slots_[a].priority < slots_[b].priority;
+    });
+  }
+  return candidates;
+}
+
+std::vector<int> ImageDecoder::Split(DecodeContext ctx,
+                                     const std::vector<std::vector<int>> &candidates,
+                                     const std::vector<int64_t> &pixels) {
+  int n = candidates.size();
+  int host_threads = ctx.tp ? ctx.tp->NumThreads() : 1;
+  for (auto &slot : slots_) {
+    if (!slot.cost_measured)
+      slot.cost = DefaultCost(slot.priority, host_threads);
+  }
+
+  // the largest samples first, so that the small ones even out the loads
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return pixels[a] > pixels[b];
+  });
+  std::vector<double> load(slots_.size());
+  std::vector<int> assignment(n, -1);
+  for (int i : order) {
+    // the fallback decoders are used only when there's nothing else
+    bool regular = std::any_of(candidates[i].begin(), candidates[i].end(), [&](int slot) {
+      return slots_[slot].priority < FallbackDecoderPriority;
+    });
+    double best_time = 0;
+    for (int slot : candidates[i]) {
+      if (regular && slots_[slot].priority >= FallbackDecoderPriority)
+        continue;
+      double time = load[slot] + pixels[i] * slots_[slot].cost;
+      if (assignment[i] < 0 || time < best_time) {
+        assignment[i] = slot;
+        best_time = time;
+      }
+    }
+    if (assignment[i] >= 0)
+      load[assignment[i]] = best_time;
+  }
+  return assignment;
+}
+
+template <typename Backend>
+std::vector<DecodeResult> ImageDecoder::DecodeBatch(DecodeContext ctx,
+                                                    span<SampleView<Backend>> out,
+                                                    cspan<ImageSource *> in, DecodeParams opts,
+                                                    cspan<ROI> rois) {
+  constexpr bool gpu_output = std::is_same<Backend, GPUBackend>::value;
+  DALI_ENFORCE(gpu_output || !opts.needs_postprocessing(),
+               "The planar layout, normalization and mirroring are supported only when "
+               "decoding to the GPU.");
+  // the host decoders produce plain interleaved images, postprocessed on the GPU
+  bool postprocess = gpu_output && opts.needs_postprocessing();
+  DecodeParams host_opts = opts;
+  if (postprocess) {
+    host_opts.planar = false;
+    host_opts.mirror = false;
+    host_opts.mean.clear();
+    host_opts.stddev.clear();
+  }
+  assert(out.size() == in.size());
+  assert(rois.empty() || rois.size() == in.size());
+  int n = in.size();
+  std::vector<DecodeResult> results(n);
+  auto remaining = GetCandidates(ctx, in, opts, rois, gpu_output);
+  std::vector<int64_t> pixels(n);
+  for (int i = 0; i < n; i++) {
+    pixels[i] = volume(out[i].shape());
+    if (remaining[i].empty()) {
+      results[i] = DecodeResult::Failure(MakeError(make_string(
+          GetFormat(in[i]) ? "No decoder can decode the image: " : "Unsupported image format: ",
+          in[i]->SourceInfo())));
+    }
+  }
+  auto assignment = Split(ctx, remaining, pixels);
+
+  for (bool first_round = true;; first_round = false) {
+    std::map<int, SubBatch> batches;
+    for (int i = 0; i < n; i++) {
+      int slot = assignment[i];
+      if (slot < 0)
+        continue;
+      remaining[i].erase(std::find(remaining[i].begin(), remaining[i].end(), slot));
+      auto &batch = batches[slot];
+      batch.slot = slot;
+      batch.samples.push_back(i);
+      batch.pixels += pixels[i];
+      batch.in.push_back(in[i]);
+      if (!rois.empty())
+        batch.rois.push_back(rois[i]);
+    }
+    if (batches.empty())
+      break;
+
+    size_t staging_size = 0;
+    if (gpu_output) {
+      for (auto &[slot, batch] : batches) {
+        batch.staged = !slots_[slot].props.gpu_output;
+        if (!batch.staged)
+          continue;
+        for (int i : batch.samples) {
+          size_t size = pixels[i] * TypeTable::GetTypeInfo(out[i].type()).size();
+          staging_size += align_up(size, kStagingAlignment);
+        }
+      }
+      if (staging_size > staging_size_) {
+        staging_.reset();
+        staging_ = mm::alloc_raw_unique<uint8_t, mm::memory_kind::pinned>(staging_size);
+        staging_size_ = staging_size;
+      }
+      if (postprocess && staging_size > device_staging_size_) {
+        device_staging_.reset();
+        device_staging_ = mm::alloc_raw_unique<uint8_t, mm::memory_kind::device>(staging_size);
+        device_staging_size_ = staging_size;
+      }
+    }
+
+    uint8_t *staging = staging_.get();
+    for (auto &[slot, batch] : batches) {
+      for (int i : batch.samples) {
+        if (batch.staged) {
+          auto shape = postprocess ? StagedShape(out[i].shape(), opts) : out[i].shape();
+          batch.host_out.emplace_back(staging, shape, out[i].type());
+          size_t size = pixels[i] * TypeTable::GetTypeInfo(out[i].type()).size();
+          staging += align_up(size, kStagingAlignment);
+        } else if constexpr (gpu_output) {
+          batch.gpu_out.push_back(out[i]);
+        } else {
+          batch.host_out.push_back(out[i]);
+        }
+      }
+      batch.start = std::chrono::high_resolution_clock::now();
+      try {
+        auto *decoder = GetInstance(slot);
+        if (batch.host_out.empty()) {
+          batch.future.emplace(decoder->ScheduleDecode(ctx, make_span(batch.gpu_out),
+                                                       make_cspan(batch.in), opts,
+                                                       make_cspan(batch.rois)));
+        } else {
+          batch.future.emplace(decoder->ScheduleDecode(ctx, make_span(batch.host_out),
+                                                       make_cspan(batch.in),
+                                                       batch.staged ? host_opts : opts,
+                                                       make_cspan(batch.rois)));
+        }
+      } catch (...) {
+        for (int i : batch.samples)
+          results[i] = DecodeResult::Failure(std::current_exception());
+      }
+    }
+
+    // Waiting for the batches in the order in which they're expected to finish gives
+    // (close to) the right decoding times for the ones that finish first.
+    std::vector<SubBatch *> scheduled;
+    for (auto &[slot, batch] : batches) {
+      if (batch.future)
+        scheduled.push_back(&batch);
+    }
+    std::stable_sort(scheduled.begin(), scheduled.end(), [&](SubBatch *a, SubBatch *b) {
+      return a->pixels * slots_[a->slot].cost < b->pixels * slots_[b->slot].cost;
+    });
+    bool copied = false;
+    for (auto *batch : scheduled) {
+      auto batch_results = batch->future->get_all_ref();
+      std::chrono::duration<double> elapsed =
+          std::chrono::high_resolution_clock::now() - batch->start;
+      auto &slot = slots_[batch->slot];
+      // the samples passed to the fallback decoders aren't representative
+      if (first_round && batch->pixels > 0) {
+        double cost = elapsed.count() / batch->pixels;
+        slot.cost = slot.cost_measured ? slot.cost + kCostUpdateRate * (cost - slot.cost) : cost;
+        slot.cost_measured = true;
+      }
+      for (size_t k = 0; k < batch->samples.size(); k++) {
+        int i = batch->samples[k];
+        results[i] = batch_results[k];
+        if (batch_results[k].success && batch->staged) {
+          if constexpr (gpu_output) {
+            auto &staged = batch->host_out[k];
+            size_t size = pixels[i] * TypeTable::GetTypeInfo(out[i].type()).size();
+            if (postprocess) {
+              void *dev = device_staging_.get() +
+                          (static_cast<uint8_t *>(staged.raw_mutable_data()) - staging_.get());
+              CUDA_CALL(cudaMemcpyAsync(dev, staged.raw_mutable_data(), size,
+                                        cudaMemcpyHostToDevice, ctx.stream));
+              ConstSampleView<GPUBackend> dev_view(dev, staged.shape(), staged.type());
+              Convert(out[i], opts, dev_view, "HWC", opts.format, ctx.stream);
+            } else {
+              CUDA_CALL(cudaMemcpyAsync(out[i].raw_mutable_data(), staged.raw_mutable_data(),
+                                        size, cudaMemcpyHostToDevice, ctx.stream));
+            }
+            copied = true;
+          }
+        }
+      }
+    }
+    // the staging buffer is reused by the next round and batch
+    if (copied)
+      CUDA_CALL(cudaStreamSynchronize(ctx.stream));
+
+    // the failed samples go to the next candidates
+    for (auto &[slot, batch] : batches) {
+      for (int i : batch.samples) {
+        assignment[i] = -1;
+        if (!results[i].success && slots_[slot].props.fallback && !remaining[i].empty())
+          assignment[i] = remaining[i].front();
+      }
+    }
+  }
+  for (int i = 0; i < n; i++) {
+    if (!results[i].success)
+      CountDecodeFailure(GetFormat(in[i]));
+  }
+  return results;
+}
+
+bool ImageDecoder::CanDecode(DecodeContext ctx, ImageSource *in, DecodeParams opts,
+                             const ROI &roi) {
+  return CanDecode(ctx, make_cspan(&in, 1), opts, make_cspan(&roi, 1))[0];
+}
+
+std::vector<bool> ImageDecoder::CanDecode(DecodeContext ctx, cspan<ImageSource *> in,
+                                          DecodeParams opts, cspan<ROI> rois) {
+  auto candidates = GetCandidates(ctx, in, opts, rois, device_id_ >= 0);
+  std::vector<bool> ret(in.size());
+  for (int i = 0; i < in.size(); i++)
+    ret[i] = !candidates[i].empty();
+  return ret;
+}
+
+DecodeResult ImageDecoder::Decode(DecodeContext ctx, SampleView<CPUBackend> out,
+                                  ImageSource *in, DecodeParams opts, const ROI &roi) {
+  return DecodeBatch<CPUBackend>(ctx, make_span(&out, 1), make_cspan(&in, 1), opts,
+                                 make_cspan(&roi, 1))[0];
+}
+
+FutureDecodeResults ImageDecoder::ScheduleDecode(DecodeContext ctx, SampleView<CPUBackend> out,
+                                                 ImageSource *in, DecodeParams opts,
+                                                 const ROI &roi) {
+  return ScheduleDecode(ctx, make_span(&out, 1), make_cspan(&in, 1), opts, make_cspan(&roi, 1));
+}
+
+std::vector<DecodeResult> ImageDecoder::Decode(DecodeContext ctx,
+                                               span<SampleView<CPUBackend>> out,
+                                               cspan<ImageSource *> in, DecodeParams opts,
+                                               cspan<ROI> rois) {
+  return DecodeBatch<CPUBackend>(ctx, out, in, opts, rois);
+}
+
+FutureDecodeResults ImageDecoder::ScheduleDecode(DecodeContext ctx,
+                                                 span<SampleView<CPUBackend>> out,
+                                                 cspan<ImageSource *> in, DecodeParams opts,
+                                                 cspan<ROI> rois) {
+  auto results = DecodeBatch<CPUBackend>(ctx, out, in, opts, rois);
+  DecodeResultsPromise promise(results.size());
+  promise.set_all(make_span(results));
+  return promise.get_future();
+}
+
+DecodeResult ImageDecoder::Decode(DecodeContext ctx, SampleView<GPUBackend> out,
+                                  ImageSource *in, DecodeParams opts, const ROI &roi) {
+  return DecodeBatch<GPUBackend>(ctx, make_span(&out, 1), make_cspan(&in, 1), opts,
+                                 make_cspan(&roi, 1))[0];
+}
+
+FutureDecodeResults ImageDecoder::ScheduleDecode(DecodeContext ctx, SampleView<GPUBackend> out,
+                                                 ImageSource *in, DecodeParams opts,
+                                                 const ROI &roi) {
+  return ScheduleDecode(ctx, make_span(&out, 1), make_cspan(&in, 1), opts, make_cspan(&roi, 1));
+}
+
+std::vector<DecodeResult> ImageDecoder::Decode(DecodeContext ctx,
+                                               span<SampleView<GPUBackend>> out,
+                                               cspan<ImageSource *> in, DecodeParams opts,
+                                               cspan<ROI> rois) {
+  return DecodeBatch<GPUBackend>(ctx, out, in, opts, rois);
+}
+
+FutureDecodeResults ImageDecoder::ScheduleDecode(DecodeContext ctx,
+                                                 span<SampleView<GPUBackend>> out,
+                                                 cspan<ImageSource *> in, DecodeParams opts,
+                                                 cspan<ROI> rois) {
+  auto results = DecodeBatch<GPUBackend>(ctx, out, in, opts, rois);
+  DecodeResultsPromise promise(results.size());
+  promise.set_all(make_span(results));
+  return promise.get_future();
+}
+
+bool ImageDecoder::SetParam(const char *key, const any &value) {
+  params_[key] = value;
+  bool relevant = false;
+  for (auto &slot : slots_) {
+    if (slot.instance)
+      relevant |= slot.instance->SetParam(key, value);
+  }
+  return relevant;
+}
+
+int ImageDecoder::SetParams(const std::map<std::string, any> &params) {
+  int ret = 0;
+  for (auto &[key, value] : params)
+    ret += SetParam(key.c_str(), value);
+  return ret;
+}
+
+any ImageDecoder::GetParam(const char *key) const {
+  auto it = params_.find(key);
+  return it != params_.end() ? it->second : any{};
+}
+
+}  // namespace imgcodec
+}  // namespace dali
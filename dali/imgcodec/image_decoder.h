@@ -0,0 +1,171 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_IMGCODEC_IMAGE_DECODER_H_
+#define DALI_IMGCODEC_IMAGE_DECODER_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/core/mm/memory.h"
+#include "dali/imgcodec/image_decoder_interfaces.h"
+#include "dali/imgcodec/image_format.h"
+
+namespace dali {
+namespace imgcodec {
+
+/**
+ * @brief Decodes the images of all the registered formats, splitting the batches between
+ *        the decoders available for them
+ *
+ * The candidates for a sample are the decoders registered for its format which are supported
+ * on the device (or on the host, for the host decoders) and which can decode it. Each sample
+ * goes to the candidate expected to finish it first, counting the work already assigned to it
+ * in this batch. The costs (seconds per pixel) start at an estimate based on the priority of
+ * the decoder and are then measured in each batch.
+ *
+ * The parts of the batch are decoded concurrently, so that the hardware decoder, the GPU and
+ * the CPU threads all work at the same time. When decoding to the GPU, the host decoders decode
+ * to a pinned buffer, which is then copied to the output. If the output needs postprocessing
+ * (planar layout, normalization or mirroring), the host decoders produce interleaved images,
+ * which are copied to a device buffer and converted by the GPU while writing the output.
+ * The samples that a decoder fails to decode are passed to the next candidates, unless
+ * the decoder disallows the fallback.
+ *
+ * The decoding is finished when ScheduleDecode returns.
+ */
+class DLL_PUBLIC ImageDecoder : public ImageDecoderInstance {
+ public:
+  /**
+   * @param device_id  the device to decode on; CPU_ONLY_DEVICE_ID means only the host decoders
+   * @param lazy_init  if true, the decoders are created when they're first needed
+   * @param params     the parameters passed to the decoders
+   * @param registry   the formats and their decoders; the global registry by default
+   */
+  ImageDecoder(int device_id, bool lazy_init, const std::map<std::string, any> &params = {},
+               const ImageFormatRegistry *registry = nullptr);
+
+  ~ImageDecoder() override;
+
+  /**
+   * @brief Gets the format of the image, or nullptr if it isn't recognized
+   */
+  const ImageFormat *GetFormat(ImageSource *encoded) const;
+
+  /**
+   * @brief Parses the image to get its shape and orientation
+   *
+   * @throws std::runtime_error if the format of the image isn't recognized
+   */
+  ImageInfo GetInfo(ImageSource *encoded) const;
+
+  bool CanDecode(DecodeContext ctx, ImageSource *in, DecodeParams opts,
+                 const ROI &roi = {}) override;
+
+  std::vector<bool> CanDecode(DecodeContext ctx, cspan<ImageSource *> in, DecodeParams opts,
+                              cspan<ROI> rois = {}) override;
+
+  DecodeResult Decode(DecodeContext ctx, SampleView<CPUBackend> out, ImageSource *in,
+                      DecodeParams opts, const ROI &roi = {}) override;
+
+  FutureDecodeResults ScheduleDecode(DecodeContext ctx, SampleView<CPUBackend> out,
+                                     ImageSource *in, DecodeParams opts,
+                                     const ROI &roi = {}) override;
+
+  std::vector<DecodeResult> Decode(DecodeContext ctx, span<SampleView<CPUBackend>> out,
+                                   cspan<ImageSource *> in, DecodeParams opts,
+                                   cspan<ROI> rois = {}) override;
+
+  FutureDecodeResults ScheduleDecode(DecodeContext ctx, span<SampleView<CPUBackend>> out,
+                                     cspan<ImageSource *> in, DecodeParams opts,
+                                     cspan<ROI> rois = {}) override;
+
+  DecodeResult Decode(DecodeContext ctx, SampleView<GPUBackend> out, ImageSource *in,
+                      DecodeParams opts, const ROI &roi = {}) override;
+
+  FutureDecodeResults ScheduleDecode(DecodeContext ctx, SampleView<GPUBackend> out,
+                                     ImageSource *in, DecodeParams opts,
+                                     const ROI &roi = {}) override;
+
+  std::vector<DecodeResult> Decode(DecodeContext ctx, span<SampleView<GPUBackend>> out,
+                                   cspan<ImageSource *> in, DecodeParams opts,
+                                   cspan<ROI> rois = {}) override;
+
+  FutureDecodeResults ScheduleDecode(DecodeContext ctx, span<SampleView<GPUBackend>> out,
+                                     cspan<ImageSource *> in, DecodeParams opts,
+                                     cspan<ROI> rois = {}) override;
+
+  /**
+   * @brief Sets the parameter for all the decoders, including the ones created later
+   */
+  bool SetParam(const char *key, const any &value) override;
+
+  int SetParams(const std::map<std::string, any> &params) override;
+
+  any GetParam(const char *key) const override;
+
+ private:
+  struct DecoderSlot {
+    ImageDecoderFactory *factory = nullptr;
+    ImageDecoderProperties props;
+    float priority = 0;
+    int device_id = CPU_ONLY_DEVICE_ID;
+    std::shared_ptr<ImageDecoderInstance> instance;
+    /// estimated decoding time, in seconds per pixel
+    double cost = 0;
+    bool cost_measured = false;
+  };
+
+  /// A part of the batch, decoded by one decoder
+  struct SubBatch;
+
+  ImageDecoderInstance *GetInstance(int slot);
+
+  /**
+   * @brief Gets the candidate decoders of each sample, in the order of priority
+   */
+  std::vector<std::vector<int>> GetCandidates(DecodeContext ctx, cspan<ImageSource *> in,
+                                              DecodeParams opts, cspan<ROI> rois,
+                                              bool gpu_output);
+
+  /**
+   * @brief Assigns each sample to the candidate which is expected to finish it first
+   */
+  std::vector<int> Split(DecodeContext ctx, const std::vector<std::vector<int>> &candidates,
+                         const std::vector<int64_t> &pixels);
+
+  template <typename Backend>
+  std::vector<DecodeResult> DecodeBatch(DecodeContext ctx, span<SampleView<Backend>> out,
+                                        cspan<ImageSource *> in, DecodeParams opts,
+                                        cspan<ROI> rois);
+
+  int device_id_;
+  const ImageFormatRegistry *registry_;
+  std::map<std::string, any> params_;
+  std::vector<DecoderSlot> slots_;
+  /// the indices in slots_ of the decoders of each format, in the order of priority
+  std::map<const ImageFormat *, std::vector<int>> format_decoders_;
+  /// the staging buffer of the samples decoded on the host to the GPU
+  mm::uptr<uint8_t> staging_;
+  size_t staging_size_ = 0;
+  /// the device copy of the staging buffer, used when the output needs postprocessing
+  mm::uptr<uint8_t> device_staging_;
+  size_t device_staging_size_ = 0;
+};
+
+}  // namespace imgcodec
+}  // namespace dali
+
+#endif  // DALI_IMGCODEC_IMAGE_DECODER_H_
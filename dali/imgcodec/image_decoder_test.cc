@@ -0,0 +1,232 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "dali/imgcodec/decoders/decoder_parallel_impl.h"
+#include "dali/imgcodec/image_decoder.h"
+#include "dali/imgcodec/registry.h"
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+namespace imgcodec {
+
+namespace {
+
+// The mock images are 'M' followed by the flags
+constexpr uint8_t kFailsInFirst = 1;
+constexpr uint8_t kRejectedByFirst = 2;
+
+uint8_t Flags(ImageSource *in) {
+  return in->RawData<uint8_t>()[1];
+}
+
+class MockParser : public ImageParser {
+ public:
+  ImageInfo GetInfo(ImageSource *encoded) const override {
+    ImageInfo info;
+    info.shape = {8, 8, 1};
+    return info;
+  }
+
+  bool CanParse(ImageSource *encoded) const override {
+    return encoded->Size() == 2 && encoded->RawData<char>()[0] == 'M';
+  }
+};
+
+/**
+ * @brief Fills the output with id + 1; the first decoder (id 0) fails or rejects the images
+ *        with the respective flags.
+ */
+class MockDecoder : public BatchParallelDecoderImpl {
+ public:
+  MockDecoder(int id, std::atomic<int> *decoded)
+      : BatchParallelDecoderImpl(CPU_ONLY_DEVICE_ID, {}), id_(id), decoded_(decoded) {}
+
+  using BatchParallelDecoderImpl::CanDecode;
+  bool CanDecode(DecodeContext ctx, ImageSource *in, DecodeParams opts, const ROI &roi) override {
+    return id_ != 0 || !(Flags(in) & kRejectedByFirst);
+  }
+
+  DecodeResult DecodeImplTask(int thread_idx, SampleView<CPUBackend> out, ImageSource *in,
+                              DecodeParams opts, const ROI &roi) override {
+    if (id_ == 0 && (Flags(in) & kFailsInFirst))
+      return DecodeResult::Failure(std::make_exception_ptr(std::runtime_error("mock failure")));
+    auto *data = static_cast<uint8_t *>(out.raw_mutable_data());
+    std::fill(data, data + volume(out.shape()), id_ + 1);
+    (*decoded_)++;
+    return DecodeResult::Success();
+  }
+
+ private:
+  int id_;
+  std::atomic<int> *decoded_;
+};
+
+class MockDecoderFactory : public ImageDecoderFactory {
+ public:
+  explicit MockDecoderFactory(int id, bool gpu_output = false, bool fallback = true)
+      : id_(id), gpu_output_(gpu_output), fallback_(fallback) {}
+
+  ImageDecoderProperties GetProperties() const override {
+    ImageDecoderProperties props;
+    props.supported_input_kinds = InputKind::HostMemory;
+    props.gpu_output = gpu_output_;
+    props.fallback = fallback_;
+    return props;
+  }
+
+  bool IsSupported(int device_id) const override {
+    return !gpu_output_ || device_id >= 0;
+  }
+
+  std::shared_ptr<ImageDecoderInstance>
+  Create(int device_id, const std::map<std::string, any> &params = {}) const override {
+    created++;
+    return std::make_shared<MockDecoder>(id_, &decoded);
+  }
+
+  mutable std::atomic<int> created{0};
+  mutable std::atomic<int> decoded{0};
+
+ private:
+  int id_;
+  bool gpu_output_, fallback_;
+};
+
+}  // namespace
+
+class ImageDecoderTest : public ::testing::Test {
+ protected:
+  ImageDecoderTest() : tp_(4, CPU_ONLY_DEVICE_ID, false, "ImageDecoderTest") {
+    format_ = std::make_shared<ImageFormat>("mock", std::make_shared<MockParser>());
+    registry_.RegisterFormat(format_);
+  }
+
+  std::shared_ptr<MockDecoderFactory> AddDecoder(int id, float priority, bool gpu_output = false,
+                                                 bool fallback = true) {
+    auto factory = std::make_shared<MockDecoderFactory>(id, gpu_output, fallback);
+    format_->RegisterDecoder(factory, priority);
+    return factory;
+  }
+
+  /**
+   * @brief Decodes the images with the given flags (or the ones with the non-mock contents,
+   *        if flags < 0) and returns the values filled by the decoders (0 if failed).
+   */
+  std::vector<int> Decode(ImageDecoder &decoder, const std::vector<int> &flags) {
+    int n = flags.size();
+    encoded_.resize(n);
+    std::vector<ImageSource> sources;
+    std::vector<ImageSource *> source_ptrs;
+    sources.reserve(n);
+    for (int i = 0; i < n; i++) {
+      encoded_[i] = {flags[i] < 0 ? uint8_t('X') : uint8_t('M'), uint8_t(std::max(flags[i], 0))};
+      sources.push_back(ImageSource::FromHostMem(encoded_[i].data(), encoded_[i].size()));
+      source_ptrs.push_back(&sources.back());
+    }
+    std::vector<std::vector<uint8_t>> outputs(n, std::vector<uint8_t>(64));
+    std::vector<SampleView<CPUBackend>> out;
+    for (auto &output : outputs)
+      out.emplace_back(output.data(), TensorShape<>{8, 8, 1}, DALI_UINT8);
+    auto results = decoder.Decode({&tp_, {}}, make_span(out), make_cspan(source_ptrs), {});
+    std::vector<int> values(n);
+    for (int i = 0; i < n; i++) {
+      if (results[i].success) {
+        EXPECT_TRUE(std::all_of(outputs[i].begin(), outputs[i].end(),
+                                [&](uint8_t v) { return v == outputs[i][0]; }));
+        values[i] = outputs[i][0];
+      } else {
+        EXPECT_NE(results[i].exception, nullptr);
+      }
+    }
+    return values;
+  }
+
+  ThreadPool tp_;
+  ImageFormatRegistry registry_;
+  std::shared_ptr<ImageFormat> format_;
+  std::vector<std::vector<uint8_t>> encoded_;
+};
+
+TEST_F(ImageDecoderTest, SplitBetweenDecoders) {
+  auto first = AddDecoder(0, HostDecoderPriority);
+  auto second = AddDecoder(1, HostDecoderPriority);
+  ImageDecoder decoder(CPU_ONLY_DEVICE_ID, true, {}, &registry_);
+  auto values = Decode(decoder, std::vector<int>(16, 0));
+  // equal costs - each decoder gets half of the batch
+  EXPECT_EQ(first->decoded, 8);
+  EXPECT_EQ(second->decoded, 8);
+  for (int v : values)
+    EXPECT_TRUE(v == 1 || v == 2);
+
+  for (int iter = 0; iter < 5; iter++) {
+    values = Decode(decoder, std::vector<int>(16, 0));
+    for (int v : values)
+      EXPECT_TRUE(v == 1 || v == 2);
+  }
+  EXPECT_EQ(first->decoded + second->decoded, 16 * 6);
+  EXPECT_EQ(first->created, 1);
+  EXPECT_EQ(second->created, 1);
+}
+
+TEST_F(ImageDecoderTest, FallbackDecodersOnlyWhenNeeded) {
+  auto regular = AddDecoder(0, HostDecoderPriority);
+  auto fallback = AddDecoder(1, FallbackDecoderPriority);
+  ImageDecoder decoder(CPU_ONLY_DEVICE_ID, false, {}, &registry_);
+  auto values = Decode(decoder, {0, 0, kRejectedByFirst, 0, kFailsInFirst, 0});
+  EXPECT_EQ(values, (std::vector<int>{1, 1, 2, 1, 2, 1}));
+  EXPECT_EQ(regular->decoded, 4);
+  EXPECT_EQ(fallback->decoded, 2);
+}
+
+TEST_F(ImageDecoderTest, NoFallback) {
+  AddDecoder(0, HostDecoderPriority, false, false);
+  AddDecoder(1, FallbackDecoderPriority);
+  ImageDecoder decoder(CPU_ONLY_DEVICE_ID, true, {}, &registry_);
+  auto values = Decode(decoder, {0, kFailsInFirst, kRejectedByFirst});
+  // the failed image isn't passed on, but the rejected one goes to the other decoder
+  EXPECT_EQ(values, (std::vector<int>{1, 0, 2}));
+}
+
+TEST_F(ImageDecoderTest, HostOnly) {
+  auto gpu = AddDecoder(0, CUDADecoderPriority, true);
+  auto host = AddDecoder(1, HostDecoderPriority);
+  ImageDecoder decoder(CPU_ONLY_DEVICE_ID, false, {}, &registry_);
+  auto values = Decode(decoder, {0, 0, 0, 0});
+  EXPECT_EQ(values, (std::vector<int>{2, 2, 2, 2}));
+  EXPECT_EQ(gpu->created, 0);
+  EXPECT_EQ(host->decoded, 4);
+}
+
+TEST_F(ImageDecoderTest, UnsupportedFormat) {
+  AddDecoder(0, HostDecoderPriority);
+  ImageDecoder decoder(CPU_ONLY_DEVICE_ID, true, {}, &registry_);
+  auto values = Decode(decoder, {0, -1, 0});
+  EXPECT_EQ(values, (std::vector<int>{1, 0, 1}));
+
+  std::vector<uint8_t> data = {'X', 0};
+  auto src = ImageSource::FromHostMem(data.data(), data.size());
+  EXPECT_EQ(decoder.GetFormat(&src), nullptr);
+  EXPECT_THROW(decoder.GetInfo(&src), std::exception);
+}
+
+}  // namespace imgcodec
+}  // namespace dali
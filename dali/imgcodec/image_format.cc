@@ -37,14 +37,21 @@ span<ImageDecoderFactory *const> ImageFormat::Decoders() const {
   return make_cspan(decoder_ptrs_);
 }
 
+span<const float> ImageFormat::DecoderPriorities() const {
+  return make_cspan(decoder_priorities_);
+}
+
 void ImageFormat::RegisterDecoder(std::shared_ptr<ImageDecoderFactory> decoder, float priority) {
   auto it = decoders_.emplace(priority, std::move(decoder));
   if (std::next(it) == decoders_.end()) {
     decoder_ptrs_.push_back(it->second.get());
+    decoder_priorities_.push_back(priority);
   } else {
     decoder_ptrs_.clear();
+    decoder_priorities_.clear();
     for (auto [priority, decoder] : decoders_) {
       decoder_ptrs_.push_back(decoder.get());
+      decoder_priorities_.push_back(priority);
     }
   }
 }
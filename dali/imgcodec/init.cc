@@ -17,6 +17,7 @@
 #include "dali/imgcodec/image_format.h"
 #include "dali/imgcodec/image_decoder_interfaces.h"
 
+#include "dali/imgcodec/parsers/avif.h"
 #include "dali/imgcodec/parsers/bmp.h"
 #include "dali/imgcodec/parsers/jpeg.h"
 #include "dali/imgcodec/parsers/jpeg2000.h"
@@ -39,6 +40,7 @@ std::shared_ptr<ImageFormat> make_format(const char *name) {
 void InitFormats(ImageFormatRegistry &reg) {
   shared_ptr<ImageFormat> format;
 
+  reg.RegisterFormat(make_format<AvifParser>("AVIF"));
   reg.RegisterFormat(make_format<BmpParser>("BMP"));
   reg.RegisterFormat(make_format<JpegParser>("JPEG"));
   reg.RegisterFormat(make_format<Jpeg2000Parser>("JPEG2000"));
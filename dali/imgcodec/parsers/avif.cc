@@ -0,0 +1,280 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+#include "dali/imgcodec/parsers/avif.h"
+#include "dali/imgcodec/util/tag.h"
+#include "dali/core/byte_io.h"
+
+namespace dali {
+namespace imgcodec {
+
+namespace {
+
+// AVIF images are stored in the HEIF container, which is based on ISOBMFF:
+// https://aomediacodec.github.io/av1-avif/
+// The file is a sequence of boxes; the still image is described by the items of the `meta` box.
+
+using box_type_t = std::array<uint8_t, 4>;
+
+const char kAlphaUrn[] = "urn:mpeg:mpegB:cicp:systems:auxiliary:alpha";
+const char kAlphaUrnHevc[] = "urn:mpeg:hevc:2015:auxid:1";
+
+struct BoxHeader {
+  box_type_t type;
+  int64_t data_begin;  // the position of the payload
+  int64_t end;         // the position of the next box
+};
+
+BoxHeader ReadBoxHeader(InputStream &stream, int64_t parent_end) {
+  int64_t start = stream.TellRead();
+  uint64_t size = ReadValueBE<uint32_t>(stream);
+  BoxHeader header;
+  header.type = stream.ReadOne<box_type_t>();
+  if (size == 1)
+    size = ReadValueBE<uint64_t>(stream);
+  else if (size == 0)  // the box extends to the end of the enclosing box
+    size = parent_end - start;
+  header.data_begin = stream.TellRead();
+  header.end = start + size;
+  DALI_ENFORCE(header.end >= header.data_begin && header.end <= parent_end,
+               "Invalid AVIF box size");
+  return header;
+}
+
+/**
+ * @brief Reads the header of a FullBox; stores the version and returns the flags
+ */
+uint32_t ReadFullBoxHeader(InputStream &stream, int *version) {
+  uint32_t version_and_flags = ReadValueBE<uint32_t>(stream);
+  *version = version_and_flags >> 24;
+  return version_and_flags & 0xffffff;
+}
+
+uint32_t ReadItemId(InputStream &stream, int version) {
+  return version == 0 ? ReadValueBE<uint16_t>(stream) : ReadValueBE<uint32_t>(stream);
+}
+
+struct ItemProperty {
+  box_type_t type{};
+  int64_t width = 0, height = 0;  // ispe
+  int angle = 0;                  // irot
+  int axis = 0;                   // imir
+  std::string aux_type;           // auxC
+};
+
+struct MetaInfo {
+  uint32_t primary_item = 0;
+  std::vector<ItemProperty> properties;
+  std::map<uint32_t, std::vector<int>> associations;  // item -> property indices (1-based)
+  std::vector<uint32_t> aux_items;                     // auxiliary images of the primary item
+};
+
+ItemProperty ReadProperty(InputStream &stream, const BoxHeader &box) {
+  ItemProperty prop;
+  prop.type = box.type;
+  int version;
+  if (box.type == tag("ispe")) {
+    ReadFullBoxHeader(stream, &version);
+    prop.width = ReadValueBE<uint32_t>(stream);
+    prop.height = ReadValueBE<uint32_t>(stream);
+  } else if (box.type == tag("irot")) {
+    prop.angle = (stream.ReadOne<uint8_t>() & 3) * 90;
+  } else if (box.type == tag("imir")) {
+    prop.axis = stream.ReadOne<uint8_t>() & 1;
+  } else if (box.type == tag("auxC")) {
+    ReadFullBoxHeader(stream, &version);
+    while (stream.TellRead() < box.end) {
+      char c = stream.ReadOne<char>();
+      if (c == '\0')
+        break;
+      prop.aux_type += c;
+    }
+  }
+  return prop;
+}
+
+void ReadAssociations(InputStream &stream, MetaInfo &meta) {
+  int version;
+  uint32_t flags = ReadFullBoxHeader(stream, &version);
+  uint32_t entry_count = ReadValueBE<uint32_t>(stream);
+  for (uint32_t i = 0; i < entry_count; i++) {
+    uint32_t item = ReadItemId(stream, version);
+    int count = stream.ReadOne<uint8_t>();
+    auto &indices = meta.associations[item];
+    for (int j = 0; j < count; j++) {
+      // the most significant bit is the `essential` flag
+      if (flags & 1)
+        indices.push_back(ReadValueBE<uint16_t>(stream) & 0x7fff);
+      else
+        indices.push_back(stream.ReadOne<uint8_t>() & 0x7f);
+    }
+  }
+}
+
+void ReadReferences(InputStream &stream, const BoxHeader &iref, MetaInfo &meta) {
+  int version;
+  ReadFullBoxHeader(stream, &version);
+  while (stream.TellRead() < iref.end) {
+    auto ref = ReadBoxHeader(stream, iref.end);
+    if (ref.type == tag("auxl")) {
+      uint32_t from = ReadItemId(stream, version);
+      int count = ReadValueBE<uint16_t>(stream);
+      for (int i = 0; i < count; i++) {
+        if (ReadItemId(stream, version) == meta.primary_item)
+          meta.aux_items.push_back(from);
+      }
+    }
+    stream.SeekRead(ref.end);
+  }
+}
+
+MetaInfo ReadMeta(InputStream &stream, const BoxHeader &meta_box) {
+  MetaInfo meta;
+  int version;
+  ReadFullBoxHeader(stream, &version);
+  // `iref` refers to the primary item, which might be declared after it
+  BoxHeader iref;
+  bool has_iref = false;
+  while (stream.TellRead() < meta_box.end) {
+    auto box = ReadBoxHeader(stream, meta_box.end);
+    if (box.type == tag("pitm")) {
+      ReadFullBoxHeader(stream, &version);
+      meta.primary_item = ReadItemId(stream, version);
+    } else if (box.type == tag("iprp")) {
+      while (stream.TellRead() < box.end) {
+        auto child = ReadBoxHeader(stream, box.end);
+        if (child.type == tag("ipco")) {
+          while (stream.TellRead() < child.end) {
+            auto prop_box = ReadBoxHeader(stream, child.end);
+            meta.properties.push_back(ReadProperty(stream, prop_box));
+            stream.SeekRead(prop_box.end);
+          }
+        } else if (child.type == tag("ipma")) {
+          ReadAssociations(stream, meta);
+        }
+        stream.SeekRead(child.end);
+      }
+    } else if (box.type == tag("iref")) {
+      iref = box;
+      has_iref = true;
+    }
+    stream.SeekRead(box.end);
+  }
+  if (has_iref) {
+    stream.SeekRead(iref.data_begin);
+    ReadReferences(stream, iref, meta);
+  }
+  return meta;
+}
+
+const std::vector<int> &ItemProperties(const MetaInfo &meta, uint32_t item) {
+  static const std::vector<int> none;
+  auto it = meta.associations.find(item);
+  return it != meta.associations.end() ? it->second : none;
+}
+
+const ItemProperty *GetProperty(const MetaInfo &meta, int index) {
+  DALI_ENFORCE(index >= 1 && index <= static_cast<int>(meta.properties.size()),
+               make_string("Invalid AVIF property index: ", index));
+  return &meta.properties[index - 1];
+}
+
+}  // namespace
+
+ImageInfo AvifParser::GetInfo(ImageSource *encoded) const {
+  auto stream = encoded->Open();
+  int64_t file_end = stream->Size();
+
+  while (stream->TellRead() < file_end) {
+    auto box = ReadBoxHeader(*stream, file_end);
+    if (box.type != tag("meta")) {
+      stream->SeekRead(box.end);
+      continue;
+    }
+
+    auto meta = ReadMeta(*stream, box);
+    ImageInfo info;
+    info.orientation = {0, false, false};
+    int64_t width = -1, height = -1;
+    bool mirrored = false;
+    for (int index : ItemProperties(meta, meta.primary_item)) {
+      auto *prop = GetProperty(meta, index);
+      if (prop->type == tag("ispe")) {
+        width = prop->width;
+        height = prop->height;
+      } else if (prop->type == tag("irot")) {
+        // The transforms are applied in the order of the association, while Orientation
+        // rotates first; mirroring before the rotation is the same as the opposite rotation
+        // followed by the mirroring.
+        info.orientation.rotate = mirrored ? (360 - prop->angle) % 360 : prop->angle;
+      } else if (prop->type == tag("imir")) {
+        mirrored = true;
+        if (prop->axis == 0)
+          info.orientation.flip_x = true;
+        else
+          info.orientation.flip_y = true;
+      }
+    }
+    DALI_ENFORCE(width > 0 && height > 0,
+                 "The primary item of the AVIF image has no spatial extent property");
+
+    bool has_alpha = false;
+    for (uint32_t aux : meta.aux_items) {
+      for (int index : ItemProperties(meta, aux)) {
+        auto *prop = GetProperty(meta, index);
+        if (prop->type == tag("auxC") &&
+            (prop->aux_type == kAlphaUrn || prop->aux_type == kAlphaUrnHevc))
+          has_alpha = true;
+      }
+    }
+
+    // AV1 monochrome images are decoded as RGB as well
+    info.shape = {height, width, has_alpha ? 4 : 3};
+    return info;
+  }
+  DALI_FAIL("The AVIF image has no `meta` box");
+}
+
+bool AvifParser::CanParse(ImageSource *encoded) const {
+  uint8_t data[64];
+  size_t n = ReadHeader(data, encoded, sizeof(data));
+  if (n < 16)
+    return false;
+
+  MemInputStream stream(data, n);
+  uint32_t ftyp_size = ReadValueBE<uint32_t>(stream);
+  if (stream.ReadOne<box_type_t>() != tag("ftyp") || ftyp_size < 16)
+    return false;
+
+  auto is_avif_brand = [](const box_type_t &brand) {
+    return brand == tag("avif") || brand == tag("avis");
+  };
+  if (is_avif_brand(stream.ReadOne<box_type_t>()))
+    return true;
+  stream.Skip<uint32_t>();  // minor version
+  size_t end = std::min<size_t>(ftyp_size, n);
+  while (static_cast<size_t>(stream.TellRead()) + sizeof(box_type_t) <= end) {
+    if (is_avif_brand(stream.ReadOne<box_type_t>()))
+      return true;
+  }
+  return false;
+}
+
+}  // namespace imgcodec
+}  // namespace dali
@@ -0,0 +1,39 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_IMGCODEC_PARSERS_AVIF_H_
+#define DALI_IMGCODEC_PARSERS_AVIF_H_
+
+#include "dali/imgcodec/image_format.h"
+
+namespace dali {
+namespace imgcodec {
+
+/**
+ * @brief Parses the HEIF (ISOBMFF) container of AVIF still images
+ *
+ * The shape is taken from the `ispe` property of the primary item and the orientation
+ * from its `irot` and `imir` properties. The images are reported as RGB, or RGBA when
+ * the primary item has an alpha auxiliary image.
+ */
+class DLL_PUBLIC AvifParser : public ImageParser {
+ public:
+  ImageInfo GetInfo(ImageSource *encoded) const override;
+  bool CanParse(ImageSource *encoded) const override;
+};
+
+}  // namespace imgcodec
+}  // namespace dali
+
+#endif  // DALI_IMGCODEC_PARSERS_AVIF_H_
@@ -0,0 +1,174 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "dali/imgcodec/image_source.h"
+#include "dali/imgcodec/parsers/avif.h"
+
+namespace dali {
+namespace imgcodec {
+namespace test {
+
+namespace {
+
+using bytes = std::vector<uint8_t>;
+
+void Append(bytes &out, const bytes &data) {
+  out.insert(out.end(), data.begin(), data.end());
+}
+
+void AppendBE(bytes &out, uint32_t value, int nbytes) {
+  for (int i = nbytes - 1; i >= 0; i--)
+    out.push_back((value >> (8 * i)) & 0xff);
+}
+
+bytes Box(const char (&type)[5], const bytes &payload) {
+  bytes out;
+  AppendBE(out, payload.size() + 8, 4);
+  out.insert(out.end(), type, type + 4);
+  Append(out, payload);
+  return out;
+}
+
+bytes FullBox(const char (&type)[5], const bytes &payload, uint32_t flags = 0) {
+  bytes data;
+  AppendBE(data, flags, 4);  // version 0
+  Append(data, payload);
+  return Box(type, data);
+}
+
+bytes Ftyp(const char (&major)[5], const char (&compatible)[5]) {
+  bytes data(major, major + 4);
+  AppendBE(data, 0, 4);
+  data.insert(data.end(), compatible, compatible + 4);
+  return Box("ftyp", data);
+}
+
+bytes Ispe(uint32_t width, uint32_t height) {
+  bytes data;
+  AppendBE(data, width, 4);
+  AppendBE(data, height, 4);
+  return FullBox("ispe", data);
+}
+
+/**
+ * @brief Builds a `meta` box with the primary item 1, which has the given properties
+ *
+ * When `alpha` is set, item 2 is an alpha auxiliary image of the primary item.
+ */
+bytes Meta(const std::vector<bytes> &properties, bool alpha = false) {
+  bytes ipco, ipma, meta;
+  for (auto &p : properties)
+    Append(ipco, p);
+  int alpha_index = properties.size() + 1;
+  if (alpha) {
+    std::string urn = "urn:mpeg:mpegB:cicp:systems:auxiliary:alpha";
+    bytes aux(urn.begin(), urn.end());
+    aux.push_back(0);
+    Append(ipco, FullBox("auxC", aux));
+  }
+
+  AppendBE(ipma, alpha ? 2 : 1, 4);  // entry count
+  AppendBE(ipma, 1, 2);              // item id
+  ipma.push_back(properties.size());
+  for (size_t i = 0; i < properties.size(); i++)
+    ipma.push_back(0x80 | (i + 1));  // essential
+  if (alpha) {
+    AppendBE(ipma, 2, 2);
+    ipma.push_back(1);
+    ipma.push_back(alpha_index);
+  }
+
+  bytes pitm;
+  AppendBE(pitm, 1, 2);
+  Append(meta, FullBox("pitm", pitm));
+  if (alpha) {
+    bytes auxl;
+    AppendBE(auxl, 2, 2);  // from
+    AppendBE(auxl, 1, 2);  // count
+    AppendBE(auxl, 1, 2);  // to
+    Append(meta, FullBox("iref", Box("auxl", auxl)));
+  }
+  bytes iprp = Box("ipco", ipco);
+  Append(iprp, FullBox("ipma", ipma));
+  Append(meta, Box("iprp", iprp));
+  return FullBox("meta", meta);
+}
+
+bytes Avif(const bytes &meta) {
+  bytes out = Ftyp("mif1", "avif");
+  Append(out, meta);
+  Append(out, Box("mdat", bytes(16, 0)));
+  return out;
+}
+
+ImageInfo Parse(const bytes &data) {
+  AvifParser parser;
+  auto src = ImageSource::FromHostMem(data.data(), data.size());
+  EXPECT_TRUE(parser.CanParse(&src));
+  return parser.GetInfo(&src);
+}
+
+}  // namespace
+
+TEST(AvifParserTest, CanParse) {
+  AvifParser parser;
+  for (auto data : {Ftyp("avif", "mif1"), Ftyp("mif1", "avif"), Ftyp("avis", "msf1")}) {
+    auto src = ImageSource::FromHostMem(data.data(), data.size());
+    EXPECT_TRUE(parser.CanParse(&src));
+  }
+  for (auto data : {Ftyp("heic", "mif1"), Box("moov", bytes(16, 0)), bytes(8, 0)}) {
+    auto src = ImageSource::FromHostMem(data.data(), data.size());
+    EXPECT_FALSE(parser.CanParse(&src));
+  }
+}
+
+TEST(AvifParserTest, Shape) {
+  auto info = Parse(Avif(Meta({Ispe(640, 480)})));
+  EXPECT_EQ(info.shape, TensorShape<>(480, 640, 3));
+  EXPECT_EQ(info.orientation.rotate, 0);
+  EXPECT_FALSE(info.orientation.flip_x);
+  EXPECT_FALSE(info.orientation.flip_y);
+}
+
+TEST(AvifParserTest, Alpha) {
+  auto info = Parse(Avif(Meta({Ispe(17, 9)}, true)));
+  EXPECT_EQ(info.shape, TensorShape<>(9, 17, 4));
+}
+
+TEST(AvifParserTest, Orientation) {
+  auto info = Parse(Avif(Meta({Ispe(20, 10), Box("irot", {1}), Box("imir", {0})})));
+  EXPECT_EQ(info.shape, TensorShape<>(10, 20, 3));
+  EXPECT_EQ(info.orientation.rotate, 90);
+  EXPECT_TRUE(info.orientation.flip_x);
+  EXPECT_FALSE(info.orientation.flip_y);
+
+  // mirroring first is equivalent to the opposite rotation followed by the mirroring
+  info = Parse(Avif(Meta({Ispe(20, 10), Box("imir", {1}), Box("irot", {1})})));
+  EXPECT_EQ(info.orientation.rotate, 270);
+  EXPECT_FALSE(info.orientation.flip_x);
+  EXPECT_TRUE(info.orientation.flip_y);
+}
+
+TEST(AvifParserTest, NoSpatialExtent) {
+  auto data = Avif(Meta({Box("irot", {2})}));
+  auto src = ImageSource::FromHostMem(data.data(), data.size());
+  EXPECT_THROW(AvifParser().GetInfo(&src), std::exception);
+}
+
+}  // namespace test
+}  // namespace imgcodec
+}  // namespace dali
@@ -41,6 +41,46 @@ bool IsSofMarker(const jpeg_marker_t &marker) {
   return marker[1] != 0xc4 && marker[1] != 0xc8 && marker[1] != 0xcc;
 }
 
+/**
+ * @brief Reads the next marker, skipping the fill bytes
+ */
+jpeg_marker_t ReadMarker(InputStream &stream, ImageSource *encoded) {
+  jpeg_marker_t marker;
+  marker[0] = stream.ReadOne<uint8_t>();
+  // https://www.w3.org/Graphics/JPEG/itu-t81.pdf section B.1.1.2 Markers
+  // Any marker may optionally be preceded by any number of fill bytes,
+  // which are bytes assigned code '\xFF'
+  do {
+    marker[1] = stream.ReadOne<uint8_t>();
+  } while (marker[1] == 0xff);
+  DALI_ENFORCE(IsValidMarker(marker),
+               make_string("Invalid marker found in JPEG image: ", encoded->SourceInfo()));
+  return marker;
+}
+
+JpegFrameInfo GetJpegFrameInfo(ImageSource *encoded) {
+  auto stream = encoded->Open();
+  DALI_ENFORCE(stream->ReadOne<jpeg_marker_t>() == soi_marker,
+               make_string("Not a JPEG image: ", encoded->SourceInfo()));
+  for (;;) {
+    jpeg_marker_t marker = ReadMarker(*stream, encoded);
+    if (marker == sos_marker)
+      break;
+    uint16_t size = ReadValueBE<uint16_t>(*stream);
+    ptrdiff_t next_marker_offset = stream->TellRead() - 2 + size;
+    if (IsSofMarker(marker)) {
+      JpegFrameInfo frame;
+      frame.sof_marker = marker[1];
+      frame.precision = stream->ReadOne<uint8_t>();
+      stream->Skip(4);  // height and width
+      frame.num_components = stream->ReadOne<uint8_t>();
+      return frame;
+    }
+    stream->SeekRead(next_marker_offset, SEEK_SET);
+  }
+  DALI_FAIL(make_string("Couldn't read the frame header of JPEG image: ", encoded->SourceInfo()));
+}
+
 ImageInfo JpegParser::GetInfo(ImageSource *encoded) const {
   ImageInfo info{};
   auto stream = encoded->Open();
@@ -50,16 +90,7 @@ ImageInfo JpegParser::GetInfo(ImageSource *encoded) const {
 
   bool read_shape = false, read_orientation = false;
   while (!read_shape || !read_orientation) {
-    jpeg_marker_t marker;
-    marker[0] = stream->ReadOne<uint8_t>();
-    // https://www.w3.org/Graphics/JPEG/itu-t81.pdf section B.1.1.2 Markers
-    // Any marker may optionally be preceded by any number of fill bytes,
-    // which are bytes assigned code '\xFF'
-    do {
-      marker[1] = stream->ReadOne<uint8_t>();
-    } while (marker[1] == 0xff);
-    DALI_ENFORCE(IsValidMarker(marker),
-                 make_string("Invalid marker found in JPEG image: ", encoded->SourceInfo()));
+    jpeg_marker_t marker = ReadMarker(*stream, encoded);
     if (marker == sos_marker)
       break;
 
@@ -20,6 +20,34 @@
 namespace dali {
 namespace imgcodec {
 
+/**
+ * @brief The coding parameters of a JPEG image, as given by its frame header
+ */
+struct JpegFrameInfo {
+  /** @brief The second byte of the Start Of Frame marker, from 0xC0 to 0xCF */
+  uint8_t sof_marker = 0;
+  /** @brief Bits per sample */
+  int precision = 0;
+  int num_components = 0;
+
+  /** @brief Whether the image is coded with the lossless process (Huffman or arithmetic) */
+  bool lossless() const {
+    return sof_marker == 0xc3 || sof_marker == 0xc7 || sof_marker == 0xcb || sof_marker == 0xcf;
+  }
+
+  /** @brief Whether the image is coded with the progressive DCT process (Huffman or arithmetic) */
+  bool progressive() const {
+    return sof_marker == 0xc2 || sof_marker == 0xc6 || sof_marker == 0xca || sof_marker == 0xce;
+  }
+};
+
+/**
+ * @brief Reads the frame header of a JPEG image
+ *
+ * Throws if there's no Start Of Frame marker before the first scan.
+ */
+DLL_PUBLIC JpegFrameInfo GetJpegFrameInfo(ImageSource *encoded);
+
 class DLL_PUBLIC JpegParser : public ImageParser {
  public:
   ImageInfo GetInfo(ImageSource *encoded) const override;
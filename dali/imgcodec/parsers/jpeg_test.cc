@@ -110,6 +110,29 @@ TEST_F(JpegParserTest, Padding) {
   EXPECT_EQ(TensorShape<>(408, 640, 3), GetInfo(padded).shape);
 }
 
+TEST_F(JpegParserTest, FrameInfo) {
+  auto src = ImageSource::FromHostMem(valid_jpeg_.data(), valid_jpeg_.size());
+  auto frame = GetJpegFrameInfo(&src);
+  EXPECT_EQ(0xc0, frame.sof_marker);
+  EXPECT_EQ(8, frame.precision);
+  EXPECT_EQ(3, frame.num_components);
+  EXPECT_FALSE(frame.lossless());
+}
+
+TEST_F(JpegParserTest, FrameInfoLossless) {
+  // SOI, a lossless (SOF3) frame header of a 16-bit 20x30 grayscale image and SOS
+  std::vector<uint8_t> lossless = {0xff, 0xd8,
+                                   0xff, 0xc3, 0, 11, 16, 0, 20, 0, 30, 1, 1, 0x11, 0,
+                                   0xff, 0xda, 0, 8, 1, 1, 0, 1, 0, 0};
+  EXPECT_TRUE(CanParse(lossless));
+  EXPECT_EQ(TensorShape<>(20, 30, 1), GetInfo(lossless).shape);
+  auto src = ImageSource::FromHostMem(lossless.data(), lossless.size());
+  auto frame = GetJpegFrameInfo(&src);
+  EXPECT_EQ(16, frame.precision);
+  EXPECT_EQ(1, frame.num_components);
+  EXPECT_TRUE(frame.lossless());
+}
+
 class JpegParserOrientationTest : public ::testing::Test {
  public:
   JpegParserOrientationTest() : parser_() {}
@@ -25,41 +25,26 @@ namespace imgcodec {
 
 // https://www.w3.org/TR/2003/REC-PNG-20031110
 
-enum ColorType : uint8_t {
-  PNG_COLOR_TYPE_GRAY       = 0,
-  PNG_COLOR_TYPE_RGB        = 2,
-  PNG_COLOR_TYPE_PALETTE    = 3,
-  PNG_COLOR_TYPE_GRAY_ALPHA = 4,
-  PNG_COLOR_TYPE_RGBA       = 6
-};
-
-struct IhdrChunk {
-  uint32_t width;
-  uint32_t height;
-  uint8_t color_type;
-  // Some fields were ommited.
-
-  int GetNumberOfChannels(bool include_alpha) {
-    switch (color_type) {
-      case PNG_COLOR_TYPE_GRAY:
-        return 1;
-      case PNG_COLOR_TYPE_GRAY_ALPHA:
-        return 1 + include_alpha;
-      case PNG_COLOR_TYPE_RGB:
-      case PNG_COLOR_TYPE_PALETTE:  // 1 byte but it's converted to 3-channel BGR by OpenCV
-        return 3;
-      case PNG_COLOR_TYPE_RGBA:
-        return 3 + include_alpha;
-      default:
-        DALI_FAIL(make_string("color type not supported: ", color_type));
-    }
-  }
-};
-
 using chunk_type_field_t = std::array<uint8_t, 4>;
 
+int PngStructure::NumberOfSamples() const {
+  switch (color_type) {
+    case PNG_COLOR_TYPE_GRAY:
+      return 1;
+    case PNG_COLOR_TYPE_GRAY_ALPHA:
+      return 2;
+    case PNG_COLOR_TYPE_RGB:
+    case PNG_COLOR_TYPE_PALETTE:  // 1 byte but it's converted to 3-channel BGR by OpenCV
+      return 3;
+    case PNG_COLOR_TYPE_RGBA:
+      return 4;
+    default:
+      DALI_FAIL(make_string("color type not supported: ", color_type));
+  }
+}
+
 // Expects the read pointer in the stream to point to the beginning of a chunk.
-static IhdrChunk ReadIhdrChunk(InputStream& stream) {
+static PngStructure ReadIhdrChunk(InputStream& stream) {
   // IHDR Chunk:
   //  IHDR chunk length(4 bytes): 0x00 0x00 0x00 0x0D
   //  IHDR chunk type(Identifies chunk type to be IHDR): 0x49 0x48 0x44 0x52
@@ -74,12 +59,14 @@ static IhdrChunk ReadIhdrChunk(InputStream& stream) {
   auto chunk_type = stream.ReadOne<chunk_type_field_t>();
   DALI_ENFORCE(chunk_type == tag("IHDR"));
 
-  IhdrChunk chunk;
+  PngStructure chunk;
   chunk.width = ReadValueBE<uint32_t>(stream);
   chunk.height = ReadValueBE<uint32_t>(stream);
-  stream.Skip(1);  // Skip the bit depth info.
+  chunk.bit_depth = ReadValueBE<uint8_t>(stream);
   chunk.color_type = ReadValueBE<uint8_t>(stream);
-  stream.Skip(3 + 4);  // Skip the other fields and the CRC checksum.
+  stream.Skip(2);  // Skip the compression and filter methods (there is only one of each).
+  chunk.interlace_method = ReadValueBE<uint8_t>(stream);
+  stream.Skip(4);  // Skip the CRC checksum.
 
   return chunk;
 }
@@ -132,7 +119,7 @@ ImageInfo PngParser::GetInfo(ImageSource *encoded) const {
   info.shape = {
     ihdr.height,
     ihdr.width,
-    ihdr.GetNumberOfChannels(true)
+    ihdr.NumberOfSamples()
   };
   if (exif_orientation_opt) {
     info.orientation = FromExifOrientation(*exif_orientation_opt);
@@ -141,6 +128,26 @@ ImageInfo PngParser::GetInfo(ImageSource *encoded) const {
   return info;
 }
 
+PngStructure ParsePngStructure(ImageSource *encoded) {
+  auto stream = encoded->Open();
+
+  stream->Skip(expected_signature.size());
+  auto png = ReadIhdrChunk(*stream);
+  while (true) {
+    uint32_t length = ReadValueBE<uint32_t>(*stream);
+    auto chunk_type = stream->ReadOne<chunk_type_field_t>();
+
+    if (chunk_type == tag("IDAT")) {
+      png.idat.emplace_back(stream->TellRead(), length);
+    } else if (chunk_type == tag("IEND")) {
+      break;
+    }
+    stream->Skip(length + 4);  // Skip chunk's data and the CRC checksum.
+  }
+  DALI_ENFORCE(!png.idat.empty(), "No image data in the PNG file.");
+  return png;
+}
+
 bool PngParser::CanParse(ImageSource *encoded) const {
   png_signature_t buffer;
   if (ReadHeader(buffer.data(), encoded, buffer.size()) != expected_signature.size()) {
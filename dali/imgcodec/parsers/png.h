@@ -15,11 +15,55 @@
 #ifndef DALI_IMGCODEC_PARSERS_PNG_H_
 #define DALI_IMGCODEC_PARSERS_PNG_H_
 
+#include <cstdint>
+#include <utility>
+#include <vector>
 #include "dali/imgcodec/image_format.h"
 
 namespace dali {
 namespace imgcodec {
 
+// https://www.w3.org/TR/2003/REC-PNG-20031110
+
+enum PngColorType : uint8_t {
+  PNG_COLOR_TYPE_GRAY       = 0,
+  PNG_COLOR_TYPE_RGB        = 2,
+  PNG_COLOR_TYPE_PALETTE    = 3,
+  PNG_COLOR_TYPE_GRAY_ALPHA = 4,
+  PNG_COLOR_TYPE_RGBA       = 6
+};
+
+/**
+ * @brief The header of a PNG image and the location of its compressed data
+ */
+struct PngStructure {
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint8_t bit_depth = 0;
+  uint8_t color_type = 0;
+  uint8_t interlace_method = 0;
+  /** @brief Offsets and lengths of the data of the consecutive IDAT chunks */
+  std::vector<std::pair<int64_t, uint32_t>> idat;
+
+  /** @brief The number of samples per pixel, including the alpha channel */
+  int NumberOfSamples() const;
+
+  /** @brief The total size of the compressed (zlib) data */
+  int64_t CompressedSize() const {
+    int64_t size = 0;
+    for (auto &chunk : idat)
+      size += chunk.second;
+    return size;
+  }
+};
+
+/**
+ * @brief Reads the header and finds the IDAT chunks of a PNG image.
+ *
+ * The compressed data is not read.
+ */
+DLL_PUBLIC PngStructure ParsePngStructure(ImageSource *encoded);
+
 class DLL_PUBLIC PngParser : public ImageParser {
  public:
   ImageInfo GetInfo(ImageSource *encoded) const override;
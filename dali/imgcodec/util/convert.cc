@@ -70,8 +70,10 @@ void Convert(SampleView<CPUBackend> out, TensorLayout out_layout, DALIImageType
 
   auto in_strides_no_channel = detail::RemoveDim(in_strides, in_channel_dim);
 
-  for (int d = 0; d < roi.begin.size(); d++) {
-    in_offset += in_strides_no_channel[d] * roi.begin[d];
+  // The ROI is in the output space, so it's mapped to the region of the input it's read from
+  auto in_roi = InputRoi(roi, orientation, detail::RemoveDim(in_shape, in_channel_dim));
+  for (int d = 0; d < in_roi.begin.size(); d++) {
+    in_offset += in_strides_no_channel[d] * in_roi.begin[d];
   }
 
   TYPE_SWITCH(out.type(), type2id, Out, (IMGCODEC_TYPES),
@@ -193,33 +193,92 @@ struct ConvertPixel<Out, In, DALI_GRAY, DALI_YCbCr> : ColorConversionBase<Out, 1
   }
 };
 
+/**
+ * @brief The orientation expressed as an (optional) swap of the spatial axes and flips of
+ *        the axes of the input image
+ */
+struct OrientationSwizzle {
+  bool swap_xy = false, flip_x = false, flip_y = false;
+
+  bool is_identity() const {
+    return !swap_xy && !flip_x && !flip_y;
+  }
+};
+
+inline OrientationSwizzle GetOrientationSwizzle(Orientation orientation) {
+  /* The rotation can be implemented as some combination of flips and axis swap. For example,
+   * to rotate an image by 180 degrees, we can flip it vertically and then flip it horizontally.
+   */
+  OrientationSwizzle swizzle;
+  if (orientation.rotate == 90) {
+    swizzle.swap_xy = true;
+    swizzle.flip_x = true;
+  } else if (orientation.rotate == 180) {
+    swizzle.flip_x = true;
+    swizzle.flip_y = true;
+  } else if (orientation.rotate == 270) {
+    swizzle.swap_xy = true;
+    swizzle.flip_y = true;
+  }
+  swizzle.flip_x ^= orientation.flip_x;
+  swizzle.flip_y ^= orientation.flip_y;
+  return swizzle;
+}
+
+namespace detail {
+
+inline ROI MapRoi(const ROI &roi, Orientation orientation, const TensorShape<> &in_shape,
+                  bool to_input) {
+  auto swizzle = GetOrientationSwizzle(orientation);
+  if (!roi || swizzle.is_identity())
+    return roi;
+  ROI mapped;
+  mapped.begin.resize(2);
+  mapped.end.resize(2);
+  for (int d = 0; d < 2; d++) {
+    int in_d = swizzle.swap_xy ? 1 - d : d;
+    bool flip = in_d == 0 ? swizzle.flip_y : swizzle.flip_x;
+    int64_t extent = in_shape[in_d];
+    int from = to_input ? d : in_d, to = to_input ? in_d : d;
+    int64_t begin = from < roi.begin.size() ? roi.begin[from] : 0;
+    int64_t end = from < roi.end.size() ? roi.end[from] : extent;
+    mapped.begin[to] = flip ? extent - end : begin;
+    mapped.end[to] = flip ? extent - begin : end;
+  }
+  return mapped;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Maps a spatial (HW) region of interest in the output space (after applying
+ *        the orientation) to the region of the input image it's read from.
+ *
+ * @param in_shape The shape of the input image; only the spatial extents (HW) are used
+ */
+inline ROI InputRoi(const ROI &roi, Orientation orientation, const TensorShape<> &in_shape) {
+  return detail::MapRoi(roi, orientation, in_shape, true);
+}
+
+/**
+ * @brief Maps a spatial (HW) region of the input image to the region of the output it's
+ *        written to, after applying the orientation. The inverse of InputRoi.
+ */
+inline ROI OutputRoi(const ROI &in_roi, Orientation orientation, const TensorShape<> &in_shape) {
+  return detail::MapRoi(in_roi, orientation, in_shape, false);
+}
+
 template <typename T>
 void ApplyOrientation(Orientation orientation, T *&data,
                       int64_t &x_stride, int64_t &x_size, int64_t &y_stride, int64_t &y_size) {
-  /* To adjust orientation, one has to rotate the image and do some flips.
-   *
-   * The rotation can be implemented as some combination of flips and axis swap. For example,
-   * to rotate an image by 180 degrees, we can flip it vertically and then flip it horizontally.
+  /* To adjust orientation, one has to rotate the image and do some flips, which is expressed
+   * as an axis swap and flips (see GetOrientationSwizzle).
    *
    * The axis swap is simple: we just swap the x and y strides and swap x and y sizes. To flip an
    * axis, we negate the appropriate stride (effectively causing the image to be read in opposite
    * direction) and move the data pointer to the end of the axis.
    */
-
-  bool swap_xy = false, flip_x = false, flip_y = false;
-
-  if (orientation.rotate == 90) {
-    swap_xy = true;
-    flip_x = true;
-  } else if (orientation.rotate == 180) {
-    flip_x = true;
-    flip_y = true;
-  } else if (orientation.rotate == 270) {
-    swap_xy = true;
-    flip_y = true;
-  }
-  flip_x ^= orientation.flip_x;
-  flip_y ^= orientation.flip_y;
+  auto [swap_xy, flip_x, flip_y] = GetOrientationSwizzle(orientation);
 
   if (swap_xy) {
     std::swap(x_stride, y_stride);
@@ -303,6 +362,8 @@ void Convert(Out *out, const int64_t *out_strides, int out_channel_dim, DALIImag
  * The function converts data type (normalizing) and color space.
  * When roi.begin or roi.end is empty, it is assumed to be the lower bound and upport bound
  * of the spatial extent. Channel dimension must not be included in ROI specification.
+ * The orientation is applied while writing the output, the ROI is in the output space
+ * (after applying the orientation).
  */
 void DLL_PUBLIC Convert(
     SampleView<CPUBackend> out, TensorLayout out_layout, DALIImageType out_format,
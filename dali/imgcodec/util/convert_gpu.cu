@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <vector>
 #include "dali/imgcodec/util/convert_gpu.h"
 #include "dali/imgcodec/util/convert.h"
@@ -31,11 +32,25 @@ namespace {
 
 constexpr int kDims = 3;
 
+/**
+ * @brief The normalization, mirroring and orientation applied while writing the output
+ */
+struct Postprocessing {
+  span<const float> mean, stddev;
+  bool mirror = false;
+  Orientation orientation = {};
+
+  bool normalize() const {
+    return !mean.empty() || !stddev.empty();
+  }
+};
+
 template<class Output, class Input>
 void LaunchSliceFlipNormalizePermutePad(
     Output *out, TensorLayout out_layout, TensorShape<kDims> out_shape,
     const Input *in, TensorLayout in_layout, TensorShape<kDims> in_shape,
-    kernels::KernelContext ctx, const ROI &roi, float multiplier) {
+    kernels::KernelContext ctx, const ROI &roi, float multiplier,
+    const Postprocessing &post = {}) {
   // this normalization only works if Output range is [-1, 1]
   static_assert(std::is_floating_point<Output>::value);
   if (std::is_integral<Input>::value)
@@ -45,20 +60,48 @@ void LaunchSliceFlipNormalizePermutePad(
   args_container.emplace_back(out_shape, in_shape);
   auto &args = args_container[0];
 
+  // The orientation is applied by reading the output coordinates from swapped and flipped
+  // input dimensions, so that it doesn't take another pass over the image
+  auto swizzle = GetOrientationSwizzle(post.orientation);
+  auto in_dim = [&](char dim_name) {
+    if (swizzle.swap_xy && (dim_name == 'H' || dim_name == 'W'))
+      dim_name = dim_name == 'H' ? 'W' : 'H';
+    return in_layout.find(dim_name);
+  };
+
   args.channel_dim = in_layout.find('C');
   for (int i = 0; i < kDims; i++) {
-    args.permuted_dims[i] = in_layout.find(out_layout[i]);
+    args.permuted_dims[i] = in_dim(out_layout[i]);
     args.shape[args.permuted_dims[i]] = out_shape[i];
   }
+  args.flip[in_layout.find('W')] = swizzle.flip_x;
+  args.flip[in_layout.find('H')] = swizzle.flip_y;
 
   if (roi) {
+    // The ROI is in the output space; a flipped dimension is read from its end
     for (int i = 0; i < roi.begin.sample_dim(); i++) {
-      args.anchor[args.permuted_dims[i]] = roi.begin[i];
+      int d = args.permuted_dims[i];
+      args.anchor[d] = args.flip[d] ? in_shape[d] - roi.begin[i] - out_shape[i] : roi.begin[i];
     }
   }
 
-  args.mean.push_back(0.0f);
-  args.inv_stddev.push_back(multiplier);
+  // the output is mirrored after applying the orientation
+  if (post.mirror)
+    args.flip[in_dim('W')] = !args.flip[in_dim('W')];
+
+  if (post.normalize()) {
+    // the values are normalized after scaling them to the output range
+    int n = std::max(post.mean.size(), post.stddev.size());
+    for (int c = 0; c < n; c++) {
+      float mean = post.mean.empty() ? 0.0f : post.mean[post.mean.size() == 1 ? 0 : c];
+      float stddev = post.stddev.empty() ? 1.0f : post.stddev[post.stddev.size() == 1 ? 0 : c];
+      args.mean.push_back(mean / multiplier);
+      args.inv_stddev.push_back(multiplier / stddev);
+    }
+  } else {
+    args.mean.push_back(0.0f);
+    args.inv_stddev.push_back(multiplier);
+  }
 
   kernels::SliceFlipNormalizePermutePadGpu<Output, Input, 3> kernel;
   TensorListView<StorageGPU, Output, kDims> tlv_out(out, {out_shape});
@@ -81,10 +124,33 @@ void LaunchConvertSatNorm(Output *out, const Input *in, size_t size, cudaStream_
   convert_sat_norm_kernel<<<num_blocks, block_size, 0, stream>>>(out, in, size);
 }
 
+/**
+ * @brief Writes the (float, possibly normalized) values to the output of any type
+ */
+template<class Output, class Input>
+void WriteOutput(SampleView<GPUBackend> out, TensorLayout out_layout,
+                 const Input *in, TensorLayout in_layout, TensorShape<kDims> in_shape,
+                 kernels::KernelContext ctx, const ROI &roi, float multiplier,
+                 const Postprocessing &post) {
+  if constexpr (std::is_floating_point<Output>::value) {
+    // no need for an intermediate buffer
+    LaunchSliceFlipNormalizePermutePad(out.mutable_data<Output>(), out_layout, out.shape(),
+                                       in, in_layout, in_shape, ctx, roi, multiplier, post);
+  } else {
+    DALI_ENFORCE(!post.normalize(), "Normalization requires a floating point output type.");
+    auto size = volume(out.shape());
+    auto buffer = ctx.scratchpad->Allocate<mm::memory_kind::device, float>(size);
+    LaunchSliceFlipNormalizePermutePad(buffer, out_layout, out.shape(), in, in_layout, in_shape,
+                                       ctx, roi, multiplier, post);
+    LaunchConvertSatNorm(out.mutable_data<Output>(), buffer, size, ctx.gpu.stream);
+  }
+}
+
 template<class Output, class Input>
 void ConvertImpl(SampleView<GPUBackend> out, TensorLayout out_layout, DALIImageType out_format,
                  ConstSampleView<GPUBackend> in, TensorLayout in_layout, DALIImageType in_format,
-                 cudaStream_t stream, const ROI &roi, float multiplier) {
+                 cudaStream_t stream, const ROI &roi, float multiplier,
+                 const Postprocessing &post = {}) {
   kernels::DynamicScratchpad scratchpad({}, AccessOrder(stream));
   kernels::KernelContext ctx;
   ctx.gpu.stream = stream;
@@ -96,31 +162,90 @@ void ConvertImpl(SampleView<GPUBackend> out, TensorLayout out_layout, DALIImageT
   DALI_ENFORCE(out_layout.is_permutation_of("HWC") && in_layout.is_permutation_of("HWC"),
                "Layouts must be a permutation of HWC layout");
 
-  // Starting with converting the layout, colorspace will be converted later
-  auto intermediate_shape = out.shape();
-  int channel_dim = out_layout.find('C');
-  intermediate_shape[channel_dim] = NumberOfChannels(in_format, intermediate_shape[channel_dim]);
+  if (out_format == in_format) {
+    WriteOutput<Output>(out, out_layout, in.data<Input>(), in_layout, in.shape(),
+                        ctx, roi, multiplier, post);
+    return;
+  }
 
-  auto size = volume(intermediate_shape);
-  auto buffer = scratchpad.Allocate<mm::memory_kind::device, float>(size);
-  LaunchSliceFlipNormalizePermutePad(
-    buffer, out_layout, intermediate_shape, in.data<Input>(), in_layout, in.shape(),
-    ctx, roi, multiplier);
+  int channel_dim = out_layout.find('C');
+  if (channel_dim == kDims - 1 && !post.normalize()) {
+    // Starting with converting the layout, colorspace will be converted later
+    auto intermediate_shape = out.shape();
+    intermediate_shape[channel_dim] = NumberOfChannels(in_format, intermediate_shape[channel_dim]);
 
-  if (out_format != in_format) {
-    DALI_ENFORCE(out_layout.find('C') == kDims - 1,
-                 "Only channel last layout is supported when running color space conversion");
+    auto size = volume(intermediate_shape);
+    auto buffer = scratchpad.Allocate<mm::memory_kind::device, float>(size);
+    LaunchSliceFlipNormalizePermutePad(
+      buffer, out_layout, intermediate_shape, in.data<Input>(), in_layout, in.shape(),
+      ctx, roi, multiplier, post);
 
     auto npixels = out.shape()[0] * out.shape()[1];
     kernels::color::RunColorSpaceConversionKernel(
       out.mutable_data<Output>(), buffer, out_format, in_format, npixels, stream);
-  } else {
-    LaunchConvertSatNorm(out.mutable_data<Output>(), buffer, size, stream);
+    return;
   }
+
+  // The color space is converted in interleaved buffers, which are then transposed and
+  // normalized while writing the output
+  auto out_shape = out.shape();
+  int h = out_shape[out_layout.find('H')], w = out_shape[out_layout.find('W')];
+  TensorShape<kDims> in_hwc_shape = {h, w, NumberOfChannels(in_format, out_shape[channel_dim])};
+  TensorShape<kDims> out_hwc_shape = {h, w, out_shape[channel_dim]};
+  ROI hwc_roi;
+  if (roi) {
+    DALI_ENFORCE(roi.begin.sample_dim() == kDims,
+                 "The ROI must include the channels when the output is not channel last");
+    hwc_roi.begin = {roi.begin[out_layout.find('H')], roi.begin[out_layout.find('W')], 0};
+  }
+
+  auto in_hwc = scratchpad.Allocate<mm::memory_kind::device, float>(volume(in_hwc_shape));
+  LaunchSliceFlipNormalizePermutePad(
+    in_hwc, "HWC", in_hwc_shape, in.data<Input>(), in_layout, in.shape(),
+    ctx, hwc_roi, multiplier, {{}, {}, post.mirror, post.orientation});
+
+  auto out_hwc = scratchpad.Allocate<mm::memory_kind::device, float>(volume(out_hwc_shape));
+  kernels::color::RunColorSpaceConversionKernel(
+    out_hwc, in_hwc, out_format, in_format, h * w, stream);
+
+  WriteOutput<Output>(out, out_layout, out_hwc, "HWC",
+                      out_hwc_shape, ctx, {}, 1.0f, {post.mean, post.stddev, false});
 }
 
 }  // namespace
 
+void Convert(SampleView<GPUBackend> out, const DecodeParams &opts,
+             ConstSampleView<GPUBackend> in, TensorLayout in_layout, DALIImageType in_format,
+             cudaStream_t stream, const ROI &roi, float multiplier, Orientation orientation) {
+  TensorLayout out_layout = opts.planar ? "CHW" : "HWC";
+  int channels = out.shape()[opts.planar ? 0 : kDims - 1];
+  for (auto *values : {&opts.mean, &opts.stddev}) {
+    DALI_ENFORCE(values->size() <= 1 || static_cast<int>(values->size()) == channels,
+                 make_string("Expected 1 or ", channels, " normalization values, got ",
+                             values->size(), "."));
+  }
+
+  ROI out_roi;
+  if (roi) {
+    // The ROI is in the output layout; the channels are not cropped
+    if (opts.planar) {
+      out_roi.begin = {0, roi.begin[0], roi.begin[1]};
+      out_roi.end = {channels, roi.end[0], roi.end[1]};
+    } else {
+      out_roi = roi;
+    }
+  }
+
+  Postprocessing post{make_cspan(opts.mean), make_cspan(opts.stddev), opts.mirror, orientation};
+  TYPE_SWITCH(out.type(), type2id, Output, (IMGCODEC_TYPES), (
+    TYPE_SWITCH(in.type(), type2id, Input, (IMGCODEC_TYPES), (
+      ConvertImpl<Output, Input>(out, out_layout, opts.format,
+                                 in, in_layout, in_format,
+                                 stream, out_roi, multiplier, post);
+    ), DALI_FAIL(make_string("Unsupported input type: ", in.type())));  // NOLINT
+  ), DALI_FAIL(make_string("Unsupported output type: ", out.type())));  // NOLINT
+}
+
 void Convert(SampleView<GPUBackend> out, TensorLayout out_layout, DALIImageType out_format,
              ConstSampleView<GPUBackend> in, TensorLayout in_layout, DALIImageType in_format,
              cudaStream_t stream, const ROI &roi, float multiplier) {
@@ -43,6 +43,24 @@ void DLL_PUBLIC Convert(
     ConstSampleView<GPUBackend> in, TensorLayout in_layout, DALIImageType in_format,
     cudaStream_t stream, const ROI &roi = {}, float multiplier = 1.0f);
 
+/**
+ * @brief Converts an image stored in `in` and stores it in `out`, as described by `opts`.
+ *
+ * The output layout (interleaved or planar), the data type, the color space, as well as
+ * the normalization and mirroring are taken from `opts` and applied while writing the output,
+ * so that the image is not read and written again by a separate operator.
+ * @param roi Spatial (without the channels), the anchor of the output in the input.
+ * Must match the spatial extents of `out`. It's in the output space, i.e. after applying
+ * the orientation.
+ * @param orientation Applied while writing the output (before mirroring), by swapping and
+ * flipping the dimensions the output is read from; `out` must have the oriented shape.
+ */
+void DLL_PUBLIC Convert(
+    SampleView<GPUBackend> out, const DecodeParams &opts,
+    ConstSampleView<GPUBackend> in, TensorLayout in_layout, DALIImageType in_format,
+    cudaStream_t stream, const ROI &roi = {}, float multiplier = 1.0f,
+    Orientation orientation = {});
+
 }  // namespace imgcodec
 }  // namespace dali
 
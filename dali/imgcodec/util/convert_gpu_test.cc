@@ -298,6 +298,190 @@ TYPED_TEST(ConvertGPUTest, RGBToGray) {
   this->CheckConvert("HWC", DALI_GRAY, "HWC", DALI_RGB);
 }
 
+class ConvertGPUPostprocessingTest : public ::testing::Test {
+ public:
+  void SetReference(const TensorTestData &data) {
+    init_test_tensor_list(reference_list_, data);
+    output_list_.reshape({{reference_list_.cpu()[0].shape}});
+  }
+
+  void SetInput(const TensorTestData &data) {
+    init_test_tensor_list(input_list_, data);
+  }
+
+  void CheckConvert(const DecodeParams &opts, DALIImageType in_format,
+                    const ROI &roi = {}, Orientation orientation = {}) {
+    int device_id;
+    CUDA_CALL(cudaGetDevice(&device_id));
+    auto out = get_gpu_sample_view(output_list_);
+    auto in = get_gpu_sample_view(input_list_);
+    auto stream = CUDAStreamPool::instance().Get(device_id);
+    Convert(out, opts, in, "HWC", in_format, stream, roi, 1.0f, orientation);
+    CUDA_CALL(cudaStreamSynchronize(stream));
+    Check(output_list_.cpu()[0], reference_list_.cpu()[0], EqualConvertNorm(eps_));
+  }
+
+ private:
+  kernels::TestTensorList<uint8_t> input_list_;
+  kernels::TestTensorList<float> output_list_;
+  kernels::TestTensorList<float> reference_list_;
+  const float eps_ = 0.01f;
+};
+
+TEST_F(ConvertGPUPostprocessingTest, NormalizePlanar) {
+  this->SetInput({
+    {
+      {0.0f, 0.2f, 0.4f},
+      {0.6f, 0.8f, 1.0f},
+    },
+  });
+
+  this->SetReference({
+    {
+      {-2.0f, 0.4f},
+    },
+    {
+      {-1.2f, 0.0f},
+    },
+    {
+      {0.0f, 1.2f},
+    },
+  });
+
+  DecodeParams opts;
+  opts.dtype = DALI_FLOAT;
+  opts.planar = true;
+  opts.mean = {0.5f, 0.8f, 0.4f};
+  opts.stddev = {0.25f, 0.5f, 0.5f};
+  this->CheckConvert(opts, DALI_RGB);
+}
+
+TEST_F(ConvertGPUPostprocessingTest, Mirror) {
+  this->SetInput({
+    {
+      {0.0f, 0.2f, 0.4f},
+      {0.6f, 0.8f, 1.0f},
+    },
+  });
+
+  this->SetReference({
+    {
+      {0.6f, 0.8f, 1.0f},
+      {0.0f, 0.2f, 0.4f},
+    },
+  });
+
+  DecodeParams opts;
+  opts.dtype = DALI_FLOAT;
+  opts.mirror = true;
+  this->CheckConvert(opts, DALI_RGB);
+}
+
+TEST_F(ConvertGPUPostprocessingTest, GrayNormalizeMirror) {
+  this->SetInput({
+    {
+      {0.1f, 0.2f, 0.3f},
+      {0.2f, 0.2f, 0.2f},
+    },
+  });
+
+  this->SetReference({
+    {
+      {0.0f, -0.038f},
+    },
+  });
+
+  DecodeParams opts;
+  opts.dtype = DALI_FLOAT;
+  opts.format = DALI_GRAY;
+  opts.planar = true;
+  opts.mirror = true;
+  opts.mean = {0.2f};
+  opts.stddev = {0.5f};
+  this->CheckConvert(opts, DALI_RGB);
+}
+
+TEST_F(ConvertGPUPostprocessingTest, Rotate) {
+  this->SetInput({
+    {
+      {0.1f}, {0.2f}, {0.3f},
+    },
+    {
+      {0.4f}, {0.5f}, {0.6f},
+    },
+  });
+
+  this->SetReference({
+    {
+      {0.3f}, {0.6f},
+    },
+    {
+      {0.2f}, {0.5f},
+    },
+    {
+      {0.1f}, {0.4f},
+    },
+  });
+
+  DecodeParams opts;
+  opts.dtype = DALI_FLOAT;
+  opts.format = DALI_GRAY;
+  this->CheckConvert(opts, DALI_GRAY, {}, {90, false, false});
+}
+
+TEST_F(ConvertGPUPostprocessingTest, RotateRoiMirror) {
+  this->SetInput({
+    {
+      {0.1f}, {0.2f}, {0.3f},
+    },
+    {
+      {0.4f}, {0.5f}, {0.6f},
+    },
+  });
+
+  // the ROI is taken from the rotated image, which is then mirrored
+  this->SetReference({
+    {
+      {0.5f}, {0.2f},
+    },
+    {
+      {0.4f}, {0.1f},
+    },
+  });
+
+  DecodeParams opts;
+  opts.dtype = DALI_FLOAT;
+  opts.format = DALI_GRAY;
+  opts.mirror = true;
+  this->CheckConvert(opts, DALI_GRAY, {{1, 0}, {3, 2}}, {90, false, false});
+}
+
+TEST_F(ConvertGPUPostprocessingTest, RotateFlipColorConversionPlanar) {
+  this->SetInput({
+    {
+      {0.1f, 0.1f, 0.1f}, {0.2f, 0.2f, 0.2f}, {0.3f, 0.3f, 0.3f},
+    },
+    {
+      {0.4f, 0.4f, 0.4f}, {0.5f, 0.5f, 0.5f}, {0.6f, 0.6f, 0.6f},
+    },
+  });
+
+  // rotated by 270 degrees after flipping vertically - a transposition
+  this->SetReference({
+    {
+      {0.1f, 0.4f},
+      {0.2f, 0.5f},
+      {0.3f, 0.6f},
+    },
+  });
+
+  DecodeParams opts;
+  opts.dtype = DALI_FLOAT;
+  opts.format = DALI_GRAY;
+  opts.planar = true;
+  this->CheckConvert(opts, DALI_RGB, {}, {270, false, true});
+}
+
 }  // namespace test
 }  // namespace imgcodec
 }  // namespace dali
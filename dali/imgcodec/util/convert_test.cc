@@ -300,21 +300,32 @@ TEST_F(ConvertLayoutTest, RoiCHW) {
 
 class ConvertOrientationTest : public NumpyDecoderTestBase<CPUBackend, uint8_t> {
  public:
-  void Test(const std::string& orientation_name, Orientation orientation) {
+  void Test(const std::string& orientation_name, Orientation orientation,
+            const ROI &roi = {}) {
     auto input_path = orientation_dir + orientation_img + "_" + orientation_name + ".npy";
     auto ref_path = orientation_dir + orientation_img + "_horizontal.npy";
-    auto c = this->RunConvert(input_path, orientation);
-    AssertEqualSatNorm(c, this->ReadReferenceFrom(ref_path));
+    auto c = this->RunConvert(input_path, orientation, roi);
+    auto ref = this->ReadReferenceFrom(ref_path);
+    if (roi) {
+      ref.SetLayout("HWC");
+      ref = Crop(ref, roi);
+    }
+    AssertEqualSatNorm(c, ref);
   }
 
  protected:
-  Tensor<CPUBackend> RunConvert(const std::string& input_path, Orientation orientation) {
+  Tensor<CPUBackend> RunConvert(const std::string& input_path, Orientation orientation,
+                                const ROI &roi) {
     auto input = this->ReadReferenceFrom(input_path);
     ConstSampleView<CPUBackend> input_view(input.raw_mutable_data(), input.shape(), input.type());
 
     TensorShape<> output_shape = input.shape();
     if (orientation.rotate == 90 || orientation.rotate == 270)
       std::swap(output_shape[0], output_shape[1]);
+    if (roi) {
+      output_shape[0] = roi.shape()[0];
+      output_shape[1] = roi.shape()[1];
+    }
 
     Tensor<CPUBackend> output;
     output.Resize(output_shape, input.type());
@@ -322,7 +333,7 @@ class ConvertOrientationTest : public NumpyDecoderTestBase<CPUBackend, uint8_t>
 
     Convert(output_view, TensorLayout("HWC"), DALI_RGB,
             input_view, TensorLayout("HWC"), DALI_RGB,
-            {}, orientation);
+            roi, orientation);
 
     return output;
   }
@@ -369,6 +380,21 @@ TEST_F(ConvertOrientationTest, Rotate270) {
   Test("rotate_270", FromExifOrientation(ExifOrientation::ROTATE_270_CW));
 }
 
+TEST_F(ConvertOrientationTest, RoiRotate90) {
+  Test("rotate_90", FromExifOrientation(ExifOrientation::ROTATE_90_CW), {{20, 30}, {120, 90}});
+}
+
+TEST_F(ConvertOrientationTest, RoiMirrorHorizontalRotate270) {
+  Test("mirror_horizontal_rotate_270",
+       FromExifOrientation(ExifOrientation::MIRROR_HORIZONTAL_ROTATE_270_CW),
+       {{20, 30}, {120, 90}});
+}
+
+TEST_F(ConvertOrientationTest, RoiMirrorVertical) {
+  Test("mirror_vertical", FromExifOrientation(ExifOrientation::MIRROR_VERTICAL),
+       {{20, 30}, {120, 90}});
+}
+
 }  // namespace test
 }  // namespace imgcodec
 }  // namespace dali
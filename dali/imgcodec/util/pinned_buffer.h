@@ -0,0 +1,46 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_IMGCODEC_UTIL_PINNED_BUFFER_H_
+#define DALI_IMGCODEC_UTIL_PINNED_BUFFER_H_
+
+#include <algorithm>
+#include "dali/core/mm/memory.h"
+
+namespace dali {
+namespace imgcodec {
+
+/**
+ * @brief A growing buffer in the pinned host memory, for staging the data copied to the GPU
+ *
+ * The contents are not preserved when the buffer grows.
+ */
+template <typename T>
+struct PinnedBuffer {
+  T *Resize(size_t size) {
+    if (capacity < size) {
+      capacity = std::max(size, 2 * capacity);
+      data = mm::alloc_raw_unique<T, mm::memory_kind::pinned>(capacity);
+    }
+    return data.get();
+  }
+
+  mm::uptr<T> data;
+  size_t capacity = 0;
+};
+
+}  // namespace imgcodec
+}  // namespace dali
+
+#endif  // DALI_IMGCODEC_UTIL_PINNED_BUFFER_H_
@@ -12,54 +12,64 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <vector>
+#include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 #include "dali/kernels/audio/mel_scale/mel_filter_bank_gpu.h"
+#include "dali/core/dev_buffer.h"
+#include "dali/core/math_util.h"
 #include "dali/core/tensor_shape_print.h"
+#include "dali/kernels/signal/decibel/decibel_calculator.h"
 
 namespace dali {
 namespace kernels {
 namespace audio {
 
 const int kBlockDim2 = 32;
-const int kBlockDim1 = 1024;
+const int kBlockDim1 = 256;
+// Shared memory used to stage the input windows of the frequency-minor layout
+const int kMaxStagingBytes = 32 << 10;
 
 template <typename T>
 struct BlockDesc {
   const T *in_frame;
   T *out_frame;
-  union {
-    struct {  // outer-dim fft
-      int64_t start_window;
-      int64_t frame_nwindows;
-    };
-    struct {  // inner-dim fft
-      int64_t block_start;
-      int64_t out_frame_size;
-    };
-  };
+  int64_t start_window;
+  int64_t frame_nwindows;
 };
 
 template <typename T>
-__device__ T calcMel(const T* in_frame, int mel_bin,
-                     const T *weights_down, const int *interval_ends,
-                     int fft_stride, int fft_shift,
-                     T norm_factor) {
-  T out = 0;
-  int fftbin = interval_ends[mel_bin];
-  int fftbin_end = interval_ends[mel_bin + 1];
-  const T *in =  in_frame + fftbin * fft_stride + fft_shift;
-  for (; fftbin < fftbin_end; ++fftbin, in += fft_stride) {
-    auto weight_up = T(1) - weights_down[fftbin];
-    weight_up *= norm_factor;
-    out += *in * weight_up;
+struct NoPostprocess {
+  DALI_HOST_DEV DALI_FORCEINLINE T operator()(T x) const {
+    return x;
   }
-  fftbin_end = interval_ends[mel_bin + 2];
-  in =  in_frame + fftbin * fft_stride + fft_shift;
+};
+
+/**
+ * @brief The filter bank as a banded matrix
+ *
+ * Row `mel_bin` has non-zero weights for the FFT bins
+ * `[interval_ends[mel_bin], interval_ends[mel_bin + 2])`, stored contiguously in `weights`,
+ * starting at `offsets[mel_bin]`. The weights include the normalization factors.
+ */
+template <typename T>
+struct FilterBankBands {
+  const int *interval_ends;
+  const int *offsets;
+  const T *weights;
+};
+
+template <typename T>
+__device__ T calcMel(const T* in_frame, int mel_bin, const FilterBankBands<T> &bands,
+                     int fft_stride) {
+  T out = 0;
+  int fftbin = bands.interval_ends[mel_bin];
+  int fftbin_end = bands.interval_ends[mel_bin + 2];
+  const T *weights = bands.weights + bands.offsets[mel_bin] - fftbin;
+  const T *in = in_frame + fftbin * fft_stride;
   for (; fftbin < fftbin_end; ++fftbin, in += fft_stride) {
-    auto weight_down = weights_down[fftbin];
-    weight_down *= norm_factor;
-    out += *in * weight_down;
+    out += *in * weights[fftbin];
   }
   return out;
 }
@@ -67,11 +77,9 @@ __device__ T calcMel(const T* in_frame, int mel_bin,
 // For layouts where the frequency is not the innermost dimension, data is flattened into
 // 3 dimensions - frame, frequency, time
 // Every frame is treated as independent two-dimensional sample
-template <typename T>
-__global__ void MelFilterBankKernel(const BlockDesc<T> *block_desc,
-                                    const T *weights_down, const int *interval_ends,
-                                    bool normalize, const T *norm_factors,
-                                    int mel_bins) {
+template <typename T, typename Postprocess>
+__global__ void MelFilterBankKernel(const BlockDesc<T> *block_desc, FilterBankBands<T> bands,
+                                    int mel_bins, Postprocess postprocess) {
   auto block_id = blockIdx.x;
   const T *in_frame = block_desc[block_id].in_frame;
   T *out_frame = block_desc[block_id].out_frame;
@@ -87,32 +95,37 @@ __global__ void MelFilterBankKernel(const BlockDesc<T> *block_desc,
     return;
 
   T *out = out_frame + mel_bin * nwindows + window;
-  T norm_factor = (normalize) ? norm_factors[mel_bin] : 1;
-  *out = calcMel(in_frame, mel_bin,
-                 weights_down, interval_ends,
-                 nwindows, window, norm_factor);
+  *out = postprocess(calcMel(in_frame + window, mel_bin, bands, nwindows));
 }
 
 // For layouts with the innermost frequency dimension, data is flattened
-// to two dimensions - time, frequency
-template <typename T>
+// to two dimensions - time, frequency.
+// Each block processes a tile of `tile_windows` windows. If `staged`, the windows are first
+// copied to shared memory, since every window is read by all the filters.
+template <typename T, typename Postprocess>
 __global__ void MelFilterBankKernelInnerFft(const BlockDesc<T> *block_desc,
-                                            const T *weights_down, const int *interval_ends,
-                                            bool normalize, const T *norm_factors,
-                                            int mel_bins, int64_t fftdim) {
-  auto block_id = blockIdx.x;
-  auto idx = block_desc[block_id].block_start + threadIdx.x;
+                                            FilterBankBands<T> bands, int mel_bins,
+                                            int64_t fftdim, int tile_windows, bool staged,
+                                            Postprocess postprocess) {
+  extern __shared__ char shm[];
+  const auto &desc = block_desc[blockIdx.x];
+  int nwindows = cuda_min<int64_t>(tile_windows, desc.frame_nwindows - desc.start_window);
+  const T *in = desc.in_frame + desc.start_window * fftdim;
+  T *out = desc.out_frame + desc.start_window * mel_bins;
 
-  if (idx >= block_desc[block_id].out_frame_size)
-    return;
+  if (staged) {
+    T *tile = reinterpret_cast<T *>(shm);
+    for (int64_t i = threadIdx.x; i < nwindows * fftdim; i += blockDim.x)
+      tile[i] = in[i];
+    __syncthreads();
+    in = tile;
+  }
 
-  auto window = idx / mel_bins;
-  auto mel_bin = idx % mel_bins;
-  const T *in = block_desc[block_id].in_frame;
-  T *out =  block_desc[block_id].out_frame;
-  T norm_factor = (normalize) ? norm_factors[mel_bin] : 1;
-  *(out + idx) = calcMel(in + window * fftdim, mel_bin,
-                         weights_down, interval_ends, 1, 0, norm_factor);
+  for (int idx = threadIdx.x; idx < nwindows * mel_bins; idx += blockDim.x) {
+    int window = idx / mel_bins;
+    int mel_bin = idx % mel_bins;
+    out[idx] = postprocess(calcMel(in + window * fftdim, mel_bin, bands, 1));
+  }
 }
 
 template <typename T>
@@ -121,7 +134,8 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
   template <typename MelScale>
   Impl(MelScale mel_scale, const MelFilterBankArgs &args) :
       MelFilterImplBase<T>(mel_scale, args),
-      interval_ends_(args.nfilter + 2) {
+      interval_ends_(args.nfilter + 2),
+      offsets_(args.nfilter) {
     double mel = mel_low_ + mel_delta_;
     interval_ends_[0] = fftbin_start_;
     interval_ends_[args.nfilter + 1] = fftbin_end_ + 1;
@@ -129,14 +143,27 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
       double freq = mel_scale.mel_to_hz(mel);
       interval_ends_[interval] = std::ceil(freq / hz_step_);
     }
-  }
 
-  void Setup(ScratchpadEstimator &se, const TensorListShape<> &in_shape) {
-    se.add<mm::memory_kind::device, int>(interval_ends_.size());
-    se.add<mm::memory_kind::device, T>(weights_down_.size());
-    if (args_.normalize)
-      se.add<mm::memory_kind::device, T>(norm_factors_.size());
+    // Each filter rises over one interval and falls over the next one
+    for (int mel_bin = 0; mel_bin < args_.nfilter; mel_bin++) {
+      offsets_[mel_bin] = weights_.size();
+      T norm_factor = args_.normalize ? norm_factors_[mel_bin] : T(1);
+      int fftbin = interval_ends_[mel_bin];
+      for (; fftbin < interval_ends_[mel_bin + 1]; fftbin++) {
+        auto weight_up = T(1) - weights_down_[fftbin];
+        weight_up *= norm_factor;
+        weights_.push_back(weight_up);
+      }
+      for (; fftbin < interval_ends_[mel_bin + 2]; fftbin++) {
+        auto weight_down = weights_down_[fftbin];
+        weight_down *= norm_factor;
+        weights_.push_back(weight_down);
+      }
+    }
+  }
 
+  void Setup(ScratchpadEstimator &se, const TensorListShape<> &in_shape, int axis) {
+    args_.axis = axis;
     inner_fft_ = true;
     for (int s = 0; s < in_shape.size(); s++) {
       inner_fft_ &= volume(in_shape.tensor_shape_span(s).begin() + args_.axis + 1,
@@ -150,30 +177,30 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
     }
   }
 
+  /**
+   * @brief Computes the mel spectrogram, applying `postprocess` to each output value
+   *        before it's stored
+   */
+  template <typename Postprocess>
   void Compute(const T* const* in_list, T **out_list, int ndim,
-               Scratchpad *scratchpad, cudaStream_t stream) {
+               Scratchpad *scratchpad, cudaStream_t stream, Postprocess postprocess) {
     if (inner_fft_) {
       FillBlockDescsInnerFft(in_list, out_list);
     } else {
       FillBlockDescsOuterFft(in_list, out_list);
     }
-    BlockDesc<T> *block_descs = nullptr;
-    int *interval_ends = nullptr;
-    T *weights_down = nullptr, *norm_factors = nullptr;
-    std::tie(block_descs, interval_ends, weights_down, norm_factors) =
-          scratchpad->ToContiguousGPU(stream, block_descs_, interval_ends_,
-                                      weights_down_, norm_factors_);
+    auto *block_descs = scratchpad->ToGPU(stream, block_descs_);
+    auto bands = GetBands(stream);
     if (inner_fft_) {
       MelFilterBankKernelInnerFft
-          <<<block_descs_.size(), kBlockDim1, 0, stream>>>
-            (block_descs, weights_down, interval_ends, args_.normalize,
-             norm_factors, args_.nfilter, fft_dim_);
+          <<<block_descs_.size(), kBlockDim1, staging_bytes_, stream>>>
+            (block_descs, bands, args_.nfilter, fft_dim_, tile_windows_, staging_bytes_ > 0,
+             postprocess);
     } else {
       dim3 block(kBlockDim2, std::min(args_.nfilter, kBlockDim2));
       dim3 grid(block_descs_.size(), div_ceil(args_.nfilter, kBlockDim2));
       MelFilterBankKernel
-        <<<grid, block, 0, stream>>>(block_descs, weights_down, interval_ends,
-                                     args_.normalize, norm_factors, args_.nfilter);
+        <<<grid, block, 0, stream>>>(block_descs, bands, args_.nfilter, postprocess);
     }
     CUDA_CALL(cudaGetLastError());
   }
@@ -181,6 +208,20 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
   using MelFilterImplBase<T>::Args;
 
  private:
+  /**
+   * @brief Returns the filter bank in device memory, uploading it on first use
+   */
+  FilterBankBands<T> GetBands(cudaStream_t stream) {
+    if (weights_gpu_.empty()) {
+      std::vector<int> indices = interval_ends_;
+      indices.insert(indices.end(), offsets_.begin(), offsets_.end());
+      indices_gpu_.from_host(indices, stream);
+      weights_gpu_.from_host(weights_, stream);
+    }
+    return { indices_gpu_.data(), indices_gpu_.data() + interval_ends_.size(),
+             weights_gpu_.data() };
+  }
+
   void SetupBlockDescsOuterFft(ScratchpadEstimator &se, const TensorListShape<> &in_shape) {
     nframes_.clear();
     nwindows_.clear();
@@ -193,8 +234,8 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
       for (int64_t s = 0; s < nframes_.back(); ++s) {
         auto nblocks = div_ceil(nwindows_.back(), kBlockDim2);
         for (int64_t b = 0; b < nblocks; ++b) {
-          block_descs_.push_back(BlockDesc<T>{nullptr, nullptr,
-                                              {b * kBlockDim2, nwindows_.back()}});
+          block_descs_.push_back(BlockDesc<T>{nullptr, nullptr, b * kBlockDim2,
+                                              nwindows_.back()});
         }
       }
     }
@@ -205,13 +246,20 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
     nframes_.clear();
     nwindows_.clear();
     block_descs_.clear();
+    // A tile should give each thread about one output, as long as its windows fit
+    // in the shared memory. Very long windows are read directly from the global memory.
+    int64_t window_bytes = fft_dim_ * sizeof(T);
+    int max_tile = std::max<int64_t>(kMaxStagingBytes / window_bytes, 1);
+    tile_windows_ = clamp(div_ceil(kBlockDim1, args_.nfilter), 1, max_tile);
+    staging_bytes_ = tile_windows_ * window_bytes <= kMaxStagingBytes
+                   ? tile_windows_ * window_bytes : 0;
     auto batch_size = in_shape.num_samples();
     for (int64_t ti = 0; ti < batch_size; ++ti) {
       const auto &tshape = in_shape.tensor_shape(ti);
-      auto sample_size = volume(tshape.begin(), tshape.begin() + args_.axis) * args_.nfilter;
-      auto nblocks = div_ceil(sample_size, kBlockDim1);
-      for (int b = 0; b < nblocks; ++b) {
-        block_descs_.push_back(BlockDesc<T>{nullptr, nullptr, {b * kBlockDim1, sample_size}});
+      int64_t nwindows = volume(tshape.begin(), tshape.begin() + args_.axis);
+      nwindows_.push_back(nwindows);
+      for (int64_t w = 0; w < nwindows; w += tile_windows_) {
+        block_descs_.push_back(BlockDesc<T>{nullptr, nullptr, w, nwindows});
       }
     }
     se.add<mm::memory_kind::device, BlockDesc<T>>(block_descs_.size());
@@ -236,28 +284,41 @@ class MelFilterBankGpu<T>::Impl : public MelFilterImplBase<T> {
   }
 
   void FillBlockDescsInnerFft(const T* const* in_list, T **out_list) {
-    int block_id = 0;
-    int sample = 0;
-    while (block_id < static_cast<int>(block_descs_.size())) {
-      auto sample_size = block_descs_[block_id].out_frame_size;
-      auto nblocks = div_ceil(sample_size, kBlockDim1);
-      for (int i = 0; i < nblocks; ++i, ++block_id) {
-        block_descs_[block_id].in_frame = in_list[sample];
-        block_descs_[block_id].out_frame = out_list[sample];
+    int64_t block_id = 0;
+    for (uint64_t ti = 0; ti < nwindows_.size(); ++ti) {
+      auto nblocks = div_ceil(nwindows_[ti], tile_windows_);
+      for (int64_t b = 0; b < nblocks; ++b, ++block_id) {
+        block_descs_[block_id].in_frame = in_list[ti];
+        block_descs_[block_id].out_frame = out_list[ti];
       }
-      ++sample;
     }
   }
 
   std::vector<int> interval_ends_;
+  std::vector<int> offsets_;
+  std::vector<T> weights_;
+  DeviceBuffer<int> indices_gpu_;
+  DeviceBuffer<T> weights_gpu_;
   std::vector<int64_t> nframes_;
   std::vector<int64_t> nwindows_;
   std::vector<BlockDesc<T>> block_descs_;
   int64_t fft_dim_ = 0;
+  int tile_windows_ = 1;
+  int staging_bytes_ = 0;
   bool inner_fft_ = false;
   USE_MEL_FILTER_IMPL_MEMBERS(T);
 };
 
+/**
+ * @brief Tells whether two sets of arguments describe the same filter bank
+ *
+ * The axis is not a property of the filter bank, only of the layout of the data.
+ */
+inline bool SameFilterBank(MelFilterBankArgs a, const MelFilterBankArgs &b) {
+  a.axis = b.axis;
+  return a == b;
+}
+
 template <typename T>
 KernelRequirements MelFilterBankGpu<T>::Setup(KernelContext &context,
                                               const InListGPU<T> &in,
@@ -279,19 +340,32 @@ KernelRequirements MelFilterBankGpu<T>::Setup(KernelContext &context,
   ScratchpadEstimator se;
   args.nfft = args.nfft > 0 ? args.nfft : 2 * (in.shape[0][args.axis] - 1);
   args.freq_high = args.freq_high > 0 ? args.freq_high : args.sample_rate / 2;
-  if (!impl_ || impl_->Args() != args) {
-    impl_.reset();
+
+  // The most recently used filter bank is kept at the back
+  auto it = std::find_if(filter_banks_.begin(), filter_banks_.end(),
+                         [&](const std::unique_ptr<Impl> &fb) {
+                           return SameFilterBank(fb->Args(), args);
+                         });
+  if (it != filter_banks_.end()) {
+    std::rotate(it, it + 1, filter_banks_.end());
+  } else {
+    if (static_cast<int>(filter_banks_.size()) >= kMaxCachedFilterBanks) {
+      // The evicted filter bank may still be in use by a previous run
+      CUDA_CALL(cudaStreamSynchronize(context.gpu.stream));
+      filter_banks_.erase(filter_banks_.begin());
+    }
     switch (args.mel_formula) {
       case MelScaleFormula::HTK:
-        impl_ = std::make_unique<Impl>(HtkMelScale<T>(), args);
+        filter_banks_.push_back(std::make_unique<Impl>(HtkMelScale<T>(), args));
         break;
       case MelScaleFormula::Slaney:
       default:
-        impl_ = std::make_unique<Impl>(SlaneyMelScale<T>(), args);
+        filter_banks_.push_back(std::make_unique<Impl>(SlaneyMelScale<T>(), args));
         break;
     }
   }
-  impl_->Setup(se, in.shape);
+  impl_ = filter_banks_.back().get();
+  impl_->Setup(se, in.shape, args.axis);
   req.scratch_sizes = se.sizes;
   return req;
 }
@@ -300,7 +374,18 @@ template <typename T>
 void MelFilterBankGpu<T>::Run(KernelContext &context, OutListGPU<T> &out, const InListGPU<T> &in) {
   assert(impl_ != nullptr);
   impl_->Compute(in.data.data(), out.data.data(), in.sample_dim(), context.scratchpad,
-                 context.gpu.stream);
+                 context.gpu.stream, NoPostprocess<T>());
+}
+
+template <typename T>
+void MelFilterBankGpu<T>::Run(KernelContext &context, OutListGPU<T> &out, const InListGPU<T> &in,
+                              const signal::ToDecibelsArgs<T> &db_args) {
+  assert(impl_ != nullptr);
+  DALI_ENFORCE(!db_args.ref_max,
+      "Converting to decibels relative to the maximum is not supported by the fused kernel");
+  signal::MagnitudeToDecibel<T> dB(db_args.multiplier, db_args.s_ref, db_args.min_ratio);
+  impl_->Compute(in.data.data(), out.data.data(), in.sample_dim(), context.scratchpad,
+                 context.gpu.stream, dB);
 }
 
 template <typename T>
@@ -16,11 +16,13 @@
 #define DALI_KERNELS_AUDIO_MEL_SCALE_MEL_FILTER_BANK_GPU_H_
 
 #include <memory>
+#include <vector>
 #include "dali/core/common.h"
 #include "dali/core/host_dev.h"
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/audio/mel_scale/mel_filter_bank_args.h"
 #include "dali/kernels/audio/mel_scale/mel_scale.h"
+#include "dali/kernels/signal/decibel/to_decibels_args.h"
 
 namespace dali {
 namespace kernels {
@@ -42,9 +44,24 @@ class DLL_PUBLIC MelFilterBankGpu {
                       OutListGPU<T> &out,
                       const InListGPU<T> &in);
 
+  /**
+   * @brief Applies the filter bank and converts the result to decibels in the same pass,
+   *        so that the linear mel spectrogram is never stored.
+   *
+   * `db_args.ref_max` is not supported - the maximum is not known until the whole output
+   * is computed.
+   */
+  DLL_PUBLIC void Run(KernelContext &context,
+                      OutListGPU<T> &out,
+                      const InListGPU<T> &in,
+                      const signal::ToDecibelsArgs<T> &db_args);
+
  private:
   class Impl;
-  std::unique_ptr<Impl> impl_;
+  /// Filter banks for the recently used arguments, the most recently used one at the back
+  std::vector<std::unique_ptr<Impl>> filter_banks_;
+  Impl *impl_ = nullptr;
+  static constexpr int kMaxCachedFilterBanks = 8;
 };
 
 }  // namespace audio
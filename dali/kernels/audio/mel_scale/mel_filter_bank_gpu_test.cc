@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
 #include <random>
 #include <tuple>
 #include <vector>
@@ -174,6 +176,110 @@ INSTANTIATE_TEST_SUITE_P(MelScaleGpuTestpuTest, MelScaleGpuTest, testing::Combin
     testing::Values(5000.0f, 8000.0f),  // fmax
     testing::Values(0, 2, 3)));  // axis
 
+TEST(MelScaleGpuFusedTest, ToDecibels) {
+  using T = float;
+  using Kernel = kernels::audio::MelFilterBankGpu<T>;
+  signal::ToDecibelsArgs<T> db_args;
+  db_args.multiplier = 20;
+  db_args.s_ref = 0.5;
+  db_args.min_ratio = 1e-3;
+  std::mt19937 rng;
+  // frequency-major ("ft") and frequency-minor ("tf") layouts
+  for (int axis : {0, 1}) {
+    TensorListShape<> in_shape = axis == 0 ? TensorListShape<>{{257, 40}, {257, 13}}
+                                           : TensorListShape<>{{40, 257}, {13, 257}};
+    TestTensorList<float> in;
+    in.reshape(in_shape);
+    UniformRandomFill(in.cpu(), rng, 0.0, 1.0);
+
+    KernelContext ctx;
+    ctx.gpu.stream = 0;
+    kernels::audio::MelFilterBankArgs args;
+    args.nfilter = 64;
+    args.sample_rate = 16000;
+    args.axis = axis;
+    kernels::KernelManager kmgr;
+    kmgr.Resize<Kernel>(1);
+    auto in_view = in.gpu();
+    auto req = kmgr.Setup<Kernel>(0, ctx, in_view, args);
+    TestTensorList<float> plain, fused;
+    plain.reshape(req.output_shapes[0]);
+    fused.reshape(req.output_shapes[0]);
+    auto plain_view = plain.gpu();
+    auto fused_view = fused.gpu();
+    kmgr.Run<Kernel>(0, ctx, plain_view, in_view);
+    kmgr.Run<Kernel>(0, ctx, fused_view, in_view, db_args);
+    auto plain_cpu = plain.cpu();
+    auto fused_cpu = fused.cpu();
+    CUDA_CALL(cudaStreamSynchronize(0));
+    for (int s = 0; s < plain_cpu.num_samples(); s++) {
+      for (int64_t j = 0; j < volume(plain_cpu.tensor_shape(s)); j++) {
+        T ratio = std::max<T>(db_args.min_ratio, plain_cpu.tensor_data(s)[j] / db_args.s_ref);
+        ASSERT_NEAR(20 * std::log10(ratio), fused_cpu.tensor_data(s)[j], 1e-4)
+            << "Output data doesn't match in sample " << s << " (idx=" << j << ", axis="
+            << axis << ")";
+      }
+    }
+  }
+}
+
+TEST(MelScaleGpuCacheTest, AlternatingArgs) {
+  using T = float;
+  using Kernel = kernels::audio::MelFilterBankGpu<T>;
+  std::mt19937 rng;
+  // The windows of 8193 bins don't fit in the shared memory and are read from the global memory
+  for (int fftdim : {257, 8193}) {
+    TensorListShape<> in_shape = {{21, fftdim}, {7, fftdim}, {30, fftdim}};
+    int nfft = (fftdim - 1) * 2;
+    TestTensorList<float> in;
+    in.reshape(in_shape);
+    UniformRandomFill(in.cpu(), rng, 0.0, 1.0);
+    auto in_cpu = in.cpu();
+    auto in_view = in.gpu();
+
+    KernelContext ctx;
+    ctx.gpu.stream = 0;
+    kernels::KernelManager kmgr;
+    kmgr.Resize<Kernel>(1);
+    // Repeated setups with any of the arguments reuse the cached filter banks
+    for (int iter = 0; iter < 2; iter++) {
+      for (int nfilter : {40, 64, 300}) {
+        kernels::audio::MelFilterBankArgs args;
+        args.axis = 1;
+        args.nfft = nfft;
+        args.nfilter = nfilter;
+        args.sample_rate = 16000;
+        args.freq_low = 20;
+        args.freq_high = 7600;
+        args.mel_formula = MelScaleFormula::HTK;
+        args.normalize = false;
+        auto req = kmgr.Setup<Kernel>(0, ctx, in_view, args);
+        TestTensorList<float> out;
+        out.reshape(req.output_shapes[0]);
+        auto out_view = out.gpu();
+        kmgr.Run<Kernel>(0, ctx, out_view, in_view);
+        auto out_cpu = out.cpu();
+        CUDA_CALL(cudaStreamSynchronize(0));
+
+        auto fbanks = ReferenceFilterBanks(nfilter, nfft, args.sample_rate, args.freq_low,
+                                           args.freq_high);
+        for (int s = 0; s < in_shape.num_samples(); s++) {
+          for (int64_t t = 0; t < in_shape[s][0]; t++) {
+            for (int j = 0; j < nfilter; j++) {
+              float ref = 0;
+              for (int i = 0; i < fftdim; i++)
+                ref += fbanks[j][i] * in_cpu.tensor_data(s)[t * fftdim + i];
+              ASSERT_NEAR(ref, out_cpu.tensor_data(s)[t * nfilter + j], 1e-4 * std::max(1.f, ref))
+                  << "Output data doesn't match in sample " << s << " (window=" << t
+                  << ", mel_bin=" << j << ", nfilter=" << nfilter << ", fftdim=" << fftdim << ")";
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace audio
 }  // namespace kernels
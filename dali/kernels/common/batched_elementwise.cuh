@@ -0,0 +1,171 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_COMMON_BATCHED_ELEMENTWISE_CUH_
+#define DALI_KERNELS_COMMON_BATCHED_ELEMENTWISE_CUH_
+
+#include <cuda_runtime_api.h>
+#include <cstdint>
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_utils.h"
+#include "dali/core/util.h"
+#include "dali/kernels/common/batched_elementwise.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief The number of elements moved with a single 16-byte vector load or store
+ *        of the larger of the two types.
+ */
+template <typename OType, typename IType>
+constexpr int ElementwiseVectorSize() {
+  return 16 / (sizeof(OType) > sizeof(IType) ? sizeof(OType) : sizeof(IType));
+}
+
+static constexpr int kElementwiseBlockSize = 256;
+/// The number of vectors processed by each thread of a block
+static constexpr int kElementwiseVectorsPerThread = 4;
+
+template <typename OType, typename IType>
+constexpr int64_t ElementwiseTileSize() {
+  return int64_t(kElementwiseBlockSize) * kElementwiseVectorsPerThread *
+         ElementwiseVectorSize<OType, IType>();
+}
+
+namespace detail {
+
+template <typename T, int N>
+struct alignas(sizeof(T) * N) ElementwiseVec {
+  T v[N];
+};
+
+/// Returns the last sample in [lo, hi] which starts at or before the element `idx`
+__device__ __forceinline__ int FindElementwiseSample(const ElementwiseSampleDesc *samples,
+                                                     int lo, int hi, int64_t idx) {
+  while (lo < hi) {
+    int mid = (lo + hi + 1) >> 1;
+    if (samples[mid].offset <= idx)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+/// Processes the elements [start, end) of a single sample with the whole block
+template <typename OType, typename IType, typename Op>
+__device__ __forceinline__ void ElementwiseSegment(OType *out, const IType *in,
+                                                   int64_t start, int64_t end, const Op &op) {
+  constexpr int N = ElementwiseVectorSize<OType, IType>();
+  using OVec = ElementwiseVec<OType, N>;
+  using IVec = ElementwiseVec<IType, N>;
+  // the number of elements before the output is aligned to the vector size
+  int64_t head = (-static_cast<int64_t>(reinterpret_cast<uintptr_t>(out + start) / sizeof(OType)))
+               & (N - 1);
+  if (head > end - start)
+    head = end - start;
+  bool vectorize = N > 1 && end - start - head >= N &&
+      reinterpret_cast<uintptr_t>(in + start + head) % sizeof(IVec) == 0;
+  if (!vectorize) {
+    for (int64_t x = start + threadIdx.x; x < end; x += blockDim.x)
+      op(out[x], in[x]);
+    return;
+  }
+  int64_t vec_start = start + head;
+  int64_t nvec = (end - vec_start) / N;
+  int64_t vec_end = vec_start + nvec * N;
+  if (threadIdx.x < head)
+    op(out[start + threadIdx.x], in[start + threadIdx.x]);
+  auto *out_vec = reinterpret_cast<OVec *>(out + vec_start);
+  const auto *in_vec = reinterpret_cast<const IVec *>(in + vec_start);
+  for (int64_t v = threadIdx.x; v < nvec; v += blockDim.x) {
+    IVec i = in_vec[v];
+    OVec o;
+    #pragma unroll
+    for (int k = 0; k < N; k++)
+      op(o.v[k], i.v[k]);
+    out_vec[v] = o;
+  }
+  if (vec_end + threadIdx.x < end)
+    op(out[vec_end + threadIdx.x], in[vec_end + threadIdx.x]);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Applies `op(OType &out, IType in)` to all the elements of a batch.
+ *
+ * Each block processes a tile of ElementwiseTileSize elements of the flat element space
+ * of the batch and finds the samples overlapping it with a binary search, so the descriptors
+ * are per sample rather than per block and a block can process many small samples.
+ * When the samples in the tile are, on average, smaller than the block, each thread processes
+ * single elements, looking up their samples. Otherwise, the block processes the samples one by
+ * one, using 16-byte vector loads and stores where the alignment of the data allows it.
+ *
+ * @param samples  the non-empty samples, ordered by `offset`
+ * @param nsamples the number of samples; must be positive
+ */
+template <typename OType, typename IType, typename Op>
+__global__ void BatchedElementwiseKernel(const ElementwiseSampleDesc *samples, int nsamples,
+                                         Op op) {
+  constexpr int64_t tile = ElementwiseTileSize<OType, IType>();
+  const auto &last = samples[nsamples - 1];
+  int64_t start = blockIdx.x * tile;
+  int64_t end = cuda_min(start + tile, last.offset + last.size);
+  int first_sample = detail::FindElementwiseSample(samples, 0, nsamples - 1, start);
+  int last_sample = detail::FindElementwiseSample(samples, first_sample, nsamples - 1, end - 1);
+
+  int num_segments = last_sample - first_sample + 1;
+  if ((end - start) < int64_t(num_segments) * blockDim.x) {
+    for (int64_t x = start + threadIdx.x; x < end; x += blockDim.x) {
+      int s = detail::FindElementwiseSample(samples, first_sample, last_sample, x);
+      auto *out = static_cast<OType *>(samples[s].output);
+      const auto *in = static_cast<const IType *>(samples[s].input);
+      int64_t i = x - samples[s].offset;
+      op(out[i], in[i]);
+    }
+    return;
+  }
+
+  for (int s = first_sample; s <= last_sample; s++) {
+    const auto &sample = samples[s];
+    int64_t seg_start = cuda_max(start, sample.offset) - sample.offset;
+    int64_t seg_end = cuda_min(end, sample.offset + sample.size) - sample.offset;
+    detail::ElementwiseSegment(static_cast<OType *>(sample.output),
+                               static_cast<const IType *>(sample.input),
+                               seg_start, seg_end, op);
+  }
+}
+
+/**
+ * @brief Launches BatchedElementwiseKernel for the samples described by `samples_dev`.
+ *
+ * @param total the total number of elements of the samples
+ */
+template <typename OType, typename IType, typename Op>
+void LaunchBatchedElementwise(const ElementwiseSampleDesc *samples_dev, int nsamples,
+                              int64_t total, const Op &op, cudaStream_t stream) {
+  if (nsamples == 0 || total == 0)
+    return;
+  unsigned num_blocks = div_ceil(total, ElementwiseTileSize<OType, IType>());
+  BatchedElementwiseKernel<OType, IType>
+      <<<num_blocks, kElementwiseBlockSize, 0, stream>>>(samples_dev, nsamples, op);
+  CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_COMMON_BATCHED_ELEMENTWISE_CUH_
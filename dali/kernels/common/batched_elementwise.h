@@ -0,0 +1,54 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_COMMON_BATCHED_ELEMENTWISE_H_
+#define DALI_KERNELS_COMMON_BATCHED_ELEMENTWISE_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief A non-empty sample processed by BatchedElementwiseKernel.
+ *
+ * The samples are laid out one after another in a flat element space - `offset` is the index
+ * of the first element of the sample in that space.
+ */
+struct ElementwiseSampleDesc {
+  void *output;
+  const void *input;
+  int64_t offset;
+  int64_t size;
+};
+
+/**
+ * @brief Appends a sample to the descriptors of BatchedElementwiseKernel; empty samples
+ *        are skipped.
+ *
+ * @return The size of the flat element space of the samples added so far.
+ */
+inline int64_t AddElementwiseSample(std::vector<ElementwiseSampleDesc> &samples,
+                                    void *output, const void *input, int64_t size) {
+  int64_t offset = samples.empty() ? 0 : samples.back().offset + samples.back().size;
+  if (size > 0)
+    samples.push_back({output, input, offset, size});
+  return offset + size;
+}
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_COMMON_BATCHED_ELEMENTWISE_H_
@@ -0,0 +1,99 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/mm/memory.h"
+#include "dali/kernels/common/batched_elementwise.cuh"
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+struct ScaleOp {
+  __device__ void operator()(float &out, uint8_t in) const {
+    out = in * 2.0f;
+  }
+};
+
+/**
+ * @brief Runs the kernel for the samples of the given sizes, placed in the buffers
+ *        at the given element offsets, and checks the results.
+ */
+void TestBatchedElementwise(const std::vector<int64_t> &sizes, int misalignment) {
+  std::vector<int64_t> offsets;
+  int64_t buffer_size = 0;
+  for (auto size : sizes) {
+    offsets.push_back(buffer_size + misalignment);
+    buffer_size += size + misalignment;
+  }
+  std::vector<uint8_t> in_host(buffer_size);
+  for (int64_t i = 0; i < buffer_size; i++)
+    in_host[i] = i * 7 % 251;
+  auto in_dev = mm::alloc_raw_unique<uint8_t, mm::memory_kind::device>(buffer_size);
+  auto out_dev = mm::alloc_raw_unique<float, mm::memory_kind::device>(buffer_size);
+  CUDA_CALL(cudaMemcpy(in_dev.get(), in_host.data(), buffer_size, cudaMemcpyHostToDevice));
+  CUDA_CALL(cudaMemset(out_dev.get(), 0, buffer_size * sizeof(float)));
+
+  std::vector<ElementwiseSampleDesc> samples;
+  int64_t total = 0;
+  for (size_t i = 0; i < sizes.size(); i++)
+    total = AddElementwiseSample(samples, out_dev.get() + offsets[i], in_dev.get() + offsets[i],
+                                 sizes[i]);
+  auto samples_dev = mm::alloc_raw_unique<ElementwiseSampleDesc, mm::memory_kind::device>(
+      samples.size());
+  CUDA_CALL(cudaMemcpy(samples_dev.get(), samples.data(),
+                       samples.size() * sizeof(ElementwiseSampleDesc), cudaMemcpyHostToDevice));
+  LaunchBatchedElementwise<float, uint8_t>(samples_dev.get(), samples.size(), total, ScaleOp(),
+                                           0);
+
+  std::vector<float> out_host(buffer_size);
+  CUDA_CALL(cudaMemcpy(out_host.data(), out_dev.get(), buffer_size * sizeof(float),
+                       cudaMemcpyDeviceToHost));
+  for (size_t s = 0; s < sizes.size(); s++) {
+    for (int64_t i = offsets[s] - misalignment; i < offsets[s]; i++)
+      ASSERT_EQ(out_host[i], 0) << "written outside of the sample " << s;
+    for (int64_t i = offsets[s]; i < offsets[s] + sizes[s]; i++)
+      ASSERT_EQ(out_host[i], in_host[i] * 2.0f) << "sample " << s << " element " << i;
+  }
+}
+
+}  // namespace
+
+TEST(BatchedElementwiseKernel, TinySamples) {
+  std::vector<int64_t> sizes(20000, 1);
+  sizes[5] = 0;
+  sizes[17] = 3;
+  TestBatchedElementwise(sizes, 0);
+}
+
+TEST(BatchedElementwiseKernel, LargeSamples) {
+  TestBatchedElementwise({100003, 0, 7, 65536, 40000}, 0);
+}
+
+TEST(BatchedElementwiseKernel, Misaligned) {
+  TestBatchedElementwise({100003, 5, 65536, 1, 40000}, 3);
+}
+
+TEST(BatchedElementwiseKernel, Mixed) {
+  std::vector<int64_t> sizes;
+  for (int i = 0; i < 1000; i++)
+    sizes.push_back(i % 10 == 0 ? 5000 + i : i % 3);
+  TestBatchedElementwise(sizes, 1);
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -0,0 +1,101 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_KERNELS_COMMON_DISJOINT_SET_GPU_CUH_
+#define DALI_KERNELS_COMMON_DISJOINT_SET_GPU_CUH_
+
+#include <cstdint>
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief Implements union/find operations on device, for groups stored in a flat array
+ *
+ * Each element holds the index of its parent; a root holds its own index. The operations
+ * can be called concurrently from many threads - the groups are merged by atomically
+ * lowering the parent of the root with the higher index, so the root of a group is always
+ * its element with the lowest index, as in the host `disjoint_set`.
+ *
+ * @tparam GroupId  the index type - int32_t or int64_t
+ */
+template <typename GroupId>
+struct disjoint_set_gpu {
+  static_assert(sizeof(GroupId) == 4 || sizeof(GroupId) == 8,
+                "The group index must be a 32- or 64-bit integer.");
+
+  /**
+   * @brief Finds the current group index of an element
+   *
+   * The parents are read with volatile loads, because other threads may be lowering them.
+   */
+  static __device__ GroupId find(const GroupId *items, GroupId x) {
+    const volatile GroupId *v = items;
+    for (;;) {
+      GroupId g = v[x];
+      if (g == x)
+        return x;
+      x = g;
+    }
+  }
+
+  /**
+   * @brief Finds the group index of an element and makes it the element's direct parent
+   */
+  static __device__ GroupId compress(GroupId *items, GroupId x) {
+    GroupId r = find(items, x);
+    if (items[x] != r)
+      items[x] = r;
+    return r;
+  }
+
+  /**
+   * @brief Merges the groups of elements `x` and `y`
+   *
+   * If another thread changes one of the roots in the meantime, the merge is retried with
+   * the new root.
+   */
+  static __device__ void merge(GroupId *items, GroupId x, GroupId y) {
+    for (;;) {
+      x = find(items, x);
+      y = find(items, y);
+      if (x == y)
+        return;
+      if (x > y) {
+        GroupId tmp = x;
+        x = y;
+        y = tmp;
+      }
+      GroupId old = atomic_min(&items[y], x);
+      if (old == y)
+        return;  // y was still a root - it's now attached to x
+      y = old;
+    }
+  }
+
+ private:
+  static __device__ int32_t atomic_min(int32_t *addr, int32_t value) {
+    return atomicMin(addr, value);
+  }
+
+  static __device__ int64_t atomic_min(int64_t *addr, int64_t value) {
+    return atomicMin(reinterpret_cast<long long *>(addr), value);  // NOLINT
+  }
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_COMMON_DISJOINT_SET_GPU_CUH_
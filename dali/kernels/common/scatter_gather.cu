@@ -135,12 +135,85 @@ void ScatterGatherCPU::MakeBlocks(size_t blocks_lower_limit) {
   ScatterGatherBase::MakeBlocks(blocks_, heap_, size_per_block);
 }
 
-__global__ void BatchCopy(const ScatterGatherBase::CopyRange *ranges) {
-  auto range = ranges[blockIdx.x];
+namespace {
+
+constexpr int kWarpSize = 32;
+constexpr int kCopyBlockSize = 256;
+constexpr int kWarpsPerBlock = kCopyBlockSize / kWarpSize;
+// Ranges up to this size are copied by a single warp, so that one block copies several of them
+constexpr size_t kMaxWarpRangeSize = 4 << 10;
+
+/**
+ * @brief Copies the part of the range which is aligned to the vector type, with vector loads
+ *        and stores; the unaligned head is copied bytewise and `dst`, `src` and `size` are
+ *        advanced to the unaligned tail.
+ */
+template <typename Vec>
+__device__ inline void CopyAligned(char *&dst, const char *&src, size_t &size,
+                                   int idx, int stride) {
+  constexpr size_t kVecSize = sizeof(Vec);
+  size_t head = (kVecSize - reinterpret_cast<uintptr_t>(dst) % kVecSize) % kVecSize;
+  if (head > size)
+    head = size;
+  for (size_t i = idx; i < head; i += stride)
+    dst[i] = src[i];
+  dst += head;
+  src += head;
+  size -= head;
+
+  size_t nvec = size / kVecSize;
+  auto *vdst = reinterpret_cast<Vec *>(dst);
+  auto *vsrc = reinterpret_cast<const Vec *>(src);
+  for (size_t i = idx; i < nvec; i += stride)
+    vdst[i] = vsrc[i];
+  dst += nvec * kVecSize;
+  src += nvec * kVecSize;
+  size -= nvec * kVecSize;
+}
+
+/**
+ * @brief Copies one range with `stride` threads, `idx` being the index of the calling thread
+ */
+__device__ inline void CopyRangeImpl(ScatterGatherBase::CopyRange range, int idx, int stride) {
+  char *dst = range.dst;
+  const char *src = range.src;
+  size_t size = range.size;
+  auto misalignment = reinterpret_cast<uintptr_t>(dst) ^ reinterpret_cast<uintptr_t>(src);
+  if (misalignment % sizeof(uint4) == 0)
+    CopyAligned<uint4>(dst, src, size, idx, stride);
+  else if (misalignment % sizeof(uint32_t) == 0)
+    CopyAligned<uint32_t>(dst, src, size, idx, stride);
+  for (size_t i = idx; i < size; i += stride)
+    dst[i] = src[i];
+}
 
-  for (size_t i = threadIdx.x; i < range.size; i += blockDim.x) {
-    range.dst[i] = range.src[i];
+/**
+ * @brief Gets the range copied by the calling thread and the thread's index among the ones
+ *        copying it; the first `num_block_ranges` ranges are copied by a whole block each,
+ *        the remaining (small) ones by a warp each.
+ *
+ * @return false, if the thread has no range to copy
+ */
+__device__ inline bool GetRangeIndex(int num_block_ranges, int num_ranges,
+                                     int &range_idx, int &idx, int &stride) {
+  if (static_cast<int>(blockIdx.x) < num_block_ranges) {
+    range_idx = blockIdx.x;
+    idx = threadIdx.x;
+    stride = blockDim.x;
+  } else {
+    int warp = threadIdx.x / kWarpSize;
+    range_idx = num_block_ranges + (blockIdx.x - num_block_ranges) * kWarpsPerBlock + warp;
+    idx = threadIdx.x % kWarpSize;
+    stride = kWarpSize;
   }
+  return range_idx < num_ranges;
+}
+
+__global__ void BatchCopy(const ScatterGatherBase::CopyRange *ranges, int num_block_ranges,
+                          int num_ranges) {
+  int range_idx, idx, stride;
+  if (GetRangeIndex(num_block_ranges, num_ranges, range_idx, idx, stride))
+    CopyRangeImpl(ranges[range_idx], idx, stride);
 }
 
 constexpr int kMaxRangesByVal = 2048 / sizeof(ScatterGatherBase::CopyRange);
@@ -149,14 +222,51 @@ struct CopyRanges {
   ScatterGatherBase::CopyRange ranges[kMaxRangesByVal];
 };
 
-__global__ void BatchCopy(CopyRanges ranges) {
-  auto range = ranges.ranges[blockIdx.x];
+__global__ void BatchCopy(CopyRanges ranges, int num_block_ranges, int num_ranges) {
+  int range_idx, idx, stride;
+  if (GetRangeIndex(num_block_ranges, num_ranges, range_idx, idx, stride))
+    CopyRangeImpl(ranges.ranges[range_idx], idx, stride);
+}
+
+/**
+ * @brief Returns the number of the ranges copied by whole blocks (after splitting them into
+ *        `size_per_block` pieces) and the number of the small ones, copied by warps.
+ */
+std::pair<size_t, size_t>
+CountBlockAndWarpRanges(const std::vector<ScatterGatherBase::CopyRange> &ranges,
+                        size_t size_per_block) {
+  size_t block_ranges = 0, warp_ranges = 0;
+  for (auto &r : ranges) {
+    if (r.size <= kMaxWarpRangeSize)
+      warp_ranges++;
+    else
+      block_ranges += div_ceil(r.size, size_per_block);
+  }
+  return { block_ranges, warp_ranges };
+}
 
-  for (size_t i = threadIdx.x; i < range.size; i += blockDim.x) {
-    range.dst[i] = range.src[i];
+/**
+ * @brief Fills `out` with the pieces of the large ranges, followed by the small ranges
+ */
+template <typename RangeCollection>
+void MakeBlockAndWarpRanges(RangeCollection &out,
+                            const std::vector<ScatterGatherBase::CopyRange> &ranges,
+                            size_t size_per_block, size_t num_block_ranges) {
+  size_t b = 0, w = num_block_ranges;
+  for (auto &r : ranges) {
+    if (r.size <= kMaxWarpRangeSize) {
+      out[w++] = r;
+    } else {
+      for (size_t ofs = 0; ofs < r.size; ofs += size_per_block)
+        out[b++] = { r.src + ofs, r.dst + ofs, std::min(r.size - ofs, size_per_block) };
+    }
   }
+  assert(b == num_block_ranges);
+  assert(w == static_cast<size_t>(dali::size(out)));
 }
 
+}  // namespace
+
 void ScatterGatherGPU::Run(cudaStream_t stream, bool reset, ScatterGatherGPU::Method method,
                            cudaMemcpyKind memcpyKind) {
   Coalesce();
@@ -170,27 +280,28 @@ void ScatterGatherGPU::Run(cudaStream_t stream, bool reset, ScatterGatherGPU::Me
     for (auto &r : ranges_) {
       CUDA_CALL(cudaMemcpyAsync(r.dst, r.src, r.size, memcpyKind, stream));
     }
-  } else {
-    size_t num_blocks, size_per_block;
-    std::tie(num_blocks, size_per_block) = BlockCountAndSize(ranges_);
-    if (num_blocks > kMaxRangesByVal) {
+  } else if (!ranges_.empty()) {
+    // The ranges are split into the pieces copied by whole blocks; the small ones are copied
+    // by warps, so that a batch of many tiny samples doesn't launch a mostly idle block for each.
+    size_t size_per_block = std::max(max_size_per_block_, kMaxWarpRangeSize);
+    size_t num_block_ranges, num_warp_ranges;
+    std::tie(num_block_ranges, num_warp_ranges) = CountBlockAndWarpRanges(ranges_,
+                                                                          size_per_block);
+    size_t num_ranges = num_block_ranges + num_warp_ranges;
+    dim3 grid(num_block_ranges + div_ceil(num_warp_ranges, kWarpsPerBlock));
+    dim3 block(kCopyBlockSize);
+    if (num_ranges > static_cast<size_t>(kMaxRangesByVal)) {
       kernels::DynamicScratchpad scratchpad({}, stream);
-      auto *blocks_pinned = scratchpad.Allocate<mm::memory_kind::pinned, CopyRange>(num_blocks);
-      auto blocks = make_span(blocks_pinned, num_blocks);
-      ScatterGatherBase::MakeBlocks(blocks, ranges_, size_per_block);
-      auto *blocks_dev = scratchpad.ToGPU(stream, blocks);
-
-      dim3 grid(blocks.size());
-      dim3 block(std::min<size_t>(size_per_block, 1024));
-      BatchCopy<<<grid, block, 0, stream>>>(blocks_dev);
+      auto *ranges_pinned = scratchpad.Allocate<mm::memory_kind::pinned, CopyRange>(num_ranges);
+      auto ranges = make_span(ranges_pinned, num_ranges);
+      MakeBlockAndWarpRanges(ranges, ranges_, size_per_block, num_block_ranges);
+      auto *ranges_dev = scratchpad.ToGPU(stream, ranges);
+      BatchCopy<<<grid, block, 0, stream>>>(ranges_dev, num_block_ranges, num_ranges);
     } else {
       CopyRanges ranges = {};
-      auto blocks = make_span(ranges.ranges, num_blocks);
-      ScatterGatherBase::MakeBlocks(blocks, ranges_, size_per_block);
-
-      dim3 grid(blocks.size());
-      dim3 block(std::min<size_t>(size_per_block, 1024));
-      BatchCopy<<<grid, block, 0, stream>>>(ranges);
+      auto ranges_span = make_span(ranges.ranges, num_ranges);
+      MakeBlockAndWarpRanges(ranges_span, ranges_, size_per_block, num_block_ranges);
+      BatchCopy<<<grid, block, 0, stream>>>(ranges, num_block_ranges, num_ranges);
     }
     CUDA_CALL(cudaGetLastError());
   }
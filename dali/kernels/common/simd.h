@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,11 +15,16 @@
 #ifndef DALI_KERNELS_COMMON_SIMD_H_
 #define DALI_KERNELS_COMMON_SIMD_H_
 
-#ifdef __SSE2__
+#if defined(__SSE2__)
 #include <emmintrin.h>
+#define DALI_SIMD_FLOAT4 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define DALI_SIMD_FLOAT4 1
 #endif
 
 #include <cstddef>
+#include <cstdint>
 #include <limits>
 #include <type_traits>
 #include "dali/core/force_inline.h"
@@ -28,11 +33,13 @@ namespace dali {
 namespace kernels {
 namespace simd {
 
-#ifdef __SSE2__
+#if defined(__SSE2__)
+
+using float4_t = __m128;
 
 template <int n>
 struct float4x {
-  __m128 v[n];  // NOLINT
+  float4_t v[n];  // NOLINT
 };
 
 template <int n>
@@ -47,6 +54,97 @@ using i128x1 = i128x<1>;
 using i128x2 = i128x<2>;
 using i128x4 = i128x<4>;
 
+DALI_FORCEINLINE float4_t zero_f() noexcept {
+  return _mm_setzero_ps();
+}
+
+DALI_FORCEINLINE float4_t set1_f(float x) noexcept {
+  return _mm_set1_ps(x);
+}
+
+/**
+ * @brief Returns acc + a * b
+ */
+DALI_FORCEINLINE float4_t madd(float4_t acc, float4_t a, float4_t b) noexcept {
+  return _mm_add_ps(acc, _mm_mul_ps(a, b));
+}
+
+DALI_FORCEINLINE float4_t sub(float4_t a, float4_t b) noexcept {
+  return _mm_sub_ps(a, b);
+}
+
+DALI_FORCEINLINE float4_t mul(float4_t a, float4_t b) noexcept {
+  return _mm_mul_ps(a, b);
+}
+
+DALI_FORCEINLINE float4_t add(float4_t a, float4_t b) noexcept {
+  return _mm_add_ps(a, b);
+}
+
+/**
+ * @brief Rounds to nearest, with ties to even
+ *
+ * The values must be in the int32 range.
+ */
+DALI_FORCEINLINE float4_t round_f(float4_t x) noexcept {
+  return _mm_cvtepi32_ps(_mm_cvtps_epi32(x));
+}
+
+/**
+ * @brief Rounds to nearest, with ties away from zero - as std::round
+ */
+DALI_FORCEINLINE float4_t round_away_f(float4_t x) noexcept {
+  __m128 sign_mask = _mm_set1_ps(-0.0f);
+  __m128 sign = _mm_and_ps(x, sign_mask);
+  __m128 abs = _mm_andnot_ps(sign_mask, x);
+  // the values not less than 2^23 are integers already (and may be out of the int32 range)
+  __m128 is_int = _mm_cmpge_ps(abs, _mm_set1_ps(8388608.0f));
+  __m128 trunc = _mm_cvtepi32_ps(_mm_cvttps_epi32(abs));
+  __m128 up = _mm_and_ps(_mm_cmpge_ps(_mm_sub_ps(abs, trunc), _mm_set1_ps(0.5f)),
+                         _mm_set1_ps(1.0f));
+  __m128 rounded = _mm_or_ps(_mm_add_ps(trunc, up), sign);
+  return _mm_or_ps(_mm_and_ps(is_int, x), _mm_andnot_ps(is_int, rounded));
+}
+
+/**
+ * @brief Transposes a 4x4 matrix stored as 4 rows
+ */
+DALI_FORCEINLINE void transpose(float4x4 &m) noexcept {
+  _MM_TRANSPOSE4_PS(m.v[0], m.v[1], m.v[2], m.v[3]);
+}
+
+/**
+ * @brief Deinterleaves 4 pixels with 3 channels, stored in 3 vectors, into 3 planes
+ *
+ * {r0 g0 b0 r1}, {g1 b1 r2 g2}, {b2 r3 g3 b3} -> {r0 r1 r2 r3}, {g0 g1 g2 g3}, {b0 b1 b2 b3}
+ */
+DALI_FORCEINLINE void deinterleave3(float4x<3> &m) noexcept {
+  __m128 a = m.v[0], b = m.v[1], c = m.v[2];
+  __m128 a2a2b1b1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+  __m128 a1a1b0b0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+  __m128 b2b2c1c1 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+  __m128 b3b3c2c2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+  m.v[0] = _mm_shuffle_ps(a, b2b2c1c1, _MM_SHUFFLE(2, 0, 3, 0));
+  m.v[1] = _mm_shuffle_ps(a1a1b0b0, b3b3c2c2, _MM_SHUFFLE(2, 0, 2, 0));
+  m.v[2] = _mm_shuffle_ps(a2a2b1b1, c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+/**
+ * @brief Interleaves 3 planes of 4 pixels into 3 vectors - the inverse of `deinterleave3`
+ */
+DALI_FORCEINLINE void interleave3(float4x<3> &m) noexcept {
+  __m128 r = m.v[0], g = m.v[1], b = m.v[2];
+  __m128 r0r0g0g0 = _mm_shuffle_ps(r, g, _MM_SHUFFLE(0, 0, 0, 0));
+  __m128 b0b0r1r1 = _mm_shuffle_ps(b, r, _MM_SHUFFLE(1, 1, 0, 0));
+  __m128 g1g1b1b1 = _mm_shuffle_ps(g, b, _MM_SHUFFLE(1, 1, 1, 1));
+  __m128 r2r2g2g2 = _mm_shuffle_ps(r, g, _MM_SHUFFLE(2, 2, 2, 2));
+  __m128 b2b2r3r3 = _mm_shuffle_ps(b, r, _MM_SHUFFLE(3, 3, 2, 2));
+  __m128 g3g3b3b3 = _mm_shuffle_ps(g, b, _MM_SHUFFLE(3, 3, 3, 3));
+  m.v[0] = _mm_shuffle_ps(r0r0g0g0, b0b0r1r1, _MM_SHUFFLE(2, 0, 2, 0));
+  m.v[1] = _mm_shuffle_ps(g1g1b1b1, r2r2g2g2, _MM_SHUFFLE(2, 0, 2, 0));
+  m.v[2] = _mm_shuffle_ps(b2b2r3r3, g3g3b3b3, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
 /**
  * @brief Clamp floating point value to range [lo, hi], round to nearest and as int32x4
  */
@@ -234,8 +332,10 @@ inline float4x1 load_f(const float *f) {
 inline __m128i saturate_f_i32(__m128 f) {
   // this converts f to int32. Out of range values (and NaN) are stored as -2^31
   __m128i raw = _mm_cvtps_epi32(f);
-  // xor to check where sign disagrees
-  __m128i mask = _mm_xor_si128(_mm_castps_si128(f), raw);
+  __m128i out_of_range = _mm_cmpeq_epi32(raw, _mm_set1_epi32(std::numeric_limits<int32_t>::min()));
+  // xor to check where sign disagrees - only for the out of range values, since small negative
+  // values (and -0.0) are legitimately converted to 0
+  __m128i mask = _mm_and_si128(_mm_xor_si128(_mm_castps_si128(f), raw), out_of_range);
   __m128i adjust = _mm_srli_epi32(mask, 31);  // move the disagreeing sign bit to LSB and subtract
   // this converts 0x80000000 to 0x7fffffff, which is what we want
   return _mm_sub_epi32(raw, adjust);
@@ -273,19 +373,525 @@ inline void store_f(float *out, float4x1 f) {
   _mm_storeu_ps(out, f.v[0]);
 }
 
+/**
+ * @brief 8 signed 16-bit integers - an operand of the fixed-point multiply-add
+ */
+using i16x8_t = __m128i;
+
+/**
+ * @brief 8 signed 32-bit integers - the accumulator of the fixed-point multiply-add
+ */
+using i32x8 = i128x2;
+
+DALI_FORCEINLINE i32x8 zero_i32x8() noexcept {
+  return {{ _mm_setzero_si128(), _mm_setzero_si128() }};
+}
+
+DALI_FORCEINLINE i16x8_t set1_i16(int16_t x) noexcept {
+  return _mm_set1_epi16(x);
+}
+
+/**
+ * @brief Load int16x8
+ */
+DALI_FORCEINLINE i16x8_t load_i16(const int16_t *i16) noexcept {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(i16));
+}
+
+/**
+ * @brief Load uint8x8 and zero-extend to int16x8
+ */
+DALI_FORCEINLINE i16x8_t load_i16(const uint8_t *u8) noexcept {
+  return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(u8)),
+                           _mm_setzero_si128());
+}
+
+/**
+ * @brief Calculates acc + a * b, with the products widened to 32 bits
+ */
+DALI_FORCEINLINE void madd_i16(i32x8 &acc, i16x8_t a, i16x8_t b) noexcept {
+  __m128i lo = _mm_mullo_epi16(a, b);
+  __m128i hi = _mm_mulhi_epi16(a, b);
+  acc.v[0] = _mm_add_epi32(acc.v[0], _mm_unpacklo_epi16(lo, hi));
+  acc.v[1] = _mm_add_epi32(acc.v[1], _mm_unpackhi_epi16(lo, hi));
+}
+
+/**
+ * @brief Shifts right by `shift` bits, rounding half up
+ */
+template <int shift>
+DALI_FORCEINLINE __m128i shr_round_i32(__m128i x) noexcept {
+  return _mm_srai_epi32(_mm_add_epi32(x, _mm_set1_epi32(1 << (shift - 1))), shift);
+}
+
+/**
+ * @brief Shifts the fixed-point values right by `shift` bits, with rounding,
+ *        saturates them to int16 and stores
+ */
+template <int shift>
+DALI_FORCEINLINE void store_shr(int16_t *i16, i32x8 acc) noexcept {
+  __m128i out = _mm_packs_epi32(shr_round_i32<shift>(acc.v[0]), shr_round_i32<shift>(acc.v[1]));
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(i16), out);
+}
+
+/**
+ * @brief Shifts the fixed-point values right by `shift` bits, with rounding,
+ *        saturates them to uint8 and stores
+ */
+template <int shift>
+DALI_FORCEINLINE void store_shr(uint8_t *u8, i32x8 acc) noexcept {
+  __m128i i16 = _mm_packs_epi32(shr_round_i32<shift>(acc.v[0]), shr_round_i32<shift>(acc.v[1]));
+  _mm_storel_epi64(reinterpret_cast<__m128i *>(u8), _mm_packus_epi16(i16, i16));
+}
+
+/**
+ * @brief Transposes an 8x8 block of 8-bit elements
+ *
+ * Row `i` of the input starts at `in + i * in_stride` and is stored as column `i` of the output,
+ * whose rows start at `out + j * out_stride` (the strides are in elements).
+ */
+DALI_FORCEINLINE void transpose8x8(uint8_t *out, int64_t out_stride,
+                                   const uint8_t *in, int64_t in_stride) noexcept {
+  __m128i r[8];  // NOLINT
+  for (int i = 0; i < 8; i++)
+    r[i] = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in + i * in_stride));
+  // {00 10 01 11 ... 07 17}, ...
+  __m128i a0 = _mm_unpacklo_epi8(r[0], r[1]), a1 = _mm_unpacklo_epi8(r[2], r[3]);
+  __m128i a2 = _mm_unpacklo_epi8(r[4], r[5]), a3 = _mm_unpacklo_epi8(r[6], r[7]);
+  // {00 10 20 30 01 11 21 31 ... 03 13 23 33}, ...
+  __m128i b0 = _mm_unpacklo_epi16(a0, a1), b1 = _mm_unpackhi_epi16(a0, a1);
+  __m128i b2 = _mm_unpacklo_epi16(a2, a3), b3 = _mm_unpackhi_epi16(a2, a3);
+  // two output rows in each vector
+  __m128i c[4] = { _mm_unpacklo_epi32(b0, b2), _mm_unpackhi_epi32(b0, b2),  // NOLINT
+                   _mm_unpacklo_epi32(b1, b3), _mm_unpackhi_epi32(b1, b3) };
+  for (int i = 0; i < 4; i++) {
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out + 2 * i * out_stride), c[i]);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out + (2 * i + 1) * out_stride),
+                     _mm_srli_si128(c[i], 8));
+  }
+}
+
+/**
+ * @brief Transposes an 8x8 block of 16-bit elements; see transpose8x8(uint8_t *, ...)
+ */
+DALI_FORCEINLINE void transpose8x8(uint16_t *out, int64_t out_stride,
+                                   const uint16_t *in, int64_t in_stride) noexcept {
+  __m128i r[8];  // NOLINT
+  for (int i = 0; i < 8; i++)
+    r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i * in_stride));
+  // a[2k] - the columns 0..3 of the rows 2k and 2k + 1, interleaved; a[2k + 1] - columns 4..7
+  __m128i a[8];  // NOLINT
+  for (int i = 0; i < 4; i++) {
+    a[2 * i] = _mm_unpacklo_epi16(r[2 * i], r[2 * i + 1]);
+    a[2 * i + 1] = _mm_unpackhi_epi16(r[2 * i], r[2 * i + 1]);
+  }
+  // b[4h + c] - columns {2c, 2c + 1} of rows 4h..4h+3
+  __m128i b[8];  // NOLINT
+  for (int h = 0; h < 2; h++) {
+    b[4 * h] = _mm_unpacklo_epi32(a[4 * h], a[4 * h + 2]);
+    b[4 * h + 1] = _mm_unpackhi_epi32(a[4 * h], a[4 * h + 2]);
+    b[4 * h + 2] = _mm_unpacklo_epi32(a[4 * h + 1], a[4 * h + 3]);
+    b[4 * h + 3] = _mm_unpackhi_epi32(a[4 * h + 1], a[4 * h + 3]);
+  }
+  for (int i = 0; i < 4; i++) {
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * i * out_stride),
+                     _mm_unpacklo_epi64(b[i], b[i + 4]));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + (2 * i + 1) * out_stride),
+                     _mm_unpackhi_epi64(b[i], b[i + 4]));
+  }
+}
+
+/**
+ * @brief Transposes an 8x8 block of 32-bit elements; see transpose8x8(uint8_t *, ...)
+ */
+DALI_FORCEINLINE void transpose8x8(uint32_t *out, int64_t out_stride,
+                                   const uint32_t *in, int64_t in_stride) noexcept {
+  for (int bi = 0; bi < 8; bi += 4) {
+    for (int bj = 0; bj < 8; bj += 4) {
+      __m128i r[4];  // NOLINT
+      for (int i = 0; i < 4; i++)
+        r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + (bi + i) * in_stride + bj));
+      __m128i t0 = _mm_unpacklo_epi32(r[0], r[1]), t1 = _mm_unpacklo_epi32(r[2], r[3]);
+      __m128i t2 = _mm_unpackhi_epi32(r[0], r[1]), t3 = _mm_unpackhi_epi32(r[2], r[3]);
+      __m128i c[4] = { _mm_unpacklo_epi64(t0, t1), _mm_unpackhi_epi64(t0, t1),  // NOLINT
+                       _mm_unpacklo_epi64(t2, t3), _mm_unpackhi_epi64(t2, t3) };
+      for (int j = 0; j < 4; j++)
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + (bj + j) * out_stride + bi), c[j]);
+    }
+  }
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+using float4_t = float32x4_t;
+
+template <int n>
+struct float4x {
+  float4_t v[n];  // NOLINT
+};
+
+using float4x1 = float4x<1>;
+using float4x2 = float4x<2>;
+using float4x4 = float4x<4>;
+
+DALI_FORCEINLINE float4_t zero_f() noexcept {
+  return vdupq_n_f32(0);
+}
+
+DALI_FORCEINLINE float4_t set1_f(float x) noexcept {
+  return vdupq_n_f32(x);
+}
+
+/**
+ * @brief Returns acc + a * b
+ *
+ * The multiplication and addition are not fused, so that the results match the SSE2 variant.
+ */
+DALI_FORCEINLINE float4_t madd(float4_t acc, float4_t a, float4_t b) noexcept {
+  return vaddq_f32(acc, vmulq_f32(a, b));
+}
+
+DALI_FORCEINLINE float4_t sub(float4_t a, float4_t b) noexcept {
+  return vsubq_f32(a, b);
+}
+
+DALI_FORCEINLINE float4_t mul(float4_t a, float4_t b) noexcept {
+  return vmulq_f32(a, b);
+}
+
+DALI_FORCEINLINE float4_t add(float4_t a, float4_t b) noexcept {
+  return vaddq_f32(a, b);
+}
+
+/**
+ * @brief Rounds to nearest, with ties to even
+ */
+DALI_FORCEINLINE float4_t round_f(float4_t x) noexcept {
+  return vrndnq_f32(x);
+}
+
+/**
+ * @brief Rounds to nearest, with ties away from zero - as std::round
+ */
+DALI_FORCEINLINE float4_t round_away_f(float4_t x) noexcept {
+  return vrndaq_f32(x);
+}
+
+/**
+ * @brief Transposes a 4x4 matrix stored as 4 rows
+ */
+DALI_FORCEINLINE void transpose(float4x4 &m) noexcept {
+  float32x4x2_t t01 = vtrnq_f32(m.v[0], m.v[1]);
+  float32x4x2_t t23 = vtrnq_f32(m.v[2], m.v[3]);
+  m.v[0] = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+  m.v[1] = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+  m.v[2] = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+  m.v[3] = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+/**
+ * @brief Deinterleaves 4 pixels with 3 channels, stored in 3 vectors, into 3 planes
+ *
+ * {r0 g0 b0 r1}, {g1 b1 r2 g2}, {b2 r3 g3 b3} -> {r0 r1 r2 r3}, {g0 g1 g2 g3}, {b0 b1 b2 b3}
+ */
+DALI_FORCEINLINE void deinterleave3(float4x<3> &m) noexcept {
+  float tmp[12];
+  for (int i = 0; i < 3; i++)
+    vst1q_f32(tmp + 4 * i, m.v[i]);
+  float32x4x3_t planes = vld3q_f32(tmp);
+  for (int i = 0; i < 3; i++)
+    m.v[i] = planes.val[i];
+}
+
+/**
+ * @brief Interleaves 3 planes of 4 pixels into 3 vectors - the inverse of `deinterleave3`
+ */
+DALI_FORCEINLINE void interleave3(float4x<3> &m) noexcept {
+  float tmp[12];
+  float32x4x3_t planes = {{ m.v[0], m.v[1], m.v[2] }};
+  vst3q_f32(tmp, planes);
+  for (int i = 0; i < 3; i++)
+    m.v[i] = vld1q_f32(tmp + 4 * i);
+}
+
+/**
+ * @brief Load uint8x16 and convert to 4 float32x4
+ */
+inline float4x4 load_f(const uint8_t *u8) {
+  uint8x16_t in = vld1q_u8(u8);
+  uint16x8_t lo16 = vmovl_u8(vget_low_u8(in));
+  uint16x8_t hi16 = vmovl_u8(vget_high_u8(in));
+  return {{ vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo16))),
+            vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo16))),
+            vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi16))),
+            vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi16))) }};
+}
+
+/**
+ * @brief Load int8x16 and convert to 4 float32x4
+ */
+inline float4x4 load_f(const int8_t *i8) {
+  int8x16_t in = vld1q_s8(i8);
+  int16x8_t lo16 = vmovl_s8(vget_low_s8(in));
+  int16x8_t hi16 = vmovl_s8(vget_high_s8(in));
+  return {{ vcvtq_f32_s32(vmovl_s16(vget_low_s16(lo16))),
+            vcvtq_f32_s32(vmovl_s16(vget_high_s16(lo16))),
+            vcvtq_f32_s32(vmovl_s16(vget_low_s16(hi16))),
+            vcvtq_f32_s32(vmovl_s16(vget_high_s16(hi16))) }};
+}
+
+/**
+ * @brief Load uint16x8 and convert to 2 float32x4
+ */
+inline float4x2 load_f(const uint16_t *u16) {
+  uint16x8_t in = vld1q_u16(u16);
+  return {{ vcvtq_f32_u32(vmovl_u16(vget_low_u16(in))),
+            vcvtq_f32_u32(vmovl_u16(vget_high_u16(in))) }};
+}
+
+/**
+ * @brief Load int16x8 and convert to 2 float32x4
+ */
+inline float4x2 load_f(const int16_t *i16) {
+  int16x8_t in = vld1q_s16(i16);
+  return {{ vcvtq_f32_s32(vmovl_s16(vget_low_s16(in))),
+            vcvtq_f32_s32(vmovl_s16(vget_high_s16(in))) }};
+}
+
+/**
+ * @brief Load int32x4 and convert to 1 float32x4
+ */
+inline float4x1 load_f(const int32_t *i32) {
+  return {{ vcvtq_f32_s32(vld1q_s32(i32)) }};
+}
+
+inline float4x1 load_f(const float *f) {
+  return {{ vld1q_f32(f) }};
+}
+
+/*
+ * The conversions below round to nearest with ties away from zero (as std::round does)
+ * and saturate at each narrowing step.
+ */
+
+/**
+ * @brief Convert 4 vectors of float to uint8x16 and store
+ */
+inline void store_f(uint8_t *u8, float4x4 f) {
+  uint16x8_t lo = vcombine_u16(vqmovn_u32(vcvtaq_u32_f32(f.v[0])),
+                               vqmovn_u32(vcvtaq_u32_f32(f.v[1])));
+  uint16x8_t hi = vcombine_u16(vqmovn_u32(vcvtaq_u32_f32(f.v[2])),
+                               vqmovn_u32(vcvtaq_u32_f32(f.v[3])));
+  vst1q_u8(u8, vcombine_u8(vqmovn_u16(lo), vqmovn_u16(hi)));
+}
+
+/**
+ * @brief Convert 4 vectors of float to int8x16 and store
+ */
+inline void store_f(int8_t *i8, float4x4 f) {
+  int16x8_t lo = vcombine_s16(vqmovn_s32(vcvtaq_s32_f32(f.v[0])),
+                              vqmovn_s32(vcvtaq_s32_f32(f.v[1])));
+  int16x8_t hi = vcombine_s16(vqmovn_s32(vcvtaq_s32_f32(f.v[2])),
+                              vqmovn_s32(vcvtaq_s32_f32(f.v[3])));
+  vst1q_s8(i8, vcombine_s8(vqmovn_s16(lo), vqmovn_s16(hi)));
+}
+
+/**
+ * @brief Convert 2 vectors of float to uint16x8 and store
+ */
+inline void store_f(uint16_t *u16, float4x2 f) {
+  vst1q_u16(u16, vcombine_u16(vqmovn_u32(vcvtaq_u32_f32(f.v[0])),
+                              vqmovn_u32(vcvtaq_u32_f32(f.v[1]))));
+}
+
+/**
+ * @brief Convert 2 vectors of float to int16x8 and store
+ */
+inline void store_f(int16_t *i16, float4x2 f) {
+  vst1q_s16(i16, vcombine_s16(vqmovn_s32(vcvtaq_s32_f32(f.v[0])),
+                              vqmovn_s32(vcvtaq_s32_f32(f.v[1]))));
+}
+
+/**
+ * @brief Convert 1 vector of float to int32x4 and store
+ */
+inline void store_f(int32_t *i32, float4x1 f) {
+  vst1q_s32(i32, vcvtaq_s32_f32(f.v[0]));
+}
+
+/**
+ * @brief Store 1 vector of floats
+ */
+inline void store_f(float *out, float4x1 f) {
+  vst1q_f32(out, f.v[0]);
+}
+
+/**
+ * @brief 8 signed 16-bit integers - an operand of the fixed-point multiply-add
+ */
+using i16x8_t = int16x8_t;
+
+/**
+ * @brief 8 signed 32-bit integers - the accumulator of the fixed-point multiply-add
+ */
+struct i32x8 {
+  int32x4_t v[2];  // NOLINT
+};
+
+DALI_FORCEINLINE i32x8 zero_i32x8() noexcept {
+  return {{ vdupq_n_s32(0), vdupq_n_s32(0) }};
+}
+
+DALI_FORCEINLINE i16x8_t set1_i16(int16_t x) noexcept {
+  return vdupq_n_s16(x);
+}
+
+/**
+ * @brief Load int16x8
+ */
+DALI_FORCEINLINE i16x8_t load_i16(const int16_t *i16) noexcept {
+  return vld1q_s16(i16);
+}
+
+/**
+ * @brief Load uint8x8 and zero-extend to int16x8
+ */
+DALI_FORCEINLINE i16x8_t load_i16(const uint8_t *u8) noexcept {
+  return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u8)));
+}
+
+/**
+ * @brief Calculates acc + a * b, with the products widened to 32 bits
+ */
+DALI_FORCEINLINE void madd_i16(i32x8 &acc, i16x8_t a, i16x8_t b) noexcept {
+  acc.v[0] = vmlal_s16(acc.v[0], vget_low_s16(a), vget_low_s16(b));
+  acc.v[1] = vmlal_s16(acc.v[1], vget_high_s16(a), vget_high_s16(b));
+}
+
+/**
+ * @brief Shifts the fixed-point values right by `shift` bits, with rounding,
+ *        saturates them to int16 and stores
+ */
+template <int shift>
+DALI_FORCEINLINE void store_shr(int16_t *i16, i32x8 acc) noexcept {
+  vst1q_s16(i16, vcombine_s16(vqmovn_s32(vrshrq_n_s32(acc.v[0], shift)),
+                              vqmovn_s32(vrshrq_n_s32(acc.v[1], shift))));
+}
+
+/**
+ * @brief Shifts the fixed-point values right by `shift` bits, with rounding,
+ *        saturates them to uint8 and stores
+ */
+template <int shift>
+DALI_FORCEINLINE void store_shr(uint8_t *u8, i32x8 acc) noexcept {
+  int16x8_t i16 = vcombine_s16(vqmovn_s32(vrshrq_n_s32(acc.v[0], shift)),
+                               vqmovn_s32(vrshrq_n_s32(acc.v[1], shift)));
+  vst1_u8(u8, vqmovun_s16(i16));
+}
+
+/**
+ * @brief Transposes an 8x8 block of 8-bit elements
+ *
+ * Row `i` of the input starts at `in + i * in_stride` and is stored as column `i` of the output,
+ * whose rows start at `out + j * out_stride` (the strides are in elements).
+ */
+DALI_FORCEINLINE void transpose8x8(uint8_t *out, int64_t out_stride,
+                                   const uint8_t *in, int64_t in_stride) noexcept {
+  uint8x8_t r[8];  // NOLINT
+  for (int i = 0; i < 8; i++)
+    r[i] = vld1_u8(in + i * in_stride);
+  // {00 10 02 12 04 14 06 16}, {01 11 03 13 05 15 07 17}
+  uint8x8x2_t a01 = vtrn_u8(r[0], r[1]), a23 = vtrn_u8(r[2], r[3]);
+  uint8x8x2_t a45 = vtrn_u8(r[4], r[5]), a67 = vtrn_u8(r[6], r[7]);
+  // {00 10 20 30 04 14 24 34}, {02 12 22 32 06 16 26 36}
+  uint16x4x2_t b02 = vtrn_u16(vreinterpret_u16_u8(a01.val[0]), vreinterpret_u16_u8(a23.val[0]));
+  uint16x4x2_t b13 = vtrn_u16(vreinterpret_u16_u8(a01.val[1]), vreinterpret_u16_u8(a23.val[1]));
+  uint16x4x2_t b46 = vtrn_u16(vreinterpret_u16_u8(a45.val[0]), vreinterpret_u16_u8(a67.val[0]));
+  uint16x4x2_t b57 = vtrn_u16(vreinterpret_u16_u8(a45.val[1]), vreinterpret_u16_u8(a67.val[1]));
+  // the columns c and c + 4
+  uint32x2x2_t c[4] = {  // NOLINT
+    vtrn_u32(vreinterpret_u32_u16(b02.val[0]), vreinterpret_u32_u16(b46.val[0])),
+    vtrn_u32(vreinterpret_u32_u16(b13.val[0]), vreinterpret_u32_u16(b57.val[0])),
+    vtrn_u32(vreinterpret_u32_u16(b02.val[1]), vreinterpret_u32_u16(b46.val[1])),
+    vtrn_u32(vreinterpret_u32_u16(b13.val[1]), vreinterpret_u32_u16(b57.val[1]))
+  };
+  for (int i = 0; i < 4; i++) {
+    vst1_u8(out + i * out_stride, vreinterpret_u8_u32(c[i].val[0]));
+    vst1_u8(out + (i + 4) * out_stride, vreinterpret_u8_u32(c[i].val[1]));
+  }
+}
+
+/**
+ * @brief Transposes an 8x8 block of 16-bit elements; see transpose8x8(uint8_t *, ...)
+ */
+DALI_FORCEINLINE void transpose8x8(uint16_t *out, int64_t out_stride,
+                                   const uint16_t *in, int64_t in_stride) noexcept {
+  uint16x8_t r[8];  // NOLINT
+  for (int i = 0; i < 8; i++)
+    r[i] = vld1q_u16(in + i * in_stride);
+  uint16x8x2_t a01 = vtrnq_u16(r[0], r[1]), a23 = vtrnq_u16(r[2], r[3]);
+  uint16x8x2_t a45 = vtrnq_u16(r[4], r[5]), a67 = vtrnq_u16(r[6], r[7]);
+  // {00 10 20 30 04 14 24 34}, {02 12 22 32 06 16 26 36}
+  uint32x4x2_t b02 = vtrnq_u32(vreinterpretq_u32_u16(a01.val[0]),
+                               vreinterpretq_u32_u16(a23.val[0]));
+  uint32x4x2_t b13 = vtrnq_u32(vreinterpretq_u32_u16(a01.val[1]),
+                               vreinterpretq_u32_u16(a23.val[1]));
+  uint32x4x2_t b46 = vtrnq_u32(vreinterpretq_u32_u16(a45.val[0]),
+                               vreinterpretq_u32_u16(a67.val[0]));
+  uint32x4x2_t b57 = vtrnq_u32(vreinterpretq_u32_u16(a45.val[1]),
+                               vreinterpretq_u32_u16(a67.val[1]));
+  // the rows 0..3 of the column c are in the low half of lo[c], of the column c + 4 - in the high
+  uint32x4_t lo[4] = { b02.val[0], b13.val[0], b02.val[1], b13.val[1] };  // NOLINT
+  uint32x4_t hi[4] = { b46.val[0], b57.val[0], b46.val[1], b57.val[1] };  // NOLINT
+  for (int i = 0; i < 4; i++) {
+    vst1q_u16(out + i * out_stride,
+              vreinterpretq_u16_u32(vcombine_u32(vget_low_u32(lo[i]), vget_low_u32(hi[i]))));
+    vst1q_u16(out + (i + 4) * out_stride,
+              vreinterpretq_u16_u32(vcombine_u32(vget_high_u32(lo[i]), vget_high_u32(hi[i]))));
+  }
+}
+
+/**
+ * @brief Transposes an 8x8 block of 32-bit elements; see transpose8x8(uint8_t *, ...)
+ */
+DALI_FORCEINLINE void transpose8x8(uint32_t *out, int64_t out_stride,
+                                   const uint32_t *in, int64_t in_stride) noexcept {
+  for (int bi = 0; bi < 8; bi += 4) {
+    for (int bj = 0; bj < 8; bj += 4) {
+      uint32x4_t r[4];  // NOLINT
+      for (int i = 0; i < 4; i++)
+        r[i] = vld1q_u32(in + (bi + i) * in_stride + bj);
+      // {00 10 02 12}, {01 11 03 13}
+      uint32x4x2_t t01 = vtrnq_u32(r[0], r[1]), t23 = vtrnq_u32(r[2], r[3]);
+      uint32x4_t c[4] = {  // NOLINT
+        vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0])),
+        vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1])),
+        vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0])),
+        vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1]))
+      };
+      for (int j = 0; j < 4; j++)
+        vst1q_u32(out + (bj + j) * out_stride + bi, c[j]);
+    }
+  }
+}
+
+#endif
+
+#ifdef DALI_SIMD_FLOAT4
+
 template <int num_vecs>
 struct multivec : float4x<num_vecs> {
   DALI_FORCEINLINE static multivec zero() noexcept  {
     multivec m;
     for (int i = 0; i < num_vecs; i++)
-      m.v[i] = _mm_setzero_ps();
+      m.v[i] = zero_f();
     return m;
   }
 
   DALI_FORCEINLINE static multivec load(const float *in) noexcept  {
     multivec m;
     for (int i = 0; i < num_vecs; i++)
-      m.v[i] = _mm_loadu_ps(in + 4*i);
+      m.v[i] = load_f(in + 4*i).v[0];
     return m;
   }
 
@@ -298,7 +904,7 @@ struct multivec : float4x<num_vecs> {
       "Total number of lanes is not a multiple of storage lanes.");
     multivec m;
     for (int i = 0; i < num_vecs; i += load_vecs) {
-      auto tmp = simd::load_f(in + i * load_lanes);
+      auto tmp = simd::load_f(in + i * 4);
       for (int j = 0; j < load_vecs; j++)
         m.v[i + j] = tmp.v[j];
     }
@@ -322,11 +928,11 @@ DALI_FORCEINLINE static void store(Out *out, multivec<num_vecs> m) noexcept {
     float4x<store_vecs> slice;
     for (int j = 0; j < store_vecs; j++)
       slice.v[j] = m.v[i + j];
-    store_f(out + i * store_lanes, slice);
+    store_f(out + i * 4, slice);
   }
 }
 
-#endif  // __SSE2__
+#endif  // DALI_SIMD_FLOAT4
 
 }  // namespace simd
 }  // namespace kernels
@@ -15,6 +15,7 @@
 #ifndef DALI_KERNELS_COMMON_SPLIT_SHAPE_H_
 #define DALI_KERNELS_COMMON_SPLIT_SHAPE_H_
 
+#include <algorithm>
 #include <utility>
 #include "dali/core/util.h"
 #include "dali/core/tensor_shape.h"
@@ -68,6 +69,30 @@ int split_shape(SplitFactor& split_factor, const Shape& in_shape, int min_nblock
   return volume(split_factor);
 }
 
+/**
+ * @brief Calculates the number of ranges of the outermost dimension into which a sample
+ *        should be split, so that a batch smaller than the number of threads can occupy them all.
+ *
+ * The samples get a number of ranges proportional to their share of the total volume of the
+ * batch. No splitting is done when there are at least as many samples as threads.
+ *
+ * @param sample_volume Volume of the sample
+ * @param total_volume Total volume of the batch
+ * @param extent Extent of the outermost dimension of the sample
+ * @param num_samples Number of samples in the batch
+ * @param num_threads Number of threads
+ * @param min_sz Minimum practical range volume
+ */
+inline int num_outer_ranges(int64_t sample_volume, int64_t total_volume, int64_t extent,
+                            int num_samples, int num_threads, int64_t min_sz = 16000) {
+  if (num_samples >= num_threads || extent <= 1 || total_volume <= 0)
+    return 1;
+  int64_t n = div_ceil(sample_volume * num_threads, total_volume);
+  n = std::min(n, sample_volume / min_sz);
+  n = std::min(n, extent);
+  return std::max<int64_t>(n, 1);
+}
+
 /**
  * @brief returns the dimension index with a split factor > 1
  */
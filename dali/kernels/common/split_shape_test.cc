@@ -75,5 +75,20 @@ TEST(split_shape, basic_test) {
   ASSERT_EQ(split_factor[2], 1);
 }
 
+TEST(SplitShapeTest, NumOuterRanges) {
+  // enough samples to occupy all the threads
+  ASSERT_EQ(num_outer_ranges(1000000, 1000000, 1000, 8, 8), 1);
+  // a single sample is split among all the threads
+  ASSERT_EQ(num_outer_ranges(1000000, 1000000, 1000, 1, 8), 8);
+  // ...but not into more ranges than there are rows
+  ASSERT_EQ(num_outer_ranges(1000000, 1000000, 5, 1, 8), 5);
+  // ...nor into ranges smaller than the minimum size
+  ASSERT_EQ(num_outer_ranges(40000, 40000, 200, 1, 8), 2);
+  // the samples get the number of ranges proportional to their share of the batch
+  ASSERT_EQ(num_outer_ranges(750000, 1000000, 1000, 2, 8), 6);
+  ASSERT_EQ(num_outer_ranges(250000, 1000000, 1000, 2, 8), 2);
+  ASSERT_EQ(num_outer_ranges(1000, 1000000, 1000, 2, 8), 1);
+}
+
 }  // namespace kernels
 }  // namespace dali
@@ -20,6 +20,8 @@
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include "dali/core/cuda_error.h"
+#include "dali/core/error_handling.h"
 #include "dali/core/static_switch.h"
 #include "dali/core/mm/fixed_order_resource.h"
 #include "dali/core/mm/memory.h"
@@ -195,12 +197,30 @@ class DynamicScratchpad
 
     auto &r = resource<Kind>();
     if (!r.get_upstream()) {
+      if (!std::is_same<Kind, mm::memory_kind::host>::value)
+        CheckNotCapturing();
       InitResource(type_tag<Kind>());
       assert(r.get_upstream() != nullptr);
     }
     return r.allocate(bytes, alignment);
   }
 
+  /**
+   * @brief Prevents the use of the scratchpad in a stream that's being captured in a CUDA graph.
+   *
+   * The memory is returned to the upstream resource when the scratchpad is destroyed, but
+   * a captured graph would keep using it when replayed.
+   */
+  void CheckNotCapturing() const {
+    if (!device_order_.is_device())
+      return;
+    cudaStreamCaptureStatus status = cudaStreamCaptureStatusNone;
+    CUDA_CALL(cudaStreamIsCapturing(device_order_.stream(), &status));
+    DALI_ENFORCE(status == cudaStreamCaptureStatusNone,
+                 "DynamicScratchpad cannot be used in a stream that's being captured "
+                 "in a CUDA graph.");
+  }
+
   AccessOrder device_order_, pinned_dealloc_order_, managed_dealloc_order_;
 };
 
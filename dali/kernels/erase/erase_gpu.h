@@ -47,11 +47,16 @@ namespace kernels {
  * to traverse every region - the hyperrectangle.
  *
  * Steps:
- * 1. In every block we first look for intersections with erased regions, to filter out only
- * the ones that we actually need.
- * 2. We check if the hyperrectangle is fully covered by erase region or not covered at all
- * to delegate to special cases - fill only or memcopy
- * 3. If we have mixed cover, we check each coordinate and either copy the input or the fill value
+ * 1. A separate binning pass, with one thread per erase region, visits only the
+ * hyperrectangles that the erase region overlaps: the ones it contains are marked as fully
+ * covered and the others get the index of the erase region appended to their bin.
+ * This way the cost of finding the erase regions relevant for a block doesn't depend on the
+ * total number of erase regions in the sample.
+ * 2. Every block reads the bin of its hyperrectangle to delegate to special cases - fill only
+ * for full cover, memcopy (or nothing at all, when working in place) for no cover.
+ * 3. If we have mixed cover, we check each coordinate against the erase regions from the bin
+ * and either copy the input or the fill value. When the bin overflows, the block falls back
+ * to filtering all the erase regions of the sample.
  *
  * The processing of hyperrectangle of n-dims is done by n-nested for loop from outer to innermost
  * dimension.
@@ -69,12 +74,32 @@ using box = Box<ndim, T>;
 template <int ndim>
 using ibox = box<int32_t, ndim>;
 
+/**
+ * @brief The maximum number of partially overlapping erase regions stored in a bin
+ */
+constexpr int kEraseBinCapacity = 30;
+
+/**
+ * @brief The erase regions overlapping one of the hyperrectangles covering a sample
+ */
+struct erase_region_bin {
+  /// the number of erase regions overlapping, but not containing, the hyperrectangle;
+  /// can exceed kEraseBinCapacity, in which case the list is incomplete
+  int count;
+  /// nonzero if any of the erase regions contains the whole hyperrectangle
+  int full_cover;
+  /// indices of the overlapping erase regions
+  int regions[kEraseBinCapacity];
+};
+
 template <typename T, int ndim>
 struct erase_sample_desc {
-  const T * __restrict__ in = nullptr;
-  T * __restrict__ out = nullptr;
+  // in and out can alias - the operation can be done in place
+  const T *in = nullptr;
+  T *out = nullptr;
   const T* fill_values = nullptr;
   span<const ibox<ndim>> erase_regions = {};
+  erase_region_bin *bins = nullptr;
   ivec<ndim> sample_shape;
   ivec<ndim> sample_stride;
 };
@@ -122,7 +147,7 @@ constexpr bool is_outer_loops(int ndim, int current_dim, int channel_dim) {
 template <typename Worker, int channel_dim, int current_dim = 0, typename T, int ndim>
 __device__ std::enable_if_t<is_outer_loops(ndim, current_dim, channel_dim)>
 erase_generic(erase_sample_desc<T, ndim> sample, ibox<ndim> region,
-              span<ibox<ndim>> erase_regions = {}, ivec<ndim> coordinate = {},
+              span<const ibox<ndim>> erase_regions = {}, ivec<ndim> coordinate = {},
               int64_t offset_base = 0) {
   constexpr int d = current_dim;
   int boundary = ::min(region.hi[d], sample.sample_shape[d]);
@@ -145,7 +170,7 @@ erase_generic(erase_sample_desc<T, ndim> sample, ibox<ndim> region,
 template <typename Worker, int channel_dim, int current_dim = 0, typename T, int ndim>
 __device__ std::enable_if_t<ndim - current_dim == 2 && channel_dim < ndim - 2>
 erase_generic(erase_sample_desc<T, ndim> sample, ibox<ndim> region,
-              span<ibox<ndim>> erase_regions = {}, ivec<ndim> coordinate = {},
+              span<const ibox<ndim>> erase_regions = {}, ivec<ndim> coordinate = {},
               int64_t offset_base = 0) {
   constexpr int d = current_dim;
   constexpr int dY = d;
@@ -179,7 +204,7 @@ erase_generic(erase_sample_desc<T, ndim> sample, ibox<ndim> region,
 template <typename Worker, int channel_dim, int current_dim = 0, typename T, int ndim>
 __device__ std::enable_if_t<ndim - current_dim == 3 && channel_dim >= ndim - 2>
 erase_generic(erase_sample_desc<T, ndim> sample, ibox<ndim> region,
-              span<ibox<ndim>> erase_regions = {}, ivec<ndim> coordinate = {},
+              span<const ibox<ndim>> erase_regions = {}, ivec<ndim> coordinate = {},
               int64_t offset_base = 0) {
   constexpr int d = current_dim;
   constexpr int dY = d;
@@ -221,7 +246,7 @@ erase_generic(erase_sample_desc<T, ndim> sample, ibox<ndim> region,
  */
 template <typename Worker, int channel_dim, int current_dim = 0, typename T, int ndim>
 __device__ std::enable_if_t<ndim == 1> erase_generic(erase_sample_desc<T, ndim> sample,
-    ibox<ndim> region, span<ibox<ndim>> erase_regions = {},
+    ibox<ndim> region, span<const ibox<ndim>> erase_regions = {},
     ivec<ndim> coordinate = {}, int64_t offset_base = 0) {
   constexpr int d = current_dim;
   int boundary = ::min(region.hi[d], sample.sample_shape[d]);
@@ -242,7 +267,8 @@ __device__ std::enable_if_t<ndim == 1> erase_generic(erase_sample_desc<T, ndim>
 template <typename Worker, int channel_dim, int current_dim = 0, typename T, int ndim>
 __device__ std::enable_if_t<(ndim == 2 && current_dim == 0 && channel_dim >= 0)> erase_generic(
     erase_sample_desc<T, ndim> sample, ibox<ndim> region,
-    span<ibox<ndim>> erase_regions = {}, ivec<ndim> coordinate = {}, int64_t offset_base = 0) {
+    span<const ibox<ndim>> erase_regions = {}, ivec<ndim> coordinate = {},
+    int64_t offset_base = 0) {
   constexpr int d = current_dim;
   constexpr int dC = d + 1;
   int boundary = ::min(region.hi[d], sample.sample_shape[d]);
@@ -263,7 +289,7 @@ __device__ std::enable_if_t<(ndim == 2 && current_dim == 0 && channel_dim >= 0)>
 struct do_copy {
   template <int channel_dim, typename T, int ndim>
   __device__ static void copy_or_erase(erase_sample_desc<T, ndim> sample,
-                                       span<ibox<ndim>> erase_regions, ivec<ndim> coordinate,
+                                       span<const ibox<ndim>> erase_regions, ivec<ndim> coordinate,
                                        int64_t offset) {
     (void)erase_regions;
     (void)coordinate;
@@ -274,7 +300,7 @@ struct do_copy {
 struct do_erase {
   template <int channel_dim, typename T, int ndim>
   __device__ static void copy_or_erase(erase_sample_desc<T, ndim> sample,
-                                       span<ibox<ndim>> erase_regions, ivec<ndim> coordinate,
+                                       span<const ibox<ndim>> erase_regions, ivec<ndim> coordinate,
                                        int64_t offset) {
     (void)erase_regions;
     if (channel_dim == -1) {
@@ -288,7 +314,7 @@ struct do_erase {
 struct do_copy_or_erase {
   template <int channel_dim, typename T, int ndim>
   __device__ static void copy_or_erase(erase_sample_desc<T, ndim> sample,
-                                       span<ibox<ndim>> erase_regions, ivec<ndim> coordinate,
+                                       span<const ibox<ndim>> erase_regions, ivec<ndim> coordinate,
                                        int64_t offset) {
     auto fill_value =
         channel_dim == -1 ? sample.fill_values[0] : sample.fill_values[coordinate[channel_dim]];
@@ -297,18 +323,64 @@ struct do_copy_or_erase {
 
   template <int channel_dim, typename T, int ndim>
   __device__ static void copy_or_erase(erase_sample_desc<T, ndim> sample,
-                                       span<ibox<ndim>> erase_regions, ivec<ndim> coordinate,
+                                       span<const ibox<ndim>> erase_regions, ivec<ndim> coordinate,
                                        int64_t offset, T fill_value) {
     bool copy = true;
     for (auto &region : erase_regions) {
       if (region.contains(coordinate)) {
         copy = false;
+        break;
       }
     }
-    sample.out[offset] = copy ? sample.in[offset] : fill_value;
+    if (!copy)
+      sample.out[offset] = fill_value;
+    else if (sample.in != sample.out)
+      sample.out[offset] = sample.in[offset];
   }
 };
 
+/**
+ * @brief Assigns the erase regions to the bins of the hyperrectangles they overlap
+ *
+ * Grid: (number of erase regions / blockDim.x, number of samples, 1) - one thread per erase
+ * region. The bins must be zero-initialized.
+ */
+template <typename T, int ndim>
+__global__ void erase_bin_regions(const erase_sample_desc<T, ndim> *samples,
+                                  ivec<ndim> region_shape) {
+  const auto &sample = samples[blockIdx.y];
+  const int erase_region_idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (erase_region_idx >= sample.erase_regions.size())
+    return;
+
+  auto erase_region = intersection(sample.erase_regions[erase_region_idx],
+                                   ibox<ndim>(ivec<ndim>(), sample.sample_shape));
+  if (erase_region.empty())
+    return;
+
+  auto region_cover_strides = GetStrides(div_ceil(sample.sample_shape, region_shape));
+  ivec<ndim> first = erase_region.lo / region_shape;
+  ivec<ndim> extent = div_ceil(erase_region.hi, region_shape) - first;
+  int num_regions = volume(extent);
+  for (int i = 0; i < num_regions; i++) {
+    ivec<ndim> position;
+    for (int d = ndim - 1, idx = i; d >= 0; d--) {
+      position[d] = first[d] + idx % extent[d];
+      idx /= extent[d];
+    }
+    ivec<ndim> region_start = position * region_shape;
+    ibox<ndim> region_box(region_start, min(region_start + region_shape, sample.sample_shape));
+    auto &bin = sample.bins[dot(position, region_cover_strides)];
+    if (erase_region.contains(region_box)) {
+      bin.full_cover = 1;
+    } else {
+      int slot = atomicAdd(&bin.count, 1);
+      if (slot < kEraseBinCapacity)
+        bin.regions[slot] = erase_region_idx;
+    }
+  }
+}
+
 template <int channel_dim = -1, typename T, int ndim = 2>
 __global__ void erase_gpu_impl(const erase_sample_desc<T, ndim> *samples,
                                ivec<ndim> region_shape) {
@@ -318,47 +390,61 @@ __global__ void erase_gpu_impl(const erase_sample_desc<T, ndim> *samples,
   const auto &sample = samples[sample_idx];
   ivec<ndim> sample_shape = sample.sample_shape;
 
+  if (static_cast<int>(region_idx) >= volume(div_ceil(sample_shape, region_shape)))
+    return;
+
   auto region_box = get_region(region_idx, region_shape, sample_shape);
+  const auto &bin = sample.bins[region_idx];
+  const int bin_count = bin.count;
+
+  if (bin.full_cover) {
+    // do a total erase
+    erase_generic<do_erase, channel_dim>(sample, region_box);
+    return;
+  } else if (bin_count == 0) {
+    // do a full copy - or nothing, if the output is the input
+    if (sample.in != sample.out)
+      erase_generic<do_copy, channel_dim>(sample, region_box);
+    return;
+  }
 
-  const auto *erase_regions_ptrs = sample.erase_regions.data();
-  const auto erase_regions_count = sample.erase_regions.size();
   constexpr int max_regions = 40 * 1024 / sizeof(ibox<ndim>);
   __shared__ ibox<ndim> erase_regions[max_regions];
   __shared__ int filtered_region_idx;
+  const int thread_idx = threadIdx.y * blockDim.x + threadIdx.x;
+  const int num_threads = blockDim.y * blockDim.x;
 
-  filtered_region_idx = 0;
-  __syncthreads();
-  int full_cover = false;
+  if (bin_count <= kEraseBinCapacity) {
+    for (int i = thread_idx; i < bin_count; i += num_threads)
+      erase_regions[i] = sample.erase_regions[bin.regions[i]];
+    __syncthreads();
+    erase_generic<do_copy_or_erase, channel_dim>(sample, region_box,
+                                                 make_cspan(erase_regions, bin_count));
+    return;
+  }
 
-  // check which erase_regions overlap with current region_box
-  for (int i = threadIdx.y * blockDim.x + threadIdx.x; i < erase_regions_count;
-       i += blockDim.y * blockDim.x) {
+  // the bin overflowed - check which erase_regions overlap with current region_box
+  const auto *erase_regions_ptrs = sample.erase_regions.data();
+  const auto erase_regions_count = sample.erase_regions.size();
+  if (thread_idx == 0)
+    filtered_region_idx = 0;
+  __syncthreads();
+  for (int i = thread_idx; i < erase_regions_count; i += num_threads) {
     if (erase_regions_ptrs[i].overlaps(region_box)) {
-      erase_regions[atomicAdd(&filtered_region_idx, 1)] = erase_regions_ptrs[i];
-      if (erase_regions_ptrs[i].contains(region_box)) {
-        full_cover = true;
-        break;
-      }
+      int idx = atomicAdd(&filtered_region_idx, 1);
+      if (idx < max_regions)
+        erase_regions[idx] = erase_regions_ptrs[i];
     }
   }
   __syncthreads();
 
-  //  Check if we have full or no cover at all
   int total_erase_regions = filtered_region_idx;
-  int is_fully_erased = __any_sync(FULL_MASK, full_cover);
-
-  if (total_erase_regions == 0) {
-    // do a full copy
-    erase_generic<do_copy, channel_dim>(sample, region_box);
-    return;
-  } else if (is_fully_erased) {
-    // do a total erase
-    erase_generic<do_erase, channel_dim>(sample, region_box,
-                                         make_span(erase_regions, total_erase_regions));
-    return;
-  } else {
+  if (total_erase_regions <= max_regions) {
     erase_generic<do_copy_or_erase, channel_dim>(sample, region_box,
-                                                 make_span(erase_regions, total_erase_regions));
+                                                 make_cspan(erase_regions, total_erase_regions));
+  } else {
+    // too many to fit in the shared memory - use all the erase regions of the sample
+    erase_generic<do_copy_or_erase, channel_dim>(sample, region_box, sample.erase_regions);
   }
 }
 
@@ -465,6 +551,9 @@ struct EraseGpu {
    * * contain 1 element - the single value is used to fill the erased regions
    * * if channel_dim >= 0, it can contain as many elements as the specified channel_dimension,
    *   one value per channel is used when filling the erased regions
+   *
+   * `out` and `in` can point to the same memory - then the parts of the samples not overlapped
+   * by any of the erased regions are not accessed at all.
    */
   void Run(KernelContext &ctx,
            OutListGPU<T, ndim> &out,
@@ -509,7 +598,7 @@ struct EraseGpu {
       region_dim[1] = 128;
       if (channel_dim >= 0) {
         const int channels = in.shape[0][channel_dim];
-        region_dim[channels] = channels;
+        region_dim[channel_dim] = channels;
       }
     } else {
       region_dim[0] = 32 * 32;
@@ -517,12 +606,19 @@ struct EraseGpu {
 
 
     int max_regions = 1;
+    int64_t total_bins = 0;
+    int max_erase_regions = 0;
     for (int i = 0; i < num_samples; i++) {
       auto region_cover = div_ceil(to_ivec(in.shape[i]), region_dim);
       auto total_regions = volume(region_cover);
       // std::max was complaining
       max_regions = max_regions >= total_regions ? max_regions : total_regions;
+      total_bins += total_regions;
+      int erase_regions = erased_regions.tensor_shape(i).num_elements();
+      max_erase_regions = max_erase_regions >= erase_regions ? max_erase_regions : erase_regions;
     }
+    auto *bins = ctx.scratchpad->AllocateGPU<erase_region_bin>(total_bins);
+    CUDA_CALL(cudaMemsetAsync(bins, 0, total_bins * sizeof(erase_region_bin), stream));
     dim3 grid_dim = {(uint32_t)max_regions, (uint32_t)num_samples, 1};
     dim3 block_dim = {32, 32, 1};  // fixed block dim
 
@@ -534,6 +630,8 @@ struct EraseGpu {
       sample.out = out.data[i];
       sample.erase_regions = make_cspan(erased_regions.tensor_data(i),
                                         erased_regions.tensor_shape(i).num_elements());
+      sample.bins = bins;
+      bins += volume(div_ceil(to_ivec(in.shape[i]), region_dim));
       for (int dim = 0; dim < ndim; dim++) {
         sample.sample_shape[dim] = in.tensor_shape_span(i)[dim];
       }
@@ -545,6 +643,15 @@ struct EraseGpu {
     sample_t *sample_desc_gpu =
         ctx.scratchpad->ToGPU(ctx.gpu.stream, make_cspan(sample_desc_cpu, num_samples));
 
+    if (max_erase_regions > 0) {
+      constexpr int bin_block_size = 256;
+      dim3 bin_grid_dim = {(uint32_t)div_ceil(max_erase_regions, bin_block_size),
+                           (uint32_t)num_samples, 1};
+      erase_bin_regions<<<bin_grid_dim, bin_block_size, 0, stream>>>(sample_desc_gpu,
+                                                                     region_dim);
+      CUDA_CALL(cudaGetLastError());
+    }
+
     erase_gpu_impl<channel_dim><<<grid_dim, block_dim, 0, stream>>>(
         sample_desc_gpu, region_dim);
     CUDA_CALL(cudaGetLastError());
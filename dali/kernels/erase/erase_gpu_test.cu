@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cmath>
 #include <complex>
 #include <tuple>
@@ -92,7 +93,8 @@ TEST(EraseGpuKernelTest, CheckUtils) {
 enum class RegionGen {
   NO_ERASE,  ///< only copy, no erase
   FULL_ERASE,  ///< full, 1-element cover, only erase
-  RANDOM_ERASE  ///< randomly generated cover
+  RANDOM_ERASE,  ///< randomly generated cover
+  SMALL_RANDOM_ERASE  ///< randomly generated cover with regions of at most 8 in each dimension
 };
 
 enum class FillType {
@@ -109,6 +111,7 @@ struct EraseTestParams {
   RegionGen region_generation;
   FillType fill_type;
   TensorShape<ndim> shape;
+  bool in_place = false;
 };
 
 
@@ -123,6 +126,9 @@ std::ostream& operator<<(std::ostream& os, RegionGen p) {
     case RegionGen::RANDOM_ERASE:
       os << "RegionGen::RANDOM_ERASE";
       break;
+    case RegionGen::SMALL_RANDOM_ERASE:
+      os << "RegionGen::SMALL_RANDOM_ERASE";
+      break;
   }
   return os;
 }
@@ -152,7 +158,8 @@ std::ostream& operator<<(std::ostream& os, FillType p) {
 template <int ndim>
 std::ostream& operator<<(std::ostream& os, const EraseTestParams<ndim>& p) {
   os << "Num erase regions: " << p.max_erase_regions << ", region generation: "
-     << p.region_generation << ", fill type: " << p.fill_type << ", shape: " << p.shape;
+     << p.region_generation << ", fill type: " << p.fill_type << ", shape: " << p.shape
+     << (p.in_place ? ", in place" : "");
   return os;
 }
 
@@ -165,6 +172,7 @@ struct EraseGpuKernelTest :
     region_generation_ = params.region_generation;
     fill_type_ = params.fill_type;
     shape_ = params.shape;
+    in_place_ = params.in_place;
     test_shape_ = uniform_list_shape<ndim>(batch_size_, shape_);
 
     input_.reshape(test_shape_);
@@ -196,7 +204,8 @@ struct EraseGpuKernelTest :
       std::cerr << ">> No cover" << std::endl;
     } else if (region_generation_ == RegionGen::FULL_ERASE) {
       std::cerr << ">> Full cover" << std::endl;
-    } else if (region_generation_ == RegionGen::RANDOM_ERASE) {
+    } else if (region_generation_ == RegionGen::RANDOM_ERASE ||
+               region_generation_ == RegionGen::SMALL_RANDOM_ERASE) {
       std::cerr << ">> Random cover of size: " << max_erase_regions_ << std::endl;
     }
     EraseGpu<T, ndim, channel_dim> kernel;
@@ -209,7 +218,14 @@ struct EraseGpuKernelTest :
 
     auto regions_gpu = regions_.gpu();
 
-    auto in_view = input_.gpu();
+    InListGPU<T, ndim> in_view = input_.gpu();
+    if (in_place_) {
+      // the output starts as a copy of the input and is processed in place
+      auto out_cpu = output_.cpu();
+      SequentialFill(out_cpu);
+      in_view = output_.gpu();
+      output_.invalidate_cpu();
+    }
 
     auto req = kernel.Setup(ctx, in_view);
 
@@ -302,7 +318,8 @@ struct EraseGpuKernelTest :
         auto regions_tv = regions_cpu[i];
         *regions_tv(0) = ibox<ndim>({0}, to_ivec(shape_));
       }
-    } else if (region_generation_ == RegionGen::RANDOM_ERASE) {
+    } else {
+      bool small = region_generation_ == RegionGen::SMALL_RANDOM_ERASE;
       for (int i = 0; i < batch_size_; i++) {
         auto regions_tv = regions_cpu[i];
         for (int j = 0; j < regions_tv.shape[0]; j ++) {
@@ -310,7 +327,8 @@ struct EraseGpuKernelTest :
           for (int d = 0; d < ndim; d++) {
             std::uniform_int_distribution<>  start_dim(0, shape_[d] - 1);
             region_box.lo[d] = start_dim(gen);
-            std::uniform_int_distribution<>  end_dim(region_box.lo[d] + 1, shape_[d]);
+            int max_end = small ? std::min<int>(region_box.lo[d] + 8, shape_[d]) : shape_[d];
+            std::uniform_int_distribution<>  end_dim(region_box.lo[d] + 1, max_end);
             region_box.hi[d] = end_dim(gen);
           }
           *regions_tv(j) = region_box;
@@ -325,6 +343,7 @@ struct EraseGpuKernelTest :
   std::vector<T> fill_values_const_;
   TestTensorList<T, 1> fill_values_tl_;
   TensorShape<ndim> shape_;
+  bool in_place_;
   TensorListShape<ndim> test_shape_;
   constexpr static int batch_size_ = 16;
   TestTensorList<T, ndim> input_, output_, baseline_;
@@ -378,6 +397,12 @@ std::vector<EraseTestParams<2>> values_2 = {
     {1, RegionGen::RANDOM_ERASE, FillType::MAGIC_42, {512, 1024}},
     {10, RegionGen::RANDOM_ERASE, FillType::MAGIC_42, {512, 1024}},
     {100, RegionGen::RANDOM_ERASE, FillType::MAGIC_42, {512, 1024}},
+    {1000, RegionGen::RANDOM_ERASE, FillType::MAGIC_42, {512, 1024}},
+    {3000, RegionGen::SMALL_RANDOM_ERASE, FillType::MAGIC_42, {512, 1024}},
+    {0, RegionGen::NO_ERASE, FillType::MAGIC_42, {512, 1024}, true},
+    {1, RegionGen::FULL_ERASE, FillType::MAGIC_42, {512, 1024}, true},
+    {100, RegionGen::RANDOM_ERASE, FillType::MAGIC_42, {512, 1024}, true},
+    {3000, RegionGen::SMALL_RANDOM_ERASE, FillType::MAGIC_42, {512, 1024}, true},
 };
 
 std::vector<EraseTestParams<2>> values_2NC = {
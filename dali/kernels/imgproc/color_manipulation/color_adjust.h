@@ -0,0 +1,89 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_COLOR_MANIPULATION_COLOR_ADJUST_H_
+#define DALI_KERNELS_IMGPROC_COLOR_MANIPULATION_COLOR_ADJUST_H_
+
+#include <cmath>
+#include "dali/core/convert.h"
+#include "dali/core/force_inline.h"
+#include "dali/core/geom/mat.h"
+#include "dali/core/geom/vec.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/math_util.h"
+
+namespace dali {
+namespace kernels {
+namespace color {
+
+/**
+ * @brief The per-sample parameters of a color adjustment: an affine transform of the input
+ *        pixel, an optional gamma correction and an affine transform to the output color space.
+ *
+ * Without the gamma correction, the output transform is composed into the first one
+ * (see Finalize), so only one 3x4 transform is applied to each pixel.
+ */
+struct ColorAdjustParams {
+  mat3 A = mat3::eye();
+  vec3 B = vec3(0);
+  /// The exponent of the gamma correction, applied to the values normalized to [0, range]
+  float gamma = 1;
+  float range = 1;
+  mat3 out_A = mat3::eye();
+  vec3 out_B = vec3(0);
+
+  DALI_HOST_DEV bool has_gamma() const {
+    return gamma != 1;
+  }
+
+  /// Folds the output transform into the first one, if there's no gamma correction
+  void Finalize() {
+    if (has_gamma())
+      return;
+    B = out_A * B + out_B;
+    A = out_A * A;
+    out_A = mat3::eye();
+    out_B = vec3(0);
+  }
+};
+
+DALI_HOST_DEV DALI_FORCEINLINE vec3 ApplyColorAdjust(const ColorAdjustParams &params, vec3 pixel) {
+  vec3 v = params.A * pixel + params.B;
+  if (!params.has_gamma())
+    return v;
+  for (int c = 0; c < 3; c++) {
+    float normalized = clamp(v[c] / params.range, 0.0f, 1.0f);
+    v[c] = params.range * powf(normalized, params.gamma);
+  }
+  return params.out_A * v + params.out_B;
+}
+
+/**
+ * @brief Applies the adjustment to a single 3-channel pixel.
+ */
+template <typename Out, typename In>
+DALI_HOST_DEV DALI_FORCEINLINE void ColorAdjustPixel(const ColorAdjustParams &params,
+                                                     Out *out, const In *in) {
+  vec3 pixel(static_cast<float>(in[0]), static_cast<float>(in[1]), static_cast<float>(in[2]));
+  vec3 v = ApplyColorAdjust(params, pixel);
+  out[0] = ConvertSat<Out>(v[0]);
+  out[1] = ConvertSat<Out>(v[1]);
+  out[2] = ConvertSat<Out>(v[2]);
+}
+
+}  // namespace color
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_COLOR_MANIPULATION_COLOR_ADJUST_H_
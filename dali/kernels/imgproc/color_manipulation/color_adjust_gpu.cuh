@@ -0,0 +1,90 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_COLOR_MANIPULATION_COLOR_ADJUST_GPU_CUH_
+#define DALI_KERNELS_IMGPROC_COLOR_MANIPULATION_COLOR_ADJUST_GPU_CUH_
+
+#include <cuda_runtime_api.h>
+#include <cstdint>
+#include "dali/core/cuda_error.h"
+#include "dali/core/util.h"
+#include "dali/kernels/imgproc/color_manipulation/color_adjust.h"
+
+namespace dali {
+namespace kernels {
+namespace color {
+
+template <typename Out, typename In>
+struct ColorAdjustSampleDesc {
+  Out *out;
+  const In *in;
+  /// The index of the first pixel of the sample in the flat pixel space of the batch
+  int64_t offset;
+  ColorAdjustParams params;
+};
+
+static constexpr int kColorAdjustBlockSize = 256;
+static constexpr int kColorAdjustPixelsPerThread = 8;
+
+/**
+ * @brief Applies the per-sample color adjustment to the 3-channel, interleaved pixels
+ *        of a batch.
+ *
+ * Each block processes a contiguous range of the flat pixel space of the batch, so a block
+ * can process many small samples and a large sample is split among many blocks.
+ *
+ * @param samples the samples, ordered by `offset`, without the empty ones
+ */
+template <typename Out, typename In>
+__global__ void ColorAdjustKernel(const ColorAdjustSampleDesc<Out, In> *samples, int nsamples,
+                                  int64_t total_pixels) {
+  int64_t block_pixels = int64_t(blockDim.x) * kColorAdjustPixelsPerThread;
+  int64_t start = blockIdx.x * block_pixels;
+  int64_t end = start + block_pixels < total_pixels ? start + block_pixels : total_pixels;
+  // the last sample which starts at or before the first pixel of the block
+  int lo = 0, hi = nsamples - 1;
+  while (lo < hi) {
+    int mid = (lo + hi + 1) >> 1;
+    if (samples[mid].offset <= start)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  int s = lo;
+  for (int64_t p = start + threadIdx.x; p < end; p += blockDim.x) {
+    while (s + 1 < nsamples && samples[s + 1].offset <= p)
+      s++;
+    const auto &sample = samples[s];
+    int64_t idx = (p - sample.offset) * 3;
+    ColorAdjustPixel(sample.params, sample.out + idx, sample.in + idx);
+  }
+}
+
+template <typename Out, typename In>
+void LaunchColorAdjust(const ColorAdjustSampleDesc<Out, In> *samples_dev, int nsamples,
+                       int64_t total_pixels, cudaStream_t stream) {
+  if (nsamples == 0 || total_pixels == 0)
+    return;
+  unsigned num_blocks = div_ceil(total_pixels,
+                                 int64_t(kColorAdjustBlockSize) * kColorAdjustPixelsPerThread);
+  ColorAdjustKernel<<<num_blocks, kColorAdjustBlockSize, 0, stream>>>(samples_dev, nsamples,
+                                                                      total_pixels);
+  CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace color
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_COLOR_MANIPULATION_COLOR_ADJUST_GPU_CUH_
@@ -0,0 +1,78 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include "dali/kernels/imgproc/color_manipulation/color_adjust.h"
+
+namespace dali {
+namespace kernels {
+namespace color {
+
+namespace {
+
+ColorAdjustParams TestParams(float gamma) {
+  ColorAdjustParams p;
+  p.A = {{{0.5f, 0.1f, 0.0f}, {0.0f, 1.2f, 0.1f}, {0.2f, 0.0f, 0.9f}}};
+  p.B = vec3(10, -5, 3);
+  p.gamma = gamma;
+  p.range = 255;
+  p.out_A = {{{0.f, 0.f, 1.f}, {0.f, 1.f, 0.f}, {1.f, 0.f, 0.f}}};
+  p.out_B = vec3(1, 2, 3);
+  return p;
+}
+
+}  // namespace
+
+TEST(ColorAdjust, FinalizeComposesTransforms) {
+  auto p = TestParams(1);
+  vec3 pixel(100, 50, 200);
+  vec3 expected = p.out_A * (p.A * pixel + p.B) + p.out_B;
+  p.Finalize();
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++)
+      EXPECT_EQ(p.out_A(i, j), i == j ? 1 : 0);
+    EXPECT_EQ(p.out_B[i], 0);
+  }
+  vec3 out = ApplyColorAdjust(p, pixel);
+  for (int c = 0; c < 3; c++)
+    EXPECT_NEAR(out[c], expected[c], 1e-3f);
+}
+
+TEST(ColorAdjust, Gamma) {
+  auto p = TestParams(2.2f);
+  p.Finalize();  // no-op with the gamma correction
+  vec3 pixel(100, 50, 300);
+  vec3 v = p.A * pixel + p.B;
+  vec3 corrected;
+  for (int c = 0; c < 3; c++) {
+    float normalized = std::min(std::max(v[c] / 255, 0.0f), 1.0f);
+    corrected[c] = 255 * std::pow(normalized, 2.2f);
+  }
+  vec3 expected = p.out_A * corrected + p.out_B;
+  vec3 out = ApplyColorAdjust(p, pixel);
+  for (int c = 0; c < 3; c++)
+    EXPECT_NEAR(out[c], expected[c], 1e-3f);
+
+  uint8_t out_pixel[3];
+  float in_pixel[3] = {100, 50, 300};
+  ColorAdjustPixel(p, out_pixel, in_pixel);
+  for (int c = 0; c < 3; c++)
+    EXPECT_EQ(out_pixel[c], ConvertSat<uint8_t>(expected[c]));
+}
+
+}  // namespace color
+}  // namespace kernels
+}  // namespace dali
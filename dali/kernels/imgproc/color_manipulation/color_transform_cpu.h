@@ -0,0 +1,127 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_COLOR_MANIPULATION_COLOR_TRANSFORM_CPU_H_
+#define DALI_KERNELS_IMGPROC_COLOR_MANIPULATION_COLOR_TRANSFORM_CPU_H_
+
+#include <cstdint>
+#include <type_traits>
+#include "dali/core/convert.h"
+#include "dali/core/force_inline.h"
+#include "dali/core/geom/mat.h"
+#include "dali/core/geom/vec.h"
+#include "dali/kernels/common/simd.h"
+
+namespace dali {
+namespace kernels {
+namespace color {
+
+namespace detail {
+
+/**
+ * @brief Whether the values of type T can be loaded and stored with the float vectors
+ *        of simd.h
+ */
+template <typename T>
+struct is_simd_pixel_type : std::integral_constant<bool,
+    std::is_same<T, uint8_t>::value || std::is_same<T, int8_t>::value ||
+    std::is_same<T, uint16_t>::value || std::is_same<T, int16_t>::value ||
+    std::is_same<T, int32_t>::value || std::is_same<T, float>::value> {};
+
+template <typename Out, typename In>
+DALI_FORCEINLINE void TransformPixel3(Out *out, const In *in, const mat3 &M, const vec3 &T) {
+  vec3 v_in;
+  for (int c = 0; c < 3; c++)
+    v_in[c] = in[c];
+  vec3 v_out = M * v_in + T;
+  for (int c = 0; c < 3; c++)
+    out[c] = ConvertSat<Out>(v_out[c]);
+}
+
+template <typename Out, typename In>
+DALI_FORCEINLINE int64_t TransformPixels3Vec(Out *, const In *, int64_t, const mat3 &,
+                                             const vec3 &, std::false_type) {
+  return 0;
+}
+
+/**
+ * @brief Processes the pixels in blocks of 16, returns the number of the pixels processed
+ */
+template <typename Out, typename In>
+inline int64_t TransformPixels3Vec(Out *out, const In *in, int64_t npixels,
+                                   const mat3 &M, const vec3 &T, std::true_type) {
+#ifdef DALI_SIMD_FLOAT4
+  // 16 pixels of 3 channels fill a whole number of vectors of any of the supported types
+  constexpr int kBlock = 16;
+  constexpr int kVecs = kBlock * 3 / 4;
+  using block_t = simd::multivec<kVecs>;
+  simd::float4_t m[3][3], t[3];  // NOLINT
+  for (int i = 0; i < 3; i++) {
+    t[i] = simd::set1_f(T[i]);
+    for (int j = 0; j < 3; j++)
+      m[i][j] = simd::set1_f(M(i, j));
+  }
+  int64_t i = 0;
+  for (; i + kBlock <= npixels; i += kBlock) {
+    block_t block = block_t::load(in + i * 3);
+    for (int q = 0; q < kVecs; q += 3) {
+      simd::float4x<3> px = {{ block.v[q], block.v[q + 1], block.v[q + 2] }};
+      simd::deinterleave3(px);
+      simd::float4x<3> res;
+      for (int c = 0; c < 3; c++) {
+        // the same order of the operations as in the scalar M * in + T
+        simd::float4_t acc = simd::mul(m[c][0], px.v[0]);
+        acc = simd::madd(acc, m[c][1], px.v[1]);
+        acc = simd::madd(acc, m[c][2], px.v[2]);
+        acc = simd::add(acc, t[c]);
+        // round as ConvertSat does; the vectorized conversion would round the ties to even
+        res.v[c] = std::is_integral<Out>::value ? simd::round_away_f(acc) : acc;
+      }
+      simd::interleave3(res);
+      for (int c = 0; c < 3; c++)
+        block.v[q + c] = res.v[c];
+    }
+    simd::store(out + i * 3, block);
+  }
+  return i;
+#else
+  return 0;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @brief Applies an affine transform `out = M * in + T` to interleaved 3-channel pixels
+ *
+ * When SIMD is available (SSE2 or NEON, see simd.h) and both types can be loaded and stored
+ * as vectors of float (8, 16 and 32-bit integers, except uint32, and float), the pixels are
+ * processed in blocks of 16: the channels are deinterleaved in registers, transformed with
+ * vector multiply-adds and converted back with vectorized saturation. The remaining pixels
+ * are processed with the scalar code. Both paths round and saturate as ConvertSat.
+ */
+template <typename Out, typename In>
+void TransformPixels3(Out *out, const In *in, int64_t npixels, const mat3 &M, const vec3 &T) {
+  using vectorizable = std::integral_constant<bool,
+      detail::is_simd_pixel_type<Out>::value && detail::is_simd_pixel_type<In>::value>;
+  int64_t i = detail::TransformPixels3Vec(out, in, npixels, M, T, vectorizable());
+  for (; i < npixels; i++)
+    detail::TransformPixel3(out + i * 3, in + i * 3, M, T);
+}
+
+}  // namespace color
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_COLOR_MANIPULATION_COLOR_TRANSFORM_CPU_H_
@@ -0,0 +1,90 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "dali/kernels/imgproc/color_manipulation/color_transform_cpu.h"
+
+namespace dali {
+namespace kernels {
+namespace color {
+namespace test {
+
+template <typename Out, typename In>
+void CheckTransformPixels3(const mat3 &M, const vec3 &T, float lo, float hi) {
+  // a number of pixels which is not a multiple of the vector block
+  const int64_t npixels = 16 * 20 + 7;
+  std::vector<In> in(npixels * 3);
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> dist(lo, hi);
+  for (auto &x : in)
+    x = ConvertSat<In>(dist(rng));
+  // exact ties, which must be rounded away from zero, as in ConvertSat
+  for (int i = 0; i < 16; i++)
+    in[i] = ConvertSat<In>(i - 8);
+
+  std::vector<Out> out(npixels * 3), ref(npixels * 3);
+  TransformPixels3(out.data(), in.data(), npixels, M, T);
+  for (int64_t i = 0; i < npixels; i++) {
+    vec3 v_in;
+    for (int c = 0; c < 3; c++)
+      v_in[c] = in[i * 3 + c];
+    vec3 v_out = M * v_in + T;
+    for (int c = 0; c < 3; c++)
+      ref[i * 3 + c] = ConvertSat<Out>(v_out[c]);
+  }
+  for (int64_t i = 0; i < npixels * 3; i++)
+    ASSERT_EQ(static_cast<float>(out[i]), static_cast<float>(ref[i]))
+        << "at pixel " << i / 3 << ", channel " << i % 3;
+}
+
+TEST(TransformPixels3Test, YCbCr) {
+  mat3 M = {{{0.299f, 0.587f, 0.114f},
+             {-0.16873589f, -0.33126411f, 0.5f},
+             {0.5f, -0.41868759f, -0.08131241f}}};
+  vec3 T(0, 128, 128);
+  CheckTransformPixels3<uint8_t, uint8_t>(M, T, 0, 255);
+  CheckTransformPixels3<float, uint8_t>(M, T, 0, 255);
+  CheckTransformPixels3<uint8_t, float>(M, T, -50, 300);
+  CheckTransformPixels3<float, float>(M, T, -1, 1);
+}
+
+TEST(TransformPixels3Test, Ties) {
+  mat3 M = mat3::eye();
+  vec3 T(0.5f, -0.5f, 1.5f);
+  CheckTransformPixels3<int8_t, float>(M, T, -100, 100);
+  CheckTransformPixels3<int16_t, int16_t>(M, T, -1000, 1000);
+  CheckTransformPixels3<int32_t, int32_t>(M, T, -1e6, 1e6);
+}
+
+TEST(TransformPixels3Test, Saturation) {
+  mat3 M = {{{2.f, 0.f, 0.f}, {0.f, -1.f, 0.f}, {0.f, 0.f, 300.f}}};
+  vec3 T(-100, 0, 0);
+  CheckTransformPixels3<uint8_t, uint8_t>(M, T, 0, 255);
+  CheckTransformPixels3<int8_t, int16_t>(M, T, -500, 500);
+  CheckTransformPixels3<uint16_t, float>(M, T, -500, 500);
+}
+
+TEST(TransformPixels3Test, ScalarTypes) {
+  // float16 is not vectorized - the scalar path must be used
+  mat3 M = {{{0.f, 0.f, 1.f}, {0.f, 1.f, 0.f}, {1.f, 0.f, 0.f}}};
+  CheckTransformPixels3<float16, uint8_t>(M, vec3(), 0, 255);
+  CheckTransformPixels3<uint8_t, float16>(M, vec3(), 0, 255);
+}
+
+}  // namespace test
+}  // namespace color
+}  // namespace kernels
+}  // namespace dali
@@ -18,6 +18,7 @@
 #include <utility>
 #include "dali/core/convert.h"
 #include "dali/kernels/kernel.h"
+#include "dali/kernels/imgproc/color_manipulation/color_transform_cpu.h"
 #include "dali/kernels/imgproc/roi.h"
 
 namespace dali {
@@ -60,15 +61,15 @@ class HsvCpu {
     auto image_width = in.shape[1];
     auto ptr = out.data;
 
+    // h + hue, s * saturation, v * value, as an affine transform
+    mat3 M = {{{1.f, 0.f, 0.f}, {0.f, saturation, 0.f}, {0.f, 0.f, value}}};
+    vec3 T(hue, 0, 0);
+    int roi_width = adjusted_roi.hi.x - adjusted_roi.lo.x;
     ptrdiff_t row_stride = image_width * num_channels;
     auto *row = in.data + adjusted_roi.lo.y * row_stride;
     for (int y = adjusted_roi.lo.y; y < adjusted_roi.hi.y; y++) {
-      for (int x = adjusted_roi.lo.x; x < adjusted_roi.hi.x; x++) {
-        auto elem = row + x * num_channels;
-        *ptr++ = ConvertSat<OutputType>(*(elem + 0) + hue /*hue hue*/);
-        *ptr++ = ConvertSat<OutputType>(*(elem + 1) * saturation);
-        *ptr++ = ConvertSat<OutputType>(*(elem + 2) * value);
-      }
+      color::TransformPixels3(ptr, row + adjusted_roi.lo.x * num_channels, roi_width, M, T);
+      ptr += roi_width * hsv::kNchannels;
       row += row_stride;
     }
   }
@@ -0,0 +1,284 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_KERNELS_IMGPROC_CONVOLUTION_FFT_CONVOLUTION_GPU_H_
+#define DALI_KERNELS_IMGPROC_CONVOLUTION_FFT_CONVOLUTION_GPU_H_
+
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "dali/core/boundary.h"
+#include "dali/core/convert.h"
+#include "dali/core/format.h"
+#include "dali/core/span.h"
+#include "dali/core/tensor_view.h"
+#include "dali/kernels/imgproc/convolution/convolution_gpu.h"
+#include "dali/kernels/imgproc/convolution/fft_convolver_gpu.h"
+#include "dali/kernels/kernel.h"
+
+namespace dali {
+namespace kernels {
+
+namespace fft_conv {
+
+template <typename Out, typename In>
+struct SampleDesc {
+  Out *out;
+  const In *in;
+  int64_t first_row;  // the buffer row of the first signal of the sample
+  int64_t outer;      // volume of the dimensions preceding the axis
+  int64_t inner;      // volume of the dimensions following the axis (including channels)
+  int extent;         // extent of the axis
+  int anchor;
+  float alpha;
+};
+
+/**
+ * @brief Writes the signals along the axis, extended with border reflect 101 by `anchor`
+ *        on both sides and zero-padded to the transform size, to the buffer rows.
+ *
+ * blockIdx.y is the sample index.
+ */
+template <typename Out, typename In>
+__global__ void PackSignals(float *buffer, int64_t pitch, int transform_size,
+                            const SampleDesc<Out, In> *samples) {
+  const auto sample = samples[blockIdx.y];
+  if (sample.extent == 0)
+    return;
+  int padded_extent = sample.extent + 2 * sample.anchor;
+  int64_t n = sample.outer * transform_size * sample.inner;
+  for (int64_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < n;
+       idx += static_cast<int64_t>(gridDim.x) * blockDim.x) {
+    int64_t c = idx % sample.inner;
+    int64_t tmp = idx / sample.inner;
+    int j = static_cast<int>(tmp % transform_size);
+    int64_t o = tmp / transform_size;
+    float v = 0;
+    if (j < padded_extent) {
+      int src = boundary::idx_reflect_101(j - sample.anchor, sample.extent);
+      v = static_cast<float>(sample.in[(o * sample.extent + src) * sample.inner + c]);
+    }
+    buffer[(sample.first_row + o * sample.inner + c) * pitch + j] = v;
+  }
+}
+
+/**
+ * @brief Stores the correlated signals the output, applying the epilogue
+ *
+ * blockIdx.y is the sample index.
+ */
+template <typename Out, typename In>
+__global__ void UnpackSignals(const SampleDesc<Out, In> *samples, const float *buffer,
+                              int64_t pitch, float beta) {
+  const auto sample = samples[blockIdx.y];
+  int64_t n = sample.outer * sample.extent * sample.inner;
+  for (int64_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < n;
+       idx += static_cast<int64_t>(gridDim.x) * blockDim.x) {
+    int64_t c = idx % sample.inner;
+    int64_t tmp = idx / sample.inner;
+    int64_t i = tmp % sample.extent;
+    int64_t o = tmp / sample.extent;
+    float v = sample.alpha * buffer[(sample.first_row + o * sample.inner + c) * pitch + i];
+    if (beta != 0)
+      v += beta * static_cast<float>(sample.out[idx]);
+    sample.out[idx] = ConvertSat<Out>(v);
+  }
+}
+
+}  // namespace fft_conv
+
+/**
+ * @brief Apply a convolution with a 1-channel `window` in the specified axis, in the frequency
+ *        domain.
+ *
+ * It's a drop-in replacement for ConvolutionGpu (the same border handling, the same formula and
+ * the same epilogue), meant for large windows: the cost per output element grows with
+ * the logarithm of the transformed length instead of the window size. There's also no limit on
+ * the size of the window.
+ *
+ * The signals along the axis are extended with border reflect 101 and transformed in batches -
+ * see FFTConvolverGpu. The computation is done in single precision.
+ *
+ * Only odd windows with centered anchor are supported.
+ */
+template <typename Out, typename In, typename W, int ndim, int axis, bool has_channels = true>
+struct FFTConvolutionGpu {
+  static_assert(std::is_same<W, float>::value, "FFTConvolutionGpu supports only float windows");
+  static constexpr int kLastSpatialDim = ndim - has_channels - 1;
+  static_assert(0 <= axis && axis <= kLastSpatialDim,
+                "Selected axis must be in [0, ndim) when there is no channel axis, or in [0, ndim "
+                "- 1) for channel-last input");
+
+  using SampleDesc = fft_conv::SampleDesc<Out, In>;
+
+  KernelRequirements Setup(KernelContext& ctx, const TensorListShape<ndim>& in_shape,
+                           const TensorListShape<1>& window_size) {
+    DALI_ENFORCE(
+        in_shape.size() == window_size.size(),
+        make_string(
+            "Provided input shape and window sizes should have the same number of samples. Got: ",
+            in_shape.size(), " vs ", window_size.size(), "."));
+    int num_samples = in_shape.size();
+    signals_per_sample_.resize(num_samples);
+    int64_t num_signals = 0;
+    int min_size = 1;
+    for (int i = 0; i < num_samples; i++) {
+      DALI_ENFORCE(
+          window_size[i][0] % 2 == 1,
+          make_string(
+              "Even or non-centered windows are not supported yet, got window with even length: ",
+              window_size, " for sample ", i, "."));
+      auto sample_shape = in_shape[i];
+      signals_per_sample_[i] =
+          sample_shape[axis] > 0 ? volume(sample_shape) / sample_shape[axis] : 0;
+      num_signals += signals_per_sample_[i];
+      min_size = std::max<int>(min_size, sample_shape[axis] + window_size[i][0] - 1);
+    }
+    transform_size_ = FFTConvolverGpu::TransformSize(min_size);
+
+    ScratchpadEstimator se;
+    se.add<mm::memory_kind::device, SampleDesc>(num_samples);
+    convolver_.Setup(se, transform_size_, num_samples, num_signals);
+
+    KernelRequirements req;
+    req.scratch_sizes = se.sizes;
+    req.output_shapes.push_back(in_shape);
+    return req;
+  }
+
+  void Run(KernelContext& ctx, const TensorListView<StorageGPU, Out, ndim> out,
+           const TensorListView<StorageGPU, const In, ndim>& in,
+           const TensorListView<StorageCPU, const W, 1>& windows,
+           const span<const int> window_anchors = {}, const ConvEpilogue& conv_epilogue = 1.f) {
+    int num_samples = in.size();
+    int num_scales = conv_epilogue.num_samples();
+
+    DALI_ENFORCE(
+        window_anchors.size() == num_samples || window_anchors.size() == 0,
+        make_string(
+            "Unexpected number of window_anchors, expected either anchors for all samples ( ",
+            num_samples,
+            ") or no anchors for windows centered by default, got: ", window_anchors.size(), "."));
+
+    DALI_ENFORCE(
+        num_scales == 0 || num_scales == num_samples,
+        make_string(
+            "Scale argument must be either a scalar or a span of length equal to the batch size (",
+            num_samples, "), got: ", num_scales, "."));
+
+    samples_.resize(num_samples);
+    int64_t first_row = num_samples;  // the windows come first
+    int64_t max_volume = 0, max_padded_volume = 0;
+    for (int i = 0; i < num_samples; i++) {
+      int window_size = static_cast<int>(windows.tensor_shape_span(i)[0]);
+      int window_anchor = window_anchors.size() ? window_anchors[i] : window_size / 2;
+      DALI_ENFORCE(
+          window_anchor == window_size / 2,
+          make_string("Support for non-centered window is not yet implemented, got anchor: ",
+                      window_anchor, ", expected: ", window_size / 2, "."));
+      auto sample_shape = in.tensor_shape(i);
+      auto &sample = samples_[i];
+      sample.out = out.tensor_data(i);
+      sample.in = in.tensor_data(i);
+      sample.first_row = first_row;
+      sample.outer = volume(sample_shape.begin(), sample_shape.begin() + axis);
+      sample.inner = volume(sample_shape.begin() + axis + 1, sample_shape.end());
+      sample.extent = sample_shape[axis];
+      sample.anchor = window_anchor;
+      sample.alpha = conv_epilogue.alpha(i);
+      first_row += signals_per_sample_[i];
+      max_volume = std::max(max_volume, volume(sample_shape));
+      max_padded_volume = std::max(max_padded_volume, signals_per_sample_[i] * transform_size_);
+    }
+
+    SampleDesc *samples_gpu;
+    std::tie(samples_gpu) = ctx.scratchpad->ToContiguousGPU(ctx.gpu.stream, samples_);
+    float *buffer = convolver_.AllocateBuffers(ctx);
+    int64_t pitch = convolver_.RowPitch();
+
+    dim3 block(256);
+    auto grid = [&](int64_t max_elements) {
+      return dim3(std::max<int64_t>(std::min<int64_t>(div_ceil(max_elements, 4 * block.x), 1024),
+                                    1),
+                  num_samples);
+    };
+    if (num_samples > 0) {
+      fft_conv::PackSignals<<<grid(max_padded_volume), block, 0, ctx.gpu.stream>>>(
+          buffer, pitch, transform_size_, samples_gpu);
+      CUDA_CALL(cudaGetLastError());
+    }
+
+    convolver_.Run(ctx, windows, make_cspan(signals_per_sample_));
+
+    if (num_samples > 0) {
+      fft_conv::UnpackSignals<<<grid(max_volume), block, 0, ctx.gpu.stream>>>(
+          samples_gpu, buffer, pitch, conv_epilogue.beta());
+      CUDA_CALL(cudaGetLastError());
+    }
+  }
+
+ private:
+  FFTConvolverGpu convolver_;
+  int transform_size_ = 0;
+  std::vector<int64_t> signals_per_sample_;
+  std::vector<SampleDesc> samples_;
+};
+
+/**
+ * @brief Applies the convolution with ConvolutionGpu or, for large windows, with FFTConvolutionGpu
+ *
+ * The FFT-based implementation is used when any window in the batch has at least
+ * kFFTMinWindowSize elements.
+ */
+template <typename Out, typename In, typename W, int ndim, int axis, bool has_channels = true>
+struct AdaptiveConvolutionGpu {
+  /// The window size at which the FFT starts to outperform the GEMM-based convolution
+  static constexpr int kFFTMinWindowSize = 101;
+
+  KernelRequirements Setup(KernelContext& ctx, const TensorListShape<ndim>& in_shape,
+                           const TensorListShape<1>& window_size) {
+    int max_window_size = 0;
+    for (int i = 0; i < window_size.num_samples(); i++)
+      max_window_size = std::max<int>(max_window_size, window_size[i][0]);
+    use_fft_ = max_window_size >= kFFTMinWindowSize;
+    return use_fft_ ? fft_conv_.Setup(ctx, in_shape, window_size)
+                    : conv_.Setup(ctx, in_shape, window_size);
+  }
+
+  void Run(KernelContext& ctx, const TensorListView<StorageGPU, Out, ndim> out,
+           const TensorListView<StorageGPU, const In, ndim>& in,
+           const TensorListView<StorageCPU, const W, 1>& windows,
+           const span<const int> window_anchors = {}, const ConvEpilogue& conv_epilogue = 1.f) {
+    if (use_fft_)
+      fft_conv_.Run(ctx, out, in, windows, window_anchors, conv_epilogue);
+    else
+      conv_.Run(ctx, out, in, windows, window_anchors, conv_epilogue);
+  }
+
+  bool UsesFFT() const {
+    return use_fft_;
+  }
+
+ private:
+  ConvolutionGpu<Out, In, W, ndim, axis, has_channels> conv_;
+  FFTConvolutionGpu<Out, In, W, ndim, axis, has_channels> fft_conv_;
+  bool use_fft_ = false;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_CONVOLUTION_FFT_CONVOLUTION_GPU_H_
@@ -0,0 +1,147 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/imgproc/convolution/baseline_convolution.h"
+#include "dali/kernels/imgproc/convolution/fft_convolution_gpu.h"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+namespace kernels {
+
+TEST(FFTConvolverGpuTest, TransformSize) {
+  EXPECT_EQ(FFTConvolverGpu::TransformSize(1), 1);
+  EXPECT_EQ(FFTConvolverGpu::TransformSize(4), 4);
+  EXPECT_EQ(FFTConvolverGpu::TransformSize(9), 10);
+  EXPECT_EQ(FFTConvolverGpu::TransformSize(129), 160);
+  EXPECT_EQ(FFTConvolverGpu::TransformSize(161), 192);
+  EXPECT_EQ(FFTConvolverGpu::TransformSize(200), 224);
+  EXPECT_EQ(FFTConvolverGpu::TransformSize(225), 256);
+}
+
+template <typename Out, typename In, int ndim, int axis, bool has_channels>
+void TestFFTConvolution(const TensorListShape<ndim> &shape, const std::vector<int> &window_sizes,
+                        bool accumulate) {
+  int num_samples = shape.num_samples();
+  TestTensorList<float, 1> windows;
+  TensorListShape<1> window_shape(num_samples, 1);
+  for (int i = 0; i < num_samples; i++)
+    window_shape.set_tensor_shape(i, {window_sizes[i]});
+  windows.reshape(window_shape);
+  auto windows_cpu = windows.cpu();
+  for (int i = 0; i < num_samples; i++) {
+    int r = window_sizes[i] / 2;
+    float sigma = std::max(r / 3.0f, 0.5f), sum = 0;
+    for (int k = 0; k < window_sizes[i]; k++) {
+      windows_cpu[i].data[k] = std::exp(-0.5f * (k - r) * (k - r) / (sigma * sigma));
+      sum += windows_cpu[i].data[k];
+    }
+    for (int k = 0; k < window_sizes[i]; k++)
+      windows_cpu[i].data[k] /= sum;
+  }
+
+  TestTensorList<In, ndim> in;
+  TestTensorList<Out, ndim> out, ref;
+  in.reshape(shape);
+  out.reshape(shape);
+  ref.reshape(shape);
+  std::mt19937 rng(42);
+  UniformRandomFill(in.cpu(), rng, 0, 100);
+
+  std::vector<float> scales(num_samples);
+  for (int i = 0; i < num_samples; i++)
+    scales[i] = accumulate ? 1.0f / (i + 1) : 1.0f;
+  float beta = accumulate ? 1.0f : 0.0f;
+
+  // The reference: float convolution with the baseline implementation, followed by the epilogue
+  TestTensorList<float, ndim> in_float, conv;
+  in_float.reshape(shape);
+  conv.reshape(shape);
+  auto in_cpu = in.cpu();
+  auto in_float_cpu = in_float.cpu();
+  auto conv_cpu = conv.cpu();
+  auto ref_cpu = ref.cpu();
+  auto out_init = out.cpu();
+  for (int i = 0; i < num_samples; i++) {
+    int64_t vol = volume(shape[i]);
+    for (int64_t k = 0; k < vol; k++) {
+      in_float_cpu[i].data[k] = in_cpu[i].data[k];
+      out_init[i].data[k] = k % 7;
+    }
+    testing::BaselineConvolve(conv_cpu[i], in_float_cpu[i], windows_cpu[i], axis,
+                              window_sizes[i] / 2);
+    for (int64_t k = 0; k < vol; k++)
+      ref_cpu[i].data[k] = ConvertSat<Out>(scales[i] * conv_cpu[i].data[k] + beta * (k % 7));
+  }
+
+  FFTConvolutionGpu<Out, In, float, ndim, axis, has_channels> kernel;
+  KernelContext ctx;
+  ctx.gpu.stream = 0;
+  auto req = kernel.Setup(ctx, shape, window_shape);
+  ASSERT_EQ(req.output_shapes[0], shape);
+  DynamicScratchpad scratchpad({}, AccessOrder(ctx.gpu.stream));
+  ctx.scratchpad = &scratchpad;
+  ConvEpilogue epilogue(make_cspan(scales), beta);
+  kernel.Run(ctx, out.gpu(), in.gpu(), windows.cpu(), {}, epilogue);
+  out.invalidate_cpu();
+  auto out_cpu = out.cpu();
+  CUDA_CALL(cudaStreamSynchronize(ctx.gpu.stream));
+  double eps = std::is_integral<Out>::value ? 1 : 1e-2;
+  Check(out_cpu, ref_cpu, EqualEps(eps));
+}
+
+TEST(FFTConvolutionGpuTest, Inner) {
+  TensorListShape<3> shape = {{37, 120, 3}, {1, 250, 3}, {64, 1, 3}, {20, 7, 3}};
+  TestFFTConvolution<float, uint8_t, 3, 1, true>(shape, {101, 151, 121, 301}, false);
+}
+
+TEST(FFTConvolutionGpuTest, Outer) {
+  TensorListShape<3> shape = {{120, 37, 3}, {250, 1, 3}, {1, 64, 3}, {7, 20, 3}};
+  TestFFTConvolution<float, uint8_t, 3, 0, true>(shape, {101, 151, 121, 301}, false);
+}
+
+TEST(FFTConvolutionGpuTest, OuterNoChannelsAccumulate) {
+  TensorListShape<2> shape = {{300, 40}, {90, 90}, {5, 3}};
+  TestFFTConvolution<float, float, 2, 0, false>(shape, {201, 101, 31}, true);
+}
+
+TEST(FFTConvolutionGpuTest, MiddleAxisIntegerOutput) {
+  TensorListShape<4> shape = {{6, 50, 40, 2}, {3, 128, 9, 1}};
+  TestFFTConvolution<int16_t, int16_t, 4, 1, true>(shape, {105, 131}, false);
+}
+
+TEST(AdaptiveConvolutionGpuTest, Selection) {
+  using Kernel = AdaptiveConvolutionGpu<float, float, float, 2, 0, false>;
+  Kernel kernel;
+  KernelContext ctx;
+  TensorListShape<2> shape = {{100, 100}, {50, 50}};
+  TensorListShape<1> small_windows = {{7}, {Kernel::kFFTMinWindowSize - 2}};
+  TensorListShape<1> large_windows = {{7}, {Kernel::kFFTMinWindowSize}};
+  kernel.Setup(ctx, shape, small_windows);
+  EXPECT_FALSE(kernel.UsesFFT());
+  kernel.Setup(ctx, shape, large_windows);
+  EXPECT_TRUE(kernel.UsesFFT());
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -0,0 +1,280 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/kernels/imgproc/convolution/fft_convolver_gpu.h"
+#include <cufft.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/format.h"
+#include "dali/core/util.h"
+#include "dali/kernels/signal/fft/cufft_helper.h"
+
+namespace dali {
+namespace kernels {
+
+namespace fft_conv {
+
+/**
+ * @brief Multiplies the spectra of the signals by the conjugated spectra of their windows
+ *
+ * blockIdx.y is the window index; the signals of the window are the rows
+ * [num_windows + signal_offsets[w], num_windows + signal_offsets[w + 1]).
+ */
+__global__ void MultiplySpectra(float2 *spectra, int64_t pitch, int num_freqs, int num_windows,
+                                const int64_t *signal_offsets, float scale) {
+  int w = blockIdx.y;
+  const float2 *window = spectra + w * pitch;
+  int64_t first_row = num_windows + signal_offsets[w];
+  int64_t n = (signal_offsets[w + 1] - signal_offsets[w]) * num_freqs;
+  for (int64_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < n;
+       idx += static_cast<int64_t>(gridDim.x) * blockDim.x) {
+    int64_t row = idx / num_freqs;
+    int f = static_cast<int>(idx - row * num_freqs);
+    float2 h = window[f];
+    float2 &x = spectra[(first_row + row) * pitch + f];
+    float2 y;
+    y.x = (h.x * x.x + h.y * x.y) * scale;
+    y.y = (h.x * x.y - h.y * x.x) * scale;
+    x = y;
+  }
+}
+
+}  // namespace fft_conv
+
+class FFTConvolverImplGpu {
+ public:
+  void Setup(ScratchpadEstimator &se, int transform_size, int num_windows, int64_t num_signals) {
+    assert(transform_size > 0 && num_windows >= 0 && num_signals >= 0);
+    transform_size_ = transform_size;
+    num_windows_ = num_windows;
+    num_signals_ = num_signals;
+    CreatePlans(num_windows + num_signals);
+    num_rows_ = std::max(align_up(num_windows + num_signals, min_batch_),
+                         num_windows + align_up(num_signals, min_batch_));
+
+    se.add<mm::memory_kind::device, float>(num_rows_ * RowPitch(), kBufferAlignment);
+    se.add<mm::memory_kind::pinned, float>(num_windows * RowPitch());
+    se.add<mm::memory_kind::pinned, int64_t>(num_windows + 1);
+    se.add<mm::memory_kind::device, int64_t>(num_windows + 1);
+    se.add<mm::memory_kind::device, char>(max_work_size_, kBufferAlignment);
+  }
+
+  float *AllocateBuffers(KernelContext &ctx) {
+    int64_t pitch = RowPitch();
+    buffer_ = ctx.scratchpad->AllocateGPU<float>(num_rows_ * pitch, kBufferAlignment);
+    windows_host_ = ctx.scratchpad->AllocatePinned<float>(num_windows_ * pitch);
+    offsets_host_ = ctx.scratchpad->AllocatePinned<int64_t>(num_windows_ + 1);
+    offsets_gpu_ = ctx.scratchpad->AllocateGPU<int64_t>(num_windows_ + 1);
+    work_ = ctx.scratchpad->AllocateGPU<char>(max_work_size_, kBufferAlignment);
+    return buffer_;
+  }
+
+  int64_t RowPitch() const {
+    return 2 * (transform_size_ / 2 + 1);
+  }
+
+  int64_t NumRows() const {
+    return num_rows_;
+  }
+
+  void Run(KernelContext &ctx, const TensorListView<StorageCPU, const float, 1> &windows,
+           span<const int64_t> signals_per_window) {
+    assert(buffer_ != nullptr && "Missing call to AllocateBuffers");
+    DALI_ENFORCE(windows.num_samples() == num_windows_ &&
+                 signals_per_window.size() == num_windows_,
+                 "The number of windows doesn't match the one passed to Setup.");
+    cudaStream_t stream = ctx.gpu.stream;
+    int64_t pitch = RowPitch();
+
+    // The windows are zero-padded on the host and copied directly to their rows
+    std::fill(windows_host_, windows_host_ + num_windows_ * pitch, 0.0f);
+    int64_t *offsets = offsets_host_;
+    offsets[0] = 0;
+    for (int w = 0; w < num_windows_; w++) {
+      int64_t size = windows.tensor_shape_span(w)[0];
+      DALI_ENFORCE(size <= transform_size_, make_string("The window ", w, " is longer (", size,
+                   ") than the transform size (", transform_size_, ")."));
+      std::copy(windows.tensor_data(w), windows.tensor_data(w) + size, windows_host_ + w * pitch);
+      offsets[w + 1] = offsets[w] + signals_per_window[w];
+    }
+    DALI_ENFORCE(offsets[num_windows_] == num_signals_,
+                 "The number of signals doesn't match the one passed to Setup.");
+    if (num_signals_ == 0)
+      return;
+
+    CUDA_CALL(cudaMemcpyAsync(buffer_, windows_host_, num_windows_ * pitch * sizeof(float),
+                              cudaMemcpyHostToDevice, stream));
+    CUDA_CALL(cudaMemcpyAsync(offsets_gpu_, offsets, (num_windows_ + 1) * sizeof(int64_t),
+                              cudaMemcpyHostToDevice, stream));
+
+    Execute(true, stream, buffer_, num_windows_ + num_signals_);
+
+    int num_freqs = transform_size_ / 2 + 1;
+    int64_t max_signals = 0;
+    for (auto n : signals_per_window)
+      max_signals = std::max(max_signals, n);
+    int64_t max_elements = max_signals * num_freqs;
+    dim3 block(256);
+    dim3 grid(std::max<int64_t>(std::min<int64_t>(div_ceil(max_elements, 4 * block.x), 1024), 1),
+              num_windows_);
+    fft_conv::MultiplySpectra<<<grid, block, 0, stream>>>(
+        reinterpret_cast<float2 *>(buffer_), pitch / 2, num_freqs, num_windows_, offsets_gpu_,
+        1.0f / transform_size_);
+    CUDA_CALL(cudaGetLastError());
+
+    Execute(false, stream, buffer_ + num_windows_ * pitch, num_signals_);
+    buffer_ = nullptr;
+  }
+
+ private:
+  struct PlanInfo {
+    CUFFTHandle handle;
+    size_t work_size = 0;
+  };
+  /**
+   * The plans, keyed by the transform size and the number of rows they transform
+   * (a power of 2).
+   *
+   * The rows are decomposed into these buckets, so that batches of variable size samples reuse
+   * the plans. The work area is taken from the scratchpad and sized for the largest plan.
+   */
+  using PlanMap = std::map<std::pair<int, int>, PlanInfo>;
+
+  static constexpr int64_t kMaxSize = 1 << 24;
+  static constexpr int64_t kMinSize = 1 << 14;
+  static constexpr size_t kBufferAlignment = 256;
+
+  void CreatePlans(int64_t rows) {
+    int64_t pitch = RowPitch();
+    int64_t max_batch = next_pow2(std::max<int64_t>(rows, 1));
+    while (max_batch > 1 && max_batch * pitch > kMaxSize)
+      max_batch >>= 1;
+    max_batch_ = max_batch;
+    min_batch_ = std::min<int64_t>(max_batch_, next_pow2(std::max<int64_t>(kMinSize / pitch, 1)));
+
+    for (int64_t b = max_batch_; b >= min_batch_; b >>= 1) {
+      CreatePlan(fwd_plans_, CUFFT_R2C, b);
+      CreatePlan(inv_plans_, CUFFT_C2R, b);
+    }
+  }
+
+  void CreatePlan(PlanMap &plans, cufftType type, int batch) {
+    auto &plan = plans[{transform_size_, batch}];
+    if (plan.handle)
+      return;
+    int n[1] = { transform_size_ };
+    int real_embed[1] = { static_cast<int>(RowPitch()) };
+    int complex_embed[1] = { static_cast<int>(RowPitch() / 2) };
+    bool forward = type == CUFFT_R2C;
+    cufftHandle handle;
+    CUDA_CALL(cufftCreate(&handle));
+    plan.handle.reset(handle);
+    CUDA_CALL(cufftSetAutoAllocation(handle, false));
+    CUDA_CALL(cufftMakePlanMany(
+        handle, 1, n,
+        forward ? real_embed : complex_embed, 1, forward ? real_embed[0] : complex_embed[0],
+        forward ? complex_embed : real_embed, 1, forward ? complex_embed[0] : real_embed[0],
+        type, batch, &plan.work_size));
+    max_work_size_ = std::max(max_work_size_, plan.work_size);
+  }
+
+  /**
+   * @brief Runs the (in-place) transforms for `rows` rows, starting at `data`, rounded up to
+   *        the smallest batch.
+   */
+  void Execute(bool forward, cudaStream_t stream, float *data, int64_t rows) {
+    auto &plans = forward ? fwd_plans_ : inv_plans_;
+    int64_t pitch = RowPitch();
+    int64_t total = align_up(rows, min_batch_);
+    for (int64_t done = 0; done < total; ) {
+      int64_t batch = max_batch_;
+      while (batch > total - done)
+        batch >>= 1;
+      auto &plan = plans.at({transform_size_, static_cast<int>(batch)});
+      CUDA_CALL(cufftSetStream(plan.handle, stream));
+      CUDA_CALL(cufftSetWorkArea(plan.handle, work_));
+      float *rows_data = data + done * pitch;
+      auto *rows_spectra = reinterpret_cast<cufftComplex *>(rows_data);
+      if (forward)
+        CUDA_CALL(cufftExecR2C(plan.handle, rows_data, rows_spectra));
+      else
+        CUDA_CALL(cufftExecC2R(plan.handle, rows_spectra, rows_data));
+      done += batch;
+    }
+  }
+
+  int transform_size_ = 0;
+  int num_windows_ = 0;
+  int64_t num_signals_ = 0;
+  int64_t num_rows_ = 0;
+  int64_t max_batch_ = 1, min_batch_ = 1;
+  size_t max_work_size_ = 0;
+  PlanMap fwd_plans_, inv_plans_;
+  float *buffer_ = nullptr;
+  float *windows_host_ = nullptr;
+  int64_t *offsets_host_ = nullptr;
+  int64_t *offsets_gpu_ = nullptr;
+  void *work_ = nullptr;
+};
+
+FFTConvolverGpu::FFTConvolverGpu() = default;
+FFTConvolverGpu::FFTConvolverGpu(FFTConvolverGpu &&) = default;
+FFTConvolverGpu::~FFTConvolverGpu() = default;
+
+int FFTConvolverGpu::TransformSize(int min_size) {
+  int64_t best = next_pow2(std::max(min_size, 1));
+  for (int64_t n : {5, 3, 7}) {
+    while (n < min_size)
+      n <<= 1;
+    best = std::min(best, n);
+  }
+  return best;
+}
+
+void FFTConvolverGpu::Setup(ScratchpadEstimator &se, int transform_size, int num_windows,
+                            int64_t num_signals) {
+  if (!impl_)
+    impl_ = std::make_unique<FFTConvolverImplGpu>();
+  impl_->Setup(se, transform_size, num_windows, num_signals);
+}
+
+int64_t FFTConvolverGpu::RowPitch() const {
+  assert(impl_ != nullptr && "No instance present - missing call to Setup?");
+  return impl_->RowPitch();
+}
+
+int64_t FFTConvolverGpu::NumRows() const {
+  assert(impl_ != nullptr && "No instance present - missing call to Setup?");
+  return impl_->NumRows();
+}
+
+float *FFTConvolverGpu::AllocateBuffers(KernelContext &ctx) {
+  assert(impl_ != nullptr && "No instance present - missing call to Setup?");
+  return impl_->AllocateBuffers(ctx);
+}
+
+void FFTConvolverGpu::Run(KernelContext &ctx,
+                          const TensorListView<StorageCPU, const float, 1> &windows,
+                          span<const int64_t> signals_per_window) {
+  assert(impl_ != nullptr && "No instance present - missing call to Setup?");
+  impl_->Run(ctx, windows, signals_per_window);
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -0,0 +1,96 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_KERNELS_IMGPROC_CONVOLUTION_FFT_CONVOLVER_GPU_H_
+#define DALI_KERNELS_IMGPROC_CONVOLUTION_FFT_CONVOLVER_GPU_H_
+
+#include <memory>
+#include "dali/core/span.h"
+#include "dali/core/tensor_view.h"
+#include "dali/kernels/kernel.h"
+
+namespace dali {
+namespace kernels {
+
+class FFTConvolverImplGpu;
+
+/**
+ * @brief Correlates batches of 1D signals with windows in the frequency domain, using cuFFT.
+ *
+ * The signals and the windows are stored in a single buffer of NumRows() rows, RowPitch() floats
+ * each, obtained with AllocateBuffers. The first `num_windows` rows contain the windows and
+ * the following `num_signals` rows contain the signals, zero-padded to the transform size.
+ * The windows are written to the buffer by Run itself; the signals must be placed there
+ * by the caller.
+ *
+ * After Run, each signal row `x` contains `y[k] = sum_t(window[t] * x[(k + t) mod L])`, where L
+ * is the transform size. This is the same formula (modulo the border handling) as used by
+ * the spatial convolution kernels - see BaselineConvolve. The signals are assigned to the windows
+ * in consecutive groups.
+ *
+ * The class exists to keep the cuFFT dependency within the kernels library - the data-type
+ * specific packing and unpacking is done by FFTConvolutionGpu.
+ */
+class DLL_PUBLIC FFTConvolverGpu {
+ public:
+  FFTConvolverGpu();
+  FFTConvolverGpu(FFTConvolverGpu &&);
+  ~FFTConvolverGpu();
+
+  /**
+   * @brief The smallest size not less than `min_size` of the form 2^k, 5*2^k, 3*2^k or 7*2^k
+   *
+   * The sizes are sparse enough for the plans to be reused in batches of variable-size samples,
+   * while wasting at most 25% of the transform size (for larger sizes).
+   */
+  static int TransformSize(int min_size);
+
+  /**
+   * @brief Prepares the FFT plans and adds the buffer and the scratch memory used by Run
+   *        to the estimator
+   */
+  void Setup(ScratchpadEstimator &se, int transform_size, int num_windows, int64_t num_signals);
+
+  /// Number of floats in each row of the buffer
+  int64_t RowPitch() const;
+
+  /// Number of rows in the buffer, including the padding used by the batched transforms
+  int64_t NumRows() const;
+
+  /**
+   * @brief Allocates the buffer and the temporary memory used by Run from the scratchpad
+   *
+   * @return the device buffer with NumRows() * RowPitch() floats
+   */
+  float *AllocateBuffers(KernelContext &ctx);
+
+  /**
+   * @brief Correlates the signals in the buffer obtained with AllocateBuffers with the windows
+   *
+   * @param windows             the windows, one per group of signals; they must not be longer
+   *                            than the transform size
+   * @param signals_per_window  the number of consecutive signals convolved with each window
+   */
+  void Run(KernelContext &ctx, const TensorListView<StorageCPU, const float, 1> &windows,
+           span<const int64_t> signals_per_window);
+
+ private:
+  std::unique_ptr<FFTConvolverImplGpu> impl_;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_CONVOLUTION_FFT_CONVOLVER_GPU_H_
@@ -15,11 +15,13 @@
 #ifndef DALI_KERNELS_IMGPROC_CONVOLUTION_SEPARABLE_CONVOLUTION_GPU_H_
 #define DALI_KERNELS_IMGPROC_CONVOLUTION_SEPARABLE_CONVOLUTION_GPU_H_
 
+#include <type_traits>
 #include "dali/core/convert.h"
 #include "dali/core/format.h"
 #include "dali/core/tensor_view.h"
 #include "dali/kernels/common/utils.h"
 #include "dali/kernels/imgproc/convolution/convolution_gpu.h"
+#include "dali/kernels/imgproc/convolution/fft_convolution_gpu.h"
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/scratch.h"
 #include "dali/pipeline/util/operator_impl_utils.h"
@@ -42,14 +44,25 @@ namespace kernels {
  *
  * Specialized for 1, 2 or 3 axes, to not go overboard with TMP for generic solutions
  *
+ * With `fft_for_large_windows`, the axes with large windows are convolved in the frequency domain
+ * - see AdaptiveConvolutionGpu.
+ *
  * Here be boilerplate.
  */
 template <typename Out, typename In, typename W, int axes, bool has_channels = false,
-          bool is_sequence = false>
+          bool is_sequence = false, bool fft_for_large_windows = false>
 struct SeparableConvolutionGpu;
 
-template <typename Out, typename In, typename W, bool has_channels, bool is_sequence>
-struct SeparableConvolutionGpu<Out, In, W, 1, has_channels, is_sequence> {
+template <bool fft_for_large_windows, typename Out, typename In, typename W, int ndim, int axis,
+          bool has_channels>
+using SeparableAxisConvolutionGpu = std::conditional_t<
+    fft_for_large_windows,
+    AdaptiveConvolutionGpu<Out, In, W, ndim, axis, has_channels>,
+    ConvolutionGpu<Out, In, W, ndim, axis, has_channels>>;
+
+template <typename Out, typename In, typename W, bool has_channels, bool is_sequence,
+          bool fft_for_large_windows>
+struct SeparableConvolutionGpu<Out, In, W, 1, has_channels, is_sequence, fft_for_large_windows> {
   static constexpr int axes = 1;
   static constexpr int sequence_axes = static_cast<int>(is_sequence);
   static constexpr int channel_axes = static_cast<int>(has_channels);
@@ -77,11 +90,13 @@ struct SeparableConvolutionGpu<Out, In, W, 1, has_channels, is_sequence> {
     conv_.Run(ctx, out, in, windows[0], anchors[0], conv_epilogue);
   }
 
-  ConvolutionGpu<Out, In, W, ndim, sequence_axes + 0, has_channels> conv_;
+  SeparableAxisConvolutionGpu<fft_for_large_windows, Out, In, W, ndim,
+                              sequence_axes + 0, has_channels> conv_;
 };
 
-template <typename Out, typename In, typename W, bool has_channels, bool is_sequence>
-struct SeparableConvolutionGpu<Out, In, W, 2, has_channels, is_sequence> {
+template <typename Out, typename In, typename W, bool has_channels, bool is_sequence,
+          bool fft_for_large_windows>
+struct SeparableConvolutionGpu<Out, In, W, 2, has_channels, is_sequence, fft_for_large_windows> {
   static constexpr int axes = 2;
   static constexpr int sequence_axes = static_cast<int>(is_sequence);
   static constexpr int channel_axes = static_cast<int>(has_channels);
@@ -138,12 +153,15 @@ struct SeparableConvolutionGpu<Out, In, W, 2, has_channels, is_sequence> {
   }
 
   scratch_sizes_t sub_scratch_sizes_;
-  ConvolutionGpu<Intermediate, In, W, ndim, sequence_axes + 1, has_channels> conv_innermost_;
-  ConvolutionGpu<Out, Intermediate, W, ndim, sequence_axes + 0, has_channels> conv_outermost_;
+  SeparableAxisConvolutionGpu<fft_for_large_windows, Intermediate, In, W, ndim,
+                              sequence_axes + 1, has_channels> conv_innermost_;
+  SeparableAxisConvolutionGpu<fft_for_large_windows, Out, Intermediate, W, ndim,
+                              sequence_axes + 0, has_channels> conv_outermost_;
 };
 
-template <typename Out, typename In, typename W, bool has_channels, bool is_sequence>
-struct SeparableConvolutionGpu<Out, In, W, 3, has_channels, is_sequence> {
+template <typename Out, typename In, typename W, bool has_channels, bool is_sequence,
+          bool fft_for_large_windows>
+struct SeparableConvolutionGpu<Out, In, W, 3, has_channels, is_sequence, fft_for_large_windows> {
   static constexpr int axes = 3;
   static constexpr int sequence_axes = static_cast<int>(is_sequence);
   static constexpr int channel_axes = static_cast<int>(has_channels);
@@ -214,9 +232,12 @@ struct SeparableConvolutionGpu<Out, In, W, 3, has_channels, is_sequence> {
 
   scratch_sizes_t sub_scratch_sizes_;
   bool use_out_as_intermediate_;
-  ConvolutionGpu<Intermediate, In, W, ndim, sequence_axes + 2, has_channels> conv_innermost_;
-  ConvolutionGpu<Intermediate, Intermediate, W, ndim, sequence_axes + 1, has_channels> conv_middle_;
-  ConvolutionGpu<Out, Intermediate, W, ndim, sequence_axes + 0, has_channels> conv_outermost_;
+  SeparableAxisConvolutionGpu<fft_for_large_windows, Intermediate, In, W, ndim,
+                              sequence_axes + 2, has_channels> conv_innermost_;
+  SeparableAxisConvolutionGpu<fft_for_large_windows, Intermediate, Intermediate, W, ndim,
+                              sequence_axes + 1, has_channels> conv_middle_;
+  SeparableAxisConvolutionGpu<fft_for_large_windows, Out, Intermediate, W, ndim,
+                              sequence_axes + 0, has_channels> conv_outermost_;
 };
 
 }  // namespace kernels
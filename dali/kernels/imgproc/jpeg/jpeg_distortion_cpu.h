@@ -0,0 +1,314 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_KERNELS_IMGPROC_JPEG_JPEG_DISTORTION_CPU_H_
+#define DALI_KERNELS_IMGPROC_JPEG_JPEG_DISTORTION_CPU_H_
+
+#include <algorithm>
+#include <cmath>
+#include "dali/core/convert.h"
+#include "dali/core/force_inline.h"
+#include "dali/core/geom/vec.h"
+#include "dali/core/tensor_view.h"
+#include "dali/kernels/common/simd.h"
+#include "dali/kernels/imgproc/color_manipulation/color_space_conversion_impl.h"
+#include "dali/kernels/imgproc/jpeg/jpeg_distortion_gpu_kernel.h"
+#include "dali/kernels/kernel.h"
+
+namespace dali {
+namespace kernels {
+namespace jpeg {
+
+namespace detail {
+
+// The same factorization of the 8x8 DCT as in dct_8x8_gpu.cuh
+constexpr float kDctA = 1.387039845322148f;             // sqrt(2) * cos(    pi / 16);
+constexpr float kDctB = 1.306562964876377f;             // sqrt(2) * cos(    pi /  8);
+constexpr float kDctC = 1.175875602419359f;             // sqrt(2) * cos(3 * pi / 16);
+constexpr float kDctD = 0.785694958387102f;             // sqrt(2) * cos(5 * pi / 16);
+constexpr float kDctE = 0.541196100146197f;             // sqrt(2) * cos(3 * pi /  8);
+constexpr float kDctF = 0.275899379282943f;             // sqrt(2) * cos(7 * pi / 16);
+constexpr float kDctNorm = 0.3535533905932737f;         // 1 / sqrt(8)
+
+DALI_FORCEINLINE float round_even(float x) {
+  return std::nearbyint(x);
+}
+
+#ifdef DALI_SIMD_FLOAT4
+
+/**
+ * @brief 4 lanes of float, with the arithmetic operators used by the DCT
+ */
+struct float4_lanes {
+  simd::float4_t v;
+};
+
+DALI_FORCEINLINE float4_lanes operator+(float4_lanes a, float4_lanes b) {
+  return { simd::add(a.v, b.v) };
+}
+
+DALI_FORCEINLINE float4_lanes operator-(float4_lanes a, float4_lanes b) {
+  return { simd::sub(a.v, b.v) };
+}
+
+DALI_FORCEINLINE float4_lanes operator*(float a, float4_lanes b) {
+  return { simd::mul(simd::set1_f(a), b.v) };
+}
+
+DALI_FORCEINLINE float4_lanes operator*(float4_lanes a, float4_lanes b) {
+  return { simd::mul(a.v, b.v) };
+}
+
+DALI_FORCEINLINE float4_lanes round_even(float4_lanes x) {
+  return { simd::round_f(x.v) };
+}
+
+#endif  // DALI_SIMD_FLOAT4
+
+/**
+ * @brief 1D forward DCT of 8 values (or vectors of values), `stride` elements apart
+ */
+template <int stride, typename T>
+DALI_FORCEINLINE void dct_fwd_8x8_1d(T *data) {
+  T x0 = data[0 * stride], x1 = data[1 * stride], x2 = data[2 * stride], x3 = data[3 * stride];
+  T x4 = data[4 * stride], x5 = data[5 * stride], x6 = data[6 * stride], x7 = data[7 * stride];
+
+  T tmp0 = x0 + x7, tmp1 = x1 + x6, tmp2 = x2 + x5, tmp3 = x3 + x4;
+  T tmp4 = x0 - x7, tmp5 = x6 - x1, tmp6 = x2 - x5, tmp7 = x4 - x3;
+  T tmp8 = tmp0 + tmp3, tmp9 = tmp0 - tmp3, tmp10 = tmp1 + tmp2, tmp11 = tmp1 - tmp2;
+
+  data[0 * stride] = kDctNorm * (tmp8 + tmp10);
+  data[2 * stride] = kDctNorm * (kDctB * tmp9 + kDctE * tmp11);
+  data[4 * stride] = kDctNorm * (tmp8 - tmp10);
+  data[6 * stride] = kDctNorm * (kDctE * tmp9 - kDctB * tmp11);
+
+  data[1 * stride] = kDctNorm * (kDctA * tmp4 - kDctC * tmp5 + kDctD * tmp6 - kDctF * tmp7);
+  data[3 * stride] = kDctNorm * (kDctC * tmp4 + kDctF * tmp5 - kDctA * tmp6 + kDctD * tmp7);
+  data[5 * stride] = kDctNorm * (kDctD * tmp4 + kDctA * tmp5 + kDctF * tmp6 - kDctC * tmp7);
+  data[7 * stride] = kDctNorm * (kDctF * tmp4 + kDctD * tmp5 + kDctC * tmp6 + kDctA * tmp7);
+}
+
+/**
+ * @brief 1D inverse DCT of 8 values (or vectors of values), `stride` elements apart
+ */
+template <int stride, typename T>
+DALI_FORCEINLINE void dct_inv_8x8_1d(T *data) {
+  T x0 = data[0 * stride], x1 = data[1 * stride], x2 = data[2 * stride], x3 = data[3 * stride];
+  T x4 = data[4 * stride], x5 = data[5 * stride], x6 = data[6 * stride], x7 = data[7 * stride];
+
+  T tmp0 = x0 + x4;
+  T tmp1 = kDctB * x2 + kDctE * x6;
+  T tmp2 = tmp0 + tmp1;
+  T tmp3 = tmp0 - tmp1;
+  T tmp4 = kDctF * x7 + kDctA * x1 + kDctC * x3 + kDctD * x5;
+  T tmp5 = kDctA * x7 - kDctF * x1 + kDctD * x3 - kDctC * x5;
+
+  T tmp6 = x0 - x4;
+  T tmp7 = kDctE * x2 - kDctB * x6;
+  T tmp8 = tmp6 + tmp7;
+  T tmp9 = tmp6 - tmp7;
+  T tmp10 = kDctC * x1 - kDctD * x7 - kDctF * x3 - kDctA * x5;
+  T tmp11 = kDctD * x1 + kDctC * x7 - kDctA * x3 + kDctF * x5;
+
+  data[0 * stride] = kDctNorm * (tmp2 + tmp4);
+  data[7 * stride] = kDctNorm * (tmp2 - tmp4);
+  data[4 * stride] = kDctNorm * (tmp3 + tmp5);
+  data[3 * stride] = kDctNorm * (tmp3 - tmp5);
+
+  data[1 * stride] = kDctNorm * (tmp8 + tmp10);
+  data[5 * stride] = kDctNorm * (tmp9 - tmp11);
+  data[2 * stride] = kDctNorm * (tmp9 + tmp11);
+  data[6 * stride] = kDctNorm * (tmp8 - tmp10);
+}
+
+/**
+ * @brief Quantization tables, stored transposed, with the reciprocals
+ */
+struct QuantizationTable {
+  alignas(16) float q[64];
+  alignas(16) float q_inv[64];
+
+  QuantizationTable() = default;
+  explicit QuantizationTable(const mat<8, 8, uint8_t> &table) {
+    for (int i = 0; i < 8; i++) {
+      for (int j = 0; j < 8; j++) {
+        q[j * 8 + i] = table(i, j);
+        q_inv[j * 8 + i] = 1.0f / table(i, j);
+      }
+    }
+  }
+};
+
+/**
+ * @brief Runs the DCT, the quantization and the inverse DCT on a row-major 8x8 block
+ *
+ * The 2D DCT is separable - the columns are transformed first, then the block is transposed
+ * and the columns (the original rows) are transformed again. The quantization is done
+ * in the transposed domain and the inverse runs the same steps in the reverse order.
+ */
+inline void QuantizeBlock(float *block, const QuantizationTable &table) {
+#ifdef DALI_SIMD_FLOAT4
+  // 8 rows of 2 vectors
+  float4_lanes rows[8][2];
+  for (int i = 0; i < 8; i++) {
+    rows[i][0].v = simd::load_f(block + 8 * i).v[0];
+    rows[i][1].v = simd::load_f(block + 8 * i + 4).v[0];
+  }
+  auto transpose = [&]() {
+    simd::float4x4 quad[2][2];
+    for (int qy = 0; qy < 2; qy++)
+      for (int qx = 0; qx < 2; qx++) {
+        for (int i = 0; i < 4; i++)
+          quad[qy][qx].v[i] = rows[4 * qy + i][qx].v;
+        simd::transpose(quad[qy][qx]);
+      }
+    for (int qy = 0; qy < 2; qy++)
+      for (int qx = 0; qx < 2; qx++)
+        for (int i = 0; i < 4; i++)
+          rows[4 * qx + i][qy].v = quad[qy][qx].v[i];
+  };
+
+  for (int h = 0; h < 2; h++)
+    dct_fwd_8x8_1d<2>(&rows[0][h]);
+  transpose();
+  for (int h = 0; h < 2; h++)
+    dct_fwd_8x8_1d<2>(&rows[0][h]);
+
+  for (int i = 0; i < 8; i++) {
+    for (int h = 0; h < 2; h++) {
+      float4_lanes q = { simd::load_f(table.q + 8 * i + 4 * h).v[0] };
+      float4_lanes q_inv = { simd::load_f(table.q_inv + 8 * i + 4 * h).v[0] };
+      rows[i][h] = q * round_even(rows[i][h] * q_inv);
+    }
+  }
+
+  for (int h = 0; h < 2; h++)
+    dct_inv_8x8_1d<2>(&rows[0][h]);
+  transpose();
+  for (int h = 0; h < 2; h++)
+    dct_inv_8x8_1d<2>(&rows[0][h]);
+
+  for (int i = 0; i < 8; i++) {
+    simd::store_f(block + 8 * i, simd::float4x1{{ rows[i][0].v }});
+    simd::store_f(block + 8 * i + 4, simd::float4x1{{ rows[i][1].v }});
+  }
+#else
+  for (int x = 0; x < 8; x++)
+    dct_fwd_8x8_1d<8>(block + x);
+  for (int y = 0; y < 8; y++)
+    dct_fwd_8x8_1d<1>(block + 8 * y);
+  // the table is transposed
+  for (int y = 0; y < 8; y++) {
+    for (int x = 0; x < 8; x++) {
+      float &v = block[8 * y + x];
+      v = table.q[8 * x + y] * round_even(v * table.q_inv[8 * x + y]);
+    }
+  }
+  for (int y = 0; y < 8; y++)
+    dct_inv_8x8_1d<1>(block + 8 * y);
+  for (int x = 0; x < 8; x++)
+    dct_inv_8x8_1d<8>(block + x);
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @brief Produces JPEG compression artifacts by running the lossy part of JPEG compression
+ *        and decompression - with 4:2:0 chroma subsampling - on an HWC RGB image.
+ *
+ * The image is processed in 16x16 macroblocks. Each macroblock is converted to YCbCr, split into
+ * four 8x8 luma blocks and two subsampled 8x8 chroma blocks, which are transformed with the DCT,
+ * quantized and transformed back, before the macroblock is converted back to RGB.
+ * The transforms use SIMD instructions, when available.
+ */
+class JpegCompressionDistortionCPU {
+ public:
+  KernelRequirements Setup(KernelContext &ctx, const TensorShape<3> &in_shape) {
+    KernelRequirements req;
+    req.output_shapes = { TensorListShape<3>({in_shape}) };
+    return req;
+  }
+
+  void Run(KernelContext &ctx, const OutTensorCPU<uint8_t, 3> &out,
+           const InTensorCPU<uint8_t, 3> &in, int quality) {
+    assert(in.shape == out.shape && in.shape[2] == 3);
+    detail::QuantizationTable luma_table(GetLumaQuantizationTable(quality));
+    detail::QuantizationTable chroma_table(GetChromaQuantizationTable(quality));
+    int height = in.shape[0], width = in.shape[1];
+    for (int y0 = 0; y0 < height; y0 += 16) {
+      for (int x0 = 0; x0 < width; x0 += 16) {
+        ProcessMacroblock(out.data, in.data, width, height, x0, y0, luma_table, chroma_table);
+      }
+    }
+  }
+
+ private:
+  using T = uint8_t;
+
+  static void ProcessMacroblock(T *out, const T *in, int width, int height, int x0, int y0,
+                                const detail::QuantizationTable &luma_table,
+                                const detail::QuantizationTable &chroma_table) {
+    // 4 luma blocks, in the row-major order, followed by Cb and Cr
+    alignas(16) float blocks[6][64];
+    auto luma = [&](int x, int y) -> float & {
+      return blocks[(y >> 3) * 2 + (x >> 3)][(y & 7) * 8 + (x & 7)];
+    };
+
+    // Shifting to [-128, 128] before the DCT
+    for (int cy = 0; cy < 8; cy++) {
+      for (int cx = 0; cx < 8; cx++) {
+        vec<3, T> rgb[4];
+        for (int k = 0; k < 4; k++) {
+          int x = std::min(x0 + 2 * cx + (k & 1), width - 1);
+          int y = std::min(y0 + 2 * cy + (k >> 1), height - 1);
+          const T *pixel = in + (static_cast<int64_t>(y) * width + x) * 3;
+          rgb[k] = vec<3, T>(pixel[0], pixel[1], pixel[2]);
+          luma(2 * cx + (k & 1), 2 * cy + (k >> 1)) = color::jpeg::rgb_to_y<T>(rgb[k]) - 128.0f;
+        }
+        vec<3, T> avg;
+        for (int c = 0; c < 3; c++)
+          avg[c] = ConvertSat<T>((rgb[0][c] + rgb[1][c] + rgb[2][c] + rgb[3][c]) * 0.25f);
+        blocks[4][cy * 8 + cx] = color::jpeg::rgb_to_cb<T>(avg) - 128.0f;
+        blocks[5][cy * 8 + cx] = color::jpeg::rgb_to_cr<T>(avg) - 128.0f;
+      }
+    }
+
+    for (int b = 0; b < 4; b++)
+      detail::QuantizeBlock(blocks[b], luma_table);
+    detail::QuantizeBlock(blocks[4], chroma_table);
+    detail::QuantizeBlock(blocks[5], chroma_table);
+
+    // Shifting to [0, 255] after the inverse DCT
+    int ymax = std::min(16, height - y0), xmax = std::min(16, width - x0);
+    for (int y = 0; y < ymax; y++) {
+      T *row = out + (static_cast<int64_t>(y0 + y) * width + x0) * 3;
+      for (int x = 0; x < xmax; x++) {
+        int chroma_idx = (y >> 1) * 8 + (x >> 1);
+        vec<3, T> ycbcr(ConvertSat<T>(luma(x, y) + 128.0f),
+                        ConvertSat<T>(blocks[4][chroma_idx] + 128.0f),
+                        ConvertSat<T>(blocks[5][chroma_idx] + 128.0f));
+        auto rgb = color::jpeg::ycbcr_to_rgb<T>(ycbcr);
+        for (int c = 0; c < 3; c++)
+          row[3 * x + c] = rgb[c];
+      }
+    }
+  }
+};
+
+}  // namespace jpeg
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_JPEG_JPEG_DISTORTION_CPU_H_
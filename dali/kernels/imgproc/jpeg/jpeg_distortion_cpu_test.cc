@@ -0,0 +1,82 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <opencv2/opencv.hpp>
+#include <string>
+#include <vector>
+#include "dali/kernels/imgproc/jpeg/jpeg_distortion_cpu.h"
+#include "dali/test/dali_test_config.h"
+#include "dali/util/image.h"
+
+namespace dali {
+namespace kernels {
+namespace jpeg {
+namespace test {
+
+class JpegDistortionTestCPU : public ::testing::TestWithParam<int> {
+ public:
+  void SetUp() final {
+    std::vector<std::string> paths = ImageList(
+      testing::dali_extra_path() + "/db/single/bmp", {".bmp"}, 3);
+    for (auto &path : paths) {
+      cv::Mat rgb;
+      cv::cvtColor(cv::imread(path), rgb, cv::COLOR_BGR2RGB);
+      images_.push_back(rgb);
+    }
+  }
+
+  void TestJpegCompressionDistortion(int quality) {
+    JpegCompressionDistortionCPU kernel;
+    KernelContext ctx;
+    for (auto &in_mat : images_) {
+      TensorShape<3> sh{in_mat.rows, in_mat.cols, 3};
+      cv::Mat out_mat(in_mat.rows, in_mat.cols, CV_8UC3);
+      auto in = make_tensor_cpu<3>(const_cast<const uint8_t *>(in_mat.data), sh);
+      auto out = make_tensor_cpu<3>(out_mat.data, sh);
+      kernel.Setup(ctx, sh);
+      kernel.Run(ctx, out, in, quality);
+
+      cv::Mat bgr, out_ref;
+      std::vector<uint8_t> encoded;
+      cv::cvtColor(in_mat, bgr, cv::COLOR_RGB2BGR);
+      cv::imencode(".jpg", bgr, encoded, {cv::IMWRITE_JPEG_QUALITY, quality});
+      cv::cvtColor(cv::imdecode(encoded, cv::IMREAD_COLOR), out_ref, cv::COLOR_BGR2RGB);
+
+      // The same limits as for the GPU kernel with 4:2:0 chroma subsampling
+      cv::Mat diff;
+      cv::absdiff(out_mat, out_ref, diff);
+      auto mean = cv::mean(diff);
+      double min_val, max_val;
+      cv::minMaxLoc(diff.reshape(1), &min_val, &max_val);
+      EXPECT_LE(max_val, 80);
+      for (int d = 0; d < 3; d++)
+        EXPECT_LE(mean[d], 3);
+    }
+  }
+
+  std::vector<cv::Mat> images_;
+};
+
+TEST_P(JpegDistortionTestCPU, JpegCompressionDistortion) {
+  this->TestJpegCompressionDistortion(GetParam());
+}
+
+INSTANTIATE_TEST_SUITE_P(JpegDistortionTestCPU, JpegDistortionTestCPU,
+                         ::testing::Values(1, 5, 95, 100));
+
+}  // namespace test
+}  // namespace jpeg
+}  // namespace kernels
+}  // namespace dali
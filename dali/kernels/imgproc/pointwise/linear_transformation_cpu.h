@@ -15,12 +15,14 @@
 #ifndef DALI_KERNELS_IMGPROC_POINTWISE_LINEAR_TRANSFORMATION_CPU_H_
 #define DALI_KERNELS_IMGPROC_POINTWISE_LINEAR_TRANSFORMATION_CPU_H_
 
+#include <type_traits>
 #include <vector>
 #include <utility>
 #include "dali/core/format.h"
 #include "dali/core/convert.h"
 #include "dali/core/geom/box.h"
 #include "dali/kernels/common/block_setup.h"
+#include "dali/kernels/imgproc/color_manipulation/color_transform_cpu.h"
 #include "dali/kernels/imgproc/surface.h"
 #include "dali/kernels/imgproc/roi.h"
 
@@ -59,18 +61,35 @@ class LinearTransformationCpu {
     auto adjusted_roi = AdjustRoi(roi, in.shape);
     auto ptr = out.data;
     auto in_width = in.shape[1];
+    int roi_width = adjusted_roi.hi.x - adjusted_roi.lo.x;
 
     for (int y = adjusted_roi.lo.y; y < adjusted_roi.hi.y; y++) {
       auto *row_ptr = &in.data[y * in_width * channels_in];
-      for (int x = adjusted_roi.lo.x; x < adjusted_roi.hi.x; x++) {
-        vec<channels_in, float> v_in;
-        for (int k = 0; k < channels_in; k++) {
-          v_in[k] = row_ptr[channels_in * x + k];
-        }
-        vec<channels_out> v_out = tmatrix * v_in + tvector;
-        for (int k = 0; k < channels_out; k++) {
-          *ptr++ = ConvertSat<OutputType>(v_out[k]);
-        }
+      RunRow(ptr, row_ptr + adjusted_roi.lo.x * channels_in, roi_width, tmatrix, tvector,
+             std::integral_constant<bool, channels_in == 3 && channels_out == 3>());
+      ptr += roi_width * channels_out;
+    }
+  }
+
+ private:
+  /**
+   * @brief 3 to 3 channels - the common case of the color transforms, vectorized
+   */
+  static void RunRow(OutputType *out, const InputType *in, int width,
+                     const Mat &tmatrix, const Vec &tvector, std::true_type) {
+    color::TransformPixels3(out, in, width, tmatrix, tvector);
+  }
+
+  static void RunRow(OutputType *out, const InputType *in, int width,
+                     const Mat &tmatrix, const Vec &tvector, std::false_type) {
+    for (int x = 0; x < width; x++) {
+      vec<channels_in, float> v_in;
+      for (int k = 0; k < channels_in; k++) {
+        v_in[k] = in[channels_in * x + k];
+      }
+      vec<channels_out> v_out = tmatrix * v_in + tvector;
+      for (int k = 0; k < channels_out; k++) {
+        *out++ = ConvertSat<OutputType>(v_out[k]);
       }
     }
   }
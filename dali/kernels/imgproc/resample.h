@@ -47,9 +47,10 @@ struct ResampleGPU {
     return pImpl.get();
   }
 
-  KernelRequirements Setup(KernelContext &context, const Input &input, const Params &params) {
+  KernelRequirements Setup(KernelContext &context, const Input &input, const Params &params,
+                           span<const int> num_frames = {}) {
     auto *impl = SelectImpl(context, input, params);
-    return impl->Setup(context, input, params);
+    return impl->Setup(context, input, params, num_frames);
   }
 
   void Run(KernelContext &context, const Output &output, const Input &input, const Params &params) {
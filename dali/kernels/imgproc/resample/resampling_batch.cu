@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -31,6 +31,9 @@ __global__ void BatchedSeparableResampleKernel(
   // find which part of which sample this block will process
   BlockDesc<spatial_ndim> bdesc = block2sample[blockIdx.x];
   const auto &sample = samples[bdesc.sample_idx];
+  int frame = blockIdx.y;
+  if (frame >= sample.num_frames)
+    return;
   Output *__restrict__ sample_out;
   const Input *__restrict__ sample_in;
 
@@ -38,8 +41,10 @@ __global__ void BatchedSeparableResampleKernel(
 
   auto in_strides = sample.strides[which_pass];
   auto out_strides = sample.strides[which_pass+1];
-  sample_in = reinterpret_cast<const Input*>(sample.pointers[which_pass]);
-  sample_out = reinterpret_cast<Output*>(sample.pointers[which_pass+1]);
+  sample_in = reinterpret_cast<const Input*>(sample.pointers[which_pass]) +
+              frame * sample.frame_strides[which_pass];
+  sample_out = reinterpret_cast<Output*>(sample.pointers[which_pass+1]) +
+               frame * sample.frame_strides[which_pass+1];
   in_shape = sample.shapes[which_pass];
 
   int axis = sample.order[which_pass];  // vec-order: 0 = X, 1 = Y, 2 = Z
@@ -79,10 +84,10 @@ __global__ void BatchedSeparableResampleKernel(
   default:
     if (axis == 0) {
       ResampleHorz(lo, hi, origin, scale, sample_out, out_strides, sample_in,
-        in_strides, in_shape, sample.channels, filter, support);
+        in_strides, in_shape, sample.channels, filter, support, sample.static_support[axis]);
     } else if (axis == 1) {
       ResampleVert(lo, hi, origin, scale, sample_out, out_strides, sample_in,
-        in_strides, in_shape, sample.channels, filter, support);
+        in_strides, in_shape, sample.channels, filter, support, sample.static_support[axis]);
     } else if (axis == 2) {
       ResampleDepth(lo, hi, origin, scale, sample_out, out_strides, sample_in,
         in_strides, in_shape, sample.channels, filter, support);
@@ -96,15 +101,51 @@ void BatchedSeparableResample(
     int which_pass,
     const SampleDesc<spatial_ndim> *samples,
     const BlockDesc<spatial_ndim> *block2sample, int num_blocks,
-    ivec3 block_size,
+    ivec3 block_size, int max_frames,
     cudaStream_t stream) {
   if (num_blocks <= 0)
     return;
 
   dim3 block(block_size.x, block_size.y, block_size.z);
+  dim3 grid(num_blocks, max_frames);
 
   BatchedSeparableResampleKernel<spatial_ndim, Output, Input>
-  <<<num_blocks, block, ResampleSharedMemSize, stream>>>(which_pass, samples, block2sample);
+  <<<grid, block, ResampleSharedMemSize, stream>>>(which_pass, samples, block2sample);
+  CUDA_CALL(cudaGetLastError());
+}
+
+
+template <typename Output, typename Input>
+__global__ void BatchedFusedResampleKernel(
+    const SampleDesc<2> *__restrict__ samples,
+    const BlockDesc<2> *__restrict__ block2sample) {
+  BlockDesc<2> bdesc = block2sample[blockIdx.x];
+  const auto &sample = samples[bdesc.sample_idx];
+  int frame = blockIdx.y;
+  if (frame >= sample.num_frames)
+    return;
+
+  ResampleFused(bdesc.start, bdesc.end, sample.origin, sample.scale,
+                sample.out_ptr<Output>() + frame * sample.frame_strides[2], sample.strides[2],
+                sample.in_ptr<Input>() + frame * sample.frame_strides[0], sample.strides[0],
+                sample.in_shape(), sample.channels,
+                sample.filter[0], sample.filter[1], sample.fused_tile_rows);
+}
+
+template <typename Output, typename Input>
+void BatchedFusedResample(
+    const SampleDesc<2> *samples,
+    const BlockDesc<2> *block2sample, int num_blocks,
+    ivec3 block_size, int max_frames,
+    cudaStream_t stream) {
+  if (num_blocks <= 0)
+    return;
+
+  dim3 block(block_size.x, block_size.y, 1);
+  dim3 grid(num_blocks, max_frames);
+
+  BatchedFusedResampleKernel<Output, Input>
+  <<<grid, block, ResampleSharedMemSize, stream>>>(samples, block2sample);
   CUDA_CALL(cudaGetLastError());
 }
 
@@ -114,7 +155,7 @@ template DLL_PUBLIC void BatchedSeparableResample<spatial_ndim, Output, Input>(
   int which_pass,                                                               \
   const SampleDesc<spatial_ndim> *samples,                                      \
   const BlockDesc<spatial_ndim> *block2sample, int num_blocks,                  \
-  ivec3 block_size, cudaStream_t stream)
+  ivec3 block_size, int max_frames, cudaStream_t stream)
 
 // Instantiate the resampling functions.
 // The resampling always goes through intermediate image of float type.
@@ -136,6 +177,8 @@ INSTANTIATE_BATCHED_RESAMPLE(2, float, uint16_t);
 INSTANTIATE_BATCHED_RESAMPLE(2, int32_t, float);
 INSTANTIATE_BATCHED_RESAMPLE(2, float, int32_t);
 
+INSTANTIATE_BATCHED_RESAMPLE(2, bfloat16, float);
+
 
 INSTANTIATE_BATCHED_RESAMPLE(3, float, float);
 
@@ -151,6 +194,28 @@ INSTANTIATE_BATCHED_RESAMPLE(3, float, uint16_t);
 INSTANTIATE_BATCHED_RESAMPLE(3, int32_t, float);
 INSTANTIATE_BATCHED_RESAMPLE(3, float, int32_t);
 
+INSTANTIATE_BATCHED_RESAMPLE(3, bfloat16, float);
+
+
+#define INSTANTIATE_FUSED_RESAMPLE(Output, Input)                      \
+template DLL_PUBLIC void BatchedFusedResample<Output, Input>(         \
+  const SampleDesc<2> *samples,                                       \
+  const BlockDesc<2> *block2sample, int num_blocks,                   \
+  ivec3 block_size, int max_frames, cudaStream_t stream)
+
+// The fused resampling is used when the output type is float or the same as the input type
+// (see SeparableResamplingGPUImpl).
+
+INSTANTIATE_FUSED_RESAMPLE(float, float);
+INSTANTIATE_FUSED_RESAMPLE(uint8_t, uint8_t);
+INSTANTIATE_FUSED_RESAMPLE(int16_t, int16_t);
+INSTANTIATE_FUSED_RESAMPLE(uint16_t, uint16_t);
+INSTANTIATE_FUSED_RESAMPLE(int32_t, int32_t);
+
+INSTANTIATE_FUSED_RESAMPLE(float, uint8_t);
+INSTANTIATE_FUSED_RESAMPLE(float, int16_t);
+INSTANTIATE_FUSED_RESAMPLE(float, uint16_t);
+INSTANTIATE_FUSED_RESAMPLE(float, int32_t);
 
 }  // namespace resampling
 }  // namespace kernels
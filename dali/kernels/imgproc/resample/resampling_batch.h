@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,12 +21,30 @@ namespace dali {
 namespace kernels {
 namespace resampling {
 
+/**
+ * @brief Resamples one pass of the batch
+ *
+ * The grid has `max_frames` rows, one for each frame of the samples
+ * (see SampleDesc::num_frames).
+ */
 template <int spatial_ndim, typename Output, typename Input>
 void BatchedSeparableResample(
   int which_pass,
   const SampleDesc<spatial_ndim> *samples,
   const BlockDesc<spatial_ndim> *block2sample, int num_blocks,
-  ivec3 block_size,
+  ivec3 block_size, int max_frames,
+  cudaStream_t stream);
+
+/**
+ * @brief Resamples the fused 2D samples in a single pass, without the intermediate buffers
+ *
+ * @see SampleDesc::fused_tile_rows
+ */
+template <typename Output, typename Input>
+void BatchedFusedResample(
+  const SampleDesc<2> *samples,
+  const BlockDesc<2> *block2sample, int num_blocks,
+  ivec3 block_size, int max_frames,
   cudaStream_t stream);
 
 }  // namespace resampling
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -20,12 +20,11 @@
 #include "dali/core/static_switch.h"
 #include "dali/core/convert.h"
 #include "dali/kernels/imgproc/resample/resampling_filters.cuh"
+#include "dali/kernels/imgproc/resample/resampling_setup.h"
 
 namespace dali {
 namespace kernels {
 
-constexpr int ResampleSharedMemSize = 32<<10;
-
 namespace {
 
 template <int n>
@@ -607,6 +606,320 @@ __device__ void ResampleDepth_Channels(
 }
 
 
+/**
+ * @brief Implements horizontal resampling with a filter of `support` taps
+ * @tparam channels - number of channels
+ * @tparam support - size of the resampling kernel, in source pixels
+ *
+ * The computations are the same as in ResampleHorz_Channels, but the loop over the filter
+ * taps is unrolled. The coefficients and the (clamped) source columns of the output column
+ * are loaded to registers once for all the rows of the span.
+ */
+template <int channels, int support, typename Dst, typename Src>
+__device__ void ResampleHorz_Static(
+    ivec2 lo, ivec2 hi,
+    float src_x0, float scale,
+    Dst *__restrict__ out, ptrdiff_vec<1> out_strides,
+    const Src *__restrict__ in, ptrdiff_vec<1> in_strides, ivec2 in_shape,
+    ResamplingFilter filter) {
+  using resample_shared::coeffs;
+
+  int out_stride = out_strides.x;
+  int in_stride = in_strides.x;
+  int in_w = in_shape.x;
+
+  src_x0 += 0.5f * scale - 0.5f - filter.anchor;
+
+  const float filter_step = filter.scale;
+
+  for (int j = lo.x; j < hi.x; j += blockDim.x) {
+    int dx = j + threadIdx.x;
+    const float sx0f = dx * scale + src_x0;
+    const int sx0 = __float2int_ru(sx0f);
+    float f = (sx0 - sx0f) * filter_step;
+    __syncthreads();
+    for (int k = threadIdx.y; k < support; k += blockDim.y) {
+      coeffs[threadIdx.x + blockDim.x*k] = filter(f + k*filter_step);
+    }
+    __syncthreads();
+
+    if (dx >= hi.x)
+      continue;
+
+    float flt[support];  // NOLINT - not a variable length array
+    int x_offset[support];  // NOLINT - not a variable length array
+    float norm = 0;
+    #pragma unroll
+    for (int k = 0; k < support; k++) {
+      flt[k] = coeffs[threadIdx.x + blockDim.x*k];
+      norm += flt[k];
+      int x = sx0 + k;
+      x_offset[k] = channels * (x < 0 ? 0 : x >= in_w-1 ? in_w-1 : x);
+    }
+    norm = 1.0f / norm;
+
+    for (int i = threadIdx.y + lo.y; i < hi.y; i += blockDim.y) {
+      const Src *in_row = &in[i * in_stride];
+      Dst *out_row = &out[i * out_stride];
+
+      float tmp[channels];  // NOLINT - not a variable length array
+      #pragma unroll
+      for (int c = 0; c < channels; c++)
+        tmp[c] = 0;
+
+      #pragma unroll
+      for (int k = 0; k < support; k++) {
+        #pragma unroll
+        for (int c = 0; c < channels; c++) {
+          Src px = __ldg(in_row + x_offset[k] + c);
+          tmp[c] = fmaf(px, flt[k], tmp[c]);
+        }
+      }
+
+      #pragma unroll
+      for (int c = 0; c < channels; c++)
+        out_row[channels * dx + c] = ConvertSat<Dst>(tmp[c] * norm);
+    }
+  }
+}
+
+/**
+ * @brief Implements vertical resampling with a filter of `support` taps
+ * @tparam channels - number of channels
+ * @tparam support - size of the resampling kernel, in source pixels
+ *
+ * The computations are the same as in ResampleVert_Channels, but the loop over the filter
+ * taps is unrolled. The coefficients and the offsets of the (clamped) source rows of
+ * the output row are loaded to registers once for all the columns of the span.
+ */
+template <int channels, int support, typename Dst, typename Src>
+__device__ void ResampleVert_Static(
+    ivec2 lo, ivec2 hi,
+    float src_y0, float scale,
+    Dst *__restrict__ out, ptrdiff_vec<1> out_strides,
+    const Src *__restrict__ in, ptrdiff_vec<1> in_strides, ivec2 in_shape,
+    ResamplingFilter filter) {
+  using resample_shared::coeffs;
+
+  int out_stride = out_strides.x;
+  int in_stride = in_strides.x;
+  int in_h = in_shape.y;
+
+  src_y0 += 0.5f * scale - 0.5f - filter.anchor;
+
+  const float filter_step = filter.scale;
+
+  const int coeff_base = support*threadIdx.y;
+
+  for (int i = lo.y; i < hi.y; i+=blockDim.y) {
+    int dy = i + threadIdx.y;
+    const float sy0f = dy * scale + src_y0;
+    const int sy0 = __float2int_ru(sy0f);
+    float f = (sy0 - sy0f) * filter_step;
+    __syncthreads();
+    for (int k = threadIdx.x; k < support; k += blockDim.x) {
+      coeffs[coeff_base + k] = filter(f + k*filter_step);
+    }
+    __syncthreads();
+
+    if (dy >= hi.y)
+      continue;
+
+    Dst *out_row = &out[dy * out_stride];
+
+    float flt[support];  // NOLINT - not a variable length array
+    int y_offset[support];  // NOLINT - not a variable length array
+    float norm = 0;
+    #pragma unroll
+    for (int k = 0; k < support; k++) {
+      flt[k] = coeffs[coeff_base + k];
+      norm += flt[k];
+      int y = sy0 + k;
+      y_offset[k] = in_stride * (y < 0 ? 0 : y >= in_h-1 ? in_h-1 : y);
+    }
+    norm = 1.0f / norm;
+
+    for (int j = lo.x + threadIdx.x; j < hi.x; j += blockDim.x) {
+      Dst *out_col = &out_row[j * channels];
+      const Src *in_col = &in[j * channels];
+
+      float tmp[channels];  // NOLINT - not a variable length array
+      #pragma unroll
+      for (int c = 0; c < channels; c++)
+        tmp[c] = 0;
+
+      #pragma unroll
+      for (int k = 0; k < support; k++) {
+        #pragma unroll
+        for (int c = 0; c < channels; c++) {
+          Src px = __ldg(in_col + y_offset[k] + c);
+          tmp[c] = fmaf(px, flt[k], tmp[c]);
+        }
+      }
+
+      #pragma unroll
+      for (int c = 0; c < channels; c++)
+        out_col[c] = ConvertSat<Dst>(tmp[c] * norm);
+    }
+  }
+}
+
+/**
+ * @brief Implements horizontal and vertical resampling in a single pass
+ * @param lo - inclusive lower bound output coordinates
+ * @param hi - exclusive upper bound output coordinates
+ * @param origin - source coordinates corresponding to output 0
+ * @param scale - step, in source coordinates, for one pixel in output (may be negative)
+ * @param tile_rows - maximum height of the output tile, used to lay out the shared memory
+ * @tparam static_channels - number of channels, if known at compile time
+ *
+ * The block processes an output tile of at most blockDim.x columns and `tile_rows` rows.
+ * The source rows needed by the tile are resampled horizontally into the shared memory,
+ * which is then resampled vertically to the output. The computations are the same as in
+ * ResampleHorz followed by ResampleVert, but the intermediate rows are not stored
+ * in the global memory.
+ */
+template <int static_channels = -1, typename Dst, typename Src>
+__device__ void ResampleFused_Channels(
+    ivec2 lo, ivec2 hi,
+    vec2 origin, vec2 scale,
+    Dst *__restrict__ out, ptrdiff_vec<1> out_strides,
+    const Src *__restrict__ in, ptrdiff_vec<1> in_strides, ivec2 in_shape, int dynamic_channels,
+    ResamplingFilter filter_x, ResamplingFilter filter_y, int tile_rows) {
+  using resample_shared::coeffs;
+
+  int out_stride = out_strides.x;
+  int in_stride = in_strides.x;
+  int in_w = in_shape.x;
+  int in_h = in_shape.y;
+
+  const int support_x = filter_x.support();
+  const int support_y = filter_y.support();
+  const int channels = static_channels < 0 ? dynamic_channels : static_channels;
+  const int tile_w = blockDim.x;
+  const int tmp_stride = tile_w * channels;
+  const int max_rows = FusedResampleInputRows(tile_rows, scale.y, support_y);
+
+  float *coeffs_x = coeffs;
+  float *coeffs_y = coeffs_x + tile_w * support_x;
+  float *tmp = coeffs_y + tile_rows * support_y;
+
+  const float src_x0 = origin.x + 0.5f * scale.x - 0.5f - filter_x.anchor;
+  const float src_y0 = origin.y + 0.5f * scale.y - 0.5f - filter_y.anchor;
+
+  const int dx = lo.x + threadIdx.x;
+  const float sx0f = dx * scale.x + src_x0;
+  const int sx0 = __float2int_ru(sx0f);
+  {
+    float f = (sx0 - sx0f) * filter_x.scale;
+    for (int k = threadIdx.y; k < support_x; k += blockDim.y)
+      coeffs_x[threadIdx.x + tile_w * k] = filter_x(f + k * filter_x.scale);
+  }
+  for (int i = threadIdx.y; i < hi.y - lo.y; i += blockDim.y) {
+    const float sy0f = (lo.y + i) * scale.y + src_y0;
+    const int sy0 = __float2int_ru(sy0f);
+    float f = (sy0 - sy0f) * filter_y.scale;
+    for (int k = threadIdx.x; k < support_y; k += blockDim.x)
+      coeffs_y[i * support_y + k] = filter_y(f + k * filter_y.scale);
+  }
+
+  // the source rows used by the tile (the scale may be negative)
+  const int sy_first = __float2int_ru(lo.y * scale.y + src_y0);
+  const int sy_last = __float2int_ru((hi.y - 1) * scale.y + src_y0);
+  const int row0 = min(sy_first, sy_last);
+  const int num_rows = min(max(sy_first, sy_last) - row0 + support_y, max_rows);
+  __syncthreads();
+
+  if (dx < hi.x) {
+    float norm = 0;
+    for (int k = 0; k < support_x; k++) {
+      norm += coeffs_x[threadIdx.x + tile_w * k];
+    }
+    norm = 1.0f / norm;
+
+    for (int r = threadIdx.y; r < num_rows; r += blockDim.y) {
+      int y = row0 + r;
+      int ysample = y < 0 ? 0 : y >= in_h-1 ? in_h-1 : y;
+      const Src *in_row = &in[ysample * in_stride];
+      float *tmp_row = &tmp[r * tmp_stride];
+
+      if (static_channels < 0) {
+        for (int c = 0; c < channels; c++) {
+          float sum = 0;
+
+          for (int k = 0, coeff_idx = threadIdx.x; k < support_x; k++, coeff_idx += tile_w) {
+            int x = sx0 + k;
+            int xsample = x < 0 ? 0 : x >= in_w-1 ? in_w-1 : x;
+            float flt = coeffs_x[coeff_idx];
+            Src px = __ldg(in_row + channels * xsample + c);
+            sum = fmaf(px, flt, sum);
+          }
+
+          tmp_row[channels * threadIdx.x + c] = sum * norm;
+        }
+      } else {
+        float sum[static_channels < 0 ? 1 : static_channels];  // NOLINT - not a variable length array
+        for (int c = 0; c < channels; c++)
+          sum[c] = 0;
+
+        for (int k = 0, coeff_idx = threadIdx.x; k < support_x; k++, coeff_idx += tile_w) {
+          int x = sx0 + k;
+          int xsample = x < 0 ? 0 : x >= in_w-1 ? in_w-1 : x;
+          float flt = coeffs_x[coeff_idx];
+          for (int c = 0; c < channels; c++) {
+            Src px = __ldg(in_row + channels * xsample + c);
+            sum[c] = fmaf(px, flt, sum[c]);
+          }
+        }
+
+        for (int c = 0; c < channels; c++)
+          tmp_row[channels * threadIdx.x + c] = sum[c] * norm;
+      }
+    }
+  }
+  __syncthreads();
+
+  if (dx >= hi.x)
+    return;
+
+  for (int i = threadIdx.y; i < hi.y - lo.y; i += blockDim.y) {
+    const int dy = lo.y + i;
+    const int sy0 = __float2int_ru(dy * scale.y + src_y0);
+    const float *row_coeffs = &coeffs_y[i * support_y];
+
+    float norm = 0;
+    for (int k = 0; k < support_y; k++) {
+      norm += row_coeffs[k];
+    }
+    norm = 1.0f / norm;
+
+    Dst *out_col = &out[dy * out_stride + dx * channels];
+    const float *tmp_col = &tmp[(sy0 - row0) * tmp_stride + threadIdx.x * channels];
+
+    if (static_channels < 0) {
+      for (int c = 0; c < channels; c++) {
+        float sum = 0;
+        for (int k = 0; k < support_y; k++)
+          sum = fmaf(tmp_col[k * tmp_stride + c], row_coeffs[k], sum);
+        out_col[c] = ConvertSat<Dst>(sum * norm);
+      }
+    } else {
+      float sum[static_channels < 0 ? 1 : static_channels];  // NOLINT - not a variable length array
+      for (int c = 0; c < channels; c++)
+        sum[c] = 0;
+
+      for (int k = 0; k < support_y; k++) {
+        float flt = row_coeffs[k];
+        for (int c = 0; c < channels; c++)
+          sum[c] = fmaf(tmp_col[k * tmp_stride + c], flt, sum[c]);
+      }
+
+      for (int c = 0; c < channels; c++)
+        out_col[c] = ConvertSat<Dst>(sum[c] * norm);
+    }
+  }
+}
+
 }  // namespace
 
 /**
@@ -619,6 +932,7 @@ __device__ void ResampleDepth_Channels(
  * @param out_strides - stride between output rows (and slices)
  * @param in_strides - stride between input rows (and slices)
  * @param in_shape - shape of the input (x, y[, z]) order
+ * @param static_support - the support, if there's a kernel specialized for it, or 0
  */
 template <int spatial_ndim, typename Dst, typename Src>
 __device__ void ResampleHorz(
@@ -627,7 +941,18 @@ __device__ void ResampleHorz(
     Dst *__restrict__ out, ptrdiff_vec<spatial_ndim-1> out_strides,
     const Src *__restrict__ in, ptrdiff_vec<spatial_ndim-1> in_strides,
     ivec<spatial_ndim> in_shape, int channels,
-    ResamplingFilter filter, int support) {
+    ResamplingFilter filter, int support, int static_support = 0) {
+  if constexpr (spatial_ndim == 2) {
+    if (static_support > 0) {
+      VALUE_SWITCH(channels, static_channels, (1, 3, 4), (
+        VALUE_SWITCH(static_support, kSupport, (2, 3, 4, 5, 6, 7, 8), (
+          ResampleHorz_Static<static_channels, kSupport>(
+            lo, hi, src_x0, scale, out, out_strides, in, in_strides, in_shape, filter);
+          return;
+        ), ());  // NOLINT
+      ), ());  // NOLINT
+    }
+  }
   // Specialize over common numbers of channels.
   // Ca. 20% speedup compared to generic code path for
   // three channel image with large kernel.
@@ -656,6 +981,7 @@ __device__ void ResampleHorz(
  * @param out_strides - stride between output rows (and slices)
  * @param in_strides - stride between input rows (and slices)
  * @param in_shape - shape of the input (x, y[, z]) order
+ * @param static_support - the support, if there's a kernel specialized for it, or 0
  */
 template <int spatial_ndim, typename Dst, typename Src>
 __device__ void ResampleVert(
@@ -664,7 +990,18 @@ __device__ void ResampleVert(
     Dst *__restrict__ out, ptrdiff_vec<spatial_ndim-1> out_strides,
     const Src *__restrict__ in, ptrdiff_vec<spatial_ndim-1> in_strides,
     ivec<spatial_ndim> in_shape, int channels,
-    ResamplingFilter filter, int support) {
+    ResamplingFilter filter, int support, int static_support = 0) {
+  if constexpr (spatial_ndim == 2) {
+    if (static_support > 0) {
+      VALUE_SWITCH(channels, static_channels, (1, 3, 4), (
+        VALUE_SWITCH(static_support, kSupport, (2, 3, 4, 5, 6, 7, 8), (
+          ResampleVert_Static<static_channels, kSupport>(
+            lo, hi, src_y0, scale, out, out_strides, in, in_strides, in_shape, filter);
+          return;
+        ), ());  // NOLINT
+      ), ());  // NOLINT
+    }
+  }
   // Specialize over common numbers of channels.
   // Ca. 20% speedup compared to generic code path for
   // three channel image with large kernel.
@@ -720,6 +1057,40 @@ __device__ void ResampleDepth(
   ));  // NOLINT
 }
 
+/**
+ * @brief Implements horizontal and vertical resampling in a single pass
+ * @param lo - inclusive lower bound output coordinates
+ * @param hi - exclusive upper bound output coordinates
+ * @param origin - source coordinates corresponding to output 0
+ * @param scale - step, in source coordinates, for one pixel in output (may be negative)
+ * @param out_strides - stride between output rows
+ * @param in_strides - stride between input rows
+ * @param in_shape - shape of the input (x, y)
+ * @param tile_rows - maximum height of the output tile processed by the block
+ */
+template <typename Dst, typename Src>
+__device__ void ResampleFused(
+    ivec2 lo, ivec2 hi,
+    vec2 origin, vec2 scale,
+    Dst *__restrict__ out, ptrdiff_vec<1> out_strides,
+    const Src *__restrict__ in, ptrdiff_vec<1> in_strides,
+    ivec2 in_shape, int channels,
+    ResamplingFilter filter_x, ResamplingFilter filter_y, int tile_rows) {
+  VALUE_SWITCH(channels, static_channels, (1, 2, 3, 4),
+  (
+    ResampleFused_Channels<static_channels>(
+      lo, hi, origin, scale,
+      out, out_strides, in, in_strides, in_shape,
+      static_channels, filter_x, filter_y, tile_rows);
+  ),  // NOLINT
+  (
+    ResampleFused_Channels<-1>(
+      lo, hi, origin, scale,
+      out, out_strides, in, in_strides, in_shape,
+      channels, filter_x, filter_y, tile_rows);
+  ));  // NOLINT
+}
+
 }  // namespace kernels
 }  // namespace dali
 
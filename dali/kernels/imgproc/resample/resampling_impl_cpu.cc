@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <cmath>
+#include <vector>
+#include "dali/core/convert.h"
 #include "dali/kernels/imgproc/resample/resampling_filters.cuh"
 #include "dali/kernels/imgproc/resample/resampling_impl_cpu.h"
 
@@ -46,5 +48,76 @@ void InitializeResamplingFilter(
   }
 }
 
+namespace {
+
+struct FixedPointFilter {
+  int out_size = -1;
+  float srcx0 = 0, scale = 0;
+  ResamplingFilter filter = {};
+  std::vector<int32_t> indices;
+  std::vector<float> float_coeffs;
+  std::vector<int16_t> coeffs;
+
+  bool Matches(int out_size, float srcx0, float scale, const ResamplingFilter &filter) const {
+    return this->out_size == out_size && this->srcx0 == srcx0 && this->scale == scale &&
+           this->filter.coeffs == filter.coeffs && this->filter.num_coeffs == filter.num_coeffs &&
+           this->filter.anchor == filter.anchor && this->filter.scale == filter.scale;
+  }
+
+  void Init(int out_size, float srcx0, float scale, const ResamplingFilter &filter) {
+    this->out_size = out_size;
+    this->srcx0 = srcx0;
+    this->scale = scale;
+    this->filter = filter;
+    int support = filter.support();
+    indices.resize(out_size);
+    float_coeffs.resize(out_size * support);
+    coeffs.resize(out_size * support);
+    InitializeResamplingFilter(indices.data(), float_coeffs.data(), out_size, srcx0, scale,
+                               filter);
+    const int one = 1 << kFixedPointCoeffBits;
+    for (int x = 0; x < out_size; x++) {
+      const float *in = &float_coeffs[x * support];
+      int16_t *out = &coeffs[x * support];
+      int sum = 0, largest = 0;
+      bool nonzero = false;
+      for (int k = 0; k < support; k++) {
+        out[k] = ConvertSat<int16_t>(in[k] * one);
+        sum += out[k];
+        nonzero |= in[k] != 0;
+        if (std::abs(in[k]) > std::abs(in[largest]))
+          largest = k;
+      }
+      // the kernels are normalized - make the fixed-point kernel sum up to 1, too
+      if (nonzero)
+        out[largest] = ConvertSat<int16_t>(out[largest] + one - sum);
+    }
+  }
+};
+
+}  // namespace
+
+void GetFixedPointFilter(const int32_t *&out_indices, const int16_t *&out_coeffs, int out_size,
+                         float srcx0, float scale, const ResamplingFilter &filter) {
+  // a few most recently used filters - e.g. both axes of a couple of sizes
+  static constexpr int kCacheSize = 4;
+  static thread_local FixedPointFilter cache[kCacheSize];
+  static thread_local int next = 0;
+  FixedPointFilter *entry = nullptr;
+  for (auto &e : cache) {
+    if (e.Matches(out_size, srcx0, scale, filter)) {
+      entry = &e;
+      break;
+    }
+  }
+  if (!entry) {
+    entry = &cache[next];
+    next = (next + 1) % kCacheSize;
+    entry->Init(out_size, srcx0, scale, filter);
+  }
+  out_indices = entry->indices.data();
+  out_coeffs = entry->coeffs.data();
+}
+
 }  // namespace kernels
 }  // namespace dali
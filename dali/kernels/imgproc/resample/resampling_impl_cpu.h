@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -87,7 +87,7 @@ void ResampleCol(Out *out, const In *in, int x, int w, const int32_t *in_columns
 
 template <typename Out, typename In>
 struct SIMD_vert_resample_impl {
-#ifdef __SSE2__
+#ifdef DALI_SIMD_FLOAT4
   static constexpr int kVecSize = 16;
   static constexpr int load_lanes = kVecSize / sizeof(In);
   static constexpr int store_lanes = kVecSize / sizeof(Out);
@@ -100,15 +100,15 @@ struct SIMD_vert_resample_impl {
   static void run(Out *out, const In **rows, const float *kernel, int support,
                    int begin_col, int end_col) {
     int i = begin_col;
-#ifdef __SSE2__
+#ifdef DALI_SIMD_FLOAT4
     for (; i + kNumLanes <= end_col; i += kNumLanes) {
       vec_pack vtmp = vec_pack::zero();
 
       for (int k = 0; k < support; k++) {
         vec_pack vin = vec_pack::load(rows[k] + i);
-        __m128 coeff = _mm_set1_ps(kernel[k]);
+        simd::float4_t coeff = simd::set1_f(kernel[k]);
         for (int v = 0; v < kNumVecs; v++)
-          vtmp.v[v] = _mm_add_ps(vtmp.v[v], _mm_mul_ps(coeff, vin.v[v]));
+          vtmp.v[v] = simd::madd(vtmp.v[v], coeff, vin.v[v]);
       }
       store(out + i, vtmp);
     }
@@ -125,7 +125,7 @@ struct SIMD_vert_resample_impl {
 
 template <typename Out, typename In>
 struct SIMD_horz_resample_impl {
-#ifdef __SSE2__
+#ifdef DALI_SIMD_FLOAT4
   static constexpr int kVecSize = 16;
   static constexpr int kNumLanes = kVecSize / sizeof(Out);
   static constexpr int kNumVecs = kNumLanes * sizeof(float) / kVecSize;
@@ -141,7 +141,7 @@ struct SIMD_horz_resample_impl {
     const int channels = static_channels < 0 ? dynamic_channels : static_channels;
 
     int x = ox0;
-#ifdef __SSE2__
+#ifdef DALI_SIMD_FLOAT4
     float tmpin[kNumLanes];
     for (; x + kNumLanes <= ox1; x += kNumLanes) {
       Out tmp_out[kNumLanes];
@@ -167,7 +167,7 @@ struct SIMD_horz_resample_impl {
             vec_pack vin = vec_pack::load(tmpin);
 
             for (int v = 0; v < kNumVecs; v++)
-              vout.v[v] = _mm_add_ps(vout.v[v], _mm_mul_ps(vcoeffs.v[v], vin.v[v]));
+              vout.v[v] = simd::madd(vout.v[v], vcoeffs.v[v], vin.v[v]);
           }
           store(tmp_out, vout);
           for (int l = 0; l < kNumLanes; l++)
@@ -202,7 +202,7 @@ struct SIMD_horz_resample_impl {
           for (int c = 0; c < channels; c++) {
             vec_pack vin = vec_pack::load(tmp_in[c]);
             for (int v = 0; v < kNumVecs; v++)
-              vout[c].v[v] = _mm_add_ps(vout[c].v[v], _mm_mul_ps(vcoeffs.v[v], vin.v[v]));
+              vout[c].v[v] = simd::madd(vout[c].v[v], vcoeffs.v[v], vin.v[v]);
           }
         }
 
@@ -225,6 +225,37 @@ struct SIMD_horz_resample_impl {
   }
 };
 
+/**
+ * @brief bfloat16 has no vectorized store - the output is calculated with the scalar code
+ */
+template <typename In>
+struct SIMD_vert_resample_impl<bfloat16, In> {
+  static void run(bfloat16 *out, const In **rows, const float *kernel, int support,
+                  int begin_col, int end_col) {
+    for (int i = begin_col; i < end_col; i++) {
+      float tmp = 0;
+      for (int k = 0; k < support; k++)
+        tmp += rows[k][i] * kernel[k];
+      out[i] = ConvertSat<bfloat16>(tmp);
+    }
+  }
+};
+
+template <typename In>
+struct SIMD_horz_resample_impl<bfloat16, In> {
+  template <int static_channels, bool clamp_left, bool clamp_right>
+  inline int run(bfloat16 *out, const In *in, int ox0, int ox1, int w,
+                 const int32_t *in_columns,
+                 const float *coeffs, int support,
+                 int dynamic_channels) {
+    int x = ox0;
+    for (; x < ox1; x++) {
+      ResampleCol<static_channels, clamp_left, clamp_right, bfloat16, In>(
+          out, in, x, w, in_columns, coeffs, support, dynamic_channels);
+    }
+    return x;
+  }
+};
 
 
 /**
@@ -510,6 +541,166 @@ inline void ResampleAxis(Surface<spatial_ndim, Out> out, Surface<spatial_ndim, I
     assert(!"Invalid axis index");
 }
 
+/// Number of fractional bits of the fixed-point filter coefficients
+constexpr int kFixedPointCoeffBits = 14;
+/// Number of fractional bits of the fixed-point (int16) intermediate image
+constexpr int kFixedPointTmpBits = 6;
+
+/**
+ * @brief Gets the fixed-point filter used for resampling an axis
+ *
+ * The indices and the coefficients are the ones calculated by InitializeResamplingFilter, with
+ * the coefficients converted to int16 with kFixedPointCoeffBits fractional bits. The largest
+ * coefficient of each kernel is adjusted so that the kernel sums up to exactly 1.
+ *
+ * The filters are cached per thread, so that the samples (or tiles of a sample) resized with
+ * the same scale and origin reuse the tables. The returned pointers are valid until the next
+ * call in the same thread.
+ */
+DLL_PUBLIC
+void GetFixedPointFilter(const int32_t *&out_indices, const int16_t *&out_coeffs, int out_size,
+                         float srcx0, float scale, const ResamplingFilter &filter);
+
+/**
+ * @brief Converts a fixed-point value with `shift` fractional bits to Out, with rounding
+ */
+template <int shift, typename Out>
+DALI_FORCEINLINE Out FixedPointToInt(int32_t value) {
+  return ConvertSat<Out>((value + (1 << (shift - 1))) >> shift);
+}
+
+/**
+ * @brief Resamples a surface horizontally, using a fixed-point filter
+ *
+ * The input values are multiplied by the int16 coefficients and accumulated in int32.
+ * The result is shifted right by `shift` bits, with rounding, and saturated to Out.
+ */
+template <int shift, int static_channels = -1, typename Out, typename In>
+void ResampleHorzFixed_Channels(Surface2D<Out> out, Surface2D<const In> in,
+                                const int32_t *in_columns, const int16_t *coeffs, int support) {
+  const int channels = static_channels < 0 ? out.channels : static_channels;
+  const int w = in.size.x;
+
+  for (int y = 0; y < out.size.y; y++) {
+    Out *out_row = &out(0, y);
+    const In *in_row = &in(0, y);
+    int x = 0;
+#ifdef DALI_SIMD_FLOAT4
+    if (static_channels > 0) {
+      // we know how many channels we have at compile time - 8 columns of each channel at once
+      static constexpr int kNCh = static_channels > 0 ? static_channels : 1;
+      static constexpr int kNumLanes = 8;
+      for (; x + kNumLanes <= out.size.x; x += kNumLanes) {
+        simd::i32x8 acc[kNCh];
+        for (int c = 0; c < kNCh; c++)
+          acc[c] = simd::zero_i32x8();
+
+        for (int k = 0; k < support; k++) {
+          int16_t tmp_coeffs[kNumLanes];
+          int16_t tmp_in[kNCh][kNumLanes];
+          for (int l = 0; l < kNumLanes; l++) {
+            tmp_coeffs[l] = coeffs[(x + l) * support + k];  // interleave per-column coefficients
+            int srcx = clamp(in_columns[x + l] + k, 0, w - 1);
+            for (int c = 0; c < kNCh; c++)
+              tmp_in[c][l] = in_row[srcx * kNCh + c];
+          }
+          simd::i16x8_t vcoeffs = simd::load_i16(tmp_coeffs);
+          for (int c = 0; c < kNCh; c++)
+            simd::madd_i16(acc[c], simd::load_i16(tmp_in[c]), vcoeffs);
+        }
+
+        Out tmp_out[kNCh][kNumLanes];
+        for (int c = 0; c < kNCh; c++)
+          simd::store_shr<shift>(tmp_out[c], acc[c]);
+        for (int l = 0; l < kNumLanes; l++)
+          for (int c = 0; c < kNCh; c++)
+            out_row[kNCh * (x + l) + c] = tmp_out[c][l];  // interleave channels
+      }
+    }
+#endif
+    for (; x < out.size.x; x++) {
+      int x0 = in_columns[x];
+      const int16_t *kernel = &coeffs[x * support];
+      for (int c = 0; c < channels; c++) {
+        int32_t acc = 0;
+        for (int k = 0; k < support; k++) {
+          int srcx = clamp(x0 + k, 0, w - 1);
+          acc += kernel[k] * in_row[srcx * channels + c];
+        }
+        out_row[channels * x + c] = FixedPointToInt<shift, Out>(acc);
+      }
+    }
+  }
+}
+
+template <int shift, typename Out, typename In>
+void ResampleHorzFixed(Surface2D<Out> out, Surface2D<const In> in,
+                       const int32_t *in_columns, const int16_t *coeffs, int support) {
+  VALUE_SWITCH(out.channels, static_channels, (1, 2, 3, 4), (
+    ResampleHorzFixed_Channels<shift, static_channels>(out, in, in_columns, coeffs, support);
+  ), (  // NOLINT
+    ResampleHorzFixed_Channels<shift, -1>(out, in, in_columns, coeffs, support);
+  ));   // NOLINT
+}
+
+/**
+ * @brief Resamples a surface vertically, using a fixed-point filter
+ *
+ * @see ResampleHorzFixed_Channels
+ */
+template <int shift, typename Out, typename In>
+void ResampleVertFixed(Surface2D<Out> out, Surface2D<const In> in, const int32_t *in_rows,
+                       const int16_t *row_coeffs, int support) {
+  int flat_w = out.size.x * out.channels;
+
+  assert(support > 0);
+  const In **in_row_ptrs = static_cast<const In **>(alloca(support * sizeof(const In *)));
+
+  for (int y = 0; y < out.size.y; y++) {
+    Out *out_row = &out(0, y, 0);
+    const int16_t *kernel = &row_coeffs[y * support];
+
+    for (int k = 0; k < support; k++) {
+      int sy = clamp(in_rows[y] + k, 0, in.size.y - 1);
+      in_row_ptrs[k] = &in(0, sy);
+    }
+
+    int i = 0;
+#ifdef DALI_SIMD_FLOAT4
+    for (; i + 8 <= flat_w; i += 8) {
+      simd::i32x8 acc = simd::zero_i32x8();
+      for (int k = 0; k < support; k++)
+        simd::madd_i16(acc, simd::load_i16(in_row_ptrs[k] + i), simd::set1_i16(kernel[k]));
+      simd::store_shr<shift>(out_row + i, acc);
+    }
+#endif
+    for (; i < flat_w; i++) {
+      int32_t acc = 0;
+      for (int k = 0; k < support; k++)
+        acc += kernel[k] * in_row_ptrs[k][i];
+      out_row[i] = FixedPointToInt<shift, Out>(acc);
+    }
+  }
+}
+
+/**
+ * @brief Resamples an axis of a 2D surface, using a fixed-point filter
+ *
+ * @param axis - 0 - horizontal (X), 1 - vertical (Y)
+ * @see ResampleAxis
+ */
+template <int shift, typename Out, typename In>
+inline void ResampleAxisFixed(Surface2D<Out> out, Surface2D<const In> in,
+                              const int32_t *in_indices, const int16_t *coeffs, int support,
+                              int axis) {
+  if (axis == 1)
+    ResampleVertFixed<shift>(out, in, in_indices, coeffs, support);
+  else if (axis == 0)
+    ResampleHorzFixed<shift>(out, in, in_indices, coeffs, support);
+  else
+    assert(!"Invalid axis index");
+}
+
 /**
  * @brief Resamples `in` using Nearest Neighbor interpolation and stores result in `out`
  * @param out - output surface
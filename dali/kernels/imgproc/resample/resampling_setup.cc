@@ -14,6 +14,7 @@
 
 #include <cuda_runtime.h>
 #include <algorithm>
+#include "dali/core/error_handling.h"
 #include "dali/core/util.h"
 #include "dali/kernels/imgproc/resample/resampling_setup.h"
 #include "dali/kernels/common/block_setup.h"
@@ -255,6 +256,74 @@ void SeparableResamplingSetup<3>::ComputeBlockLayout(SampleDesc &sample) const {
   }
 }
 
+/**
+ * @brief Calculates the height of the tiles resampled in a single pass for a 2D sample
+ *
+ * The fused pass is used for the filters which are evaluated from the coefficient tables
+ * (i.e. not nearest neighbour or linear), when the source rows needed by a tile of at least
+ * kMinFusedTileRows output rows fit in the shared memory.
+ *
+ * @return The number of output rows in a tile or 0, if the sample can't be fused
+ */
+template <>
+int SeparableResamplingSetup<2>::FusedTileRows(const SampleDesc &desc) const {
+  constexpr int kMaxFusedTileRows = 32;
+  constexpr int kMinFusedTileRows = 8;
+  if (!fuse_passes || volume(desc.out_shape()) == 0)
+    return 0;
+  for (int axis = 0; axis < 2; axis++) {
+    if (desc.filter_type[axis] == ResamplingFilterType::Nearest ||
+        desc.filter_type[axis] == ResamplingFilterType::Linear ||
+        desc.filter[axis].num_coeffs == 0)
+      return 0;
+    // the coefficients for huge filters are stored differently in the separate passes
+    if (desc.filter[axis].support() > 256)
+      return 0;
+  }
+  int support_x = desc.filter[0].support();
+  int support_y = desc.filter[1].support();
+  for (int rows = kMaxFusedTileRows; rows >= kMinFusedTileRows; rows /= 2) {
+    int floats = FusedResampleSharedMemFloats(block_dim.x, rows, desc.channels, desc.scale[1],
+                                              support_x, support_y);
+    if (floats * static_cast<int>(sizeof(float)) <= ResampleSharedMemSize)
+      return rows;
+  }
+  return 0;
+}
+
+template <>
+int SeparableResamplingSetup<3>::FusedTileRows(const SampleDesc &) const {
+  return 0;
+}
+
+/**
+ * @brief Selects the kernel specialized for the filter support, used to resample the axis
+ *
+ * The filters evaluated from the coefficient tables with a support of up to
+ * kMaxStaticSupport taps (e.g. cubic or Lanczos3 when upscaling, triangular when downscaling
+ * up to 4x) are applied with the taps unrolled, for 1, 3 and 4 channels.
+ *
+ * @return The filter support or 0, if the generic kernel is used
+ */
+template <>
+int SeparableResamplingSetup<2>::StaticSupport(const SampleDesc &desc, int axis) const {
+  if (!static_support_kernels)
+    return 0;
+  if (desc.filter_type[axis] == ResamplingFilterType::Nearest ||
+      desc.filter_type[axis] == ResamplingFilterType::Linear ||
+      desc.filter[axis].num_coeffs == 0)
+    return 0;
+  if (desc.channels != 1 && desc.channels != 3 && desc.channels != 4)
+    return 0;
+  int support = desc.filter[axis].support();
+  return support >= kMinStaticSupport && support <= kMaxStaticSupport ? support : 0;
+}
+
+template <>
+int SeparableResamplingSetup<3>::StaticSupport(const SampleDesc &, int) const {
+  return 0;
+}
+
 /**
  * @brief Preprares a sample descriptor based on input shape and resampling parameters
  *
@@ -282,6 +351,8 @@ void SeparableResamplingSetup<spatial_ndim>::SetupSample(
 
   SetFilters(desc, params);
   ROI roi = ComputeScaleAndROI(desc, params);
+  for (int axis = 0; axis < spatial_ndim; axis++)
+    desc.static_support[axis] = StaticSupport(desc, axis);
 
   ivec<spatial_ndim> filter_support;
   for (int i = 0, d = spatial_ndim - 1; i < spatial_ndim; i++, d--) {
@@ -290,7 +361,14 @@ void SeparableResamplingSetup<spatial_ndim>::SetupSample(
     filter_support[i] = std::max(1, support);
   }
 
-  desc.order = GetProcessingOrder(roi.extent(), out_size, filter_support);
+  desc.fused_tile_rows = FusedTileRows(desc);
+  if (desc.fused_tile_rows > 0) {
+    // the fused pass resamples the rows first
+    for (int i = 0; i < spatial_ndim; i++)
+      desc.order[i] = i;
+  } else {
+    desc.order = GetProcessingOrder(roi.extent(), out_size, filter_support);
+  }
 
   {
     ivec<spatial_ndim> pass_size = roi.extent();
@@ -318,6 +396,12 @@ void SeparableResamplingSetup<spatial_ndim>::SetupSample(
     desc.offsets[stage] = 0;
   }
 
+  // a single frame by default - the frames are whole buffers, so the input ROI doesn't apply
+  desc.num_frames = 1;
+  desc.frame_strides[0] = volume(in_shape);
+  for (int stage = 1; stage <= spatial_ndim; stage++)
+    desc.frame_strides[stage] = volume(desc.shapes[stage]) * static_cast<ptrdiff_t>(channels);
+
   {
     int first_pass_axis = desc.order[0];
     auto strides = cat<ptrdiff_t>(channels, desc.strides[0]);
@@ -340,13 +424,15 @@ void SeparableResamplingSetup<spatial_ndim>::SetupSample(
  */
 template <int spatial_ndim>
 void BatchResamplingSetup<spatial_ndim>::SetupBatch(
-    const TensorListShape<tensor_ndim> &in, const Params &params) {
+    const TensorListShape<tensor_ndim> &in, const Params &params, span<const int> num_frames) {
   constexpr int channel_dim =  BatchResamplingSetup<spatial_ndim>::channel_dim;
   if (!this->filters)
     this->Initialize();
 
   int N = in.num_samples();
   assert(params.size() == static_cast<span_extent_t>(N));
+  DALI_ENFORCE(num_frames.empty() || num_frames.size() == static_cast<span_extent_t>(N),
+    "The number of frames must be given for each sample or not at all.");
 
   sample_descs.resize(N);
   for (auto &shape : intermediate_shapes)
@@ -357,14 +443,29 @@ void BatchResamplingSetup<spatial_ndim>::SetupBatch(
     size = 0;
 
   total_blocks = 0;
+  fused_blocks = 0;
+  max_frames = 1;
 
   for (int i = 0; i < N; i++) {
     SampleDesc &desc = sample_descs[i];
     auto ts_in = in.tensor_shape(i);
+    int frames = num_frames.empty() ? 1 : num_frames[i];
+    DALI_ENFORCE(frames >= 1 && frames <= frame_limit, make_string(
+      "The number of frames in sample ", i, " (", frames, ") is out of range [1, ",
+      frame_limit, "]."));
+    DALI_ENFORCE(ts_in[0] % frames == 0, make_string(
+      "The outermost extent of sample ", i, " (", ts_in[0], ") is not a multiple of "
+      "the number of frames (", frames, ")."));
+    ts_in[0] /= frames;
     this->SetupSample(desc, ts_in, params[i]);
+    desc.num_frames = frames;
+    max_frames = std::max(max_frames, frames);
 
     for (int t = 0; t < num_tmp_buffers; t++) {
-      TensorShape<tensor_ndim> ts_tmp = shape_cat(vec2shape(desc.tmp_shape(t)), desc.channels);
+      // the fused samples don't use the intermediate buffers
+      auto tmp_size = desc.fused_tile_rows > 0 ? ivec<spatial_ndim>() : desc.tmp_shape(t);
+      TensorShape<tensor_ndim> ts_tmp = shape_cat(vec2shape(tmp_size), desc.channels);
+      ts_tmp[0] *= frames;
       intermediate_shapes[t].set_tensor_shape(i, ts_tmp);
       intermediate_sizes[t] += volume(ts_tmp);
     }
@@ -372,11 +473,17 @@ void BatchResamplingSetup<spatial_ndim>::SetupBatch(
     auto ts_out = output_shape.tensor_shape_span(i);
     static_assert(channel_dim == spatial_ndim, "Shape calculation requires channel-last layout");
     auto sample_shape = shape_cat(vec2shape(desc.out_shape()), desc.channels);
+    sample_shape[0] *= frames;
 
     output_shape.set_tensor_shape(i, sample_shape);
     if (volume(desc.out_shape()) == 0)
       continue;  // this sample does not generate any blocks
 
+    if (desc.fused_tile_rows > 0) {
+      fused_blocks += volume(div_ceil(desc.out_shape(), FusedBlockShape(desc)));
+      continue;
+    }
+
     for (int pass = 0; pass < spatial_ndim; pass++) {
       ivec<spatial_ndim> blocks;
       for (int d = 0; d < spatial_ndim; d++) {
@@ -412,6 +519,7 @@ int AddBlocks(BlockDesc<n> *blocks, int sample_idx,
  *
  * Each block descriptor contains the sample index and the range of output coordinates processed
  * by this block (lo, hi).
+ * The blocks of the fused samples are placed after the blocks of all the passes.
  */
 template <int spatial_ndim>
 void BatchResamplingSetup<spatial_ndim>::InitializeSampleLookup(
@@ -419,6 +527,7 @@ void BatchResamplingSetup<spatial_ndim>::InitializeSampleLookup(
   int blocks_in_all_passes = 0;
   for (int i = 0; i < spatial_ndim; i++)
     blocks_in_all_passes += total_blocks[i];
+  blocks_in_all_passes += fused_blocks;
 
   assert(sample_lookup.shape[0] >= blocks_in_all_passes);
   (void)blocks_in_all_passes;  // for non-debug builds
@@ -428,13 +537,19 @@ void BatchResamplingSetup<spatial_ndim>::InitializeSampleLookup(
   for (int pass = 0; pass < spatial_ndim; pass++) {
     for (int i = 0; i < N; i++) {
       auto &desc = sample_descs[i];
-      if (volume(desc.out_shape()) > 0) {
+      if (volume(desc.out_shape()) > 0 && desc.fused_tile_rows == 0) {
         int sample_block_count = AddBlocks(sample_lookup.data + block, i,
                                           desc.logical_block_shape[pass], desc.shapes[pass+1]);
         block += sample_block_count;
       }
     }
   }
+  // the blocks of the fused samples follow the ones of all the separate passes
+  for (int i = 0; i < N; i++) {
+    auto &desc = sample_descs[i];
+    if (volume(desc.out_shape()) > 0 && desc.fused_tile_rows > 0)
+      block += AddBlocks(sample_lookup.data + block, i, FusedBlockShape(desc), desc.out_shape());
+  }
   assert(block == blocks_in_all_passes);
 }
 
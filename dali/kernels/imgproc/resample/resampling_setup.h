@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
 #define DALI_KERNELS_IMGPROC_RESAMPLE_RESAMPLING_SETUP_H_
 
 #include <cuda_runtime.h>
+#include <cmath>
 #include <memory>
 #include <vector>
 #include "dali/kernels/common/block_setup.h"
@@ -29,6 +30,15 @@ namespace dali {
 namespace kernels {
 namespace resampling {
 
+constexpr int ResampleSharedMemSize = 32<<10;
+
+/**
+ * @brief The range of filter supports for which there are resampling kernels with
+ *        the filter taps unrolled at compile time
+ */
+constexpr int kMinStaticSupport = 2;
+constexpr int kMaxStaticSupport = 8;
+
 template <int spatial_ndim>
 using ProcessingOrder = i8vec<spatial_ndim>;
 
@@ -97,10 +107,50 @@ struct SampleDesc {
   int channels;
   ResamplingFilterType filter_type[spatial_ndim];  // NOLINT
   ResamplingFilter filter[spatial_ndim];           // NOLINT
+  /**
+   * @brief The filter support, if the axis is resampled by a kernel specialized for it, or 0
+   */
+  int static_support[spatial_ndim];                // NOLINT
 
   DeviceArray<ivec<spatial_ndim>, spatial_ndim> logical_block_shape;
+
+  /**
+   * @brief The height (in output rows) of the tiles processed in a single, fused pass
+   *
+   * If 0, the sample is resampled in separate passes, through the intermediate buffers.
+   */
+  int fused_tile_rows;
+
+  /**
+   * @brief The number of frames (e.g. of a video) resampled with the same parameters
+   *
+   * The frames are stacked along the outermost dimension of each buffer, `frame_strides`
+   * elements apart. They're processed by the consecutive rows of the grid (blockIdx.y).
+   */
+  int num_frames;
+  DeviceArray<ptrdiff_t, num_buffers> frame_strides;
 };
 
+/**
+ * @brief The number of source rows needed to produce `tile_rows` output rows in
+ *        the fused resampling
+ */
+DALI_HOST_DEV inline int FusedResampleInputRows(int tile_rows, float scale_y, int support_y) {
+  return static_cast<int>(ceilf((tile_rows - 1) * fabsf(scale_y))) + support_y + 2;
+}
+
+/**
+ * @brief The number of floats in the shared memory used by the fused resampling
+ *
+ * The shared memory contains the horizontal filter coefficients for each column of the tile,
+ * the vertical coefficients for each output row and the horizontally resampled source rows.
+ */
+DALI_HOST_DEV inline int FusedResampleSharedMemFloats(int tile_width, int tile_rows, int channels,
+                                                      float scale_y, int support_x, int support_y) {
+  return tile_width * support_x + tile_rows * support_y +
+         FusedResampleInputRows(tile_rows, scale_y, support_y) * tile_width * channels;
+}
+
 ResamplingFilter GetResamplingFilter(const ResamplingFilters *filters, const FilterDesc &params);
 
 /**
@@ -142,12 +192,28 @@ class SeparableResamplingSetup {
 
   ivec3 block_dim;
 
+  /**
+   * @brief If true, the 2D samples with small enough filters are resampled in a single pass
+   *
+   * The horizontally resampled rows are then kept in shared memory instead of the intermediate
+   * buffer. Only the GPU implementation supports it.
+   */
+  bool fuse_passes = false;
+
+  /**
+   * @brief If true, the separate passes with small filters use the kernels specialized for
+   *        the filter support and the number of channels (see StaticSupport)
+   */
+  bool static_support_kernels = true;
+
  protected:
   using ROI = Roi<spatial_ndim>;
 
   void SetFilters(SampleDesc &desc, const ResamplingParamsND<spatial_ndim> &params) const;
   ROI ComputeScaleAndROI(SampleDesc &desc, const ResamplingParamsND<spatial_ndim> &params) const;
   void ComputeBlockLayout(SampleDesc &sample) const;
+  int FusedTileRows(const SampleDesc &desc) const;
+  int StaticSupport(const SampleDesc &desc, int axis) const;
 
   std::shared_ptr<ResamplingFilters> filters;
 
@@ -170,17 +236,38 @@ class BatchResamplingSetup : public SeparableResamplingSetup<_spatial_ndim> {
   TensorListShape<tensor_ndim> output_shape, intermediate_shapes[num_tmp_buffers]; // NOLINT
   size_t intermediate_sizes[num_tmp_buffers];  // NOLINT
   ivec<spatial_ndim> total_blocks;
+  /** @brief The number of blocks which resample the fused samples in a single pass */
+  int fused_blocks = 0;
+  /** @brief The largest number of frames in a sample - the height of the grid */
+  int max_frames = 1;
+  /** @brief The limit of the number of frames in a sample (the limit of the grid height) */
+  static constexpr int frame_limit = 65535;
 
-  /** @brief Prepares sample descriptors and block info for entire batch */
-  DLL_PUBLIC void SetupBatch(const TensorListShape<tensor_ndim> &in, const Params &params);
+  /**
+   * @brief Prepares sample descriptors and block info for entire batch
+   *
+   * @param num_frames  if not empty, the number of frames in each sample; the frames are
+   *                    stacked along the outermost dimension and share the sample descriptor
+   */
+  DLL_PUBLIC void SetupBatch(const TensorListShape<tensor_ndim> &in, const Params &params,
+                             span<const int> num_frames = {});
 
   template <typename Collection>
-  void SetupBatch(const TensorListShape<tensor_ndim> &in, const Collection &params) {
-    SetupBatch(in, make_cspan(params));
+  void SetupBatch(const TensorListShape<tensor_ndim> &in, const Collection &params,
+                  span<const int> num_frames = {}) {
+    SetupBatch(in, make_cspan(params), num_frames);
   }
 
   /** @brief Calculates the mapping from grid block indices to samples and regions within samples */
   DLL_PUBLIC void InitializeSampleLookup(const OutTensorCPU<BlockDesc, 1> &sample_lookup);
+
+ private:
+  ivec<spatial_ndim> FusedBlockShape(const SampleDesc &desc) const {
+    ivec<spatial_ndim> blk = desc.out_shape();
+    blk[0] = this->block_dim.x;
+    blk[1] = desc.fused_tile_rows;
+    return blk;
+  }
 };
 
 }  // namespace resampling
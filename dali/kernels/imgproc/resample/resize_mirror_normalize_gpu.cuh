@@ -0,0 +1,243 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_KERNELS_IMGPROC_RESAMPLE_RESIZE_MIRROR_NORMALIZE_GPU_CUH_
+#define DALI_KERNELS_IMGPROC_RESAMPLE_RESIZE_MIRROR_NORMALIZE_GPU_CUH_
+
+#include <cuda_runtime.h>
+#include <algorithm>
+#include <vector>
+#include "dali/core/convert.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/geom/vec.h"
+#include "dali/core/math_util.h"
+#include "dali/core/small_vector.h"
+#include "dali/core/span.h"
+#include "dali/core/static_switch.h"
+#include "dali/kernels/kernel.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief Parameters of the fused resize, mirror and normalization of one sample
+ */
+struct ResizeMirrorNormalizeArgs {
+  /// The resized region of the input, in (x, y) order, in pixels
+  vec2 roi_lo, roi_hi;
+  /// The size of the output, in (x, y) order
+  ivec2 out_size;
+  /// If true, the output is flipped horizontally
+  bool mirror = false;
+  /// Per-channel (or scalar) mean and reciprocal of standard deviation; empty if not normalized
+  SmallVector<float, 4> mean, inv_stddev;
+  /// The number of output channels; the channels past the input ones are set to `fill_value`
+  int out_channels = 0;
+  float fill_value = 0;
+  /// If true, the output is in CHW layout; otherwise it's HWC
+  bool planar = true;
+};
+
+namespace resize_mirror_normalize {
+
+static constexpr int kMaxChannels = 4;
+
+template <typename Out, typename In>
+struct SampleDesc {
+  Out *__restrict__ out;
+  const In *__restrict__ in;
+  ivec2 in_size, out_size;
+  int in_channels, out_channels;
+  /// Source coordinates of the output pixel (x, y) are origin + (x + 0.5) * scale
+  vec2 origin, scale;
+  /// out = in * norm_mul + norm_add; for the padding channels norm_add is the fill value
+  float norm_mul[kMaxChannels], norm_add[kMaxChannels];  // NOLINT
+  bool planar;
+};
+
+/**
+ * @brief Resamples the input with bilinear interpolation and writes the normalized values
+ *        of all the channels of a pixel, in the output layout.
+ *
+ * The grid's z dimension goes over the samples.
+ */
+template <int static_channels, typename Out, typename In>
+__device__ void ResizeMirrorNormalizeSample(const SampleDesc<Out, In> &sample, int x, int y) {
+  const int in_channels = static_channels < 0 ? sample.in_channels : static_channels;
+  const int in_w = sample.in_size.x, in_h = sample.in_size.y;
+  const ptrdiff_t in_stride = static_cast<ptrdiff_t>(in_w) * in_channels;
+
+  float sx = sample.origin.x + (x + 0.5f) * sample.scale.x - 0.5f;
+  float sy = sample.origin.y + (y + 0.5f) * sample.scale.y - 0.5f;
+  int sx0i = __float2int_rd(sx);
+  int sy0i = __float2int_rd(sy);
+  float qx = sx - sx0i;
+  float qy = sy - sy0i;
+  int sx0 = clamp(sx0i, 0, in_w - 1), sx1 = clamp(sx0i + 1, 0, in_w - 1);
+  int sy0 = clamp(sy0i, 0, in_h - 1), sy1 = clamp(sy0i + 1, 0, in_h - 1);
+
+  const In *in00 = &sample.in[sy0 * in_stride + sx0 * in_channels];
+  const In *in01 = &sample.in[sy0 * in_stride + sx1 * in_channels];
+  const In *in10 = &sample.in[sy1 * in_stride + sx0 * in_channels];
+  const In *in11 = &sample.in[sy1 * in_stride + sx1 * in_channels];
+
+  const ptrdiff_t plane = static_cast<ptrdiff_t>(sample.out_size.x) * sample.out_size.y;
+  const ptrdiff_t px = static_cast<ptrdiff_t>(y) * sample.out_size.x + x;
+  // in planar layout, the channels are one plane apart; otherwise, they're adjacent
+  const ptrdiff_t channel_stride = sample.planar ? plane : 1;
+  Out *out = sample.planar ? &sample.out[px] : &sample.out[px * sample.out_channels];
+
+  #pragma unroll
+  for (int c = 0; c < kMaxChannels; c++) {
+    if (c >= in_channels)
+      break;
+    float a = __ldg(&in00[c]);
+    float b = __ldg(&in01[c]);
+    float top = fmaf(b - a, qx, a);
+    a = __ldg(&in10[c]);
+    b = __ldg(&in11[c]);
+    float bottom = fmaf(b - a, qx, a);
+    float value = fmaf(bottom - top, qy, top);
+    out[c * channel_stride] = ConvertSat<Out>(fmaf(value, sample.norm_mul[c], sample.norm_add[c]));
+  }
+  for (int c = in_channels; c < sample.out_channels; c++)
+    out[c * channel_stride] = ConvertSat<Out>(sample.norm_add[c]);
+}
+
+template <typename Out, typename In>
+__global__ void ResizeMirrorNormalizeKernel(const SampleDesc<Out, In> *samples) {
+  const SampleDesc<Out, In> &sample = samples[blockIdx.z];
+  int x = blockIdx.x * blockDim.x + threadIdx.x;
+  int y = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= sample.out_size.x || y >= sample.out_size.y)
+    return;
+  VALUE_SWITCH(sample.in_channels, static_channels, (1, 3, 4), (
+    ResizeMirrorNormalizeSample<static_channels>(sample, x, y);
+  ), (  // NOLINT
+    ResizeMirrorNormalizeSample<-1>(sample, x, y);
+  ));   // NOLINT
+}
+
+}  // namespace resize_mirror_normalize
+
+/**
+ * @brief Resizes a region of interest, mirrors, normalizes, pads the channels and
+ *        optionally transposes the samples to planar layout - all in a single pass.
+ *
+ * This is the GPU equivalent of a resize followed by slice-flip-normalize-permute-pad,
+ * without the intermediate buffer. The interpolation is bilinear, without antialiasing,
+ * so the results match the separable resampling with the linear filter when upscaling.
+ *
+ * The input is a batch of HWC images with at most 4 channels.
+ */
+template <typename Out, typename In>
+class ResizeMirrorNormalizeGPU {
+ public:
+  static constexpr int kMaxChannels = resize_mirror_normalize::kMaxChannels;
+
+  KernelRequirements Setup(KernelContext &context,
+                           const TensorListShape<3> &in_shape,
+                           span<const ResizeMirrorNormalizeArgs> args) {
+    int N = in_shape.num_samples();
+    DALI_ENFORCE(static_cast<int>(args.size()) == N,
+                 "The number of the arguments must match the number of samples.");
+    KernelRequirements req;
+    TensorListShape<3> out_shape(N);
+    for (int i = 0; i < N; i++) {
+      int in_channels = in_shape.tensor_shape_span(i)[2];
+      int out_channels = OutChannels(args[i], in_channels);
+      DALI_ENFORCE(in_channels >= 1 && in_channels <= kMaxChannels &&
+                   out_channels <= kMaxChannels,
+                   make_string("The fused resize supports up to ", kMaxChannels,
+                               " channels, got: ", in_channels, " -> ", out_channels));
+      DALI_ENFORCE(args[i].mean.size() == args[i].inv_stddev.size() &&
+                   (args[i].mean.size() <= 1 ||
+                    static_cast<int>(args[i].mean.size()) == in_channels),
+                   "The normalization arguments must be scalars or have one value per channel.");
+      int W = args[i].out_size.x, H = args[i].out_size.y;
+      if (args[i].planar)
+        out_shape.set_tensor_shape(i, {out_channels, H, W});
+      else
+        out_shape.set_tensor_shape(i, {H, W, out_channels});
+    }
+    req.output_shapes = { out_shape };
+    return req;
+  }
+
+  void Run(KernelContext &context,
+           const OutListGPU<Out, 3> &out,
+           const InListGPU<In, 3> &in,
+           span<const ResizeMirrorNormalizeArgs> args) {
+    int N = in.num_samples();
+    if (N == 0)
+      return;
+    samples_.resize(N);
+    ivec2 max_size = { 0, 0 };
+    for (int i = 0; i < N; i++) {
+      auto in_sh = in.tensor_shape_span(i);
+      auto &a = args[i];
+      auto &s = samples_[i];
+      s.out = out.tensor_data(i);
+      s.in = in.tensor_data(i);
+      s.in_size = { static_cast<int>(in_sh[1]), static_cast<int>(in_sh[0]) };
+      s.in_channels = in_sh[2];
+      s.out_channels = OutChannels(a, s.in_channels);
+      s.out_size = a.out_size;
+      s.planar = a.planar;
+      vec2 lo = a.roi_lo, hi = a.roi_hi;
+      if (a.mirror)
+        std::swap(lo.x, hi.x);
+      s.origin = lo;
+      s.scale = (hi - lo) / vec2(max(a.out_size, ivec2(1, 1)));
+      for (int c = 0; c < kMaxChannels; c++) {
+        if (c >= s.in_channels) {
+          s.norm_mul[c] = 0;
+          s.norm_add[c] = a.fill_value;
+        } else if (a.mean.empty()) {
+          s.norm_mul[c] = 1;
+          s.norm_add[c] = 0;
+        } else {
+          int idx = a.mean.size() > 1 ? c : 0;
+          s.norm_mul[c] = a.inv_stddev[idx];
+          s.norm_add[c] = -a.mean[idx] * a.inv_stddev[idx];
+        }
+      }
+      max_size = max(max_size, a.out_size);
+    }
+    if (max_size.x == 0 || max_size.y == 0)
+      return;
+
+    auto *samples_gpu = context.scratchpad->ToGPU(context.gpu.stream, samples_);
+    dim3 block(32, 8);
+    dim3 grid(div_ceil(max_size.x, block.x), div_ceil(max_size.y, block.y), N);
+    resize_mirror_normalize::ResizeMirrorNormalizeKernel<<<grid, block, 0, context.gpu.stream>>>(
+        samples_gpu);
+    CUDA_CALL(cudaGetLastError());
+  }
+
+ private:
+  static int OutChannels(const ResizeMirrorNormalizeArgs &args, int in_channels) {
+    return std::max(args.out_channels, in_channels);
+  }
+
+  std::vector<resize_mirror_normalize::SampleDesc<Out, In>> samples_;
+};
+
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_RESAMPLE_RESIZE_MIRROR_NORMALIZE_GPU_CUH_
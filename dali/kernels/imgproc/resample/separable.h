@@ -37,8 +37,13 @@ struct SeparableResamplingFilter {
 
   using Params = span<const ResamplingParamsND<spatial_ndim> >;
 
+  /**
+   * @param num_frames  if not empty, the number of frames stacked along the outermost dimension
+   *                    of each sample; the frames are resampled with the sample's parameters
+   */
   virtual KernelRequirements
-  Setup(KernelContext &context, const Input &in, const Params &params) = 0;
+  Setup(KernelContext &context, const Input &in, const Params &params,
+        span<const int> num_frames = {}) = 0;
 
   virtual void
   Run(KernelContext &context, const Output &out, const Input &in, const Params &params) = 0;
@@ -16,6 +16,7 @@
 #define DALI_KERNELS_IMGPROC_RESAMPLE_SEPARABLE_IMPL_H_
 
 #include <cuda_runtime.h>
+#include <type_traits>
 #include "dali/kernels/imgproc/resample/separable.h"
 #include "dali/kernels/imgproc/resample/resampling_setup.h"
 #include "dali/kernels/imgproc/resample/resampling_batch.h"
@@ -48,6 +49,18 @@ struct SeparableResamplingGPUImpl : Interface {
   using SampleDesc = typename ResamplingSetup::SampleDesc;
   using BlockDesc = typename ResamplingSetup::BlockDesc;
   static constexpr int num_tmp_buffers = ResamplingSetup::num_tmp_buffers;
+
+  /**
+   * Whether the 2D samples can be resampled in a single pass (see BatchedFusedResample)
+   */
+  static constexpr bool fused_pass_supported = spatial_ndim == 2 &&
+    (std::is_same<OutputElement, InputElement>::value ||
+     std::is_same<OutputElement, float>::value);
+
+  SeparableResamplingGPUImpl() {
+    setup.fuse_passes = fused_pass_supported;
+  }
+
   /**
    * Generates and stores resampling setup
    */
@@ -87,9 +100,10 @@ struct SeparableResamplingGPUImpl : Interface {
     return max_even;
   }
 
-  virtual KernelRequirements Setup(KernelContext &context, const Input &in, const Params &params) {
+  virtual KernelRequirements Setup(KernelContext &context, const Input &in, const Params &params,
+                                   span<const int> num_frames = {}) {
     Initialize(context);
-    setup.SetupBatch(in.shape, params);
+    setup.SetupBatch(in.shape, params, num_frames);
     // this will allocate and calculate offsets
     for (int i = 0; i < num_tmp_buffers; i++) {
       intermediate[i] = { nullptr, setup.intermediate_shapes[i] };
@@ -103,7 +117,7 @@ struct SeparableResamplingGPUImpl : Interface {
 
     // CPU block2sample lookup may change in size and is large enough
     // to mandate declaring it as a requirement for external allocator.
-    size_t num_blocks = 0;
+    size_t num_blocks = setup.fused_blocks;
     for (auto x : setup.total_blocks)
       num_blocks += x;
 
@@ -127,7 +141,7 @@ struct SeparableResamplingGPUImpl : Interface {
     BatchedSeparableResample<spatial_ndim, PassOutputElement, PassInputElement>(
         which_pass,
         descs_gpu, block2sample.data, block2sample.shape[0],
-        setup.block_dim,
+        setup.block_dim, setup.max_frames,
         stream);
   }
 
@@ -141,7 +155,7 @@ struct SeparableResamplingGPUImpl : Interface {
 
     SampleDesc *descs_gpu = context.scratchpad->AllocateGPU<SampleDesc>(setup.sample_descs.size());
 
-    int blocks_in_all_passes = 0;
+    int blocks_in_all_passes = setup.fused_blocks;
     for (auto x : setup.total_blocks)
       blocks_in_all_passes += x;
 
@@ -165,6 +179,8 @@ struct SeparableResamplingGPUImpl : Interface {
                                              { setup.total_blocks[pass] });
       pass_lookup_offset += setup.total_blocks[pass];
     }
+    InTensorGPU<BlockDesc, 1> fused_lookup = make_tensor_gpu<1>(
+        sample_lookup_gpu.data + pass_lookup_offset, { setup.fused_blocks });
 
     auto *tmp_mem = context.scratchpad->AllocateGPU<IntermediateElement>(GetTmpMemSize());
 
@@ -192,9 +208,24 @@ struct SeparableResamplingGPUImpl : Interface {
         cudaMemcpyHostToDevice,
         stream));
 
+    RunFusedPass(descs_gpu, fused_lookup, stream,
+                 std::integral_constant<bool, fused_pass_supported>());
     RunPasses(descs_gpu, pass_lookup, stream, std::integral_constant<int, spatial_ndim>());
   }
 
+  void RunFusedPass(SampleDesc *descs_gpu,
+                    const InTensorGPU<BlockDesc, 1> &fused_lookup,
+                    cudaStream_t stream,
+                    std::true_type) {
+    BatchedFusedResample<OutputElement, InputElement>(
+        descs_gpu, fused_lookup.data, fused_lookup.shape[0],
+        setup.block_dim, setup.max_frames,
+        stream);
+  }
+
+  void RunFusedPass(SampleDesc *, const InTensorGPU<BlockDesc, 1> &, cudaStream_t,
+                    std::false_type) {}
+
   void RunPasses(SampleDesc *descs_gpu,
                  const InTensorGPU<BlockDesc, 1> *pass_lookup,
                  cudaStream_t stream,
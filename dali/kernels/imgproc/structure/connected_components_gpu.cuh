@@ -0,0 +1,324 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_KERNELS_IMGPROC_STRUCTURE_CONNECTED_COMPONENTS_GPU_CUH_
+#define DALI_KERNELS_IMGPROC_STRUCTURE_CONNECTED_COMPONENTS_GPU_CUH_
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/format.h"
+#include "dali/core/geom/vec.h"
+#include "dali/core/math_util.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/core/util.h"
+#include "dali/kernels/common/disjoint_set_gpu.cuh"
+#include "dali/kernels/context.h"
+
+namespace dali {
+namespace kernels {
+namespace connected_components {
+namespace gpu {
+
+constexpr int kBlockSize = 256;
+
+/// The number of elements of a row processed by one thread when calculating the boxes
+constexpr int kBoxChunk = 256;
+
+inline int GridSize(int64_t n) {
+  return std::max<int64_t>(1, std::min<int64_t>(div_ceil(n, kBlockSize), 4096));
+}
+
+/**
+ * @brief Makes each non-background element a separate group; background is marked with -1
+ */
+template <typename Label, typename T>
+__global__ void InitLabelsKernel(Label *labels, const T *in, int64_t n, T background) {
+  for (int64_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += blockDim.x * gridDim.x)
+    labels[i] = in[i] == background ? Label(-1) : Label(i);
+}
+
+/**
+ * @brief Merges the groups of elements with their next neighbors along each axis,
+ *        if the values are equal.
+ */
+template <int ndim, typename Label, typename T>
+__global__ void MergeKernel(Label *labels, const T *in, i64vec<ndim> shape,
+                            i64vec<ndim> strides, int64_t n, T background) {
+  for (int64_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += blockDim.x * gridDim.x) {
+    T value = in[i];
+    if (value == background)
+      continue;
+    for (int d = 0; d < ndim; d++) {
+      int64_t pos = i / strides[d] % shape[d];
+      if (pos + 1 < shape[d] && in[i + strides[d]] == value)
+        disjoint_set_gpu<Label>::merge(labels, i, i + strides[d]);
+    }
+  }
+}
+
+/**
+ * @brief Points each element directly at its root and counts the roots
+ */
+template <typename Label>
+__global__ void CompressKernel(Label *labels, int64_t n,
+                               unsigned long long *num_roots) {  // NOLINT
+  for (int64_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += blockDim.x * gridDim.x) {
+    if (labels[i] < 0)
+      continue;
+    if (disjoint_set_gpu<Label>::compress(labels, i) == i)
+      atomicAdd(num_roots, 1ull);
+  }
+}
+
+/**
+ * @brief Assigns consecutive object indices to the roots
+ *
+ * The index is stored in place of the root's label as `-(index + 2)`, distinguishable from
+ * the background (-1) and from the labels of the other elements, which point at the root.
+ */
+template <typename Label, typename T>
+__global__ void AssignObjectsKernel(Label *labels, const T *in, int64_t n,
+                                    unsigned long long *counter,  // NOLINT
+                                    int64_t *roots, int *values) {
+  for (int64_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += blockDim.x * gridDim.x) {
+    if (labels[i] != i)
+      continue;
+    int64_t idx = atomicAdd(counter, 1ull);
+    roots[idx] = i;
+    values[idx] = in[i];
+    labels[i] = -(idx + 2);
+  }
+}
+
+template <typename Label>
+__device__ int64_t ObjectIndex(const Label *labels, int64_t i) {
+  Label l = labels[i];
+  if (l == -1)
+    return -1;
+  if (l < 0)
+    return -l - 2;
+  return -labels[l] - 2;
+}
+
+template <typename Coord>
+__global__ void InitBoxesKernel(Coord *lo, Coord *hi, int64_t n) {
+  for (int64_t i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += blockDim.x * gridDim.x) {
+    lo[i] = std::numeric_limits<Coord>::max();
+    hi[i] = std::numeric_limits<Coord>::min();
+  }
+}
+
+/**
+ * @brief Calculates the bounding boxes of the objects
+ *
+ * Each thread goes over a chunk of a row and extends the boxes once per run of elements
+ * that belong to the same object, rather than once per element.
+ */
+template <int ndim, typename Label>
+__global__ void BoxesKernel(int *lo, int *hi, const Label *labels, i64vec<ndim> shape) {
+  int64_t row_len = shape[ndim - 1];
+  int64_t chunks_per_row = div_ceil(row_len, kBoxChunk);
+  int64_t num_rows = 1;
+  for (int d = 0; d < ndim - 1; d++)
+    num_rows *= shape[d];
+  int64_t num_chunks = num_rows * chunks_per_row;
+
+  for (int64_t w = blockIdx.x * blockDim.x + threadIdx.x; w < num_chunks;
+       w += blockDim.x * gridDim.x) {
+    int64_t row = w / chunks_per_row;
+    int64_t x0 = w % chunks_per_row * kBoxChunk;
+    int64_t x1 = cuda_min(x0 + kBoxChunk, row_len);
+    int64_t row_start = row * row_len;
+
+    ivec<ndim> pos;
+    for (int d = ndim - 2; d >= 0; d--) {
+      pos[d] = row % shape[d];
+      row /= shape[d];
+    }
+
+    auto extend = [&](int64_t obj, int start, int end) {
+      int *obj_lo = lo + obj * ndim;
+      int *obj_hi = hi + obj * ndim;
+      for (int d = 0; d < ndim - 1; d++) {
+        atomicMin(&obj_lo[d], pos[d]);
+        atomicMax(&obj_hi[d], pos[d] + 1);
+      }
+      atomicMin(&obj_lo[ndim - 1], start);
+      atomicMax(&obj_hi[ndim - 1], end);
+    };
+
+    int64_t run_obj = -1;
+    int run_start = 0;
+    for (int64_t x = x0; x < x1; x++) {
+      int64_t obj = ObjectIndex(labels, row_start + x);
+      if (obj == run_obj)
+        continue;
+      if (run_obj >= 0)
+        extend(run_obj, run_start, x);
+      run_obj = obj;
+      run_start = x;
+    }
+    if (run_obj >= 0)
+      extend(run_obj, run_start, x1);
+  }
+}
+
+/**
+ * @brief Labels the objects and calculates their boxes, in device memory
+ *
+ * @return The number of objects
+ */
+template <typename Label, int ndim, typename T>
+int64_t LabelObjects(int64_t *&roots, int *&values, int *&lo, int *&hi,
+                     const T *in, const TensorShape<ndim> &shape, T background,
+                     Scratchpad &scratch, cudaStream_t stream) {
+  int64_t n = volume(shape);
+  i64vec<ndim> shape_vec, strides;
+  int64_t stride = 1;
+  for (int d = ndim - 1; d >= 0; d--) {
+    shape_vec[d] = shape[d];
+    strides[d] = stride;
+    stride *= shape[d];
+  }
+
+  auto *counters = scratch.AllocateGPU<unsigned long long>(2);  // NOLINT
+  auto *host_counter = scratch.AllocatePinned<unsigned long long>(1);  // NOLINT
+  CUDA_CALL(cudaMemsetAsync(counters, 0, 2 * sizeof(*counters), stream));
+  Label *labels = scratch.AllocateGPU<Label>(n);
+  int grid = GridSize(n);
+
+  InitLabelsKernel<<<grid, kBlockSize, 0, stream>>>(labels, in, n, background);
+  CUDA_CALL(cudaGetLastError());
+  MergeKernel<<<grid, kBlockSize, 0, stream>>>(labels, in, shape_vec, strides, n, background);
+  CUDA_CALL(cudaGetLastError());
+  CompressKernel<<<grid, kBlockSize, 0, stream>>>(labels, n, counters);
+  CUDA_CALL(cudaGetLastError());
+  CUDA_CALL(cudaMemcpyAsync(host_counter, counters, sizeof(*counters),
+                            cudaMemcpyDeviceToHost, stream));
+  CUDA_CALL(cudaStreamSynchronize(stream));
+  int64_t nobj = *host_counter;
+  if (nobj == 0)
+    return 0;
+
+  roots = scratch.AllocateGPU<int64_t>(nobj);
+  values = scratch.AllocateGPU<int>(nobj);
+  lo = scratch.AllocateGPU<int>(nobj * ndim);
+  hi = scratch.AllocateGPU<int>(nobj * ndim);
+  AssignObjectsKernel<<<grid, kBlockSize, 0, stream>>>(
+      labels, in, n, counters + 1, roots, values);
+  CUDA_CALL(cudaGetLastError());
+  InitBoxesKernel<<<GridSize(nobj * ndim), kBlockSize, 0, stream>>>(lo, hi, nobj * ndim);
+  CUDA_CALL(cudaGetLastError());
+  int64_t row_len = shape[ndim - 1];
+  int64_t num_chunks = n / row_len * div_ceil(row_len, kBoxChunk);
+  BoxesKernel<<<GridSize(num_chunks), kBlockSize, 0, stream>>>(lo, hi, labels, shape_vec);
+  CUDA_CALL(cudaGetLastError());
+  return nobj;
+}
+
+}  // namespace gpu
+
+/**
+ * @brief Finds the blobs of connected elements with equal, non-background values
+ *        and their bounding boxes, on the GPU
+ *
+ * The elements are connected by faces and belong to the same blob if they have the same value,
+ * as in `LabelConnectedRegions` with that value selected. The blobs are ordered by the flat
+ * index of their first element - the same order as the labels assigned by
+ * `LabelConnectedRegions`.
+ *
+ * The function waits for the stream twice: once to get the number of blobs and once to get
+ * the results.
+ *
+ * @param values    receives the values (labels) of the elements of each of the blobs
+ * @param box_data  receives the bounding boxes of the blobs - `ndim` start coordinates followed
+ *                  by `ndim` one-past-end coordinates, per blob (the layout of `Box<ndim, int>`)
+ * @param in        the input, in device memory
+ * @param shape     the shape of the input; 1 to 6 dimensions
+ * @param scratch   provides the temporary device and pinned memory
+ *
+ * @return The number of blobs
+ */
+template <typename T>
+int64_t FindObjectsGPU(std::vector<int> &values, std::vector<int> &box_data,
+                       const T *in, const TensorShape<> &shape, same_as_t<T> background,
+                       Scratchpad &scratch, cudaStream_t stream) {
+  values.clear();
+  box_data.clear();
+  int64_t n = volume(shape);
+  if (n == 0)
+    return 0;
+  int ndim = shape.size();
+
+  int64_t *d_roots = nullptr;
+  int *d_values = nullptr, *d_lo = nullptr, *d_hi = nullptr;
+  int64_t nobj = 0;
+  VALUE_SWITCH(ndim, static_ndim, (1, 2, 3, 4, 5, 6), (
+    auto sh = shape.to_static<static_ndim>();
+    // the labels are flat element indices, so 32 bits are enough for up to 2^31 elements
+    if (n > 0x80000000)
+      nobj = gpu::LabelObjects<int64_t>(d_roots, d_values, d_lo, d_hi,
+                                        in, sh, background, scratch, stream);
+    else
+      nobj = gpu::LabelObjects<int32_t>(d_roots, d_values, d_lo, d_hi,
+                                        in, sh, background, scratch, stream);
+  ), (  // NOLINT
+    throw std::invalid_argument(make_string(
+        "Unsupported number of dimensions: ", ndim, ". Valid range is 1..6."));
+  ));  // NOLINT
+  if (nobj == 0)
+    return 0;
+
+  auto *roots = scratch.AllocatePinned<int64_t>(nobj);
+  auto *obj_values = scratch.AllocatePinned<int>(nobj);
+  auto *lo = scratch.AllocatePinned<int>(nobj * ndim);
+  auto *hi = scratch.AllocatePinned<int>(nobj * ndim);
+  CUDA_CALL(cudaMemcpyAsync(roots, d_roots, nobj * sizeof(int64_t),
+                            cudaMemcpyDeviceToHost, stream));
+  CUDA_CALL(cudaMemcpyAsync(obj_values, d_values, nobj * sizeof(int),
+                            cudaMemcpyDeviceToHost, stream));
+  CUDA_CALL(cudaMemcpyAsync(lo, d_lo, nobj * ndim * sizeof(int), cudaMemcpyDeviceToHost, stream));
+  CUDA_CALL(cudaMemcpyAsync(hi, d_hi, nobj * ndim * sizeof(int), cudaMemcpyDeviceToHost, stream));
+  CUDA_CALL(cudaStreamSynchronize(stream));
+
+  // the indices were assigned in an arbitrary order - sort the objects by their first element
+  std::vector<int64_t> order(nobj);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](int64_t a, int64_t b) {
+    return roots[a] < roots[b];
+  });
+  values.resize(nobj);
+  box_data.resize(2 * ndim * nobj);
+  for (int64_t i = 0; i < nobj; i++) {
+    int64_t o = order[i];
+    values[i] = obj_values[o];
+    for (int d = 0; d < ndim; d++) {
+      box_data[2 * ndim * i + d] = lo[o * ndim + d];
+      box_data[2 * ndim * i + ndim + d] = hi[o * ndim + d];
+    }
+  }
+  return nobj;
+}
+
+}  // namespace connected_components
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_STRUCTURE_CONNECTED_COMPONENTS_GPU_CUH_
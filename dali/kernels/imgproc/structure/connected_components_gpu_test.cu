@@ -0,0 +1,119 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "dali/core/cuda_stream.h"
+#include "dali/core/mm/memory.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/imgproc/structure/connected_components.h"
+#include "dali/kernels/imgproc/structure/connected_components_gpu.cuh"
+#include "dali/kernels/imgproc/structure/label_bbox.h"
+#include "dali/test/tensor_test_utils.h"
+
+namespace dali {
+namespace kernels {
+
+/**
+ * @brief Compares the blobs found on the GPU with the ones labeled for each class on the CPU
+ */
+template <int ndim>
+void TestFindObjectsGPU(const TensorShape<ndim> &shape, int num_classes, int seed) {
+  std::mt19937 rng(seed);
+  int64_t n = volume(shape);
+  std::vector<uint8_t> input(n);
+  // short runs of equal values, so that there are blobs larger than a single element
+  std::uniform_int_distribution<int> value_dist(0, num_classes), run_dist(1, 5);
+  for (int64_t i = 0; i < n;) {
+    int value = value_dist(rng);
+    for (int r = run_dist(rng); r > 0 && i < n; r--)
+      input[i++] = value;
+  }
+  const uint8_t background = 0;
+
+  auto gpu_input = mm::alloc_raw_unique<uint8_t, mm::memory_kind::device>(n);
+  CUDAStream stream = CUDAStream::Create(true);
+  CUDA_CALL(cudaMemcpyAsync(gpu_input.get(), input.data(), n, cudaMemcpyHostToDevice, stream));
+
+  std::vector<int> values, box_data;
+  DynamicScratchpad scratch({}, AccessOrder(stream));
+  int64_t nobj = connected_components::FindObjectsGPU(
+      values, box_data, gpu_input.get(), TensorShape<>(shape), background, scratch, stream);
+  ASSERT_EQ(static_cast<int64_t>(values.size()), nobj);
+  ASSERT_EQ(static_cast<int64_t>(box_data.size()), 2 * ndim * nobj);
+
+  int64_t total = 0;
+  std::vector<uint8_t> filtered(n);
+  std::vector<int> blobs(n);
+  for (int cls = 1; cls <= num_classes; cls++) {
+    for (int64_t i = 0; i < n; i++)
+      filtered[i] = input[i] == cls;
+    auto blob_tv = make_tensor_cpu<ndim>(blobs.data(), shape);
+    int64_t nblobs = connected_components::LabelConnectedRegions<int, uint8_t, ndim>(
+        blob_tv, make_tensor_cpu<ndim>(filtered.data(), shape), -1, 0);
+    std::vector<Box<ndim, int>> ref(nblobs);
+    label_bbox::GetLabelBoundingBoxes(make_span(ref),
+                                      make_tensor_cpu<ndim>(blobs.data(), shape), -1);
+    total += nblobs;
+
+    int64_t b = 0;
+    for (int64_t i = 0; i < nobj; i++) {
+      if (values[i] != cls)
+        continue;
+      ASSERT_LT(b, nblobs) << "Too many blobs of class " << cls;
+      for (int d = 0; d < ndim; d++) {
+        EXPECT_EQ(box_data[2 * ndim * i + d], ref[b].lo[d]) << "blob " << b << " of class " << cls;
+        EXPECT_EQ(box_data[2 * ndim * i + ndim + d], ref[b].hi[d])
+            << "blob " << b << " of class " << cls;
+      }
+      b++;
+    }
+    EXPECT_EQ(b, nblobs) << "Wrong number of blobs of class " << cls;
+  }
+  EXPECT_EQ(total, nobj);
+}
+
+TEST(ConnectedComponentsGPU, FindObjects1D) {
+  TestFindObjectsGPU(TensorShape<1>{10000}, 3, 1);
+}
+
+TEST(ConnectedComponentsGPU, FindObjects2D) {
+  TestFindObjectsGPU(TensorShape<2>{123, 457}, 2, 2);
+}
+
+TEST(ConnectedComponentsGPU, FindObjects3D) {
+  TestFindObjectsGPU(TensorShape<3>{31, 45, 67}, 4, 3);
+}
+
+TEST(ConnectedComponentsGPU, FindObjects4D) {
+  TestFindObjectsGPU(TensorShape<4>{5, 1, 29, 30}, 3, 4);
+}
+
+TEST(ConnectedComponentsGPU, NoObjects) {
+  const int n = 1000;
+  auto gpu_input = mm::alloc_raw_unique<int, mm::memory_kind::device>(n);
+  CUDAStream stream = CUDAStream::Create(true);
+  CUDA_CALL(cudaMemsetAsync(gpu_input.get(), 0, n * sizeof(int), stream));
+  std::vector<int> values, box_data;
+  DynamicScratchpad scratch({}, AccessOrder(stream));
+  EXPECT_EQ(connected_components::FindObjectsGPU(
+      values, box_data, gpu_input.get(), TensorShape<>(10, 100), 0, scratch, stream), 0);
+  EXPECT_TRUE(values.empty());
+  EXPECT_TRUE(box_data.empty());
+}
+
+}  // namespace kernels
+}  // namespace dali
@@ -0,0 +1,138 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_KERNELS_IMGPROC_WARP_WARP_PERSISTENT_IMPL_CUH_
+#define DALI_KERNELS_IMGPROC_WARP_WARP_PERSISTENT_IMPL_CUH_
+
+#include "dali/kernels/imgproc/warp/warp_setup.cuh"
+#include "dali/kernels/imgproc/warp/block_warp.cuh"
+#include "dali/kernels/imgproc/warp/mapping_traits.h"
+#include "dali/core/static_switch.h"
+
+namespace dali {
+namespace kernels {
+namespace warp {
+
+/// Number of threads of the tile setup kernel; it's launched with a single block
+static constexpr int kTileSetupBlockSize = 256;
+
+/**
+ * @brief Calculates the tile offsets of the samples and resets the work counter
+ *
+ * `tile_offsets` receives the exclusive prefix sum of the number of tiles covering each sample;
+ * `tile_offsets[num_samples]` is the total number of tiles.
+ *
+ * @remarks Must be launched with a single block of kTileSetupBlockSize threads.
+ */
+template <int ndim, typename OutputType, typename InputType>
+__global__ void PersistentWarpTileSetup(
+    const SampleDesc<ndim, OutputType, InputType> *samples, int num_samples,
+    ivec2 tile_size, int *tile_offsets, int *work_counter) {
+  __shared__ int scan[kTileSetupBlockSize];
+  int carry = 0;
+  for (int base = 0; base < num_samples; base += kTileSetupBlockSize) {
+    int i = base + threadIdx.x;
+    int tiles = 0;
+    if (i < num_samples) {
+      auto size = samples[i].out_size;
+      tiles = div_ceil(size.x, tile_size.x) * div_ceil(size.y, tile_size.y);
+    }
+    scan[threadIdx.x] = tiles;
+    __syncthreads();
+    // Hillis-Steele inclusive scan within the chunk
+    for (int dist = 1; dist < kTileSetupBlockSize; dist <<= 1) {
+      int prev = threadIdx.x >= dist ? scan[threadIdx.x - dist] : 0;
+      __syncthreads();
+      scan[threadIdx.x] += prev;
+      __syncthreads();
+    }
+    if (i < num_samples)
+      tile_offsets[i] = carry + scan[threadIdx.x] - tiles;
+    carry += scan[kTileSetupBlockSize - 1];
+    __syncthreads();
+  }
+  if (threadIdx.x == 0) {
+    tile_offsets[num_samples] = carry;
+    *work_counter = 0;
+  }
+}
+
+/**
+ * @brief Finds the sample containing given tile - the last one with tile_offsets[i] <= tile
+ */
+__device__ inline int FindTileSample(const int *tile_offsets, int num_samples, int tile) {
+  int lo = 0, hi = num_samples - 1;
+  while (lo < hi) {
+    int mid = (lo + hi + 1) >> 1;
+    if (tile_offsets[mid] <= tile)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+/**
+ * @brief Warps a batch of samples with a fixed number of CUDA blocks
+ *
+ * The blocks keep fetching tiles from a global work counter until all the tiles,
+ * as enumerated by PersistentWarpTileSetup, are processed. A tile covers `tile_size` pixels
+ * in XY and, for volumes, the entire depth.
+ */
+template <typename Mapping,
+         int ndim, typename OutputType, typename InputType,
+         typename BorderType>
+__global__ void BatchWarpPersistent(
+    const SampleDesc<ndim, OutputType, InputType> *samples, int num_samples,
+    const int *tile_offsets, int *work_counter, ivec2 tile_size,
+    const mapping_params_t<Mapping> *mapping,
+    BorderType border) {
+  __shared__ int tile_idx;
+  const int total_tiles = tile_offsets[num_samples];
+  for (;;) {
+    if (threadIdx.x == 0 && threadIdx.y == 0 && threadIdx.z == 0)
+      tile_idx = atomicAdd(work_counter, 1);
+    __syncthreads();
+    int tile = tile_idx;
+    __syncthreads();  // all threads must read tile_idx before it's overwritten
+    if (tile >= total_tiles)
+      break;
+
+    int sample_idx = FindTileSample(tile_offsets, num_samples, tile);
+    auto sample = samples[sample_idx];
+    int tile_in_sample = tile - tile_offsets[sample_idx];
+    int tiles_x = div_ceil(sample.out_size.x, tile_size.x);
+
+    BlockDesc<ndim> block;
+    block.sample_idx = sample_idx;
+    block.start = 0;
+    block.end = sample.out_size;
+    block.start.x = (tile_in_sample % tiles_x) * tile_size.x;
+    block.start.y = (tile_in_sample / tiles_x) * tile_size.y;
+    block.end.x = ::min(block.start.x + tile_size.x, sample.out_size.x);
+    block.end.y = ::min(block.start.y + tile_size.y, sample.out_size.y);
+
+    VALUE_SWITCH(sample.interp, interp_const, (DALI_INTERP_NN, DALI_INTERP_LINEAR), (
+      BlockWarp<interp_const, Mapping, OutputType, InputType, BorderType>(
+        sample, block, Mapping(mapping[sample_idx]), border)),
+      (assert(!"Interpolation type not supported")));
+  }
+}
+
+}  // namespace warp
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_IMGPROC_WARP_WARP_PERSISTENT_IMPL_CUH_
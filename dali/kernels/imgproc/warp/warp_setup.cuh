@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -37,6 +37,15 @@ struct SampleDesc {
   DALIInterpType interp;
 };
 
+/**
+ * @brief Controls the use of the persistent kernel for variable-size batches
+ */
+enum class PersistentMode {
+  Auto,    ///< use the persistent kernel for large batches of small samples
+  Never,
+  Always,  ///< use the persistent kernel for all non-uniform batches
+};
+
 /**
  * @brief Prepares batched execution of warping kernel.
  *
@@ -58,14 +67,34 @@ class WarpSetup : public BlockSetup<spatial_ndim, spatial_ndim> {
   using SampleDesc = warp::SampleDesc<spatial_ndim, OutputType, InputType>;
   using BlockDesc = kernels::BlockDesc<spatial_ndim>;
 
+  /// Minimum number of samples for which the persistent kernel is used in the Auto mode
+  static constexpr int kPersistentMinSamples = 64;
+  /// Maximum output area (XY) of a sample for which the persistent kernel is used in the Auto mode
+  static constexpr int64_t kPersistentMaxSampleArea = 256 * 256;
+
   KernelRequirements Setup(const TensorListShape<tensor_ndim> &output_shape,
                            bool force_variable_size = false) {
-    SetupBlocks(output_shape, force_variable_size);
+    int N = output_shape.num_samples();
+    is_persistent_ = UsePersistent(output_shape, force_variable_size);
+    if (is_persistent_) {
+      // The tiles are enumerated on the GPU - here we only count them to limit the grid size
+      total_tiles_ = 0;
+      for (int i = 0; i < N; i++) {
+        auto size = shape2size(output_shape[i]);
+        total_tiles_ += div_ceil(size.x, persistent_tile_size_.x) *
+                        div_ceil(size.y, persistent_tile_size_.y);
+      }
+    } else {
+      SetupBlocks(output_shape, force_variable_size);
+    }
 
     KernelRequirements req = {};
     ScratchpadEstimator se;
-    se.add<mm::memory_kind::device, SampleDesc>(output_shape.num_samples());
-    se.add<mm::memory_kind::device, BlockDesc>(Blocks().size());
+    se.add<mm::memory_kind::device, SampleDesc>(N);
+    if (is_persistent_)
+      se.add<mm::memory_kind::device, int>(N + 2);  // tile offsets, total and work counter
+    else
+      se.add<mm::memory_kind::device, BlockDesc>(Blocks().size());
     req.output_shapes = { output_shape };
     req.scratch_sizes = se.sizes;
     return req;
@@ -102,8 +131,47 @@ class WarpSetup : public BlockSetup<spatial_ndim, spatial_ndim> {
 
   span<const SampleDesc> Samples() const { return make_span(samples_); }
 
+  void SetPersistentMode(PersistentMode mode) { persistent_mode_ = mode; }
+
+  PersistentMode GetPersistentMode() const { return persistent_mode_; }
+
+  /**
+   * @brief Whether the batch is processed by the persistent kernel
+   *
+   * In this mode, no blocks are generated on the host; the tiles of size PersistentTileSize()
+   * are enumerated on the GPU and distributed dynamically among a fixed number of CUDA blocks.
+   */
+  bool IsPersistent() const { return is_persistent_; }
+
+  ivec2 PersistentTileSize() const { return persistent_tile_size_; }
+
+  /// Total number of tiles in the batch; valid only in the persistent mode
+  int64_t PersistentTotalTiles() const { return total_tiles_; }
+
  private:
+  bool UsePersistent(const TensorListShape<tensor_ndim> &output_shape,
+                     bool force_variable_size) const {
+    if (persistent_mode_ == PersistentMode::Never ||
+        (!force_variable_size && is_uniform(output_shape)))
+      return false;
+    if (persistent_mode_ == PersistentMode::Always)
+      return true;
+    int N = output_shape.num_samples();
+    if (N < kPersistentMinSamples)
+      return false;
+    for (int i = 0; i < N; i++) {
+      auto size = shape2size(output_shape[i]);
+      if (static_cast<int64_t>(size.x) * size.y > kPersistentMaxSampleArea)
+        return false;
+    }
+    return true;
+  }
+
   std::vector<SampleDesc> samples_;
+  PersistentMode persistent_mode_ = PersistentMode::Auto;
+  bool is_persistent_ = false;
+  ivec2 persistent_tile_size_ = { 64, 32 };
+  int64_t total_tiles_ = 0;
 };
 
 }  // namespace warp
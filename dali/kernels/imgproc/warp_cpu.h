@@ -77,12 +77,31 @@ class WarpCPU {
       const TensorShape<spatial_ndim> &out_size,
       DALIInterpType interp = DALI_INTERP_LINEAR,
       const BorderType &border = {}) {
+    RunRange(context, output, input, mapping_params, out_size, 0, output.shape[0], interp, border);
+  }
+
+  /**
+   * @brief Computes a range of the outermost spatial dimension (rows or planes) of the output
+   *
+   * `output` is the whole output tensor and only the range [begin, end) of its outermost
+   * dimension is written, so the ranges can be computed concurrently.
+   */
+  void RunRange(
+      KernelContext &context,
+      const OutTensorCPU<OutputType, tensor_ndim> &output,
+      const InTensorCPU<InputType, tensor_ndim> &input,
+      const MappingParams &mapping_params,
+      const TensorShape<spatial_ndim> &out_size,
+      int64_t begin, int64_t end,
+      DALIInterpType interp = DALI_INTERP_LINEAR,
+      const BorderType &border = {}) {
     Mapping mapping(mapping_params);
 
     assert(output.shape == shape_cat(out_size, input.shape[channel_dim]));
+    assert(0 <= begin && begin <= end && end <= output.shape[0]);
 
     VALUE_SWITCH(interp, static_interp, (DALI_INTERP_NN, DALI_INTERP_LINEAR),
-      (RunImpl<static_interp>(context, output, input, mapping, border);),
+      (RunImpl<static_interp>(context, output, input, mapping, begin, end, border);),
       (DALI_FAIL("Unsupported interpolation type"))
     ); // NOLINT
   }
@@ -94,16 +113,16 @@ class WarpCPU {
       const OutTensorCPU<OutputType, 3> &output,
       const InTensorCPU<InputType, 3> &input,
       Mapping_ &mapping,
+      int64_t begin, int64_t end,
       BorderType border = {}) {
     int out_w = output.shape[1];
-    int out_h = output.shape[0];
     int c     = output.shape[2];
 
     Surface2D<const InputType> in = as_surface_channel_last(input);
 
     Sampler2D<static_interp, InputType> sampler(in);
 
-    for (int y = 0; y < out_h; y++) {
+    for (int y = begin; y < end; y++) {
       OutputType *out_row = output(y, 0);
       for (int x = 0; x < out_w; x++) {
         auto src = warp::map_coords(mapping, ivec2(x, y));
@@ -118,17 +137,17 @@ class WarpCPU {
       const OutTensorCPU<OutputType, 4> &output,
       const InTensorCPU<InputType, 4> &input,
       Mapping_ &mapping,
+      int64_t begin, int64_t end,
       BorderType border = {}) {
     int out_w = output.shape[2];
     int out_h = output.shape[1];
-    int out_d = output.shape[0];
     int c     = output.shape[3];
 
     Surface2D<const InputType> in = as_surface_channel_last(input);
 
     Sampler2D<static_interp, InputType> sampler(in);
 
-    for (int z = 0; z < out_d; z++) {
+    for (int z = begin; z < end; z++) {
       for (int y = 0; y < out_h; y++) {
         OutputType *out_row = output(z, y, 0);
         for (int x = 0; x < out_w; x++) {
@@ -146,9 +165,9 @@ class WarpCPU {
       const OutTensorCPU<OutputType, 3> &output,
       const InTensorCPU<InputType, 3> &input,
       AffineMapping<2> &mapping,
+      int64_t begin, int64_t end,
       BorderType border = {}) {
     int out_w = output.shape[1];
-    int out_h = output.shape[0];
     int c     = output.shape[2];
 
     Surface2D<const InputType> in = as_surface_channel_last(input);
@@ -164,7 +183,7 @@ class WarpCPU {
     constexpr int tile_w = 256;
     vec2 dsdx_tile = tile_w * dsdx;
 
-    for (int y = 0; y < out_h; y++) {
+    for (int y = begin; y < end; y++) {
       OutputType *out_row = output(y, 0);
       auto src_tile = warp::map_coords(mapping, ivec2(0, y));
       for (int x_tile = 0; x_tile < out_w; x_tile += tile_w, src_tile += dsdx_tile) {
@@ -184,10 +203,10 @@ class WarpCPU {
       const OutTensorCPU<OutputType, 4> &output,
       const InTensorCPU<InputType, 4> &input,
       AffineMapping<3> &mapping,
+      int64_t begin, int64_t end,
       BorderType border = {}) {
     int out_w = output.shape[2];
     int out_h = output.shape[1];
-    int out_d = output.shape[0];
     int c     = output.shape[3];
 
     Surface3D<const InputType> in = as_surface_channel_last(input);
@@ -203,7 +222,7 @@ class WarpCPU {
     constexpr int tile_w = 256;
     vec3 dsdx_tile = tile_w * dsdx;
 
-    for (int z = 0; z < out_d; z++) {
+    for (int z = begin; z < end; z++) {
       for (int y = 0; y < out_h; y++) {
         OutputType *out_row = output(z, y, 0);
         auto src_tile = warp::map_coords(mapping, ivec3(0, y, z));
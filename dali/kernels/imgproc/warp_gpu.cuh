@@ -15,12 +15,15 @@
 #ifndef DALI_KERNELS_IMGPROC_WARP_GPU_CUH_
 #define DALI_KERNELS_IMGPROC_WARP_GPU_CUH_
 
+#include <algorithm>
 #include "dali/core/common.h"
+#include "dali/core/cuda_utils.h"
 #include "dali/core/geom/vec.h"
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/imgproc/warp/warp_setup.cuh"
 #include "dali/kernels/imgproc/warp/warp_variable_size_impl.cuh"
 #include "dali/kernels/imgproc/warp/warp_uniform_size_impl.cuh"
+#include "dali/kernels/imgproc/warp/warp_persistent_impl.cuh"
 #include "dali/kernels/imgproc/warp/mapping_traits.h"
 
 namespace dali {
@@ -36,6 +39,8 @@ namespace kernels {
  *  * Assumes HWC layout
  *  * Output and input have same number of spatial dimenions
  *  * Output and input have same number of channels and layout
+ *  * Large batches of small, non-uniform samples are processed by a persistent kernel,
+ *    which avoids generating block descriptors on the host (see warp::PersistentMode)
  */
 template <typename _Mapping, int _spatial_ndim, typename _OutputType, typename _InputType,
           typename _BorderType>
@@ -84,7 +89,9 @@ class WarpGPU {
     dim3 grid_dim  = setup.GridDim();
     dim3 block_dim = setup.BlockDim();
 
-    if (setup.IsUniformSize()) {
+    if (setup.IsPersistent()) {
+      RunPersistent(context, mapping, border);
+    } else if (setup.IsUniformSize()) {
       std::tie(gpu_samples) =
         context.scratchpad->ToContiguousGPU(context.gpu.stream, setup.Samples());
       CUDA_CALL(cudaGetLastError());
@@ -123,8 +130,42 @@ class WarpGPU {
     }
   }
 
+  void SetPersistentMode(warp::PersistentMode mode) {
+    setup.SetPersistentMode(mode);
+  }
+
  private:
+  void RunPersistent(KernelContext &context,
+                     const InTensorGPU<MappingParams, 1> &mapping,
+                     BorderType border) {
+    int N = setup.Samples().size();
+    SampleDesc *gpu_samples = context.scratchpad->ToGPU(context.gpu.stream, setup.Samples());
+    int *tile_offsets = context.scratchpad->AllocateGPU<int>(N + 2);
+    int *work_counter = tile_offsets + N + 1;
+    ivec2 tile_size = setup.PersistentTileSize();
+
+    warp::PersistentWarpTileSetup<<<1, warp::kTileSetupBlockSize, 0, context.gpu.stream>>>(
+        gpu_samples, N, tile_size, tile_offsets, work_counter);
+    CUDA_CALL(cudaGetLastError());
+
+    dim3 block_dim = setup.BlockDim();
+    auto *kernel = warp::BatchWarpPersistent
+        <Mapping, spatial_ndim, OutputType, InputType, BorderType>;
+    if (blocks_per_sm_ == 0) {
+      CUDA_CALL(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+          &blocks_per_sm_, kernel, block_dim.x * block_dim.y * block_dim.z, 0));
+      if (blocks_per_sm_ < 1)
+        blocks_per_sm_ = 1;
+    }
+    int64_t max_blocks = static_cast<int64_t>(blocks_per_sm_) * GetSmCount();
+    int grid_dim = std::max<int64_t>(std::min(max_blocks, setup.PersistentTotalTiles()), 1);
+    kernel<<<grid_dim, block_dim, 0, context.gpu.stream>>>(
+        gpu_samples, N, tile_offsets, work_counter, tile_size, mapping.data, border);
+    CUDA_CALL(cudaGetLastError());
+  }
+
   WarpSetup setup;
+  int blocks_per_sm_ = 0;
   friend class WarpPrivateTest;
 };
 
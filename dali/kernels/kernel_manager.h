@@ -16,6 +16,7 @@
 #define DALI_KERNELS_KERNEL_MANAGER_H_
 
 #include <cassert>
+#include <cstddef>
 #include <memory>
 #include <utility>
 #include <atomic>
@@ -69,6 +70,11 @@ struct AnyKernelInstance {
  *
  * KernelManager provides type erasure for kernels whose type is selected at
  * run-time.
+ *
+ * The manager doesn't keep any scratch memory of its own. The scratchpads draw from the default
+ * stream-ordered memory resources, so the scratch memory is returned to the pool when a kernel
+ * is done with it and the next kernel (also from a different operator) on the same stream can
+ * reuse it. The pool grows only to the peak of the scratch memory that's live at the same time.
  */
 class DLL_PUBLIC KernelManager {
  public:
@@ -189,7 +195,8 @@ class DLL_PUBLIC KernelManager {
            "Kernel instance index (instance_idx) out of range");
     auto &inst = instances[instance_idx];
     if (!context.scratchpad) {
-      DynamicScratchpad scratchpad({}, AccessOrder(context.gpu.stream));
+      DynamicScratchpad scratchpad(InitialScratchSizes(inst.requirements),
+                                   AccessOrder(context.gpu.stream));
       context.scratchpad = &scratchpad;
       auto finally = AtScopeExit([&]() {
         context.scratchpad = nullptr;
@@ -201,6 +208,24 @@ class DLL_PUBLIC KernelManager {
   }
 
  private:
+  /**
+   * @brief The sizes of the first blocks of a temporary scratchpad
+   *
+   * When the first block can hold all the memory in the requirements, the scratchpad makes
+   * a single allocation, instead of a chain of ever larger blocks, which would also keep up to
+   * twice as much memory out of the pool.
+   */
+  static scratch_sizes_t InitialScratchSizes(const KernelRequirements &req) {
+    // room for the bookkeeping of the monotonic resource in the block
+    constexpr size_t kBlockOverhead = 256;
+    scratch_sizes_t sizes = {};
+    for (size_t i = 0; i < sizes.size(); i++) {
+      if (req.scratch_sizes[i])
+        sizes[i] = req.scratch_sizes[i] + kBlockOverhead;
+    }
+    return sizes;
+  }
+
   SmallVector<AnyKernelInstance, 1> instances;
 };
 
@@ -16,6 +16,8 @@
 #define DALI_KERNELS_MASK_GRID_MASK_GPU_H_
 
 #include <cuda_runtime.h>
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/common/block_setup.h"
@@ -46,8 +48,10 @@ __global__ void GridMaskKernel(const GridMaskSampleDesc<T> *samples,
       float fx = fmaf(x, sample.ca, fxy);
       float fy = fmaf(x, sample.sa, fyy);
       if ((fx - ::floor(fx) >= sample.ratio) || (fy - ::floor(fy) >= sample.ratio)) {
-        for (unsigned i = 0; i < (C ? C : sample.channels); i++)
-          sample.out[off + i] = sample.in[off + i];
+        if (sample.in != sample.out) {
+          for (unsigned i = 0; i < (C ? C : sample.channels); i++)
+            sample.out[off + i] = sample.in[off + i];
+        }
       } else {
         for (unsigned i = 0; i < (C ? C : sample.channels); i++)
           sample.out[off + i] = 0;
@@ -62,8 +66,33 @@ class GridMaskGpu {
   using SampleDesc = GridMaskSampleDesc<Type>;
   using BlockDesc = kernels::BlockDesc<2>;
   std::vector<SampleDesc> sample_descs_;
+  std::vector<BlockDesc> masked_blocks_;
   BlockSetup<2, 2> block_setup_;
 
+  /**
+   * @brief Checks whether the grid mask leaves the whole block unchanged
+   *
+   * The mask coordinates are affine in x and y, so their range over the block is given by
+   * the corners. The block is untouched if the range of either of the coordinates is within
+   * the unmasked part of a single grid cell.
+   */
+  static bool IsUntouched(const SampleDesc &sample, const BlockDesc &block) {
+    double x0 = block.start.x, x1 = block.end.x - 1;
+    double y0 = block.start.y, y1 = block.end.y - 1;
+    auto unmasked = [&](double f00, double f01, double f10, double f11) {
+      double lo = std::min(std::min(f00, f01), std::min(f10, f11));
+      double hi = std::max(std::max(f00, f01), std::max(f10, f11));
+      // a margin for the float arithmetic used on the device
+      lo -= 1e-5 * (1 + std::abs(lo));
+      hi += 1e-5 * (1 + std::abs(hi));
+      return std::floor(lo) == std::floor(hi) && lo - std::floor(lo) >= sample.ratio;
+    };
+    auto fx = [&](double x, double y) { return x * sample.ca - y * sample.sa - sample.sx; };
+    auto fy = [&](double x, double y) { return x * sample.sa + y * sample.ca - sample.sy; };
+    return unmasked(fx(x0, y0), fx(x1, y0), fx(x0, y1), fx(x1, y1)) ||
+           unmasked(fy(x0, y0), fy(x1, y0), fy(x0, y1), fy(x1, y1));
+  }
+
  public:
   KernelRequirements Setup(KernelContext &context, const InListGPU<Type, 3> &in) {
     KernelRequirements req;
@@ -76,6 +105,12 @@ class GridMaskGpu {
     return req;
   }
 
+  /**
+   * @brief Applies the grid mask
+   *
+   * `out` and `in` can point to the same memory - then only the masked pixels are written
+   * and the blocks which the mask doesn't touch are skipped altogether.
+   */
   void Run(KernelContext &ctx, OutListGPU<Type, 3> &out, const InListGPU<Type, 3> &in,
            const std::vector<int> &tile,
            const std::vector<float> &ratio,
@@ -84,6 +119,7 @@ class GridMaskGpu {
            const std::vector<float> &sy) {
     int n = in.num_samples();
     int c = in.tensor_shape(0)[2];
+    bool in_place = true;
 
     sample_descs_.resize(n);
     for (int i = 0; i < n; i++) {
@@ -94,6 +130,7 @@ class GridMaskGpu {
 
       sample_descs_[i].out = out[i].data;
       sample_descs_[i].in = in[i].data;
+      in_place = in_place && out[i].data == in[i].data;
       sample_descs_[i].channels = shape[2];
       sample_descs_[i].width = shape[1];
       sample_descs_[i].height = shape[0];
@@ -105,11 +142,24 @@ class GridMaskGpu {
       sample_descs_[i].ratio = ratio[i];
     }
 
+    span<const BlockDesc> blocks = make_cspan(block_setup_.Blocks());
+    dim3 grid = block_setup_.GridDim();
+    if (in_place) {
+      masked_blocks_.clear();
+      for (auto &blk : blocks) {
+        if (!IsUntouched(sample_descs_[blk.sample_idx], blk))
+          masked_blocks_.push_back(blk);
+      }
+      if (masked_blocks_.empty())
+        return;
+      blocks = make_cspan(masked_blocks_);
+      grid = dim3(masked_blocks_.size());
+    }
+
     SampleDesc *samples_gpu;
     BlockDesc *blocks_gpu;
     std::tie(samples_gpu, blocks_gpu) = ctx.scratchpad->ToContiguousGPU(
-        ctx.gpu.stream, sample_descs_, block_setup_.Blocks());
-    dim3 grid = block_setup_.GridDim();
+        ctx.gpu.stream, sample_descs_, blocks);
     dim3 block = block_setup_.BlockDim();
     VALUE_SWITCH(c, C, (1, 2, 3, 4), (
       GridMaskKernel<Type, C><<<grid, block, 0, ctx.gpu.stream>>>(samples_gpu, blocks_gpu);
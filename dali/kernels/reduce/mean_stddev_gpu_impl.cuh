@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -19,9 +19,11 @@
  * @file
  *
  * This file contains the classes needed to implement reductions with pre-
- * and postprocessing: mean, root mean square, standard deviation (and its reciprocal).
+ * and postprocessing: mean, root mean square, standard deviation (and its reciprocal) and
+ * a one-pass calculation of mean and inverse standard deviation.
  */
 
+#include <vector>
 #include "dali/kernels/reduce/reduce_gpu_impl.cuh"
 #include "dali/kernels/reduce/reduce_drop_dims.h"
 
@@ -421,6 +423,183 @@ class InvStdDevImplGPU :
   }
 };
 
+/**
+ * @brief Calculates the mean and the regularized inverse standard deviation from
+ *        a `welford_state`
+ */
+template <typename Out, typename Param>
+struct WelfordMeanInvStdDev {
+  Param ddof = 0, reg = 0;
+
+  template <typename T>
+  DALI_HOST_DEV vec<2, Out> operator()(const reductions::welford_state<T> &state) const {
+    Param n = state.count - ddof;
+    Param s = (n > 0 ? state.m2 / n : 0) + reg;
+    return { ConvertSat<Out>(state.mean), s ? ConvertSat<Out>(rsqrt(s)) : Out(0) };
+  }
+};
+
+template <typename Out>
+struct SplitMeanInvStdDevDesc {
+  Out *mean, *inv_stddev;
+  const vec<2, Out> *in;
+  int64_t size;
+};
+
+template <typename Out>
+__global__ void SplitMeanInvStdDev(const SplitMeanInvStdDevDesc<Out> *descs) {
+  auto desc = descs[blockIdx.y];
+  for (int64_t i = threadIdx.x + static_cast<int64_t>(blockIdx.x) * blockDim.x;
+       i < desc.size; i += static_cast<int64_t>(blockDim.x) * gridDim.x) {
+    vec<2, Out> v = desc.in[i];
+    desc.mean[i] = v[0];
+    desc.inv_stddev[i] = v[1];
+  }
+}
+
+/**
+ * @brief Implements a one-pass calculation of mean and regularized inverse standard deviation
+ *
+ * The input is reduced with `reductions::welford`, which yields both statistics while reading
+ * the data once. The results are stored interleaved in a temporary buffer and then split
+ * into two output tensor lists.
+ */
+template <typename Out, typename In, typename Acc = scale_t<Out>>
+class MeanInvStdDevImplGPU
+    : public ReduceImplGPU<vec<2, Out>, In, reductions::welford_state<Acc>,
+                           MeanInvStdDevImplGPU<Out, In, Acc>> {
+ public:
+  using ReduceBase = ReduceImplGPU<vec<2, Out>, In, reductions::welford_state<Acc>,
+                                   MeanInvStdDevImplGPU<Out, In, Acc>>;
+  using param_t = std::conditional_t<std::is_same<Out, double>::value, double, float>;
+
+  using Preprocessor = reductions::welford_init<Acc>;
+  template <int non_reduced_dims>
+  using PreprocessorBank = UniformPreprocessorBank<non_reduced_dims, Preprocessor>;
+  using Postprocessor = WelfordMeanInvStdDev<Out, param_t>;
+
+  Preprocessor GetPreprocessorImpl(int sample_idx, bool batch) const { return {}; }
+
+  template <int non_reduced_dims>
+  PreprocessorBank<non_reduced_dims> *
+  GetPreprocessorBanksImpl(WorkArea &wa, int axis, int_const<non_reduced_dims>) const {
+    return nullptr;
+  }
+
+  Postprocessor GetPostprocessorImpl(int sample_index, bool reduce_batch) const {
+    int64_t reduced_elems = reduce_batch ? this->TotalReducedElements()
+                                         : this->ReducedElements(sample_index);
+    DALI_ENFORCE(reduced_elems > 0, "Cannot calculate a mean from 0 elements");
+    return { static_cast<param_t>(ddof_), regularization_ };
+  }
+
+  reductions::welford GetReduction() const { return {}; }
+
+  KernelRequirements Setup(KernelContext &ctx,
+                           const TensorListShape<> &in_shape,
+                           span<const int> axes,
+                           bool keep_dims,
+                           bool reduce_batch) {
+    auto req = ReduceBase::Setup(ctx, in_shape, axes, keep_dims, reduce_batch);
+    out_shape_ = req.output_shapes[0];
+    // the interleaved output is allocated before the reduction's buffers
+    ScratchpadEstimator se;
+    se.add<mm::memory_kind::device, vec<2, Out>>(out_shape_.num_elements());
+    se.sizes = AppendScratchSize(se.sizes, req.scratch_sizes);
+    se.add<mm::memory_kind::device, SplitMeanInvStdDevDesc<Out>>(out_shape_.num_samples());
+    req.scratch_sizes = se.sizes;
+    return req;
+  }
+
+  void Run(KernelContext &kctx,
+           const OutListGPU<Out> &mean,
+           const OutListGPU<Out> &inv_stddev,
+           const InListGPU<In> &in,
+           int ddof = 0,
+           param_t epsilon = 0) {
+    if (!(epsilon >= 0))  // >= 0 and not NaN
+      throw std::range_error("The regularizing term must be a non-negative number.");
+    if (ddof < 0)
+      throw std::range_error("Delta Degrees of Freedom must be a non-negative number.");
+    regularization_ = epsilon;
+    ddof_ = ddof;
+
+    int64_t n = out_shape_.num_elements();
+    auto *tmp = kctx.scratchpad->AllocateGPU<vec<2, Out>>(n);
+    OutListGPU<vec<2, Out>> tmp_out(tmp, out_shape_);
+    ReduceBase::Run(kctx, tmp_out, in);
+
+    int N = out_shape_.num_samples();
+    descs_.resize(N);
+    int64_t max_size = 0;
+    for (int i = 0; i < N; i++) {
+      auto &desc = descs_[i];
+      desc.mean = mean.data[i];
+      desc.inv_stddev = inv_stddev.data[i];
+      desc.in = tmp_out.data[i];
+      desc.size = out_shape_.tensor_size(i);
+      if (desc.size > max_size)
+        max_size = desc.size;
+    }
+    if (max_size == 0)
+      return;
+    auto *gpu_descs = kctx.scratchpad->ToGPU(kctx.gpu.stream, descs_);
+    int block = std::min<int64_t>(max_size, 256);
+    dim3 grid(std::min<int64_t>(div_ceil(max_size, block), 1024), N);
+    SplitMeanInvStdDev<<<grid, block, 0, kctx.gpu.stream>>>(gpu_descs);
+    CUDA_CALL(cudaGetLastError());
+  }
+
+ private:
+  TensorListShape<> out_shape_;
+  std::vector<SplitMeanInvStdDevDesc<Out>> descs_;
+  param_t regularization_ = 0;
+  int ddof_ = 0;
+};
+
+/**
+ * @brief Converts a `welford_state` to the power sums: the count, the sum and the sum of squares
+ */
+template <typename Out>
+struct WelfordPowerSums {
+  template <typename T>
+  DALI_HOST_DEV vec<3, Out> operator()(const reductions::welford_state<T> &state) const {
+    Out n = state.count, mean = state.mean;
+    return { n, n * mean, state.m2 + n * mean * mean };
+  }
+};
+
+/**
+ * @brief Implements a one-pass calculation of the power sums: the count, the sum and the sum
+ *        of squares.
+ *
+ * The input is reduced with `reductions::welford`, as in MeanInvStdDevImplGPU, and the result
+ * is converted to the power sums, which can be added to merge the statistics of disjoint parts
+ * of the data.
+ */
+template <typename Out, typename In, typename Acc = float>
+class PowerSumsImplGPU
+    : public ReduceImplGPU<vec<3, Out>, In, reductions::welford_state<Acc>,
+                           PowerSumsImplGPU<Out, In, Acc>> {
+ public:
+  using Preprocessor = reductions::welford_init<Acc>;
+  template <int non_reduced_dims>
+  using PreprocessorBank = UniformPreprocessorBank<non_reduced_dims, Preprocessor>;
+  using Postprocessor = WelfordPowerSums<Out>;
+
+  Preprocessor GetPreprocessorImpl(int sample_idx, bool batch) const { return {}; }
+
+  template <int non_reduced_dims>
+  PreprocessorBank<non_reduced_dims> *
+  GetPreprocessorBanksImpl(WorkArea &wa, int axis, int_const<non_reduced_dims>) const {
+    return nullptr;
+  }
+
+  Postprocessor GetPostprocessorImpl(int sample_index, bool reduce_batch) const { return {}; }
+
+  reductions::welford GetReduction() const { return {}; }
+};
+
 }  // namespace reduce_impl
 }  // namespace kernels
 }  // namespace dali
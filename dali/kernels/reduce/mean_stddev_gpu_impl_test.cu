@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -361,6 +361,171 @@ TEST(InvStdDevImplGPU, Outer_Batch_Regularized) {
 }
 
 
+template <typename In>
+void TestMeanInvStdDev(const TensorListShape<> &in_shape,
+                       const TensorListShape<> &ref_out_shape,
+                       span<const int> axes, bool batch, int min_stages,
+                       int ddof = 0, float reg = 0) {
+  MeanInvStdDevImplGPU<float, In> kernel;
+  TestTensorList<In> in;
+  TestTensorList<float> mean, inv_stddev, ref_mean;
+  in.reshape(in_shape);
+  mean.reshape(ref_out_shape);
+  inv_stddev.reshape(ref_out_shape);
+  ref_mean.reshape(ref_out_shape);
+  std::mt19937_64 rng{12345};
+  ScratchpadAllocator sa;
+  KernelContext ctx;
+  ctx.gpu.stream = 0;
+
+  for (int iter = 0; iter < 3; iter++) {
+    auto req = kernel.Setup(ctx, in_shape, axes, true, batch);
+    ASSERT_EQ(req.output_shapes.size(), 1);
+    ASSERT_EQ(req.output_shapes[0], ref_out_shape);
+    EXPECT_GE(kernel.GetNumStages(), min_stages);
+    sa.Reserve(req.scratch_sizes);
+    UniformRandomFill(in.cpu(), rng, 0, 255);
+    in.invalidate_gpu();
+
+    auto scratchpad = sa.GetScratchpad();
+    ctx.scratchpad = &scratchpad;
+    kernel.Run(ctx, mean.gpu(), inv_stddev.gpu(), in.gpu(), ddof, reg);
+    auto mean_cpu = mean.cpu(0);
+    auto inv_stddev_cpu = inv_stddev.cpu(0);
+    CUDA_CALL(cudaStreamSynchronize(0));
+
+    RefMean<double>(ref_mean.cpu(), in.cpu(), axes, true, batch);
+    auto ref_inv_stddev = RefStdDev(in.cpu(), ref_mean.cpu(), ddof, reg, true);
+    Check(mean_cpu, ref_mean.cpu(), EqualEpsRel(1e-5, 1e-6));
+    Check(inv_stddev_cpu, ref_inv_stddev.cpu(), EqualEpsRel(1e-5, 1e-6));
+    mean.invalidate_cpu();
+    inv_stddev.invalidate_cpu();
+  }
+}
+
+TEST(MeanInvStdDevImplGPU, Outer_Inner_SplitStage) {
+  TensorListShape<> in_shape = {{
+    { 32, 2, 64000 },
+    { 15, 4, 128000 },
+    { 72000, 1, 7 }
+  }};
+  TensorListShape<> ref_out_shape = {{
+    { 1, 2, 1 },
+    { 1, 4, 1 },
+    { 1, 1, 1 }
+  }};
+  int axes[] = { 0, 2 };
+  TestMeanInvStdDev<uint8_t>(in_shape, ref_out_shape, make_span(axes), false, 4);
+}
+
+TEST(MeanInvStdDevImplGPU, Middle_Inner_Batch) {
+  TensorListShape<> in_shape = {{
+    { 2, 32, 3, 6400 },
+    { 2, 15, 3, 12800 },
+    { 2, 7200, 3, 7 }
+  }};
+  TensorListShape<> ref_out_shape = {{
+    { 2, 1, 3, 1 }
+  }};
+  int axes[] = { 1, 3 };
+  TestMeanInvStdDev<int16_t>(in_shape, ref_out_shape, make_span(axes), true, 2, 1);
+}
+
+TEST(MeanInvStdDevImplGPU, Outer_Batch_Regularized) {
+  TensorListShape<> in_shape = {{
+    { 480, 640, 3 },
+    { 720, 1280, 3 },
+    { 1080, 1920, 3 }
+  }};
+  TensorListShape<> ref_out_shape = {{
+    { 1, 1, 3 }
+  }};
+  int axes[] = { 0, 1 };
+  TestMeanInvStdDev<float>(in_shape, ref_out_shape, make_span(axes), true, 2, 1, 12000);
+}
+
+template <typename In>
+void TestPowerSums(const TensorListShape<> &in_shape,
+                   const TensorListShape<> &ref_out_shape,
+                   span<const int> axes, bool batch) {
+  PowerSumsImplGPU<double, In> kernel;
+  TestTensorList<In> in;
+  TestTensorList<double> squared, ref_sum, ref_sum_sq;
+  TestTensorList<vec<3, double>> out;
+  in.reshape(in_shape);
+  squared.reshape(in_shape);
+  out.reshape(ref_out_shape);
+  ref_sum.reshape(ref_out_shape);
+  ref_sum_sq.reshape(ref_out_shape);
+  std::mt19937_64 rng{12345};
+  ScratchpadAllocator sa;
+  KernelContext ctx;
+  ctx.gpu.stream = 0;
+
+  auto req = kernel.Setup(ctx, in_shape, axes, true, batch);
+  ASSERT_EQ(req.output_shapes.size(), 1);
+  ASSERT_EQ(req.output_shapes[0], ref_out_shape);
+  sa.Reserve(req.scratch_sizes);
+  UniformRandomFill(in.cpu(), rng, 0, 255);
+  auto in_cpu = in.cpu();
+  auto squared_cpu = squared.cpu();
+  for (int i = 0; i < in_shape.num_samples(); i++) {
+    for (int64_t j = 0; j < in_shape.tensor_size(i); j++) {
+      double x = in_cpu.data[i][j];
+      squared_cpu.data[i][j] = x * x;
+    }
+  }
+
+  auto scratchpad = sa.GetScratchpad();
+  ctx.scratchpad = &scratchpad;
+  kernel.Run(ctx, out.gpu(), in.gpu());
+  auto out_cpu = out.cpu(0);
+  CUDA_CALL(cudaStreamSynchronize(0));
+
+  RefReduce(ref_sum.cpu(), in_cpu, axes, true, batch, reductions::sum());
+  RefReduce(ref_sum_sq.cpu(), squared_cpu, axes, true, batch, reductions::sum());
+  auto ref_sum_cpu = ref_sum.cpu();
+  auto ref_sum_sq_cpu = ref_sum_sq.cpu();
+  for (int i = 0; i < ref_out_shape.num_samples(); i++) {
+    int64_t n = ref_out_shape.tensor_size(i);
+    int64_t count = (batch ? in_shape.num_elements() : in_shape.tensor_size(i)) / n;
+    for (int64_t j = 0; j < n; j++) {
+      vec<3, double> v = out_cpu.data[i][j];
+      EXPECT_EQ(v[0], count);
+      EXPECT_NEAR(v[1], ref_sum_cpu.data[i][j], 1e-5 * ref_sum_cpu.data[i][j]);
+      EXPECT_NEAR(v[2], ref_sum_sq_cpu.data[i][j], 1e-5 * ref_sum_sq_cpu.data[i][j]);
+    }
+  }
+}
+
+TEST(PowerSumsImplGPU, Outer_Inner_SplitStage) {
+  TensorListShape<> in_shape = {{
+    { 32, 2, 64000 },
+    { 15, 4, 128000 },
+    { 72000, 1, 7 }
+  }};
+  TensorListShape<> ref_out_shape = {{
+    { 1, 2, 1 },
+    { 1, 4, 1 },
+    { 1, 1, 1 }
+  }};
+  int axes[] = { 0, 2 };
+  TestPowerSums<uint8_t>(in_shape, ref_out_shape, make_span(axes), false);
+}
+
+TEST(PowerSumsImplGPU, Outer_Batch) {
+  TensorListShape<> in_shape = {{
+    { 480, 640, 3 },
+    { 720, 1280, 3 },
+    { 1080, 1920, 3 }
+  }};
+  TensorListShape<> ref_out_shape = {{
+    { 1, 1, 3 }
+  }};
+  int axes[] = { 0, 1 };
+  TestPowerSums<float>(in_shape, ref_out_shape, make_span(axes), true);
+}
+
 }  // namespace reduce_impl
 }  // namespace kernels
 }  // namespace dali
@@ -17,6 +17,7 @@
 
 #include <cuda_runtime.h>
 #include "dali/core/util.h"
+#include "dali/kernels/reduce/reductions.h"
 
 namespace dali {
 namespace kernels {
@@ -33,6 +34,20 @@ DALI_FORCEINLINE __device__ vec<N, T> shfl_down(vec<N, T> &t, int n) {
   IMPL_VEC_ELEMENTWISE(__shfl_down_sync(FULL_MASK, t[i], n));
 }
 
+namespace reductions {
+
+template <typename T>
+DALI_FORCEINLINE __device__ welford_state<T> shfl_down(welford_state<T> &t, int n) {
+  constexpr unsigned FULL_MASK = 0xffffffffu;
+  return {
+    __shfl_down_sync(FULL_MASK, t.mean, n),
+    __shfl_down_sync(FULL_MASK, t.m2, n),
+    __shfl_down_sync(FULL_MASK, t.count, n)
+  };
+}
+
+}  // namespace reductions
+
 template <typename Acc, typename Reduction>
 DALI_FORCEINLINE __device__ void WarpReduce(Acc &val, Reduction reduce) {
   reduce(val, shfl_down(val, 16));
@@ -15,6 +15,7 @@
 #ifndef DALI_KERNELS_REDUCE_REDUCE_CPU_H_
 #define DALI_KERNELS_REDUCE_REDUCE_CPU_H_
 
+#include <algorithm>
 #include <cassert>
 #include <utility>
 #include <vector>
@@ -36,12 +37,22 @@ namespace reduce_impl {
 
 constexpr int kTreeReduceThreshold = 32;
 
+/**
+ * @brief The number of independent accumulators in the innermost loop
+ *
+ * The accumulators are updated in lockstep, so the compiler can keep them in vector registers.
+ */
+constexpr int kReduceLanes = 8;
+
+/// @brief The minimum number of input elements processed by one block in RunParallel
+constexpr int64_t kMinParallelBlockVolume = 1 << 16;
+
 template <int static_stride, typename Dst, typename Src, typename Preprocessor, typename Reduction>
 void reduce1D_stride(Dst &reduced, const Src *data, int64_t dynamic_stride, int64_t n,
                      const Preprocessor &P, const Reduction &R) {
   const int64_t stride = static_stride < 0 ? dynamic_stride : static_stride;
   const Dst neutral = R.template neutral<Dst>();
-  if (n > kTreeReduceThreshold) {
+  if (n > kTreeReduceThreshold * kReduceLanes) {
     int64_t m = n >> 1;
     Dst tmp1 = neutral, tmp2 = neutral;
     // reduce first half and accumulate
@@ -53,7 +64,24 @@ void reduce1D_stride(Dst &reduced, const Src *data, int64_t dynamic_stride, int6
   } else {
     // reduce to a temporary
     Dst tmp = neutral;
-    for (int64_t i = 0; i < n; i++)
+    int64_t i = 0;
+    if (n >= 2 * kReduceLanes) {
+      // each lane reduces at most kTreeReduceThreshold values and the lanes are combined
+      // pairwise, so the accuracy is the same as that of the tree reduction
+      Dst lanes[kReduceLanes];  // NOLINT
+      for (int l = 0; l < kReduceLanes; l++)
+        lanes[l] = neutral;
+      for (; i + kReduceLanes <= n; i += kReduceLanes) {
+        for (int l = 0; l < kReduceLanes; l++)
+          R(lanes[l], P(data[(i + l) * stride]));
+      }
+      for (int w = kReduceLanes / 2; w > 0; w >>= 1) {
+        for (int l = 0; l < w; l++)
+          R(lanes[l], lanes[l + w]);
+      }
+      tmp = lanes[0];
+    }
+    for (; i < n; i++)
        R(tmp, P(data[i * stride]));
     // accumulate in target value
     R(reduced, tmp);
@@ -113,6 +141,21 @@ void reduce(Dst &reduced, const StridedTensor<StorageCPU, Src> &in,
   reduce(reduced, in, P, R, 0, in.size[0], offset);
 }
 
+/// @brief Reduces the range [start, start + count) of the outermost dimension of a strided tensor
+template <typename Dst, typename Src, typename Preprocessor, typename Reduction>
+void reduce_range(Dst &reduced, const StridedTensor<StorageCPU, Src> &in,
+                  const Preprocessor &P, const Reduction &R,
+                  int64_t start, int64_t count, int64_t offset) {
+  offset += start * in.stride[0];
+  if (in.dim() == 1) {
+    Dst tmp = R.template neutral<Dst>();
+    reduce1D(tmp, in.data + offset, in.stride[0], count, P, R);
+    R(reduced, tmp);
+  } else {
+    reduce(reduced, in, P, R, 0, count, offset);
+  }
+}
+
 }  // namespace reduce_impl
 
 /**
@@ -181,6 +224,54 @@ struct ReduceBaseCPU {
     Run(clear, postprocess);
   }
 
+  /**
+   * @brief Runs the reduction, splitting large inputs into blocks processed with `engine`
+   *
+   * The outermost reduced dimension is split into up to `engine.NumThreads()` blocks, each
+   * producing partial results for all outputs. The partial results are then merged in a fixed
+   * order, so the result doesn't depend on the scheduling. Calls `engine.RunAll()`.
+   */
+  template <typename ExecutionEngine>
+  void RunParallel(ExecutionEngine &engine, bool clear = true, bool postprocess = true) {
+    int64_t in_volume = input.num_elements();
+    int64_t num_blocks = 1;
+    if (!axes.empty()) {
+      num_blocks = std::min<int64_t>(engine.NumThreads(),
+                                     in_volume / reduce_impl::kMinParallelBlockVolume);
+      num_blocks = std::min<int64_t>(num_blocks, strided_in.size[0]);
+    }
+    if (num_blocks <= 1) {
+      Run(clear, postprocess);
+      return;
+    }
+
+    int64_t nout = output.num_elements();
+    partial_results.resize((num_blocks - 1) * nout);
+    int64_t extent = strided_in.size[0];
+    for (int64_t b = 0; b < num_blocks; b++) {
+      int64_t start = extent * b / num_blocks;
+      int64_t count = extent * (b + 1) / num_blocks - start;
+      // the first block accumulates directly in the output
+      Dst *out = b == 0 ? output.data : &partial_results[(b - 1) * nout];
+      bool clear_block = b == 0 ? clear : true;
+      engine.AddWork([this, out, clear_block, start, count](int) {
+        SmallVector<int64_t, 6> pos;
+        pos.resize(output.dim());
+        ReduceAxisRange(out, clear_block, make_span(pos), 0, 0, start, count);
+      }, in_volume / extent * count, false);
+    }
+    engine.RunAll();
+
+    auto R = This().GetReduction();
+    for (int64_t b = 1; b < num_blocks; b++) {
+      const Dst *block_out = &partial_results[(b - 1) * nout];
+      for (int64_t i = 0; i < nout; i++)
+        R(output.data[i], block_out[i]);
+    }
+    if (postprocess)
+      This().PostprocessAll();
+  }
+
   void PostprocessAll() {
     if (reinterpret_cast<decltype(&ReduceBaseCPU::Postprocess)>(&Actual::Postprocess) ==
         &ReduceBaseCPU::Postprocess)
@@ -211,17 +302,28 @@ struct ReduceBaseCPU {
 
  protected:
   void ReduceAxis(bool clear, span<int64_t> pos, int axis, int64_t offset = 0) {
+    ReduceAxisRange(output.data, clear, pos, axis, offset, 0, strided_in.size[0]);
+  }
+
+  /**
+   * @brief Reduces the range [start, start + count) of the outermost reduced dimension
+   *
+   * The results are stored in `out`, which has the same layout as `output`.
+   */
+  void ReduceAxisRange(Dst *out, bool clear, span<int64_t> pos, int axis, int64_t offset,
+                       int64_t start, int64_t count) {
     auto R = This().GetReduction();
     if (axis == output.dim()) {
-      Dst &r = *output(pos);
+      Dst &r = out[output(pos) - output.data];
       if (clear) {
         r = R.template neutral<Dst>();
       }
-      reduce_impl::reduce(r, strided_in, This().GetPreprocessor(pos), R, offset);
+      reduce_impl::reduce_range(r, strided_in, This().GetPreprocessor(pos), R,
+                                start, count, offset);
     } else {
       for (int64_t i = 0; i < output.shape[axis]; i++) {
         pos[axis] = i;
-        ReduceAxis(clear, pos, axis+1, offset + i*step[axis]);
+        ReduceAxisRange(out, clear, pos, axis+1, offset + i*step[axis], start, count);
       }
     }
   }
@@ -332,6 +434,7 @@ struct ReduceBaseCPU {
   reduce_impl::StridedTensor<StorageCPU, const Src> strided_in;
   SmallVector<int64_t, 6> step;
   uint64_t axis_mask = 0;
+  std::vector<Dst> partial_results;
 };
 
 template <typename Dst, typename Src>
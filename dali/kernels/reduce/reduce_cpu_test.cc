@@ -15,6 +15,8 @@
 #include <gtest/gtest.h>
 #include <random>
 #include <chrono>
+#include <functional>
+#include <vector>
 #include "dali/kernels/reduce/reduce_cpu.h"
 
 namespace dali {
@@ -27,6 +29,25 @@ inline Out microseconds(std::chrono::duration<R, P> d) {
   return std::chrono::duration_cast<std::chrono::duration<Out, std::micro>>(d).count();
 }
 
+/**
+ * @brief Runs the work in the reverse order of scheduling, pretending to have 4 threads
+ */
+struct TestExecutionEngine {
+  void AddWork(std::function<void(int)> f, int64_t priority = 0, bool start_immediately = true) {
+    work.push_back(std::move(f));
+  }
+
+  void RunAll() {
+    for (int i = work.size() - 1; i >= 0; i--)
+      work[i](i % NumThreads());
+    work.clear();
+  }
+
+  int NumThreads() const noexcept { return 4; }
+
+  std::vector<std::function<void(int)>> work;
+};
+
 TEST(ReduceTest, Mean2D) {
   MeanCPU<float, int> mean;
 
@@ -63,8 +84,9 @@ TEST(ReduceTest, Mean2D) {
 }
 
 template <typename Reduce, typename Preprocess, typename Postprocess>
-void TestStatelessReduction3D(bool mean, Preprocess pre, Postprocess post) {
+void TestStatelessReduction3D(bool mean, Preprocess pre, Postprocess post, bool parallel = false) {
   Reduce red;
+  TestExecutionEngine engine;
 
   const int W = 640, H = 480, C = 3;
   std::vector<int> in_v(W*H*C);
@@ -112,7 +134,10 @@ void TestStatelessReduction3D(bool mean, Preprocess pre, Postprocess post) {
 
     auto out = make_tensor_cpu(out_data, out_shape);
     red.Setup(out, in, make_cspan(axes));
-    red.Run();
+    if (parallel)
+      red.RunParallel(engine);
+    else
+      red.Run();
 
     std::fill(ref.begin(), ref.end(), 0);
 
@@ -164,6 +189,79 @@ TEST(ReduceTest, RootMeanSquare3D) {
     sqrt);
 }
 
+TEST(ReduceTest, Sum3DParallel) {
+  TestStatelessReduction3D<SumCPU<float, int>>(
+    false,
+    dali::identity(),
+    dali::identity(),
+    true);
+}
+
+TEST(ReduceTest, RootMeanSquare3DParallel) {
+  auto sqrt = [](auto x) { return std::sqrt(x); };
+  TestStatelessReduction3D<RootMeanSquareCPU<float, int>>(
+    true,
+    reductions::square(),
+    sqrt,
+    true);
+}
+
+TEST(ReduceTest, MinMaxParallel) {
+  const int N = 1000, C = 300;
+  std::vector<int16_t> in_v(N * C);
+  std::mt19937_64 rng(4321);
+  std::uniform_int_distribution<int> dist(-30000, 30000);
+  for (auto &x : in_v)
+    x = dist(rng);
+  auto in = make_tensor_cpu<2>(in_v.data(), { N, C });
+  TestExecutionEngine engine;
+  int axes_sets[][2] = { { 0, 0 }, { 0, 1 } };
+  for (int num_axes = 1; num_axes <= 2; num_axes++) {
+    auto axes = make_cspan(axes_sets[num_axes - 1], num_axes);
+    std::vector<int16_t> min_out(C), min_ref(C), max_out(C), max_ref(C);
+    TensorShape<> out_shape = num_axes == 1 ? TensorShape<>{ C } : TensorShape<>{ 1 };
+    MinCPU<int16_t, int16_t> min;
+    MaxCPU<int16_t, int16_t> max;
+    min.Setup(make_tensor_cpu(min_ref.data(), out_shape), in, axes);
+    min.Run();
+    min.Setup(make_tensor_cpu(min_out.data(), out_shape), in, axes);
+    min.RunParallel(engine);
+    max.Setup(make_tensor_cpu(max_ref.data(), out_shape), in, axes);
+    max.Run();
+    max.Setup(make_tensor_cpu(max_out.data(), out_shape), in, axes);
+    max.RunParallel(engine);
+    EXPECT_EQ(min_out, min_ref);
+    EXPECT_EQ(max_out, max_ref);
+  }
+}
+
+TEST(ReduceTest, StdDevParallel) {
+  MeanCPU<float, float> mean;
+  StdDevCPU<float, float> stddev;
+  TestExecutionEngine engine;
+
+  std::mt19937_64 rng(1337);
+  std::normal_distribution<float> dist(10, 42);
+
+  const int W = 1920, H = 1080;
+  std::vector<float> in_v(W*H);
+  for (auto &x : in_v)
+    x = dist(rng);
+  auto in = make_tensor_cpu<2>(in_v.data(), { H, W });
+
+  int axes[] = { 0, 1 };
+  float m = 0, s = 0;
+  auto mean_out = make_tensor_cpu<1>(&m, { 1 });
+  mean.Setup(mean_out, in, make_span(axes));
+  mean.RunParallel(engine);
+  auto stddev_out = make_tensor_cpu<1>(&s, { 1 });
+  stddev.Setup(stddev_out, in, make_span(axes), mean_out);
+  stddev.RunParallel(engine);
+
+  EXPECT_NEAR(m, 10, 0.2);
+  EXPECT_NEAR(s, 42, 0.2);
+}
+
 TEST(ReduceTest, StdDev) {
   MeanCPU<float, float> mean;
   StdDevCPU<float, float> stddev;
@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -23,6 +23,7 @@
 
 #include <memory>
 #include "dali/kernels/kernel.h"
+#include "dali/core/geom/vec.h"
 #include "dali/core/host_dev.h"
 #include "dali/core/tensor_view.h"
 
@@ -710,6 +711,108 @@ extern template class InvStdDevGPU<float, int32_t>;
 
 extern template class InvStdDevGPU<float, float>;
 
+/**
+ * @brief Calculates the mean and the regularized inverse standard deviation in one pass
+ *
+ * This kernel produces the same results as MeanGPU followed by InvStdDevGPU, but the input is
+ * read only once: the mean and the variance are accumulated together with Welford's algorithm
+ * and the partial results are merged with Chan's formula, which is numerically stable.
+ *
+ * @see MeanGPU
+ * @see InvStdDevGPU
+ */
+template <typename Out, typename In>
+class DLL_PUBLIC MeanInvStdDevGPU {
+ public:
+  MeanInvStdDevGPU();
+  ~MeanInvStdDevGPU();
+
+  /**
+   * @brief Sets up the reduction
+   *
+   * The parameters have the same meaning as in InvStdDevGPU::Setup. The output shape
+   * is the shape of both outputs: the mean and the inverse standard deviation.
+   */
+  KernelRequirements Setup(KernelContext &ctx,
+                           const TensorListShape<> &in_shape,
+                           span<const int> axes, bool keep_dims, bool reduce_batch);
+
+  using param_t = std::conditional_t<std::is_same<Out, double>::value, double, float>;
+
+  /**
+   * @brief Calculates the mean and the regularized inverse standard deviation
+   *
+   * @param ctx         the execution environment
+   * @param mean        the mean of the input
+   * @param inv_stddev  (regularized) inverse standard deviation, as calculated by InvStdDevGPU
+   * @param in          input tensor
+   * @param ddof        delta degrees of freedom, for Bessel's correction
+   * @param epsilon     regularizing term, added to the variance
+   */
+  void Run(KernelContext &ctx, const OutListGPU<Out> &mean, const OutListGPU<Out> &inv_stddev,
+           const InListGPU<In> &in, int ddof = 0, param_t epsilon = 0);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+extern template class MeanInvStdDevGPU<float, uint8_t>;
+extern template class MeanInvStdDevGPU<float, int8_t>;
+
+extern template class MeanInvStdDevGPU<float, uint16_t>;
+extern template class MeanInvStdDevGPU<float, int16_t>;
+
+extern template class MeanInvStdDevGPU<float, uint32_t>;
+extern template class MeanInvStdDevGPU<float, int32_t>;
+
+extern template class MeanInvStdDevGPU<float, float>;
+
+/**
+ * @brief Calculates the count, the sum and the sum of squares of the elements in the tensor(s)
+ *        along given axes
+ *
+ * The three values are stored together, as a `vec<3, Out>`. They are calculated in a single,
+ * numerically stable pass over the data (as in MeanInvStdDevGPU) and, unlike the mean and the
+ * variance, they can be simply added to combine the statistics of disjoint sets of data, e.g.
+ * the parts of a batch processed on different devices.
+ */
+template <typename Out, typename In>
+class DLL_PUBLIC PowerSumsGPU {
+ public:
+  PowerSumsGPU();
+  ~PowerSumsGPU();
+
+  /**
+   * @brief Sets up the reduction
+   *
+   * The parameters have the same meaning as in SumGPU::Setup.
+   */
+  KernelRequirements Setup(KernelContext &ctx,
+                           const TensorListShape<> &in_shape,
+                           span<const int> axes, bool keep_dims, bool reduce_batch);
+
+  /**
+   * @brief Calculates the count, the sum and the sum of squares
+   */
+  void Run(KernelContext &ctx, const OutListGPU<vec<3, Out>> &out, const InListGPU<In> &in);
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+extern template class PowerSumsGPU<double, uint8_t>;
+extern template class PowerSumsGPU<double, int8_t>;
+
+extern template class PowerSumsGPU<double, uint16_t>;
+extern template class PowerSumsGPU<double, int16_t>;
+
+extern template class PowerSumsGPU<double, uint32_t>;
+extern template class PowerSumsGPU<double, int32_t>;
+
+extern template class PowerSumsGPU<double, float>;
+
 }  // namespace kernels
 }  // namespace dali
 
@@ -70,6 +70,62 @@ struct sum {
   static constexpr T neutral() noexcept { return 0; }
 };
 
+/**
+ * @brief The state of a one-pass mean and variance calculation
+ *
+ * `m2` is the sum of squared differences from the mean. The number of elements is stored
+ * in the same type as the statistics - it only serves as a weight when states are merged.
+ */
+template <typename T>
+struct welford_state {
+  T mean, m2, count;
+};
+
+/**
+ * @brief Merges the mean and variance of two sets of values (Chan et al.)
+ *
+ * This allows a numerically stable calculation of mean and variance in one pass over the data,
+ * with the values converted to single-element states (see `welford_init`) and reduced in
+ * any order.
+ */
+struct welford {
+  template <typename T>
+  DALI_HOST_DEV DALI_FORCEINLINE
+  void operator()(welford_state<T> &acc, const welford_state<T> &x) const noexcept {
+    T n = acc.count + x.count;
+    if (n == 0)
+      return;
+    T delta = x.mean - acc.mean;
+    T w = x.count / n;
+    acc.mean += delta * w;
+    acc.m2 += x.m2 + delta * delta * acc.count * w;
+    acc.count = n;
+  }
+
+  template <typename Acc>
+  DALI_HOST_DEV DALI_FORCEINLINE
+  static constexpr Acc neutral() noexcept { return { 0, 0, 0 }; }
+};
+
+/**
+ * @brief Converts a value into a single-element `welford_state`
+ */
+template <typename T>
+struct welford_init {
+  template <typename U>
+  DALI_HOST_DEV DALI_FORCEINLINE
+  welford_state<T> operator()(const U &x) const noexcept {
+    return { static_cast<T>(x), 0, 1 };
+  }
+};
+
+#ifdef __CUDACC__
+template <typename T>
+__device__ DALI_FORCEINLINE welford_state<T> __ldg(const welford_state<T> *ptr) {
+  return { ::__ldg(&ptr->mean), ::__ldg(&ptr->m2), ::__ldg(&ptr->count) };
+}
+#endif
+
 template <typename T>
 struct min_impl {
   template <typename U>
@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -162,5 +162,84 @@ template class InvStdDevGPU<float, int32_t>;
 
 template class InvStdDevGPU<float, float>;
 
+
+template <typename Out, typename In>
+class MeanInvStdDevGPU<Out, In>::Impl : public reduce_impl::MeanInvStdDevImplGPU<Out, In> {
+};
+
+template <typename Out, typename In>
+MeanInvStdDevGPU<Out, In>::MeanInvStdDevGPU() {}
+
+template <typename Out, typename In>
+MeanInvStdDevGPU<Out, In>::~MeanInvStdDevGPU() {}
+
+template <typename Out, typename In>
+KernelRequirements MeanInvStdDevGPU<Out, In>::Setup(
+    KernelContext &ctx,
+    const TensorListShape<> &in_shape, span<const int> axes, bool keep_dims, bool reduce_batch) {
+  if (!impl_) {
+    impl_ = std::make_unique<Impl>();
+  }
+  return impl_->Setup(ctx, in_shape, axes, keep_dims, reduce_batch);
+}
+
+template <typename Out, typename In>
+void MeanInvStdDevGPU<Out, In>::Run(
+    KernelContext &ctx, const OutListGPU<Out> &mean, const OutListGPU<Out> &inv_stddev,
+    const InListGPU<In> &in, int ddof, param_t epsilon) {
+  assert(impl_ != nullptr);
+  impl_->Run(ctx, mean, inv_stddev, in, ddof, epsilon);
+}
+
+template class MeanInvStdDevGPU<float, uint8_t>;
+template class MeanInvStdDevGPU<float, int8_t>;
+
+template class MeanInvStdDevGPU<float, uint16_t>;
+template class MeanInvStdDevGPU<float, int16_t>;
+
+template class MeanInvStdDevGPU<float, uint32_t>;
+template class MeanInvStdDevGPU<float, int32_t>;
+
+template class MeanInvStdDevGPU<float, float>;
+
+
+template <typename Out, typename In>
+class PowerSumsGPU<Out, In>::Impl : public reduce_impl::PowerSumsImplGPU<Out, In> {
+};
+
+template <typename Out, typename In>
+PowerSumsGPU<Out, In>::PowerSumsGPU() {}
+
+template <typename Out, typename In>
+PowerSumsGPU<Out, In>::~PowerSumsGPU() {}
+
+template <typename Out, typename In>
+KernelRequirements PowerSumsGPU<Out, In>::Setup(
+    KernelContext &ctx,
+    const TensorListShape<> &in_shape, span<const int> axes, bool keep_dims, bool reduce_batch) {
+  if (!impl_) {
+    impl_ = std::make_unique<Impl>();
+  }
+  return impl_->Setup(ctx, in_shape, axes, keep_dims, reduce_batch);
+}
+
+template <typename Out, typename In>
+void PowerSumsGPU<Out, In>::Run(
+    KernelContext &ctx, const OutListGPU<vec<3, Out>> &out, const InListGPU<In> &in) {
+  assert(impl_ != nullptr);
+  impl_->Run(ctx, out, in);
+}
+
+template class PowerSumsGPU<double, uint8_t>;
+template class PowerSumsGPU<double, int8_t>;
+
+template class PowerSumsGPU<double, uint16_t>;
+template class PowerSumsGPU<double, int16_t>;
+
+template class PowerSumsGPU<double, uint32_t>;
+template class PowerSumsGPU<double, int32_t>;
+
+template class PowerSumsGPU<double, float>;
+
 }  // namespace kernels
 }  // namespace dali
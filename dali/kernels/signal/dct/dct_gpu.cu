@@ -13,11 +13,13 @@
 // limitations under the License.
 
 #include "dali/kernels/signal/dct/dct_gpu.h"
+#include <algorithm>
 #include <cmath>
 #include "dali/core/common.h"
 #include "dali/core/convert.h"
 #include "dali/core/error_handling.h"
 #include "dali/core/format.h"
+#include "dali/core/math_util.h"
 #include "dali/core/util.h"
 #include "dali/kernels/common/utils.h"
 #include "dali/kernels/kernel.h"
@@ -127,6 +129,8 @@ KernelRequirements Dct1DGpu<OutputType, InputType>::Setup(KernelContext &ctx,
   TensorListShape<> out_shape(in.num_samples(), dims);
   TensorListShape<3> reduced_shape(in.num_samples());
   max_cos_table_size_ = 0;
+  int64_t max_input_length = 0;
+  int64_t new_tables_size = 0;
   axis_ = axis >= 0 ? axis : dims - 1;
   DALI_ENFORCE(axis_ >= 0 && axis_ < dims,
                make_string("Axis is out of bounds: ", axis_));
@@ -150,11 +154,13 @@ KernelRequirements Dct1DGpu<OutputType, InputType>::Setup(KernelContext &ctx,
     }
     if (cos_tables_.find({n, arg}) == cos_tables_.end()) {
       cos_tables_[{n, arg}] = nullptr;
-      se.add<mm::memory_kind::device, OutputType>(n * arg.ndct);
+      if (table_cache_.find({n, arg}) == table_cache_.end())
+        new_tables_size += n * arg.ndct;
       if (n * arg.ndct > max_cos_table_size_) {
         max_cos_table_size_ = n * arg.ndct;
       }
     }
+    max_input_length = std::max(max_input_length, n);
     auto reduced_samle_shape = reduce_shape(in_shape, axis_, arg.ndct);
     reduced_shape.set_tensor_shape(s, reduced_samle_shape);
     if (reduced_samle_shape[2] != 1)
@@ -163,13 +169,27 @@ KernelRequirements Dct1DGpu<OutputType, InputType>::Setup(KernelContext &ctx,
     sample_shape[axis_] = arg.ndct;
     out_shape.set_tensor_shape(s, sample_shape);
   }
-  se.add<mm::memory_kind::pinned, OutputType>(max_cos_table_size_);
-  if (cos_tables_.size() > 1) {
-    se.add<mm::memory_kind::pinned, OutputType>(max_cos_table_size_);
-  }
+  if (new_tables_size > 0)
+    se.add<mm::memory_kind::pinned, OutputType>(new_tables_size);
   se.add<mm::memory_kind::device, SampleDesc>(in.num_samples());
   if (inner_axis_) {
-    block_setup_inner_.Setup(reduced_shape);
+    // Each block loads the whole cosine table to shared memory - process enough frames
+    // to amortize that, but keep enough blocks to occupy the device and stay within
+    // the default shared memory limit.
+    constexpr int64_t kMinFrames = 8, kMaxFrames = 64, kMinBlocks = 256, kMaxShmSize = 48 << 10;
+    int64_t total_frames = 0;
+    for (int s = 0; s < reduced_shape.num_samples(); s++)
+      total_frames += reduced_shape[s][0];
+    max_input_length = std::max<int64_t>(max_input_length, 1);
+    int64_t frames_per_block = clamp(max_cos_table_size_ / max_input_length,
+                                     kMinFrames, kMaxFrames);
+    int64_t table_bytes = max_cos_table_size_ * sizeof(OutputType);
+    int64_t frame_bytes = max_input_length * sizeof(InputType);
+    int64_t shm_frames = (kMaxShmSize - table_bytes) / frame_bytes;
+    frames_per_block = std::min({frames_per_block,
+                                 std::max(kMinFrames, total_frames / kMinBlocks),
+                                 std::max(kMinFrames, shm_frames)});
+    block_setup_inner_.Setup(reduced_shape, frames_per_block);
     se.add<mm::memory_kind::device, BlockSetupInner::BlockDesc>(block_setup_inner_.Blocks().size());
   } else {
     block_setup_.SetupBlocks(reduced_shape, true);
@@ -185,26 +205,7 @@ DLL_PUBLIC void Dct1DGpu<OutputType, InputType>::Run(KernelContext &ctx,
                                                      const OutListGPU<OutputType> &out,
                                                      const InListGPU<InputType> &in,
                                                      InTensorGPU<float, 1> lifter_coeffs) {
-  OutputType *cpu_cos_table[2];
-  cpu_cos_table[0] = ctx.scratchpad->AllocatePinned<OutputType>(max_cos_table_size_);
-  if (cos_tables_.size() > 1) {
-    cpu_cos_table[1] = ctx.scratchpad->AllocatePinned<OutputType>(max_cos_table_size_);
-  }
-
-  int i = 0;
-  for (auto &table_entry : cos_tables_) {
-    auto cpu_table = cpu_cos_table[i % 2];
-    auto &buffer_event = buffer_events_[i % 2];
-    int n;
-    DctArgs arg;
-    std::tie(n, arg) = table_entry.first;
-    CUDA_CALL(cudaEventSynchronize(buffer_event));
-    FillCosineTable(cpu_table, n, arg);
-    table_entry.second = ctx.scratchpad->ToGPU(ctx.gpu.stream,
-                                               span<OutputType>(cpu_table, n * arg.ndct));
-    CUDA_CALL(cudaEventRecord(buffer_event, ctx.gpu.stream));
-    ++i;
-  }
+  PrepareCosineTables(ctx);
   sample_descs_.clear();
   sample_descs_.reserve(args_.size());
   int s = 0;
@@ -234,7 +235,35 @@ DLL_PUBLIC void Dct1DGpu<OutputType, InputType>::Run(KernelContext &ctx,
   }
 }
 
-void BlockSetupInner::Setup(const TensorListShape<3> &reduced_shape) {
+template <typename OutputType, typename InputType>
+void Dct1DGpu<OutputType, InputType>::PrepareCosineTables(KernelContext &ctx) {
+  if (table_cache_.size() + cos_tables_.size() > kMaxCachedTables) {
+    // The previous runs might still use the tables, which are about to be freed
+    CUDA_CALL(cudaStreamSynchronize(ctx.gpu.stream));
+    for (auto it = table_cache_.begin(); it != table_cache_.end(); ) {
+      if (cos_tables_.count(it->first))
+        ++it;
+      else
+        it = table_cache_.erase(it);
+    }
+  }
+  for (auto &table_entry : cos_tables_) {
+    auto &table = table_cache_[table_entry.first];
+    if (table.empty()) {
+      int n;
+      DctArgs arg;
+      std::tie(n, arg) = table_entry.first;
+      int64_t size = static_cast<int64_t>(n) * arg.ndct;
+      OutputType *cpu_table = ctx.scratchpad->AllocatePinned<OutputType>(size);
+      FillCosineTable(cpu_table, n, arg);
+      table.from_host(cpu_table, size, ctx.gpu.stream);
+    }
+    table_entry.second = table.data();
+  }
+}
+
+void BlockSetupInner::Setup(const TensorListShape<3> &reduced_shape, int64_t frames_per_block) {
+  frames_per_block_ = frames_per_block;
   blocks_.clear();
   int64_t bid = 0;
   for (int s = 0; s < reduced_shape.num_samples(); ++s) {
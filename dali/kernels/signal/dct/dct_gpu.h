@@ -20,13 +20,13 @@
 #include <map>
 #include <utility>
 #include "dali/core/common.h"
+#include "dali/core/dev_buffer.h"
 #include "dali/core/error_handling.h"
 #include "dali/core/format.h"
 #include "dali/core/util.h"
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/signal/dct/dct_args.h"
 #include "dali/kernels/common/block_setup.h"
-#include "dali/core/cuda_event.h"
 
 namespace dali {
 namespace kernels {
@@ -41,7 +41,10 @@ class BlockSetupInner {
     int64_t frame_count;
   };
 
-  void Setup(const TensorListShape<3> &reduced_shape);
+  /**
+   * @brief Splits the frames of the samples into blocks of (at most) `frames_per_block` frames
+   */
+  void Setup(const TensorListShape<3> &reduced_shape, int64_t frames_per_block = 8);
 
   const std::vector<BlockDesc> &Blocks() {
     return blocks_;
@@ -63,7 +66,7 @@ class BlockSetupInner {
 
  private:
   std::vector<BlockDesc> blocks_{};
-  const int64_t frames_per_block_ = 8;
+  int64_t frames_per_block_ = 8;
 };
 
 /**
@@ -74,6 +77,9 @@ class BlockSetupInner {
  *          https://en.wikipedia.org/wiki/Discrete_cosine_transform
  *          DCT generally stands for type II and inverse DCT stands for DCT type III
  *
+ * @remarks The cosine tables are kept in device memory between the runs and are only computed
+ *          for the combinations of the input length and the arguments that weren't seen before.
+ *
  * @see DCTArgs
  */
 template <typename OutputType = float,  typename InputType = OutputType>
@@ -106,7 +112,7 @@ class DLL_PUBLIC Dct1DGpu {
   static_assert(std::is_same<OutputType, InputType>::value,
     "Data type conversion is not supported");
 
-  DLL_PUBLIC Dct1DGpu(): buffer_events_{CUDAEvent::Create(), CUDAEvent::Create()} {};
+  DLL_PUBLIC Dct1DGpu() = default;
 
   DLL_PUBLIC KernelRequirements Setup(KernelContext &context,
                                       const InListGPU<InputType> &in,
@@ -124,7 +130,17 @@ class DLL_PUBLIC Dct1DGpu {
   void RunPlanarDCT(KernelContext &context, int max_ndct,
                     InTensorGPU<float, 1> lifter_coeffs);
 
-  std::map<std::pair<int, DctArgs>, OutputType*> cos_tables_{};
+  /**
+   * @brief Fills the missing cosine tables of the current batch and sets `cos_tables_`
+   */
+  void PrepareCosineTables(KernelContext &context);
+
+  using TableKey = std::pair<int, DctArgs>;
+  /// The maximum number of cosine tables kept between the runs
+  static constexpr int kMaxCachedTables = 64;
+  /// The tables used by the current batch, pointing to `table_cache_`
+  std::map<TableKey, const OutputType*> cos_tables_{};
+  std::map<TableKey, DeviceBuffer<OutputType>> table_cache_{};
   std::vector<DctArgs> args_{};
   BlockSetup<3, -1> block_setup_{};
   BlockSetupInner block_setup_inner_{};
@@ -132,7 +148,6 @@ class DLL_PUBLIC Dct1DGpu {
   int64_t max_cos_table_size_ = 0;
   int axis_ = -1;
   bool inner_axis_ = false;
-  CUDAEvent buffer_events_[2];
 };
 
 }  // namespace dct
@@ -12,8 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <random>
 #include <tuple>
 #include <string>
+#include <vector>
 #include "dali/kernels/signal/dct/dct_gpu.h"
 #include "dali/kernels/kernel_manager.h"
 #include "dali/kernels/common/utils.h"
@@ -190,6 +192,52 @@ INSTANTIATE_TEST_SUITE_P(Dct1DGpuTest, Dct1DGpuTest, testing::Combine(
                     std::make_pair(1, std::vector<int>{0, 0}))  // dims, axes
   ));  // NOLINT
 
+TEST(Dct1DGpuCacheTest, ManyInputLengths) {
+  // More combinations of the input length and the arguments than the number of cached tables
+  using Kernel = Dct1DGpu<float>;
+  const int batch_size = 16;
+  const int nframes = 100;
+  KernelContext ctx;
+  ctx.gpu.stream = 0;
+  KernelManager kmgr;
+  kmgr.Resize<Kernel>(1);
+  std::mt19937_64 rng{4321};
+  TestTensorList<float, 2> in, out;
+  for (int iter = 0; iter < 10; iter++) {
+    // every other iteration repeats the lengths of the previous one
+    int first_length = 2 + (iter / 2) * batch_size;
+    TensorListShape<2> in_shape(batch_size), out_shape(batch_size);
+    std::vector<DctArgs> args(batch_size);
+    for (int s = 0; s < batch_size; s++) {
+      args[s].dct_type = 2 + s % 3;
+      args[s].normalize = s % 2;
+      args[s].ndct = 13;
+      in_shape.set_tensor_shape(s, {nframes, first_length + s});
+      out_shape.set_tensor_shape(s, {nframes, args[s].ndct});
+    }
+    in.reshape(in_shape);
+    UniformRandomFill(in.cpu(), rng, 0., 1.);
+    auto req = kmgr.Setup<Kernel>(0, ctx, in.gpu(), make_cspan(args), 1);
+    ASSERT_EQ(req.output_shapes[0], out_shape);
+    out.reshape(out_shape);
+    kmgr.Run<Kernel>(0, ctx, out.gpu(), in.gpu(), InTensorGPU<float, 1>{});
+    CUDA_CALL(cudaStreamSynchronize(ctx.gpu.stream));
+    auto in_cpu = in.cpu();
+    auto out_cpu = out.cpu();
+    for (int s = 0; s < batch_size; s++) {
+      int n = in_shape[s][1];
+      int ndct = args[s].ndct;
+      std::vector<float> ref(ndct);
+      for (int f = 0; f < nframes; f++) {
+        ReferenceDct(args[s].dct_type, make_span(ref),
+                     make_cspan(in_cpu.tensor_data(s) + f * n, n), args[s].normalize, 0.f);
+        for (int k = 0; k < ndct; k++)
+          ASSERT_NEAR(ref[k], out_cpu.tensor_data(s)[f * ndct + k], 1e-4)
+            << "iteration " << iter << ", sample " << s << ", frame " << f << ", k = " << k;
+      }
+    }
+  }
+}
 
 class Dct1DGpuPerfTest : public ::testing::TestWithParam<bool> {
  protected:
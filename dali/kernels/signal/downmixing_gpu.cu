@@ -0,0 +1,102 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/kernels/signal/downmixing_gpu.h"
+#include <algorithm>
+#include "dali/core/convert.h"
+#include "dali/core/cuda_error.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+
+namespace dali {
+namespace kernels {
+namespace signal {
+
+namespace {
+
+struct DownmixSampleDesc {
+  void *out;
+  const void *in;
+  int64_t length;
+  int nchannels;
+};
+
+template <typename Out, typename In>
+__global__ void DownmixKernel(const DownmixSampleDesc *samples) {
+  auto sample = samples[blockIdx.y];
+  Out *out = static_cast<Out *>(sample.out);
+  const In *in = static_cast<const In *>(sample.in);
+  float weight = 1.0f / sample.nchannels;
+  int64_t grid_stride = static_cast<int64_t>(gridDim.x) * blockDim.x;
+  for (int64_t i = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+       i < sample.length; i += grid_stride) {
+    const In *in_ptr = in + i * sample.nchannels;
+    float sum = ConvertNorm<float>(in_ptr[0]) * weight;
+    for (int c = 1; c < sample.nchannels; c++)
+      sum += ConvertNorm<float>(in_ptr[c]) * weight;
+    out[i] = ConvertSatNorm<Out>(sum);
+  }
+}
+
+}  // namespace
+
+template <typename Out, typename In>
+KernelRequirements DownmixGPU<Out, In>::Setup(KernelContext &context,
+                                              const InListGPU<In, 2> &in) {
+  KernelRequirements req;
+  TensorListShape<1> out_shape(in.num_samples());
+  for (int i = 0; i < in.num_samples(); i++)
+    out_shape.set_tensor_shape(i, {in.shape[i][0]});
+  req.output_shapes = {out_shape};
+  return req;
+}
+
+template <typename Out, typename In>
+void DownmixGPU<Out, In>::Run(KernelContext &context, const OutListGPU<Out, 1> &out,
+                              const InListGPU<In, 2> &in) {
+  int nsamples = in.num_samples();
+  if (nsamples == 0)
+    return;
+  assert(context.scratchpad);
+  auto &scratch = *context.scratchpad;
+  auto samples_cpu =
+      make_span(scratch.Allocate<mm::memory_kind::pinned, DownmixSampleDesc>(nsamples), nsamples);
+  int64_t max_length = 0;
+  for (int i = 0; i < nsamples; i++) {
+    auto &desc = samples_cpu[i];
+    desc.out = out.data[i];
+    desc.in = in.data[i];
+    desc.length = in.shape[i][0];
+    desc.nchannels = in.shape[i][1];
+    assert(out.shape[i][0] == desc.length);
+    max_length = std::max(max_length, desc.length);
+  }
+  auto samples_gpu = scratch.ToGPU(context.gpu.stream, samples_cpu);
+
+  dim3 block(256);
+  int64_t blocks = (max_length + block.x - 1) / block.x;
+  dim3 grid(std::max<int64_t>(1, std::min<int64_t>(blocks, 1024)), nsamples);
+  DownmixKernel<Out, In><<<grid, block, 0, context.gpu.stream>>>(samples_gpu);
+  CUDA_CALL(cudaGetLastError());
+}
+
+template class DownmixGPU<float, float>;
+template class DownmixGPU<float, int16_t>;
+template class DownmixGPU<float, int32_t>;
+template class DownmixGPU<int16_t, float>;
+template class DownmixGPU<int32_t, float>;
+
+}  // namespace signal
+}  // namespace kernels
+}  // namespace dali
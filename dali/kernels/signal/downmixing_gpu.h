@@ -0,0 +1,44 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_KERNELS_SIGNAL_DOWNMIXING_GPU_H_
+#define DALI_KERNELS_SIGNAL_DOWNMIXING_GPU_H_
+
+#include "dali/kernels/kernel.h"
+
+namespace dali {
+namespace kernels {
+namespace signal {
+
+/**
+ * @brief Downmixes a batch of interleaved signals to a single channel, with equal weights
+ *
+ * The input samples have the shape {length, channels}; the output ones - {length}.
+ * The output values are the same as the ones of the CPU Downmix with the default weights.
+ */
+template <typename Out, typename In>
+class DLL_PUBLIC DownmixGPU {
+ public:
+  DLL_PUBLIC KernelRequirements Setup(KernelContext &context, const InListGPU<In, 2> &in);
+
+  DLL_PUBLIC void Run(KernelContext &context, const OutListGPU<Out, 1> &out,
+                      const InListGPU<In, 2> &in);
+};
+
+}  // namespace signal
+}  // namespace kernels
+}  // namespace dali
+
+#endif  // DALI_KERNELS_SIGNAL_DOWNMIXING_GPU_H_
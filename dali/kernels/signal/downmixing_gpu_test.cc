@@ -0,0 +1,65 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/kernels/signal/downmixing_gpu.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/signal/downmixing.h"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+namespace kernels {
+namespace signal {
+namespace test {
+
+TEST(SignalDownmixingGPU, MatchesCPU) {
+  TensorListShape<2> in_shape = {{1000, 2}, {12345, 3}, {1, 8}, {4000, 1}};
+  TensorListShape<1> out_shape = {{1000}, {12345}, {1}, {4000}};
+  TestTensorList<float, 2> in;
+  TestTensorList<float, 1> out;
+  in.reshape(in_shape);
+  out.reshape(out_shape);
+  std::mt19937 rng(1234);
+  UniformRandomFill(in.cpu(), rng, -1.0f, 1.0f);
+
+  KernelContext ctx;
+  ctx.gpu.stream = 0;
+  DynamicScratchpad dyn_scratchpad({}, AccessOrder(ctx.gpu.stream));
+  ctx.scratchpad = &dyn_scratchpad;
+
+  DownmixGPU<float, float> kernel;
+  auto req = kernel.Setup(ctx, in.gpu());
+  ASSERT_EQ(req.output_shapes[0], out_shape);
+  kernel.Run(ctx, out.gpu(), in.gpu());
+  CUDA_CALL(cudaStreamSynchronize(ctx.gpu.stream));
+
+  auto in_cpu = in.cpu();
+  auto out_cpu = out.cpu();
+  for (int s = 0; s < in_shape.num_samples(); s++) {
+    int64_t length = in_shape[s][0];
+    std::vector<float> ref(length);
+    Downmix(ref.data(), in_cpu[s].data, length, in_shape[s][1]);
+    for (int64_t i = 0; i < length; i++)
+      ASSERT_NEAR(out_cpu[s].data[i], ref[i], 1e-6f) << "sample " << s << " at " << i;
+  }
+}
+
+}  // namespace test
+}  // namespace signal
+}  // namespace kernels
+}  // namespace dali
@@ -23,6 +23,7 @@ namespace fft {
 
 void StftImplGPU::Reset() {
   plans_.clear();
+  max_work_size_ = 0;
   post_complex_.reset();
   post_real_.reset();
 }
@@ -134,6 +135,7 @@ void StftImplGPU::CreatePlans(int64_t nwindows) {
           handle, 1, n,
           0, 0, 0, 0, 0, 0,
           CUFFT_R2C, w, &plan.work_size));
+      max_work_size_ = std::max(max_work_size_, plan.work_size);
     }
   }
 
@@ -158,25 +160,11 @@ void StftImplGPU::ReserveTempStorage(ScratchpadEstimator &se) {
   // transform output
   se.add<mm::memory_kind::device, float2>(num_temp_windows() * transform_out_size());
 
-  int windows_left = total_windows_;
-  int max_plan = num_temp_windows();
-
-  size_t max_work = 0;
-  while (windows_left > 0) {
-    auto it = plans_.upper_bound(max_plan);
-    assert(it != plans_.begin());
-    --it;
-    int batch = it->first;
-    max_work = std::max(max_work, it->second.work_size);
-    windows_left -= batch;
-    max_plan -= batch;
-  }
-
-  max_work_size_ = max_work;
-
+  // Any of the plans may be used for a part of the batch - the workspace is sized for the largest
+  // one, so that it doesn't need to be reallocated when the decomposition of the batch changes.
   for (size_t i = 0; i < streams_.size(); i++)
     // make each allocation aligned to a complex number
-    se.add<mm::memory_kind::device, char>(max_work, alignof(double2));
+    se.add<mm::memory_kind::device, char>(max_work_size_, alignof(double2));
 }
 
 void StftImplGPU::ValidateParams(ExecutionContext &ctx) {
@@ -59,6 +59,11 @@ class StftImplGPU {
            const InListGPU<float, 1> &in,
            const InTensorGPU<float, 1> &window);
 
+  /// Number of cuFFT plans created so far; the plans are reused until the arguments change
+  int num_plans() const {
+    return plans_.size();
+  }
+
  private:
   void Reset();
 
@@ -112,6 +117,14 @@ class StftImplGPU {
     CUFFTHandle handle;
     size_t work_size = 0;
   };
+  /**
+   * The plans, keyed by the number of windows they transform (a power of 2).
+   *
+   * The total number of windows in the batch is decomposed into these buckets, so batches
+   * of variable-length recordings reuse the same plans. The plans don't allocate their
+   * workspace - it's taken from the scratchpad and sized for the largest plan created so far,
+   * so that the scratch requirements don't change with the decomposition of each batch.
+   */
   std::map<int, PlanInfo> plans_;
   struct Stream {
     CUDAStream stream;
@@ -119,6 +132,7 @@ class StftImplGPU {
   };
   CUDAEvent main_stream_ready_;
   std::vector<Stream> streams_;
+  /// The largest workspace required by any of the plans
   size_t max_work_size_ = 0;
   static constexpr int kMaxStreams = 4;
 
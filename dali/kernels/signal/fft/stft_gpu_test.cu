@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <random>
 #include <utility>
 #include <vector>
@@ -24,6 +25,7 @@
 #include "dali/kernels/signal/window/window_functions.h"
 #include "dali/kernels/signal/fft/fft_test_ref.h"
 #include "dali/kernels/signal/fft/stft_gpu.h"
+#include "dali/kernels/signal/fft/stft_gpu_impl.cuh"
 #include "dali/kernels/signal/fft/fft_postprocess.cuh"
 #include "dali/core/boundary.h"
 #include "dali/test/test_sound_generator.h"
@@ -174,6 +176,41 @@ TEST(StftGPU, Setup) {
   }
 }
 
+TEST(StftGPU, PlanReuse) {
+  StftImplGPU stft;
+  StftArgs args;
+  args.axis = 0;
+  args.spectrum_type = FFT_SPECTRUM_POWER;
+  args.window_length = 400;
+  args.window_center = 200;
+  args.window_step = 160;
+  args.nfft = 512;
+
+  std::mt19937_64 rng(1234);
+  std::uniform_int_distribution<int64_t> length_dist(1000, 300000);
+  std::uniform_int_distribution<int> batch_dist(1, 16);
+  std::vector<TensorListShape<1>> batches(20);
+  for (auto &lengths : batches) {
+    lengths.resize(batch_dist(rng));
+    for (auto &l : lengths.shapes)
+      l = length_dist(rng);
+  }
+
+  KernelContext ctx;
+  ctx.gpu.stream = 0;
+  for (auto &lengths : batches)
+    stft.Setup(ctx, lengths, args);
+  int num_plans = stft.num_plans();
+  EXPECT_GT(num_plans, 0);
+
+  // once the batches were seen, the plans are reused, regardless of the order of the batches
+  std::shuffle(batches.begin(), batches.end(), rng);
+  for (auto &lengths : batches) {
+    stft.Setup(ctx, lengths, args);
+    EXPECT_EQ(stft.num_plans(), num_plans);
+  }
+}
+
 template <typename Params>
 class StftGPUTest;
 
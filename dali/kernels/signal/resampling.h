@@ -98,6 +98,45 @@ inline int64_t resampled_length(int64_t in_length, double in_rate, double out_ra
   return std::ceil(in_length * out_rate / in_rate);
 }
 
+/**
+ * @brief Expresses the ratio of integral sampling rates as `phase_step / nphases`
+ *
+ * @return false if any of the rates is not an integer
+ */
+inline bool polyphase_ratio(double in_rate, double out_rate, int &phase_step, int &nphases) {
+  if (in_rate <= 0 || out_rate <= 0 || in_rate > (1 << 30) || out_rate > (1 << 30) ||
+      in_rate != std::floor(in_rate) || out_rate != std::floor(out_rate))
+    return false;
+  int64_t a = in_rate, b = out_rate;
+  while (b) {
+    int64_t tmp = a % b;
+    a = b;
+    b = tmp;
+  }
+  phase_step = in_rate / a;
+  nphases = out_rate / a;
+  return true;
+}
+
+/**
+ * @brief Calculates the window coefficients for each of the `nphases` fractional input positions
+ *
+ * The row `p` contains the `2 * window.lobes` coefficients for the input position with
+ * the fractional part `p / nphases`, starting with the first input sample under the window
+ * (see ResamplingWindow::input_range).
+ */
+inline void polyphase_coeffs(std::vector<float> &coeffs, const ResamplingWindow &window,
+                             int nphases) {
+  int ntaps = 2 * window.lobes;
+  coeffs.resize(static_cast<size_t>(nphases) * ntaps);
+  for (int p = 0; p < nphases; p++) {
+    float frac = static_cast<float>(p) / nphases;
+    int first = (p > 0) - window.lobes;
+    for (int t = 0; t < ntaps; t++)
+      coeffs[p * ntaps + t] = window(first + t - frac);
+  }
+}
+
 }  // namespace resampling
 }  // namespace signal
 }  // namespace kernels
@@ -13,6 +13,10 @@
 // limitations under the License.
 
 #include <cuda_runtime.h>
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
 #include "dali/core/dev_buffer.h"
 #include "dali/core/mm/memory.h"
 #include "dali/core/static_switch.h"
@@ -30,12 +34,21 @@ namespace resampling {
 template <typename Out, typename In>
 void ResamplerGPU<Out, In>::Initialize(int lobes, int lookup_size) {
   windowed_sinc(window_cpu_, lookup_size, lobes);
+  phase_coeffs_.clear();
   window_gpu_storage_.from_host(window_cpu_.storage);
   window_gpu_ = window_cpu_;
   window_gpu_.lookup = window_gpu_storage_.data();
   CUDA_CALL(cudaStreamSynchronize(0));
 }
 
+template <typename Out, typename In>
+const std::vector<float> &ResamplerGPU<Out, In>::PhaseCoeffs(int nphases) {
+  auto &coeffs = phase_coeffs_[nphases];
+  if (coeffs.empty())
+    polyphase_coeffs(coeffs, window_cpu_, nphases);
+  return coeffs;
+}
+
 template <typename Out, typename In>
 KernelRequirements ResamplerGPU<Out, In>::Setup(KernelContext &context, const InListGPU<In> &in,
                                                 span<const Args> args) {
@@ -68,6 +81,35 @@ void ResamplerGPU<Out, In>::Run(KernelContext &context, const OutListGPU<Out> &o
   auto samples_cpu =
       make_span(scratch.Allocate<mm::memory_kind::pinned, SampleDesc>(nsamples), nsamples);
 
+  // the polyphase coefficients used in this batch, by the number of phases
+  std::map<int, int64_t> coeffs_offsets;
+  // (phase_step, nphases) of each sample; nphases is 0 if the sample isn't resampled with
+  // the polyphase coefficients
+  std::vector<std::pair<int, int>> sample_phases(nsamples, {0, 0});
+  int64_t total_coeffs = 0;
+  int ntaps = 2 * window_cpu_.lobes;
+  size_t max_coeffs = window_gpu_storage_.size();
+  for (int i = 0; i < nsamples; i++) {
+    int phase_step, nphases;
+    if (!polyphase_ratio(args[i].in_rate, args[i].out_rate, phase_step, nphases) ||
+        static_cast<int64_t>(nphases) * ntaps > kMaxPolyphaseCoeffs)
+      continue;
+    sample_phases[i] = {phase_step, nphases};
+    if (coeffs_offsets.emplace(nphases, total_coeffs).second)
+      total_coeffs += nphases * ntaps;
+    max_coeffs = std::max<size_t>(max_coeffs, nphases * ntaps);
+  }
+  float *coeffs_gpu = nullptr;
+  if (total_coeffs > 0) {
+    auto coeffs_cpu = make_span(
+        scratch.Allocate<mm::memory_kind::pinned, float>(total_coeffs), total_coeffs);
+    for (auto &offset : coeffs_offsets) {
+      auto &coeffs = PhaseCoeffs(offset.first);
+      std::copy(coeffs.begin(), coeffs.end(), &coeffs_cpu[offset.second]);
+    }
+    coeffs_gpu = scratch.ToGPU(context.gpu.stream, coeffs_cpu);
+  }
+
   bool any_multichannel = false;
   for (int i = 0; i < nsamples; i++) {
     auto &desc = samples_cpu[i];
@@ -85,6 +127,9 @@ void ResamplerGPU<Out, In>::Run(KernelContext &context, const OutListGPU<Out> &o
     assert((desc.out_end - desc.out_begin) == out_sample.shape[0]);
     desc.nchannels = in_sh.sample_dim() > 1 ? in_sh[1] : 1;
     desc.scale = arg.in_rate / arg.out_rate;
+    desc.phase_step = sample_phases[i].first;
+    desc.nphases = sample_phases[i].second;
+    desc.phase_coeffs = desc.nphases > 0 ? coeffs_gpu + coeffs_offsets[desc.nphases] : nullptr;
     any_multichannel |= desc.nchannels > 1;
   }
 
@@ -94,8 +139,8 @@ void ResamplerGPU<Out, In>::Run(KernelContext &context, const OutListGPU<Out> &o
   int blocks_per_sample = std::max(32, 1024 / nsamples);
   dim3 grid(blocks_per_sample, nsamples);
 
-  // window coefficients and temporary per channel out values
-  size_t shm_size = (window_gpu_storage_.size() + (SHM_NCHANNELS + 1) * block.x) * sizeof(float);
+  // window (or polyphase) coefficients and temporary per channel out values
+  size_t shm_size = (max_coeffs + (SHM_NCHANNELS + 1) * block.x) * sizeof(float);
 
   BOOL_SWITCH(!any_multichannel, SingleChannel,
               (ResampleGPUKernel<Out, In, SingleChannel>
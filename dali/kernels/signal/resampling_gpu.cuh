@@ -37,6 +37,10 @@ struct SampleDesc {
   int64_t out_end;  // output region-of-interest end
   int nchannels;  // number of channels
   double scale;  // in_sampling_rate / out_sampling_rate
+  // polyphase coefficients (nphases rows of 2 * window.lobes taps) or null
+  const float *phase_coeffs;
+  int nphases;  // out_sampling_rate / gcd(in_sampling_rate, out_sampling_rate)
+  int phase_step;  // in_sampling_rate / gcd(in_sampling_rate, out_sampling_rate)
 };
 
 /**
@@ -53,6 +57,71 @@ __device__ float ConvertInput(In in_val) {
   }
 }
 
+/**
+ * @brief Resamples a signal with a rational rate ratio, with the window coefficients
+ *        precomputed for each of the output phases.
+ *
+ * The output sample `out_pos` is centered at `out_pos * phase_step / nphases` in the input,
+ * so the fractional part of the position repeats every `nphases` samples and the coefficients
+ * don't need to be interpolated from the window lookup table.
+ */
+template <typename Out, typename In, bool SingleChannel>
+__device__ void ResamplePolyphase(const SampleDesc &sample, float *sh_mem) {
+  int ntaps = 2 * sample.window.lobes;
+  int ncoeffs = sample.nphases * ntaps;
+  int nchannels = SingleChannel ? 1 : sample.nchannels;
+  float *coeffs_sh = sh_mem;
+  float *tmp = sh_mem + ncoeffs +
+               threadIdx.x * (SHM_NCHANNELS+1);  // used to accummulate per-channel out values
+  for (int k = threadIdx.x; k < ncoeffs; k += blockDim.x) {
+    coeffs_sh[k] = sample.phase_coeffs[k];
+  }
+  __syncthreads();
+
+  Out* out = reinterpret_cast<Out*>(sample.out);
+  const In* in = reinterpret_cast<const In*>(sample.in);
+
+  int64_t grid_stride = static_cast<int64_t>(gridDim.x) * blockDim.x;
+  for (int64_t out_pos = sample.out_begin + static_cast<int64_t>(blockIdx.x) * blockDim.x +
+                         threadIdx.x;
+       out_pos < sample.out_end; out_pos += grid_stride) {
+    int64_t in_num = out_pos * sample.phase_step;
+    int64_t in_idx = in_num / sample.nphases;
+    int phase = in_num - in_idx * sample.nphases;
+    // the first input sample under the window - see ResamplingWindow::input_range
+    int64_t i0 = in_idx + (phase > 0) - sample.window.lobes;
+    const float *w = coeffs_sh + phase * ntaps;
+    int t0 = i0 < 0 ? -i0 : 0;
+    int t1 = i0 + ntaps > sample.in_len ? sample.in_len - i0 : ntaps;
+    const In *in_ptr = in + i0 * nchannels;
+
+    if (SingleChannel) {
+      float out_val = 0;
+      for (int t = t0; t < t1; t++) {
+        out_val = fma(ConvertInput<Out, In>(in_ptr[t]), w[t], out_val);
+      }
+      out[out_pos - sample.out_begin] = ConvertSatNorm<Out>(out_val);
+    } else {  // multiple channels
+      Out *out_ptr = out + (out_pos - sample.out_begin) * nchannels;
+      for (int c0 = 0; c0 < nchannels; c0 += SHM_NCHANNELS) {
+        int nc = cuda_min(SHM_NCHANNELS, nchannels - c0);
+        for (int c = 0; c < nc; c++) {
+          tmp[c] = 0;
+        }
+        for (int t = t0; t < t1; t++) {
+          const In *in_t = in_ptr + t * nchannels + c0;
+          for (int c = 0; c < nc; c++) {
+            tmp[c] = fma(ConvertInput<Out, In>(in_t[c]), w[t], tmp[c]);
+          }
+        }
+        for (int c = 0; c < nc; c++) {
+          out_ptr[c0 + c] = ConvertSatNorm<Out>(tmp[c]);
+        }
+      }
+    }
+  }
+}
+
 /**
  * @brief Resamples 1D signal (single or multi-channel), optionally converting to a different data type.
  *
@@ -61,12 +130,17 @@ __device__ float ConvertInput(In in_val) {
 template <typename Out, typename In, bool SingleChannel = false>
 __global__ void ResampleGPUKernel(const SampleDesc *samples) {
   auto sample = samples[blockIdx.y];
+  extern __shared__ float sh_mem[];
+  if (sample.phase_coeffs) {
+    ResamplePolyphase<Out, In, SingleChannel>(sample, sh_mem);
+    return;
+  }
+
   double scale = sample.scale;
   float fscale = scale;
   int nchannels = SingleChannel ? 1 : sample.nchannels;
   auto& window = sample.window;
 
-  extern __shared__ float sh_mem[];
   float *window_coeffs_sh = sh_mem;
   float *tmp = sh_mem + window.lookup_size +
                threadIdx.x * (SHM_NCHANNELS+1);  // used to accummulate per-channel out values
@@ -16,6 +16,8 @@
 #define DALI_KERNELS_SIGNAL_RESAMPLING_GPU_H_
 
 #include <cuda_runtime.h>
+#include <map>
+#include <vector>
 #include "dali/kernels/signal/resampling.h"
 #include "dali/kernels/kernel.h"
 #include "dali/core/dev_buffer.h"
@@ -26,9 +28,19 @@ namespace signal {
 
 namespace resampling {
 
+/**
+ * @brief Resamples a batch of signals with a windowed sinc filter
+ *
+ * When the sampling rates are integers and the number of the output phases
+ * (out_rate / gcd(in_rate, out_rate)) is small enough, the filter coefficients are precomputed
+ * for each phase (polyphase resampling) instead of being interpolated from the window.
+ */
 template <typename Out = float, typename In = Out>
 class DLL_PUBLIC ResamplerGPU {
  public:
+  /// The maximum number of the polyphase coefficients of a sample (they're kept in shared memory)
+  static constexpr int kMaxPolyphaseCoeffs = 6144;
+
   void Initialize(int lobes = 16, int lookup_size = 2048);
 
   KernelRequirements Setup(KernelContext &context, const InListGPU<In> &in, span<const Args> args);
@@ -37,7 +49,11 @@ class DLL_PUBLIC ResamplerGPU {
            const InListGPU<In> &in, span<const Args> args);
 
  private:
+  /// Returns the polyphase coefficients for the number of phases
+  const std::vector<float> &PhaseCoeffs(int nphases);
+
   ResamplingWindowCPU window_cpu_;
+  std::map<int, std::vector<float>> phase_coeffs_;
   ResamplingWindow window_gpu_;
   DeviceBuffer<float> window_gpu_storage_;
 };
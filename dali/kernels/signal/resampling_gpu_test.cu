@@ -131,6 +131,19 @@ TEST_F(ResamplingGPUTest, EightChannelOutBeginEnd) {
   this->RunTest();
 }
 
+TEST_F(ResamplingGPUTest, Polyphase) {
+  // the rational rate ratios use the precomputed polyphase coefficients
+  std::vector<Args> args_v = {
+    {48000.0f, 16000.0f}, {16000.0f, 48000.0f}, {44100.0f, 16000.0f}, {16000.0f, 16000.0f},
+    {48000.0f, 16000.0f, 100, 8000}, {8000.0f, 11025.0f}, {22050.0f, 16000.0f}, {44100.0f, 48000.0f}
+  };
+  this->nchannels_ = 2;
+  auto args = make_cspan(args_v);
+  this->PrepareData(args);
+  this->RunResampling(args);
+  this->Verify(args);
+}
+
 TEST_F(ResamplingGPUTest, PerfTest) {
   this->RunPerfTest(1000);
 }
@@ -193,6 +193,43 @@ TEST_F(ResamplingCPUTest, ThreeChannelNeedHighPrecision) {
   this->RunTest();
 }
 
+TEST(ResamplingPolyphase, Ratio) {
+  int phase_step, nphases;
+  ASSERT_TRUE(polyphase_ratio(48000, 16000, phase_step, nphases));
+  EXPECT_EQ(phase_step, 3);
+  EXPECT_EQ(nphases, 1);
+  ASSERT_TRUE(polyphase_ratio(44100, 16000, phase_step, nphases));
+  EXPECT_EQ(phase_step, 441);
+  EXPECT_EQ(nphases, 160);
+  ASSERT_TRUE(polyphase_ratio(16000, 22050, phase_step, nphases));
+  EXPECT_EQ(phase_step, 320);
+  EXPECT_EQ(nphases, 441);
+  EXPECT_FALSE(polyphase_ratio(44100.5, 16000, phase_step, nphases));
+  EXPECT_FALSE(polyphase_ratio(0, 16000, phase_step, nphases));
+}
+
+TEST(ResamplingPolyphase, CoeffsMatchWindow) {
+  ResamplingWindowCPU window;
+  windowed_sinc(window, 2048, 16);
+  int phase_step = 441, nphases = 160;
+  std::vector<float> coeffs;
+  polyphase_coeffs(coeffs, window, nphases);
+  int ntaps = 2 * window.lobes;
+  ASSERT_EQ(coeffs.size(), static_cast<size_t>(nphases * ntaps));
+  for (int64_t out_pos = 0; out_pos < 1000; out_pos++) {
+    int64_t in_num = out_pos * phase_step;
+    int64_t in_idx = in_num / nphases;
+    int phase = in_num % nphases;
+    double in_pos = static_cast<double>(in_num) / nphases;
+    auto range = window.input_range(in_pos - in_idx);
+    ASSERT_EQ(range.i1 - range.i0, ntaps);
+    for (int t = 0; t < ntaps; t++) {
+      float x = in_idx + range.i0 + t - in_pos;
+      EXPECT_NEAR(coeffs[phase * ntaps + t], window(x), 1e-5f);
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace resampling
 }  // namespace signal
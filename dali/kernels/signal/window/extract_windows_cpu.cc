@@ -13,7 +13,11 @@
 // limitations under the License.
 
 #include "dali/kernels/signal/window/extract_windows_cpu.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 #include <algorithm>
+#include <type_traits>
 #include <vector>
 #include "dali/core/common.h"
 #include "dali/core/boundary.h"
@@ -28,6 +32,50 @@ namespace dali {
 namespace kernels {
 namespace signal {
 
+namespace {
+
+/**
+ * @brief Applies the window function to `n` contiguous samples
+ */
+template <typename OutputType, typename InputType>
+void ApplyWindow(OutputType *out, const InputType *in, const float *window_fn, int n) {
+  int t = 0;
+#ifdef __SSE2__
+  if constexpr (std::is_same<OutputType, float>::value && std::is_same<InputType, float>::value) {
+    for (; t + 4 <= n; t += 4)
+      _mm_storeu_ps(out + t, _mm_mul_ps(_mm_loadu_ps(window_fn + t), _mm_loadu_ps(in + t)));
+  }
+#endif
+  for (; t < n; t++)
+    out[t] = window_fn[t] * in[t];
+}
+
+/**
+ * @brief Applies the window function to 4 windows, which start at `in`, `in + step`,
+ *        `in + 2 * step` and `in + 3 * step`, and stores them in 4 adjacent columns of
+ *        a vertical output, with rows `out_row_stride` elements apart.
+ *
+ * Each SIMD lane processes one window, so that the output is written one row at a time.
+ */
+template <typename OutputType, typename InputType>
+void ApplyWindow4Vertical(OutputType *out, int64_t out_row_stride,
+                          const InputType *in, int64_t step, const float *window_fn, int n) {
+#ifdef __SSE2__
+  if constexpr (std::is_same<OutputType, float>::value && std::is_same<InputType, float>::value) {
+    for (int t = 0; t < n; t++) {
+      __m128 x = _mm_setr_ps(in[t], in[step + t], in[2 * step + t], in[3 * step + t]);
+      _mm_storeu_ps(out + t * out_row_stride, _mm_mul_ps(_mm_set1_ps(window_fn[t]), x));
+    }
+    return;
+  }
+#endif
+  for (int t = 0; t < n; t++)
+    for (int k = 0; k < 4; k++)
+      out[t * out_row_stride + k] = window_fn[t] * in[k * step + t];
+}
+
+}  // namespace
+
 template <typename OutputType, typename InputType, int Dims, bool vertical>
 constexpr int ExtractWindowsCpu<OutputType, InputType, Dims, vertical>::InputDims;
 
@@ -116,6 +164,7 @@ void ExtractWindowsCpu<OutputType, InputType, Dims, vertical>::Run(
     [this, &window_fn](
       OutputType *out_data, const InputType *in_data,
       int64_t out_size, int64_t out_stride, int64_t in_size, int64_t in_stride) {
+        bool contiguous = in_stride == 1 && out_stride == 1;
         for (int64_t w = 0; w < nwindows_; w++) {
           int64_t window_start = w * window_step_ - window_center_offset_;
           // Window needs special treatment (falls outside of the signal)
@@ -134,6 +183,15 @@ void ExtractWindowsCpu<OutputType, InputType, Dims, vertical>::Run(
                   window_fn.data[t] * in_data[in_idx * in_stride] : 0;
               }
             }
+          } else if (contiguous && !vertical) {
+            ApplyWindow(out_data + w * window_length_, in_data + window_start,
+                        window_fn.data, window_length_);
+          } else if (contiguous && vertical && w + 4 <= nwindows_ &&
+                     window_start + 3 * window_step_ + window_length_ <= in_size) {
+            // the next 3 windows are within the signal, too
+            ApplyWindow4Vertical(out_data + w, nwindows_, in_data + window_start, window_step_,
+                                 window_fn.data, window_length_);
+            w += 3;
           } else {  // no special treatment for this window (just copy)
             for (int t = 0; t < window_length_; t++) {
               int64_t out_idx = vertical ? t * nwindows_ + w : w * window_length_ + t;
@@ -188,9 +188,10 @@ TEST_P(ExtractWindowsCpuTest, Horizontal) {
 
 INSTANTIATE_TEST_SUITE_P(ExtractWindowsCpuTest, ExtractWindowsCpuTest, testing::Combine(
     testing::Values(std::array<int64_t, 2>{1, 12},
-                    std::array<int64_t, 2>{2, 12}),
-    testing::Values(4),  // window_length
-    testing::Values(2),  // step
+                    std::array<int64_t, 2>{2, 12},
+                    std::array<int64_t, 2>{1, 50}),
+    testing::Values(4, 7),  // window_length
+    testing::Values(2, 3),  // step
     testing::Values(1),  // axis
     testing::Values(0, 2, 4),  // window offsets
     testing::Values(Padding::None, Padding::Zero, Padding::Reflect)));  // reflect padding
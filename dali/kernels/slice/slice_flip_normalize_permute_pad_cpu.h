@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,13 +15,16 @@
 #ifndef DALI_KERNELS_SLICE_SLICE_FLIP_NORMALIZE_PERMUTE_PAD_CPU_H_
 #define DALI_KERNELS_SLICE_SLICE_FLIP_NORMALIZE_PERMUTE_PAD_CPU_H_
 
+#include <initializer_list>
 #include <utility>
 #include <vector>
 #include "dali/core/common.h"
 #include "dali/core/convert.h"
+#include "dali/core/convert_bulk.h"
 #include "dali/core/error_handling.h"
 #include "dali/core/exec/engine.h"
 #include "dali/core/static_switch.h"
+#include "dali/kernels/common/simd.h"
 #include "dali/kernels/common/split_shape.h"
 #include "dali/kernels/kernel.h"
 #include "dali/kernels/slice/slice_flip_normalize_permute_pad_common.h"
@@ -213,6 +216,128 @@ void SliceFlipNormalizePermutePadKernelImpl(
   }
 }
 
+/**
+ * @brief Normalizes a block of 16 interleaved 3-channel pixels (48 values)
+ *
+ * @param mean   per-channel mean, repeated to fill 12 values (lcm of 3 channels and 4 lanes)
+ * @param scale  per-channel inverse standard deviation, repeated as `mean`
+ */
+template <typename InputType>
+inline void NormalizeInterleaved3Block(float *out, const InputType *in,
+                                       const float *mean, const float *scale) {
+  for (int i = 0; i < 48; i++)
+    out[i] = (static_cast<float>(in[i]) - mean[i % 12]) * scale[i % 12];
+}
+
+#ifdef DALI_SIMD_FLOAT4
+inline void NormalizeInterleaved3Block(float *out, const uint8_t *in,
+                                       const float *mean, const float *scale) {
+  simd::float4_t m[3], s[3];  // NOLINT
+  for (int j = 0; j < 3; j++) {
+    m[j] = simd::load_f(mean + 4 * j).v[0];
+    s[j] = simd::load_f(scale + 4 * j).v[0];
+  }
+  for (int i = 0; i < 3; i++) {
+    simd::float4x4 f = simd::load_f(in + 16 * i);
+    for (int j = 0; j < 4; j++) {
+      int k = (4 * i + j) % 3;  // position of the vector in the channel pattern
+      simd::float4x1 v = {{ simd::mul(simd::sub(f.v[j], m[k]), s[k]) }};
+      simd::store_f(out + 16 * i + 4 * j, v);
+    }
+  }
+}
+#endif
+
+/**
+ * @brief Fast path for 3-channel inputs with interleaved channels (e.g. HWC images)
+ *
+ * Handles CHW and HWC output, with the pixels optionally mirrored, without padding.
+ * The pixels are normalized in blocks of 16, in the order in which they're stored in the input,
+ * and then written to the output (reversed, if mirrored).
+ *
+ * @param rows        number of rows; the rows can be flipped (negative `in_row_stride`)
+ * @param cols        number of pixels in a row
+ * @param in_col_stride  3 or -3 (mirrored)
+ * @param out_channel_stride  distance between the channels in the output: 1 for HWC
+ *                            or the plane size for CHW
+ */
+template <typename OutputType, typename InputType>
+void SliceFlipNormalizeInterleaved3(
+    OutputType *output, const InputType *input, int64_t rows, int64_t cols,
+    int64_t in_row_stride, int64_t in_col_stride,
+    int64_t out_row_stride, int64_t out_col_stride, int64_t out_channel_stride,
+    const float *mean, const float *inv_stddev) {
+  constexpr int kBlock = 16;
+  float mean_pattern[12], scale_pattern[12];  // NOLINT
+  for (int i = 0; i < 12; i++) {
+    mean_pattern[i] = mean[i % 3];
+    scale_pattern[i] = inv_stddev[i % 3];
+  }
+  bool mirror = in_col_stride < 0;
+  float tmp[kBlock * 3];  // NOLINT
+  OutputType converted[kBlock * 3];  // NOLINT
+  for (int64_t y = 0; y < rows; y++, output += out_row_stride, input += in_row_stride) {
+    int64_t x = 0;
+    for (; x + kBlock <= cols; x += kBlock) {
+      // the pixels of a block are contiguous in memory - reversed, if mirrored
+      const InputType *in_blk = input + (mirror ? x + kBlock - 1 : x) * in_col_stride;
+      NormalizeInterleaved3Block(tmp, in_blk, mean_pattern, scale_pattern);
+      // vectorized for float16 outputs
+      ConvertSatBulk(converted, tmp, kBlock * 3);
+      OutputType *out = output + x * out_col_stride;
+      for (int i = 0; i < kBlock; i++, out += out_col_stride) {
+        const OutputType *px = converted + 3 * (mirror ? kBlock - 1 - i : i);
+        out[0] = px[0];
+        out[out_channel_stride] = px[1];
+        out[2 * out_channel_stride] = px[2];
+      }
+    }
+    for (; x < cols; x++) {
+      const InputType *px = input + x * in_col_stride;
+      OutputType *out = output + x * out_col_stride;
+      for (int c = 0; c < 3; c++)
+        Fill<true>(out[c * out_channel_stride], px[c], mean + c, inv_stddev + c);
+    }
+  }
+}
+
+/**
+ * @brief Runs SliceFlipNormalizeInterleaved3, if the 3D slice (without padding) matches it
+ *
+ * The channel dimension must be the innermost in the input and outermost (CHW)
+ * or innermost (HWC) in the output.
+ *
+ * @return false, if the generic implementation should be used
+ */
+template <typename OutputType, typename InputType>
+bool TrySliceFlipNormalizeInterleaved3(
+    OutputType *output, const InputType *input, int ndim, const int64_t *in_strides,
+    const int64_t *out_strides, const int64_t *out_shape, const float *mean,
+    const float *inv_stddev, int channel_dim) {
+  if (ndim != 3)
+    return false;
+  for (int c : {0, 2}) {
+    if (channel_dim >= 0 && channel_dim != c)
+      continue;
+    int row_dim = c == 0 ? 1 : 0;
+    int col_dim = row_dim + 1;
+    if (out_shape[c] != 3 || in_strides[c] != 1 ||
+        (in_strides[col_dim] != 3 && in_strides[col_dim] != -3))
+      continue;
+    float m[3], s[3];  // NOLINT
+    for (int i = 0; i < 3; i++) {
+      m[i] = channel_dim >= 0 ? mean[i] : mean[0];
+      s[i] = channel_dim >= 0 ? inv_stddev[i] : inv_stddev[0];
+    }
+    SliceFlipNormalizeInterleaved3(output, input, out_shape[row_dim], out_shape[col_dim],
+                                   in_strides[row_dim], in_strides[col_dim],
+                                   out_strides[row_dim], out_strides[col_dim], out_strides[c],
+                                   m, s);
+    return true;
+  }
+  return false;
+}
+
 }  // namespace detail
 
 template <int Dims, typename OutputType, typename InputType>
@@ -226,6 +351,11 @@ void SliceFlipNormalizePermutePadKernel(
   bool need_pad = NeedPad(Dims, anchor.data(), in_shape.data(), out_shape.data());
   bool has_channels = channel_dim >= 0;
   bool need_normalize = (mean != nullptr && inv_stddev != nullptr);
+  if (!need_pad && need_normalize &&
+      detail::TrySliceFlipNormalizeInterleaved3(output, input, Dims, in_strides.data(),
+                                                out_strides.data(), out_shape.data(), mean,
+                                                inv_stddev, channel_dim))
+    return;
   // Convert switch argument to `int` to avoid compiler warning about unreachable case label
   BOOL_SWITCH(need_normalize, NeedNormalize, (
     BOOL_SWITCH(has_channels, HasChannels, (
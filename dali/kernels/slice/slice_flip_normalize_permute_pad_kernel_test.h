@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -445,6 +445,27 @@ struct SliceFlipNormPermArgsGen_SwapXY {
   }
 };
 
+template <typename OutputType, int Dims = 3, bool MultiChannel = true>
+struct SliceFlipNormPermArgsGen_MirrorNormalize_PermuteHWC2CHW {
+  SliceFlipNormalizePermutePadArgs<Dims> Get(const TensorShape<Dims>& input_shape) {
+    SliceFlipNormalizePermutePadArgs<Dims> args(input_shape, input_shape);
+    static_assert(Dims == 3);
+    args.anchor[0] = 1;
+    args.shape[0] = input_shape[0] - 2;
+    args.flip[1] = true;
+    args.permuted_dims = {2, 0, 1};
+    if (MultiChannel) {
+      args.mean = {120.0f, 115.0f, 100.0f};
+      args.inv_stddev = {1 / 60.0f, 1 / 58.0f, 1 / 57.0f};
+      args.channel_dim = 2;
+    } else {
+      args.mean = {110.0f};
+      args.inv_stddev = {1 / 58.0f};
+    }
+    return args;
+  }
+};
+
 template <typename OutputType, int Dims = 3>
 struct SliceFlipNormPermArgsGen_FlipYZ_ChannelFirst {
   SliceFlipNormalizePermutePadArgs<Dims> Get(const TensorShape<Dims>& input_shape) {
@@ -542,7 +563,18 @@ using SLICE_FLIP_NORMALIZE_PERMUTE_TEST_TYPES_CPU_ONLY = ::testing::Types<
     SliceTestArgs<uint8_t, float16, 3, 1, 2,
       SliceFlipNormPermArgsGen_SliceOnly<float16, 3>>,
     SliceTestArgs<float16, uint8_t, 3, 1, 2,
-      SliceFlipNormPermArgsGen_SliceOnly<uint8_t, 3>>
+      SliceFlipNormPermArgsGen_SliceOnly<uint8_t, 3>>,
+    // interleaved 3-channel fast path: full blocks of 16 pixels and a remainder
+    SliceTestArgs<uint8_t, float, 3, 1, 3,
+      SliceFlipNormPermArgsGen_NormalizeOnly<float, 3>, 5, 37>,
+    SliceTestArgs<uint8_t, float16, 3, 1, 3,
+      SliceFlipNormPermArgsGen_NormalizeAndFlipDim<float16, 3, 1>, 5, 37>,
+    SliceTestArgs<uint8_t, float, 3, 1, 3,
+      SliceFlipNormPermArgsGen_MirrorNormalize_PermuteHWC2CHW<float, 3>, 6, 41>,
+    SliceTestArgs<uint8_t, float16, 3, 1, 3,
+      SliceFlipNormPermArgsGen_MirrorNormalize_PermuteHWC2CHW<float16, 3, false>, 6, 41>,
+    SliceTestArgs<uint8_t, float, 3, 1, 3,
+      SliceFlipNormPermArgsGen_SliceFlipNormalizePermute_PermuteHWC2CHW<float, 3>, 10, 70>
 >;
 
 }  // namespace kernels
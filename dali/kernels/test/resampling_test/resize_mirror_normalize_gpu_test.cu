@@ -0,0 +1,151 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/imgproc/resample/resize_mirror_normalize_gpu.cuh"
+#include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
+
+namespace dali {
+namespace kernels {
+namespace resample_test {
+
+namespace {
+
+/**
+ * @brief Bilinear resize of the ROI, followed by flip, normalization, padding and transposition
+ */
+template <typename In>
+void RefResizeMirrorNormalize(float *out, const In *in, TensorShape<3> in_shape,
+                              const ResizeMirrorNormalizeArgs &args) {
+  int H = in_shape[0], W = in_shape[1], C = in_shape[2];
+  int out_w = args.out_size.x, out_h = args.out_size.y;
+  int out_c = std::max(args.out_channels, C);
+  float scale_x = (args.roi_hi.x - args.roi_lo.x) / out_w;
+  float scale_y = (args.roi_hi.y - args.roi_lo.y) / out_h;
+  for (int y = 0; y < out_h; y++) {
+    for (int x = 0; x < out_w; x++) {
+      int rx = args.mirror ? out_w - 1 - x : x;  // resized column that lands at x
+      float sx = args.roi_lo.x + (rx + 0.5f) * scale_x - 0.5f;
+      float sy = args.roi_lo.y + (y + 0.5f) * scale_y - 0.5f;
+      int x0 = std::floor(sx), y0 = std::floor(sy);
+      float qx = sx - x0, qy = sy - y0;
+      int xa = clamp(x0, 0, W - 1), xb = clamp(x0 + 1, 0, W - 1);
+      int ya = clamp(y0, 0, H - 1), yb = clamp(y0 + 1, 0, H - 1);
+      for (int c = 0; c < out_c; c++) {
+        float value = 0;
+        if (c < C) {
+          auto px = [&](int sy, int sx) { return static_cast<float>(in[(sy * W + sx) * C + c]); };
+          float top = px(ya, xa) + (px(ya, xb) - px(ya, xa)) * qx;
+          float bottom = px(yb, xa) + (px(yb, xb) - px(yb, xa)) * qx;
+          value = top + (bottom - top) * qy;
+          if (!args.mean.empty()) {
+            int idx = args.mean.size() > 1 ? c : 0;
+            value = (value - args.mean[idx]) * args.inv_stddev[idx];
+          }
+        } else {
+          value = args.fill_value;
+        }
+        int64_t idx = args.planar ? (c * out_h + y) * out_w + x : (y * out_w + x) * out_c + c;
+        out[idx] = value;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <typename Out>
+void TestResizeMirrorNormalize(bool planar, double eps) {
+  std::mt19937_64 rng(1234);
+  TensorListShape<3> in_shape = {{ 60, 80, 3 }, { 17, 33, 3 }, { 128, 96, 4 }, { 40, 40, 1 }};
+  int N = in_shape.num_samples();
+  TestTensorList<uint8_t, 3> in;
+  in.reshape(in_shape);
+  UniformRandomFill(in.cpu(), rng, 0, 255);
+
+  std::vector<ResizeMirrorNormalizeArgs> args(N);
+  for (int i = 0; i < N; i++) {
+    auto &a = args[i];
+    float W = in_shape[i][1], H = in_shape[i][0];
+    a.roi_lo = vec2(0.1f * W, 0.2f * H);
+    a.roi_hi = vec2(0.9f * W, 0.7f * H);
+    a.out_size = ivec2(40 + 3 * i, 32 + i);
+    a.mirror = i % 2 == 0;
+    a.planar = planar;
+    a.out_channels = i == 0 ? 4 : 0;  // pad one of the samples
+    if (in_shape[i][2] == 3) {
+      a.mean = { 124, 116, 104 };
+      a.inv_stddev = { 1 / 58.f, 1 / 57.f, 1 / 57.5f };
+    } else if (i != N - 1) {
+      a.mean = { 128 };
+      a.inv_stddev = { 1 / 64.f };
+    }
+  }
+
+  ResizeMirrorNormalizeGPU<Out, uint8_t> kernel;
+  KernelContext ctx;
+  ctx.gpu.stream = 0;
+  auto req = kernel.Setup(ctx, in_shape, make_cspan(args));
+  ASSERT_EQ(req.output_shapes.size(), 1u);
+  auto out_shape = req.output_shapes[0].template to_static<3>();
+  for (int i = 0; i < N; i++) {
+    int C = std::max<int>(args[i].out_channels, in_shape[i][2]);
+    TensorShape<3> expected = planar
+        ? TensorShape<3>{ C, args[i].out_size.y, args[i].out_size.x }
+        : TensorShape<3>{ args[i].out_size.y, args[i].out_size.x, C };
+    EXPECT_EQ(out_shape[i], expected);
+  }
+
+  TestTensorList<Out, 3> out;
+  out.reshape(out_shape);
+  {
+    DynamicScratchpad scratchpad({}, AccessOrder(ctx.gpu.stream));
+    ctx.scratchpad = &scratchpad;
+    kernel.Run(ctx, out.gpu(), in.gpu(), make_cspan(args));
+    CUDA_CALL(cudaStreamSynchronize(ctx.gpu.stream));
+    ctx.scratchpad = nullptr;
+  }
+
+  TestTensorList<float, 3> ref;
+  ref.reshape(out_shape);
+  auto in_cpu = in.cpu();
+  auto ref_cpu = ref.cpu();
+  for (int i = 0; i < N; i++)
+    RefResizeMirrorNormalize(ref_cpu.tensor_data(i), in_cpu.tensor_data(i), in_shape[i],
+                             args[i]);
+  Check(out.cpu(), ref_cpu, EqualEps(eps));
+}
+
+TEST(ResizeMirrorNormalizeGPU, PlanarFloat) {
+  TestResizeMirrorNormalize<float>(true, 1e-3);
+}
+
+TEST(ResizeMirrorNormalizeGPU, InterleavedFloat) {
+  TestResizeMirrorNormalize<float>(false, 1e-3);
+}
+
+TEST(ResizeMirrorNormalizeGPU, PlanarHalf) {
+  // values are up to ~255 for the non-normalized sample - float16 has ~3 significant digits
+  TestResizeMirrorNormalize<float16>(true, 0.15);
+}
+
+}  // namespace resample_test
+}  // namespace kernels
+}  // namespace dali
@@ -14,8 +14,10 @@
 
 #include <gtest/gtest.h>
 #include <opencv2/imgcodecs.hpp>
+#include <random>
 #include "dali/kernels/test/test_data.h"
 #include "dali/test/tensor_test_utils.h"
+#include "dali/test/test_tensors.h"
 #include "dali/kernels/test/resampling_test/resampling_test_params.h"
 #include "dali/kernels/imgproc/resample/separable_cpu.h"
 #include "dali/kernels/imgproc/resample_cpu.h"
@@ -107,7 +109,7 @@ static std::vector<ResamplingTestEntry> ResampleTests = {
   },
   {
     "imgproc/dots.png", "imgproc/blobs.png",
-    { 300, 300 }, lin(), 0
+    { 300, 300 }, lin(), 1
   },
   {
     "imgproc/alley.png", "imgproc/ref/resampling/alley_tri_300x300.png",
@@ -150,6 +152,56 @@ static std::vector<ResamplingTestEntry> CropResampleTests = {
   },
 };
 
+/**
+ * @brief Checks that the fixed-point uint8 resampling is within 1 from the float one
+ */
+TEST(SeparableResampleCPU, FixedPointMatchesFloat) {
+  TestTensorList<uint8_t, 3> input;
+  input.reshape(uniform_list_shape<3>(1, { 99, 131, 3 }));
+  std::mt19937_64 rng(1234);
+  UniformRandomFill(input.cpu(), rng, 0, 255);
+  auto in_tensor = input.cpu()[0];
+
+  for (FilterDesc filter : { lin(), tri(), cubic(), lanczos(), gauss(3) }) {
+    for (auto out_size : { TensorShape<2>(37, 250), TensorShape<2>(200, 64) }) {
+      ResamplingParams2D params;
+      for (int d = 0; d < 2; d++) {
+        params[d].output_size = out_size[d];
+        params[d].min_filter = params[d].mag_filter = filter;
+      }
+      // a flipped ROI in one of the dimensions
+      params[1].roi = ResamplingParams::ROI(120.5f, 3.0f);
+
+      SeparableResampleCPU<uint8_t, uint8_t, 2> fixed;
+      SeparableResampleCPU<float, uint8_t, 2> flt;
+      TestTensorList<uint8_t, 3> fixed_out, ref_out;
+      TestTensorList<float, 3> flt_out;
+      for (bool is_fixed : { true, false }) {
+        KernelContext context;
+        ScratchpadAllocator scratch_alloc;
+        auto req = is_fixed ? fixed.Setup(context, in_tensor, params)
+                            : flt.Setup(context, in_tensor, params);
+        scratch_alloc.Reserve(req.scratch_sizes);
+        auto scratchpad = scratch_alloc.GetScratchpad();
+        context.scratchpad = &scratchpad;
+        if (is_fixed) {
+          fixed_out.reshape(req.output_shapes[0].to_static<3>());
+          fixed.Run(context, fixed_out.cpu()[0], in_tensor, params);
+        } else {
+          flt_out.reshape(req.output_shapes[0].to_static<3>());
+          flt.Run(context, flt_out.cpu()[0], in_tensor, params);
+        }
+      }
+      ref_out.reshape(flt_out.cpu().shape);
+      auto flt_view = flt_out.cpu()[0];
+      auto ref_view = ref_out.cpu()[0];
+      for (int64_t i = 0; i < flt_view.num_elements(); i++)
+        ref_view.data[i] = ConvertSat<uint8_t>(flt_view.data[i]);
+      Check(fixed_out.cpu()[0], ref_view, EqualEps(1));
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(Basic, ResamplingTestCPU, ::testing::ValuesIn(ResampleTests));
 INSTANTIATE_TEST_SUITE_P(Crop , ResamplingTestCPU, ::testing::ValuesIn(CropResampleTests));
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
 #include <cuda_runtime.h>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
+#include <algorithm>
 #include <random>
 #include "dali/kernels/imgproc/resample/separable.h"
 #include "dali/test/test_tensors.h"
@@ -113,7 +114,7 @@ void TestSetup() {
     }
   }
   for (int pass = 0; pass < spatial_ndim; pass++) {
-    EXPECT_GE(resampling.setup.total_blocks[pass], N);
+    EXPECT_GE(resampling.setup.total_blocks[pass] + resampling.setup.fused_blocks, N);
   }
 }
 
@@ -125,6 +126,207 @@ TEST(SeparableImpl, Setup3D) {
   TestSetup<3>();
 }
 
+/**
+ * @brief Checks that the samples resampled in a single pass match the ones resampled
+ *        through the intermediate buffer
+ */
+TEST(SeparableImpl, FusedPass) {
+  std::vector<TensorShape<3>> shapes = {
+    { 480, 640, 3 }, { 1080, 1920, 3 }, { 300, 200, 1 }, { 250, 500, 4 }, { 100, 80, 3 }
+  };
+  int N = shapes.size();
+  std::vector<ResamplingParams2D> params(N);
+  for (int i = 0; i < N; i++) {
+    for (int d = 0; d < 2; d++) {
+      params[i][d].output_size = 224;
+      params[i][d].min_filter.type = ResamplingFilterType::Triangular;
+      params[i][d].mag_filter.type = ResamplingFilterType::Cubic;
+    }
+  }
+  // flipped ROI
+  params[2][0].roi = ResamplingParams::ROI(250, 10);
+  params[2][1].roi = ResamplingParams::ROI(20, 180);
+
+  TestTensorList<uint8_t, 3> input;
+  input.reshape(shapes);
+  std::mt19937_64 rng(1234);
+  UniformRandomFill(input.cpu(), rng, 0, 255);
+  auto in_tlv = input.gpu();
+
+  SeparableResamplingGPUImpl<float, uint8_t, 2> fused, separate;
+  separate.setup.fuse_passes = false;
+
+  TestTensorList<float, 3> fused_out, separate_out;
+  for (auto *impl : { &fused, &separate }) {
+    KernelContext ctx;
+    ctx.gpu.stream = 0;
+    auto req = impl->Setup(ctx, in_tlv, make_span(params));
+    ScratchpadAllocator scratch_alloc;
+    scratch_alloc.Reserve(req.scratch_sizes);
+    auto scratchpad = scratch_alloc.GetScratchpad();
+    ctx.scratchpad = &scratchpad;
+    auto &out = impl == &fused ? fused_out : separate_out;
+    out.reshape(req.output_shapes[0].to_static<3>());
+    impl->Run(ctx, out.gpu(), in_tlv, make_span(params));
+  }
+  CUDA_CALL(cudaDeviceSynchronize());
+
+  EXPECT_GT(fused.setup.fused_blocks, 0);
+  EXPECT_EQ(separate.setup.fused_blocks, 0);
+  for (int i = 0; i < N; i++)
+    EXPECT_GT(fused.setup.sample_descs[i].fused_tile_rows, 0) << "sample " << i;
+
+  // the order of the separate passes may be different, hence the tolerance
+  Check(fused_out.cpu(), separate_out.cpu(), EqualEpsRel(1e-3, 1e-4));
+}
+
+TEST(SeparableImpl, StaticSupport) {
+  std::vector<TensorShape<3>> shapes = {
+    { 100, 80, 3 }, { 120, 90, 1 }, { 150, 200, 4 }, { 300, 400, 3 }, { 100, 80, 2 }
+  };
+  int N = shapes.size();
+  std::vector<ResamplingParams2D> params(N);
+  for (int i = 0; i < N; i++) {
+    for (int d = 0; d < 2; d++) {
+      params[i][d].output_size = 224;
+      params[i][d].min_filter.type = ResamplingFilterType::Triangular;
+      params[i][d].mag_filter.type = i == 1 ? ResamplingFilterType::Lanczos3
+                                            : ResamplingFilterType::Cubic;
+    }
+  }
+  // flipped ROI
+  params[2][0].roi = ResamplingParams::ROI(190, 10);
+
+  TestTensorList<uint8_t, 3> input;
+  input.reshape(shapes);
+  std::mt19937_64 rng(1234);
+  UniformRandomFill(input.cpu(), rng, 0, 255);
+  auto in_tlv = input.gpu();
+
+  SeparableResamplingGPUImpl<float, uint8_t, 2> specialized, generic;
+  specialized.setup.fuse_passes = false;
+  generic.setup.fuse_passes = false;
+  generic.setup.static_support_kernels = false;
+
+  TestTensorList<float, 3> specialized_out, generic_out;
+  for (auto *impl : { &specialized, &generic }) {
+    KernelContext ctx;
+    ctx.gpu.stream = 0;
+    auto req = impl->Setup(ctx, in_tlv, make_span(params));
+    ScratchpadAllocator scratch_alloc;
+    scratch_alloc.Reserve(req.scratch_sizes);
+    auto scratchpad = scratch_alloc.GetScratchpad();
+    ctx.scratchpad = &scratchpad;
+    auto &out = impl == &specialized ? specialized_out : generic_out;
+    out.reshape(req.output_shapes[0].to_static<3>());
+    impl->Run(ctx, out.gpu(), in_tlv, make_span(params));
+  }
+  CUDA_CALL(cudaDeviceSynchronize());
+
+  for (int i = 0; i < N; i++) {
+    for (int axis = 0; axis < 2; axis++) {
+      EXPECT_EQ(generic.setup.sample_descs[i].static_support[axis], 0);
+      int support = specialized.setup.sample_descs[i].static_support[axis];
+      if (i < 3)  // upscaled with cubic or Lanczos3 filter
+        EXPECT_GT(support, 0) << "sample " << i << " axis " << axis;
+      else if (i == 4)  // 2 channels
+        EXPECT_EQ(support, 0) << "sample " << i << " axis " << axis;
+      if (support > 0)
+        EXPECT_EQ(support, specialized.setup.sample_descs[i].filter[axis].support());
+    }
+  }
+
+  // the specialized kernels compute the same sums in the same order
+  Check(specialized_out.cpu(), generic_out.cpu(), EqualEpsRel(1e-5, 1e-6));
+}
+
+/**
+ * @brief Checks that the frames stacked in one sample are resampled like separate samples
+ */
+TEST(SeparableImpl, FrameStacks) {
+  std::vector<TensorShape<3>> frame_shapes = {
+    { 100, 80, 3 }, { 120, 90, 1 }, { 150, 200, 4 }, { 60, 50, 3 }
+  };
+  std::vector<int> num_frames = { 4, 1, 3, 2 };
+  int N = frame_shapes.size();
+  std::vector<ResamplingParams2D> params(N);
+  for (int i = 0; i < N; i++) {
+    for (int d = 0; d < 2; d++) {
+      params[i][d].output_size = i == 3 ? 30 : 112;
+      params[i][d].min_filter.type = ResamplingFilterType::Triangular;
+      params[i][d].mag_filter.type = ResamplingFilterType::Linear;
+    }
+  }
+  // flipped ROI
+  params[2][0].roi = ResamplingParams::ROI(140, 10);
+
+  std::vector<TensorShape<3>> stack_shapes, single_shapes;
+  std::vector<ResamplingParams2D> single_params;
+  for (int i = 0; i < N; i++) {
+    TensorShape<3> stack_shape = frame_shapes[i];
+    stack_shape[0] *= num_frames[i];
+    stack_shapes.push_back(stack_shape);
+    for (int f = 0; f < num_frames[i]; f++) {
+      single_shapes.push_back(frame_shapes[i]);
+      single_params.push_back(params[i]);
+    }
+  }
+
+  TestTensorList<uint8_t, 3> stacks, singles;
+  stacks.reshape(stack_shapes);
+  singles.reshape(single_shapes);
+  std::mt19937_64 rng(1234);
+  UniformRandomFill(stacks.cpu(), rng, 0, 255);
+  // the frames are contiguous in both lists
+  auto stacks_cpu = stacks.cpu();
+  auto singles_cpu = singles.cpu();
+  for (int i = 0, j = 0; i < N; i++) {
+    for (int f = 0; f < num_frames[i]; f++, j++) {
+      auto frame_volume = volume(frame_shapes[i]);
+      std::copy(stacks_cpu.data[i] + f * frame_volume,
+                stacks_cpu.data[i] + (f + 1) * frame_volume,
+                singles_cpu.data[j]);
+    }
+  }
+
+  for (bool fuse_passes : { true, false }) {
+    SeparableResamplingGPUImpl<float, uint8_t, 2> stacked, separate;
+    stacked.setup.fuse_passes = fuse_passes;
+    separate.setup.fuse_passes = fuse_passes;
+
+    TestTensorList<float, 3> stacked_out, separate_out;
+    auto run = [](auto &impl, auto &out, auto in_tlv, auto params, span<const int> frames) {
+      KernelContext ctx;
+      ctx.gpu.stream = 0;
+      auto req = impl.Setup(ctx, in_tlv, params, frames);
+      ScratchpadAllocator scratch_alloc;
+      scratch_alloc.Reserve(req.scratch_sizes);
+      auto scratchpad = scratch_alloc.GetScratchpad();
+      ctx.scratchpad = &scratchpad;
+      out.reshape(req.output_shapes[0].template to_static<3>());
+      impl.Run(ctx, out.gpu(), in_tlv, params);
+    };
+    run(stacked, stacked_out, stacks.gpu(), make_cspan(params), make_cspan(num_frames));
+    run(separate, separate_out, singles.gpu(), make_cspan(single_params), {});
+    CUDA_CALL(cudaDeviceSynchronize());
+
+    EXPECT_EQ(stacked.setup.max_frames, 4);
+    auto stacked_cpu = stacked_out.cpu();
+    auto separate_cpu = separate_out.cpu();
+    for (int i = 0, j = 0; i < N; i++) {
+      EXPECT_EQ(stacked.setup.sample_descs[i].num_frames, num_frames[i]);
+      for (int f = 0; f < num_frames[i]; f++, j++) {
+        auto frame_shape = separate_cpu.shape[j];
+        auto stacked_frame = make_tensor_cpu<3>(
+            stacked_cpu.data[i] + f * volume(frame_shape), frame_shape);
+        ASSERT_EQ(stacked_cpu.shape[i][0], frame_shape[0] * num_frames[i]);
+        ASSERT_NO_FATAL_FAILURE(Check(stacked_frame, separate_cpu[j], EqualEpsRel(1e-6, 1e-6)))
+          << "sample " << i << " frame " << f << " fuse_passes " << fuse_passes;
+      }
+    }
+  }
+}
+
 ResamplingTestBatch SingleImageBatch = {
   {
     "imgproc/alley.png", "imgproc/ref/resampling/alley_tri_300x300.png",
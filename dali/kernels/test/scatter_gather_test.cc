@@ -167,7 +167,16 @@ TYPED_TEST_P(ScatterGatherTest, CopySmallChunks) {
   this->CopyTestImpl(1 << 20, 1024, 1024);
 }
 
-REGISTER_TYPED_TEST_SUITE_P(ScatterGatherTest, CopyLargeChunks, CopySmallChunks);
+TYPED_TEST_P(ScatterGatherTest, CopyTinyChunks) {
+  this->CopyTestImpl(1 << 16, 16, 65536);
+}
+
+TYPED_TEST_P(ScatterGatherTest, CopyMixedChunks) {
+  this->CopyTestImpl(1 << 20, 16384, 8192);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(ScatterGatherTest, CopyLargeChunks, CopySmallChunks, CopyTinyChunks,
+                            CopyMixedChunks);
 
 using ScatterGatherTypes = ::testing::Types<ScatterGatherCPU, ScatterGatherGPU>;
 INSTANTIATE_TYPED_TEST_SUITE_P(ScatterGatherSuite, ScatterGatherTest, ScatterGatherTypes);
@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,7 +21,7 @@ namespace kernels {
 namespace simd {
 namespace test {
 
-#ifdef __SSE2__
+#ifdef DALI_SIMD_FLOAT4
 
 template <typename Out, int nvec = sizeof(float)/sizeof(Out)>
 void TestConvertStore(float4x<nvec> vec) {
@@ -29,22 +29,11 @@ void TestConvertStore(float4x<nvec> vec) {
   store_f(out, vec);
   float flt[nvec * 4];  // NOLINT
   for (int i = 0; i < nvec; i++)
-    _mm_storeu_ps(flt + i * 4, vec.v[i]);
+    store_f(flt + i * 4, float4x1{{ vec.v[i] }});
   for (int i = 0; i < nvec * 4; i++)
     EXPECT_EQ(out[i], ConvertSat<Out>(flt[i]));
 }
 
-template <typename Out, int nvec = sizeof(int32_t)/sizeof(Out)>
-void TestConvertStore(i128x<nvec> vec) {
-  Out out[nvec * 4];  // NOLINT
-  store_i32(out, vec);
-  int32_t i32[nvec * 4];  // NOLINT
-  for (int i = 0; i < nvec; i++)
-    _mm_storeu_si128(reinterpret_cast<__m128i*>(i32 + i * 4), vec.v[i]);
-  for (int i = 0; i < nvec * 4; i++)
-    EXPECT_EQ(out[i], ConvertSat<Out>(i32[i]));
-}
-
 template <typename In, int nvec = sizeof(float)/sizeof(In)>
 void TestConvertLoad(In lo, In hi) {
   int lanes = 16 / sizeof(In);
@@ -56,7 +45,7 @@ void TestConvertLoad(In lo, In hi) {
   float4x<nvec> v = load_f(in);
   for (int i = 0; i < nvec; i++) {
     float tmp[4];
-    _mm_storeu_ps(tmp, v.v[i]);
+    store_f(tmp, float4x1{{ v.v[i] }});
     for (int j = 0; j < 4; j++) {
       float ref = in[4*i + j];
       EXPECT_EQ(tmp[j], ref);
@@ -79,11 +68,68 @@ float4x<n> make_vec_f(float min, float max) {
       tmp[j] = value;
       value += delta;
     }
-    out.v[i] = _mm_loadu_ps(tmp);
+    out.v[i] = load_f(tmp).v[0];
   }
   return out;
 }
 
+TEST(SIMDTest, ConvertStore) {
+  TestConvertStore<int8_t>(make_vec_f<4>(-128, 127));
+  TestConvertStore<uint8_t>(make_vec_f<4>(0, 255));
+  TestConvertStore<int16_t>(make_vec_f<2>(-32768, 32767));
+  TestConvertStore<uint16_t>(make_vec_f<2>(0, 65535));
+  TestConvertStore<int32_t>(make_vec_f<1>(-1000000, 1000000));
+  TestConvertStore<int32_t>(make_vec_f<1>(-2.5e+9, 2.5e+9));
+}
+
+TEST(SIMDTest, ConvertLoad) {
+  TestConvertLoad<int8_t>(-128, 127);
+  TestConvertLoad<int16_t>(-32768, 32767);
+  TestConvertLoad<uint8_t>(0, 255);
+  TestConvertLoad<uint16_t>(0, 65535);
+  TestConvertLoad<int32_t>(-1000000000, 1000000000);
+}
+
+TEST(SIMDTest, MultiplyAdd) {
+  float a[4] = { 1, 2, 3, 4 }, b[4] = { 0.5f, -1, 2, 0 }, out[4];  // NOLINT
+  float4_t acc = set1_f(10);
+  acc = madd(acc, load_f(a).v[0], load_f(b).v[0]);
+  acc = madd(acc, set1_f(2), load_f(a).v[0]);
+  store_f(out, float4x1{{ acc }});
+  for (int i = 0; i < 4; i++)
+    EXPECT_EQ(out[i], 10 + a[i] * b[i] + 2 * a[i]);
+}
+
+TEST(SIMDTest, SubtractMultiply) {
+  float a[4] = { 1, 2, 3, 4 }, b[4] = { 0.5f, -1, 2, 0 }, out[4];  // NOLINT
+  float4_t v = mul(sub(load_f(a).v[0], load_f(b).v[0]), set1_f(3));
+  store_f(out, float4x1{{ v }});
+  for (int i = 0; i < 4; i++)
+    EXPECT_EQ(out[i], (a[i] - b[i]) * 3);
+}
+
+TEST(SIMDTest, FixedPointMultiplyAdd) {
+  int16_t a[8] = { 255, -255, 1000, -1000, 32767, 0, 7, -32768 };  // NOLINT
+  int16_t b[8] = { 16384, 16384, -3000, 3000, 1, 100, -7, 2 };  // NOLINT
+  uint8_t u8[8] = { 0, 1, 2, 127, 128, 200, 254, 255 };  // NOLINT
+  i32x8 acc = zero_i32x8();
+  madd_i16(acc, load_i16(a), load_i16(b));
+  madd_i16(acc, load_i16(u8), set1_i16(64));
+  int16_t out16[8];  // NOLINT
+  uint8_t out8[8];  // NOLINT
+  store_shr<6>(out16, acc);
+  store_shr<14>(out8, acc);
+  for (int i = 0; i < 8; i++) {
+    int32_t ref = a[i] * b[i] + u8[i] * 64;
+    EXPECT_EQ(out16[i], ConvertSat<int16_t>((ref + 32) >> 6)) << "at " << i;
+    EXPECT_EQ(out8[i], ConvertSat<uint8_t>((ref + 8192) >> 14)) << "at " << i;
+  }
+}
+
+#endif  // DALI_SIMD_FLOAT4
+
+#ifdef __SSE2__
+
 template <int n>
 i128x<n> make_vec_i32(float min, float max) {
   float range = max - min;
@@ -104,14 +150,18 @@ i128x<n> make_vec_i32(float min, float max) {
   return out;
 }
 
-TEST(SSE2Test, ConvertStore) {
-  TestConvertStore<int8_t>(make_vec_f<4>(-128, 127));
-  TestConvertStore<uint8_t>(make_vec_f<4>(0, 255));
-  TestConvertStore<int16_t>(make_vec_f<2>(-32768, 32767));
-  TestConvertStore<uint16_t>(make_vec_f<2>(0, 65535));
-  TestConvertStore<int32_t>(make_vec_f<1>(-1000000, 1000000));
-  TestConvertStore<int32_t>(make_vec_f<1>(-2.5e+9, 2.5e+9));
+template <typename Out, int nvec = sizeof(int32_t)/sizeof(Out)>
+void TestConvertStore(i128x<nvec> vec) {
+  Out out[nvec * 4];  // NOLINT
+  store_i32(out, vec);
+  int32_t i32[nvec * 4];  // NOLINT
+  for (int i = 0; i < nvec; i++)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(i32 + i * 4), vec.v[i]);
+  for (int i = 0; i < nvec * 4; i++)
+    EXPECT_EQ(out[i], ConvertSat<Out>(i32[i]));
+}
 
+TEST(SSE2Test, ConvertStoreI32) {
   TestConvertStore<int8_t>(make_vec_i32<4>(-128, 127));
   TestConvertStore<uint8_t>(make_vec_i32<4>(0, 255));
   TestConvertStore<int16_t>(make_vec_i32<2>(-32768, 32767));
@@ -119,14 +169,6 @@ TEST(SSE2Test, ConvertStore) {
   TestConvertStore<int32_t>(make_vec_i32<1>(-1000000, 1000000));
 }
 
-TEST(SSE2Test, ConvertLoad) {
-  TestConvertLoad<int8_t>(-128, 127);
-  TestConvertLoad<int16_t>(-32768, 32767);
-  TestConvertLoad<uint8_t>(0, 255);
-  TestConvertLoad<uint16_t>(0, 65535);
-  TestConvertLoad<int32_t>(-1000000000, 1000000000);
-}
-
 #endif  // __SSE2__
 
 }  // namespace test
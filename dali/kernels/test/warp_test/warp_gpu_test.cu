@@ -15,6 +15,7 @@
 #include <gtest/gtest.h>
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc.hpp>
+#include <random>
 #include <string>
 #include <vector>
 #include "dali/kernels/imgproc/warp_gpu.h"
@@ -24,6 +25,7 @@
 #include "dali/test/mat2tensor.h"
 #include "dali/test/test_tensors.h"
 #include "dali/kernels/scratch.h"
+#include "dali/kernels/dynamic_scratchpad.h"
 #include "dali/core/mm/memory.h"
 #include "dali/test/dali_test_config.h"
 #include "dali/core/geom/transform.h"
@@ -282,5 +284,77 @@ TEST(WarpGPU, Affine_RotateScale_Uniform) {
   }
 }
 
+/**
+ * @brief Warps many small images of different sizes with the persistent kernel and compares
+ *        the result with the regular, block-based, variable-size kernel.
+ */
+void WarpGPU_Affine_Persistent(warp::PersistentMode mode) {
+  const int samples = 300;
+  std::mt19937_64 rng(1234);
+  std::uniform_int_distribution<int> size_dist(8, 96);
+  std::uniform_real_distribution<float> angle_dist(-M_PI, M_PI);
+
+  TensorListShape<3> in_shape;
+  in_shape.resize(samples, 3);
+  std::vector<TensorShape<2>> out_shapes_hw(samples);
+  std::vector<AffineMapping2D> mapping_cpu(samples);
+  for (int i = 0; i < samples; i++) {
+    in_shape.set_tensor_shape(i, { size_dist(rng), size_dist(rng), 3 });
+    out_shapes_hw[i] = { size_dist(rng), size_dist(rng) };
+    vec2 in_center(in_shape[i][1] * 0.5f, in_shape[i][0] * 0.5f);
+    vec2 out_center(out_shapes_hw[i][1] * 0.5f, out_shapes_hw[i][0] * 0.5f);
+    auto tr = translation(in_center) * rotation2D(angle_dist(rng)) * translation(-out_center);
+    mapping_cpu[i] = sub<2, 3>(tr, 0, 0);
+  }
+
+  TestTensorList<uint8_t, 3> in;
+  in.reshape(in_shape);
+  UniformRandomFill(in.cpu(), rng, 0, 255);
+  auto in_list = in.gpu();
+
+  auto mapping_gpu = mm::alloc_raw_unique<AffineMapping2D, mm::memory_kind::device>(samples);
+  auto mappings = make_tensor_gpu<1>(mapping_gpu.get(), { samples });
+  copy(mappings, make_tensor_cpu<1>(mapping_cpu.data(), { samples }));
+
+  DALIInterpType interp[2] = { DALI_INTERP_NN, DALI_INTERP_LINEAR };
+  std::vector<DALIInterpType> interps(samples);
+  for (int i = 0; i < samples; i++)
+    interps[i] = interp[i % 2];
+
+  auto run = [&](warp::PersistentMode m, TestTensorList<uint8_t, 3> &out, bool &persistent) {
+    WarpGPU<AffineMapping2D, 2, uint8_t, uint8_t, uint8_t> warp;
+    warp.SetPersistentMode(m);
+    KernelContext ctx = {};
+    ctx.gpu.stream = 0;
+    auto req = warp.Setup(ctx, in_list, mappings, make_span(out_shapes_hw),
+                          make_span(interps), 42);
+    persistent = WarpPrivateTest::GetSetup(warp).IsPersistent();
+    out.reshape(req.output_shapes[0].to_static<3>());
+    DynamicScratchpad scratchpad({}, AccessOrder(ctx.gpu.stream));
+    ctx.scratchpad = &scratchpad;
+    warp.Run(ctx, out.gpu(), in_list, mappings, make_span(out_shapes_hw),
+             make_span(interps), 42);
+  };
+
+  TestTensorList<uint8_t, 3> out, ref;
+  bool persistent = false, ref_persistent = true;
+  run(mode, out, persistent);
+  run(warp::PersistentMode::Never, ref, ref_persistent);
+  EXPECT_TRUE(persistent);
+  EXPECT_FALSE(ref_persistent);
+  auto out_cpu = out.cpu();
+  auto ref_cpu = ref.cpu();
+  CUDA_CALL(cudaDeviceSynchronize());
+  Check(out_cpu, ref_cpu);
+}
+
+TEST(WarpGPU, Affine_Persistent_Auto) {
+  WarpGPU_Affine_Persistent(warp::PersistentMode::Auto);
+}
+
+TEST(WarpGPU, Affine_Persistent_Always) {
+  WarpGPU_Affine_Persistent(warp::PersistentMode::Always);
+}
+
 }  // namespace kernels
 }  // namespace dali
@@ -15,12 +15,18 @@
 #ifndef DALI_KERNELS_TRANSPOSE_TRANSPOSE_H_
 #define DALI_KERNELS_TRANSPOSE_TRANSPOSE_H_
 
+#include <algorithm>
+#include <cstring>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "dali/core/exec/engine.h"
+#include "dali/core/force_inline.h"
+#include "dali/core/math_util.h"
 #include "dali/core/static_switch.h"
 #include "dali/core/tensor_view.h"
+#include "dali/kernels/common/simd.h"
 #include "dali/kernels/common/utils.h"
 #include "dali/kernels/transpose/transpose_util.h"
 
@@ -111,6 +117,145 @@ void TransposeImpl(T *dst, const T *src, int level, int max_levels, span<const i
   }
 }
 
+template <int size>
+struct simd_transpose_element;
+
+template <>
+struct simd_transpose_element<1> { using type = uint8_t; };
+
+template <>
+struct simd_transpose_element<2> { using type = uint16_t; };
+
+template <>
+struct simd_transpose_element<4> { using type = uint32_t; };
+
+/**
+ * @brief Whether an 8x8 block of T can be transposed with simd::transpose8x8
+ */
+template <typename T>
+struct has_simd_transpose : std::integral_constant<bool,
+#ifdef DALI_SIMD_FLOAT4
+    sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4
+#else
+    false
+#endif
+    > {};  // NOLINT
+
+template <typename T>
+DALI_FORCEINLINE void TransposeBlock8(T *out, int64_t out_stride,
+                                      const T *in, int64_t in_stride, std::false_type) {
+  for (int j = 0; j < 8; j++)
+    for (int i = 0; i < 8; i++)
+      out[j * out_stride + i] = in[i * in_stride + j];
+}
+
+template <typename T>
+DALI_FORCEINLINE void TransposeBlock8(T *out, int64_t out_stride,
+                                      const T *in, int64_t in_stride, std::true_type) {
+#ifdef DALI_SIMD_FLOAT4
+  using U = typename simd_transpose_element<sizeof(T)>::type;
+  simd::transpose8x8(reinterpret_cast<U *>(out), out_stride,
+                     reinterpret_cast<const U *>(in), in_stride);
+#endif
+}
+
+/**
+ * @brief Transposes a `rows` x `cols` matrix with contiguous rows
+ *
+ * `out[j * out_stride + i] = in[i * in_stride + j]`
+ *
+ * The matrix is processed in cache-sized tiles, which are further split into 8x8 blocks,
+ * transposed in registers when possible (see has_simd_transpose).
+ */
+template <typename T>
+void Transpose2D(T *out, int64_t out_stride, const T *in, int64_t in_stride,
+                 int64_t rows, int64_t cols) {
+  constexpr int64_t kTile = sizeof(T) <= 4 ? 64 : 32;
+  for (int64_t i0 = 0; i0 < rows; i0 += kTile) {
+    int64_t i1 = std::min(i0 + kTile, rows);
+    for (int64_t j0 = 0; j0 < cols; j0 += kTile) {
+      int64_t j1 = std::min(j0 + kTile, cols);
+      int64_t i = i0;
+      for (; i + 8 <= i1; i += 8) {
+        int64_t j = j0;
+        for (; j + 8 <= j1; j += 8)
+          TransposeBlock8(out + j * out_stride + i, out_stride, in + i * in_stride + j, in_stride,
+                          has_simd_transpose<T>());
+        for (; j < j1; j++)
+          for (int64_t k = i; k < i + 8; k++)
+            out[j * out_stride + k] = in[k * in_stride + j];
+      }
+      for (int64_t j = j0; j < j1; j++)
+        for (int64_t k = i; k < i1; k++)
+          out[j * out_stride + k] = in[k * in_stride + j];
+    }
+  }
+}
+
+/**
+ * @brief Calls `leaf(dst, src)` for every position in the dimensions listed in `dims`
+ */
+template <typename T, typename Leaf>
+void ForEachOuterPosition(T *dst, const T *src, const int *dims, int ndims,
+                          const int64_t *size, const int64_t *dst_stride,
+                          const int64_t *src_stride, Leaf &leaf) {
+  if (ndims == 0) {
+    leaf(dst, src);
+    return;
+  }
+  int d = dims[0];
+  for (int64_t i = 0; i < size[d]; i++) {
+    ForEachOuterPosition(dst, src, dims + 1, ndims - 1, size, dst_stride, src_stride, leaf);
+    dst += dst_stride[d];
+    src += src_stride[d];
+  }
+}
+
+/**
+ * @brief Transposes a (possibly partial) tensor described by destination-ordered extents
+ *        and strides
+ *
+ * The `src_stride[i]` is the source stride of the destination dimension `i`. The innermost
+ * destination dimension must be dense (`dst_stride[ndim - 1] == 1`) and so must be one
+ * of the source dimensions.
+ *
+ * If the innermost dimension is dense in the source as well, the rows are copied with memcpy.
+ * Otherwise, the destination dimension which is dense in the source and the innermost
+ * destination dimension form 2D planes, transposed with Transpose2D.
+ */
+template <typename T>
+void TransposeBlocked(T *dst, const T *src, int ndim, const int64_t *size,
+                      const int64_t *dst_stride, const int64_t *src_stride) {
+  assert(ndim > 0 && dst_stride[ndim - 1] == 1);
+  SmallVector<int, 6> outer;
+  if (src_stride[ndim - 1] == 1) {
+    for (int d = 0; d < ndim - 1; d++)
+      outer.push_back(d);
+    int64_t row_bytes = size[ndim - 1] * sizeof(T);
+    auto copy_row = [row_bytes](T *d, const T *s) {
+      std::memcpy(d, s, row_bytes);
+    };
+    ForEachOuterPosition(dst, src, outer.data(), outer.size(), size, dst_stride, src_stride,
+                         copy_row);
+    return;
+  }
+  int q = -1;
+  for (int d = 0; d < ndim - 1; d++) {
+    if (src_stride[d] == 1)
+      q = d;
+    else
+      outer.push_back(d);
+  }
+  assert(q >= 0 && "One of the dimensions must be dense in the source");
+  int64_t out_stride = dst_stride[q], in_stride = src_stride[ndim - 1];
+  int64_t rows = size[ndim - 1], cols = size[q];
+  auto transpose_plane = [=](T *d, const T *s) {
+    Transpose2D(d, out_stride, s, in_stride, rows, cols);
+  };
+  ForEachOuterPosition(dst, src, outer.data(), outer.size(), size, dst_stride, src_stride,
+                       transpose_plane);
+}
+
 }  // namespace transpose_impl
 
 /**
@@ -147,20 +292,76 @@ void Transpose(const TensorView<StorageCPU, T> &dst, const TensorView<StorageCPU
  * For example "HWC", perm = {2, 0, 1}; the "HW" would be collapsed to one dimension "X",
  * and effectively we will do XC -> CX transposition.
  *
+ * The 2D planes formed by the innermost destination dimension and the innermost source
+ * dimension are transposed in cache-sized tiles of 8x8 blocks, using SIMD for 1, 2 and 4-byte
+ * types. The work is split along the largest outer destination dimension into up to
+ * `engine.NumThreads()` blocks, which are scheduled with `engine.AddWork` - it's the caller's
+ * responsibility to call `engine.RunAll()`.
+ *
  * Source dimension `perm[i]` goes to destination dimension `i`.
  */
-template <typename T>
+template <typename T, typename ExecutionEngine>
 void TransposeGrouped(const TensorView<StorageCPU, T> &dst,
-                      const TensorView<StorageCPU, const T> &src, span<const int> perm) {
-  int N = src.shape.sample_dim();
-  auto src_shape = src.shape;
+                      const TensorView<StorageCPU, const T> &src, span<const int> perm,
+                      ExecutionEngine &engine) {
   TensorShape<> collapsed_src_shape;
   SmallVector<int, DynamicTensorShapeContainer::static_size> collapsed_perm;
   transpose_impl::SimplifyPermute(collapsed_src_shape, collapsed_perm, src.shape, perm);
-  auto collapsed_dst_shape = permute(collapsed_src_shape, collapsed_perm);
-  Transpose(TensorView<StorageCPU, T>{dst.data, collapsed_dst_shape},
-            TensorView<StorageCPU, const T>{src.data, collapsed_src_shape},
-            make_cspan(collapsed_perm));
+  int ndim = collapsed_src_shape.size();
+  T *dst_data = dst.data;
+  const T *src_data = src.data;
+  if (ndim == 0) {  // it's a scalar - just copy it
+    engine.AddWork([=](int) { *dst_data = *src_data; }, 1, false);
+    return;
+  }
+  auto size = permute(collapsed_src_shape, collapsed_perm);
+  auto dst_strides = GetStrides(size);
+  auto collapsed_src_strides = GetStrides(collapsed_src_shape);
+  TensorShape<> src_strides = size;
+  for (int d = 0; d < ndim; d++)
+    src_strides[d] = collapsed_src_strides[collapsed_perm[d]];
+
+  constexpr int64_t kMinBlockBytes = 1 << 18;
+  int64_t total = volume(size);
+  int split_dim = -1;
+  for (int d = 0; d < ndim - 1; d++)
+    if (split_dim < 0 || size[d] > size[split_dim])
+      split_dim = d;
+  int64_t num_blocks = 1;
+  if (split_dim >= 0) {
+    num_blocks = std::min<int64_t>(engine.NumThreads(), total * sizeof(T) / kMinBlockBytes);
+    num_blocks = clamp<int64_t>(num_blocks, 1, size[split_dim]);
+  }
+  for (int64_t b = 0; b < num_blocks; b++) {
+    auto block_size = size;
+    int64_t start = 0;
+    if (num_blocks > 1) {
+      // align the blocks to the 8x8 tiles, when possible
+      int64_t extent = size[split_dim];
+      int64_t align = extent >= 8 * num_blocks ? 8 : 1;
+      start = extent * b / num_blocks / align * align;
+      int64_t end = b == num_blocks - 1 ? extent : extent * (b + 1) / num_blocks / align * align;
+      block_size[split_dim] = end - start;
+    }
+    T *block_dst = dst_data + (num_blocks > 1 ? start * dst_strides[split_dim] : 0);
+    const T *block_src = src_data + (num_blocks > 1 ? start * src_strides[split_dim] : 0);
+    engine.AddWork([=](int) {
+      transpose_impl::TransposeBlocked(block_dst, block_src, ndim, block_size.data(),
+                                       dst_strides.data(), src_strides.data());
+    }, volume(block_size), false);
+  }
+}
+
+/**
+ * @brief Transpose `src` Tensor to `dst` wrt to permutation `perm`
+ *
+ * Single-threaded variant of TransposeGrouped.
+ */
+template <typename T>
+void TransposeGrouped(const TensorView<StorageCPU, T> &dst,
+                      const TensorView<StorageCPU, const T> &src, span<const int> perm) {
+  SequentialExecutionEngine engine;
+  TransposeGrouped(dst, src, perm, engine);
 }
 
 }  // namespace kernels
@@ -0,0 +1,133 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <random>
+#include <vector>
+#include "dali/kernels/transpose/transpose.h"
+#include "dali/kernels/transpose/transpose_test.h"
+
+namespace dali {
+namespace kernels {
+
+namespace {
+
+/**
+ * @brief Defers the work and runs it in the reverse order, so that the blocks are
+ *        not processed in the order of scheduling
+ */
+struct DeferredEngine {
+  void AddWork(std::function<void(int)> f, int64_t priority = 0, bool start_immediately = true) {
+    work.push_back(std::move(f));
+  }
+
+  void RunAll() {
+    for (int i = work.size() - 1; i >= 0; i--)
+      work[i](0);
+    work.clear();
+  }
+
+  int NumThreads() const noexcept { return 4; }
+
+  std::vector<std::function<void(int)>> work;
+};
+
+template <typename T, typename Engine>
+void CheckTransposeGrouped(const TensorShape<> &in_shape, span<const int> perm, Engine &engine,
+                           std::mt19937_64 &rng) {
+  int64_t n = volume(in_shape);
+  std::vector<T> in(n), out(n, T(0)), ref(n);
+  std::uniform_int_distribution<int> dist(0, 100);
+  for (auto &x : in)
+    x = static_cast<T>(dist(rng));
+  testing::RefTranspose(ref.data(), in.data(), in_shape.data(), perm.data(), in_shape.size());
+  auto out_shape = permute(in_shape, perm);
+  TransposeGrouped(TensorView<StorageCPU, T>{out.data(), out_shape},
+                   TensorView<StorageCPU, const T>{in.data(), in_shape}, perm, engine);
+  engine.RunAll();
+  for (int64_t i = 0; i < n; i++)
+    ASSERT_EQ(out[i], ref[i]) << "at " << i;
+}
+
+template <typename T, typename Engine>
+void TestTranspose4DAll(Engine &engine) {
+  std::mt19937_64 rng(1234);
+  std::uniform_int_distribution<int> shape_dist(1, 20);
+  for (auto &perm : testing::Permutations4) {
+    for (int iter = 0; iter < 3; iter++) {
+      TensorShape<> shape;
+      shape.resize(4);
+      for (int d = 0; d < 4; d++)
+        shape[d] = shape_dist(rng);
+      CheckTransposeGrouped<T>(shape, make_cspan(perm), engine, rng);
+    }
+  }
+}
+
+template <typename T, typename Engine>
+void TestTranspose2D(Engine &engine) {
+  std::mt19937_64 rng(4321);
+  int perm[] = { 1, 0 };
+  // the extents which are, and are not, multiples of the 8x8 blocks and the tiles
+  for (int64_t rows : { 1, 3, 8, 17, 64, 131, 1024 }) {
+    for (int64_t cols : { 1, 5, 8, 24, 65, 300 }) {
+      CheckTransposeGrouped<T>(TensorShape<>{rows, cols}, make_cspan(perm), engine, rng);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(TransposeCPU, Test4DAll) {
+  SequentialExecutionEngine engine;
+  TestTranspose4DAll<uint8_t>(engine);
+  TestTranspose4DAll<int16_t>(engine);
+  TestTranspose4DAll<float>(engine);
+  TestTranspose4DAll<double>(engine);
+}
+
+TEST(TransposeCPU, Test2D) {
+  SequentialExecutionEngine engine;
+  TestTranspose2D<uint8_t>(engine);
+  TestTranspose2D<uint16_t>(engine);
+  TestTranspose2D<int32_t>(engine);
+  TestTranspose2D<int64_t>(engine);
+  TestTranspose2D<int8_t>(engine);
+}
+
+TEST(TransposeCPU, ParallelBlocks) {
+  DeferredEngine engine;
+  std::mt19937_64 rng(42);
+  int perm_hwc2chw[] = { 2, 0, 1 };
+  CheckTransposeGrouped<uint8_t>(TensorShape<>{480, 640, 3}, make_cspan(perm_hwc2chw), engine,
+                                 rng);
+  int perm_chw2hwc[] = { 1, 2, 0 };
+  CheckTransposeGrouped<float>(TensorShape<>{3, 480, 640}, make_cspan(perm_chw2hwc), engine, rng);
+  int perm_2d[] = { 1, 0 };
+  CheckTransposeGrouped<uint16_t>(TensorShape<>{1001, 517}, make_cspan(perm_2d), engine, rng);
+  TestTranspose4DAll<uint8_t>(engine);
+}
+
+TEST(TransposeCPU, Scalar) {
+  SequentialExecutionEngine engine;
+  float in = 42, out = 0;
+  TransposeGrouped(TensorView<StorageCPU, float>{&out, TensorShape<>{}},
+                   TensorView<StorageCPU, const float>{&in, TensorShape<>{}},
+                   span<const int>{}, engine);
+  EXPECT_EQ(out, 42);
+}
+
+}  // namespace kernels
+}  // namespace dali
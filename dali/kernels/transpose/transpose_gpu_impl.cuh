@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
 #define DALI_KERNELS_TRANSPOSE_TRANSPOSE_GPU_IMPL_CUH_
 
 #include <cuda_runtime.h>
+#include <type_traits>
 #include "dali/core/tensor_view.h"
 #include "dali/core/fast_div.h"
 #include "dali/kernels/transpose/transpose_gpu_def.h"
@@ -45,6 +46,11 @@
  * are close together and all but the first "channel" should already be in the cache.
  * If the penultimate dimension has large enough extent, the reads should hit the cache and the
  * writes should be contiguous.
+ * When the whole transposition is a deinterleave of 2-4 channels of a 1- or 2-byte type
+ * (e.g. HWC -> CHW of an RGB image) and the data is suitably aligned, a thread processes
+ * a group of pixels which occupies a whole number of 32-bit words: the group is read with
+ * word loads, the channels are shuffled in registers and each output plane is stored with
+ * a single word store.
  *
  * Generic:
  * The input index is calculated from the output index by dividing the flattened output offset by
@@ -233,8 +239,77 @@ struct DeinterleaveDesc {
   int ndim;
 };
 
+/**
+ * @brief Deinterleaves a [pixels, lanes] array with 32-bit loads and stores
+ *
+ * Each thread reads `lanes` words, containing `pixels_per_word` consecutive pixels, and writes
+ * one word to each of the output planes.
+ *
+ * @remarks The caller must check that the input and output are 32-bit aligned and that
+ *          the number of pixels is divisible by `pixels_per_word`.
+ */
+template <int lanes, typename T>
+__device__ void TransposeDeinterleaveWords(const DeinterleaveDesc<T> &desc) {
+  using Word = type_of_size<4>;
+  constexpr int pixels_per_word = sizeof(Word) / sizeof(T);
+  static_assert(pixels_per_word * sizeof(T) == sizeof(Word), "Unsupported element size");
+
+  const uint64_t num_words = desc.size / lanes / pixels_per_word;  // per output plane
+  const uint64_t block_size = blockDim.x;
+  const uint64_t grid_stride = gridDim.x * block_size;
+
+  Word *out = reinterpret_cast<Word *>(desc.out);
+  const Word *in = reinterpret_cast<const Word *>(desc.in);
+
+  for (uint64_t idx = blockIdx.x * block_size + threadIdx.x; idx < num_words; idx += grid_stride) {
+    Word in_words[lanes];  // NOLINT
+    #pragma unroll
+    for (int i = 0; i < lanes; i++)
+      in_words[i] = __ldg(&in[idx * lanes + i]);
+    const T *in_elems = reinterpret_cast<const T *>(in_words);
+
+    #pragma unroll
+    for (int lane = 0; lane < lanes; lane++) {
+      Word out_word;
+      T *out_elems = reinterpret_cast<T *>(&out_word);
+      #pragma unroll
+      for (int p = 0; p < pixels_per_word; p++)
+        out_elems[p] = in_elems[p * lanes + lane];
+      out[lane * num_words + idx] = out_word;
+    }
+  }
+}
+
+/**
+ * @brief Runs TransposeDeinterleaveWords, if the sample is suitable for it
+ *
+ * @return true, if the sample was transposed
+ */
+template <typename T>
+__device__ bool TryTransposeDeinterleaveWords(const DeinterleaveDesc<T> &desc, std::true_type) {
+  constexpr int pixels_per_word = 4 / sizeof(T);
+  if (desc.ndim != 2)
+    return false;
+  int lanes = desc.in_strides[0];
+  if ((desc.size / lanes) % pixels_per_word != 0 ||
+      reinterpret_cast<uintptr_t>(desc.out) % 4 != 0 ||
+      reinterpret_cast<uintptr_t>(desc.in) % 4 != 0)
+    return false;
+  VALUE_SWITCH(lanes, static_lanes, (2, 3, 4),
+    (TransposeDeinterleaveWords<static_lanes>(desc); return true;),
+    (return false;));
+}
+
+template <typename T>
+__device__ bool TryTransposeDeinterleaveWords(const DeinterleaveDesc<T> &, std::false_type) {
+  return false;
+}
+
 template <typename T>
 __device__ void TransposeDeinterleave(const DeinterleaveDesc<T> &desc) {
+  if (TryTransposeDeinterleaveWords(desc, std::integral_constant<bool, (sizeof(T) < 4)>()))
+    return;
+
   const int tid = threadIdx.x;
 
   int ndim = desc.ndim;
@@ -338,6 +338,53 @@ TEST(TransposeDeinterleave, AllPerm4DInnermost) {
   }
 }
 
+template <typename T>
+void TestDeinterleaveSmallChannels(int H, int W, int channels, int offset) {
+  TensorShape<> shape = { H, W, channels };
+  int perm[] = { 2, 0, 1 };
+  TensorShape<> simple_shape;
+  SmallVector<int, 6> simple_perm;
+  SimplifyPermute(simple_shape, simple_perm, shape.data(), perm, 3);
+  ASSERT_EQ(simple_shape.size(), 2);
+  int size = volume(shape);
+  vector<T> in_cpu(size), out_cpu(size), ref(size);
+  for (int i = 0; i < size; i++)
+    in_cpu[i] = static_cast<T>(i * 7 + 3);
+  // allocate with some margin to test (mis)aligned pointers
+  DeviceBuffer<T> in_gpu, out_gpu;
+  in_gpu.resize(size + offset);
+  out_gpu.resize(size + offset);
+  copyH2D(in_gpu.data() + offset, in_cpu.data(), size);
+  CUDA_CALL(cudaMemset(out_gpu, 0xff, (size + offset) * sizeof(T)));
+
+  DeinterleaveDesc<T> desc;
+  memset(&desc, 0xCC, sizeof(desc));
+  InitDeinterleave(desc, simple_shape, make_span(simple_perm),
+                   out_gpu.data() + offset, in_gpu.data() + offset);
+  int block_size = 256;
+  int grid_size = std::max(1, size / (block_size * channels * 16));
+  TransposeDeinterleaveSingle<<<grid_size, block_size>>>(desc);
+  CUDA_CALL(cudaGetLastError());
+  copyD2H(out_cpu.data(), out_gpu.data() + offset, size);
+  testing::RefTranspose(ref.data(), in_cpu.data(), shape.data(), perm, 3);
+
+  for (int i = 0; i < size; i++) {
+    ASSERT_EQ(out_cpu[i], ref[i]) << " at " << i << " for shape " << shape
+                                  << " and offset " << offset;
+  }
+}
+
+TEST(TransposeDeinterleave, SmallChannels) {
+  for (int channels = 2; channels <= 5; channels++) {
+    for (int offset = 0; offset < 2; offset++) {
+      TestDeinterleaveSmallChannels<uint8_t>(123, 456, channels, offset);  // aligned plane
+      TestDeinterleaveSmallChannels<uint8_t>(123, 457, channels, offset);  // misaligned plane
+      TestDeinterleaveSmallChannels<uint16_t>(67, 90, channels, offset);
+      TestDeinterleaveSmallChannels<uint16_t>(67, 91, channels, offset);
+    }
+  }
+}
+
 TEST(TransposeGeneric, AllPerm4D) {
   TensorShape<> shape = { 31, 43, 53, 47 };
   int size = volume(shape);
@@ -15,6 +15,7 @@
 #include "dali/operators/audio/mel_scale/mel_filter_bank.h"
 #include "dali/core/static_switch.h"
 #include "dali/kernels/audio/mel_scale/mel_filter_bank_cpu.h"
+#include "dali/kernels/signal/decibel/decibel_calculator.h"
 #include "dali/pipeline/data/views.h"
 
 namespace dali {
@@ -25,6 +26,10 @@ triangular filters.
 
 The frequency ('f') dimension is selected from the input layout.
 In case of no layout, "f", "ft", or "\*ft" is assumed, depending on the number of dimensions.
+
+If ``to_decibels`` is set, the mel spectrogram is converted to the decibel scale
+(as with :meth:`nvidia.dali.fn.to_decibels`) while it's produced - on the GPU, the filter bank
+and the conversion run in a single kernel and the linear mel spectrogram is never stored.
 )code")
     .NumInput(kNumInputs)
     .NumOutput(kNumOutputs)
@@ -63,7 +68,24 @@ The supported values are:
     consistent with Librosa's default implementation.
 - | ``htk``, which follows O'Shaughnessy's book formula, ``m = 2595 * log10(1 + (f/700))``.
   | This value is consistent with the implementation of the Hidden Markov Toolkit (HTK).
-)code", "slaney");
+)code", "slaney")
+    .AddOptionalArg("to_decibels",
+      R"code(If set to True, the output is converted to the decibel scale::
+
+  min_ratio = pow(10, decibels_cutoff / decibels_multiplier)
+  out[i] = decibels_multiplier * log10(max(min_ratio, mel[i] / decibels_reference)))code",
+      false)
+    .AddOptionalArg("decibels_multiplier",
+      R"code(Factor by which the logarithm is multiplied when ``to_decibels`` is set.)code",
+      10.0f)
+    .AddOptionalArg("decibels_reference",
+      R"code(Reference magnitude used when ``to_decibels`` is set.)code",
+      1.0f)
+    .AddOptionalArg("decibels_cutoff",
+      R"code(Minimum or cut-off ratio in dB used when ``to_decibels`` is set.
+
+Any value below this value will saturate.)code",
+      -200.0f);
 
 template <>
 bool MelFilterBank<CPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
@@ -106,6 +128,13 @@ void MelFilterBank<CPUBackend>::RunImpl(workspace_t<CPUBackend> &ws) {
           auto in_view = view<const T>(input[i]);
           auto out_view = view<T>(output[i]);
           kmgr_.Run<MelFilterBankKernel>(i, ctx_, out_view, in_view);
+          if (to_decibels_) {
+            kernels::signal::MagnitudeToDecibel<T> dB(db_args_.multiplier, db_args_.s_ref,
+                                                      db_args_.min_ratio);
+            T *out = out_view.data;
+            for (int64_t j = 0, n = volume(out_view.shape); j < n; j++)
+              out[j] = dB(out[j]);
+          }
         }, in_shape.tensor_size(i));
     }
   ), DALI_FAIL(make_string("Unsupported data type: ", input.type())));  // NOLINT
@@ -21,6 +21,7 @@
 #include "dali/core/common.h"
 #include "dali/kernels/kernel_manager.h"
 #include "dali/kernels/audio/mel_scale/mel_filter_bank_args.h"
+#include "dali/kernels/signal/decibel/to_decibels_args.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/pipeline/operator/operator.h"
 
@@ -65,6 +66,15 @@ class MelFilterBank : public Operator<Backend> {
     }
 
     args_.normalize = spec.GetArgument<bool>("normalize");
+
+    to_decibels_ = spec.GetArgument<bool>("to_decibels");
+    db_args_.multiplier = spec.GetArgument<float>("decibels_multiplier");
+    db_args_.s_ref = spec.GetArgument<float>("decibels_reference");
+    DALI_ENFORCE(db_args_.s_ref > 0, "`decibels_reference` should be > 0");
+    auto cutoff_db = spec.GetArgument<float>("decibels_cutoff");
+    db_args_.min_ratio = std::pow(10.0f, cutoff_db / db_args_.multiplier);
+    if (db_args_.min_ratio == 0)
+      db_args_.min_ratio = std::nextafter(0.0f, 1.0f);
   }
 
  protected:
@@ -78,6 +88,8 @@ class MelFilterBank : public Operator<Backend> {
   kernels::KernelManager kmgr_;
   kernels::KernelContext ctx_;
   kernels::audio::MelFilterBankArgs args_;
+  bool to_decibels_ = false;
+  kernels::signal::ToDecibelsArgs<float> db_args_;
 };
 
 }  // namespace dali
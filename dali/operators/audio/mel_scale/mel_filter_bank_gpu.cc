@@ -52,7 +52,10 @@ void MelFilterBank<GPUBackend>::RunImpl(workspace_t<GPUBackend> &ws) {
     using MelFilterBankKernel = kernels::audio::MelFilterBankGpu<T>;
     auto in_view = view<const T>(input);
     auto out_view = view<T>(output);
-    kmgr_.Run<MelFilterBankKernel>(0, ctx_, out_view, in_view);
+    if (to_decibels_)
+      kmgr_.Run<MelFilterBankKernel>(0, ctx_, out_view, in_view, db_args_);
+    else
+      kmgr_.Run<MelFilterBankKernel>(0, ctx_, out_view, in_view);
   ), DALI_FAIL(make_string("Unsupported data type: ", input.type())));  // NOLINT
 }
 
@@ -0,0 +1,86 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_AUDIO_NONSILENCE_OP_GPU_CUH_
+#define DALI_OPERATORS_AUDIO_NONSILENCE_OP_GPU_CUH_
+
+#include "dali/kernels/reduce/find_region.cuh"
+#include "dali/kernels/reduce/reduce_gpu.h"
+#include "dali/operators/audio/nonsilence_op.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+namespace detail {
+
+/**
+ * @brief Threshold predicate for the nonsilent region.
+ */
+template <typename T>
+struct NotLess {
+  T value_;
+
+  DALI_HOST_DEV DALI_FORCEINLINE bool operator()(T x) const noexcept {
+    return x >= value_;
+  }
+};
+
+}  // namespace detail
+
+class NonsilenceOperatorGpu : public NonsilenceOperator<GPUBackend> {
+ public:
+  explicit NonsilenceOperatorGpu(const OpSpec &spec) :
+          NonsilenceOperator<GPUBackend>(spec) {}
+
+  ~NonsilenceOperatorGpu() override = default;
+  DISABLE_COPY_MOVE_ASSIGN(NonsilenceOperatorGpu);
+
+ protected:
+  void RunImpl(workspace_t<GPUBackend> &ws) override;
+
+  /**
+   * @brief Calculates the beginning and length of the nonsilent region
+   */
+  void CalcNonsilentRegion(TensorListView<StorageGPU, int32_t, 0> &begin,
+                           TensorListView<StorageGPU, int32_t, 0> &len,
+                           TensorListView<StorageGPU, float, 1> &mms,
+                           cudaStream_t stream);
+
+ private:
+  kernels::MaxGPU<float, float> max_kernel_;
+  using Predicate = detail::NotLess<float>;
+  kernels::FindRegionGPU<float, Predicate> find_region_;
+
+  /**
+   * @brief Computes mean moving mean square of an audio signal
+   */
+  template <typename T>
+  void CalcMMS(TensorListView<StorageGPU, float, 1> &mms,
+               const TensorListView<StorageGPU, const T, 1> &in,
+               cudaStream_t stream);
+
+  /**
+   * @brief Calculates the maximum value of an input
+   */
+  void CalcMax(TensorListView<StorageGPU, float, 0> &max,
+               const TensorListView<StorageGPU, float, 1> &in,
+               cudaStream_t stream);
+
+  template <typename T>
+  void RunImplTyped(workspace_t<GPUBackend> &ws);
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_AUDIO_NONSILENCE_OP_GPU_CUH_
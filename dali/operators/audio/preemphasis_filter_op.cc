@@ -17,6 +17,7 @@
 #include <utility>
 #include <vector>
 #include "dali/operators/audio/preemphasis_filter_op.h"
+#include "dali/operators/signal/stream_state.h"
 
 namespace dali {
 
@@ -35,6 +36,9 @@ The value of ``X_border`` depends on the ``border`` argument::
   X_border = 0                    if border_type == 'zero'
   X_border = X[0]                 if border_type == 'clamp'
   X_border = X[1]                 if border_type == 'reflect'
+
+When ``stream_id`` is given, ``X[t-1]`` for the first sample of a chunk is the last sample
+of the previous chunk of the stream, and ``X_border`` is only used for the first chunk.
 )code")
     .NumInput(1)
     .NumOutput(detail::kNumOutputs)
@@ -42,16 +46,25 @@ The value of ``X_border`` depends on the ``border`` argument::
     .AddOptionalTypeArg(arg_names::kDtype, R"code(Data type for the output.)code", DALI_FLOAT)
     .AddOptionalArg(detail::kBorder,
       R"(Border value policy. Possible values are \"zero\", \"clamp\", \"reflect\".)",
-      "clamp");
+      "clamp")
+    .AddParent("SignalStreamAttr");
 
 class PreemphasisFilterCPU : public PreemphasisFilter<CPUBackend> {
  public:
-  explicit PreemphasisFilterCPU(const OpSpec &spec) : PreemphasisFilter<CPUBackend>(spec) {}
+  explicit PreemphasisFilterCPU(const OpSpec &spec)
+      : PreemphasisFilter<CPUBackend>(spec), streams_(spec) {}
   void RunImpl(workspace_t<CPUBackend> &ws) override;
 
  private:
   template <typename OutputType, typename InputType>
   void RunImplTyped(workspace_t<CPUBackend> &ws);
+
+  struct StreamState {
+    bool has_prev = false;
+    double prev = 0;  ///< The last sample of the previous chunk
+    void clear() { has_prev = false; }
+  };
+  StreamStates<StreamState> streams_;
 };
 
 template <typename OutputType, typename InputType>
@@ -61,6 +74,8 @@ void PreemphasisFilterCPU::RunImplTyped(workspace_t<CPUBackend> &ws) {
   auto &tp = ws.GetThreadPool();
   auto shape = input.shape();
   auto nsamples = shape.num_samples();
+  if (streams_.enabled())
+    streams_.Acquire(spec_, ws, nsamples);
 
   for (int sample_id = 0; sample_id < nsamples; sample_id++) {
     tp.AddWork(
@@ -71,12 +86,16 @@ void PreemphasisFilterCPU::RunImplTyped(workspace_t<CPUBackend> &ws) {
                      "Input and output shapes don't match");
         auto n = volume(output.tensor_shape(sample_id));
         auto coeff = preemph_coeff_[sample_id];
+        auto *state = streams_.enabled() ? &streams_[sample_id] : nullptr;
         if (coeff == 0.0f) {
           for (int64_t j = 0; j < n; j++) {
             out_ptr[j] = ConvertSat<OutputType>(in_ptr[j]);
           }
         } else {
-          if (border_type_ == BorderType::Zero) {
+          if (state && state->has_prev) {
+            auto prev = static_cast<InputType>(state->prev);
+            out_ptr[0] = ConvertSat<OutputType>(in_ptr[0] - coeff * prev);
+          } else if (border_type_ == BorderType::Zero) {
             out_ptr[0] = ConvertSat<OutputType>(in_ptr[0]);
           } else {
             InputType border = (border_type_ == BorderType::Reflect) ? in_ptr[1] : in_ptr[0];
@@ -86,6 +105,10 @@ void PreemphasisFilterCPU::RunImplTyped(workspace_t<CPUBackend> &ws) {
             out_ptr[j] = ConvertSat<OutputType>(in_ptr[j] - coeff * in_ptr[j - 1]);
           }
         }
+        if (state && n > 0) {
+          state->prev = in_ptr[n - 1];
+          state->has_prev = true;
+        }
       }, shape.tensor_size(sample_id));
   }
   tp.RunAll();
@@ -14,6 +14,8 @@
 
 #include "dali/operators/audio/preemphasis_filter_op.h"
 #include <vector>
+#include "dali/core/dev_buffer.h"
+#include "dali/operators/signal/stream_state.h"
 #include "dali/pipeline/data/types.h"
 
 namespace dali {
@@ -26,6 +28,8 @@ struct SampleDescriptor {
   OutputType *out;
   float coeff;
   int64_t size;
+  const InputType *prev;  // the last sample of the previous chunk of the stream, if any
+  InputType *save_last;   // where to store the last sample, for the next chunk of the stream
 };
 
 using BorderType = PreemphasisFilter<GPUBackend>::BorderType;
@@ -43,7 +47,11 @@ void __global__ PreemphasisFilterKernel(const SampleDescriptor<OutputType, Input
     return;
 
   if (k == 0) {
-    if (border_type == BorderType::Zero) {
+    if (sample.save_last)
+      *sample.save_last = sample.in[sample.size - 1];
+    if (sample.prev) {
+      sample.out[k] = sample.in[k] - sample.coeff * *sample.prev;
+    } else if (border_type == BorderType::Zero) {
       sample.out[k] = sample.in[k];
     } else {
       // BorderType::Reflect or BorderType::Clamp
@@ -60,7 +68,8 @@ void __global__ PreemphasisFilterKernel(const SampleDescriptor<OutputType, Input
 
 class PreemphasisFilterGPU : public PreemphasisFilter<GPUBackend> {
  public:
-  explicit PreemphasisFilterGPU(const OpSpec &spec) : PreemphasisFilter<GPUBackend>(spec) {
+  explicit PreemphasisFilterGPU(const OpSpec &spec)
+      : PreemphasisFilter<GPUBackend>(spec), streams_(spec) {
     // void is OK here, pointer sizes are the same size
     int64_t sz = max_batch_size_ * sizeof(detail::SampleDescriptor<void, void>);
     scratch_mem_.Resize({sz}, DALI_UINT8);
@@ -72,6 +81,17 @@ class PreemphasisFilterGPU : public PreemphasisFilter<GPUBackend> {
   void RunImplTyped(workspace_t<GPUBackend> &ws);
 
   Tensor<GPUBackend> scratch_mem_;
+
+  struct StreamState {
+    // The last sample of a chunk is stored in one of two slots, alternately, so that the kernel
+    // can read the previous one and write the new one at the same time.
+    DeviceBuffer<uint8_t> last;
+    int slot = 0;
+    bool has_prev = false;
+    DALIDataType type = DALI_NO_TYPE;
+    void clear() { has_prev = false; }
+  };
+  StreamStates<StreamState> streams_;
 };
 
 template <typename OutputType, typename InputType>
@@ -81,6 +101,10 @@ void PreemphasisFilterGPU::RunImplTyped(workspace_t<GPUBackend> &ws) {
   auto &output = ws.Output<GPUBackend>(0);
   auto curr_batch_size = ws.GetInputBatchSize(0);
 
+  auto stream = ws.stream();
+  if (streams_.enabled())
+    streams_.Acquire(spec_, ws, curr_batch_size);
+
   std::vector<SampleDesc> samples_cpu(curr_batch_size);
   for (int sample_idx = 0; sample_idx < curr_batch_size; sample_idx++) {
     auto &sample = samples_cpu[sample_idx];
@@ -88,12 +112,29 @@ void PreemphasisFilterGPU::RunImplTyped(workspace_t<GPUBackend> &ws) {
     sample.out = output.mutable_tensor<OutputType>(sample_idx);
     sample.size = volume(input.tensor_shape(sample_idx));
     sample.coeff = preemph_coeff_[sample_idx];
+    sample.prev = nullptr;
+    sample.save_last = nullptr;
+    if (streams_.enabled() && sample.size > 0) {
+      auto &state = streams_[sample_idx];
+      if (state.last.empty())  // large enough for any of the PREEMPH_TYPES
+        state.last.resize(2 * sizeof(double), stream);
+      auto *slots = reinterpret_cast<InputType *>(state.last.data());
+      if (state.has_prev) {
+        DALI_ENFORCE(state.type == input.type(), make_string(
+            "The type of the chunks of a stream must not change. Got ", input.type(),
+            " after ", state.type, " for sample ", sample_idx, "."));
+        sample.prev = slots + state.slot;
+      }
+      state.slot = 1 - state.slot;
+      sample.save_last = slots + state.slot;
+      state.has_prev = true;
+      state.type = input.type();
+    }
   }
 
   int64_t sz = curr_batch_size * sizeof(SampleDesc);
   scratch_mem_.Resize({sz}, DALI_UINT8);
   auto sample_descs_gpu = reinterpret_cast<SampleDesc*>(scratch_mem_.mutable_data<uint8_t>());
-  auto stream = ws.stream();
   CUDA_CALL(
     cudaMemcpyAsync(sample_descs_gpu, samples_cpu.data(), sz, cudaMemcpyHostToDevice, stream));
 
@@ -0,0 +1,243 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "dali/core/static_switch.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/signal/moving_mean_square_gpu.cuh"
+#include "dali/operators/audio/nonsilence_op_gpu.cuh"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+DALI_SCHEMA(experimental__PreemphasisTrim)
+  .DocStr(R"code(Applies a preemphasis filter to an audio buffer and trims the leading and
+trailing silence of the filtered signal.
+
+The result is equivalent to applying :meth:`nvidia.dali.fn.preemphasis_filter`, finding the
+non-silent region of the filtered signal with :meth:`nvidia.dali.fn.nonsilent_region` and
+slicing the filtered signal to that region. The filtered signal is never stored in full:
+the short-term power is computed while filtering, and only the non-silent region
+is filtered again and written to the output.
+
+Inputs and outputs:
+
+* **Input 0** - 1D audio buffer.
+* **Output 0** - Filtered non-silent region of the signal, as ``float``.
+
+.. note::
+  The size of the output is only known after the non-silent region is found, so the operator
+  waits for its CUDA stream before writing the output.
+)code")
+  .NumInput(1)
+  .NumOutput(1)
+  .AddOptionalArg("preemph_coeff", R"code(Preemphasis coefficient ``coeff``.)code", 0.97f, true)
+  .AddOptionalArg("border",
+    R"(Border value policy. Possible values are \"zero\", \"clamp\", \"reflect\".)",
+    "clamp")
+  .AddParent("NonsilentRegion");
+
+namespace {
+
+enum class BorderType : uint8_t {
+  Zero = 0,
+  Clamp,
+  Reflect,
+};
+
+/**
+ * @brief Computes the preemphasis filter `in[idx] - coeff * in[idx - 1]` at a given position
+ */
+template <typename T>
+DALI_HOST_DEV DALI_FORCEINLINE float Preemphasis(const T *in, int64_t len, int64_t idx,
+                                                 float coeff, BorderType border) {
+  float prev;
+  if (idx > 0)
+    prev = in[idx - 1];
+  else if (border == BorderType::Zero)
+    prev = 0;
+  else if (border == BorderType::Reflect && len > 1)
+    prev = in[1];
+  else
+    prev = in[0];
+  return static_cast<float>(in[idx]) - coeff * prev;
+}
+
+/**
+ * @brief Moving mean square sample, loading the filtered signal
+ */
+template <typename T>
+struct PreemphasisMMSSample {
+  using value_type = float;
+
+  float *out;
+  const T *in;
+  int64_t len;
+  float coeff;
+  BorderType border;
+
+  DALI_HOST_DEV DALI_FORCEINLINE float load(int64_t idx) const {
+    return Preemphasis(in, len, idx, coeff, border);
+  }
+};
+
+template <typename T>
+struct PreemphasisTrimSample {
+  float *out;
+  const T *in;
+  int64_t in_len;
+  int64_t begin;
+  int64_t len;
+  float coeff;
+};
+
+template <typename T>
+__global__ void PreemphasisTrimKernel(const PreemphasisTrimSample<T> *samples,
+                                      BorderType border) {
+  const auto &sample = samples[blockIdx.y];
+  for (int64_t k = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x; k < sample.len;
+       k += static_cast<int64_t>(blockDim.x) * gridDim.x) {
+    sample.out[k] = Preemphasis(sample.in, sample.in_len, sample.begin + k, sample.coeff, border);
+  }
+}
+
+}  // namespace
+
+class PreemphasisTrimGpu : public NonsilenceOperatorGpu {
+ public:
+  explicit PreemphasisTrimGpu(const OpSpec &spec) : NonsilenceOperatorGpu(spec) {
+    auto border_str = spec.GetArgument<std::string>("border");
+    if (border_str == "zero") {
+      border_type_ = BorderType::Zero;
+    } else if (border_str == "reflect") {
+      border_type_ = BorderType::Reflect;
+    } else if (border_str == "clamp") {
+      border_type_ = BorderType::Clamp;
+    } else {
+      DALI_FAIL(make_string("``border`` mode \"", border_str, "\" is not supported."));
+    }
+  }
+
+  ~PreemphasisTrimGpu() override = default;
+  DISABLE_COPY_MOVE_ASSIGN(PreemphasisTrimGpu);
+
+ protected:
+  bool CanInferOutputs() const override {
+    return false;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc,
+                 const workspace_t<GPUBackend> &ws) override {
+    AcquireArgs(spec_, ws);
+    this->GetPerSampleArgument(preemph_coeff_, "preemph_coeff", ws, ws.GetInputBatchSize(0));
+    // The power is calculated for the filtered signal, which is always floating point
+    reset_interval_ = spec_.GetArgument<int>("reset_interval", &ws);
+    DALI_ENFORCE(reset_interval_ == -1 || reset_interval_ % window_length_ == 0,
+                 make_string("`reset_interval` shall be a multiple of `window_length`. "
+                             "Got: reset_interval: ", reset_interval_, " vs window_length: ",
+                             window_length_));
+    return false;
+  }
+
+  void RunImpl(workspace_t<GPUBackend> &ws) override {
+    auto dtype = ws.template Input<GPUBackend>(0).type();
+    TYPE_SWITCH(dtype, type2id, T, (NONSILENCE_TYPES),
+      (RunImplTyped<T>(ws);),
+      (DALI_FAIL(
+          make_string("Unsupported input type: ", dtype,
+                      "\nSupported types are : ", ListTypeNames<NONSILENCE_TYPES>()));));
+  }
+
+ private:
+  template <typename T>
+  void RunImplTyped(workspace_t<GPUBackend> &ws) {
+    const auto &in = ws.template Input<GPUBackend>(0);
+    auto input = view<const T, 1>(in);
+    int nsamples = input.num_samples();
+    cudaStream_t stream = ws.stream();
+    kernels::DynamicScratchpad scratchpad({}, stream);
+
+    // 1. Compute the MMS of the filtered signal, without storing the filtered signal
+    auto mms = scratchpad.AllocTensorList<mm::memory_kind::device, float, 1>(input.shape);
+    auto *mms_samples = scratchpad.AllocatePinned<PreemphasisMMSSample<T>>(nsamples);
+    int64_t max_len = 0;
+    for (int i = 0; i < nsamples; i++) {
+      auto &sample = mms_samples[i];
+      sample.out = mms[i].data;
+      sample.in = input[i].data;
+      sample.len = input[i].shape[0];
+      sample.coeff = preemph_coeff_[i];
+      sample.border = border_type_;
+      max_len = std::max(max_len, sample.len);
+    }
+    if (max_len > 0) {
+      auto *mms_samples_gpu = scratchpad.ToGPU(stream, make_span(mms_samples, nsamples));
+      kernels::signal::MovingMeanSquare(mms_samples_gpu, nsamples, max_len,
+                                        {window_length_, reset_interval_}, stream);
+    }
+
+    // 2. Find the nonsilent region and bring it to the host, to size the output
+    TensorListShape<0> scalar_sh(nsamples);
+    auto begin = scratchpad.AllocTensorList<mm::memory_kind::device, int32_t>(scalar_sh);
+    auto len = scratchpad.AllocTensorList<mm::memory_kind::device, int32_t>(scalar_sh);
+    CalcNonsilentRegion(begin, len, mms, stream);
+    auto *region_cpu = scratchpad.AllocatePinned<int32_t>(2 * nsamples);
+    assert(begin.is_contiguous() && len.is_contiguous());
+    CUDA_CALL(cudaMemcpyAsync(region_cpu, begin.data[0], nsamples * sizeof(int32_t),
+                              cudaMemcpyDeviceToHost, stream));
+    CUDA_CALL(cudaMemcpyAsync(region_cpu + nsamples, len.data[0], nsamples * sizeof(int32_t),
+                              cudaMemcpyDeviceToHost, stream));
+    CUDA_CALL(cudaStreamSynchronize(stream));
+
+    TensorListShape<1> out_shape(nsamples);
+    for (int i = 0; i < nsamples; i++)
+      out_shape.set_tensor_shape(i, {region_cpu[nsamples + i]});
+    auto &output = ws.template Output<GPUBackend>(0);
+    output.Resize(out_shape, DALI_FLOAT);
+    output.SetLayout(in.GetLayout());
+    auto out = view<float, 1>(output);
+
+    // 3. Filter again, writing only the nonsilent region
+    auto *trim_samples = scratchpad.AllocatePinned<PreemphasisTrimSample<T>>(nsamples);
+    int num_trimmed = 0;
+    int64_t max_out_len = 0;
+    for (int i = 0; i < nsamples; i++) {
+      if (out_shape[i][0] == 0)
+        continue;
+      auto &sample = trim_samples[num_trimmed++];
+      sample.out = out[i].data;
+      sample.in = input[i].data;
+      sample.in_len = input[i].shape[0];
+      sample.begin = region_cpu[i];
+      sample.len = out_shape[i][0];
+      sample.coeff = preemph_coeff_[i];
+      max_out_len = std::max(max_out_len, sample.len);
+    }
+    if (num_trimmed == 0)
+      return;
+    auto *trim_samples_gpu = scratchpad.ToGPU(stream, make_span(trim_samples, num_trimmed));
+    int block = 256;
+    dim3 grid(std::min<int64_t>(div_ceil(max_out_len, block), 1024), num_trimmed);
+    PreemphasisTrimKernel<<<grid, block, 0, stream>>>(trim_samples_gpu, border_type_);
+    CUDA_CALL(cudaGetLastError());
+  }
+
+  std::vector<float> preemph_coeff_;
+  BorderType border_type_;
+};
+
+DALI_REGISTER_OPERATOR(experimental__PreemphasisTrim, PreemphasisTrimGpu, GPU);
+
+}  // namespace dali
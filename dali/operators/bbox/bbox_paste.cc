@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,8 +12,6 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <cmath>
-
 #include "dali/operators/bbox/bbox_paste.h"
 
 namespace dali {
@@ -67,30 +65,10 @@ void BBoxPaste<CPUBackend>::RunImpl(Workspace<CPUBackend> &ws) {
   output.Resize(input.shape(), DALI_FLOAT);
   auto *output_data = output.mutable_data<float>();
 
-  const auto data_idx = ws.data_idx();
-  // pasting onto a larger canvas scales bounding boxes down by scale ratio
-  float ratio = spec_.GetArgument<float>("ratio", &ws, data_idx);
-  float px = spec_.GetArgument<float>("paste_x", &ws, data_idx);
-  float py = spec_.GetArgument<float>("paste_y", &ws, data_idx);
-  float scale = 1 / ratio;
-
-  // offsets are scaled so that (0,0) pastes the image aligned to the top-left
-  // corner and (1,1) aligns it to the (bottom, right) corner
-  float ofs_mul = (ratio - 1) / ratio;
-  float ofsx = px * ofs_mul;
-  float ofsy = py * ofs_mul;
-
-  // this ensures that the boxes that were in (0,1) range still are after pasting
-  if (scale + ofsx > 1) {
-    ofsx = 1 - scale;
-    while (scale + ofsx > 1)
-      ofsx = std::nextafter(ofsx, -1.0f);
-  }
-  if (scale + ofsy > 1) {
-    ofsy = 1 - scale;
-    while (scale + ofsy > 1)
-      ofsy = std::nextafter(ofsy, -1.0f);
-  }
+  auto params = GetParams(ws, ws.data_idx());
+  float scale = params.scale;
+  float ofsx = params.ofsx;
+  float ofsy = params.ofsy;
 
   for (int j = 0; j + 4 <= input.size(); j += 4) {
     auto x0 = input_data[j];
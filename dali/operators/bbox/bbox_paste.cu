@@ -0,0 +1,100 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/format.h"
+#include "dali/core/util.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/operators/bbox/bbox_paste.h"
+
+namespace dali {
+
+namespace {
+
+struct BBoxPasteSampleDesc {
+  float *output;
+  const float *input;
+  int64_t nboxes;
+  BBoxPasteParams params;
+};
+
+/**
+ * @brief Transforms the boxes, with one row of blocks per sample
+ *
+ * The operations are explicitly rounded, so that the results are the same as on the CPU.
+ */
+template <bool ltrb>
+__global__ void BBoxPasteKernel(const BBoxPasteSampleDesc *samples) {
+  const auto &sample = samples[blockIdx.y];
+  float scale = sample.params.scale;
+  float ofsx = sample.params.ofsx;
+  float ofsy = sample.params.ofsy;
+  for (int64_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < sample.nboxes;
+       idx += blockDim.x * gridDim.x) {
+    const float *in = &sample.input[4 * idx];
+    float *out = &sample.output[4 * idx];
+    out[0] = __fadd_rn(__fmul_rn(in[0], scale), ofsx);
+    out[1] = __fadd_rn(__fmul_rn(in[1], scale), ofsy);
+    if (ltrb) {
+      out[2] = __fadd_rn(__fmul_rn(in[2], scale), ofsx);
+      out[3] = __fadd_rn(__fmul_rn(in[3], scale), ofsy);
+    } else {
+      out[2] = __fmul_rn(in[2], scale);
+      out[3] = __fmul_rn(in[3], scale);
+    }
+  }
+}
+
+}  // namespace
+
+template<>
+void BBoxPaste<GPUBackend>::RunImpl(Workspace<GPUBackend> &ws) {
+  const auto &input = ws.Input<GPUBackend>(0);
+  DALI_ENFORCE(input.type() == DALI_FLOAT, "Bounding box in wrong format");
+  int nsamples = input.num_samples();
+
+  auto &output = ws.Output<GPUBackend>(0);
+  output.Resize(input.shape(), DALI_FLOAT);
+
+  std::vector<BBoxPasteSampleDesc> samples(nsamples);
+  int64_t max_boxes = 0;
+  for (int i = 0; i < nsamples; i++) {
+    auto size = volume(input.tensor_shape(i));
+    DALI_ENFORCE(size % 4 == 0, make_string("Bounding box tensor size must be a multiple of 4."
+                                            "Got: ", size));
+    samples[i].output = output.mutable_tensor<float>(i);
+    samples[i].input = input.tensor<float>(i);
+    samples[i].nboxes = size / 4;
+    samples[i].params = GetParams(ws, i);
+    max_boxes = std::max(max_boxes, samples[i].nboxes);
+  }
+  if (max_boxes == 0)
+    return;
+
+  auto stream = ws.stream();
+  kernels::DynamicScratchpad scratchpad({}, AccessOrder(stream));
+  auto *samples_gpu = scratchpad.ToGPU(stream, samples);
+  dim3 grid(std::min<int64_t>(div_ceil(max_boxes, 256), 1024), nsamples);
+  if (use_ltrb_)
+    BBoxPasteKernel<true><<<grid, 256, 0, stream>>>(samples_gpu);
+  else
+    BBoxPasteKernel<false><<<grid, 256, 0, stream>>>(samples_gpu);
+  CUDA_CALL(cudaGetLastError());
+}
+
+DALI_REGISTER_OPERATOR(BBoxPaste, BBoxPaste<GPUBackend>, GPU);
+
+}  // namespace dali
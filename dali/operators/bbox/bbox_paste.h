@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_BBOX_BBOX_PASTE_H_
 #define DALI_OPERATORS_BBOX_BBOX_PASTE_H_
 
+#include <cmath>
 #include <vector>
 
 #include "dali/core/common.h"
@@ -24,6 +25,14 @@
 
 namespace dali {
 
+/**
+ * @brief The scale and the offsets which transform the boxes of a sample
+ */
+struct BBoxPasteParams {
+  float scale;
+  float ofsx, ofsy;
+};
+
 template <typename Backend>
 class BBoxPaste : public Operator<Backend> {
  public:
@@ -41,6 +50,33 @@ class BBoxPaste : public Operator<Backend> {
 
   void RunImpl(Workspace<Backend> &ws) override;
 
+  BBoxPasteParams GetParams(const ArgumentWorkspace &ws, int data_idx) const {
+    // pasting onto a larger canvas scales bounding boxes down by scale ratio
+    float ratio = spec_.template GetArgument<float>("ratio", &ws, data_idx);
+    float px = spec_.template GetArgument<float>("paste_x", &ws, data_idx);
+    float py = spec_.template GetArgument<float>("paste_y", &ws, data_idx);
+    float scale = 1 / ratio;
+
+    // offsets are scaled so that (0,0) pastes the image aligned to the top-left
+    // corner and (1,1) aligns it to the (bottom, right) corner
+    float ofs_mul = (ratio - 1) / ratio;
+    float ofsx = px * ofs_mul;
+    float ofsy = py * ofs_mul;
+
+    // this ensures that the boxes that were in (0,1) range still are after pasting
+    if (scale + ofsx > 1) {
+      ofsx = 1 - scale;
+      while (scale + ofsx > 1)
+        ofsx = std::nextafter(ofsx, -1.0f);
+    }
+    if (scale + ofsy > 1) {
+      ofsy = 1 - scale;
+      while (scale + ofsy > 1)
+        ofsy = std::nextafter(ofsy, -1.0f);
+    }
+    return {scale, ofsx, ofsy};
+  }
+
   USE_OPERATOR_MEMBERS();
   using Operator<Backend>::RunImpl;
 };
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string>
 #include "dali/test/dali_test_bboxes.h"
 
 namespace dali {
@@ -64,12 +65,13 @@ class BBoxPasteTest<std::integral_constant<bool, ltrb>> : public DALISingleOpTes
 
   std::vector<std::vector<BBox>> input_, output_;
 
-  void Run(float ratio, float paste_x, float paste_y) {
+  void Run(float ratio, float paste_x, float paste_y, const std::string &device = "cpu") {
     OpSpec spec("BBoxPaste");
     input_tl_ = ToTensorList(input_);
     SetBatchSize(input_tl_->num_samples());
 
-    spec.AddInput("bb_input", "cpu").AddOutput("bb_output", "cpu");
+    spec.AddArg("device", device);
+    spec.AddInput("bb_input", device).AddOutput("bb_output", device);
 
     spec.AddArg("ltrb", ltrb);
     spec.AddArg("ratio", ratio);
@@ -193,4 +195,33 @@ TYPED_TEST(BBoxPasteTest, Random) {
   this->Run(ratio, x, y);
 }
 
+TYPED_TEST(BBoxPasteTest, FullBoxPasteGPU) {
+  const float x = 0.876f;
+  const float y = 0.321f;
+
+  const float ratio = 1.789f;
+  const float margin = (ratio-1)/ratio;
+
+  this->input_ = { { { 0, 0, 1, 1 } } };
+
+  if (this->ltrb_) {
+    this->output_ = { { { x*margin, y*margin, x*margin+1/ratio, y*margin+1/ratio } } };
+  } else {
+    this->output_ = { { { x*margin, y*margin, 1/ratio, 1/ratio } } };
+  }
+
+  this->Run(ratio, x, y, "gpu");
+}
+
+TYPED_TEST(BBoxPasteTest, RandomGPU) {
+  const float x = 0.876f;
+  const float y = 0.321f;
+
+  const float ratio = 1.789f;
+
+  this->input_ = this->RandomBoxes(10, 100);
+  this->output_ = this->CalculateReferenceOutput(this->input_, ratio, x, y);
+  this->Run(ratio, x, y, "gpu");
+}
+
 }  // namespace dali
@@ -48,6 +48,7 @@ DALI_SCHEMA(DumpImage)
   .DocStr(R"code(Save images in batch to disk in PPM format.
 
 Useful for debugging.)code")
+  .Nondeterministic()
   .NumInput(1)
   .NumOutput(1)
   .AddOptionalArg("suffix",
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dali/operators/decoder/audio/audio_decoder_impl.h"
+#include <algorithm>
 #include "dali/kernels/signal/downmixing.h"
 
 namespace dali {
@@ -22,7 +23,7 @@ std::pair<int64_t, int64_t> ProcessOffsetAndLength(const AudioMetadata &meta,
   int64_t offset = 0;
   int64_t length = meta.length;
   if (offset_sec >= 0.0) {
-    offset = static_cast<int64_t>(offset_sec * meta.sample_rate);
+    offset = std::min(static_cast<int64_t>(offset_sec * meta.sample_rate), meta.length);
   }
 
   if (length_sec >= 0.0) {
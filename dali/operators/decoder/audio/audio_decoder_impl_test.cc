@@ -50,6 +50,11 @@ TEST(AudioDecoderImpl, ProcessOffsetAndLength) {
     int64_t duration = total_length - offset;
     ASSERT_EQ(std::make_pair(offset, duration), ProcessOffsetAndLength(meta, 0.45, -1.0));
   }
+
+  {
+    // the offset past the end gives an empty recording
+    ASSERT_EQ(std::make_pair(total_length, int64_t(0)), ProcessOffsetAndLength(meta, 5.0, 1.0));
+  }
 }
 
 }  // namespace test
@@ -0,0 +1,188 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/operators/decoder/audio/audio_decoder_mixed_op.h"
+#include <tuple>
+#include "dali/core/static_switch.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/signal/resampling_gpu.h"
+#include "dali/operators/audio/resampling_params.h"
+#include "dali/operators/decoder/audio/audio_decoder_impl.h"
+#include "dali/operators/decoder/audio/generic_decoder.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+DALI_REGISTER_OPERATOR(decoders__Audio, AudioDecoderMixed, Mixed);
+
+AudioDecoderMixed::AudioDecoderMixed(const OpSpec &spec)
+    : Operator<MixedBackend>(spec),
+      output_type_(spec.GetArgument<DALIDataType>("dtype")),
+      downmix_(spec.GetArgument<bool>("downmix")),
+      use_resampling_(spec.HasArgument("sample_rate") || spec.HasTensorArgument("sample_rate")),
+      quality_(spec.GetArgument<float>("quality")),
+      thread_pool_(spec.GetArgument<int>("num_threads"), spec.GetArgument<int>("device_id"),
+                   false, "AudioDecoderMixed") {
+  DALI_ENFORCE(quality_ >= 0 && quality_ <= 100, "Resampling quality must be in [0..100] range");
+  decoded_cpu_.set_pinned(true);
+  sample_rates_cpu_.set_pinned(true);
+  copy_done_ = CUDAEvent::Create(spec.GetArgument<int>("device_id"));
+}
+
+bool AudioDecoderMixed::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                  const MixedWorkspace &ws) {
+  const auto &input = ws.Input<CPUBackend>(0);
+  int batch_size = input.num_samples();
+  GetPerSampleArgument<float>(target_sample_rates_, "sample_rate", ws, batch_size);
+  GetPerSampleArgument<float>(offsets_sec_, "offset", ws, batch_size);
+  GetPerSampleArgument<float>(durations_sec_, "duration", ws, batch_size);
+  DALI_ENFORCE(IsType<uint8_t>(input.type()), "Raw files must be stored as uint8 data.");
+
+  decoders_.resize(batch_size);
+  sample_meta_.resize(batch_size);
+  files_names_.resize(batch_size);
+  offsets_.resize(batch_size);
+  args_.resize(batch_size);
+
+  TensorListShape<> shape_data(batch_size, downmix_ ? 1 : 2);
+  for (int i = 0; i < batch_size; i++) {
+    DALI_ENFORCE(input.tensor_shape(i).size() == 1, "Raw input must be 1D encoded byte data");
+    if (!decoders_[i])
+      decoders_[i] = make_generic_audio_decoder();
+    auto &meta = sample_meta_[i] =
+        decoders_[i]->Open({static_cast<const char *>(input.raw_tensor(i)),
+                            input.tensor_shape(i).num_elements()});
+    std::tie(offsets_[i], meta.length) =
+        ProcessOffsetAndLength(meta, offsets_sec_[i], durations_sec_[i]);
+    float out_rate = use_resampling_ ? target_sample_rates_[i] : meta.sample_rate;
+    // the samples which are not resampled go through the resampling kernel (with the ratio 1)
+    // anyway, to be converted to the output type
+    args_[i].in_rate = meta.sample_rate;
+    args_[i].out_rate = out_rate;
+    shape_data.set_tensor_shape(i, DecodedAudioShape(meta, out_rate, downmix_));
+    files_names_[i] = input.GetMeta(i).GetSourceInfo();
+  }
+
+  output_desc.resize(2);
+  output_desc[0] = {shape_data, output_type_};
+  output_desc[1] = {TensorListShape<>(batch_size, 0), DALI_FLOAT};
+  return true;
+}
+
+void AudioDecoderMixed::DecodeBatch() {
+  int batch_size = sample_meta_.size();
+  TensorListShape<2> shape(batch_size);
+  for (int i = 0; i < batch_size; i++)
+    shape.set_tensor_shape(i, {sample_meta_[i].length, sample_meta_[i].channels});
+  // the previous batch may still be copied to the GPU
+  CUDA_CALL(cudaEventSynchronize(copy_done_));
+  decoded_cpu_.Resize(shape, DALI_FLOAT);
+
+  for (int i = 0; i < batch_size; i++) {
+    thread_pool_.AddWork([&, i](int thread_id) {
+      try {
+        auto &decoder = *decoders_[i];
+        if (offsets_[i] > 0) {
+          auto pos = decoder.SeekFrames(offsets_[i], SEEK_SET);
+          DALI_ENFORCE(pos == offsets_[i],
+                       make_string("Failed to seek to the frame ", offsets_[i]));
+        }
+        int64_t length = sample_meta_[i].length;
+        int64_t ret = decoder.DecodeFrames(decoded_cpu_.mutable_tensor<float>(i), length);
+        DALI_ENFORCE(ret == length, make_string("Requested ", length, " samples but got ", ret,
+                                                " samples."));
+      } catch (const DALIException &e) {
+        DALI_FAIL(make_string("Error decoding file ", files_names_[i], ". Error: ", e.what()));
+      }
+    }, sample_meta_[i].length * sample_meta_[i].channels);
+  }
+  thread_pool_.RunAll();
+}
+
+template <typename Out>
+void AudioDecoderMixed::Resample(TensorList<GPUBackend> &output, cudaStream_t stream) {
+  int batch_size = sample_meta_.size();
+  kernels::DynamicScratchpad scratchpad({}, AccessOrder(stream));
+  kernels::KernelContext ctx;
+  ctx.gpu.stream = stream;
+  ctx.scratchpad = &scratchpad;
+
+  auto decoded = view<const float, 2>(decoded_gpu_);
+  kernels::InListGPU<float> in;
+  if (downmix_) {
+    // the multi-channel recordings are downmixed to downmixed_gpu_ first
+    std::vector<int> multichannel;
+    for (int i = 0; i < batch_size; i++) {
+      if (decoded.shape[i][1] > 1)
+        multichannel.push_back(i);
+    }
+    int nmulti = multichannel.size();
+    kernels::InListGPU<float, 2> multi_in;
+    multi_in.resize(nmulti);
+    TensorListShape<1> mono_shape(nmulti);
+    for (int j = 0; j < nmulti; j++) {
+      multi_in.data[j] = decoded.data[multichannel[j]];
+      multi_in.shape.set_tensor_shape(j, decoded.shape[multichannel[j]]);
+      mono_shape.set_tensor_shape(j, {decoded.shape[multichannel[j]][0]});
+    }
+    downmixed_gpu_.Resize(mono_shape, DALI_FLOAT);
+    auto mono = view<float, 1>(downmixed_gpu_);
+    if (nmulti > 0)
+      downmix_kernel_.Run(ctx, mono, multi_in);
+
+    in.resize(batch_size, 1);
+    for (int i = 0, j = 0; i < batch_size; i++) {
+      bool is_multi = j < nmulti && multichannel[j] == i;
+      in.data[i] = is_multi ? mono.data[j++] : decoded.data[i];
+      in.shape.set_tensor_shape(i, {decoded.shape[i][0]});
+    }
+  } else {
+    in.resize(batch_size, 2);
+    for (int i = 0; i < batch_size; i++) {
+      in.data[i] = decoded.data[i];
+      in.shape.set_tensor_shape(i, decoded.shape[i]);
+    }
+  }
+
+  using Kernel = kernels::signal::resampling::ResamplerGPU<Out, float>;
+  if (kmgr_.NumInstances() == 0) {
+    kmgr_.Resize<Kernel>(1);
+    auto params = audio::ResamplingParams::FromQuality(quality_);
+    kmgr_.Get<Kernel>(0).Initialize(params.lobes, params.lookup_size);
+  }
+  auto args = make_cspan(args_);
+  kmgr_.Setup<Kernel>(0, ctx, in, args);
+  kmgr_.Run<Kernel>(0, ctx, view<Out>(output), in, args);
+}
+
+void AudioDecoderMixed::Run(MixedWorkspace &ws) {
+  DecodeBatch();
+  auto stream = ws.stream();
+  decoded_gpu_.Copy(decoded_cpu_, stream);
+
+  auto &output = ws.Output<GPUBackend>(0);
+  TYPE_SWITCH(output_type_, type2id, Out, (int16_t, int32_t, float), (
+    Resample<Out>(output, stream);
+  ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)))  // NOLINT
+
+  int batch_size = sample_meta_.size();
+  sample_rates_cpu_.Resize(TensorListShape<>(batch_size, 0), DALI_FLOAT);
+  for (int i = 0; i < batch_size; i++)
+    *sample_rates_cpu_.mutable_tensor<float>(i) = args_[i].out_rate;
+  ws.Output<GPUBackend>(1).Copy(sample_rates_cpu_, stream);
+  CUDA_CALL(cudaEventRecord(copy_done_, stream));
+}
+
+}  // namespace dali
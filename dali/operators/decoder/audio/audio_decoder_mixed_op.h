@@ -0,0 +1,83 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_OPERATORS_DECODER_AUDIO_AUDIO_DECODER_MIXED_OP_H_
+#define DALI_OPERATORS_DECODER_AUDIO_AUDIO_DECODER_MIXED_OP_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/core/cuda_event.h"
+#include "dali/kernels/kernel_manager.h"
+#include "dali/kernels/signal/downmixing_gpu.h"
+#include "dali/kernels/signal/resampling.h"
+#include "dali/operators/decoder/audio/audio_decoder.h"
+#include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+
+/**
+ * @brief Decodes the audio on the CPU and resamples and downmixes it on the GPU
+ *
+ * The decoded samples (at the original sampling rate and with all the channels) are copied to
+ * the GPU once, as floats. The downmixing, the resampling and the conversion to the output type
+ * are done on the GPU for the whole batch.
+ */
+class AudioDecoderMixed : public Operator<MixedBackend> {
+ public:
+  explicit AudioDecoderMixed(const OpSpec &spec);
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const MixedWorkspace &ws) override;
+
+  void Run(MixedWorkspace &ws) override;
+
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+ private:
+  /// Decodes the (requested part of the) recordings to decoded_cpu_
+  void DecodeBatch();
+
+  template <typename Out>
+  void Resample(TensorList<GPUBackend> &output, cudaStream_t stream);
+
+  const DALIDataType output_type_;
+  const bool downmix_, use_resampling_;
+  const float quality_;
+  ThreadPool thread_pool_;
+
+  std::vector<float> target_sample_rates_;
+  std::vector<float> offsets_sec_, durations_sec_;
+  /// The first frame of the decoded part of each recording
+  std::vector<int64_t> offsets_;
+  std::vector<AudioMetadata> sample_meta_;
+  std::vector<std::string> files_names_;
+  std::vector<std::unique_ptr<AudioDecoderBase>> decoders_;
+  std::vector<kernels::signal::resampling::Args> args_;
+
+  TensorList<CPUBackend> decoded_cpu_, sample_rates_cpu_;
+  TensorList<GPUBackend> decoded_gpu_, downmixed_gpu_;
+  kernels::signal::DownmixGPU<float, float> downmix_kernel_;
+  kernels::KernelManager kmgr_;
+  /// Recorded when the host buffers are no longer used by the copies
+  CUDAEvent copy_done_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_AUDIO_AUDIO_DECODER_MIXED_OP_H_
@@ -29,6 +29,12 @@ This operator produces the following outputs:
 
 * output[0]: A batch of decoded data
 * output[1]: A batch of sampling rates [Hz].
+
+With the ``mixed`` backend, the audio is decoded on the CPU and copied to the GPU once, at its
+original sampling rate. The downmixing, the resampling and the conversion to ``dtype`` are done
+on the GPU for the whole batch. When the sampling rates are integers and their ratio has a small
+denominator (e.g. 48 kHz to 16 kHz or 44.1 kHz to 16 kHz), the resampling uses the filter
+coefficients precomputed for each output phase.
 )code")
   .NumInput(1)
   .NumOutput(2)
@@ -46,7 +52,16 @@ Supported types: ``INT16``, ``INT32``, ``FLOAT``.)code", DALI_FLOAT)
 the highest.
 
 0 gives 3 lobes of the sinc filter, 50 gives 16 lobes, and 100 gives 64 lobes.)code",
-          50.0f, false);
+          50.0f, false)
+  .AddOptionalArg("offset", R"code(The offset, in seconds, of the decoded part of the recording.
+
+Only the requested part is decoded - the decoder seeks to the offset, without decoding
+the preceding samples.)code", 0.0f, true)
+  .AddOptionalArg("duration", R"code(The duration, in seconds, of the decoded part of
+the recording.
+
+A negative value means that the recording is decoded until its end. The duration is limited
+to the end of the recording.)code", -1.0f, true);
 
 
 DALI_REGISTER_OPERATOR(AudioDecoder, AudioDecoderCpu, CPU);
@@ -68,6 +83,8 @@ AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const workspace
   auto &input = ws.template Input<Backend>(0);
   const auto batch_size = input.shape().num_samples();
   GetPerSampleArgument<float>(target_sample_rates_, "sample_rate", ws, batch_size);
+  GetPerSampleArgument<float>(offsets_sec_, "offset", ws, batch_size);
+  GetPerSampleArgument<float>(durations_sec_, "duration", ws, batch_size);
 
   for (int i = 0; i < batch_size; i++) {
     DALI_ENFORCE(input.shape()[i].size() == 1, "Raw input must be 1D encoded byte data");
@@ -76,6 +93,7 @@ AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const workspace
   decoders_.resize(batch_size);
   sample_meta_.resize(batch_size);
   files_names_.resize(batch_size);
+  offsets_.resize(batch_size);
 
   decode_type_ = use_resampling_ ? DALI_FLOAT : output_type_;
   for (int i = 0; i < batch_size; i++)
@@ -90,6 +108,9 @@ AudioDecoderCpu::SetupImpl(std::vector<OutputDesc> &output_desc, const workspace
     auto &meta = sample_meta_[i] =
         decoders_[i]->Open({static_cast<const char *>(input.raw_tensor(i)),
                             input.tensor_shape(i).num_elements()});
+    // the length of the decoded part of the recording
+    std::tie(offsets_[i], meta.length) =
+        ProcessOffsetAndLength(meta, offsets_sec_[i], durations_sec_[i]);
     TensorShape<> data_sample_shape = DecodedAudioShape(
         meta, use_resampling_ ? target_sample_rates_[i] : -1.0f, downmix_);
     shape_data.set_tensor_shape(i, data_sample_shape);
@@ -127,7 +148,11 @@ AudioDecoderCpu::DecodeSample(const TensorView<StorageCPU, OutputType, DynamicDi
   auto &scratch_resampler = scratch_resampler_[thread_idx];
   scratch_resampler.resize(resample_scratch_sz);
 
-  // TODO(janton): handle offset and duration
+  if (offsets_[sample_idx] > 0) {
+    auto pos = decoders_[sample_idx]->SeekFrames(offsets_[sample_idx], SEEK_SET);
+    DALI_ENFORCE(pos == offsets_[sample_idx],
+                 make_string("Failed to seek to the frame ", offsets_[sample_idx]));
+  }
 
   DecodeAudio<OutputType>(
     audio, *decoders_[sample_idx], meta, resampler_,
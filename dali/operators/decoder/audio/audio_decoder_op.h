@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 #include "dali/core/static_switch.h"
 #include "dali/operators/decoder/audio/audio_decoder.h"
@@ -83,6 +84,9 @@ class AudioDecoderCpu : public Operator<CPUBackend> {
   }
 
   std::vector<float> target_sample_rates_;
+  std::vector<float> offsets_sec_, durations_sec_;
+  /// The first frame of the decoded part of each recording
+  std::vector<int64_t> offsets_;
   kernels::signal::resampling::ResamplerCPU resampler_;
   DALIDataType output_type_ = DALI_NO_TYPE, decode_type_ = DALI_NO_TYPE;
   const bool downmix_ = false, use_resampling_ = false;
@@ -32,11 +32,18 @@ CachedDecoderImpl::CachedDecoderImpl(const OpSpec& spec)
     const std::size_t cache_size = cache_size_mb * 1024 * 1024;
     const std::size_t cache_threshold =
         static_cast<std::size_t>(spec.GetArgument<int>("cache_threshold"));
-    if (cache_size > 0 && cache_size >= cache_threshold) {
+    const std::string cache_dir = spec.GetArgument<std::string>("cache_dir");
+    const std::size_t cache_disk_size =
+        static_cast<std::size_t>(spec.GetArgument<int>("cache_disk_size")) * 1024 * 1024;
+    const std::size_t cache_host_size =
+        static_cast<std::size_t>(spec.GetArgument<int>("cache_host_size")) * 1024 * 1024;
+    const bool memory_cache = cache_size > 0 && cache_size >= cache_threshold;
+    if (memory_cache || !cache_dir.empty()) {
       const std::string cache_type = spec.GetArgument<std::string>("cache_type");
       const bool cache_debug = spec.GetArgument<bool>("cache_debug");
       cache_ = ImageCacheFactory::Instance().Get(
-        device_id_, cache_type, cache_size, cache_debug, cache_threshold);
+        device_id_, cache_type, memory_cache ? cache_size : 0, cache_debug, cache_threshold,
+        cache_dir, cache_disk_size, cache_host_size);
 
       use_batch_copy_kernel_ = spec.GetArgument<bool>("cache_batch_copy");
       auto batch_size = spec.GetArgument<int>("max_batch_size");
@@ -59,8 +66,12 @@ bool CachedDecoderImpl::DeferCacheLoad(const std::string& file_name, uint8_t *ou
   if (!cache_ || file_name.empty())
     return false;
   auto img = cache_->Get(file_name);
-  if (!img.data)
-    return false;
+  if (!img.data) {
+    if (!cache_->IsCached(file_name))
+      return false;
+    deferred_reads_.emplace_back(file_name, output_data);
+    return true;
+  }
   scatter_gather_->AddCopy(output_data, img.data, img.num_elements());
   return true;
 }
@@ -74,6 +85,11 @@ void CachedDecoderImpl::LoadDeferred(cudaStream_t stream) {
   auto copy_method = use_batch_copy_kernel_ ? Method::Default
                                             : Method::Memcpy;
   CUDA_CALL((scatter_gather_->Run(stream, true, copy_method), cudaGetLastError()));
+
+  for (auto &read : deferred_reads_)
+    DALI_ENFORCE(cache_->Read(read.first, read.second, stream),
+                 "cache entry [" + read.first + "] not found");
+  deferred_reads_.clear();
 }
 
 ImageCache::ImageShape CachedDecoderImpl::CacheImageShape(const std::string& file_name) {
@@ -108,7 +124,8 @@ longer needs to be decoded when it is encountered at the operator input saving p
   .AddOptionalArg("cache_debug",
       R"code(Applies **only** to the ``mixed`` backend type.
 
-Prints the debug information about the decoder cache.)code",
+Prints the debug information about the decoder cache. For the ``adaptive`` policy, these are the
+hit rate and the numbers of the hits (in GPU and in host memory), misses and evictions.)code",
       false)
   .AddOptionalArg("cache_batch_copy",
       R"code(Applies **only** to the ``mixed`` backend type.
@@ -117,6 +134,34 @@ If set to True, multiple images from the cache are copied with a batched copy ke
 Otherwise, unless the order in the batch is the same as in the cache, each image is
 copied with ``cudaMemcpy``.)code",
       true)
+  .AddOptionalArg("cache_dir",
+      R"code(Applies **only** to the ``mixed`` backend type.
+
+A directory (preferably on a fast local drive) where the decoded images are stored. Unlike the
+cache in GPU memory, it persists between the runs: the images decoded once are read from there in
+the subsequent epochs and jobs using the same directory, skipping the decoding.
+
+The images smaller than ``cache_threshold`` are not stored. When ``cache_size`` is also given,
+the cache in GPU memory is used first, and the images found only on disk are copied to it.
+
+.. note::
+  The cache is keyed by the source info of the images (their file names), so it should only be
+  reused with the same dataset and the same decoding parameters.
+)code",
+      std::string())
+  .AddOptionalArg("cache_disk_size",
+      R"code(Applies **only** to the ``mixed`` backend type.
+
+Maximum size of the data stored in ``cache_dir``, in megabytes. 0 means no limit.
+)code",
+      0)
+  .AddOptionalArg("cache_host_size",
+      R"code(Applies **only** to the ``mixed`` backend type and the ``adaptive`` cache type.
+
+Size, in megabytes, of the pinned host memory where the images evicted from the cache in GPU
+memory are kept. Such images are copied back to the output, instead of being decoded again.
+)code",
+      0)
   .AddOptionalArg("cache_type",
       R"code(Applies **only** to the ``mixed`` backend type.
 
@@ -128,6 +173,11 @@ Here is a list of the available cache types:
   The warm-up time for threshold policy is 1 epoch.
 * | ``largest``: stores the largest images that can fit in the cache.
   | The warm-up time for largest policy is 2 epochs
+* | ``adaptive``: keeps the images that are read often or were added recently, evicting the
+  | others when the cache is full (adaptive replacement cache). The division between the
+  | recent and the frequent images adapts to the access pattern, which suits random sampling
+  | with replacement or a changing subset of the dataset. The evicted images can be kept in host
+  | memory, see ``cache_host_size``.
 
   .. note::
     To take advantage of caching, it is recommended to configure readers with `stick_to_shard=True`
@@ -18,6 +18,8 @@
 #include <cuda_runtime_api.h>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 #include "dali/operators/decoder/cache/image_cache.h"
 #include "dali/pipeline/operator/op_spec.h"
 
@@ -61,6 +63,8 @@ class CachedDecoderImpl {
   std::unique_ptr<kernels::ScatterGatherGPU> scatter_gather_;
   int device_id_;
   bool use_batch_copy_kernel_ = true;
+  // the images which are not in GPU memory (e.g. only in the disk cache), read in LoadDeferred
+  std::vector<std::pair<std::string, uint8_t *>> deferred_reads_;
 };
 
 }  // namespace dali
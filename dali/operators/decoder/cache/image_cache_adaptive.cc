@@ -0,0 +1,341 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_adaptive.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <utility>
+#include "dali/core/error_handling.h"
+#include "dali/pipeline/data/backend.h"
+
+namespace dali {
+
+ImageCacheAdaptive::ImageCacheAdaptive(std::size_t cache_size,
+                                       std::size_t host_size,
+                                       std::size_t image_size_threshold,
+                                       bool stats_enabled)
+    : cache_size_(cache_size)
+    , host_size_(host_size)
+    , image_size_threshold_(image_size_threshold)
+    , stats_enabled_(stats_enabled) {
+  DALI_ENFORCE(image_size_threshold <= cache_size_, "Cache size should fit at least one image");
+  LOG_LINE << "cache size is " << cache_size_ / (1024 * 1024) << " MB, host memory size is "
+           << host_size_ / (1024 * 1024) << " MB" << std::endl;
+
+  CUDA_CALL(cudaStreamCreateWithPriority(&cache_stream_, cudaStreamNonBlocking, 0));
+  CUDA_CALL(cudaEventCreate(&cache_read_event_));
+  CUDA_CALL(cudaEventCreate(&cache_write_event_));
+}
+
+ImageCacheAdaptive::~ImageCacheAdaptive() {
+  if (stats_enabled_) print_stats();
+
+  // the memory is freed in cache_stream_
+  entries_.clear();
+  CUDA_CALL(cudaStreamSynchronize(cache_stream_));
+  CUDA_CALL(cudaEventDestroy(cache_read_event_));
+  CUDA_CALL(cudaEventDestroy(cache_write_event_));
+  CUDA_CALL(cudaStreamDestroy(cache_stream_));
+}
+
+bool ImageCacheAdaptive::IsCached(const ImageKey& image_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.find(image_key) != entries_.end();
+}
+
+const ImageCache::ImageShape& ImageCacheAdaptive::GetShape(const ImageKey& image_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = entries_.find(image_key);
+  DALI_ENFORCE(it != entries_.end(), "cache entry [" + image_key + "] not found");
+  it->second.reserved++;
+  return it->second.shape;
+}
+
+bool ImageCacheAdaptive::Read(const ImageKey& image_key,
+                              void* destination_data,
+                              cudaStream_t stream) const {
+  DALI_ENFORCE(!image_key.empty());
+  DALI_ENFORCE(destination_data != nullptr);
+  std::lock_guard<std::mutex> lock(mutex_);
+  LOG_LINE << "Read: image_key[" << image_key << "]" << std::endl;
+  const auto it = entries_.find(image_key);
+  if (it == entries_.end())
+    return false;
+  auto &entry = it->second;
+  if (entry.reserved > 0)
+    entry.reserved--;
+
+  SyncToRead(stream);
+  if (entry.list != kHost) {
+    MemCopy(destination_data, entry.gpu_data.get(), entry.size, stream);
+    SyncAfterAccess(stream);
+    Unlink(entry);
+    Link(entry, image_key, kFrequent);
+    stats_.gpu_hits++;
+    return true;
+  }
+
+  MemCopy(destination_data, entry.host_data.get(), entry.size, stream);
+  SyncAfterAccess(stream);
+  stats_.host_hits++;
+  // The image was evicted from GPU memory, so it's a hit in the respective ghost list;
+  // bring it back, copying from the destination.
+  Adapt(entry.origin, entry.size);
+  Unlink(entry);
+  if (StoreInGPU(entry, static_cast<const uint8_t *>(destination_data),
+                 entry.origin == kFrequent, stream)) {
+    entry.host_data.reset();  // freed in cache_stream_, after the copy above
+    Link(entry, image_key, kFrequent);
+  } else {
+    EvictFromHost(entry.size);
+    Link(entry, image_key, kHost);
+  }
+  return true;
+}
+
+ImageCache::DecodedImage ImageCacheAdaptive::Get(const ImageKey &) const {
+  return {};
+}
+
+void ImageCacheAdaptive::Add(const ImageKey& image_key, const uint8_t *data,
+                             const ImageShape& data_shape, cudaStream_t stream) {
+  const std::size_t data_size = volume(data_shape);
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.misses++;
+  if (data_size == 0 || data_size < image_size_threshold_ || data_size > cache_size_)
+    return;
+  DALI_ENFORCE(!image_key.empty());
+  if (entries_.find(image_key) != entries_.end())
+    return;
+
+  ListId list = kRecent;
+  bool frequent_hit = false;
+  auto ghost_it = ghosts_.find(image_key);
+  if (ghost_it != ghosts_.end()) {
+    auto &ghost = ghost_it->second;
+    Adapt(ghost.list, data_size);
+    frequent_hit = ghost.list == kFrequent;
+    ghost_lists_[ghost.list].erase(ghost.pos);
+    ghost_bytes_[ghost.list] -= ghost.size;
+    ghosts_.erase(ghost_it);
+    list = kFrequent;
+    stats_.ghost_hits++;
+  }
+
+  Entry entry;
+  entry.shape = data_shape;
+  entry.size = data_size;
+  if (!StoreInGPU(entry, data, frequent_hit, stream)) {
+    LOG_LINE << "WARNING: not enough space in cache. Ignore" << std::endl;
+    return;
+  }
+  auto &stored = entries_[image_key];
+  stored = std::move(entry);
+  Link(stored, image_key, list);
+  TrimGhosts();
+}
+
+void ImageCacheAdaptive::SyncToRead(cudaStream_t stream) const {
+  // synchronizing with cache instance stream with provided stream
+  CUDA_CALL(cudaEventRecord(cache_read_event_, cache_stream_));
+  CUDA_CALL(cudaStreamWaitEvent(stream, cache_read_event_, 0));
+}
+
+void ImageCacheAdaptive::SyncAfterAccess(cudaStream_t stream) const {
+  // the memory is not freed (in cache_stream_) before the pending accesses in `stream`
+  CUDA_CALL(cudaEventRecord(cache_write_event_, stream));
+  CUDA_CALL(cudaStreamWaitEvent(cache_stream_, cache_write_event_, 0));
+}
+
+void ImageCacheAdaptive::Link(Entry &entry, const ImageKey &key, ListId list) const {
+  lists_[list].push_front(key);
+  entry.pos = lists_[list].begin();
+  entry.list = list;
+  list_bytes_[list] += entry.size;
+  if (list == kHost)
+    host_origin_bytes_[entry.origin] += entry.size;
+}
+
+void ImageCacheAdaptive::Unlink(Entry &entry) const {
+  lists_[entry.list].erase(entry.pos);
+  list_bytes_[entry.list] -= entry.size;
+  if (entry.list == kHost)
+    host_origin_bytes_[entry.origin] -= entry.size;
+}
+
+void ImageCacheAdaptive::Adapt(ListId ghost_list, std::size_t size) const {
+  // the images in host memory are evicted from GPU memory, like the ghosts
+  std::size_t recent = ghost_bytes_[kRecent] + host_origin_bytes_[kRecent];
+  std::size_t frequent = ghost_bytes_[kFrequent] + host_origin_bytes_[kFrequent];
+  if (ghost_list == kRecent) {
+    std::size_t delta = recent > 0 && frequent > recent ? size * frequent / recent : size;
+    target_recent_ = std::min(cache_size_, target_recent_ + delta);
+  } else {
+    std::size_t delta = frequent > 0 && recent > frequent ? size * recent / frequent : size;
+    target_recent_ = target_recent_ > delta ? target_recent_ - delta : 0;
+  }
+}
+
+bool ImageCacheAdaptive::MakeRoom(std::size_t size, bool frequent_hit) const {
+  if (size > cache_size_)
+    return false;
+  while (list_bytes_[kRecent] + list_bytes_[kFrequent] + size > cache_size_) {
+    std::size_t recent = list_bytes_[kRecent];
+    bool from_recent = recent > 0 && (recent > target_recent_ ||
+                                      (frequent_hit && recent == target_recent_) ||
+                                      list_bytes_[kFrequent] == 0);
+    ListId first = from_recent ? kRecent : kFrequent;
+    ListId second = from_recent ? kFrequent : kRecent;
+    if (!EvictFrom(first) && !EvictFrom(second))
+      return false;
+  }
+  return true;
+}
+
+bool ImageCacheAdaptive::EvictFrom(ListId list) const {
+  auto &keys = lists_[list];
+  for (auto key_it = keys.rbegin(); key_it != keys.rend(); ++key_it) {
+    auto it = entries_.find(*key_it);
+    assert(it != entries_.end());
+    if (it->second.reserved > 0)
+      continue;
+    ImageKey key = *key_it;  // the list node is removed
+    Unlink(it->second);
+    stats_.evictions++;
+    Demote(it->second, key);
+    return true;
+  }
+  return false;
+}
+
+void ImageCacheAdaptive::Demote(Entry &entry, const ImageKey &key) const {
+  if (entry.size <= host_size_) {
+    EvictFromHost(entry.size);
+    if (list_bytes_[kHost] + entry.size <= host_size_) {
+      try {
+        entry.host_data = mm::alloc_raw_async_unique<uint8_t, mm::memory_kind::pinned>(
+            entry.size, cache_stream_, cache_stream_);
+      } catch (const std::bad_alloc &) {
+        entry.host_data.reset();
+      }
+    }
+    if (entry.host_data) {
+      MemCopy(entry.host_data.get(), entry.gpu_data.get(), entry.size, cache_stream_);
+      entry.gpu_data.reset();  // freed in cache_stream_, after the copy
+      entry.origin = entry.list;
+      Link(entry, key, kHost);
+      stats_.spills++;
+      return;
+    }
+  }
+  AddGhost(key, entry.list, entry.size);
+  entries_.erase(key);
+}
+
+void ImageCacheAdaptive::EvictFromHost(std::size_t size) const {
+  auto &keys = lists_[kHost];
+  auto pos = keys.end();
+  while (list_bytes_[kHost] + size > host_size_ && pos != keys.begin()) {
+    --pos;
+    auto it = entries_.find(*pos);
+    assert(it != entries_.end());
+    auto &entry = it->second;
+    if (entry.reserved > 0)
+      continue;
+    pos = std::next(pos);  // the node of the evicted image is removed
+    Unlink(entry);
+    AddGhost(it->first, entry.origin, entry.size);
+    entries_.erase(it);  // the host memory is freed in cache_stream_
+  }
+}
+
+void ImageCacheAdaptive::AddGhost(const ImageKey &key, ListId list, std::size_t size) const {
+  ghost_lists_[list].push_front(key);
+  ghosts_[key] = {size, list, ghost_lists_[list].begin()};
+  ghost_bytes_[list] += size;
+}
+
+void ImageCacheAdaptive::TrimGhosts() const {
+  auto drop_last = [&](ListId list) {
+    auto &keys = ghost_lists_[list];
+    ghost_bytes_[list] -= ghosts_[keys.back()].size;
+    ghosts_.erase(keys.back());
+    keys.pop_back();
+  };
+  // As in ARC: |T1| + |B1| <= c and |T1| + |T2| + |B1| + |B2| <= 2c
+  while (!ghost_lists_[kRecent].empty() &&
+         list_bytes_[kRecent] + ghost_bytes_[kRecent] > cache_size_)
+    drop_last(kRecent);
+  auto total = [&]() {
+    return list_bytes_[kRecent] + list_bytes_[kFrequent] +
+           ghost_bytes_[kRecent] + ghost_bytes_[kFrequent];
+  };
+  while (!ghost_lists_[kFrequent].empty() && total() > 2 * cache_size_)
+    drop_last(kFrequent);
+}
+
+bool ImageCacheAdaptive::StoreInGPU(Entry &entry, const uint8_t *data, bool frequent_hit,
+                                    cudaStream_t stream) const {
+  if (!MakeRoom(entry.size, frequent_hit))
+    return false;
+  try {
+    entry.gpu_data = mm::alloc_raw_async_unique<uint8_t, mm::memory_kind::device>(
+        entry.size, cache_stream_, cache_stream_);
+  } catch (const std::bad_alloc &) {
+    return false;
+  }
+  // the memory may have been used by the evicted images
+  SyncToRead(stream);
+  MemCopy(entry.gpu_data.get(), data, entry.size, stream);
+  SyncAfterAccess(stream);
+  return true;
+}
+
+void ImageCacheAdaptive::print_stats() const {
+  static std::mutex stats_mutex;
+  std::lock_guard<std::mutex> lock(stats_mutex);
+  std::size_t hits = stats_.gpu_hits + stats_.host_hits;
+  std::size_t accesses = hits + stats_.misses;
+  const char* log_filename = std::getenv("DALI_LOG_FILE");
+  std::ofstream log_file;
+  if (log_filename) log_file.open(log_filename);
+  std::ostream& out = log_filename ? log_file : std::cout;
+  out << "#################### CACHE STATS ####################" << std::endl;
+  out << "cache_type: adaptive" << std::endl;
+  out << "cache_size: " << cache_size_ << std::endl;
+  out << "cache_host_size: " << host_size_ << std::endl;
+  out << "cache_threshold: " << image_size_threshold_ << std::endl;
+  out << "hits_gpu: " << stats_.gpu_hits << std::endl;
+  out << "hits_host: " << stats_.host_hits << std::endl;
+  out << "misses: " << stats_.misses << std::endl;
+  out << "hit_rate: " << (accesses ? static_cast<double>(hits) / accesses : 0.0) << std::endl;
+  out << "ghost_hits: " << stats_.ghost_hits << std::endl;
+  out << "evictions: " << stats_.evictions << std::endl;
+  out << "spills_to_host: " << stats_.spills << std::endl;
+  out << "target_recent_size: " << target_recent_ << std::endl;
+  out << "images_recent: " << lists_[kRecent].size()
+      << " (" << list_bytes_[kRecent] << " bytes)" << std::endl;
+  out << "images_frequent: " << lists_[kFrequent].size()
+      << " (" << list_bytes_[kFrequent] << " bytes)" << std::endl;
+  out << "images_host: " << lists_[kHost].size()
+      << " (" << list_bytes_[kHost] << " bytes)" << std::endl;
+  out << "#################### END   STATS ####################" << std::endl;
+}
+
+}  // namespace dali
@@ -0,0 +1,191 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_ADAPTIVE_H_
+#define DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_ADAPTIVE_H_
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "dali/core/common.h"
+#include "dali/core/mm/memory.h"
+#include "dali/operators/decoder/cache/image_cache.h"
+
+namespace dali {
+
+/**
+ * @brief A cache of decoded images with an adaptive replacement policy (ARC)
+ *
+ * The GPU memory is divided between the images added recently and not read since (T1) and
+ * the images read at least once (T2). The keys of the images evicted from either list are
+ * remembered (the ghost lists B1 and B2) and adding such an image again moves the target size
+ * of T1 towards recency (B1) or frequency (B2), so the division keeps adapting to the access
+ * pattern, e.g. when sampling with replacement. A single pass over new images can only evict
+ * the images from T1.
+ *
+ * With a nonzero `host_size`, the images evicted from GPU memory are first moved to pinned host
+ * memory (evicted in LRU order) and read from there with a host-to-device copy. Such a read
+ * counts as a hit in the respective ghost list and moves the image back to GPU memory.
+ *
+ * The images can be evicted, so Get always returns an empty image - use Read.
+ * GetShape reserves the image for the subsequent Read: a reserved image is not evicted.
+ */
+class DLL_PUBLIC ImageCacheAdaptive : public ImageCache {
+ public:
+  DLL_PUBLIC ImageCacheAdaptive(std::size_t cache_size,
+                                std::size_t host_size = 0,
+                                std::size_t image_size_threshold = 0,
+                                bool stats_enabled = false);
+
+  ~ImageCacheAdaptive() override;
+
+  DISABLE_COPY_MOVE_ASSIGN(ImageCacheAdaptive);
+
+  bool IsCached(const ImageKey& image_key) const override;
+
+  bool Read(const ImageKey& image_key,
+            void* destination_data,
+            cudaStream_t stream) const override;
+
+  const ImageShape& GetShape(const ImageKey& image_key) const override;
+
+  void Add(const ImageKey& image_key,
+           const uint8_t *data,
+           const ImageShape& data_shape,
+           cudaStream_t stream) override;
+
+  /**
+   * @brief The images can be evicted - always returns an empty image; use Read
+   */
+  DecodedImage Get(const ImageKey &image_key) const override;
+
+  void SyncToRead(cudaStream_t stream) const override;
+
+  struct Stats {
+    std::size_t gpu_hits = 0;
+    std::size_t host_hits = 0;
+    std::size_t misses = 0;      // the images added, i.e. decoded
+    std::size_t ghost_hits = 0;  // the images added again after being evicted
+    std::size_t evictions = 0;   // from GPU memory
+    std::size_t spills = 0;      // to host memory
+  };
+
+  Stats GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+  /**
+   * @brief The current target size, in bytes, of the recently added images in GPU memory
+   */
+  std::size_t target_recent_size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return target_recent_;
+  }
+
+ private:
+  enum ListId : int {
+    kRecent = 0,    // T1 / B1
+    kFrequent = 1,  // T2 / B2
+    kHost = 2
+  };
+
+  struct Entry {
+    ImageShape shape;
+    std::size_t size = 0;
+    ListId list = kRecent;
+    ListId origin = kRecent;  // for the images in host memory - the list they were evicted from
+    std::list<ImageKey>::iterator pos;
+    mm::async_uptr<uint8_t> gpu_data, host_data;
+    int reserved = 0;
+  };
+
+  struct Ghost {
+    std::size_t size = 0;
+    ListId list = kRecent;
+    std::list<ImageKey>::iterator pos;
+  };
+
+  void Link(Entry &entry, const ImageKey &key, ListId list) const;
+  void Unlink(Entry &entry) const;
+
+  /**
+   * @brief Moves the target size of T1 after a hit in B1 (or in host memory with that origin)
+   *        or B2
+   */
+  void Adapt(ListId ghost_list, std::size_t size) const;
+
+  /**
+   * @brief Evicts the images from GPU memory until `size` bytes more fit in it
+   *
+   * @return false, if there is not enough space in the images which are not reserved
+   */
+  bool MakeRoom(std::size_t size, bool frequent_hit) const;
+
+  /**
+   * @brief Evicts the least recently used, not reserved image from the list
+   */
+  bool EvictFrom(ListId list) const;
+
+  /**
+   * @brief Moves the image from GPU memory to host memory, or forgets its data
+   */
+  void Demote(Entry &entry, const ImageKey &key) const;
+
+  void EvictFromHost(std::size_t size) const;
+
+  void AddGhost(const ImageKey &key, ListId list, std::size_t size) const;
+
+  void TrimGhosts() const;
+
+  /**
+   * @brief Allocates GPU memory for the image and copies the data, ordered in `stream`
+   *
+   * @return false, if the image doesn't fit
+   */
+  bool StoreInGPU(Entry &entry, const uint8_t *data, bool frequent_hit,
+                  cudaStream_t stream) const;
+
+  void SyncAfterAccess(cudaStream_t stream) const;
+
+  void print_stats() const;
+
+  std::size_t cache_size_ = 0;
+  std::size_t host_size_ = 0;
+  std::size_t image_size_threshold_ = 0;
+  bool stats_enabled_ = false;
+
+  // the reads change the order of the images and can move them between the lists
+  mutable std::unordered_map<ImageKey, Entry> entries_;
+  mutable std::unordered_map<ImageKey, Ghost> ghosts_;
+  // front - most recently used
+  mutable std::list<ImageKey> lists_[3], ghost_lists_[2];
+  mutable std::size_t list_bytes_[3] = {0, 0, 0};
+  mutable std::size_t ghost_bytes_[2] = {0, 0};
+  // the images in host memory, by the list they were evicted from
+  mutable std::size_t host_origin_bytes_[2] = {0, 0};
+  mutable std::size_t target_recent_ = 0;
+  mutable Stats stats_;
+  mutable std::mutex mutex_;
+
+  // the memory is allocated and freed in this stream; the accesses in the other streams
+  // are ordered with it
+  cudaStream_t cache_stream_;
+  cudaEvent_t cache_read_event_;
+  cudaEvent_t cache_write_event_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_ADAPTIVE_H_
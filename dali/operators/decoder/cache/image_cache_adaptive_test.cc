@@ -0,0 +1,142 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_adaptive.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/core/cuda_error.h"
+
+namespace dali {
+namespace testing {
+
+struct ImageCacheAdaptiveTest : public ::testing::Test {
+  static constexpr int kImageSize = 10;
+
+  void SetUp() override { SetUpImpl(4 * kImageSize); }
+
+  void SetUpImpl(std::size_t cache_size, std::size_t host_size = 0) {
+    cache_.reset(new ImageCacheAdaptive(cache_size, host_size));
+  }
+
+  static std::string Key(int i) { return std::to_string(i); }
+
+  void AddImage(int i) {
+    std::vector<uint8_t> data(kImageSize, i);
+    cache_->Add(Key(i), data.data(), {kImageSize, 1, 1}, 0);
+    CUDA_CALL(cudaDeviceSynchronize());
+  }
+
+  bool IsCached(int i) { return cache_->IsCached(Key(i)); }
+
+  void ReadImage(int i) {
+    CUDA_CALL(cudaDeviceSynchronize());
+    std::vector<uint8_t> data(kImageSize);
+    ASSERT_TRUE(cache_->Read(Key(i), data.data(), 0));
+    CUDA_CALL(cudaDeviceSynchronize());
+    EXPECT_EQ(data, std::vector<uint8_t>(kImageSize, i));
+  }
+
+  std::unique_ptr<ImageCacheAdaptive> cache_;
+};
+
+TEST_F(ImageCacheAdaptiveTest, AddRead) {
+  EXPECT_FALSE(IsCached(1));
+  AddImage(1);
+  EXPECT_TRUE(IsCached(1));
+  ReadImage(1);
+  EXPECT_EQ(cache_->Get(Key(1)).data, nullptr);
+  auto stats = cache_->GetStats();
+  EXPECT_EQ(stats.gpu_hits, 1u);
+  EXPECT_EQ(stats.misses, 1u);
+}
+
+TEST_F(ImageCacheAdaptiveTest, EvictsLeastRecentlyUsed) {
+  for (int i = 0; i < 5; i++)
+    AddImage(i);
+  EXPECT_FALSE(IsCached(0));
+  for (int i = 1; i < 5; i++)
+    EXPECT_TRUE(IsCached(i));
+  EXPECT_EQ(cache_->GetStats().evictions, 1u);
+}
+
+TEST_F(ImageCacheAdaptiveTest, FrequentSurviveScan) {
+  AddImage(0);
+  AddImage(1);
+  ReadImage(0);
+  ReadImage(1);
+  // a pass over new images evicts only the images which weren't read
+  for (int i = 2; i < 10; i++)
+    AddImage(i);
+  EXPECT_TRUE(IsCached(0));
+  EXPECT_TRUE(IsCached(1));
+  EXPECT_TRUE(IsCached(9));
+  EXPECT_FALSE(IsCached(2));
+}
+
+TEST_F(ImageCacheAdaptiveTest, GhostHitAdapts) {
+  EXPECT_EQ(cache_->target_recent_size(), 0u);
+  AddImage(0);
+  ReadImage(0);
+  for (int i = 1; i < 5; i++)
+    AddImage(i);
+  EXPECT_FALSE(IsCached(1));
+  // the image evicted from the recent ones is added again
+  AddImage(1);
+  EXPECT_EQ(cache_->GetStats().ghost_hits, 1u);
+  EXPECT_GT(cache_->target_recent_size(), 0u);
+  EXPECT_TRUE(IsCached(1));
+}
+
+TEST_F(ImageCacheAdaptiveTest, HostSpill) {
+  SetUpImpl(2 * kImageSize, 2 * kImageSize);
+  for (int i = 0; i < 4; i++)
+    AddImage(i);
+  for (int i = 0; i < 4; i++)
+    EXPECT_TRUE(IsCached(i));
+  AddImage(4);
+  EXPECT_FALSE(IsCached(0));
+  auto stats = cache_->GetStats();
+  EXPECT_EQ(stats.evictions, 3u);
+  EXPECT_EQ(stats.spills, 3u);
+
+  // read from host memory and moved back to GPU memory
+  ReadImage(1);
+  stats = cache_->GetStats();
+  EXPECT_EQ(stats.host_hits, 1u);
+  EXPECT_EQ(stats.gpu_hits, 0u);
+  ReadImage(1);
+  EXPECT_EQ(cache_->GetStats().gpu_hits, 1u);
+  for (int i = 1; i < 5; i++)
+    EXPECT_TRUE(IsCached(i));
+}
+
+TEST_F(ImageCacheAdaptiveTest, ReservedNotEvicted) {
+  AddImage(0);
+  EXPECT_EQ(cache_->GetShape(Key(0)), TensorShape<3>(kImageSize, 1, 1));
+  for (int i = 1; i < 10; i++)
+    AddImage(i);
+  EXPECT_TRUE(IsCached(0));
+  ReadImage(0);
+}
+
+TEST_F(ImageCacheAdaptiveTest, TooLarge) {
+  std::vector<uint8_t> data(5 * kImageSize);
+  cache_->Add("large", data.data(), {5 * kImageSize, 1, 1}, 0);
+  EXPECT_FALSE(cache_->IsCached("large"));
+}
+
+}  // namespace testing
+}  // namespace dali
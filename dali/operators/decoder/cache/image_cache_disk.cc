@@ -0,0 +1,259 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_disk.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/pipeline/data/backend.h"
+
+namespace dali {
+
+namespace {
+
+constexpr char kIndexMagic[8] = {'D', 'A', 'L', 'I', 'I', 'M', 'C', '1'};
+constexpr char kIndexFile[] = "index.bin";
+constexpr char kDataFile[] = "images.bin";
+
+// Followed by `key_size` bytes of the key
+struct IndexRecord {
+  uint32_t key_size;
+  uint32_t reserved;
+  int64_t offset;
+  int64_t shape[3];
+};
+
+std::string ErrnoString(const std::string &what) {
+  return make_string(what, ": ", std::strerror(errno));
+}
+
+class FileLock {
+ public:
+  FileLock(int fd, int op) : fd_(fd) {
+    int ret;
+    do {
+      ret = flock(fd_, op);
+    } while (ret != 0 && errno == EINTR);
+    DALI_ENFORCE(ret == 0, ErrnoString("Failed to lock the decoder cache index"));
+  }
+
+  ~FileLock() {
+    flock(fd_, LOCK_UN);
+  }
+
+ private:
+  int fd_;
+};
+
+void WriteAll(int fd, const void *data, size_t size, off_t offset) {
+  auto *ptr = static_cast<const uint8_t *>(data);
+  while (size > 0) {
+    ssize_t n = pwrite(fd, ptr, size, offset);
+    if (n < 0 && errno == EINTR)
+      continue;
+    DALI_ENFORCE(n > 0, ErrnoString("Failed to write to the decoder cache"));
+    ptr += n;
+    size -= n;
+    offset += n;
+  }
+}
+
+size_t FileSize(int fd) {
+  struct stat st;
+  DALI_ENFORCE(fstat(fd, &st) == 0, ErrnoString("Failed to stat the decoder cache"));
+  return st.st_size;
+}
+
+}  // namespace
+
+ImageCacheDisk::ImageCacheDisk(const std::string &cache_dir,
+                               std::size_t cache_size,
+                               std::size_t image_size_threshold)
+    : cache_dir_(cache_dir)
+    , cache_size_(cache_size)
+    , image_size_threshold_(image_size_threshold) {
+  DALI_ENFORCE(!cache_dir_.empty(), "The decoder cache directory cannot be empty");
+  if (mkdir(cache_dir_.c_str(), 0755) != 0 && errno != EEXIST)
+    DALI_FAIL(ErrnoString("Failed to create the decoder cache directory " + cache_dir_));
+
+  auto index_path = cache_dir_ + "/" + kIndexFile;
+  auto data_path = cache_dir_ + "/" + kDataFile;
+  index_fd_ = open(index_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  DALI_ENFORCE(index_fd_ >= 0, ErrnoString("Failed to open " + index_path));
+  data_fd_ = open(data_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (data_fd_ < 0) {
+    close(index_fd_);
+    DALI_FAIL(ErrnoString("Failed to open " + data_path));
+  }
+  try {
+    LoadIndex();
+  } catch (...) {
+    close(index_fd_);
+    close(data_fd_);
+    throw;
+  }
+  LOG_LINE << "disk cache " << cache_dir_ << ": " << cache_.size() << " images, "
+           << data_size_ / (1024 * 1024) << " MB" << std::endl;
+}
+
+ImageCacheDisk::~ImageCacheDisk() {
+  if (mapping_)
+    munmap(mapping_, mapping_size_);
+  close(index_fd_);
+  close(data_fd_);
+}
+
+void ImageCacheDisk::LoadIndex() {
+  FileLock lock(index_fd_, LOCK_EX);
+  size_t index_size = FileSize(index_fd_);
+  if (index_size == 0) {
+    WriteAll(index_fd_, kIndexMagic, sizeof(kIndexMagic), 0);
+    return;
+  }
+
+  std::vector<char> index(index_size);
+  size_t pos = 0;
+  while (pos < index_size) {
+    ssize_t n = pread(index_fd_, index.data() + pos, index_size - pos, pos);
+    if (n < 0 && errno == EINTR)
+      continue;
+    DALI_ENFORCE(n > 0, ErrnoString("Failed to read the decoder cache index"));
+    pos += n;
+  }
+  DALI_ENFORCE(index_size >= sizeof(kIndexMagic) &&
+               !memcmp(index.data(), kIndexMagic, sizeof(kIndexMagic)),
+               make_string(cache_dir_, " does not contain a decoder cache or it was created by "
+                           "an incompatible version"));
+
+  // A process may have died in the middle of an append - the records past the data that
+  // is actually in the file are ignored
+  size_t data_file_size = FileSize(data_fd_);
+  pos = sizeof(kIndexMagic);
+  while (pos + sizeof(IndexRecord) <= index_size) {
+    IndexRecord record;
+    memcpy(&record, index.data() + pos, sizeof(record));
+    pos += sizeof(record);
+    if (pos + record.key_size > index_size)
+      break;
+    ImageKey key(index.data() + pos, record.key_size);
+    pos += record.key_size;
+    ImageShape shape{record.shape[0], record.shape[1], record.shape[2]};
+    size_t end = record.offset + volume(shape);
+    if (record.offset < 0 || end > data_file_size)
+      break;
+    cache_.emplace(std::move(key), Entry{record.offset, shape});
+    data_size_ = std::max(data_size_, end);
+  }
+}
+
+bool ImageCacheDisk::IsCached(const ImageKey& image_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.find(image_key) != cache_.end();
+}
+
+const ImageCache::ImageShape& ImageCacheDisk::GetShape(const ImageKey& image_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = cache_.find(image_key);
+  DALI_ENFORCE(it != cache_.end(), "cache entry [" + image_key + "] not found");
+  return it->second.shape;
+}
+
+const uint8_t *ImageCacheDisk::MapData(std::size_t end) const {
+  if (end <= mapping_size_)
+    return mapping_;
+  if (mapping_) {
+    // Pending host-to-device copies are not affected - a copy from pageable memory is staged
+    // before cudaMemcpyAsync returns
+    munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+  }
+  size_t size = FileSize(data_fd_);
+  DALI_ENFORCE(size >= end, "The decoder cache data file was truncated");
+  void *ptr = mmap(nullptr, size, PROT_READ, MAP_SHARED, data_fd_, 0);
+  DALI_ENFORCE(ptr != MAP_FAILED, ErrnoString("Failed to map the decoder cache"));
+  mapping_ = static_cast<uint8_t *>(ptr);
+  mapping_size_ = size;
+  return mapping_;
+}
+
+bool ImageCacheDisk::Read(const ImageKey& image_key,
+                          void* destination_buffer,
+                          cudaStream_t stream) const {
+  DALI_ENFORCE(!image_key.empty());
+  DALI_ENFORCE(destination_buffer != nullptr);
+  std::lock_guard<std::mutex> lock(mutex_);
+  LOG_LINE << "Read: image_key[" << image_key << "]" << std::endl;
+  const auto it = cache_.find(image_key);
+  if (it == cache_.end())
+    return false;
+  const auto &entry = it->second;
+  const auto n = volume(entry.shape);
+  const uint8_t *data = MapData(entry.offset + n);
+  MemCopy(destination_buffer, data + entry.offset, n, stream);
+  return true;
+}
+
+ImageCache::DecodedImage ImageCacheDisk::Get(const ImageKey &image_key) const {
+  return {};
+}
+
+void ImageCacheDisk::Add(const ImageKey& image_key, const uint8_t *data,
+                         const ImageShape& data_shape, cudaStream_t stream) {
+  const std::size_t data_size = volume(data_shape);
+  if (data_size < image_size_threshold_) return;
+  DALI_ENFORCE(!image_key.empty());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (cache_.find(image_key) != cache_.end())
+    return;
+  if (cache_size_ > 0 && data_size_ + data_size > cache_size_) {
+    LOG_LINE << "WARNING: not enough space in the disk cache. Ignore" << std::endl;
+    return;
+  }
+
+  std::vector<uint8_t> host(data_size);
+  MemCopy(host.data(), data, data_size, stream);
+  CUDA_CALL(cudaStreamSynchronize(stream));
+
+  IndexRecord record{};
+  record.key_size = image_key.size();
+  for (int d = 0; d < 3; d++)
+    record.shape[d] = data_shape[d];
+  std::vector<char> index_entry(sizeof(record) + image_key.size());
+
+  FileLock file_lock(index_fd_, LOCK_EX);
+  // other processes may have appended to the files since they were opened
+  record.offset = FileSize(data_fd_);
+  WriteAll(data_fd_, host.data(), data_size, record.offset);
+  memcpy(index_entry.data(), &record, sizeof(record));
+  memcpy(index_entry.data() + sizeof(record), image_key.data(), image_key.size());
+  // the index record is added after the data, so that it never describes missing data
+  WriteAll(index_fd_, index_entry.data(), index_entry.size(), FileSize(index_fd_));
+
+  cache_[image_key] = {record.offset, data_shape};
+  data_size_ = record.offset + data_size;
+}
+
+}  // namespace dali
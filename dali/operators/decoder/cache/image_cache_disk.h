@@ -0,0 +1,102 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_DISK_H_
+#define DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_DISK_H_
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "dali/core/common.h"
+#include "dali/operators/decoder/cache/image_cache.h"
+
+namespace dali {
+
+/**
+ * @brief A persistent cache of decoded images, kept in files in a directory
+ *
+ * The images are appended to a data file and described by the records (key, shape, offset)
+ * of an index file, so the cache outlives the process and is reused by the subsequent runs
+ * using the same directory. The data file is memory-mapped and the images are copied
+ * directly from the mapping.
+ *
+ * The files are appended under an exclusive file lock, so several processes (e.g. one per GPU)
+ * can share the directory; the images added by the others after the cache has been opened are
+ * not visible until it's opened again. Nothing is evicted - once the data reaches `cache_size`
+ * bytes (if nonzero), new images are not added.
+ */
+class DLL_PUBLIC ImageCacheDisk : public ImageCache {
+ public:
+  DLL_PUBLIC ImageCacheDisk(const std::string &cache_dir,
+                            std::size_t cache_size = 0,
+                            std::size_t image_size_threshold = 0);
+
+  ~ImageCacheDisk() override;
+
+  DISABLE_COPY_MOVE_ASSIGN(ImageCacheDisk);
+
+  bool IsCached(const ImageKey& image_key) const override;
+
+  bool Read(const ImageKey& image_key,
+            void* destination_data,
+            cudaStream_t stream) const override;
+
+  const ImageShape& GetShape(const ImageKey& image_key) const override;
+
+  void Add(const ImageKey& image_key,
+           const uint8_t *data,
+           const ImageShape& data_shape,
+           cudaStream_t stream) override;
+
+  /**
+   * @brief The images are not in GPU memory - always returns an empty image; use Read
+   */
+  DecodedImage Get(const ImageKey &image_key) const override;
+
+  void SyncToRead(cudaStream_t stream) const override {}
+
+  inline std::size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.size();
+  }
+
+ private:
+  struct Entry {
+    int64_t offset;
+    ImageShape shape;
+  };
+
+  void LoadIndex();
+
+  /**
+   * @brief Returns the mapping of the data file, remapping it if it doesn't cover `end` bytes
+   */
+  const uint8_t *MapData(std::size_t end) const;
+
+  std::string cache_dir_;
+  std::size_t cache_size_ = 0;
+  std::size_t image_size_threshold_ = 0;
+  int data_fd_ = -1;
+  int index_fd_ = -1;
+  std::size_t data_size_ = 0;
+  mutable uint8_t *mapping_ = nullptr;
+  mutable std::size_t mapping_size_ = 0;
+
+  std::unordered_map<ImageKey, Entry> cache_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_DISK_H_
@@ -0,0 +1,129 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_disk.h"
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "dali/operators/decoder/cache/image_cache_blob.h"
+#include "dali/operators/decoder/cache/image_cache_tiered.h"
+
+namespace dali {
+namespace testing {
+
+const char kDiskKey1[] = "file1.jpg";
+const char kDiskKey2[] = "file2.jpg";
+const std::vector<uint8_t> kDiskValue1(300, 0xAA);
+const std::vector<uint8_t> kDiskValue2(600, 0x55);
+const ImageCache::ImageShape kDiskShape1{100, 1, 3};
+const ImageCache::ImageShape kDiskShape2{10, 20, 3};
+
+struct ImageCacheDiskTest : public ::testing::Test {
+  void SetUp() override {
+    char dir[] = "/tmp/dali_image_cache_disk_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    dir_ = dir;
+  }
+
+  void TearDown() override {
+    unlink((dir_ + "/index.bin").c_str());
+    unlink((dir_ + "/images.bin").c_str());
+    rmdir(dir_.c_str());
+  }
+
+  std::string dir_;
+};
+
+TEST_F(ImageCacheDiskTest, AddRead) {
+  ImageCacheDisk cache(dir_);
+  EXPECT_FALSE(cache.IsCached(kDiskKey1));
+  cache.Add(kDiskKey1, &kDiskValue1[0], kDiskShape1, 0);
+  cache.Add(kDiskKey2, &kDiskValue2[0], kDiskShape2, 0);
+  EXPECT_TRUE(cache.IsCached(kDiskKey1));
+  EXPECT_EQ(cache.GetShape(kDiskKey2), kDiskShape2);
+  std::vector<uint8_t> cached_data(kDiskValue1.size());
+  EXPECT_TRUE(cache.Read(kDiskKey1, &cached_data[0], 0));
+  EXPECT_EQ(kDiskValue1, cached_data);
+  // not in GPU memory
+  EXPECT_EQ(cache.Get(kDiskKey1).data, nullptr);
+}
+
+TEST_F(ImageCacheDiskTest, Persistent) {
+  {
+    ImageCacheDisk cache(dir_);
+    cache.Add(kDiskKey1, &kDiskValue1[0], kDiskShape1, 0);
+  }
+  ImageCacheDisk cache(dir_);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.GetShape(kDiskKey1), kDiskShape1);
+  cache.Add(kDiskKey2, &kDiskValue2[0], kDiskShape2, 0);
+  std::vector<uint8_t> cached_data(kDiskValue2.size());
+  EXPECT_TRUE(cache.Read(kDiskKey2, &cached_data[0], 0));
+  EXPECT_EQ(kDiskValue2, cached_data);
+  cached_data.resize(kDiskValue1.size());
+  EXPECT_TRUE(cache.Read(kDiskKey1, &cached_data[0], 0));
+  EXPECT_EQ(kDiskValue1, cached_data);
+}
+
+TEST_F(ImageCacheDiskTest, TruncatedData) {
+  {
+    ImageCacheDisk cache(dir_);
+    cache.Add(kDiskKey1, &kDiskValue1[0], kDiskShape1, 0);
+    cache.Add(kDiskKey2, &kDiskValue2[0], kDiskShape2, 0);
+  }
+  // as if the process died while writing the second image
+  ASSERT_EQ(truncate((dir_ + "/images.bin").c_str(), kDiskValue1.size() + 10), 0);
+  ImageCacheDisk cache(dir_);
+  EXPECT_TRUE(cache.IsCached(kDiskKey1));
+  EXPECT_FALSE(cache.IsCached(kDiskKey2));
+}
+
+TEST_F(ImageCacheDiskTest, SizeAndThreshold) {
+  ImageCacheDisk cache(dir_, kDiskValue2.size(), kDiskValue1.size() + 1);
+  cache.Add(kDiskKey1, &kDiskValue1[0], kDiskShape1, 0);
+  EXPECT_FALSE(cache.IsCached(kDiskKey1));
+  cache.Add(kDiskKey2, &kDiskValue2[0], kDiskShape2, 0);
+  EXPECT_TRUE(cache.IsCached(kDiskKey2));
+  cache.Add("file3.jpg", &kDiskValue2[0], kDiskShape2, 0);
+  EXPECT_FALSE(cache.IsCached("file3.jpg"));
+}
+
+TEST_F(ImageCacheDiskTest, Tiered) {
+  {
+    ImageCacheDisk cache(dir_);
+    cache.Add(kDiskKey1, &kDiskValue1[0], kDiskShape1, 0);
+  }
+  auto memory = std::make_shared<ImageCacheBlob>(1 << 12, 0);
+  auto disk = std::make_shared<ImageCacheDisk>(dir_);
+  ImageCacheTiered cache(memory, disk);
+  EXPECT_TRUE(cache.IsCached(kDiskKey1));
+  EXPECT_FALSE(memory->IsCached(kDiskKey1));
+  EXPECT_EQ(cache.GetShape(kDiskKey1), kDiskShape1);
+
+  std::vector<uint8_t> cached_data(kDiskValue1.size());
+  EXPECT_TRUE(cache.Read(kDiskKey1, &cached_data[0], 0));
+  EXPECT_EQ(kDiskValue1, cached_data);
+  // promoted to the memory tier
+  EXPECT_TRUE(memory->IsCached(kDiskKey1));
+
+  cache.Add(kDiskKey2, &kDiskValue2[0], kDiskShape2, 0);
+  EXPECT_TRUE(memory->IsCached(kDiskKey2));
+  EXPECT_TRUE(disk->IsCached(kDiskKey2));
+}
+
+}  // namespace testing
+}  // namespace dali
@@ -14,8 +14,13 @@
 
 #include "dali/operators/decoder/cache/image_cache_factory.h"
 #include <memory>
+#include <string>
+#include <utility>
+#include "dali/operators/decoder/cache/image_cache_adaptive.h"
 #include "dali/operators/decoder/cache/image_cache_blob.h"
+#include "dali/operators/decoder/cache/image_cache_disk.h"
 #include "dali/operators/decoder/cache/image_cache_largest.h"
+#include "dali/operators/decoder/cache/image_cache_tiered.h"
 
 namespace dali {
 
@@ -23,18 +28,37 @@ std::shared_ptr<ImageCache> ImageCacheFactory::Get(int device_id,
                                                    const std::string& cache_policy,
                                                    std::size_t cache_size,
                                                    bool cache_debug,
-                                                   std::size_t cache_threshold) {
+                                                   std::size_t cache_threshold,
+                                                   const std::string& cache_dir,
+                                                   std::size_t cache_disk_size,
+                                                   std::size_t cache_host_size) {
   std::lock_guard<std::mutex> lock(mutex_);
-  const CacheParams params{cache_policy, cache_size, cache_debug, cache_threshold};
+  const CacheParams params{cache_policy, cache_size, cache_debug, cache_threshold,
+                           cache_dir, cache_disk_size, cache_host_size};
   auto &instance = caches_[device_id];
   auto cache = instance.cache.lock();
   if (!cache) {
-    if (cache_policy == "threshold") {
-      cache.reset(new ImageCacheBlob(cache_size, cache_threshold, cache_debug));
-    } else if (cache_policy == "largest") {
-      cache.reset(new ImageCacheLargest(cache_size, cache_debug));
-    } else {
-      DALI_FAIL("unexpected cache policy `" + cache_policy + "`");
+    DALI_ENFORCE(cache_host_size == 0 || cache_policy == "adaptive",
+                 "The cache in host memory is supported only by the `adaptive` policy");
+    if (cache_size > 0 || cache_dir.empty()) {
+      if (cache_policy == "threshold") {
+        cache.reset(new ImageCacheBlob(cache_size, cache_threshold, cache_debug));
+      } else if (cache_policy == "largest") {
+        cache.reset(new ImageCacheLargest(cache_size, cache_debug));
+      } else if (cache_policy == "adaptive") {
+        cache.reset(new ImageCacheAdaptive(cache_size, cache_host_size, cache_threshold,
+                                           cache_debug));
+      } else {
+        DALI_FAIL("unexpected cache policy `" + cache_policy + "`");
+      }
+    }
+    if (!cache_dir.empty()) {
+      std::shared_ptr<ImageCache> disk(
+          new ImageCacheDisk(cache_dir, cache_disk_size, cache_threshold));
+      if (cache)
+        cache.reset(new ImageCacheTiered(std::move(cache), std::move(disk)));
+      else
+        cache = std::move(disk);
     }
     caches_[device_id] = {cache, params};
     return cache;
@@ -36,13 +36,21 @@ class DLL_PUBLIC ImageCacheFactory {
    * are the same.
    * Will fail if the cache was already allocated but with different
    * parameters
+   * If `cache_dir` is not empty, the images are also kept on disk, in that directory
+   * (at most `cache_disk_size` bytes, unless it's 0), and persist between the runs.
+   * With `cache_size` equal to 0, only the disk is used.
+   * `cache_host_size` is the size of the pinned host memory to which the `adaptive` policy
+   * moves the images evicted from GPU memory.
    */
   DLL_PUBLIC std::shared_ptr<ImageCache> Get(
     int device_id,
     const std::string& cache_policy,
     std::size_t cache_size,
     bool cache_debug = false,
-    std::size_t cache_threshold = 0);
+    std::size_t cache_threshold = 0,
+    const std::string& cache_dir = "",
+    std::size_t cache_disk_size = 0,
+    std::size_t cache_host_size = 0);
 
   /**
    * @brief Get the already allocated cache
@@ -65,12 +73,18 @@ class DLL_PUBLIC ImageCacheFactory {
     std::size_t cache_size;
     bool cache_debug;
     std::size_t cache_threshold;
+    std::string cache_dir;
+    std::size_t cache_disk_size;
+    std::size_t cache_host_size;
 
     inline bool operator==(const CacheParams& oth) const {
       return cache_policy == oth.cache_policy
           && cache_size == oth.cache_size
           && cache_debug == oth.cache_debug
-          && cache_threshold == oth.cache_threshold;
+          && cache_threshold == oth.cache_threshold
+          && cache_dir == oth.cache_dir
+          && cache_disk_size == oth.cache_disk_size
+          && cache_host_size == oth.cache_host_size;
     }
   };
 
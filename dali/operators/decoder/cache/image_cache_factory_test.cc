@@ -112,5 +112,17 @@ TEST_F(ImageCacheFactoryTest, GetAndRefCount) {
   auto cache03 = factory.Get(0, "threshold", 2*1024*1024, true, 1024);
 }
 
+TEST_F(ImageCacheFactoryTest, AdaptiveWithHostMemory) {
+  auto &factory = ImageCacheFactory::Instance();
+  ASSERT_FALSE(factory.IsInitialized(0));
+  // only the adaptive policy moves the images to host memory
+  EXPECT_THROW(
+    factory.Get(0, "threshold", 1*1024*1024, false, 0, "", 0, 1*1024*1024),
+    std::runtime_error);
+  auto cache = factory.Get(0, "adaptive", 1*1024*1024, false, 0, "", 0, 1*1024*1024);
+  EXPECT_NE(nullptr, cache);
+  EXPECT_TRUE(factory.IsInitialized(0));
+}
+
 }  // namespace testing
 }  // namespace dali
@@ -0,0 +1,67 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/decoder/cache/image_cache_tiered.h"
+#include <memory>
+#include <utility>
+#include "dali/core/error_handling.h"
+
+namespace dali {
+
+ImageCacheTiered::ImageCacheTiered(std::shared_ptr<ImageCache> memory,
+                                   std::shared_ptr<ImageCache> disk)
+    : memory_(std::move(memory)), disk_(std::move(disk)) {
+  DALI_ENFORCE(memory_ && disk_, "Both tiers of the cache are required");
+}
+
+bool ImageCacheTiered::IsCached(const ImageKey& image_key) const {
+  return memory_->IsCached(image_key) || disk_->IsCached(image_key);
+}
+
+const ImageCache::ImageShape& ImageCacheTiered::GetShape(const ImageKey& image_key) const {
+  return memory_->IsCached(image_key) ? memory_->GetShape(image_key)
+                                      : disk_->GetShape(image_key);
+}
+
+bool ImageCacheTiered::Read(const ImageKey& image_key,
+                            void* destination_data,
+                            cudaStream_t stream) const {
+  if (memory_->Read(image_key, destination_data, stream))
+    return true;
+  if (!disk_->Read(image_key, destination_data, stream))
+    return false;
+  // promote - the image has just been copied to the (device) destination buffer
+  memory_->Add(image_key, static_cast<const uint8_t *>(destination_data),
+               disk_->GetShape(image_key), stream);
+  return true;
+}
+
+void ImageCacheTiered::Add(const ImageKey& image_key,
+                           const uint8_t *data,
+                           const ImageShape& data_shape,
+                           cudaStream_t stream) {
+  memory_->Add(image_key, data, data_shape, stream);
+  if (!disk_->IsCached(image_key))
+    disk_->Add(image_key, data, data_shape, stream);
+}
+
+ImageCache::DecodedImage ImageCacheTiered::Get(const ImageKey &image_key) const {
+  return memory_->Get(image_key);
+}
+
+void ImageCacheTiered::SyncToRead(cudaStream_t stream) const {
+  memory_->SyncToRead(stream);
+}
+
+}  // namespace dali
@@ -0,0 +1,66 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_TIERED_H_
+#define DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_TIERED_H_
+
+#include <memory>
+#include "dali/core/common.h"
+#include "dali/operators/decoder/cache/image_cache.h"
+
+namespace dali {
+
+/**
+ * @brief Places a cache in GPU memory in front of a persistent (disk) one
+ *
+ * The images are looked up in the GPU tier first. An image found only in the disk tier is
+ * offered to the GPU tier when it's read, so that (depending on the policy of the GPU tier)
+ * the subsequent reads don't touch the disk. New images are added to both tiers.
+ */
+class DLL_PUBLIC ImageCacheTiered : public ImageCache {
+ public:
+  DLL_PUBLIC ImageCacheTiered(std::shared_ptr<ImageCache> memory,
+                              std::shared_ptr<ImageCache> disk);
+
+  ~ImageCacheTiered() override = default;
+
+  DISABLE_COPY_MOVE_ASSIGN(ImageCacheTiered);
+
+  bool IsCached(const ImageKey& image_key) const override;
+
+  bool Read(const ImageKey& image_key,
+            void* destination_data,
+            cudaStream_t stream) const override;
+
+  const ImageShape& GetShape(const ImageKey& image_key) const override;
+
+  void Add(const ImageKey& image_key,
+           const uint8_t *data,
+           const ImageShape& data_shape,
+           cudaStream_t stream) override;
+
+  /**
+   * @brief Returns the image from the GPU tier, if it's there
+   */
+  DecodedImage Get(const ImageKey &image_key) const override;
+
+  void SyncToRead(cudaStream_t stream) const override;
+
+ private:
+  std::shared_ptr<ImageCache> memory_, disk_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_CACHE_IMAGE_CACHE_TIERED_H_
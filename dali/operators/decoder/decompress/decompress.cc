@@ -0,0 +1,271 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <nvcomp/deflate.h>
+#include <nvcomp/lz4.h>
+#include <nvcomp/zstd.h>
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "dali/operators/decoder/decompress/decompress.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/error_handling.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/pipeline/operator/common.h"
+
+namespace dali {
+
+DALI_SCHEMA(experimental__Decompress)
+  .DocStr(R"code(Decompresses the samples on the GPU, with nvCOMP.
+
+Each sample is a 1D ``uint8`` buffer with the compressed data - a single LZ4 block, Zstandard frame
+or raw Deflate stream, as compressed by the nvCOMP batched API or by the compatible CPU libraries.
+The samples of the batch are decompressed together. As only the compressed data is copied
+to the GPU, the traffic between the host and the GPU is reduced by the compression ratio.
+
+The compressed payloads returned by the readers (for example, ``readers.webdataset`` or
+``readers.file``) are moved to the GPU with ``.gpu()``::
+
+    data, label = fn.readers.webdataset(paths=..., ext=["lz4", "cls"])
+    features = fn.experimental.decompress(data.gpu(), codec="lz4", dtype=types.FLOAT16,
+                                          shape=[256, 80])
+
+The decompressed size of a sample is limited by nvCOMP, to 16 MB for LZ4 and Zstandard.)code")
+  .NumInput(1)
+  .NumOutput(1)
+  .AddArg("codec",
+      R"code(Compression format of the samples: ``"lz4"``, ``"zstd"`` or ``"deflate"``.)code",
+      DALI_STRING)
+  .AddOptionalTypeArg("dtype",
+      R"code(Type of the decompressed data.)code", DALI_UINT8)
+  .AddOptionalArg<std::vector<int>>("shape",
+      R"code(Shape of the decompressed samples.
+
+If not specified, the output is 1D and its size is read from the compressed data, which requires
+waiting for the preceding GPU work.)code", nullptr, true)
+  .AddOptionalArg("layout",
+      R"code(Layout of the decompressed samples.)code", TensorLayout());
+
+namespace {
+
+Codec ParseCodec(const std::string &name) {
+  if (name == "lz4")
+    return Codec::LZ4;
+  if (name == "zstd")
+    return Codec::Zstd;
+  if (name == "deflate")
+    return Codec::Deflate;
+  DALI_FAIL(make_string("Unsupported codec: \"", name,
+                        "\". Supported codecs are \"lz4\", \"zstd\" and \"deflate\"."));
+}
+
+void CheckNvcomp(nvcompStatus_t status, const char *what) {
+  DALI_ENFORCE(status == nvcompSuccess,
+               make_string("nvCOMP error ", static_cast<int>(status), " when ", what, "."));
+}
+
+size_t DecompressTempSize(Codec codec, size_t num_chunks, size_t max_chunk_size) {
+  size_t temp_bytes = 0;
+  nvcompStatus_t status = nvcompSuccess;
+  switch (codec) {
+    case Codec::LZ4:
+      status = nvcompBatchedLZ4DecompressGetTempSize(num_chunks, max_chunk_size, &temp_bytes);
+      break;
+    case Codec::Zstd:
+      status = nvcompBatchedZstdDecompressGetTempSize(num_chunks, max_chunk_size, &temp_bytes);
+      break;
+    case Codec::Deflate:
+      status = nvcompBatchedDeflateDecompressGetTempSize(num_chunks, max_chunk_size, &temp_bytes);
+      break;
+  }
+  CheckNvcomp(status, "computing the size of the temporary buffer");
+  return temp_bytes;
+}
+
+void GetDecompressSizeAsync(Codec codec, const void *const *in, const size_t *in_sizes,
+                            size_t *out_sizes, size_t num_chunks, cudaStream_t stream) {
+  nvcompStatus_t status = nvcompSuccess;
+  switch (codec) {
+    case Codec::LZ4:
+      status = nvcompBatchedLZ4GetDecompressSizeAsync(in, in_sizes, out_sizes, num_chunks, stream);
+      break;
+    case Codec::Zstd:
+      status = nvcompBatchedZstdGetDecompressSizeAsync(in, in_sizes, out_sizes, num_chunks, stream);
+      break;
+    case Codec::Deflate:
+      status = nvcompBatchedDeflateGetDecompressSizeAsync(in, in_sizes, out_sizes, num_chunks,
+                                                          stream);
+      break;
+  }
+  CheckNvcomp(status, "reading the decompressed sizes");
+}
+
+void DecompressAsync(Codec codec, const void *const *in, const size_t *in_sizes,
+                     const size_t *out_sizes, size_t *actual_out_sizes, size_t num_chunks,
+                     void *temp, size_t temp_bytes, void *const *out, nvcompStatus_t *statuses,
+                     cudaStream_t stream) {
+  nvcompStatus_t status = nvcompSuccess;
+  switch (codec) {
+    case Codec::LZ4:
+      status = nvcompBatchedLZ4DecompressAsync(in, in_sizes, out_sizes, actual_out_sizes,
+                                               num_chunks, temp, temp_bytes, out, statuses,
+                                               stream);
+      break;
+    case Codec::Zstd:
+      status = nvcompBatchedZstdDecompressAsync(in, in_sizes, out_sizes, actual_out_sizes,
+                                                num_chunks, temp, temp_bytes, out, statuses,
+                                                stream);
+      break;
+    case Codec::Deflate:
+      status = nvcompBatchedDeflateDecompressAsync(in, in_sizes, out_sizes, actual_out_sizes,
+                                                   num_chunks, temp, temp_bytes, out, statuses,
+                                                   stream);
+      break;
+  }
+  CheckNvcomp(status, "decompressing");
+}
+
+}  // namespace
+
+DecompressGPU::DecompressGPU(const OpSpec &spec)
+    : Operator<GPUBackend>(spec),
+      codec_(ParseCodec(spec.GetArgument<std::string>("codec"))),
+      dtype_(spec.GetArgument<DALIDataType>("dtype")),
+      layout_(spec.GetArgument<TensorLayout>("layout")) {
+}
+
+void DecompressGPU::GetDecompressedSizes(const TensorList<GPUBackend> &input,
+                                         cudaStream_t stream) {
+  int nsamples = input.num_samples();
+  std::vector<const void *> in_ptrs(nsamples);
+  std::vector<size_t> in_sizes(nsamples);
+  for (int i = 0; i < nsamples; i++) {
+    in_ptrs[i] = input.raw_tensor(i);
+    in_sizes[i] = input.shape().tensor_size(i);
+  }
+  kernels::DynamicScratchpad scratchpad({}, stream);
+  const void **in_ptrs_gpu;
+  size_t *in_sizes_gpu;
+  std::tie(in_ptrs_gpu, in_sizes_gpu) = scratchpad.ToContiguousGPU(stream, in_ptrs, in_sizes);
+  size_t *sizes_gpu = scratchpad.AllocateGPU<size_t>(nsamples);
+  size_t *sizes_cpu = scratchpad.AllocatePinned<size_t>(nsamples);
+  GetDecompressSizeAsync(codec_, in_ptrs_gpu, in_sizes_gpu, sizes_gpu, nsamples, stream);
+  CUDA_CALL(cudaMemcpyAsync(sizes_cpu, sizes_gpu, nsamples * sizeof(size_t),
+                            cudaMemcpyDeviceToHost, stream));
+  CUDA_CALL(cudaStreamSynchronize(stream));
+  decompressed_sizes_.assign(sizes_cpu, sizes_cpu + nsamples);
+}
+
+bool DecompressGPU::SetupImpl(std::vector<OutputDesc> &output_desc,
+                              const workspace_t<GPUBackend> &ws) {
+  const auto &input = ws.Input<GPUBackend>(0);
+  DALI_ENFORCE(input.type() == DALI_UINT8,
+               make_string("The compressed data must be of type uint8, got: ", input.type(), "."));
+  DALI_ENFORCE(input.sample_dim() == 1,
+               make_string("The compressed data must be 1D, got ", input.sample_dim(),
+                           " dimensions."));
+  int nsamples = input.num_samples();
+  int64_t type_size = TypeTable::GetTypeInfo(dtype_).size();
+  if (spec_.ArgumentDefined("shape")) {
+    GetShapeArgument(shape_, spec_, "shape", ws, nsamples);
+    decompressed_sizes_.resize(nsamples);
+    for (int i = 0; i < nsamples; i++)
+      decompressed_sizes_[i] = shape_.tensor_size(i) * type_size;
+  } else {
+    GetDecompressedSizes(input, ws.stream());
+    shape_.resize(nsamples, 1);
+    for (int i = 0; i < nsamples; i++) {
+      DALI_ENFORCE(decompressed_sizes_[i] % type_size == 0,
+                   make_string("The decompressed size of the sample ", i, " (",
+                               decompressed_sizes_[i], " bytes) is not a multiple of the size of ",
+                               dtype_, "."));
+      shape_.set_tensor_shape(i, {static_cast<int64_t>(decompressed_sizes_[i] / type_size)});
+    }
+  }
+  DALI_ENFORCE(layout_.empty() || layout_.ndim() == shape_.sample_dim(),
+               make_string("The layout \"", layout_, "\" doesn't match the number of dimensions "
+                           "of the output: ", shape_.sample_dim(), "."));
+  output_desc.resize(1);
+  output_desc[0] = {shape_, dtype_};
+  return true;
+}
+
+void DecompressGPU::RunImpl(workspace_t<GPUBackend> &ws) {
+  const auto &input = ws.Input<GPUBackend>(0);
+  auto &output = ws.Output<GPUBackend>(0);
+  output.SetLayout(layout_);
+  cudaStream_t stream = ws.stream();
+
+  int nsamples = input.num_samples();
+  std::vector<int> sample_idxs;
+  std::vector<const void *> in_ptrs;
+  std::vector<size_t> in_sizes;
+  std::vector<void *> out_ptrs;
+  std::vector<size_t> out_sizes;
+  size_t max_out_size = 0;
+  for (int i = 0; i < nsamples; i++) {
+    // there's nothing to decompress to an empty output
+    if (decompressed_sizes_[i] == 0)
+      continue;
+    sample_idxs.push_back(i);
+    in_ptrs.push_back(input.raw_tensor(i));
+    in_sizes.push_back(input.shape().tensor_size(i));
+    out_ptrs.push_back(output.raw_mutable_tensor(i));
+    out_sizes.push_back(decompressed_sizes_[i]);
+    max_out_size = std::max(max_out_size, decompressed_sizes_[i]);
+  }
+  size_t nchunks = sample_idxs.size();
+  if (nchunks == 0)
+    return;
+
+  kernels::DynamicScratchpad scratchpad({}, stream);
+  const void **in_ptrs_gpu;
+  size_t *in_sizes_gpu, *out_sizes_gpu;
+  void **out_ptrs_gpu;
+  std::tie(in_ptrs_gpu, in_sizes_gpu, out_ptrs_gpu, out_sizes_gpu) =
+      scratchpad.ToContiguousGPU(stream, in_ptrs, in_sizes, out_ptrs, out_sizes);
+  size_t temp_bytes = DecompressTempSize(codec_, nchunks, max_out_size);
+  void *temp = scratchpad.AllocateGPU<uint8_t>(temp_bytes, 256);
+  size_t *actual_sizes_gpu = scratchpad.AllocateGPU<size_t>(nchunks);
+  auto *statuses_gpu = scratchpad.AllocateGPU<nvcompStatus_t>(nchunks);
+
+  DecompressAsync(codec_, in_ptrs_gpu, in_sizes_gpu, out_sizes_gpu, actual_sizes_gpu, nchunks,
+                  temp, temp_bytes, out_ptrs_gpu, statuses_gpu, stream);
+
+  // the errors are reported per sample, on the GPU - the corrupted samples must not pass silently
+  size_t *actual_sizes = scratchpad.AllocatePinned<size_t>(nchunks);
+  auto *statuses = scratchpad.AllocatePinned<nvcompStatus_t>(nchunks);
+  CUDA_CALL(cudaMemcpyAsync(actual_sizes, actual_sizes_gpu, nchunks * sizeof(size_t),
+                            cudaMemcpyDeviceToHost, stream));
+  CUDA_CALL(cudaMemcpyAsync(statuses, statuses_gpu, nchunks * sizeof(nvcompStatus_t),
+                            cudaMemcpyDeviceToHost, stream));
+  CUDA_CALL(cudaStreamSynchronize(stream));
+  for (size_t j = 0; j < nchunks; j++) {
+    int i = sample_idxs[j];
+    DALI_ENFORCE(statuses[j] == nvcompSuccess,
+                 make_string("Cannot decompress the sample ", i, " (",
+                             input.GetMeta(i).GetSourceInfo(), "): nvCOMP error ",
+                             static_cast<int>(statuses[j]), "."));
+    DALI_ENFORCE(actual_sizes[j] == out_sizes[j],
+                 make_string("The sample ", i, " (", input.GetMeta(i).GetSourceInfo(),
+                             ") decompresses to ", actual_sizes[j], " bytes, while its shape "
+                             "requires ", out_sizes[j], " bytes."));
+  }
+}
+
+DALI_REGISTER_OPERATOR(experimental__Decompress, DecompressGPU, GPU);
+
+}  // namespace dali
@@ -0,0 +1,77 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_DECOMPRESS_DECOMPRESS_H_
+#define DALI_OPERATORS_DECODER_DECOMPRESS_DECOMPRESS_H_
+
+#include <string>
+#include <vector>
+
+#include "dali/core/tensor_shape.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/**
+ * @brief The compression formats decoded by the Decompress operator
+ *
+ * The samples are single nvCOMP batched chunks: LZ4 blocks, Zstandard frames or raw
+ * Deflate streams.
+ */
+enum class Codec {
+  LZ4,
+  Zstd,
+  Deflate
+};
+
+/**
+ * @brief Decompresses a batch of samples on the GPU with the nvCOMP batched API
+ *
+ * All the samples of the batch are decompressed with a single nvCOMP call. The compressed data
+ * is expected on the GPU already, so only the compressed bytes are copied from the host.
+ */
+class DecompressGPU : public Operator<GPUBackend> {
+ public:
+  explicit DecompressGPU(const OpSpec &spec);
+
+  DISABLE_COPY_MOVE_ASSIGN(DecompressGPU);
+
+ protected:
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<GPUBackend> &ws) override;
+
+  void RunImpl(workspace_t<GPUBackend> &ws) override;
+
+ private:
+  /**
+   * @brief Reads the sizes of the decompressed samples from their headers, on the GPU
+   *
+   * Used when the output `shape` is not given. It waits for the sizes, so it synchronizes
+   * the stream.
+   */
+  void GetDecompressedSizes(const TensorList<GPUBackend> &input, cudaStream_t stream);
+
+  Codec codec_;
+  DALIDataType dtype_;
+  TensorLayout layout_;
+  TensorListShape<> shape_;
+  std::vector<size_t> decompressed_sizes_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_DECOMPRESS_DECOMPRESS_H_
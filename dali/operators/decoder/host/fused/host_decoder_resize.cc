@@ -0,0 +1,133 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cmath>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/image/image_factory.h"
+#include "dali/operators/decoder/host/fused/host_decoder_resize.h"
+
+namespace dali {
+
+HostDecoderResize::HostDecoderResize(const OpSpec &spec)
+    : Operator<CPUBackend>(spec)
+    , ResizeBase<CPUBackend>(spec)
+    , output_type_(spec.GetArgument<DALIImageType>("output_type"))
+    , use_fast_idct_(spec.GetArgument<bool>("use_fast_idct")) {
+  InitializeCPU(num_threads_);
+  decoded_.set_pinned(false);
+}
+
+void HostDecoderResize::DecodeScaled(const HostWorkspace &ws,
+                                     const TensorListShape<> &orig_shape) {
+  const auto &input = ws.Input<CPUBackend>(0);
+  auto &tp = ws.GetThreadPool();
+  int N = input.num_samples();
+  for (int i = 0; i < N; i++) {
+    const auto &params = resize_attr_.params_[i];
+    // The decoder scales the whole image - the hint is chosen so that the ROI is scaled to
+    // at least the output size
+    int hint[2];
+    for (int d = 0; d < 2; d++) {
+      float roi_extent = std::abs(params.src_hi[d] - params.src_lo[d]);
+      int64_t extent = orig_shape.tensor_shape_span(i)[d];
+      hint[d] = roi_extent > 0
+              ? static_cast<int>(std::ceil(params.dst_size[d] * extent / roi_extent))
+              : 0;
+    }
+    tp.AddWork([&, i, hint_h = hint[0], hint_w = hint[1]](int) {
+      try {
+        images_[i]->SetUseFastIdct(use_fast_idct_);
+        images_[i]->SetDecodeSizeHint(hint_h, hint_w);
+        images_[i]->Decode();
+      } catch (std::exception &e) {
+        DALI_FAIL(make_string(e.what(), ". File: ", input.GetMeta(i).GetSourceInfo()));
+      }
+    }, volume(input.tensor_shape(i)));
+  }
+  tp.RunAll();
+}
+
+bool HostDecoderResize::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                  const HostWorkspace &ws) {
+  const auto &input = ws.Input<CPUBackend>(0);
+  DALI_ENFORCE(IsType<uint8>(input.type()), "Input must be stored as uint8 data.");
+  int N = input.num_samples();
+
+  images_.resize(N);
+  TensorListShape<> orig_shape(N, 3);
+  for (int i = 0; i < N; i++) {
+    DALI_ENFORCE(input.tensor_shape(i).sample_dim() == 1,
+                 "Input must be 1D encoded jpeg string.");
+    try {
+      images_[i] = ImageFactory::CreateImage(input.tensor<uint8>(i),
+                                             volume(input.tensor_shape(i)), output_type_);
+      orig_shape.set_tensor_shape(i, images_[i]->PeekShape());
+    } catch (std::exception &e) {
+      DALI_FAIL(make_string(e.what(), ". File: ", input.GetMeta(i).GetSourceInfo()));
+    }
+  }
+
+  // The output size and the ROI are calculated for the original images
+  resize_attr_.PrepareResizeParams(spec_, ws, orig_shape, "HWC");
+  DecodeScaled(ws, orig_shape);
+
+  decoded_shape_.resize(N, 3);
+  for (int i = 0; i < N; i++) {
+    auto shape = images_[i]->GetShape();
+    decoded_shape_.set_tensor_shape(i, shape);
+    auto &params = resize_attr_.params_[i];
+    for (int d = 0; d < 2; d++) {
+      float scale = static_cast<float>(shape[d]) / orig_shape.tensor_shape_span(i)[d];
+      params.src_lo[d] *= scale;
+      params.src_hi[d] *= scale;
+    }
+  }
+
+  resample_params_.resize(N);
+  resampling_attr_.PrepareFilterParams(spec_, ws, N);
+  resampling_attr_.GetResamplingParams(make_span(resample_params_),
+                                       make_cspan(resize_attr_.params_));
+
+  auto out_type = resampling_attr_.GetOutputType(DALI_UINT8);
+  output_desc.resize(1);
+  output_desc[0].type = out_type;
+  this->SetupResize(output_desc[0].shape, out_type, decoded_shape_, DALI_UINT8,
+                    make_cspan(resample_params_));
+  return true;
+}
+
+void HostDecoderResize::RunImpl(HostWorkspace &ws) {
+  auto &output = ws.Output<CPUBackend>(0);
+  auto &tp = ws.GetThreadPool();
+  int N = decoded_shape_.num_samples();
+
+  decoded_.Resize(decoded_shape_, DALI_UINT8);
+  for (int i = 0; i < N; i++) {
+    tp.AddWork([&, i](int) {
+      images_[i]->GetImage(decoded_.mutable_tensor<uint8_t>(i));
+      images_[i].reset();
+    }, volume(decoded_shape_.tensor_shape_span(i)));
+  }
+  tp.RunAll();
+
+  decoded_.SetLayout("HWC");
+  RunResize(ws, output, decoded_);
+  output.SetLayout("HWC");
+}
+
+DALI_REGISTER_OPERATOR(decoders__ImageResize, HostDecoderResize, CPU);
+
+}  // namespace dali
@@ -0,0 +1,75 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_HOST_FUSED_HOST_DECODER_RESIZE_H_
+#define DALI_OPERATORS_DECODER_HOST_FUSED_HOST_DECODER_RESIZE_H_
+
+#include <memory>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/image/image.h"
+#include "dali/kernels/imgproc/resample/params.h"
+#include "dali/operators/image/resize/resampling_attr.h"
+#include "dali/operators/image/resize/resize_attr.h"
+#include "dali/operators/image/resize/resize_base.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/**
+ * @brief Decodes the images and resizes them, without materializing the full resolution images
+ *
+ * The JPEG images are scaled down while decoding (in the DCT domain) by the largest power of two,
+ * which keeps the decoded region of interest at least as large as the output; the resampling
+ * is then done on the smaller image.
+ */
+class HostDecoderResize : public Operator<CPUBackend>, protected ResizeBase<CPUBackend> {
+ public:
+  explicit HostDecoderResize(const OpSpec &spec);
+
+  inline ~HostDecoderResize() override = default;
+  DISABLE_COPY_MOVE_ASSIGN(HostDecoderResize);
+
+  bool CanInferOutputs() const override { return true; }
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) override;
+
+  void RunImpl(HostWorkspace &ws) override;
+
+  using Operator<CPUBackend>::RunImpl;
+
+ private:
+  /**
+   * @brief Decodes the images, scaled down (if possible) so that the ROI is not smaller
+   *        than the output size
+   */
+  void DecodeScaled(const HostWorkspace &ws, const TensorListShape<> &orig_shape);
+
+  USE_OPERATOR_MEMBERS();
+  DALIImageType output_type_;
+  bool use_fast_idct_ = false;
+
+  ResizeAttr resize_attr_;
+  ResamplingFilterAttr resampling_attr_;
+  std::vector<kernels::ResamplingParams2D> resample_params_;
+
+  std::vector<std::unique_ptr<Image>> images_;
+  TensorListShape<> decoded_shape_;
+  TensorList<CPUBackend> decoded_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_HOST_FUSED_HOST_DECODER_RESIZE_H_
@@ -36,6 +36,7 @@ void HostDecoder::RunImpl(SampleWorkspace &ws) {
     img = ImageFactory::CreateImage(input.data<uint8>(), input.size(), output_type_);
     img->SetCropWindowGenerator(GetCropWindowGenerator(ws.data_idx()));
     img->SetUseFastIdct(use_fast_idct_);
+    img->SetDecodeSizeHint(decode_size_hint_[0], decode_size_hint_[1]);
     img->Decode();
   } catch (std::exception &e) {
     DALI_FAIL(e.what() + ". File: " + file_name);
@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_DECODER_HOST_HOST_DECODER_H_
 #define DALI_OPERATORS_DECODER_HOST_HOST_DECODER_H_
 
+#include <array>
 #include <vector>
 
 #include "dali/core/common.h"
@@ -29,8 +30,13 @@ class HostDecoder : public Operator<CPUBackend> {
   explicit inline HostDecoder(const OpSpec &spec) :
       Operator<CPUBackend>(spec),
       output_type_(spec.GetArgument<DALIImageType>("output_type")),
-      use_fast_idct_(spec.GetArgument<bool>("use_fast_idct"))
-  {}
+      use_fast_idct_(spec.GetArgument<bool>("use_fast_idct")) {
+    auto hint = spec.GetRepeatedArgument<int>("decode_size_hint");
+    DALI_ENFORCE(hint.empty() || hint.size() == 2, make_string(
+        "``decode_size_hint`` must be a (height, width) pair, got ", hint.size(), " values."));
+    if (!hint.empty())
+      decode_size_hint_ = {hint[0], hint[1]};
+  }
 
   inline ~HostDecoder() override = default;
   DISABLE_COPY_MOVE_ASSIGN(HostDecoder);
@@ -48,6 +54,7 @@ class HostDecoder : public Operator<CPUBackend> {
 
   DALIImageType output_type_;
   bool use_fast_idct_ = false;
+  std::array<int, 2> decode_size_hint_ = {0, 0};
 };
 
 }  // namespace dali
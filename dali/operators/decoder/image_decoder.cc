@@ -40,6 +40,23 @@ Huffman decoder.
 .. note::
   Hybrid Huffman decoder still largely uses the CPU.)code",
       1000u*1000u)
+  .AddOptionalArg("hybrid_huffman_cost_model",
+      R"code(Applies **only** to the ``mixed`` backend type.
+
+If set to True, the choice between the host-side and the hybrid Huffman decoder is based on
+an estimate of the cost of both, instead of the number of pixels only. The estimate takes into
+account the compressed size of the image, its number of pixels and its chroma subsampling,
+so that, for example, small images compressed with a low ratio use the hybrid Huffman decoder
+and large images compressed with a high ratio use the host-side one.
+``hybrid_huffman_threshold`` is then the number of pixels at which the estimated costs are equal
+for a typical (4:2:0, 2 bits per pixel) image.)code",
+      false)
+  .AddOptionalArg("hybrid_huffman_calibration",
+      R"code(Applies **only** to the ``mixed`` backend type and ``hybrid_huffman_cost_model``.
+
+If set to True, the time the decoding threads spend on the images with each of the Huffman
+decoders is measured at run time and the cost estimates are scaled to match it.)code",
+      true)
   .AddOptionalArg("device_memory_padding",
       R"code(Applies **only** to the ``mixed`` backend type.
 
@@ -102,6 +119,18 @@ if available. The optimal workload depends on the number of threads that are pro
 the DALI pipeline and should be found empirically. More details can be found at
 https://developer.nvidia.com/blog/loading-data-fast-with-dali-and-new-jpeg-decoder-in-a100)code",
       0.65f)
+  .AddOptionalArg("auto_hw_decoder_load",
+      R"code(Tunes ``hw_decoder_load`` at run time.
+
+Applies **only** to the ``mixed`` backend type in NVIDIA Ampere GPU architecture.
+
+If set to True, the operator measures the decoding time per image of the HW JPEG decoder and
+of the other decoders in each iteration, and adjusts the share of the HW decoder so that both
+finish at the same time. ``hw_decoder_load`` is used as the initial value.
+
+.. note::
+  Measuring the time of the HW decoder requires waiting for it to finish in each iteration.)code",
+      false)
   .AddOptionalArg("preallocate_width_hint",
       R"code(Image width hint.
 
@@ -144,6 +173,18 @@ the GPU implementation.
 According to the libjpeg-turbo documentation, decompression performance is improved by up to 14%
 with little reduction in quality.)code",
       false)
+  .AddOptionalArg("decode_size_hint",
+      R"code(Applies **only** to the ``cpu`` backend type.
+
+The size (height, width), to which the decoded images are going to be resized later.
+
+If set, the libjpeg-turbo based CPU decoder scales the JPEG images (or the cropped regions) down
+by 1/2, 1/4 or 1/8 while decoding, in the DCT domain, as long as the result stays at least as
+large as this size in both dimensions. This makes the decoding considerably faster (for example,
+in the `RandomResizedCrop`-style pipelines), but the output of the decoder is smaller than the
+original image or the requested crop. A value of 0 means that the extent is not constrained.
+By default, the images are decoded at the full resolution.)code",
+      std::vector<int>{})
   .AddOptionalArg("memory_stats",
       R"code(Applies **only** to the ``mixed`` backend type.
 
@@ -306,6 +347,35 @@ interpreted as absolute or relative coordinates, depending on the value of
 ``normalized_shape``.)code");
 
 
+DALI_SCHEMA(decoders__ImageResize)
+  .DocStr(R"code(Decodes images and resizes them.
+
+The output size and the region of interest are specified as in :meth:`nvidia.dali.fn.resize`,
+relative to the original images.
+
+The full resolution images are not materialized when the output is smaller: the JPEG images
+are scaled down while decoding (in the DCT domain, with *libjpeg-turbo*) by 1/2, 1/4 or 1/8,
+as long as the region of interest stays at least as large as the output, and only then
+resampled to the output size. This makes the decoding faster and reduces the memory usage,
+when the images are much larger than the output. The other formats are decoded at the full
+resolution.
+
+The output of the decoder is in *HWC* layout.
+
+Supported formats: JPG, BMP, PNG, TIFF, PNM, PPM, PGM, PBM, JPEG 2000, WebP.
+
+.. note::
+  ``decode_size_hint`` is ignored by this operator - it's calculated from the output size.
+
+.. note::
+  EXIF orientation metadata is disregarded.)code")
+  .NumInput(1)
+  .NumOutput(1)
+  .AddParent("ImageDecoderAttr")
+  .AddParent("ResizeAttr")
+  .AddParent("ResamplingFilterAttr");
+
+
 // Deprecated aliases
 
 DALI_SCHEMA(ImageDecoder)
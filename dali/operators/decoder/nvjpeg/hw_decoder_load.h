@@ -0,0 +1,80 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_NVJPEG_HW_DECODER_LOAD_H_
+#define DALI_OPERATORS_DECODER_NVJPEG_HW_DECODER_LOAD_H_
+
+#include "dali/core/math_util.h"
+
+namespace dali {
+
+/**
+ * @brief Tunes the fraction of the batch decoded by the HW decoder, so that it finishes at
+ *        the same time as the thread pool (nvJPEG CUDA and host decoding).
+ *
+ * The decoding time per image of both paths is measured in each iteration and averaged
+ * over the recent iterations. The load is then set so that the estimated times of both paths
+ * are equal.
+ */
+class HwDecoderLoadBalancer {
+ public:
+  /// The load never drops to 0, so that the HW decoding time is still measured
+  static constexpr float kMinLoad = 0.05f;
+  static constexpr float kMaxLoad = 1.0f;
+  /// The weight of the last iteration in the averaged times
+  static constexpr double kUpdateRate = 0.2;
+
+  explicit HwDecoderLoadBalancer(float initial_load = 0.65f)
+      : load_(clamp(initial_load, kMinLoad, kMaxLoad)) {}
+
+  float load() const {
+    return load_;
+  }
+
+  /**
+   * @brief Updates the load with the times measured in an iteration
+   *
+   * @param hw_samples     the number of images decoded by the HW decoder
+   * @param hw_time        the time the HW decoder took, in seconds
+   * @param other_samples  the number of images decoded in the thread pool
+   * @param other_time     the time the thread pool took, in seconds
+   * @param batch_size     the size of the batch
+   */
+  void Update(int hw_samples, double hw_time, int other_samples, double other_time,
+              int batch_size) {
+    if (hw_samples > 0)
+      Average(hw_cost_, hw_time / hw_samples);
+    if (other_samples > 0)
+      Average(other_cost_, other_time / other_samples);
+    if (hw_cost_ <= 0 || other_cost_ <= 0 || batch_size <= 0)
+      return;
+    // h * hw_cost == (n - h) * other_cost
+    int n = hw_samples + other_samples;
+    double hw_share = n * other_cost_ / (hw_cost_ + other_cost_);
+    load_ = clamp(static_cast<float>(hw_share / batch_size), kMinLoad, kMaxLoad);
+  }
+
+ private:
+  static void Average(double &avg, double value) {
+    avg = avg > 0 ? avg + kUpdateRate * (value - avg) : value;
+  }
+
+  float load_;
+  /// estimated decoding time per image, in seconds; 0 if not measured yet
+  double hw_cost_ = 0, other_cost_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_NVJPEG_HW_DECODER_LOAD_H_
@@ -0,0 +1,63 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include "dali/operators/decoder/nvjpeg/hw_decoder_load.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Simulates the iterations with the given costs per image and returns the final load
+ */
+float Simulate(HwDecoderLoadBalancer &balancer, double hw_cost, double other_cost,
+               int batch_size, int iters) {
+  for (int i = 0; i < iters; i++) {
+    int hw = std::lround(balancer.load() * batch_size);
+    int other = batch_size - hw;
+    balancer.Update(hw, hw * hw_cost, other, other * other_cost, batch_size);
+  }
+  return balancer.load();
+}
+
+}  // namespace
+
+TEST(HwDecoderLoadBalancer, Converges) {
+  // the HW decoder is 3 times faster - it should get 3/4 of the batch
+  HwDecoderLoadBalancer balancer(0.2f);
+  EXPECT_NEAR(Simulate(balancer, 1e-3, 3e-3, 256, 50), 0.75f, 0.01f);
+
+  // the CPU got faster
+  EXPECT_NEAR(Simulate(balancer, 1e-3, 1e-3, 256, 50), 0.5f, 0.01f);
+}
+
+TEST(HwDecoderLoadBalancer, Limits) {
+  HwDecoderLoadBalancer balancer(0.0f);
+  EXPECT_EQ(balancer.load(), HwDecoderLoadBalancer::kMinLoad);
+  // the HW decoder still gets some samples, even if it's much slower
+  EXPECT_EQ(Simulate(balancer, 1.0, 1e-3, 100, 50), HwDecoderLoadBalancer::kMinLoad);
+  EXPECT_NEAR(Simulate(balancer, 1e-6, 1.0, 100, 50), HwDecoderLoadBalancer::kMaxLoad, 0.01f);
+}
+
+TEST(HwDecoderLoadBalancer, KeepsLoadUntilMeasured) {
+  HwDecoderLoadBalancer balancer(0.65f);
+  balancer.Update(0, 0, 10, 1e-2, 10);
+  EXPECT_EQ(balancer.load(), 0.65f);
+  balancer.Update(10, 1e-2, 0, 0, 10);
+  EXPECT_EQ(balancer.load(), 0.5f);
+}
+
+}  // namespace dali
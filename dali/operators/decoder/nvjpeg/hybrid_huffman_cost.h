@@ -0,0 +1,154 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_DECODER_NVJPEG_HYBRID_HUFFMAN_COST_H_
+#define DALI_OPERATORS_DECODER_NVJPEG_HYBRID_HUFFMAN_COST_H_
+
+#include <cstdint>
+#include <mutex>
+
+namespace dali {
+
+/**
+ * @brief Chooses between the host Huffman decoding (nvJPEG hybrid backend) and the GPU Huffman
+ *        decoding (nvJPEG GPU hybrid backend) for each image, based on the estimated cost
+ *        of both.
+ *
+ * The host Huffman decoding takes time proportional to the compressed size of the image.
+ * The GPU Huffman decoding has a fixed overhead, a cost per 8x8 block of the image (given by
+ * the pixel count and the chroma subsampling) and a smaller cost per compressed byte, for
+ * the part of the work still done on the host. Therefore, the GPU is chosen for the images
+ * which are large or compressed with a low ratio.
+ *
+ * The costs are equal for a 4:2:0 image of `threshold` pixels and kRefBytesPerPixel bytes
+ * per pixel, so the model makes the same choice as a plain pixel count threshold for
+ * the images with typical compression ratio.
+ *
+ * If calibration is enabled, the decoding time of each path is measured and the estimates
+ * are scaled by the averaged ratio of the measured times to the estimated costs. Then, a path
+ * which hasn't been chosen for kExplorePeriod images is chosen for the next one, so that its
+ * cost is still measured.
+ */
+class HybridHuffmanCostModel {
+ public:
+  /// The compressed size, per pixel, of the reference image (about 2 bits per pixel)
+  static constexpr double kRefBytesPerPixel = 0.25;
+  /// The cost per compressed byte of the GPU Huffman decoding, relative to the host decoding
+  static constexpr double kGpuByteCost = 0.25;
+  /// The weight of the last measurement in the averaged time to cost ratios
+  static constexpr double kUpdateRate = 0.05;
+  static constexpr int kExplorePeriod = 64;
+
+  /**
+   * @brief The features of the image which determine the decoding cost
+   */
+  struct Image {
+    double bytes = 0;   // the compressed size
+    double blocks = 0;  // the number of 8x8 blocks of all components
+  };
+
+  /**
+   * @param encoded_size    the compressed size of the (decoded part of) the image
+   * @param pixels          the number of the decoded pixels
+   * @param chroma_factor   the number of the chroma samples per luma sample, e.g.
+   *                        2 for 4:4:4, 0.5 for 4:2:0 and 0 for grayscale
+   */
+  static Image Describe(double encoded_size, double pixels, double chroma_factor) {
+    return { encoded_size, pixels * (1 + chroma_factor) / 64 };
+  }
+
+  explicit HybridHuffmanCostModel(int64_t threshold = 1000 * 1000, bool calibrate = false)
+      : calibrate_(calibrate) {
+    Image ref = Describe(threshold * kRefBytesPerPixel, threshold, 0.5);
+    // the GPU saves this much on the host at the threshold - half of it is taken by
+    // the fixed overhead and half by the work per block
+    double saving = (1 - kGpuByteCost) * ref.bytes;
+    gpu_overhead_ = saving / 2;
+    gpu_block_cost_ = ref.blocks > 0 ? saving / 2 / ref.blocks : 0;
+  }
+
+  /// The estimated cost of the host Huffman decoding, in arbitrary units
+  double HostCost(const Image &image) const {
+    return image.bytes;
+  }
+
+  /// The estimated cost of the GPU Huffman decoding, in arbitrary units
+  double GpuCost(const Image &image) const {
+    return gpu_overhead_ + kGpuByteCost * image.bytes + gpu_block_cost_ * image.blocks;
+  }
+
+  /**
+   * @brief Returns true, if the image should be decoded with the GPU Huffman decoding
+   */
+  bool UseGpu(const Image &image) {
+    double host = HostCost(image), gpu = GpuCost(image);
+    if (!calibrate_)
+      return gpu < host;
+
+    std::lock_guard<std::mutex> guard(mtx_);
+    if (host_scale_ > 0 && gpu_scale_ > 0) {
+      host *= host_scale_;
+      gpu *= gpu_scale_;
+    }
+    bool use_gpu = gpu < host;
+    if (use_gpu && since_host_ >= kExplorePeriod)
+      use_gpu = false;
+    else if (!use_gpu && since_gpu_ >= kExplorePeriod)
+      use_gpu = true;
+    if (use_gpu) {
+      since_gpu_ = 0;
+      since_host_++;
+    } else {
+      since_host_ = 0;
+      since_gpu_++;
+    }
+    return use_gpu;
+  }
+
+  /**
+   * @brief Updates the calibration with the time it took to decode the image
+   *
+   * @param gpu      true, if the image was decoded with the GPU Huffman decoding
+   * @param seconds  the decoding time
+   */
+  void Update(bool gpu, const Image &image, double seconds) {
+    if (!calibrate_)
+      return;
+    double cost = gpu ? GpuCost(image) : HostCost(image);
+    if (cost <= 0 || seconds <= 0)
+      return;
+    double ratio = seconds / cost;
+    std::lock_guard<std::mutex> guard(mtx_);
+    double &scale = gpu ? gpu_scale_ : host_scale_;
+    scale = scale > 0 ? scale + kUpdateRate * (ratio - scale) : ratio;
+  }
+
+  bool calibrate() const {
+    return calibrate_;
+  }
+
+ private:
+  bool calibrate_;
+  double gpu_overhead_ = 0, gpu_block_cost_ = 0;
+
+  std::mutex mtx_;
+  /// the averaged ratio of the decoding time to the estimated cost; 0 if not measured yet
+  double host_scale_ = 0, gpu_scale_ = 0;
+  /// the number of the images since each path was chosen last
+  int since_host_ = 0, since_gpu_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_DECODER_NVJPEG_HYBRID_HUFFMAN_COST_H_
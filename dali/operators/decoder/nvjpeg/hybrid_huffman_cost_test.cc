@@ -0,0 +1,86 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <limits>
+#include "dali/operators/decoder/nvjpeg/hybrid_huffman_cost.h"
+
+namespace dali {
+
+namespace {
+
+HybridHuffmanCostModel::Image Image420(int64_t pixels, double bytes_per_pixel) {
+  return HybridHuffmanCostModel::Describe(pixels * bytes_per_pixel, pixels, 0.5);
+}
+
+}  // namespace
+
+TEST(HybridHuffmanCostModel, MatchesThresholdForReferenceImages) {
+  int64_t threshold = 1000 * 1000;
+  HybridHuffmanCostModel model(threshold);
+  double ref_bpp = HybridHuffmanCostModel::kRefBytesPerPixel;
+  EXPECT_FALSE(model.UseGpu(Image420(threshold / 2, ref_bpp)));
+  EXPECT_FALSE(model.UseGpu(Image420(threshold * 9 / 10, ref_bpp)));
+  EXPECT_TRUE(model.UseGpu(Image420(threshold * 11 / 10, ref_bpp)));
+  EXPECT_TRUE(model.UseGpu(Image420(threshold * 4, ref_bpp)));
+}
+
+TEST(HybridHuffmanCostModel, CompressionRatio) {
+  int64_t threshold = 1000 * 1000;
+  HybridHuffmanCostModel model(threshold);
+  // a small image with high entropy is decoded on the GPU...
+  EXPECT_TRUE(model.UseGpu(Image420(threshold / 2, 1.0)));
+  // ...and a large one with low entropy on the host
+  EXPECT_FALSE(model.UseGpu(Image420(threshold * 2, 0.05)));
+  // more blocks to decode on the GPU in a 4:4:4 image
+  auto image444 = HybridHuffmanCostModel::Describe(threshold * 0.3, threshold, 2);
+  auto image420 = HybridHuffmanCostModel::Describe(threshold * 0.3, threshold, 0.5);
+  EXPECT_GT(model.GpuCost(image444), model.GpuCost(image420));
+  EXPECT_EQ(model.HostCost(image444), model.HostCost(image420));
+}
+
+TEST(HybridHuffmanCostModel, Extremes) {
+  HybridHuffmanCostModel always_gpu(0);
+  EXPECT_TRUE(always_gpu.UseGpu(Image420(64, 0.1)));
+  HybridHuffmanCostModel never_gpu(std::numeric_limits<unsigned>::max());
+  EXPECT_FALSE(never_gpu.UseGpu(Image420(8000 * 8000, 1.0)));
+}
+
+TEST(HybridHuffmanCostModel, Calibration) {
+  int64_t threshold = 1000 * 1000;
+  HybridHuffmanCostModel model(threshold, true);
+  auto image = Image420(threshold * 2, HybridHuffmanCostModel::kRefBytesPerPixel);
+  ASSERT_TRUE(model.UseGpu(image));
+
+  // the GPU path turns out to be 10x slower than estimated
+  auto host_image = Image420(threshold / 2, HybridHuffmanCostModel::kRefBytesPerPixel);
+  for (int i = 0; i < 100; i++) {
+    model.Update(false, host_image, model.HostCost(host_image) * 1e-9);
+    model.Update(true, image, model.GpuCost(image) * 1e-8);
+  }
+  // only the exploration goes to the GPU - once per kExplorePeriod images decoded on the host
+  int gpu = 0;
+  for (int i = 0; i < 10 * (HybridHuffmanCostModel::kExplorePeriod + 1); i++)
+    gpu += model.UseGpu(image);
+  EXPECT_EQ(gpu, 10);
+}
+
+TEST(HybridHuffmanCostModel, NoCalibrationWithoutMeasurements) {
+  HybridHuffmanCostModel model(1000 * 1000, true);
+  auto image = Image420(2000 * 1000, HybridHuffmanCostModel::kRefBytesPerPixel);
+  model.Update(true, image, 1.0);  // only one of the paths measured
+  EXPECT_TRUE(model.UseGpu(image));
+}
+
+}  // namespace dali
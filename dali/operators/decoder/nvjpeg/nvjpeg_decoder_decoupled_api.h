@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_DECODER_NVJPEG_NVJPEG_DECODER_DECOUPLED_API_H_
 #define DALI_OPERATORS_DECODER_NVJPEG_NVJPEG_DECODER_DECOUPLED_API_H_
 
+#include <algorithm>
 #include <functional>
 #include <string>
 #include <utility>
@@ -22,7 +23,10 @@
 #include <memory>
 #include <numeric>
 #include <atomic>
+#include <chrono>
 #include "dali/pipeline/operator/operator.h"
+#include "dali/operators/decoder/nvjpeg/hw_decoder_load.h"
+#include "dali/operators/decoder/nvjpeg/hybrid_huffman_cost.h"
 #include "dali/operators/decoder/nvjpeg/nvjpeg_helper.h"
 #include "dali/operators/decoder/nvjpeg/nvjpeg_memory.h"
 #include "dali/operators/decoder/nvjpeg/nvjpeg2k_helper.h"
@@ -36,6 +40,7 @@
 #include "dali/core/device_guard.h"
 #include "dali/core/dev_buffer.h"
 #include "dali/core/static_switch.h"
+#include "dali/core/trace.h"
 #include "dali/operators/decoder/nvjpeg/permute_layout.h"
 
 #if NVJPEG_VER_MAJOR > 11 || \
@@ -57,6 +62,9 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     CachedDecoderImpl(spec),
     output_image_type_(spec.GetArgument<DALIImageType>("output_type")),
     hybrid_huffman_threshold_(spec.GetArgument<unsigned int>("hybrid_huffman_threshold")),
+    hybrid_huffman_cost_model_(spec.GetArgument<bool>("hybrid_huffman_cost_model")),
+    huffman_cost_(hybrid_huffman_threshold_, hybrid_huffman_cost_model_ &&
+                  spec.GetArgument<bool>("hybrid_huffman_calibration")),
     use_fast_idct_(spec.GetArgument<bool>("use_fast_idct")),
     output_shape_(max_batch_size_, kOutputDim),
     pinned_buffers_(num_threads_*2),
@@ -91,6 +99,10 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     bool try_init_hw_decoder = false;
     if (spec_.GetSchema().HasArgument("hw_decoder_load")) {
       hw_decoder_load_ = spec.GetArgument<float>("hw_decoder_load");
+      auto_hw_decoder_load_ = spec.GetArgument<bool>("auto_hw_decoder_load");
+      hw_load_balancer_ = HwDecoderLoadBalancer(hw_decoder_load_);
+      if (auto_hw_decoder_load_)
+        hw_decoder_load_ = hw_load_balancer_.load();
       try_init_hw_decoder = true;
     } else {
       hw_decoder_load_ = 0;
@@ -106,6 +118,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       if (driverVersion < 455) {
         try_init_hw_decoder = false,
         hw_decoder_load_ = 0;
+        auto_hw_decoder_load_ = false;
         CUDA_CALL(nvjpegDestroy(handle_));
         LOG_LINE << "NVJPEG_BACKEND_HARDWARE is disabled due to performance reason" << std::endl;
         CUDA_CALL(nvjpegCreateSimple(&handle_));
@@ -321,6 +334,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
         nvjpeg_memory::DeleteAllBuffers(thread_id);
       }
 #endif  // NVJPEG2K_ENABLED
+      nvjpeg_memory::ReleaseCachedBuffers();
 
       nvjpeg_memory::PrintMemStats();
     } catch (const std::exception &e) {
@@ -368,6 +382,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     int64_t encoded_length = 0;
     bool is_progressive = false;
     std::string file_name;
+    std::string cache_key;  // the key of the image in the decoder cache
     TensorShape<> shape;
     int req_nchannels = -1;
     int bpp = 8;  // currently used for jpeg2k only
@@ -375,6 +390,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     DecodeMethod method = DecodeMethod::Host;
     nvjpegDecodeParams_t params;
     nvjpegChromaSubsampling_t subsampling = NVJPEG_CSS_UNKNOWN;
+    HybridHuffmanCostModel::Image huffman_image;
 
     // enough to access by nvjpegBackend_t (index 0 not used)
     std::array<DecoderData, 4> decoders = {};
@@ -404,6 +420,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       req_nchannels = -1;
       method = DecodeMethod::Host;
       subsampling = NVJPEG_CSS_UNKNOWN;
+      huffman_image = {};
     }
 
     ~SampleData() {
@@ -462,6 +479,53 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     }
   }
 
+  /// The number of the chroma samples per luma sample
+  static double chroma_factor(nvjpegChromaSubsampling_t subsampling) {
+    switch (subsampling) {
+      case NVJPEG_CSS_444:
+        return 2;
+      case NVJPEG_CSS_422:
+      case NVJPEG_CSS_440:
+        return 1;
+      case NVJPEG_CSS_420:
+      case NVJPEG_CSS_411:
+        return 0.5;
+      case NVJPEG_CSS_410:
+        return 0.25;
+      case NVJPEG_CSS_GRAY:
+        return 0;
+      case NVJPEG_CSS_UNKNOWN:
+      default:
+        return 2;
+    }
+  }
+
+  /**
+   * @brief Selects the host-side or the hybrid Huffman decoder for a sample decoded with
+   *        the nvJPEG CUDA decoder
+   */
+  void SelectHuffmanDecoder(SampleData &data) {
+    int64_t sz = data.roi
+      ? data.roi.shape[1] * (data.roi.anchor[0] + data.roi.shape[0])
+      : data.shape[0] * data.shape[1];
+    bool use_gpu;
+    if (data.is_progressive) {
+      use_gpu = false;
+    } else if (hybrid_huffman_cost_model_) {
+      // the entropy-coded data is decoded only up to the last row of the ROI
+      int64_t total = data.shape[0] * data.shape[1];
+      double encoded_size = total > 0 ? data.encoded_length * (static_cast<double>(sz) / total)
+                                      : data.encoded_length;
+      data.huffman_image = HybridHuffmanCostModel::Describe(encoded_size, sz,
+                                                            chroma_factor(data.subsampling));
+      use_gpu = huffman_cost_.UseGpu(data.huffman_image);
+    } else {
+      use_gpu = sz > hybrid_huffman_threshold_;
+    }
+    data.selected_decoder = &data.decoders[use_gpu ? NVJPEG_BACKEND_GPU_HYBRID
+                                                   : NVJPEG_BACKEND_HYBRID];
+  }
+
   void RebalanceAndSortSamples() {
     static const char *sort_method_env = getenv("SORT_METHOD");
     enum {
@@ -496,14 +560,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 
       auto &data = *samples_single_.back();
       data.method = DecodeMethod::NvjpegCuda;
-      int64_t sz = data.roi
-        ? data.roi.shape[1] * (data.roi.anchor[0] + data.roi.shape[0])
-        : data.shape[0] * data.shape[1];
-      if (sz > hybrid_huffman_threshold_ && !data.is_progressive) {
-        data.selected_decoder = &data.decoders[NVJPEG_BACKEND_GPU_HYBRID];
-      } else {
-        data.selected_decoder = &data.decoders[NVJPEG_BACKEND_HYBRID];
-      }
+      SelectHuffmanDecoder(data);
     }
 
     if (sort_method != SORT_METHOD_NO_SORTING) {
@@ -546,6 +603,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
   }
 
   void ParseImagesInfo(MixedWorkspace &ws) {
+    TraceScope tr(TraceEvent::DecoderParse);
     auto curr_batch_size = ws.GetInputBatchSize(0);
     output_shape_.resize(curr_batch_size);
     samples_cache_.clear();
@@ -561,14 +619,16 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       auto *input_data = input.tensor<uint8_t>(i);
       const auto in_size = input.tensor_shape(i).num_elements();
       const auto &source_info = input.GetMeta(i).GetSourceInfo();
-      thread_pool_.AddWork([this, i, input_data, in_size, source_info](int tid) {
+      const auto &cache_key = input.GetMeta(i).GetCacheKey();
+      thread_pool_.AddWork([this, i, input_data, in_size, source_info, cache_key](int tid) {
         SampleData &data = sample_data_[i];
         data.clear();
         data.sample_idx = i;
         data.file_name = source_info;
+        data.cache_key = cache_key;
         data.encoded_length = in_size;
 
-        auto cached_shape = CacheImageShape(data.file_name);
+        auto cached_shape = CacheImageShape(data.cache_key);
         if (volume(cached_shape) > 0) {
           data.method = DecodeMethod::Cache;
           data.shape = cached_shape;
@@ -650,16 +710,8 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
         }
 
         data.is_progressive = IsProgressiveJPEG(input_data, in_size);
-        if (data.method == DecodeMethod::NvjpegCuda) {
-          int64_t sz = data.roi
-            ? data.roi.shape[1] * (data.roi.anchor[0] + data.roi.shape[0])
-            : data.shape[0] * data.shape[1];
-          if (sz > hybrid_huffman_threshold_ && !data.is_progressive) {
-            data.selected_decoder = &data.decoders[NVJPEG_BACKEND_GPU_HYBRID];
-          } else {
-            data.selected_decoder = &data.decoders[NVJPEG_BACKEND_HYBRID];
-          }
-        }
+        if (data.method == DecodeMethod::NvjpegCuda)
+          SelectHuffmanDecoder(data);
       }, in_size);
     }
     thread_pool_.RunAll();
@@ -700,7 +752,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       assert(sample);
       auto i = sample->sample_idx;
       auto *output_data = output.mutable_tensor<uint8_t>(i);
-      DALI_ENFORCE(DeferCacheLoad(sample->file_name, output_data));
+      DALI_ENFORCE(DeferCacheLoad(sample->cache_key, output_data));
     }
     LoadDeferred(ws.stream());
   }
@@ -718,6 +770,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
         [this, sample, in_data, in_size, output_data](int tid) {
           SampleWorker(sample->sample_idx, sample->file_name, in_size, tid,
             in_data, output_data, streams_[tid]);
+          task_end_[tid] = std::chrono::steady_clock::now();
         }, task_priority_seq_--);  // FIFO order, since the samples were already ordered
     }
   }
@@ -807,7 +860,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
         auto in = span<const uint8_t>(input.tensor<uint8_t>(i), input_shape[i].num_elements());
         ImageCache::ImageShape shape = output_shape_[i].to_static<3>();
         DecodeJpeg2k(output_data, sample, in);
-        CacheStore(sample->file_name, output_data, shape, nvjpeg2k_cu_stream_);
+        CacheStore(sample->cache_key, output_data, shape, nvjpeg2k_cu_stream_);
       }
     });
 #endif  // NVJPEG2K_ENABLED
@@ -824,9 +877,11 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       ImageCache::ImageShape shape = output_shape_[i].to_static<3>();
       thread_pool_.AddWork(
         [this, sample, input_data, in_size, output_data, shape](int tid) {
+          TraceScope tr(TraceEvent::DecoderHost, sample->sample_idx);
           HostFallback<StorageGPU>(input_data, in_size, output_image_type_, output_data,
                                    streams_[tid], sample->file_name, sample->roi, use_fast_idct_);
-          CacheStore(sample->file_name, output_data, shape, streams_[tid]);
+          CacheStore(sample->cache_key, output_data, shape, streams_[tid]);
+          task_end_[tid] = std::chrono::steady_clock::now();
         }, task_priority_seq_--);  // FIFO order, since the samples were already ordered
     }
   }
@@ -835,6 +890,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 #if IS_HW_DECODER_COMPATIBLE
     auto& output = ws.Output<GPUBackend>(0);
     if (!samples_hw_batched_.empty()) {
+      TraceScope tr(TraceEvent::DecoderHw, samples_hw_batched_.size());
       nvjpegJpegState_t &state = state_hw_batched_;
       assert(state != nullptr);
       // not used so set to 1
@@ -882,6 +938,8 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
           in_data_[k] = hw_decoder_images_staging_.mutable_tensor<uint8_t>(k);
         }
       }
+      TraceDeviceScope device_tr(TraceEvent::DecoderHwDevice, hw_decode_stream_,
+                                 samples_hw_batched_.size());
       // if nvjpegDecodeBatchedSupportedEx is available nvjpegDecodeBatchedEx should be as well,
       // otherwise no ROI should be provided anyway so we can safely call nvjpegDecodeBatched
       if (nvjpegIsSymbolAvailable("nvjpegDecodeBatchedEx")) {
@@ -908,7 +966,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 
       for (auto *sample : samples_hw_batched_) {
         int i = sample->sample_idx;
-        CacheStore(sample->file_name, output.mutable_tensor<uint8_t>(i),
+        CacheStore(sample->cache_key, output.mutable_tensor<uint8_t>(i),
                    output_shape_.tensor_shape(i).to_static<3>(), hw_decode_stream_);
       }
       CUDA_CALL(cudaEventRecord(hw_decode_event_, hw_decode_stream_));
@@ -931,6 +989,8 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     task_priority_seq_ = 0;
     ProcessImagesCache(ws);
 
+    auto start = std::chrono::steady_clock::now();
+    task_end_.assign(num_threads_, start);
     ProcessImagesCuda(ws);
     ProcessImagesHost(ws);
     ProcessImagesJpeg2k(ws);
@@ -938,9 +998,24 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     nvjpeg2k_thread_.RunAll(false);
 
     ProcessImagesHw(ws);
+    std::chrono::duration<double> hw_time{};
+    if (auto_hw_decoder_load_) {
+      // the HW decoder runs asynchronously - it has to be waited for, to measure its time
+      CUDA_CALL(cudaEventSynchronize(hw_decode_event_));
+      hw_time = std::chrono::steady_clock::now() - start;
+    }
 
     thread_pool_.WaitForWork();
     nvjpeg2k_thread_.WaitForWork();
+    if (auto_hw_decoder_load_) {
+      std::chrono::duration<double> other_time =
+          *std::max_element(task_end_.begin(), task_end_.end()) - start;
+      hw_load_balancer_.Update(samples_hw_batched_.size(), hw_time.count(),
+                               samples_single_.size() + samples_host_.size(), other_time.count(),
+                               ws.GetInputBatchSize(0));
+      // used in the next SetupImpl
+      hw_decoder_load_ = hw_load_balancer_.load();
+    }
     // wait for all work in workspace main stream
     for (int tid = 0; tid < num_threads_; tid++) {
       CUDA_CALL(cudaEventRecord(decode_events_[tid], streams_[tid]));
@@ -966,6 +1041,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
   // with libjpeg.
   void SampleWorker(int sample_idx, string file_name, int in_size, int thread_id,
                     const uint8_t* input_data, uint8_t* output_data, cudaStream_t stream) {
+    TraceScope tr(TraceEvent::DecoderCuda, sample_idx);
     SampleData &data = sample_data_[sample_idx];
     assert(data.method != DecodeMethod::Host);
 
@@ -981,6 +1057,8 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
 
     CUDA_CALL(nvjpegStateAttachPinnedBuffer(state, pinned_buffers_[buff_idx]));
 
+    // the time spent decoding in this thread, used to calibrate the Huffman decoder choice
+    auto decode_start = std::chrono::steady_clock::now();
     nvjpegStatus_t ret = nvjpegJpegStreamParse(handle_, input_data, in_size, false, false,
                                                jpeg_streams_[jpeg_stream_idx]);
 
@@ -1014,7 +1092,9 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
       nvjpeg_image.channel[0] = output_data;
       nvjpeg_image.pitch[0] = out_shape[1] * out_shape[2];
 
+      auto wait_start = std::chrono::steady_clock::now();
       CUDA_CALL(cudaEventSynchronize(decode_events_[thread_id]));
+      decode_start += std::chrono::steady_clock::now() - wait_start;
       CUDA_CALL_EX(nvjpegStateAttachDeviceBuffer(state, device_buffers_[thread_id]), file_name);
 
       CUDA_CALL_EX(nvjpegDecodeJpegTransferToDevice(handle_, decoder, state,
@@ -1034,6 +1114,13 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
         return;
       }
 
+      if (huffman_cost_.calibrate() && !data.is_progressive) {
+        std::chrono::duration<double> decode_time =
+            std::chrono::steady_clock::now() - decode_start;
+        bool gpu = data.selected_decoder == &data.decoders[NVJPEG_BACKEND_GPU_HYBRID];
+        huffman_cost_.Update(gpu, data.huffman_image, decode_time.count());
+      }
+
       if (output_image_type_ == DALI_YCbCr) {
         // We don't decode directly to YCbCr, since we want to control the YCbCr definition,
         // which is different between general color conversion libraries (OpenCV) and
@@ -1042,7 +1129,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
         Convert_RGB_to_YCbCr(output_data, output_data, npixels, stream);
       }
 
-      CacheStore(file_name, output_data, out_shape, stream);
+      CacheStore(data.cache_key, output_data, out_shape, stream);
       CUDA_CALL(cudaEventRecord(decode_events_[thread_id], stream));
     }
   }
@@ -1055,6 +1142,8 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
   DALIImageType output_image_type_;
 
   unsigned int hybrid_huffman_threshold_;
+  bool hybrid_huffman_cost_model_;
+  HybridHuffmanCostModel huffman_cost_;
   bool use_fast_idct_;
 
   TensorListShape<> output_shape_;
@@ -1092,6 +1181,10 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
   bool using_hw_decoder_ = false;
   bool using_hw_decoder_roi_ = false;
   float hw_decoder_load_ = 0.0f;
+  bool auto_hw_decoder_load_ = false;
+  HwDecoderLoadBalancer hw_load_balancer_;
+  /// the time at which each thread of thread_pool_ finished its last task in this iteration
+  std::vector<std::chrono::steady_clock::time_point> task_end_;
   int hw_decoder_bs_ = 0;
 
   // Those are used to feed nvjpeg's batched API
@@ -1129,6 +1222,7 @@ class nvJPEGDecoder : public Operator<MixedBackend>, CachedDecoderImpl {
     RegisterDiagnostic("nsamples_nvjpeg2k", &nsamples_nvjpeg2k_);
     RegisterDiagnostic("using_hw_decoder", &using_hw_decoder_);
     RegisterDiagnostic("using_hw_decoder_roi", &using_hw_decoder_roi_);
+    RegisterDiagnostic("hw_decoder_load", &hw_decoder_load_);
   }
 
   int CalcHwDecoderBatchSize(float hw_decoder_load, int curr_batch_size) {
@@ -15,6 +15,7 @@
 #include <nvjpeg.h>  // for NVJPEG_VER_MAJOR define
 #include <limits>
 
+#include "dali/operators/decoder/nvjpeg/hw_decoder_load.h"
 #include "dali/test/dali_test_decoder.h"
 #include "dali/util/nvml.h"
 
@@ -346,6 +347,62 @@ TEST_F(HwDecoderMemoryPoolTest, MemoryPoolTest) {
   this->pipeline_.RunGPU();
 }
 
+class AutoHwDecoderLoadTest : public ::testing::Test {
+ public:
+  void SetUp() final {
+    dali::string list_root(testing::dali_extra_path() + "/db/single/jpeg");
+
+    pipeline_.AddOperator(
+            OpSpec("FileReader")
+                    .AddArg("device", "cpu")
+                    .AddArg("file_root", list_root)
+                    .AddOutput("compressed_images", "cpu")
+                    .AddOutput("labels", "cpu"));
+    auto decoder_spec =
+            OpSpec("ImageDecoder")
+                    .AddArg("device", "mixed")
+                    .AddArg("output_type", DALI_RGB)
+                    .AddArg("hw_decoder_load", 0.2f)
+                    .AddArg("auto_hw_decoder_load", true)
+                    .AddInput("compressed_images", "cpu")
+                    .AddOutput("images", "gpu");
+    pipeline_.AddOperator(decoder_spec, decoder_name_);
+
+    pipeline_.Build(outputs_);
+
+    auto node = pipeline_.GetOperatorNode(decoder_name_);
+    if (!node->op->GetDiagnostic<bool>("using_hw_decoder")) {
+      GTEST_SKIP();
+    }
+  }
+
+
+  int batch_size_ = 47;
+  Pipeline pipeline_{batch_size_, 4, 0, -1, false, 2, false};
+  vector<std::pair<string, string>> outputs_ = {{"images", "gpu"}};
+  std::string decoder_name_ = "Lorem Ipsum";
+};
+
+TEST_F(AutoHwDecoderLoadTest, LoadIsTuned) {
+  constexpr int kIters = 10;
+  DeviceWorkspace ws;
+  for (int i = 0; i < kIters; i++) {
+    this->pipeline_.RunCPU();
+    this->pipeline_.RunGPU();
+    this->pipeline_.Outputs(&ws);
+  }
+
+  auto node = this->pipeline_.GetOperatorNode(this->decoder_name_);
+  auto load = node->op->GetDiagnostic<float>("hw_decoder_load");
+  EXPECT_GE(load, HwDecoderLoadBalancer::kMinLoad);
+  EXPECT_LE(load, HwDecoderLoadBalancer::kMaxLoad);
+  auto nsamples_hw = node->op->GetDiagnostic<int64_t>("nsamples_hw");
+  auto nsamples_cuda = node->op->GetDiagnostic<int64_t>("nsamples_cuda");
+  auto nsamples_host = node->op->GetDiagnostic<int64_t>("nsamples_host");
+  EXPECT_EQ(nsamples_hw + nsamples_cuda + nsamples_host, kIters * batch_size_);
+  EXPECT_GT(nsamples_hw, 0);
+}
+
 class HwDecoderSliceUtilizationTest : public ::testing::Test {
  public:
   void SetUp() final {
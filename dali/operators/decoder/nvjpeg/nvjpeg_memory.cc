@@ -17,6 +17,7 @@
 #include <shared_mutex>
 #include <atomic>
 #include <cassert>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -26,6 +27,8 @@
 #include <memory>
 #include <unordered_map>
 #include "dali/core/cuda_error.h"
+#include "dali/core/small_vector.h"
+#include "dali/core/mm/detail/size_class_cache.h"
 #include "dali/core/mm/memory.h"
 #include "dali/core/mm/memory_kind.h"
 #include "dali/core/mm/malloc_resource.h"
@@ -73,19 +76,51 @@ using MemoryPool = std::array<std::vector<Buffer>, static_cast<size_t>(mm::memor
 using BufferPool = std::map<std::thread::id, MemoryPool>;
 
 namespace {
+
+/**
+ * @brief The capacity of the cache of the freed buffers, per memory kind
+ *
+ * Can be set (in MiB) with the DALI_NVJPEG_BUFFER_CACHE_MB environment variable.
+ */
+size_t BufferCacheCapacity() {
+  static size_t capacity = []() -> size_t {
+    const char *env = std::getenv("DALI_NVJPEG_BUFFER_CACHE_MB");
+    return (env ? std::atoll(env) : 256) << 20;
+  }();
+  return capacity;
+}
+
+constexpr size_t kNumKinds = static_cast<size_t>(mm::memory_kind_id::count);
+
 struct NVJpegMem {
+  /// the buffers preallocated for the threads, see AddBuffer
   BufferPool buffer_pool_;
   std::shared_timed_mutex buffer_pool_mutex_;
 
+  /// the buffers freed by nvJPEG, shared by all the threads
+  std::array<mm::size_class_cache, kNumKinds> cache_;
+  std::mutex cache_mutex_;
+
   struct MemoryStats {
     size_t nallocs = 0;
     size_t biggest_alloc = 0;
+    size_t cache_hits = 0;
+    size_t cache_evictions = 0;
   };
 
-  std::array<MemoryStats, static_cast<size_t>(mm::memory_kind_id::count)> mem_stats_;
+  std::array<MemoryStats, kNumKinds> mem_stats_;
   std::mutex mem_stats_mutex_;
   std::atomic<bool> mem_stats_enabled_ = {true};
 
+  NVJpegMem() {
+    for (auto &cache : cache_)
+      cache = mm::size_class_cache(BufferCacheCapacity());
+  }
+
+  ~NVJpegMem() {
+    ReleaseCachedBuffers();
+  }
+
   static NVJpegMem &instance() {
     // ensure proper destruction order
     (void)mm::GetDefaultResource<mm::memory_kind::host>();
@@ -110,6 +145,15 @@ struct NVJpegMem {
     }
   }
 
+  void AddCacheStats(mm::memory_kind_id kind, size_t hits, size_t evictions) {
+    if (mem_stats_enabled_ && (hits || evictions)) {
+      std::lock_guard<std::mutex> lock(mem_stats_mutex_);
+      auto &stats = mem_stats_[static_cast<size_t>(kind)];
+      stats.cache_hits += hits;
+      stats.cache_evictions += evictions;
+    }
+  }
+
   void PrintMemStats() {
     if (mem_stats_enabled_) {
       std::lock_guard<std::mutex> lock(mem_stats_mutex_);
@@ -129,6 +173,16 @@ struct NVJpegMem {
       auto &host_mem_stats = mem_stats_[static_cast<size_t>(mm::memory_kind_id::host)];
       out << "Host (regular) memory: " << host_mem_stats.nallocs
           << " allocations, largest = " << host_mem_stats.biggest_alloc << " bytes\n";
+      std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+      const char *kind_names[] = {"device", "host (pinned)", "host (regular)"};
+      const mm::memory_kind_id kinds[] = {
+          mm::memory_kind_id::device, mm::memory_kind_id::pinned, mm::memory_kind_id::host};
+      for (int i = 0; i < 3; i++) {
+        auto k = static_cast<size_t>(kinds[i]);
+        out << "Cached " << kind_names[i] << " memory: " << mem_stats_[k].cache_hits
+            << " reused, " << mem_stats_[k].cache_evictions << " released, peak = "
+            << cache_[k].peak_bytes() << " bytes\n";
+      }
       out << "################## END NVJPEG STATS ##################" << std::endl;
     }
   }
@@ -180,35 +234,53 @@ struct NVJpegMem {
         buffers.pop_back();
       }
     }
-    // Couldn't find a preallocated buffer, proceed to allocate
-    AddMemStats<MemoryKind>(size);
-    return Allocate<MemoryKind>(thread_id, size).release();
+    // Couldn't find a preallocated buffer, try the ones freed by any thread
+    std::unique_lock<std::mutex> cache_lock(cache_mutex_);
+    auto block = cache_[static_cast<size_t>(kind)].get(size);
+    cache_lock.unlock();
+    if (block.mem) {
+      AddCacheStats(kind, 1, 0);
+      return block.mem;
+    }
+    // Allocate, rounding up to the size class, so that the buffer can be reused for
+    // slightly larger requests
+    size_t alloc_size = mm::size_class_cache::class_size(mm::size_class_cache::class_index(size));
+    AddMemStats<MemoryKind>(alloc_size);
+    return Allocate<MemoryKind>(thread_id, alloc_size).release();
   }
 
   int ReturnBufferToPool(void *raw_ptr) {
     std::shared_lock<std::shared_timed_mutex> info_lock(alloc_info_mutex_);
     auto info_it = alloc_info_.find(raw_ptr);
     assert(info_it != alloc_info_.end());
-    auto info = info_it->second;
+    mm::memory_kind_id kind = info_it->second.kind;
+    size_t size = info_it->second.size;
     info_lock.unlock();
-    std::unique_ptr<char, Deleter> ptr(reinterpret_cast<char*>(raw_ptr), {});
-    std::shared_lock<std::shared_timed_mutex> lock(buffer_pool_mutex_);
-    auto it = buffer_pool_.find(info.thread_id);
-    auto end_it =  buffer_pool_.end();
-    lock.unlock();
-    MemoryPool *pool;
-    if (it != end_it) {
-      pool = &(it->second);
-    } else {
-      // if nothing has been preallocated create a pool for given thread_id
-      std::unique_lock<std::shared_timed_mutex> lock(buffer_pool_mutex_);
-      pool = &(buffer_pool_[info.thread_id]);
+    SmallVector<void *, 4> evicted;
+    {
+      std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+      cache_[static_cast<size_t>(kind)].put(raw_ptr, size, [&](mm::size_class_cache::block b) {
+        evicted.push_back(b.mem);
+      });
     }
-    auto &buffers = (*pool)[static_cast<size_t>(info.kind)];
-    buffers.emplace_back(std::move(ptr), info.kind, info.size);
+    // free the evicted buffers outside of the lock
+    for (void *p : evicted)
+      Deleter()(p);
+    AddCacheStats(kind, 0, evicted.size());
     return 0;
   }
 
+  void ReleaseCachedBuffers() {
+    SmallVector<void *, 16> evicted;
+    {
+      std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+      for (auto &cache : cache_)
+        cache.trim(0, [&](mm::size_class_cache::block b) { evicted.push_back(b.mem); });
+    }
+    for (void *p : evicted)
+      Deleter()(p);
+  }
+
   template <typename MemoryKind>
   void AddBuffer(std::thread::id thread_id, size_t size) {
     std::unique_lock<std::shared_timed_mutex> lock(buffer_pool_mutex_);
@@ -273,6 +345,10 @@ void DeleteAllBuffers(std::thread::id thread_id) {
   NVJpegMem::instance().DeleteAllBuffers(thread_id);
 }
 
+void ReleaseCachedBuffers() {
+  NVJpegMem::instance().ReleaseCachedBuffers();
+}
+
 void SetEnableMemStats(bool enabled) {
   NVJpegMem::instance().SetEnableMemStats(enabled);
 }
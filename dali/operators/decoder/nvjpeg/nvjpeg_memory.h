@@ -54,6 +54,15 @@ void AddHostBuffer(std::thread::id thread_id, size_t size);
  */
 void DeleteAllBuffers(std::thread::id thread_id);
 
+/**
+ * @brief Frees the buffers kept for reuse after being released by nvJPEG
+ *
+ * The released buffers are shared by all the threads and binned by size classes. They're kept
+ * up to a capacity per memory kind, set with the DALI_NVJPEG_BUFFER_CACHE_MB environment
+ * variable (256 MiB by default); above it, the largest ones are freed.
+ */
+void ReleaseCachedBuffers();
+
 /**
  * @brief Enables/disables nvJPEG allocation statistics collection
  */
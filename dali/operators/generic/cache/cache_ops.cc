@@ -0,0 +1,108 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/generic/cache/cache_ops.h"
+
+namespace dali {
+
+DALI_SCHEMA(experimental__CacheLookup)
+  .DocStr(R"code(Checks which samples are in a cache of the samples computed by a part of
+the pipeline.
+
+The samples are identified by the source info of ``keys`` (e.g. the path of the file, set by
+the readers) or, if the reader computes it (``content_hash``), by the hash of their content, and
+are cached by :meth:`nvidia.dali.fn.experimental.cache_store`. Together with
+:meth:`nvidia.dali.fn.experimental.cache_fetch` and the conditional split and merge, it lets
+the pipeline compute each sample only once, e.g. in the first epoch::
+
+  jpegs, labels = fn.readers.file(file_root=image_dir)
+  hit = fn.experimental.cache_lookup(jpegs, cache_name="images", gpu_size=2048,
+                                     host_size=8192)
+  cached_jpegs, new_jpegs = fn._conditional.split(jpegs, predicate=hit)
+  images = fn.decoders.image(new_jpegs, device="mixed")
+  images = fn.resize(images, size=[224, 224])
+  images = fn.experimental.cache_store(images, new_jpegs, cache_name="images")
+  cached = fn.experimental.cache_fetch(cached_jpegs, cache_name="images", device="gpu")
+  images = fn._conditional.merge(cached, images, predicate=hit)
+
+The output is a per-sample boolean, true for the samples in the cache. Such samples are kept
+in the cache until they're fetched.
+
+The samples are kept in GPU memory (when stored and fetched by the GPU operators), host memory
+and files in ``disk_path``, each with its own size. A new sample is added to the first of them
+with a nonzero size; the least recently used samples are moved to the next one and, from the last
+one, dropped. The samples without the source info are neither cached nor found.
+
+The cache is bypassed - the lookups always miss and nothing is stored - when any of the operators
+computing the stored samples from ``keys`` (including their argument inputs) is
+nondeterministic, e.g. a random augmentation.
+
+The operators with the same ``cache_name`` use the same cache, also across the pipelines
+in the process.)code")
+  .NumInput(1)
+  .InputDox(0, "keys", "TensorList", R"code(The samples whose source info is the key.)code")
+  .NumOutput(1)
+  .Nondeterministic()
+  .AddArg("cache_name", R"code(The name of the cache.)code", DALI_STRING)
+  .AddOptionalArg("gpu_size", R"code(The size of the cache in GPU memory, in MB.)code", 0)
+  .AddOptionalArg("host_size", R"code(The size of the cache in host memory, in MB.)code", 0)
+  .AddOptionalArg("disk_size", R"code(The size of the cache in ``disk_path``, in MB.)code", 0)
+  .AddOptionalArg("disk_path", R"code(The directory for the samples cached on the disk.
+
+The files are removed when the cache is destroyed.)code", std::string())
+  .AddOptionalArg("bypass", R"code(Disables the cache.
+
+Set automatically when the cached samples are computed by a nondeterministic operator.)code",
+      false);
+
+DALI_SCHEMA(experimental__CacheFetch)
+  .DocStr(R"code(Reads the samples found in the cache by
+:meth:`nvidia.dali.fn.experimental.cache_lookup`.
+
+``keys`` must contain only the samples for which the lookup returned true, e.g. as split by
+:meth:`nvidia.dali.fn._conditional.split` with the result of the lookup as the ``predicate``.
+The cached samples must have the same type and number of dimensions.
+
+The GPU operator reads the samples stored by the GPU
+:meth:`nvidia.dali.fn.experimental.cache_store` and the CPU operator - the ones stored by
+the CPU one.)code")
+  .NumInput(1)
+  .InputDox(0, "keys", "TensorList", R"code(The samples whose source info is the key.)code")
+  .InputDevice(0, InputDevice::CPU)
+  .NumOutput(1)
+  .NoPrune()
+  .AddArg("cache_name", R"code(The name of the cache.)code", DALI_STRING);
+
+DALI_SCHEMA(experimental__CacheStore)
+  .DocStr(R"code(Adds the samples to the cache used by
+:meth:`nvidia.dali.fn.experimental.cache_lookup` and passes them through.
+
+The samples are stored under the source info of the respective ``keys``. The samples which
+are already in the cache or don't fit in it are not stored.)code")
+  .NumInput(2)
+  .InputDox(0, "data", "TensorList", R"code(The samples to cache.)code")
+  .InputDox(1, "keys", "TensorList", R"code(The samples whose source info is the key.)code")
+  .InputDevice(1, InputDevice::CPU)
+  .NumOutput(1)
+  .PassThrough({{0, 0}})
+  .NoPrune()
+  .AddArg("cache_name", R"code(The name of the cache.)code", DALI_STRING);
+
+DALI_REGISTER_OPERATOR(experimental__CacheLookup, CacheLookup, CPU);
+DALI_REGISTER_OPERATOR(experimental__CacheFetch, CacheFetch<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(experimental__CacheFetch, CacheFetch<GPUBackend>, GPU);
+DALI_REGISTER_OPERATOR(experimental__CacheStore, CacheStore<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(experimental__CacheStore, CacheStore<GPUBackend>, GPU);
+
+}  // namespace dali
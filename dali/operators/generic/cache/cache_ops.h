@@ -0,0 +1,192 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_GENERIC_CACHE_CACHE_OPS_H_
+#define DALI_OPERATORS_GENERIC_CACHE_CACHE_OPS_H_
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/core/format.h"
+#include "dali/operators/generic/cache/sample_cache.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+namespace detail {
+
+inline cudaStream_t CacheStream(const HostWorkspace &) {
+  return 0;
+}
+
+inline cudaStream_t CacheStream(const DeviceWorkspace &ws) {
+  return ws.stream();
+}
+
+}  // namespace detail
+
+/**
+ * @brief Checks which samples of the batch are in the cache, by the cache keys of `keys`,
+ *        and pins them until they're fetched.
+ *
+ * The cache is configured with the arguments of this operator.
+ */
+class CacheLookup : public Operator<CPUBackend> {
+ public:
+  explicit CacheLookup(const OpSpec &spec)
+      : Operator<CPUBackend>(spec),
+        cache_(SampleCache::Get(spec.GetArgument<std::string>("cache_name"))) {
+    constexpr std::size_t MB = 1 << 20;
+    cache_->Configure(spec.GetArgument<int>("gpu_size") * MB,
+                      spec.GetArgument<int>("host_size") * MB,
+                      spec.GetArgument<int>("disk_size") * MB,
+                      spec.GetArgument<std::string>("disk_path"),
+                      spec.GetArgument<bool>("bypass"));
+  }
+
+ protected:
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) override {
+    int nsamples = ws.Input<CPUBackend>(0).num_samples();
+    output_desc.resize(1);
+    output_desc[0].shape = uniform_list_shape(nsamples, TensorShape<0>());
+    output_desc[0].type = DALI_BOOL;
+    return true;
+  }
+
+  void RunImpl(HostWorkspace &ws) override {
+    const auto &keys = ws.Input<CPUBackend>(0);
+    auto &hit = ws.Output<CPUBackend>(0);
+    for (int i = 0; i < keys.num_samples(); i++)
+      *hit.mutable_tensor<bool>(i) = cache_->Pin(keys.GetMeta(i).GetCacheKey());
+  }
+
+ private:
+  std::shared_ptr<SampleCache> cache_;
+};
+
+/**
+ * @brief Reads the samples found (and pinned) by CacheLookup, by the cache keys of `keys`.
+ */
+template <typename Backend>
+class CacheFetch : public Operator<Backend> {
+ public:
+  explicit CacheFetch(const OpSpec &spec)
+      : Operator<Backend>(spec),
+        cache_(SampleCache::Get(spec.GetArgument<std::string>("cache_name"))) {
+    cache_->SetDevice(std::is_same<Backend, GPUBackend>::value);
+  }
+
+ protected:
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override {
+    const auto &keys = ws.template Input<CPUBackend>(0);
+    int nsamples = keys.num_samples();
+    descs_.resize(nsamples);
+    for (int i = 0; i < nsamples; i++)
+      descs_[i] = cache_->Describe(keys.GetMeta(i).GetCacheKey());
+    output_desc.resize(1);
+    // the type of an empty batch is irrelevant - it's merged with the computed samples
+    output_desc[0].type = nsamples > 0 ? descs_[0].type : DALI_UINT8;
+    int ndim = nsamples > 0 ? descs_[0].shape.sample_dim() : 0;
+    output_desc[0].shape.resize(nsamples, ndim);
+    for (int i = 0; i < nsamples; i++) {
+      DALI_ENFORCE(descs_[i].type == descs_[0].type && descs_[i].shape.sample_dim() == ndim,
+                   make_string("The cached samples must have the same type and number of "
+                               "dimensions, got: ", descs_[0].type, " with ", ndim,
+                               " dimensions and ", descs_[i].type, " with ",
+                               descs_[i].shape.sample_dim(), " dimensions."));
+      output_desc[0].shape.set_tensor_shape(i, descs_[i].shape);
+    }
+    return true;
+  }
+
+  void RunImpl(workspace_t<Backend> &ws) override {
+    const auto &keys = ws.template Input<CPUBackend>(0);
+    auto &output = ws.template Output<Backend>(0);
+    if (keys.num_samples() > 0)
+      output.SetLayout(descs_[0].layout);
+    for (int i = 0; i < keys.num_samples(); i++) {
+      const auto &key = keys.GetMeta(i).GetCacheKey();
+      cache_->Read(key, output.raw_mutable_tensor(i), detail::CacheStream(ws));
+      cache_->Unpin(key);
+      output.SetSourceInfo(i, keys.GetMeta(i).GetSourceInfo());
+    }
+  }
+
+ private:
+  std::shared_ptr<SampleCache> cache_;
+  std::vector<SampleCache::SampleDesc> descs_;
+};
+
+/**
+ * @brief Passes the samples through, adding them to the cache under the cache keys of `keys`.
+ */
+template <typename Backend>
+class CacheStore : public Operator<Backend> {
+ public:
+  explicit CacheStore(const OpSpec &spec)
+      : Operator<Backend>(spec),
+        cache_(SampleCache::Get(spec.GetArgument<std::string>("cache_name"))) {
+    cache_->SetDevice(std::is_same<Backend, GPUBackend>::value);
+  }
+
+ protected:
+  bool CanInferOutputs() const override {
+    return false;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override {
+    const auto &input = ws.template Input<Backend>(0);
+    const auto &keys = ws.template Input<CPUBackend>(1);
+    DALI_ENFORCE(keys.num_samples() == input.num_samples(),
+                 make_string("The ``keys`` must have the same number of samples as the data, "
+                             "got: ", keys.num_samples(), " and ", input.num_samples(), "."));
+    output_desc.resize(1);
+    output_desc[0].type = input.type();
+    output_desc[0].shape = input.shape();
+    return false;
+  }
+
+  void RunImpl(workspace_t<Backend> &ws) override {
+    const auto &input = ws.template Input<Backend>(0);
+    const auto &keys = ws.template Input<CPUBackend>(1);
+    ws.template Output<Backend>(0).ShareData(input);
+    if (cache_->bypassed())
+      return;
+    SampleCache::SampleDesc desc;
+    desc.type = input.type();
+    desc.layout = input.GetLayout();
+    for (int i = 0; i < input.num_samples(); i++) {
+      desc.shape = input.tensor_shape(i);
+      cache_->Add(keys.GetMeta(i).GetCacheKey(), input.raw_tensor(i), desc,
+                  detail::CacheStream(ws));
+    }
+  }
+
+ private:
+  std::shared_ptr<SampleCache> cache_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_GENERIC_CACHE_CACHE_OPS_H_
@@ -0,0 +1,274 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/generic/cache/sample_cache.h"
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+
+namespace dali {
+
+namespace {
+
+void WriteFile(const std::string &path, const void *data, std::size_t size) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(static_cast<const char *>(data), size);
+  DALI_ENFORCE(file.good(), make_string("Failed to write the cached sample to ", path));
+}
+
+void ReadFile(const std::string &path, void *data, std::size_t size) {
+  std::ifstream file(path, std::ios::binary);
+  file.read(static_cast<char *>(data), size);
+  DALI_ENFORCE(file.good(), make_string("Failed to read the cached sample from ", path));
+}
+
+}  // namespace
+
+std::shared_ptr<SampleCache> SampleCache::Get(const std::string &name) {
+  static std::mutex registry_mutex;
+  static std::unordered_map<std::string, std::weak_ptr<SampleCache>> registry;
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  auto &weak = registry[name];
+  auto cache = weak.lock();
+  if (!cache) {
+    cache = std::make_shared<SampleCache>(name);
+    weak = cache;
+  }
+  return cache;
+}
+
+SampleCache::~SampleCache() {
+  for (auto &kv : entries_)
+    Release(kv.second);
+}
+
+void SampleCache::Configure(std::size_t gpu_size, std::size_t host_size, std::size_t disk_size,
+                            const std::string &disk_dir, bool bypass) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bypass_ = bypass_ || bypass;
+  if (configured_) {
+    DALI_ENFORCE(budget_[kGPU] == gpu_size && budget_[kHost] == host_size &&
+                 budget_[kDisk] == disk_size && disk_dir_ == disk_dir,
+                 make_string("The cache \"", name_, "\" is already used with different sizes "
+                             "or ``disk_path``."));
+    return;
+  }
+  DALI_ENFORCE(disk_size == 0 || !disk_dir.empty(),
+               "The ``disk_path`` must be specified for a nonzero ``disk_size``.");
+  if (disk_size > 0 && mkdir(disk_dir.c_str(), 0755) != 0 && errno != EEXIST)
+    DALI_FAIL(make_string("Failed to create the cache directory ", disk_dir, ": ",
+                          std::strerror(errno)));
+  budget_[kGPU] = gpu_size;
+  budget_[kHost] = host_size;
+  budget_[kDisk] = disk_size;
+  disk_dir_ = disk_dir;
+  configured_ = true;
+}
+
+void SampleCache::SetDevice(bool gpu) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  DALI_ENFORCE(!device_set_ || gpu_ == gpu,
+               make_string("The samples of the cache \"", name_, "\" must be read and stored "
+                           "by the operators running on the same device."));
+  gpu_ = gpu;
+  device_set_ = true;
+}
+
+bool SampleCache::Pin(const std::string &key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (bypass_ || key.empty())
+    return false;
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    stats_.misses++;
+    return false;
+  }
+  it->second.pins++;
+  stats_.hits++;
+  return true;
+}
+
+void SampleCache::Unpin(const std::string &key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  DALI_ENFORCE(it != entries_.end() && it->second.pins > 0,
+               make_string("The sample \"", key, "\" is not pinned in the cache."));
+  it->second.pins--;
+}
+
+SampleCache::SampleDesc SampleCache::Describe(const std::string &key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  DALI_ENFORCE(it != entries_.end() && it->second.pins > 0,
+               make_string("The sample \"", key, "\" is not pinned in the cache."));
+  return it->second.desc;
+}
+
+void SampleCache::Read(const std::string &key, void *destination, cudaStream_t stream) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = entries_.find(key);
+  DALI_ENFORCE(it != entries_.end() && it->second.pins > 0,
+               make_string("The sample \"", key, "\" is not pinned in the cache."));
+  auto &entry = it->second;
+  auto &lru = lru_[entry.tier];
+  lru.splice(lru.begin(), lru, entry.pos);
+  if (entry.tier == kDisk) {
+    if (!gpu_) {
+      ReadFile(entry.path, destination, entry.size);
+      return;
+    }
+    std::vector<uint8_t> staging(entry.size);
+    ReadFile(entry.path, staging.data(), entry.size);
+    // a copy from pageable memory is staged before cudaMemcpyAsync returns
+    CUDA_CALL(cudaMemcpyAsync(destination, staging.data(), entry.size, cudaMemcpyDefault,
+                              stream));
+    return;
+  }
+  if (!gpu_) {
+    std::memcpy(destination, entry.data.get(), entry.size);
+    return;
+  }
+  if (entry.access)
+    CUDA_CALL(cudaStreamWaitEvent(stream, entry.access, 0));
+  CUDA_CALL(cudaMemcpyAsync(destination, entry.data.get(), entry.size, cudaMemcpyDefault,
+                            stream));
+  RecordAccess(entry, stream);
+}
+
+void SampleCache::Add(const std::string &key, const void *data, const SampleDesc &desc,
+                      cudaStream_t stream) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (bypass_ || key.empty() || entries_.count(key))
+    return;
+  auto &entry = entries_[key];
+  entry.desc = desc;
+  entry.size = volume(desc.shape) * TypeTable::GetTypeInfo(desc.type).size();
+  if (Place(entry, key, gpu_ ? kGPU : kHost, data, gpu_, stream)) {
+    stats_.added++;
+  } else {
+    entries_.erase(key);
+    stats_.dropped++;
+  }
+}
+
+bool SampleCache::Place(Entry &entry, const std::string &key, Tier tier, const void *data,
+                        bool data_on_gpu, cudaStream_t stream) {
+  for (int t = tier; t < kNumTiers; t++) {
+    if (budget_[t] < entry.size || !MakeRoom(static_cast<Tier>(t), entry.size, stream))
+      continue;
+    Store(entry, static_cast<Tier>(t), data, data_on_gpu, stream);
+    entry.tier = static_cast<Tier>(t);
+    lru_[t].push_front(key);
+    entry.pos = lru_[t].begin();
+    tier_bytes_[t] += entry.size;
+    return true;
+  }
+  return false;
+}
+
+bool SampleCache::MakeRoom(Tier tier, std::size_t size, cudaStream_t stream) {
+  auto &lru = lru_[tier];
+  auto it = lru.end();
+  while (tier_bytes_[tier] + size > budget_[tier] && it != lru.begin()) {
+    --it;
+    auto &entry = entries_.find(*it)->second;
+    if (entry.pins > 0)
+      continue;
+    std::string key = *it;
+    it = lru.erase(it);
+    tier_bytes_[tier] -= entry.size;
+    Demote(entry, key, stream);
+  }
+  return tier_bytes_[tier] + size <= budget_[tier];
+}
+
+void SampleCache::Demote(Entry &entry, const std::string &key, cudaStream_t stream) {
+  if (entry.tier != kDisk) {
+    // the entry's data is replaced, but it's still the source of the copy
+    WaitForAccess(entry);
+    auto data = std::move(entry.data);
+    bool placed = Place(entry, key, static_cast<Tier>(entry.tier + 1), data.get(),
+                        entry.tier == kGPU, stream);
+    WaitForAccess(entry);
+    if (placed) {
+      stats_.demoted++;
+      return;
+    }
+  }
+  Release(entry);
+  entries_.erase(key);
+  stats_.dropped++;
+}
+
+void SampleCache::Store(Entry &entry, Tier tier, const void *data, bool data_on_gpu,
+                        cudaStream_t stream) {
+  if (tier == kDisk) {
+    static std::atomic<int64_t> next_file{0};
+    std::string path = make_string(disk_dir_, "/dali_sample_cache_", getpid(), "_",
+                                   next_file++, ".bin");
+    if (data_on_gpu) {
+      std::vector<uint8_t> staging(entry.size);
+      CUDA_CALL(cudaMemcpyAsync(staging.data(), data, entry.size, cudaMemcpyDefault, stream));
+      CUDA_CALL(cudaStreamSynchronize(stream));
+      WriteFile(path, staging.data(), entry.size);
+    } else {
+      WriteFile(path, data, entry.size);
+    }
+    entry.path = std::move(path);
+    return;
+  }
+  if (tier == kGPU)
+    entry.data = mm::alloc_raw_unique<uint8_t, mm::memory_kind::device>(entry.size);
+  else if (gpu_)
+    entry.data = mm::alloc_raw_unique<uint8_t, mm::memory_kind::pinned>(entry.size);
+  else
+    entry.data = mm::alloc_raw_unique<uint8_t, mm::memory_kind::host>(entry.size);
+  if (!gpu_) {
+    std::memcpy(entry.data.get(), data, entry.size);
+    return;
+  }
+  CUDA_CALL(cudaMemcpyAsync(entry.data.get(), data, entry.size, cudaMemcpyDefault, stream));
+  RecordAccess(entry, stream);
+}
+
+void SampleCache::Release(Entry &entry) {
+  WaitForAccess(entry);
+  entry.data.reset();
+  if (!entry.path.empty()) {
+    std::remove(entry.path.c_str());
+    entry.path.clear();
+  }
+}
+
+void SampleCache::WaitForAccess(Entry &entry) {
+  if (entry.access)
+    CUDA_CALL(cudaEventSynchronize(entry.access));
+}
+
+void SampleCache::RecordAccess(Entry &entry, cudaStream_t stream) {
+  if (!entry.access)
+    entry.access = CUDAEvent::Create();
+  CUDA_CALL(cudaEventRecord(entry.access, stream));
+}
+
+}  // namespace dali
@@ -0,0 +1,212 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_GENERIC_CACHE_SAMPLE_CACHE_H_
+#define DALI_OPERATORS_GENERIC_CACHE_SAMPLE_CACHE_H_
+
+#include <cuda_runtime_api.h>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "dali/core/common.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/mm/memory.h"
+#include "dali/core/tensor_layout.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/pipeline/data/types.h"
+
+namespace dali {
+
+/**
+ * @brief A cache of the samples computed by a part of a pipeline, keyed by the source info
+ *        of the samples they were computed from
+ *
+ * The samples are kept in up to three tiers, each with its own budget, in bytes: GPU memory
+ * (only when the cache is used by the GPU operators), host memory and files in a local
+ * directory. A new sample is added to the first tier with a nonzero budget; the least recently
+ * used samples evicted from a tier are moved to the next one and dropped from the last one.
+ *
+ * The samples are looked up and pinned (see Pin) before they're read, possibly a few
+ * iterations later - a pinned sample is not evicted.
+ *
+ * The caches are shared by name (see Get), so that the operators looking up, reading and
+ * storing the samples refer to the same cache.
+ */
+class DLL_PUBLIC SampleCache {
+ public:
+  enum Tier : int {
+    kGPU = 0,
+    kHost = 1,
+    kDisk = 2,
+    kNumTiers = 3
+  };
+
+  struct SampleDesc {
+    TensorShape<> shape;
+    DALIDataType type = DALI_NO_TYPE;
+    TensorLayout layout;
+  };
+
+  struct Stats {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t added = 0;
+    std::size_t demoted = 0;  // moved to the next tier
+    std::size_t dropped = 0;  // evicted from the last tier or not fitting in any
+  };
+
+  /**
+   * @brief Returns the cache with the given name, creating an empty, unconfigured one
+   *
+   * The cache lives as long as any of the operators using it.
+   */
+  static std::shared_ptr<SampleCache> Get(const std::string &name);
+
+  explicit SampleCache(std::string name = {}) : name_(std::move(name)) {}
+
+  ~SampleCache();
+
+  DISABLE_COPY_MOVE_ASSIGN(SampleCache);
+
+  /**
+   * @brief Sets the budgets of the tiers, in bytes
+   *
+   * Can be called more than once, e.g. by the operators of several pipelines sharing the cache,
+   * but always with the same values. A bypassed cache is never hit and doesn't store anything.
+   */
+  void Configure(std::size_t gpu_size, std::size_t host_size, std::size_t disk_size,
+                 const std::string &disk_dir, bool bypass);
+
+  /**
+   * @brief Sets the device of the data stored in and read from the cache
+   *
+   * Only the GPU operators can use the GPU tier; the host tier is then in pinned memory.
+   */
+  void SetDevice(bool gpu);
+
+  bool bypassed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bypass_;
+  }
+
+  /**
+   * @brief Checks if the sample is in the cache and, if so, pins it until Unpin
+   */
+  bool Pin(const std::string &key);
+
+  void Unpin(const std::string &key);
+
+  /**
+   * @brief Describes a pinned sample
+   */
+  SampleDesc Describe(const std::string &key) const;
+
+  /**
+   * @brief Copies a pinned sample to `destination`, ordered in `stream` for the GPU data
+   */
+  void Read(const std::string &key, void *destination, cudaStream_t stream);
+
+  /**
+   * @brief Adds the sample, unless it's already in the cache or doesn't fit in any tier
+   *
+   * The data is copied in `stream`, for the GPU data.
+   */
+  void Add(const std::string &key, const void *data, const SampleDesc &desc,
+           cudaStream_t stream);
+
+  std::size_t tier_bytes(Tier tier) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tier_bytes_[tier];
+  }
+
+  std::size_t tier_samples(Tier tier) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_[tier].size();
+  }
+
+  Stats GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+ private:
+  struct Entry {
+    SampleDesc desc;
+    std::size_t size = 0;
+    Tier tier = kHost;
+    std::list<std::string>::iterator pos;
+    mm::uptr<uint8_t> data;  // in the GPU and host tiers
+    std::string path;        // in the disk tier
+    // the last access to `data` in a stream; it's waited for before the data is moved or freed
+    CUDAEvent access;
+    int pins = 0;
+  };
+
+  /**
+   * @brief Puts the entry in the first tier, starting with `tier`, with enough room for it
+   *
+   * `data` is the current data of the entry, in GPU memory if `data_on_gpu`.
+   *
+   * @return false, if the entry doesn't fit in any tier
+   */
+  bool Place(Entry &entry, const std::string &key, Tier tier, const void *data, bool data_on_gpu,
+             cudaStream_t stream);
+
+  /**
+   * @brief Moves the least recently used, not pinned entries from the tier to the next ones,
+   *        until `size` bytes more fit in it
+   */
+  bool MakeRoom(Tier tier, std::size_t size, cudaStream_t stream);
+
+  /**
+   * @brief Moves the entry, evicted from its tier, to the next tiers or drops it
+   */
+  void Demote(Entry &entry, const std::string &key, cudaStream_t stream);
+
+  /**
+   * @brief Allocates the data of the entry in the tier and copies `data` there
+   */
+  void Store(Entry &entry, Tier tier, const void *data, bool data_on_gpu, cudaStream_t stream);
+
+  /**
+   * @brief Forgets the data of the entry, after its last access is complete
+   */
+  void Release(Entry &entry);
+
+  void WaitForAccess(Entry &entry);
+
+  void RecordAccess(Entry &entry, cudaStream_t stream);
+
+  std::string name_;
+  bool configured_ = false;
+  bool bypass_ = false;
+  bool gpu_ = false;
+  bool device_set_ = false;
+  std::size_t budget_[kNumTiers] = {0, 0, 0};
+  std::size_t tier_bytes_[kNumTiers] = {0, 0, 0};
+  std::string disk_dir_;
+
+  std::unordered_map<std::string, Entry> entries_;
+  // front - most recently used
+  std::list<std::string> lru_[kNumTiers];
+  Stats stats_;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_GENERIC_CACHE_SAMPLE_CACHE_H_
@@ -0,0 +1,131 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/generic/cache/sample_cache.h"
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+namespace dali {
+namespace testing {
+
+struct SampleCacheTest : public ::testing::Test {
+  void SetUp() override {
+    char dir[] = "/tmp/dali_sample_cache_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    dir_ = dir;
+  }
+
+  void TearDown() override {
+    rmdir(dir_.c_str());
+  }
+
+  static SampleCache::SampleDesc Desc(int64_t size) {
+    SampleCache::SampleDesc desc;
+    desc.shape = TensorShape<>{size};
+    desc.type = DALI_UINT8;
+    desc.layout = "X";
+    return desc;
+  }
+
+  static std::vector<uint8_t> Sample(int key) {
+    return std::vector<uint8_t>(100, key);
+  }
+
+  void Add(SampleCache &cache, int key) {
+    cache.Add(std::to_string(key), Sample(key).data(), Desc(100), 0);
+  }
+
+  void ExpectCached(SampleCache &cache, int key) {
+    auto k = std::to_string(key);
+    ASSERT_TRUE(cache.Pin(k));
+    auto desc = cache.Describe(k);
+    EXPECT_EQ(desc.shape, TensorShape<>{100});
+    EXPECT_EQ(desc.type, DALI_UINT8);
+    EXPECT_EQ(desc.layout, "X");
+    std::vector<uint8_t> data(100);
+    cache.Read(k, data.data(), 0);
+    cache.Unpin(k);
+    EXPECT_EQ(data, Sample(key));
+  }
+
+  std::string dir_;
+};
+
+TEST_F(SampleCacheTest, Tiers) {
+  SampleCache cache;
+  cache.Configure(0, 250, 250, dir_, false);
+  cache.SetDevice(false);
+  EXPECT_FALSE(cache.Pin("0"));
+  for (int key = 0; key < 5; key++)
+    Add(cache, key);
+  // the least recently used sample is moved to the disk, and then dropped
+  EXPECT_EQ(cache.tier_samples(SampleCache::kHost), 2u);
+  EXPECT_EQ(cache.tier_samples(SampleCache::kDisk), 2u);
+  EXPECT_EQ(cache.tier_bytes(SampleCache::kDisk), 200u);
+  EXPECT_FALSE(cache.Pin("0"));
+  for (int key = 1; key < 5; key++)
+    ExpectCached(cache, key);
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.added, 5u);
+  EXPECT_EQ(stats.demoted, 3u);
+  EXPECT_EQ(stats.dropped, 1u);
+  EXPECT_EQ(stats.hits, 4u);
+  EXPECT_EQ(stats.misses, 2u);
+}
+
+TEST_F(SampleCacheTest, PinnedNotEvicted) {
+  SampleCache cache;
+  cache.Configure(0, 250, 0, "", false);
+  cache.SetDevice(false);
+  Add(cache, 0);
+  Add(cache, 1);
+  ASSERT_TRUE(cache.Pin("0"));
+  Add(cache, 2);
+  EXPECT_FALSE(cache.Pin("1"));
+  ExpectCached(cache, 2);
+  // the pinned sample is read after it would have been evicted
+  std::vector<uint8_t> data(100);
+  cache.Read("0", data.data(), 0);
+  cache.Unpin("0");
+  EXPECT_EQ(data, Sample(0));
+  // nothing can be evicted for a sample which doesn't fit
+  cache.Add("big", std::vector<uint8_t>(300).data(), Desc(300), 0);
+  EXPECT_FALSE(cache.Pin("big"));
+}
+
+TEST_F(SampleCacheTest, Bypass) {
+  SampleCache cache;
+  cache.Configure(0, 1000, 0, "", true);
+  cache.SetDevice(false);
+  Add(cache, 0);
+  EXPECT_FALSE(cache.Pin("0"));
+  EXPECT_EQ(cache.tier_samples(SampleCache::kHost), 0u);
+}
+
+TEST_F(SampleCacheTest, Shared) {
+  auto cache = SampleCache::Get("shared_test");
+  EXPECT_EQ(SampleCache::Get("shared_test"), cache);
+  EXPECT_NE(SampleCache::Get("other"), cache);
+  cache->Configure(0, 1000, 0, "", false);
+  EXPECT_NO_THROW(cache->Configure(0, 1000, 0, "", false));
+  EXPECT_THROW(cache->Configure(0, 2000, 0, "", false), std::exception);
+  cache->SetDevice(false);
+  EXPECT_THROW(cache->SetDevice(true), std::exception);
+}
+
+}  // namespace testing
+}  // namespace dali
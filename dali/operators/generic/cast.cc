@@ -14,6 +14,7 @@
 
 
 #include "dali/operators/generic/cast.h"
+#include "dali/core/convert_bulk.h"
 #include "dali/core/static_switch.h"
 
 namespace dali {
@@ -32,9 +33,7 @@ class CastCPU : public Cast<CPUBackend> {
 
 template <typename OType, typename IType>
 inline void CpuHelper(OType *out, const IType *in, size_t N) {
-  for (size_t i = 0; i < N; ++i) {
-    out[i] = ConvertSat<OType>(in[i]);
-  }
+  ConvertSatBulk(out, in, N);
 }
 
 void CastCPU::RunImpl(HostWorkspace &ws) {
@@ -25,7 +25,7 @@ namespace dali {
 
 #define CAST_ALLOWED_TYPES                                                                         \
   (bool, uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, int32_t, int64_t, float16, float, \
-  double)
+  double, bfloat16)
 
 template <typename Backend>
 class Cast : public Operator<Backend> {
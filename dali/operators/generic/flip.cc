@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -37,7 +37,10 @@ and depthwise).)code")
 
 template <>
 Flip<CPUBackend>::Flip(const OpSpec &spec)
-    : Operator<CPUBackend>(spec) {}
+    : Operator<CPUBackend>(spec),
+      horizontal_("horizontal", spec),
+      vertical_("vertical", spec),
+      depthwise_("depthwise", spec) {}
 
 void RunFlip(Tensor<CPUBackend> &output, const Tensor<CPUBackend> &input,
              const TensorLayout &layout,
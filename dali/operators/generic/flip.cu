@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -22,7 +22,11 @@
 namespace dali {
 
 template <>
-Flip<GPUBackend>::Flip(const OpSpec &spec) : Operator<GPUBackend>(spec) {}
+Flip<GPUBackend>::Flip(const OpSpec &spec)
+    : Operator<GPUBackend>(spec),
+      horizontal_("horizontal", spec),
+      vertical_("vertical", spec),
+      depthwise_("depthwise", spec) {}
 
 void RunKernel(TensorList<GPUBackend> &output, const TensorList<GPUBackend> &input,
                const std::vector<int32> &depthwise, const std::vector<int32> &horizontal,
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -47,36 +47,38 @@ class Flip: public Operator<Backend> {
   void RunImpl(Workspace<Backend> &ws) override;
 
   int GetHorizontal(const ArgumentWorkspace &ws, int idx) {
-    return this->spec_.template GetArgument<int>("horizontal", &ws, idx);
+    return horizontal_.Get(ws, idx);
   }
 
   int GetVertical(const ArgumentWorkspace &ws, int idx) {
-    return this->spec_.template GetArgument<int>("vertical", &ws, idx);
+    return vertical_.Get(ws, idx);
   }
 
   int GetDepthwise(const ArgumentWorkspace &ws, int idx) {
-    return this->spec_.template GetArgument<int>("depthwise", &ws, idx);
+    return depthwise_.Get(ws, idx);
   }
 
   std::vector<int> GetHorizontal(const workspace_t<Backend> &ws, int curr_batch_size) {
     std::vector<int> result;
-    OperatorBase::GetPerSampleArgument(result, "horizontal", ws, curr_batch_size);
+    OperatorBase::GetPerSampleArgument(result, horizontal_, ws, curr_batch_size);
     return result;
   }
 
   std::vector<int> GetVertical(const workspace_t<Backend> &ws, int curr_batch_size) {
     std::vector<int> result;
-    OperatorBase::GetPerSampleArgument(result, "vertical", ws, curr_batch_size);
+    OperatorBase::GetPerSampleArgument(result, vertical_, ws, curr_batch_size);
     return result;
   }
 
   std::vector<int> GetDepthwise(const workspace_t<Backend> &ws, int curr_batch_size) {
     std::vector<int> result;
-    OperatorBase::GetPerSampleArgument(result, "depthwise", ws, curr_batch_size);
+    OperatorBase::GetPerSampleArgument(result, depthwise_, ws, curr_batch_size);
     return result;
   }
 
  private:
+  ArgHandle<int> horizontal_, vertical_, depthwise_;
+
   USE_OPERATOR_MEMBERS();
 };
 
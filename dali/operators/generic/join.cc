@@ -170,9 +170,35 @@ void TensorJoin<Backend, new_axis>::SetupAxis() {
   }
 }
 
+template <typename Backend, bool new_axis>
+bool TensorJoin<Backend, new_axis>::InputsInPlace(const workspace_t<Backend> &ws,
+                                                  const TensorList<Backend> &out) const {
+  if (axis_ != 0)
+    return false;
+  int ninp = this->spec_.NumRegularInput();
+  for (int s = 0; s < out.num_samples(); s++) {
+    auto *sample_ptr = static_cast<const uint8_t *>(out.raw_tensor(s));
+    for (int i = 0; i < ninp; i++) {
+      auto &in = ws.template Input<Backend>(i);
+      int64_t bytes = in.shape().tensor_size(s) * in.type_info().size();
+      if (bytes == 0)
+        continue;
+      if (in.raw_tensor(s) != sample_ptr)
+        return false;
+      sample_ptr += bytes;
+    }
+  }
+  return true;
+}
+
 template <typename Backend, bool new_axis>
 void TensorJoin<Backend, new_axis>::RunImpl(workspace_t<Backend> &ws) {
   auto &out = ws.template Output<Backend>(0);
+  if (InputsInPlace(ws, out)) {
+    // the inputs were written directly to the output - nothing to copy
+    out.SetLayout(output_layout_);
+    return;
+  }
   if (copy_idx_ >= 0) {
     // just one non-empty input - copy it to the output and return
     TensorListShape<> shape;
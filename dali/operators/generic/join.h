@@ -73,6 +73,12 @@ class TensorJoin : public Operator<Backend> {
   template <typename T>
   void RunTyped(const TensorListView<Storage, T> &out, DeviceWorkspace &ws);
 
+  /**
+   * @brief Checks if the inputs are already placed in the output (by the executor, see
+   *        Executor::PlanInplaceJoins), one after another in each sample
+   */
+  bool InputsInPlace(const workspace_t<Backend> &ws, const TensorList<Backend> &out) const;
+
   void GetInputLayout(const workspace_t<Backend> &ws);
   void SetupAxis();
   void SetOutputLayout(const workspace_t<Backend> &ws);
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,24 +16,24 @@
 #include <utility>
 #include "dali/core/convert.h"
 #include "dali/core/span.h"
+#include "dali/kernels/common/batched_elementwise.cuh"
+#include "dali/kernels/dynamic_scratchpad.h"
 #include "dali/operators/generic/lookup_table.h"
 
 namespace dali {
 
 namespace detail {
 
-template <typename OutputType, typename InputType>
-__global__ void LookupValuesImpl(const LutSampleDesc *samples, const kernels::BlockDesc<1> *blocks,
-                                 const OutputType *lookup_table, const OutputType default_value) {
-  const auto &block = blocks[blockIdx.x];
-  const auto &sample = samples[block.sample_idx];
+template <typename OutputType>
+struct LookupValueOp {
+  const OutputType *lookup_table;
+  OutputType default_value;
 
-  auto *output = reinterpret_cast<OutputType *>(sample.output);
-  const auto *input = reinterpret_cast<const InputType *>(sample.input);
-  for (int64_t x = threadIdx.x + block.start.x; x < block.end.x; x += blockDim.x) {
-    DoLookup<GPUBackend>(output[x], input[x], lookup_table, default_value);
+  template <typename InputType>
+  __device__ __forceinline__ void operator()(OutputType &output, InputType key) const {
+    DoLookup<GPUBackend>(output, key, lookup_table, default_value);
   }
-}
+};
 
 }  // namespace detail
 
@@ -47,29 +47,27 @@ void LookupTable<GPUBackend>::RunImpl(DeviceWorkspace &ws) {
   const auto stream = ws.stream();
 
   auto num_samples = shape.num_samples();
-  samples_.resize(num_samples);
+  samples_.clear();
+  samples_.reserve(num_samples);
+  int64_t total = 0;
   for (int sample_id = 0; sample_id < num_samples; sample_id++) {
-    samples_[sample_id].output = output.raw_mutable_tensor(sample_id);
-    samples_[sample_id].input = input.raw_tensor(sample_id);
+    total = kernels::AddElementwiseSample(samples_, output.raw_mutable_tensor(sample_id),
+                                          input.raw_tensor(sample_id),
+                                          shape.tensor_size(sample_id));
   }
-  samples_dev_.from_host(samples_, stream);
-
-  auto collapsed_shape = collapse_dims<1>(shape, {std::make_pair(0, shape.sample_dim())});
+  if (samples_.empty())
+    return;
 
-  block_setup_.SetupBlocks(collapsed_shape, true);
-  blocks_dev_.from_host(block_setup_.Blocks(), stream);
+  kernels::DynamicScratchpad scratchpad({}, stream);
+  auto *samples_dev = scratchpad.ToGPU(stream, samples_);
 
   TYPE_SWITCH(input.type(), dali::type2id, InputType, LUT_IN_TYPES, (
     TYPE_SWITCH(output_type_, dali::type2id, OutputType, LUT_OUT_TYPES, (
 
-      const OutputType *lookup_table = lut_.data<OutputType>();
-      OutputType default_value = ConvertSat<OutputType>(default_value_f_);
-
-      dim3 grid_dim = block_setup_.GridDim();
-      dim3 block_dim = block_setup_.BlockDim();
-
-      detail::LookupValuesImpl<OutputType, InputType><<<grid_dim, block_dim, 0, stream>>>(
-          samples_dev_.data(), blocks_dev_.data(), lookup_table, default_value);
+      detail::LookupValueOp<OutputType> op{lut_.data<OutputType>(),
+                                           ConvertSat<OutputType>(default_value_f_)};
+      kernels::LaunchBatchedElementwise<OutputType, InputType>(
+          samples_dev, samples_.size(), total, op, stream);
 
     ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)); );       // NOLINT
   ), DALI_FAIL(make_string("Unsupported input type: ", input.type())); );     // NOLINT
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -26,11 +26,10 @@
 #include <memory>
 #include <vector>
 #include "dali/core/convert.h"
-#include "dali/core/dev_buffer.h"
 #include "dali/core/host_dev.h"
 #include "dali/core/static_switch.h"
 #include "dali/core/tensor_shape.h"
-#include "dali/kernels/common/block_setup.h"
+#include "dali/kernels/common/batched_elementwise.h"
 #include "dali/kernels/type_tag.h"
 #include "dali/pipeline/operator/operator.h"
 
@@ -45,11 +44,6 @@ void value_mem_deleter(void *ptr) {
 
 }  // namespace detail
 
-struct LutSampleDesc {
-  void *output;
-  const void *input;
-};
-
 template <typename Backend>
 class LookupTable : public Operator<Backend> {
  public:
@@ -125,12 +119,7 @@ class LookupTable : public Operator<Backend> {
   std::unique_ptr<void, void(*)(void*)> value_mem_ = {nullptr, free};
   Tensor<GPUBackend> lut_;
 
-  using GpuBlockSetup = kernels::BlockSetup<1, -1>;
-
-  GpuBlockSetup block_setup_;
-  std::vector<LutSampleDesc> samples_;
-  DeviceBuffer<GpuBlockSetup::BlockDesc> blocks_dev_;
-  DeviceBuffer<LutSampleDesc> samples_dev_;
+  std::vector<kernels::ElementwiseSampleDesc> samples_;
 
   USE_OPERATOR_MEMBERS();
 };
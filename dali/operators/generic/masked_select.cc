@@ -0,0 +1,107 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <vector>
+#include "dali/operators/generic/masked_select.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+DALI_SCHEMA(MaskedSelect)
+  .DocStr(R"code(Selects the elements of the inputs for which a boolean mask is set.
+
+The first input is the mask - a 1D boolean tensor, for example, a result of a comparison in
+an arithmetic expression. The remaining inputs are selected with the mask along their outermost
+dimension, which must have the same extent as the mask. The elements are kept in their order and
+the output ``k`` contains the selected elements of the input ``k + 1``::
+
+  out[k] = inputs[k + 1][mask]
+
+For example, to drop the small bounding boxes together with their labels::
+
+  area = (boxes[:, 2] - boxes[:, 0]) * (boxes[:, 3] - boxes[:, 1])
+  boxes, labels = fn.masked_select(area >= min_area, boxes, labels)
+
+Inputs and outputs:
+
+* **Input 0** - 1D boolean mask.
+* **Inputs 1..N** - Tensors of any type with the outermost extent equal to the length of
+  the mask.
+* **Outputs 0..N-1** - The selected elements of the inputs 1..N, with the outermost extent
+  equal to the number of the set elements of the mask.
+
+.. note::
+  The size of the outputs is only known after the mask is processed, so the GPU operator waits
+  for its CUDA stream before writing the outputs.
+)code")
+  .NumInput(2, 32)
+  .OutputFn([](const OpSpec &spec) {
+    return spec.NumRegularInput() - 1;
+  });
+
+void MaskedSelectCPU::RunImpl(HostWorkspace &ws) {
+  const auto &mask = ws.Input<CPUBackend>(0);
+  auto mask_view = view<const bool, 1>(mask);
+  int nsamples = mask_view.num_samples();
+  int ninputs = ws.NumInput() - 1;
+  auto &tp = ws.GetThreadPool();
+
+  // the masks are packed to bits, so that the runs of the selected elements are found quickly
+  bits_.resize(nsamples);
+  counts_.resize(nsamples);
+  for (int i = 0; i < nsamples; i++) {
+    int64_t len = mask_view.shape[i][0];
+    tp.AddWork([&, i, len](int) {
+      auto &bits = bits_[i];
+      bits.clear();
+      bits.resize(len, false);
+      auto *words = bits.data();
+      const bool *m = mask_view.data[i];
+      for (int64_t j = 0; j < len; j++)
+        words[bitmask::word_idx(j)] |= bitmask::bit_storage_t(m[j]) << bitmask::bit_idx(j);
+      counts_[i] = bits.count();
+    }, len);
+  }
+  tp.RunAll();
+
+  ResizeOutputs(ws, make_cspan(counts_));
+
+  for (int i = 0; i < nsamples; i++) {
+    int64_t cost = 0;
+    for (int k = 1; k <= ninputs; k++)
+      cost += counts_[i] * RowBytes(ws, k, i);
+    tp.AddWork([&, i](int) {
+      const auto &bits = bits_[i];
+      int64_t row = 0;
+      for (ptrdiff_t start = bits.find(true); start < bits.ssize(); ) {
+        ptrdiff_t end = bits.find(false, start);
+        for (int k = 1; k <= ninputs; k++) {
+          int64_t row_bytes = RowBytes(ws, k, i);
+          auto *in = static_cast<const uint8_t *>(ws.Input<CPUBackend>(k).raw_tensor(i));
+          auto *out = static_cast<uint8_t *>(ws.Output<CPUBackend>(k - 1).raw_mutable_tensor(i));
+          // a whole run of the selected elements is copied at once
+          std::memcpy(out + row * row_bytes, in + start * row_bytes, (end - start) * row_bytes);
+        }
+        row += end - start;
+        start = bits.find(true, end);
+      }
+    }, cost);
+  }
+  tp.RunAll();
+}
+
+DALI_REGISTER_OPERATOR(MaskedSelect, MaskedSelectCPU, CPU);
+
+}  // namespace dali
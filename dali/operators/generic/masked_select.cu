@@ -0,0 +1,249 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <vector>
+#include "dali/core/bitmask.h"
+#include "dali/core/cuda_error.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/operators/generic/masked_select.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+namespace masked_select {
+
+using word_t = bitmask::bit_storage_t;
+
+static constexpr int kBlockSize = 256;
+/// The number of the mask elements processed by one block - the bits of a tile fill 64 words
+static constexpr int kTileWords = 64;
+static constexpr int kTileSize = kTileWords * bitmask::storage_bits;
+/// The longest row (in bytes) copied by a single thread; the longer ones are copied by warps
+static constexpr int64_t kMaxThreadRowBytes = 64;
+
+struct MaskTile {
+  const bool *mask;
+  /// The index of the first element of the tile in the sample
+  int64_t start;
+  /// The number of the elements in the tile, up to kTileSize
+  int size;
+  int sample_idx;
+  /// The number of the selected elements in the sample before the tile
+  int64_t out_offset;
+};
+
+/**
+ * @brief One input to be compacted, in one sample
+ */
+struct CompactDesc {
+  const uint8_t *in;
+  uint8_t *out;
+  int64_t row_bytes;
+  /// The size of the words used to copy the rows: a power of 2 up to 8, dividing the row size
+  /// and the alignment of the pointers
+  int unit;
+};
+
+/**
+ * @brief Packs the mask of each tile to kTileWords words, in the layout of `bitmask`,
+ *        and counts the set bits of the tile
+ */
+__global__ void PackMaskKernel(const MaskTile *tiles, word_t *bits, int *counts) {
+  const auto tile = tiles[blockIdx.x];
+  // the words are little-endian - the lower half of a word holds the first 32 bits
+  auto *tile_bits = reinterpret_cast<uint32_t *>(bits + blockIdx.x * kTileWords);
+  __shared__ int block_count;
+  if (threadIdx.x == 0)
+    block_count = 0;
+  __syncthreads();
+
+  int lane = threadIdx.x & 31, warp = threadIdx.x >> 5;
+  int nwarps = blockDim.x >> 5;
+  int count = 0;
+  for (int base = warp * 32; base < kTileSize; base += nwarps * 32) {
+    int i = base + lane;
+    bool selected = i < tile.size && tile.mask[i];
+    unsigned ballot = __ballot_sync(0xffffffffu, selected);
+    if (lane == 0)
+      tile_bits[base >> 5] = ballot;
+    count += __popc(ballot);
+  }
+  if (lane == 0)
+    atomicAdd(&block_count, count);
+  __syncthreads();
+  if (threadIdx.x == 0)
+    counts[blockIdx.x] = block_count;
+}
+
+template <typename U>
+__device__ void CopyRow(uint8_t *dst, const uint8_t *src, int64_t n, int start, int step) {
+  auto *d = reinterpret_cast<U *>(dst);
+  auto *s = reinterpret_cast<const U *>(src);
+  for (int64_t k = start; k < n; k += step)
+    d[k] = s[k];
+}
+
+__device__ void CopyRow(uint8_t *dst, const uint8_t *src, int64_t bytes, int unit,
+                        int start, int step) {
+  switch (unit) {
+    case 8:
+      CopyRow<uint64_t>(dst, src, bytes >> 3, start, step);
+      break;
+    case 4:
+      CopyRow<uint32_t>(dst, src, bytes >> 2, start, step);
+      break;
+    case 2:
+      CopyRow<uint16_t>(dst, src, bytes >> 1, start, step);
+      break;
+    default:
+      CopyRow<uint8_t>(dst, src, bytes, start, step);
+      break;
+  }
+}
+
+/**
+ * @brief Copies the selected rows of the inputs, one tile per block
+ *
+ * The position of a selected element in the output is the number of the selected elements
+ * before its tile (from the host), plus the exclusive prefix sum of the set bits of the words
+ * of the tile, plus the number of the set bits before it in its word.
+ *
+ * The block size must be at least kTileWords.
+ */
+__global__ void CompactKernel(const MaskTile *tiles, const word_t *bits,
+                              const CompactDesc *descs, int ninputs) {
+  const auto tile = tiles[blockIdx.x];
+  const word_t *tile_bits = bits + blockIdx.x * kTileWords;
+  __shared__ word_t words[kTileWords];
+  __shared__ int word_offsets[kTileWords];
+
+  int lane = threadIdx.x & 31, warp = threadIdx.x >> 5;
+  int nwarps = blockDim.x >> 5;
+  if (threadIdx.x < kTileWords) {
+    word_t word = tile_bits[threadIdx.x];
+    words[threadIdx.x] = word;
+    int count = __popcll(word);
+    int sum = count;
+    for (int d = 1; d < 32; d *= 2) {
+      int other = __shfl_up_sync(0xffffffffu, sum, d);
+      if (lane >= d)
+        sum += other;
+    }
+    word_offsets[threadIdx.x] = sum - count;
+  }
+  __syncthreads();
+  // the second warp continues from the total of the first one
+  if (threadIdx.x >= 32 && threadIdx.x < kTileWords)
+    word_offsets[threadIdx.x] += word_offsets[31] + __popcll(words[31]);
+  __syncthreads();
+
+  auto is_selected = [&](int i) {
+    return (words[bitmask::word_idx(i)] >> bitmask::bit_idx(i)) & 1;
+  };
+  auto out_row = [&](int i) {
+    int w = bitmask::word_idx(i);
+    word_t lower = (word_t(1) << bitmask::bit_idx(i)) - 1;
+    return tile.out_offset + word_offsets[w] + __popcll(words[w] & lower);
+  };
+
+  for (int k = 0; k < ninputs; k++) {
+    const auto desc = descs[tile.sample_idx * ninputs + k];
+    if (desc.row_bytes == 0)
+      continue;
+    if (desc.row_bytes <= kMaxThreadRowBytes) {
+      for (int i = threadIdx.x; i < tile.size; i += blockDim.x) {
+        if (is_selected(i))
+          CopyRow(desc.out + out_row(i) * desc.row_bytes,
+                  desc.in + (tile.start + i) * desc.row_bytes, desc.row_bytes, desc.unit, 0, 1);
+      }
+    } else {
+      for (int i = warp; i < tile.size; i += nwarps) {
+        if (is_selected(i))
+          CopyRow(desc.out + out_row(i) * desc.row_bytes,
+                  desc.in + (tile.start + i) * desc.row_bytes, desc.row_bytes, desc.unit,
+                  lane, 32);
+      }
+    }
+  }
+}
+
+}  // namespace masked_select
+
+void MaskedSelectGPU::RunImpl(DeviceWorkspace &ws) {
+  using namespace masked_select;  // NOLINT
+  const auto &mask = ws.Input<GPUBackend>(0);
+  auto mask_view = view<const bool, 1>(mask);
+  int nsamples = mask_view.num_samples();
+  int ninputs = ws.NumInput() - 1;
+  cudaStream_t stream = ws.stream();
+  kernels::DynamicScratchpad scratchpad({}, stream);
+
+  // 1. Pack the masks to bits and count the selected elements in the tiles
+  std::vector<MaskTile> tiles;
+  for (int i = 0; i < nsamples; i++) {
+    int64_t len = mask_view.shape[i][0];
+    for (int64_t start = 0; start < len; start += kTileSize) {
+      int size = std::min<int64_t>(kTileSize, len - start);
+      tiles.push_back({mask_view.data[i] + start, start, size, i, 0});
+    }
+  }
+  int ntiles = tiles.size();
+  std::vector<int64_t> counts(nsamples, 0);
+  word_t *bits = nullptr;
+  if (ntiles > 0) {
+    auto *tiles_gpu = scratchpad.ToGPU(stream, tiles);
+    bits = scratchpad.AllocateGPU<word_t>(ntiles * kTileWords);
+    int *tile_counts_gpu = scratchpad.AllocateGPU<int>(ntiles);
+    PackMaskKernel<<<ntiles, kBlockSize, 0, stream>>>(tiles_gpu, bits, tile_counts_gpu);
+    CUDA_CALL(cudaGetLastError());
+
+    // 2. Bring the counts to the host, to size the outputs and to offset the tiles
+    int *tile_counts = scratchpad.AllocatePinned<int>(ntiles);
+    CUDA_CALL(cudaMemcpyAsync(tile_counts, tile_counts_gpu, ntiles * sizeof(int),
+                              cudaMemcpyDeviceToHost, stream));
+    CUDA_CALL(cudaStreamSynchronize(stream));
+    for (int t = 0; t < ntiles; t++) {
+      auto &count = counts[tiles[t].sample_idx];
+      tiles[t].out_offset = count;
+      count += tile_counts[t];
+    }
+  }
+
+  ResizeOutputs(ws, make_cspan(counts));
+  if (ntiles == 0)
+    return;
+
+  // 3. Copy the selected rows of all the inputs
+  std::vector<CompactDesc> descs(nsamples * ninputs);
+  for (int i = 0; i < nsamples; i++) {
+    for (int k = 0; k < ninputs; k++) {
+      auto &desc = descs[i * ninputs + k];
+      desc.in = static_cast<const uint8_t *>(ws.Input<GPUBackend>(k + 1).raw_tensor(i));
+      desc.out = static_cast<uint8_t *>(ws.Output<GPUBackend>(k).raw_mutable_tensor(i));
+      desc.row_bytes = RowBytes(ws, k + 1, i);
+      auto alignment = reinterpret_cast<uintptr_t>(desc.in) |
+                       reinterpret_cast<uintptr_t>(desc.out) | desc.row_bytes | 8;
+      desc.unit = alignment & -alignment;
+    }
+  }
+  auto *tiles_gpu = scratchpad.ToGPU(stream, tiles);
+  auto *descs_gpu = scratchpad.ToGPU(stream, descs);
+  CompactKernel<<<ntiles, kBlockSize, 0, stream>>>(tiles_gpu, bits, descs_gpu, ninputs);
+  CUDA_CALL(cudaGetLastError());
+}
+
+DALI_REGISTER_OPERATOR(MaskedSelect, MaskedSelectGPU, GPU);
+
+}  // namespace dali
@@ -0,0 +1,113 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_GENERIC_MASKED_SELECT_H_
+#define DALI_OPERATORS_GENERIC_MASKED_SELECT_H_
+
+#include <vector>
+#include "dali/core/bitmask.h"
+#include "dali/core/span.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/**
+ * @brief Selects the elements (along the outermost dimension) of the inputs 1..N
+ *        for which the boolean mask given as the input 0 is set
+ *
+ * The size of the outputs depends on the contents of the mask, so the outputs are resized
+ * when running the operator.
+ */
+template <typename Backend>
+class MaskedSelect : public Operator<Backend> {
+ public:
+  explicit MaskedSelect(const OpSpec &spec) : Operator<Backend>(spec) {}
+
+ protected:
+  bool CanInferOutputs() const override {
+    return false;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc,
+                 const workspace_t<Backend> &ws) override {
+    const auto &mask = ws.template Input<Backend>(0);
+    DALI_ENFORCE(mask.type() == DALI_BOOL, make_string(
+        "The mask must be of type bool, got ", mask.type(), "."));
+    const auto &mask_shape = mask.shape();
+    DALI_ENFORCE(mask_shape.sample_dim() == 1, make_string(
+        "The mask must be 1D, got a ", mask_shape.sample_dim(), "D input."));
+    for (int k = 1; k < ws.NumInput(); k++) {
+      const auto &in_shape = ws.template Input<Backend>(k).shape();
+      DALI_ENFORCE(in_shape.sample_dim() >= 1, make_string(
+          "The inputs selected with the mask must have at least one dimension; the input ",
+          k, " is a scalar."));
+      for (int i = 0; i < in_shape.num_samples(); i++) {
+        DALI_ENFORCE(in_shape.tensor_shape_span(i)[0] == mask_shape[i][0], make_string(
+            "The outermost extent of the input ", k, " doesn't match the length of the mask ",
+            "in the sample ", i, ": ", in_shape.tensor_shape_span(i)[0], " vs ",
+            mask_shape[i][0], "."));
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Resizes the outputs to the number of the selected elements of the samples
+   */
+  void ResizeOutputs(workspace_t<Backend> &ws, span<const int64_t> counts) {
+    for (int k = 1; k < ws.NumInput(); k++) {
+      const auto &in = ws.template Input<Backend>(k);
+      auto &out = ws.template Output<Backend>(k - 1);
+      auto out_shape = in.shape();
+      for (int i = 0; i < out_shape.num_samples(); i++)
+        out_shape.tensor_shape_span(i)[0] = counts[i];
+      out.Resize(out_shape, in.type());
+      out.SetLayout(in.GetLayout());
+    }
+  }
+
+  /**
+   * @brief The size, in bytes, of a single element (along the outermost dimension)
+   *        of a sample of the input `k`
+   */
+  static int64_t RowBytes(const workspace_t<Backend> &ws, int k, int sample_idx) {
+    const auto &in = ws.template Input<Backend>(k);
+    auto sh = in.shape().tensor_shape_span(sample_idx);
+    return volume(sh.begin() + 1, sh.end()) * in.type_info().size();
+  }
+};
+
+class MaskedSelectCPU : public MaskedSelect<CPUBackend> {
+ public:
+  using MaskedSelect<CPUBackend>::MaskedSelect;
+
+ protected:
+  void RunImpl(HostWorkspace &ws) override;
+
+ private:
+  std::vector<bitmask> bits_;
+  std::vector<int64_t> counts_;
+};
+
+class MaskedSelectGPU : public MaskedSelect<GPUBackend> {
+ public:
+  using MaskedSelect<GPUBackend>::MaskedSelect;
+
+ protected:
+  void RunImpl(DeviceWorkspace &ws) override;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_GENERIC_MASKED_SELECT_H_
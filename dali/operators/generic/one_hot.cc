@@ -41,6 +41,9 @@ For backward compatibility, any input in which all tensors have only one element
 as scalars is not supported if ``axis`` argument is specified.)code")
   .NumInput(1)
   .NumOutput(1)
+  .OutputFn([](const OpSpec &spec) {
+    return spec.GetArgument<bool>("sparse") ? 2 : 1;
+  })
   .AddOptionalArg("num_classes", R"code(Number of all classes in the data.)code", 0)
   .AddOptionalArg<int>("axis", R"code(Dimension to place the one-hot encoding axis of `num_classes`
 size. By default it's appended as the last dimension for non-scalar inputs. For scalar inputs,
@@ -56,6 +59,25 @@ This value will be cast to the ``dtype`` type.)code", 1.f)
 class in the corresponding input coordinate.
 
 This value will be cast to the ``dtype`` type.)code", 0.f)
+  .AddOptionalArg("label_smoothing",
+                  R"code(Fraction of the difference between ``on_value`` and ``off_value``
+spread evenly over all the classes.
+
+With ``label_smoothing = e``, the class indicated by the input gets
+``on_value - e * (on_value - off_value) * (1 - 1 / num_classes)`` and the other classes get
+``off_value + e * (on_value - off_value) / num_classes``. For the default values, this is
+``1 - e + e / num_classes`` and ``e / num_classes``.)code", 0.f)
+  .AddOptionalArg("sparse",
+                  R"code(If set to True, the operator returns a sparse representation of the
+one-hot encoding instead of the dense one.
+
+There are two outputs, each with one entry per input element: the flat (row-major) indices
+of the elements indicated by the input in the dense output (as int64) and their values
+(as ``dtype``). All the other elements of the dense output are equal to ``off_value``.
+For the input values outside of ``[0, num_classes)``, the index points at class 0 and the value
+is ``off_value``.
+
+For large numbers of classes, this is much smaller than the dense output.)code", false)
   .AddOptionalArg<std::string>("axis_name",
                   R"code(Single character that will be used as a name for the newly added
 dimension in the output layout. If no character is provided, the output layout will be
@@ -71,17 +93,46 @@ class OneHotCPU : public OneHot<CPUBackend> {
   void RunImpl(workspace_t<CPUBackend> &ws) override;
 
   USE_OPERATOR_MEMBERS();
+
+ private:
+  void RunSparse(workspace_t<CPUBackend> &ws, int placement_axis);
 };
 
+void OneHotCPU::RunSparse(workspace_t<CPUBackend> &ws, int placement_axis) {
+  const auto &input = ws.template Input<CPUBackend>(0);
+  auto &indices = ws.template Output<CPUBackend>(0);
+  auto &values = ws.template Output<CPUBackend>(1);
+  auto &tp = ws.GetThreadPool();
+  auto in_shape = input.shape();
+  TYPE_SWITCH(input.type(), type2id, InputType, ONE_HOT_TYPES, (
+    TYPE_SWITCH(output_type_, type2id, OutputType, ONE_HOT_TYPES, (
+      auto in_tensor = view<const InputType, DynamicDimensions>(input);
+      for (int sample_id = 0; sample_id < in_shape.num_samples(); ++sample_id) {
+        tp.AddWork(
+            [&, sample_id](int thread_id) {
+              detail::DoSparseOneHot(indices.mutable_tensor<int64_t>(sample_id),
+                                     values.mutable_tensor<OutputType>(sample_id),
+                                     in_tensor[sample_id], num_classes_, on_value_, off_value_,
+                                     placement_axis);
+            }, in_shape.tensor_size(sample_id));
+      }
+      tp.RunAll();
+    ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)))  // NOLINT
+  ), DALI_FAIL(make_string("Unsupported input type: ", input.type())))  // NOLINT
+}
+
 void OneHotCPU::RunImpl(workspace_t<CPUBackend> &ws) {
   const auto &input = ws.template Input<CPUBackend>(0);
   auto &output = ws.template Output<CPUBackend>(0);
   auto &tp = ws.GetThreadPool();
   auto in_shape = input.shape();
   auto num_samples = in_shape.num_samples();
-  int output_sample_dim = output.shape().sample_dim();
-  int placement_axis = get_placement_axis(output_sample_dim);
-  output.SetLayout(GetOutputLayout(ws, placement_axis, output_sample_dim));
+  int placement_axis = get_placement_axis(dense_sample_dim_);
+  if (sparse_) {
+    RunSparse(ws, placement_axis);
+    return;
+  }
+  output.SetLayout(GetOutputLayout(ws, placement_axis, dense_sample_dim_));
   TYPE_SWITCH(input.type(), type2id, InputType, ONE_HOT_TYPES, (
     TYPE_SWITCH(output_type_, type2id, OutputType, ONE_HOT_TYPES, (
 
@@ -57,9 +57,9 @@ bool OneHotGPU::SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_
 void OneHotGPU::RunImpl(workspace_t<GPUBackend> &ws) {
   const auto &input = ws.Input<GPUBackend>(0);
   auto &output = ws.Output<GPUBackend>(0);
-  int output_sample_dim = output.shape().sample_dim();
-  int placement_axis = get_placement_axis(output_sample_dim);
-  output.SetLayout(GetOutputLayout(ws, placement_axis, output_sample_dim));
+  int placement_axis = get_placement_axis(dense_sample_dim_);
+  if (!sparse_)
+    output.SetLayout(GetOutputLayout(ws, placement_axis, dense_sample_dim_));
   TYPE_SWITCH(input.type(), type2id, InputType, ONE_HOT_TYPES, (
     TYPE_SWITCH(output_type_, type2id, OutputType, ONE_HOT_TYPES, (
       RunImplTyped<OutputType, InputType>(ws, placement_axis);
@@ -70,22 +70,27 @@ void OneHotGPU::RunImpl(workspace_t<GPUBackend> &ws) {
 template <typename OutputType, typename InputType>
 void OneHotGPU::RunImplTyped(workspace_t<GPUBackend> &ws, int axis) {
   const auto &input = ws.Input<GPUBackend>(0);
-  auto &output = ws.Output<GPUBackend>(0);
+  // in the sparse mode, the outputs are the indices and the values
+  auto &output = ws.Output<GPUBackend>(sparse_ ? 1 : 0);
   int num_samples = input.shape().num_samples();
 
-  uint64_t max_out_vol = 1;
-  const auto &shape = output.shape();
+  uint64_t max_out_vol = 1, max_in_vol = 1;
+  const auto &in_shape = input.shape();
   for (int sample_id = 0; sample_id < num_samples; ++sample_id) {
     detail::SampleDesc sample;
-    auto output_shape = shape.tensor_shape_span(sample_id);
+    auto output_shape = determine_shape(in_shape[sample_id], dense_sample_dim_);
     auto outer_vol = volume(output_shape.begin(), output_shape.begin() + axis);
     sample.inner_vol = volume(output_shape.begin() + axis + 1, output_shape.end());
     sample.inner_vol_classes = sample.inner_vol * num_classes_;
     sample.output_vol = outer_vol * sample.inner_vol_classes;
+    sample.input_vol = in_shape.tensor_size(sample_id);
     sample.out = output.mutable_tensor<OutputType>(sample_id);
     sample.in = input.tensor<InputType>(sample_id);
+    if (sparse_)
+      sample.indices = ws.Output<GPUBackend>(0).mutable_tensor<int64_t>(sample_id);
     sample_descs_.push_back(sample);
     max_out_vol = std::max(max_out_vol, sample.output_vol);
+    max_in_vol = std::max(max_in_vol, sample.input_vol);
   }
 
   auto stream = ws.stream();
@@ -93,11 +98,17 @@ void OneHotGPU::RunImplTyped(workspace_t<GPUBackend> &ws, int axis) {
   scratch_mem_.Copy(sample_descs_, stream);
   const auto *scratch_mem_gpu = scratch_mem_.data<detail::SampleDesc>();
 
-  const int block = 256;
-  auto grid = detail::gridHelper(max_out_vol, num_samples, block);
-
-  detail::PopulateOneHot<OutputType, InputType><<<grid, block, 0, stream>>>(
-    on_value_, off_value_, scratch_mem_gpu);
+  if (sparse_) {
+    const int block = 256;
+    auto grid = detail::gridHelper(max_in_vol, num_samples, block);
+    detail::PopulateSparseOneHot<OutputType, InputType><<<grid, block, 0, stream>>>(
+        on_value_, off_value_, num_classes_, scratch_mem_gpu);
+  } else {
+    detail::LaunchOneHot<OutputType, InputType>(on_value_, off_value_, num_classes_,
+                                                scratch_mem_gpu, num_samples, max_out_vol,
+                                                max_in_vol, stream);
+  }
+  CUDA_CALL(cudaGetLastError());
 }
 
 DALI_REGISTER_OPERATOR(OneHot, OneHotGPU, GPU);
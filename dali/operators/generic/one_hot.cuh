@@ -21,26 +21,73 @@ namespace dali {
 namespace detail {
 
 struct SampleDesc {
-  uint64_t inner_vol, output_vol, inner_vol_classes;
+  uint64_t inner_vol, output_vol, inner_vol_classes, input_vol;
   void *out = nullptr;
   const void *in = nullptr;
+  int64_t *indices = nullptr;  // only for the sparse output
 };
 
-template <typename OutputType, typename InputType>
-__global__ void PopulateOneHot(OutputType on_value, OutputType off_value,
-                               const SampleDesc *samples) {
+template <typename InputType>
+__device__ int64_t GetClass(const SampleDesc &sample, uint64_t in_index, int64_t num_classes) {
+  auto cls = static_cast<int64_t>(static_cast<const InputType*>(sample.in)[in_index]);
+  return cls >= 0 && cls < num_classes ? cls : -1;
+}
+
+/**
+ * @brief Fills the whole output with `off_value`
+ */
+template <typename OutputType>
+__global__ void FillOneHot(OutputType off_value, const SampleDesc *samples) {
   uint64_t out_index = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
   uint64_t grid_size = gridDim.x * blockDim.x;
   const auto &sample = samples[blockIdx.y];
-  for (; out_index < sample.output_vol; out_index += grid_size) {
-    auto *out = static_cast<OutputType*>(sample.out);
-    auto *in = static_cast<const InputType*>(sample.in);
-    uint64_t i = out_index / sample.inner_vol_classes;
-    uint64_t j = out_index % sample.inner_vol;
-    uint64_t in_index = i * sample.inner_vol + j;
-    uint64_t in_val = in[in_index];
-    uint64_t on_out_index = i * sample.inner_vol_classes + in_val * sample.inner_vol + j;
-    out[out_index] = on_out_index == out_index ? on_value : off_value;
+  auto *out = static_cast<OutputType*>(sample.out);
+  for (; out_index < sample.output_vol; out_index += grid_size)
+    out[out_index] = off_value;
+}
+
+/**
+ * @brief Writes `on_value` at the positions indicated by the input, one thread per input element
+ *
+ * Must run after FillOneHot.
+ */
+template <typename OutputType, typename InputType>
+__global__ void ScatterOneHot(OutputType on_value, int64_t num_classes,
+                              const SampleDesc *samples) {
+  uint64_t in_index = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  uint64_t grid_size = gridDim.x * blockDim.x;
+  const auto &sample = samples[blockIdx.y];
+  auto *out = static_cast<OutputType*>(sample.out);
+  for (; in_index < sample.input_vol; in_index += grid_size) {
+    int64_t cls = GetClass<InputType>(sample, in_index, num_classes);
+    if (cls < 0)
+      continue;
+    uint64_t i = in_index / sample.inner_vol;
+    uint64_t j = in_index % sample.inner_vol;
+    out[i * sample.inner_vol_classes + cls * sample.inner_vol + j] = on_value;
+  }
+}
+
+/**
+ * @brief Writes the flat index of the class in the dense output and the value, for each input
+ *        element
+ *
+ * The classes out of range are stored as class 0 with `off_value`.
+ */
+template <typename OutputType, typename InputType>
+__global__ void PopulateSparseOneHot(OutputType on_value, OutputType off_value,
+                                     int64_t num_classes, const SampleDesc *samples) {
+  uint64_t in_index = static_cast<uint64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  uint64_t grid_size = gridDim.x * blockDim.x;
+  const auto &sample = samples[blockIdx.y];
+  auto *values = static_cast<OutputType*>(sample.out);
+  for (; in_index < sample.input_vol; in_index += grid_size) {
+    int64_t cls = GetClass<InputType>(sample, in_index, num_classes);
+    uint64_t i = in_index / sample.inner_vol;
+    uint64_t j = in_index % sample.inner_vol;
+    sample.indices[in_index] = i * sample.inner_vol_classes + (cls < 0 ? 0 : cls) *
+                               sample.inner_vol + j;
+    values[in_index] = cls < 0 ? off_value : on_value;
   }
 }
 
@@ -50,6 +97,22 @@ dim3 gridHelper(uint64_t output_vol, int batch_size, int block = 256,
   return dim3(block_size, batch_size);
 }
 
+/**
+ * @brief Computes the dense one-hot encoding: fills the outputs with `off_value` and then
+ *        scatters `on_value`, instead of checking the class for every output element
+ */
+template <typename OutputType, typename InputType>
+void LaunchOneHot(OutputType on_value, OutputType off_value, int64_t num_classes,
+                  const SampleDesc *samples_gpu, int num_samples,
+                  uint64_t max_out_vol, uint64_t max_in_vol, cudaStream_t stream) {
+  const int block = 256;
+  auto fill_grid = gridHelper(max_out_vol, num_samples, block);
+  FillOneHot<<<fill_grid, block, 0, stream>>>(off_value, samples_gpu);
+  auto scatter_grid = gridHelper(max_in_vol, num_samples, block);
+  ScatterOneHot<OutputType, InputType><<<scatter_grid, block, 0, stream>>>(
+      on_value, num_classes, samples_gpu);
+}
+
 }  // namespace detail
 
 }  // namespace dali
@@ -50,6 +50,31 @@ void DoOneHot(kernels::OutTensorCPU<Out, DynamicDimensions> output,
   }
 }
 
+/**
+ * @brief Computes the sparse representation of the one-hot encoding: for each input element,
+ *        the flat index of its class in the dense output and the value stored there
+ *
+ * Out-of-range classes are stored as class 0 with `off_value`.
+ */
+template<typename Out, typename In>
+void DoSparseOneHot(int64_t *indices, Out *values,
+                    kernels::InTensorCPU<In, DynamicDimensions> input, int num_classes,
+                    same_as_t<Out> on_value, same_as_t<Out> off_value, int axis) {
+  auto in = input.data;
+  auto volume_outer = volume(input.shape.begin(), input.shape.begin() + axis);
+  auto volume_inner = volume(input.shape.begin() + axis, input.shape.end());
+  for (int64_t outer_coord = 0; outer_coord < volume_outer; outer_coord++) {
+    for (int64_t inner_coord = 0; inner_coord < volume_inner; inner_coord++) {
+      int64_t in_idx = outer_coord * volume_inner + inner_coord;
+      int cls = in[in_idx];
+      bool valid = cls >= 0 && cls < num_classes;
+      indices[in_idx] = (outer_coord * num_classes + (valid ? cls : 0)) * volume_inner +
+                        inner_coord;
+      values[in_idx] = valid ? on_value : off_value;
+    }
+  }
+}
+
 }  // namespace detail
 
 template <typename Backend>
@@ -60,7 +85,18 @@ class OneHot : public Operator<Backend> {
         axis_(spec.GetArgument<int>("axis")),
         output_type_(spec.GetArgument<DALIDataType>(arg_names::kDtype)),
         on_value_(spec.GetArgument<float>("on_value")),
-        off_value_(spec.GetArgument<float>("off_value")) {
+        off_value_(spec.GetArgument<float>("off_value")),
+        sparse_(spec.GetArgument<bool>("sparse")) {
+    float label_smoothing = spec.GetArgument<float>("label_smoothing");
+    DALI_ENFORCE(label_smoothing >= 0 && label_smoothing <= 1, make_string(
+        "`label_smoothing` must be in range [0, 1], got: ", label_smoothing, "."));
+    if (label_smoothing > 0) {
+      DALI_ENFORCE(num_classes_ > 0, "`label_smoothing` requires a positive `num_classes`.");
+      // a fraction of the difference between the values is spread evenly over all the classes
+      float spread = (on_value_ - off_value_) * label_smoothing;
+      on_value_ += spread / num_classes_ - spread;
+      off_value_ += spread / num_classes_;
+    }
     if (spec.HasArgument("axis_name")) {
       auto axis_name = spec.GetArgument<std::string>("axis_name");
       DALI_ENFORCE(axis_name.length() == 1,
@@ -93,18 +129,32 @@ class OneHot : public Operator<Backend> {
       all_scalars = all_scalars && is_scalar(input.shape()[i]);
     }
 
-    int output_sample_dim = all_scalars ? 1 : input_sample_dim + 1;
-    output_desc.resize(1);
-
-    output_desc[0].shape.resize(num_samples, output_sample_dim);
+    dense_sample_dim_ = all_scalars ? 1 : input_sample_dim + 1;
+    TYPE_SWITCH(output_type_, type2id, DType, ONE_HOT_TYPES, (
+                (void)DType(); /* silence warnings */),
+                DALI_FAIL(make_string("Unsupported output type: ", output_type_))) // NOLINT
 
     const auto& shape = input.shape();
+    if (sparse_) {
+      // one entry per input element - the flat index in the dense output and the value
+      output_desc.resize(2);
+      output_desc[0].shape.resize(num_samples, 1);
+      output_desc[1].shape.resize(num_samples, 1);
+      for (int i = 0; i < num_samples; i++) {
+        TensorShape<> entries_shape{shape.tensor_size(i)};
+        output_desc[0].shape.set_tensor_shape(i, entries_shape);
+        output_desc[1].shape.set_tensor_shape(i, entries_shape);
+      }
+      output_desc[0].type = DALI_INT64;
+      output_desc[1].type = output_type_;
+      return true;
+    }
+
+    output_desc.resize(1);
+    output_desc[0].shape.resize(num_samples, dense_sample_dim_);
     for (int i = 0; i < num_samples; i++) {
-      output_desc[0].shape.set_tensor_shape(i, determine_shape(shape[i], output_sample_dim));
+      output_desc[0].shape.set_tensor_shape(i, determine_shape(shape[i], dense_sample_dim_));
     }
-    TYPE_SWITCH(output_type_, type2id, DType, ONE_HOT_TYPES, (
-                (void)DType(); /* silence warnings */),
-                DALI_FAIL(make_string("Unsupported output type: ", output_type_))) // NOLINT
     output_desc[0].type = output_type_;
     return true;
   };
@@ -157,7 +207,10 @@ class OneHot : public Operator<Backend> {
   const DALIDataType output_type_;
   float on_value_;
   float off_value_;
+  bool sparse_;
   char new_axis_name_ = 0;
+  /// the number of dimensions of the dense one-hot encoding
+  int dense_sample_dim_ = 0;
 };
 
 }  // namespace dali
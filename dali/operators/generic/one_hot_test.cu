@@ -69,6 +69,7 @@ struct OneHotOpGpuPerfTest : public ::testing::Test {
       samples_cpu(sample_id)->inner_vol = inner_vol;
       samples_cpu(sample_id)->inner_vol_classes = inner_vol_classes;
       samples_cpu(sample_id)->output_vol = output_vol;
+      samples_cpu(sample_id)->input_vol = volume(input_shape);
       samples_cpu(sample_id)->out = output_gpu[sample_id].data;
       samples_cpu(sample_id)->in = input_gpu[sample_id].data;
     }
@@ -79,21 +80,20 @@ struct OneHotOpGpuPerfTest : public ::testing::Test {
     auto input_vol = volume(config_.shape);
     auto output_vol = input_vol * config_.num_classes;
 
-    const int block = 256;
-    auto grid = detail::gridHelper(output_vol, config_.batch_size, block);
-
     Out on_value = 1, off_value = 0;
-    detail::PopulateOneHot<Out, In><<<grid, block, 0, stream_>>>(on_value, off_value, samples_gpu_);
+    auto run = [&]() {
+      detail::LaunchOneHot<Out, In>(on_value, off_value, config_.num_classes, samples_gpu_,
+                                    config_.batch_size, output_vol, input_vol, stream_);
+    };
+    run();
 
     CUDAEvent start = CUDAEvent::CreateWithFlags(0);
     CUDAEvent end = CUDAEvent::CreateWithFlags(0);
 
     CUDA_CALL(cudaEventRecord(start, stream_));
     constexpr int kIters = 100;
-    for (int i = 0; i < kIters; i++) {
-      detail::PopulateOneHot<Out, In><<<grid, block, 0, stream_>>>(
-        on_value, off_value, samples_gpu_);
-    }
+    for (int i = 0; i < kIters; i++)
+      run();
     CUDA_CALL(cudaEventRecord(end, stream_));
     CUDA_CALL(cudaDeviceSynchronize());
     float time;
@@ -61,6 +61,16 @@ class AxesHelper {
   TensorLayout axis_names_;
 };
 
+/**
+ * @brief Whether a sample should be reduced by all the threads, rather than by one of them
+ *
+ * It's the case when the sample is larger than the share of the batch volume of one thread.
+ */
+inline bool IsLargeSample(int64_t sample_volume, int64_t batch_volume, int num_threads) {
+  return num_threads > 1 && sample_volume >= 2 * kernels::reduce_impl::kMinParallelBlockVolume &&
+         sample_volume * num_threads > batch_volume;
+}
+
 }  // namespace detail
 
 template <
@@ -121,8 +131,13 @@ class Reduce : public Operator<Backend>, detail::AxesHelper {
     using Kernel = ReductionType<OutputType, InputType>;
     kmgr_.template Resize<Kernel>(num_threads);
 
+    SmallVector<int, 8> large_samples;
     for (int sample = 0; sample < in_view.num_samples(); sample++) {
       int64_t priority = volume(in_view.shape.tensor_shape_span(sample));
+      if (detail::IsLargeSample(priority, in_view.num_elements(), num_threads)) {
+        large_samples.push_back(sample);
+        continue;
+      }
       thread_pool.AddWork(
         [&, sample](int thread_id) {
           auto in_sample_view = in_view[sample];
@@ -136,6 +151,12 @@ class Reduce : public Operator<Backend>, detail::AxesHelper {
         priority);
     }
     thread_pool.RunAll();
+
+    for (int sample : large_samples) {
+      Kernel kernel;
+      kernel.Setup(out_view[sample], in_view[sample], make_cspan(axes_));
+      kernel.RunParallel(thread_pool);
+    }
   }
 
   template <typename OutputType, typename InputType>
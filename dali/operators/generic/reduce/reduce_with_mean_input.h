@@ -99,8 +99,14 @@ class ReduceWithMeanInput : public Operator<Backend>, detail::AxesHelper {
     using Kernel = ReductionType<OutputType, InputType, OutputType>;
     kmgr_.template Resize<Kernel>(num_threads);
 
+    SmallVector<int, 8> large_samples;
     for (int sample = 0; sample < in_view.num_samples(); sample++) {
       int64_t priority = volume(in_view.shape.tensor_shape_span(sample));
+      if (!has_empty_axes_arg_ &&
+          detail::IsLargeSample(priority, in_view.num_elements(), num_threads)) {
+        large_samples.push_back(sample);
+        continue;
+      }
       thread_pool.AddWork(
         [&, sample](int thread_id) {
           auto in_sample_view = in_view[sample];
@@ -126,6 +132,14 @@ class ReduceWithMeanInput : public Operator<Backend>, detail::AxesHelper {
         priority);
     }
     thread_pool.RunAll();
+
+    for (int sample : large_samples) {
+      Kernel kernel;
+      kernels::KernelContext ctx;
+      kernel.Setup(ctx, out_view[sample], in_view[sample], make_cspan(axes_), mean_view[sample],
+                   ddof_);
+      kernel.RunParallel(thread_pool);
+    }
   }
 
   template <typename OutputType, typename InputType>
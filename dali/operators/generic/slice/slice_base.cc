@@ -49,7 +49,7 @@ template <typename OutputType, typename InputType, int Dims>
 bool SliceBaseCpu<OutputType, InputType, Dims>::SetupImpl(std::vector<OutputDesc> &output_desc,
                                                           const workspace_t<CPUBackend> &ws) {
   const auto &input = ws.template Input<CPUBackend>(0);
-  auto in_shape = input.shape();
+  const auto &in_shape = input.shape();
   int nsamples = in_shape.num_samples();
   auto nthreads = ws.GetThreadPool().NumThreads();
   assert(nsamples == static_cast<int>(args_.size()));
@@ -75,7 +75,7 @@ void SliceBaseCpu<OutputType, InputType, Dims>::RunImpl(workspace_t<CPUBackend>
 
   int nsamples = input.num_samples();
   auto& thread_pool = ws.GetThreadPool();
-  auto out_shape = output.shape();
+  const auto &out_shape = output.shape();
 
   auto in_view = view<const InputType, Dims>(input);
   auto out_view = view<OutputType, Dims>(output);
@@ -56,7 +56,7 @@ class SliceBase : public Operator<Backend> {
                 const workspace_t<Backend> &ws) {
     this->ProcessCroppingAttrs(spec_, ws);
     const auto &input = ws.template Input<Backend>(0);
-    auto in_shape = input.shape();
+    const auto &in_shape = input.shape();
     int nsamples = in_shape.num_samples();
     int ndim = in_shape.sample_dim();
     auto in_layout = input.GetLayout();
@@ -0,0 +1,66 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/operators/generic/split_merge.h"
+
+namespace dali {
+
+DALI_SCHEMA(_conditional__Split)
+  .DocStr(R"code(Splits the batch into the samples for which the ``predicate`` is true and
+the ones for which it is false.
+
+The first output contains the samples for which the ``predicate`` is true, the second one -
+the remaining samples, both in the order of the input batch. The outputs can be processed
+by different operators (the branches of a conditional), each running only on its part of the
+batch, and merged back with :meth:`nvidia.dali.fn._conditional.merge` using the same
+``predicate``::
+
+  flip = fn.random.coin_flip(dtype=types.BOOL)
+  flipped, kept = fn._conditional.split(images, predicate=flip)
+  flipped = fn.flip(flipped)
+  images = fn._conditional.merge(flipped, kept, predicate=flip)
+
+The operators in a branch process as many samples as they get. All of them must take
+(directly or not) the outputs of the split as their inputs.)code")
+  .NumInput(1)
+  .NumOutput(2)
+  .AddArg("predicate",
+      R"code(Per-sample boolean scalars selecting the output for each sample.)code",
+      DALI_BOOL, true);
+
+DALI_SCHEMA(_conditional__Merge)
+  .DocStr(R"code(Merges the outputs of the branches of a conditional into a single batch.
+
+The first input contains the samples for which the ``predicate`` is true, the second one -
+the samples for which it is false, as split by :meth:`nvidia.dali.fn._conditional.split`.
+The output has the order of the batch split with the same ``predicate``.
+
+Both inputs must have the same type, number of dimensions and layout, unless one of them
+is empty.)code")
+  .NumInput(2)
+  .NumOutput(1)
+  .AddArg("predicate",
+      R"code(Per-sample boolean scalars selecting the input for each output sample.)code",
+      DALI_BOOL, true);
+
+template <>
+void SplitMergeBase<CPUBackend>::RunCopies(HostWorkspace &ws) {
+  scatter_gather_.Run(ws.GetThreadPool(), true);
+}
+
+DALI_REGISTER_OPERATOR(_conditional__Split, Split<CPUBackend>, CPU);
+DALI_REGISTER_OPERATOR(_conditional__Merge, Merge<CPUBackend>, CPU);
+
+}  // namespace dali
@@ -0,0 +1,214 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_OPERATORS_GENERIC_SPLIT_MERGE_H_
+#define DALI_OPERATORS_GENERIC_SPLIT_MERGE_H_
+
+#include <type_traits>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/core/format.h"
+#include "dali/kernels/common/scatter_gather.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/**
+ * @brief Common part of the operators splitting the batch into the branches of a conditional
+ *        and merging the branches back.
+ *
+ * The per-sample predicate comes from the ``predicate`` argument input. The samples are copied
+ * between the batches with scatter-gather.
+ *
+ * The outputs of these operators don't match the size of the first input, so the uniform batch
+ * size isn't enforced for them.
+ */
+template <typename Backend>
+class SplitMergeBase : public Operator<Backend> {
+ public:
+  explicit SplitMergeBase(const OpSpec &spec)
+      : Operator<Backend>(spec), scatter_gather_(kMaxSizePerBlock) {
+    DALI_ENFORCE(spec.HasTensorArgument("predicate"),
+                 "The ``predicate`` must be a batch of per-sample boolean values.");
+  }
+
+  using Operator<Backend>::Run;
+
+  void Run(workspace_t<Backend> &ws) override {
+    this->RunImpl(ws);
+  }
+
+ protected:
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  /**
+   * @brief Reads the per-sample predicate and counts the samples in each branch.
+   */
+  void ReadPredicate(const workspace_t<Backend> &ws) {
+    const auto &predicate = ws.ArgumentInput("predicate");
+    DALI_ENFORCE(predicate.type() == DALI_BOOL,
+                 make_string("The ``predicate`` must be a batch of boolean values, got: ",
+                             predicate.type(), "."));
+    int nsamples = predicate.num_samples();
+    predicate_.resize(nsamples);
+    num_true_ = 0;
+    for (int i = 0; i < nsamples; i++) {
+      DALI_ENFORCE(volume(predicate.tensor_shape(i)) == 1,
+                   make_string("The ``predicate`` must be a scalar, got a sample of shape: ",
+                               predicate.tensor_shape(i), "."));
+      predicate_[i] = *predicate.template tensor<bool>(i);
+      num_true_ += predicate_[i];
+    }
+  }
+
+  /**
+   * @brief Schedules the copy of `src`[`src_idx`] to `dst`[`dst_idx`].
+   */
+  void AddSampleCopy(TensorList<Backend> &dst, int dst_idx, const TensorList<Backend> &src,
+                     int src_idx) {
+    dst.SetMeta(dst_idx, src.GetMeta(src_idx));
+    scatter_gather_.AddCopy(dst.raw_mutable_tensor(dst_idx), src.raw_tensor(src_idx),
+                            volume(src.tensor_shape(src_idx)) * src.type_info().size());
+  }
+
+  void RunCopies(workspace_t<Backend> &ws);
+
+  std::vector<bool> predicate_;
+  int num_true_ = 0;
+
+ private:
+  std::conditional_t<
+      std::is_same<Backend, CPUBackend>::value,
+      kernels::ScatterGatherCPU,
+      kernels::ScatterGatherGPU> scatter_gather_;
+  // 256 kB per block for GPU
+  static constexpr size_t kMaxSizePerBlock =
+      std::is_same<Backend, CPUBackend>::value ? kernels::ScatterGatherCPU::kAnyBlockSize : 1 << 18;
+};
+
+/**
+ * @brief Splits the batch into the samples for which the predicate is true (the first output)
+ *        and the ones for which it's false (the second output), preserving their order.
+ */
+template <typename Backend>
+class Split : public SplitMergeBase<Backend> {
+ public:
+  using SplitMergeBase<Backend>::SplitMergeBase;
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override {
+    const auto &input = ws.template Input<Backend>(0);
+    this->ReadPredicate(ws);
+    int nsamples = input.num_samples();
+    output_desc.resize(2);
+    output_desc[0].shape.resize(this->num_true_, input.sample_dim());
+    output_desc[1].shape.resize(nsamples - this->num_true_, input.sample_dim());
+    int next[2] = {0, 0};
+    for (int i = 0; i < nsamples; i++) {
+      int branch = this->predicate_[i] ? 0 : 1;
+      output_desc[branch].shape.set_tensor_shape(next[branch]++, input.tensor_shape(i));
+    }
+    output_desc[0].type = output_desc[1].type = input.type();
+    return true;
+  }
+
+  void RunImpl(workspace_t<Backend> &ws) override {
+    const auto &input = ws.template Input<Backend>(0);
+    TensorList<Backend> *outputs[2] = {&ws.template Output<Backend>(0),
+                                       &ws.template Output<Backend>(1)};
+    for (auto *output : outputs)
+      output->SetLayout(input.GetLayout());
+    int next[2] = {0, 0};
+    for (int i = 0; i < input.num_samples(); i++) {
+      int branch = this->predicate_[i] ? 0 : 1;
+      this->AddSampleCopy(*outputs[branch], next[branch]++, input, i);
+    }
+    this->RunCopies(ws);
+  }
+};
+
+/**
+ * @brief Merges the outputs of the branches of a conditional back into a single batch, in the
+ *        order of the batch split with the same predicate.
+ */
+template <typename Backend>
+class Merge : public SplitMergeBase<Backend> {
+ public:
+  using SplitMergeBase<Backend>::SplitMergeBase;
+
+  using SplitMergeBase<Backend>::Setup;
+
+  // The branches have different batch sizes, so the uniform batch size isn't enforced
+  bool Setup(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override {
+    return SetupImpl(output_desc, ws);
+  }
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override {
+    const auto &true_input = ws.template Input<Backend>(0);
+    const auto &false_input = ws.template Input<Backend>(1);
+    this->ReadPredicate(ws);
+    int nsamples = this->predicate_.size();
+    DALI_ENFORCE(true_input.num_samples() == this->num_true_ &&
+                 false_input.num_samples() == nsamples - this->num_true_,
+                 make_string("The branches don't match the predicate: expected ", this->num_true_,
+                             " samples in the true branch and ", nsamples - this->num_true_,
+                             " in the false branch, got ", true_input.num_samples(), " and ",
+                             false_input.num_samples(), "."));
+    // the type, dimensionality and layout of an empty branch don't matter
+    bool both = true_input.num_samples() > 0 && false_input.num_samples() > 0;
+    DALI_ENFORCE(!both || true_input.type() == false_input.type(),
+                 make_string("The branches must produce the same type, got: ", true_input.type(),
+                             " and ", false_input.type(), "."));
+    DALI_ENFORCE(!both || true_input.sample_dim() == false_input.sample_dim(),
+                 make_string("The branches must produce the same number of dimensions, got: ",
+                             true_input.sample_dim(), " and ", false_input.sample_dim(), "."));
+    DALI_ENFORCE(!both || true_input.GetLayout() == false_input.GetLayout(),
+                 make_string("The branches must produce the same layout, got: \"",
+                             true_input.GetLayout(), "\" and \"", false_input.GetLayout(),
+                             "\"."));
+    const TensorList<Backend> *inputs[2] = {&true_input, &false_input};
+    const auto &ref = true_input.num_samples() > 0 ? true_input : false_input;
+    output_desc.resize(1);
+    output_desc[0].shape.resize(nsamples, ref.sample_dim());
+    output_desc[0].type = ref.type();
+    int next[2] = {0, 0};
+    for (int i = 0; i < nsamples; i++) {
+      int branch = this->predicate_[i] ? 0 : 1;
+      output_desc[0].shape.set_tensor_shape(i, inputs[branch]->tensor_shape(next[branch]++));
+    }
+    return true;
+  }
+
+  void RunImpl(workspace_t<Backend> &ws) override {
+    const TensorList<Backend> *inputs[2] = {&ws.template Input<Backend>(0),
+                                            &ws.template Input<Backend>(1)};
+    auto &output = ws.template Output<Backend>(0);
+    output.SetLayout(inputs[0]->num_samples() > 0 ? inputs[0]->GetLayout()
+                                                  : inputs[1]->GetLayout());
+    int next[2] = {0, 0};
+    for (int i = 0; i < output.num_samples(); i++) {
+      int branch = this->predicate_[i] ? 0 : 1;
+      this->AddSampleCopy(output, i, *inputs[branch], next[branch]++);
+    }
+    this->RunCopies(ws);
+  }
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_GENERIC_SPLIT_MERGE_H_
@@ -41,14 +41,13 @@ class TransposeCPU : public Transpose<CPUBackend> {
 
     TYPE_SWITCH(input_type, type2id, T, TRANSPOSE_ALLOWED_TYPES, (
       for (int i = 0; i < nsamples; i++) {
-        thread_pool.AddWork(
-          [this, &input, &output, i](int thread_id) {
-            TensorShape<> src_ts = input.shape()[i];
-            auto dst_ts = permute(src_ts, perm_);
-            kernels::TransposeGrouped(
-                TensorView<StorageCPU, T>{output.mutable_tensor<T>(i), dst_ts},
-                TensorView<StorageCPU, const T>{input.tensor<T>(i), src_ts}, make_cspan(perm_));
-          }, out_shape.tensor_size(i));
+        // large samples are split into blocks, so that they can be processed in parallel
+        TensorShape<> src_ts = input.shape()[i];
+        auto dst_ts = permute(src_ts, perm_);
+        kernels::TransposeGrouped(
+            TensorView<StorageCPU, T>{output.mutable_tensor<T>(i), dst_ts},
+            TensorView<StorageCPU, const T>{input.tensor<T>(i), src_ts}, make_cspan(perm_),
+            thread_pool);
       }
     ), DALI_FAIL(make_string("Unsupported input type: ", input_type)));  // NOLINT
     thread_pool.RunAll();
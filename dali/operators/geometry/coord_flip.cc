@@ -68,14 +68,14 @@ void CoordFlipCPU::RunImpl(workspace_t<CPUBackend> &ws) {
 
   for (int sample_id = 0; sample_id < curr_batch_size; sample_id++) {
     std::array<bool, 3> flip_dim = {false, false, false};
-    flip_dim[x_dim_] = spec_.GetArgument<int>("flip_x", &ws, sample_id);
-    flip_dim[y_dim_] = spec_.GetArgument<int>("flip_y", &ws, sample_id);
-    flip_dim[z_dim_] = spec_.GetArgument<int>("flip_z", &ws, sample_id);
+    flip_dim[x_dim_] = flip_x_.Get(ws, sample_id);
+    flip_dim[y_dim_] = flip_y_.Get(ws, sample_id);
+    flip_dim[z_dim_] = flip_z_.Get(ws, sample_id);
 
     std::array<float, 3> mirrored_origin = {1.0f, 1.0f, 1.0f};
-    mirrored_origin[x_dim_] = 2.0f * spec_.GetArgument<float>("center_x", &ws, sample_id);
-    mirrored_origin[y_dim_] = 2.0f * spec_.GetArgument<float>("center_y", &ws, sample_id);
-    mirrored_origin[z_dim_] = 2.0f * spec_.GetArgument<float>("center_z", &ws, sample_id);
+    mirrored_origin[x_dim_] = 2.0f * center_x_.Get(ws, sample_id);
+    mirrored_origin[y_dim_] = 2.0f * center_y_.Get(ws, sample_id);
+    mirrored_origin[z_dim_] = 2.0f * center_z_.Get(ws, sample_id);
 
     auto in_size = volume(input.tensor_shape(sample_id));
     thread_pool.AddWork(
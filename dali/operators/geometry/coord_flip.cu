@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -79,9 +79,9 @@ void CoordFlipGPU::RunImpl(workspace_t<GPUBackend> &ws) {
     sample_desc.size = volume(input.tensor_shape(sample_id));
     assert(sample_desc.size == volume(output.tensor_shape(sample_id)));
 
-    bool flip_x = spec_.GetArgument<int>("flip_x", &ws, sample_id);
-    bool flip_y = spec_.GetArgument<int>("flip_y", &ws, sample_id);
-    bool flip_z = spec_.GetArgument<int>("flip_z", &ws, sample_id);
+    bool flip_x = flip_x_.Get(ws, sample_id);
+    bool flip_y = flip_y_.Get(ws, sample_id);
+    bool flip_z = flip_z_.Get(ws, sample_id);
 
     if (flip_x) {
       sample_desc.flip_dim_mask |= (1 << x_dim_);
@@ -95,12 +95,9 @@ void CoordFlipGPU::RunImpl(workspace_t<GPUBackend> &ws) {
       sample_desc.flip_dim_mask |= (1 << z_dim_);
     }
 
-    sample_desc.mirrored_origin[x_dim_] =
-        2.0f * spec_.GetArgument<float>("center_x", &ws, sample_id);
-    sample_desc.mirrored_origin[y_dim_] =
-        2.0f * spec_.GetArgument<float>("center_y", &ws, sample_id);
-    sample_desc.mirrored_origin[z_dim_] =
-        2.0f * spec_.GetArgument<float>("center_z", &ws, sample_id);
+    sample_desc.mirrored_origin[x_dim_] = 2.0f * center_x_.Get(ws, sample_id);
+    sample_desc.mirrored_origin[y_dim_] = 2.0f * center_y_.Get(ws, sample_id);
+    sample_desc.mirrored_origin[z_dim_] = 2.0f * center_z_.Get(ws, sample_id);
 
     sample_descs_.emplace_back(std::move(sample_desc));
   }
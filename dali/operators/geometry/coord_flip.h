@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -28,7 +28,9 @@ class CoordFlip : public Operator<Backend> {
  public:
   explicit CoordFlip(const OpSpec &spec)
       : Operator<Backend>(spec)
-      , layout_(spec.GetArgument<TensorLayout>("layout")) {}
+      , layout_(spec.GetArgument<TensorLayout>("layout"))
+      , flip_x_("flip_x", spec), flip_y_("flip_y", spec), flip_z_("flip_z", spec)
+      , center_x_("center_x", spec), center_y_("center_y", spec), center_z_("center_z", spec) {}
 
   ~CoordFlip() override = default;
   DISABLE_COPY_MOVE_ASSIGN(CoordFlip);
@@ -96,6 +98,8 @@ class CoordFlip : public Operator<Backend> {
 
   // Layout of the coordinates
   TensorLayout layout_;
+  ArgHandle<int> flip_x_, flip_y_, flip_z_;
+  ArgHandle<float> center_x_, center_y_, center_z_;
   // Number of dimensions
   int ndim_ = -1;
   // Indices of x, y and z dimensions
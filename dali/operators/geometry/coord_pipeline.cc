@@ -0,0 +1,86 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/geometry/coord_pipeline.h"
+
+namespace dali {
+
+DALI_SCHEMA(CoordPipeline)
+  .DocStr(R"(Applies a sequence of coordinate transformations to points or boxes in a single step.
+
+The steps are applied in the following order:
+
+ 1. the affine transform ``M * in + T`` (see the ``M``, ``T`` and ``MT`` arguments),
+ 2. the normalization - division by ``normalize``, e.g. by the size of the image,
+ 3. the flip (reflection) with respect to ``flip_center`` in the dimensions selected by ``flip``,
+ 4. the clipping to the range [``clip_lo``, ``clip_hi``].
+
+The first three steps are composed into a single affine transform per sample, so this operator
+replaces a chain of ``coord_transform``, ``coord_flip``, ``bb_flip`` and arithmetic operators
+with one pass over the data (and, on the GPU, a single kernel launch). A different order of
+the affine steps can be expressed with the ``M``, ``T`` or ``MT`` arguments, e.g. with
+the matrices produced by ``transforms`` operators.
+
+The input must be of type float and its last dimension contains the coordinates of the points
+or, if ``boxes`` is set, of the boxes, given by the start and the end (or the size) of
+the box in each dimension. Up to 3 dimensions are supported.
+)")
+  .NumInput(1)
+  .NumOutput(1)
+  .AddOptionalArg("boxes", R"(If True, the input contains boxes instead of points.
+
+A box is transformed to the smallest axis-aligned box containing it after the affine transform,
+so the matrix must be square.)", false)
+  .AddOptionalArg("ltrb", R"(If True, the boxes are given by their start and end
+coordinates (e.g. ``[left, top, right, bottom]``), otherwise by their start and size
+(e.g. ``[x, y, width, height]``).
+
+Only used when ``boxes`` is set.)", true)
+  .AddOptionalArg<vector<float>>("normalize", R"(The extent of the coordinate space, by which
+the transformed coordinates are divided.
+
+Can be a single value or one value per output dimension.)", std::vector<float>{1.0f}, true)
+  .AddOptionalArg<vector<int>>("flip", R"(Nonzero values select the dimensions in which
+the normalized coordinates are flipped.
+
+Can be a single value or one value per output dimension.)", std::vector<int>{0}, true)
+  .AddOptionalArg<vector<float>>("flip_center", R"(The center of the flip.
+
+Can be a single value or one value per output dimension.)", std::vector<float>{0.5f}, true)
+  .AddOptionalArg("clip", R"(If True, the output coordinates are clipped to
+[``clip_lo``, ``clip_hi``].)", false)
+  .AddOptionalArg("clip_lo", R"(The lower bound of the clipping range.)", 0.0f)
+  .AddOptionalArg("clip_hi", R"(The upper bound of the clipping range.)", 1.0f)
+  .AddParent("MTTransformAttr");
+
+template <>
+template <int out_dim, int in_dim, bool boxes>
+void CoordPipeline<CPUBackend>::RunTyped(HostWorkspace &ws) {
+  auto &tp = ws.GetThreadPool();
+  int in_size = boxes ? 2 * in_dim : in_dim;
+  for (int i = 0; i < static_cast<int>(sample_descs_.size()); i++) {
+    const auto &sample = sample_descs_[i];
+    if (sample.num_items == 0)
+      continue;
+    tp.AddWork([&, i](int) {
+      coord_pipeline::TransformItems<out_dim, in_dim, boxes>(
+          sample_descs_[i], 0, sample_descs_[i].num_items, 1, ltrb_, clip_);
+    }, sample.num_items * in_size);
+  }
+  tp.RunAll();
+}
+
+DALI_REGISTER_OPERATOR(CoordPipeline, CoordPipeline<CPUBackend>, CPU);
+
+}  // namespace dali
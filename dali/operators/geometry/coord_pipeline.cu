@@ -0,0 +1,61 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include "dali/core/util.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/operators/geometry/coord_pipeline.h"
+
+namespace dali {
+
+namespace {
+
+template <int out_dim, int in_dim, bool boxes>
+__global__ void CoordPipelineKernel(const coord_pipeline::SampleDesc *samples, bool ltrb,
+                                    coord_pipeline::ClipParams clip) {
+  const auto &sample = samples[blockIdx.y];
+  int64_t step = static_cast<int64_t>(gridDim.x) * blockDim.x;
+  int64_t begin = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  coord_pipeline::TransformItems<out_dim, in_dim, boxes>(
+      sample, begin, sample.num_items, step, ltrb, clip);
+}
+
+}  // namespace
+
+template <>
+template <int out_dim, int in_dim, bool boxes>
+void CoordPipeline<GPUBackend>::RunTyped(DeviceWorkspace &ws) {
+  int N = sample_descs_.size();
+  int64_t max_items = 0;
+  for (auto &sample : sample_descs_)
+    max_items = std::max(max_items, sample.num_items);
+  if (max_items == 0)
+    return;
+
+  // all the samples (and the transforms composed for them) are uploaded at once
+  auto stream = ws.stream();
+  kernels::DynamicScratchpad scratchpad({}, stream);
+  auto *samples_gpu = scratchpad.ToGPU(stream, sample_descs_);
+
+  constexpr int kBlockSize = 256;
+  int blocks_per_sample = std::min<int64_t>(div_ceil(max_items, kBlockSize), 64);
+  dim3 grid(blocks_per_sample, N);
+  CoordPipelineKernel<out_dim, in_dim, boxes>
+      <<<grid, kBlockSize, 0, stream>>>(samples_gpu, ltrb_, clip_);
+  CUDA_CALL(cudaGetLastError());
+}
+
+DALI_REGISTER_OPERATOR(CoordPipeline, CoordPipeline<GPUBackend>, GPU);
+
+}  // namespace dali
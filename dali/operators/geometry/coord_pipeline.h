@@ -0,0 +1,264 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_GEOMETRY_COORD_PIPELINE_H_
+#define DALI_OPERATORS_GEOMETRY_COORD_PIPELINE_H_
+
+#include <vector>
+#include "dali/core/format.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/math_util.h"
+#include "dali/core/static_switch.h"
+#include "dali/operators/geometry/mt_transform_attr.h"
+#include "dali/pipeline/operator/arg_helper.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+namespace coord_pipeline {
+
+constexpr int kMaxDim = 3;
+
+/**
+ * @brief The data of a sample and the affine transform composed of all the steps
+ *        except for the clipping
+ */
+struct SampleDesc {
+  float *out;
+  const float *in;
+  int64_t num_items;  // points or boxes
+  float M[kMaxDim * kMaxDim];  // out_dim x in_dim, row-major
+  float T[kMaxDim];
+};
+
+struct ClipParams {
+  bool clip;
+  float lo, hi;
+};
+
+template <int out_dim, int in_dim>
+DALI_HOST_DEV void TransformPoint(float *out, const float *in,
+                                  const SampleDesc &sample, ClipParams clip) {
+  float p[in_dim];  // NOLINT - not a variable length array
+  for (int j = 0; j < in_dim; j++)
+    p[j] = in[j];
+  for (int i = 0; i < out_dim; i++) {
+    float v = sample.T[i];
+    for (int j = 0; j < in_dim; j++)
+      v += sample.M[i * in_dim + j] * p[j];
+    out[i] = clip.clip ? clamp(v, clip.lo, clip.hi) : v;
+  }
+}
+
+/**
+ * @brief Transforms a box given by its start and end (or size) coordinates
+ *
+ * The result is the smallest axis-aligned box containing the transformed box, so the boxes
+ * are flipped, scaled and translated exactly and the rotated boxes are replaced by their
+ * bounding boxes.
+ */
+template <int ndim>
+DALI_HOST_DEV void TransformBox(float *out, const float *in, bool ltrb,
+                                const SampleDesc &sample, ClipParams clip) {
+  float lo[ndim], hi[ndim];  // NOLINT - not a variable length array
+  for (int j = 0; j < ndim; j++) {
+    lo[j] = in[j];
+    hi[j] = ltrb ? in[ndim + j] : in[j] + in[ndim + j];
+  }
+  float out_lo[ndim], out_hi[ndim];  // NOLINT - not a variable length array
+  for (int i = 0; i < ndim; i++) {
+    out_lo[i] = out_hi[i] = sample.T[i];
+    for (int j = 0; j < ndim; j++) {
+      float a = sample.M[i * ndim + j] * lo[j];
+      float b = sample.M[i * ndim + j] * hi[j];
+      out_lo[i] += a < b ? a : b;
+      out_hi[i] += a < b ? b : a;
+    }
+    if (clip.clip) {
+      out_lo[i] = clamp(out_lo[i], clip.lo, clip.hi);
+      out_hi[i] = clamp(out_hi[i], clip.lo, clip.hi);
+    }
+  }
+  for (int i = 0; i < ndim; i++) {
+    out[i] = out_lo[i];
+    out[ndim + i] = ltrb ? out_hi[i] : out_hi[i] - out_lo[i];
+  }
+}
+
+template <int out_dim, int in_dim, bool boxes>
+DALI_HOST_DEV void TransformItems(const SampleDesc &sample, int64_t begin, int64_t end,
+                                  int64_t step, bool ltrb, ClipParams clip) {
+  constexpr int in_size = boxes ? 2 * in_dim : in_dim;
+  constexpr int out_size = boxes ? 2 * out_dim : out_dim;
+  for (int64_t idx = begin; idx < end; idx += step) {
+    const float *in = sample.in + idx * in_size;
+    float *out = sample.out + idx * out_size;
+    if constexpr (boxes) {
+      static_assert(out_dim == in_dim, "The boxes can only be transformed to the same space");
+      TransformBox<in_dim>(out, in, ltrb, sample, clip);
+    } else {
+      TransformPoint<out_dim, in_dim>(out, in, sample, clip);
+    }
+  }
+}
+
+}  // namespace coord_pipeline
+
+#define COORD_PIPELINE_DIMS (1, 2, 3)
+
+template <typename Backend>
+class CoordPipeline : public Operator<Backend>, protected MTTransformAttr {
+ public:
+  explicit CoordPipeline(const OpSpec &spec)
+      : Operator<Backend>(spec), MTTransformAttr(spec)
+      , boxes_(spec.GetArgument<bool>("boxes"))
+      , ltrb_(spec.GetArgument<bool>("ltrb"))
+      , normalize_("normalize", spec)
+      , flip_("flip", spec)
+      , flip_center_("flip_center", spec) {
+    clip_.clip = spec.GetArgument<bool>("clip");
+    clip_.lo = spec.GetArgument<float>("clip_lo");
+    clip_.hi = spec.GetArgument<float>("clip_hi");
+    DALI_ENFORCE(clip_.lo <= clip_.hi, make_string("The clipping range must not be empty. Got: [",
+                 clip_.lo, ", ", clip_.hi, "]."));
+  }
+
+  bool CanInferOutputs() const override { return true; }
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_descs, const workspace_t<Backend> &ws) override {
+    const auto &input = ws.template Input<Backend>(0);
+    const auto &input_shape = input.shape();
+    DALI_ENFORCE(input.type() == DALI_FLOAT, make_string(
+        "CoordPipeline expects the coordinates to be of type float. Got: ", input.type()));
+    DALI_ENFORCE(input_shape.sample_dim() >= 2,
+        "CoordPipeline expects an input with at least 2 dimensions.");
+    int N = input_shape.num_samples();
+
+    int item_size = N > 0 ? input_shape.tensor_shape_span(0).back() : 0;
+    for (int i = 1; i < N; i++) {
+      DALI_ENFORCE(input_shape.tensor_shape_span(i).back() == item_size, make_string(
+          "The number of coordinates must be the same for all input samples. Got: ",
+          input_shape, "."));
+    }
+    if (boxes_) {
+      DALI_ENFORCE(item_size % 2 == 0, make_string("The boxes must consist of an even number "
+                   "of coordinates. Got: ", item_size, "."));
+      in_dim_ = item_size / 2;
+    } else {
+      in_dim_ = item_size;
+    }
+    DALI_ENFORCE(in_dim_ >= 1 && in_dim_ <= coord_pipeline::kMaxDim, make_string(
+        "Unsupported number of dimensions of the ", boxes_ ? "boxes" : "points", ": ", in_dim_,
+        ". Supported: 1-", coord_pipeline::kMaxDim, "."));
+
+    SetTransformDims(in_dim_);
+    ProcessTransformArgs(spec_, ws, N);
+    out_dim_ = output_pt_dim_;
+    DALI_ENFORCE(out_dim_ <= coord_pipeline::kMaxDim, make_string(
+        "Unsupported number of dimensions of the output: ", out_dim_,
+        ". Supported: 1-", coord_pipeline::kMaxDim, "."));
+    DALI_ENFORCE(!boxes_ || out_dim_ == in_dim_, make_string("The transformation of boxes "
+                 "must keep the number of dimensions. Got a ", out_dim_, "x", in_dim_,
+                 " matrix."));
+
+    ComposeTransforms(ws, N);
+
+    output_descs.resize(1);
+    output_descs[0].type = DALI_FLOAT;
+    output_descs[0].shape = input_shape;
+    for (int i = 0; i < N; i++)
+      output_descs[0].shape.tensor_shape_span(i).back() = boxes_ ? 2 * out_dim_ : out_dim_;
+    return true;
+  }
+
+  void RunImpl(workspace_t<Backend> &ws) override {
+    const auto &in = ws.template Input<Backend>(0);
+    auto &out = ws.template Output<Backend>(0);
+    out.SetLayout(in.GetLayout());
+
+    int N = in.num_samples();
+    int in_size = boxes_ ? 2 * in_dim_ : in_dim_;
+    for (int i = 0; i < N; i++) {
+      auto &desc = sample_descs_[i];
+      desc.in = in.template tensor<float>(i);
+      desc.out = out.template mutable_tensor<float>(i);
+      desc.num_items = volume(in.tensor_shape(i)) / in_size;
+    }
+
+    if (boxes_) {
+      VALUE_SWITCH(in_dim_, ndim, COORD_PIPELINE_DIMS, (
+        RunTyped<ndim, ndim, true>(ws);
+      ), (DALI_FAIL(make_string("Unsupported number of dimensions: ", in_dim_))));  // NOLINT
+    } else {
+      VALUE_SWITCH(out_dim_, out_dim, COORD_PIPELINE_DIMS, (
+        VALUE_SWITCH(in_dim_, in_dim, COORD_PIPELINE_DIMS, (
+          RunTyped<out_dim, in_dim, false>(ws);
+        ), (DALI_FAIL(make_string("Unsupported number of dimensions: ", in_dim_))));  // NOLINT
+      ), (DALI_FAIL(make_string("Unsupported number of dimensions: ", out_dim_))));  // NOLINT
+    }
+  }
+
+  /**
+   * @brief Composes the affine transform, the normalization and the flip of each sample
+   *        into a single matrix and translation
+   */
+  void ComposeTransforms(const workspace_t<Backend> &ws, int N) {
+    TensorShape<1> arg_shape{out_dim_};
+    normalize_.Acquire(spec_, ws, N, arg_shape);
+    flip_.Acquire(spec_, ws, N, arg_shape);
+    flip_center_.Acquire(spec_, ws, N, arg_shape);
+
+    sample_descs_.resize(N);
+    int mat_size = out_dim_ * in_dim_;
+    for (int s = 0; s < N; s++) {
+      auto &desc = sample_descs_[s];
+      const float *M = &per_sample_mtx_[s * mat_size];
+      const float *T = &per_sample_translation_[s * out_dim_];
+      for (int i = 0; i < out_dim_; i++) {
+        float extent = normalize_[s].data[i];
+        DALI_ENFORCE(extent != 0, make_string("The normalization extent must not be 0. Got: ",
+                     normalize_[s].data[i], " for sample ", s, ", dimension ", i, "."));
+        float scale = 1.0f / extent;
+        float offset = 0.0f;
+        if (flip_[s].data[i]) {
+          // 2 * center - x
+          scale = -scale;
+          offset = 2.0f * flip_center_[s].data[i];
+        }
+        for (int j = 0; j < in_dim_; j++)
+          desc.M[i * in_dim_ + j] = scale * M[i * in_dim_ + j];
+        desc.T[i] = scale * T[i] + offset;
+      }
+    }
+  }
+
+  template <int out_dim, int in_dim, bool boxes>
+  void RunTyped(workspace_t<Backend> &ws);
+
+  using Operator<Backend>::spec_;
+
+  bool boxes_, ltrb_;
+  coord_pipeline::ClipParams clip_;
+  ArgValue<float, 1> normalize_;
+  ArgValue<int, 1> flip_;
+  ArgValue<float, 1> flip_center_;
+
+  int in_dim_ = 0, out_dim_ = 0;
+  std::vector<coord_pipeline::SampleDesc> sample_descs_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_GEOMETRY_COORD_PIPELINE_H_
@@ -63,6 +63,10 @@ class BrightnessContrastOp : public SequenceOperator<Backend> {
  protected:
   explicit BrightnessContrastOp(const OpSpec &spec)
       : SequenceOperator<Backend>(spec),
+        brightness_arg_("brightness", spec),
+        brightness_shift_arg_("brightness_shift", spec),
+        contrast_arg_("contrast", spec),
+        contrast_center_arg_("contrast_center", spec),
         output_type_(DALI_NO_TYPE),
         input_type_(DALI_NO_TYPE) {
     spec.TryGetArgument(output_type_arg_, "dtype");
@@ -99,20 +103,20 @@ class BrightnessContrastOp : public SequenceOperator<Backend> {
 
   void AcquireArguments(const workspace_t<Backend> &ws) {
     auto curr_batch_size = ws.GetInputBatchSize(0);
-    if (this->spec_.ArgumentDefined("brightness")) {
-      this->GetPerSampleArgument(brightness_, "brightness", ws, curr_batch_size);
+    if (brightness_arg_.IsDefined()) {
+      this->GetPerSampleArgument(brightness_, brightness_arg_, ws, curr_batch_size);
     } else {
       brightness_ = std::vector<float>(curr_batch_size, kDefaultBrightness);
     }
 
-    if (this->spec_.ArgumentDefined("brightness_shift")) {
-      this->GetPerSampleArgument(brightness_shift_, "brightness_shift", ws, curr_batch_size);
+    if (brightness_shift_arg_.IsDefined()) {
+      this->GetPerSampleArgument(brightness_shift_, brightness_shift_arg_, ws, curr_batch_size);
     } else {
       brightness_shift_ = std::vector<float>(curr_batch_size, kDefaultBrightnessShift);
     }
 
-    if (this->spec_.ArgumentDefined("contrast")) {
-      this->GetPerSampleArgument(contrast_, "contrast", ws, curr_batch_size);
+    if (contrast_arg_.IsDefined()) {
+      this->GetPerSampleArgument(contrast_, contrast_arg_, ws, curr_batch_size);
     } else {
       contrast_ = std::vector<float>(curr_batch_size, kDefaultContrast);
     }
@@ -123,8 +127,8 @@ class BrightnessContrastOp : public SequenceOperator<Backend> {
 
   template <typename InputType>
   const vector<float> &GetContrastCenter(const workspace_t<Backend> &ws, int num_samples) {
-    if (this->spec_.ArgumentDefined("contrast_center")) {
-      this->GetPerSampleArgument(contrast_center_, "contrast_center", ws, num_samples);
+    if (contrast_center_arg_.IsDefined()) {
+      this->GetPerSampleArgument(contrast_center_, contrast_center_arg_, ws, num_samples);
     } else {
       // argument cannot stop being defined in a built pipeline,
       // so just fill in missing samples if needed
@@ -146,6 +150,7 @@ class BrightnessContrastOp : public SequenceOperator<Backend> {
   }
 
   USE_OPERATOR_MEMBERS();
+  ArgHandle<float> brightness_arg_, brightness_shift_arg_, contrast_arg_, contrast_center_arg_;
   std::vector<float> brightness_, brightness_shift_, contrast_, contrast_center_;
   DALIDataType output_type_arg_ = DALI_NO_TYPE;
   DALIDataType output_type_ = DALI_NO_TYPE;
@@ -0,0 +1,111 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/image/color/color_adjust.h"
+#include <algorithm>
+
+namespace dali {
+
+DALI_SCHEMA(experimental__ColorAdjust)
+    .DocStr(R"code(Applies a chain of color adjustments to the images in a single pass.
+
+The operator combines the adjustments of :meth:`nvidia.dali.fn.hsv`,
+:meth:`nvidia.dali.fn.brightness_contrast`, a gamma correction and a color space conversion.
+They are applied in the following order:
+
+1. the conversion of the input to RGB (see ``image_type``),
+2. the hue, saturation and value adjustment, approximated with a linear transform in the RGB
+   space, as in :meth:`nvidia.dali.fn.hsv`,
+3. the contrast, brightness and brightness shift adjustment::
+
+       out = brightness_shift * output_range +
+             brightness * (contrast_center + contrast * (in - contrast_center))
+
+   where output_range is 1 for float outputs or the maximum positive value for integral types,
+4. the gamma correction::
+
+       out = output_range * (clamp(in / output_range, 0, 1) ^ gamma)
+
+5. the conversion to ``output_image_type``.
+
+The linear steps are composed into a single 3x4 transform per sample, so chaining the
+adjustments costs no more than applying one of them. The gamma correction, when used, is
+applied in the same pass. The intermediate results are neither rounded nor clamped,
+except for the clamping done by the gamma correction, so the result can differ slightly from
+running the equivalent operators one after another with an integer type.)code")
+    .NumInput(1)
+    .NumOutput(1)
+    .AddOptionalArg("hue", R"code(Hue delta, in degrees.)code", 0.0f, true, true)
+    .AddOptionalArg("saturation", R"code(The saturation multiplier.)code", 1.0f, true, true)
+    .AddOptionalArg("value", R"code(The value multiplier.)code", 1.0f, true, true)
+    .AddOptionalArg("contrast", R"code(The contrast multiplier, where 0.0 produces
+the uniform grey.)code", kDefaultContrast, true, true)
+    .AddOptionalArg("contrast_center", R"code(The intensity level that is unaffected by contrast.
+
+When not set, the half of the input type's positive range (or 0.5 for ``float``) is used.)code",
+                    brightness_contrast::HalfRange<float>(), true, true)
+    .AddOptionalArg("brightness", R"code(The brightness multiplier.)code",
+                    kDefaultBrightness, true, true)
+    .AddOptionalArg("brightness_shift", R"code(The brightness shift.
+
+For signed types, 1.0 represents the maximum positive value that can be represented by
+the type.)code", kDefaultBrightnessShift, true, true)
+    .AddOptionalArg("gamma", R"code(The exponent of the gamma correction.
+
+Must be positive. The value 1.0 disables the gamma correction.)code", 1.0f, true, true)
+    .AddOptionalArg("image_type", R"code(The color space of the input image - RGB or BGR.)code",
+                    DALI_RGB)
+    .AddOptionalArg<DALIImageType>("output_image_type",
+                    R"code(The color space of the output image - RGB, BGR or YCbCr.
+
+The YCbCr conversion follows the JPEG definition, using the whole range of the type.
+If not set, the color space of the input is used.)code", nullptr)
+    .AddOptionalTypeArg("dtype", R"code(The output data type.
+
+If not set, the input type is used.)code")
+    .InputLayout(0, {"HWC", "FHWC", "DHWC"})
+    .AllowSequences()
+    .SupportVolumetric();
+
+template <>
+void ColorAdjust<CPUBackend>::RunImpl(workspace_t<CPUBackend> &ws) {
+  const auto &input = ws.Input<CPUBackend>(0);
+  auto &output = ws.Output<CPUBackend>(0);
+  output.SetLayout(input.GetLayout());
+  auto &tp = ws.GetThreadPool();
+  // the number of the pixels processed by a single task
+  constexpr int64_t kChunk = 1 << 16;
+  TYPE_SWITCH(input.type(), type2id, In, COLOR_ADJUST_SUPPORTED_TYPES, (
+    TYPE_SWITCH(output_type_, type2id, Out, COLOR_ADJUST_SUPPORTED_TYPES, (
+      for (int i = 0; i < input.num_samples(); i++) {
+        const In *in = input.tensor<In>(i);
+        Out *out = output.mutable_tensor<Out>(i);
+        int64_t num_pixels = volume(input.tensor_shape_span(i)) / 3;
+        for (int64_t start = 0; start < num_pixels; start += kChunk) {
+          int64_t end = std::min(start + kChunk, num_pixels);
+          tp.AddWork([&, i, in, out, start, end](int) {
+            const auto &params = params_[i];
+            for (int64_t p = start; p < end; p++)
+              kernels::color::ColorAdjustPixel(params, out + p * 3, in + p * 3);
+          }, (end - start) * 3);
+        }
+      }
+    ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)))  // NOLINT
+  ), DALI_FAIL(make_string("Unsupported input type: ", input.type())))  // NOLINT
+  tp.RunAll();
+}
+
+DALI_REGISTER_OPERATOR(experimental__ColorAdjust, ColorAdjust<CPUBackend>, CPU);
+
+}  // namespace dali
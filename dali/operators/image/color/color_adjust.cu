@@ -0,0 +1,53 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/imgproc/color_manipulation/color_adjust_gpu.cuh"
+#include "dali/operators/image/color/color_adjust.h"
+
+namespace dali {
+
+template <>
+void ColorAdjust<GPUBackend>::RunImpl(workspace_t<GPUBackend> &ws) {
+  const auto &input = ws.Input<GPUBackend>(0);
+  auto &output = ws.Output<GPUBackend>(0);
+  output.SetLayout(input.GetLayout());
+  int nsamples = input.num_samples();
+  kernels::DynamicScratchpad scratchpad({}, ws.stream());
+  TYPE_SWITCH(input.type(), type2id, In, COLOR_ADJUST_SUPPORTED_TYPES, (
+    TYPE_SWITCH(output_type_, type2id, Out, COLOR_ADJUST_SUPPORTED_TYPES, (
+      std::vector<kernels::color::ColorAdjustSampleDesc<Out, In>> samples;
+      samples.reserve(nsamples);
+      int64_t total_pixels = 0;
+      for (int i = 0; i < nsamples; i++) {
+        int64_t num_pixels = volume(input.tensor_shape_span(i)) / 3;
+        if (num_pixels == 0)
+          continue;
+        samples.push_back({output.mutable_tensor<Out>(i), input.tensor<In>(i), total_pixels,
+                           params_[i]});
+        total_pixels += num_pixels;
+      }
+      if (!samples.empty()) {
+        auto *samples_dev = scratchpad.ToGPU(ws.stream(), samples);
+        kernels::color::LaunchColorAdjust(samples_dev, samples.size(), total_pixels,
+                                          ws.stream());
+      }
+    ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)))  // NOLINT
+  ), DALI_FAIL(make_string("Unsupported input type: ", input.type())))  // NOLINT
+}
+
+DALI_REGISTER_OPERATOR(experimental__ColorAdjust, ColorAdjust<GPUBackend>, GPU);
+
+}  // namespace dali
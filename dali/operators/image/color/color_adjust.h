@@ -0,0 +1,193 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_IMAGE_COLOR_COLOR_ADJUST_H_
+#define DALI_OPERATORS_IMAGE_COLOR_COLOR_ADJUST_H_
+
+#include <vector>
+#include "dali/core/format.h"
+#include "dali/core/static_switch.h"
+#include "dali/kernels/imgproc/color_manipulation/color_adjust.h"
+#include "dali/operators/image/color/brightness_contrast.h"
+#include "dali/operators/image/color/color_twist.h"
+#include "dali/pipeline/data/views.h"
+#include "dali/pipeline/operator/common.h"
+#include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/operator/sequence_operator.h"
+
+#define COLOR_ADJUST_SUPPORTED_TYPES (uint8_t, int16_t, int32_t, float, float16)
+
+namespace dali {
+
+namespace color {
+
+/**
+ * @brief Returns the matrix and the offset converting RGB to the given color space.
+ *
+ * Only the color spaces which are an affine transform of RGB are supported.
+ *
+ * @param half_range the middle of the range of the values, used as the offset of the chroma
+ */
+inline void RgbTo(DALIImageType type, float half_range, mat3 &A, vec3 &B) {
+  B = vec3(0);
+  switch (type) {
+    case DALI_RGB:
+      A = mat3::eye();
+      break;
+    case DALI_BGR:
+      A = {{{0.f, 0.f, 1.f}, {0.f, 1.f, 0.f}, {1.f, 0.f, 0.f}}};
+      break;
+    case DALI_YCbCr:
+      // The JPEG definition, using the whole range of the type
+      A = {{{0.299f, 0.587f, 0.114f},
+            {-0.16873589f, -0.33126411f, 0.5f},
+            {0.5f, -0.41868759f, -0.08131241f}}};
+      B = vec3(0, half_range, half_range);
+      break;
+    default:
+      DALI_FAIL(make_string("Unsupported color space: ", to_string(type),
+                            ". Supported color spaces are RGB, BGR and YCbCr."));
+  }
+}
+
+}  // namespace color
+
+/**
+ * @brief Applies the adjustments of Hsv, ColorTwist and BrightnessContrast, a gamma correction
+ *        and a color space conversion in a single pass.
+ *
+ * The linear parts are composed on the host into one 3x4 transform per sample; the gamma
+ * correction, if used, is applied in the same pass, before the transform to the output color
+ * space.
+ */
+template <typename Backend>
+class ColorAdjust : public SequenceOperator<Backend> {
+ public:
+  explicit ColorAdjust(const OpSpec &spec)
+      : SequenceOperator<Backend>(spec),
+        hue_arg_("hue", spec),
+        saturation_arg_("saturation", spec),
+        value_arg_("value", spec),
+        contrast_arg_("contrast", spec),
+        contrast_center_arg_("contrast_center", spec),
+        brightness_arg_("brightness", spec),
+        brightness_shift_arg_("brightness_shift", spec),
+        gamma_arg_("gamma", spec),
+        image_type_(spec.GetArgument<DALIImageType>("image_type")),
+        output_image_type_(image_type_) {
+    spec.TryGetArgument(output_image_type_, "output_image_type");
+    spec.TryGetArgument(output_type_arg_, "dtype");
+    DALI_ENFORCE(image_type_ == DALI_RGB || image_type_ == DALI_BGR,
+                 make_string("The input must be an RGB or BGR image. Got: ",
+                             to_string(image_type_)));
+  }
+
+  DISABLE_COPY_MOVE_ASSIGN(ColorAdjust);
+
+ protected:
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  // As in ColorTwist, use the 4 dim path for the sequences with no per-frame parameters
+  bool ShouldExpand(const workspace_t<Backend> &ws) override {
+    return SequenceOperator<Backend>::ShouldExpand(ws) && this->HasPerFrameArgInputs(ws);
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override {
+    const auto &input = ws.template Input<Backend>(0);
+    auto sh = input.shape();
+    int nsamples = sh.num_samples();
+    int ndim = sh.sample_dim();
+    for (int i = 0; i < nsamples; i++) {
+      int channels = sh.tensor_shape_span(i)[ndim - 1];
+      DALI_ENFORCE(channels == 3, make_string("Expected 3-channel images. Got ", channels,
+                                              " channels in the sample ", i, "."));
+    }
+    output_type_ = output_type_arg_ != DALI_NO_TYPE ? output_type_arg_ : input.type();
+    TYPE_SWITCH(input.type(), type2id, In, COLOR_ADJUST_SUPPORTED_TYPES, (
+      TYPE_SWITCH(output_type_, type2id, Out, COLOR_ADJUST_SUPPORTED_TYPES, (
+        ComputeParams<Out, In>(ws, nsamples);
+      ), DALI_FAIL(make_string("Unsupported output type: ", output_type_)))  // NOLINT
+    ), DALI_FAIL(make_string("Unsupported input type: ", input.type())))  // NOLINT
+    output_desc.resize(1);
+    output_desc[0] = {sh, output_type_};
+    return true;
+  }
+
+  /**
+   * @brief Composes the per-sample transforms.
+   *
+   * The order of the operations is: the conversion to RGB, the HSV adjustment (as in Hsv),
+   * the contrast, the brightness and the brightness shift (as in BrightnessContrast),
+   * the gamma correction and the conversion to the output color space.
+   */
+  template <typename Out, typename In>
+  void ComputeParams(const workspace_t<Backend> &ws, int nsamples) {
+    this->GetPerSampleArgument(hue_, hue_arg_, ws, nsamples);
+    this->GetPerSampleArgument(saturation_, saturation_arg_, ws, nsamples);
+    this->GetPerSampleArgument(value_, value_arg_, ws, nsamples);
+    this->GetPerSampleArgument(contrast_, contrast_arg_, ws, nsamples);
+    this->GetPerSampleArgument(brightness_, brightness_arg_, ws, nsamples);
+    this->GetPerSampleArgument(brightness_shift_, brightness_shift_arg_, ws, nsamples);
+    this->GetPerSampleArgument(gamma_, gamma_arg_, ws, nsamples);
+    if (contrast_center_arg_.IsDefined())
+      this->GetPerSampleArgument(contrast_center_, contrast_center_arg_, ws, nsamples);
+    else
+      contrast_center_.assign(nsamples, brightness_contrast::HalfRange<In>());
+
+    float out_range = brightness_contrast::FullRange<Out>();
+    mat3 to_rgb, from_rgb;
+    vec3 to_rgb_offset, from_rgb_offset;
+    // BGR <-> RGB conversion is its own inverse
+    color::RgbTo(image_type_, 0, to_rgb, to_rgb_offset);
+    color::RgbTo(output_image_type_, brightness_contrast::HalfRange<Out>(), from_rgb,
+                 from_rgb_offset);
+
+    params_.resize(nsamples);
+    for (int i = 0; i < nsamples; i++) {
+      DALI_ENFORCE(gamma_[i] > 0, make_string("`gamma` must be positive. Got ", gamma_[i],
+                                              " for the sample ", i, "."));
+      mat3 hsv = color::Yiq2Rgb * color::hue_mat(hue_[i]) * color::sat_mat(saturation_[i]) *
+                 mat3(value_[i]) * color::Rgb2Yiq;
+      float multiplier = brightness_[i] * contrast_[i];
+      float addend = brightness_shift_[i] * out_range +
+                     brightness_[i] * (contrast_center_[i] - contrast_[i] * contrast_center_[i]);
+      auto &p = params_[i];
+      p.A = mat3(multiplier) * hsv * to_rgb;
+      p.B = vec3(addend);
+      p.gamma = gamma_[i];
+      p.range = out_range;
+      p.out_A = from_rgb;
+      p.out_B = from_rgb_offset;
+      p.Finalize();
+    }
+  }
+
+  void RunImpl(workspace_t<Backend> &ws) override;
+  using Operator<Backend>::RunImpl;
+
+  USE_OPERATOR_MEMBERS();
+  ArgHandle<float> hue_arg_, saturation_arg_, value_arg_, contrast_arg_, contrast_center_arg_,
+                   brightness_arg_, brightness_shift_arg_, gamma_arg_;
+  std::vector<float> hue_, saturation_, value_, contrast_, contrast_center_, brightness_,
+                     brightness_shift_, gamma_;
+  DALIImageType image_type_, output_image_type_;
+  DALIDataType output_type_arg_ = DALI_NO_TYPE, output_type_ = DALI_NO_TYPE;
+  std::vector<kernels::color::ColorAdjustParams> params_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_IMAGE_COLOR_COLOR_ADJUST_H_
@@ -13,11 +13,20 @@
 // limitations under the License.
 
 #include "dali/operators/image/color/color_twist.h"
+#include <vector>
 #include "dali/kernels/imgproc/pointwise/linear_transformation_cpu.h"
 #include "dali/pipeline/data/sequence_utils.h"
 
 namespace dali {
 
+namespace {
+
+// The output types supported by the kernels
+const std::vector<DALIDataType> kColorTwistFusableTypes = {
+    DALI_UINT8, DALI_INT16, DALI_INT32, DALI_FLOAT, DALI_FLOAT16};
+
+}  // namespace
+
 DALI_SCHEMA(Hsv)
     .DocStr(R"code(Adjusts hue, saturation and value (brightness) of the images.
 
@@ -50,7 +59,8 @@ they would in case of rotation.)code",
 If a value is not set, the input type is used.)code",
                     DALI_UINT8)
     .InputLayout(0, {"HWC", "FHWC", "DHWC"})
-    .AllowSequences();
+    .AllowSequences()
+    .PointwiseFusable(kColorTwistFusableTypes);
 
 DALI_SCHEMA(ColorTransformBase)
     .DocStr(R"code(Base Schema for color transformations operators.)code")
@@ -70,7 +80,8 @@ DALI_SCHEMA(Hue)
     .AddParent("ColorTransformBase")
     .InputLayout(0, {"HWC", "FHWC", "DHWC"})
     .AllowSequences()
-    .SupportVolumetric();
+    .SupportVolumetric()
+    .PointwiseFusable(kColorTwistFusableTypes);
 
 DALI_SCHEMA(Saturation)
     .DocStr(R"code(Changes the saturation level of the image.)code")
@@ -89,7 +100,8 @@ Example values:
     .AddParent("ColorTransformBase")
     .InputLayout(0, {"HWC", "FHWC", "DHWC"})
     .AllowSequences()
-    .SupportVolumetric();
+    .SupportVolumetric()
+    .PointwiseFusable(kColorTwistFusableTypes);
 
 DALI_SCHEMA(ColorTwist)
     .DocStr(R"code(Adjusts hue, saturation, brightness and contrast of the image.)code")
@@ -131,7 +143,8 @@ Example values:
     .AddParent("ColorTransformBase")
     .InputLayout(0, {"HWC", "FHWC", "DHWC"})
     .AllowSequences()
-    .SupportVolumetric();
+    .SupportVolumetric()
+    .PointwiseFusable(kColorTwistFusableTypes);
 
 
 DALI_REGISTER_OPERATOR(Hsv, ColorTwistCpu, CPU)
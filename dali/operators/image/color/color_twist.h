@@ -95,6 +95,11 @@ class ColorTwistBase : public SequenceOperator<Backend> {
  protected:
   explicit ColorTwistBase(const OpSpec &spec)
       : SequenceOperator<Backend>(spec),
+        hue_arg_(color::kHue, spec),
+        saturation_arg_(color::kSaturation, spec),
+        value_arg_(color::kValue, spec),
+        brightness_arg_(color::kBrightness, spec),
+        contrast_arg_(color::kContrast, spec),
         output_type_(DALI_NO_TYPE) {
     spec.TryGetArgument(output_type_arg_, color::kOutputType);
   }
@@ -112,32 +117,32 @@ class ColorTwistBase : public SequenceOperator<Backend> {
 
   void AcquireArguments(const workspace_t<Backend> &ws) {
     auto curr_batch_size = ws.GetInputBatchSize(0);
-    if (this->spec_.ArgumentDefined(color::kHue)) {
-      this->GetPerSampleArgument(hue_, color::kHue, ws, curr_batch_size);
+    if (hue_arg_.IsDefined()) {
+      this->GetPerSampleArgument(hue_, hue_arg_, ws, curr_batch_size);
     } else {
       hue_ = std::vector<float>(curr_batch_size, 0);
     }
 
-    if (this->spec_.ArgumentDefined(color::kSaturation)) {
-      this->GetPerSampleArgument(saturation_, color::kSaturation, ws, curr_batch_size);
+    if (saturation_arg_.IsDefined()) {
+      this->GetPerSampleArgument(saturation_, saturation_arg_, ws, curr_batch_size);
     } else {
       saturation_ = std::vector<float>(curr_batch_size, 1);
     }
 
-    if (this->spec_.ArgumentDefined(color::kValue)) {
-      this->GetPerSampleArgument(value_, color::kValue, ws, curr_batch_size);
+    if (value_arg_.IsDefined()) {
+      this->GetPerSampleArgument(value_, value_arg_, ws, curr_batch_size);
     } else {
       value_ = std::vector<float>(curr_batch_size, 1);
     }
 
-    if (this->spec_.ArgumentDefined(color::kBrightness)) {
-      this->GetPerSampleArgument(brightness_, color::kBrightness, ws, curr_batch_size);
+    if (brightness_arg_.IsDefined()) {
+      this->GetPerSampleArgument(brightness_, brightness_arg_, ws, curr_batch_size);
     } else {
       brightness_ = std::vector<float>(curr_batch_size, 1);
     }
 
-    if (this->spec_.ArgumentDefined(color::kContrast)) {
-      this->GetPerSampleArgument(contrast_, color::kContrast, ws, curr_batch_size);
+    if (contrast_arg_.IsDefined()) {
+      this->GetPerSampleArgument(contrast_, contrast_arg_, ws, curr_batch_size);
     } else {
       contrast_ = std::vector<float>(curr_batch_size, 1);
     }
@@ -186,6 +191,7 @@ class ColorTwistBase : public SequenceOperator<Backend> {
 
   USE_OPERATOR_MEMBERS();
   float half_range_ = 0.0f;
+  ArgHandle<float> hue_arg_, saturation_arg_, value_arg_, brightness_arg_, contrast_arg_;
   std::vector<float> hue_, saturation_, value_, brightness_, contrast_;
   std::vector<mat3> tmatrices_;
   std::vector<vec3> toffsets_;
@@ -57,6 +57,10 @@ For example, with ``HWC`` input, you can provide ``sigma=1.0`` or ``sigma=(1.0,
 there are two data axes, H and W.
 
 The same input can be provided as per-sample tensors.
+
+On the GPU, the axes with large windows (101 or more elements) are convolved in the frequency
+domain, which makes the cost of the operation almost independent of the window size. The results of
+both methods differ only by rounding errors.
 )code")
     .NumInput(1)
     .NumOutput(1)
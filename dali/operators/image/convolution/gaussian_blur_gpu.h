@@ -44,7 +44,7 @@ class GaussianBlurOpGpu : public OpImplBase<GPUBackend> {
  public:
   using WindowType = float;
   using Kernel =
-      kernels::SeparableConvolutionGpu<Out, In, WindowType, axes, has_channels, is_sequence>;
+      kernels::SeparableConvolutionGpu<Out, In, WindowType, axes, has_channels, is_sequence, true>;
   static constexpr int ndim = Kernel::ndim;
 
   /**
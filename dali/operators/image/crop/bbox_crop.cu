@@ -0,0 +1,598 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/geom/box.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/reduce/reduce_common.cuh"
+#include "dali/operators/image/crop/bbox_crop.h"
+#include "dali/operators/image/crop/bbox_crop_search.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+namespace bbox_crop {
+
+/**
+ * @brief The order of the coordinates in the input and output boxes
+ */
+template <int ndim>
+struct BoxLayoutDesc {
+  static constexpr int kBoxSize = 2 * ndim;
+  /// The position of each of the internal (lo..., hi...) coordinates in the layout
+  int read_perm[kBoxSize];
+  /// The position of each of the layout's coordinates in the internal order
+  int write_perm[kBoxSize];
+  /// The layout stores the extent of the box instead of its end
+  bool start_shape;
+};
+
+template <int ndim>
+struct ReadBoxesDesc {
+  const float *in;
+  Box<ndim, float> *out;
+  int nboxes;
+};
+
+template <int ndim>
+struct CandidateDesc {
+  Box<ndim, float> crop;
+  const Box<ndim, float> *boxes;
+  int nboxes;
+};
+
+struct CandidateResult {
+  float min_metric, max_metric;
+  /// The number of boxes with the centroid within the candidate window
+  int nboxes_in;
+};
+
+template <int ndim>
+struct WriteOutputsDesc {
+  Box<ndim, float> crop;
+  /// No crop was done - all the boxes are kept as they are
+  bool keep_all;
+  const Box<ndim, float> *in;
+  int nboxes;
+  float *anchor, *shape;
+  float anchor_value[ndim], shape_value[ndim];
+  float *out_boxes;
+  const int *in_labels;
+  int *out_labels;
+  int64_t label_stride;
+  int *out_indices;
+};
+
+// The metrics are calculated with explicitly rounded operations, so that the results match
+// the ones calculated on the host and the same windows are selected.
+
+template <int ndim>
+__device__ float BoxVolume(const Box<ndim, float> &box) {
+  float v = __fsub_rn(box.hi[0], box.lo[0]);
+  for (int d = 1; d < ndim; d++)
+    v = __fmul_rn(v, __fsub_rn(box.hi[d], box.lo[d]));
+  return v;
+}
+
+template <int ndim>
+__device__ float IntersectionVolume(const Box<ndim, float> &a, const Box<ndim, float> &b) {
+  Box<ndim, float> tmp;
+  for (int d = 0; d < ndim; d++) {
+    tmp.lo[d] = fmaxf(a.lo[d], b.lo[d]);
+    tmp.hi[d] = fminf(a.hi[d], b.hi[d]);
+    if (!(tmp.hi[d] > tmp.lo[d]))
+      return 0.0f;
+  }
+  return BoxVolume(tmp);
+}
+
+template <int ndim>
+__device__ float IoU(const Box<ndim, float> &crop, const Box<ndim, float> &box) {
+  float intersection_vol = IntersectionVolume(crop, box);
+  if (intersection_vol == 0)
+    return 0.0f;
+  float union_vol = __fsub_rn(__fadd_rn(BoxVolume(crop), BoxVolume(box)), intersection_vol);
+  return __fdiv_rn(intersection_vol, union_vol);
+}
+
+template <int ndim>
+__device__ float Overlap(const Box<ndim, float> &crop, const Box<ndim, float> &box) {
+  return __fdiv_rn(IntersectionVolume(crop, box), BoxVolume(box));
+}
+
+template <int ndim>
+__device__ bool CentroidWithin(const Box<ndim, float> &crop, const Box<ndim, float> &box) {
+  for (int d = 0; d < ndim; d++) {
+    float c = __fmul_rn(0.5f, __fadd_rn(box.hi[d], box.lo[d]));
+    if (!(c >= crop.lo[d] && c < crop.hi[d]))
+      return false;
+  }
+  return true;
+}
+
+template <int ndim>
+__global__ void ReadBoxesKernel(const ReadBoxesDesc<ndim> *descs, BoxLayoutDesc<ndim> layout,
+                                unsigned *first_out_of_bounds) {
+  auto desc = descs[blockIdx.y];
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < desc.nboxes;
+       i += blockDim.x * gridDim.x) {
+    const float *in = desc.in + i * 2 * ndim;
+    Box<ndim, float> box;
+    for (int d = 0; d < ndim; d++) {
+      box.lo[d] = in[layout.read_perm[d]];
+      box.hi[d] = in[layout.read_perm[ndim + d]];
+      if (layout.start_shape)
+        box.hi[d] = __fadd_rn(box.hi[d], box.lo[d]);
+    }
+    desc.out[i] = box;
+    bool in_bounds = true;
+    for (int d = 0; d < ndim; d++)
+      in_bounds = in_bounds && box.lo[d] >= 0.0f && box.hi[d] <= 1.0f;
+    if (!in_bounds)
+      atomicMin(&first_out_of_bounds[blockIdx.y], static_cast<unsigned>(i));
+  }
+}
+
+/**
+ * @brief Calculates the overlap metric range of a candidate window and checks if it contains
+ *        any of the boxes' centroids
+ *
+ * One block processes one candidate. The block must be (32, pow2).
+ */
+template <bool iou, int ndim>
+__global__ void EvaluateCandidatesKernel(const CandidateDesc<ndim> *candidates,
+                                         CandidateResult *results) {
+  auto candidate = candidates[blockIdx.x];
+  int tid = threadIdx.x + threadIdx.y * blockDim.x;
+  int nthreads = blockDim.x * blockDim.y;
+  float min_metric = kernels::reductions::min::neutral<float>();
+  float max_metric = kernels::reductions::max::neutral<float>();
+  int nboxes_in = 0;
+  for (int i = tid; i < candidate.nboxes; i += nthreads) {
+    const auto &box = candidate.boxes[i];
+    float metric = iou ? IoU(candidate.crop, box) : Overlap(candidate.crop, box);
+    min_metric = fminf(min_metric, metric);
+    max_metric = fmaxf(max_metric, metric);
+    nboxes_in += CentroidWithin(candidate.crop, box);
+  }
+  kernels::BlockReduce(min_metric, kernels::reductions::min());
+  kernels::BlockReduce(max_metric, kernels::reductions::max());
+  if (kernels::BlockReduce(nboxes_in, kernels::reductions::sum())) {
+    if (candidate.nboxes == 0)
+      min_metric = max_metric = 0.0f;
+    results[blockIdx.x] = { min_metric, max_metric, nboxes_in };
+  }
+}
+
+/**
+ * @brief Writes the crop window and the boxes (and their labels) that are within the window
+ *
+ * One block processes one sample. The order of the boxes is preserved.
+ */
+template <int ndim>
+__global__ void WriteOutputsKernel(const WriteOutputsDesc<ndim> *descs,
+                                   BoxLayoutDesc<ndim> layout) {
+  auto &desc = descs[blockIdx.x];
+  if (threadIdx.x < ndim) {
+    desc.anchor[threadIdx.x] = desc.anchor_value[threadIdx.x];
+    desc.shape[threadIdx.x] = desc.shape_value[threadIdx.x];
+  }
+
+  __shared__ int warp_counts[32];
+  __shared__ int base;
+  if (threadIdx.x == 0)
+    base = 0;
+  __syncthreads();
+
+  int lane = threadIdx.x & 31, warp = threadIdx.x >> 5;
+  int nwarps = blockDim.x >> 5;
+  for (int start = 0; start < desc.nboxes; start += blockDim.x) {
+    int i = start + threadIdx.x;
+    bool keep = i < desc.nboxes && (desc.keep_all || CentroidWithin(desc.crop, desc.in[i]));
+    unsigned mask = __ballot_sync(0xffffffffu, keep);
+    if (lane == 0)
+      warp_counts[warp] = __popc(mask);
+    __syncthreads();
+
+    if (keep) {
+      int out_idx = base + __popc(mask & ((1u << lane) - 1));
+      for (int w = 0; w < warp; w++)
+        out_idx += warp_counts[w];
+
+      Box<ndim, float> box = desc.in[i];
+      if (!desc.keep_all) {
+        for (int d = 0; d < ndim; d++) {
+          float extent = __fsub_rn(desc.crop.hi[d], desc.crop.lo[d]);
+          float lo = __fdiv_rn(__fsub_rn(fmaxf(desc.crop.lo[d], box.lo[d]), desc.crop.lo[d]),
+                               extent);
+          float hi = __fdiv_rn(__fsub_rn(fminf(desc.crop.hi[d], box.hi[d]), desc.crop.lo[d]),
+                               extent);
+          box.lo[d] = fminf(fmaxf(lo, 0.0f), 1.0f);
+          box.hi[d] = fminf(fmaxf(hi, 0.0f), 1.0f);
+        }
+      }
+
+      constexpr int kBoxSize = 2 * ndim;
+      float tmp[kBoxSize];
+      for (int d = 0; d < ndim; d++) {
+        tmp[d] = box.lo[d];
+        tmp[ndim + d] = layout.start_shape ? __fsub_rn(box.hi[d], box.lo[d]) : box.hi[d];
+      }
+      float *out = desc.out_boxes + out_idx * 2 * ndim;
+      for (int d = 0; d < 2 * ndim; d++)
+        out[d] = tmp[layout.write_perm[d]];
+
+      if (desc.out_labels) {
+        const int *in_label = desc.in_labels + i * desc.label_stride;
+        int *out_label = desc.out_labels + out_idx * desc.label_stride;
+        for (int64_t k = 0; k < desc.label_stride; k++)
+          out_label[k] = in_label[k];
+      }
+      if (desc.out_indices)
+        desc.out_indices[out_idx] = i;
+    }
+    __syncthreads();
+    if (threadIdx.x == 0) {
+      for (int w = 0; w < nwarps; w++)
+        base += warp_counts[w];
+    }
+    __syncthreads();
+  }
+}
+
+}  // namespace bbox_crop
+
+/**
+ * @brief The GPU variant of RandomBBoxCrop
+ *
+ * The cropping windows are drawn on the host, in the same way (and with the same random draws)
+ * as in the CPU operator, and they are evaluated against the boxes on the GPU. The search
+ * goes in passes: in each pass, the rounds of all the samples which haven't finished yet
+ * are drawn ahead (up to `kCandidatesPerPass` candidates per sample) and evaluated at once.
+ * Then, the windows are selected on the host and the random generators of the samples
+ * whose search finished in an earlier round are rewound to the end of that round.
+ */
+template <int ndim>
+class RandomBBoxCropImplGPU : public OpImplBase<GPUBackend> {
+ public:
+  using Search = BBoxCropSearch<ndim>;
+  using BoxType = Box<ndim, float>;
+
+  static constexpr int kCandidatesPerPass = 64;
+  static constexpr int kMaxRoundsPerPass = 64;
+
+  /**
+   * @param spec  Pointer to a persistent OpSpec object,
+   *              which is guaranteed to be alive for the entire lifetime of this object
+   */
+  explicit RandomBBoxCropImplGPU(const OpSpec *spec) : search_(spec) {
+    auto default_start_end = DefaultBBoxLayout<ndim>();
+    auto default_start_shape = DefaultBBoxAnchorAndShapeLayout<ndim>();
+    const auto &layout = search_.bbox_layout();
+    layout_.start_shape = layout.is_permutation_of(default_start_shape);
+    const auto &ordered = layout_.start_shape ? default_start_shape : default_start_end;
+    auto read_perm = GetDimIndices(layout, ordered);
+    auto write_perm = GetDimIndices(ordered, layout);
+    for (int d = 0; d < 2 * ndim; d++) {
+      layout_.read_perm[d] = read_perm[d];
+      layout_.write_perm[d] = write_perm[d];
+    }
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<GPUBackend> &ws) override {
+    search_.CollectShapes(ws);
+    return false;
+  }
+
+  void RunImpl(workspace_t<GPUBackend> &ws) override;
+
+ private:
+  struct SampleSearch {
+    typename Search::State state;
+    /// The number of boxes with the centroid within the selected window
+    int nboxes_in = 0;
+    bool done = false;
+    /// The random generator at the beginning of the current pass
+    std::mt19937 rng;
+    int first_candidate = 0;
+    int num_rounds = 0;
+  };
+
+  /**
+   * @brief Draws the rounds of the current pass and appends their candidates
+   */
+  void DrawPass(SampleSearch &sample, int sample_idx, const BoxType *boxes, int nboxes);
+
+  /**
+   * @brief Replays the rounds of the current pass with the evaluated candidates
+   */
+  void SelectPass(SampleSearch &sample, int sample_idx, const bbox_crop::CandidateResult *results);
+
+  void ReportOutOfBounds(int sample_idx, int box_idx, const BoxType *boxes, cudaStream_t stream);
+
+  Search search_;
+  bbox_crop::BoxLayoutDesc<ndim> layout_;
+  std::vector<SampleSearch> samples_;
+  std::vector<bbox_crop::ReadBoxesDesc<ndim>> read_descs_;
+  std::vector<bbox_crop::CandidateDesc<ndim>> candidates_;
+  std::vector<bbox_crop::WriteOutputsDesc<ndim>> output_descs_;
+  std::vector<int64_t> box_offsets_;
+  typename Search::Round round_;
+};
+
+template <int ndim>
+void RandomBBoxCropImplGPU<ndim>::DrawPass(SampleSearch &sample, int sample_idx,
+                                           const BoxType *boxes, int nboxes) {
+  auto &rng = search_.rng(sample_idx);
+  sample.rng = rng;
+  sample.first_candidate = candidates_.size();
+  sample.num_rounds = 0;
+  auto state = sample.state;
+  int ncandidates = 0;
+  while (search_.KeepSearching(state) &&
+         ncandidates < kCandidatesPerPass && sample.num_rounds < kMaxRoundsPerPass) {
+    search_.DrawRound(round_, state, sample_idx);
+    sample.num_rounds++;
+    for (auto &candidate : round_.candidates)
+      candidates_.push_back({candidate.rel_crop, boxes, nboxes});
+    ncandidates += round_.candidates.size();
+  }
+}
+
+template <int ndim>
+void RandomBBoxCropImplGPU<ndim>::SelectPass(SampleSearch &sample, int sample_idx,
+                                             const bbox_crop::CandidateResult *results) {
+  auto &state = sample.state;
+  // the rounds are drawn again, to leave the generator where the search ended
+  search_.rng(sample_idx) = sample.rng;
+  int candidate_idx = sample.first_candidate;
+  for (int r = 0; r < sample.num_rounds && search_.KeepSearching(state); r++) {
+    search_.DrawRound(round_, state, sample_idx);
+    for (auto &candidate : round_.candidates) {
+      auto &result = results[candidate_idx++];
+      float metric = search_.all_boxes_above_threshold() ? result.min_metric : result.max_metric;
+      if (!Search::Improves(state, metric, round_.option))
+        continue;
+      Search::Select(state, candidate, metric, round_.option, result.nboxes_in > 0);
+      sample.nboxes_in = result.nboxes_in;
+    }
+  }
+  if (!search_.KeepSearching(state)) {
+    Search::Finish(state);
+    sample.done = true;
+  }
+}
+
+template <int ndim>
+void RandomBBoxCropImplGPU<ndim>::ReportOutOfBounds(int sample_idx, int box_idx,
+                                                    const BoxType *boxes, cudaStream_t stream) {
+  BoxType box;
+  CUDA_CALL(cudaMemcpyAsync(&box, boxes + box_offsets_[sample_idx] + box_idx, sizeof(BoxType),
+                            cudaMemcpyDeviceToHost, stream));
+  CUDA_CALL(cudaStreamSynchronize(stream));
+  auto limits = Uniform<ndim>(0.0f, 1.0f);
+  DALI_FAIL(make_string("box ", box, " is out of bounds ", limits));
+}
+
+template <int ndim>
+void RandomBBoxCropImplGPU<ndim>::RunImpl(workspace_t<GPUBackend> &ws) {
+  using namespace bbox_crop;  // NOLINT
+  const auto &in_boxes = ws.template Input<GPUBackend>(0);
+  auto in_boxes_view = view<const float>(in_boxes);
+  int num_samples = in_boxes_view.num_samples();
+  cudaStream_t stream = ws.stream();
+  kernels::DynamicScratchpad scratch({}, AccessOrder(stream));
+
+  box_offsets_.resize(num_samples + 1);
+  box_offsets_[0] = 0;
+  for (int i = 0; i < num_samples; i++)
+    box_offsets_[i + 1] = box_offsets_[i] + in_boxes_view.tensor_shape_span(i)[0];
+  int64_t total_boxes = box_offsets_[num_samples];
+
+  // Converting the boxes to the internal representation
+  auto *boxes = scratch.AllocateGPU<BoxType>(total_boxes);
+  auto *first_out_of_bounds = scratch.AllocateGPU<unsigned>(num_samples);
+  auto *first_out_of_bounds_host = scratch.AllocatePinned<unsigned>(num_samples);
+  CUDA_CALL(cudaMemsetAsync(first_out_of_bounds, 0xff, num_samples * sizeof(unsigned), stream));
+  read_descs_.resize(num_samples);
+  int max_boxes = 0;
+  for (int i = 0; i < num_samples; i++) {
+    int nboxes = box_offsets_[i + 1] - box_offsets_[i];
+    read_descs_[i] = {in_boxes_view.tensor_data(i), boxes + box_offsets_[i], nboxes};
+    max_boxes = std::max(max_boxes, nboxes);
+  }
+  if (max_boxes > 0) {
+    auto *read_descs_gpu = scratch.ToGPU(stream, read_descs_);
+    dim3 grid(div_ceil(max_boxes, 256), num_samples);
+    ReadBoxesKernel<<<grid, 256, 0, stream>>>(read_descs_gpu, layout_, first_out_of_bounds);
+    CUDA_CALL(cudaGetLastError());
+  }
+  CUDA_CALL(cudaMemcpyAsync(first_out_of_bounds_host, first_out_of_bounds,
+                            num_samples * sizeof(unsigned), cudaMemcpyDeviceToHost, stream));
+
+  // Searching for the windows, in passes
+  samples_.clear();
+  samples_.resize(num_samples);
+  bool boxes_checked = false;
+  for (;;) {
+    candidates_.clear();
+    for (int i = 0; i < num_samples; i++) {
+      if (!samples_[i].done)
+        DrawPass(samples_[i], i, boxes + box_offsets_[i], box_offsets_[i + 1] - box_offsets_[i]);
+    }
+    int num_candidates = candidates_.size();
+    CandidateResult *results = nullptr;
+    if (num_candidates > 0) {
+      auto *candidates_gpu = scratch.ToGPU(stream, candidates_);
+      auto *results_gpu = scratch.AllocateGPU<CandidateResult>(num_candidates);
+      results = scratch.AllocatePinned<CandidateResult>(num_candidates);
+      dim3 block(32, 8);
+      if (search_.overlap_metric() == Search::IoU)
+        EvaluateCandidatesKernel<true><<<num_candidates, block, 0, stream>>>(
+            candidates_gpu, results_gpu);
+      else
+        EvaluateCandidatesKernel<false><<<num_candidates, block, 0, stream>>>(
+            candidates_gpu, results_gpu);
+      CUDA_CALL(cudaGetLastError());
+      CUDA_CALL(cudaMemcpyAsync(results, results_gpu, num_candidates * sizeof(CandidateResult),
+                                cudaMemcpyDeviceToHost, stream));
+    }
+    if (!boxes_checked || num_candidates > 0)
+      CUDA_CALL(cudaStreamSynchronize(stream));
+    if (!boxes_checked) {
+      for (int i = 0; i < num_samples; i++) {
+        if (first_out_of_bounds_host[i] != std::numeric_limits<unsigned>::max())
+          ReportOutOfBounds(i, first_out_of_bounds_host[i], boxes, stream);
+      }
+      boxes_checked = true;
+    }
+
+    bool all_done = true;
+    for (int i = 0; i < num_samples; i++) {
+      if (!samples_[i].done)
+        SelectPass(samples_[i], i, results);
+      all_done = all_done && samples_[i].done;
+    }
+    if (all_done)
+      break;
+  }
+
+  // Writing the outputs
+  auto &anchor_out = ws.template Output<GPUBackend>(0);
+  anchor_out.Resize(uniform_list_shape(num_samples, {ndim}), DALI_FLOAT);
+  auto anchor_out_view = view<float>(anchor_out);
+  auto &shape_out = ws.template Output<GPUBackend>(1);
+  shape_out.Resize(uniform_list_shape(num_samples, {ndim}), DALI_FLOAT);
+  auto shape_out_view = view<float>(shape_out);
+
+  TensorListShape<> bbox_out_shape;
+  bbox_out_shape.resize(num_samples, 2);
+  for (int i = 0; i < num_samples; i++) {
+    auto &state = samples_[i].state;
+    int nboxes_out = 0;
+    if (state.no_crop)
+      nboxes_out = box_offsets_[i + 1] - box_offsets_[i];
+    else if (state.selected)
+      nboxes_out = samples_[i].nboxes_in;
+    auto sh = bbox_out_shape.tensor_shape_span(i);
+    sh[0] = nboxes_out;
+    sh[1] = 2 * ndim;
+  }
+  auto &bbox_out = ws.template Output<GPUBackend>(2);
+  bbox_out.Resize(bbox_out_shape, DALI_FLOAT);
+  auto bbox_out_view = view<float>(bbox_out);
+
+  int next_out_idx = 3;
+  TensorListView<StorageGPU, const int> labels_in_view;
+  TensorListView<StorageGPU, int> labels_out_view;
+  if (search_.has_labels()) {
+    const auto &labels_in = ws.template Input<GPUBackend>(1);
+    labels_in_view = view<const int>(labels_in);
+    TensorListShape<> labels_out_shape = labels_in.shape();
+    for (int i = 0; i < num_samples; i++) {
+      auto sh = labels_out_shape.tensor_shape_span(i);
+      DALI_ENFORCE(sh[0] == box_offsets_[i + 1] - box_offsets_[i], make_string(
+        "The number of labels doesn't match the number of bounding boxes in sample ", i,
+        ": ", sh[0], " vs ", box_offsets_[i + 1] - box_offsets_[i]));
+      sh[0] = bbox_out_shape.tensor_shape_span(i)[0];
+    }
+    auto &labels_out = ws.template Output<GPUBackend>(next_out_idx++);
+    labels_out.Resize(labels_out_shape, DALI_INT32);
+    labels_out_view = view<int>(labels_out);
+  }
+
+  TensorListView<StorageGPU, int> indices_out_view;
+  if (search_.output_bbox_indices()) {
+    TensorListShape<> indices_out_shape;
+    indices_out_shape.resize(num_samples, 1);
+    for (int i = 0; i < num_samples; i++)
+      indices_out_shape.tensor_shape_span(i)[0] = bbox_out_shape.tensor_shape_span(i)[0];
+    auto &indices_out = ws.template Output<GPUBackend>(next_out_idx++);
+    indices_out.Resize(indices_out_shape, DALI_INT32);
+    indices_out_view = view<int>(indices_out);
+  }
+
+  if (num_samples == 0)
+    return;
+
+  output_descs_.resize(num_samples);
+  for (int i = 0; i < num_samples; i++) {
+    auto &state = samples_[i].state;
+    auto &desc = output_descs_[i];
+    // if no window was selected, the crop and the boxes are empty, as on the CPU
+    BoxType crop = state.no_crop || state.selected ? state.crop.out_crop : BoxType{};
+    auto extent = crop.extent();
+    for (int d = 0; d < ndim; d++) {
+      desc.anchor_value[d] = crop.lo[d];
+      desc.shape_value[d] = extent[d];
+    }
+    desc.anchor = anchor_out_view.tensor_data(i);
+    desc.shape = shape_out_view.tensor_data(i);
+    desc.crop = state.crop.rel_crop;
+    desc.keep_all = state.no_crop;
+    desc.in = boxes + box_offsets_[i];
+    desc.nboxes = state.no_crop || state.selected ? box_offsets_[i + 1] - box_offsets_[i] : 0;
+    desc.out_boxes = bbox_out_view.tensor_data(i);
+    desc.in_labels = nullptr;
+    desc.out_labels = nullptr;
+    desc.label_stride = 0;
+    if (search_.has_labels()) {
+      auto in_sh = labels_in_view.tensor_shape_span(i);
+      desc.in_labels = labels_in_view.tensor_data(i);
+      desc.out_labels = labels_out_view.tensor_data(i);
+      desc.label_stride = volume(in_sh.begin() + 1, in_sh.end());
+    }
+    desc.out_indices = search_.output_bbox_indices() ? indices_out_view.tensor_data(i) : nullptr;
+  }
+  auto *output_descs_gpu = scratch.ToGPU(stream, output_descs_);
+  WriteOutputsKernel<<<num_samples, 256, 0, stream>>>(output_descs_gpu, layout_);
+  CUDA_CALL(cudaGetLastError());
+}
+
+template <>
+RandomBBoxCrop<GPUBackend>::~RandomBBoxCrop() = default;
+
+template <>
+RandomBBoxCrop<GPUBackend>::RandomBBoxCrop(const OpSpec &spec)
+    : Operator<GPUBackend>(spec) {}
+
+template <>
+bool RandomBBoxCrop<GPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                           const workspace_t<GPUBackend> &ws) {
+  int num_dims = bbox_crop::BoxesNumDims(ws.template Input<GPUBackend>(0).shape());
+  if (impl_ == nullptr || impl_ndim_ != num_dims) {
+    VALUE_SWITCH(num_dims, ndim, (2, 3),
+      (impl_ = std::make_unique<RandomBBoxCropImplGPU<ndim>>(&spec_);),
+      (DALI_FAIL(make_string("Not supported number of dimensions", num_dims));));
+    impl_ndim_ = num_dims;
+  }
+  return impl_->SetupImpl(output_desc, ws);
+}
+
+template <>
+void RandomBBoxCrop<GPUBackend>::RunImpl(workspace_t<GPUBackend> &ws) {
+  assert(impl_ != nullptr);
+  impl_->RunImpl(ws);
+}
+
+DALI_REGISTER_OPERATOR(RandomBBoxCrop, RandomBBoxCrop<GPUBackend>, GPU);
+
+}  // namespace dali
@@ -0,0 +1,578 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_IMAGE_CROP_BBOX_CROP_SEARCH_H_
+#define DALI_OPERATORS_IMAGE_CROP_BBOX_CROP_SEARCH_H_
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/core/geom/box.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/pipeline/data/views.h"
+#include "dali/pipeline/operator/op_spec.h"
+#include "dali/pipeline/util/batch_rng.h"
+#include "dali/pipeline/util/bounding_box_utils.h"
+#include "dali/pipeline/workspace/workspace.h"
+
+namespace dali {
+
+namespace bbox_crop {
+
+// This is the default shape layout that the operator uses internally
+inline TensorLayout InternalShapeLayout(int ndim) {
+  assert(ndim == 3 || ndim == 2);
+  return ndim == 3 ? "WHD" : "WH";
+}
+
+template <int ndim>
+void CollectShape(std::vector<i64vec<ndim>> &v,
+                  const std::string &name,
+                  const OpSpec& spec,
+                  const ArgumentWorkspace& ws,
+                  span<const int> perm) {
+  int batch_size = spec.GetArgument<int>("max_batch_size");
+  v.clear();
+  v.reserve(batch_size);
+
+  i64vec<ndim> sample_sh;
+  if (spec.HasTensorArgument(name)) {
+    auto arg_view = view<const int>(ws.ArgumentInput(name));
+    DALI_ENFORCE(arg_view.num_samples() == batch_size, make_string(
+      "Unexpected number of samples in argument `", name, "`: ", arg_view.num_samples(),
+      ", expected: ", batch_size));
+
+    for (int sample = 0; sample < batch_size; sample++) {
+      auto shape_len = volume(arg_view.tensor_shape(sample));
+      DALI_ENFORCE(shape_len == ndim, make_string(
+        "Unexpected number of elements in argument `", name, "`: ", shape_len,
+        ", expected: ", ndim));
+      permute(sample_sh, arg_view.tensor_data(sample), perm);
+
+      DALI_ENFORCE(all_coords(sample_sh >= 0),
+                   make_string("``", name,
+                               "`` argument should contain non negative values. Got: ", sample_sh));
+
+      v.push_back(sample_sh);
+    }
+  } else if (spec.HasArgument(name)) {
+    auto tmp = spec.GetRepeatedArgument<int>(name);
+    DALI_ENFORCE(static_cast<int>(tmp.size()) == ndim,
+                 make_string("Argument `", name, "` must be a ", ndim, "D vector. Got ", tmp.size(),
+                             " elements."));
+    permute(sample_sh, tmp, perm);
+
+    DALI_ENFORCE(all_coords(sample_sh >= 0),
+                 make_string("``", name,
+                             "`` argument should contain non negative values. Got: ", sample_sh));
+
+    v.resize(batch_size, sample_sh);
+  } else {
+    DALI_FAIL(make_string("Argument `", name, "` was not found"));
+  }
+}
+
+struct SampleOption {
+  bool no_crop = false;
+  float threshold = 0.0f;
+};
+
+struct Range {
+  bool Contains(float k) const {
+    assert(min <= max);
+    return k >= min && k <= max;
+  }
+  float min = 0.0f, max = 0.0f;
+};
+
+/**
+ * @brief Validates the shape of the bounding boxes input
+ *
+ * @return The number of dimensions of the boxes
+ */
+inline int BoxesNumDims(const TensorListShape<> &tl_shape) {
+  DALI_ENFORCE(tl_shape.sample_dim() == 2, make_string(
+    "Unexpected number of dimensions for bounding boxes input: ", tl_shape.sample_dim()));
+  // first dim is number of boxes, second is number of coordinates on each box
+  auto ncoords = tl_shape[0][1];  // first sample, second dimension
+  for (int sample = 0; sample < tl_shape.num_samples(); sample++) {
+    auto sh = tl_shape[sample];
+    DALI_ENFORCE(sh[1] == ncoords,
+      make_string("Unexpected number of coordinates for sample ", sample, ". Expected ",
+                  ncoords, ", got ", sh[1]));
+  }
+  DALI_ENFORCE(ncoords % 2 == 0,
+    make_string("Unexpected number of coordinates for bounding boxes: ", ncoords));
+  auto num_dims = ncoords / 2;
+
+  DALI_ENFORCE(num_dims == 2 || num_dims == 3,
+    make_string("Unexpected number of dimensions: ", num_dims));
+  return num_dims;
+}
+
+}  // namespace bbox_crop
+
+/**
+ * @brief The arguments and the random search for a cropping window of RandomBBoxCrop
+ *
+ * The search goes in rounds: each round draws a sample option (a threshold or no crop) and
+ * then `num_attempts` candidate windows. The candidates are evaluated by the backend, which
+ * reports the overlap metric and whether any box is left in the window, and the search
+ * selects the last valid candidate or, if there's none, the best one so far.
+ *
+ * Drawing the candidates doesn't depend on their evaluation, so a backend can draw the rounds
+ * ahead and evaluate them at once, as long as it rewinds the random generator to the end
+ * of the round that finished the search.
+ */
+template <int ndim>
+class BBoxCropSearch {
+ public:
+  using SampleOption = bbox_crop::SampleOption;
+  using Range = bbox_crop::Range;
+
+  enum OverlapMetric {
+    IoU = 1,
+    Overlap = 2
+  };
+
+  struct Candidate {
+    /// The window in relative coordinates, used to evaluate and remap the boxes
+    Box<ndim, float> rel_crop;
+    /// The window in the output coordinates: absolute, if `crop_shape` is used
+    Box<ndim, float> out_crop;
+  };
+
+  /// The option and the candidates drawn in one round of the search
+  struct Round {
+    SampleOption option;
+    /// The candidates, without the ones rejected because of their aspect ratio
+    std::vector<Candidate> candidates;
+  };
+
+  /// The progress of the search in one sample
+  struct State {
+    int count = 0;
+    float best_metric = -1.0f;
+    bool success = false;
+    bool no_crop = false;
+    /// Whether any candidate was selected
+    bool selected = false;
+    Candidate crop{};
+  };
+
+  /**
+   * @param spec  Pointer to a persistent OpSpec object,
+   *              which is guaranteed to be alive for the entire lifetime of this object
+   */
+  explicit BBoxCropSearch(const OpSpec *spec)
+      : spec_(*spec),
+        num_attempts_{spec_.GetArgument<int>("num_attempts")},
+        has_labels_(spec_.NumRegularInput() > 1),
+        has_crop_shape_(spec_.ArgumentDefined("crop_shape")),
+        has_input_shape_(spec_.ArgumentDefined("input_shape")),
+        bbox_layout_(spec_.GetArgument<TensorLayout>("bbox_layout")),
+        shape_layout_(spec_.GetArgument<TensorLayout>("shape_layout")),
+        all_boxes_above_threshold_(spec_.GetArgument<bool>("all_boxes_above_threshold")),
+        output_bbox_indices_(spec_.GetArgument<bool>("output_bbox_indices")),
+        rngs_(spec_.GetArgument<int64_t>("seed"), spec_.GetArgument<int>("max_batch_size")) {
+    auto scaling_arg = spec_.GetRepeatedArgument<float>("scaling");
+    DALI_ENFORCE(scaling_arg.size() == 2,
+                 make_string("`scaling` must be a range `[min, max]`. Got ",
+                             scaling_arg.size(), " values"));
+    scale_range_.min = scaling_arg[0];
+    scale_range_.max = scaling_arg[1];
+    DALI_ENFORCE(
+        scale_range_.min >= 0 && scale_range_.min <= scale_range_.max,
+        make_string("`scaling` range must be positive and min <= max. Got: ", scale_range_.min,
+                    ", ", scale_range_.max));
+
+    auto aspect_ratio_arg = spec_.GetRepeatedArgument<float>("aspect_ratio");
+    DALI_ENFORCE(aspect_ratio_arg.size() == 2 || aspect_ratio_arg.size() == 6,
+        make_string(
+            "`aspect_ratio` range argument should have 2 elements, or 6 elements in case of "
+            "3D bounding boxes. Got ",
+            aspect_ratio_arg.size(), " elements"));
+    aspect_ratio_ranges_.resize(aspect_ratio_arg.size() / 2);
+    int k = 0;
+    for (auto &range : aspect_ratio_ranges_) {
+      range.min = aspect_ratio_arg[k++];
+      range.max = aspect_ratio_arg[k++];
+      DALI_ENFORCE(range.min >= 0 && range.min <= range.max,
+                   make_string("`aspect_ratio` range must be positive and min <= max. Got: ",
+                               range.min, ", ", range.max));
+    }
+
+    if (has_crop_shape_) {
+      DALI_ENFORCE(has_input_shape_,
+        "``input_shape`` must be provided when providing ``crop_shape``");
+    }
+
+    if (spec_.ArgumentDefined("ltrb")) {
+      if (spec_.ArgumentDefined("bbox_layout")) {
+        DALI_FAIL(
+            "`ltrb` and `bbox_layout` can't be provided at the same time. `ltrb` was deprecated in "
+            "favor of `bbox_layout`.");
+      }
+      DALI_WARN(
+          "WARNING: `ltrb` is deprecated. Please use `bbox_layout` to specify the format of the "
+          "bounding box. E.g. For 2D bounding boxes, `ltrb=True`` is equivalent to "
+          "`bbox_layout=\"xyXY\"`, and `ltrb=False` is equivalent to `bbox_layout=\"xyWH\"`");
+    }
+
+    bool allow_no_crop = spec_.GetArgument<bool>("allow_no_crop");
+    if (has_crop_shape_) {
+      // If it was left default but a crop_shape was provided, disallow no crop silently
+      if (!spec_.HasArgument("allow_no_crop")) {
+        DALI_WARN("Using explicit `crop_shape`, `allow_no_crop` will not take effect.");
+        allow_no_crop = false;
+      }
+
+      DALI_ENFORCE(!allow_no_crop,
+                   "`allow_no_crop` is incompatible with providing the crop shape explicitly");
+      DALI_ENFORCE(!spec_.HasArgument("aspect_ratio"),
+                   "`aspect_ratio` is incompatible with providing the crop shape explicitly");
+      DALI_ENFORCE(!spec_.HasArgument("scaling"),
+                   "`scaling` is incompatible with providing the crop shape explicitly");
+    }
+
+    auto thresholds = spec_.GetRepeatedArgument<float>("thresholds");
+    DALI_ENFORCE(!thresholds.empty(),
+      "At least one threshold value must be provided");
+    DALI_ENFORCE(num_attempts_ > 0,
+      "Minimum number of attempts must be greater than zero");
+    for (const auto &threshold : thresholds) {
+      DALI_ENFORCE(0.0 <= threshold && threshold <= 1.0,
+        make_string("Threshold value must be within the range [0.0, 1.0]. Received: ", threshold));
+      sample_options_.push_back({false, threshold});
+    }
+
+    if (spec_.HasArgument("threshold_type")) {
+      auto threshold_type = spec_.GetArgument<std::string>("threshold_type");
+      if (threshold_type == "iou") {
+        overlap_metric_ = OverlapMetric::IoU;
+      } else  if (threshold_type == "overlap") {
+        overlap_metric_ = OverlapMetric::Overlap;
+      } else {
+        DALI_FAIL(make_string("Not supported ``threshold_type`` value: \"", threshold_type,
+                              "\". Supported values are: \"iou\", \"overlap\"."));
+      }
+    }
+
+    if (allow_no_crop) {
+      sample_options_.push_back({true, 0.0f});
+    }
+
+    total_num_attempts_ = -1;
+    if (spec_.HasArgument("total_num_attempts")) {
+      total_num_attempts_ = spec_.GetArgument<int>("total_num_attempts");
+      DALI_ENFORCE(total_num_attempts_ > 0,
+        "Minimum total number of attempts must be greater than zero");
+    }
+
+    auto default_bbox_layout_start_end = DefaultBBoxLayout<ndim>();
+    auto default_bbox_layout_start_shape = DefaultBBoxAnchorAndShapeLayout<ndim>();
+    if (bbox_layout_.empty()) {
+      auto ltrb = spec_.GetArgument<bool>("ltrb");
+      bbox_layout_ = ltrb ? default_bbox_layout_start_end : default_bbox_layout_start_shape;
+    }
+    DALI_ENFORCE(bbox_layout_.is_permutation_of(default_bbox_layout_start_end) ||
+                 bbox_layout_.is_permutation_of(default_bbox_layout_start_shape),
+      make_string("`bbox_layout` should be a permutation of `", default_bbox_layout_start_end,
+                  "` or `", default_bbox_layout_start_shape, "`. Got: `", bbox_layout_, "`"));
+  }
+
+
+  /**
+   * @brief Collects the `crop_shape` and `input_shape` of the samples
+   */
+  void CollectShapes(const ArgumentWorkspace &ws) {
+    if (has_input_shape_ || has_crop_shape_) {
+      // Converting the shapes to "WHD" or "WH" if necessary
+      auto default_shape_layout = bbox_crop::InternalShapeLayout(ndim);
+      const TensorLayout &layout = shape_layout_.empty() ? default_shape_layout : shape_layout_;
+      if (!shape_layout_.empty() && shape_layout_ != default_shape_layout) {
+        DALI_ENFORCE(shape_layout_.is_permutation_of(default_shape_layout),
+                     make_string("`shape_layout` should be a permutation of ", default_shape_layout,
+                                 "` for the provided inputs"));
+      }
+      auto perm = GetDimIndices(layout, default_shape_layout);
+      if (has_crop_shape_)
+        bbox_crop::CollectShape(crop_shape_, "crop_shape", spec_, ws, make_cspan(perm));
+      if (has_input_shape_)
+        bbox_crop::CollectShape(input_shape_, "input_shape", spec_, ws, make_cspan(perm));
+    }
+  }
+
+  const TensorLayout &bbox_layout() const {
+    return bbox_layout_;
+  }
+
+  bool has_labels() const {
+    return has_labels_;
+  }
+
+  bool output_bbox_indices() const {
+    return output_bbox_indices_;
+  }
+
+  OverlapMetric overlap_metric() const {
+    return overlap_metric_;
+  }
+
+  bool all_boxes_above_threshold() const {
+    return all_boxes_above_threshold_;
+  }
+
+  /**
+   * @brief The random generator of the sample - snapshot it to redraw the rounds
+   */
+  std::mt19937 &rng(int sample) {
+    return rngs_[sample];
+  }
+
+  /**
+   * @brief Whether another round should be drawn
+   */
+  bool KeepSearching(const State &state) const {
+    return !state.success && (total_num_attempts_ < 0 || state.count < total_num_attempts_);
+  }
+
+  /**
+   * @brief Draws the option and the candidates of the next round
+   *
+   * If the drawn option is to not crop, the search is finished with the whole input as
+   * the window.
+   */
+  void DrawRound(Round &round, State &state, int sample) {
+    auto &rng = rngs_[sample];
+    std::uniform_int_distribution<> idx_dist(0, sample_options_.size() - 1);
+    round.option = sample_options_[idx_dist(rng)];
+    round.candidates.clear();
+    bool absolute_crop_dims = has_crop_shape_;
+
+    if (round.option.no_crop) {
+      Box<ndim, float> no_crop = Uniform<ndim>(0.0f, 1.0f);
+      if (absolute_crop_dims) {
+        auto &input_shape = input_shape_[sample];
+        for (int d = 0; d < ndim; d++)
+          no_crop.hi[d] *= input_shape[d];
+      }
+      state.success = true;
+      state.no_crop = true;
+      state.crop.out_crop = no_crop;
+      return;
+    }
+
+    vec<ndim> shape, anchor;
+    Box<ndim, float> rel_crop, out_crop;
+    for (int i = 0; i < num_attempts_; i++, state.count++) {
+      if (absolute_crop_dims) {
+        auto &crop_shape = crop_shape_[sample];
+        auto &input_shape = input_shape_[sample];
+
+        for (int d = 0; d < ndim; d++) {
+          shape[d] = static_cast<float>(crop_shape[d]);
+          out_crop.hi[d] = shape[d];
+          rel_crop.hi[d] = shape[d] / input_shape[d];
+        }
+
+        for (int d = 0; d < ndim; d++) {
+          auto diff = input_shape[d] - crop_shape[d];
+          if (diff > 0) {
+            anchor[d] = static_cast<float>(
+                std::uniform_int_distribution<>(0, diff)(rng));
+          } else if (diff < 0) {
+            anchor[d] = static_cast<float>(
+                std::uniform_int_distribution<>(diff, 0)(rng));
+          } else {
+            anchor[d] = 0.0f;
+          }
+          out_crop.lo[d] = anchor[d];
+          rel_crop.lo[d] = anchor[d] / input_shape[d];
+        }
+        out_crop.hi += out_crop.lo;
+        rel_crop.hi += rel_crop.lo;
+      } else {  // relative dimensions
+        std::uniform_real_distribution<float> extent_dist(scale_range_.min, scale_range_.max);
+        for (int d = 0; d < ndim; d++) {
+          shape[d] = extent_dist(rng);
+        }
+
+        // If input shape is provided, we take it into account for the aspect ratio range check
+        // Otherwise, we use the relative shape for aspect ratio check
+        vec<ndim> tmp_sh = has_input_shape_ ? shape * input_shape_[sample] : shape;
+
+        bool fixed_ar = FixAspectRatios(tmp_sh, rng);
+
+        if (!ValidAspectRatio(tmp_sh))
+          continue;
+
+        if (fixed_ar) {
+          shape = has_input_shape_ ? tmp_sh / input_shape_[sample] : tmp_sh;
+        }
+
+        for (int d = 0; d < ndim; d++) {
+          std::uniform_real_distribution<float> anchor_dist(0.0f, 1.0f - shape[d]);
+          anchor[d] = anchor_dist(rng);
+          rel_crop.lo[d] = anchor[d];
+          rel_crop.hi[d] = anchor[d] + shape[d];
+        }
+        out_crop = rel_crop;
+      }
+      round.candidates.push_back({rel_crop, out_crop});
+    }
+  }
+
+  /**
+   * @brief Whether the candidate with given overlap metric replaces the current window
+   */
+  static bool Improves(const State &state, float metric, const SampleOption &option) {
+    return metric > state.best_metric || metric >= option.threshold;
+  }
+
+  /**
+   * @brief Replaces the current window with the candidate
+   *
+   * @param any_box  whether the centroid of any of the boxes is within the candidate window
+   */
+  static void Select(State &state, const Candidate &candidate, float metric,
+                     const SampleOption &option, bool any_box) {
+    state.best_metric = metric;
+    state.crop = candidate;
+    state.selected = true;
+    state.success = metric >= option.threshold && any_box;
+  }
+
+  /**
+   * @brief Accepts the best window, if the search ran out of attempts
+   */
+  static void Finish(State &state) {
+    if (!state.success) {
+      DALI_WARN(make_string(
+        "Could not find a valid cropping window to satisfy the specified requirements (attempted ",
+        state.count, " times). Using the best cropping window so far (best_metric=",
+        state.best_metric, ")"));
+      state.success = true;
+    }
+  }
+
+ private:
+  /**
+   * @brief Fixes shape dimensions to follow aspect ratio constraints in case of ar_min == ar_max
+   * @remarks The dimensions are fixed on a random order
+   * @return true if the shape was modified, false otherwise
+   */
+  bool FixAspectRatios(vec<ndim>& shape, std::mt19937 &rng) {
+    // If aspect ratio is fixed, fix the required dimensions
+    std::array<float, ndim*ndim> fixed_aspect_ratios;
+    int k = 0;
+
+    bool need_fix = false;
+    for (int d0 = 0; d0 < ndim; d0++) {
+      for (int d1 = d0 + 1; d1 < ndim; d1++) {
+        // to be used later when min==max
+        if (aspect_ratio_ranges_[k].min == aspect_ratio_ranges_[k].max) {
+          fixed_aspect_ratios[d0*ndim+d1] = aspect_ratio_ranges_[k].min;
+          fixed_aspect_ratios[d1*ndim+d0] = 1.0 / aspect_ratio_ranges_[k].min;
+          need_fix = true;
+        } else {
+          fixed_aspect_ratios[d0*ndim+d1] = 0.0f;
+          fixed_aspect_ratios[d1*ndim+d0] = 0.0f;
+        }
+        k = (k + 1) % aspect_ratio_ranges_.size();
+      }
+    }
+
+    if (!need_fix)
+      return false;
+
+    std::array<int, ndim> order;
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    float max_extent = 0.0f;
+    for (int d = 0; d < ndim; d++) {
+      max_extent = std::max(max_extent, shape[d]);
+    }
+
+    for (int i0 = 0; i0 < ndim; i0++) {
+      for (int i1 = i0 + 1; i1 < ndim; i1++) {
+        int d0 = order[i0], d1 = order[i1];
+        auto fixed_ar = fixed_aspect_ratios[d1*ndim+d0];
+        if (fixed_ar > 0) {
+          shape[d1] = shape[d0] * fixed_ar;
+        }
+      }
+    }
+
+    // Re-scale so that largest extent matches the previous max extent
+    float new_max_extent = 0.0;
+    for (int d = 0; d < ndim; d++)
+      new_max_extent = std::max(new_max_extent, shape[d]);
+
+    for (auto &extent : shape)
+      extent = max_extent * extent / new_max_extent;
+
+    return true;
+  }
+
+  bool ValidAspectRatio(vec<ndim> shape) {
+    assert(static_cast<int>(shape.size()) == ndim);
+    int k = 0;
+    assert(!aspect_ratio_ranges_.empty());
+    for (int i = 0; i < ndim; i++) {
+      for (int j = i + 1; j < ndim; j++) {
+        if (!aspect_ratio_ranges_[k].Contains(shape[i] / shape[j]))
+          return false;
+        k = (k + 1) % aspect_ratio_ranges_.size();
+      }
+    }
+    return true;
+  }
+
+  const OpSpec &spec_;
+  int num_attempts_;
+  int total_num_attempts_;
+  bool has_labels_;
+  bool has_crop_shape_;
+  bool has_input_shape_;
+
+  TensorLayout bbox_layout_;
+  TensorLayout shape_layout_;
+
+  OverlapMetric overlap_metric_ = OverlapMetric::IoU;
+  bool all_boxes_above_threshold_ = true;
+  bool output_bbox_indices_ = false;
+
+  BatchRNG<std::mt19937> rngs_;
+
+  std::vector<SampleOption> sample_options_;
+
+  std::vector<i64vec<ndim>> crop_shape_;
+  std::vector<i64vec<ndim>> input_shape_;
+
+  Range scale_range_;
+  std::vector<Range> aspect_ratio_ranges_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_IMAGE_CROP_BBOX_CROP_SEARCH_H_
@@ -34,6 +34,7 @@ Normalization takes the input images and produces the output by using the follow
 )code")
   .NumInput(1)
   .NumOutput(1)
+  .MicroBatchable()
   .InputLayout(0, {"HWC", "CHW",
                    "DHWC", "CDHW",
                    "FHWC", "FCHW", "CFHW",
@@ -16,7 +16,9 @@
 #include <vector>
 #include "dali/operators/image/crop/crop_mirror_normalize.h"
 #include "dali/kernels/slice/slice_flip_normalize_permute_pad_gpu.h"
+#include "dali/kernels/dynamic_scratchpad.h"
 #include "dali/core/static_switch.h"
+#include "dali/operators/util/cast_samples.h"
 #include "dali/pipeline/data/views.h"
 
 namespace dali {
@@ -29,8 +31,16 @@ bool CropMirrorNormalize<GPUBackend>::SetupImpl(std::vector<OutputDesc> &output_
   SetupCommonImpl(ws);
   const auto &input = ws.Input<GPUBackend>(0);
   int ndim = input.shape().sample_dim();
-  TYPE_SWITCH(input_type_, type2id, InputType, CMN_IN_TYPES, (
-    TYPE_SWITCH(output_type_, type2id, OutputType, CMN_OUT_TYPES, (
+  DALI_ENFORCE(DALI_TYPE_IN_LIST(input_type_, type2id, CMN_IN_TYPES),
+               make_string("Not supported input type:", input_type_));
+  DALI_ENFORCE(DALI_TYPE_IN_LIST(output_type_, type2id, CMN_OUT_TYPES),
+               make_string("Not supported output type:", output_type_));
+  kernel_in_type_ = DALI_TYPE_IN_LIST(input_type_, type2id, CMN_GPU_KERNEL_IN_TYPES)
+                        ? input_type_ : DALI_FLOAT;
+  kernel_out_type_ = DALI_TYPE_IN_LIST(output_type_, type2id, CMN_GPU_KERNEL_OUT_TYPES)
+                         ? output_type_ : DALI_FLOAT;
+  TYPE_SWITCH(kernel_in_type_, type2id, InputType, CMN_GPU_KERNEL_IN_TYPES, (
+    TYPE_SWITCH(kernel_out_type_, type2id, OutputType, CMN_GPU_KERNEL_OUT_TYPES, (
       VALUE_SWITCH(ndim, Dims, CMN_NDIMS, (
         using Kernel = kernels::SliceFlipNormalizePermutePadGpu<OutputType, InputType, Dims>;
         using Args = kernels::SliceFlipNormalizePermutePadArgs<Dims>;
@@ -41,7 +51,10 @@ bool CropMirrorNormalize<GPUBackend>::SetupImpl(std::vector<OutputDesc> &output_
 
         kernels::KernelContext ctx;
         ctx.gpu.stream = ws.stream();
-        auto in_view = view<const InputType, Dims>(input);
+        // The setup uses only the shape of the input - the data may be converted in RunImpl
+        TensorListView<StorageGPU, const InputType, Dims> in_view;
+        in_view.shape = convert_dim<Dims>(input.shape());
+        in_view.data.resize(in_view.shape.num_samples());
         auto &req = kmgr_.Setup<Kernel>(0, ctx, in_view, kernel_sample_args);
         output_desc[0].shape = req.output_shapes[0];
       ), DALI_FAIL(make_string("Not supported number of dimensions:", ndim));); // NOLINT
@@ -56,17 +69,47 @@ void CropMirrorNormalize<GPUBackend>::RunImpl(DeviceWorkspace &ws) {
   auto &output = ws.Output<GPUBackend>(0);
   output.SetLayout(output_layout_);
   int ndim = input.shape().sample_dim();
-  TYPE_SWITCH(input_type_, type2id, InputType, CMN_IN_TYPES, (
-    TYPE_SWITCH(output_type_, type2id, OutputType, CMN_OUT_TYPES, (
+  int nsamples = input.num_samples();
+  // The input and output types without specialized kernels are converted from and to float,
+  // in temporary buffers
+  kernels::DynamicScratchpad scratchpad({}, ws.stream());
+  std::vector<CastSample> cast_samples;
+  TYPE_SWITCH(kernel_in_type_, type2id, InputType, CMN_GPU_KERNEL_IN_TYPES, (
+    TYPE_SWITCH(kernel_out_type_, type2id, OutputType, CMN_GPU_KERNEL_OUT_TYPES, (
       VALUE_SWITCH(ndim, Dims, CMN_NDIMS, (
         using Kernel = kernels::SliceFlipNormalizePermutePadGpu<OutputType, InputType, Dims>;
         using Args = kernels::SliceFlipNormalizePermutePadArgs<Dims>;
-        auto in_view = view<const InputType, Dims>(input);
-        auto out_view = view<OutputType, Dims>(output);
+        TensorListView<StorageGPU, const InputType, Dims> in_view;
+        if (kernel_in_type_ == input_type_) {
+          in_view = view<const InputType, Dims>(input);
+        } else {
+          auto converted = scratchpad.AllocTensorList<mm::memory_kind::device, InputType, Dims>(
+              convert_dim<Dims>(input.shape()));
+          cast_samples.clear();
+          for (int i = 0; i < nsamples; i++)
+            cast_samples.push_back({converted.data[i], input.raw_tensor(i),
+                                    converted.shape.tensor_size(i)});
+          CastSamplesGPU(kernel_in_type_, input_type_, make_cspan(cast_samples), ws.stream());
+          in_view = converted;
+        }
+        TensorListView<StorageGPU, OutputType, Dims> out_view;
+        if (kernel_out_type_ == output_type_) {
+          out_view = view<OutputType, Dims>(output);
+        } else {
+          out_view = scratchpad.AllocTensorList<mm::memory_kind::device, OutputType, Dims>(
+              convert_dim<Dims>(output.shape()));
+        }
         kernels::KernelContext ctx;
         ctx.gpu.stream = ws.stream();
         auto &kernel_sample_args = any_cast<std::vector<Args>&>(kernel_sample_args_);
         kmgr_.Run<Kernel>(0, ctx, out_view, in_view, kernel_sample_args);
+        if (kernel_out_type_ != output_type_) {
+          cast_samples.clear();
+          for (int i = 0; i < nsamples; i++)
+            cast_samples.push_back({output.raw_mutable_tensor(i), out_view.data[i],
+                                    out_view.shape.tensor_size(i)});
+          CastSamplesGPU(output_type_, kernel_out_type_, make_cspan(cast_samples), ws.stream());
+        }
       ), DALI_FAIL(make_string("Not supported number of dimensions:", ndim));); // NOLINT
     ), DALI_FAIL(make_string("Not supported output type:", output_type_));); // NOLINT
   ), DALI_FAIL(make_string("Not supported input type:", input_type_));); // NOLINT
@@ -23,6 +23,7 @@
 #include "dali/core/format.h"
 #include "dali/core/util.h"
 #include "dali/core/error_handling.h"
+#include "dali/core/hot_types.h"
 #include "dali/core/static_switch.h"
 #include "dali/kernels/kernel_manager.h"
 #include "dali/kernels/scratch.h"
@@ -34,9 +35,14 @@
 #include "dali/pipeline/operator/operator.h"
 
 #define CMN_IN_TYPES (uint8_t, int16_t, uint16_t, int32_t, float, float16)
-#define CMN_OUT_TYPES (float, float16, uint8_t, int8_t)
+#define CMN_OUT_TYPES (float, float16, bfloat16, uint8_t, int8_t)
 #define CMN_NDIMS (3, 4, 5)
 
+// The types for which the GPU kernels are instantiated; the other types are converted
+// to and from float
+#define CMN_GPU_KERNEL_IN_TYPES DALI_KERNEL_TYPES(CMN_IN_TYPES, DALI_HOT_INPUT_TYPES)
+#define CMN_GPU_KERNEL_OUT_TYPES DALI_KERNEL_TYPES(CMN_OUT_TYPES, DALI_HOT_OUTPUT_TYPES)
+
 namespace dali {
 
 namespace detail {
@@ -102,6 +108,7 @@ class CropMirrorNormalize : public Operator<Backend> {
         output_layout_(spec.GetArgument<TensorLayout>("output_layout")),
         pad_output_(spec.GetArgument<bool>("pad_output")),
         out_of_bounds_policy_(GetOutOfBoundsPolicy(spec)),
+        mirror_arg_("mirror", spec),
         mean_arg_("mean", spec),
         std_arg_("std", spec),
         scale_(spec.GetArgument<float>("scale")),
@@ -201,7 +208,7 @@ class CropMirrorNormalize : public Operator<Backend> {
       auto crop_win_gen = crop_attr_.GetCropWindowGenerator(data_idx);
       assert(crop_win_gen);
       CropWindow crop_window = crop_win_gen(in_shape[data_idx], input_layout_);
-      bool horizontal_flip = this->spec_.template GetArgument<int>("mirror", &ws, data_idx);
+      bool horizontal_flip = mirror_arg_.Get(ws, data_idx);
       ApplySliceBoundsPolicy(out_of_bounds_policy_, in_shape[data_idx], crop_window.anchor,
                               crop_window.shape);
 
@@ -228,6 +235,9 @@ class CropMirrorNormalize : public Operator<Backend> {
 
   DALIDataType input_type_ = DALI_NO_TYPE;
   DALIDataType output_type_ = DALI_NO_TYPE;
+  // The types of the kernel - either the same as the input/output or float
+  DALIDataType kernel_in_type_ = DALI_NO_TYPE;
+  DALIDataType kernel_out_type_ = DALI_NO_TYPE;
 
   TensorLayout input_layout_;
   TensorLayout output_layout_;
@@ -238,6 +248,7 @@ class CropMirrorNormalize : public Operator<Backend> {
   std::vector<float> fill_values_;
   OutOfBoundsPolicy out_of_bounds_policy_ = OutOfBoundsPolicy::Error;
 
+  ArgHandle<int> mirror_arg_;
   ArgValue<float, 1> mean_arg_;
   ArgValue<float, 1> std_arg_;
   float scale_ = 1.0f;
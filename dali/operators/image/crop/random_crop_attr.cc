@@ -19,6 +19,7 @@ namespace dali {
 
 DALI_SCHEMA(RandomCropAttr)
     .DocStr(R"code(Random Crop attributes placeholder)code")
+    .Nondeterministic()
     .AddOptionalArg("random_aspect_ratio",
       R"code(Range from which to choose random aspect ratio (width/height).)code",
       std::vector<float>{3./4., 4./3.})
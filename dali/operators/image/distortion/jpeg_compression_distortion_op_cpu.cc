@@ -1,4 +1,4 @@
-// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,8 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <opencv2/opencv.hpp>
 #include <vector>
+#include "dali/kernels/imgproc/jpeg/jpeg_distortion_cpu.h"
 #include "dali/operators/image/distortion/jpeg_compression_distortion_op.h"
 
 namespace dali {
@@ -50,26 +50,8 @@ class JpegCompressionDistortionCPU : public JpegCompressionDistortion<CPUBackend
 
  protected:
   void RunImpl(workspace_t<CPUBackend> &ws) override;
-
- private:
-  struct ThreadCtx {
-    std::vector<uint8_t> encoded;
-  };
-  std::vector<ThreadCtx> thread_ctx_;
 };
 
-template <typename ThreadCtx>
-static void RunJpegDistortionCPU(ThreadCtx &ctx, const uint8_t *input, uint8_t *output,
-                                 size_t width, size_t height, int quality) {
-  auto in_mat = cv::Mat(height, width, CV_8UC3, const_cast<uint8_t *>(input));
-  auto out_mat = cv::Mat(height, width, CV_8UC3, output);
-
-  cv::cvtColor(in_mat, out_mat, cv::COLOR_RGB2BGR);
-  cv::imencode(".jpg", out_mat, ctx.encoded, {cv::IMWRITE_JPEG_QUALITY, quality});
-  cv::imdecode(ctx.encoded, cv::IMREAD_COLOR, &out_mat);
-  cv::cvtColor(out_mat, out_mat, cv::COLOR_BGR2RGB);
-}
-
 void JpegCompressionDistortionCPU::RunImpl(workspace_t<CPUBackend> &ws) {
   const auto &input = ws.Input<CPUBackend>(0);
   auto &output = ws.Output<CPUBackend>(0);
@@ -79,8 +61,6 @@ void JpegCompressionDistortionCPU::RunImpl(workspace_t<CPUBackend> &ws) {
   auto in_view = view<const uint8_t>(input);
   auto out_view = view<uint8_t>(output);
 
-  thread_ctx_.resize(thread_pool.NumThreads());
-
   for (int sample_idx = 0; sample_idx < nsamples; sample_idx++) {
     auto shape = in_shape.tensor_shape_span(sample_idx);
     int ndim = shape.size();
@@ -104,9 +84,13 @@ void JpegCompressionDistortionCPU::RunImpl(workspace_t<CPUBackend> &ws) {
       thread_pool.AddWork(
           [&, sample_idx, elem_idx, width, height, frame_size,
            quality = quality_arg_[sample_idx].data[0]](int thread_id) {
-            auto *in = in_view[sample_idx].data + elem_idx * frame_size;
-            auto *out = out_view[sample_idx].data + elem_idx * frame_size;
-            RunJpegDistortionCPU(thread_ctx_[thread_id], in, out, width, height, quality);
+            TensorShape<3> frame_shape{height, width, 3};
+            auto in = make_tensor_cpu<3>(in_view[sample_idx].data + elem_idx * frame_size,
+                                         frame_shape);
+            auto out = make_tensor_cpu<3>(out_view[sample_idx].data + elem_idx * frame_size,
+                                          frame_shape);
+            kernels::KernelContext ctx;
+            kernels::jpeg::JpegCompressionDistortionCPU().Run(ctx, out, in, quality);
           },
           frame_size);
     }
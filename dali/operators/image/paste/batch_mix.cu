@@ -0,0 +1,373 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/geom/vec.h"
+#include "dali/core/math_util.h"
+#include "dali/core/philox.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/imgproc/sampler.h"
+#include "dali/kernels/imgproc/surface.h"
+#include "dali/operators/util/philox_dist.h"
+#include "dali/pipeline/operator/common.h"
+#include "dali/pipeline/operator/operator.h"
+
+#define BATCH_MIX_TYPES (uint8_t, int16_t, float)
+
+namespace dali {
+
+DALI_SCHEMA(experimental__BatchMix)
+  .DocStr(R"code(Mixes the samples of a batch with the CutMix or the mosaic augmentation and blends
+their labels accordingly.
+
+With ``mode="cutmix"``, a rectangular region of the image is replaced with the corresponding
+region of another, randomly selected, sample of the batch. The area of the region, relative to
+the area of the image, is drawn uniformly from ``area_range`` and its center is drawn uniformly
+from the whole image.
+
+With ``mode="mosaic"``, the image is split into four tiles at a random point, drawn uniformly
+from ``center_range`` (relative to the image size). The top-left tile is filled with the image
+itself and the other ones with other, randomly selected, samples of the batch.
+
+The source regions are scaled to the destination regions with the linear interpolation,
+so the samples can have different sizes. The output images have the sizes of the input ones.
+
+The optional second input contains the labels, e.g. one-hot vectors, which are blended with
+the weights equal to the fraction of the output image covered by each of the sources.
+
+The mixing parameters are generated on the GPU and the whole batch, together with the labels,
+is processed with a single kernel launch.
+
+This operator is supported only on the GPU.)code")
+  .Nondeterministic()
+  .NumInput(1, 2)
+  .InputDox(0, "images", "TensorList", "A batch of *HWC* images.")
+  .InputDox(1, "labels", "TensorList", R"code(Float label vectors.
+
+All the samples must have the same number of elements.)code")
+  .OutputFn([](const OpSpec &spec) {
+    return spec.NumRegularInput();
+  })
+  .AddOptionalArg("mode",
+      R"code(The kind of mixing - ``"cutmix"`` or ``"mosaic"``.)code",
+      "cutmix")
+  .AddOptionalArg("probability",
+      R"code(The probability of mixing a sample.
+
+The samples which are not mixed are passed unchanged.)code",
+      1.0f, true)
+  .AddOptionalArg("area_range",
+      R"code(The range of the relative area of the region pasted with ``mode="cutmix"``.)code",
+      std::vector<float>{0.0f, 1.0f})
+  .AddOptionalArg("center_range",
+      R"code(The range of the relative coordinates of the point at which the image is split
+with ``mode="mosaic"``.)code",
+      std::vector<float>{0.25f, 0.75f});
+
+namespace batch_mix {
+
+constexpr int kMaxTiles = 4;
+
+template <typename T>
+struct SampleDesc {
+  T *out;
+  const T *in;
+  float *out_label;
+  const float *in_label;
+  ivec2 size;
+  uint64_t key;
+  float probability;
+};
+
+struct MixArgs {
+  bool mosaic;
+  int channels;
+  int num_classes;
+  vec2 area_range;
+  vec2 center_range;
+};
+
+/**
+ * @brief A region of the output, filled with a scaled region of the sample `src`
+ *
+ * Later tiles are drawn over the earlier ones.
+ */
+struct Tile {
+  ivec2 lo, hi;
+  int src;
+  bool identity;
+  /// The source coordinates corresponding to `lo`
+  vec2 src_lo;
+  /// The source extent of one output pixel
+  vec2 scale;
+};
+
+struct MixLayout {
+  Tile tiles[kMaxTiles];
+  float weights[kMaxTiles];
+  int ntiles;
+};
+
+__device__ DALI_FORCEINLINE float uniform(Philox4x32_10 &rng, vec2 range) {
+  return range[0] + philox_uniform01<float>(rng) * (range[1] - range[0]);
+}
+
+/**
+ * @brief Draws the mixing parameters of the sample `idx`
+ *
+ * The parameters depend only on the key of the sample, so they can be computed in any block.
+ */
+template <typename T>
+__device__ void GetLayout(MixLayout &layout, const SampleDesc<T> *samples, int nsamples, int idx,
+                          const MixArgs &args) {
+  ivec2 size = samples[idx].size;
+  Philox4x32_10 rng(samples[idx].key, 0);
+  auto &tile0 = layout.tiles[0];
+  tile0.lo = ivec2(0);
+  tile0.hi = size;
+  tile0.src = idx;
+  tile0.identity = true;
+  tile0.src_lo = vec2(0);
+  tile0.scale = vec2(1);
+  layout.ntiles = 1;
+  if (nsamples > 1 && philox_bernoulli_dist(samples[idx].probability)(rng)) {
+    // another sample of the batch, drawn uniformly
+    auto partner = [&]() {
+      uint32_t r = (static_cast<uint64_t>(rng()) * (nsamples - 1)) >> 32;
+      return static_cast<int>((idx + 1 + r) % nsamples);
+    };
+    if (args.mosaic) {
+      vec2 rel;
+      rel.x = uniform(rng, args.center_range);
+      rel.y = uniform(rng, args.center_range);
+      ivec2 split = clamp(round_int(vec2(size) * rel), ivec2(0), size);
+      for (int k = 0; k < 4; k++) {
+        auto &tile = layout.tiles[k];
+        tile.lo = ivec2(k & 1 ? split.x : 0, k & 2 ? split.y : 0);
+        tile.hi = ivec2(k & 1 ? size.x : split.x, k & 2 ? size.y : split.y);
+        tile.src = k == 0 ? idx : partner();
+        tile.identity = false;
+        tile.src_lo = vec2(0);
+        ivec2 extent = tile.hi - tile.lo;
+        tile.scale = vec2(samples[tile.src].size) / vec2(max(extent, ivec2(1)));
+      }
+      layout.ntiles = 4;
+    } else {
+      vec2 box = vec2(size) * sqrtf(uniform(rng, args.area_range));
+      vec2 center;
+      center.x = philox_uniform01<float>(rng) * size.x;
+      center.y = philox_uniform01<float>(rng) * size.y;
+      auto &tile = layout.tiles[1];
+      tile.lo = clamp(round_int(center - box * 0.5f), ivec2(0), size);
+      tile.hi = clamp(round_int(center + box * 0.5f), ivec2(0), size);
+      tile.src = partner();
+      tile.identity = false;
+      tile.scale = vec2(samples[tile.src].size) / vec2(max(size, ivec2(1)));
+      tile.src_lo = vec2(tile.lo) * tile.scale;
+      layout.ntiles = 2;
+    }
+  }
+
+  // The tiles except the first one don't overlap, so the first one covers the rest of the image
+  float total = static_cast<float>(size.x) * size.y;
+  float rest = 1;
+  for (int t = 1; t < layout.ntiles; t++) {
+    ivec2 extent = layout.tiles[t].hi - layout.tiles[t].lo;
+    layout.weights[t] = total > 0 ? static_cast<float>(extent.x) * extent.y / total : 0;
+    rest -= layout.weights[t];
+  }
+  layout.weights[0] = rest;
+}
+
+/**
+ * @brief Mixes the images and the labels of the whole batch
+ *
+ * The block layer z processes the sample z.
+ */
+template <typename T>
+__global__ void BatchMixKernel(const SampleDesc<T> *samples, int nsamples, MixArgs args) {
+  __shared__ MixLayout layout;
+  int idx = blockIdx.z;
+  if (threadIdx.x == 0 && threadIdx.y == 0)
+    GetLayout(layout, samples, nsamples, idx, args);
+  __syncthreads();
+
+  const auto &sample = samples[idx];
+  if (blockIdx.x == 0 && blockIdx.y == 0 && sample.out_label) {
+    for (int c = threadIdx.y * blockDim.x + threadIdx.x; c < args.num_classes;
+         c += blockDim.x * blockDim.y) {
+      float label = 0;
+      for (int t = 0; t < layout.ntiles; t++)
+        label += layout.weights[t] * samples[layout.tiles[t].src].in_label[c];
+      sample.out_label[c] = label;
+    }
+  }
+
+  ivec2 size = sample.size;
+  int channels = args.channels;
+  for (int y = blockIdx.y * blockDim.y + threadIdx.y; y < size.y; y += gridDim.y * blockDim.y) {
+    for (int x = blockIdx.x * blockDim.x + threadIdx.x; x < size.x;
+         x += gridDim.x * blockDim.x) {
+      int t = layout.ntiles - 1;
+      while (t > 0 && !kernels::all_in_range(ivec2(x, y) - layout.tiles[t].lo,
+                                    layout.tiles[t].hi - layout.tiles[t].lo))
+        t--;
+      const auto &tile = layout.tiles[t];
+      int64_t offset = (static_cast<int64_t>(y) * size.x + x) * channels;
+      T *out = sample.out + offset;
+      if (tile.identity) {
+        for (int c = 0; c < channels; c++)
+          out[c] = sample.in[offset + c];
+      } else {
+        const auto &src = samples[tile.src];
+        kernels::Surface2D<const T> surface(src.in, src.size.x, src.size.y, channels,
+                                   channels, static_cast<int64_t>(src.size.x) * channels, 1);
+        vec2 pos = tile.src_lo + (vec2(x, y) + 0.5f - vec2(tile.lo)) * tile.scale;
+        kernels::make_sampler<DALI_INTERP_LINEAR>(surface)(out, pos, kernels::BorderClamp());
+      }
+    }
+  }
+}
+
+}  // namespace batch_mix
+
+class BatchMixGPU : public Operator<GPUBackend> {
+ public:
+  explicit BatchMixGPU(const OpSpec &spec);
+
+  bool CanInferOutputs() const override { return true; }
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) override;
+  void RunImpl(DeviceWorkspace &ws) override;
+
+ private:
+  static vec2 GetRange(const OpSpec &spec, const char *name);
+
+  template <typename T>
+  void RunTyped(DeviceWorkspace &ws);
+
+  batch_mix::MixArgs args_;
+  std::vector<float> probability_;
+  uint64_t seed_;
+  int64_t iteration_ = 0;
+};
+
+BatchMixGPU::BatchMixGPU(const OpSpec &spec)
+    : Operator<GPUBackend>(spec), seed_(spec.GetArgument<int64_t>("seed")) {
+  auto mode = spec.GetArgument<std::string>("mode");
+  DALI_ENFORCE(mode == "cutmix" || mode == "mosaic",
+               make_string("Unknown mode: \"", mode,
+                           "\". Supported modes are: cutmix and mosaic."));
+  args_.mosaic = mode == "mosaic";
+  args_.area_range = GetRange(spec, "area_range");
+  args_.center_range = GetRange(spec, "center_range");
+}
+
+vec2 BatchMixGPU::GetRange(const OpSpec &spec, const char *name) {
+  auto range = spec.GetRepeatedArgument<float>(name);
+  DALI_ENFORCE(range.size() == 2 && 0 <= range[0] && range[0] <= range[1] && range[1] <= 1,
+               make_string("``", name, "`` must be a range [lo, hi], with 0 <= lo <= hi <= 1."));
+  return vec2(range[0], range[1]);
+}
+
+bool BatchMixGPU::SetupImpl(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) {
+  const auto &images = ws.Input<GPUBackend>(0);
+  int nsamples = images.num_samples();
+  DALI_ENFORCE(images.sample_dim() == 3,
+               make_string("The images must be 3D tensors with the HWC layout. Got a ",
+                           images.sample_dim(), "D input."));
+  args_.channels = nsamples > 0 ? images.tensor_shape_span(0)[2] : 0;
+  for (int i = 0; i < nsamples; i++) {
+    DALI_ENFORCE(images.tensor_shape_span(i)[2] == args_.channels,
+                 make_string("All the images must have the same number of channels. Got ",
+                             args_.channels, " and ", images.tensor_shape_span(i)[2], "."));
+  }
+  GetPerSampleArgument(probability_, "probability", ws, nsamples);
+  for (float p : probability_)
+    DALI_ENFORCE(0 <= p && p <= 1,
+                 make_string("The probability must be in the range [0, 1], got ", p, "."));
+
+  output_desc.resize(ws.NumInput());
+  output_desc[0] = {images.shape(), images.type()};
+  args_.num_classes = 0;
+  if (ws.NumInput() > 1) {
+    const auto &labels = ws.Input<GPUBackend>(1);
+    DALI_ENFORCE(labels.num_samples() == nsamples,
+                 "The images and the labels must have the same number of samples.");
+    DALI_ENFORCE(labels.type() == DALI_FLOAT,
+                 make_string("The labels must be float, got ", labels.type(), "."));
+    args_.num_classes = nsamples > 0 ? volume(labels.tensor_shape_span(0)) : 0;
+    for (int i = 0; i < nsamples; i++) {
+      DALI_ENFORCE(volume(labels.tensor_shape_span(i)) == args_.num_classes,
+                   "All the label vectors must have the same number of elements.");
+    }
+    output_desc[1] = {labels.shape(), labels.type()};
+  }
+  return true;
+}
+
+template <typename T>
+void BatchMixGPU::RunTyped(DeviceWorkspace &ws) {
+  const auto &images = ws.Input<GPUBackend>(0);
+  auto &out_images = ws.Output<GPUBackend>(0);
+  out_images.SetLayout(images.GetLayout());
+  int nsamples = images.num_samples();
+  bool has_labels = ws.NumInput() > 1;
+  int64_t iteration = iteration_++;
+  if (nsamples == 0)
+    return;
+
+  std::vector<batch_mix::SampleDesc<T>> samples(nsamples);
+  ivec2 max_size(0);
+  for (int i = 0; i < nsamples; i++) {
+    auto &sample = samples[i];
+    auto sh = images.tensor_shape_span(i);
+    sample.out = out_images.mutable_tensor<T>(i);
+    sample.in = images.tensor<T>(i);
+    sample.out_label = has_labels ? ws.Output<GPUBackend>(1).mutable_tensor<float>(i) : nullptr;
+    sample.in_label = has_labels ? ws.Input<GPUBackend>(1).tensor<float>(i) : nullptr;
+    sample.size = ivec2(sh[1], sh[0]);
+    sample.key = splitmix64(splitmix64(splitmix64(seed_) + iteration) + i);
+    sample.probability = probability_[i];
+    max_size = max(max_size, sample.size);
+  }
+  if (has_labels)
+    ws.Output<GPUBackend>(1).SetLayout(ws.Input<GPUBackend>(1).GetLayout());
+
+  auto stream = ws.stream();
+  kernels::DynamicScratchpad scratch({}, AccessOrder(stream));
+  auto *samples_gpu = scratch.ToGPU(stream, samples);
+  dim3 block(32, 8);
+  dim3 grid(std::min(div_ceil(std::max(max_size.x, 1), 32), 32),
+            std::min(div_ceil(std::max(max_size.y, 1), 8), 64), nsamples);
+  batch_mix::BatchMixKernel<<<grid, block, 0, stream>>>(samples_gpu, nsamples, args_);
+  CUDA_CALL(cudaGetLastError());
+}
+
+void BatchMixGPU::RunImpl(DeviceWorkspace &ws) {
+  const auto &images = ws.Input<GPUBackend>(0);
+  TYPE_SWITCH(images.type(), type2id, T, BATCH_MIX_TYPES, (
+    RunTyped<T>(ws);
+  ), DALI_FAIL(make_string("Unsupported image type: ", images.type())));  // NOLINT
+}
+
+DALI_REGISTER_OPERATOR(experimental__BatchMix, BatchMixGPU, GPU);
+
+}  // namespace dali
@@ -0,0 +1,133 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <vector>
+#include "dali/operators/image/paste/pack_images.h"
+
+namespace dali {
+
+DALI_SCHEMA(experimental__PackImages)
+  .DocStr(R"code(Packs a batch of images of different sizes into a small number of canvases of
+a fixed size.
+
+Instead of padding every image to the size of the largest one, the images are placed side by
+side, without overlapping, on canvases of ``canvas_size``. The placement is computed on the host,
+from the shapes only, with first-fit decreasing height shelf packing: the images, sorted by
+height, are put in rows (shelves) of the canvases, opening a new shelf or a new canvas when an
+image doesn't fit in any of the existing ones. The area of the canvases not covered by any image
+is filled with zeros.
+
+The operator has two outputs:
+
+* The canvases. The batch size is the same as that of the input: the first ``num_canvases``
+  samples are the canvases, of shape ``(height, width, channels)``, and the remaining samples
+  are empty, with the shape ``(0, 0, channels)``.
+* The placement of each input image, as ``[canvas_idx, y, x, height, width]``, where
+  ``canvas_idx`` is the index of the canvas (output sample) and ``y, x`` are the coordinates of
+  the top-left corner of the image within the canvas. Empty images are not placed and have
+  ``canvas_idx`` equal to -1.
+
+The placement can be used to crop the processed images back from the canvases.)code")
+  .NumInput(1)
+  .InputDox(0, "images", "TensorList", "Images in HWC layout, with the same number of channels.")
+  .InputLayout(0, "HWC")
+  .NumOutput(2)
+  .AddArg("canvas_size",
+      R"code(Height and width of the canvases.
+
+Every image must fit in the canvas.)code",
+      DALI_INT_VEC);
+
+int PackOnCanvases(span<CanvasPlacement> placements, span<const ivec2> sizes,
+                   ivec2 canvas_size) {
+  assert(placements.size() == sizes.size());
+  struct Shelf {
+    int canvas_idx, y, height, used_width;
+  };
+  std::vector<int> order(sizes.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return sizes[a][0] != sizes[b][0] ? sizes[a][0] > sizes[b][0] : sizes[a][1] > sizes[b][1];
+  });
+
+  std::vector<Shelf> shelves;
+  std::vector<int> used_height;  // per canvas
+  for (int i : order) {
+    ivec2 size = sizes[i];
+    auto &placement = placements[i];
+    assert(size[0] <= canvas_size[0] && size[1] <= canvas_size[1]);
+    if (size[0] == 0 || size[1] == 0) {
+      placement.canvas_idx = -1;
+      placement.origin = {};
+      continue;
+    }
+    // the shelves are at least as high as the image, as the images are sorted by height
+    auto shelf = std::find_if(shelves.begin(), shelves.end(), [&](const Shelf &s) {
+      return s.used_width + size[1] <= canvas_size[1];
+    });
+    if (shelf == shelves.end()) {
+      int canvas = 0;
+      while (canvas < static_cast<int>(used_height.size()) &&
+             used_height[canvas] + size[0] > canvas_size[0])
+        canvas++;
+      if (canvas == static_cast<int>(used_height.size()))
+        used_height.push_back(0);
+      shelves.push_back({ canvas, used_height[canvas], size[0], 0 });
+      used_height[canvas] += size[0];
+      shelf = shelves.end() - 1;
+    }
+    placement.canvas_idx = shelf->canvas_idx;
+    placement.origin = { shelf->y, shelf->used_width };
+    shelf->used_width += size[1];
+  }
+  return used_height.size();
+}
+
+template <>
+void PackImages<CPUBackend>::RunImpl(HostWorkspace &ws) {
+  const auto &input = ws.Input<CPUBackend>(0);
+  auto &canvases = ws.Output<CPUBackend>(0);
+  auto &placements = ws.Output<CPUBackend>(1);
+  canvases.SetLayout(input.GetLayout());
+  StorePlacements(view<int32_t, 1>(placements));
+
+  auto &tp = ws.GetThreadPool();
+  int64_t pixel_size = channels_ * input.type_info().size();
+  int64_t canvas_pitch = canvas_size_[1] * pixel_size;
+  int64_t canvas_bytes = canvas_size_[0] * canvas_pitch;
+  for (int c = 0; c < num_canvases_; c++) {
+    tp.AddWork([&, c](int thread_id) {
+      auto *canvas = static_cast<uint8_t *>(canvases.raw_mutable_tensor(c));
+      std::memset(canvas, 0, canvas_bytes);
+      for (size_t i = 0; i < placements_.size(); i++) {
+        if (placements_[i].canvas_idx != c)
+          continue;
+        auto *in = static_cast<const uint8_t *>(input.raw_tensor(i));
+        int64_t row_bytes = sizes_[i][1] * pixel_size;
+        uint8_t *out = canvas + placements_[i].origin[0] * canvas_pitch +
+                       placements_[i].origin[1] * pixel_size;
+        for (int y = 0; y < sizes_[i][0]; y++, in += row_bytes, out += canvas_pitch)
+          std::memcpy(out, in, row_bytes);
+      }
+    }, canvas_bytes);
+  }
+  tp.RunAll();
+}
+
+DALI_REGISTER_OPERATOR(experimental__PackImages, PackImages<CPUBackend>, CPU);
+
+}  // namespace dali
@@ -0,0 +1,72 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/core/static_switch.h"
+#include "dali/kernels/imgproc/paste/paste_gpu.h"
+#include "dali/operators/image/paste/pack_images.h"
+
+namespace dali {
+
+template <>
+void PackImages<GPUBackend>::RunImpl(DeviceWorkspace &ws) {
+  const auto &input = ws.Input<GPUBackend>(0);
+  auto &canvases = ws.Output<GPUBackend>(0);
+  auto &placements = ws.Output<GPUBackend>(1);
+  canvases.SetLayout(input.GetLayout());
+
+  if (!placements_staging_.has_data())
+    placements_staging_.set_pinned(true);
+  placements_staging_.Resize(placements.shape(), DALI_INT32);
+  StorePlacements(view<int32_t, 1>(placements_staging_));
+  placements.Copy(placements_staging_, ws.stream());
+
+  if (num_canvases_ == 0)
+    return;
+
+  canvases_.resize(num_canvases_);
+  for (auto &canvas : canvases_) {
+    canvas.inputs.clear();
+    canvas.out_size = canvas_size_;
+    canvas.channels = channels_;
+  }
+  for (int i = 0; i < static_cast<int>(placements_.size()); i++) {
+    int c = placements_[i].canvas_idx;
+    if (c < 0)
+      continue;
+    kernels::paste::MultiPasteSampleInput<2>::InputPatch patch;
+    patch.out_anchor = placements_[i].origin;
+    patch.in_anchor = {};
+    patch.size = sizes_[i];
+    patch.in_idx = i;
+    canvases_[c].inputs.push_back(patch);
+  }
+
+  kernels::KernelContext ctx;
+  ctx.gpu.stream = ws.stream();
+  TYPE_SWITCH(input.type(), type2id, T, (PACK_IMAGES_GPU_TYPES), (
+    using Kernel = kernels::PasteGPU<T, T, 3>;
+    auto in_view = view<const T, 3>(input);
+    auto out_view = view<T, 3>(canvases);
+    // only the canvases - the trailing empty samples have nothing to paste
+    out_view.resize(num_canvases_);
+    kmgr_.Resize<Kernel>(1);
+    kmgr_.Setup<Kernel>(0, ctx, make_span(canvases_), out_view.shape, in_view.shape);
+    kmgr_.Run<Kernel>(0, ctx, out_view, in_view);
+  ), DALI_FAIL(make_string("Unsupported input type: ", input.type(),  // NOLINT
+                           "\nSupported types: ", ListTypeNames<PACK_IMAGES_GPU_TYPES>())));
+}
+
+DALI_REGISTER_OPERATOR(experimental__PackImages, PackImages<GPUBackend>, GPU);
+
+}  // namespace dali
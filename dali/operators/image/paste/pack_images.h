@@ -0,0 +1,137 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_IMAGE_PASTE_PACK_IMAGES_H_
+#define DALI_OPERATORS_IMAGE_PASTE_PACK_IMAGES_H_
+
+#include <vector>
+#include "dali/core/geom/vec.h"
+#include "dali/core/span.h"
+#include "dali/kernels/imgproc/paste/paste_gpu_input.h"
+#include "dali/kernels/kernel_manager.h"
+#include "dali/pipeline/data/views.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+#define PACK_IMAGES_GPU_TYPES uint8_t, int16_t, int32_t, float
+
+/**
+ * @brief The position of an image on a canvas
+ */
+struct CanvasPlacement {
+  /** @brief Index of the canvas or -1 for an empty image, which is not placed at all */
+  int canvas_idx = -1;
+  /** @brief Top-left corner of the image within the canvas, (y, x) */
+  ivec2 origin;
+};
+
+/**
+ * @brief Places the rectangles of given sizes, without overlapping, on canvases
+ *
+ * Uses first-fit decreasing height shelf packing: the rectangles, sorted by height, are placed
+ * in the first row (shelf) of any canvas that has room for them; a new shelf is opened below
+ * the last one of the first canvas with enough space left and, if there's none, a new canvas
+ * is started.
+ *
+ * @param placements  output placements, one per rectangle
+ * @param sizes       sizes of the rectangles, (height, width); each must fit in the canvas
+ * @param canvas_size (height, width) of the canvases
+ * @return the number of canvases used
+ */
+DLL_PUBLIC int PackOnCanvases(span<CanvasPlacement> placements, span<const ivec2> sizes,
+                              ivec2 canvas_size);
+
+template <typename Backend>
+class PackImages : public Operator<Backend> {
+ public:
+  explicit PackImages(const OpSpec &spec) : Operator<Backend>(spec) {
+    auto canvas_size = spec.GetRepeatedArgument<int>("canvas_size");
+    DALI_ENFORCE(canvas_size.size() == 2 && canvas_size[0] > 0 && canvas_size[1] > 0,
+                 "``canvas_size`` must consist of two positive values: height and width.");
+    canvas_size_ = { canvas_size[0], canvas_size[1] };
+  }
+
+ protected:
+  USE_OPERATOR_MEMBERS();
+  using Operator<Backend>::RunImpl;
+
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override {
+    const auto &input = ws.template Input<Backend>(0);
+    const auto &in_shape = input.shape();
+    DALI_ENFORCE(in_shape.sample_dim() == 3,
+                 "PackImages expects images with channels (HWC layout).");
+    int nsamples = in_shape.num_samples();
+    channels_ = nsamples > 0 ? static_cast<int>(in_shape.tensor_shape_span(0)[2]) : 0;
+    sizes_.resize(nsamples);
+    for (int i = 0; i < nsamples; i++) {
+      auto sh = in_shape.tensor_shape_span(i);
+      DALI_ENFORCE(sh[2] == channels_, make_string("All the images must have the same number "
+                   "of channels. Got ", sh[2], " channels in sample ", i, " and ", channels_,
+                   " in sample 0."));
+      DALI_ENFORCE(sh[0] <= canvas_size_[0] && sh[1] <= canvas_size_[1], make_string(
+                   "The image ", i, " of size ", sh[0], "x", sh[1], " doesn't fit in the canvas "
+                   "of size ", canvas_size_[0], "x", canvas_size_[1], "."));
+      sizes_[i] = { static_cast<int>(sh[0]), static_cast<int>(sh[1]) };
+    }
+    placements_.resize(nsamples);
+    num_canvases_ = PackOnCanvases(make_span(placements_), make_cspan(sizes_), canvas_size_);
+
+    output_desc.resize(2);
+    output_desc[0].type = input.type();
+    // the batch size doesn't change - the samples beyond the last canvas are empty
+    output_desc[0].shape.resize(nsamples, 3);
+    TensorShape<3> canvas_shape(canvas_size_[0], canvas_size_[1], channels_);
+    TensorShape<3> empty_shape(0, 0, channels_);
+    for (int i = 0; i < nsamples; i++)
+      output_desc[0].shape.set_tensor_shape(i, i < num_canvases_ ? canvas_shape : empty_shape);
+    output_desc[1].type = DALI_INT32;
+    output_desc[1].shape = uniform_list_shape(nsamples, {5});
+    return true;
+  }
+
+  void RunImpl(workspace_t<Backend> &ws) override;
+
+  /**
+   * @brief Writes the placements as [canvas_idx, y, x, height, width]
+   */
+  void StorePlacements(const TensorListView<StorageCPU, int32_t, 1> &out) const {
+    for (int i = 0; i < out.num_samples(); i++) {
+      int32_t *p = out.data[i];
+      p[0] = placements_[i].canvas_idx;
+      p[1] = placements_[i].origin[0];
+      p[2] = placements_[i].origin[1];
+      p[3] = sizes_[i][0];
+      p[4] = sizes_[i][1];
+    }
+  }
+
+  ivec2 canvas_size_;
+  int channels_ = 0;
+  int num_canvases_ = 0;
+  std::vector<ivec2> sizes_;
+  std::vector<CanvasPlacement> placements_;
+
+  kernels::KernelManager kmgr_;
+  std::vector<kernels::paste::MultiPasteSampleInput<2>> canvases_;
+  TensorList<CPUBackend> placements_staging_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_IMAGE_PASTE_PACK_IMAGES_H_
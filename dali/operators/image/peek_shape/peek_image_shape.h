@@ -81,10 +81,17 @@ class PeekImageShape : public Operator<CPUBackend> {
 
     for (size_t sample_id = 0; sample_id < batch_size; ++sample_id) {
       thread_pool.AddWork([sample_id, &input, &output, this] (int tid) {
-        const auto& image = input[sample_id];
-        auto img =
-            ImageFactory::CreateImage(image.data<uint8>(), image.shape().num_elements(), {});
-        auto shape = img->PeekShape();
+        TensorShape<3> shape;
+        // the reader may have parsed the header already
+        auto &meta = input.GetMeta(sample_id);
+        if (meta.HasImageInfo() && meta.GetImageInfo().shape.sample_dim() == 3) {
+          shape = meta.GetImageInfo().shape.to_static<3>();
+        } else {
+          const auto& image = input[sample_id];
+          auto img =
+              ImageFactory::CreateImage(image.data<uint8>(), image.shape().num_elements(), {});
+          shape = img->PeekShape();
+        }
         TYPE_SWITCH(output_type_, type2id, type,
                 (int32_t, uint32_t, int64_t, uint64_t, float, double),
           (WriteShape(view<type, 1>(output[sample_id]), shape);),
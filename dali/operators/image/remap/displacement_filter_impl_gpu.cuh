@@ -19,8 +19,12 @@
 #include <vector>
 
 #include "dali/core/common.h"
+#include "dali/core/convert.h"
 #include "dali/core/dev_buffer.h"
+#include "dali/core/float16.h"
+#include "dali/core/force_inline.h"
 #include "dali/core/host_dev.h"
+#include "dali/core/math_util.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/kernels/common/block_setup.h"
 #include "dali/kernels/imgproc/sampler.h"
@@ -35,26 +39,81 @@ struct DisplacementSampleDesc {
   bool mask;
 };
 
+namespace detail {
+
+/**
+ * @brief Loads a value through the read-only data cache and converts it to float
+ */
+template <typename T>
+__device__ DALI_FORCEINLINE float LoadReadOnly(const T *ptr) {
+  return __ldg(ptr);
+}
+
+__device__ DALI_FORCEINLINE float LoadReadOnly(const float16 *ptr) {
+  return __half2float(__ldg(reinterpret_cast<const __half *>(ptr)));
+}
+
+}  // namespace detail
+
+/**
+ * @brief Samples an interleaved (HWC) image for the displacement filters
+ *
+ * Computes the same values as kernels::Sampler2D with a constant border, but the pixels
+ * are read through the read-only data cache and the interpolation is always done in float,
+ * which also covers float16 images.
+ */
+template <DALIInterpType interp_type, typename T>
+struct DisplacementSampler {
+  const T *__restrict__ data;
+  int H, W, C;
+  float fill_value;
+
+  __device__ DALI_FORCEINLINE float pixel(int x, int y, int c) const {
+    if (static_cast<unsigned>(x) < static_cast<unsigned>(W) &&
+        static_cast<unsigned>(y) < static_cast<unsigned>(H))
+      return detail::LoadReadOnly(data + (static_cast<int64_t>(y) * W + x) * C + c);
+    return fill_value;
+  }
+
+  __device__ DALI_FORCEINLINE float at(ivec2 pos, int c) const {
+    return pixel(pos.x, pos.y, c);
+  }
+
+  __device__ DALI_FORCEINLINE float at(vec2 pos, int c) const {
+    if (interp_type == DALI_INTERP_NN)
+      return pixel(floor_int(pos.x), floor_int(pos.y), c);
+    float x = pos.x - 0.5f;
+    float y = pos.y - 0.5f;
+    int x0 = floor_int(x);
+    int y0 = floor_int(y);
+    float qx = x - x0;
+    float px = 1 - qx;
+    float qy = y - y0;
+    float s0 = pixel(x0, y0, c) * px + pixel(x0 + 1, y0, c) * qx;
+    float s1 = pixel(x0, y0 + 1, c) * px + pixel(x0 + 1, y0 + 1, c) * qx;
+    return s0 + (s1 - s0) * qy;
+  }
+};
+
 template <typename T, class Displacement, DALIInterpType interp_type>
 __device__ inline T GetPixelValueSingleC(int h, int w, int c,
                                          int H, int W, int C,
-                                         const T * input,
+                                         const T *__restrict__ input,
                                          Displacement& displace, const T fill_value) {
-  kernels::Surface2D<const T> in_surface = { input, W, H, C, C, C*W, 1 };
-  auto sampler = kernels::make_sampler<interp_type>(in_surface);
+  DisplacementSampler<interp_type, T> sampler = { input, H, W, C, static_cast<float>(fill_value) };
   auto p = displace(h, w, c, H, W, C);
-  return sampler.template at<T>(p, c, fill_value);
+  return ConvertSat<T>(sampler.at(p, c));
 }
 
 template <typename T, class Displacement, DALIInterpType interp_type>
 __device__ inline void GetPixelValueMultiC(int h, int w,
                                            int H, int W, int C,
-                                           const T * input, T * output,
+                                           const T *__restrict__ input, T *output,
                                            Displacement& displace, const T fill_value) {
-  kernels::Surface2D<const T> in_surface = { input, W, H, C, C, C*W, 1 };
-  auto sampler = kernels::make_sampler<interp_type>(in_surface);
+  DisplacementSampler<interp_type, T> sampler = { input, H, W, C, static_cast<float>(fill_value) };
   auto p = displace(h, w, 0, H, W, C);
-  sampler(output, p, fill_value);
+  for (int c = 0; c < C; c++)
+    output[c] = ConvertSat<T>(sampler.at(p, c));
 }
 
 template <class Displacement, bool has_param = HasParam<Displacement>::value>
@@ -78,7 +137,7 @@ __global__ void DisplacementKernel(const DisplacementSampleDesc *samples,
   const auto &sample = samples[block.sample_idx];
 
   auto *image_out = static_cast<T *>(sample.output);
-  const auto *image_in = static_cast<const T *>(sample.input);
+  const T *__restrict__ image_in = static_cast<const T *>(sample.input);
 
   const int H = sample.shape[0];
   const int W = sample.shape[1];
@@ -122,7 +181,7 @@ void DisplacementKernel_aligned32bit(
   const auto &sample = samples[block.sample_idx];
 
   auto *image_out = reinterpret_cast<uint32_t *>(sample.output);
-  const auto *image_in = reinterpret_cast<const T *>(sample.input);
+  const T *__restrict__ image_in = reinterpret_cast<const T *>(sample.input);
 
   const int H = sample.shape[0];
   const int W = sample.shape[1];
@@ -260,6 +319,8 @@ class DisplacementFilter<GPUBackend, Displacement,
 
     if (IsType<float>(input.type())) {
       BatchedGPUKernel<float>(ws);
+    } else if (IsType<float16>(input.type())) {
+      BatchedGPUKernel<float16>(ws);
     } else if (IsType<uint8_t>(input.type())) {
       BatchedGPUKernel<uint8_t>(ws);
     } else {
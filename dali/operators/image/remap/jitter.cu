@@ -23,6 +23,7 @@ DALI_SCHEMA(Jitter)
 
 The output images are produced by moving each pixel by a random amount, in the x and y dimensions,
 and bounded by half of the ``nDegree`` parameter.)code")
+  .Nondeterministic()
   .NumInput(1)
   .NumOutput(1)
   .AddOptionalArg("nDegree",
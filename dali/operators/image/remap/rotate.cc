@@ -17,8 +17,14 @@
 namespace dali {
 
 DALI_SCHEMA(Rotate)
-  .DocStr(R"code(Rotates the images by the specified angle.)code")
-  .NumInput(1)
+  .DocStr(R"code(Rotates the images by the specified angle.
+
+The angle can be also passed as the second input, with one value per sample. For the GPU
+operator, this input can reside in GPU memory (for example, be produced by another GPU operator):
+the rotations are then calculated on the device, without copying the angles to the host, which
+removes the synchronization between the operators. In that case, the output size cannot depend
+on the angle, so ``size`` must be given or ``keep_size`` set to True.)code")
+  .NumInput(1, 2)
   .NumOutput(1)
   .InputLayout(0, { "HWC", "FHWC", "DHWC", "FDHWC"})
   .SupportVolumetric()
@@ -29,11 +35,13 @@ The vector does not need to be normalized, but it must have a non-zero length.
 Reversing the vector is equivalent to changing the sign of ``angle``.
 )code",
   std::vector<float>(), true, true)
-  .AddArg("angle", R"code(Angle, in degrees, by which the image is rotated.
+  .AddOptionalArg<float>("angle", R"code(Angle, in degrees, by which the image is rotated.
 
 For two-dimensional data, the rotation is counter-clockwise, assuming the top-left corner is
 at ``(0,0)``. For three-dimensional data, the ``angle`` is a positive rotation around the provided
-axis.)code", DALI_FLOAT, true, true)
+axis.
+
+It must be provided, unless the angle is passed as the second input.)code", nullptr, true, true)
   .AddOptionalArg("keep_size", R"code(If True, original canvas size is kept.
 
 If set to False (default), and the size is not set, the canvas size is adjusted to
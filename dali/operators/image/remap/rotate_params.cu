@@ -0,0 +1,65 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cuda_runtime.h>
+#include <algorithm>
+#include "dali/core/geom/transform.h"
+#include "dali/core/math_util.h"
+#include "dali/operators/image/remap/rotate_params.h"
+
+namespace dali {
+namespace {
+
+// The same destination-to-source mappings as in RotateParamProvider::AdjustParams; there,
+// the 2D angles are negated beforehand (in SetParams).
+
+__device__ RotateParams<2> CalcRotateParams(const RotateDeviceParamsDesc<2> &desc) {
+  float a = deg2rad(*desc.angle);
+  mat3 M = translation(desc.in_center) * rotation2D(a) * translation(-desc.out_center);
+  return sub<2, 3>(M);
+}
+
+__device__ RotateParams<3> CalcRotateParams(const RotateDeviceParamsDesc<3> &desc) {
+  float a = deg2rad(*desc.angle);
+  mat4 M = translation(desc.in_center) * rotation3D(desc.axis, -a) *
+           translation(-desc.out_center);
+  return sub<3, 4>(M);
+}
+
+template <int ndims>
+__global__ void RotateParamsKernel(RotateParams<ndims> *output,
+                                   const RotateDeviceParamsDesc<ndims> *descs, int count) {
+  for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < count; i += blockDim.x * gridDim.x)
+    output[i] = CalcRotateParams(descs[i]);
+}
+
+}  // namespace
+
+template <int spatial_ndim>
+void RotateParamsGPU(RotateParams<spatial_ndim> *output,
+                     const RotateDeviceParamsDesc<spatial_ndim> *descs, int count,
+                     cudaStream_t stream) {
+  if (count == 0)
+    return;
+  int blocks = div_ceil(count, 512);
+  int threads = std::min(count, 512);
+  RotateParamsKernel<spatial_ndim><<<blocks, threads, 0, stream>>>(output, descs, count);
+}
+
+template void RotateParamsGPU<2>(RotateParams<2> *, const RotateDeviceParamsDesc<2> *, int,
+                                 cudaStream_t);
+template void RotateParamsGPU<3>(RotateParams<3> *, const RotateDeviceParamsDesc<3> *, int,
+                                 cudaStream_t);
+
+}  // namespace dali
@@ -20,6 +20,7 @@
 #include <tuple>
 #include <type_traits>
 #include <vector>
+#include "dali/core/dev_buffer.h"
 #include "dali/pipeline/operator/operator.h"
 #include "dali/kernels/imgproc/warp/affine.h"
 #include "dali/kernels/imgproc/warp/mapping_traits.h"
@@ -33,6 +34,24 @@ namespace dali {
 template <int spatial_ndim>
 using RotateParams = kernels::AffineMapping<spatial_ndim>;
 
+/**
+ * @brief Describes a rotation with the angle stored in device memory
+ */
+template <int spatial_ndim>
+struct RotateDeviceParamsDesc {
+  const float *angle;  ///< the angle, in degrees, as in the `angle` argument
+  vec<spatial_ndim> in_center, out_center;
+  vec3 axis;  ///< ignored for 2D
+};
+
+/**
+ * @brief Calculates the rotation mappings in a kernel, reading the angles from device memory
+ */
+template <int spatial_ndim>
+void RotateParamsGPU(RotateParams<spatial_ndim> *output,
+                     const RotateDeviceParamsDesc<spatial_ndim> *descs, int count,
+                     cudaStream_t stream);
+
 inline std::tuple<ivec2, ivec2> RotatedCanvasSize(TensorShape<2> input_size, double angle) {
   double eps = 1e-2;
   double abs_cos = std::abs(std::cos(angle));
@@ -115,7 +134,23 @@ class RotateParamProvider
 
   void SetParams() override {
     input_shape_ = convert_dim<spatial_ndim + 1>(ws_->template Input<Backend>(0).shape());
-    Collect(angles_, "angle", true);
+    device_angles_.clear();
+    if (spec_->NumRegularInput() >= 2) {
+      DALI_ENFORCE(!spec_->ArgumentDefined("angle"),
+        "The angle can be passed either as the second input or as the `angle` argument, "
+        "but not both.");
+      if (ws_->template InputIsType<GPUBackend>(1)) {
+        UseDeviceAngles(ws_->template Input<GPUBackend>(1));
+      } else {
+        const auto &input = ws_->template Input<CPUBackend>(1);
+        CheckAngleInput(input);
+        CopyIgnoreShape(angles_, view<const float>(input));
+      }
+    } else {
+      DALI_ENFORCE(spec_->ArgumentDefined("angle"),
+        "The angle must be passed either as the `angle` argument or as the second input.");
+      Collect(angles_, "angle", true);
+    }
 
     // For 2D, assume positive CCW rotation when (0,0) denotes top-left corner.
     // For 3D, we just follow the mathematical formula for rotation around arbitrary axis.
@@ -126,6 +161,37 @@ class RotateParamProvider
       Collect(axes_, "axis", true);
   }
 
+  template <typename InputType>
+  void CheckAngleInput(const InputType &input) {
+    DALI_ENFORCE(input.type() == DALI_FLOAT, make_string(
+      "The angles must be of type float, got: ", input.type()));
+    const auto &shape = input.shape();
+    DALI_ENFORCE(shape.num_samples() == num_samples_, make_string(
+      "Unexpected number of angles: ", shape.num_samples(), "; expected: ", num_samples_));
+    for (int i = 0; i < num_samples_; i++) {
+      DALI_ENFORCE(volume(shape.tensor_shape_span(i)) == 1, make_string(
+        "The angle input must contain one value per sample. Got a tensor of shape ",
+        shape[i], " for sample ", i, "."));
+    }
+  }
+
+  /**
+   * @brief Uses the angles in device memory (e.g. produced by a GPU operator)
+   *
+   * The angles are not copied to the host - the mappings are calculated by a kernel.
+   * The output size cannot depend on the angle, so it must be either given or kept.
+   */
+  void UseDeviceAngles(const TensorList<GPUBackend> &input) {
+    CheckAngleInput(input);
+    DALI_ENFORCE(!ShouldInferSize(),
+      "When the angles are in GPU memory, the output size cannot depend on them. "
+      "Specify the `size` or set `keep_size` to True.");
+    angles_.clear();
+    device_angles_.resize(num_samples_);
+    for (int i = 0; i < num_samples_; i++)
+      device_angles_[i] = input.tensor<float>(i);
+  }
+
   template <typename T>
   void CopyIgnoreShape(vector<T> &out, const TensorListView<StorageCPU, const T> &TL) {
     int64_t n = TL.num_elements();
@@ -222,7 +288,29 @@ class RotateParamProvider
   }
 
   void AdjustParams() override {
-    AdjustParams(std::integral_constant<int, spatial_ndim>());
+    if (!device_angles_.empty())
+      AdjustParamsGPU();
+    else
+      AdjustParams(std::integral_constant<int, spatial_ndim>());
+  }
+
+  void AdjustParamsGPU() {
+    using kernels::shape2vec;
+    using kernels::skip_dim;
+    assert(static_cast<int>(device_angles_.size()) == num_samples_);
+    assert(static_cast<int>(out_sizes_.size()) == num_samples_);
+
+    descs_.resize(num_samples_);
+    for (int i = 0; i < num_samples_; i++) {
+      auto &desc = descs_[i];
+      desc.angle = device_angles_[i];
+      desc.in_center = shape2vec(skip_dim<spatial_ndim>(input_shape_[i])) * 0.5f;
+      desc.out_center = shape2vec(out_sizes_[i]) * 0.5f;
+      desc.axis = spatial_ndim == 3 ? axes_[i] : vec3();
+    }
+    descs_gpu_.from_host(descs_, this->GetStream());
+    auto *params = this->template AllocParams<mm::memory_kind::device>();
+    RotateParamsGPU<spatial_ndim>(params, descs_gpu_.data(), num_samples_, this->GetStream());
   }
 
   void AdjustParams(std::integral_constant<int, 2>) {
@@ -318,6 +406,9 @@ class RotateParamProvider
   }
 
   std::vector<float> angles_;
+  std::vector<const float *> device_angles_;
+  std::vector<RotateDeviceParamsDesc<spatial_ndim>> descs_;
+  DeviceBuffer<RotateDeviceParamsDesc<spatial_ndim>> descs_gpu_;
   std::vector<vec3> axes_;
   TensorListShape<spatial_ndim + 1> input_shape_;
 };
@@ -24,6 +24,7 @@
 
 #include "dali/core/static_switch.h"
 #include "dali/core/tuple_helpers.h"
+#include "dali/kernels/common/split_shape.h"
 #include "dali/kernels/imgproc/warp_cpu.h"
 #include "dali/kernels/imgproc/warp_gpu.h"
 #include "dali/kernels/kernel_manager.h"
@@ -163,20 +164,32 @@ class WarpOpImpl : public OpImplInterface<Backend> {
 
     ThreadPool &pool = ws.GetThreadPool();
     auto interp_types = param_provider_->InterpTypes();
+    int N = input_.num_samples();
+    int64_t total_volume = output.shape.num_elements();
 
-    for (int i = 0; i < input_.num_samples(); i++) {
-      pool.AddWork([&, i](int tid) {
-        DALIInterpType interp_type = interp_types.size() > 1 ? interp_types[i] : interp_types[0];
-        auto context = GetContext(ws);
-        kmgr_.Run<Kernel>(
-            i, context,
-            output[i],
-            input_[i],
-            *param_provider_->ParamsCPU()(i),
-            param_provider_->OutputSizes()[i],
-            interp_type,
-            param_provider_->Border());
-      }, output.shape.tensor_size(i));
+    for (int i = 0; i < N; i++) {
+      // With fewer samples than threads, large samples are split into ranges of rows (planes)
+      int64_t sample_volume = output.shape.tensor_size(i);
+      int64_t rows = output.shape.tensor_shape_span(i)[0];
+      int nranges = kernels::num_outer_ranges(sample_volume, total_volume, rows, N,
+                                              pool.NumThreads());
+      for (int r = 0; r < nranges; r++) {
+        int64_t begin = rows * r / nranges;
+        int64_t end = rows * (r + 1) / nranges;
+        pool.AddWork([&, i, begin, end](int tid) {
+          DALIInterpType interp_type = interp_types.size() > 1 ? interp_types[i] : interp_types[0];
+          auto context = GetContext(ws);
+          kmgr_.Get<Kernel>(i).RunRange(
+              context,
+              output[i],
+              input_[i],
+              *param_provider_->ParamsCPU()(i),
+              param_provider_->OutputSizes()[i],
+              begin, end,
+              interp_type,
+              param_provider_->Border());
+        }, sample_volume / nranges);
+      }
     }
     pool.RunAll();
   }
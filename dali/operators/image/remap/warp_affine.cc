@@ -22,6 +22,7 @@ DALI_SCHEMA(WarpAffine)
 )code")
   .NumInput(1, 2)
   .NumOutput(1)
+  .MicroBatchable()
   .InputLayout(0, { "HWC", "FHWC", "DHWC", "FDHWC" })
   .SupportVolumetric()
   .AddOptionalArg<float>("matrix",
@@ -0,0 +1,381 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cfloat>
+#include <string>
+#include <vector>
+#include "dali/core/convert.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/geom/mat.h"
+#include "dali/core/geom/transform.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/tensor_shape_print.h"
+#include "dali/core/util.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/imgproc/warp/affine.h"
+#include "dali/kernels/imgproc/warp_gpu.h"
+#include "dali/kernels/kernel_manager.h"
+#include "dali/operators/geometry/mt_transform_attr.h"
+#include "dali/pipeline/data/views.h"
+#include "dali/pipeline/operator/common.h"
+#include "dali/pipeline/operator/operator.h"
+
+#define WARP_AFFINE_MULTI_TYPES (uint8_t, int16_t, int32_t, float)
+
+namespace dali {
+
+DALI_SCHEMA(experimental__WarpAffineMulti)
+  .DocStr(R"code(Applies an affine transform to several related inputs at once - images, masks,
+points and bounding boxes.
+
+The transform maps the source coordinates to the destination coordinates and is given as
+``MT`` (or ``M`` and ``T``), e.g. one returned by :meth:`nvidia.dali.fn.transforms.combine`.
+The same transform is applied to all the inputs of a sample. It is processed (and, for
+the images and masks, inverted and copied to the GPU) once per iteration, and each input is
+processed with a single kernel launch.
+
+The coordinates are expressed in pixels, with ``[0, 0]`` being the corner of the first pixel,
+unless ``normalized_coords`` is set.
+
+The kind of each input is given with ``input_kinds``:
+
+* ``"image"`` - an *HWC* image, sampled with ``interp_type``,
+* ``"mask"`` - an *HWC* mask, sampled with the nearest neighbor interpolation, with 0 used
+  outside of the source mask,
+* ``"points"`` - float points, stored as ``[x, y]`` in the innermost dimension,
+* ``"boxes"`` - float boxes, stored as ``[left, top, right, bottom]`` in the innermost
+  dimension. The output boxes are the bounding boxes of the transformed corners.
+
+There must be at least one image or mask input and all images and masks of a sample must have
+the same height and width.
+
+This operator is supported only on the GPU.)code")
+  .NumInput(1, 8)
+  .OutputFn([](const OpSpec &spec) {
+    return spec.NumRegularInput();
+  })
+  .AddOptionalArg("input_kinds",
+      R"code(The kinds of the inputs - ``"image"``, ``"mask"``, ``"points"`` or ``"boxes"``.
+
+Must have one entry per input. Can be omitted only if there's one input, which is an image.)code",
+      std::vector<std::string>{"image"})
+  .AddOptionalArg<float>("size",
+      R"code(The size of the output images and masks.
+
+If not specified, the size of the input is used.)code",
+      std::vector<float>(), true)
+  .AddOptionalArg("interp_type",
+      R"code(The type of interpolation used for the images.)code",
+      DALI_INTERP_LINEAR)
+  .AddOptionalArg<float>("fill_value",
+      R"code(The value used to fill the areas of the images that are outside the source image.
+
+If not specified, the source coordinates are clamped and the border pixel is repeated.)code",
+      nullptr)
+  .AddOptionalArg("normalized_coords",
+      R"code(If set to True, the points and boxes are expressed in the coordinates relative to
+the size of the input and output images, in the range [0, 1].
+
+The transform is always expressed in pixels.)code",
+      false)
+  .AddParent("MTTransformAttr");
+
+namespace warp_affine_multi {
+
+struct CoordsDesc {
+  float *out;
+  const float *in;
+  int64_t count;
+  bool boxes;
+  mat2 M;
+  vec2 T;
+};
+
+/**
+ * @brief Transforms the points or boxes of all the coordinate inputs
+ *
+ * The block row y processes the descriptor y - a sample of one of the inputs.
+ */
+__global__ void TransformCoordsKernel(const CoordsDesc *descs) {
+  const auto &desc = descs[blockIdx.y];
+  for (int64_t i = blockIdx.x * blockDim.x + threadIdx.x; i < desc.count;
+       i += gridDim.x * blockDim.x) {
+    if (desc.boxes) {
+      const float *in = desc.in + 4 * i;
+      vec2 lo(FLT_MAX), hi(-FLT_MAX);
+      for (int corner = 0; corner < 4; corner++) {
+        vec2 p = desc.M * vec2(in[(corner & 1) ? 2 : 0], in[(corner & 2) ? 3 : 1]) + desc.T;
+        lo = min(lo, p);
+        hi = max(hi, p);
+      }
+      float *out = desc.out + 4 * i;
+      out[0] = lo.x;
+      out[1] = lo.y;
+      out[2] = hi.x;
+      out[3] = hi.y;
+    } else {
+      vec2 p = desc.M * vec2(desc.in[2 * i], desc.in[2 * i + 1]) + desc.T;
+      desc.out[2 * i] = p.x;
+      desc.out[2 * i + 1] = p.y;
+    }
+  }
+}
+
+}  // namespace warp_affine_multi
+
+class WarpAffineMultiGPU : public Operator<GPUBackend>, private MTTransformAttr {
+ public:
+  explicit WarpAffineMultiGPU(const OpSpec &spec);
+
+  bool CanInferOutputs() const override { return true; }
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) override;
+  void RunImpl(DeviceWorkspace &ws) override;
+
+ private:
+  enum class InputKind { Image, Mask, Points, Boxes };
+
+  bool IsImageLike(int input_idx) const {
+    return kinds_[input_idx] == InputKind::Image || kinds_[input_idx] == InputKind::Mask;
+  }
+
+  template <typename T, typename BorderType>
+  void Warp(DeviceWorkspace &ws, int input_idx, kernels::KernelContext &ctx,
+            const TensorView<StorageGPU, const kernels::AffineMapping2D, 1> &mapping,
+            DALIInterpType interp_type, BorderType border);
+
+  void TransformCoords(DeviceWorkspace &ws, kernels::DynamicScratchpad &scratch);
+
+  std::vector<InputKind> kinds_;
+  DALIInterpType interp_type_;
+  bool has_fill_value_;
+  float fill_value_ = 0;
+  bool normalized_coords_;
+
+  /// The sizes of the input and output images and masks, per sample
+  std::vector<TensorShape<2>> in_sizes_, out_sizes_;
+  TensorListShape<2> size_arg_;
+  /// Destination to source mappings, used by the warps
+  std::vector<kernels::AffineMapping2D> mappings_;
+  kernels::KernelManager kmgr_;
+};
+
+WarpAffineMultiGPU::WarpAffineMultiGPU(const OpSpec &spec)
+    : Operator<GPUBackend>(spec), MTTransformAttr(spec),
+      interp_type_(spec.GetArgument<DALIInterpType>("interp_type")),
+      has_fill_value_(spec.HasArgument("fill_value")),
+      normalized_coords_(spec.GetArgument<bool>("normalized_coords")) {
+  int ninputs = spec.NumRegularInput();
+  auto kinds = spec.GetRepeatedArgument<std::string>("input_kinds");
+  DALI_ENFORCE(static_cast<int>(kinds.size()) == ninputs,
+               make_string("``input_kinds`` must have one entry per input. Got ", kinds.size(),
+                           " entries for ", ninputs, " inputs."));
+  bool has_image_like = false;
+  for (auto &kind : kinds) {
+    if (kind == "image") {
+      kinds_.push_back(InputKind::Image);
+    } else if (kind == "mask") {
+      kinds_.push_back(InputKind::Mask);
+    } else if (kind == "points") {
+      kinds_.push_back(InputKind::Points);
+    } else if (kind == "boxes") {
+      kinds_.push_back(InputKind::Boxes);
+    } else {
+      DALI_FAIL(make_string("Unknown input kind: \"", kind,
+                            "\". Supported kinds are: image, mask, points and boxes."));
+    }
+    has_image_like |= IsImageLike(kinds_.size() - 1);
+  }
+  DALI_ENFORCE(has_image_like, "There must be at least one image or mask input.");
+  DALI_ENFORCE(interp_type_ == DALI_INTERP_NN || interp_type_ == DALI_INTERP_LINEAR,
+               "Only nearest and linear interpolation is supported.");
+  if (has_fill_value_)
+    fill_value_ = spec.GetArgument<float>("fill_value");
+  kmgr_.Resize(ninputs);
+}
+
+bool WarpAffineMultiGPU::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                   const DeviceWorkspace &ws) {
+  int ninputs = ws.NumInput();
+  int nsamples = ws.GetInputBatchSize(0);
+  in_sizes_.assign(nsamples, TensorShape<2>(-1, -1));
+  for (int k = 0; k < ninputs; k++) {
+    const auto &input = ws.Input<GPUBackend>(k);
+    DALI_ENFORCE(input.num_samples() == nsamples,
+                 "All the inputs must have the same number of samples.");
+    if (IsImageLike(k)) {
+      DALI_ENFORCE(input.sample_dim() == 3,
+                   make_string("Images and masks must be 3D tensors with the HWC layout. Got a ",
+                               input.sample_dim(), "D input ", k, "."));
+      for (int i = 0; i < nsamples; i++) {
+        auto sh = input.tensor_shape_span(i);
+        TensorShape<2> size(sh[0], sh[1]);
+        if (in_sizes_[i][0] < 0) {
+          in_sizes_[i] = size;
+        } else {
+          DALI_ENFORCE(in_sizes_[i] == size,
+                       make_string("All images and masks of a sample must have the same size. "
+                                   "Got ", in_sizes_[i], " and ", size, " in the sample ", i,
+                                   "."));
+        }
+      }
+    } else {
+      DALI_ENFORCE(input.type() == DALI_FLOAT,
+                   make_string("Points and boxes must be float, got ", input.type(),
+                               " in the input ", k, "."));
+      int coords = kinds_[k] == InputKind::Boxes ? 4 : 2;
+      for (int i = 0; i < nsamples; i++) {
+        auto sh = input.tensor_shape_span(i);
+        DALI_ENFORCE(sh.size() > 0 && sh[sh.size() - 1] == coords,
+                     make_string("The innermost dimension of ",
+                                 kinds_[k] == InputKind::Boxes ? "boxes" : "points",
+                                 " must have the extent ", coords, ". Got the shape ",
+                                 input.tensor_shape(i), " in the input ", k, "."));
+      }
+    }
+  }
+
+  out_sizes_ = in_sizes_;
+  if (spec_.ArgumentDefined("size")) {
+    GetShapeArgument<float>(size_arg_, spec_, "size", ws, nsamples);
+    for (int i = 0; i < nsamples; i++) {
+      out_sizes_[i] = size_arg_[i];
+      DALI_ENFORCE(out_sizes_[i][0] >= 0 && out_sizes_[i][1] >= 0,
+                   make_string("The output size must not be negative, got ", out_sizes_[i],
+                               "."));
+    }
+  }
+
+  SetTransformDims(2, 2);
+  ProcessTransformArgs(spec_, ws, nsamples);
+  auto matrices = GetMatrices<2, 2>();
+  auto translations = GetTranslations<2>();
+  mappings_.resize(nsamples);
+  for (int i = 0; i < nsamples; i++)
+    mappings_[i] = kernels::AffineMapping2D(cat_cols(matrices[i], translations[i])).inv();
+
+  output_desc.resize(ninputs);
+  for (int k = 0; k < ninputs; k++) {
+    const auto &input = ws.Input<GPUBackend>(k);
+    output_desc[k].type = input.type();
+    output_desc[k].shape = input.shape();
+    if (IsImageLike(k)) {
+      for (int i = 0; i < nsamples; i++) {
+        auto sh = output_desc[k].shape.tensor_shape_span(i);
+        sh[0] = out_sizes_[i][0];
+        sh[1] = out_sizes_[i][1];
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T, typename BorderType>
+void WarpAffineMultiGPU::Warp(
+    DeviceWorkspace &ws, int input_idx, kernels::KernelContext &ctx,
+    const TensorView<StorageGPU, const kernels::AffineMapping2D, 1> &mapping,
+    DALIInterpType interp_type, BorderType border) {
+  using Kernel = kernels::WarpGPU<kernels::AffineMapping2D, 2, T, T, BorderType>;
+  auto in = view<const T, 3>(ws.Input<GPUBackend>(input_idx));
+  auto out = view<T, 3>(ws.Output<GPUBackend>(input_idx));
+  auto sizes = make_cspan(out_sizes_);
+  auto interp = make_cspan(&interp_type, 1);
+  kmgr_.CreateOrGet<Kernel>(input_idx);
+  kmgr_.Setup<Kernel>(input_idx, ctx, in, mapping, sizes, interp, border);
+  kmgr_.Run<Kernel>(input_idx, ctx, out, in, mapping, sizes, interp, border);
+}
+
+void WarpAffineMultiGPU::TransformCoords(DeviceWorkspace &ws,
+                                         kernels::DynamicScratchpad &scratch) {
+  using warp_affine_multi::CoordsDesc;
+  int nsamples = mappings_.size();
+  auto matrices = GetMatrices<2, 2>();
+  auto translations = GetTranslations<2>();
+  std::vector<CoordsDesc> descs;
+  int64_t max_count = 0;
+  for (int k = 0; k < ws.NumInput(); k++) {
+    if (IsImageLike(k))
+      continue;
+    const auto &input = ws.Input<GPUBackend>(k);
+    auto &output = ws.Output<GPUBackend>(k);
+    output.SetLayout(input.GetLayout());
+    bool boxes = kinds_[k] == InputKind::Boxes;
+    for (int i = 0; i < nsamples; i++) {
+      CoordsDesc desc;
+      desc.in = input.tensor<float>(i);
+      desc.out = output.mutable_tensor<float>(i);
+      desc.count = volume(input.tensor_shape(i)) / (boxes ? 4 : 2);
+      desc.boxes = boxes;
+      desc.M = matrices[i];
+      desc.T = translations[i];
+      if (normalized_coords_) {
+        // scale to pixels, transform and scale back to the relative coordinates of the output
+        vec2 in_scale(in_sizes_[i][1], in_sizes_[i][0]);
+        vec2 out_scale(out_sizes_[i][1], out_sizes_[i][0]);
+        for (int r = 0; r < 2; r++) {
+          for (int c = 0; c < 2; c++)
+            desc.M(r, c) *= in_scale[c] / out_scale[r];
+          desc.T[r] /= out_scale[r];
+        }
+      }
+      max_count = std::max(max_count, desc.count);
+      descs.push_back(desc);
+    }
+  }
+  if (descs.empty() || max_count == 0)
+    return;
+  cudaStream_t stream = ws.stream();
+  auto *descs_gpu = scratch.ToGPU(stream, descs);
+  dim3 grid(std::min<int64_t>(div_ceil(max_count, 256), 1024), descs.size());
+  warp_affine_multi::TransformCoordsKernel<<<grid, 256, 0, stream>>>(descs_gpu);
+  CUDA_CALL(cudaGetLastError());
+}
+
+void WarpAffineMultiGPU::RunImpl(DeviceWorkspace &ws) {
+  cudaStream_t stream = ws.stream();
+  kernels::DynamicScratchpad scratch({}, AccessOrder(stream));
+  int nsamples = mappings_.size();
+
+  // the mappings are copied once and shared by the warps of all the images and masks
+  auto mapping = make_tensor_gpu<1>(scratch.ToGPU(stream, mappings_), {nsamples});
+  kernels::KernelContext ctx;
+  ctx.gpu.stream = stream;
+  ctx.scratchpad = &scratch;
+
+  for (int k = 0; k < ws.NumInput(); k++) {
+    if (!IsImageLike(k))
+      continue;
+    const auto &input = ws.Input<GPUBackend>(k);
+    ws.Output<GPUBackend>(k).SetLayout(input.GetLayout());
+    if (ws.Output<GPUBackend>(k).shape().num_elements() == 0)
+      continue;
+    TYPE_SWITCH(input.type(), type2id, T, WARP_AFFINE_MULTI_TYPES, (
+      if (kinds_[k] == InputKind::Mask) {
+        Warp<T>(ws, k, ctx, mapping, DALI_INTERP_NN, T(0));
+      } else if (has_fill_value_) {
+        Warp<T>(ws, k, ctx, mapping, interp_type_, ConvertSat<T>(fill_value_));
+      } else {
+        Warp<T>(ws, k, ctx, mapping, interp_type_, kernels::BorderClamp());
+      }
+    ), (  // NOLINT
+      DALI_FAIL(make_string("Unsupported type of the input ", k, ": ", input.type()));
+    ));  // NOLINT
+  }
+  TransformCoords(ws, scratch);
+}
+
+DALI_REGISTER_OPERATOR(experimental__WarpAffineMulti, WarpAffineMultiGPU, GPU);
+
+}  // namespace dali
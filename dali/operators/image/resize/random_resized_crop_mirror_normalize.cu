@@ -0,0 +1,178 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <algorithm>
+#include <vector>
+#include "dali/core/static_switch.h"
+#include "dali/core/tensor_layout.h"
+#include "dali/core/util.h"
+#include "dali/kernels/imgproc/resample/resize_mirror_normalize_gpu.cuh"
+#include "dali/kernels/kernel_manager.h"
+#include "dali/operators/image/crop/random_crop_attr.h"
+#include "dali/pipeline/data/views.h"
+#include "dali/pipeline/operator/common.h"
+#include "dali/pipeline/operator/operator.h"
+
+#define RRCMN_IN_TYPES (uint8_t, int16_t, uint16_t, float)
+#define RRCMN_OUT_TYPES (float, float16)
+
+namespace dali {
+
+DALI_SCHEMA(experimental__RandomResizedCropMirrorNormalize)
+  .DocStr(R"code(Performs a crop with a randomly selected area and aspect ratio, resizes it
+to the specified size, and mirrors, normalizes and (optionally) pads and transposes the result.
+
+This is a fused equivalent of :meth:`nvidia.dali.fn.random_resized_crop` followed by
+:meth:`nvidia.dali.fn.crop_mirror_normalize`, which writes the final output directly, without
+the intermediate, resized images.
+
+Normalization produces the output by using the following formula::
+
+  output = (input - mean) / std
+
+.. note::
+    The interpolation is always bilinear and no antialiasing is applied. When the crop
+    is downscaled significantly, the result differs from the one of
+    :meth:`nvidia.dali.fn.random_resized_crop` with antialiasing enabled.
+
+Expects a three-dimensional input with samples in height, width, channels (HWC) layout,
+with up to 4 channels.)code")
+  .NumInput(1)
+  .NumOutput(1)
+  .AddArg("size",
+      R"code(Size of the resized image.)code",
+      DALI_INT_VEC)
+  .AddOptionalTypeArg("dtype",
+      R"code(Output data type.
+
+Supported types: ``FLOAT``, ``FLOAT16``.)code", DALI_FLOAT)
+  .AddOptionalArg("output_layout",
+      R"code(Tensor data layout for the output - *CHW* or *HWC*.)code", TensorLayout("CHW"))
+  .AddOptionalArg("pad_output",
+      R"code(Determines whether to pad the output so that the number of channels is a power of 2.
+
+The padding channels are filled with zeros.)code", false)
+  .AddOptionalArg("mirror",
+      R"code(If nonzero, the image will be flipped (mirrored) horizontally.)code",
+      0, true)
+  .AddOptionalArg("mean",
+      R"code(Mean pixel values for image normalization.)code",
+      std::vector<float>{0.0f})
+  .AddOptionalArg("std",
+      R"code(Standard deviation values for image normalization.)code",
+      std::vector<float>{1.0f})
+  .AddParent("RandomCropAttr")
+  .InputLayout(0, "HWC");
+
+class RandomResizedCropMirrorNormalize : public Operator<GPUBackend> {
+ public:
+  explicit RandomResizedCropMirrorNormalize(const OpSpec &spec)
+      : Operator<GPUBackend>(spec),
+        crop_attr_(spec),
+        output_type_(spec.GetArgument<DALIDataType>("dtype")),
+        output_layout_(spec.GetArgument<TensorLayout>("output_layout")),
+        pad_output_(spec.GetArgument<bool>("pad_output")) {
+    GetSingleOrRepeatedArg(spec, size_, "size", 2);
+    DALI_ENFORCE(output_layout_ == "CHW" || output_layout_ == "HWC",
+                 make_string("The output layout must be CHW or HWC, got: ", output_layout_, "."));
+    auto mean = spec.GetRepeatedArgument<float>("mean");
+    auto stddev = spec.GetRepeatedArgument<float>("std");
+    DALI_ENFORCE(mean.size() == stddev.size() || mean.size() == 1 || stddev.size() == 1,
+        "``mean`` and ``std`` must either be of the same size, be scalars, or one of them can be a "
+        "vector and the other a scalar.");
+    int nargs = std::max(mean.size(), stddev.size());
+    for (int c = 0; c < nargs; c++) {
+      float s = stddev[c % stddev.size()];
+      DALI_ENFORCE(s > 0, "The standard deviation must be positive.");
+      mean_.push_back(mean[c % mean.size()]);
+      inv_stddev_.push_back(1.0f / s);
+    }
+  }
+
+  bool CanInferOutputs() const override { return true; }
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) override {
+    const auto &input = ws.Input<GPUBackend>(0);
+    input_type_ = input.type();
+    const auto &in_shape = input.shape();
+    DALI_ENFORCE(in_shape.sample_dim() == 3,
+                 "The input must be a batch of HWC images.");
+    int N = in_shape.num_samples();
+    args_.resize(N);
+    for (int i = 0; i < N; i++) {
+      auto sample_shape = in_shape.tensor_shape_span(i);
+      int H = sample_shape[0], W = sample_shape[1], C = sample_shape[2];
+      CropWindow crop = crop_attr_.GetCropWindowGenerator(i)({H, W}, "HW");
+      auto &a = args_[i];
+      a.roi_lo = vec2(crop.anchor[1], crop.anchor[0]);
+      a.roi_hi = a.roi_lo + vec2(crop.shape[1], crop.shape[0]);
+      a.out_size = ivec2(size_[1], size_[0]);
+      a.mirror = spec_.GetArgument<int>("mirror", &ws, i);
+      a.mean = mean_;
+      a.inv_stddev = inv_stddev_;
+      a.out_channels = pad_output_ ? next_pow2(C) : C;
+      a.planar = output_layout_ == "CHW";
+    }
+
+    output_desc.resize(1);
+    output_desc[0].type = output_type_;
+    kernels::KernelContext ctx;
+    ctx.gpu.stream = ws.stream();
+    auto in_view_shape = in_shape.to_static<3>();
+    TYPE_SWITCH(input_type_, type2id, In, RRCMN_IN_TYPES, (
+      TYPE_SWITCH(output_type_, type2id, Out, RRCMN_OUT_TYPES, (
+        using Kernel = kernels::ResizeMirrorNormalizeGPU<Out, In>;
+        kmgr_.Resize<Kernel>(1);
+        auto &req = kmgr_.Setup<Kernel>(0, ctx, in_view_shape, make_cspan(args_));
+        output_desc[0].shape = req.output_shapes[0];
+      ), DALI_FAIL(make_string("Not supported output type: ", output_type_)););  // NOLINT
+    ), DALI_FAIL(make_string("Not supported input type: ", input_type_)););  // NOLINT
+    return true;
+  }
+
+  void RunImpl(DeviceWorkspace &ws) override {
+    const auto &input = ws.Input<GPUBackend>(0);
+    auto &output = ws.Output<GPUBackend>(0);
+    output.SetLayout(output_layout_);
+    kernels::KernelContext ctx;
+    ctx.gpu.stream = ws.stream();
+    TYPE_SWITCH(input_type_, type2id, In, RRCMN_IN_TYPES, (
+      TYPE_SWITCH(output_type_, type2id, Out, RRCMN_OUT_TYPES, (
+        using Kernel = kernels::ResizeMirrorNormalizeGPU<Out, In>;
+        auto in_view = view<const In, 3>(input);
+        auto out_view = view<Out, 3>(output);
+        kmgr_.Run<Kernel>(0, ctx, out_view, in_view, make_cspan(args_));
+      ), DALI_FAIL(make_string("Not supported output type: ", output_type_)););  // NOLINT
+    ), DALI_FAIL(make_string("Not supported input type: ", input_type_)););  // NOLINT
+  }
+
+ private:
+  RandomCropAttr crop_attr_;
+  std::vector<int> size_;
+  DALIDataType input_type_ = DALI_NO_TYPE;
+  DALIDataType output_type_ = DALI_NO_TYPE;
+  TensorLayout output_layout_;
+  bool pad_output_ = false;
+  SmallVector<float, 4> mean_, inv_stddev_;
+
+  std::vector<kernels::ResizeMirrorNormalizeArgs> args_;
+  kernels::KernelManager kmgr_;
+};
+
+DALI_REGISTER_OPERATOR(experimental__RandomResizedCropMirrorNormalize,
+                       RandomResizedCropMirrorNormalize, GPU);
+
+}  // namespace dali
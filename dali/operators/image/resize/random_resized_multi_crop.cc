@@ -0,0 +1,77 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "dali/operators/image/resize/random_resized_multi_crop.h"
+
+namespace dali {
+
+DALI_SCHEMA(experimental__RandomResizedMultiCrop)
+  .DocStr(R"code(Performs several crops with a randomly selected area and aspect ratio of each
+image and resizes them to the specified sizes.
+
+The crops are given in groups - e.g. for 2 global and 8 local views of an image, as used in
+self-supervised training, ``num_crops`` is ``[2, 8]``, ``size`` is ``[224, 224, 96, 96]`` and
+``random_area`` is ``[0.4, 1.0, 0.05, 0.4]``. The operator has one output per crop, the crops of
+each group being consecutive outputs.
+
+All the crops of all the images are resized together, which is equivalent to, but faster than,
+applying :meth:`nvidia.dali.fn.random_resized_crop` separately for each crop.
+
+Expects a three-dimensional input with samples in height, width, channels (HWC) or channels,
+height, width (CHW) layout.)code")
+  .NumInput(1)
+  .OutputFn([](const OpSpec &spec) {
+    int total = 0;
+    for (int n : spec.GetRepeatedArgument<int>("num_crops"))
+      total += n;
+    return total;
+  })
+  .AddArg("num_crops",
+      R"code(The number of crops in each group.)code",
+      DALI_INT_VEC)
+  .AddArg("size",
+      R"code(Size of the resized crops.
+
+Either a pair of (height, width) or a single value, used for all the groups, or one pair per
+group.)code",
+      DALI_INT_VEC)
+  .AddOptionalArg("random_aspect_ratio",
+      R"code(Range from which to choose random aspect ratio (width/height).
+
+Either a single range, used for all the groups, or one range per group.)code",
+      std::vector<float>{3./4., 4./3.})
+  .AddOptionalArg("random_area",
+      R"code(Range from which to choose random area fraction ``A``.
+
+The cropped image's area will be equal to ``A`` * original image's area.
+Either a single range, used for all the groups, or one range per group.)code",
+      std::vector<float>{0.08, 1.0})
+  .AddOptionalArg("num_attempts",
+      R"code(Maximum number of attempts used to choose random area and aspect ratio.)code",
+      10)
+  .Nondeterministic()
+  .AddParent("ResamplingFilterAttr")
+  .InputLayout(0, { "HWC", "CHW" });
+
+template<>
+void RandomResizedMultiCrop<CPUBackend>::BackendInit() {
+  InitializeCPU(num_threads_);
+}
+
+DALI_REGISTER_OPERATOR(experimental__RandomResizedMultiCrop, RandomResizedMultiCrop<CPUBackend>,
+                       CPU);
+
+}  // namespace dali
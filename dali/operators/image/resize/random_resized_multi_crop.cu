@@ -0,0 +1,28 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/image/resize/random_resized_multi_crop.h"
+
+namespace dali {
+
+template<>
+void RandomResizedMultiCrop<GPUBackend>::BackendInit() {
+  InitializeGPU(spec_.GetArgument<int>("minibatch_size"),
+                spec_.GetArgument<int64_t>("temp_buffer_hint"));
+}
+
+DALI_REGISTER_OPERATOR(experimental__RandomResizedMultiCrop, RandomResizedMultiCrop<GPUBackend>,
+                       GPU);
+
+}  // namespace dali
@@ -0,0 +1,219 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_IMAGE_RESIZE_RANDOM_RESIZED_MULTI_CROP_H_
+#define DALI_OPERATORS_IMAGE_RESIZE_RANDOM_RESIZED_MULTI_CROP_H_
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "dali/core/tensor_shape_print.h"
+#include "dali/kernels/imgproc/resample/params.h"
+#include "dali/operators/image/resize/resampling_attr.h"
+#include "dali/operators/image/resize/resize_base.h"
+#include "dali/pipeline/operator/common.h"
+#include "dali/pipeline/operator/op_spec.h"
+#include "dali/pipeline/operator/operator.h"
+#include "dali/util/random_crop_generator.h"
+
+namespace dali {
+
+/**
+ * @brief Produces several random resized crops of each input image in one resampling pass
+ *
+ * The crops of all the samples are set up as one virtual batch of `batch_size * num_crops`
+ * samples, in which the crops of an image are adjacent, and resized with a single call to
+ * ResizeBase. The virtual batch aliases the input samples and the samples of the outputs,
+ * so there are no copies and the crops of an image are processed in the same minibatch,
+ * reading the source image while it's still in the cache.
+ */
+template <typename Backend>
+class RandomResizedMultiCrop : public Operator<Backend>
+                             , protected ResizeBase<Backend> {
+ public:
+  explicit inline RandomResizedMultiCrop(const OpSpec &spec)
+      : Operator<Backend>(spec), ResizeBase<Backend>(spec) {
+    auto num_crops = spec.GetRepeatedArgument<int>("num_crops");
+    int num_groups = num_crops.size();
+    DALI_ENFORCE(num_groups > 0, "``num_crops`` must not be empty.");
+    auto sizes = GetGroupArg<int>(spec, "size", num_groups);
+    auto areas = GetGroupArg<float>(spec, "random_area", num_groups);
+    auto aspect_ratios = GetGroupArg<float>(spec, "random_aspect_ratio", num_groups);
+    int num_attempts = spec.GetArgument<int>("num_attempts");
+    std::vector<int> crop_group;
+
+    for (int g = 0; g < num_groups; g++) {
+      DALI_ENFORCE(num_crops[g] > 0, make_string("The number of crops must be positive. Got ",
+                                                 num_crops[g], " in the group ", g, "."));
+      DALI_ENFORCE(sizes[2 * g] > 0 && sizes[2 * g + 1] > 0,
+                   make_string("The crop size must be positive. Got ", sizes[2 * g], "x",
+                               sizes[2 * g + 1], " in the group ", g, "."));
+      DALI_ENFORCE(areas[2 * g] <= areas[2 * g + 1] &&
+                   aspect_ratios[2 * g] <= aspect_ratios[2 * g + 1],
+                   make_string("Provided empty range in the group ", g, "."));
+      for (int c = 0; c < num_crops[g]; c++) {
+        kernels::ResamplingParams2D params;
+        params[0].output_size = sizes[2 * g];
+        params[1].output_size = sizes[2 * g + 1];
+        crop_params_.push_back(params);
+        crop_group.push_back(g);
+      }
+    }
+    num_crops_ = crop_params_.size();
+
+    // one generator per crop and batch slot, so that the crops don't depend on the batch size
+    std::seed_seq seq{spec.GetArgument<int64_t>("seed")};
+    std::vector<int> seeds(num_crops_ * max_batch_size_);
+    seq.generate(seeds.begin(), seeds.end());
+    generators_.reserve(seeds.size());
+    for (int k = 0, s = 0; k < num_crops_; k++) {
+      int g = crop_group[k];
+      for (int i = 0; i < max_batch_size_; i++, s++) {
+        generators_.emplace_back(AspectRatioRange{aspect_ratios[2 * g], aspect_ratios[2 * g + 1]},
+                                 AreaRange{areas[2 * g], areas[2 * g + 1]}, seeds[s],
+                                 num_attempts);
+      }
+    }
+    BackendInit();
+  }
+
+  inline ~RandomResizedMultiCrop() override = default;
+
+  DISABLE_COPY_MOVE_ASSIGN(RandomResizedMultiCrop);
+
+  USE_OPERATOR_MEMBERS();
+  using Operator<Backend>::RunImpl;
+
+  bool CanInferOutputs() const override { return true; }
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override {
+    const auto &input = ws.template Input<Backend>(0);
+    const auto &in_shape = input.shape();
+    DALIDataType in_type = input.type();
+    auto layout = input.GetLayout();
+    int N = in_shape.num_samples();
+    int ndim = in_shape.sample_dim();
+
+    int height_idx = layout.find('H');
+    int width_idx = layout.find('W');
+    DALI_ENFORCE(height_idx >= 0 && width_idx == height_idx + 1,
+                 make_string("The input must have the height and the width as consecutive "
+                             "dimensions. Got the layout \"", layout, "\"."));
+
+    resampling_attr_.PrepareFilterParams(spec_, ws, N);
+    auto out_type = resampling_attr_.GetOutputType(in_type);
+
+    // the virtual batch: crop k of the sample i is the sample i * num_crops_ + k
+    int total = N * num_crops_;
+    crops_in_shape_.resize(total, ndim);
+    resample_params_.resize(total);
+    group_params_.resize(N);
+    for (int i = 0; i < N; i++) {
+      for (int k = 0; k < num_crops_; k++)
+        crops_in_shape_.set_tensor_shape(i * num_crops_ + k, in_shape[i]);
+    }
+    for (int k = 0; k < num_crops_; k++) {
+      for (int i = 0; i < N; i++) {
+        auto sample_shape = in_shape.tensor_shape_span(i);
+        TensorShape<> size{sample_shape[height_idx], sample_shape[width_idx]};
+        auto wnd = generators_[k * max_batch_size_ + i].GenerateCropWindow(size);
+        auto &params = group_params_[i];
+        params = crop_params_[k];
+        for (int d = 0; d < 2; d++)
+          params[d].roi = kernels::ResamplingParams::ROI(wnd.anchor[d],
+                                                         wnd.anchor[d] + wnd.shape[d]);
+      }
+      // the filters are given per sample - applied to each crop separately
+      resampling_attr_.ApplyFilterParams(make_span(group_params_));
+      for (int i = 0; i < N; i++)
+        resample_params_[i * num_crops_ + k] = group_params_[i];
+    }
+
+    this->SetupResize(crops_out_shape_, out_type, crops_in_shape_, in_type,
+                      make_cspan(resample_params_), height_idx);
+
+    output_desc.resize(num_crops_);
+    for (int k = 0; k < num_crops_; k++) {
+      output_desc[k].type = out_type;
+      output_desc[k].shape.resize(N, ndim);
+      for (int i = 0; i < N; i++)
+        output_desc[k].shape.set_tensor_shape(i, crops_out_shape_[i * num_crops_ + k]);
+    }
+    return true;
+  }
+
+  void RunImpl(workspace_t<Backend> &ws) override {
+    const auto &input = ws.template Input<Backend>(0);
+    int N = input.num_samples();
+    for (int k = 0; k < num_crops_; k++)
+      ws.template Output<Backend>(k).SetLayout(input.GetLayout());
+    if (N == 0)
+      return;
+
+    // aliases of the input and the output samples, arranged as the virtual batch
+    TensorList<Backend> crops_in(N * num_crops_), crops_out(N * num_crops_);
+    crops_in.SetupLike(input);
+    crops_out.SetupLike(ws.template Output<Backend>(0));
+    for (int i = 0; i < N; i++) {
+      for (int k = 0; k < num_crops_; k++) {
+        crops_in.SetSample(i * num_crops_ + k, input, i);
+        crops_out.SetSample(i * num_crops_ + k, ws.template Output<Backend>(k), i);
+      }
+    }
+    this->RunResize(ws, crops_out, crops_in);
+  }
+
+ private:
+  void BackendInit();
+
+  /**
+   * @brief Gets an argument with a pair of values per group of crops or a single pair
+   *        (or a single value), shared by all the groups
+   */
+  template <typename T>
+  static std::vector<T> GetGroupArg(const OpSpec &spec, const std::string &name,
+                                    int num_groups) {
+    auto values = spec.GetRepeatedArgument<T>(name);
+    if (values.size() == 1)
+      values.push_back(values[0]);
+    if (values.size() == 2) {
+      std::vector<T> repeated;
+      for (int g = 0; g < num_groups; g++)
+        repeated.insert(repeated.end(), values.begin(), values.end());
+      return repeated;
+    }
+    DALI_ENFORCE(values.size() == 2u * num_groups,
+                 make_string("Argument \"", name, "\" expects 2 values or 2 values per group of "
+                             "crops (", 2 * num_groups, "). ", values.size(), " given."));
+    return values;
+  }
+
+  ResamplingFilterAttr resampling_attr_;
+
+  int num_crops_ = 0;
+  /// The output size of each crop, without the regions of interest
+  std::vector<kernels::ResamplingParams2D> crop_params_;
+  /// Crop window generators, indexed with crop * max_batch_size + sample
+  std::vector<RandomCropGenerator> generators_;
+
+  std::vector<kernels::ResamplingParams2D> group_params_;
+  std::vector<kernels::ResamplingParams2D> resample_params_;
+  TensorListShape<> crops_in_shape_, crops_out_shape_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_IMAGE_RESIZE_RANDOM_RESIZED_MULTI_CROP_H_
@@ -41,7 +41,8 @@ INTERP_LINEAR with ``antialias`` enabled.
       true)
   .AddOptionalArg<DALIDataType>("dtype", R"code(Output data type.
 
-Must be same as input type or ``float``. If not set, input type is used.)code", nullptr)
+Must be same as input type, ``float`` or ``bfloat16``. If not set, input type is used.)code",
+      nullptr)
   .AddOptionalArg("temp_buffer_hint",
       R"code(Initial size in bytes, of a temporary buffer for resampling.
 
@@ -22,6 +22,7 @@ DALI_SCHEMA(Resize)
   .DocStr(R"code(Resize images.)code")
   .NumInput(1)
   .NumOutput(1)
+  .MicroBatchable()
   .AdditionalOutputsFn([](const OpSpec& spec) {
     return static_cast<int>(spec.GetArgument<bool>("save_attrs"));
   })
@@ -44,13 +44,15 @@ void ResizeBase<Backend>::SetupResize(TensorListShape<> &out_shape,
       (DALI_FAIL(make_string("Unsupported type: ", out_type,
         ". Supported types are: uint8, int16, uint16 and float"))));
   } else {
-    DALI_ENFORCE(out_type == DALI_FLOAT,
-      make_string("Resize must output original type or float. Got: ", out_type));
-    TYPE_SWITCH(in_type, type2id, InputType, (uint8_t, int16_t, uint16_t),
-      (this->template SetupResizeTyped<float, InputType>(out_shape, in_shape, params,
-        spatial_ndim, first_spatial_dim)),
-      (DALI_FAIL(make_string("Unsupported type: ", in_type,
-        ". Supported types are: uint8, int16, uint16 and float"))));
+    DALI_ENFORCE(out_type == DALI_FLOAT || out_type == DALI_BFLOAT16,
+      make_string("Resize must output original type, float or bfloat16. Got: ", out_type));
+    TYPE_SWITCH(out_type, type2id, OutputType, (float, bfloat16), (
+      TYPE_SWITCH(in_type, type2id, InputType, (uint8_t, int16_t, uint16_t, float),
+        (this->template SetupResizeTyped<OutputType, InputType>(out_shape, in_shape, params,
+          spatial_ndim, first_spatial_dim)),
+        (DALI_FAIL(make_string("Unsupported type: ", in_type,
+          ". Supported types are: uint8, int16, uint16 and float"))))
+    ), (assert(!"Unreachable code")));  // NOLINT
   }
 }
 
@@ -98,7 +100,7 @@ void ResizeBase<CPUBackend>::SetupResizeStatic(
   auto *impl = dynamic_cast<ImplType*>(impl_.get());
   if (!impl) {
     impl_.reset();
-    auto unq_impl = std::make_unique<ImplType>(kmgr_);
+    auto unq_impl = std::make_unique<ImplType>(kmgr_, num_threads_);
     impl = unq_impl.get();
     impl_ = std::move(unq_impl);
   }
@@ -19,6 +19,7 @@
 #error This file is a part of resize base implementation and should not be included elsewhere
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 #include "dali/kernels/kernel_manager.h"
@@ -100,6 +101,57 @@ void GetFrameShapesAndParams(
   }
 }
 
+/**
+ * @brief Collapses the leading dimensions of the samples into the outermost spatial dimension
+ *
+ * The frames of a sample (e.g. of a video or a planar image) are stacked along the outermost
+ * dimension, up to `max_stack_frames` in one stack, so that they can be resampled with one
+ * sample descriptor. The trailing dimensions are collapsed into channels.
+ * The samples without frames are skipped.
+ *
+ * @param stack_shapes  the shapes of the stacks
+ * @param stack_frames  the number of frames in each stack
+ * @param stack_samples the index of the sample each stack comes from
+ */
+template <int spatial_ndim, int out_ndim, int in_ndim>
+void GetFrameStacks(
+      TensorListShape<out_ndim> &stack_shapes,
+      std::vector<int> &stack_frames,
+      std::vector<int> &stack_samples,
+      const TensorListShape<in_ndim> &shape,
+      int first_spatial_dim,
+      int max_stack_frames) {
+  assert(first_spatial_dim + spatial_ndim <= shape.sample_dim());
+  assert(max_stack_frames > 0);
+  const int frame_ndim = spatial_ndim + 1;
+  static_assert(out_ndim == frame_ndim || out_ndim < 0, "Invalid frame tensor rank.");
+
+  int N = shape.num_samples();
+  int ndim = shape.sample_dim();
+  stack_frames.clear();
+  stack_samples.clear();
+  for (int i = 0; i < N; i++) {
+    auto sample_shape = shape.tensor_shape_span(i);
+    int seq_len = volume(&sample_shape[0], &sample_shape[first_spatial_dim]);
+    for (int f = 0; f < seq_len; f += max_stack_frames) {
+      stack_frames.push_back(std::min(seq_len - f, max_stack_frames));
+      stack_samples.push_back(i);
+    }
+  }
+
+  int num_stacks = stack_frames.size();
+  stack_shapes.resize(num_stacks, frame_ndim);
+  for (int s = 0; s < num_stacks; s++) {
+    auto sample_shape = shape.tensor_shape_span(stack_samples[s]);
+    auto stack_shape = stack_shapes.tensor_shape_span(s);
+    for (int d = first_spatial_dim, od = 0; od < spatial_ndim; d++, od++)
+      stack_shape[od] = sample_shape[d];
+    stack_shape[0] *= stack_frames[s];
+    stack_shape[frame_ndim - 1] = volume(&sample_shape[first_spatial_dim + spatial_ndim],
+                                         &sample_shape[ndim]);
+  }
+}
+
 template <int out_ndim, int in_ndim>
 void GetResizedShape(
       TensorListShape<out_ndim> &out_shape, const TensorListShape<in_ndim> &in_shape,
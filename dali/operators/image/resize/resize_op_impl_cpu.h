@@ -23,6 +23,7 @@
 #include <cmath>
 #include <vector>
 #include "dali/operators/image/resize/resize_op_impl.h"
+#include "dali/kernels/common/split_shape.h"
 #include "dali/kernels/imgproc/resample_cpu.h"
 
 namespace dali {
@@ -30,7 +31,8 @@ namespace dali {
 template <typename Out, typename In, int spatial_ndim>
 class ResizeOpImplCPU : public ResizeBase<CPUBackend>::Impl {
  public:
-  explicit ResizeOpImplCPU(kernels::KernelManager &kmgr) : kmgr_(kmgr) {}
+  ResizeOpImplCPU(kernels::KernelManager &kmgr, int num_threads)
+  : kmgr_(kmgr), num_threads_(num_threads) {}
 
   static_assert(spatial_ndim == 2 || spatial_ndim == 3, "Only 2D and 3D resizing is supported");
 
@@ -55,20 +57,44 @@ class ResizeOpImplCPU : public ResizeBase<CPUBackend>::Impl {
     GetResizedShape(out_shape_, in_shape_, make_cspan(params_), 0);
 
     // Now that we know how many logical frames there are, calculate batch subdivision.
-    OnNumFramesUpdated();
+    SetupTiles();
+    OnNumTilesUpdated();
 
     SetupKernel();
   }
 
+  /**
+   * @brief Divides the frames into tiles - ranges of the outermost spatial dimension
+   *        (rows or planes) of the output
+   *
+   * When there are fewer frames than threads, large frames are resized in multiple tiles,
+   * each of which uses a subrange of the frame's ROI in the outermost dimension.
+   */
+  void SetupTiles() {
+    int N = GetNumFrames();
+    int64_t total_volume = out_shape_.num_elements();
+    tiles_.clear();
+    tile_params_.clear();
+    for (int i = 0; i < N; i++) {
+      int64_t rows = out_shape_.tensor_shape_span(i)[0];
+      int ntiles = kernels::num_outer_ranges(volume(out_shape_.tensor_shape_span(i)),
+                                             total_volume, rows, N, num_threads_);
+      for (int t = 0; t < ntiles; t++) {
+        Tile tile = { i, rows * t / ntiles, rows * (t + 1) / ntiles };
+        tiles_.push_back(tile);
+        tile_params_.push_back(TileParams(tile));
+      }
+    }
+  }
+
   void SetupKernel() {
-    const int dim = in_shape_.sample_dim();
     kernels::KernelContext ctx;
 
-    for (int i = 0; i < GetNumFrames(); i++) {
+    for (int t = 0; t < GetNumTiles(); t++) {
       kernels::InTensorCPU<In, frame_ndim> dummy_input;
-      dummy_input.shape = in_shape_[i];
-      kernels::KernelRequirements &req = kmgr_.Setup<Kernel>(i, ctx, dummy_input, params_[i]);
-      assert(req.output_shapes[0][0] == out_shape_[i]);
+      dummy_input.shape = in_shape_[tiles_[t].frame];
+      kernels::KernelRequirements &req = kmgr_.Setup<Kernel>(t, ctx, dummy_input, tile_params_[t]);
+      assert(req.output_shapes[0][0][0] == tiles_[t].row_end - tiles_[t].row_begin);
     }
   }
 
@@ -81,12 +107,16 @@ class ResizeOpImplCPU : public ResizeBase<CPUBackend>::Impl {
 
     ThreadPool &tp = ws.GetThreadPool();
 
-    for (int i = 0; i < GetNumFrames(); i++) {
-      auto work = [&, i](int tid) {
+    for (int t = 0; t < GetNumTiles(); t++) {
+      const Tile &tile = tiles_[t];
+      int i = tile.frame;
+      auto work = [&, t, i](int tid) {
         kernels::KernelContext ctx;
-        auto out_frame = out_frames_view[i];
+        auto out_tile = out_frames_view[i];
+        out_tile.data += tiles_[t].row_begin * volume(out_tile.shape.last(frame_ndim - 1));
+        out_tile.shape[0] = tiles_[t].row_end - tiles_[t].row_begin;
         auto in_frame = in_frames_view[i];
-        kmgr_.Run<Kernel>(i, ctx, out_frame, in_frame, params_[i]);
+        kmgr_.Run<Kernel>(t, ctx, out_tile, in_frame, tile_params_[t]);
       };
 
       double out_size = volume(out_frames_view.shape.tensor_shape_span(i));
@@ -102,13 +132,16 @@ class ResizeOpImplCPU : public ResizeBase<CPUBackend>::Impl {
         // NOTE: This does not account for cost of antialiasing!
         cost += std::pow(std::pow(out_size, spatial_ndim - i) * pow(in_size, i), root);
       }
+      int64_t rows = out_frames_view.shape.tensor_shape_span(i)[0];
+      if (tile.row_end - tile.row_begin < rows)
+        cost = cost * (tile.row_end - tile.row_begin) / rows;
       tp.AddWork(work, std::llround(cost));
     }
     tp.RunAll();
   }
 
-  void OnNumFramesUpdated() {
-    int N = GetNumFrames();
+  void OnNumTilesUpdated() {
+    int N = GetNumTiles();
     if (static_cast<int>(kmgr_.NumInstances()) < N)
       kmgr_.Resize<Kernel>(N);
   }
@@ -117,10 +150,43 @@ class ResizeOpImplCPU : public ResizeBase<CPUBackend>::Impl {
     return in_shape_.num_samples();
   }
 
+  int GetNumTiles() const {
+    return tiles_.size();
+  }
+
+  struct Tile {
+    int frame;
+    int64_t row_begin, row_end;
+  };
+
+  /**
+   * @brief Calculates the resampling parameters of a tile
+   *
+   * The ROI in the outermost dimension is narrowed to the part which maps to the tile's rows;
+   * the filters read the input outside of the ROI, so the tiles produce the same result as
+   * resizing the whole frame.
+   */
+  ResamplingParamsND<spatial_ndim> TileParams(const Tile &tile) const {
+    auto params = params_[tile.frame];
+    int64_t rows = out_shape_.tensor_shape_span(tile.frame)[0];
+    if (tile.row_begin == 0 && tile.row_end == rows)
+      return params;
+    auto &p = params[0];
+    double start = p.roi.use_roi ? p.roi.start : 0;
+    double end = p.roi.use_roi ? p.roi.end : in_shape_.tensor_shape_span(tile.frame)[0];
+    p.roi = kernels::ResamplingParams::ROI(start + (end - start) * tile.row_begin / rows,
+                                           start + (end - start) * tile.row_end / rows);
+    p.output_size = tile.row_end - tile.row_begin;
+    return params;
+  }
+
   kernels::KernelManager &kmgr_;
+  int num_threads_;
 
   TensorListShape<frame_ndim> in_shape_, out_shape_;
   std::vector<ResamplingParamsND<spatial_ndim>> params_;
+  std::vector<Tile> tiles_;
+  std::vector<ResamplingParamsND<spatial_ndim>> tile_params_;
 };
 
 }  // namespace dali
@@ -19,10 +19,12 @@
 #error This file is a part of resize base implementation and should not be included elsewhere
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 #include "dali/operators/image/resize/resize_op_impl.h"
 #include "dali/kernels/imgproc/resample.h"
+#include "dali/kernels/imgproc/resample/resampling_setup.h"
 
 namespace dali {
 
@@ -48,16 +50,26 @@ class ResizeOpImplGPU : public ResizeBase<GPUBackend>::Impl {
     // Calculate output shape of the input, as supplied (sequences, planar images, etc)
     GetResizedShape(out_shape, in_shape, params, spatial_ndim, first_spatial_dim);
 
-    // Create "frames" from outer dimensions and "channels" from inner dimensions.
-    GetFrameShapesAndParams<spatial_ndim>(in_shape_, params_, in_shape, params,
-                                          first_spatial_dim);
-
-    // Now that we have per-frame parameters, we can calculate the output shape of the
-    // effective frames (from videos, channel planes, etc).
-    GetResizedShape(out_shape_, in_shape_, make_cspan(params_), 0);
+    // Stack the "frames" from outer dimensions and create "channels" from inner dimensions.
+    // The frames of a stack share the sample descriptor of the kernel, which resamples them
+    // in the same launch, instead of replicating the parameters for each frame.
+    int frame_limit = kernels::resampling::BatchResamplingSetup<spatial_ndim>::frame_limit;
+    int max_stack_frames = std::min(minibatch_size_, frame_limit);
+    GetFrameStacks<spatial_ndim>(in_shape_, num_frames_, stack_samples_, in_shape,
+                                 first_spatial_dim, max_stack_frames);
+    // The leading dimensions of the output are the same, so are the stacks.
+    GetFrameStacks<spatial_ndim>(out_shape_, num_frames_, stack_samples_, out_shape,
+                                 first_spatial_dim, max_stack_frames);
+
+    int num_stacks = in_shape_.num_samples();
+    params_.resize(num_stacks);
+    for (int s = 0; s < num_stacks; s++) {
+      for (int d = 0; d < spatial_ndim; d++)
+        params_[s][d] = params[stack_samples_[s] * spatial_ndim + d];
+    }
 
     // Now that we know how many logical frames there are, calculate batch subdivision.
-    SetNumFrames(in_shape_.num_samples());
+    SetNumFrames(num_stacks);
 
     SetupKernel();
   }
@@ -76,7 +88,9 @@ class ResizeOpImplGPU : public ResizeBase<GPUBackend>::Impl {
       }
 
       auto param_slice = make_span(&params_[mb.start], mb.count);
-      kernels::KernelRequirements &req = kmgr_.Setup<Kernel>(mb_idx, ctx, mb.input, param_slice);
+      auto frames_slice = make_cspan(&num_frames_[mb.start], mb.count);
+      kernels::KernelRequirements &req = kmgr_.Setup<Kernel>(mb_idx, ctx, mb.input, param_slice,
+                                                              frames_slice);
       mb.out_shape = req.output_shapes[0].to_static<frame_ndim>();
     }
   }
@@ -103,29 +117,37 @@ class ResizeOpImplGPU : public ResizeBase<GPUBackend>::Impl {
     }
   }
 
-  void SetNumFrames(int n) {
-    int num_minibatches = CalculateMinibatchPartition(n, minibatch_size_);
+  void SetNumFrames(int num_stacks) {
+    int num_minibatches = CalculateMinibatchPartition(num_stacks, minibatch_size_);
     if (static_cast<int>(kmgr_.NumInstances()) < num_minibatches)
       kmgr_.Resize<Kernel>(num_minibatches);
   }
 
-  int CalculateMinibatchPartition(int total_frames, int minibatch_size) {
-    int num_minibatches = div_ceil(total_frames, minibatch_size);
-
-    minibatches_.resize(num_minibatches);
-    int start = 0;
-    for (int i = 0; i < num_minibatches; i++) {
-      int end = (i + 1) * total_frames / num_minibatches;
-      auto &mb = minibatches_[i];
-      mb.start = start;
-      mb.count = end - start;
-      start = end;
+  /**
+   * @brief Divides the stacks into minibatches of at most `minibatch_size` frames
+   *
+   * A stack is never split - it has at most `minibatch_size` frames, see GetFrameStacks.
+   */
+  int CalculateMinibatchPartition(int num_stacks, int minibatch_size) {
+    minibatches_.clear();
+    int frames = 0;
+    for (int s = 0; s < num_stacks; s++) {
+      if (minibatches_.empty() || frames + num_frames_[s] > minibatch_size) {
+        minibatches_.emplace_back();
+        minibatches_.back().start = s;
+        minibatches_.back().count = 0;
+        frames = 0;
+      }
+      minibatches_.back().count++;
+      frames += num_frames_[s];
     }
-    return num_minibatches;
+    return minibatches_.size();
   }
 
+  /// The shapes of the frame stacks; the frames are stacked along the outermost spatial dim
   TensorListShape<frame_ndim> in_shape_, out_shape_;
   std::vector<ResamplingParamsND<spatial_ndim>> params_;
+  std::vector<int> num_frames_, stack_samples_;
 
   kernels::KernelManager &kmgr_;
 
@@ -0,0 +1,191 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/imgcodec/image_decoder.h"
+#include <string>
+#include <type_traits>
+#include "dali/imgcodec/util/output_shape.h"
+
+namespace dali {
+
+DALI_SCHEMA(experimental__decoders__Image)
+  .DocStr(R"code(Decodes images with the image codec library.
+
+Each batch is split between the decoders available for the image formats - with the ``mixed``
+backend, the GPU decoders and the CPU ones (which decode with the operator's threads) run at
+the same time. The split is based on the decoding times measured in the previous iterations,
+so that the decoders finish their parts of the batch at the same time.
+
+If a decoder fails to decode an image, the image is passed to the next decoder which supports
+its format.
+
+The output of the decoder is in *HWC* layout, unless ``output_layout`` is set to *CHW*.
+
+With the ``mixed`` backend, the conversion to the planar layout, the normalization and
+the mirroring are done while the decoded pixels are written to the output, so that
+a separate pass (e.g. with :meth:`nvidia.dali.fn.crop_mirror_normalize`) is not needed.
+
+Supported formats: JPG, BMP, PNG, TIFF, PNM, PPM, PGM, PBM, JPEG 2000, WebP.)code")
+  .NumInput(1)
+  .NumOutput(1)
+  .AddOptionalArg("output_type",
+      R"code(The color space of the output image.)code",
+      DALI_RGB)
+  .AddOptionalTypeArg("dtype",
+      R"code(The output data type of the image.
+
+The values are scaled to the dynamic range of the type.)code",
+      DALI_UINT8)
+  .AddOptionalArg("output_layout",
+      R"code(Tensor data layout for the output - *HWC* or *CHW*.
+
+*CHW* is supported only by the ``mixed`` backend.)code",
+      TensorLayout("HWC"))
+  .AddOptionalArg("mean",
+      R"code(Mean pixel values for image normalization.
+
+The values are in the dynamic range of ``dtype`` (e.g. [0, 1] for float). A single value
+applies to all channels. Requires a floating point ``dtype`` and is supported only by
+the ``mixed`` backend.)code",
+      std::vector<float>{})
+  .AddOptionalArg("std",
+      R"code(Standard deviation values for image normalization.
+
+The values are in the dynamic range of ``dtype`` (e.g. [0, 1] for float). A single value
+applies to all channels. Requires a floating point ``dtype`` and is supported only by
+the ``mixed`` backend.)code",
+      std::vector<float>{})
+  .AddOptionalArg("mirror",
+      R"code(If set to True, the image is flipped (mirrored) horizontally.
+
+Supported only by the ``mixed`` backend.)code",
+      false)
+  .AddOptionalArg("adjust_orientation",
+      R"code(Uses the EXIF orientation metadata to rectify the images.)code",
+      true)
+  .AddOptionalArg("affine",
+      R"code(Applies **only** to the ``mixed`` backend type.
+
+If set to True, each thread in the internal thread pool will be tied to a specific CPU core.
+Otherwise, the threads can be reassigned to any CPU core by the operating system.)code",
+      true);
+
+template <typename Backend>
+ImgcodecDecoder<Backend>::ImgcodecDecoder(const OpSpec &spec) : Operator<Backend>(spec) {
+  opts_.format = spec.GetArgument<DALIImageType>("output_type");
+  opts_.dtype = spec.GetArgument<DALIDataType>("dtype");
+  opts_.use_orientation = spec.GetArgument<bool>("adjust_orientation");
+  auto layout = spec.GetArgument<TensorLayout>("output_layout");
+  DALI_ENFORCE(layout == "HWC" || layout == "CHW",
+               make_string("The output layout must be HWC or CHW, got: ", layout, "."));
+  opts_.planar = layout == "CHW";
+  for (float m : spec.GetRepeatedArgument<float>("mean"))
+    opts_.mean.push_back(m);
+  for (float s : spec.GetRepeatedArgument<float>("std")) {
+    DALI_ENFORCE(s > 0, "The standard deviation must be positive.");
+    opts_.stddev.push_back(s);
+  }
+  opts_.mirror = spec.GetArgument<bool>("mirror");
+  DALI_ENFORCE((opts_.mean.empty() && opts_.stddev.empty()) || IsFloatingPoint(opts_.dtype),
+               "The normalization requires a floating point ``dtype``.");
+  DALI_ENFORCE(std::is_same<Backend, MixedBackend>::value || !opts_.needs_postprocessing(),
+               "The ``output_layout`` CHW, ``mean``, ``std`` and ``mirror`` are supported "
+               "only by the mixed backend.");
+  int device_id = std::is_same<Backend, MixedBackend>::value
+                      ? spec.GetArgument<int>("device_id")
+                      : CPU_ONLY_DEVICE_ID;
+  decoder_ = std::make_unique<imgcodec::ImageDecoder>(device_id, true);
+}
+
+template <typename Backend>
+imgcodec::ImageInfo ImgcodecDecoder<Backend>::GetInfo(const DALIMeta &meta,
+                                                      imgcodec::ImageSource *src) {
+  // the reader may have parsed the header already
+  if (!meta.HasImageInfo())
+    return decoder_->GetInfo(src);
+  auto &parsed = meta.GetImageInfo();
+  imgcodec::ImageInfo info;
+  info.shape = parsed.shape;
+  info.orientation = {parsed.rotate, parsed.flip_x, parsed.flip_y};
+  return info;
+}
+
+template <typename Backend>
+bool ImgcodecDecoder<Backend>::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                         const workspace_t<Backend> &ws) {
+  const auto &input = ws.template Input<CPUBackend>(0);
+  DALI_ENFORCE(input.type() == DALI_UINT8,
+               make_string("The input must be stored as uint8 data, got: ", input.type(), "."));
+  int nsamples = input.num_samples();
+  sources_.clear();
+  source_ptrs_.clear();
+  sources_.reserve(nsamples);
+  output_desc.resize(1);
+  output_desc[0].type = opts_.dtype;
+  output_desc[0].shape.resize(nsamples, 3);
+  for (int i = 0; i < nsamples; i++) {
+    DALI_ENFORCE(input.tensor_shape(i).sample_dim() == 1,
+                 "The input must be a batch of 1D encoded images.");
+    sources_.push_back(imgcodec::ImageSource::FromHostMem(
+        input.raw_tensor(i), volume(input.tensor_shape(i)), input.GetMeta(i).GetSourceInfo()));
+    source_ptrs_.push_back(&sources_.back());
+    auto info = GetInfo(input.GetMeta(i), source_ptrs_.back());
+    TensorShape<> shape;
+    imgcodec::OutputShape(shape, info, opts_, {});
+    output_desc[0].shape.set_tensor_shape(i, shape);
+  }
+  return true;
+}
+
+template <typename Backend>
+template <typename OutBackend>
+void ImgcodecDecoder<Backend>::Decode(TensorList<OutBackend> &output,
+                                      imgcodec::DecodeContext ctx) {
+  int nsamples = source_ptrs_.size();
+  std::vector<SampleView<OutBackend>> out(nsamples);
+  for (int i = 0; i < nsamples; i++)
+    out[i] = output[i];
+  auto results = decoder_->Decode(ctx, make_span(out), make_cspan(source_ptrs_), opts_);
+  for (int i = 0; i < nsamples; i++) {
+    if (!results[i].success) {
+      try {
+        std::rethrow_exception(results[i].exception);
+      } catch (std::exception &e) {
+        DALI_FAIL(make_string(e.what(), " File: ", sources_[i].SourceInfo()));
+      }
+    }
+  }
+  output.SetLayout(opts_.planar ? "CHW" : "HWC");
+}
+
+template class ImgcodecDecoder<CPUBackend>;
+template class ImgcodecDecoder<MixedBackend>;
+
+void ImgcodecHostDecoder::RunImpl(HostWorkspace &ws) {
+  Decode(ws.Output<CPUBackend>(0), {&ws.GetThreadPool(), cudaStream_t(-1)});
+}
+
+ImgcodecMixedDecoder::ImgcodecMixedDecoder(const OpSpec &spec)
+    : ImgcodecDecoder<MixedBackend>(spec),
+      thread_pool_(spec.GetArgument<int>("num_threads"), spec.GetArgument<int>("device_id"),
+                   spec.GetArgument<bool>("affine"), "imgcodec decoder") {}
+
+void ImgcodecMixedDecoder::Run(MixedWorkspace &ws) {
+  Decode(ws.Output<GPUBackend>(0), {&thread_pool_, ws.stream()});
+}
+
+DALI_REGISTER_OPERATOR(experimental__decoders__Image, ImgcodecHostDecoder, CPU);
+DALI_REGISTER_OPERATOR(experimental__decoders__Image, ImgcodecMixedDecoder, Mixed);
+
+}  // namespace dali
@@ -0,0 +1,80 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_IMGCODEC_IMAGE_DECODER_H_
+#define DALI_OPERATORS_IMGCODEC_IMAGE_DECODER_H_
+
+#include <memory>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/imgcodec/image_decoder.h"
+#include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+
+/**
+ * @brief Decodes the images with imgcodec, splitting each batch between the available decoders
+ */
+template <typename Backend>
+class ImgcodecDecoder : public Operator<Backend> {
+ public:
+  explicit ImgcodecDecoder(const OpSpec &spec);
+
+  ~ImgcodecDecoder() override = default;
+  DISABLE_COPY_MOVE_ASSIGN(ImgcodecDecoder);
+
+ protected:
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override;
+
+  /**
+   * @brief Gets the image info attached to the sample by the reader, or parses the image
+   */
+  imgcodec::ImageInfo GetInfo(const DALIMeta &meta, imgcodec::ImageSource *src);
+
+  template <typename OutBackend>
+  void Decode(TensorList<OutBackend> &output, imgcodec::DecodeContext ctx);
+
+  imgcodec::DecodeParams opts_;
+  std::unique_ptr<imgcodec::ImageDecoder> decoder_;
+  std::vector<imgcodec::ImageSource> sources_;
+  std::vector<imgcodec::ImageSource *> source_ptrs_;
+};
+
+class ImgcodecHostDecoder : public ImgcodecDecoder<CPUBackend> {
+ public:
+  explicit ImgcodecHostDecoder(const OpSpec &spec) : ImgcodecDecoder<CPUBackend>(spec) {}
+
+ protected:
+  using Operator<CPUBackend>::RunImpl;
+  void RunImpl(HostWorkspace &ws) override;
+};
+
+class ImgcodecMixedDecoder : public ImgcodecDecoder<MixedBackend> {
+ public:
+  explicit ImgcodecMixedDecoder(const OpSpec &spec);
+
+  void Run(MixedWorkspace &ws) override;
+
+ private:
+  ThreadPool thread_pool_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_IMGCODEC_IMAGE_DECODER_H_
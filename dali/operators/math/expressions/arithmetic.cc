@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -25,15 +25,30 @@ void ArithmeticGenericOp<CPUBackend>::RunImpl(HostWorkspace &ws) {
                                    spec_);
   auto &pool = ws.GetThreadPool();
   ws.Output<CPUBackend>(0).SetLayout(result_layout_);
+  // Every node except for the root writes its results for the tile to a per-thread buffer
+  size_t num_intermediate = exec_order_.size() - 1;
+  intermediate_buffers_.resize(pool.NumThreads() * num_intermediate * kTileSize);
   for (size_t task_idx = 0; task_idx < tile_range_.size(); task_idx++) {
-    pool.AddWork([this, task_idx](int thread_idx) {
+    pool.AddWork([this, task_idx, num_intermediate](int thread_idx) {
       auto range = tile_range_[task_idx];
+      auto *buffers = intermediate_buffers_.data() + thread_idx * num_intermediate * kTileSize;
+      std::vector<ExtendedTileDesc> tiles(exec_order_.size());
       // Go over "tiles"
       for (int extent_idx = range.begin; extent_idx < range.end; extent_idx++) {
         // Go over expression tree in some provided order
         for (size_t i = 0; i < exec_order_.size(); i++) {
-          exec_order_[i].impl->Execute(exec_order_[i].ctx, tiles_per_task_[i],
-                                       {extent_idx, extent_idx + 1});
+          auto &tile = tiles[i];
+          tile = tiles_per_task_[i][extent_idx];
+          if (i < num_intermediate) {
+            tile.output = buffers + i * kTileSize;
+          }
+          for (size_t j = 0; j < subexpr_tasks_[i].size(); j++) {
+            if (subexpr_tasks_[i][j] >= 0) {
+              tile.args[j] = tiles[subexpr_tasks_[i][j]].output;
+            }
+          }
+          int task = i;
+          exec_order_[i].impl->Execute(exec_order_[i].ctx, tiles, {task, task + 1});
         }
       }
     }, -task_idx);  // FIFO order, since the work is already divided to similarly sized chunks
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,18 +12,147 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <tuple>
+#include <vector>
+
+#include "dali/core/static_switch.h"
+#include "dali/kernels/dynamic_scratchpad.h"
 #include "dali/kernels/type_tag.h"
 #include "dali/operators/math/expressions/arithmetic.h"
 
 namespace dali {
 
+#define FUSED_BIN_OPS                                                                      \
+  (ArithmeticOp::add, ArithmeticOp::sub, ArithmeticOp::mul, ArithmeticOp::div,             \
+  ArithmeticOp::fdiv, ArithmeticOp::mod, ArithmeticOp::min, ArithmeticOp::max,             \
+  ArithmeticOp::pow, ArithmeticOp::fpow, ArithmeticOp::atan2)
+
+/**
+ * @brief Apply the `op` to the `arity` values from `args`
+ */
+__device__ float ApplyFusedOp(ArithmeticOp op, int arity, const float *args) {
+  float result = 0.f;
+  if (arity == 1) {
+    VALUE_SWITCH(op, op_static, ALLOWED_UN_OPS, (
+      result = arithm_meta<op_static, GPUBackend>::impl(args[0]);
+    ), ());  // NOLINT(whitespace/parens)
+  } else if (arity == 2) {
+    VALUE_SWITCH(op, op_static, FUSED_BIN_OPS, (
+      result = arithm_meta<op_static, GPUBackend>::impl(args[0], args[1]);
+    ), ());  // NOLINT(whitespace/parens)
+  } else {
+    VALUE_SWITCH(op, op_static, ALLOWED_TERNARY_OPS, (
+      result = arithm_meta<op_static, GPUBackend>::impl(args[0], args[1], args[2]);
+    ), ());  // NOLINT(whitespace/parens)
+  }
+  return result;
+}
+
+/**
+ * @brief Run the stack machine program `prog` for the element `idx`
+ */
+__device__ float EvaluateFused(const FusedExprProgram &prog, const void *const *operands,
+                               int64_t idx) {
+  float stack[kMaxFusedStackDepth];
+  int top = 0;
+  for (int i = 0; i < prog.num_instr; i++) {
+    const auto &instr = prog.instr[i];
+    if (instr.kind == FusedInstrKind::Load) {
+      stack[top++] = expression_detail::Access<float>(operands[instr.operand], idx, instr.type);
+    } else if (instr.kind == FusedInstrKind::LoadScalar) {
+      stack[top++] = expression_detail::Access<float>(operands[instr.operand], 0, instr.type);
+    } else {
+      top -= instr.arity;
+      stack[top] = ApplyFusedOp(instr.op, instr.arity, &stack[top]);
+      top++;
+    }
+  }
+  return stack[0];
+}
+
+/**
+ * @brief Go over all tiles and evaluate the whole expression for every element of the tile.
+ *
+ * The operands of the tile `blockIdx.y` start at `operands + blockIdx.y * prog.num_operands`.
+ */
+__global__ void ExecuteTiledFusedExpr(const FusedExprTile *tiles, const void *const *operands,
+                                      FusedExprProgram prog) {
+  const auto &tile = tiles[blockIdx.y];
+  const void *const *tile_operands = operands + blockIdx.y * prog.num_operands;
+  int64_t start_ofs = static_cast<int64_t>(blockDim.x) * blockIdx.x + threadIdx.x;
+  int64_t stride = static_cast<int64_t>(blockDim.x) * gridDim.x;
+  for (int64_t idx = start_ofs; idx < tile.extent_size; idx += stride) {
+    tile.output[idx] = EvaluateFused(prog, tile_operands, idx);
+  }
+}
+
+template <>
+void ArithmeticGenericOp<GPUBackend>::RunFused(DeviceWorkspace &ws) {
+  const auto &root_tiles = tiles_per_task_.back();
+  int num_tiles = root_tiles.size();
+  if (num_tiles == 0) {
+    return;
+  }
+  fused_tiles_.resize(num_tiles);
+  fused_operand_ptrs_.resize(num_tiles * fused_operands_.size());
+  for (int t = 0; t < num_tiles; t++) {
+    fused_tiles_[t] = {static_cast<float *>(root_tiles[t].output), root_tiles[t].desc.extent_size};
+    for (size_t k = 0; k < fused_operands_.size(); k++) {
+      fused_operand_ptrs_[t * fused_operands_.size() + k] =
+          GetLeafPointer(*fused_operands_[k], ws, constant_storage_, tile_cover_[t]);
+    }
+  }
+  kernels::DynamicScratchpad s({}, ws.stream());
+  const FusedExprTile *tiles_gpu;
+  const InputSamplePtr *operands_gpu;
+  std::tie(tiles_gpu, operands_gpu) =
+      s.ToContiguousGPU(ws.stream(), fused_tiles_, fused_operand_ptrs_);
+  // Same launch configuration as for the separate nodes, @see ExprImplGPUInvoke
+  ExecuteTiledFusedExpr<<<dim3(64, num_tiles, 1), dim3(256, 1, 1), 0, ws.stream()>>>(
+      tiles_gpu, operands_gpu, fused_program_);
+  CUDA_CALL(cudaGetLastError());
+}
+
 template <>
 void ArithmeticGenericOp<GPUBackend>::RunImpl(DeviceWorkspace &ws) {
   PrepareTilesForTasks<GPUBackend>(tiles_per_task_, exec_order_, tile_cover_, ws, constant_storage_,
                                    spec_);
   ws.Output<GPUBackend>(0).SetLayout(result_layout_);
   assert(tile_range_.size() == 1 && "Expected to cover whole GPU execution by 1 task");
+  if (fused_) {
+    RunFused(ws);
+    return;
+  }
+  // The results of the subexpressions are stored in the buffers for the whole batch,
+  // the scalar-like ones take one element per tile
+  kernels::DynamicScratchpad s({}, ws.stream());
+  std::vector<int64_t> sample_offsets(result_shape_.num_samples());
+  for (int i = 1; i < result_shape_.num_samples(); i++) {
+    sample_offsets[i] = sample_offsets[i - 1] + result_shape_[i - 1].num_elements();
+  }
+  for (size_t i = 0; i + 1 < exec_order_.size(); i++) {
+    auto &node = *exec_order_[i].ctx.node;
+    auto type_size = TypeTable::GetTypeInfo(node.GetTypeId()).size();
+    bool is_scalar = IsScalarLike(node.GetShape());
+    auto num_elements = is_scalar ? tile_cover_.size() : result_shape_.num_elements();
+    auto *buffer = s.AllocateGPU<uint8_t>(num_elements * type_size, 8);
+    for (size_t t = 0; t < tile_cover_.size(); t++) {
+      const auto &tile = tile_cover_[t];
+      int64_t offset = is_scalar ? t : sample_offsets[tile.sample_idx] +
+                                           tile.tile_size * tile.extent_idx;
+      tiles_per_task_[i][t].output = buffer + offset * type_size;
+    }
+  }
   for (size_t i = 0; i < exec_order_.size(); i++) {
+    for (size_t j = 0; j < subexpr_tasks_[i].size(); j++) {
+      int task = subexpr_tasks_[i][j];
+      if (task < 0) {
+        continue;
+      }
+      for (size_t t = 0; t < tile_cover_.size(); t++) {
+        tiles_per_task_[i][t].args[j] = tiles_per_task_[task][t].output;
+      }
+    }
     // call impl for whole batch
     exec_order_[i].impl->Execute(exec_order_[i].ctx, tiles_per_task_[i], tile_range_[0]);
   }
@@ -28,6 +28,7 @@
 #include "dali/core/tensor_shape_print.h"
 #include "dali/kernels/type_tag.h"
 #include "dali/operators/math/expressions/arithmetic_meta.h"
+#include "dali/operators/math/expressions/expression_fused.h"
 #include "dali/operators/math/expressions/expression_impl_factory.h"
 #include "dali/pipeline/operator/operator.h"
 
@@ -40,11 +41,13 @@ using TileCover = std::tuple<std::vector<TileDesc>, std::vector<TileRange>>;
 
 /**
  * @brief Divide the shape into groups of linear tiles
+ *
+ * The storage of `descs` and `ranges` is reused, so that the cover can be recalculated in every
+ * iteration without allocating memory.
  */
-inline TileCover GetTiledCover(const TensorListShape<> &shape, int tile_size,
-                               int num_tiles_in_task) {
-  Index total_elements = shape.num_elements();
-  std::vector<TileDesc> descs;
+inline void GetTiledCover(std::vector<TileDesc> &descs, std::vector<TileRange> &ranges,
+                          const TensorListShape<> &shape, int tile_size, int num_tiles_in_task) {
+  descs.clear();
   for (int sample_idx = 0; sample_idx < shape.num_samples(); sample_idx++) {
     int extent_idx = 0;
     Index sample_elements = shape[sample_idx].num_elements();
@@ -55,14 +58,20 @@ inline TileCover GetTiledCover(const TensorListShape<> &shape, int tile_size,
     }
   }
   Index num_tasks = (descs.size() + num_tiles_in_task - 1) / num_tiles_in_task;
-  std::vector<TileRange> ranges;
+  ranges.clear();
   ranges.reserve(num_tasks);
   for (int task = 0, tiles_used = 0; task < num_tasks; task++) {
     auto tiles_end = std::min(tiles_used + num_tiles_in_task, static_cast<int>(descs.size()));
     ranges.push_back({tiles_used, tiles_end});
     tiles_used = tiles_end;
   }
-  return std::make_tuple(descs, ranges);
+}
+
+inline TileCover GetTiledCover(const TensorListShape<> &shape, int tile_size,
+                               int num_tiles_in_task) {
+  TileCover cover;
+  GetTiledCover(std::get<0>(cover), std::get<1>(cover), shape, tile_size, num_tiles_in_task);
+  return cover;
 }
 
 /**
@@ -155,9 +164,9 @@ inline std::vector<ExprImplTask> CreateExecutionTasks(const ExprNode &expr, Expr
   return result;
 }
 
-inline TensorListShape<> ShapePromotion(const std::string &op,
-                                        span<const TensorListShape<> *> shapes,
-                                        int batch_size) {
+inline const TensorListShape<> &ShapePromotion(const std::string &op,
+                                               span<const TensorListShape<> *> shapes,
+                                               int batch_size) {
   const TensorListShape<> *out_shape = nullptr;
   bool only_scalars = true;
   for (int i = 0; i < shapes.size(); i++) {
@@ -288,7 +297,13 @@ inline void CheckAllowedOperations(ExprNode &expr) {
  * @brief Arithmetic operator capable of executing expression tree of element-wise
  *        arithmetic operations.
  *
- * Only expressions consisting of one function node with tensor inputs are now supported.
+ * The function nodes are executed in postorder, tile by tile. The results of the function
+ * subexpressions are stored in intermediate buffers:
+ * - For CPUBackend the buffers are per-thread and hold only one tile, so that the whole
+ *   expression is evaluated for the tile while it is still in the cache.
+ * - For GPUBackend, expressions that produce floats in every node are evaluated
+ *   by one kernel (@see FusedExprProgram), without any intermediate buffers in memory.
+ *   Other expressions are executed node by node with the buffers covering the whole batch.
  *
  * There are 3 levels for unit of work.
  * - Thread (CPUBackend) or CUDA kernel invokation (GPUBackend)
@@ -332,11 +347,15 @@ class ArithmeticGenericOp : public Operator<Backend> {
     }
 
     result_shape_ = PropagateShapes<Backend>(*expr_, ws, curr_batch_size);
+    exec_order_.clear();
+    CreateExecutionTasks<Backend>(exec_order_, *expr_, cache_, ws.has_stream() ? ws.stream() : 0);
     AllocateIntermediateNodes();
-    exec_order_ = CreateExecutionTasks<Backend>(*expr_, cache_, ws.has_stream() ? ws.stream() : 0);
+    if (std::is_same<Backend, GPUBackend>::value) {
+      fused_ = exec_order_.size() > 1 && CompileFusedExpr(fused_program_, fused_operands_, *expr_);
+    }
 
     output_desc[0] = {result_shape_, result_type_id_};
-    std::tie(tile_cover_, tile_range_) = GetTiledCover(result_shape_, kTileSize, kTaskSize);
+    GetTiledCover(tile_cover_, tile_range_, result_shape_, kTileSize, kTaskSize);
     return true;
   }
 
@@ -344,22 +363,31 @@ class ArithmeticGenericOp : public Operator<Backend> {
   void RunImpl(workspace_t<Backend> &ws) override;
 
  private:
+  /**
+   * @brief Find the tasks that compute the function subexpressions of every task, so that
+   *        their results can be passed through the intermediate buffers.
+   */
   void AllocateIntermediateNodes() {
-    auto &expr = *expr_;
-    bool is_simple_expression = expr.GetNodeType() == NodeType::Function &&
-                                expr.GetSubexpressionCount() > 0 &&
-                                expr.GetSubexpressionCount() <= kMaxArity;
-    auto &func = dynamic_cast<ExprFunc &>(expr);
-    for (int i = 0; i < func.GetSubexpressionCount(); i++) {
-      is_simple_expression = is_simple_expression && func[i].GetNodeType() != NodeType::Function;
+    DALI_ENFORCE(expr_->GetNodeType() == NodeType::Function,
+                 "The root of the expression tree must be a function node.");
+    subexpr_tasks_.resize(exec_order_.size());
+    for (size_t i = 0; i < exec_order_.size(); i++) {
+      auto &func = dynamic_cast<const ExprFunc &>(*exec_order_[i].ctx.node);
+      subexpr_tasks_[i].clear();
+      subexpr_tasks_[i].resize(func.GetSubexpressionCount(), -1);
+      // The subexpressions precede their parent in the execution order
+      for (size_t task = 0; task < i; task++) {
+        for (int j = 0; j < func.GetSubexpressionCount(); j++) {
+          if (exec_order_[task].ctx.node == &func[j]) {
+            subexpr_tasks_[i][j] = task;
+          }
+        }
+      }
     }
-
-    DALI_ENFORCE(is_simple_expression,
-                 "Complex expression trees are not yet supported. Only expressions containing one "
-                 "function node with one or two inputs are supported.");
-    // TODO(klecki): allocate memory for intermediate results and point the threads to them
   }
 
+  void RunFused(workspace_t<Backend> &ws);
+
   std::unique_ptr<ExprNode> expr_;
   TensorListShape<> result_shape_;
   bool types_layout_inferred_ = false;
@@ -369,6 +397,15 @@ class ArithmeticGenericOp : public Operator<Backend> {
   std::vector<TileRange> tile_range_;
   std::vector<ExprImplTask> exec_order_;
   std::vector<std::vector<ExtendedTileDesc>> tiles_per_task_;
+  // For every task, the indices of the tasks computing its subexpressions (-1 for the leaves)
+  std::vector<SmallVector<int, kMaxArity>> subexpr_tasks_;
+  // Per-thread intermediate tiles (CPU), 8 bytes per element fit any of the supported types
+  std::vector<int64_t> intermediate_buffers_;
+  bool fused_ = false;
+  FusedExprProgram fused_program_;
+  std::vector<const ExprNode *> fused_operands_;
+  std::vector<FusedExprTile> fused_tiles_;
+  std::vector<InputSamplePtr> fused_operand_ptrs_;
   ConstantStorage<Backend> constant_storage_;
   ExprImplCache cache_;
   // For CPU we limit the tile size to limit the sizes of intermediate buffers
@@ -151,6 +151,14 @@ TEST(ArithmeticOpsTest, GetTiledCover) {
   std::vector<TileRange> range1 = {{0, 4}, {4, 7}};
   EXPECT_EQ(std::get<0>(result1), cover1);
   EXPECT_EQ(std::get<1>(result1), range1);
+
+  // the storage is reused, the previous cover is discarded
+  std::vector<TileDesc> descs;
+  std::vector<TileRange> ranges;
+  GetTiledCover(descs, ranges, shape0, 50, 4);
+  GetTiledCover(descs, ranges, shape1, 50, 4);
+  EXPECT_EQ(descs, cover1);
+  EXPECT_EQ(ranges, range1);
 }
 
 namespace {
@@ -468,6 +476,85 @@ TEST(ArithmeticOpsTest, ConstantsPipeline) {
   }
 }
 
+TEST(ArithmeticOpsTest, NestedExpressionPipeline) {
+  constexpr int batch_size = 5;
+  constexpr int num_threads = 4;
+  // Spans multiple tiles on the CPU
+  constexpr int tensor_elements = 10000;
+  Pipeline pipe(batch_size, num_threads, 0);
+
+  pipe.AddExternalInput("data");
+  pipe.AddExternalInput("scalar");
+
+  // float expression, a scalar-like integer subexpression, an integer expression
+  // and a float expression with a scalar-like subexpression
+  std::vector<std::string> descs = {"sub(mul(&0 $0:float32) fdiv(&0 $1:float32))",
+                                    "add(mul(&0 $0:int32) minus(&0))",
+                                    "mul(&0 add(&1 $0:int32))",
+                                    "add(&0 mul(&1 $0:float32))"};
+  std::vector<std::vector<int>> integers = {{}, {3}, {5}, {}};
+  std::vector<std::vector<float>> reals = {{2.f, 4.f}, {}, {}, {0.5f}};
+  vector<std::pair<string, string>> outputs;
+  for (std::string device : {"cpu", "gpu"}) {
+    for (size_t e = 0; e < descs.size(); e++) {
+      auto output = make_string("result_", device, e);
+      pipe.AddOperator(OpSpec("ArithmeticGenericOp")
+                           .AddArg("device", device)
+                           .AddArg("expression_desc", descs[e])
+                           .AddArg("integer_constants", integers[e])
+                           .AddArg("real_constants", reals[e])
+                           .AddInput("data", device)
+                           .AddInput("scalar", device)
+                           .AddOutput(output, device),
+                       make_string("arithm_", device, e));
+      outputs.emplace_back(output, device);
+    }
+  }
+
+  pipe.Build(outputs);
+
+  TensorList<CPUBackend> batch, scalars;
+  FillBatch<int>(batch, uniform_list_shape(batch_size, {tensor_elements}));
+  FillBatch<int>(scalars, uniform_list_shape(batch_size, {1}));
+
+  pipe.SetExternalInput("data", batch);
+  pipe.SetExternalInput("scalar", scalars);
+  pipe.RunCPU();
+  pipe.RunGPU();
+  DeviceWorkspace ws;
+  pipe.Outputs(&ws);
+
+  int num_descs = descs.size();
+  vector<int32_t> int_result(tensor_elements);
+  vector<float> float_result(tensor_elements);
+  for (int sample_id = 0; sample_id < batch_size; sample_id++) {
+    const auto *data = batch.tensor<int>(sample_id);
+    int s = scalars.tensor<int>(sample_id)[0];
+    for (int out = 0; out < 2 * num_descs; out++) {
+      int e = out % num_descs;
+      bool is_float = e == 0 || e == 3;
+      const void *result = out < num_descs ? ws.Output<CPUBackend>(out).raw_tensor(sample_id)
+                                           : ws.Output<GPUBackend>(out).raw_tensor(sample_id);
+      void *result_cpu = is_float ? static_cast<void *>(float_result.data())
+                                  : static_cast<void *>(int_result.data());
+      MemCopy(result_cpu, result, tensor_elements * sizeof(int));
+      CUDA_CALL(cudaStreamSynchronize(0));
+
+      for (int i = 0; i < tensor_elements; i++) {
+        if (e == 0) {
+          EXPECT_FLOAT_EQ(float_result[i], data[i] * 2.f - data[i] / 4.f);
+        } else if (e == 1) {
+          EXPECT_EQ(int_result[i], data[i] * 3 - data[i]);
+        } else if (e == 2) {
+          EXPECT_EQ(int_result[i], data[i] * (s + 5));
+        } else {
+          EXPECT_FLOAT_EQ(float_result[i], data[i] + s * 0.5f);
+        }
+      }
+    }
+  }
+}
+
 using shape_sequence = std::vector<std::array<TensorListShape<>, 3>>;
 
 int GetBatchSize(const shape_sequence &seq) {
@@ -0,0 +1,124 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_FUSED_H_
+#define DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_FUSED_H_
+
+#include <vector>
+
+#include "dali/operators/math/expressions/arithmetic_meta.h"
+#include "dali/operators/math/expressions/expression_tree.h"
+#include "dali/pipeline/data/types.h"
+
+namespace dali {
+
+/**
+ * @brief The limits of the expression that can be evaluated by the fused kernel
+ */
+constexpr int kMaxFusedInstructions = 32;
+constexpr int kMaxFusedStackDepth = 8;
+
+enum class FusedInstrKind : uint8_t {
+  Load,        // push the element of the operand
+  LoadScalar,  // push the only element of a scalar-like operand
+  Apply,       // replace the `arity` values on top of the stack with the result of `op`
+};
+
+struct FusedInstr {
+  ArithmeticOp op;
+  DALIDataType type;  // type of the loaded operand
+  int16_t operand;    // index of the loaded operand
+  FusedInstrKind kind;
+  uint8_t arity;
+};
+
+/**
+ * @brief Expression tree flattened (in postorder) into a program for a stack machine.
+ *
+ * It allows the whole expression to be evaluated in one kernel, without storing
+ * the intermediate results in memory. All the function nodes are evaluated in float,
+ * the leaves (tensor inputs and constants) are the operands of the program and are converted
+ * to float when loaded.
+ */
+struct FusedExprProgram {
+  int num_instr = 0;
+  int num_operands = 0;
+  FusedInstr instr[kMaxFusedInstructions];
+};
+
+/**
+ * @brief Tile of the output of the fused expression, the operands for the tile are stored
+ *        separately.
+ */
+struct FusedExprTile {
+  float *output;
+  int64_t extent_size;
+};
+
+inline bool CompileFusedExpr(FusedExprProgram &prog, std::vector<const ExprNode *> &operands,
+                             const ExprNode &expr, int &depth) {
+  if (prog.num_instr == kMaxFusedInstructions) {
+    return false;
+  }
+  if (expr.GetNodeType() != NodeType::Function) {
+    auto &instr = prog.instr[prog.num_instr++];
+    instr.kind = IsScalarLike(expr) ? FusedInstrKind::LoadScalar : FusedInstrKind::Load;
+    instr.type = expr.GetTypeId();
+    instr.operand = operands.size();
+    operands.push_back(&expr);
+    return ++depth <= kMaxFusedStackDepth;
+  }
+  auto &func = dynamic_cast<const ExprFunc &>(expr);
+  auto op = NameToOp(func.GetFuncName());
+  if (func.GetTypeId() != DALI_FLOAT || IsComparison(op) || IsBitwise(op)) {
+    return false;
+  }
+  for (int i = 0; i < func.GetSubexpressionCount(); i++) {
+    if (!CompileFusedExpr(prog, operands, func[i], depth)) {
+      return false;
+    }
+  }
+  if (prog.num_instr == kMaxFusedInstructions) {
+    return false;
+  }
+  auto &instr = prog.instr[prog.num_instr++];
+  instr.kind = FusedInstrKind::Apply;
+  instr.op = op;
+  instr.arity = func.GetSubexpressionCount();
+  depth -= instr.arity - 1;
+  return true;
+}
+
+/**
+ * @brief Flatten the `expr` into the `prog`, listing its leaves in `operands`.
+ *
+ * @return false, if the expression cannot be evaluated by the fused kernel: it is too large,
+ *         or some of its function nodes do not produce floats
+ */
+inline bool CompileFusedExpr(FusedExprProgram &prog, std::vector<const ExprNode *> &operands,
+                             const ExprNode &expr) {
+  prog.num_instr = 0;
+  operands.clear();
+  int depth = 0;
+  if (expr.GetNodeType() != NodeType::Function || !CompileFusedExpr(prog, operands, expr, depth)) {
+    return false;
+  }
+  prog.num_operands = operands.size();
+  return true;
+}
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_FUSED_H_
@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_FACTORY_H_
 #define DALI_OPERATORS_MATH_EXPRESSIONS_EXPRESSION_IMPL_FACTORY_H_
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -151,8 +152,35 @@ inline OutputSamplePtr GetOutput(const ExprFunc &func, workspace_t<Backend> &ws,
          tile.tile_size * tile.extent_idx * TypeTable::GetTypeInfo(func.GetTypeId()).size();
 }
 
+/**
+ * @brief Type erased obtaining pointer to the data of the leaf node (Tensor or Constant)
+ *        for given tile.
+ */
+template <typename Backend>
+inline InputSamplePtr GetLeafPointer(const ExprNode &leaf, workspace_t<Backend> &ws,
+                                     const ConstantStorage<Backend> &st, TileDesc tile) {
+  if (leaf.GetNodeType() == NodeType::Constant) {
+    const auto &constant = dynamic_cast<const ExprConstant &>(leaf);
+    return st.GetPointer(constant.GetConstIndex(), constant.GetTypeId());
+  }
+  const auto &tensor = dynamic_cast<const ExprTensor &>(leaf);
+  auto input_idx = tensor.GetInputIndex();
+  const auto *ptr =
+      reinterpret_cast<const char *>(GetInputSamplePointer(ws, input_idx, tile.sample_idx));
+  if (IsScalarLike(leaf)) {
+    // No tile offset, just take the pointer for this element as this is a scalar
+    return ptr;
+  }
+  auto tile_offset =
+      tile.tile_size * tile.extent_idx * TypeTable::GetTypeInfo(tensor.GetTypeId()).size();
+  return ptr + tile_offset;
+}
+
 /**
  * @brief Type erased obtaining pointers to inputs
+ *
+ * The pointers for the Function subexpressions are left empty, they point to the buffers
+ * for intermediate results, which are filled by the operator.
  */
 template <typename Backend>
 inline ArgPack GetArgPack(const ExprFunc &func, workspace_t<Backend> &ws,
@@ -160,26 +188,10 @@ inline ArgPack GetArgPack(const ExprFunc &func, workspace_t<Backend> &ws,
   ArgPack result;
   result.resize(func.GetSubexpressionCount());
   for (int i = 0; i < func.GetSubexpressionCount(); i++) {
-    DALI_ENFORCE(func[i].GetNodeType() != NodeType::Function,
-                 "Function nodes are not supported as subexpressions");
-    if (IsScalarLike(func[i])) {
-      if (func[i].GetNodeType() == NodeType::Constant) {
-        const auto &constant = dynamic_cast<const ExprConstant &>(func[i]);
-        result[i] = st.GetPointer(constant.GetConstIndex(), constant.GetTypeId());
-      } else if (func[i].GetNodeType() == NodeType::Tensor) {
-        // No tile offset, just take the pointer for this element as this is a scalar
-        const auto &tensor = dynamic_cast<const ExprTensor &>(func[i]);
-        auto input_idx = tensor.GetInputIndex();
-        result[i] = GetInputSamplePointer(ws, input_idx, tile.sample_idx);
-      }
-    } else if (func[i].GetNodeType() == NodeType::Tensor) {
-      const auto &tensor = dynamic_cast<const ExprTensor &>(func[i]);
-      auto input_idx = tensor.GetInputIndex();
-      const auto *ptr =
-          reinterpret_cast<const char *>(GetInputSamplePointer(ws, input_idx, tile.sample_idx));
-      auto tile_offset =
-          tile.tile_size * tile.extent_idx * TypeTable::GetTypeInfo(tensor.GetTypeId()).size();
-      result[i] = ptr + tile_offset;
+    if (func[i].GetNodeType() == NodeType::Function) {
+      result[i] = nullptr;
+    } else {
+      result[i] = GetLeafPointer(func[i], ws, st, tile);
     }
   }
   return result;
@@ -190,22 +202,31 @@ inline ArgPack GetArgPack(const ExprFunc &func, workspace_t<Backend> &ws,
  * based on the ExprFunc by extracting the input and output pointers to data
  * from workspace and constant storage.
  *
+ * Scalar-like function nodes are computed only once for every tile.
+ *
  * @param extended_tiles Output vector of ExtendedTiles for given task
+ * @param is_root Whether `func` is the root of the expression. Only the root writes directly
+ *                to the output of the operator, the output pointers are left empty otherwise.
  */
 template <typename Backend>
 void TransformDescs(std::vector<ExtendedTileDesc> &extended_tiles,
                     const std::vector<TileDesc> &tiles, const ExprFunc &func,
                     workspace_t<Backend> &ws, const ConstantStorage<Backend> &st,
-                    const OpSpec &spec) {
+                    const OpSpec &spec, bool is_root = true) {
   extended_tiles.reserve(tiles.size());
   SmallVector<DALIDataType, kMaxArity> in_types;
   in_types.resize(func.GetSubexpressionCount());
   for (int i = 0; i < func.GetSubexpressionCount(); i++) {
     in_types[i] = func[i].GetTypeId();
   }
-  for (auto &tile : tiles) {
-    extended_tiles.emplace_back(tile, GetOutput<Backend>(func, ws, tile),
-                                GetArgPack(func, ws, st, spec, tile), func.GetTypeId(), in_types);
+  bool is_scalar = IsScalarLike(func.GetShape());
+  for (auto tile : tiles) {
+    auto *output = is_root ? GetOutput<Backend>(func, ws, tile) : nullptr;
+    auto args = GetArgPack(func, ws, st, spec, tile);
+    if (is_scalar) {
+      tile.extent_size = std::min<int64_t>(tile.extent_size, 1);
+    }
+    extended_tiles.emplace_back(tile, output, args, func.GetTypeId(), in_types);
   }
 }
 
@@ -213,6 +234,8 @@ void TransformDescs(std::vector<ExtendedTileDesc> &extended_tiles,
  * @brief Prepare vector of ExtendedTiles for every task that we have to execute, filling
  * the pointers to data.
  *
+ * The last task in the `task_exec_order` is the root of the expression.
+ *
  * @param tiles_per_task  Output vectors of ExtendedTiles per every task to execute
  */
 template <typename Backend>
@@ -225,7 +248,8 @@ void PrepareTilesForTasks(std::vector<std::vector<ExtendedTileDesc>> &tiles_per_
     const auto &expr_task = task_exec_order[i];
     const auto &expr_func = dynamic_cast<const ExprFunc &>(*expr_task.ctx.node);
     tiles_per_task[i].resize(0);
-    TransformDescs<Backend>(tiles_per_task[i], tiles, expr_func, ws, constant_storage, spec);
+    TransformDescs<Backend>(tiles_per_task[i], tiles, expr_func, ws, constant_storage, spec,
+                            i + 1 == task_exec_order.size());
   }
 }
 
@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -220,12 +220,11 @@ class ExprConstant : public ExprNode {
 DLL_PUBLIC std::unique_ptr<ExprNode> ParseExpressionString(const std::string &expr);
 
 /**
- * @brief Scalar-like nodes are the Constant nodes and Tensor nodes that consist of batch of
- * scalars.
+ * @brief Scalar-like nodes are the Constant nodes and Tensor (or Function) nodes that consist of
+ * batch of scalars.
  */
 inline bool IsScalarLike(const ExprNode &node) {
-  return node.GetNodeType() == NodeType::Constant ||
-         (node.GetNodeType() == NodeType::Tensor && IsScalarLike(node.GetShape()));
+  return node.GetNodeType() == NodeType::Constant || IsScalarLike(node.GetShape());
 }
 
 }  // namespace dali
@@ -113,6 +113,19 @@ The variance is estimated by using the following formula::
   sum(Xi - mean)**2 / (N - ddof).
 
 This argument is ignored when an externally supplied standard deviation is used.)code", 0, false)
+  .AddOptionalArg("cross_device_group", R"code(The name of a group of devices across which
+the batch statistics are calculated.
+
+In data-parallel training, each device processes only a part of the global batch. When this
+argument is set, the partial sums of all the devices in the group are added with a single, small
+all-reduce per iteration, so that all the devices normalize the data with the mean and standard
+deviation of the whole global batch.
+
+The reduction is provided by the framework (e.g. an ``ncclAllReduce`` on the communicator of
+the data-parallel group) and must be registered under this name with
+:meth:`nvidia.dali.backend.SetCrossDeviceSum` before the pipeline runs. The argument is
+supported only by the GPU operator, with ``batch`` set to True. The non-reduced extents of
+the input must be equal on all the devices.)code", "")
   .AddOptionalTypeArg("dtype", R"code(Output data type.
 
 When using integral types, use ``shift`` and ``scale`` to improve the usage of the output
@@ -122,7 +135,10 @@ and non-integer values are rounded to nearest integer.)code", DALI_FLOAT);
 template <>
 class Normalize<CPUBackend> : public NormalizeBase<CPUBackend> {
  public:
-  explicit Normalize(const OpSpec &spec) : NormalizeBase<CPUBackend>(spec) {}
+  explicit Normalize(const OpSpec &spec) : NormalizeBase<CPUBackend>(spec) {
+    DALI_ENFORCE(cross_device_group_.empty(),
+      "Normalize: `cross_device_group` is supported only by the GPU operator");
+  }
 
  private:
   friend class NormalizeBase<CPUBackend>;
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "dali/core/any.h"
@@ -30,7 +31,8 @@
 namespace dali {
 
 #define DALI_NORMALIZE_INPUT_TYPES (int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, float)
-#define DALI_NORMALIZE_OUTPUT_TYPES DALI_NORMALIZE_INPUT_TYPES
+#define DALI_NORMALIZE_OUTPUT_TYPES \
+  (int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t, float, bfloat16)
 
 template <typename Backend>
 class Normalize;
@@ -52,6 +54,7 @@ class NormalizeBase : public Operator<Backend> {
     epsilon_ = spec.GetArgument<float>("epsilon");
     degrees_of_freedom_ = spec.GetArgument<int>("ddof");
     output_type_ = spec.GetArgument<DALIDataType>("dtype");
+    cross_device_group_ = spec.GetArgument<std::string>("cross_device_group");
 
     DALI_ENFORCE(!has_axes_arg_ || !has_axis_names_arg_,
       "Normalize: Arguments `axes` and `axis_names` are mutually exclusive");
@@ -65,6 +68,9 @@ class NormalizeBase : public Operator<Backend> {
       DALI_ENFORCE(!batch_norm_, "Normalize: Batch normalization cannot be used with parameters "
       "specified as TensorList inputs");
     }
+
+    DALI_ENFORCE(cross_device_group_.empty() || batch_norm_,
+      "Normalize: `cross_device_group` can be used only with batch normalization (`batch=True`)");
     mean_.set_pinned(false);
     inv_stddev_.set_pinned(false);
   }
@@ -242,6 +248,10 @@ class NormalizeBase : public Operator<Backend> {
 
   bool ShouldCalcMean() const noexcept { return !has_tensor_mean_ && !has_scalar_mean_; }
   bool ShouldCalcStdDev() const noexcept { return !has_tensor_stddev_ && !has_scalar_stddev_; }
+  /// The batch statistics are calculated and combined across the devices of a group
+  bool UseCrossDeviceStats() const noexcept {
+    return !cross_device_group_.empty() && (ShouldCalcMean() || ShouldCalcStdDev());
+  }
   bool IsFullReduction() const noexcept {
     int ndim = data_shape_.sample_dim();
     return axis_mask_== ((1_u64 << ndim) - 1);
@@ -266,6 +276,7 @@ class NormalizeBase : public Operator<Backend> {
   float scale_ = 1;
   float epsilon_ = 0;  //!< Added to variance for regularization
   int degrees_of_freedom_ = 0;  //!< For Bessel's correction
+  std::string cross_device_group_;  //!< Name of the registered cross-device reduction, if any
   DALIDataType input_type_ = DALI_NO_TYPE, output_type_ = DALI_FLOAT;
   std::vector<int> axes_;
   uint64_t axis_mask_ = 0;
@@ -18,6 +18,7 @@
 #include "dali/kernels/normalize/normalize_gpu.h"
 #include "dali/kernels/reduce/reduce_gpu.h"
 #include "dali/kernels/common/copy.h"
+#include "dali/pipeline/util/cross_device_sum.h"
 
 namespace dali {
 
@@ -51,6 +52,26 @@ class Normalize<GPUBackend> : public NormalizeBase<GPUBackend> {
     return stddev_kernel_.create_or_get<InvStdDevGPU<ParamType, InputType>>();
   }
 
+  template <typename ParamType, typename InputType>
+  MeanInvStdDevGPU<ParamType, InputType> &GetMeanInvStdDevKernel() {
+    return mean_kernel_.create_or_get<MeanInvStdDevGPU<ParamType, InputType>>();
+  }
+
+  /// Both statistics are calculated - they can be obtained in a single pass over the data
+  bool ShouldCalcMeanAndStdDev() const noexcept {
+    return ShouldCalcMean() && ShouldCalcStdDev();
+  }
+
+  template <typename InputType>
+  PowerSumsGPU<double, InputType> &GetPowerSumsKernel() {
+    return mean_kernel_.create_or_get<PowerSumsGPU<double, InputType>>();
+  }
+
+  template <typename InputType>
+  void CalcCrossDeviceStats(KernelContext &ctx,
+                            const OutListGPU<float> &mean, const OutListGPU<float> &inv_stddev,
+                            const InListGPU<InputType> &in, float scalar_mean);
+
   template <typename OutputType, typename InputType>
   NormalizeGPU<OutputType, InputType> &GetNormalizeKernel() {
     return normalize_kernel_.create_or_get<NormalizeGPU<OutputType, InputType>>();
@@ -122,6 +143,32 @@ __global__ void Fill(T *data, size_t count, T value) {
     data[i] = value;
 }
 
+/**
+ * @brief Calculates the mean and the inverse standard deviation from the power sums
+ *        (count, sum, sum of squares) of the whole, cross-device batch
+ *
+ * If `mean` is null, the statistics are calculated around `fixed_mean`.
+ * If `inv_stddev` is null, only the mean is calculated.
+ */
+__global__ void CrossDeviceStats(float *mean, float *inv_stddev, const vec<3, double> *sums,
+                                 int64_t count, float fixed_mean, int ddof, float epsilon) {
+  int64_t i = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (i >= count)
+    return;
+  vec<3, double> s = sums[i];
+  double n = s[0];
+  double m = mean ? (n > 0 ? s[1] / n : 0) : fixed_mean;
+  if (mean)
+    mean[i] = m;
+  if (inv_stddev) {
+    // sum((x - m)^2) = sum(x^2) - 2 m sum(x) + n m^2
+    double m2 = fmax(s[2] - 2 * m * s[1] + n * m * m, 0.0);
+    float var = n > ddof ? m2 / (n - ddof) : 0;
+    float reg = var + epsilon;
+    inv_stddev[i] = reg ? rsqrt(reg) : 0;
+  }
+}
+
 }  // namespace
 
 TensorListView<StorageGPU, float>
@@ -142,6 +189,26 @@ Normalize<GPUBackend>::BroadcastMean(KernelContext &ctx, float value) const {
   return mean_gpu;
 }
 
+template <typename InputType>
+void Normalize<GPUBackend>::CalcCrossDeviceStats(
+      KernelContext &ctx, const OutListGPU<float> &mean, const OutListGPU<float> &inv_stddev,
+      const InListGPU<InputType> &in, float scalar_mean) {
+  auto cross_device_sum = GetCrossDeviceSum(cross_device_group_);
+  int64_t param_volume = param_shape_.num_elements();
+  auto *sums = ctx.scratchpad->AllocateGPU<vec<3, double>>(param_volume);
+  OutListGPU<vec<3, double>> sums_tl(sums, param_shape_);
+  GetPowerSumsKernel<InputType>().Run(ctx, sums_tl, in);
+  // the only communication: the power sums of all the devices are added in place
+  cross_device_sum(reinterpret_cast<double *>(sums), 3 * param_volume, ctx.gpu.stream);
+  int block = 256;
+  int grid = div_ceil(param_volume, block);
+  CrossDeviceStats<<<grid, block, 0, ctx.gpu.stream>>>(
+    ShouldCalcMean() ? mean.data[0] : nullptr,
+    ShouldCalcStdDev() ? inv_stddev.data[0] : nullptr,
+    sums, param_volume, scalar_mean, degrees_of_freedom_, epsilon_);
+  CUDA_CALL(cudaGetLastError());
+}
+
 template <typename OutputType, typename InputType>
 void Normalize<GPUBackend>::SetupTyped(const DeviceWorkspace &ws) {
   auto &input = ws.Input<GPUBackend>(0);
@@ -179,14 +246,22 @@ void Normalize<GPUBackend>::SetupTyped(const DeviceWorkspace &ws) {
   auto req = norm.Setup(ctx, data_shape_, make_span(axes_),
                         has_scalar_mean_, has_scalar_stddev_, scale_is_stddev);
 
-  if (ShouldCalcMean()) {
+  if (UseCrossDeviceStats()) {
+    auto &sums = GetPowerSumsKernel<InputType>();
+    auto sums_req = sums.Setup(ctx, data_shape_, make_span(axes_), true, true);
+    assert(sums_req.output_shapes[0] == param_shape_);
+    MaxInPlace(req.scratch_sizes, sums_req.scratch_sizes);
+  } else if (ShouldCalcMeanAndStdDev()) {
+    auto &stats = GetMeanInvStdDevKernel<float, InputType>();
+    auto stats_req = stats.Setup(ctx, data_shape_, make_span(axes_), true, batch_norm_);
+    assert(stats_req.output_shapes[0] == param_shape_);
+    MaxInPlace(req.scratch_sizes, stats_req.scratch_sizes);
+  } else if (ShouldCalcMean()) {
     auto &mean = GetMeanKernel<float, InputType>();
     auto mean_req = mean.Setup(ctx, data_shape_, make_span(axes_), true, batch_norm_);
     assert(mean_req.output_shapes[0] == param_shape_);
     MaxInPlace(req.scratch_sizes, mean_req.scratch_sizes);
-  }
-
-  if (ShouldCalcStdDev()) {
+  } else if (ShouldCalcStdDev()) {
     auto &stddev = GetInvStdDevKernel<float, InputType>();
     auto stddev_req = stddev.Setup(ctx, data_shape_, make_span(axes_), true, batch_norm_);
     assert(stddev_req.output_shapes[0] == param_shape_);
@@ -240,7 +315,19 @@ void Normalize<GPUBackend>::RunTyped(DeviceWorkspace &ws) {
     stddev_gpu = buffer_scratchpad.AllocTensorList<mm::memory_kind::device, float>(param_shape_);
   }
 
-  if (ShouldCalcMean()) {
+  if (UseCrossDeviceStats()) {
+    // mean and/or stddev of the batches of all the devices; there are no tensor arguments here
+    DynamicScratchpad scratchpad({}, stream);
+    ctx.scratchpad = &scratchpad;
+    CalcCrossDeviceStats(ctx, mean_gpu, stddev_gpu, in_view, scalar_mean);
+    ctx.scratchpad = nullptr;
+  } else if (ShouldCalcMeanAndStdDev()) {
+    DynamicScratchpad scratchpad({}, stream);
+    ctx.scratchpad = &scratchpad;
+    auto &stats_kernel = GetMeanInvStdDevKernel<float, InputType>();
+    stats_kernel.Run(ctx, mean_gpu, stddev_gpu, in_view, degrees_of_freedom_, epsilon_);
+    ctx.scratchpad = nullptr;
+  } else if (ShouldCalcMean()) {
     DynamicScratchpad scratchpad({}, stream);
     ctx.scratchpad = &scratchpad;
     auto &mean_kernel = GetMeanKernel<float, InputType>();
@@ -250,7 +337,10 @@ void Normalize<GPUBackend>::RunTyped(DeviceWorkspace &ws) {
     kernels::copy(mean_gpu, mean_input_, stream);
   }
 
-  if (ShouldCalcStdDev()) {
+  if (UseCrossDeviceStats()) {
+    // already calculated
+  } else if (ShouldCalcStdDev() && !ShouldCalcMeanAndStdDev()) {
+    // otherwise calculated with the mean
     DynamicScratchpad scratchpad({}, stream);
     ctx.scratchpad = &scratchpad;
     auto &stddev_kernel = GetInvStdDevKernel<float, InputType>();
@@ -45,6 +45,12 @@ output can be accessed by ``outs[1][0]``.
 
 If no setup function provided, the output shape and data type will be the same as the input.
 
+For the GPU operator, the run function is compiled to a CUDA kernel. The compiled kernels are
+cached on disk, keyed by a hash of the function's code, the argument types and the device, so
+that the subsequent processes skip the compilation. The cache is stored in the directory given by
+the ``DALI_NUMBA_CACHE_DIR`` environment variable (``~/.cache/dali/numba`` by default);
+setting it to an empty string disables the cache.
+
 .. note::
     This operator is experimental and its API might change without notice.
 
@@ -121,7 +127,12 @@ separately for each sample in the batch.
 When ``batch_processing`` is set to ``True``, the function processes the whole batch. It is necessary if the
 function has to perform cross-sample operations and may be beneficial if significant part of the work can
 be reused. For other use cases, specifying False and using per-sample processing function allows the operator
-to process samples in parallel.)code", false);
+to process samples in parallel.
+
+For the GPU operator, the batch processing function is a kernel launched once for the whole batch:
+each array has the sample index as its outermost dimension, so the kernel can, for example, select
+the sample with ``cuda.blockIdx.z``. As in per-sample mode, all samples must have the same shape.)code",
+                  false);
 
 DALI_SCHEMA(NumbaFuncImpl)
   .DocStr("")
@@ -38,6 +38,34 @@ vector<ssize_t> calc_sizes(DALIDataType type, TensorShape<-1> shape) {
   return args;
 }
 
+/**
+ * @brief Calculates the array arguments describing the whole batch as a single array,
+ *        with the sample index as the outermost dimension
+ *
+ * The samples must have the same shape and be densely packed in memory, one after another.
+ */
+vector<ssize_t> calc_batch_sizes(DALIDataType type, int num_samples,
+                                 const TensorShape<-1> &sample_shape) {
+  vector<ssize_t> args;
+  int ndim = sample_shape.size() + 1;
+  ssize_t item_size = TypeTable::GetTypeInfo(type).size();
+  args.push_back(num_samples * volume(sample_shape));
+  args.push_back(item_size);
+
+  args.push_back(num_samples);
+  for (int i = 0; i < sample_shape.size(); i++)
+    args.push_back(sample_shape[i]);
+
+  vector<ssize_t> strides(ndim);
+  ssize_t stride = item_size;
+  for (int i = ndim - 1; i >= 0; i--) {
+    strides[i] = stride;
+    stride *= args[2 + i];
+  }
+  args.insert(args.end(), strides.begin(), strides.end());
+  return args;
+}
+
 
 vector<void*> prepare_args(vector<void*> &memory_ptrs,
     vector<ssize_t> &sizes, uint64_t *ptr) {
@@ -61,8 +89,6 @@ NumbaFuncImpl<GPUBackend>::NumbaFuncImpl(const OpSpec &spec) : Base(spec) {
   run_fn_ = spec.GetArgument<uint64_t>("run_fn");
   setup_fn_ = spec.GetArgument<uint64_t>("setup_fn");
   batch_processing_ = spec.GetArgument<bool>("batch_processing");
-  DALI_ENFORCE(batch_processing_ == false,
-    make_string("Currently batch processing for GPU is not supported."));
 
   out_types_ = spec.GetRepeatedArgument<DALIDataType>("out_types");
   DALI_ENFORCE(out_types_.size() <= 6,
@@ -147,16 +173,23 @@ bool NumbaFuncImpl<GPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
       in.type(), " != ", in_types_[in_id]));
   }
 
+  auto get_sizes = [&](DALIDataType type, const TensorListShape<-1> &shape) {
+    return batch_processing_ ? calc_batch_sizes(type, shape.num_samples(), shape[0])
+                             : calc_sizes(type, shape[0]);
+  };
+
+  in_sizes_.clear();
+  in_memory_ptrs_.clear();
   for (size_t in_id = 0; in_id < in_types_.size(); in_id++) {
-    vector<ssize_t> sizes = calc_sizes(in_types_[in_id], in_shapes_[in_id][0]);
-    in_sizes_.push_back(sizes);
+    in_sizes_.push_back(get_sizes(in_types_[in_id], in_shapes_[in_id]));
     in_memory_ptrs_.push_back({nullptr, nullptr});
   }
 
+  out_sizes_.clear();
+  out_memory_ptrs_.clear();
   for (size_t out_id = 0; out_id < out_types_.size(); out_id++) {
     // For now we assume that inputs and outputs have the same shapes and types
-    vector<ssize_t> sizes = calc_sizes(in_types_[out_id], in_shapes_[out_id][0]);
-    out_sizes_.push_back(sizes);
+    out_sizes_.push_back(get_sizes(in_types_[out_id], in_shapes_[out_id]));
     out_memory_ptrs_.push_back({nullptr, nullptr});
   }
 
@@ -168,8 +201,66 @@ bool NumbaFuncImpl<GPUBackend>::SetupImpl(std::vector<OutputDesc> &output_desc,
 }
 
 
+template <>
+void NumbaFuncImpl<GPUBackend>::RunBatch(workspace_t<GPUBackend> &ws) {
+  int N = ws.Input<GPUBackend>(0).shape().num_samples();
+  if (N == 0)
+    return;
+  packed_inputs_.resize(in_types_.size());
+  std::vector<uint64_t> in_ptrs(in_types_.size());
+  for (size_t in_id = 0; in_id < in_types_.size(); in_id++) {
+    auto &in = ws.Input<GPUBackend>(in_id);
+    const TensorList<GPUBackend> *batch = &in;
+    if (!in.IsContiguousInMemory()) {
+      // The kernel sees the batch as one array - the samples must be packed back to back
+      auto &packed = packed_inputs_[in_id];
+      packed.set_order(ws.stream());
+      packed.SetContiguity(BatchContiguity::Contiguous);
+      packed.Copy(in, ws.stream());
+      batch = &packed;
+    }
+    in_ptrs[in_id] = reinterpret_cast<uint64_t>(batch->raw_tensor(0));
+  }
+
+  std::vector<uint64_t> out_ptrs(out_types_.size());
+  for (size_t out_id = 0; out_id < out_types_.size(); out_id++) {
+    auto &out = ws.Output<GPUBackend>(out_id);
+    DALI_ENFORCE(out.IsContiguousInMemory(),
+                 "Batch processing requires the outputs to be contiguous in memory.");
+    out_ptrs[out_id] = reinterpret_cast<uint64_t>(out.raw_mutable_tensor(0));
+  }
+
+  vector<void*> args;
+  for (size_t in_id = 0; in_id < in_types_.size(); in_id++) {
+    vector<void*> args_local = prepare_args(in_memory_ptrs_[in_id], in_sizes_[in_id],
+                                            &in_ptrs[in_id]);
+    args.insert(args.end(), args_local.begin(), args_local.end());
+  }
+  for (size_t out_id = 0; out_id < out_types_.size(); out_id++) {
+    vector<void*> args_local = prepare_args(out_memory_ptrs_[out_id], out_sizes_[out_id],
+                                            &out_ptrs[out_id]);
+    args.insert(args.end(), args_local.begin(), args_local.end());
+  }
+
+  CUfunction cufunc = (CUfunction)run_fn_;
+  CUresult result = cuLaunchKernel(
+    cufunc,
+    blocks_[0], blocks_[1], blocks_[2],
+    threads_per_block_[0], threads_per_block_[1], threads_per_block_[2],
+    0,
+    ws.stream(),
+    static_cast<void**>(args.data()),
+    NULL);
+  cudaResultCheck(result);
+}
+
+
 template <>
 void NumbaFuncImpl<GPUBackend>::RunImpl(workspace_t<GPUBackend> &ws) {
+  if (batch_processing_) {
+    RunBatch(ws);
+    return;
+  }
   auto N = ws.Input<GPUBackend>(0).shape().num_samples();
   int ninputs = ws.NumInput();
 
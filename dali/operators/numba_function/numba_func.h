@@ -36,6 +36,11 @@ class NumbaFuncImpl : public Operator<Backend> {
 
   void RunImpl(Workspace &ws) override;
 
+  /**
+   * @brief Launches the kernel once for the whole batch (GPU only)
+   */
+  void RunBatch(Workspace &ws);
+
  private:
   using NumbaPtr = uint64_t;
 
@@ -56,6 +61,7 @@ class NumbaFuncImpl : public Operator<Backend> {
   std::vector<uint64_t> input_shape_ptrs_;
   vector<TensorListShape<-1>> in_shapes_;
   vector<TensorListShape<-1>> out_shapes_;
+  vector<TensorList<Backend>> packed_inputs_;
 };
 
 
@@ -16,6 +16,7 @@
 #include <memory>
 #include <utility>
 #include <string>
+#include <vector>
 #include "dali/operators/python_function/dltensor_function.h"
 #include "dali/pipeline/util/copy_with_stride.h"
 
@@ -50,6 +51,11 @@ tasks are finished in the operator call. The GPU code can be executed on the CUD
 by DALI, which can be obtained by calling the ``current_dali_stream()`` function. In this case,
 the ``synchronize_stream`` flag can be set to False.
 
+Dense GPU outputs which reside on DALI's device are adopted without a copy - DALI keeps the
+DLPack tensors alive for as long as it uses their memory. Such outputs should be produced on
+DALI's stream (or exported with the stream-aware ``__dlpack__(stream=...)`` protocol, which
+orders DALI's stream after the pending work on another stream).
+
 .. warning::
   This operator is not compatible with TensorFlow integration.
 )code")
@@ -157,9 +163,100 @@ void CopyOutputData(TensorList<CPUBackend> &output, std::vector<DLMTensorPtr> &d
 template <>
 void CopyOutputData(TensorList<GPUBackend>& output, std::vector<DLMTensorPtr> &dl_tensors,
                     int batch_size, DeviceWorkspace &workspace) {
+  // the whole batch is copied at once, so that many small samples don't make it launch-bound
+  int ndim = output.sample_dim();
+  std::vector<void *> outputs(batch_size);
+  std::vector<const void *> inputs(batch_size);
+  std::vector<const Index *> shapes(batch_size);
+  std::vector<const Index *> strides(batch_size);
+  std::vector<Index> byte_strides(batch_size * ndim);
+  size_t item_size = output.type_info().size();
+  for (int i = 0; i < batch_size; ++i) {
+    auto &dl_tensor = dl_tensors[i]->dl_tensor;
+    outputs[i] = output.raw_mutable_tensor(i);
+    inputs[i] = dl_tensor.data;
+    shapes[i] = dl_tensor.shape;
+    if (dl_tensor.strides) {
+      Index *sample_strides = &byte_strides[i * ndim];
+      for (int d = 0; d < ndim; ++d)
+        sample_strides[d] = dl_tensor.strides[d] * item_size;
+      strides[i] = sample_strides;
+    }
+  }
+  CopyWithStride<GPUBackend>(outputs.data(), inputs.data(), strides.data(), shapes.data(),
+                             batch_size, ndim, item_size, workspace.stream());
+}
+
+namespace {
+
+/**
+ * @brief Whether the DLPack tensor is stored densely, in the row-major order
+ */
+bool IsDenseDLTensor(const DLTensor &dl_tensor) {
+  if (!dl_tensor.strides)
+    return true;
+  int64_t expected_stride = 1;
+  for (int d = dl_tensor.ndim - 1; d >= 0; d--) {
+    if (dl_tensor.shape[d] != 1 && dl_tensor.strides[d] != expected_stride)
+      return false;
+    expected_stride *= dl_tensor.shape[d];
+  }
+  return true;
+}
+
+/**
+ * @brief Releases a DLPack tensor produced in Python (e.g. by CuPy or PyTorch).
+ *
+ * The deleter of the producer may touch Python objects, so it runs with the GIL held.
+ * If the interpreter is already gone, so is the producer - the tensor is left alone then.
+ */
+void PythonDLMTensorDeleter(DLManagedTensor *dlm_tensor) {
+  if (!Py_IsInitialized())
+    return;
+  py::gil_scoped_acquire interpreter_guard{};
+  DLMTensorPtrDeleter(dlm_tensor);
+}
+
+}  // namespace
+
+template <>
+bool ShareOutputData(TensorList<CPUBackend> &, std::vector<DLMTensorPtr> &, int) {
+  return false;
+}
+
+template <>
+bool ShareOutputData(TensorList<GPUBackend> &output, std::vector<DLMTensorPtr> &dl_tensors,
+                     int batch_size) {
+  if (output.GetContiguity() == BatchContiguity::Contiguous)
+    return false;
+  int device_id = output.device_id();
+  for (auto &dlm_tensor : dl_tensors) {
+    auto &dl_tensor = dlm_tensor->dl_tensor;
+    if (dl_tensor.device.device_type != kDLCUDA || dl_tensor.device.device_id != device_id ||
+        !IsDenseDLTensor(dl_tensor))
+      return false;
+  }
+  auto type = DLToDALIType(dl_tensors[0]->dl_tensor.dtype);
+  size_t item_size = TypeTable::GetTypeInfo(type).size();
+  int ndim = dl_tensors[0]->dl_tensor.ndim;
+  auto layout = output.GetLayout();
+  auto order = output.order();
+  output.Reset();
+  output.SetSize(batch_size);
+  output.set_sample_dim(ndim);
+  output.set_type(type);
+  output.SetLayout(layout);
   for (int i = 0; i < batch_size; ++i) {
-    CopyDlTensor<GPUBackend>(output.raw_mutable_tensor(i), dl_tensors[i], workspace.stream());
+    auto &dl_tensor = dl_tensors[i]->dl_tensor;
+    TensorShape<> shape(make_span(dl_tensor.shape, dl_tensor.ndim));
+    void *data = static_cast<uint8_t *>(dl_tensor.data) + dl_tensor.byte_offset;
+    // the sample keeps the DLPack tensor (and the Python object behind it) alive
+    std::shared_ptr<DLManagedTensor> owner(dl_tensors[i].release(), PythonDLMTensorDeleter);
+    std::shared_ptr<void> sample_ptr(owner, data);
+    output.SetSample(i, sample_ptr, volume(shape) * item_size, false, shape, type, device_id,
+                     order, layout);
   }
+  return true;
 }
 
 }  // namespace detail
@@ -101,6 +101,15 @@ template <typename Workspace, typename Output>
 void CopyOutputData(Output& output, std::vector<DLMTensorPtr> &dl_tensors,
                     int batch_size, Workspace &workspace);
 
+/**
+ * @brief Adopts the memory of the DLPack tensors as the samples of the output, without a copy.
+ *
+ * Returns false (and leaves the tensors intact) if the tensors can't be adopted, e.g. because
+ * they are not dense or reside on another device - they must be copied then.
+ */
+template <typename Output>
+bool ShareOutputData(Output &output, std::vector<DLMTensorPtr> &dl_tensors, int batch_size);
+
 template <typename Backend>
 void PrepareOutputs(workspace_t<Backend> &ws, const py::object &output_o, int batch_size) {
   py::tuple return_tuple = (py::tuple::check_(output_o)) ? output_o : py::make_tuple(output_o);
@@ -109,6 +118,8 @@ void PrepareOutputs(workspace_t<Backend> &ws, const py::object &output_o, int ba
     auto dl_tensors = CastToDLTensorList<Backend>(dl_list, batch_size, idx);
     if (dl_tensors.empty()) continue;
     auto &tlist = ws.template Output<Backend>(idx);
+    if (ShareOutputData(tlist, dl_tensors, batch_size))
+      continue;
     tlist.Resize(GetDLTensorListShape(dl_tensors), DLToDALIType(dl_tensors[0]->dl_tensor.dtype));
     CopyOutputData(tlist, dl_tensors, batch_size, ws);
   }
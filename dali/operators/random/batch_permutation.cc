@@ -23,6 +23,7 @@ namespace dali {
 DALI_SCHEMA(BatchPermutation)
   .DocStr(R"(Produces a batch of random integers which can be used as indices for
 indexing samples in the batch.)")
+  .Nondeterministic()
   .NumInput(0)
   .NumOutput(1)
   .AddOptionalArg("allow_repetitions",
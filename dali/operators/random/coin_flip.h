@@ -15,7 +15,6 @@
 #ifndef DALI_OPERATORS_RANDOM_COIN_FLIP_H_
 #define DALI_OPERATORS_RANDOM_COIN_FLIP_H_
 
-#include <random>
 #include "dali/operators/random/rng_base.h"
 #include "dali/pipeline/operator/arg_helper.h"
 #include "dali/operators/random/rng_base_gpu.h"
@@ -27,10 +26,7 @@ namespace dali {
 
 template <typename Backend>
 struct CoinFlipImpl {
-  using DistType =
-    typename std::conditional_t<std::is_same<Backend, GPUBackend>::value,
-        curand_bernoulli_dist,
-        std::bernoulli_distribution>;
+  using DistType = philox_bernoulli_dist;
 
   DALI_HOST_DEV explicit CoinFlipImpl() {}
 
@@ -23,6 +23,7 @@ DALI_SCHEMA(noise__SaltAndPepper)
 
 The shape and data type of the output will match the input.
 )code")
+    .Nondeterministic()
     .NumInput(1)
     .NumOutput(1)
     .AddOptionalArg<float>("prob",
@@ -29,9 +29,7 @@ namespace dali {
 template <typename Backend, typename T>
 class SaltAndPepperNoiseImpl {
  public:
-  using DistType = typename std::conditional_t<std::is_same<Backend, GPUBackend>::value,
-                                               curand_uniform_dist<float>,
-                                               std::uniform_real_distribution<float>>;
+  using DistType = philox_uniform_dist<float>;
   static constexpr T kDefaultSalt =
       std::is_floating_point<T>::value ? T(1) : std::numeric_limits<T>::max();
   static constexpr T kDefaultPepper =
@@ -40,6 +40,7 @@ the output. A factor of 0 makes this an identity operation.
 
 The shape and data type of the output will match the input.
 )code")
+    .Nondeterministic()
     .NumInput(1)
     .NumOutput(1)
     .AddOptionalArg<float>("factor",
@@ -28,10 +28,7 @@ namespace dali {
 template <typename Backend, typename T>
 class ShotNoiseImpl {
  public:
-  using DistType =
-      typename std::conditional_t<std::is_same<Backend, GPUBackend>::value,
-                                  curand_poisson_dist,
-                                  std::poisson_distribution<uint32_t>>;
+  using DistType = philox_poisson_dist;
 
   DALI_HOST_DEV explicit ShotNoiseImpl(float factor = 12)
       : factor_{factor}, inv_factor_{1.0f / factor_} {}
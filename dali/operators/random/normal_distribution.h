@@ -30,9 +30,7 @@ struct NormalDistImpl {
   using FloatType =
       typename std::conditional<((std::is_integral<T>::value && sizeof(T) >= 4) || sizeof(T) > 4),
                                 double, float>::type;
-  using DistType = typename std::conditional_t<std::is_same<Backend, GPUBackend>::value,
-                                               curand_normal_dist<FloatType>,
-                                               std::normal_distribution<FloatType>>;
+  using DistType = philox_normal_dist<FloatType>;
 
   DALI_HOST_DEV NormalDistImpl() {}
 
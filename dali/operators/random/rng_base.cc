@@ -21,6 +21,7 @@ DALI_SCHEMA(RNGAttr)
     .DocStr(R"code(Random Number Generator attributes.
 
 It should be added as parent to all RNG operators.)code")
+    .Nondeterministic()
     .AddOptionalArg<std::vector<int>>("shape",
       R"code(Shape of the output data.)code", nullptr, true)
     .AddOptionalArg<DALIDataType>("dtype",
@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,13 +15,12 @@
 #ifndef DALI_OPERATORS_RANDOM_RNG_BASE_H_
 #define DALI_OPERATORS_RANDOM_RNG_BASE_H_
 
-#include <random>
 #include <vector>
 #include "dali/core/convert.h"
+#include "dali/core/philox.h"
 #include "dali/pipeline/operator/operator.h"
-#include "dali/pipeline/util/batch_rng.h"
 #include "dali/core/static_switch.h"
-#include "dali/operators/util/randomizer.cuh"
+#include "dali/operators/util/philox_dist.h"
 
 namespace dali {
 
@@ -33,8 +32,8 @@ class RNGBase : public Operator<Backend> {
  protected:
   explicit RNGBase(const OpSpec &spec)
       : Operator<Backend>(spec),
-        rng_(spec.GetArgument<int64_t>("seed"), max_batch_size_),
-        backend_data_(spec.GetArgument<int64_t>("seed"), max_batch_size_) {
+        seed_(spec.GetArgument<int64_t>("seed")),
+        backend_data_(max_batch_size_) {
   }
 
   Impl &This() noexcept { return static_cast<Impl&>(*this); }
@@ -89,6 +88,17 @@ class RNGBase : public Operator<Backend> {
     return true;
   }
 
+  /**
+   * @brief Returns the key of the Philox generator of a sample in the given iteration
+   *
+   * The element ``i`` of the sample is generated with ``Philox4x32_10(key, i)``, so the results
+   * depend only on the seed, the iteration, the sample and the element index - not on the
+   * backend or on how the work is split between the threads.
+   */
+  uint64_t SampleKey(int64_t iteration, int sample_idx) const {
+    return splitmix64(splitmix64(splitmix64(seed_) + iteration) + sample_idx);
+  }
+
   bool PerChannel() const {
     // By default generators don't interpret channel data, treating the data as a 1D array
     // If set to false by an implementation, the generation will occur once and will be applied
@@ -106,7 +116,8 @@ class RNGBase : public Operator<Backend> {
   using Operator<Backend>::max_batch_size_;
 
   DALIDataType dtype_ = DALI_NO_TYPE;
-  BatchRNG<std::mt19937_64> rng_;
+  uint64_t seed_;
+  int64_t iteration_ = 0;
   TensorListShape<> shape_;
   RNGBaseFields<Backend, IsNoiseGen> backend_data_;
 };
@@ -15,20 +15,19 @@
 #ifndef DALI_OPERATORS_RANDOM_RNG_BASE_CPU_H_
 #define DALI_OPERATORS_RANDOM_RNG_BASE_CPU_H_
 
-#include <random>
 #include <utility>
 #include <vector>
 #include "dali/operators/random/rng_base.h"
 #include "dali/core/convert.h"
+#include "dali/core/philox.h"
 #include "dali/pipeline/operator/operator.h"
-#include "dali/pipeline/util/batch_rng.h"
 #include "dali/core/static_switch.h"
 
 namespace dali {
 
 template <bool IsNoiseGen>
 struct RNGBaseFields<CPUBackend, IsNoiseGen> {
-  RNGBaseFields(int64_t seed, int nsamples) {}
+  explicit RNGBaseFields(int nsamples) {}
 
   std::vector<uint8_t> dists_cpu_;
 };
@@ -38,24 +37,26 @@ struct DistGen;
 
 template <>
 struct DistGen<false> {
-  template <typename T, typename Dist, typename RNG>
-  inline void gen(span<T> out, span<const T> in, Dist &dist, RNG &rng,
+  template <typename T, typename Dist>
+  inline void gen(span<T> out, span<const T> in, Dist &dist, uint64_t key,
                   int64_t p_offset, int64_t p_count) const {
     (void) in;
     int64_t p_pos = p_offset;
     for (int64_t p = 0; p < p_count; p++, p_pos++) {
+      Philox4x32_10 rng(key, p_pos);
       out[p_pos] = ConvertSat<T>(dist.Generate(rng));
     }
   }
 
-  template <typename T, typename Dist, typename RNG>
-  inline void gen_all_channels(span<T> out, span<const T> in, Dist &dist, RNG &rng,
+  template <typename T, typename Dist>
+  inline void gen_all_channels(span<T> out, span<const T> in, Dist &dist, uint64_t key,
                                int64_t p_offset, int64_t p_count, int c_count,
                                int64_t c_stride, int64_t p_stride) const {
     (void) in;
     int64_t p_pos = p_offset * p_stride;
     for (int64_t p = 0; p < p_count; p++, p_pos += p_stride) {
       int64_t c_pos = p_pos;
+      Philox4x32_10 rng(key, p_offset + p);
       auto n = ConvertSat<T>(dist.Generate(rng));
       for (int c = 0; c < c_count; c++, c_pos += c_stride) {
         out[c_pos] = n;
@@ -66,25 +67,27 @@ struct DistGen<false> {
 
 template <>
 struct DistGen<true> {
-  template <typename T, typename Dist, typename RNG>
-  inline void gen(span<T> out, span<const T> in, Dist& dist, RNG &rng,
+  template <typename T, typename Dist>
+  inline void gen(span<T> out, span<const T> in, Dist& dist, uint64_t key,
                   int64_t p_offset, int64_t p_count) const {
     assert(out.size() == in.size());
     int64_t p_pos = p_offset;
     for (int64_t p = 0; p < p_count; p++, p_pos++) {
+      Philox4x32_10 rng(key, p_pos);
       auto n = dist.Generate(in[p_pos], rng);
       dist.Apply(out[p_pos], in[p_pos], n);
     }
   }
 
-  template <typename T, typename Dist, typename RNG>
-  inline void gen_all_channels(span<T> out, span<const T> in, Dist& dist, RNG &rng,
+  template <typename T, typename Dist>
+  inline void gen_all_channels(span<T> out, span<const T> in, Dist& dist, uint64_t key,
                                int64_t p_offset, int64_t p_count,
                                int c_count, int64_t c_stride, int64_t p_stride) const {
     assert(out.size() == in.size());
     int64_t p_pos = p_offset * p_stride;
     for (int64_t p = 0; p < p_count; p++, p_pos += p_stride) {
       int64_t c_pos = p_pos;
+      Philox4x32_10 rng(key, p_offset + p);
       auto n = dist.Generate(in[p_pos], rng);
       for (int c = 0; c < c_count; c++, c_pos += c_stride) {
         dist.Apply(out[c_pos], in[c_pos], n);
@@ -111,7 +114,7 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(workspace_t<CPUBackend> &w
   auto &tp = ws.GetThreadPool();
   constexpr int64_t kThreshold = 1 << 18;
   constexpr int64_t kChunkSize = 1 << 16;
-  constexpr size_t kNumChunkSeeds = 16;
+  int64_t iteration = iteration_++;
   int nsamples = output.shape().size();
   int ndim = output.shape().sample_dim();
 
@@ -135,6 +138,7 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(workspace_t<CPUBackend> &w
 
   DistGen<IsNoiseGen> dist_gen_;
   for (int sample_id = 0; sample_id < nsamples; ++sample_id) {
+    uint64_t key = SampleKey(iteration, sample_id);
     auto sample_sz = out_shape.tensor_size(sample_id);
     int64_t total_p_count = sample_sz;
     int nchannels = -1;
@@ -160,39 +164,21 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(workspace_t<CPUBackend> &w
       p_stride = channel_dim == 0 ? 1 : nchannels;
     }
 
-    if (total_p_count < kThreshold) {
+    // Each element has its own generator, so the chunks are independent of each other
+    int chunks = total_p_count < kThreshold ? 1 : div_ceil(total_p_count, kChunkSize);
+    for (int c = 0; c < chunks; c++) {
+      int64_t p_offset, p_count;
+      std::tie(p_offset, p_count) = get_chunk<T>(total_p_count, c, chunks);
       tp.AddWork(
         [=](int thread_id) {
           auto dist = use_default_dist ? Dist() : dists[sample_id];
           if (independent_channels) {
-            dist_gen_.template gen<T>(out_span, in_span, dist, rng_[sample_id], 0, total_p_count);
+            dist_gen_.template gen<T>(out_span, in_span, dist, key, p_offset, p_count);
           } else {
-            dist_gen_.template gen_all_channels<T>(out_span, in_span, dist, rng_[sample_id], 0,
-                                                   total_p_count, nchannels, c_stride, p_stride);
+            dist_gen_.template gen_all_channels<T>(out_span, in_span, dist, key, p_offset,
+                                                   p_count, nchannels, c_stride, p_stride);
           }
-        }, total_p_count);
-    } else {
-      int chunks = div_ceil(total_p_count, kChunkSize);
-      std::array<uint32_t, kNumChunkSeeds> seed;
-      for (int c = 0; c < chunks; c++) {
-        int64_t p_offset, p_count;
-        std::tie(p_offset, p_count) = get_chunk<T>(total_p_count, c, chunks);
-        for (auto &s : seed)
-          s = rng_[sample_id]();
-        tp.AddWork(
-          [=](int thread_id) {
-            std::seed_seq seq(seed.begin(), seed.end());
-            std::mt19937_64 chunk_rng(seq);
-            auto dist = use_default_dist ? Dist() : dists[sample_id];
-            if (independent_channels) {
-              dist_gen_.template gen<T>(out_span, in_span, dist, chunk_rng,
-                                        p_offset, p_count);
-            } else {
-              dist_gen_.template gen_all_channels<T>(out_span, in_span, dist, chunk_rng, p_offset,
-                                                     p_count, nchannels, c_stride, p_stride);
-            }
-          }, p_count);
-      }
+        }, p_count);
     }
   }
   tp.RunAll();
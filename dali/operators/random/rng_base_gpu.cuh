@@ -19,8 +19,8 @@
 #include <vector>
 #include "dali/core/convert.h"
 #include "dali/operators/random/rng_base_gpu.h"
+#include "dali/core/philox.h"
 #include "dali/pipeline/operator/operator.h"
-#include "dali/pipeline/util/batch_rng.h"
 #include "dali/core/static_switch.h"
 #include "dali/kernels/dynamic_scratchpad.h"
 
@@ -35,13 +35,13 @@ template <typename T, typename Dist>
 __device__ __inline__ void Generate(const SampleDesc &sample,
                                     const BlockDesc &block,
                                     Dist& dist,
-                                    curandState* __restrict__ rng,
                                     bool_const<true>,     // is_noise_gen
                                     bool_const<true>) {   // is_per_channel
   auto out = static_cast<T*>(sample.output);
   auto in = static_cast<const T*>(sample.input);
   auto idx_end = block.p_offset + block.p_count;
   for (auto idx = block.p_offset + threadIdx.x; idx < idx_end; idx += blockDim.x) {
+    Philox4x32_10 rng(sample.key, idx);
     auto n = dist.Generate(in[idx], rng);
     dist.Apply(out[idx], in[idx], n);
   }
@@ -51,7 +51,6 @@ template <typename T, typename Dist>
 __device__ __inline__ void Generate(const SampleDesc &sample,
                                     const BlockDesc &block,
                                     Dist& dist,
-                                    curandState* __restrict__ rng,
                                     bool_const<true>,     // is_noise_gen
                                     bool_const<false>) {  // is_per_channel
   auto out = static_cast<T*>(sample.output);
@@ -61,6 +60,7 @@ __device__ __inline__ void Generate(const SampleDesc &sample,
     int64_t pos = idx * sample.p_stride;
     // Implementations that generate noise once for all channels should not depend on the input
     // to generate the number.
+    Philox4x32_10 rng(sample.key, idx);
     auto n = dist.Generate({}, rng);
     for (int c = 0; c < sample.c_count; c++, pos += sample.c_stride) {
       dist.Apply(out[pos], in[pos], n);
@@ -72,12 +72,12 @@ template <typename T, typename Dist>
 __device__ __inline__ void Generate(const SampleDesc &sample,
                                     const BlockDesc &block,
                                     Dist& dist,
-                                    curandState* __restrict__ rng,
                                     bool_const<false>,     // is_noise_gen
                                     bool_const<true>) {    // is_per_channel
   auto out = static_cast<T*>(sample.output);
   auto idx_end = block.p_offset + block.p_count;
   for (auto idx = block.p_offset + threadIdx.x; idx < idx_end; idx += blockDim.x) {
+    Philox4x32_10 rng(sample.key, idx);
     auto n = dist.Generate(rng);
     out[idx] = ConvertSat<T>(n);
   }
@@ -87,13 +87,13 @@ template <typename T, typename Dist>
 __device__ __inline__ void Generate(const SampleDesc &sample,
                                     const BlockDesc &block,
                                     Dist& dist,
-                                    curandState* __restrict__ rng,
                                     bool_const<false>,      // is_noise_gen
                                     bool_const<false>) {    // is_per_channel
   auto out = static_cast<T*>(sample.output);
   auto idx_end = block.p_offset + block.p_count;
   for (auto idx = block.p_offset + threadIdx.x; idx < idx_end; idx += blockDim.x) {
     int64_t pos = idx * sample.p_stride;
+    Philox4x32_10 rng(sample.key, idx);
     auto n = dist.Generate(rng);
     for (int c = 0; c < sample.c_count; c++, pos += sample.c_stride) {
       out[pos] = ConvertSat<T>(n);
@@ -104,19 +104,14 @@ __device__ __inline__ void Generate(const SampleDesc &sample,
 template <typename T, typename Dist, bool DefaultDist, bool IsNoiseGen, bool IsPerChannel>
 __global__ void RNGKernel(SampleDesc* __restrict__ sample_descs,
                           BlockDesc* __restrict__ block_descs,
-                          curandState* __restrict__ states,
                           const Dist* __restrict__ dists, int nblocks) {
-  int block_size = blockDim.x * blockDim.y;
-  int local_tid = blockDim.x * threadIdx.y + threadIdx.x;
-  int64_t global_tid = blockIdx.y * block_size + local_tid;
-  auto rng = states + global_tid;
   int blk_stride = blockDim.y * gridDim.y;
   int blk = blockIdx.y * blockDim.y + threadIdx.y;
   for (; blk < nblocks; blk += blk_stride) {
     auto block = block_descs[blk];
     auto sample = sample_descs[block.sample_idx];
     Dist dist = DefaultDist ? Dist() : dists[block.sample_idx];
-    Generate<T, Dist>(sample, block, dist, rng,
+    Generate<T, Dist>(sample, block, dist,
                       bool_const<IsNoiseGen>(), bool_const<IsPerChannel>());
   }
 }
@@ -128,7 +123,7 @@ template <typename T, typename Dist>
 void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(workspace_t<GPUBackend> &ws) {
   static_assert(std::is_same<Backend, GPUBackend>::value, "Unexpected backend");
   auto &output = ws.template Output<GPUBackend>(0);
-  auto rngs = backend_data_.randomizer_.states();
+  int64_t iteration = iteration_++;
   int block_sz = backend_data_.block_size_;
   int max_nblocks = backend_data_.max_blocks_;
   int blockdesc_count = -1;
@@ -159,6 +154,8 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(workspace_t<GPUBackend> &w
   auto &samples_cpu = backend_data_.sample_descs_cpu_;
   samples_cpu.resize(nsamples);
   SetupSampleDescs(samples_cpu.data(), out_view, in_view, channel_dim);
+  for (int s = 0; s < nsamples; s++)
+    samples_cpu[s].key = SampleKey(iteration, s);
 
   auto &blocks_cpu = backend_data_.block_descs_cpu_;
   blocks_cpu.resize(max_nblocks);
@@ -203,7 +200,7 @@ void RNGBase<Backend, Impl, IsNoiseGen>::RunImplTyped(workspace_t<GPUBackend> &w
     VALUE_SWITCH(independent_channels ? 1 : 0, IsPerChannel, (false, true), (
       RNGKernel<T, Dist, DefaultDist, IsNoiseGen, IsPerChannel>
         <<<gridDim, blockDim, 0, ws.stream()>>>(samples_gpu, blocks_gpu,
-                                                rngs, dists_gpu, blockdesc_count);
+                                                dists_gpu, blockdesc_count);
     ), ());  // NOLINT
   ), ());  // NOLINT
   CUDA_CALL(cudaGetLastError());
@@ -30,6 +30,7 @@ namespace dali {
 struct SampleDesc {
   void *output;
   const void* input;
+  uint64_t key;  // the key of the Philox generator of the sample
   int64_t p_count;
   int64_t p_stride;
   int64_t c_count;
@@ -44,21 +45,19 @@ struct BlockDesc {
 
 template <bool IsNoiseGen>
 struct RNGBaseFields<GPUBackend, IsNoiseGen> {
-  RNGBaseFields<GPUBackend, IsNoiseGen>(int64_t seed, int max_batch_size,
-                                        int64_t static_sample_size = -1)
+  explicit RNGBaseFields<GPUBackend, IsNoiseGen>(int max_batch_size,
+                                                 int64_t static_sample_size = -1)
       : block_size_(static_sample_size < 0 ? 256 : std::min<int64_t>(static_sample_size, 256)),
         max_blocks_(static_sample_size < 0 ?
                         1024 :
                         std::min<int64_t>(
-                            max_batch_size * div_ceil(static_sample_size, block_size_), 1024)),
-        randomizer_(seed, block_size_ * max_blocks_) {
+                            max_batch_size * div_ceil(static_sample_size, block_size_), 1024)) {
     sample_descs_cpu_.resize(max_batch_size);
     block_descs_cpu_.resize(max_blocks_);
   }
 
   const int block_size_;
   const int max_blocks_;
-  curand_states randomizer_;
 
   std::vector<SampleDesc> sample_descs_cpu_;
   std::vector<BlockDesc> block_descs_cpu_;
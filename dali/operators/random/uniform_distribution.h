@@ -26,67 +26,12 @@
 
 namespace dali {
 
-/**
- * @brief Wraps std::uniform_real_distribution<T>> and works around the issue
- *        with end of the range (GCC and LLVM bug)
- */
-template <typename T>
-class uniform_real_dist {
- public:
-  explicit uniform_real_dist(T range_start = -1, T range_end = 1)
-      : range_end_(range_end)
-      , dist_(range_start, range_end) {
-    assert(range_end > range_start);
-  }
-
-  template <typename Generator>
-  inline T operator()(Generator& g) {
-    T val = range_end_;
-    while (val >= range_end_)
-      val = dist_(g);
-    return val;
-  }
-
- private:
-  T range_end_ = 1;
-  std::uniform_real_distribution<T> dist_;
-};
-
-
-/**
- * @brief Draws values from a discrete uniform distribution
- */
-template <typename T>
-class uniform_int_values_dist {
- public:
-  uniform_int_values_dist() : values_(nullptr), nvalues_(0) {
-    // Should not be used. It is just here to make the base
-    // RNG operator code easier.
-    assert(false);
-  }
-  uniform_int_values_dist(const T *values, int64_t nvalues)
-    : values_(values), nvalues_(nvalues), dist_(0, nvalues-1) {}
-
-  template <typename Generator>
-  inline T operator()(Generator& g) {
-    int idx = dist_(g);
-    return values_[idx];
-  }
-
- private:
-  const T *values_ = nullptr;
-  int64_t nvalues_ = 0;
-  std::uniform_int_distribution<int> dist_;
-};
-
 template <typename Backend, typename T>
 struct UniformDistributionContinuousImpl {
   using FloatType =
       typename std::conditional<((std::is_integral<T>::value && sizeof(T) >= 4) || sizeof(T) > 4),
                                 double, float>::type;
-  using DistType =
-      typename std::conditional_t<std::is_same<Backend, GPUBackend>::value,
-                                  curand_uniform_dist<FloatType>, uniform_real_dist<FloatType>>;
+  using DistType = philox_uniform_dist<FloatType>;
 
   DALI_HOST_DEV UniformDistributionContinuousImpl()
     : dist_(-1, 1) {}
@@ -105,9 +50,7 @@ struct UniformDistributionContinuousImpl {
 
 template <typename Backend, typename T>
 struct UniformDistributionDiscreteImpl {
-  using DistType = typename std::conditional_t<std::is_same<Backend, GPUBackend>::value,
-                                               curand_uniform_int_values_dist<float>,
-                                               uniform_int_values_dist<float>>;
+  using DistType = philox_uniform_values_dist<float>;
 
   DALI_HOST_DEV explicit UniformDistributionDiscreteImpl() : dist_(nullptr, 0) {}
 
@@ -163,6 +163,17 @@ preprocessed COCO annotations.)code",
     std::string())
   .DeprecateArgInFavorOf("dump_meta_files_path",
                          "save_preprocessed_annotations_dir")  // deprecated since 0.28dev
+  .AddOptionalArg("annotations_cache",
+      R"code(Path to a binary index of the parsed annotations.
+
+If the index exists and was built from the same ``annotations_file`` with the same arguments,
+the annotations are memory-mapped from it instead of being parsed. The boxes, labels, polygons
+and vertices of the samples are then read directly from the mapping, which can be shared by
+the readers in one process.
+Otherwise, the annotations are parsed and the index is written to this path.
+
+This argument is mutually exclusive with ``preprocessed_annotations``.)code",
+      std::string())
   .AdditionalOutputsFn(COCOReaderOutputFn)
   .AddParent("LoaderBase");
 
@@ -206,6 +217,7 @@ void COCOReader::RunImpl(SampleWorkspace &ws) {
 
   image_output.Resize({image_size}, DALI_UINT8);
   image_output.SetSourceInfo(image_label.image.GetSourceInfo());
+  image_output.SetCacheKey(image_label.image.GetMeta().GetCacheKey());
   std::memcpy(image_output.mutable_data<uint8_t>(), image_label.image.raw_data(), image_size);
 
   auto &loader_impl = LoaderImpl();
@@ -85,7 +85,10 @@ for details.
       R"(Path to a directory that contains the data files.
 
 If not using ``file_list`` or ``files``, this directory is traversed to discover the files.
-``file_root`` is required in this mode of operation.)",
+``file_root`` is required in this mode of operation.
+
+The subdirectories are traversed in parallel. When the files are not shuffled and there is only
+one shard, the reader starts reading the files found first while the traversal continues.)",
       nullptr)
   .AddOptionalArg<string>("file_list",
       R"(Path to a text file that contains one whitespace-separated ``filename label``
@@ -116,6 +119,21 @@ This argument is ignored when file paths are taken from ``file_list`` or ``files
       kKnownExtensionsGlob)
   .AddOptionalArg<bool>("case_sensitive_filter", R"(If set to True, the filter will be matched
 case-sensitively, otherwise case-insensitively.)", false)
+  .AddOptionalArg<string>("file_list_cache", R"(Path to a file where the list of the files found
+in ``file_root`` is saved.
+
+On the next runs, the list is loaded from that file instead of traversing the directories again,
+as long as ``file_root``, the filters and the modification times of its subdirectories are the
+same. Otherwise, the directories are traversed and the file is overwritten.
+
+This argument is ignored when file paths are taken from ``file_list`` or ``files``.)", "")
+  .AddOptionalArg("parse_image_info", R"(If set to True, the headers of the images are parsed
+while the files are read ahead and the shape and the EXIF orientation of the images are attached
+to the samples as metadata.
+
+The decoders and the operators which need the shapes of the encoded images (e.g.
+:meth:`nvidia.dali.fn.peek_image_shape`) then use it instead of parsing the headers again.
+The files which aren't images of a supported format are passed without the metadata.)", false)
   .AddParent("LoaderBase");
 
 
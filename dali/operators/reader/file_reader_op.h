@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -32,6 +32,27 @@ class FileReader : public DataReader<CPUBackend, ImageLabelWrapper> {
     loader_ = InitLoader<FileLabelLoader>(spec, shuffle_after_epoch);
   }
 
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  /**
+   * @brief The sizes of the files are known once the batch is prefetched, so the outputs
+   *        are allocated by the executor as contiguous batches.
+   */
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) override {
+    DataReader<CPUBackend, ImageLabelWrapper>::SetupImpl(output_desc, ws);
+    int batch_size = GetCurrBatchSize();
+    output_desc.resize(2);
+    output_desc[0].type = DALI_UINT8;
+    output_desc[0].shape.resize(batch_size, 1);
+    for (int i = 0; i < batch_size; i++)
+      output_desc[0].shape.tensor_shape_span(i)[0] = GetSample(i).image.size();
+    output_desc[1].type = DALI_INT32;
+    output_desc[1].shape = uniform_list_shape(batch_size, {1});
+    return true;
+  }
+
   void RunImpl(SampleWorkspace &ws) override {
     const int idx = ws.data_idx();
 
@@ -41,15 +62,12 @@ class FileReader : public DataReader<CPUBackend, ImageLabelWrapper> {
     auto &image_output = ws.Output<CPUBackend>(0);
     auto &label_output = ws.Output<CPUBackend>(1);
 
-    Index image_size = image_label.image.size();
-
-    image_output.Resize({image_size}, DALI_UINT8);
-    label_output.Resize({1}, DALI_INT32);
-
     std::memcpy(image_output.raw_mutable_data(),
                 image_label.image.raw_data(),
-                image_size);
+                image_label.image.size());
     image_output.SetSourceInfo(image_label.image.GetSourceInfo());
+    image_output.SetCacheKey(image_label.image.GetMeta().GetCacheKey());
+    image_output.SetImageInfo(image_label.image.GetImageInfo());
 
     label_output.mutable_data<int>()[0] = image_label.label;
   }
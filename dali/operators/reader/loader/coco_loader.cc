@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -12,15 +12,22 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
 #include <list>
 #include <map>
 #include <unordered_map>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
+#include "dali/core/util.h"
 #include "dali/operators/reader/loader/coco_loader.h"
 #include "dali/pipeline/util/lookahead_parser.h"
+#include "dali/util/file.h"
 
 namespace dali {
 namespace detail {
@@ -409,6 +416,127 @@ void ParseJsonFile(const OpSpec &spec, std::vector<detail::ImageInfo> &image_inf
   }
 }
 
+/*
+ * The annotations index is a single binary file - a header, followed by the columns with
+ * the parsed annotations. Each column is a flat array, aligned to kIndexAlignment bytes,
+ * so that it can be accessed directly in the memory-mapped file.
+ */
+constexpr char kIndexMagic[8] = {'D', 'A', 'L', 'I', 'C', 'O', 'C', 'O'};
+constexpr uint32_t kIndexVersion = 1;
+constexpr int64_t kIndexAlignment = 64;
+
+enum IndexColumn : int {
+  kIndexOptions,        // the description of the arguments the index was built with
+  kIndexFilenames,      // the file names of the images, concatenated
+  kIndexFilenameEnds,   // the end offsets of the file names
+  kIndexFileLabels,
+  kIndexHeights,
+  kIndexWidths,
+  kIndexOffsets,
+  kIndexBoxes,
+  kIndexLabels,
+  kIndexCounts,
+  kIndexOriginalIds,
+  kIndexPolygonData,
+  kIndexPolygonOffset,
+  kIndexPolygonCount,
+  kIndexVertices,
+  kIndexVerticesOffset,
+  kIndexVerticesCount,
+  kIndexMasksRlesIdx,
+  kIndexMaskOffsets,
+  kIndexMaskCounts,
+  kIndexRleDims,        // (h, w, m) of the RLE masks
+  kIndexRleCounts,      // the counts of the RLE masks, concatenated
+  kIndexNumColumns
+};
+
+struct IndexHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_columns;
+  struct {
+    int64_t offset, size;  // in bytes
+  } columns[kIndexNumColumns];
+};
+
+class IndexWriter {
+ public:
+  explicit IndexWriter(const std::string &path)
+      : path_(path), file_(path, std::ios_base::binary | std::ios_base::out) {
+    DALI_ENFORCE(file_, "CocoReader annotations index error while saving: " + path);
+    std::memcpy(header_.magic, kIndexMagic, sizeof(kIndexMagic));
+    header_.version = kIndexVersion;
+    header_.num_columns = kIndexNumColumns;
+    Write(file_, header_, path_.c_str());  // a placeholder - the offsets are not known yet
+    pos_ = sizeof(header_);
+  }
+
+  template <typename T>
+  void Add(IndexColumn column, span<const T> data) {
+    static const char padding[kIndexAlignment] = {};
+    int64_t aligned = align_up(pos_, kIndexAlignment);
+    Write(file_, span<const char>{padding, aligned - pos_}, path_.c_str());
+    int64_t size = data.size() * sizeof(T);
+    header_.columns[column] = {aligned, size};
+    Write(file_, data, path_.c_str());
+    pos_ = aligned + size;
+  }
+
+  void Finish() {
+    file_.seekp(0);
+    Write(file_, header_, path_.c_str());
+    file_.close();
+    DALI_ENFORCE(file_.good(), make_string("Error writing to path: ", path_));
+  }
+
+ private:
+  std::string path_;
+  std::ofstream file_;
+  IndexHeader header_ = {};
+  int64_t pos_ = 0;
+};
+
+class IndexReader {
+ public:
+  IndexReader(const void *data, int64_t size) : data_(static_cast<const char *>(data)) {
+    valid_ = size >= static_cast<int64_t>(sizeof(header_));
+    if (!valid_)
+      return;
+    std::memcpy(&header_, data_, sizeof(header_));
+    valid_ = !std::memcmp(header_.magic, kIndexMagic, sizeof(kIndexMagic)) &&
+             header_.version == kIndexVersion && header_.num_columns == kIndexNumColumns;
+    for (int c = 0; valid_ && c < kIndexNumColumns; c++) {
+      auto &column = header_.columns[c];
+      valid_ = column.offset % kIndexAlignment == 0 && column.offset >= 0 && column.size >= 0 &&
+               column.offset + column.size <= size;
+    }
+  }
+
+  bool valid() const {
+    return valid_;
+  }
+
+  /**
+   * @brief Points `out` at the column; invalidates the reader if the column doesn't hold Ts
+   */
+  template <typename T>
+  void Get(IndexColumn column, span<const T> &out) {
+    auto &desc = header_.columns[column];
+    if (!valid_ || desc.size % sizeof(T)) {
+      valid_ = false;
+      return;
+    }
+    out = {reinterpret_cast<const T *>(data_ + desc.offset),
+           static_cast<int64_t>(desc.size / sizeof(T))};
+  }
+
+ private:
+  const char *data_;
+  IndexHeader header_;
+  bool valid_ = false;
+};
+
 }  // namespace detail
 
 void CocoLoader::SavePreprocessedAnnotations(const std::string &path,
@@ -478,6 +606,184 @@ void CocoLoader::ParsePreprocessedAnnotations() {
   }
 }
 
+void CocoLoader::ViewParsedAnnotations() {
+  view_.heights = make_cspan(heights_);
+  view_.widths = make_cspan(widths_);
+  view_.offsets = make_cspan(offsets_);
+  view_.boxes = make_cspan(boxes_);
+  view_.labels = make_cspan(labels_);
+  view_.counts = make_cspan(counts_);
+  view_.original_ids = make_cspan(original_ids_);
+  view_.polygon_data = make_cspan(polygon_data_);
+  view_.polygon_offset = make_cspan(polygon_offset_);
+  view_.polygon_count = make_cspan(polygon_count_);
+  view_.vertices_data = make_cspan(vertices_data_);
+  view_.vertices_offset = make_cspan(vertices_offset_);
+  view_.vertices_count = make_cspan(vertices_count_);
+  view_.masks_rles_idx = make_cspan(masks_rles_idx_);
+  view_.mask_offsets = make_cspan(mask_offsets_);
+  view_.mask_counts = make_cspan(mask_counts_);
+}
+
+std::string CocoLoader::AnnotationsIndexOptions() const {
+  auto annotations_file = spec_.GetArgument<std::string>("annotations_file");
+  struct stat st;
+  DALI_ENFORCE(stat(annotations_file.c_str(), &st) == 0,
+               "Could not open JSON annotations file: \"" + annotations_file + "\"");
+  std::stringstream ss;
+  // the size and the modification time are there so that the index is rebuilt
+  // when the annotations file changes
+  ss << "annotations_file=" << annotations_file
+     << "\nsize=" << st.st_size
+     << "\nmtime=" << st.st_mtime
+     << "\nskip_empty=" << spec_.GetArgument<bool>("skip_empty")
+     << "\nratio=" << spec_.GetArgument<bool>("ratio")
+     << "\nltrb=" << spec_.GetArgument<bool>("ltrb")
+     << "\nsize_threshold=" << std::hexfloat << spec_.GetArgument<float>("size_threshold")
+     << "\navoid_class_remapping=" << spec_.GetArgument<bool>("avoid_class_remapping")
+     << "\npolygon_masks=" << output_polygon_masks_
+     << "\npixelwise_masks=" << output_pixelwise_masks_
+     << "\nimage_ids=" << output_image_ids_
+     << "\nimages=" << images_.size();
+  for (auto &image : images_)
+    ss << "\n" << image;
+  return ss.str();
+}
+
+void CocoLoader::SaveAnnotationsIndex(const std::string &options) {
+  std::string filenames;
+  std::vector<int64_t> filename_ends;
+  std::vector<int> file_labels;
+  for (auto &image_label : image_label_pairs_) {
+    filenames += image_label.first;
+    filename_ends.push_back(filenames.size());
+    file_labels.push_back(image_label.second);
+  }
+  std::vector<uint64_t> rle_dims;
+  std::vector<uint> rle_counts;
+  for (auto &rle : masks_rles_) {
+    rle_dims.insert(rle_dims.end(), {(*rle)->h, (*rle)->w, (*rle)->m});
+    rle_counts.insert(rle_counts.end(), (*rle)->cnts, (*rle)->cnts + (*rle)->m);
+  }
+
+  // The index is written under a temporary name and renamed when it's complete, so that
+  // the readers that load it at the same time never see a partial file.
+  auto tmp_path = make_string(annotations_cache_, ".", getpid(), ".",
+                              reinterpret_cast<uintptr_t>(this), ".tmp");
+  using namespace detail;  // NOLINT
+  IndexWriter writer(tmp_path);
+  writer.Add(kIndexOptions, make_cspan(options));
+  writer.Add(kIndexFilenames, make_cspan(filenames));
+  writer.Add(kIndexFilenameEnds, make_cspan(filename_ends));
+  writer.Add(kIndexFileLabels, make_cspan(file_labels));
+  writer.Add(kIndexHeights, view_.heights);
+  writer.Add(kIndexWidths, view_.widths);
+  writer.Add(kIndexOffsets, view_.offsets);
+  writer.Add(kIndexBoxes, view_.boxes);
+  writer.Add(kIndexLabels, view_.labels);
+  writer.Add(kIndexCounts, view_.counts);
+  writer.Add(kIndexOriginalIds, view_.original_ids);
+  writer.Add(kIndexPolygonData, view_.polygon_data);
+  writer.Add(kIndexPolygonOffset, view_.polygon_offset);
+  writer.Add(kIndexPolygonCount, view_.polygon_count);
+  writer.Add(kIndexVertices, view_.vertices_data);
+  writer.Add(kIndexVerticesOffset, view_.vertices_offset);
+  writer.Add(kIndexVerticesCount, view_.vertices_count);
+  writer.Add(kIndexMasksRlesIdx, view_.masks_rles_idx);
+  writer.Add(kIndexMaskOffsets, view_.mask_offsets);
+  writer.Add(kIndexMaskCounts, view_.mask_counts);
+  writer.Add(kIndexRleDims, make_cspan(rle_dims));
+  writer.Add(kIndexRleCounts, make_cspan(rle_counts));
+  writer.Finish();
+  if (std::rename(tmp_path.c_str(), annotations_cache_.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    DALI_FAIL(make_string("Could not save the annotations index to: ", annotations_cache_));
+  }
+}
+
+bool CocoLoader::LoadAnnotationsIndex(const std::string &options) {
+  using namespace detail;  // NOLINT
+  struct stat st;
+  if (stat(annotations_cache_.c_str(), &st) != 0 ||
+      st.st_size < static_cast<off_t>(sizeof(IndexHeader)))
+    return false;
+  auto file = FileStream::Open(annotations_cache_, false, true);
+  int64_t size = file->Size();
+  auto mapping = file->Get(size);
+  file->Close();  // the mapping is kept alive by `mapping`
+  if (!mapping)
+    return false;
+
+  IndexReader reader(mapping.get(), size);
+  span<const char> stored_options, filenames;
+  span<const int64_t> filename_ends;
+  span<const int> file_labels;
+  span<const uint64_t> rle_dims;
+  span<const uint> rle_counts;
+  decltype(view_) view;
+  reader.Get(kIndexOptions, stored_options);
+  reader.Get(kIndexFilenames, filenames);
+  reader.Get(kIndexFilenameEnds, filename_ends);
+  reader.Get(kIndexFileLabels, file_labels);
+  reader.Get(kIndexHeights, view.heights);
+  reader.Get(kIndexWidths, view.widths);
+  reader.Get(kIndexOffsets, view.offsets);
+  reader.Get(kIndexBoxes, view.boxes);
+  reader.Get(kIndexLabels, view.labels);
+  reader.Get(kIndexCounts, view.counts);
+  reader.Get(kIndexOriginalIds, view.original_ids);
+  reader.Get(kIndexPolygonData, view.polygon_data);
+  reader.Get(kIndexPolygonOffset, view.polygon_offset);
+  reader.Get(kIndexPolygonCount, view.polygon_count);
+  reader.Get(kIndexVertices, view.vertices_data);
+  reader.Get(kIndexVerticesOffset, view.vertices_offset);
+  reader.Get(kIndexVerticesCount, view.vertices_count);
+  reader.Get(kIndexMasksRlesIdx, view.masks_rles_idx);
+  reader.Get(kIndexMaskOffsets, view.mask_offsets);
+  reader.Get(kIndexMaskCounts, view.mask_counts);
+  reader.Get(kIndexRleDims, rle_dims);
+  reader.Get(kIndexRleCounts, rle_counts);
+  if (!reader.valid() ||
+      std::string(stored_options.data(), stored_options.size()) != options)
+    return false;
+
+  int64_t nimages = file_labels.size();
+  if (filename_ends.size() != nimages || view.offsets.size() != nimages ||
+      view.counts.size() != nimages || view.boxes.size() != 4 * view.labels.size() ||
+      rle_dims.size() % 3 != 0 ||
+      (nimages > 0 && filename_ends[nimages - 1] > filenames.size()))
+    return false;
+
+  image_label_pairs_.clear();
+  image_label_pairs_.reserve(nimages);
+  int64_t filename_start = 0;
+  for (int64_t i = 0; i < nimages; i++) {
+    if (filename_ends[i] < filename_start)
+      return false;
+    image_label_pairs_.emplace_back(
+        std::string(filenames.data() + filename_start, filenames.data() + filename_ends[i]),
+        file_labels[i]);
+    filename_start = filename_ends[i];
+  }
+
+  // the RLE masks are owned by RLEMask handles, so (only) they are copied
+  masks_rles_.clear();
+  masks_rles_.reserve(rle_dims.size() / 3);
+  int64_t counts_start = 0;
+  for (int64_t i = 0; i < rle_dims.size(); i += 3) {
+    siz h = rle_dims[i], w = rle_dims[i + 1], m = rle_dims[i + 2];
+    if (counts_start + static_cast<int64_t>(m) > rle_counts.size())
+      return false;
+    span<const uint> counts{rle_counts.data() + counts_start, static_cast<int64_t>(m)};
+    masks_rles_.push_back(std::make_shared<RLEMask>(h, w, counts));
+    counts_start += m;
+  }
+
+  view_ = view;
+  annotations_index_ = std::move(mapping);
+  return true;
+}
+
 void CocoLoader::ParseJsonAnnotations() {
   std::vector<detail::ImageInfo> image_infos;
   std::vector<detail::Annotation> annotations;
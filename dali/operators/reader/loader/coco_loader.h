@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -65,6 +65,11 @@ inline bool HasSavePreprocessedAnnotationsDir(const OpSpec &spec) {
     (spec.HasArgument("dump_meta_files_path") && spec.GetArgument<bool>("dump_meta_files_path"));
 }
 
+inline bool HasAnnotationsCache(const OpSpec &spec) {
+  return spec.HasArgument("annotations_cache") &&
+    !spec.GetArgument<std::string>("annotations_cache").empty();
+}
+
 struct RLEMask : public UniqueHandle<RLE, RLEMask> {
   DALI_INHERIT_UNIQUE_HANDLE(RLE, RLEMask)
 
@@ -106,13 +111,17 @@ class DLL_PUBLIC CocoLoader : public FileLabelLoader {
         "Either ``annotations_file`` or ``preprocessed_annotations`` must be provided");
     if (has_preprocessed_annotations_) {
       for (const char* arg_name : {"annotations_file", "skip_empty", "ratio", "ltrb", "images",
-                                   "size_threshold", "dump_meta_files", "dump_meta_files_path"}) {
+                                   "size_threshold", "dump_meta_files", "dump_meta_files_path",
+                                   "annotations_cache"}) {
         if (spec.HasArgument(arg_name))
           DALI_FAIL(make_string("When reading data from preprocessed annotation files, \"",
                                 arg_name, "\" is not supported."));
       }
     }
 
+    if (HasAnnotationsCache(spec))
+      annotations_cache_ = spec.GetArgument<std::string>("annotations_cache");
+
     spec.TryGetRepeatedArgument(images_, "images");
     output_polygon_masks_ = OutPolygonMasksEnabled(spec);
     output_pixelwise_masks_ = OutPixelwiseMasksEnabled(spec);
@@ -139,48 +148,62 @@ class DLL_PUBLIC CocoLoader : public FileLabelLoader {
   };
 
   span<const vec<4>> bboxes(int image_idx) const {
-    return {reinterpret_cast<const vec<4>*>(boxes_.data()) + offsets_[image_idx],
-            counts_[image_idx]};
+    return {reinterpret_cast<const vec<4>*>(view_.boxes.data()) + view_.offsets[image_idx],
+            view_.counts[image_idx]};
   }
 
   span<const int> labels(int image_idx) const {
-    return {labels_.data() + offsets_[image_idx], counts_[image_idx]};
+    return {view_.labels.data() + view_.offsets[image_idx], view_.counts[image_idx]};
   }
 
   int image_id(int image_idx) const {
     assert(output_image_ids_);
-    return original_ids_[image_idx];
+    return view_.original_ids[image_idx];
   }
 
   PixelwiseMasksInfo pixelwise_masks_info(int image_idx) const {
     assert(output_pixelwise_masks_);
     return {
-      {heights_[image_idx], widths_[image_idx], 1},
-      {masks_rles_.data() + mask_offsets_[image_idx], mask_counts_[image_idx]},
-      {masks_rles_idx_.data() + mask_offsets_[image_idx], mask_counts_[image_idx]}
+      {view_.heights[image_idx], view_.widths[image_idx], 1},
+      {masks_rles_.data() + view_.mask_offsets[image_idx], view_.mask_counts[image_idx]},
+      {view_.masks_rles_idx.data() + view_.mask_offsets[image_idx], view_.mask_counts[image_idx]}
     };
   }
 
   span<const ivec3> polygons(int image_idx) const {
     assert(output_polygon_masks_ || output_pixelwise_masks_);
-    if (polygon_data_.empty() || polygon_offset_.empty() || polygon_count_.empty())
+    if (view_.polygon_data.empty() || view_.polygon_offset.empty() ||
+        view_.polygon_count.empty())
       return {};
-    return {polygon_data_.data() + polygon_offset_[image_idx], polygon_count_[image_idx]};
+    return {view_.polygon_data.data() + view_.polygon_offset[image_idx],
+            view_.polygon_count[image_idx]};
   }
 
   span<const vec2> vertices(int image_idx) const {
     assert(output_polygon_masks_ || output_pixelwise_masks_);
-    if (vertices_data_.empty() || vertices_offset_.empty() || vertices_count_.empty())
+    if (view_.vertices_data.empty() || view_.vertices_offset.empty() ||
+        view_.vertices_count.empty())
       return {};
-    return {vertices_data_.data() + vertices_offset_[image_idx], vertices_count_[image_idx]};
+    return {view_.vertices_data.data() + view_.vertices_offset[image_idx],
+            view_.vertices_count[image_idx]};
   }
 
  protected:
   void PrepareMetadataImpl() override {
     if (has_preprocessed_annotations_) {
       ParsePreprocessedAnnotations();
-    } else {
+      ViewParsedAnnotations();
+    } else if (annotations_cache_.empty()) {
       ParseJsonAnnotations();
+      ViewParsedAnnotations();
+    } else {
+      // the options are taken before parsing, which consumes the list of images
+      auto options = AnnotationsIndexOptions();
+      if (!LoadAnnotationsIndex(options)) {
+        ParseJsonAnnotations();
+        ViewParsedAnnotations();
+        SaveAnnotationsIndex(options);
+      }
     }
 
     DALI_ENFORCE(SizeImpl() > 0, "No files found.");
@@ -199,6 +222,30 @@ class DLL_PUBLIC CocoLoader : public FileLabelLoader {
 
   void SavePreprocessedAnnotations(const std::string &path, const ImageIdPairs &image_id_pairs);
 
+  /**
+   * @brief Describes the arguments and the annotations file which the index is built from
+   *
+   * The index is used only if the description stored in it matches this one.
+   */
+  std::string AnnotationsIndexOptions() const;
+
+  /**
+   * @brief Memory-maps the annotations index and points the views at it
+   *
+   * @return false, if the index doesn't exist, is invalid or was built with different options
+   */
+  bool LoadAnnotationsIndex(const std::string &options);
+
+  /**
+   * @brief Writes the parsed annotations (and the image file names) to the annotations index
+   */
+  void SaveAnnotationsIndex(const std::string &options);
+
+  /**
+   * @brief Points the views at the parsed annotations
+   */
+  void ViewParsedAnnotations();
+
  private:
   const OpSpec spec_;
 
@@ -225,6 +272,22 @@ class DLL_PUBLIC CocoLoader : public FileLabelLoader {
   std::vector<int64_t> mask_offsets_;  // per-sample offsets of masks
   std::vector<int64_t> mask_counts_;   // number of masks per sample
 
+  // The annotations are accessed via these views - into the vectors above or
+  // into the memory-mapped annotations index
+  struct {
+    span<const int> heights, widths, offsets, labels, counts, original_ids;
+    span<const float> boxes;
+    span<const ivec3> polygon_data;
+    span<const int64_t> polygon_offset, polygon_count;
+    span<const vec2> vertices_data;
+    span<const int64_t> vertices_offset, vertices_count;
+    span<const int> masks_rles_idx;
+    span<const int64_t> mask_offsets, mask_counts;
+  } view_;
+
+  std::string annotations_cache_;
+  std::shared_ptr<void> annotations_index_;
+
   bool output_polygon_masks_ = false;
   bool output_pixelwise_masks_ = false;
   bool output_image_ids_ = false;
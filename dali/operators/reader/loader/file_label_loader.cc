@@ -12,9 +12,21 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "dali/core/common.h"
+#include "dali/imgcodec/image_format.h"
+#include "dali/imgcodec/image_source.h"
 #include "dali/operators/reader/loader/file_label_loader.h"
 #include "dali/util/file.h"
 #include "dali/operators/reader/loader/utils.h"
@@ -23,15 +35,87 @@ namespace dali {
 
 using filesystem::dir_sep;
 
+namespace {
+
+// listing the directories is mostly waiting for the file system
+constexpr int kListingThreads = 16;
+
+/*
+ * The cache is a text file:
+ *   <header>
+ *   <file_root>
+ *   <case_sensitive_filter>
+ *   <number of filters>
+ *   <filter> - one per line
+ *   <number of directories>
+ *   <label> <modification time> <directory name> - one per line, in the order of listing
+ *   <number of files>
+ *   <label> <file name> - one per line, the name relative to the directory
+ * It's valid as long as everything up to the files matches.
+ */
+constexpr const char kListingCacheHeader[] = "DALI file list cache 1";
+
+string ListingCacheKey(const string &file_root, const vector<string> &filters,
+                       bool case_sensitive_filter, const vector<filesystem::ClassDirectory> &dirs) {
+  std::stringstream ss;
+  ss << kListingCacheHeader << "\n" << file_root << "\n" << case_sensitive_filter << "\n"
+     << filters.size() << "\n";
+  for (auto &filter : filters)
+    ss << filter << "\n";
+  ss << dirs.size() << "\n";
+  for (auto &dir : dirs)
+    ss << dir.label << " " << dir.mtime << " " << dir.name << "\n";
+  return ss.str();
+}
+
+/**
+ * @brief Parses the header of the image and stores its shape and orientation in its metadata
+ *
+ * The files which aren't images of a supported format are left without the image info.
+ */
+void ParseImageInfo(Tensor<CPUBackend> &image) {
+  auto src = imgcodec::ImageSource::FromHostMem(image.raw_data(), image.size(),
+                                                image.GetSourceInfo());
+  try {
+    auto *format = imgcodec::ImageFormatRegistry::instance().GetImageFormat(&src);
+    if (!format)
+      return;
+    auto info = format->Parser()->GetInfo(&src);
+    EncodedImageInfo image_info;
+    image_info.shape = info.shape;
+    image_info.rotate = info.orientation.rotate;
+    image_info.flip_x = info.orientation.flip_x;
+    image_info.flip_y = info.orientation.flip_y;
+    image.SetImageInfo(image_info);
+  } catch (std::exception &) {
+    // corrupted header - the decoder reports the error
+  }
+}
+
+}  // namespace
+
 void FileLabelLoader::PrepareEmpty(ImageLabelWrapper &image_label) {
   PrepareEmptyTensor(image_label.image);
 }
 
 void FileLabelLoader::ReadSample(ImageLabelWrapper &image_label) {
-  auto image_pair = image_label_pairs_[current_index_++];
+  auto read = PrepareRead(image_label);
+  if (read)
+    read(0);
+}
 
-  // handle wrap-around
-  MoveToNextShard(current_index_);
+FileLabelLoader::ReadWork FileLabelLoader::PrepareRead(ImageLabelWrapper &image_label) {
+  std::pair<string, int> image_pair;
+  // the next file needs to be listed as well, to tell if this is the last one
+  if (listing_pending_ && WaitForListing(current_index_ + 2)) {
+    std::lock_guard<std::mutex> g(listing_mutex_);
+    image_pair = image_label_pairs_[current_index_++];
+  } else {
+    image_pair = image_label_pairs_[SampleIndex(current_index_++)];
+
+    // handle wrap-around
+    MoveToNextShard(current_index_);
+  }
 
   // copy the label
   image_label.label = image_pair.second;
@@ -40,40 +124,213 @@ void FileLabelLoader::ReadSample(ImageLabelWrapper &image_label) {
   meta.SetSkipSample(false);
 
   // if image is cached, skip loading
-  if (ShouldSkipImage(image_pair.first)) {
+  auto cache_key = ContentCacheKey(image_pair.first);
+  if (ShouldSkipImage(cache_key)) {
+    meta.SetCacheKey(cache_key);
     meta.SetSkipSample(true);
     image_label.image.Reset();
     image_label.image.SetMeta(meta);
     image_label.image.Resize({0}, DALI_UINT8);
-    return;
+    return {};
   }
 
-  auto current_image = FileStream::Open(filesystem::join_path(file_root_, image_pair.first),
-                                        read_ahead_, !copy_read_data_);
-  Index image_size = current_image->Size();
+  return [this, &image_label, image_name = std::move(image_pair.first), meta](int) {
+    auto path = filesystem::join_path(file_root_, image_name);
+    if (shared_cache_) {
+      if (image_label.image.shares_data()) {
+        image_label.image.Reset();
+      }
+      bool cached = shared_cache_->Get(path, [&](size_t size) -> void * {
+        image_label.image.Resize({static_cast<Index>(size)}, DALI_UINT8);
+        return image_label.image.raw_mutable_data();
+      });
+      if (cached) {
+        FinishRead(image_label, image_name, meta);
+        return;
+      }
+    }
+
+    auto current_image = FileStream::Open(path, read_ahead_, !copy_read_data_, use_io_uring_,
+                                          use_o_direct_, read_policy_);
+    Index image_size = current_image->Size();
 
-  if (copy_read_data_) {
-    if (image_label.image.shares_data()) {
-      image_label.image.Reset();
+    if (copy_read_data_) {
+      if (image_label.image.shares_data()) {
+        image_label.image.Reset();
+      }
+      image_label.image.Resize({image_size}, DALI_UINT8);
+      // copy the image
+      Index ret = current_image->Read(image_label.image.mutable_data<uint8_t>(), image_size);
+      DALI_ENFORCE(ret == image_size, make_string("Failed to read file: ", image_name));
+    } else {
+      auto p = current_image->Get(image_size);
+      DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", image_name));
+      // Wrap the raw data in the Tensor object.
+      image_label.image.ShareData(p, image_size, false, {image_size}, DALI_UINT8,
+                                  CPU_ONLY_DEVICE_ID);
     }
-    image_label.image.Resize({image_size}, DALI_UINT8);
-    // copy the image
-    Index ret = current_image->Read(image_label.image.mutable_data<uint8_t>(), image_size);
-    DALI_ENFORCE(ret == image_size, make_string("Failed to read file: ", image_pair.first));
-  } else {
-    auto p = current_image->Get(image_size);
-    DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", image_pair.first));
-    // Wrap the raw data in the Tensor object.
-    image_label.image.ShareData(p, image_size, false, {image_size}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
-  }
 
-  // close the file handle
-  current_image->Close();
+    if (shared_cache_)
+      shared_cache_->Put(path, image_label.image.raw_data(), image_size);
+
+    // close the file handle
+    current_image->Close();
+
+    FinishRead(image_label, image_name, meta);
+  };
+}
 
+void FileLabelLoader::FinishRead(ImageLabelWrapper &image_label, const std::string &image_name,
+                                 DALIMeta meta) {
+  if (HashContent(image_name, image_label.image.raw_data(), image_label.image.nbytes(), meta)) {
+    // the same content, read from another file, is cached
+    meta.SetSkipSample(true);
+    image_label.image.Reset();
+    image_label.image.SetMeta(meta);
+    image_label.image.Resize({0}, DALI_UINT8);
+    return;
+  }
   image_label.image.SetMeta(meta);
+  if (parse_image_info_)
+    ParseImageInfo(image_label.image);
 }
 
 Index FileLabelLoader::SizeImpl() {
+  if (listing_pending_)
+    WaitForListing(std::numeric_limits<Index>::max());
   return static_cast<Index>(image_label_pairs_.size());
 }
+
+double FileLabelLoader::SampleSizeKey(Index index) {
+  auto path = filesystem::join_path(file_root_, image_label_pairs_[index].first);
+  struct stat st;
+  DALI_ENFORCE(stat(path.c_str(), &st) == 0,
+               make_string("Cannot get the size of ", path, ": ", std::strerror(errno)));
+  return st.st_size;
+}
+
+void FileLabelLoader::ListFileRoot() {
+  auto dirs = filesystem::list_class_directories(file_root_);
+  if (!file_list_cache_.empty() && LoadListingCache(dirs))
+    return;
+
+  auto append = [this](vector<std::pair<string, int>> &&files) {
+    std::lock_guard<std::mutex> g(listing_mutex_);
+    image_label_pairs_.insert(image_label_pairs_.end(), std::make_move_iterator(files.begin()),
+                              std::make_move_iterator(files.end()));
+    listing_cv_.notify_all();
+    return !stop_listing_;
+  };
+
+  if (shuffle_ || shuffle_after_epoch_ || global_shuffle_ || bucket_by_size_ || num_shards_ > 1 ||
+      pad_last_batch_ || checkpointing_) {
+    filesystem::traverse_class_directories(file_root_, dirs, filters_, case_sensitive_filter_,
+                                           kListingThreads, append);
+    SaveListingCache(dirs);
+    return;
+  }
+
+  listing_pending_ = true;
+  listing_thread_ = std::thread([this, append, dirs = std::move(dirs)]() {
+    try {
+      filesystem::traverse_class_directories(file_root_, dirs, filters_, case_sensitive_filter_,
+                                             kListingThreads, append);
+      if (!stop_listing_)
+        SaveListingCache(dirs);
+      std::lock_guard<std::mutex> g(listing_mutex_);
+      listing_pending_ = false;
+    } catch (...) {
+      // the listing stays pending - the error is reported by WaitForListing
+      std::lock_guard<std::mutex> g(listing_mutex_);
+      listing_error_ = std::current_exception();
+    }
+    listing_cv_.notify_all();
+  });
+  // the error is reported here if there are no files at all
+  if (!WaitForListing(1))
+    DALI_ENFORCE(!image_label_pairs_.empty(), "No files found.");
+}
+
+bool FileLabelLoader::WaitForListing(Index n) {
+  std::unique_lock<std::mutex> l(listing_mutex_);
+  listing_cv_.wait(l, [&]() {
+    return !listing_pending_ || listing_error_ ||
+           static_cast<Index>(image_label_pairs_.size()) >= n;
+  });
+  if (listing_error_)
+    std::rethrow_exception(listing_error_);
+  return listing_pending_;
+}
+
+bool FileLabelLoader::LoadListingCache(const vector<filesystem::ClassDirectory> &dirs) {
+  std::ifstream s(file_list_cache_);
+  if (!s.is_open())
+    return false;
+  string key = ListingCacheKey(file_root_, filters_, case_sensitive_filter_, dirs);
+  string stored(key.size(), '\0');
+  if (!s.read(&stored[0], key.size()) || stored != key)
+    return false;
+
+  vector<const string *> dir_names(dirs.size());
+  for (auto &dir : dirs)
+    dir_names[dir.label] = &dir.name;
+  size_t num_files;
+  string line;
+  if (!(s >> num_files) || !std::getline(s, line))
+    return false;
+  vector<std::pair<string, int>> pairs;
+  pairs.reserve(num_files);
+  while (pairs.size() < num_files && std::getline(s, line)) {
+    char *end;
+    size_t label = std::strtoul(line.c_str(), &end, 10);
+    if (*end != ' ' || label >= dir_names.size())
+      return false;
+    pairs.emplace_back(filesystem::join_path(*dir_names[label], end + 1), label);
+  }
+  if (pairs.size() != num_files)
+    return false;
+  image_label_pairs_ = std::move(pairs);
+  return true;
+}
+
+void FileLabelLoader::SaveListingCache(const vector<filesystem::ClassDirectory> &dirs) {
+  if (file_list_cache_.empty())
+    return;
+  for (auto &dir : dirs) {
+    if (dir.name.find('\n') != string::npos)
+      return;
+  }
+  vector<size_t> dir_name_lengths(dirs.size());
+  for (auto &dir : dirs)
+    dir_name_lengths[dir.label] = dir.name.size() + 1;
+  // written to a temporary file first, so that the jobs starting at once don't read it halfway
+  string tmp_path = make_string(file_list_cache_, ".tmp.", getpid());
+  {
+    std::ofstream s(tmp_path);
+    if (!s.is_open()) {
+      DALI_WARN("Cannot write the file list cache: ", file_list_cache_);
+      return;
+    }
+    s << ListingCacheKey(file_root_, filters_, case_sensitive_filter_, dirs)
+      << image_label_pairs_.size() << "\n";
+    for (auto &pair : image_label_pairs_) {
+      if (pair.first.find('\n') != string::npos) {
+        s.close();
+        std::remove(tmp_path.c_str());
+        return;
+      }
+      s << pair.second << " " << pair.first.c_str() + dir_name_lengths[pair.second] << "\n";
+    }
+    if (!s.good()) {
+      s.close();
+      std::remove(tmp_path.c_str());
+      DALI_WARN("Cannot write the file list cache: ", file_list_cache_);
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), file_list_cache_.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    DALI_WARN("Cannot write the file list cache: ", file_list_cache_);
+  }
+}
 }  // namespace dali
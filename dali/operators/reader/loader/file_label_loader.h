@@ -19,8 +19,13 @@
 #include <sys/stat.h>
 #include <errno.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <fstream>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -60,6 +65,8 @@ class DLL_PUBLIC FileLabelLoader : public Loader<CPUBackend, ImageLabelWrapper>
       // TODO(ksztenderski): CocoLoader inherits after FileLabelLoader and it doesn't work with
       // GetArgument.
       spec.TryGetArgument(case_sensitive_filter_, "case_sensitive_filter");
+      spec.TryGetArgument(file_list_cache_, "file_list_cache");
+      spec.TryGetArgument(parse_image_info_, "parse_image_info");
 
       DALI_ENFORCE(has_file_root_arg_ || has_files_arg_ || has_file_list_arg_,
         "``file_root`` argument is required when not using ``files`` or ``file_list``.");
@@ -98,6 +105,19 @@ class DLL_PUBLIC FileLabelLoader : public Loader<CPUBackend, ImageLabelWrapper>
         }
       }
 
+      DALI_ENFORCE(!(shuffle_after_epoch_ && global_shuffle_),
+                   "shuffle_after_epoch and global_shuffle cannot be both true");
+      DALI_ENFORCE(!(shuffle_after_epoch_ && bucket_by_size_),
+                   "shuffle_after_epoch and bucket_by_size cannot be both true");
+      DALI_ENFORCE(!(shuffle_after_epoch_ && checkpointing_),
+                   "shuffle_after_epoch and enable_checkpointing cannot be both true");
+      EnableGlobalShuffle();
+      EnableSharedCache();
+      EnableContentHash();
+      EnableBucketing();
+      EnableCheckpointing();
+      EnableResharding();
+
       /*
       * Those options are mutually exclusive as `shuffle_after_epoch` will make every shard looks differently
       * after each epoch so coexistence with `stick_to_shard` doesn't make any sense
@@ -121,17 +141,28 @@ class DLL_PUBLIC FileLabelLoader : public Loader<CPUBackend, ImageLabelWrapper>
     copy_read_data_ = dont_use_mmap_ || !mmap_reserver_.CanShareMappedData();
   }
 
+  ~FileLabelLoader() override {
+    if (listing_thread_.joinable()) {
+      stop_listing_ = true;
+      listing_thread_.join();
+    }
+  }
+
   void PrepareEmpty(ImageLabelWrapper &tensor) override;
   void ReadSample(ImageLabelWrapper &tensor) override;
 
  protected:
+  ReadWork PrepareRead(ImageLabelWrapper &tensor) override;
+
+  /// Sets the metadata of the sample read, skipping it if its content is cached (`content_hash`)
+  void FinishRead(ImageLabelWrapper &image_label, const std::string &image_name, DALIMeta meta);
+
   Index SizeImpl() override;
 
   void PrepareMetadataImpl() override {
     if (image_label_pairs_.empty()) {
       if (!has_file_list_arg_ && !has_files_arg_) {
-        image_label_pairs_ =
-            filesystem::traverse_directories(file_root_, filters_, case_sensitive_filter_);
+        ListFileRoot();
       } else if (has_file_list_arg_) {
         // load (path, label) pairs from list
         std::ifstream s(file_list_);
@@ -174,7 +205,8 @@ class DLL_PUBLIC FileLabelLoader : public Loader<CPUBackend, ImageLabelWrapper>
         DALI_ENFORCE(s.eof(), "Wrong format of file_list: " + file_list_);
       }
     }
-    DALI_ENFORCE(SizeImpl() > 0, "No files found.");
+    // when listing in the background, there is at least one file - or the listing is complete
+    DALI_ENFORCE(SizePending() || SizeImpl() > 0, "No files found.");
 
     if (shuffle_) {
       // seeded with hardcoded value to get
@@ -185,8 +217,13 @@ class DLL_PUBLIC FileLabelLoader : public Loader<CPUBackend, ImageLabelWrapper>
     Reset(true);
   }
 
+  bool SizePending() const override {
+    return listing_pending_;
+  }
+
   void Reset(bool wrap_to_shard) override {
-    if (wrap_to_shard) {
+    // the listing in the background is done only with one shard, starting at 0
+    if (wrap_to_shard && !listing_pending_) {
       current_index_ = start_index(shard_id_, num_shards_, SizeImpl());
     } else {
       current_index_ = 0;
@@ -198,12 +235,50 @@ class DLL_PUBLIC FileLabelLoader : public Loader<CPUBackend, ImageLabelWrapper>
       std::mt19937 g(kDaliDataloaderSeed + current_epoch_);
       std::shuffle(image_label_pairs_.begin(), image_label_pairs_.end(), g);
     }
+    ShuffleSampleOrder();
   }
 
+  // the size of the file
+  double SampleSizeKey(Index index) override;
+
+  void SaveCursor(std::ostream &os) const override {
+    os << " " << current_index_ << " " << current_epoch_;
+  }
+
+  void RestoreCursor(std::istream &is) override {
+    is >> current_index_ >> current_epoch_;
+  }
+
+  void SeekPosition(Index position) override {
+    current_index_ = position;
+  }
+
+  /**
+   * @brief Lists the files in the subdirectories of `file_root`
+   *
+   * The directories are listed in parallel. The listing is loaded from `file_list_cache`,
+   * if it's up to date, and saved there otherwise.
+   *
+   * When the order of the files doesn't depend on their number (no shuffling, one shard),
+   * the listing continues in the background and the reads start as soon as the first files
+   * are found.
+   */
+  void ListFileRoot();
+
+  /**
+   * @brief Waits until `n` files are listed or the listing completes
+   *
+   * @return Whether the listing is still in progress
+   */
+  bool WaitForListing(Index n);
+
+  bool LoadListingCache(const vector<filesystem::ClassDirectory> &dirs);
+  void SaveListingCache(const vector<filesystem::ClassDirectory> &dirs);
+
   using Loader<CPUBackend, ImageLabelWrapper>::shard_id_;
   using Loader<CPUBackend, ImageLabelWrapper>::num_shards_;
 
-  string file_root_, file_list_;
+  string file_root_, file_list_, file_list_cache_;
   vector<std::pair<string, int>> image_label_pairs_;
   vector<string> filters_;
 
@@ -212,11 +287,21 @@ class DLL_PUBLIC FileLabelLoader : public Loader<CPUBackend, ImageLabelWrapper>
   bool has_file_list_arg_ = false;
   bool has_file_root_arg_ = false;
   bool case_sensitive_filter_ = false;
+  /// parse the headers of the images read and attach EncodedImageInfo to the samples
+  bool parse_image_info_ = false;
 
   bool shuffle_after_epoch_;
   Index current_index_;
   int current_epoch_;
   FileStream::MappingReserver mmap_reserver_;
+
+  // the listing in the background (see ListFileRoot), appending to image_label_pairs_
+  std::thread listing_thread_;
+  std::mutex listing_mutex_;
+  std::condition_variable listing_cv_;
+  std::atomic<bool> listing_pending_{false};
+  std::atomic<bool> stop_listing_{false};
+  std::exception_ptr listing_error_;
 };
 
 }  // namespace dali
@@ -18,14 +18,20 @@
 #include <glob.h>
 #include <sys/stat.h>
 #include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <exception>
+#include <iterator>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "dali/core/error_handling.h"
 #include "dali/operators/reader/loader/filesystem.h"
 #include "dali/operators/reader/loader/utils.h"
+#include "dali/util/remote_uri.h"
 
 namespace dali {
 namespace filesystem {
@@ -53,6 +59,7 @@ inline void assemble_file_list(std::vector<std::pair<std::string, int>> &file_la
                                const bool case_sensitive_filter) {
   std::string curr_dir_path = join_path(path, curr_entry);
   DIR *dir = opendir(curr_dir_path.c_str());
+  DALI_ENFORCE(dir != nullptr, "Directory " + curr_dir_path + " could not be opened.");
 
   dirent *entry;
 
@@ -78,9 +85,9 @@ inline void assemble_file_list(std::vector<std::pair<std::string, int>> &file_la
   closedir(dir);
 }
 
-vector<std::pair<string, int>> traverse_directories(const std::string &file_root,
-                                                    const std::vector<std::string> &filters,
-                                                    const bool case_sensitive_filter) {
+vector<ClassDirectory> list_class_directories(const std::string &file_root) {
+  DALI_ENFORCE(!IsRemoteUri(file_root), make_string("Cannot list the files in ", file_root,
+               ". The remote files need to be listed in ``files`` or ``file_list``."));
   // open the root
   DIR *dir = opendir(file_root.c_str());
 
@@ -89,35 +96,120 @@ vector<std::pair<string, int>> traverse_directories(const std::string &file_root
 
   struct dirent *entry;
 
-  std::vector<std::pair<std::string, int>> file_label_pairs;
-  std::vector<std::string> entry_name_list;
+  std::vector<ClassDirectory> dirs;
 
   while ((entry = readdir(dir))) {
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
+#ifdef _DIRENT_HAVE_D_TYPE
+    // no need to stat the regular files - on a network file system, it's slow
+    if (entry->d_type == DT_REG) continue;
+#endif
     struct stat s;
     std::string entry_name(entry->d_name);
     std::string full_path = join_path(file_root, entry_name);
     int ret = stat(full_path.c_str(), &s);
     DALI_ENFORCE(ret == 0,
         "Could not access " + full_path + " during directory traversal.");
-    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) continue;
     if (S_ISDIR(s.st_mode)) {
-      entry_name_list.push_back(entry_name);
+      dirs.push_back({entry_name, 0, s.st_mtim.tv_sec * 1000000000LL + s.st_mtim.tv_nsec});
     }
   }
+  closedir(dir);
+
   // sort directories to preserve class alphabetic order, as readdir could
   // return unordered dir list. Otherwise file reader for training and validation
   // could return directories with the same names in completely different order
-  std::sort(entry_name_list.begin(), entry_name_list.end());
-  for (unsigned dir_count = 0; dir_count < entry_name_list.size(); ++dir_count) {
-      assemble_file_list(file_label_pairs, file_root, entry_name_list[dir_count], dir_count,
-                         filters, case_sensitive_filter);
+  std::sort(dirs.begin(), dirs.end(), [](const ClassDirectory &a, const ClassDirectory &b) {
+    return a.name < b.name;
+  });
+  for (int i = 0, n = dirs.size(); i < n; i++)
+    dirs[i].label = i;
+  // The files are sorted by their paths - "<dir>/<file>" - so the directories go in the order
+  // of "<dir>/", which can differ from the order of the names (e.g. "a/" > "a-b/").
+  std::sort(dirs.begin(), dirs.end(), [](const ClassDirectory &a, const ClassDirectory &b) {
+    return a.name + dir_sep < b.name + dir_sep;
+  });
+  return dirs;
+}
+
+void traverse_class_directories(
+    const std::string &file_root, const std::vector<ClassDirectory> &dirs,
+    const std::vector<std::string> &filters, bool case_sensitive_filter, int num_threads,
+    const std::function<bool(std::vector<std::pair<std::string, int>> &&)> &publish) {
+  auto list = [&](const ClassDirectory &dir) {
+    std::vector<std::pair<std::string, int>> files;
+    assemble_file_list(files, file_root, dir.name, dir.label, filters, case_sensitive_filter);
+    // sort file names as well
+    std::sort(files.begin(), files.end());
+    return files;
+  };
+
+  num_threads = std::min<int>(num_threads, dirs.size());
+  if (num_threads <= 1) {
+    for (auto &dir : dirs) {
+      if (!publish(list(dir)))
+        return;
+    }
+    return;
   }
-  // sort file names as well
-  std::sort(file_label_pairs.begin(), file_label_pairs.end());
-  LOG_LINE  << "read " << file_label_pairs.size() << " files from " << entry_name_list.size()
-            << "directories\n";
 
-  closedir(dir);
+  // the directories are listed in parallel and published in order
+  std::vector<std::vector<std::pair<std::string, int>>> listed(dirs.size());
+  std::vector<bool> done(dirs.size());
+  std::atomic<size_t> next{0};
+  size_t published = 0;
+  bool stop = false;
+  std::exception_ptr error;
+  std::mutex mtx;
+  auto worker = [&]() {
+    for (size_t i; (i = next++) < dirs.size();) {
+      std::vector<std::pair<std::string, int>> files;
+      try {
+        files = list(dirs[i]);
+      } catch (...) {
+        std::lock_guard<std::mutex> g(mtx);
+        if (!error)
+          error = std::current_exception();
+        stop = true;
+      }
+      std::lock_guard<std::mutex> g(mtx);
+      if (stop)
+        return;
+      listed[i] = std::move(files);
+      done[i] = true;
+      for (; published < dirs.size() && done[published]; published++) {
+        if (!publish(std::move(listed[published]))) {
+          stop = true;
+          return;
+        }
+        listed[published] = {};
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int t = 1; t < num_threads; t++)
+    threads.emplace_back(worker);
+  worker();
+  for (auto &t : threads)
+    t.join();
+  if (error)
+    std::rethrow_exception(error);
+}
+
+vector<std::pair<string, int>> traverse_directories(const std::string &file_root,
+                                                    const std::vector<std::string> &filters,
+                                                    const bool case_sensitive_filter,
+                                                    int num_threads) {
+  auto dirs = list_class_directories(file_root);
+  std::vector<std::pair<std::string, int>> file_label_pairs;
+  traverse_class_directories(file_root, dirs, filters, case_sensitive_filter, num_threads,
+                             [&](std::vector<std::pair<std::string, int>> &&files) {
+    file_label_pairs.insert(file_label_pairs.end(), std::make_move_iterator(files.begin()),
+                            std::make_move_iterator(files.end()));
+    return true;
+  });
+  LOG_LINE  << "read " << file_label_pairs.size() << " files from " << dirs.size()
+            << "directories\n";
 
   return file_label_pairs;
 }
@@ -168,6 +260,8 @@ inline void assemble_file_list(std::vector<std::string>& file_list,
 
 
 vector<std::string> traverse_directories(const std::string &file_root, const std::string &filter) {
+  DALI_ENFORCE(!IsRemoteUri(file_root), make_string("Cannot list the files in ", file_root,
+               ". The remote files need to be listed in ``files`` or ``file_list``."));
   // open the root
   DIR *dir = opendir(file_root.c_str());
 
@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_READER_LOADER_FILESYSTEM_H_
 #define DALI_OPERATORS_READER_LOADER_FILESYSTEM_H_
 
+#include <functional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -27,10 +28,40 @@ DLL_PUBLIC vector<string> traverse_directories(const string &path, const string
 
 /**
  * @brief Finds all (file, label) pairs matching any filter from the list.
+ *
+ * The subdirectories of `file_root` are listed with up to `num_threads` threads.
  */
 DLL_PUBLIC vector<std::pair<string, int>> traverse_directories(
     const string &file_root, const vector<string> &filters,
-    const bool case_sensitive_filter = false);
+    const bool case_sensitive_filter = false, int num_threads = 1);
+
+/**
+ * @brief A subdirectory of the root traversed by traverse_directories
+ */
+struct ClassDirectory {
+  string name;
+  /// The label of the files in the directory
+  int label;
+  /// The modification time, in nanoseconds
+  int64_t mtime;
+};
+
+/**
+ * @brief Lists the subdirectories of `file_root`, in the order in which
+ *        traverse_directories returns their files
+ */
+DLL_PUBLIC vector<ClassDirectory> list_class_directories(const string &file_root);
+
+/**
+ * @brief Lists the directories with `num_threads` threads
+ *
+ * `publish` is called with the sorted (file, label) pairs found in each directory,
+ * directory by directory, in the order of `dirs`. It returns false to stop the traversal.
+ */
+DLL_PUBLIC void traverse_class_directories(
+    const string &file_root, const vector<ClassDirectory> &dirs, const vector<string> &filters,
+    bool case_sensitive_filter, int num_threads,
+    const std::function<bool(vector<std::pair<string, int>> &&)> &publish);
 
 /**
  * @brief Prepends dir to a relative path and keeps absolute path unchanged.
@@ -14,8 +14,14 @@
 
 #include <glob.h>
 #include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "dali/core/error_handling.h"
@@ -147,4 +153,51 @@ TEST_F(FilesystemTest, CaseInsensitiveFilters) {
     EXPECT_EQ(correct_match[i], file_label_pairs_filtered[i].first);
   }
 }
+TEST(FilesystemTraversalTest, ParallelAndOrder) {
+  char root_template[] = "/tmp/dali_traverse_testXXXXXX";
+  ASSERT_NE(mkdtemp(root_template), nullptr);
+  std::string root = root_template;
+  // "a-b/..." goes before "a/...", while the labels follow the order of the names
+  std::vector<std::string> dirs = {"a", "a-b", "b", "c.d", "c"};
+  std::vector<std::pair<std::string, int>> expected;
+  std::vector<std::string> sorted_dirs = dirs;
+  std::sort(sorted_dirs.begin(), sorted_dirs.end());
+  for (auto &dir : dirs) {
+    ASSERT_EQ(mkdir((root + "/" + dir).c_str(), 0755), 0);
+    int label = std::find(sorted_dirs.begin(), sorted_dirs.end(), dir) - sorted_dirs.begin();
+    for (int i = 0; i < 20; i++) {
+      std::string name = dir + "/" + std::to_string(i * 7 % 20) + ".jpg";
+      std::ofstream(root + "/" + name) << name;
+      expected.emplace_back(name, label);
+    }
+    std::ofstream(root + "/" + dir + "/skipped.txt");
+  }
+  std::ofstream(root + "/not_a_class.jpg");
+  std::sort(expected.begin(), expected.end());
+
+  for (int num_threads : {1, 2, 16}) {
+    auto pairs = filesystem::traverse_directories(root, {"*.jpg"}, false, num_threads);
+    EXPECT_EQ(pairs, expected) << "num_threads = " << num_threads;
+  }
+
+  auto class_dirs = filesystem::list_class_directories(root);
+  ASSERT_EQ(class_dirs.size(), dirs.size());
+  int published = 0;
+  filesystem::traverse_class_directories(root, class_dirs, {"*.jpg"}, false, 4,
+                                         [&](std::vector<std::pair<std::string, int>> &&files) {
+    EXPECT_EQ(files.size(), 20u);
+    return ++published < 2;
+  });
+  EXPECT_EQ(published, 2);
+
+  for (auto &dir : dirs) {
+    for (int i = 0; i < 20; i++)
+      std::remove((root + "/" + dir + "/" + std::to_string(i) + ".jpg").c_str());
+    std::remove((root + "/" + dir + "/skipped.txt").c_str());
+    rmdir((root + "/" + dir).c_str());
+  }
+  std::remove((root + "/not_a_class.jpg").c_str());
+  rmdir(root.c_str());
+}
+
 }  // namespace dali
@@ -33,15 +33,20 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     : Loader(options),
       uris_(options.GetRepeatedArgument<std::string>("path")),
       index_uris_(options.GetRepeatedArgument<std::string>("index_path")),
-      current_index_(0), current_file_index_(0), current_file_(nullptr) {
-    }
+      current_index_(0), current_file_index_(0), current_file_(nullptr),
+      read_streams_(num_read_threads_) {
+    EnableGlobalShuffle();
+    EnableBucketing();
+    EnableCheckpointing();
+    EnableResharding();
+  }
 
   void ReadSample(Tensor<CPUBackend>& tensor) override {
     MoveToNextShard(current_index_);
 
     int64 seek_pos, size;
     size_t file_index;
-    std::tie(seek_pos, size, file_index) = indices_[current_index_];
+    std::tie(seek_pos, size, file_index) = indices_[SampleIndex(current_index_)];
     ++current_index_;
 
     std::string image_key = uris_[file_index] + " at index " + to_string(seek_pos);
@@ -51,8 +56,10 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
 
     if (file_index != current_file_index_) {
       current_file_->Close();
-      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_);
+      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_,
+                                       use_io_uring_, use_o_direct_, read_policy_);
       current_file_index_ = file_index;
+      should_seek_ = true;
     }
 
     // if image is cached, skip loading
@@ -91,10 +98,67 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     return;
   }
 
+  /**
+   * @brief Reads the sample in the I/O threads, each reading from its own stream
+   *
+   * The mapped samples are shared with the tensors right away, so only the ones read
+   * (`dont_use_mmap` or `use_io_uring`) are read in parallel.
+   */
+  ReadWork PrepareRead(Tensor<CPUBackend>& tensor) override {
+    if (!copy_read_data_) {
+      ReadSample(tensor);
+      return {};
+    }
+
+    MoveToNextShard(current_index_);
+
+    int64 seek_pos, size;
+    size_t file_index;
+    std::tie(seek_pos, size, file_index) = indices_[SampleIndex(current_index_)];
+    ++current_index_;
+
+    std::string image_key = uris_[file_index] + " at index " + to_string(seek_pos);
+    DALIMeta meta;
+    meta.SetSourceInfo(image_key);
+    meta.SetSkipSample(false);
+
+    // if image is cached, skip loading
+    if (ShouldSkipImage(image_key)) {
+      meta.SetSkipSample(true);
+      tensor.Reset();
+      tensor.SetMeta(meta);
+      tensor.Resize({0}, DALI_UINT8);
+      return {};
+    }
+
+    return [this, &tensor, seek_pos, size, file_index, meta](int thread_idx) {
+      auto &stream = read_streams_[thread_idx];
+      if (!stream.file || stream.file_index != file_index) {
+        if (stream.file)
+          stream.file->Close();
+        stream.file = FileStream::Open(uris_[file_index], read_ahead_, false, use_io_uring_,
+                                       use_o_direct_, read_policy_);
+        stream.file_index = file_index;
+      }
+      stream.file->SeekRead(seek_pos);
+      if (tensor.shares_data()) {
+        tensor.Reset();
+      }
+      tensor.Resize({size}, DALI_UINT8);
+      int64 n_read = stream.file->Read(tensor.mutable_data<uint8_t>(), size);
+      DALI_ENFORCE(n_read == size, "Error reading from a file " + uris_[file_index]);
+      tensor.SetMeta(meta);
+    };
+  }
+
   ~IndexedFileLoader() override {
     if (current_file_ != nullptr) {
       current_file_->Close();
     }
+    for (auto &stream : read_streams_) {
+      if (stream.file)
+        stream.file->Close();
+    }
   }
 
   virtual void ReadIndexFile(const std::vector<std::string>& index_uris) {
@@ -138,17 +202,38 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     } else {
       current_index_ = 0;
     }
-    std::tie(seek_pos, size, file_index) = indices_[current_index_];
+    ShuffleSampleOrder();
+    std::tie(seek_pos, size, file_index) = indices_[SampleIndex(current_index_)];
     if (file_index != current_file_index_) {
       if (current_file_index_ != static_cast<size_t>(INVALID_INDEX)) {
         current_file_->Close();
       }
-      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_);
+      current_file_ = FileStream::Open(uris_[file_index], read_ahead_, !copy_read_data_,
+                                       use_io_uring_, use_o_direct_, read_policy_);
       current_file_index_ = file_index;
     }
     current_file_->SeekRead(seek_pos);
   }
 
+  double SampleSizeKey(Index index) override {
+    return std::get<1>(indices_[index]);
+  }
+
+  void SaveCursor(std::ostream &os) const override {
+    os << " " << current_index_;
+  }
+
+  void RestoreCursor(std::istream &is) override {
+    is >> current_index_;
+    // the next read seeks to its record, opening its file if needed
+    should_seek_ = true;
+  }
+
+  void SeekPosition(Index position) override {
+    current_index_ = position;
+    should_seek_ = true;
+  }
+
   std::vector<std::string> uris_;
   std::vector<std::string> index_uris_;
   std::vector<std::tuple<int64, int64, size_t>> indices_;
@@ -159,6 +244,13 @@ class IndexedFileLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
   static constexpr int INVALID_INDEX = -1;
   bool should_seek_ = false;
   int64 next_seek_pos_ = 0;
+
+  // The file last read by an I/O thread, kept open for its next samples
+  struct ReadStream {
+    size_t file_index = 0;
+    std::unique_ptr<FileStream> file;
+  };
+  std::vector<ReadStream> read_streams_;
 };
 
 }  // namespace dali
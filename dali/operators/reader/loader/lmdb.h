@@ -32,6 +32,12 @@ namespace dali {
   } while (0)
 
 
+/**
+ * @brief A read-only LMDB database with a cursor addressed by the entry index
+ *
+ * The read transaction is kept open until Close, so the values returned by SeekByIndex point
+ * to the memory-mapped database and stay valid until then.
+ */
 class IndexedLMDB {
   MDB_env* mdb_env_ = nullptr;
   MDB_cursor* mdb_cursor_ = nullptr;
@@ -43,6 +49,13 @@ class IndexedLMDB {
   Index mdb_size_;
 
  public:
+  IndexedLMDB() = default;
+  DISABLE_COPY_MOVE_ASSIGN(IndexedLMDB);
+
+  ~IndexedLMDB() {
+    Close();
+  }
+
   void Open(const std::string& path, int num) {
     DALI_ENFORCE(mdb_env_ == nullptr, "Previous MDB environment was not closed");
     db_path_ = path;
@@ -151,12 +164,6 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     }
   }
 
-  ~LMDBLoader() override {
-    for (size_t i = 0; i < mdb_.size(); i++) {
-      mdb_[i].Close();
-    }
-  }
-
   void MapIndexToFile(Index index, Index& file_index, Index& local_index) {
     DALI_ENFORCE(offsets_.size() > 0);
     DALI_ENFORCE(index >= 0 && index < offsets_.back());
@@ -171,7 +178,7 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     MapIndexToFile(current_index_, file_index, local_index);
 
     MDB_val key, value;
-    mdb_[file_index].SeekByIndex(local_index, &key, &value);
+    mdb_[file_index]->SeekByIndex(local_index, &key, &value);
     ++current_index_;
 
     MoveToNextShard(current_index_);
@@ -192,11 +199,15 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
       return;
     }
 
+    // The value is shared, not copied - the database keeps it mapped until it's closed, which
+    // the shared pointer defers until the sample is released
+    if (tensor.shares_data()) {
+      tensor.Reset();
+    }
+    Index size = value.mv_size;
+    tensor.ShareData(std::shared_ptr<void>(mdb_[file_index], value.mv_data), size, false,
+                     {size}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
     tensor.SetMeta(meta);
-    tensor.Resize({static_cast<Index>(value.mv_size)}, DALI_UINT8);
-    std::memcpy(tensor.raw_mutable_data(),
-                reinterpret_cast<uint8_t*>(value.mv_data),
-                value.mv_size * sizeof(uint8_t));
   }
 
  protected:
@@ -209,8 +220,9 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     offsets_[0] = 0;
     mdb_.resize(db_paths_.size());
     for (size_t i = 0; i < db_paths_.size(); i++) {
-      mdb_[i].Open(db_paths_[i], i);
-      offsets_[i + 1] = offsets_[i] + mdb_[i].GetSize();
+      mdb_[i] = std::make_shared<IndexedLMDB>();
+      mdb_[i]->Open(db_paths_[i], i);
+      offsets_[i + 1] = offsets_[i] + mdb_[i]->GetSize();
     }
     Reset(true);
   }
@@ -226,12 +238,12 @@ class LMDBLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
     Index file_index, local_index;
     MapIndexToFile(current_index_, file_index, local_index);
 
-    mdb_[file_index].SeekByIndex(local_index);
+    mdb_[file_index]->SeekByIndex(local_index);
   }
   using Loader<CPUBackend, Tensor<CPUBackend>>::shard_id_;
   using Loader<CPUBackend, Tensor<CPUBackend>>::num_shards_;
 
-  std::vector<IndexedLMDB> mdb_;
+  std::vector<std::shared_ptr<IndexedLMDB>> mdb_;
 
   Index current_index_ = 0;
 
@@ -18,6 +18,7 @@
 namespace dali {
 
 DALI_SCHEMA(LoaderBase)
+  .Nondeterministic()
   .AddOptionalArg("random_shuffle",
       R"code(Determines whether to randomly shuffle data.
 
@@ -56,6 +57,18 @@ consumption for better interleaving with the Loader thread.)code", 1)
 in the decoder cache.
 
 In this case, the output of the loader will be empty.)code", false)
+  .AddOptionalArg("content_hash",
+      R"code(If set to True, the samples are identified in the caches by a hash of their content,
+computed while reading them, instead of the file names.
+
+The duplicates of the images (e.g. the same image in several shards of the dataset) are then
+decoded only once by the decoders using a cache, and found in the cache by
+:meth:`nvidia.dali.fn.experimental.cache_lookup`. With ``skip_cached_images``, the samples
+whose content is in the decoder cache are skipped after they are read, and once their content
+is known, also before reading them.
+
+Supported only by :meth:`nvidia.dali.fn.readers.file` and
+:meth:`nvidia.dali.fn.readers.coco`.)code", false)
   .AddOptionalArg("lazy_init",
             R"code(Parse and prepare the dataset metadata only during the first run instead of
 in the constructor.)code", false)
@@ -71,7 +84,145 @@ the file in memory.
 
 Mapping provides a small performance benefit when accessing a local file system, but most network file
 systems, do not provide optimum performance.
-)code", false);
+)code", false)
+  .AddOptionalArg("num_read_threads",
+      R"code(Number of threads used to read the samples concurrently.
+
+Increasing this value helps when the latency of accessing a file is high, for example, on network
+file systems. The order of the samples does not depend on it.
+
+Supported by ``readers.file``, ``readers.numpy`` (CPU), ``readers.webdataset`` and, when the files
+are not mapped (``dont_use_mmap`` or ``use_io_uring``), by ``readers.tfrecord``, ``readers.mxnet``
+and ``readers.packed``; the other readers ignore it.)code", 1)
+  .AddOptionalArg("use_io_uring",
+      R"code(If set to True, the files are read with io_uring, which keeps many read requests
+in flight from a single thread.
+
+Implies ``dont_use_mmap``. If io_uring is not available (for example, on an older kernel or
+in a restricted container), plain reads are used.
+
+Applies to the readers reading the files with the host file I/O; the others ignore it.)code", false)
+  .AddOptionalArg("use_o_direct",
+      R"code(If set to True, the files are opened with ``O_DIRECT``, bypassing the page cache.
+
+This helps when the dataset is much bigger than the memory and is read once per epoch. Requires
+``use_io_uring``. If the file system does not support ``O_DIRECT``, the page cache is used.)code",
+      false)
+  .AddOptionalArg("file_access_pattern",
+      R"code(How the files are accessed, passed to the operating system as a hint for
+the page cache.
+
+Supported values are: ``"normal"`` (the system default), ``"sequential"`` (the files are read
+from the beginning to the end, e.g., TFRecord or webdataset shards without shuffling; enables
+a more aggressive readahead) and ``"random"`` (e.g., with ``global_shuffle``; disables
+the readahead, which would read the data that is not used).
+
+Applies to the readers reading the files with the host file I/O; the others ignore it.)code",
+      std::string("normal"))
+  .AddOptionalArg("drop_page_cache",
+      R"code(If set to True, the pages of the files are dropped from the page cache once
+they are read.
+
+Keeps the dataset from evicting the cached data of the other processes on a shared node, at the cost
+of reading the data from the storage again in the next epoch. Implies ``dont_use_mmap``.
+Unlike ``use_o_direct``, the reads still go through the page cache and benefit from
+the readahead.)code", false)
+  .AddOptionalArg("readahead_batches",
+      R"code(Number of batches of data the operating system is asked to read ahead of
+the current position in a file.
+
+The size of the window is this number times the batch size times the average size of a read
+(usually, a sample) so far. Useful for the readers of the container files (e.g., TFRecord, RecordIO,
+webdataset or packed) on a storage with high latency. 0 leaves the readahead to the operating
+system.)code", 0)
+  .AddOptionalArg("global_shuffle",
+      R"code(If set to True, the reader draws a new permutation of all the samples every epoch
+and reads them in that order.
+
+Unlike ``random_shuffle``, it doesn't need a buffer of ``initial_fill`` samples and mixes
+the whole dataset, also across the shards: all the shards use the same permutation and each one
+reads its own part of it, so it implies ``stick_to_shard``. It's incompatible with
+``random_shuffle`` and ``stick_to_shard``.
+
+The permutation depends only on the epoch and ``global_shuffle_seed``, so the shards running on
+different nodes agree on it without communicating. Reading a random permutation means random
+access to the files - use ``num_read_threads`` (and ``use_io_uring``) to keep many reads in flight.
+
+Supported by ``readers.file``, ``readers.coco``, ``readers.tfrecord``, ``readers.mxnet``,
+``readers.packed`` and ``readers.webdataset``.)code", false)
+  .AddOptionalArg("global_shuffle_seed",
+      R"code(Seed of the permutations drawn with ``global_shuffle`` and ``bucket_by_size``.
+
+Unlike ``seed``, which usually differs between the shards, it must be the same in all of them.
+Changing it gives a different sequence of the permutations, e.g. for another training run.
+-1 means a fixed, default seed.)code", -1)
+  .AddOptionalArg("shuffle_block_size",
+      R"code(Number of consecutive samples permuted together when ``global_shuffle`` is used.
+
+Values greater than 1 keep the reads within a block sequential, which is faster on storage
+with slow random access (for example, tar or TFRecord files on a network file system), at
+the cost of a weaker shuffling.)code", 1)
+  .AddOptionalArg("shared_cache_name",
+      R"code(Name of a cache of the read (still encoded) samples kept in the shared memory
+of the node.
+
+All the readers on the node using the same name - also in different processes - share the
+cache, so a file read by one of them is served to the others from memory. When the cache is
+full, the least recently used samples are evicted. The cache persists in ``/dev/shm`` after the
+processes exit and is reused by the subsequent jobs; delete ``/dev/shm/<name>`` to release the
+memory.
+
+Supported by ``readers.file``. An empty name disables the cache.)code", "")
+  .AddOptionalArg("shared_cache_size",
+      R"code(Size, in megabytes, of the cache named ``shared_cache_name``.
+
+Only used by the process creating the cache; the ones opening an existing cache use the size
+it was created with.)code", 0)
+  .AddOptionalArg("streaming",
+      R"code(If set to True, the files are read sequentially, as streams, without an index.
+
+The reader doesn't need to know the samples before it starts - there's no scanning of the
+files nor index files - so the first batch is produced right away, also for huge datasets
+on remote storage. The dataset is sharded by files: each shard reads its own contiguous range
+of the files, over and over, so there need to be at least ``num_shards`` files and the shards
+may get different numbers of samples. The number of samples is unknown, so the epoch size is
+reported as -1. It's incompatible with ``global_shuffle`` and ``pad_last_batch``;
+``random_shuffle`` works as usual.
+
+Supported by ``readers.tfrecord`` and ``readers.webdataset``.)code", false)
+  .AddOptionalArg("stream_buffer_size",
+      R"code(Size, in megabytes, of the reads issued when ``streaming`` is used.)code", 8)
+  .AddOptionalArg("bucket_by_size",
+      R"code(If set to True, the batches are composed of samples of similar sizes.
+
+Every epoch, the samples are permuted randomly; then each ``bucket_pool_size`` batches worth
+of samples are sorted by size and cut into batches, which are read in a random order. This
+reduces the padding needed to process variable-length samples (audio, sequences) in batches,
+keeping the order random. The size is the duration for ``readers.nemo_asr``, the size of the
+record for ``readers.tfrecord``, ``readers.mxnet`` and ``readers.packed``, the total size of
+the components for ``readers.webdataset`` and the file size for ``readers.file`` and
+``readers.coco``.
+
+Like ``global_shuffle``, it implies ``stick_to_shard``, all the shards use the same order
+and each one reads its own part of it. It's incompatible with ``random_shuffle``,
+``stick_to_shard``, ``global_shuffle``, ``shuffle_after_epoch`` and ``streaming``. The batches
+are aligned with the beginning of the shard, so, unless ``pad_last_batch`` is used or the shard
+size is a multiple of the batch size, the last batch of an epoch is mixed with the first one
+of the next epoch.)code", false)
+  .AddOptionalArg("bucket_pool_size",
+      R"code(Number of batches sorted together when ``bucket_by_size`` is used.
+
+Greater values give batches of more uniform sizes, smaller ones - a more random order.)code",
+      100)
+  .AddOptionalArg("enable_checkpointing",
+      R"code(If set to True, the state of the reader can be saved and restored.
+
+The state, obtained with ``Pipeline.reader_state`` for the batches returned so far, lets a new
+pipeline restore it with ``Pipeline.restore_reader_state`` before it's run, and continue with
+the same batches as the original one would, without reading the epoch from its beginning.
+Restoring costs reading the ``initial_fill`` samples of the shuffling buffer.
+Supported by ``readers.file``, ``readers.coco``, ``readers.tfrecord``, ``readers.mxnet`` and
+``readers.packed``. It's incompatible with ``streaming`` and ``shuffle_after_epoch``.)code", false);
 
 size_t start_index(const size_t shard_id,
                    const size_t shard_num,
@@ -15,24 +15,36 @@
 #ifndef DALI_OPERATORS_READER_LOADER_LOADER_H_
 #define DALI_OPERATORS_READER_LOADER_LOADER_H_
 
+#include <algorithm>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <numeric>
 #include <random>
+#include <sstream>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <deque>
 #include <atomic>
+#include <cassert>
 
 #include "dali/core/nvtx.h"
+#include "dali/core/trace.h"
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
+#include "dali/kernels/common/fast_hash.h"
 #include "dali/pipeline/operator/op_spec.h"
 #include "dali/pipeline/data/tensor.h"
+#include "dali/pipeline/util/lock_free_queue.h"
+#include "dali/pipeline/util/thread_pool.h"
 #include "dali/operators/decoder/cache/image_cache_factory.h"
+#include "dali/operators/reader/loader/shared_sample_cache.h"
+#include "dali/util/file.h"
 
 namespace dali {
 
@@ -54,6 +66,8 @@ class Loader {
  public:
   using LoadTargetUniquePtr = std::unique_ptr<LoadTarget>;
   using LoadTargetSharedPtr = std::shared_ptr<LoadTarget>;
+  /// Reads the data of a sample; receives the index of the I/O thread running it
+  using ReadWork = std::function<void(int thread_idx)>;
   explicit Loader(const OpSpec& options)
     : shuffle_(options.GetArgument<bool>("random_shuffle")),
       initial_buffer_fill_(shuffle_ ? options.GetArgument<int>("initial_fill") : 1),
@@ -68,22 +82,69 @@ class Loader {
       stick_to_shard_(options.GetArgument<bool>("stick_to_shard")),
       device_id_(options.GetArgument<int>("device_id")),
       skip_cached_images_(options.GetArgument<bool>("skip_cached_images")),
+      content_hash_(options.GetArgument<bool>("content_hash")),
       lazy_init_(options.GetArgument<bool>("lazy_init")),
       loading_flag_(false),
       read_sample_counter_(0),
       returned_sample_counter_(0),
       pad_last_batch_(options.GetArgument<bool>("pad_last_batch")),
-      dont_use_mmap_(options.GetArgument<bool>("dont_use_mmap")) {
+      dont_use_mmap_(options.GetArgument<bool>("dont_use_mmap")),
+      use_io_uring_(options.GetArgument<bool>("use_io_uring")),
+      use_o_direct_(options.GetArgument<bool>("use_o_direct")),
+      num_read_threads_(options.GetArgument<int>("num_read_threads")),
+      global_shuffle_(options.GetArgument<bool>("global_shuffle")),
+      shuffle_block_size_(options.GetArgument<int>("shuffle_block_size")),
+      shuffle_seed_(options.GetArgument<Index>("global_shuffle_seed")),
+      shared_cache_name_(options.GetArgument<std::string>("shared_cache_name")),
+      shared_cache_size_(options.GetArgument<int>("shared_cache_size")),
+      streaming_(options.GetArgument<bool>("streaming")),
+      stream_buffer_size_(options.GetArgument<int>("stream_buffer_size")),
+      bucket_by_size_(options.GetArgument<bool>("bucket_by_size")),
+      bucket_pool_size_(options.GetArgument<int>("bucket_pool_size")),
+      bucket_batch_size_(options.GetArgument<int>("max_batch_size")),
+      checkpointing_(options.GetArgument<bool>("enable_checkpointing")) {
     DALI_ENFORCE(initial_empty_size_ > 0, "Batch size needs to be greater than 0");
+    DALI_ENFORCE(num_read_threads_ > 0, make_string("`num_read_threads` must be positive, got ",
+                                                    num_read_threads_, "."));
+    DALI_ENFORCE(!use_o_direct_ || use_io_uring_, "`use_o_direct` requires `use_io_uring`.");
+    DALI_ENFORCE(shuffle_block_size_ > 0, make_string(
+                 "`shuffle_block_size` must be positive, got ", shuffle_block_size_, "."));
+    if (shuffle_seed_ < 0)
+      shuffle_seed_ = kDaliDataloaderSeed;
+    // io_uring reads the data to the tensors - the files are not mapped
+    if (use_io_uring_)
+      dont_use_mmap_ = true;
+    auto access_pattern = options.GetArgument<std::string>("file_access_pattern");
+    if (access_pattern == "sequential") {
+      read_policy_.access_pattern = FileReadPolicy::AccessPattern::Sequential;
+    } else if (access_pattern == "random") {
+      read_policy_.access_pattern = FileReadPolicy::AccessPattern::Random;
+    } else {
+      DALI_ENFORCE(access_pattern == "normal", make_string(
+          "`file_access_pattern` must be one of \"normal\", \"sequential\" or \"random\", "
+          "got \"", access_pattern, "\"."));
+    }
+    read_policy_.drop_page_cache = options.GetArgument<bool>("drop_page_cache");
+    // the mapped pages are referenced by the outputs - they can't be dropped
+    if (read_policy_.drop_page_cache)
+      dont_use_mmap_ = true;
+    int readahead_batches = options.GetArgument<int>("readahead_batches");
+    DALI_ENFORCE(readahead_batches >= 0, make_string(
+                 "`readahead_batches` must not be negative, got ", readahead_batches, "."));
+    read_policy_.readahead_reads = readahead_batches * options.GetArgument<int>("max_batch_size");
     DALI_ENFORCE(num_shards_ > shard_id_, "num_shards needs to be greater than shard_id");
     // initialize a random distribution -- this will be
     // used to pick from our sample buffer
     std::seed_seq seq({seed_});
     e_ = std::default_random_engine(seq);
     virtual_shard_id_ = shard_id_;
+    // the loader never creates more tensors than that, so all of them fit in the empty pile
+    empty_tensors_.Reset(initial_empty_size_ + initial_buffer_fill_);
   }
 
   virtual ~Loader() {
+    // finish the reads in flight before the tensors they write to are destroyed
+    read_pool_.reset();
     sample_buffer_.clear();
     empty_tensors_.clear();
   }
@@ -91,6 +152,18 @@ class Loader {
   // We need this two stage init because overriden PrepareMetadata
   // is not known in Loader ctor
   void Init() {
+    DALI_ENFORCE(!global_shuffle_ || global_shuffle_supported_,
+                 "`global_shuffle` is not supported by this reader.");
+    DALI_ENFORCE(shared_cache_name_.empty() || shared_cache_supported_,
+                 "`shared_cache_name` is not supported by this reader.");
+    DALI_ENFORCE(!content_hash_ || content_hash_supported_,
+                 "`content_hash` is not supported by this reader.");
+    DALI_ENFORCE(!streaming_ || streaming_supported_,
+                 "`streaming` is not supported by this reader.");
+    DALI_ENFORCE(!bucket_by_size_ || bucketing_supported_,
+                 "`bucket_by_size` is not supported by this reader.");
+    DALI_ENFORCE(!checkpointing_ || checkpointing_supported_,
+                 "`enable_checkpointing` is not supported by this reader.");
     if (!lazy_init_) {
       PrepareMetadata();
     }
@@ -119,10 +192,10 @@ class Loader {
   // Get a random read sample
   LoadTargetSharedPtr ReadOne(bool is_new_batch) {
     PrepareMetadata();
-    DomainTimeRange tr("[DALI][Loader] ReadOne", DomainTimeRange::kGreen1);
+    TraceScope tr(TraceEvent::LoaderReadOne);
     // perform an initial buffer fill if it hasn't already happened
     if (!initial_buffer_filled_) {
-      DomainTimeRange tr("[DALI][Loader] Filling initial buffer", DomainTimeRange::kBlue1);
+      TraceScope tr(TraceEvent::LoaderFillBuffer);
       shards_.push_back({0, 0});
 
       // Read an initial number of samples to fill our
@@ -130,21 +203,15 @@ class Loader {
       for (int i = 0; i < initial_buffer_fill_; ++i) {
         auto tensor_ptr = LoadTargetUniquePtr(new LoadTarget());
         PrepareEmpty(*tensor_ptr);
-        ReadSample(*tensor_ptr);
+        if (checkpointing_)
+          sample_cursors_.push_back(CaptureCursor());
+        IssueRead(*tensor_ptr);
         IncreaseReadSampleCounter();
         sample_buffer_.push_back(std::move(tensor_ptr));
         ++shards_.back().end;
       }
 
-      // need some entries in the empty_tensors_ list
-      DomainTimeRange tr2("[DALI][Loader] Filling empty list", DomainTimeRange::kOrange);
-      std::lock_guard<std::mutex> lock(empty_tensors_mutex_);
-      for (int i = 0; i < initial_empty_size_; ++i) {
-        auto tensor_ptr = LoadTargetUniquePtr(new LoadTarget());
-        PrepareEmpty(*tensor_ptr);
-        empty_tensors_.push_back(std::move(tensor_ptr));
-      }
-
+      FillEmptyTensors();
       initial_buffer_filled_ = true;
     }
 
@@ -178,19 +245,24 @@ class Loader {
         RecycleTensor(std::move(recycle_ptr));
     });
     std::swap(sample_buffer_[idx], sample_buffer_[shards_.front().start % sample_buffer_.size()]);
+    std::string cursor;
+    if (checkpointing_) {
+      last_cursor_ = std::move(sample_cursors_[idx]);
+      std::swap(sample_cursors_[idx],
+                sample_cursors_[shards_.front().start % sample_buffer_.size()]);
+      cursor = CaptureCursor();
+    }
     // now grab an empty tensor, fill it and add to filled buffers
-    // empty_tensors_ needs to be thread-safe w.r.t. RecycleTensor()
-    // being called by multiple consumer threads
+    // empty_tensors_ is a lock-free queue, as RecycleTensor() is called
+    // by multiple consumer threads
     LoadTargetUniquePtr tensor_ptr;
-    {
-      std::lock_guard<std::mutex> lock(empty_tensors_mutex_);
-      DALI_ENFORCE(empty_tensors_.size() > 0, "No empty tensors - did you forget to return them?");
-      tensor_ptr = std::move(empty_tensors_.back());
-      empty_tensors_.pop_back();
-    }
-    ReadSample(*tensor_ptr);
+    bool has_empty_tensor = empty_tensors_.TryPop(tensor_ptr);
+    DALI_ENFORCE(has_empty_tensor, "No empty tensors - did you forget to return them?");
+    IssueRead(*tensor_ptr);
     IncreaseReadSampleCounter();
     std::swap(sample_buffer_[shards_.back().end % sample_buffer_.size()], tensor_ptr);
+    if (checkpointing_)
+      sample_cursors_[shards_.back().end % sample_buffer_.size()] = std::move(cursor);
     ++shards_.back().end;
     last_sample_ptr_tmp = sample_ptr;
 
@@ -199,11 +271,103 @@ class Loader {
     return sample_ptr;
   }
 
+  bool CheckpointingEnabled() const {
+    return checkpointing_;
+  }
+
+  /**
+   * @brief Serializes the state of the loader (`enable_checkpointing`)
+   *
+   * The state consists of the random engine, the bookkeeping of the shards, the positions at
+   * which the samples in the shuffling buffer were read and the current position of the loader,
+   * so restoring it costs reading the buffer, no matter how many samples were read before.
+   * It must be taken between the batches.
+   */
+  std::string SaveState() {
+    DALI_ENFORCE(checkpointing_, "The state of the reader is available only when "
+                 "`enable_checkpointing` is set.");
+    PrepareMetadata();
+    std::stringstream ss;
+    ss << kStateHeader << "\n" << initial_buffer_filled_ << "\n";
+    if (!initial_buffer_filled_)
+      return ss.str();
+    ss << e_ << "\n"
+       << read_sample_counter_ << " " << returned_sample_counter_ << " " << virtual_shard_id_
+       << "\n" << shards_.size();
+    for (auto &shard : shards_)
+      ss << " " << shard.start << " " << shard.end;
+    ss << "\n" << sample_cursors_.size() << "\n";
+    for (auto &cursor : sample_cursors_)
+      ss << cursor << "\n";
+    ss << last_cursor_ << "\n" << CaptureCursor() << "\n";
+    return ss.str();
+  }
+
+  /**
+   * @brief Restores the state saved with SaveState, before anything is read
+   */
+  void RestoreState(const std::string &state) {
+    DALI_ENFORCE(checkpointing_, "The state of the reader can be restored only when "
+                 "`enable_checkpointing` is set.");
+    DALI_ENFORCE(!initial_buffer_filled_,
+                 "The state of the reader can be restored only before it starts reading.");
+    PrepareMetadata();
+    std::istringstream ss(state);
+    std::string line;
+    bool filled = false;
+    DALI_ENFORCE(std::getline(ss, line) && line == kStateHeader && ss >> filled,
+                 "Invalid reader state.");
+    if (!filled)
+      return;
+    size_t num_shards = 0, num_cursors = 0;
+    // the engine doesn't skip the whitespace
+    ss >> std::ws >> e_ >> read_sample_counter_ >> returned_sample_counter_ >> virtual_shard_id_
+       >> num_shards;
+    shards_.resize(num_shards);
+    for (auto &shard : shards_)
+      ss >> shard.start >> shard.end;
+    ss >> num_cursors;
+    std::getline(ss, line);
+    DALI_ENFORCE(ss && num_shards > 0, "Invalid reader state.");
+    DALI_ENFORCE(num_cursors == static_cast<size_t>(initial_buffer_fill_), make_string(
+                 "The reader state was saved with a shuffling buffer of ", num_cursors,
+                 " samples, while this reader uses ", initial_buffer_fill_, "."));
+    sample_cursors_.resize(num_cursors);
+    for (auto &cursor : sample_cursors_)
+      std::getline(ss, cursor);
+    std::string cursor;
+    std::getline(ss, last_cursor_);
+    DALI_ENFORCE(std::getline(ss, cursor), "Invalid reader state.");
+
+    for (auto &sample_cursor : sample_cursors_) {
+      ApplyCursor(sample_cursor);
+      auto tensor_ptr = LoadTargetUniquePtr(new LoadTarget());
+      PrepareEmpty(*tensor_ptr);
+      IssueRead(*tensor_ptr);
+      sample_buffer_.push_back(std::move(tensor_ptr));
+    }
+    if (pad_last_batch_ && !last_cursor_.empty()) {
+      // it might be needed for padding
+      ApplyCursor(last_cursor_);
+      auto tensor_ptr = std::make_shared<LoadTarget>();
+      PrepareEmpty(*tensor_ptr);
+      IssueRead(*tensor_ptr);
+      last_sample_ptr_tmp = std::move(tensor_ptr);
+    }
+    WaitForReads();
+    FillEmptyTensors();
+    ApplyCursor(cursor);
+    initial_buffer_filled_ = true;
+  }
+
   // return a tensor to the empty pile
   // called by multiple consumer threads
   void RecycleTensor(LoadTargetUniquePtr&& tensor_ptr) {
-    std::lock_guard<std::mutex> lock(empty_tensors_mutex_);
-    empty_tensors_.push_back(std::move(tensor_ptr));
+    // The pile can hold all the tensors created by the loader, so this never fails;
+    // if it did, the tensor would be just freed.
+    bool recycled = empty_tensors_.TryPush(std::move(tensor_ptr));
+    assert(recycled && "The empty tensor pile is full");
+    (void)recycled;
   }
 
   // Read an actual sample from the FileStore,
@@ -211,6 +375,17 @@ class Loader {
   // reads.
   virtual void ReadSample(LoadTarget& tensor) = 0;
 
+  /**
+   * @brief Waits for the samples being read in parallel (see `num_read_threads`)
+   *
+   * The samples returned by ReadOne might still be being read - this must be called before
+   * they are used.
+   */
+  void WaitForReads(bool check_errors = true) {
+    if (read_pool_)
+      read_pool_->WaitForWork(check_errors);
+  }
+
   void PrepareMetadata() {
     if (!loading_flag_) {
       std::lock_guard<std::mutex> l(prepare_metadata_mutex_);
@@ -218,17 +393,20 @@ class Loader {
         PrepareMetadataImpl();
         std::atomic_thread_fence(std::memory_order_release);
         loading_flag_ = true;
-        DALI_ENFORCE(num_shards_ <= Size(), make_string("The number of input samples: ", Size(),
-                                        ", needs to be at least equal to the requested number of"
-                                        " shards: ", num_shards_, "."));
+        // the number of samples read as a stream (or still being listed) is not known
+        DALI_ENFORCE(streaming_ || SizePending() || num_shards_ <= Size(),
+                     make_string("The number of input samples: ", Size(),
+                                 ", needs to be at least equal to the requested number of"
+                                 " shards: ", num_shards_, "."));
       }
     }
   }
 
-  // Give the size of the data accessed through the Loader
+  // Give the size of the data accessed through the Loader; -1 if unknown (see EnableStreaming)
   Index Size(bool consider_padding = false) {
     PrepareMetadata();
     if (pad_last_batch_ && consider_padding) {
+      std::lock_guard<std::mutex> lock(reshard_mutex_);
       return num_samples(num_shards_, SizeImpl()) * num_shards_;
     } else {
       return SizeImpl();
@@ -236,13 +414,58 @@ class Loader {
   }
 
   int GetNumShards() {
+    std::lock_guard<std::mutex> lock(reshard_mutex_);
     return num_shards_;
   }
 
   int GetShardId() {
+    std::lock_guard<std::mutex> lock(reshard_mutex_);
     return shard_id_;
   }
 
+  /**
+   * @brief Changes the sharding of the dataset, e.g. when the number of workers of an elastic
+   *        training changes
+   *
+   * With a negative `at_sample`, the new sharding is used once the current part of the epoch
+   * is read. Otherwise, each of the shards stops reading its current part of the epoch after
+   * `at_sample` samples of it and the samples that none of them has read are split among
+   * the new shards, so that no sample is skipped or read twice within the epoch. The next
+   * epochs follow the new sharding.
+   *
+   * All the readers of the dataset need to be resharded with the same `num_shards` and
+   * `at_sample`, which must lie ahead of the samples any of them has read (including the ones
+   * prefetched). The request is applied by the thread reading the samples; if there's none
+   * (`reading` is false) and nothing was read yet, the new shard is used right away.
+   */
+  void Reshard(int num_shards, int shard_id, Index at_sample, bool reading) {
+    DALI_ENFORCE(resharding_supported_, "Resharding is not supported by this reader.");
+    DALI_ENFORCE(!streaming_, "A reader with `streaming` cannot be resharded.");
+    DALI_ENFORCE(!checkpointing_, "A reader with `enable_checkpointing` cannot be resharded.");
+    DALI_ENFORCE(shard_id >= 0 && shard_id < num_shards, make_string(
+                 "Invalid shard ", shard_id, " out of ", num_shards, "."));
+    DALI_ENFORCE(at_sample < 0 || !pad_last_batch_, "A reader with `pad_last_batch` can be "
+                 "resharded only at the end of the part of the epoch it reads.");
+    PrepareMetadata();
+    DALI_ENFORCE(!SizePending(), "The reader can be resharded only after its files are listed.");
+    DALI_ENFORCE(num_shards <= Size(), make_string("The number of input samples: ", Size(),
+                 ", needs to be at least equal to the requested number of shards: ",
+                 num_shards, "."));
+    if (!reading && !initial_buffer_filled_) {
+      SetShards(num_shards, shard_id);
+      if (bucket_by_size_) {
+        // the order depends on the number of shards
+        shuffle_epoch_--;
+        ShuffleSampleOrder();
+      }
+      SeekPosition(start_index(shard_id_, num_shards_, SizeImpl()));
+      return;
+    }
+    std::lock_guard<std::mutex> lock(reshard_mutex_);
+    reshard_ = {num_shards, shard_id, at_sample};
+    reshard_pending_ = true;
+  }
+
   int PadLastBatch() {
     return pad_last_batch_;
   }
@@ -256,11 +479,444 @@ class Loader {
 
   virtual void PrepareMetadataImpl() {}
 
+  /**
+   * @brief Whether the samples are still being discovered, so that the size is not known yet
+   *
+   * A loader which lists its samples in the background returns true until the listing
+   * completes. Meanwhile, the reads don't look for the ends of the shards.
+   */
+  virtual bool SizePending() const {
+    return false;
+  }
+
+  /**
+   * @brief Advances to the next sample and returns the work reading its data into `tensor`
+   *
+   * Used when reading in parallel: the calls are sequential, so the order of the samples is
+   * deterministic, while the returned work runs in one of the I/O threads, concurrently with
+   * the reads of the other samples. An empty work means that the sample is already read.
+   *
+   * The default implementation reads the whole sample with ReadSample.
+   */
+  virtual ReadWork PrepareRead(LoadTarget& tensor) {
+    ReadSample(tensor);
+    return {};
+  }
+
+  /**
+   * @brief Like PrepareRead, but the sample can be split into several works, which are run
+   *        concurrently (e.g. one per frame of a sequence)
+   *
+   * The default implementation returns the work of PrepareRead.
+   */
+  virtual void PrepareReads(LoadTarget& tensor, std::vector<ReadWork> &works) {
+    if (auto work = PrepareRead(tensor))
+      works.push_back(std::move(work));
+  }
+
+  // Reads a sample, in the I/O thread pool if there's more than one read thread
+  void IssueRead(LoadTarget& tensor) {
+    if (num_read_threads_ == 1) {
+      ReadSample(tensor);
+      return;
+    }
+    read_works_.clear();
+    PrepareReads(tensor, read_works_);
+    if (read_works_.empty())
+      return;
+    if (!read_pool_) {
+      read_pool_ = std::make_unique<ThreadPool>(num_read_threads_, CPU_ONLY_DEVICE_ID, false,
+                                                "Loader I/O");
+    }
+    // the samples needed first are read first
+    for (auto &work : read_works_)
+      read_pool_->AddWork(std::move(work), -read_seq_, true);
+    read_seq_++;
+  }
+
+  /**
+   * @brief Enables reading the samples in an order drawn anew every epoch (`global_shuffle`)
+   *
+   * To be called by the constructors of the loaders which support it. Such a loader reads
+   * the sample SampleIndex(i) where it would otherwise read the i-th one and calls
+   * ShuffleSampleOrder when it starts an epoch.
+   */
+  void EnableGlobalShuffle() {
+    global_shuffle_supported_ = true;
+    if (!global_shuffle_)
+      return;
+    DALI_ENFORCE(!shuffle_, "`global_shuffle` and `random_shuffle` cannot be both true");
+    DALI_ENFORCE(!stick_to_shard_, "`global_shuffle` and `stick_to_shard` cannot be both true");
+    // all the shards use the same permutation, each one reads its own part of it
+    stick_to_shard_ = true;
+  }
+
+  /**
+   * @brief Opens the cache of the samples shared by the readers on the node (`shared_cache_name`)
+   *
+   * To be called by the constructors of the loaders which support it. Such a loader looks
+   * the files up in shared_cache_ (if set) before reading them and adds the ones it has read.
+   */
+  void EnableSharedCache() {
+    shared_cache_supported_ = true;
+    if (shared_cache_name_.empty())
+      return;
+#if SHM_WRAPPER_ENABLED
+    DALI_ENFORCE(shared_cache_size_ > 0,
+                 "`shared_cache_size` must be positive when `shared_cache_name` is used.");
+    shared_cache_ = SharedSampleCache::Open(shared_cache_name_,
+                                            static_cast<size_t>(shared_cache_size_) << 20);
+#else
+    DALI_FAIL("`shared_cache_name` is not supported - DALI was built without the shared memory "
+              "support.");
+#endif
+  }
+
+  /**
+   * @brief Enables keying the samples in the caches by their content (`content_hash`)
+   *
+   * To be called by the constructors of the loaders which support it. Such a loader checks
+   * if a sample is cached by ContentCacheKey before reading it and calls HashContent after
+   * reading it.
+   */
+  void EnableContentHash() {
+    content_hash_supported_ = true;
+  }
+
+  /**
+   * @brief The cache key of the sample `name` - the hash of its content, if it was read before
+   */
+  std::string ContentCacheKey(const std::string &name) {
+    if (!content_hash_)
+      return name;
+    std::lock_guard<std::mutex> g(content_keys_mutex_);
+    auto it = content_keys_.find(name);
+    return it != content_keys_.end() ? it->second : name;
+  }
+
+  /**
+   * @brief Sets the cache key of the sample `name` read to `data` to the hash of the data
+   *
+   * Returns true if a sample with the same content is in the decoder cache, so the sample can
+   * be skipped like the ones known to be cached before reading (`skip_cached_images`).
+   * Called by the read threads.
+   */
+  bool HashContent(const std::string &name, const void *data, size_t size, DALIMeta &meta) {
+    if (!content_hash_)
+      return false;
+    kernels::fast_hash_t hash = {};
+    kernels::fast_hash(hash, data, size);
+    static const char kHexDigits[] = "0123456789abcdef";
+    std::string key = "#";
+    for (uint32_t word : hash.data) {
+      for (int shift = 28; shift >= 0; shift -= 4)
+        key += kHexDigits[(word >> shift) & 0xf];
+    }
+    {
+      std::lock_guard<std::mutex> g(content_keys_mutex_);
+      content_keys_[name] = key;
+    }
+    meta.SetCacheKey(key);
+    return ShouldSkipImage(key);
+  }
+
+  /**
+   * @brief Enables reading the files sequentially, without an index (`streaming`)
+   *
+   * To be called by the constructors of the loaders which support it. In the streaming mode
+   * such a loader reads the files of StreamingFiles() one after another, starting over after
+   * the last one, and reports an unknown size (-1). The whole stream is one shard - there
+   * are no shard boundaries to stop at.
+   */
+  void EnableStreaming() {
+    streaming_supported_ = true;
+    if (!streaming_)
+      return;
+    DALI_ENFORCE(!global_shuffle_, "`global_shuffle` and `streaming` cannot be both true");
+    DALI_ENFORCE(!pad_last_batch_, "`pad_last_batch` and `streaming` cannot be both true");
+    DALI_ENFORCE(stream_buffer_size_ > 0, make_string(
+                 "`stream_buffer_size` must be positive, got ", stream_buffer_size_, "."));
+  }
+
+  /**
+   * @brief Enables grouping the samples of similar sizes into batches (`bucket_by_size`)
+   *
+   * To be called by the constructors of the loaders which support it. Such a loader
+   * implements SampleSizeKey and reads the samples in the order of SampleIndex, just like
+   * with `global_shuffle`, calling ShuffleSampleOrder when it starts an epoch.
+   */
+  void EnableBucketing() {
+    bucketing_supported_ = true;
+    if (!bucket_by_size_)
+      return;
+    DALI_ENFORCE(!shuffle_, "`bucket_by_size` and `random_shuffle` cannot be both true");
+    DALI_ENFORCE(!global_shuffle_, "`bucket_by_size` and `global_shuffle` cannot be both true");
+    DALI_ENFORCE(!stick_to_shard_, "`bucket_by_size` and `stick_to_shard` cannot be both true");
+    DALI_ENFORCE(!streaming_, "`bucket_by_size` and `streaming` cannot be both true");
+    DALI_ENFORCE(bucket_pool_size_ > 0, make_string(
+                 "`bucket_pool_size` must be positive, got ", bucket_pool_size_, "."));
+    // all the shards use the same order, each one reads its own part of it
+    stick_to_shard_ = true;
+  }
+
+  /**
+   * @brief The size of a sample (by its index in the dataset) used by `bucket_by_size`
+   *
+   * It can be any measure correlated with the size of the outputs, e.g. the file size or the
+   * duration of a recording. Called once per sample, when the first epoch starts.
+   */
+  virtual double SampleSizeKey(Index) {
+    DALI_FAIL("`bucket_by_size` is not supported by this reader.");
+  }
+
+  /**
+   * @brief Enables saving and restoring the state of the loader (`enable_checkpointing`)
+   *
+   * To be called by the constructors of the loaders which support it. Such a loader
+   * implements SaveCursor and RestoreCursor.
+   */
+  void EnableCheckpointing() {
+    checkpointing_supported_ = true;
+    if (!checkpointing_)
+      return;
+    DALI_ENFORCE(!streaming_, "`enable_checkpointing` and `streaming` cannot be both true");
+  }
+
+  /**
+   * @brief Enables changing the sharding while reading (see Reshard)
+   *
+   * To be called by the constructors of the loaders which support it. Such a loader
+   * implements SeekPosition and calls MoveToNextShard with the position of the next sample
+   * to read, before reading it.
+   */
+  void EnableResharding() {
+    resharding_supported_ = true;
+  }
+
+  // Moves the loader to the given position in the epoch, so that it's the next one read
+  virtual void SeekPosition(Index) {
+    DALI_FAIL("Resharding is not supported by this reader.");
+  }
+
+  /**
+   * @brief Writes the position of the loader in the dataset, in a single line
+   *
+   * After RestoreCursor with it, the loader reads the same samples as after the position
+   * was saved. The order of the samples drawn by ShuffleSampleOrder is restored by the caller.
+   */
+  virtual void SaveCursor(std::ostream &) const {
+    DALI_FAIL("`enable_checkpointing` is not supported by this reader.");
+  }
+
+  virtual void RestoreCursor(std::istream &) {
+    DALI_FAIL("`enable_checkpointing` is not supported by this reader.");
+  }
+
+  /**
+   * @brief The range [begin, end) of the files read by this shard in the streaming mode
+   */
+  std::pair<size_t, size_t> StreamingFiles(size_t num_files) const {
+    DALI_ENFORCE(static_cast<size_t>(num_shards_) <= num_files, make_string(
+                 "With `streaming`, the dataset is sharded by files - the number of files: ",
+                 num_files, ", needs to be at least equal to the requested number of shards: ",
+                 num_shards_, "."));
+    return {start_index(shard_id_, num_shards_, num_files),
+            start_index(shard_id_ + 1, num_shards_, num_files)};
+  }
+
+  // The index of the sample to read at the given position in the epoch
+  inline Index SampleIndex(Index position) const {
+    return sample_order_.empty() ? position : sample_order_[position];
+  }
+
+  /**
+   * @brief Draws the order of the samples for the next epoch, if `global_shuffle` is enabled
+   *
+   * The samples are permuted in blocks of `shuffle_block_size` consecutive ones, so that the
+   * reads within a block are sequential. The permutation depends only on the epoch and
+   * `global_shuffle_seed`, so all the shards get the same one.
+   */
+  void ShuffleSampleOrder() {
+    if (bucket_by_size_) {
+      BucketSampleOrder();
+      return;
+    }
+    if (!global_shuffle_)
+      return;
+    Index size = SizeImpl();
+    Index block_size = shuffle_block_size_;
+    std::vector<Index> blocks((size + block_size - 1) / block_size);
+    std::iota(blocks.begin(), blocks.end(), 0);
+    std::mt19937 g(shuffle_seed_ + shuffle_epoch_++);
+    std::shuffle(blocks.begin(), blocks.end(), g);
+    sample_order_.clear();
+    sample_order_.reserve(size);
+    for (Index block : blocks) {
+      Index end = std::min(size, (block + 1) * block_size);
+      for (Index i = block * block_size; i < end; i++)
+        sample_order_.push_back(i);
+    }
+  }
+
+  /**
+   * @brief Draws the order of the samples for the next epoch, so that the batches consist of
+   *        samples of similar sizes (`bucket_by_size`)
+   *
+   * The samples are permuted randomly and split into the shards. Within a shard, every
+   * `bucket_pool_size` batches worth of samples are sorted by SampleSizeKey and cut into batches,
+   * which are then shuffled. The order depends only on the epoch, so all the shards get
+   * the same one, and the batches are aligned with the beginning of each shard.
+   */
+  void BucketSampleOrder() {
+    Index size = SizeImpl();
+    if (static_cast<Index>(sample_size_keys_.size()) != size) {
+      sample_size_keys_.resize(size);
+      for (Index i = 0; i < size; i++)
+        sample_size_keys_[i] = SampleSizeKey(i);
+    }
+    std::vector<Index> samples(size);
+    std::iota(samples.begin(), samples.end(), 0);
+    std::mt19937 g(shuffle_seed_ + shuffle_epoch_++);
+    std::shuffle(samples.begin(), samples.end(), g);
+    auto by_size = [&](Index a, Index b) {
+      return sample_size_keys_[a] < sample_size_keys_[b];
+    };
+
+    Index batch_size = bucket_batch_size_;
+    Index pool_size = batch_size * bucket_pool_size_;
+    sample_order_.clear();
+    sample_order_.reserve(size);
+    std::vector<Index> batches;
+    for (int shard = 0; shard < num_shards_; shard++) {
+      Index shard_begin = start_index(shard, num_shards_, size);
+      Index shard_end = start_index(shard + 1, num_shards_, size);
+      for (Index begin = shard_begin; begin < shard_end; begin += pool_size) {
+        Index end = std::min(shard_end, begin + pool_size);
+        std::sort(samples.begin() + begin, samples.begin() + end, by_size);
+      }
+      // the last, partial batch of the shard stays at its end
+      batches.resize((shard_end - shard_begin) / batch_size);
+      std::iota(batches.begin(), batches.end(), 0);
+      std::shuffle(batches.begin(), batches.end(), g);
+      for (Index batch : batches) {
+        Index begin = shard_begin + batch * batch_size;
+        sample_order_.insert(sample_order_.end(), samples.begin() + begin,
+                             samples.begin() + begin + batch_size);
+      }
+      sample_order_.insert(sample_order_.end(),
+                           samples.begin() + shard_begin + batches.size() * batch_size,
+                           samples.begin() + shard_end);
+    }
+  }
+
   virtual void MoveToNextShard(Index current_index) {
+    if ((reshard_pending_ || resharded_epoch_) && ApplyReshard(current_index))
+      return;
     if (IsNextShard(current_index)) {
       Reset(stick_to_shard_);
     }
   }
+
+  void SetShards(int num_shards, int shard_id) {
+    std::lock_guard<std::mutex> lock(reshard_mutex_);
+    num_shards_ = num_shards;
+    shard_id_ = shard_id;
+    virtual_shard_id_ = shard_id;
+  }
+
+  // The beginning of the part of the epoch read by the given shard
+  Index PartBegin(int shard) {
+    return reshard_begin_ +
+           static_cast<Index>(start_index(shard, num_shards_, SizeImpl() - reshard_begin_));
+  }
+
+  /**
+   * @brief Applies the pending Reshard when the loader gets to its position, `current_index`
+   *        being the next one to read
+   *
+   * Returns true if the position is handled here, i.e. the loader shouldn't look for the end
+   * of the shard itself.
+   */
+  bool ApplyReshard(Index current_index) {
+    int part = shard_id_;
+    if (!resharded_epoch_ && !stick_to_shard_ && read_sample_counter_ > 0) {
+      // the last sample read is in (begin, end] of its part
+      part = 0;
+      while (part + 1 < num_shards_ && PartBegin(part + 1) < current_index)
+        part++;
+    }
+    Index begin = PartBegin(part), end = PartBegin(part + 1);
+    if (reshard_pending_) {
+      std::unique_lock<std::mutex> lock(reshard_mutex_);
+      Index at = end - begin;
+      if (reshard_.at_sample >= 0)
+        at = std::min(at, reshard_.at_sample);
+      DALI_ENFORCE(current_index - begin <= at, make_string(
+                   "Cannot reshard the reader after ", at, " samples of the current part of "
+                   "the epoch - ", current_index - begin, " of them were already read."));
+      if (current_index - begin == at) {
+        auto request = reshard_;
+        reshard_pending_ = false;
+        lock.unlock();
+        if (at < end - begin) {
+          CutEpoch(at);
+          SetShards(request.num_shards, request.shard_id);
+          resharded_epoch_ = true;
+          begin = PartBegin(shard_id_);
+          end = PartBegin(shard_id_ + 1);
+          part_samples_ = resharded_read_ + end - begin;
+          if (begin < end)
+            SeekPosition(begin);
+          else
+            StartReshardedEpoch();
+        } else {
+          SetShards(request.num_shards, request.shard_id);
+          part_samples_ = resharded_read_ + at;
+          StartReshardedEpoch();
+        }
+        return true;
+      }
+    }
+    if (resharded_epoch_ && current_index >= end) {
+      StartReshardedEpoch();
+      return true;
+    }
+    return resharded_epoch_;
+  }
+
+  /**
+   * @brief Reorders the rest of the epoch, so that the samples read by the shards, up to
+   *        `at` samples of each part, go first and the ones left follow, to be split anew
+   */
+  void CutEpoch(Index at) {
+    Index size = SizeImpl();
+    std::vector<Index> order, rest;
+    order.reserve(size);
+    for (Index i = 0; i < reshard_begin_; i++)
+      order.push_back(SampleIndex(i));
+    for (int shard = 0; shard < num_shards_; shard++) {
+      Index begin = PartBegin(shard), end = PartBegin(shard + 1);
+      Index cut = std::min(end, begin + at);
+      for (Index i = begin; i < cut; i++)
+        order.push_back(SampleIndex(i));
+      for (Index i = cut; i < end; i++)
+        rest.push_back(SampleIndex(i));
+    }
+    reshard_begin_ = order.size();
+    order.insert(order.end(), rest.begin(), rest.end());
+    sample_order_ = std::move(order);
+    resharded_read_ += at;
+  }
+
+  // Starts the next epoch with the new sharding
+  void StartReshardedEpoch() {
+    resharded_epoch_ = false;
+    reshard_begin_ = 0;
+    resharded_read_ = 0;
+    if (!global_shuffle_ && !bucket_by_size_)
+      sample_order_.clear();
+    Reset(true);
+  }
   // Reset reader to the first sample
   virtual void Reset(bool wrap_to_shard) = 0;
 
@@ -282,8 +938,17 @@ class Loader {
 
   inline void IncreaseReadSampleCounter() {
     ++read_sample_counter_;
-    if (IsNextShardRelative(read_sample_counter_ - 1, virtual_shard_id_)) {
-      if (!stick_to_shard_) {
+    if (streaming_ || SizePending())
+      return;
+    bool next_shard = part_samples_ >= 0
+                    ? read_sample_counter_ > part_samples_
+                    : IsNextShardRelative(read_sample_counter_ - 1, virtual_shard_id_);
+    if (next_shard) {
+      if (part_samples_ >= 0) {
+        // the part of the epoch was changed by Reshard, the next one is the new shard
+        virtual_shard_id_ = shard_id_;
+        part_samples_ = -1;
+      } else if (!stick_to_shard_) {
         ++virtual_shard_id_;
       }
       read_sample_counter_ = 1;
@@ -295,6 +960,40 @@ class Loader {
     }
   }
 
+  // need some entries in the empty_tensors_ list
+  void FillEmptyTensors() {
+    DomainTimeRange tr("[DALI][Loader] Filling empty list", DomainTimeRange::kOrange);
+    for (int i = 0; i < initial_empty_size_; ++i) {
+      auto tensor_ptr = LoadTargetUniquePtr(new LoadTarget());
+      PrepareEmpty(*tensor_ptr);
+      RecycleTensor(std::move(tensor_ptr));
+    }
+  }
+
+  std::string CaptureCursor() const {
+    std::stringstream ss;
+    ss << shuffle_epoch_;
+    SaveCursor(ss);
+    return ss.str();
+  }
+
+  void ApplyCursor(const std::string &cursor) {
+    std::istringstream ss(cursor);
+    int epoch;
+    DALI_ENFORCE(static_cast<bool>(ss >> epoch), "Invalid reader state.");
+    if (epoch == 0) {
+      // nothing was drawn yet
+      shuffle_epoch_ = 0;
+      sample_order_.clear();
+    } else if (epoch != shuffle_epoch_) {
+      // the order of the samples drawn for that epoch
+      shuffle_epoch_ = epoch - 1;
+      ShuffleSampleOrder();
+    }
+    RestoreCursor(ss);
+    DALI_ENFORCE(!ss.fail(), "Invalid reader state.");
+  }
+
   bool ShouldSkipImage(const ImageCache::ImageKey& key) {
     if (!skip_cached_images_)
       return false;
@@ -312,7 +1011,7 @@ class Loader {
 
   std::vector<LoadTargetUniquePtr> sample_buffer_;
 
-  std::vector<LoadTargetUniquePtr> empty_tensors_;
+  MPMCBoundedQueue<LoadTargetUniquePtr> empty_tensors_;
 
   // number of samples to initialize buffer with
   // ~1 minibatch seems reasonable
@@ -326,12 +1025,9 @@ class Loader {
   std::default_random_engine e_;
   Index seed_;
 
-  // control return of tensors
-  std::mutex empty_tensors_mutex_;
-
   // sharding
-  const int shard_id_;
-  const int num_shards_;
+  int shard_id_;
+  int num_shards_;
 
   // if read data need to be copied or can be just shared with tensor
   bool copy_read_data_;
@@ -353,6 +1049,13 @@ class Loader {
   bool lazy_init_;
   bool loading_flag_;
 
+  // Keying the samples in the caches by their content (see EnableContentHash) - the keys of
+  // the samples read so far, by name
+  const bool content_hash_;
+  bool content_hash_supported_ = false;
+  std::mutex content_keys_mutex_;
+  std::unordered_map<std::string, std::string> content_keys_;
+
   // Image cache
   std::once_flag fetch_cache_;
   std::shared_ptr<ImageCache> cache_;
@@ -368,17 +1071,84 @@ class Loader {
   // target tensor, if false loader will try to mmap files if possible and wrap the content into
   // tensor without copy
   bool dont_use_mmap_;
+  // If true, the files are read via io_uring
+  bool use_io_uring_;
+  // If true, the files read via io_uring bypass the page cache
+  bool use_o_direct_;
+  // Hints passed to the OS on how the files are read
+  FileReadPolicy read_policy_;
   // Number of data shards that were actually read by the reader
   int virtual_shard_id_;
   // Keeps pointer to the last returned sample just in case it needs to be cloned
   LoadTargetSharedPtr last_sample_ptr_tmp;
 
+  // Number of threads reading the samples in parallel (see PrepareRead)
+  const int num_read_threads_;
+  std::unique_ptr<ThreadPool> read_pool_;
+  int64_t read_seq_ = 0;
+  std::vector<ReadWork> read_works_;
+
+  // Reading the samples in an order drawn every epoch (see ShuffleSampleOrder)
+  const bool global_shuffle_;
+  const int shuffle_block_size_;
+  // the same in all the shards (`global_shuffle_seed`)
+  Index shuffle_seed_;
+  bool global_shuffle_supported_ = false;
+  int shuffle_epoch_ = 0;
+  std::vector<Index> sample_order_;
+
+  // The cache of the samples shared with the other readers on the node (see EnableSharedCache)
+  const std::string shared_cache_name_;
+  const int shared_cache_size_;
+  bool shared_cache_supported_ = false;
+  std::shared_ptr<SharedSampleCache> shared_cache_;
+
+  // Reading the files as streams, without an index (see EnableStreaming)
+  const bool streaming_;
+  const int stream_buffer_size_;
+  bool streaming_supported_ = false;
+
+  // Grouping the samples of similar sizes into batches (see BucketSampleOrder)
+  const bool bucket_by_size_;
+  const int bucket_pool_size_;
+  const int bucket_batch_size_;
+  bool bucketing_supported_ = false;
+  std::vector<double> sample_size_keys_;
+
+  // Saving and restoring the state (see SaveState)
+  static constexpr const char *kStateHeader = "DALI loader state 1";
+  const bool checkpointing_;
+  bool checkpointing_supported_ = false;
+  // the positions at which the samples in sample_buffer_ and the last returned one were read
+  std::vector<std::string> sample_cursors_;
+  std::string last_cursor_;
+
   struct ShardBoundaries {
     Index start;
     Index end;
   };
 
   std::deque<ShardBoundaries> shards_;
+
+  // Changing the sharding while reading (see Reshard)
+  struct ReshardRequest {
+    int num_shards;
+    int shard_id;
+    Index at_sample;
+  };
+  bool resharding_supported_ = false;
+  // guards the request and the sharding, which is changed by the loader thread
+  std::mutex reshard_mutex_;
+  ReshardRequest reshard_{};
+  std::atomic<bool> reshard_pending_{false};
+  // whether the epoch was cut by Reshard - the positions before reshard_begin_ are read and
+  // the rest is split among the new shards
+  bool resharded_epoch_ = false;
+  Index reshard_begin_ = 0;
+  // the number of samples of the current part of the epoch read before it was cut
+  Index resharded_read_ = 0;
+  // the number of samples in the current part of the epoch, if it's changed by Reshard
+  Index part_samples_ = -1;
 };
 
 template<typename T, typename... Args>
@@ -1,4 +1,4 @@
-// Copyright (c) 2017, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,7 +13,19 @@
 // limitations under the License.
 
 #include <gtest/gtest.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "dali/core/common.h"
 #include "dali/pipeline/data/backend.h"
@@ -80,6 +92,397 @@ TYPED_TEST(DataLoadStoreTest, FileLabelLoaderMmmap) {
   }
 }
 
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderIOUring) {
+  auto make_spec = [](bool use_io_uring, bool use_o_direct) {
+    return OpSpec("FileReader")
+        .AddArg("file_root", loader_test_image_folder)
+        .AddArg("max_batch_size", 32)
+        .AddArg("device_id", 0)
+        .AddArg("use_io_uring", use_io_uring)
+        .AddArg("use_o_direct", use_o_direct);
+  };
+  for (bool use_o_direct : {false, true}) {
+    FileLabelLoader ref_reader(make_spec(false, false));
+    ref_reader.PrepareMetadata();
+    FileLabelLoader reader(make_spec(true, use_o_direct));
+    reader.PrepareMetadata();
+    for (int i = 0; i < 10; i++) {
+      auto ref = ref_reader.ReadOne(i == 0);
+      auto sample = reader.ReadOne(i == 0);
+      EXPECT_FALSE(sample->image.shares_data());
+      ASSERT_EQ(sample->image.shape(), ref->image.shape());
+      EXPECT_EQ(sample->label, ref->label);
+      EXPECT_EQ(std::memcmp(sample->image.raw_data(), ref->image.raw_data(),
+                            ref->image.nbytes()), 0);
+    }
+  }
+  EXPECT_THROW(FileLabelLoader(make_spec(false, true)), std::exception);
+}
+
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderGlobalShuffle) {
+  auto make_spec = [](bool global_shuffle, int block_size) {
+    return OpSpec("FileReader")
+        .AddArg("file_root", loader_test_image_folder)
+        .AddArg("max_batch_size", 32)
+        .AddArg("device_id", 0)
+        .AddArg("global_shuffle", global_shuffle)
+        .AddArg("shuffle_block_size", block_size);
+  };
+  auto read_epoch = [](FileLabelLoader &reader) {
+    std::vector<std::string> names;
+    for (Index i = 0; i < reader.Size(); i++)
+      names.push_back(reader.ReadOne(i == 0)->image.GetMeta().GetSourceInfo());
+    return names;
+  };
+
+  FileLabelLoader ref_reader(make_spec(false, 1));
+  ref_reader.PrepareMetadata();
+  auto ref_order = read_epoch(ref_reader);
+  std::map<std::string, int> ref_pos;
+  for (size_t i = 0; i < ref_order.size(); i++)
+    ref_pos[ref_order[i]] = i;
+
+  for (int block_size : {1, 3}) {
+    FileLabelLoader reader(make_spec(true, block_size));
+    reader.PrepareMetadata();
+    ASSERT_EQ(reader.Size(), ref_reader.Size());
+    std::vector<std::string> prev_epoch;
+    for (int epoch = 0; epoch < 3; epoch++) {
+      auto order = read_epoch(reader);
+      // each sample is read exactly once per epoch
+      EXPECT_EQ(std::set<std::string>(order.begin(), order.end()).size(), order.size());
+      EXPECT_NE(order, ref_order);
+      EXPECT_NE(order, prev_epoch);
+      // the blocks are read sequentially
+      int num_blocks = (order.size() + block_size - 1) / block_size;
+      int breaks = 0;
+      for (size_t i = 1; i < order.size(); i++)
+        breaks += ref_pos[order[i]] != ref_pos[order[i - 1]] + 1;
+      EXPECT_LT(breaks, num_blocks);
+      prev_epoch = std::move(order);
+    }
+  }
+
+  // the permutation is shared by the readers with the same `global_shuffle_seed`, no matter
+  // their `seed`
+  std::vector<std::vector<std::string>> orders;
+  for (auto seeds : {std::make_pair(1, 7), std::make_pair(2, 7), std::make_pair(1, 8)}) {
+    FileLabelLoader reader(make_spec(true, 1)
+                           .AddArg("seed", seeds.first)
+                           .AddArg("global_shuffle_seed", seeds.second));
+    reader.PrepareMetadata();
+    orders.push_back(read_epoch(reader));
+  }
+  EXPECT_EQ(orders[0], orders[1]);
+  EXPECT_NE(orders[0], orders[2]);
+
+  EXPECT_THROW(FileLabelLoader(make_spec(true, 1).AddArg("random_shuffle", true)),
+               std::exception);
+  EXPECT_THROW(FileLabelLoader(make_spec(true, 1).AddArg("stick_to_shard", true)),
+               std::exception);
+  EXPECT_THROW(FileLabelLoader(make_spec(true, 0)), std::exception);
+}
+
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderBucketing) {
+  const int batch_size = 4;
+  auto make_spec = [&](bool bucket_by_size) {
+    return OpSpec("FileReader")
+        .AddArg("file_root", loader_test_image_folder)
+        .AddArg("max_batch_size", batch_size)
+        .AddArg("device_id", 0)
+        .AddArg("bucket_by_size", bucket_by_size)
+        .AddArg("bucket_pool_size", 8);
+  };
+  // the sum of the differences between the largest and the smallest sample of each batch
+  auto read_epoch = [&](FileLabelLoader &reader, std::vector<std::string> &names) {
+    names.clear();
+    int64_t spread = 0;
+    for (Index i = 0; i + batch_size <= reader.Size(); i += batch_size) {
+      int64_t min_size = std::numeric_limits<int64_t>::max(), max_size = 0;
+      for (int j = 0; j < batch_size; j++) {
+        auto sample = reader.ReadOne(j == 0);
+        names.push_back(sample->image.GetMeta().GetSourceInfo());
+        min_size = std::min<int64_t>(min_size, sample->image.nbytes());
+        max_size = std::max<int64_t>(max_size, sample->image.nbytes());
+      }
+      spread += max_size - min_size;
+    }
+    while (static_cast<Index>(names.size()) < reader.Size())
+      names.push_back(reader.ReadOne(false)->image.GetMeta().GetSourceInfo());
+    return spread;
+  };
+
+  FileLabelLoader ref_reader(make_spec(false).AddArg("global_shuffle", true));
+  ref_reader.PrepareMetadata();
+  FileLabelLoader reader(make_spec(true));
+  reader.PrepareMetadata();
+  ASSERT_EQ(reader.Size(), ref_reader.Size());
+  std::vector<std::string> ref_names, names, prev_names;
+  for (int epoch = 0; epoch < 3; epoch++) {
+    int64_t ref_spread = read_epoch(ref_reader, ref_names);
+    int64_t spread = read_epoch(reader, names);
+    // the batches are composed of the samples of similar sizes
+    EXPECT_LT(spread, ref_spread / 2);
+    // each sample is read exactly once per epoch, in a different order every time
+    EXPECT_EQ(std::set<std::string>(names.begin(), names.end()).size(), names.size());
+    EXPECT_NE(names, prev_names);
+    prev_names = names;
+  }
+
+  EXPECT_THROW(FileLabelLoader(make_spec(true).AddArg("random_shuffle", true)), std::exception);
+  EXPECT_THROW(FileLabelLoader(make_spec(true).AddArg("global_shuffle", true)), std::exception);
+  EXPECT_THROW(FileLabelLoader(make_spec(true).AddArg("bucket_pool_size", 0)), std::exception);
+  EXPECT_THROW(FileLabelLoader(make_spec(true), true), std::exception);
+}
+
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderCheckpointing) {
+  auto make_spec = [&](bool global_shuffle) {
+    return OpSpec("FileReader")
+        .AddArg("file_root", loader_test_image_folder)
+        .AddArg("max_batch_size", 4)
+        .AddArg("device_id", 0)
+        .AddArg("random_shuffle", !global_shuffle)
+        .AddArg("global_shuffle", global_shuffle)
+        .AddArg("initial_fill", 8)
+        .AddArg("seed", 123)
+        .AddArg("enable_checkpointing", true);
+  };
+  auto read = [](FileLabelLoader &reader, Index n) {
+    std::vector<std::string> names;
+    for (Index i = 0; i < n; i++)
+      names.push_back(reader.ReadOne(i % 4 == 0)->image.GetMeta().GetSourceInfo());
+    return names;
+  };
+
+  for (bool global_shuffle : {false, true}) {
+    FileLabelLoader reader(make_spec(global_shuffle));
+    reader.PrepareMetadata();
+    Index size = reader.Size();
+    // the state before the first read, and then in the middle of the next epochs
+    for (Index skip : {Index(0), size + 4, size / 2 + 4}) {
+      read(reader, skip);
+      auto state = reader.SaveState();
+      auto expected = read(reader, 2 * size);
+
+      FileLabelLoader restored(make_spec(global_shuffle));
+      restored.RestoreState(state);
+      EXPECT_EQ(read(restored, 2 * size), expected);
+      EXPECT_EQ(restored.SaveState(), reader.SaveState());
+    }
+  }
+
+  FileLabelLoader no_checkpointing(make_spec(false).AddArg("enable_checkpointing", false));
+  EXPECT_THROW(no_checkpointing.SaveState(), std::exception);
+  FileLabelLoader other_fill(make_spec(false).AddArg("initial_fill", 16));
+  FileLabelLoader reader(make_spec(false));
+  read(reader, 4);
+  EXPECT_THROW(other_fill.RestoreState(reader.SaveState()), std::exception);
+  EXPECT_THROW(reader.RestoreState(reader.SaveState()), std::exception);
+  EXPECT_THROW(FileLabelLoader(make_spec(false).AddArg("random_shuffle", false), true),
+               std::exception);
+}
+
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderResharding) {
+  auto make_spec = [](int num_shards, int shard_id) {
+    return OpSpec("FileReader")
+        .AddArg("file_root", loader_test_image_folder)
+        .AddArg("max_batch_size", 4)
+        .AddArg("device_id", 0)
+        .AddArg("num_shards", num_shards)
+        .AddArg("shard_id", shard_id);
+  };
+  auto read = [](FileLabelLoader &reader, Index n, std::vector<std::string> &names) {
+    for (Index i = 0; i < n; i++)
+      names.push_back(reader.ReadOne(i == 0)->image.GetMeta().GetSourceInfo());
+  };
+  auto part_size = [](int shard, int num_shards, Index size) {
+    return static_cast<Index>(start_index(shard + 1, num_shards, size) -
+                              start_index(shard, num_shards, size));
+  };
+  auto check_epoch = [](std::vector<std::string> names, Index size) {
+    EXPECT_EQ(static_cast<Index>(names.size()), size);
+    EXPECT_EQ(static_cast<Index>(std::set<std::string>(names.begin(), names.end()).size()), size);
+  };
+
+  // 3 shards, one of them leaves in the middle of the epoch
+  std::vector<std::unique_ptr<FileLabelLoader>> readers;
+  for (int i = 0; i < 3; i++) {
+    readers.push_back(std::make_unique<FileLabelLoader>(make_spec(3, i)));
+    readers.back()->PrepareMetadata();
+  }
+  Index size = readers[0]->Size();
+  Index at = part_size(0, 3, size) / 2;
+  ASSERT_GT(at, 2);
+  std::vector<std::string> epoch;
+  for (int i = 0; i < 3; i++)
+    read(*readers[i], 2, epoch);
+  for (int i = 0; i < 2; i++)
+    readers[i]->Reshard(2, i, at, true);
+  // the leaving shard returns its samples up to the cut
+  read(*readers[2], at - 2, epoch);
+  Index rest = size - 3 * at;
+  for (int i = 0; i < 2; i++)
+    read(*readers[i], at - 2 + part_size(i, 2, rest), epoch);
+  check_epoch(epoch, size);
+
+  // the next epoch follows the new sharding
+  epoch.clear();
+  for (int i = 0; i < 2; i++) {
+    EXPECT_EQ(readers[i]->GetNumShards(), 2);
+    EXPECT_EQ(readers[i]->GetShardId(), i);
+    read(*readers[i], part_size(i, 2, size), epoch);
+  }
+  check_epoch(epoch, size);
+
+  // a shard joins at the end of the epoch
+  epoch.clear();
+  for (int i = 0; i < 2; i++) {
+    read(*readers[i], 1, epoch);
+    readers[i]->Reshard(3, i, -1, true);
+    read(*readers[i], part_size(i, 2, size) - 1, epoch);
+  }
+  check_epoch(epoch, size);
+  epoch.clear();
+  FileLabelLoader joined(make_spec(3, 2));
+  read(joined, part_size(2, 3, size), epoch);
+  for (int i = 0; i < 2; i++)
+    read(*readers[i], part_size(i, 3, size), epoch);
+  check_epoch(epoch, size);
+
+  // before anything is read, the new shard is used right away
+  FileLabelLoader reader(make_spec(3, 0)), ref(make_spec(2, 1));
+  reader.Reshard(2, 1, -1, false);
+  std::vector<std::string> names, ref_names;
+  read(reader, 4, names);
+  read(ref, 4, ref_names);
+  EXPECT_EQ(names, ref_names);
+
+  // the cut is behind the samples already read
+  reader.Reshard(2, 0, 2, true);
+  EXPECT_THROW(read(reader, 1, names), std::exception);
+  EXPECT_THROW(reader.Reshard(2, 2, -1, true), std::exception);
+  FileLabelLoader checkpointing(make_spec(2, 0).AddArg("enable_checkpointing", true));
+  EXPECT_THROW(checkpointing.Reshard(3, 0, -1, true), std::exception);
+}
+
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderLazyListing) {
+  auto make_spec = [](bool pad_last_batch) {
+    return OpSpec("FileReader")
+        .AddArg("file_root", loader_test_image_folder)
+        .AddArg("max_batch_size", 32)
+        .AddArg("device_id", 0)
+        .AddArg("pad_last_batch", pad_last_batch);
+  };
+  // without padding, the reads start while the directories are being listed
+  FileLabelLoader reader(make_spec(false));
+  reader.PrepareMetadata();
+  FileLabelLoader ref_reader(make_spec(true));
+  ref_reader.PrepareMetadata();
+  for (Index i = 0; i < ref_reader.Size() * 2 + 5; i++) {
+    auto ref = ref_reader.ReadOne(i == 0);
+    auto sample = reader.ReadOne(i == 0);
+    ASSERT_EQ(sample->image.GetMeta().GetSourceInfo(), ref->image.GetMeta().GetSourceInfo());
+    EXPECT_EQ(sample->label, ref->label);
+  }
+  EXPECT_EQ(reader.Size(), ref_reader.Size());
+}
+
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderListingCache) {
+  char cache_template[] = "/tmp/dali_file_list_cacheXXXXXX";
+  int fd = mkstemp(cache_template);
+  ASSERT_GE(fd, 0);
+  // not a valid cache - overwritten
+  ASSERT_EQ(write(fd, "garbage\n", 8), 8);
+  close(fd);
+  std::string cache = cache_template;
+
+  auto make_spec = [&](bool shuffle) {
+    return OpSpec("FileReader")
+        .AddArg("file_root", loader_test_image_folder)
+        .AddArg("max_batch_size", 32)
+        .AddArg("device_id", 0)
+        .AddArg("random_shuffle", shuffle)
+        .AddArg("file_list_cache", cache);
+  };
+  auto read_epoch = [](FileLabelLoader &reader) {
+    std::vector<std::pair<std::string, int>> samples;
+    for (Index i = 0; i < reader.Size(); i++) {
+      auto sample = reader.ReadOne(i == 0);
+      samples.emplace_back(sample->image.GetMeta().GetSourceInfo(), sample->label);
+    }
+    return samples;
+  };
+
+  FileLabelLoader ref_reader(OpSpec("FileReader")
+                             .AddArg("file_root", loader_test_image_folder)
+                             .AddArg("max_batch_size", 32)
+                             .AddArg("device_id", 0));
+  ref_reader.PrepareMetadata();
+  auto ref = read_epoch(ref_reader);
+
+  for (bool shuffle : {false, true}) {
+    // the first one saves the cache, the other one loads it
+    for (int run = 0; run < 2; run++) {
+      FileLabelLoader reader(make_spec(shuffle));
+      reader.PrepareMetadata();
+      auto samples = read_epoch(reader);
+      if (shuffle)
+        std::sort(samples.begin(), samples.end());
+      auto expected = ref;
+      if (shuffle)
+        std::sort(expected.begin(), expected.end());
+      EXPECT_EQ(samples, expected);
+      std::ifstream s(cache);
+      std::string header;
+      ASSERT_TRUE(std::getline(s, header));
+      EXPECT_EQ(header, "DALI file list cache 1");
+    }
+  }
+  std::remove(cache.c_str());
+}
+
+TYPED_TEST(DataLoadStoreTest, FileLabelLoaderContentHash) {
+  char dir_template[] = "/tmp/dali_content_hashXXXXXX";
+  ASSERT_NE(mkdtemp(dir_template), nullptr);
+  std::string dir = dir_template;
+  // the first two files are the same
+  std::vector<std::string> files = {"a.bin", "b.bin", "c.bin"};
+  std::vector<std::string> contents = {"some content", "some content", "other content"};
+  for (size_t i = 0; i < files.size(); i++)
+    std::ofstream(dir + "/" + files[i]) << contents[i];
+
+  for (bool content_hash : {false, true}) {
+    FileLabelLoader reader(OpSpec("FileReader")
+                           .AddArg("file_root", dir)
+                           .AddArg("files", files)
+                           .AddArg("max_batch_size", 32)
+                           .AddArg("device_id", 0)
+                           .AddArg("content_hash", content_hash));
+    reader.PrepareMetadata();
+    // the keys are the same in the next epoch
+    for (int epoch = 0; epoch < 2; epoch++) {
+      std::vector<std::string> keys;
+      for (size_t i = 0; i < files.size(); i++) {
+        auto sample = reader.ReadOne(epoch == 0 && i == 0);
+        EXPECT_EQ(sample->image.GetMeta().GetSourceInfo(), files[i]);
+        keys.push_back(sample->image.GetMeta().GetCacheKey());
+      }
+      if (content_hash) {
+        EXPECT_EQ(keys[0], keys[1]);
+        EXPECT_NE(keys[0], keys[2]);
+        EXPECT_EQ(keys[0].size(), 65u);
+        EXPECT_EQ(keys[0][0], '#');
+      } else {
+        EXPECT_EQ(keys, files);
+      }
+    }
+  }
+
+  for (auto &file : files)
+    std::remove((dir + "/" + file).c_str());
+  rmdir(dir.c_str());
+}
+
 TYPED_TEST(DataLoadStoreTest, RecordIOLoaderMmmap) {
   for (bool dont_use_mmap : {true, false}) {
     std::vector<std::string> path =  {testing::dali_extra_path() + "/db/recordio/train.rec"};
@@ -95,7 +498,8 @@ TYPED_TEST(DataLoadStoreTest, RecordIOLoaderMmmap) {
 
     reader->PrepareMetadata();
     auto sample = reader->ReadOne(false);
-    EXPECT_EQ(sample->shares_data(), !dont_use_mmap);
+    // without mmap, the records are read in runs and share the buffer of their run
+    EXPECT_TRUE(sample->shares_data());
   }
 }
 
@@ -118,6 +522,34 @@ TYPED_TEST(DataLoadStoreTest, TFRecordLoaderMmmap) {
   }
 }
 
+TYPED_TEST(DataLoadStoreTest, TFRecordLoaderParallelGlobalShuffle) {
+  std::vector<std::string> path = {testing::dali_extra_path() + "/db/tfrecord/train"};
+  std::vector<std::string> index_path = {testing::dali_extra_path() + "/db/tfrecord/train.idx"};
+  auto read = [&](int num_read_threads) {
+    IndexedFileLoader reader(OpSpec("TFRecordReader")
+                             .AddArg("path", path)
+                             .AddArg("index_path", index_path)
+                             .AddArg("max_batch_size", 32)
+                             .AddArg("device_id", 0)
+                             .AddArg("dont_use_mmap", true)
+                             .AddArg("global_shuffle", true)
+                             .AddArg("num_read_threads", num_read_threads));
+    reader.PrepareMetadata();
+    std::vector<std::shared_ptr<Tensor<CPUBackend>>> samples;
+    for (int i = 0; i < 64; i++)
+      samples.push_back(reader.ReadOne(i % 32 == 0));
+    reader.WaitForReads();
+    std::vector<std::vector<uint8_t>> data;
+    for (auto &sample : samples) {
+      auto *ptr = sample->data<uint8_t>();
+      data.emplace_back(ptr, ptr + sample->size());
+    }
+    return data;
+  };
+  // the records drawn at random are read in parallel, in the same order
+  EXPECT_EQ(read(4), read(1));
+}
+
 TYPED_TEST(DataLoadStoreTest, CocoLoaderMmmap) {
   for (bool dont_use_mmap : {true, false}) {
     std::string file_root = testing::dali_extra_path() + "/db/coco/images";
@@ -101,6 +101,11 @@ void NemoAsrLoader::Reset(bool wrap_to_shard) {
     std::mt19937 g(kDaliDataloaderSeed + current_epoch_);
     std::shuffle(shuffled_indices_.begin(), shuffled_indices_.end(), g);
   }
+  ShuffleSampleOrder();
+}
+
+double NemoAsrLoader::SampleSizeKey(Index index) {
+  return entries_[shuffled_indices_[index]].duration;
 }
 
 void NemoAsrLoader::PrepareEmpty(AsrSample &sample) {
@@ -140,7 +145,7 @@ void NemoAsrLoader::ReadAudio(SampleView<CPUBackend> audio,
 }
 
 void NemoAsrLoader::ReadSample(AsrSample& sample) {
-  auto &entry = entries_[shuffled_indices_[current_index_]];
+  auto &entry = entries_[shuffled_indices_[SampleIndex(current_index_)]];
 
   // handle wrap-around
   ++current_index_;
@@ -172,8 +177,11 @@ void NemoAsrLoader::ReadSample(AsrSample& sample) {
     // Audio decoding will be run in the prefetch function, once the batch is formed
     sample.decode_f_ = [this, &sample, &entry, offset](SampleView<CPUBackend> audio, int tid) {
       sample.decoder().OpenFromFile(entry.audio_filepath);
-      if (offset > 0)
-        sample.decoder().SeekFrames(offset);
+      if (offset > 0) {
+        auto pos = sample.decoder().SeekFrames(offset, SEEK_SET);
+        DALI_ENFORCE(pos == offset, make_string("Failed to seek to the frame ", offset,
+                                                " of ", entry.audio_filepath));
+      }
       ReadAudio<OutputType>(
         audio, sample.audio_meta_, entry, sample.decoder(),
         decode_scratch_[tid], resample_scratch_[tid]);
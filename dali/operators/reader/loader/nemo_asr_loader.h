@@ -134,6 +134,9 @@ class DLL_PUBLIC NemoAsrLoader : public Loader<CPUBackend, AsrSample> {
       DALI_FAIL("`shuffle_after_epoch` and `stick_to_shard` can't be provided together");
     if (shuffle_after_epoch_ && shuffle_)
       DALI_FAIL("`shuffle_after_epoch` and `random_shuffle` can't be provided together");
+    if (shuffle_after_epoch_ && bucket_by_size_)
+      DALI_FAIL("`shuffle_after_epoch` and `bucket_by_size` can't be provided together");
+    EnableBucketing();
     /*
      * Imply `stick_to_shard` from  `shuffle_after_epoch`
      */
@@ -155,6 +158,7 @@ class DLL_PUBLIC NemoAsrLoader : public Loader<CPUBackend, AsrSample> {
   void PrepareMetadataImpl() override;
   Index SizeImpl() override;
   void Reset(bool wrap_to_shard) override;
+  double SampleSizeKey(Index index) override;
 
  private:
   template <typename OutputType>
@@ -14,8 +14,14 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
+#include <fstream>
+#include <map>
 #include <memory>
+#include <sstream>
 
 #include "dali/core/common.h"
 #include "dali/operators/reader/loader/numpy_loader.h"
@@ -25,30 +31,168 @@
 namespace dali {
 namespace detail {
 
-bool NumpyHeaderCache::GetFromCache(const string &file_name, numpy::HeaderData &header) {
+namespace {
+
+constexpr const char kIndexHeader[] = "DALI numpy header cache 1";
+
+// the types supported by TypeFromNumpyStr
+constexpr const char *kNumpyTypes[] = {
+  "u1", "u2", "u4", "u8", "i1", "i2", "i4", "i8", "f2", "f4", "f8"
+};
+
+const char *NumpyTypeStr(DALIDataType type) {
+  for (const char *format : kNumpyTypes) {
+    if (TypeFromNumpyStr(format).id() == type)
+      return format;
+  }
+  return nullptr;
+}
+
+bool IsNumpyTypeStr(const string &type_str) {
+  return std::find(std::begin(kNumpyTypes), std::end(kNumpyTypes), type_str) !=
+         std::end(kNumpyTypes);
+}
+
+}  // namespace
+
+NumpyHeaderCache::NumpyHeaderCache(bool cache_headers, const string &index_path)
+    : cache_headers_(cache_headers || !index_path.empty()), index_path_(index_path) {
+  if (!index_path_.empty())
+    Load();
+}
+
+NumpyHeaderCache::~NumpyHeaderCache() {
+  try {
+    Save();
+  } catch (const std::exception &e) {
+    DALI_WARN("Cannot write the numpy header cache ", index_path_, ": ", e.what());
+  }
+}
+
+std::shared_ptr<NumpyHeaderCache> NumpyHeaderCache::Open(bool cache_headers,
+                                                         const string &index_path) {
+  if (index_path.empty())
+    return std::make_shared<NumpyHeaderCache>(cache_headers);
+  static std::mutex mtx;
+  static std::map<string, std::weak_ptr<NumpyHeaderCache>> instances;
+  std::lock_guard<std::mutex> guard(mtx);
+  auto &instance = instances[index_path];
+  auto cache = instance.lock();
+  if (!cache) {
+    cache = std::make_shared<NumpyHeaderCache>(true, index_path);
+    instance = cache;
+  }
+  return cache;
+}
+
+bool NumpyHeaderCache::GetFromCache(const string &file_name, numpy::HeaderData &header,
+                                    int64_t file_size) {
   if (!cache_headers_) {
     return false;
   }
   std::unique_lock<std::mutex> cache_lock(cache_mutex_);
   auto it = header_cache_.find(file_name);
-  if (it == header_cache_.end()) {
+  if (it == header_cache_.end() || it->second.file_size != file_size) {
     return false;
   } else {
-    header = it->second;
+    header = it->second.header;
     return true;
   }
 }
 
-void NumpyHeaderCache::UpdateCache(const string &file_name, const numpy::HeaderData &value) {
+void NumpyHeaderCache::UpdateCache(const string &file_name, const numpy::HeaderData &value,
+                                   int64_t file_size) {
   if (cache_headers_) {
     std::unique_lock<std::mutex> cache_lock(cache_mutex_);
-    header_cache_[file_name] = value;
+    header_cache_[file_name] = { value, file_size };
+    dirty_ = true;
   }
 }
 
+/*
+ * The index is a text file: a header line followed by a line per file:
+ * <file size> <numpy type string> <fortran order> <data offset> <ndim> <extents...> <path>
+ */
+void NumpyHeaderCache::Load() {
+  std::ifstream s(index_path_);
+  if (!s.is_open())
+    return;
+  string line;
+  if (!std::getline(s, line) || line != kIndexHeader) {
+    DALI_WARN("Ignoring the numpy header cache ", index_path_, " - unknown format");
+    return;
+  }
+  bool valid = true;
+  while (valid && std::getline(s, line)) {
+    std::istringstream ls(line);
+    Entry entry;
+    string type_str, path;
+    int fortran_order, ndim;
+    if (!(ls >> entry.file_size >> type_str >> fortran_order >> entry.header.data_offset >> ndim) ||
+        ndim < 0) {
+      valid = false;
+      break;
+    }
+    entry.header.fortran_order = fortran_order != 0;
+    entry.header.shape.resize(ndim);
+    for (int d = 0; d < ndim; d++)
+      ls >> entry.header.shape[d];
+    valid = ls && ls.get() == ' ' && std::getline(ls, path) && !path.empty() &&
+            IsNumpyTypeStr(type_str);
+    if (valid) {
+      entry.header.type_info = &TypeFromNumpyStr(type_str);
+      header_cache_[path] = std::move(entry);
+    }
+  }
+  if (!valid) {
+    DALI_WARN("Ignoring the numpy header cache ", index_path_, " - malformed entry: ", line);
+    header_cache_.clear();
+  }
+}
+
+void NumpyHeaderCache::Save() {
+  std::unique_lock<std::mutex> cache_lock(cache_mutex_);
+  if (index_path_.empty() || !dirty_)
+    return;
+  // written to a temporary file first, so that the jobs starting at once don't read it halfway
+  string tmp_path = make_string(index_path_, ".tmp.", getpid());
+  {
+    std::ofstream s(tmp_path);
+    DALI_ENFORCE(s.is_open(), make_string("Cannot open ", tmp_path, " for writing"));
+    s << kIndexHeader << "\n";
+    for (auto &e : header_cache_) {
+      auto &header = e.second.header;
+      const char *type_str = NumpyTypeStr(header.type());
+      if (!type_str || e.first.find('\n') != string::npos)
+        continue;
+      s << e.second.file_size << " " << type_str << " "
+        << header.fortran_order << " " << header.data_offset << " " << header.shape.size();
+      for (auto extent : header.shape)
+        s << " " << extent;
+      s << " " << e.first << "\n";
+    }
+    if (!s.good()) {
+      s.close();
+      std::remove(tmp_path.c_str());
+      DALI_FAIL(make_string("Cannot write ", tmp_path));
+    }
+  }
+  if (std::rename(tmp_path.c_str(), index_path_.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    DALI_FAIL(make_string("Cannot rename ", tmp_path, " to ", index_path_));
+  }
+  dirty_ = false;
+}
+
 }  // namespace detail
 
 void NumpyLoader::ReadSample(NumpyFileWrapper& target) {
+  auto read = PrepareRead(target);
+  if (read)
+    read(0);
+}
+
+NumpyLoader::ReadWork NumpyLoader::PrepareRead(NumpyFileWrapper& target) {
   auto filename = files_[current_index_++];
 
   // handle wrap-around
@@ -66,56 +210,60 @@ void NumpyLoader::ReadSample(NumpyFileWrapper& target) {
     target.data.SetMeta(meta);
     target.data.Resize({0}, DALI_UINT8);
     target.filename.clear();
-    return;
+    return {};
   }
 
-  auto path = filesystem::join_path(file_root_, filename);
-  auto current_file = FileStream::Open(path, read_ahead_, !copy_read_data_);
+  return [this, &target, filename = std::move(filename), meta](int) {
+    auto path = filesystem::join_path(file_root_, filename);
+    auto current_file = FileStream::Open(path, read_ahead_, !copy_read_data_, use_io_uring_,
+                                         use_o_direct_, read_policy_);
 
-  // read the header
-  numpy::HeaderData header;
-  auto ret = header_cache_.GetFromCache(filename, header);
-  try {
-    if (ret) {
-      current_file->SeekRead(header.data_offset);
-    } else {
-      numpy::ParseHeader(header, current_file.get());
-      header_cache_.UpdateCache(filename, header);
+    // read the header
+    numpy::HeaderData header;
+    int64_t file_size = current_file->Size();
+    auto ret = header_cache_->GetFromCache(path, header, file_size);
+    try {
+      if (ret) {
+        current_file->SeekRead(header.data_offset);
+      } else {
+        numpy::ParseHeader(header, current_file.get());
+        header_cache_->UpdateCache(path, header, file_size);
+      }
+    } catch (const std::runtime_error &e) {
+      DALI_FAIL(e.what() + ". File: " + filename);
     }
-  } catch (const std::runtime_error &e) {
-    DALI_FAIL(e.what() + ". File: " + filename);
-  }
 
-  Index nbytes = header.nbytes();
+    Index nbytes = header.nbytes();
 
-  if (copy_read_data_) {
-    if (target.data.shares_data()) {
-      target.data.Reset();
+    if (copy_read_data_) {
+      if (target.data.shares_data()) {
+        target.data.Reset();
+      }
+      target.data.Resize(header.shape, header.type());
+      // copy the image
+      Index ret = current_file->Read(static_cast<uint8_t*>(target.data.raw_mutable_data()),
+                                      nbytes);
+      DALI_ENFORCE(ret == nbytes, make_string("Failed to read file: ", filename));
+    } else {
+      auto p = current_file->Get(nbytes);
+      DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", filename));
+      // Wrap the raw data in the Tensor object.
+      target.data.ShareData(p, nbytes, false, {nbytes}, header.type(), CPU_ONLY_DEVICE_ID);
+      target.data.Resize(header.shape, header.type());
     }
-    target.data.Resize(header.shape, header.type());
-    // copy the image
-    Index ret = current_file->Read(static_cast<uint8_t*>(target.data.raw_mutable_data()),
-                                    nbytes);
-    DALI_ENFORCE(ret == nbytes, make_string("Failed to read file: ", filename));
-  } else {
-    auto p = current_file->Get(nbytes);
-    DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", filename));
-    // Wrap the raw data in the Tensor object.
-    target.data.ShareData(p, nbytes, false, {nbytes}, header.type(), CPU_ONLY_DEVICE_ID);
-    target.data.Resize(header.shape, header.type());
-  }
 
-  // close the file handle
-  current_file->Close();
+    // close the file handle
+    current_file->Close();
 
-  // set metadata
-  target.data.SetMeta(meta);
+    // set metadata
+    target.data.SetMeta(meta);
 
-  // set file path
-  target.filename = std::move(path);
+    // set file path
+    target.filename = std::move(path);
 
-  // set meta
-  target.fortran_order = header.fortran_order;
+    // set meta
+    target.fortran_order = header.fortran_order;
+  };
 }
 
 }  // namespace dali
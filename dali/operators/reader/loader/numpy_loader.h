@@ -28,6 +28,7 @@
 #include <map>
 #include <regex>
 #include <memory>
+#include <mutex>
 
 #include "dali/core/common.h"
 #include "dali/pipeline/data/types.h"
@@ -59,17 +60,49 @@ struct NumpyFileWrapper {
 
 namespace detail {
 
-class NumpyHeaderCache {
+/**
+ * @brief Caches the parsed headers of the numpy files
+ *
+ * When backed by an index file, the cache is loaded from it, shared by all the readers
+ * (CPU and GPU) of the process using the same file, and written back when the last of them
+ * is destroyed. The entries are validated with the size of the file.
+ */
+class DLL_PUBLIC NumpyHeaderCache {
  public:
-  explicit NumpyHeaderCache(bool cache_headers) : cache_headers_(cache_headers) {}
-  bool GetFromCache(const string &file_name, numpy::HeaderData &target);
-  void UpdateCache(const string &file_name, const numpy::HeaderData &value);
+  explicit NumpyHeaderCache(bool cache_headers, const string &index_path = {});
+  ~NumpyHeaderCache();
+
+  NumpyHeaderCache(const NumpyHeaderCache &) = delete;
+  NumpyHeaderCache &operator=(const NumpyHeaderCache &) = delete;
+
+  /**
+   * @brief Returns the cache for the reader - shared one if `index_path` is not empty
+   */
+  static std::shared_ptr<NumpyHeaderCache> Open(bool cache_headers, const string &index_path);
+
+  bool GetFromCache(const string &file_name, numpy::HeaderData &target, int64_t file_size = -1);
+  void UpdateCache(const string &file_name, const numpy::HeaderData &value,
+                   int64_t file_size = -1);
+
+  /**
+   * @brief Writes the new entries to the index file, if there are any
+   */
+  void Save();
 
  private:
+  struct Entry {
+    numpy::HeaderData header;
+    int64_t file_size;
+  };
+
+  void Load();
+
   // helper for header caching
   std::mutex cache_mutex_;
   bool cache_headers_;
-  std::map<string, numpy::HeaderData> header_cache_;
+  string index_path_;
+  bool dirty_ = false;
+  std::map<string, Entry> header_cache_;
 };
 
 }  // namespace detail
@@ -80,7 +113,9 @@ class NumpyLoader : public FileLoader<CPUBackend, NumpyFileWrapper> {
     const OpSpec& spec,
     bool shuffle_after_epoch = false)
     : FileLoader(spec, shuffle_after_epoch),
-    header_cache_(spec.GetArgument<bool>("cache_header_information")) {}
+    header_cache_(detail::NumpyHeaderCache::Open(
+        spec.GetArgument<bool>("cache_header_information"),
+        spec.GetArgument<string>("header_cache_file"))) {}
 
   void PrepareEmpty(NumpyFileWrapper &target) override {
     target = {};
@@ -89,8 +124,11 @@ class NumpyLoader : public FileLoader<CPUBackend, NumpyFileWrapper> {
   // we want to make it possible to override this function as well
   void ReadSample(NumpyFileWrapper& target) override;
 
+ protected:
+  ReadWork PrepareRead(NumpyFileWrapper& target) override;
+
  private:
-  detail::NumpyHeaderCache header_cache_;
+  std::shared_ptr<detail::NumpyHeaderCache> header_cache_;
 };
 
 }  // namespace dali
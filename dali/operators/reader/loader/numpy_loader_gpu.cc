@@ -32,13 +32,14 @@ void NumpyFileWrapperGPU::Reopen() {
 
 void NumpyFileWrapperGPU::ReadHeader(detail::NumpyHeaderCache &cache) {
   numpy::HeaderData header;
-  bool ret = cache.GetFromCache(filename, header);
+  int64_t file_size = file_stream->Size();
+  bool ret = cache.GetFromCache(filename, header, file_size);
   try {
     if (ret) {
       file_stream->SeekRead(header.data_offset);
     } else {
       numpy::ParseHeader(header, file_stream.get());
-      cache.UpdateCache(filename, header);
+      cache.UpdateCache(filename, header, file_size);
     }
   } catch (const std::runtime_error &e) {
     DALI_FAIL(e.what() + ". File: " + filename);
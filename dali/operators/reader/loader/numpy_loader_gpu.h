@@ -51,6 +51,11 @@ struct NumpyFileWrapperGPU {
   DALIMeta meta;
   int source_sample_idx = -1;
 
+  /// The first row (along the outermost dimension of the array in the file), which is read
+  int64_t read_row_start = 0;
+  /// The number of rows read; negative when the whole array is read
+  int64_t read_rows = -1;
+
   std::unique_ptr<CUFileStream> file_stream;
   bool read_ahead = false;
 
@@ -64,6 +69,16 @@ struct NumpyFileWrapperGPU {
     return shape;
   }
 
+  /**
+   * @brief The shape of the part of the array which is read
+   */
+  TensorShape<> get_read_shape() const {
+    TensorShape<> sh = shape;
+    if (read_rows >= 0)
+      sh[0] = read_rows;
+    return sh;
+  }
+
   DALIDataType get_type() const {
     return type;
   }
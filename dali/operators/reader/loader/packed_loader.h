@@ -0,0 +1,77 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_PACKED_LOADER_H_
+#define DALI_OPERATORS_READER_LOADER_PACKED_LOADER_H_
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/core/error_handling.h"
+#include "dali/operators/reader/loader/indexed_file_loader.h"
+
+namespace dali {
+
+/**
+ * @brief Reads the samples of the DALI packed format, created with `tools/dali_pack.py`
+ *
+ * The samples start at multiples of the alignment given in the index, so that they can be read
+ * with O_DIRECT. A sample is a PackedSampleHeader (see packed_parser.h) followed by the data.
+ */
+class PackedLoader : public IndexedFileLoader {
+ public:
+  explicit PackedLoader(const OpSpec& options)
+    : IndexedFileLoader(options) {
+  }
+
+  void ReadIndexFile(const std::vector<std::string>& index_uris) override {
+    DALI_ENFORCE(index_uris.size() == uris_.size(),
+        "Number of index files needs to match the number of data files");
+    for (size_t i = 0; i < index_uris.size(); ++i) {
+      std::ifstream fin(index_uris[i]);
+      DALI_ENFORCE(fin.good(), "Failed to open file " + index_uris[i]);
+      std::string magic, version;
+      int64 alignment = 0, num_samples = -1;
+      fin >> magic >> version >> alignment >> num_samples;
+      DALI_ENFORCE(magic == kIndexMagic && version == kIndexVersion,
+          make_string("Unsupported packed dataset index: \"", index_uris[i], "\". Expected a ",
+                      kIndexMagic, " ", kIndexVersion, " index, created with `dali_pack`."));
+      DALI_ENFORCE(alignment > 0 && num_samples >= 0,
+          make_string("Invalid header of the packed dataset index: \"", index_uris[i], "\"."));
+      int64 offset, size, label;
+      int64 n = 0;
+      while (fin >> offset >> size >> label) {
+        DALI_ENFORCE(offset % alignment == 0,
+            make_string("The sample at ", offset, " in \"", uris_[i], "\" is not aligned to ",
+                        alignment, " bytes, as stated in the index."));
+        indices_.emplace_back(offset, size, i);
+        n++;
+      }
+      DALI_ENFORCE(n == num_samples,
+          make_string("The packed dataset index \"", index_uris[i], "\" lists ", n,
+                      " samples, while its header states ", num_samples, "."));
+    }
+  }
+
+ private:
+  static constexpr const char *kIndexMagic = "DALI_PACKED";
+  static constexpr const char *kIndexVersion = "v1";
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_PACKED_LOADER_H_
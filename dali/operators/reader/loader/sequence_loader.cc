@@ -15,6 +15,10 @@
 #include <glob.h>
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "dali/core/common.h"
 #include "dali/image/image.h"
 #include "dali/operators/reader/loader/sequence_loader.h"
@@ -34,9 +38,9 @@ std::string parent_dir(const std::string &path) {
 
 namespace filesystem {
 
-std::vector<Stream> GatherExtractedStreams(const string &file_root) {
+std::vector<Stream> GatherExtractedStreams(const string &file_root, const string &file_filter) {
   glob_t glob_buff;
-  std::string glob_pattern = file_root + "/*/*";
+  std::string glob_pattern = file_root + "/*/" + file_filter;
   const int glob_flags = 0;
   int glob_ret = glob(glob_pattern.c_str(), glob_flags, nullptr, &glob_buff);
   DALI_ENFORCE(glob_ret == 0,
@@ -69,24 +73,44 @@ std::vector<Stream> GatherExtractedStreams(const string &file_root) {
 
 namespace detail {
 
-std::vector<std::vector<std::string>> GenerateSequences(
+std::vector<std::vector<Index>> GenerateSequenceFrames(
     const std::vector<filesystem::Stream> &streams, size_t sequence_length, size_t step,
     size_t stride) {
-  std::vector<std::vector<std::string>> sequences;
+  std::vector<std::vector<Index>> sequences;
+  Index stream_start = 0;
   for (const auto &s : streams) {
     for (size_t i = 0; i < s.second.size(); i += step) {
-      std::vector<std::string> sequence;
-      sequence.reserve(sequence_length);
       // this sequence won't fit
       if (i + (sequence_length - 1) * stride >= s.second.size()) {
         break;
       }
       // fill the sequence
+      std::vector<Index> sequence;
+      sequence.reserve(sequence_length);
       for (size_t seq_elem = 0; seq_elem < sequence_length; seq_elem++) {
-        sequence.push_back(s.second[i + seq_elem * stride]);
+        sequence.push_back(stream_start + i + seq_elem * stride);
       }
-      sequences.push_back((sequence));
+      sequences.push_back(std::move(sequence));
     }
+    stream_start += s.second.size();
+  }
+  return sequences;
+}
+
+std::vector<std::vector<std::string>> GenerateSequences(
+    const std::vector<filesystem::Stream> &streams, size_t sequence_length, size_t step,
+    size_t stride) {
+  std::vector<const std::string *> frames;
+  for (const auto &s : streams)
+    for (const auto &f : s.second)
+      frames.push_back(&f);
+  std::vector<std::vector<std::string>> sequences;
+  for (const auto &frame_indices : GenerateSequenceFrames(streams, sequence_length, step, stride)) {
+    std::vector<std::string> sequence;
+    sequence.reserve(sequence_length);
+    for (Index frame : frame_indices)
+      sequence.push_back(*frames[frame]);
+    sequences.push_back(std::move(sequence));
   }
   return sequences;
 }
@@ -100,57 +124,84 @@ void SequenceLoader::PrepareEmpty(TensorSequence &sequence) {
   }
 }
 
-void SequenceLoader::ReadSample(TensorSequence &sequence) {
-  // TODO(klecki) this is written as a prototype for video handling
-  const auto &sequence_paths = sequences_[current_sequence_];
-  // TODO(klecki) we probably should buffer the "stream", or recently used
-  // frames
+void SequenceLoader::PrepareReads(TensorSequence &sequence, std::vector<ReadWork> &works) {
+  const auto &frame_indices = sequences_[current_index_];
+  frames_.resize(sequence_length_);
   for (int i = 0; i < sequence_length_; i++) {
-    LoadFrame(sequence_paths, i, &sequence.tensors[i]);
+    if (auto work = LoadFrame(frame_indices[i], sequence.tensors[i], frames_[i]))
+      works.push_back(std::move(work));
   }
-  current_sequence_++;
+  std::swap(prev_frames_, frames_);
+  current_index_++;
   // wrap-around
-  MoveToNextShard(current_sequence_);
+  MoveToNextShard(current_index_);
+}
+
+void SequenceLoader::ReadSample(TensorSequence &sequence) {
+  std::vector<ReadWork> works;
+  PrepareReads(sequence, works);
+  for (auto &work : works)
+    work(0);
 }
 
 Index SequenceLoader::SizeImpl() {
-  return total_size_;
+  return sequences_.size();
 }
 
-void SequenceLoader::LoadFrame(const std::vector<std::string> &s, Index frame_idx,
-                               Tensor<CPUBackend> *target) {
-  const auto frame_filename = s[frame_idx];
+Loader<CPUBackend, TensorSequence>::ReadWork SequenceLoader::LoadFrame(
+    Index frame_idx, Tensor<CPUBackend> &target, Frame &frame) {
+  const auto &frame_filename = files_[frame_idx];
   DALIMeta meta;
   meta.SetSourceInfo(frame_filename);
   meta.SetSkipSample(false);
+  frame = {};
 
   // if image is cached, skip loading
   if (ShouldSkipImage(frame_filename)) {
     meta.SetSkipSample(true);
-    target->Reset();
-    target->SetMeta(meta);
-    target->Resize({0}, DALI_UINT8);
-    return;
+    target.Reset();
+    target.SetMeta(meta);
+    target.Resize({0}, DALI_UINT8);
+    return {};
+  }
+
+  // the overlapping sequences share the frames
+  auto prev = std::find_if(prev_frames_.begin(), prev_frames_.end(),
+                           [&](const Frame &f) { return f.index == frame_idx; });
+  if (prev != prev_frames_.end()) {
+    frame = *prev;
+    target.ShareData(frame.data, frame.size, false, {frame.size}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
+    target.SetMeta(meta);
+    return {};
   }
 
-  auto frame = FileStream::Open(frame_filename, read_ahead_, !copy_read_data_);
-  Index frame_size = frame->Size();
-  // Release and unmap memory previously obtained by Get call
+  std::shared_ptr<FileStream> stream = FileStream::Open(frame_filename, read_ahead_,
+                                                        !copy_read_data_, use_io_uring_,
+                                                        use_o_direct_, read_policy_);
+  frame.index = frame_idx;
+  frame.size = stream->Size();
+  ReadWork work;
   if (copy_read_data_) {
-    if (target->shares_data()) {
-      target->Reset();
-    }
-    target->Resize({frame_size}, DALI_UINT8);
-    Index ret = frame->Read(target->mutable_data<uint8_t>(), frame_size);
-    DALI_ENFORCE(ret == frame_size, make_string("Failed to read file: ", frame_filename));
+    // The buffer is allocated here, so that the next sequence can share it, and filled
+    // by the work, in one of the I/O threads.
+    frame.data = std::shared_ptr<uint8_t>(new uint8_t[frame.size],
+                                          std::default_delete<uint8_t[]>());
+    auto *dst = static_cast<uint8_t *>(frame.data.get());
+    Index size = frame.size;
+    work = [stream, dst, size, frame_filename](int) {
+      Index ret = stream->Read(dst, size);
+      DALI_ENFORCE(ret == size, make_string("Failed to read file: ", frame_filename));
+      stream->Close();
+    };
   } else {
-    auto p = frame->Get(frame_size);
-    DALI_ENFORCE(p != nullptr, make_string("Failed to read file: ", frame_filename));
-    // Wrap the raw data in the Tensor object.
-    target->ShareData(p, frame_size, false, {frame_size}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
+    frame.data = stream->Get(frame.size);
+    DALI_ENFORCE(frame.data != nullptr, make_string("Failed to read file: ", frame_filename));
+    stream->Close();
   }
-  target->SetMeta(meta);
-  frame->Close();
+  // Wrap the raw data in the Tensor object.
+  target.ShareData(frame.data, frame.size, false, {frame.size}, DALI_UINT8, CPU_ONLY_DEVICE_ID);
+  target.SetMeta(meta);
+  return work;
 }
 
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2018-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,13 +15,14 @@
 #ifndef DALI_OPERATORS_READER_LOADER_SEQUENCE_LOADER_H_
 #define DALI_OPERATORS_READER_LOADER_SEQUENCE_LOADER_H_
 
+#include <memory>
 #include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "dali/core/common.h"
-#include "dali/operators/reader/loader/loader.h"
+#include "dali/operators/reader/loader/file_loader.h"
 #include "dali/util/file.h"
 
 namespace dali {
@@ -56,9 +57,11 @@ using Stream = std::pair<std::string, std::vector<std::string>>;
  *     ....
  *
  * @param file_root
+ * @param file_filter glob pattern the names of the frame files must match
  * @return std::vector<Stream> GatherExtractedStreams
  */
-std::vector<Stream> DLL_PUBLIC GatherExtractedStreams(const string &file_root);
+std::vector<Stream> DLL_PUBLIC GatherExtractedStreams(const string &file_root,
+                                                      const string &file_filter = "*");
 
 }  // namespace filesystem
 
@@ -71,48 +74,52 @@ namespace detail {
 std::vector<std::vector<std::string>> DLL_PUBLIC
 GenerateSequences(const std::vector<filesystem::Stream> &streams, size_t sequence_length,
                   size_t step, size_t stride);
+
+/**
+ * @brief Like GenerateSequences, but the frames are given by their indices in the frames
+ *        of all the streams, concatenated.
+ */
+std::vector<std::vector<Index>> DLL_PUBLIC
+GenerateSequenceFrames(const std::vector<filesystem::Stream> &streams, size_t sequence_length,
+                       size_t step, size_t stride);
 }  // namespace detail
 
 struct TensorSequence {
   std::vector<Tensor<CPUBackend>> tensors;
 };
 
-// TODO(klecki) consider using FileLoader as base class
-// TODO(klecki) ?? allow for more high level grouping of sequences:
-//              we should probably make sure that other Loaders read
-//              sequentially, and allow for SequenceLoader to wrap any other
-//              loader, similar for parser and reader
-// TODO(klecki) loader is responsible for handling shuffle_
-class SequenceLoader : public Loader<CPUBackend, TensorSequence> {
+/**
+ * @brief Reads the sequences of frames, stored as separate image files
+ *
+ * The frames of a sequence are read concurrently, as separate works of the I/O threads
+ * (see `num_read_threads`). The frames shared with the previous sequence (when `step` is less
+ * than the span of a sequence) are not read again - the sequences share their data.
+ */
+class SequenceLoader : public FileLoader<CPUBackend, TensorSequence> {
  public:
   explicit SequenceLoader(const OpSpec &spec)
-      : Loader(spec),
-        file_root_(spec.GetArgument<string>("file_root")),
+      : FileLoader(spec),
         sequence_length_(spec.GetArgument<int32_t>("sequence_length")),
         step_(spec.GetArgument<int32_t>("step")),
-        stride_(spec.GetArgument<int32_t>("stride")),
-        total_size_(0),
-        current_sequence_(0) {
+        stride_(spec.GetArgument<int32_t>("stride")) {
   }
 
   void PrepareEmpty(TensorSequence &tensor) override;
   void ReadSample(TensorSequence &tensor) override;
+  void PrepareReads(TensorSequence &tensor, std::vector<ReadWork> &works) override;
 
  protected:
   Index SizeImpl() override;
 
   void PrepareMetadataImpl() override {
-    streams_ = filesystem::GatherExtractedStreams(file_root_);
-    sequences_ = detail::GenerateSequences(streams_, sequence_length_, step_, stride_);
-    total_size_ = sequences_.size();
     DALI_ENFORCE(sequence_length_ > 0, "Sequence length must be positive");
     DALI_ENFORCE(step_ > 0, "Step must be positive");
     DALI_ENFORCE(stride_ > 0, "Stride must be positive");
-    if (!dont_use_mmap_) {
-      mmap_reserver_ = FileStream::MappingReserver(
-                                  static_cast<unsigned int>(initial_buffer_fill_));
-    }
-    copy_read_data_ = dont_use_mmap_ || !mmap_reserver_.CanShareMappedData();
+    auto streams = filesystem::GatherExtractedStreams(file_root_, file_filter_);
+    files_.clear();
+    for (auto &s : streams)
+      files_.insert(files_.end(), s.second.begin(), s.second.end());
+    sequences_ = detail::GenerateSequenceFrames(streams, sequence_length_, step_, stride_);
     if (shuffle_) {
       // TODO(spanev) decide of a policy for multi-gpu here
       // seeded with hardcoded value to get
@@ -124,27 +131,25 @@ class SequenceLoader : public Loader<CPUBackend, TensorSequence> {
   }
 
  private:
-  void Reset(bool wrap_to_shard) override {
-    if (wrap_to_shard) {
-      current_sequence_ = start_index(shard_id_, num_shards_, SizeImpl());
-    } else {
-      current_sequence_ = 0;
-    }
-  }
-  // TODO(klecki) For now sequence is <directory, image list> pair, later it
-  // will be a video file
+  struct Frame {
+    Index index = -1;
+    std::shared_ptr<void> data;
+    Index size = 0;
+  };
+
+  /**
+   * @brief Prepares the tensor of a frame; if the data needs to be read, returns the work
+   *        reading it.
+   */
+  ReadWork LoadFrame(Index frame_idx, Tensor<CPUBackend> &target, Frame &frame);
 
-  string file_root_;
   int32_t sequence_length_;
   int32_t step_;
   int32_t stride_;
-  std::vector<filesystem::Stream> streams_;
-  std::vector<std::vector<std::string>> sequences_;
-  Index total_size_;
-  Index current_sequence_;
-  FileStream::MappingReserver mmap_reserver_;
-
-  void LoadFrame(const std::vector<std::string> &s, Index frame, Tensor<CPUBackend> *target);
+  /// The frames of the sequences, as the indices in files_
+  std::vector<std::vector<Index>> sequences_;
+  /// The frames of the previously read sequence, reused by the next one
+  std::vector<Frame> prev_frames_, frames_;
 };
 
 }  // namespace dali
@@ -49,6 +49,18 @@ TEST(GatherExtractedStreamsTest, LoadTestDir) {
   }
 }
 
+TEST(GatherExtractedStreamsTest, FileFilter) {
+  const auto frames_dir = testing::dali_extra_path() + "/db/sequence/frames";
+  auto result = filesystem::GatherExtractedStreams(frames_dir, "0000[1-4].png");
+  ASSERT_EQ(result.size(), 2);
+  for (auto &stream : result) {
+    ASSERT_EQ(stream.second.size(), 4);
+    for (int i = 0; i < 4; i++) {
+      ASSERT_EQ(stream.second[i], stream.first + print_frame_num(i + 1) + ".png");
+    }
+  }
+}
+
 TEST(GenerateSequencesTest, Test) {
   std::vector<filesystem::Stream> zero_stream = {{"/0", {}}};
   auto zero_length_1 = detail::GenerateSequences(zero_stream, 1, 1, 1);
@@ -88,4 +100,20 @@ TEST(GenerateSequencesTest, Test) {
   ASSERT_EQ(seq_2_2_2, exp_2_2_2);
 }
 
+TEST(GenerateSequenceFramesTest, Test) {
+  std::vector<filesystem::Stream> test_streams = {
+      {"/0", {"/0/00.png", "/0/01.png", "/0/02.png", "/0/03.png", "/0/04.png", "/0/05.png"}},
+      {"/1", {"/1/00.png", "/1/01.png", "/1/02.png", "/1/03.png"}}};
+
+  // the frames of the second stream follow the frames of the first one
+  auto seq_2_2_2 = detail::GenerateSequenceFrames(test_streams, 2, 2, 2);
+  auto exp_2_2_2 = std::vector<std::vector<Index>>{{0, 2}, {2, 4}, {6, 8}};
+  ASSERT_EQ(seq_2_2_2, exp_2_2_2);
+
+  auto seq_3_1_1 = detail::GenerateSequenceFrames(test_streams, 3, 1, 1);
+  auto exp_3_1_1 = std::vector<std::vector<Index>>{
+      {0, 1, 2}, {1, 2, 3}, {2, 3, 4}, {3, 4, 5}, {6, 7, 8}, {7, 8, 9}};
+  ASSERT_EQ(seq_3_1_1, exp_3_1_1);
+}
+
 }  // namespace dali
@@ -0,0 +1,432 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "dali/core/format.h"
+#include "dali/operators/reader/loader/shared_sample_cache.h"
+
+namespace dali {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x48434143494c4144;  // "DALICACH"
+constexpr uint32_t kVersion = 1;
+constexpr uint32_t kReady = 1;
+// how long to wait for another process to initialize the cache
+constexpr auto kInitTimeout = std::chrono::seconds(30);
+
+std::string ShmName(const std::string &name) {
+  DALI_ENFORCE(!name.empty() && name.find('/') == std::string::npos, make_string(
+      "Invalid shared cache name: \"", name, "\". It must be non-empty and cannot contain '/'."));
+  return "/" + name;
+}
+
+// FNV-1a - unlike std::hash, it's guaranteed to be the same in all the processes
+uint64_t Hash(const std::string &key) {
+  uint64_t h = 0xcbf29ce484222325;
+  for (unsigned char c : key) {
+    h ^= c;
+    h *= 0x100000001b3;
+  }
+  return h;
+}
+
+size_t AlignUp(size_t x, size_t alignment) {
+  return (x + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+struct SharedSampleCache::Header {
+  uint64_t magic;
+  uint32_t version;
+  std::atomic<uint32_t> state;
+  uint64_t total_size;
+  uint64_t page_size;
+  uint64_t num_pages;    // also the maximum number of entries
+  uint64_t num_buckets;  // a power of 2
+  uint64_t entries_offset, buckets_offset, page_next_offset, pages_offset;
+
+  pthread_mutex_t mutex;
+  int64_t lru_head;  // the most recently used entry
+  int64_t lru_tail;  // the least recently used entry
+  int64_t free_pages;
+  uint64_t num_free_pages;
+  int64_t free_entries;
+  Stats stats;
+};
+
+struct SharedSampleCache::Entry {
+  uint64_t hash;
+  uint64_t key_size;
+  uint64_t data_size;
+  uint64_t num_pages;
+  int64_t first_page;
+  int64_t lru_prev, lru_next;
+  int64_t hash_next;  // the next entry in the bucket or in the free list
+};
+
+class SharedSampleCache::Lock {
+ public:
+  explicit Lock(SharedSampleCache &cache) : mutex_(&cache.header_->mutex) {
+    int ret = pthread_mutex_lock(mutex_);
+    if (ret == EOWNERDEAD) {
+      // the owner died, possibly in the middle of an update - the contents can't be trusted
+      pthread_mutex_consistent(mutex_);
+      cache.Clear();
+    } else if (ret != 0) {
+      DALI_FAIL(make_string("Failed to lock the shared sample cache: ", strerror(ret)));
+    }
+  }
+
+  ~Lock() {
+    pthread_mutex_unlock(mutex_);
+  }
+
+ private:
+  pthread_mutex_t *mutex_;
+};
+
+SharedSampleCache::SharedSampleCache(const std::string &name, size_t capacity, size_t page_size)
+    : name_(ShmName(name)) {
+  DALI_ENFORCE(page_size > 0, "The page size of the shared sample cache must be positive.");
+  DALI_ENFORCE(capacity >= page_size, make_string("The capacity of the shared sample cache (",
+               capacity, " B) must be at least one page (", page_size, " B)."));
+  handle_ = ShmHandle(shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR));
+  if (handle_) {
+    try {
+      Create(capacity, page_size);
+    } catch (...) {
+      shm_unlink(name_.c_str());
+      throw;
+    }
+  } else {
+    if (errno != EEXIST)
+      POSIX_CHECK_STATUS_EX(-1, "shm_open", name);
+    handle_ = ShmHandle(shm_open(name_.c_str(), O_RDWR, 0));
+    POSIX_CHECK_STATUS_EX(handle_, "shm_open", name);
+    OpenExisting();
+  }
+}
+
+SharedSampleCache::~SharedSampleCache() = default;
+
+void SharedSampleCache::Create(size_t capacity, size_t page_size) {
+  uint64_t num_pages = capacity / page_size;
+  uint64_t num_buckets = 1;
+  while (num_buckets < num_pages)
+    num_buckets <<= 1;
+
+  size_t entries_offset = AlignUp(sizeof(Header), 64);
+  size_t buckets_offset = AlignUp(entries_offset + num_pages * sizeof(Entry), 64);
+  size_t page_next_offset = AlignUp(buckets_offset + num_buckets * sizeof(int64_t), 64);
+  size_t pages_offset = AlignUp(page_next_offset + num_pages * sizeof(int64_t), 4096);
+  size_t total_size = pages_offset + num_pages * page_size;
+
+  POSIX_CALL_EX(ftruncate(handle_, total_size), "Failed to resize the shared sample cache.");
+  mapping_ = MemoryMapping(handle_, total_size);
+  header_ = reinterpret_cast<Header *>(mapping_.get_raw_ptr());
+  header_->magic = kMagic;
+  header_->version = kVersion;
+  header_->total_size = total_size;
+  header_->page_size = page_size;
+  header_->num_pages = num_pages;
+  header_->num_buckets = num_buckets;
+  header_->entries_offset = entries_offset;
+  header_->buckets_offset = buckets_offset;
+  header_->page_next_offset = page_next_offset;
+  header_->pages_offset = pages_offset;
+
+  pthread_mutexattr_t attr;
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+  pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+  int ret = pthread_mutex_init(&header_->mutex, &attr);
+  pthread_mutexattr_destroy(&attr);
+  DALI_ENFORCE(ret == 0, make_string("Failed to initialize the shared sample cache lock: ",
+                                     strerror(ret)));
+
+  SetPointers();
+  Clear();
+  header_->state.store(kReady, std::memory_order_release);
+}
+
+void SharedSampleCache::OpenExisting() {
+  auto deadline = std::chrono::steady_clock::now() + kInitTimeout;
+  auto wait = [&](const char *what) {
+    DALI_ENFORCE(std::chrono::steady_clock::now() < deadline, make_string(
+        "Timed out waiting for the shared sample cache \"", name_, "\" ", what, ". If the process "
+        "which created it has died, remove it from /dev/shm."));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  };
+
+  // the creator may not have resized the object yet
+  struct stat st;
+  for (;;) {
+    POSIX_CALL(fstat(handle_, &st));
+    if (static_cast<size_t>(st.st_size) >= sizeof(Header))
+      break;
+    wait("to be created");
+  }
+  mapping_ = MemoryMapping(handle_, sizeof(Header));
+  header_ = reinterpret_cast<Header *>(mapping_.get_raw_ptr());
+  while (header_->state.load(std::memory_order_acquire) != kReady)
+    wait("to be initialized");
+  DALI_ENFORCE(header_->magic == kMagic && header_->version == kVersion, make_string(
+      "\"", name_, "\" is not a shared sample cache or was created by an incompatible version."));
+
+  // the object is resized before it's marked as ready
+  size_t total_size = header_->total_size;
+  POSIX_CALL(fstat(handle_, &st));
+  DALI_ENFORCE(static_cast<size_t>(st.st_size) == total_size,
+               make_string("The shared sample cache \"", name_, "\" is corrupted."));
+  mapping_ = MemoryMapping(handle_, total_size);
+  header_ = reinterpret_cast<Header *>(mapping_.get_raw_ptr());
+  SetPointers();
+}
+
+void SharedSampleCache::SetPointers() {
+  uint8_t *base = mapping_.get_raw_ptr();
+  entries_ = reinterpret_cast<Entry *>(base + header_->entries_offset);
+  buckets_ = reinterpret_cast<int64_t *>(base + header_->buckets_offset);
+  page_next_ = reinterpret_cast<int64_t *>(base + header_->page_next_offset);
+  pages_ = base + header_->pages_offset;
+}
+
+std::shared_ptr<SharedSampleCache> SharedSampleCache::Open(const std::string &name,
+                                                           size_t capacity) {
+  static std::mutex mtx;
+  static std::map<std::string, std::weak_ptr<SharedSampleCache>> instances;
+  std::lock_guard<std::mutex> guard(mtx);
+  auto &instance = instances[name];
+  auto cache = instance.lock();
+  if (!cache) {
+    cache = std::make_shared<SharedSampleCache>(name, capacity);
+    instance = cache;
+  }
+  return cache;
+}
+
+void SharedSampleCache::Remove(const std::string &name) {
+  if (shm_unlink(ShmName(name).c_str()) != 0 && errno != ENOENT)
+    POSIX_CHECK_STATUS_EX(-1, "shm_unlink", name);
+}
+
+void SharedSampleCache::Clear() {
+  for (uint64_t b = 0; b < header_->num_buckets; b++)
+    buckets_[b] = -1;
+  int64_t n = header_->num_pages;
+  for (int64_t i = 0; i < n; i++) {
+    page_next_[i] = i + 1 < n ? i + 1 : -1;
+    entries_[i].hash_next = i + 1 < n ? i + 1 : -1;
+  }
+  header_->free_pages = 0;
+  header_->num_free_pages = n;
+  header_->free_entries = 0;
+  header_->lru_head = header_->lru_tail = -1;
+  header_->stats = {};
+}
+
+template <typename Chunk>
+void SharedSampleCache::VisitChunks(int64_t page, size_t offset, size_t size,
+                                    Chunk &&chunk) const {
+  size_t page_size = header_->page_size;
+  for (; offset >= page_size; offset -= page_size)
+    page = page_next_[page];
+  while (size > 0) {
+    size_t n = std::min(size, page_size - offset);
+    chunk(pages_ + page * page_size + offset, n);
+    size -= n;
+    offset = 0;
+    page = page_next_[page];
+  }
+}
+
+bool SharedSampleCache::KeyEquals(const Entry &entry, const std::string &key) const {
+  if (entry.key_size != key.size())
+    return false;
+  bool equal = true;
+  const char *k = key.data();
+  VisitChunks(entry.first_page, 0, key.size(), [&](const uint8_t *ptr, size_t n) {
+    equal = equal && !memcmp(ptr, k, n);
+    k += n;
+  });
+  return equal;
+}
+
+int64_t SharedSampleCache::Find(const std::string &key, uint64_t hash) const {
+  int64_t e = buckets_[hash & (header_->num_buckets - 1)];
+  for (; e >= 0; e = entries_[e].hash_next) {
+    if (entries_[e].hash == hash && KeyEquals(entries_[e], key))
+      break;
+  }
+  return e;
+}
+
+void SharedSampleCache::Touch(int64_t e) {
+  Entry &entry = entries_[e];
+  if (header_->lru_head == e)
+    return;
+  // unlink...
+  entries_[entry.lru_prev].lru_next = entry.lru_next;
+  if (entry.lru_next >= 0)
+    entries_[entry.lru_next].lru_prev = entry.lru_prev;
+  else
+    header_->lru_tail = entry.lru_prev;
+  // ...and move to the front
+  entry.lru_prev = -1;
+  entry.lru_next = header_->lru_head;
+  entries_[header_->lru_head].lru_prev = e;
+  header_->lru_head = e;
+}
+
+void SharedSampleCache::Evict(int64_t e) {
+  Entry &entry = entries_[e];
+  int64_t *link = &buckets_[entry.hash & (header_->num_buckets - 1)];
+  while (*link != e)
+    link = &entries_[*link].hash_next;
+  *link = entry.hash_next;
+
+  if (entry.lru_prev >= 0)
+    entries_[entry.lru_prev].lru_next = entry.lru_next;
+  else
+    header_->lru_head = entry.lru_next;
+  if (entry.lru_next >= 0)
+    entries_[entry.lru_next].lru_prev = entry.lru_prev;
+  else
+    header_->lru_tail = entry.lru_prev;
+
+  int64_t last = entry.first_page;
+  while (page_next_[last] >= 0)
+    last = page_next_[last];
+  page_next_[last] = header_->free_pages;
+  header_->free_pages = entry.first_page;
+  header_->num_free_pages += entry.num_pages;
+
+  entry.hash_next = header_->free_entries;
+  header_->free_entries = e;
+
+  header_->stats.num_samples--;
+  header_->stats.bytes_used -= entry.data_size;
+  header_->stats.evictions++;
+}
+
+bool SharedSampleCache::Get(const std::string &key, const AllocFunc &alloc) {
+  uint64_t hash = Hash(key);
+  Lock lock(*this);
+  int64_t e = Find(key, hash);
+  if (e < 0) {
+    header_->stats.misses++;
+    return false;
+  }
+  Touch(e);
+  header_->stats.hits++;
+  const Entry &entry = entries_[e];
+  auto *dst = static_cast<uint8_t *>(alloc(entry.data_size));
+  VisitChunks(entry.first_page, entry.key_size, entry.data_size,
+              [&](const uint8_t *ptr, size_t n) {
+    memcpy(dst, ptr, n);
+    dst += n;
+  });
+  return true;
+}
+
+bool SharedSampleCache::Put(const std::string &key, const void *data, size_t size) {
+  uint64_t hash = Hash(key);
+  size_t page_size = this->page_size();
+  uint64_t num_pages = std::max<uint64_t>(1, (key.size() + size + page_size - 1) / page_size);
+  if (num_pages > header_->num_pages)
+    return false;
+
+  Lock lock(*this);
+  int64_t e = Find(key, hash);
+  if (e >= 0) {
+    // added by another pipeline in the meantime
+    Touch(e);
+    return true;
+  }
+  while (header_->num_free_pages < num_pages || header_->free_entries < 0)
+    Evict(header_->lru_tail);
+
+  e = header_->free_entries;
+  Entry &entry = entries_[e];
+  header_->free_entries = entry.hash_next;
+
+  int64_t last = header_->free_pages;
+  for (uint64_t i = 1; i < num_pages; i++)
+    last = page_next_[last];
+  entry.first_page = header_->free_pages;
+  header_->free_pages = page_next_[last];
+  page_next_[last] = -1;
+  header_->num_free_pages -= num_pages;
+
+  entry.hash = hash;
+  entry.key_size = key.size();
+  entry.data_size = size;
+  entry.num_pages = num_pages;
+  const char *src = key.data();
+  VisitChunks(entry.first_page, 0, key.size(), [&](uint8_t *ptr, size_t n) {
+    memcpy(ptr, src, n);
+    src += n;
+  });
+  src = static_cast<const char *>(data);
+  VisitChunks(entry.first_page, key.size(), size, [&](uint8_t *ptr, size_t n) {
+    memcpy(ptr, src, n);
+    src += n;
+  });
+
+  int64_t &bucket = buckets_[hash & (header_->num_buckets - 1)];
+  entry.hash_next = bucket;
+  bucket = e;
+
+  entry.lru_prev = -1;
+  entry.lru_next = header_->lru_head;
+  if (header_->lru_head >= 0)
+    entries_[header_->lru_head].lru_prev = e;
+  else
+    header_->lru_tail = e;
+  header_->lru_head = e;
+
+  header_->stats.num_samples++;
+  header_->stats.bytes_used += size;
+  return true;
+}
+
+SharedSampleCache::Stats SharedSampleCache::GetStats() {
+  Lock lock(*this);
+  return header_->stats;
+}
+
+size_t SharedSampleCache::capacity() const {
+  return header_->num_pages * header_->page_size;
+}
+
+size_t SharedSampleCache::page_size() const {
+  return header_->page_size;
+}
+
+}  // namespace dali
@@ -0,0 +1,133 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_SHARED_SAMPLE_CACHE_H_
+#define DALI_OPERATORS_READER_LOADER_SHARED_SAMPLE_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "dali/core/common.h"
+#include "dali/core/os/shared_mem.h"
+
+namespace dali {
+
+/**
+ * @brief A cache of raw (encoded) samples kept in named POSIX shared memory
+ *
+ * All the pipelines on the node which open the cache with the same name - in the same or in
+ * different processes - share its contents, so a file read by one of them is served to the
+ * others from memory.
+ *
+ * The memory is divided into pages of `page_size` bytes and a sample (its key followed by
+ * the data) occupies a chain of pages. When there are not enough free pages, the least recently
+ * used samples are evicted. The accesses are serialized with a robust, process-shared mutex;
+ * if a process dies while holding it, the next one to lock it clears the cache.
+ *
+ * The shared memory object outlives the processes, so it can be reused by the subsequent jobs.
+ * It's removed with Remove (or by deleting it from /dev/shm).
+ */
+class DLL_PUBLIC SharedSampleCache {
+ public:
+  static constexpr size_t kDefaultPageSize = 64 << 10;
+
+  /**
+   * @brief Opens the cache `name`, creating it with the given capacity if it doesn't exist
+   *
+   * If the cache exists, the capacity and the page size it was created with are used.
+   */
+  SharedSampleCache(const std::string &name, size_t capacity,
+                    size_t page_size = kDefaultPageSize);
+  ~SharedSampleCache();
+
+  SharedSampleCache(const SharedSampleCache &) = delete;
+  SharedSampleCache &operator=(const SharedSampleCache &) = delete;
+
+  /**
+   * @brief Returns an instance shared by all the callers in this process
+   */
+  static std::shared_ptr<SharedSampleCache> Open(const std::string &name, size_t capacity);
+
+  /**
+   * @brief Removes the shared memory object; the processes which have it open can still use it
+   */
+  static void Remove(const std::string &name);
+
+  using AllocFunc = std::function<void *(size_t size)>;
+
+  /**
+   * @brief Copies the sample to a buffer obtained from `alloc(size)`
+   *
+   * @return false if the sample is not in the cache (`alloc` is not called then)
+   */
+  bool Get(const std::string &key, const AllocFunc &alloc);
+
+  /**
+   * @brief Adds a sample, evicting the least recently used ones if necessary
+   *
+   * @return false if the sample is larger than the whole cache
+   */
+  bool Put(const std::string &key, const void *data, size_t size);
+
+  struct Stats {
+    uint64_t num_samples;
+    uint64_t bytes_used;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+  };
+
+  Stats GetStats();
+
+  size_t capacity() const;
+
+  size_t page_size() const;
+
+ private:
+  struct Header;
+  struct Entry;
+  class Lock;
+
+  void Create(size_t capacity, size_t page_size);
+  void OpenExisting();
+  void SetPointers();
+  void Clear();
+  int64_t Find(const std::string &key, uint64_t hash) const;
+  void Touch(int64_t e);
+  void Evict(int64_t e);
+  bool KeyEquals(const Entry &entry, const std::string &key) const;
+
+  /**
+   * @brief Calls `chunk(ptr, length)` for the consecutive pieces of the range
+   *        [offset, offset + size) of the page chain starting at `page`
+   */
+  template <typename Chunk>
+  void VisitChunks(int64_t page, size_t offset, size_t size, Chunk &&chunk) const;
+
+  std::string name_;
+  ShmHandle handle_;
+  MemoryMapping mapping_;
+  Header *header_ = nullptr;
+  Entry *entries_ = nullptr;
+  int64_t *buckets_ = nullptr;
+  int64_t *page_next_ = nullptr;
+  uint8_t *pages_ = nullptr;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_SHARED_SAMPLE_CACHE_H_
@@ -0,0 +1,168 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dali/core/format.h"
+#include "dali/operators/reader/loader/shared_sample_cache.h"
+
+namespace dali {
+
+namespace {
+
+class SharedSampleCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    name_ = make_string("dali_sample_cache_test_", getpid());
+    SharedSampleCache::Remove(name_);
+  }
+
+  void TearDown() override {
+    SharedSampleCache::Remove(name_);
+  }
+
+  std::string name_;
+};
+
+std::vector<char> Sample(size_t size, char seed) {
+  std::vector<char> data(size);
+  for (size_t i = 0; i < size; i++)
+    data[i] = seed + i % 97;
+  return data;
+}
+
+std::vector<char> GetSample(SharedSampleCache &cache, const std::string &key, bool &found) {
+  std::vector<char> out;
+  found = cache.Get(key, [&](size_t size) {
+    out.resize(size);
+    return out.data();
+  });
+  return out;
+}
+
+}  // namespace
+
+TEST_F(SharedSampleCacheTest, PutGet) {
+  SharedSampleCache cache(name_, 1 << 20, 4096);
+  EXPECT_EQ(cache.capacity(), 1u << 20);
+  bool found;
+  GetSample(cache, "a", found);
+  EXPECT_FALSE(found);
+
+  // sizes spanning zero, one and many pages
+  std::vector<size_t> sizes = {0, 1, 4095, 4096, 10000, 100000};
+  for (size_t i = 0; i < sizes.size(); i++) {
+    auto data = Sample(sizes[i], i);
+    ASSERT_TRUE(cache.Put(make_string("sample_", i), data.data(), data.size()));
+  }
+  for (size_t i = 0; i < sizes.size(); i++) {
+    auto out = GetSample(cache, make_string("sample_", i), found);
+    ASSERT_TRUE(found) << i;
+    EXPECT_EQ(out, Sample(sizes[i], i)) << i;
+  }
+  // a key sharing the prefix is a different sample
+  GetSample(cache, "sample_", found);
+  EXPECT_FALSE(found);
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.num_samples, sizes.size());
+  EXPECT_EQ(stats.hits, sizes.size());
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.evictions, 0u);
+
+  auto too_big = Sample(2 << 20, 0);
+  EXPECT_FALSE(cache.Put("too_big", too_big.data(), too_big.size()));
+}
+
+TEST_F(SharedSampleCacheTest, EvictsLeastRecentlyUsed) {
+  // 16 pages, each sample takes 4 of them
+  SharedSampleCache cache(name_, 16 * 4096, 4096);
+  auto data = Sample(3 * 4096, 1);
+  for (int i = 0; i < 4; i++)
+    ASSERT_TRUE(cache.Put(make_string(i), data.data(), data.size()));
+  bool found;
+  GetSample(cache, "0", found);
+  ASSERT_TRUE(found);
+
+  // evicts "1", the least recently used one
+  ASSERT_TRUE(cache.Put("4", data.data(), data.size()));
+  GetSample(cache, "1", found);
+  EXPECT_FALSE(found);
+  for (auto *key : {"0", "2", "3", "4"}) {
+    auto out = GetSample(cache, key, found);
+    EXPECT_TRUE(found) << key;
+    EXPECT_EQ(out, data) << key;
+  }
+
+  // a sample filling the whole cache evicts everything else
+  auto big = Sample(16 * 4096 - 3, 2);
+  ASSERT_TRUE(cache.Put("big", big.data(), big.size()));
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.num_samples, 1u);
+  EXPECT_EQ(stats.bytes_used, big.size());
+  EXPECT_EQ(stats.evictions, 5u);
+  EXPECT_EQ(GetSample(cache, "big", found), big);
+  EXPECT_TRUE(found);
+}
+
+TEST_F(SharedSampleCacheTest, SharedBetweenInstances) {
+  SharedSampleCache writer(name_, 1 << 20, 4096);
+  // the size given by the second instance is ignored
+  SharedSampleCache reader(name_, 4 << 20, 8192);
+  EXPECT_EQ(reader.capacity(), 1u << 20);
+  EXPECT_EQ(reader.page_size(), 4096u);
+
+  auto data = Sample(50000, 3);
+  ASSERT_TRUE(writer.Put("file.jpg", data.data(), data.size()));
+  bool found;
+  EXPECT_EQ(GetSample(reader, "file.jpg", found), data);
+  EXPECT_TRUE(found);
+
+  EXPECT_EQ(SharedSampleCache::Open(name_, 1 << 20), SharedSampleCache::Open(name_, 1 << 20));
+}
+
+TEST_F(SharedSampleCacheTest, MultipleThreads) {
+  SharedSampleCache cache(name_, 64 * 4096, 4096);
+  std::vector<std::thread> threads;
+  std::vector<int> errors(4, 0);
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < 1000; i++) {
+        int id = (i * 7 + t) % 100;
+        auto data = Sample(1000 + id * 100, id);
+        auto key = make_string(id);
+        bool found;
+        auto out = GetSample(cache, key, found);
+        if (!found)
+          cache.Put(key, data.data(), data.size());
+        else if (out != data)
+          errors[t]++;
+      }
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  for (int t = 0; t < 4; t++)
+    EXPECT_EQ(errors[t], 0) << "thread " << t;
+}
+
+TEST_F(SharedSampleCacheTest, InvalidName) {
+  EXPECT_THROW(SharedSampleCache("a/b", 1 << 20), std::exception);
+  EXPECT_THROW(SharedSampleCache("", 1 << 20), std::exception);
+}
+
+}  // namespace dali
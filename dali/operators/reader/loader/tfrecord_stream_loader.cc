@@ -0,0 +1,107 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/tfrecord_stream_loader.h"
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <utility>
+#include "dali/util/buffered_file.h"
+
+namespace dali {
+
+namespace {
+
+// [uint64 length][uint32 masked crc of the length] ... [uint32 masked crc of the data]
+constexpr int64_t kHeaderSize = sizeof(uint64_t) + sizeof(uint32_t);
+constexpr int64_t kFooterSize = sizeof(uint32_t);
+
+}  // namespace
+
+TFRecordStreamLoader::TFRecordStreamLoader(const OpSpec& options)
+    : Loader(options),
+      uris_(options.GetRepeatedArgument<std::string>("path")) {
+  EnableStreaming();
+  DALI_ENFORCE(streaming_, "TFRecordStreamLoader reads the files only as streams");
+}
+
+TFRecordStreamLoader::~TFRecordStreamLoader() {
+  if (current_file_)
+    current_file_->Close();
+}
+
+void TFRecordStreamLoader::PrepareMetadataImpl() {
+  DALI_ENFORCE(!uris_.empty(), "No files specified.");
+  std::tie(files_begin_, files_end_) = StreamingFiles(uris_.size());
+  // the buffer is reused - the records are always copied
+  copy_read_data_ = true;
+  OpenFile(files_begin_);
+}
+
+void TFRecordStreamLoader::OpenFile(size_t file_index) {
+  if (current_file_)
+    current_file_->Close();
+  auto file = FileStream::Open(uris_[file_index], read_ahead_, false, use_io_uring_,
+                               use_o_direct_, read_policy_);
+  current_file_ = std::make_unique<BufferedFileStream>(std::move(file),
+                                                       static_cast<size_t>(stream_buffer_size_)
+                                                       << 20);
+  current_file_index_ = file_index;
+}
+
+void TFRecordStreamLoader::Reset(bool) {
+  // the shard's files are read over and over - there are no epoch boundaries
+}
+
+void TFRecordStreamLoader::ReadSample(Tensor<CPUBackend>& tensor) {
+  uint64_t length;
+  int64_t pos;
+  size_t n;
+  for (;;) {
+    pos = current_file_->TellRead();
+    n = current_file_->Read(&length, sizeof(length));
+    if (n != 0)
+      break;
+    // the end of the file - go on with the next one of the shard
+    size_t next = current_file_index_ + 1;
+    if (next == files_end_) {
+      DALI_ENFORCE(records_in_pass_ > 0, make_string("No records found in the files of shard ",
+                   shard_id_, ", the first one being ", uris_[files_begin_]));
+      next = files_begin_;
+      records_in_pass_ = 0;
+    }
+    OpenFile(next);
+  }
+  const auto &uri = uris_[current_file_index_];
+  DALI_ENFORCE(n == sizeof(length), make_string("Truncated record in ", uri, " at ", pos));
+  int64_t size = kHeaderSize + length + kFooterSize;
+
+  if (tensor.shares_data()) {
+    tensor.Reset();
+  }
+  tensor.Resize({size}, DALI_UINT8);
+  auto *data = static_cast<uint8_t*>(tensor.raw_mutable_data());
+  std::memcpy(data, &length, sizeof(length));
+  int64_t rest = size - sizeof(length);
+  DALI_ENFORCE(static_cast<int64_t>(current_file_->Read(data + sizeof(length), rest)) == rest,
+               make_string("Truncated record in ", uri, " at ", pos));
+  records_in_pass_++;
+
+  DALIMeta meta;
+  meta.SetSourceInfo(uri + " at index " + to_string(pos));
+  meta.SetSkipSample(false);
+  tensor.SetMeta(meta);
+}
+
+}  // namespace dali
@@ -0,0 +1,64 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_TFRECORD_STREAM_LOADER_H_
+#define DALI_OPERATORS_READER_LOADER_TFRECORD_STREAM_LOADER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/operators/reader/loader/loader.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+/**
+ * @brief Reads the records of TFRecord files one after another, without an index (`streaming`)
+ *
+ * The files of the shard are read sequentially with large buffered reads; each record, together
+ * with its length and CRCs, becomes a sample - the same data IndexedFileLoader reads using
+ * the index.
+ */
+class DLL_PUBLIC TFRecordStreamLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
+ public:
+  explicit TFRecordStreamLoader(const OpSpec& options);
+  ~TFRecordStreamLoader() override;
+
+  void ReadSample(Tensor<CPUBackend>& tensor) override;
+
+ protected:
+  Index SizeImpl() override {
+    return -1;
+  }
+
+  void PrepareMetadataImpl() override;
+
+  void Reset(bool wrap_to_shard) override;
+
+ private:
+  void OpenFile(size_t file_index);
+
+  std::vector<std::string> uris_;
+  size_t files_begin_ = 0, files_end_ = 0;
+  size_t current_file_index_ = 0;
+  std::unique_ptr<FileStream> current_file_;
+  // the number of records read from the files since the first one was opened the last time
+  int64_t records_in_pass_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_TFRECORD_STREAM_LOADER_H_
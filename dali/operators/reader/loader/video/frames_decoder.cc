@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "dali/operators/reader/loader/video/frames_decoder.h"
+#include <algorithm>
 #include <memory>
 #include <iomanip>
 #include "dali/core/error_handling.h"
@@ -93,6 +94,12 @@ void FramesDecoder::InitAvState() {
     ret >= 0,
     make_string("Could not fill the codec based on parameters: ", detail::av_error_string(ret)));
 
+  if (num_threads_ > 1) {
+    // the threads are started by avcodec_open2
+    av_state_->codec_ctx_->thread_count = num_threads_;
+    av_state_->codec_ctx_->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+  }
+
   ret = avcodec_open2(av_state_->codec_ctx_, av_state_->codec_, nullptr);
   DALI_ENFORCE(
     ret == 0,
@@ -130,8 +137,10 @@ void FramesDecoder::FindVideoStream() {
   DALI_FAIL(make_string("Could not find a valid video stream in a file ", Filename()));
 }
 
-FramesDecoder::FramesDecoder(const std::string &filename)
-    : av_state_(std::make_unique<AvState>()), filename_(filename) {
+FramesDecoder::FramesDecoder(const std::string &filename, const FramesIndexCache *index_cache,
+                             int num_threads)
+    : av_state_(std::make_unique<AvState>()), num_threads_(std::max(num_threads, 1)),
+      filename_(filename) {
 
   av_log_set_level(AV_LOG_ERROR);
 
@@ -151,7 +160,11 @@ FramesDecoder::FramesDecoder(const std::string &filename)
       " in file: ", Filename(),
       " Supported codecs: h264, HEVC."));
   InitAvState();
-  BuildIndex();
+  if (!index_cache || !index_cache->Load(filename, index_)) {
+    BuildIndex();
+    if (index_cache)
+      index_cache->Store(filename, index_);
+  }
   DetectVfr();
 }
 
@@ -342,15 +355,29 @@ void FramesDecoder::Reset() {
 }
 
 void FramesDecoder::SeekFrame(int frame_id) {
-  // TODO(awolant): Optimize seeking:
-  //  - when we seek next frame,
-  //  - when we seek frame with the same keyframe as the current frame
-  //  - for CFR, when we know pts, but don't know keyframes
+  // TODO(awolant): Optimize seeking for CFR, when we know pts, but don't know keyframes
+  if (!ReadForwardTo(frame_id))
+    SeekFromKeyframe(frame_id);
+}
 
+bool FramesDecoder::ReadForwardTo(int frame_id) {
   DALI_ENFORCE(
     frame_id >= 0 && frame_id < NumFrames(),
     make_string("Invalid seek frame id. frame_id = ", frame_id, ", num_frames = ", NumFrames()));
 
+  if (next_frame_idx_ < 0 || next_frame_idx_ > frame_id ||
+      index_[frame_id].last_keyframe_id > next_frame_idx_) {
+    return false;
+  }
+  LOG_LINE << "Reading forward to frame " << frame_id << " from frame " << next_frame_idx_
+           << std::endl;
+  while (next_frame_idx_ < frame_id) {
+    ReadNextFrame(nullptr, false);
+  }
+  return true;
+}
+
+void FramesDecoder::SeekFromKeyframe(int frame_id) {
   auto &frame_entry = index_[frame_id];
   int keyframe_id = frame_entry.last_keyframe_id;
   auto &keyframe_entry = index_[keyframe_id];
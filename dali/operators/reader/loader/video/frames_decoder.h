@@ -28,14 +28,9 @@ extern "C" {
 #include <optional>
 
 #include "dali/core/common.h"
+#include "dali/operators/reader/loader/video/frames_index_cache.h"
 
 namespace dali {
-struct IndexEntry {
-  int64_t pts;
-  int last_keyframe_id;
-  bool is_keyframe;
-  bool is_flush_frame;
-};
 
 struct AvState {
   AVFormatContext *ctx_ = nullptr;
@@ -100,8 +95,14 @@ class DLL_PUBLIC FramesDecoder {
    * @brief Construct a new FramesDecoder object.
    * 
    * @param filename Path to a video file.
+   * @param index_cache Optional cache of the frame indices. If the index of the file is
+   * in the cache, it is not built again.
+   * @param num_threads Number of threads used by FFmpeg to decode the frames (frame and
+   * slice threading). With 1, the frames are decoded in the calling thread.
    */
-  explicit FramesDecoder(const std::string &filename);
+  explicit FramesDecoder(const std::string &filename,
+                         const FramesIndexCache *index_cache = nullptr,
+                         int num_threads = 1);
 
 
   /**
@@ -155,6 +156,14 @@ class DLL_PUBLIC FramesDecoder {
     return Channels() * Width() * Height();
   }
 
+  /**
+   * @brief Is the frame given by id a keyframe
+   *
+   */
+  bool IsKeyframe(int frame_id) const {
+    return index_[frame_id].is_keyframe;
+  }
+
     /**
    * @brief Is video variable frame rate
    * 
@@ -203,6 +212,20 @@ class DLL_PUBLIC FramesDecoder {
 
   int next_frame_idx_ = 0;
 
+  /**
+   * @brief Reads (and drops) the frames up to the given one, if it is in the GOP being decoded
+   * and is not behind the current position. This is cheaper than seeking to the keyframe
+   * and decoding the GOP from the start again.
+   *
+   * @return Whether the next call to ReadNextFrame will return the frame
+   */
+  bool ReadForwardTo(int frame_id);
+
+  /**
+   * @brief Seeks to the keyframe preceding the frame given by id and decodes the frames up to it
+   */
+  void SeekFromKeyframe(int frame_id);
+
  private:
    /**
    * @brief Gets the packet from the decoder and reads a frame from it to provided buffer. Returns 
@@ -248,6 +271,7 @@ class DLL_PUBLIC FramesDecoder {
   }
 
   int channels_ = 3;
+  int num_threads_ = 1;
   bool flush_state_ = false;
   bool is_vfr_ = false;
 
@@ -120,14 +120,16 @@ void FramesDecoderGpu::InitGpuDecoder() {
 
   // Init internal frame buffer
   // TODO(awolant): Check, if continuous buffer would be faster
+  // The buffered frames are kept in NV12, which takes half of the RGB size
   for (size_t i = 0; i < frame_buffer_.size(); ++i) {
-    frame_buffer_[i].frame_.resize(FrameSize());
+    frame_buffer_[i].frame_.resize(Nv12FrameSize());
     frame_buffer_[i].pts_ = -1;
   }
 }
 
-FramesDecoderGpu::FramesDecoderGpu(const std::string &filename, cudaStream_t stream) :
-    FramesDecoder(filename),
+FramesDecoderGpu::FramesDecoderGpu(const std::string &filename, cudaStream_t stream,
+                                   const FramesIndexCache *index_cache) :
+    FramesDecoder(filename, index_cache),
     frame_buffer_(num_decode_surfaces_),
     stream_(stream) {
     InitGpuDecoder();
@@ -159,6 +161,7 @@ int FramesDecoderGpu::ProcessPictureDecode(void *user_data, CUVIDPICPARAMS *pict
   videoProcessingParameters.output_stream = stream_;
 
   uint8_t *frame_output = nullptr;
+  bool convert = false;
 
   // Take pts of the currently decoded frame
   int current_pts = piped_pts_.front();
@@ -181,6 +184,7 @@ int FramesDecoderGpu::ProcessPictureDecode(void *user_data, CUVIDPICPARAMS *pict
       return 1;
     }
     frame_output = current_frame_output_;
+    convert = !nv12_output_;
   } else {
     // Put currently decoded frame to the buffer for later
     auto &slot = FindEmptySlot();
@@ -199,14 +203,18 @@ int FramesDecoderGpu::ProcessPictureDecode(void *user_data, CUVIDPICPARAMS *pict
     &videoProcessingParameters));
 
   // TODO(awolant): Benchmark, if copy would be faster
-  yuv_to_rgb(
-    reinterpret_cast<uint8_t *>(frame),
-    pitch,
-    frame_output,
-    Width()* 3,
-    Width(),
-    Height(),
-    stream_);
+  if (convert) {
+    yuv_to_rgb(
+      reinterpret_cast<uint8_t *>(frame),
+      pitch,
+      frame_output,
+      Width()* 3,
+      Width(),
+      Height(),
+      stream_);
+  } else {
+    CopyNv12(frame_output, reinterpret_cast<const uint8_t *>(frame), pitch);
+  }
   // TODO(awolant): Alterantive is to copy the data to a buffer
   // and then process it on the stream. Check, if this is faster, when
   // the benchmark is ready.
@@ -217,9 +225,10 @@ int FramesDecoderGpu::ProcessPictureDecode(void *user_data, CUVIDPICPARAMS *pict
 }
 
 void FramesDecoderGpu::SeekFrame(int frame_id) {
-  // TODO(awolant): This seek can be optimized - for consecutive frames not needed etc.
+  if (ReadForwardTo(frame_id))
+    return;
   SendLastPacket(true);
-  FramesDecoder::SeekFrame(frame_id);
+  SeekFromKeyframe(frame_id);
 }
 
 bool FramesDecoderGpu::ReadNextFrame(uint8_t *data, bool copy_to_output) {
@@ -231,8 +240,11 @@ bool FramesDecoderGpu::ReadNextFrame(uint8_t *data, bool copy_to_output) {
   // Check if requested frame was buffered earlier
   for (auto &frame : frame_buffer_) {
     if (frame.pts_ == index_[next_frame_idx_].pts) {
-      if (copy_to_output) {
-        copyD2D(data, frame.frame_.data(), FrameSize());
+      if (copy_to_output && nv12_output_) {
+        copyD2D(data, frame.frame_.data(), Nv12FrameSize());
+      } else if (copy_to_output) {
+        yuv_to_rgb(frame.frame_.data(), Width(), data, Width() * 3, Width(), Height(), stream_);
+        CUDA_CALL(cudaStreamSynchronize(stream_));
       }
       LOG_LINE << "Read frame, index " << next_frame_idx_ << ", timestamp " <<
         std::setw(5) << frame.pts_ << ", current copy " << copy_to_output << std::endl;
@@ -311,6 +323,12 @@ void FramesDecoderGpu::SendLastPacket(bool flush) {
   }
 }
 
+void FramesDecoderGpu::CopyNv12(uint8_t *dst, const uint8_t *surface, unsigned int pitch) {
+  // the luma plane is followed by the interleaved chroma plane of half the height
+  CUDA_CALL(cudaMemcpy2DAsync(dst, Width(), surface, pitch, Width(), Height() * 3 / 2,
+                              cudaMemcpyDeviceToDevice, stream_));
+}
+
 BufferedFrame& FramesDecoderGpu::FindEmptySlot() {
   for (auto &frame : frame_buffer_) {
     if (frame.pts_ == -1) {
@@ -55,8 +55,10 @@ class DLL_PUBLIC FramesDecoderGpu : public FramesDecoder {
    * 
    * @param filename Path to a video file.
    * @param stream Stream used for decode processing.
+   * @param index_cache Optional cache of the frame indices.
    */
-  explicit FramesDecoderGpu(const std::string &filename, cudaStream_t stream = 0);
+  explicit FramesDecoderGpu(const std::string &filename, cudaStream_t stream = 0,
+                            const FramesIndexCache *index_cache = nullptr);
 
   /**
  * @brief Construct a new FramesDecoder object.
@@ -77,6 +79,21 @@ class DLL_PUBLIC FramesDecoderGpu : public FramesDecoder {
 
   int NextFramePts() { return index_[NextFrameIdx()].pts; }
 
+  /**
+   * @brief Makes ReadNextFrame return the frames in NV12 (the luma plane followed by
+   * the interleaved chroma plane), so that they can be converted to RGB in batches.
+   */
+  void SetNv12Output(bool nv12_output) {
+    nv12_output_ = nv12_output;
+  }
+
+  /**
+   * @brief Size of a frame in NV12, in bytes (width * height * 3 / 2)
+   */
+  int Nv12FrameSize() const {
+    return Width() * Height() * 3 / 2;
+  }
+
   int ProcessPictureDecode(void *user_data, CUVIDPICPARAMS *picture_params);
 
   FramesDecoderGpu(FramesDecoderGpu&&) = default;
@@ -91,6 +108,7 @@ class DLL_PUBLIC FramesDecoderGpu : public FramesDecoder {
   bool current_copy_to_output_ = false;
   bool frame_returned_ = false;
   bool flush_ = false;
+  bool nv12_output_ = false;
 
   AVBSFContext *bsfc_ = nullptr;
   AVPacket *filtered_packet_ = nullptr;
@@ -108,6 +126,8 @@ class DLL_PUBLIC FramesDecoderGpu : public FramesDecoder {
 
   BufferedFrame& FindEmptySlot();
 
+  void CopyNv12(uint8_t *dst, const uint8_t *surface, unsigned int pitch);
+
   void InitBitStreamFilter();
 
   cudaVideoCodec GetCodecType();
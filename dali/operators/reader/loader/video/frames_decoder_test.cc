@@ -13,8 +13,10 @@
 // limitations under the License.
 
 #include <cuda_runtime_api.h>
+#include <stdlib.h>
 #include <exception>
 #include <random>
+#include <vector>
 
 #include "dali/core/cuda_error.h"
 #include "dali/core/dev_buffer.h"
@@ -174,6 +176,32 @@ TEST_F(FramesDecoderTest_CpuOnlyTests, VariableFrameRateHevc) {
   RunTest(decoder, vfr_hevc_videos_[0]);
 }
 
+TEST_F(FramesDecoderTest_CpuOnlyTests, MultiThreaded) {
+  FramesDecoder decoder(cfr_videos_paths_[0], nullptr, 4);
+  RunTest(decoder, cfr_videos_[0]);
+  FramesDecoder decoder_vfr(vfr_hevc_videos_paths_[0], nullptr, 4);
+  RunTest(decoder_vfr, vfr_hevc_videos_[0]);
+}
+
+TEST_F(FramesDecoderTest_CpuOnlyTests, IndexCache) {
+  char dir[] = "/tmp/dali_frames_index_cache_XXXXXX";
+  ASSERT_NE(mkdtemp(dir), nullptr);
+  FramesIndexCache cache(dir);
+  std::vector<IndexEntry> index;
+  EXPECT_FALSE(cache.Load(vfr_videos_paths_[1], index));
+  {
+    FramesDecoder decoder(vfr_videos_paths_[1], &cache);
+    RunTest(decoder, vfr_videos_[1]);
+  }
+  ASSERT_TRUE(cache.Load(vfr_videos_paths_[1], index));
+  EXPECT_EQ(static_cast<int>(index.size()), vfr_videos_[1].NumFrames());
+
+  // the second decoder reads the index from the cache
+  FramesDecoder decoder(vfr_videos_paths_[1], &cache);
+  RunTest(decoder, vfr_videos_[1]);
+  EXPECT_EQ(system(make_string("rm -rf ", dir).c_str()), 0);
+}
+
 TEST_F(FramesDecoderTest_CpuOnlyTests, InvalidPath) {
   std::string path = "invalid_path.mp4";
 
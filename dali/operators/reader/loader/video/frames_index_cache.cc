@@ -0,0 +1,152 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/operators/reader/loader/video/frames_index_cache.h"
+#include <errno.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "dali/core/error_handling.h"
+
+namespace dali {
+
+namespace {
+
+constexpr char kIndexMagic[8] = {'D', 'A', 'L', 'I', 'V', 'I', 'X', '1'};
+
+// Identifies the version of the video file that the index was built for.
+// Followed by `path_size` bytes of the path and `num_frames` records
+struct IndexHeader {
+  char magic[8];
+  int64_t file_size;
+  int64_t mtime_ns;
+  uint64_t path_size;
+  uint64_t num_frames;
+};
+
+struct IndexRecord {
+  int64_t pts;
+  int32_t last_keyframe_id;
+  uint8_t is_keyframe;
+  uint8_t is_flush_frame;
+  uint16_t reserved;
+};
+
+bool StatFile(const std::string &filename, int64_t &size, int64_t &mtime_ns) {
+  struct stat st;
+  if (stat(filename.c_str(), &st) != 0)
+    return false;
+  size = st.st_size;
+  mtime_ns = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+  return true;
+}
+
+}  // namespace
+
+FramesIndexCache::FramesIndexCache(const std::string &cache_dir) : cache_dir_(cache_dir) {
+  DALI_ENFORCE(!cache_dir_.empty(), "The index cache directory cannot be empty");
+  if (mkdir(cache_dir_.c_str(), 0755) != 0 && errno != EEXIST)
+    DALI_FAIL(make_string("Failed to create the index cache directory ", cache_dir_, ": ",
+                          std::strerror(errno)));
+}
+
+std::string FramesIndexCache::IndexPath(const std::string &filename) const {
+  std::stringstream ss;
+  ss << cache_dir_ << "/" << std::hex << std::setw(16) << std::setfill('0')
+     << std::hash<std::string>()(filename) << ".idx";
+  return ss.str();
+}
+
+bool FramesIndexCache::Load(const std::string &filename, std::vector<IndexEntry> &index) const {
+  int64_t file_size, mtime_ns;
+  if (!StatFile(filename, file_size, mtime_ns))
+    return false;
+  std::ifstream in(IndexPath(filename), std::ios::binary);
+  if (!in)
+    return false;
+
+  IndexHeader header;
+  if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kIndexMagic, sizeof(kIndexMagic)) != 0 ||
+      header.file_size != file_size || header.mtime_ns != mtime_ns ||
+      header.path_size != filename.size())
+    return false;
+  // different paths can have the same hash
+  std::string path(header.path_size, '\0');
+  if (!in.read(&path[0], path.size()) || path != filename)
+    return false;
+
+  std::vector<IndexRecord> records(header.num_frames);
+  if (!in.read(reinterpret_cast<char *>(records.data()), records.size() * sizeof(IndexRecord)))
+    return false;
+  index.clear();
+  index.reserve(records.size());
+  for (auto &record : records) {
+    if (record.last_keyframe_id < 0 || record.last_keyframe_id >= static_cast<int>(records.size()))
+      return false;
+    index.push_back({record.pts, record.last_keyframe_id, record.is_keyframe != 0,
+                     record.is_flush_frame != 0});
+  }
+  LOG_LINE << "Loaded the index of " << filename << " from the cache: " << index.size()
+           << " frames" << std::endl;
+  return true;
+}
+
+void FramesIndexCache::Store(const std::string &filename,
+                             const std::vector<IndexEntry> &index) const {
+  IndexHeader header;
+  std::memcpy(header.magic, kIndexMagic, sizeof(kIndexMagic));
+  if (!StatFile(filename, header.file_size, header.mtime_ns))
+    return;
+  header.path_size = filename.size();
+  header.num_frames = index.size();
+
+  std::vector<IndexRecord> records;
+  records.reserve(index.size());
+  for (auto &entry : index) {
+    records.push_back({entry.pts, entry.last_keyframe_id, entry.is_keyframe,
+                       entry.is_flush_frame, 0});
+  }
+
+  // Other processes may read the index at the same time - write the whole file first
+  // and then move it in place
+  auto path = IndexPath(filename);
+  static std::atomic<int> tmp_idx{0};
+  auto tmp_path = make_string(path, ".", getpid(), ".", tmp_idx++, ".tmp");
+  {
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(filename.data(), filename.size());
+    out.write(reinterpret_cast<const char *>(records.data()),
+              records.size() * sizeof(IndexRecord));
+    if (!out) {
+      out.close();
+      remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (rename(tmp_path.c_str(), path.c_str()) != 0)
+    remove(tmp_path.c_str());
+}
+
+}  // namespace dali
@@ -0,0 +1,74 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_OPERATORS_READER_LOADER_VIDEO_FRAMES_INDEX_CACHE_H_
+#define DALI_OPERATORS_READER_LOADER_VIDEO_FRAMES_INDEX_CACHE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dali/core/api_helper.h"
+
+namespace dali {
+
+struct IndexEntry {
+  int64_t pts;
+  int last_keyframe_id;
+  bool is_keyframe;
+  bool is_flush_frame;
+};
+
+/**
+ * @brief Keeps the frame indices of the video files in a directory, so that they are built
+ *        only once, and not in every run.
+ *
+ * The index of a video file is stored in a separate file, which is valid as long as the path,
+ * the size and the modification time of the video file match.
+ */
+class DLL_PUBLIC FramesIndexCache {
+ public:
+  /**
+   * @brief Creates the cache in the given directory. The directory is created, if needed.
+   */
+  explicit FramesIndexCache(const std::string &cache_dir);
+
+  /**
+   * @brief Reads the stored index of the video file.
+   *
+   * @return false, if there is no valid index for the file in the cache
+   */
+  bool Load(const std::string &filename, std::vector<IndexEntry> &index) const;
+
+  /**
+   * @brief Stores the index of the video file.
+   *
+   * Failing to store the index is not an error - the index is built again in the next run.
+   */
+  void Store(const std::string &filename, const std::vector<IndexEntry> &index) const;
+
+  const std::string &Dir() const {
+    return cache_dir_;
+  }
+
+ private:
+  std::string IndexPath(const std::string &filename) const;
+
+  std::string cache_dir_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_VIDEO_FRAMES_INDEX_CACHE_H_
@@ -1,29 +1,54 @@
-// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
-//
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at
-//
-//     http://www.apache.org/licenses/LICENSE-2.0
-//
-// Unless required by applicable law or agreed to in writing, software
-// distributed under the License is distributed on an "AS IS" BASIS,
-// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
-// See the License for the specific language governing permissions and
-// limitations under the License.
-
-#ifndef DALI_OPERATORS_READER_LOADER_VIDEO_NVDECODE_COLOR_SPACE_GPU_H_
-#define DALI_OPERATORS_READER_LOADER_VIDEO_NVDECODE_COLOR_SPACE_GPU_H_
-
-#include <stdint.h>
-
-void yuv_to_rgb(
-    uint8_t *yuv,
-    int yuv_pitch,
-    uint8_t *rgb,
-    int rgb_pitch,
-    int width,
-    int height,
-    cudaStream_t stream);
-
-#endif  // DALI_OPERATORS_READER_LOADER_VIDEO_NVDECODE_COLOR_SPACE_GPU_H_
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_VIDEO_NVDECODE_COLOR_SPACE_GPU_H_
+#define DALI_OPERATORS_READER_LOADER_VIDEO_NVDECODE_COLOR_SPACE_GPU_H_
+
+#include <stdint.h>
+
+/**
+ * A frame to convert with yuv_to_rgb_batch
+ */
+struct YuvToRgbSample {
+    const uint8_t *yuv;
+    int yuv_pitch;
+    uint8_t *rgb;
+    int rgb_pitch;
+    int width;
+    int height;
+};
+
+void yuv_to_rgb(
+    uint8_t *yuv,
+    int yuv_pitch,
+    uint8_t *rgb,
+    int rgb_pitch,
+    int width,
+    int height,
+    cudaStream_t stream);
+
+/**
+ * Converts multiple NV12 frames to RGB with a single kernel launch.
+ *
+ * `samples` is a device array of `num_samples` descriptors; `max_width` and `max_height`
+ * are the largest dimensions among the frames.
+ */
+void yuv_to_rgb_batch(
+    const YuvToRgbSample *samples,
+    int num_samples,
+    int max_width,
+    int max_height,
+    cudaStream_t stream);
+
+#endif  // DALI_OPERATORS_READER_LOADER_VIDEO_NVDECODE_COLOR_SPACE_GPU_H_
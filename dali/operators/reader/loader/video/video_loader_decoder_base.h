@@ -16,9 +16,14 @@
 #define DALI_OPERATORS_READER_LOADER_VIDEO_VIDEO_LOADER_DECODER_BASE_H_
 
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "dali/operators/reader/loader/video/frames_decoder.h"
+#include "dali/operators/reader/loader/video/frames_index_cache.h"
+
 namespace dali {
 class VideoSampleDesc {
  public:
@@ -44,7 +49,8 @@ class VideoLoaderDecoderBase {
     filenames_(spec.GetRepeatedArgument<std::string>("filenames")),
     sequence_len_(spec.GetArgument<int>("sequence_length")),
     stride_(spec.GetArgument<int>("stride")),
-    step_(spec.GetArgument<int>("step")) {
+    step_(spec.GetArgument<int>("step")),
+    align_to_keyframes_(spec.GetArgument<bool>("align_to_keyframes")) {
     has_labels_ = spec.TryGetRepeatedArgument(labels_, "labels");
     DALI_ENFORCE(
         !has_labels_ || labels_.size() == filenames_.size(),
@@ -54,10 +60,37 @@ class VideoLoaderDecoderBase {
     if (step_ <= 0) {
       step_ = stride_ * sequence_len_;
     }
+    auto index_cache_dir = spec.GetArgument<std::string>("index_cache_dir");
+    if (!index_cache_dir.empty()) {
+      index_cache_ = std::make_unique<FramesIndexCache>(index_cache_dir);
+    }
   }
 
 
  protected:
+  /**
+   * @brief Adds the sequences of the video to sample_spans_
+   *
+   * The sequences start every `step_` frames. With `align_to_keyframes_`, a sequence is moved
+   * forward to the first keyframe within the step, so that the frames before its start don't
+   * have to be decoded and discarded.
+   */
+  void AddSampleSpans(const FramesDecoder &video, int video_idx) {
+    int span = stride_ * sequence_len_;
+    int num_frames = video.NumFrames();
+    for (int start = 0; start + span <= num_frames; start += step_) {
+      int aligned = start;
+      if (align_to_keyframes_) {
+        int limit = std::min(start + step_, num_frames - span + 1);
+        while (aligned < limit && !video.IsKeyframe(aligned))
+          aligned++;
+        if (aligned == limit)
+          aligned = start;
+      }
+      sample_spans_.push_back(VideoSampleDesc(aligned, aligned + span, stride_, video_idx));
+    }
+  }
+
   std::vector<std::string> filenames_;
   std::vector<int> labels_;
   bool has_labels_ = false;
@@ -67,6 +100,9 @@ class VideoLoaderDecoderBase {
   int sequence_len_;
   int stride_;
   int step_;
+  bool align_to_keyframes_;
+
+  std::unique_ptr<FramesIndexCache> index_cache_;
 
   std::vector<VideoSampleDesc> sample_spans_;
 };
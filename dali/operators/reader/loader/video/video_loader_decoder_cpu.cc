@@ -15,35 +15,40 @@
 #include "dali/operators/reader/loader/video/video_loader_decoder_cpu.h"
 
 namespace dali {
-void VideoLoaderDecoderCpu::PrepareEmpty(VideoSample<CPUBackend> &sample) {
+void VideoSampleCpu::Decode() {
+  data_.Resize(
+    TensorShape<4>{
+      sequence_len_, video_file_->Height(), video_file_->Width(), video_file_->Channels()},
+    DALIDataType::DALI_UINT8);
+
+  auto data = data_.mutable_data<uint8_t>();
+
+  for (int i = 0; i < sequence_len_; ++i) {
+    video_file_->SeekFrame(span_->start_ + i * span_->stride_);
+    video_file_->ReadNextFrame(data + i * video_file_->FrameSize());
+  }
+}
+
+void VideoLoaderDecoderCpu::PrepareEmpty(VideoSampleCpu &sample) {
   sample = {};
   sample.data_.set_pinned(false);
   sample.data_.SetLayout("FHWC");
 }
 
-void VideoLoaderDecoderCpu::ReadSample(VideoSample<CPUBackend> &sample) {
+void VideoLoaderDecoderCpu::ReadSample(VideoSampleCpu &sample) {
   auto &sample_span = sample_spans_[current_index_];
-  auto &video_file = video_files_[sample_span.video_idx_];
 
-  ++current_index_;
-  MoveToNextShard(current_index_);
-
-  sample.data_.Resize(
-    TensorShape<4>{sequence_len_, video_file.Height(), video_file.Width(), video_file.Channels()},
-    DALIDataType::DALI_UINT8);
-
-  auto data = sample.data_.mutable_data<uint8_t>();
-
-  // TODO(awolant): Extract decoding outside of ReadSample (ReaderDecoder abstraction)
-  for (int i = 0; i < sequence_len_; ++i) {
-    // TODO(awolant): This seek can be optimized - for consecutive frames not needed etc.
-    video_file.SeekFrame(sample_span.start_ + i * sample_span.stride_);
-    video_file.ReadNextFrame(data + i * video_file.FrameSize());
-  }
+  // Bind sample to the video and span, so it can be decoded later
+  sample.span_ = &sample_span;
+  sample.video_file_ = &video_files_[sample_span.video_idx_];
+  sample.sequence_len_ = sequence_len_;
 
   if (has_labels_) {
     sample.label_ = labels_[sample_span.video_idx_];
   }
+
+  ++current_index_;
+  MoveToNextShard(current_index_);
 }
 
 Index VideoLoaderDecoderCpu::SizeImpl() {
@@ -53,16 +58,11 @@ Index VideoLoaderDecoderCpu::SizeImpl() {
 void VideoLoaderDecoderCpu::PrepareMetadataImpl() {
   video_files_.reserve(filenames_.size());
   for (auto &filename : filenames_) {
-    video_files_.emplace_back(filename);
+    video_files_.emplace_back(filename, index_cache_.get(), num_decoder_threads_);
   }
 
   for (size_t video_idx = 0; video_idx < video_files_.size(); ++video_idx) {
-    for (int start = 0;
-         start + stride_ * sequence_len_ <= video_files_[video_idx].NumFrames();
-         start += step_) {
-      sample_spans_.push_back(
-        VideoSampleDesc(start, start + stride_ * sequence_len_, stride_, video_idx));
-    }
+    AddSampleSpans(video_files_[video_idx], video_idx);
   }
   if (shuffle_) {
       // seeded with hardcoded value to get
@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_READER_LOADER_VIDEO_VIDEO_LOADER_DECODER_CPU_H_
 #define DALI_OPERATORS_READER_LOADER_VIDEO_VIDEO_LOADER_DECODER_CPU_H_
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -24,13 +25,33 @@
 
 
 namespace dali {
-using VideoSampleCpu = VideoSample<CPUBackend>;
+class VideoSampleCpu {
+ public:
+  /**
+   * @brief Decodes the frames of the sequence to `data_`
+   *
+   * The samples of a batch are decoded after the batch is read (see
+   * VideoReaderDecoderCpu::Prefetch), so that the samples from different files are decoded
+   * at the same time.
+   */
+  void Decode();
+
+  FramesDecoder *video_file_ = nullptr;
+  VideoSampleDesc *span_ = nullptr;
+  int sequence_len_ = 0;
+  Tensor<CPUBackend> data_;
+  int label_ = -1;
+};
 
 class VideoLoaderDecoderCpu : public Loader<CPUBackend, VideoSampleCpu>, VideoLoaderDecoderBase {
  public:
   explicit inline VideoLoaderDecoderCpu(const OpSpec &spec) :
     Loader<CPUBackend, VideoSampleCpu>(spec),
-    VideoLoaderDecoderBase(spec) { }
+    VideoLoaderDecoderBase(spec),
+    // the samples of a batch are decoded in parallel - the remaining threads are given
+    // to FFmpeg to decode the frames of a sample
+    num_decoder_threads_(std::max(1, spec.GetArgument<int>("num_threads") /
+                                     spec.GetArgument<int>("max_batch_size"))) { }
 
   void ReadSample(VideoSampleCpu &sample) override;
 
@@ -45,6 +66,9 @@ class VideoLoaderDecoderCpu : public Loader<CPUBackend, VideoSampleCpu>, VideoLo
   void Reset(bool wrap_to_shard) override;
 
   std::vector<FramesDecoder> video_files_;
+
+  /// Number of threads used by FFmpeg to decode a video file
+  int num_decoder_threads_ = 1;
 };
 
 }  // namespace dali
@@ -27,12 +27,29 @@ void VideoSampleGpu::Decode() {
   data_.Resize(
     shape,
     DALIDataType::DALI_UINT8);
+  nv12_.Resize(
+    TensorShape<2>{sequence_len_, video_file_->Nv12FrameSize()},
+    DALIDataType::DALI_UINT8);
 
   for (int i = 0; i < sequence_len_; ++i) {
     int frame_id = span_->start_ + i * span_->stride_;
     video_file_->SeekFrame(frame_id);
     video_file_->ReadNextFrame(
-      static_cast<uint8_t *>(data_.raw_mutable_data()) + i * video_file_->FrameSize());
+      static_cast<uint8_t *>(nv12_.raw_mutable_data()) + i * video_file_->Nv12FrameSize());
+  }
+}
+
+void VideoSampleGpu::AddFramesToConvert(std::vector<YuvToRgbSample> &frames) {
+  int width = video_file_->Width();
+  int height = video_file_->Height();
+  for (int i = 0; i < sequence_len_; ++i) {
+    frames.push_back({
+      nv12_.data<uint8_t>() + i * video_file_->Nv12FrameSize(),
+      width,
+      data_.mutable_data<uint8_t>() + i * video_file_->FrameSize(),
+      width * video_file_->Channels(),
+      width,
+      height});
   }
 }
 
@@ -88,16 +105,12 @@ Index VideoLoaderDecoderGpu::SizeImpl() {
 void VideoLoaderDecoderGpu::PrepareMetadataImpl() {
   video_files_.reserve(filenames_.size());
   for (auto &filename : filenames_) {
-    video_files_.emplace_back(filename, cuda_stream_);
+    video_files_.emplace_back(filename, cuda_stream_, index_cache_.get());
+    video_files_.back().SetNv12Output(true);
   }
 
   for (size_t video_idx = 0; video_idx < video_files_.size(); ++video_idx) {
-    for (int start = 0;
-         start + stride_ * sequence_len_ <= video_files_[video_idx].NumFrames();
-         start += step_) {
-      sample_spans_.push_back(
-        VideoSampleDesc(start, start + stride_ * sequence_len_, stride_, video_idx));
-    }
+    AddSampleSpans(video_files_[video_idx], video_idx);
   }
   if (shuffle_) {
     // seeded with hardcoded value to get
@@ -23,15 +23,28 @@
 #include "dali/operators/reader/loader/video/video_loader_decoder_base.h"
 #include "dali/operators/reader/loader/video/video_loader_decoder_cpu.h"
 #include "dali/operators/reader/loader/video/frames_decoder_gpu.h"
+#include "dali/operators/reader/loader/video/nvdecode/color_space.h"
 
 namespace dali {
 class VideoSampleGpu {
  public:
+  /**
+   * @brief Decodes the frames of the sequence to `nv12_` and allocates `data_` for them.
+   *
+   * The frames are converted from NV12 to RGB for the whole batch at once,
+   * with `AddFramesToConvert` and `yuv_to_rgb_batch`.
+   */
   void Decode();
 
+  /**
+   * @brief Appends the conversion descriptors of the decoded frames
+   */
+  void AddFramesToConvert(std::vector<YuvToRgbSample> &frames);
+
   FramesDecoderGpu *video_file_ = nullptr;
   VideoSampleDesc *span_ = nullptr;
   int sequence_len_ = 0;
+  Tensor<GPUBackend> nv12_;
   Tensor<GPUBackend> data_;
   int label_ = -1;
 };
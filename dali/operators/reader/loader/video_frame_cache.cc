@@ -0,0 +1,124 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/operators/reader/loader/video_frame_cache.h"
+#include <iterator>
+#include <string>
+#include "dali/core/cuda_error.h"
+#include "dali/pipeline/data/types.h"
+
+namespace dali {
+
+VideoFrameCache::FrameFormat::FrameFormat(const SequenceWrapper &sequence)
+    : height(sequence.height),
+      width(sequence.width),
+      channels(sequence.channels),
+      dtype(sequence.dtype),
+      resize_frames(sequence.resize_frames),
+      roi_x0(sequence.roi_x0),
+      roi_y0(sequence.roi_y0),
+      roi_x1(sequence.roi_x1),
+      roi_y1(sequence.roi_y1) {
+  if (!resize_frames)
+    roi_x0 = roi_y0 = roi_x1 = roi_y1 = 0;
+}
+
+bool VideoFrameCache::FrameFormat::operator==(const FrameFormat &other) const {
+  return height == other.height && width == other.width && channels == other.channels &&
+         dtype == other.dtype && resize_frames == other.resize_frames &&
+         roi_x0 == other.roi_x0 && roi_y0 == other.roi_y0 &&
+         roi_x1 == other.roi_x1 && roi_y1 == other.roi_y1;
+}
+
+VideoFrameCache::~VideoFrameCache() {
+  while (!frames_.empty())
+    Evict(std::prev(frames_.end()));
+}
+
+int VideoFrameCache::Get(const std::string &file, int first_frame, int stride,
+                         SequenceWrapper &sequence, cudaStream_t stream) {
+  FrameFormat format(sequence);
+  size_t frame_size =
+      volume(sequence.frame_shape()) * TypeTable::GetTypeInfo(sequence.dtype).size();
+  auto *out = static_cast<uint8_t *>(sequence.sequence.raw_mutable_data());
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  int i = 0;
+  for (; i < sequence.count; i++) {
+    auto it = index_.find({file, first_frame + i * stride});
+    if (it == index_.end())
+      break;
+    auto &frame = *it->second;
+    if (!(frame.format == format))
+      break;
+    CUDA_CALL(cudaStreamWaitEvent(stream, frame.event, 0));
+    CUDA_CALL(cudaMemcpyAsync(out + i * frame_size, frame.data.get(), frame_size,
+                              cudaMemcpyDeviceToDevice, stream));
+    CUDA_CALL(cudaEventRecord(frame.event, stream));
+    sequence.timestamps.push_back(frame.timestamp);
+    frames_.splice(frames_.begin(), frames_, it->second);
+  }
+  return i;
+}
+
+void VideoFrameCache::Put(const std::string &file, int first_frame, int stride, int begin,
+                          const SequenceWrapper &sequence, cudaStream_t stream) {
+  FrameFormat format(sequence);
+  size_t frame_size =
+      volume(sequence.frame_shape()) * TypeTable::GetTypeInfo(sequence.dtype).size();
+  if (frame_size > capacity_)
+    return;
+  auto *in = static_cast<const uint8_t *>(sequence.sequence.raw_data());
+  sequence.wait(stream);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (int i = begin; i < sequence.count; i++) {
+    Key key(file, first_frame + i * stride);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      if (it->second->format == format) {
+        frames_.splice(frames_.begin(), frames_, it->second);
+        continue;
+      }
+      Evict(it->second);
+    }
+    MakeRoom(frame_size);
+    frames_.emplace_front(key, format, frame_size);
+    auto &frame = frames_.front();
+    frame.data = mm::alloc_raw_unique<uint8_t, mm::memory_kind::device>(frame_size);
+    frame.event = CUDAEvent::CreateWithFlags(cudaEventDisableTiming);
+    frame.timestamp = sequence.timestamps[i];
+    CUDA_CALL(cudaMemcpyAsync(frame.data.get(), in + i * frame_size, frame_size,
+                              cudaMemcpyDeviceToDevice, stream));
+    CUDA_CALL(cudaEventRecord(frame.event, stream));
+    index_.emplace(std::move(key), frames_.begin());
+    used_ += frame_size;
+  }
+}
+
+void VideoFrameCache::MakeRoom(size_t size) {
+  while (!frames_.empty() && used_ + size > capacity_)
+    Evict(std::prev(frames_.end()));
+}
+
+void VideoFrameCache::Evict(std::list<Frame>::iterator frame) {
+  // the copies issued to other streams may still use the memory
+  CUDA_CALL(cudaEventSynchronize(frame->event));
+  used_ -= frame->size;
+  index_.erase(frame->key);
+  frames_.erase(frame);
+}
+
+}  // namespace dali
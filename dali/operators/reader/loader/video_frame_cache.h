@@ -0,0 +1,117 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_OPERATORS_READER_LOADER_VIDEO_FRAME_CACHE_H_
+#define DALI_OPERATORS_READER_LOADER_VIDEO_FRAME_CACHE_H_
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "dali/core/common.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/mm/memory.h"
+#include "dali/operators/reader/nvdecoder/sequencewrapper.h"
+
+namespace dali {
+
+/**
+ * @brief A cache of the decoded (converted) frames, shared by the decoders of the video loader
+ *
+ * When the sequences overlap (`step` smaller than the sequence extent), the frames which
+ * are also a part of the upcoming sequences are kept in the GPU memory, so that they're
+ * copied instead of being decoded again. When the capacity is exceeded, the least recently
+ * used frames are evicted.
+ *
+ * The frames are copied with the stream passed by the caller. Each frame has an event, recorded
+ * after every copy to or from it, so the accesses from different streams are ordered and
+ * the memory of an evicted frame is released only when it's no longer in use.
+ */
+class VideoFrameCache {
+ public:
+  explicit VideoFrameCache(size_t capacity) : capacity_(capacity) {}
+  ~VideoFrameCache();
+
+  VideoFrameCache(const VideoFrameCache &) = delete;
+  VideoFrameCache &operator=(const VideoFrameCache &) = delete;
+
+  /**
+   * @brief Copies the leading frames of the sequence which are in the cache
+   *
+   * The frames `first_frame`, `first_frame + stride`, ... of `file` are looked up until the first
+   * one which is missing or was decoded to a different format. Their timestamps are appended
+   * to the sequence.
+   *
+   * @return the number of frames copied
+   */
+  int Get(const std::string &file, int first_frame, int stride, SequenceWrapper &sequence,
+          cudaStream_t stream);
+
+  /**
+   * @brief Adds the frames `begin`...`sequence.count - 1` of the sequence, which starts with
+   *        the frame `first_frame` of `file`, to the cache
+   *
+   * The copies wait for the sequence to be decoded.
+   */
+  void Put(const std::string &file, int first_frame, int stride, int begin,
+           const SequenceWrapper &sequence, cudaStream_t stream);
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+ private:
+  /// The parameters of the sequence which affect the contents of the frames
+  struct FrameFormat {
+    explicit FrameFormat(const SequenceWrapper &sequence);
+    bool operator==(const FrameFormat &other) const;
+
+    int height, width, channels;
+    DALIDataType dtype;
+    bool resize_frames;
+    float roi_x0, roi_y0, roi_x1, roi_y1;
+  };
+
+  using Key = std::pair<std::string, int>;
+
+  struct Frame {
+    Frame(Key key, const FrameFormat &format, size_t size)
+        : key(std::move(key)), format(format), size(size) {}
+
+    Key key;
+    FrameFormat format;
+    size_t size;
+    double timestamp = 0;
+    mm::uptr<uint8_t> data;
+    CUDAEvent event;
+  };
+
+  /// Evicts the least recently used frames until `size` more bytes fit in the cache
+  void MakeRoom(size_t size);
+  void Evict(std::list<Frame>::iterator frame);
+
+  size_t capacity_;
+  size_t used_ = 0;
+  std::mutex mutex_;
+  /// The most recently used frames go first
+  std::list<Frame> frames_;
+  std::map<Key, std::list<Frame>::iterator> index_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_VIDEO_FRAME_CACHE_H_
@@ -24,6 +24,8 @@
 #include <limits>
 #include <sstream>
 
+#include "dali/pipeline/data/types.h"
+
 
 inline int gcd(int a, int b) {
   while (b) {
@@ -264,8 +266,8 @@ static int64_t seek_file(void *opaque, int64_t offset, int whence) {
   }
 }
 
-VideoFile& VideoLoader::get_or_open_file(const std::string &filename) {
-  auto& file = open_files_[filename];
+VideoFile& VideoLoader::get_or_open_file(VideoDecodeLane &lane, const std::string &filename) {
+  auto& file = lane.open_files[filename];
 
   if (file.empty()) {
     file.file_desc.filename = filename;
@@ -459,15 +461,15 @@ VideoFile& VideoLoader::get_or_open_file(const std::string &filename) {
     }
   }
   // close the previous file if there was any open
-  if (last_opened_.size() && last_opened_ != filename) {
-    auto& old_file = open_files_[last_opened_];
+  if (lane.last_opened.size() && lane.last_opened != filename) {
+    auto& old_file = lane.open_files[lane.last_opened];
     if (old_file.file_desc.file_stream) {
       old_file.file_desc.file_position = ftell(old_file.file_desc.file_stream);
       fclose(old_file.file_desc.file_stream);
       old_file.file_desc.file_stream = nullptr;
     }
   }
-  last_opened_ = filename;
+  lane.last_opened = filename;
   return file;
 }
 
@@ -495,25 +497,25 @@ void VideoLoader::seek(VideoFile& file, int frame) {
     // starting.
 }
 
-void VideoLoader::read_file() {
+void VideoLoader::read_file(VideoDecodeLane &lane) {
   // av_packet_unref is unlike the other libav free functions
   using pkt_ptr = std::unique_ptr<AVPacket, decltype(&av_packet_unref)>;
   AVPacket raw_pkt = {};
 
-  auto req = send_queue_.pop();
+  auto req = lane.send_queue.pop();
 
   LOG_LINE << "Got a request for " << req.filename << " frame " << req.frame
-            << " count " << req.count << " send_queue_ has " << send_queue_.size()
+            << " count " << req.count << " send_queue has " << lane.send_queue.size()
             << " frames left" << std::endl;
 
 
 
-  auto& file = get_or_open_file(req.filename);
+  auto& file = get_or_open_file(lane, req.filename);
   auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
   req.frame_base = file.frame_base_;
 
-  if (vid_decoder_) {
-      vid_decoder_->push_req(req);
+  if (lane.vid_decoder) {
+      lane.vid_decoder->push_req(req);
   } else {
       DALI_FAIL("No video decoder even after opening a file");
   }
@@ -540,8 +542,8 @@ void VideoLoader::read_file() {
   while (av_read_frame(file.fmt_ctx_.get(), &raw_pkt) >= 0) {
     auto pkt = pkt_ptr(&raw_pkt, av_packet_unref);
 
-    stats_.bytes_read += pkt->size;
-    stats_.packets_read++;
+    lane.stats.bytes_read += pkt->size;
+    lane.stats.packets_read++;
 
     if (pkt->stream_index != file.vid_stream_idx_) {
         continue;
@@ -613,8 +615,8 @@ void VideoLoader::read_file() {
                 << " nonkey_frame_count = " << nonkey_frame_count
                 << std::endl;
 
-    stats_.bytes_decoded += pkt->size;
-    stats_.packets_decoded++;
+    lane.stats.bytes_decoded += pkt->size;
+    lane.stats.packets_decoded++;
 
     if (file.bsf_ctx_ && pkt->size > 0) {
       int ret;
@@ -626,8 +628,8 @@ void VideoLoader::read_file() {
       }
       while ((ret = av_bsf_receive_packet(file.bsf_ctx_.get(), &raw_filtered_pkt)) == 0) {
         auto fpkt = pkt_ptr(&raw_filtered_pkt, av_packet_unref);
-        dec_status = vid_decoder_->decode_packet(fpkt.get(), file.start_time_, file.stream_base_,
-                                    codecpar(stream));
+        dec_status = lane.vid_decoder->decode_packet(fpkt.get(), file.start_time_,
+                                                     file.stream_base_, codecpar(stream));
       }
       if (ret != AVERROR(EAGAIN)) {
         DALI_FAIL(std::string("BSF receive packet failed:") + av_err2str(ret));
@@ -664,11 +666,11 @@ void VideoLoader::read_file() {
         }
         *pkt.get() = fpkt;
       }
-      dec_status = vid_decoder_->decode_packet(pkt.get(), file.start_time_, file.stream_base_,
+      dec_status = lane.vid_decoder->decode_packet(pkt.get(), file.start_time_, file.stream_base_,
                                   codecpar(stream));
 #endif
     } else {
-      dec_status = vid_decoder_->decode_packet(pkt.get(), file.start_time_, file.stream_base_,
+      dec_status = lane.vid_decoder->decode_packet(pkt.get(), file.start_time_, file.stream_base_,
                                   codecpar(stream));
     }
     is_first_frame = false;
@@ -683,38 +685,37 @@ void VideoLoader::read_file() {
   }
 
   // flush the decoder
-  vid_decoder_->decode_packet(nullptr, 0, {0}, 0);
+  lane.vid_decoder->decode_packet(nullptr, 0, {0}, 0);
 }
 
-void VideoLoader::push_sequence_to_read(std::string filename, int frame, int count) {
+void VideoLoader::push_sequence_to_read(VideoDecodeLane &lane, std::string filename, int frame,
+                                        int count) {
     int total_count = 1 + (count - 1) * stride_;
     auto req = FrameReq{std::move(filename), frame, total_count, stride_, {0, 0}};
     // give both reader thread and decoder a copy of what is coming
-    send_queue_.push(req);
+    lane.send_queue.push(req);
 }
 
-void VideoLoader::receive_frames(SequenceWrapper& sequence) {
+void VideoLoader::receive_frames(VideoDecodeLane &lane, SequenceWrapper& sequence, int first) {
   auto startup_timeout = 1000;
-  while (!vid_decoder_) {
+  while (!lane.vid_decoder) {
     usleep(500);
     if (startup_timeout-- == 0) {
       DALI_FAIL("Timeout waiting for a valid decoder");
     }
   }
-  vid_decoder_->receive_frames(sequence);
+  lane.vid_decoder->receive_frames(sequence, first);
 
   // Stats code
-  stats_.frames_used += sequence.count;
+  lane.stats.frames_used += sequence.count - first;
 
-  static auto frames_since_warn = 0;
-  static auto frames_used_warned = false;
-  frames_since_warn += sequence.count;
-  auto ratio_used = static_cast<float>(stats_.packets_decoded) / stats_.frames_used;
+  lane.frames_since_warn += sequence.count - first;
+  auto ratio_used = static_cast<float>(lane.stats.packets_decoded) / lane.stats.frames_used;
   if (ratio_used > frames_used_warning_ratio &&
-      frames_since_warn > (frames_used_warned ? frames_used_warning_interval :
-                            frames_used_warning_minimum)) {
-    frames_since_warn = 0;
-    frames_used_warned = true;
+      lane.frames_since_warn > (lane.frames_used_warned ? frames_used_warning_interval :
+                                frames_used_warning_minimum)) {
+    lane.frames_since_warn = 0;
+    lane.frames_used_warned = true;
     LOG_LINE << "\e[1mThe video loader is performing suboptimally due to reading "
              << std::setprecision(2) << ratio_used << "x as many packets as "
              << "frames being used.\e[0m  Consider reencoding the video with a "
@@ -724,20 +725,83 @@ void VideoLoader::receive_frames(SequenceWrapper& sequence) {
 
 void VideoLoader::PrepareEmpty(SequenceWrapper &tensor) {}
 
+namespace {
+
+/**
+ * @brief Zeroes the frames after sequence.count (done by the decoder, when it decodes any frame)
+ */
+void pad_sequence(SequenceWrapper &sequence, cudaStream_t stream) {
+  if (sequence.count >= sequence.max_count)
+    return;
+  size_t frame_size =
+      volume(sequence.frame_shape()) * TypeTable::GetTypeInfo(sequence.dtype).size();
+  auto *data = static_cast<uint8_t *>(sequence.sequence.raw_mutable_data());
+  CUDA_CALL(cudaMemsetAsync(data + sequence.count * frame_size, 0,
+                            (sequence.max_count - sequence.count) * frame_size, stream));
+}
+
+}  // namespace
+
+VideoDecodeLane &VideoLoader::AcquireLane() {
+  std::unique_lock<std::mutex> lock(lanes_mutex_);
+  lane_freed_.wait(lock, [&]() { return !free_lanes_.empty(); });
+  int idx = free_lanes_.back();
+  free_lanes_.pop_back();
+  return *lanes_[idx];
+}
+
+void VideoLoader::ReleaseLane(VideoDecodeLane &lane) {
+  {
+    std::lock_guard<std::mutex> lock(lanes_mutex_);
+    for (size_t i = 0; i < lanes_.size(); i++) {
+      if (lanes_[i].get() == &lane)
+        free_lanes_.push_back(i);
+    }
+  }
+  lane_freed_.notify_one();
+}
+
 void VideoLoader::ReadSample(SequenceWrapper& tensor) {
     // TODO(spanev) remove the async between the 2 following methods?
     auto& seq_meta = frame_starts_[current_frame_idx_];
     tensor.initialize(seq_meta.length, count_, seq_meta.height, seq_meta.width, channels_, dtype_);
+    if (frame_resize_)
+      frame_resize_(tensor);
 
     tensor.read_sample_f = [this,
                             file_name = file_info_[seq_meta.filename_idx].video_file,
                             index = seq_meta.frame_idx, count = seq_meta.length, &tensor] () {
-      thread_file_reader_.DoWork([this]() {
-        read_file();
-      });
-      push_sequence_to_read(file_name, index, count);
-      receive_frames(tensor);
-      thread_file_reader_.WaitForWork();
+      // the sequence goes to whichever decoder gets free first
+      auto &lane = AcquireLane();
+      try {
+        // the leading frames may be shared with the previous sequence
+        int cached = 0;
+        if (frame_cache_)
+          cached = frame_cache_->Get(file_name, index, stride_, tensor, lane.cache_stream);
+        if (cached < count) {
+          lane.thread_file_reader.DoWork([this, &lane]() {
+            read_file(lane);
+          });
+          push_sequence_to_read(lane, file_name, index + cached * stride_, count - cached);
+          receive_frames(lane, tensor, cached);
+          lane.thread_file_reader.WaitForWork();
+          if (frame_cache_) {
+            // keep the frames which are a part of the next sequence
+            int next_first = (step_ + stride_ - 1) / stride_;
+            frame_cache_->Put(file_name, index, stride_, next_first, tensor, lane.cache_stream);
+            // the sequence event covers only the decoded frames, and the sequence can be
+            // overwritten by the next decoding only when the copies are done
+            CUDA_CALL(cudaStreamSynchronize(lane.cache_stream));
+          }
+        } else {
+          pad_sequence(tensor, lane.cache_stream);
+          tensor.set_started(lane.cache_stream);
+        }
+      } catch (...) {
+        ReleaseLane(lane);
+        throw;
+      }
+      ReleaseLane(lane);
     };
     ++current_frame_idx_;
 
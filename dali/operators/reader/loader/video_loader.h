@@ -25,7 +25,10 @@ extern "C" {
 }
 
 #include <algorithm>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <random>
 #include <string>
 #include <thread>
@@ -36,6 +39,7 @@ extern "C" {
 
 #include "dali/core/common.h"
 #include "dali/operators/reader/loader/loader.h"
+#include "dali/operators/reader/loader/video_frame_cache.h"
 #include "dali/operators/reader/nvdecoder/nvdecoder.h"
 #include "dali/operators/reader/nvdecoder/sequencewrapper.h"
 #include "dali/pipeline/util/worker_thread.h"
@@ -135,6 +139,32 @@ struct VideoLoaderStats {
   uint64_t frames_used;
 };
 
+/**
+ * @brief A decoder with its own file reading thread, request queue and open files
+ *
+ * The loader keeps a pool of lanes, which decode different sequences at the same time, so that
+ * all the NVDEC engines of the GPU can be used.
+ */
+struct VideoDecodeLane {
+  explicit VideoDecodeLane(int device_id)
+      : thread_file_reader(device_id, false, "Video read_file thread") {}
+
+  std::unordered_map<std::string, VideoFile> open_files;
+  std::string last_opened;
+  std::unique_ptr<NvDecoder> vid_decoder;
+
+  ThreadSafeQueue<FrameReq> send_queue;
+
+  WorkerThread thread_file_reader;
+
+  /// Used for the copies to and from the frame cache
+  CUDAStreamLease cache_stream;
+
+  VideoLoaderStats stats = {0, 0, 0, 0, 0};
+  int frames_since_warn = 0;
+  bool frames_used_warned = false;
+};
+
 struct sequence_meta {
   size_t filename_idx;
   int frame_idx;
@@ -168,13 +198,18 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
       file_list_include_preceding_frame_(
         spec.GetArgument<bool>("file_list_include_preceding_frame")),
       pad_sequences_(spec.GetArgument<bool>("pad_sequences")),
-      stats_({0, 0, 0, 0, 0}),
-      thread_file_reader_(device_id_, false, "Video read_file thread"),
       current_frame_idx_(-1),
       stop_(false) {
     DALI_ENFORCE(stride_ > 0, "Stride should be > 0");
+    int num_decoders = spec.GetArgument<int>("num_decoders");
+    DALI_ENFORCE(num_decoders > 0, "The number of decoders should be > 0");
     if (step_ < 0)
       step_ = count_ * stride_;
+    auto frame_cache_size = spec.GetArgument<int64_t>("frame_cache_size");
+    DALI_ENFORCE(frame_cache_size >= 0, "The frame cache size should be >= 0");
+    // the cache is useful only when the consecutive sequences share frames
+    if (frame_cache_size > 0 && step_ < 1 + (count_ - 1) * stride_)
+      frame_cache_ = std::make_unique<VideoFrameCache>(frame_cache_size);
     if (!file_list_include_preceding_frame_) {
       DALI_WARN("``file_list_include_preceding_frame`` is set to False (or not set at all). In "
                 "future releases, the default behavior would be changed to True.");
@@ -193,27 +228,56 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
       "to https://github.com/NVIDIA/nvidia-docker/wiki/Usage");
 
       av_log_set_level(AV_LOG_ERROR);
-      thread_file_reader_.WaitForInit();
+      for (int i = 0; i < num_decoders; i++) {
+        lanes_.push_back(std::make_unique<VideoDecodeLane>(device_id_));
+        lanes_.back()->thread_file_reader.WaitForInit();
+        if (frame_cache_)
+          lanes_.back()->cache_stream = CUDAStreamPool::instance().Get(device_id_);
+        free_lanes_.push_back(i);
+      }
   }
 
   ~VideoLoader() noexcept override {
     stop_ = true;
-    send_queue_.shutdown();
-    if (vid_decoder_) {
-      vid_decoder_->finish();
+    for (auto &lane : lanes_) {
+      lane->send_queue.shutdown();
+      if (lane->vid_decoder) {
+        lane->vid_decoder->finish();
+      }
+      lane->thread_file_reader.ForceStop();
+      lane->thread_file_reader.Shutdown();
     }
-    thread_file_reader_.ForceStop();
-    thread_file_reader_.Shutdown();
   }
 
   void PrepareEmpty(SequenceWrapper &tensor) override;
   void ReadSample(SequenceWrapper &tensor) override;
 
-  VideoFile& get_or_open_file(const std::string &filename);
+  VideoFile& get_or_open_file(VideoDecodeLane &lane, const std::string &filename);
   void seek(VideoFile& file, int frame);
-  void read_file();
-  void push_sequence_to_read(std::string filename, int frame, int count);
-  void receive_frames(SequenceWrapper& sequence);
+  void read_file(VideoDecodeLane &lane);
+  void push_sequence_to_read(VideoDecodeLane &lane, std::string filename, int frame, int count);
+  void receive_frames(VideoDecodeLane &lane, SequenceWrapper& sequence, int first = 0);
+
+  /**
+   * @brief The number of sequences which can be decoded at the same time
+   *
+   * The read_sample_f functions of that many samples can be called concurrently.
+   */
+  int num_decoders() const {
+    return lanes_.size();
+  }
+
+  /**
+   * @brief Sets the function which chooses the output size and the source region of the frames
+   * of each sequence (see SequenceWrapper::resize_frames), so that the frames are resized while
+   * they are decoded.
+   *
+   * The function is called from ReadSample, after the sequence is initialized with the size of
+   * the video.
+   */
+  void SetFrameResize(std::function<void(SequenceWrapper &)> frame_resize) {
+    frame_resize_ = std::move(frame_resize);
+  }
 
  protected:
   Index SizeImpl() override;
@@ -222,7 +286,7 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
     int total_count = 1 + (count_ - 1) * stride_;
 
     for (size_t i = 0; i < file_info_.size(); ++i) {
-      const auto& file = get_or_open_file(file_info_[i].video_file);
+      const auto& file = get_or_open_file(*lanes_[0], file_info_[i].video_file);
       const auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
       int frame_count = file.frame_count_;
 
@@ -310,17 +374,19 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
                  "length.");
 
 
-    const auto& file = get_or_open_file(file_info_[0].video_file);
-    auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
+    for (auto &lane : lanes_) {
+      const auto& file = get_or_open_file(*lane, file_info_[0].video_file);
+      auto stream = file.fmt_ctx_->streams[file.vid_stream_idx_];
 
-    vid_decoder_ = std::make_unique<NvDecoder>(device_id_,
-                                               codecpar(stream),
-                                               image_type_,
-                                               dtype_,
-                                               normalized_,
-                                               ALIGN16(max_height_),
-                                               ALIGN16(max_width_),
-                                               additional_decode_surfaces_);
+      lane->vid_decoder = std::make_unique<NvDecoder>(device_id_,
+                                                      codecpar(stream),
+                                                      image_type_,
+                                                      dtype_,
+                                                      normalized_,
+                                                      ALIGN16(max_height_),
+                                                      ALIGN16(max_width_),
+                                                      additional_decode_surfaces_);
+    }
 
     if (shuffle_) {
       // TODO(spanev) decide of a policy for multi-gpu here and SequenceLoader
@@ -334,6 +400,10 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
   }
 
  private:
+  /// Waits until one of the lanes is free and takes it
+  VideoDecodeLane &AcquireLane();
+  void ReleaseLane(VideoDecodeLane &lane);
+
   void Reset(bool wrap_to_shard) override {
     if (wrap_to_shard) {
       current_frame_idx_ = start_index(shard_id_, num_shards_, SizeImpl());
@@ -365,15 +435,15 @@ class VideoLoader : public Loader<GPUBackend, SequenceWrapper> {
   bool file_list_frame_num_;
   bool file_list_include_preceding_frame_;
   bool pad_sequences_;
-  VideoLoaderStats stats_;
-
-  std::unordered_map<std::string, VideoFile> open_files_;
-  std::string last_opened_;
-  std::unique_ptr<NvDecoder> vid_decoder_;
 
-  ThreadSafeQueue<FrameReq> send_queue_;
+  std::function<void(SequenceWrapper &)> frame_resize_;
+  /// Keeps the frames shared by the overlapping sequences; null if not used
+  std::unique_ptr<VideoFrameCache> frame_cache_;
 
-  WorkerThread thread_file_reader_;
+  std::vector<std::unique_ptr<VideoDecodeLane>> lanes_;
+  std::vector<int> free_lanes_;
+  std::mutex lanes_mutex_;
+  std::condition_variable lane_freed_;
 
   std::vector<struct sequence_meta> frame_starts_;
   Index current_frame_idx_;
@@ -0,0 +1,172 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/loader/webdataset/index_cache.h"
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "dali/core/error_handling.h"
+
+namespace dali {
+namespace detail {
+namespace wds {
+
+namespace {
+
+bool StatFile(const std::string &filename, int64_t &size, int64_t &mtime_ns) {
+  struct stat st;
+  if (stat(filename.c_str(), &st) != 0)
+    return false;
+  size = st.st_size;
+  mtime_ns = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+  return true;
+}
+
+std::string AbsolutePath(const std::string &path) {
+  char buf[PATH_MAX];
+  if (realpath(path.c_str(), buf) == nullptr)
+    return path;
+  return buf;
+}
+
+// Creates the directory along with its parents
+void MakeDirs(const std::string &dir) {
+  for (size_t pos = dir.find('/', 1); ; pos = dir.find('/', pos + 1)) {
+    auto parent = dir.substr(0, pos);
+    if (mkdir(parent.c_str(), 0755) != 0 && errno != EEXIST)
+      DALI_FAIL(make_string("Failed to create the index cache directory ", parent, ": ",
+                            std::strerror(errno)));
+    if (pos == std::string::npos)
+      break;
+  }
+}
+
+// The names and the extensions are separated with whitespace in the index file
+bool IsValidToken(const std::string &s) {
+  if (s.empty())
+    return false;
+  for (char c : s) {
+    if (std::isspace(static_cast<unsigned char>(c)))
+      return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+IndexCache::IndexCache(const std::string &cache_dir)
+    : cache_dir_(cache_dir.empty() ? DefaultDir() : cache_dir) {
+  MakeDirs(cache_dir_);
+}
+
+std::string IndexCache::DefaultDir() {
+  const char *xdg_cache = getenv("XDG_CACHE_HOME");
+  if (xdg_cache && xdg_cache[0])
+    return make_string(xdg_cache, "/dali/webdataset_index");
+  const char *home = getenv("HOME");
+  DALI_ENFORCE(home && home[0], "Cannot determine the user cache directory - please specify "
+               "``index_cache_dir``.");
+  return make_string(home, "/.cache/dali/webdataset_index");
+}
+
+std::string IndexCache::IndexPath(const std::string &archive_path) const {
+  std::stringstream ss;
+  ss << cache_dir_ << "/" << std::hex << std::setw(16) << std::setfill('0')
+     << std::hash<std::string>()(archive_path) << ".idx";
+  return ss.str();
+}
+
+std::string IndexCache::Find(const std::string &archive_path) const {
+  auto path = AbsolutePath(archive_path);
+  int64_t file_size, mtime_ns;
+  if (!StatFile(path, file_size, mtime_ns))
+    return {};
+  auto index_path = IndexPath(path);
+  std::ifstream in(index_path);
+  if (!in)
+    return {};
+  std::string header;
+  std::getline(in, header);
+  std::stringstream header_stream(header);
+  std::string version, stored_path;
+  int64_t num_samples, stored_size, stored_mtime_ns;
+  if (!(header_stream >> version >> num_samples >> stored_size >> stored_mtime_ns) ||
+      version != kCurrentIndexVersion || stored_size != file_size || stored_mtime_ns != mtime_ns)
+    return {};
+  // different paths can have the same hash
+  header_stream.get();
+  std::getline(header_stream, stored_path);
+  if (stored_path != path)
+    return {};
+  return index_path;
+}
+
+void IndexCache::Store(const std::string &archive_path, std::vector<SampleDesc> &samples) const {
+  auto path = AbsolutePath(archive_path);
+  int64_t file_size, mtime_ns;
+  if (samples.empty() || !StatFile(path, file_size, mtime_ns))
+    return;
+  // such an index couldn't be read back
+  for (auto &sample : samples) {
+    if (sample.components.num == 0)
+      return;
+    for (auto &component : sample.components) {
+      if (!IsValidToken(component.ext) || !IsValidToken(component.filename))
+        return;
+    }
+  }
+
+  // Other processes may read the index at the same time - write the whole file first
+  // and then move it in place
+  auto index_path = IndexPath(path);
+  static std::atomic<int> tmp_idx{0};
+  auto tmp_path = make_string(index_path, ".", getpid(), ".", tmp_idx++, ".tmp");
+  {
+    std::ofstream out(tmp_path, std::ios::trunc);
+    out << kCurrentIndexVersion << ' ' << samples.size() << ' ' << file_size << ' ' << mtime_ns
+        << ' ' << path << '\n';
+    for (auto &sample : samples) {
+      const char *sep = "";
+      for (auto &component : sample.components) {
+        out << sep << component.ext << ' ' << component.offset << ' ' << component.size << ' '
+            << component.filename;
+        sep = " ";
+      }
+      out << '\n';
+    }
+    if (!out) {
+      out.close();
+      remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (rename(tmp_path.c_str(), index_path.c_str()) != 0)
+    remove(tmp_path.c_str());
+}
+
+}  // namespace wds
+}  // namespace detail
+}  // namespace dali
@@ -0,0 +1,76 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_WEBDATASET_INDEX_CACHE_H_
+#define DALI_OPERATORS_READER_LOADER_WEBDATASET_INDEX_CACHE_H_
+
+#include <string>
+#include <vector>
+
+#include "dali/core/api_helper.h"
+#include "dali/operators/reader/loader/webdataset_loader.h"
+
+namespace dali {
+namespace detail {
+namespace wds {
+
+/**
+ * @brief Keeps the indices inferred from the webdataset archives, so that an archive is
+ *        scanned only once, and not in every run.
+ *
+ * The index of an archive is stored in a regular index file (see `index_paths`), with the size,
+ * the modification time and the path of the archive appended to its first line. It's valid as
+ * long as they match.
+ */
+class DLL_PUBLIC IndexCache {
+ public:
+  /**
+   * @brief Creates the cache in the given directory or, if it's empty, in the user cache
+   *        directory (DefaultDir). The directory is created, if needed.
+   */
+  explicit IndexCache(const std::string &cache_dir);
+
+  /**
+   * @brief Returns the path of the stored index of the archive or an empty string, if there's
+   *        no valid index for the archive in the cache
+   */
+  std::string Find(const std::string &archive_path) const;
+
+  /**
+   * @brief Stores the index of the archive.
+   *
+   * Failing to store the index is not an error - the index is built again in the next run.
+   */
+  void Store(const std::string &archive_path, std::vector<SampleDesc> &samples) const;
+
+  /**
+   * @brief `$XDG_CACHE_HOME/dali/webdataset_index`, or `~/.cache/dali/webdataset_index`
+   */
+  static std::string DefaultDir();
+
+  const std::string &Dir() const {
+    return cache_dir_;
+  }
+
+ private:
+  std::string IndexPath(const std::string &archive_path) const;
+
+  std::string cache_dir_;
+};
+
+}  // namespace wds
+}  // namespace detail
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_WEBDATASET_INDEX_CACHE_H_
@@ -13,16 +13,22 @@
 // limitations under the License.
 
 #include "dali/operators/reader/loader/webdataset_loader.h"
+#include <algorithm>
 #include <cstddef>
 #include <cstring>
 #include <limits>
 #include <memory>
+#include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
+#include "dali/operators/reader/loader/webdataset/index_cache.h"
 #include "dali/operators/reader/loader/webdataset/tar_utils.h"
 #include "dali/pipeline/data/types.h"
+#include "dali/pipeline/util/thread_pool.h"
+#include "dali/util/buffered_file.h"
 
 namespace dali {
 
@@ -201,7 +207,10 @@ WebdatasetLoader::WebdatasetLoader(const OpSpec& spec)
       paths_(spec.GetRepeatedArgument<std::string>("paths")),
       index_paths_(spec.GetRepeatedArgument<std::string>("index_paths")),
       missing_component_behavior_(detail::wds::ParseMissingExtBehavior(
-          spec.GetArgument<std::string>("missing_component_behavior"))) {
+          spec.GetArgument<std::string>("missing_component_behavior"))),
+      cache_index_(spec.GetArgument<bool>("cache_index")),
+      index_cache_dir_(spec.GetArgument<std::string>("index_cache_dir")),
+      num_index_threads_(std::max(1, spec.GetArgument<int>("num_threads"))) {
   DALI_ENFORCE(paths_.size() == index_paths_.size() || index_paths_.size() == 0,
                make_string("The number of index files, if any, must match the number of archives ",
                "in the dataset"));
@@ -236,6 +245,10 @@ WebdatasetLoader::WebdatasetLoader(const OpSpec& spec)
   }
   DALI_ENFORCE(ext_.size() == dtypes_.size(),
                "Number of extensions does not match the number of provided types");
+  thread_streams_.resize(num_read_threads_);
+  EnableGlobalShuffle();
+  EnableStreaming();
+  EnableBucketing();
 }
 
 WebdatasetLoader::~WebdatasetLoader() {}
@@ -250,26 +263,57 @@ void WebdatasetLoader::PrepareEmpty(vector<Tensor<CPUBackend>>& empty) {
 }
 
 std::string WebdatasetLoader::GetSampleSource(const detail::wds::SampleDesc& sample) {
-  if (generate_index_) {
+  const auto& index_source = index_sources_[sample.wds_shard_index];
+  if (index_source.empty()) {
     return make_string("tar file at \"", paths_[sample.wds_shard_index], '"');
   } else {
-    return make_string("index file at \"", index_paths_[sample.wds_shard_index], "\" line ",
-                       sample.line_number);
+    return make_string("index file at \"", index_source, "\" line ", sample.line_number);
   }
 }
 
 
 void WebdatasetLoader::ReadSample(vector<Tensor<CPUBackend>>& sample) {
+  if (streaming_) {
+    ReadStreamSample(sample);
+    return;
+  }
   MoveToNextShard(sample_index_);
-  detail::wds::SampleDesc& current_sample = samples_[sample_index_];
-  auto& current_wds_shard = wds_shards_[current_sample.wds_shard_index];
+  detail::wds::SampleDesc& current_sample = samples_[SampleIndex(sample_index_)];
+  ReadComponents(sample, current_sample, wds_shards_[current_sample.wds_shard_index]);
+  sample_index_++;
+}
 
+WebdatasetLoader::ReadWork WebdatasetLoader::PrepareRead(vector<Tensor<CPUBackend>>& sample) {
+  // Mapped data is just shared - there's nothing to read in parallel; a stream is read in order
+  if (!copy_read_data_ || streaming_) {
+    ReadSample(sample);
+    return {};
+  }
+  MoveToNextShard(sample_index_);
+  size_t sample_index = SampleIndex(sample_index_++);
+  return [this, &sample, sample_index](int thread_idx) {
+    detail::wds::SampleDesc& current_sample = samples_[sample_index];
+    // the threads can't share the streams, as reading moves the position
+    auto &thread_stream = thread_streams_[thread_idx];
+    if (!thread_stream.stream || thread_stream.wds_shard_index != current_sample.wds_shard_index) {
+      thread_stream.stream =
+          FileStream::Open(paths_[current_sample.wds_shard_index], read_ahead_, false,
+                           use_io_uring_, use_o_direct_, read_policy_);
+      thread_stream.wds_shard_index = current_sample.wds_shard_index;
+    }
+    ReadComponents(sample, current_sample, thread_stream.stream);
+  };
+}
+
+void WebdatasetLoader::ReadComponents(vector<Tensor<CPUBackend>>& sample,
+                                      detail::wds::SampleDesc& current_sample,
+                                      std::unique_ptr<FileStream>& current_wds_shard) {
   for (auto& component : current_sample.components) {
     // Checking if the component data from the index file agrees with reality
     DALI_ENFORCE(
         component.offset < static_cast<int64_t>(current_wds_shard->Size()),
-        IndexFileErrMsg(index_paths_[current_sample.wds_shard_index], current_sample.line_number,
-                        "offset is outside of the archive file"));
+        make_string("Error in ", GetSampleSource(current_sample),
+                    " - offset is outside of the archive file"));
 
     current_wds_shard->SeekRead(component.offset);
 
@@ -330,62 +374,89 @@ void WebdatasetLoader::ReadSample(vector<Tensor<CPUBackend>>& sample) {
     sample[empty_output].Reset();
     sample[empty_output].Resize({0}, dtypes_[empty_output]);
   }
-  sample_index_++;
 }
 
 Index WebdatasetLoader::SizeImpl() {
-  return samples_.size();
+  return streaming_ ? -1 : static_cast<Index>(samples_.size());
 }
 
 void WebdatasetLoader::PrepareMetadataImpl() {
+  // preparing the map from extensions to outputs
+  for (size_t output_index = 0; output_index < ext_.size(); output_index++) {
+    for (auto& ext : ext_[output_index]) {
+      ext_map_[ext].push_back(output_index);
+    }
+  }
+
+  dtype_sizes_.resize(dtypes_.size());
+  for (size_t i = 0; i < dtypes_.size(); i++) {
+    dtype_sizes_[i] = TypeTable::GetTypeInfo(dtypes_[i]).size();
+  }
+
+  if (streaming_) {
+    // the buffers are reused - the components are always copied
+    copy_read_data_ = true;
+    std::tie(stream_shards_begin_, stream_shards_end_) = StreamingFiles(paths_.size());
+    OpenStreamArchive(stream_shards_begin_);
+    return;
+  }
+
   if (!dont_use_mmap_) {
     mmap_reserver_ = FileStream::MappingReserver(static_cast<unsigned int>(paths_.size()));
   }
   copy_read_data_ = dont_use_mmap_ || !mmap_reserver_.CanShareMappedData();
 
   generate_index_ = index_paths_.size() == 0;
+  std::unique_ptr<detail::wds::IndexCache> index_cache;
+  std::vector<std::string> cached_indices(paths_.size());
   if (generate_index_) {
-    DALI_WARN("Index file not provided, it may take some time to infer it from the tar file");
+    size_t num_missing = paths_.size();
+    if (cache_index_) {
+      index_cache = std::make_unique<detail::wds::IndexCache>(index_cache_dir_);
+      for (size_t i = 0; i < paths_.size(); i++) {
+        cached_indices[i] = index_cache->Find(paths_[i]);
+        num_missing -= !cached_indices[i].empty();
+      }
+    }
+    if (num_missing > 0) {
+      DALI_WARN(make_string("Index file not provided for ", num_missing, " of ", paths_.size(),
+                            " archives, it may take some time to infer it from the tar files"));
+    }
   }
 
   // initializing all the readers
   wds_shards_.reserve(paths_.size());
   for (auto& uri : paths_) {
-    wds_shards_.emplace_back(FileStream::Open(uri, read_ahead_, !copy_read_data_));
+    wds_shards_.emplace_back(
+        FileStream::Open(uri, read_ahead_, !copy_read_data_, use_io_uring_, use_o_direct_,
+                         read_policy_));
   }
 
-  // preparing the map from extensions to outputs
-  std::unordered_map<std::string, std::vector<size_t>> ext_map;
-  for (size_t output_index = 0; output_index < ext_.size(); output_index++) {
-    for (auto& ext : ext_[output_index]) {
-      ext_map[ext].push_back(output_index);
+  // reading the indices - the archives without one are scanned in parallel
+  std::vector<std::vector<detail::wds::SampleDesc>> shard_samples(paths_.size());
+  std::vector<std::vector<detail::wds::ComponentDesc>> shard_components(paths_.size());
+  index_sources_.resize(paths_.size());
+  int num_index_threads = std::min<int>(num_index_threads_, paths_.size());
+  if (num_index_threads > 1) {
+    ThreadPool index_pool(num_index_threads, CPU_ONLY_DEVICE_ID, false, "Webdataset index");
+    for (size_t i = 0; i < paths_.size(); i++) {
+      index_pool.AddWork([&, i](int) {
+        ReadIndex(i, shard_samples[i], shard_components[i], cached_indices[i], index_cache.get());
+      });
     }
+    index_pool.RunAll();
+  } else {
+    for (size_t i = 0; i < paths_.size(); i++)
+      ReadIndex(i, shard_samples[i], shard_components[i], cached_indices[i], index_cache.get());
   }
 
-  // collecting and filtering the index files
-  std::vector<detail::wds::SampleDesc> unfiltered_samples;
-  std::vector<detail::wds::ComponentDesc> unfiltered_components;
+  // filtering the indices
   bitmask was_output_set;
   was_output_set.resize(ext_.size(), false);
   output_indicies_.reserve(ext_.size());
 
-  std::vector<size_t> dtype_sizes_(dtypes_.size());
-  for (size_t i = 0; i < dtypes_.size(); i++) {
-    dtype_sizes_[i] = TypeTable::GetTypeInfo(dtypes_[i]).size();
-  }
-
   for (size_t wds_shard_index = 0; wds_shard_index < paths_.size(); wds_shard_index++) {
-    unfiltered_samples.resize(0);
-    unfiltered_components.resize(0);
-    if (generate_index_) {
-      detail::wds::ParseTarFile(unfiltered_samples, unfiltered_components,
-                                wds_shards_[wds_shard_index]);
-    } else {
-      detail::wds::ParseIndexFile(unfiltered_samples, unfiltered_components,
-                                  index_paths_[wds_shard_index]);
-    }
-
-    for (auto& sample : unfiltered_samples) {
+    for (auto& sample : shard_samples[wds_shard_index]) {
       detail::wds::SampleDesc new_sample{
           detail::wds::VectorRange<detail::wds::ComponentDesc>(components_, components_.size()),
           detail::wds::VectorRange<size_t>(empty_outputs_, empty_outputs_.size()), wds_shard_index,
@@ -396,7 +467,7 @@ void WebdatasetLoader::PrepareMetadataImpl() {
       for (auto& component : sample.components) {
         component.outputs =
             detail::wds::VectorRange<size_t>(output_indicies_, output_indicies_.size());
-        for (auto& output : ext_map[component.ext]) {
+        for (auto& output : ext_map_[component.ext]) {
           if (!was_output_set[output]) {
             DALI_ENFORCE(component.size % dtype_sizes_[output] == 0,
                          make_string("Error in index file at ", GetSampleSource(new_sample),
@@ -443,12 +514,187 @@ void WebdatasetLoader::PrepareMetadataImpl() {
       }
       was_output_set.fill(false);
     }
+    shard_samples[wds_shard_index] = {};
+    shard_components[wds_shard_index] = {};
   }
   sample_index_ = start_index(shard_id_, num_shards_, samples_.size());
+  ShuffleSampleOrder();
+}
+
+void WebdatasetLoader::ReadIndex(size_t wds_shard_index,
+                                 std::vector<detail::wds::SampleDesc>& samples,
+                                 std::vector<detail::wds::ComponentDesc>& components,
+                                 const std::string& cached_index,
+                                 const detail::wds::IndexCache* index_cache) {
+  if (!generate_index_) {
+    index_sources_[wds_shard_index] = index_paths_[wds_shard_index];
+    detail::wds::ParseIndexFile(samples, components, index_paths_[wds_shard_index]);
+    return;
+  }
+  if (!cached_index.empty()) {
+    try {
+      detail::wds::ParseIndexFile(samples, components, cached_index);
+      index_sources_[wds_shard_index] = cached_index;
+      return;
+    } catch (const std::exception&) {
+      // a damaged index is just built again
+      samples.clear();
+      components.clear();
+    }
+  }
+  detail::wds::ParseTarFile(samples, components, wds_shards_[wds_shard_index]);
+  if (index_cache)
+    index_cache->Store(paths_[wds_shard_index], samples);
 }
 
 void WebdatasetLoader::Reset(bool wrap_to_shard) {
+  // a stream has no epoch boundaries - the archives of the shard are read over and over
+  if (streaming_)
+    return;
   sample_index_ = wrap_to_shard ? start_index(shard_id_, num_shards_, samples_.size()) : 0;
+  ShuffleSampleOrder();
+}
+
+double WebdatasetLoader::SampleSizeKey(Index index) {
+  size_t size = 0;
+  for (auto& component : samples_[index].components)
+    size += component.size;
+  return size;
+}
+
+void WebdatasetLoader::OpenStreamArchive(size_t wds_shard_index) {
+  auto file = FileStream::Open(paths_[wds_shard_index], read_ahead_, false, use_io_uring_,
+                               use_o_direct_, read_policy_);
+  stream_archive_ = std::make_unique<detail::TarArchive>(std::make_unique<BufferedFileStream>(
+      std::move(file), static_cast<size_t>(stream_buffer_size_) << 20));
+  stream_shard_index_ = wds_shard_index;
+}
+
+void WebdatasetLoader::ReadStreamSample(vector<Tensor<CPUBackend>>& sample) {
+  for (;;) {
+    auto& archive = *stream_archive_;
+    if (archive.EndOfArchive()) {
+      // go on with the next archive of the shard
+      size_t next = stream_shard_index_ + 1;
+      if (next == stream_shards_end_) {
+        DALI_ENFORCE(stream_samples_in_pass_ > 0, make_string(
+                     "No samples found in the archives of shard ", shard_id_,
+                     ", the first one being \"", paths_[stream_shards_begin_], '"'));
+        next = stream_shards_begin_;
+        stream_samples_in_pass_ = 0;
+      }
+      OpenStreamArchive(next);
+      continue;
+    }
+    if (archive.GetFileType() != detail::TarArchive::ENTRY_FILE) {
+      archive.NextFile();
+      continue;
+    }
+    if (ReadStreamComponents(sample)) {
+      stream_samples_in_pass_++;
+      return;
+    }
+  }
+}
+
+bool WebdatasetLoader::ReadStreamComponents(vector<Tensor<CPUBackend>>& sample) {
+  auto& archive = *stream_archive_;
+  const auto& path = paths_[stream_shard_index_];
+  std::string sample_name;
+  std::tie(sample_name, std::ignore) = detail::wds::split_name(archive.GetFileName());
+  if (sample_name.empty()) {
+    archive.NextFile();
+    return false;
+  }
+
+  std::vector<bool> was_output_set(ext_.size(), false);
+  size_t num_outputs_set = 0;
+  // the components of a sample are the consecutive files with the same name
+  for (; !archive.EndOfArchive(); archive.NextFile()) {
+    if (archive.GetFileType() != detail::TarArchive::ENTRY_FILE) {
+      continue;
+    }
+    std::string basename, ext;
+    std::tie(basename, ext) = detail::wds::split_name(archive.GetFileName());
+    if (basename != sample_name) {
+      break;
+    }
+    auto it = ext_map_.find(ext);
+    if (it == ext_map_.end()) {
+      continue;
+    }
+
+    const size_t size = archive.GetFileSize();
+    const int64_t offset = archive.TellArchive() + archive.HeaderSize();
+    const std::string sample_key = make_string_delim(':', path, offset, archive.GetFileName());
+    DALIMeta meta;
+    meta.SetSourceInfo(sample_key);
+    bool skip = ShouldSkipImage(sample_key);
+    meta.SetSkipSample(skip);
+
+    uint8_t* shared_tensor_data = nullptr;
+    bool shared_tensor_is_pinned = false;
+    int device_id = CPU_ONLY_DEVICE_ID;
+    for (auto output : it->second) {
+      if (was_output_set[output]) {
+        std::call_once(multiple_files_single_component, [&]() {
+          DALI_WARN(make_string("Multiple components matching output ", output,
+                                " at tar file at \"", path, "\"."));
+        });
+        continue;
+      }
+      DALI_ENFORCE(size % dtype_sizes_[output] == 0,
+                   make_string("Error in tar file at \"", path, "\" - component ",
+                               archive.GetFileName(), " size and dtype incompatible"));
+      was_output_set[output] = true;
+      num_outputs_set++;
+      auto& tensor = sample[output];
+      if (skip) {
+        tensor.Reset();
+        tensor.SetMeta(meta);
+        tensor.Resize({0}, dtypes_[output]);
+        continue;
+      }
+      TensorShape<> shape{static_cast<int64_t>(size / dtype_sizes_[output])};
+      if (!shared_tensor_data) {
+        if (tensor.shares_data()) {
+          tensor.Reset();
+        }
+        tensor.Resize(shape, dtypes_[output]);
+        shared_tensor_data = reinterpret_cast<uint8_t*>(tensor.raw_mutable_data());
+        shared_tensor_is_pinned = tensor.is_pinned();
+        device_id = tensor.device_id();
+      } else {
+        tensor.ShareData(shared_tensor_data, size, shared_tensor_is_pinned, shape,
+                         dtypes_[output], device_id);
+      }
+      tensor.SetMeta(meta);
+    }
+    if (shared_tensor_data) {
+      DALI_ENFORCE(archive.Read(shared_tensor_data, size) == size,
+                   "Error reading from a file " + path);
+    }
+  }
+
+  if (num_outputs_set < ext_.size()) {
+    switch (missing_component_behavior_) {
+      case detail::wds::MissingExtBehavior::Skip:
+        return false;
+      case detail::wds::MissingExtBehavior::Raise:
+        DALI_FAIL(make_string("Underful sample detected at tar file at \"", path, "\", sample ",
+                              sample_name));
+        break;
+      default:
+        for (size_t output = 0; output < ext_.size(); output++) {
+          if (!was_output_set[output]) {
+            sample[output].Reset();
+            sample[output].Resize({0}, dtypes_[output]);
+          }
+        }
+        break;
+    }
+  }
+  return true;
 }
 
 }  // namespace dali
@@ -30,8 +30,13 @@
 
 namespace dali {
 namespace detail {
+
+class TarArchive;
+
 namespace wds {
 
+class IndexCache;
+
 const std::string kCurrentIndexVersion = "v1.2";  // NOLINT
 const std::unordered_set<std::string> kSupportedIndexVersions = {"v1.1", kCurrentIndexVersion};
 constexpr char kExtDelim = ';';
@@ -99,6 +104,8 @@ class DLL_PUBLIC WebdatasetLoader : public Loader<CPUBackend, vector<Tensor<CPUB
   Index SizeImpl() override;
   void PrepareMetadataImpl() override;
   void Reset(bool wrap_to_shard) override;
+  double SampleSizeKey(Index index) override;
+  ReadWork PrepareRead(std::vector<Tensor<CPUBackend>>& sample) override;
 
   std::vector<std::string> paths_;
   std::vector<std::string> index_paths_;
@@ -114,12 +121,52 @@ class DLL_PUBLIC WebdatasetLoader : public Loader<CPUBackend, vector<Tensor<CPUB
   std::vector<size_t> output_indicies_;  // indices of outputs that a component corresponds to
 
   std::vector<std::unique_ptr<FileStream>> wds_shards_;
+  // the archive opened by each of the I/O threads, when reading in parallel
+  struct ThreadStream {
+    size_t wds_shard_index = 0;
+    std::unique_ptr<FileStream> stream;
+  };
+  std::vector<ThreadStream> thread_streams_;
   size_t sample_index_ = 0;
   FileStream::MappingReserver mmap_reserver_;
   std::once_flag multiple_files_single_component;
 
-  bool generate_index_ = true;
+  // the index files of the archives; empty for the indices inferred from the archives
+  std::vector<std::string> index_sources_;
+  // storing the indices inferred from the archives (`cache_index`)
+  bool cache_index_ = true;
+  std::string index_cache_dir_;
+  // the number of threads scanning the archives without an index
+  int num_index_threads_ = 1;
+  /**
+   * @brief Reads or infers the index of the archive, trying the cache first
+   */
+  void ReadIndex(size_t wds_shard_index, std::vector<detail::wds::SampleDesc>& samples,
+                 std::vector<detail::wds::ComponentDesc>& components,
+                 const std::string& cached_index, const detail::wds::IndexCache* index_cache);
   std::string GetSampleSource(const detail::wds::SampleDesc& sample);
+  void ReadComponents(std::vector<Tensor<CPUBackend>>& sample,
+                      detail::wds::SampleDesc& current_sample,
+                      std::unique_ptr<FileStream>& current_wds_shard);
+
+  std::unordered_map<std::string, std::vector<size_t>> ext_map_;  // outputs of the extensions
+  std::vector<size_t> dtype_sizes_;
+
+  // Reading the archives of the shard one after another, without an index (`streaming`)
+  void OpenStreamArchive(size_t wds_shard_index);
+  void ReadStreamSample(std::vector<Tensor<CPUBackend>>& sample);
+  /**
+   * @brief Reads the components of the sample starting at the current entry of the archive
+   *
+   * @return false, if the sample was skipped (see `missing_component_behavior`)
+   */
+  bool ReadStreamComponents(std::vector<Tensor<CPUBackend>>& sample);
+
+  size_t stream_shards_begin_ = 0, stream_shards_end_ = 0;
+  size_t stream_shard_index_ = 0;
+  std::unique_ptr<detail::TarArchive> stream_archive_;
+  // the number of samples read from the archives since the first one was opened the last time
+  int64_t stream_samples_in_pass_ = 0;
 };
 
 }  // namespace dali
@@ -0,0 +1,231 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if ZLIB_ENABLED
+#include <zlib.h>
+#endif
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/operators/reader/loader/filesystem.h"
+#include "dali/operators/reader/loader/zarr_loader.h"
+#include "dali/pipeline/util/lookahead_parser.h"
+#include "dali/util/file.h"
+#include "dali/util/numpy.h"
+
+namespace dali {
+namespace zarr {
+
+namespace {
+
+constexpr const char kArrayMetadataFile[] = ".zarray";
+
+TensorShape<> ParseShape(detail::LookaheadParser &parser) {
+  TensorShape<> shape;
+  DALI_ENFORCE(parser.EnterArray(), "Expected an array of integers");
+  while (parser.NextArrayValue()) {
+    shape.shape.push_back(static_cast<int64_t>(parser.GetDouble()));
+  }
+  return shape;
+}
+
+double ParseFillValue(detail::LookaheadParser &parser) {
+  switch (parser.PeekType()) {
+    case rapidjson::kNullType:
+      parser.GetNull();
+      return 0;
+    case rapidjson::kNumberType:
+      return parser.GetDouble();
+    case rapidjson::kStringType: {
+      std::string value = parser.GetString();
+      if (value == "NaN")
+        return std::numeric_limits<double>::quiet_NaN();
+      if (value == "Infinity")
+        return std::numeric_limits<double>::infinity();
+      if (value == "-Infinity")
+        return -std::numeric_limits<double>::infinity();
+      DALI_FAIL(make_string("Unsupported fill value: \"", value, "\""));
+    }
+    default:
+      DALI_FAIL("Unsupported fill value");
+  }
+}
+
+Compressor ParseCompressor(detail::LookaheadParser &parser) {
+  if (parser.PeekType() == rapidjson::kNullType) {
+    parser.GetNull();
+    return Compressor::None;
+  }
+  DALI_ENFORCE(parser.EnterObject(), "Expected the compressor configuration");
+  std::string id;
+  while (const char *key = parser.NextObjectKey()) {
+    if (0 == std::strcmp(key, "id"))
+      id = parser.GetString();
+    else
+      parser.SkipValue();
+  }
+  if (id == "zlib")
+    return Compressor::Zlib;
+  if (id == "gzip")
+    return Compressor::Gzip;
+  DALI_FAIL(make_string("Unsupported compressor: \"", id, "\". Supported compressors are "
+                        "\"zlib\" and \"gzip\"."));
+}
+
+}  // namespace
+
+ArrayMetadata ParseArrayMetadata(std::string json) {
+  ArrayMetadata meta;
+  bool has_shape = false, has_chunks = false;
+  detail::LookaheadParser parser(&json[0]);
+  DALI_ENFORCE(parser.PeekType() == rapidjson::kObjectType, "Expected a JSON object");
+  parser.EnterObject();
+  while (const char *key = parser.NextObjectKey()) {
+    if (0 == std::strcmp(key, "zarr_format")) {
+      int format = parser.GetInt();
+      DALI_ENFORCE(format == 2, make_string("Unsupported Zarr format: ", format,
+                                            ". Only Zarr v2 arrays are supported."));
+    } else if (0 == std::strcmp(key, "shape")) {
+      meta.shape = ParseShape(parser);
+      has_shape = true;
+    } else if (0 == std::strcmp(key, "chunks")) {
+      meta.chunks = ParseShape(parser);
+      has_chunks = true;
+    } else if (0 == std::strcmp(key, "dtype")) {
+      DALI_ENFORCE(parser.PeekType() == rapidjson::kStringType,
+                   "Structured data types are not supported");
+      std::string dtype = parser.GetString();
+      DALI_ENFORCE(!dtype.empty() && (dtype[0] == '<' || dtype[0] == '|'),
+                   make_string("Unsupported data type: \"", dtype, "\". Only the little endian "
+                               "numeric types are supported."));
+      meta.type = numpy::TypeFromNumpyStr(dtype.substr(1)).id();
+    } else if (0 == std::strcmp(key, "compressor")) {
+      meta.compressor = ParseCompressor(parser);
+    } else if (0 == std::strcmp(key, "fill_value")) {
+      meta.fill_value = ParseFillValue(parser);
+    } else if (0 == std::strcmp(key, "order")) {
+      std::string order = parser.GetString();
+      DALI_ENFORCE(order == "C", make_string("Unsupported order: \"", order,
+                                             "\". Only the C order is supported."));
+    } else if (0 == std::strcmp(key, "filters")) {
+      DALI_ENFORCE(parser.PeekType() == rapidjson::kNullType, "Filters are not supported");
+      parser.GetNull();
+    } else if (0 == std::strcmp(key, "dimension_separator")) {
+      std::string separator = parser.GetString();
+      DALI_ENFORCE(separator == "." || separator == "/",
+                   make_string("Unsupported dimension separator: \"", separator, "\""));
+      meta.dimension_separator = separator[0];
+    } else {
+      parser.SkipValue();
+    }
+  }
+  DALI_ENFORCE(parser.IsValid(), "Invalid JSON");
+  DALI_ENFORCE(has_shape && has_chunks, "The shape and the chunks of the array are required");
+  DALI_ENFORCE(meta.type != DALI_NO_TYPE, "The data type of the array is required");
+  DALI_ENFORCE(meta.shape.sample_dim() == meta.chunks.sample_dim(),
+               make_string("The chunks ", meta.chunks, " don't match the shape of the array ",
+                           meta.shape));
+  for (int d = 0; d < meta.chunks.sample_dim(); d++)
+    DALI_ENFORCE(meta.chunks[d] > 0, make_string("Invalid chunks: ", meta.chunks));
+  return meta;
+}
+
+std::string ChunkKey(span<const int64_t> chunk_idx, char separator) {
+  // a 0D array has a single chunk
+  if (chunk_idx.empty())
+    return "0";
+  std::string key;
+  for (int d = 0; d < static_cast<int>(chunk_idx.size()); d++) {
+    if (d > 0)
+      key += separator;
+    key += std::to_string(chunk_idx[d]);
+  }
+  return key;
+}
+
+void DecompressChunk(Compressor compressor, span<const uint8_t> in, span<uint8_t> out,
+                     const std::string &path) {
+  if (compressor == Compressor::None) {
+    DALI_ENFORCE(in.size() == out.size(),
+                 make_string("The chunk \"", path, "\" has ", in.size(), " bytes, expected ",
+                             out.size(), "."));
+    std::memcpy(out.data(), in.data(), out.size());
+    return;
+  }
+#if ZLIB_ENABLED
+  z_stream stream = {};
+  // detects the zlib and the gzip headers
+  DALI_ENFORCE(inflateInit2(&stream, 15 + 32) == Z_OK, "Cannot initialize zlib");
+  stream.next_in = const_cast<uint8_t *>(in.data());
+  stream.avail_in = in.size();
+  stream.next_out = out.data();
+  stream.avail_out = out.size();
+  int ret = inflate(&stream, Z_FINISH);
+  int64_t decompressed = out.size() - stream.avail_out;
+  inflateEnd(&stream);
+  DALI_ENFORCE(ret == Z_STREAM_END && decompressed == static_cast<int64_t>(out.size()),
+               make_string("Cannot decompress the chunk \"", path, "\"."));
+#else
+  DALI_FAIL(make_string("Cannot decompress the chunk \"", path,
+                        "\": DALI was built without zlib."));
+#endif
+}
+
+}  // namespace zarr
+
+void ZarrLoader::ReadSample(ZarrArrayWrapper& target) {
+  auto filename = files_[current_index_++];
+
+  // handle wrap-around
+  MoveToNextShard(current_index_);
+
+  auto path = filesystem::join_path(file_root_, filename);
+  // the arrays can be given by their `.zarray` files (as listed with `file_filter`)
+  constexpr int kSuffixLen = sizeof(zarr::kArrayMetadataFile) - 1;
+  if (path.size() >= kSuffixLen &&
+      path.compare(path.size() - kSuffixLen, kSuffixLen, zarr::kArrayMetadataFile) == 0) {
+    path.resize(path.size() - kSuffixLen);
+    if (!path.empty() && path.back() == filesystem::dir_sep)
+      path.pop_back();
+  }
+
+  auto it = metadata_cache_.find(path);
+  if (it == metadata_cache_.end()) {
+    auto metadata_path = filesystem::join_path(path, zarr::kArrayMetadataFile);
+    auto file = FileStream::Open(metadata_path, false, false);
+    std::string json(file->Size(), '\0');
+    auto n_read = file->Read(reinterpret_cast<uint8_t *>(&json[0]), json.size());
+    file->Close();
+    DALI_ENFORCE(n_read == json.size(),
+                 make_string("Error reading from a file ", metadata_path));
+    try {
+      it = metadata_cache_.emplace(path, zarr::ParseArrayMetadata(std::move(json))).first;
+    } catch (const std::exception &e) {
+      DALI_FAIL(make_string("Failed to parse the Zarr array metadata \"", metadata_path, "\": ",
+                            e.what()));
+    }
+  }
+
+  target.path = path;
+  target.meta = it->second;
+  target.source_meta.SetSourceInfo(path);
+  target.source_meta.SetSkipSample(false);
+}
+
+}  // namespace dali
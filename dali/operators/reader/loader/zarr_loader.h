@@ -0,0 +1,115 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_LOADER_ZARR_LOADER_H_
+#define DALI_OPERATORS_READER_LOADER_ZARR_LOADER_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/core/span.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/operators/reader/loader/file_loader.h"
+#include "dali/pipeline/data/types.h"
+
+namespace dali {
+namespace zarr {
+
+enum class Compressor {
+  None,
+  Zlib,
+  Gzip
+};
+
+/**
+ * @brief The metadata of a Zarr (v2) array, read from its `.zarray` file
+ *
+ * Only the C order and the little endian types are supported.
+ */
+struct ArrayMetadata {
+  TensorShape<> shape;
+  TensorShape<> chunks;
+  DALIDataType type = DALI_NO_TYPE;
+  Compressor compressor = Compressor::None;
+  /// The value of the elements in the chunks which are not stored
+  double fill_value = 0;
+  char dimension_separator = '.';
+};
+
+/**
+ * @brief Parses the contents of a `.zarray` file
+ */
+DLL_PUBLIC ArrayMetadata ParseArrayMetadata(std::string json);
+
+/**
+ * @brief Returns the name of the chunk file, relative to the array directory
+ */
+DLL_PUBLIC std::string ChunkKey(span<const int64_t> chunk_idx, char separator);
+
+/**
+ * @brief Decompresses the contents of a chunk file to `out`, which has the size of the chunk
+ */
+DLL_PUBLIC void DecompressChunk(Compressor compressor, span<const uint8_t> in,
+                                span<uint8_t> out, const std::string &path);
+
+}  // namespace zarr
+
+/**
+ * @brief A Zarr array - only its metadata, the chunks are read by the operator
+ */
+struct ZarrArrayWrapper {
+  /// The directory of the array
+  std::string path;
+  zarr::ArrayMetadata meta;
+  DALIMeta source_meta;
+
+  DALIDataType get_type() const {
+    return meta.type;
+  }
+
+  const TensorShape<>& get_shape() const {
+    return meta.shape;
+  }
+
+  const DALIMeta& get_meta() const {
+    return source_meta;
+  }
+};
+
+/**
+ * @brief Lists the Zarr arrays and reads their metadata
+ *
+ * The arrays are given as the paths of their directories or of their `.zarray` files. As
+ * the metadata is tiny and doesn't change, it's parsed once per array.
+ */
+class ZarrLoader : public FileLoader<CPUBackend, ZarrArrayWrapper> {
+ public:
+  explicit ZarrLoader(const OpSpec& spec, bool shuffle_after_epoch = false)
+    : FileLoader(spec, shuffle_after_epoch) {}
+
+  void PrepareEmpty(ZarrArrayWrapper &target) override {
+    target = {};
+  }
+
+  void ReadSample(ZarrArrayWrapper& target) override;
+
+ private:
+  std::map<std::string, zarr::ArrayMetadata> metadata_cache_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_LOADER_ZARR_LOADER_H_
@@ -0,0 +1,93 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "dali/operators/reader/loader/zarr_loader.h"
+
+namespace dali {
+namespace zarr {
+
+TEST(ZarrLoaderTest, ParseArrayMetadata) {
+  auto meta = ParseArrayMetadata(R"code({
+    "chunks": [100, 50, 3],
+    "compressor": {"id": "zlib", "level": 1},
+    "dtype": "<u2",
+    "fill_value": 7,
+    "filters": null,
+    "order": "C",
+    "shape": [1000, 120, 3],
+    "zarr_format": 2
+  })code");
+  EXPECT_EQ(TensorShape<>(1000, 120, 3), meta.shape);
+  EXPECT_EQ(TensorShape<>(100, 50, 3), meta.chunks);
+  EXPECT_EQ(DALI_UINT16, meta.type);
+  EXPECT_EQ(Compressor::Zlib, meta.compressor);
+  EXPECT_EQ(7, meta.fill_value);
+  EXPECT_EQ('.', meta.dimension_separator);
+
+  meta = ParseArrayMetadata(R"code({
+    "chunks": [16, 16],
+    "compressor": null,
+    "dtype": "<f4",
+    "fill_value": "NaN",
+    "dimension_separator": "/",
+    "shape": [20, 30],
+    "zarr_format": 2
+  })code");
+  EXPECT_EQ(DALI_FLOAT, meta.type);
+  EXPECT_EQ(Compressor::None, meta.compressor);
+  EXPECT_TRUE(std::isnan(meta.fill_value));
+  EXPECT_EQ('/', meta.dimension_separator);
+}
+
+TEST(ZarrLoaderTest, ParseArrayMetadataUnsupported) {
+  EXPECT_THROW(ParseArrayMetadata(R"code({
+    "chunks": [10], "compressor": null, "dtype": "<f4", "order": "F", "shape": [20],
+    "zarr_format": 2
+  })code"), std::exception);
+  EXPECT_THROW(ParseArrayMetadata(R"code({
+    "chunks": [10], "compressor": {"id": "blosc"}, "dtype": "<f4", "shape": [20],
+    "zarr_format": 2
+  })code"), std::exception);
+  EXPECT_THROW(ParseArrayMetadata(R"code({
+    "chunks": [10], "compressor": null, "dtype": ">f4", "shape": [20], "zarr_format": 2
+  })code"), std::exception);
+  EXPECT_THROW(ParseArrayMetadata(R"code({
+    "chunks": [10, 10], "compressor": null, "dtype": "<f4", "shape": [20], "zarr_format": 2
+  })code"), std::exception);
+}
+
+TEST(ZarrLoaderTest, ChunkKey) {
+  std::vector<int64_t> idx0 = {};
+  std::vector<int64_t> idx3 = {1, 2, 3};
+  EXPECT_EQ("0", ChunkKey(make_cspan(idx0), '.'));
+  EXPECT_EQ("1.2.3", ChunkKey(make_cspan(idx3), '.'));
+  EXPECT_EQ("1/2/3", ChunkKey(make_cspan(idx3), '/'));
+}
+
+TEST(ZarrLoaderTest, DecompressUncompressed) {
+  std::vector<uint8_t> in = {1, 2, 3, 4};
+  std::vector<uint8_t> out(4);
+  DecompressChunk(Compressor::None, make_cspan(in), make_span(out), "chunk");
+  EXPECT_EQ(in, out);
+  std::vector<uint8_t> too_big(5);
+  EXPECT_THROW(DecompressChunk(Compressor::None, make_cspan(in), make_span(too_big), "chunk"),
+               std::exception);
+}
+
+}  // namespace zarr
+}  // namespace dali
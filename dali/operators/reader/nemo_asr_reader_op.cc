@@ -46,8 +46,9 @@ Example manifest file::
     Only ``audio_filepath`` is field mandatory. If ``duration`` is not specified, the whole audio file will be used. A missing ``text`` field
     will produce an empty string as a text.
 
-.. warning::
-    Handling of ``duration`` and ``offset`` fields is not yet implemented. The current implementation always reads the whole audio file.
+If ``offset`` or ``duration`` are specified, only that part of the audio file is decoded - the decoder
+seeks to the offset without decoding the preceding samples. The files are decoded in parallel, with
+``num_threads`` threads.
 
 This reader produces between 1 and 3 outputs:
 
@@ -147,8 +148,7 @@ NemoAsrReader::~NemoAsrReader() {
 }
 
 void NemoAsrReader::Prefetch() {
-  DomainTimeRange tr("[DALI][NemoAsrReader] Prefetch #" + to_string(curr_batch_producer_),
-                      DomainTimeRange::kRed);
+  TraceScope tr(TraceEvent::ReaderPrefetch, curr_batch_producer_, "NemoAsrReader");
   DataReader<CPUBackend, AsrSample>::Prefetch();
   auto &curr_batch = prefetched_batch_queue_[curr_batch_producer_];
   auto &audio_batch = *prefetched_decoded_audio_[curr_batch_producer_];
@@ -12,8 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
+#include "dali/core/math_util.h"
 #include "dali/core/mm/memory.h"
 #include "dali/core/mm/malloc_resource.h"
 #include "dali/operators/reader/numpy_reader_gpu_op.h"
@@ -27,7 +31,11 @@ NumpyReaderGPU::NumpyReaderGPU(const OpSpec& spec)
     : NumpyReader<GPUBackend, NumpyFileWrapperGPU>(spec),
       thread_pool_(num_threads_, spec.GetArgument<int>("device_id"), false, "NumpyReaderGPU"),
       sg_(1 << 18),
-      header_cache_(spec.GetArgument<bool>("cache_header_information")) {
+      header_cache_(detail::NumpyHeaderCache::Open(
+          spec.GetArgument<bool>("cache_header_information"),
+          spec.GetArgument<string>("header_cache_file"))),
+      prefetch_slice_attr_(spec, "roi_start", "rel_roi_start", "roi_end", "rel_roi_end",
+                           "roi_shape", "rel_roi_shape", "roi_axes", nullptr) {
   prefetched_batch_tensors_.resize(prefetch_queue_depth_);
   // make the device current
   DeviceGuard g(device_id_);
@@ -41,12 +49,26 @@ NumpyReaderGPU::NumpyReaderGPU(const OpSpec& spec)
   loader_ = InitLoader<NumpyLoaderGPU>(spec, std::vector<string>(), shuffle_after_epoch);
 
   kmgr_transpose_.Resize<TransposeKernel>(1);
+
+  if (spec.GetArgument<bool>("use_batch_io") && CUFileBatchReader::IsAvailable()) {
+    // Keep the number of staging buffers held by the reads in flight well below the capacity
+    // of the staging engine, so that getting a new buffer never waits for the batch itself.
+    batch_reader_ = std::make_unique<CUFileBatchReader>(32);
+    pending_chunks_.reserve(batch_reader_->max_batch_size());
+  }
+
+  bool has_roi = false, has_roi_input = false;
+  for (const char *arg : { "roi_start", "rel_roi_start", "roi_end", "rel_roi_end",
+                           "roi_shape", "rel_roi_shape" }) {
+    has_roi |= spec.HasArgument(arg);
+    has_roi_input |= spec.HasTensorArgument(arg);
+  }
+  direct_roi_reads_ = has_roi && !has_roi_input;
 }
 
 void NumpyReaderGPU::Prefetch() {
   // We actually prepare the next batch
-  DomainTimeRange tr("[DALI][NumpyReaderGPU] Prefetch #" + to_string(curr_batch_producer_),
-                      DomainTimeRange::kRed);
+  TraceScope tr(TraceEvent::ReaderPrefetch, curr_batch_producer_, "NumpyReaderGPU");
   DataReader<GPUBackend, NumpyFileWrapperGPU>::Prefetch();
   auto &curr_batch = prefetched_batch_queue_[curr_batch_producer_];
   auto &curr_tensor_list = prefetched_batch_tensors_[curr_batch_producer_];
@@ -57,11 +79,14 @@ void NumpyReaderGPU::Prefetch() {
     if (data_idx > 0 && curr_batch[data_idx -1 ] == curr_batch[data_idx]) continue;
     thread_pool_.AddWork([this, &curr_batch, data_idx](int tid) {
         curr_batch[data_idx]->Reopen();
-        curr_batch[data_idx]->ReadHeader(header_cache_);
+        curr_batch[data_idx]->ReadHeader(*header_cache_);
       });
   }
   thread_pool_.RunAll();
 
+  if (direct_roi_reads_)
+    SetReadRegions(curr_batch);
+
   // resize the current batch
   auto ref_type = curr_batch[0]->get_type();
   auto ref_shape = curr_batch[0]->get_shape();
@@ -82,7 +107,7 @@ void NumpyReaderGPU::Prefetch() {
             " dimensions whereas\n"
             "[0] has ",
             ref_shape.sample_dim(), " dimensions."));
-    tmp_shapes.set_tensor_shape(data_idx, sample->get_shape());
+    tmp_shapes.set_tensor_shape(data_idx, sample->get_read_shape());
   }
 
   curr_tensor_list.Resize(tmp_shapes, ref_type);
@@ -105,7 +130,10 @@ void NumpyReaderGPU::Prefetch() {
       curr_batch[data_idx]->source_sample_idx = data_idx;
     }
   }
-  thread_pool_.RunAll();
+  if (batch_reader_)
+    RunBatch();
+  else
+    thread_pool_.RunAll();
   staging_.commit();
   CUDA_CALL(cudaEventRecord(staging_ready_, staging_stream_));
 
@@ -114,6 +142,74 @@ void NumpyReaderGPU::Prefetch() {
   }
 }
 
+void NumpyReaderGPU::SetReadRegions(std::vector<std::shared_ptr<NumpyFileWrapperGPU>> &batch) {
+  for (auto &sample : batch) {
+    sample->read_row_start = 0;
+    sample->read_rows = -1;
+  }
+  int ndim = batch[0]->get_shape().sample_dim();
+  if (ndim == 0)
+    return;
+
+  try {
+    // The ROI arguments are not argument inputs, so the workspace is not used
+    DeviceWorkspace ws;
+    prefetch_slice_attr_.ProcessArguments<GPUBackend>(spec_, ws, batch.size(), ndim);
+  } catch (std::exception &) {
+    // Invalid arguments - read the whole arrays and let SetupImpl report the error
+    return;
+  }
+
+  for (size_t data_idx = 0; data_idx < batch.size(); data_idx++) {
+    auto &sample = *batch[data_idx];
+    const auto &file_sh = sample.get_shape();
+    if (file_sh.sample_dim() != ndim)
+      continue;  // reported in Prefetch
+
+    // The same as in NumpyReader::SetupImpl - the ROI is given in the output layout
+    int row_axis = 0;
+    TensorShape<> sh = file_sh;
+    if (sample.fortran_order) {
+      for (int d = 0; d < ndim; d++)
+        sh[d] = file_sh[ndim - 1 - d];
+      row_axis = ndim - 1;
+    }
+    CropWindow roi;
+    try {
+      roi = prefetch_slice_attr_.GetCropWindowGenerator(data_idx)(sh, {});
+    } catch (std::exception &) {
+      continue;
+    }
+
+    int64_t nrows = file_sh[0];
+    int64_t start = clamp<int64_t>(roi.anchor[row_axis], 0, nrows);
+    int64_t end = clamp<int64_t>(roi.anchor[row_axis] + roi.shape[row_axis], 0, nrows);
+    // Read everything if the window is empty (it's padded or an error is reported later)
+    if (start >= end || (start == 0 && end == nrows))
+      continue;
+    sample.read_row_start = start;
+    sample.read_rows = end - start;
+  }
+}
+
+void NumpyReaderGPU::RunBatch() {
+  try {
+    batch_reader_->Run([&](int64_t chunk_idx) {
+      auto &chunk = pending_chunks_[chunk_idx];
+      staging_.copy_to_client(chunk.dst, chunk.length, std::move(chunk.buffer), chunk.skip);
+      chunk.done = true;
+    });
+  } catch (...) {
+    for (auto &chunk : pending_chunks_) {
+      if (!chunk.done)
+        staging_.return_unused(std::move(chunk.buffer));
+    }
+    pending_chunks_.clear();
+    throw;
+  }
+  pending_chunks_.clear();
+}
+
 void NumpyReaderGPU::ScheduleChunkedRead(SampleView<GPUBackend> &out_sample,
                                          NumpyFileWrapperGPU &load_target) {
   // TODO(michalz): add nbytes and num_elements to SampleView.
@@ -122,23 +218,45 @@ void NumpyReaderGPU::ScheduleChunkedRead(SampleView<GPUBackend> &out_sample,
   if (!data_bytes)
     return;  // empty array - short-circuit
 
+  // skip the rows before the region of interest
+  ssize_t data_offset = load_target.data_offset;
+  if (load_target.read_rows > 0)
+    data_offset += load_target.read_row_start * (data_bytes / load_target.read_rows);
+
   uint8_t *base_ptr = static_cast<uint8_t*>(out_sample.raw_mutable_data());
   uint8_t *dst_ptr = base_ptr;
-  ssize_t read_start = load_target.data_offset & -gds::kGDSAlignment;  // align _down_
+  ssize_t read_start = data_offset & -gds::kGDSAlignment;  // align _down_
   ssize_t file_offset = read_start;
-  ssize_t read_bytes = data_bytes + load_target.data_offset - read_start;
+  ssize_t read_bytes = data_bytes + data_offset - read_start;
   while (read_bytes > 0) {
     ssize_t chunk_read_length = std::min<ssize_t>(read_bytes, chunk_size_);
-    ssize_t copy_start = std::max(file_offset, load_target.data_offset);
+    ssize_t copy_start = std::max(file_offset, data_offset);
     ssize_t copy_skip = copy_start - file_offset;
     ssize_t copy_end = file_offset + chunk_read_length;
     ssize_t chunk_copy_length = copy_end - copy_start;
-    thread_pool_.AddWork([=, &load_target](int tid) {
+    assert(dst_ptr >= base_ptr && dst_ptr + chunk_copy_length <= base_ptr + data_bytes);
+    if (batch_reader_) {
+      // the whole batch is submitted at once, from this thread
       auto buffer = staging_.get_staging_buffer();
-      load_target.ReadRawChunk(buffer.at(0), chunk_read_length, 0, file_offset);
-      assert(dst_ptr >= base_ptr && dst_ptr + chunk_copy_length <= base_ptr + data_bytes);
-      staging_.copy_to_client(dst_ptr, chunk_copy_length, std::move(buffer), copy_skip);
-    });
+      try {
+        batch_reader_->Add(*load_target.file_stream, buffer.at(0), 0, file_offset,
+                           chunk_read_length, pending_chunks_.size());
+      } catch (...) {
+        staging_.return_unused(std::move(buffer));
+        RunBatch();
+        throw;
+      }
+      pending_chunks_.push_back({ dst_ptr, chunk_copy_length, copy_skip, std::move(buffer),
+                                  false });
+      if (batch_reader_->num_pending() == batch_reader_->max_batch_size())
+        RunBatch();
+    } else {
+      thread_pool_.AddWork([=, &load_target](int tid) {
+        auto buffer = staging_.get_staging_buffer();
+        load_target.ReadRawChunk(buffer.at(0), chunk_read_length, 0, file_offset);
+        staging_.copy_to_client(dst_ptr, chunk_copy_length, std::move(buffer), copy_skip);
+      });
+    }
 
     // update addresses
     dst_ptr += chunk_copy_length;
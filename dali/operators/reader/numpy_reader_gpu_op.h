@@ -15,6 +15,7 @@
 #ifndef DALI_OPERATORS_READER_NUMPY_READER_GPU_OP_H_
 #define DALI_OPERATORS_READER_NUMPY_READER_GPU_OP_H_
 
+#include <memory>
 #include <utility>
 #include <string>
 #include <vector>
@@ -27,6 +28,7 @@
 #include "dali/operators/reader/loader/numpy_loader_gpu.h"
 #include "dali/operators/reader/numpy_reader_op.h"
 #include "dali/operators/reader/reader_op.h"
+#include "dali/util/cufile_batch.h"
 
 namespace dali {
 
@@ -76,12 +78,41 @@ class NumpyReaderGPU : public NumpyReader<GPUBackend, NumpyFileWrapperGPU> {
 
   void ScheduleChunkedRead(SampleView<GPUBackend> &out_sample, NumpyFileWrapperGPU &target);
 
+  /**
+   * @brief Limits the reads to the rows (the outermost dimension of the array in the file)
+   *        covered by the region of interest
+   *
+   * Only used when the ROI doesn't depend on argument inputs, so it can be calculated
+   * ahead of time, in the prefetch thread.
+   */
+  void SetReadRegions(std::vector<std::shared_ptr<NumpyFileWrapperGPU>> &batch);
+
+  /**
+   * @brief Submits the chunks enqueued in batch_reader_ and hands them over to the staging engine
+   */
+  void RunBatch();
+
+  struct PendingChunk {
+    uint8_t *dst;
+    ssize_t length;
+    ssize_t skip;
+    gds::GDSStagingBuffer buffer;
+    bool done;
+  };
+
   size_t chunk_size_ = gds::GetGDSChunkSize();
-  detail::NumpyHeaderCache header_cache_;
+  std::shared_ptr<detail::NumpyHeaderCache> header_cache_;
   gds::GDSStagingEngine staging_;
   CUDAStreamLease staging_stream_;
   CUDAEvent staging_ready_;
   std::vector<int> source_data_index_;
+
+  std::unique_ptr<CUFileBatchReader> batch_reader_;
+  std::vector<PendingChunk> pending_chunks_;
+
+  bool direct_roi_reads_ = false;
+  // a separate instance, used only by the prefetch thread
+  NamedSliceAttr prefetch_slice_attr_;
 };
 
 }  // namespace dali
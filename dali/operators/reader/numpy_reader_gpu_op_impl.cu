@@ -105,13 +105,16 @@ void NumpyReaderGPU::RunImplTyped(DeviceWorkspace &ws) {
     for (int i = 0, j = 0, k = 0; i < nsamples; i++) {
       if (!need_slice_[i])
         continue;
+      int src_idx = source_data_index_[i];
       auto &args = slice_args[j];
       args.anchor = rois_[i].anchor;
       args.shape = rois_[i].shape;
       args.fill_values.clear();
       args.fill_values.push_back(ConvertSat<T>(fill_value_));
+      // only the rows covered by the ROI may have been read
+      if (Dims > 0)
+        args.anchor[0] -= GetSample(src_idx).read_row_start;
 
-      int src_idx = source_data_index_[i];
       from.data[j] = curr_batch.data[src_idx];
       from.shape.set_tensor_shape(j, curr_batch.shape[src_idx]);
 
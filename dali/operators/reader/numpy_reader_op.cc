@@ -91,6 +91,64 @@ static void SlicePermuteHelper(SampleView<CPUBackend> output, ConstSampleView<CP
   ), DALI_FAIL(make_string("Unsupported number of dimensions: ", ndim)););  // NOLINT
 }
 
+// The region-of-interest arguments of the readers of arrays (readers.numpy, readers.zarr)
+DALI_SCHEMA(ReaderROIBase)
+    .AddOptionalArg<std::vector<int>>("roi_start",
+        R"code(Start of the region-of-interest, in absolute coordinates.
+
+This argument is incompatible with "rel_roi_start".
+)code",
+        nullptr, true)
+    .AddOptionalArg<std::vector<float>>("rel_roi_start",
+        R"code(Start of the region-of-interest, in relative coordinates (range [0.0 - 1.0]).
+
+This argument is incompatible with "roi_start".
+)code",
+        nullptr, true)
+    .AddOptionalArg<std::vector<int>>("roi_end",
+        R"code(End of the region-of-interest, in absolute coordinates.
+
+This argument is incompatible with "rel_roi_end", "roi_shape" and "rel_roi_shape".
+)code",
+        nullptr, true)
+    .AddOptionalArg<std::vector<float>>("rel_roi_end",
+        R"code(End of the region-of-interest, in relative coordinates (range [0.0 - 1.0]).
+
+This argument is incompatible with "roi_end", "roi_shape" and "rel_roi_shape".
+)code",
+        nullptr, true)
+    .AddOptionalArg<std::vector<int>>("roi_shape",
+        R"code(Shape of the region-of-interest, in absolute coordinates.
+
+This argument is incompatible with "rel_roi_shape", "roi_end" and "rel_roi_end".
+)code",
+        nullptr, true)
+    .AddOptionalArg<std::vector<float>>("rel_roi_shape",
+        R"code(Shape of the region-of-interest, in relative coordinates (range [0.0 - 1.0]).
+
+This argument is incompatible with "roi_shape", "roi_end" and "rel_roi_end".
+)code",
+        nullptr, true)
+    .AddOptionalArg("roi_axes",
+        R"code(Order of dimensions used for the ROI anchor and shape argumens, as dimension indices.
+
+If not provided, all the dimensions should be specified in the ROI arguments.
+)code",
+        std::vector<int>{})
+    .AddOptionalArg("out_of_bounds_policy",
+        R"code(Determines the policy when reading outside of the bounds of the array.
+
+Here is a list of the supported values:
+
+- ``"error"`` (default): Attempting to read outside of the bounds of the image will produce an error.
+- ``"pad"``: The array will be padded as needed with zeros or any other value that is specified
+  with the ``fill_value`` argument.
+- ``"trim_to_shape"``: The ROI will be cut to the bounds of the array.)code",
+        "error")
+    .AddOptionalArg("fill_value",
+        R"code(Determines the padding value when ``out_of_bounds_policy`` is set to “pad”.)code",
+        0.f);
+
 DALI_REGISTER_OPERATOR(readers__Numpy, NumpyReaderCPU, CPU);
 
 DALI_SCHEMA(readers__Numpy)
@@ -149,65 +207,27 @@ This argument is mutually exclusive with ``file_list``.)", nullptr)
 
 If true, the device I/O buffers will be registered with cuFile. It is not recommended if the sample
 sizes vary a lot.)code", true)
+  .AddOptionalArg("use_batch_io",
+      R"code(Applies **only** to the ``gpu`` backend type.
+
+If true, the file chunks of a batch are submitted to cuFile in batches, from a single thread,
+instead of being read one by one by the worker threads. It's ignored when the cuFile library
+doesn't support the batch API.)code", true)
   .AddOptionalArg("cache_header_information",
       R"code(If set to True, the header information for each file is cached, improving access
 speed.)code",
       false)
-    .AddOptionalArg<std::vector<int>>("roi_start",
-        R"code(Start of the region-of-interest, in absolute coordinates.
-
-This argument is incompatible with "rel_roi_start".
-)code",
-        nullptr, true)
-    .AddOptionalArg<std::vector<float>>("rel_roi_start",
-        R"code(Start of the region-of-interest, in relative coordinates (range [0.0 - 1.0]).
+  .AddOptionalArg("header_cache_file",
+      R"code(Path of a file where the parsed headers are stored across the runs.
 
-This argument is incompatible with "roi_start".
-)code",
-        nullptr, true)
-    .AddOptionalArg<std::vector<int>>("roi_end",
-        R"code(End of the region-of-interest, in absolute coordinates.
-
-This argument is incompatible with "rel_roi_end", "roi_shape" and "rel_roi_shape".
-)code",
-        nullptr, true)
-    .AddOptionalArg<std::vector<float>>("rel_roi_end",
-        R"code(End of the region-of-interest, in relative coordinates (range [0.0 - 1.0]).
-
-This argument is incompatible with "roi_end", "roi_shape" and "rel_roi_shape".
-)code",
-        nullptr, true)
-    .AddOptionalArg<std::vector<int>>("roi_shape",
-        R"code(Shape of the region-of-interest, in absolute coordinates.
+If the file exists, the headers are loaded from it, so that the files don't need to be parsed
+again, and the headers parsed in this run are written back to it when the reader is destroyed.
+The readers (both ``cpu`` and ``gpu``) in the process which use the same file share the cache.
+An entry is used only if the size of the file didn't change.
 
-This argument is incompatible with "rel_roi_shape", "roi_end" and "rel_roi_end".
-)code",
-        nullptr, true)
-    .AddOptionalArg<std::vector<float>>("rel_roi_shape",
-        R"code(Shape of the region-of-interest, in relative coordinates (range [0.0 - 1.0]).
-
-This argument is incompatible with "roi_shape", "roi_end" and "rel_roi_end".
-)code",
-        nullptr, true)
-    .AddOptionalArg("roi_axes",
-        R"code(Order of dimensions used for the ROI anchor and shape argumens, as dimension indices.
-
-If not provided, all the dimensions should be specified in the ROI arguments.
-)code",
-        std::vector<int>{})
-    .AddOptionalArg("out_of_bounds_policy",
-        R"code(Determines the policy when reading outside of the bounds of the numpy array.
-
-Here is a list of the supported values:
-
-- ``"error"`` (default): Attempting to read outside of the bounds of the image will produce an error.
-- ``"pad"``: The array will be padded as needed with zeros or any other value that is specified
-  with the ``fill_value`` argument.
-- ``"trim_to_shape"``: The ROI will be cut to the bounds of the array.)code",
-        "error")
-    .AddOptionalArg("fill_value",
-        R"code(Determines the padding value when ``out_of_bounds_policy`` is set to “pad”.)code",
-        0.f)
+Implies ``cache_header_information``.)code",
+      std::string())
+  .AddParent("ReaderROIBase")
   .AddParent("LoaderBase");
 
 
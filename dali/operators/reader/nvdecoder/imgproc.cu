@@ -93,7 +93,8 @@ __global__ void process_frame_kernel(
   cudaTextureObject_t luma, cudaTextureObject_t chroma,
   T* dst, int index,
   float fx, float fy,
-  int dst_width, int dst_height, int c) {
+  int dst_width, int dst_height, int c,
+  bool resize, float x0, float y0) {
   const int dst_x = blockIdx.x * blockDim.x + threadIdx.x;
   const int dst_y = blockIdx.y * blockDim.y + threadIdx.y;
 
@@ -101,10 +102,18 @@ __global__ void process_frame_kernel(
       return;
 
   auto src_x = 0.0f;
-  // TODO(spanev) something less hacky here, why 4:2:0 fails on this edge?
-  float shift = (dst_x == dst_width - 1) ? 0 : 0.5f;
-  src_x = static_cast<float>(dst_x) * fx + shift;
-  auto src_y = static_cast<float>(dst_y) * fy + shift;
+  auto src_y = 0.0f;
+  if (resize) {
+    // The texture unit does the bilinear interpolation - the pixel centers of the output
+    // are mapped to the source region
+    src_x = x0 + (static_cast<float>(dst_x) + 0.5f) * fx;
+    src_y = y0 + (static_cast<float>(dst_y) + 0.5f) * fy;
+  } else {
+    // TODO(spanev) something less hacky here, why 4:2:0 fails on this edge?
+    float shift = (dst_x == dst_width - 1) ? 0 : 0.5f;
+    src_x = static_cast<float>(dst_x) * fx + shift;
+    src_y = static_cast<float>(dst_y) * fy + shift;
+  }
 
   // https://docs.nvidia.com/cuda/cuda-c-programming-guide/index.html#tex2d-object
   YCbCr<float> ycbcr;
@@ -143,6 +152,10 @@ void process_frame(
 
   auto fx = static_cast<float>(input_width) / scale_width;
   auto fy = static_cast<float>(input_height) / scale_height;
+  if (output.resize_frames) {
+    fx = (output.roi_x1 - output.roi_x0) / output.width;
+    fy = (output.roi_y1 - output.roi_y0) / output.height;
+  }
 
   dim3 block(32, 8);
   dim3 grid(divUp(output.width, block.x), divUp(output.height, block.y));
@@ -155,18 +168,22 @@ void process_frame(
   if (normalized) {
     if (rgb) {
       process_frame_kernel<T, true, true><<<grid, block, 0, stream>>>
-          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels);
+          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels,
+           output.resize_frames, output.roi_x0, output.roi_y0);
     } else {
       process_frame_kernel<T, true, false><<<grid, block, 0, stream>>>
-          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels);
+          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels,
+           output.resize_frames, output.roi_x0, output.roi_y0);
     }
   } else {
     if (rgb) {
       process_frame_kernel<T, false, true><<<grid, block, 0, stream>>>
-          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels);
+          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels,
+           output.resize_frames, output.roi_x0, output.roi_y0);
     } else {
       process_frame_kernel<T, false, false><<<grid, block, 0, stream>>>
-          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels);
+          (luma, chroma, tensor_out, index, fx, fy, output.width, output.height, output.channels,
+           output.resize_frames, output.roi_x0, output.roi_y0);
     }
   }
 }
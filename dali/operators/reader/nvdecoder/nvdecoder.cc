@@ -412,11 +412,11 @@ void NvDecoder::push_req(FrameReq req) {
   recv_queue_.push(std::move(req));
 }
 
-void NvDecoder::receive_frames(SequenceWrapper& sequence) {
+void NvDecoder::receive_frames(SequenceWrapper& sequence, int first) {
   LOG_LINE << "Sequence pushed with " << sequence.count << " frames" << std::endl;
 
   DeviceGuard g(device_id_);
-  for (int i = 0; i < sequence.count; ++i) {
+  for (int i = first; i < sequence.count; ++i) {
       LOG_LINE << "popping frame (" << i << "/" << sequence.count << ") "
                << frame_queue_.size() << " reqs left" << std::endl;
 
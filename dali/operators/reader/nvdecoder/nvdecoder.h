@@ -114,7 +114,12 @@ class NvDecoder {
 
   void push_req(FrameReq req);
 
-  void receive_frames(SequenceWrapper& batch);
+  /**
+   * @brief Receives the frames of the sequence, starting with the frame `first`
+   *
+   * The frames before `first` are expected to be filled by the caller.
+   */
+  void receive_frames(SequenceWrapper& batch, int first = 0);
 
   void finish();
 
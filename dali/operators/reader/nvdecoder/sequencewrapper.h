@@ -45,6 +45,7 @@ struct SequenceWrapper {
     this->width = width;
     this->channels = channels;
     this->dtype = dtype;
+    resize_frames = false;
 
     timestamps.clear();
     timestamps.reserve(max_count);
@@ -58,6 +59,13 @@ struct SequenceWrapper {
     CUDA_CALL(cudaEventRecord(event_, stream));
   }
 
+  /**
+   * @brief Makes the work issued to `stream` wait for the sequence
+   */
+  void wait(cudaStream_t stream) const {
+    CUDA_CALL(cudaStreamWaitEvent(stream, event_, 0));
+  }
+
   void wait() const {
     if (event_) {
       LOG_LINE << event_ << " waiting for sequence event" << std::endl;
@@ -87,6 +95,14 @@ struct SequenceWrapper {
   DALIDataType dtype = DALI_NO_TYPE;
   std::function<void(void)> read_sample_f;
 
+  /**
+   * If set, the region from (roi_x0, roi_y0) to (roi_x1, roi_y1) of the decoded frames
+   * (in pixels, flipped if x1 < x0 or y1 < y0) is resized to height x width while the frames
+   * are converted to the output, without a full resolution intermediate
+   */
+  bool resize_frames = false;
+  float roi_x0 = 0, roi_y0 = 0, roi_x1 = 0, roi_y1 = 0;
+
  private:
   CUDAEvent event_;
 };
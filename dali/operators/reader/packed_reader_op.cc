@@ -0,0 +1,65 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/operators/reader/packed_reader_op.h"
+
+namespace dali {
+
+namespace {
+
+int PackedReaderOutputFn(const OpSpec &spec) {
+  return spec.GetArgument<bool>("image_shapes");
+}
+
+}  // namespace
+
+DALI_REGISTER_OPERATOR(readers__Packed, PackedReader, CPU);
+
+DALI_SCHEMA(readers__Packed)
+  .DocStr(R"code(Reads the images and labels from a dataset in the DALI packed format.
+
+The dataset is created with the ``dali_pack`` script that is distributed with DALI, from
+a directory with a subdirectory per class or from a file list, like the ones used by
+:meth:`readers.file`. It consists of data files, with the samples starting at multiples of
+a fixed alignment, and of index files, with the offset, the size and the label of every sample,
+so no index needs to be built when the reader starts.
+
+Reading the dataset is sequential, unless ``global_shuffle`` is used - then, a
+``shuffle_block_size`` greater than 1 keeps the reads within a block sequential. The samples
+are shared with the memory-mapped files, without copying them. With ``use_io_uring``,
+they are read instead, by ``num_read_threads`` threads; as they are aligned, also with
+``use_o_direct``.
+
+The reader returns the encoded images and their labels, and, with ``image_shapes``,
+the shapes of the images stored by ``dali_pack --image-info``.)code")
+  .NumInput(0)
+  .NumOutput(2)
+  .AdditionalOutputsFn(PackedReaderOutputFn)
+  .AddArg("path",
+      R"code(List of paths to the data (.dpk) files.)code",
+      DALI_STRING_VEC)
+  .AddArg("index_path",
+      R"code(List of paths to the index (.idx) files, one for each data file.
+
+The index files are created by ``dali_pack`` together with the data files.)code",
+      DALI_STRING_VEC)
+  .AddOptionalArg("image_shapes",
+      R"code(If set to True, the reader returns an additional output with the shapes
+(height, width, channels) of the images, as stored by ``dali_pack --image-info``.
+
+The shapes of the images packed without ``--image-info`` are zeros.)code",
+      false)
+  .AddParent("LoaderBase");
+
+}  // namespace dali
@@ -0,0 +1,43 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_PACKED_READER_OP_H_
+#define DALI_OPERATORS_READER_PACKED_READER_OP_H_
+
+#include "dali/operators/reader/reader_op.h"
+#include "dali/operators/reader/loader/packed_loader.h"
+#include "dali/operators/reader/parser/packed_parser.h"
+
+namespace dali {
+
+class PackedReader : public DataReader<CPUBackend, Tensor<CPUBackend>> {
+ public:
+  explicit PackedReader(const OpSpec& spec)
+  : DataReader<CPUBackend, Tensor<CPUBackend>>(spec) {
+    loader_ = InitLoader<PackedLoader>(spec);
+    parser_.reset(new PackedParser(spec));
+  }
+
+  void RunImpl(SampleWorkspace &ws) override {
+    const auto& tensor = GetSample(ws.data_idx());
+    ParseIfNeeded(tensor, &ws);
+  }
+
+ protected:
+  USE_READER_OPERATOR_MEMBERS(CPUBackend, Tensor<CPUBackend>);
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_PACKED_READER_OP_H_
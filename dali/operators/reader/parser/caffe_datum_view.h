@@ -0,0 +1,95 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_PARSER_CAFFE_DATUM_VIEW_H_
+#define DALI_OPERATORS_READER_PARSER_CAFFE_DATUM_VIEW_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "dali/core/span.h"
+#include "dali/operators/reader/parser/proto_wire_reader.h"
+
+namespace dali {
+
+namespace CaffeUtil {
+
+/**
+ * @brief The fields of a serialized caffe::Datum, decoded straight from the protobuf wire format
+ *
+ * The image data is a span of the input buffer, so it can be copied to the output directly,
+ * without materializing the message. `float_data` is not used by the reader and is skipped.
+ */
+struct DatumView {
+  int32_t channels = 0;
+  int32_t height = 0;
+  int32_t width = 0;
+  bool has_data = false;
+  span<const uint8_t> data;
+  bool has_label = false;
+  int32_t label = 0;
+  bool has_encoded = false;
+  bool encoded = false;
+
+  /**
+   * @return false if the data is not a valid message
+   */
+  bool Parse(const uint8_t *ptr, size_t size) {
+    *this = {};
+    proto_wire::Reader r(ptr, size);
+    while (!r.AtEnd()) {
+      uint32_t field, wire;
+      if (!r.ReadTag(field, wire))
+        return false;
+      bool scalar = field <= 3 || field == 5 || field == 7;  // the int32 and bool fields
+      if (scalar && wire == proto_wire::kVarint) {
+        uint64_t v;
+        if (!r.ReadVarint(v))
+          return false;
+        switch (field) {
+          case 1:
+            channels = static_cast<int32_t>(v);
+            break;
+          case 2:
+            height = static_cast<int32_t>(v);
+            break;
+          case 3:
+            width = static_cast<int32_t>(v);
+            break;
+          case 5:
+            label = static_cast<int32_t>(v);
+            has_label = true;
+            break;
+          default:
+            encoded = v != 0;
+            has_encoded = true;
+            break;
+        }
+      } else if (field == 4 && wire == proto_wire::kLengthDelimited) {
+        if (!r.ReadBytes(data))
+          return false;
+        has_data = true;
+      } else if (!r.Skip(wire)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+}  // namespace CaffeUtil
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_PARSER_CAFFE_DATUM_VIEW_H_
@@ -0,0 +1,87 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "dali/operators/reader/parser/caffe.pb.h"
+#include "dali/operators/reader/parser/caffe_datum_view.h"
+
+namespace dali {
+
+namespace {
+
+CaffeUtil::DatumView Parse(const std::string &serialized) {
+  CaffeUtil::DatumView view;
+  EXPECT_TRUE(view.Parse(reinterpret_cast<const uint8_t *>(serialized.data()),
+                         serialized.size()));
+  return view;
+}
+
+}  // namespace
+
+TEST(CaffeDatumView, RawImage) {
+  caffe::Datum datum;
+  datum.set_channels(3);
+  datum.set_height(2);
+  datum.set_width(4);
+  datum.set_data(std::string(24, '\x7f'));
+  datum.set_label(-5);
+  datum.add_float_data(1.5f);
+  datum.set_encoded(false);
+  std::string serialized = datum.SerializeAsString();
+
+  auto view = Parse(serialized);
+  EXPECT_EQ(view.channels, 3);
+  EXPECT_EQ(view.height, 2);
+  EXPECT_EQ(view.width, 4);
+  ASSERT_TRUE(view.has_data);
+  ASSERT_EQ(view.data.size(), 24);
+  // the data is not copied
+  EXPECT_GE(reinterpret_cast<const char *>(view.data.data()), serialized.data());
+  EXPECT_LE(reinterpret_cast<const char *>(view.data.data() + view.data.size()),
+            serialized.data() + serialized.size());
+  EXPECT_EQ(view.data[0], 0x7f);
+  EXPECT_TRUE(view.has_label);
+  EXPECT_EQ(view.label, -5);
+  EXPECT_TRUE(view.has_encoded);
+  EXPECT_FALSE(view.encoded);
+}
+
+TEST(CaffeDatumView, EncodedImage) {
+  caffe::Datum datum;
+  datum.set_data("\xff\xd8 jpeg");
+  datum.set_encoded(true);
+
+  auto view = Parse(datum.SerializeAsString());
+  EXPECT_TRUE(view.has_data);
+  EXPECT_EQ(view.data.size(), 7);
+  EXPECT_FALSE(view.has_label);
+  EXPECT_TRUE(view.encoded);
+
+  view = Parse("");
+  EXPECT_FALSE(view.has_data);
+  EXPECT_FALSE(view.has_encoded);
+}
+
+TEST(CaffeDatumView, Malformed) {
+  caffe::Datum datum;
+  datum.set_data(std::string(100, 'x'));
+  std::string serialized = datum.SerializeAsString();
+  CaffeUtil::DatumView view;
+  EXPECT_FALSE(view.Parse(reinterpret_cast<const uint8_t *>(serialized.data()),
+                          serialized.size() - 1));
+}
+
+}  // namespace dali
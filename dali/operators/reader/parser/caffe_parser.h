@@ -16,7 +16,7 @@
 #define DALI_OPERATORS_READER_PARSER_CAFFE_PARSER_H_
 
 #include "dali/operators/reader/parser/parser.h"
-#include "dali/operators/reader/parser/caffe.pb.h"
+#include "dali/operators/reader/parser/caffe_datum_view.h"
 
 namespace dali {
 
@@ -28,42 +28,39 @@ class CaffeParser : public Parser<Tensor<CPUBackend>> {
     label_available_(spec.GetArgument<bool>("label_available")) {}
 
   void Parse(const Tensor<CPUBackend>& data, SampleWorkspace* ws) override {
-    caffe::Datum datum;
+    // The Datum is decoded in place - the image is copied straight from the (possibly
+    // memory-mapped) input, without materializing the message
+    CaffeUtil::DatumView datum;
     int out_tensors = 0;
-    DALI_ENFORCE(datum.ParseFromArray(data.raw_data(), data.size()),
+    DALI_ENFORCE(datum.Parse(data.data<uint8_t>(), data.size()),
       make_string("Error while parsing Caffe file: ", data.GetSourceInfo(),
                   " (raw data length: ", data.size(), " bytes)."));
 
     if (image_available_) {
-      bool encoded_data = true;
-      int data_size = 0;
+      bool encoded_data = !(datum.has_encoded && !datum.encoded);
+      Index data_size = datum.has_data ? datum.data.size() : 0;
       auto& image = ws->Output<CPUBackend>(out_tensors);
-      if (datum.has_encoded() && !datum.encoded()) {
-        encoded_data = false;
-      }
-      if (datum.has_data()) {
-        data_size = datum.data().size();
-      }
       // copy image
       if (encoded_data) {
-        image.Resize({static_cast<Index>(data_size)}, DALI_UINT8);
+        image.Resize({data_size}, DALI_UINT8);
       } else {
-        DALI_ENFORCE(datum.height() * datum.width() * datum.channels() == data_size,
+        DALI_ENFORCE(static_cast<Index>(datum.height) * datum.width * datum.channels == data_size,
                     "The content size of the raw image in LMDB caffe entry doesn't"
                     " match its dimensions");
-        image.Resize({datum.height(), datum.width(), datum.channels()}, DALI_UINT8);
+        image.Resize({datum.height, datum.width, datum.channels}, DALI_UINT8);
       }
-      std::memcpy(image.mutable_data<uint8_t>(), datum.data().data(), data_size * sizeof(uint8_t));
+      if (data_size > 0)
+        std::memcpy(image.mutable_data<uint8_t>(), datum.data.data(), data_size);
       image.SetSourceInfo(data.GetSourceInfo());
       out_tensors++;
     }
 
     if (label_available_) {
       auto& label = ws->Output<CPUBackend>(out_tensors);
-      if (datum.has_label()) {
+      if (datum.has_label) {
         // copy label
         label.Resize({1}, DALI_INT32);
-        label.mutable_data<int>()[0] = datum.label();
+        label.mutable_data<int>()[0] = datum.label;
       } else {
         label.Resize({0}, DALI_INT32);
       }
@@ -0,0 +1,84 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_PARSER_PACKED_PARSER_H_
+#define DALI_OPERATORS_READER_PARSER_PACKED_PARSER_H_
+
+#include <cstring>
+
+#include "dali/operators/reader/parser/parser.h"
+
+namespace dali {
+
+/**
+ * @brief The header of a sample in the DALI packed format (see `tools/dali_pack.py`)
+ *
+ * The shape of the image is zero if it wasn't stored by `dali_pack --image-info`.
+ */
+struct PackedSampleHeader {
+  uint32_t magic;
+  int32_t label;
+  uint32_t height, width, channels;
+  uint8_t reserved[12];
+};
+
+static_assert(sizeof(PackedSampleHeader) == 32, "The packed sample header has 32 bytes");
+
+class PackedParser : public Parser<Tensor<CPUBackend>> {
+ public:
+  explicit PackedParser(const OpSpec& spec) :
+    Parser<Tensor<CPUBackend>>(spec),
+    image_shapes_(spec.GetArgument<bool>("image_shapes")) {
+  }
+
+  void Parse(const Tensor<CPUBackend>& data, SampleWorkspace* ws) override {
+    const uint8_t *input = data.data<uint8_t>();
+    int64_t size = data.size();
+    DALI_ENFORCE(size >= static_cast<int64_t>(sizeof(PackedSampleHeader)),
+      make_string("Invalid packed sample: ", data.GetSourceInfo(), " (", size, " bytes)."));
+    PackedSampleHeader hdr;
+    std::memcpy(&hdr, input, sizeof(hdr));
+    DALI_ENFORCE(hdr.magic == kSampleMagic,
+      make_string("Invalid packed sample: ", data.GetSourceInfo(), ": wrong magic number."));
+
+    auto& image = ws->Output<CPUBackend>(0);
+    int64_t image_size = size - sizeof(hdr);
+    image.Resize({image_size}, DALI_UINT8);
+    std::memcpy(image.mutable_data<uint8_t>(), input + sizeof(hdr), image_size);
+    image.SetSourceInfo(data.GetSourceInfo());
+
+    auto& label = ws->Output<CPUBackend>(1);
+    label.Resize({1}, DALI_INT32);
+    label.mutable_data<int>()[0] = hdr.label;
+
+    if (image_shapes_) {
+      auto& shape = ws->Output<CPUBackend>(2);
+      shape.Resize({3}, DALI_INT64);
+      auto *shape_data = shape.mutable_data<int64_t>();
+      shape_data[0] = hdr.height;
+      shape_data[1] = hdr.width;
+      shape_data[2] = hdr.channels;
+    }
+  }
+
+ private:
+  // "DPK1"
+  static constexpr uint32_t kSampleMagic = 0x314b5044;
+
+  bool image_shapes_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_PARSER_PACKED_PARSER_H_
@@ -0,0 +1,111 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_PARSER_PROTO_WIRE_READER_H_
+#define DALI_OPERATORS_READER_PARSER_PROTO_WIRE_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "dali/core/span.h"
+
+namespace dali {
+
+namespace proto_wire {
+
+constexpr uint32_t kVarint = 0;
+constexpr uint32_t kFixed64 = 1;
+constexpr uint32_t kLengthDelimited = 2;
+constexpr uint32_t kFixed32 = 5;
+
+/**
+ * @brief Reads the fields of a serialized protobuf message in place
+ *
+ * All the methods return false on malformed or truncated input. Length-delimited payloads are
+ * returned as spans of the input buffer, which must outlive them.
+ */
+class Reader {
+ public:
+  Reader(const uint8_t *data, size_t size) : ptr_(data), end_(data + size) {}
+
+  bool AtEnd() const {
+    return ptr_ >= end_;
+  }
+
+  const uint8_t *ptr() const {
+    return ptr_;
+  }
+
+  bool ReadVarint(uint64_t &value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && ptr_ < end_; shift += 7) {
+      uint8_t byte = *ptr_++;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadTag(uint32_t &field, uint32_t &wire) {
+    uint64_t tag;
+    if (!ReadVarint(tag))
+      return false;
+    field = static_cast<uint32_t>(tag >> 3);
+    wire = static_cast<uint32_t>(tag & 7);
+    return field != 0;
+  }
+
+  bool ReadBytes(span<const uint8_t> &bytes) {
+    uint64_t length;
+    if (!ReadVarint(length) || length > static_cast<uint64_t>(end_ - ptr_))
+      return false;
+    bytes = span<const uint8_t>(ptr_, length);
+    ptr_ += length;
+    return true;
+  }
+
+  bool Advance(size_t n) {
+    if (n > static_cast<size_t>(end_ - ptr_))
+      return false;
+    ptr_ += n;
+    return true;
+  }
+
+  bool Skip(uint32_t wire) {
+    uint64_t varint;
+    span<const uint8_t> bytes;
+    switch (wire) {
+      case kVarint:
+        return ReadVarint(varint);
+      case kFixed64:
+        return Advance(8);
+      case kLengthDelimited:
+        return ReadBytes(bytes);
+      case kFixed32:
+        return Advance(4);
+      default:  // groups are deprecated and not used by the readers
+        return false;
+    }
+  }
+
+ private:
+  const uint8_t *ptr_, *end_;
+};
+
+}  // namespace proto_wire
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_PARSER_PROTO_WIRE_READER_H_
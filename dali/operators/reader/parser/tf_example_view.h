@@ -0,0 +1,274 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_PARSER_TF_EXAMPLE_VIEW_H_
+#define DALI_OPERATORS_READER_PARSER_TF_EXAMPLE_VIEW_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "dali/core/small_vector.h"
+#include "dali/core/span.h"
+#include "dali/operators/reader/parser/proto_wire_reader.h"
+
+namespace dali {
+
+namespace TFUtil {
+
+/**
+ * @brief Decodes selected features of a serialized tf.Example straight from the protobuf
+ *        wire format
+ *
+ * Unlike parsing the message with protobuf, nothing is materialized: a feature is described by
+ * the spans of its serialized value list(s) in the input buffer, so the `bytes` values can be
+ * used in place, without copying them.
+ *
+ * The semantics follow the protobuf ones: if a key occurs more than once, the last occurrence
+ * is used; within a feature, the last list kind set wins and repeated lists of that kind are
+ * concatenated. Both packed and unpacked numeric lists are accepted.
+ *
+ * @remark The view refers to the feature names it was created with - they must outlive it.
+ */
+class ExampleView {
+ public:
+  enum ListKind : uint8_t {
+    kNone = 0,
+    kBytes = 1,   // BytesList, field number 1 of Feature
+    kFloat = 2,   // FloatList, field number 2 of Feature
+    kInt64 = 3,   // Int64List, field number 3 of Feature
+  };
+
+  struct FeatureView {
+    bool found = false;
+    ListKind kind = kNone;
+    // the serialized lists (usually one) - the payloads of the `kind` field of the Feature
+    SmallVector<span<const uint8_t>, 1> lists;
+  };
+
+  explicit ExampleView(const std::vector<std::string> &names) {
+    for (auto &name : names)
+      lookup_.emplace(std::string_view(name), static_cast<int>(lookup_.size()));
+  }
+
+  /**
+   * @brief Index of the feature in the output of Parse
+   */
+  int FeatureIndex(const std::string &name) const {
+    auto it = lookup_.find(name);
+    return it == lookup_.end() ? -1 : it->second;
+  }
+
+  /**
+   * @brief Finds the features in a serialized tf.Example message
+   *
+   * @return false if the data is not a valid message
+   */
+  bool Parse(const uint8_t *data, size_t size, std::vector<FeatureView> &features) const {
+    features.clear();
+    features.resize(lookup_.size());
+    Reader example(data, size);
+    while (!example.AtEnd()) {
+      uint32_t field, wire;
+      if (!example.ReadTag(field, wire))
+        return false;
+      if (field == 1 && wire == kLengthDelimited) {  // Example.features
+        span<const uint8_t> message;
+        if (!example.ReadBytes(message) || !ParseFeatures(message, features))
+          return false;
+      } else if (!example.Skip(wire)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  static int64_t NumValues(const FeatureView &feature) {
+    int64_t n = 0;
+    ForEachValue(feature, [&](const uint8_t *, size_t, uint32_t) { n++; });
+    return n;
+  }
+
+  /**
+   * @brief Calls `value(span)` for each element of a BytesList
+   */
+  template <typename Value>
+  static void ForEachBytes(const FeatureView &feature, Value &&value) {
+    if (feature.kind != kBytes)
+      return;
+    ForEachValue(feature, [&](const uint8_t *ptr, size_t n, uint32_t) {
+      value(span<const uint8_t>(ptr, n));
+    });
+  }
+
+  static void CopyFloats(const FeatureView &feature, float *out) {
+    if (feature.kind != kFloat)
+      return;
+    ForEachValue(feature, [&](const uint8_t *ptr, size_t, uint32_t) {
+      std::memcpy(out++, ptr, sizeof(float));
+    });
+  }
+
+  static void CopyInt64(const FeatureView &feature, int64_t *out) {
+    if (feature.kind != kInt64)
+      return;
+    ForEachValue(feature, [&](const uint8_t *ptr, size_t n, uint32_t) {
+      Reader r(ptr, n);
+      uint64_t v = 0;
+      r.ReadVarint(v);
+      *out++ = static_cast<int64_t>(v);
+    });
+  }
+
+ private:
+  using Reader = proto_wire::Reader;
+  static constexpr uint32_t kVarint = proto_wire::kVarint;
+  static constexpr uint32_t kLengthDelimited = proto_wire::kLengthDelimited;
+  static constexpr uint32_t kFixed32 = proto_wire::kFixed32;
+
+  bool ParseFeatures(span<const uint8_t> message, std::vector<FeatureView> &features) const {
+    Reader r(message.data(), message.size());
+    while (!r.AtEnd()) {
+      uint32_t field, wire;
+      if (!r.ReadTag(field, wire))
+        return false;
+      if (field != 1 || wire != kLengthDelimited) {  // Features.feature map entry
+        if (!r.Skip(wire))
+          return false;
+        continue;
+      }
+      span<const uint8_t> entry;
+      if (!r.ReadBytes(entry))
+        return false;
+
+      span<const uint8_t> key, value;
+      Reader e(entry.data(), entry.size());
+      while (!e.AtEnd()) {
+        if (!e.ReadTag(field, wire))
+          return false;
+        if (field == 1 && wire == kLengthDelimited) {
+          if (!e.ReadBytes(key))
+            return false;
+        } else if (field == 2 && wire == kLengthDelimited) {
+          if (!e.ReadBytes(value))
+            return false;
+        } else if (!e.Skip(wire)) {
+          return false;
+        }
+      }
+      auto it = lookup_.find(std::string_view(reinterpret_cast<const char *>(key.data()),
+                                              key.size()));
+      if (it == lookup_.end())
+        continue;
+      auto &feature = features[it->second];
+      feature = {};  // a repeated key replaces the previous value
+      feature.found = true;
+      if (!ParseFeature(value, feature))
+        return false;
+    }
+    return true;
+  }
+
+  static bool ParseFeature(span<const uint8_t> message, FeatureView &feature) {
+    Reader r(message.data(), message.size());
+    while (!r.AtEnd()) {
+      uint32_t field, wire;
+      if (!r.ReadTag(field, wire))
+        return false;
+      if (field >= kBytes && field <= kInt64 && wire == kLengthDelimited) {
+        span<const uint8_t> list;
+        if (!r.ReadBytes(list))
+          return false;
+        if (feature.kind != field) {  // oneof - the last kind set wins
+          feature.kind = static_cast<ListKind>(field);
+          feature.lists.clear();
+        }
+        feature.lists.push_back(list);
+      } else if (!r.Skip(wire)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Calls `value(ptr, length, wire_type)` for the encoded elements of the feature's lists
+   *
+   * The lists are validated by Parse only up to their boundaries - malformed elements are
+   * skipped here.
+   */
+  template <typename Value>
+  static void ForEachValue(const FeatureView &feature, Value &&value) {
+    for (auto &list : feature.lists) {
+      Reader r(list.data(), list.size());
+      while (!r.AtEnd()) {
+        uint32_t field, wire;
+        if (!r.ReadTag(field, wire))
+          return;
+        if (field != 1) {  // value
+          if (!r.Skip(wire))
+            return;
+          continue;
+        }
+        const uint8_t *start = r.ptr();
+        if (feature.kind == kBytes && wire == kLengthDelimited) {
+          span<const uint8_t> bytes;
+          if (!r.ReadBytes(bytes))
+            return;
+          value(bytes.data(), bytes.size(), wire);
+        } else if (feature.kind == kFloat && wire == kFixed32) {
+          if (!r.Advance(4))
+            return;
+          value(start, 4, wire);
+        } else if (feature.kind == kInt64 && wire == kVarint) {
+          uint64_t v;
+          if (!r.ReadVarint(v))
+            return;
+          value(start, r.ptr() - start, wire);
+        } else if (feature.kind != kBytes && wire == kLengthDelimited) {  // packed
+          span<const uint8_t> packed;
+          if (!r.ReadBytes(packed))
+            return;
+          Reader p(packed.data(), packed.size());
+          while (!p.AtEnd()) {
+            const uint8_t *elem = p.ptr();
+            if (feature.kind == kFloat) {
+              if (!p.Advance(4))
+                return;
+              value(elem, 4, kFixed32);
+            } else {
+              uint64_t v;
+              if (!p.ReadVarint(v))
+                return;
+              value(elem, p.ptr() - elem, kVarint);
+            }
+          }
+        } else if (!r.Skip(wire)) {
+          return;
+        }
+      }
+    }
+  }
+
+  std::unordered_map<std::string_view, int> lookup_;
+};
+
+}  // namespace TFUtil
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_PARSER_TF_EXAMPLE_VIEW_H_
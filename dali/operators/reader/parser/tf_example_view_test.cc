@@ -0,0 +1,218 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/operators/reader/parser/tf_example_view.h"
+
+namespace dali {
+
+namespace {
+
+using TFUtil::ExampleView;
+
+// A minimal protobuf encoder, so that the test doesn't depend on the generated messages
+class Message {
+ public:
+  Message &Varint(int field, uint64_t value) {
+    Tag(field, 0);
+    PutVarint(value);
+    return *this;
+  }
+
+  Message &Fixed32(int field, float value) {
+    Tag(field, 5);
+    return Element(value);
+  }
+
+  Message &Bytes(int field, const std::string &value) {
+    Tag(field, 2);
+    PutVarint(value.size());
+    data_.insert(data_.end(), value.begin(), value.end());
+    return *this;
+  }
+
+  Message &Bytes(int field, const Message &message) {
+    return Bytes(field, message.str());
+  }
+
+  /**
+   * @brief Adds a value without a tag - an element of a packed list
+   */
+  Message &Element(uint64_t value) {
+    PutVarint(value);
+    return *this;
+  }
+
+  Message &Element(float value) {
+    uint8_t bytes[4];
+    std::memcpy(bytes, &value, 4);
+    data_.insert(data_.end(), bytes, bytes + 4);
+    return *this;
+  }
+
+  std::string str() const {
+    return {data_.begin(), data_.end()};
+  }
+
+  std::vector<uint8_t> data() const {
+    return data_;
+  }
+
+ private:
+  void Tag(int field, int wire) {
+    PutVarint(field << 3 | wire);
+  }
+
+  void PutVarint(uint64_t value) {
+    do {
+      data_.push_back((value & 0x7f) | (value >= 0x80 ? 0x80 : 0));
+      value >>= 7;
+    } while (value);
+  }
+
+  std::vector<uint8_t> data_;
+};
+
+// A packed list: Int64List or FloatList
+template <typename T>
+Message Packed(const std::vector<T> &values) {
+  Message payload;
+  for (auto v : values)
+    payload.Element(v);
+  return Message().Bytes(1, payload);
+}
+
+// Example { Features { map<string, Feature> } }
+std::vector<uint8_t> MakeExample(const std::vector<std::pair<std::string, Message>> &features) {
+  Message map;
+  for (auto &f : features)
+    map.Bytes(1, Message().Bytes(1, f.first).Bytes(2, f.second));
+  return Message().Bytes(1, map).data();
+}
+
+std::vector<std::string> Bytes(const ExampleView::FeatureView &feature) {
+  std::vector<std::string> values;
+  ExampleView::ForEachBytes(feature, [&](span<const uint8_t> v) {
+    values.emplace_back(reinterpret_cast<const char *>(v.data()), v.size());
+  });
+  return values;
+}
+
+std::vector<int64_t> Int64s(const ExampleView::FeatureView &feature) {
+  std::vector<int64_t> values(ExampleView::NumValues(feature));
+  ExampleView::CopyInt64(feature, values.data());
+  return values;
+}
+
+std::vector<float> Floats(const ExampleView::FeatureView &feature) {
+  std::vector<float> values(ExampleView::NumValues(feature));
+  ExampleView::CopyFloats(feature, values.data());
+  return values;
+}
+
+}  // namespace
+
+TEST(TFExampleView, Features) {
+  std::string jpeg("\xff\xd8\0\x01", 4);
+  std::vector<uint64_t> labels = {0, 1, static_cast<uint64_t>(-1), 1ul << 40};
+  std::vector<float> xmin = {0.5f, -2.0f, 1e10f};
+  auto data = MakeExample({
+    {"image/encoded", Message().Bytes(1, Message().Bytes(1, jpeg).Bytes(1, "second"))},
+    {"image/class/label", Message().Bytes(3, Packed(labels))},
+    {"skipped", Message().Bytes(1, Message().Bytes(1, "skipped"))},
+    {"image/object/bbox/xmin", Message().Bytes(2, Packed(xmin))},
+    {"empty", Message().Bytes(3, Message())},
+  });
+
+  std::vector<std::string> names = {"image/encoded", "image/class/label",
+                                    "image/object/bbox/xmin", "empty", "missing"};
+  ExampleView view(names);
+  std::vector<ExampleView::FeatureView> out;
+  ASSERT_TRUE(view.Parse(data.data(), data.size(), out));
+  ASSERT_EQ(out.size(), names.size());
+
+  auto &encoded = out[view.FeatureIndex("image/encoded")];
+  EXPECT_TRUE(encoded.found);
+  EXPECT_EQ(encoded.kind, ExampleView::kBytes);
+  EXPECT_EQ(Bytes(encoded), (std::vector<std::string>{jpeg, "second"}));
+  // the values are views of the input
+  ExampleView::ForEachBytes(encoded, [&](span<const uint8_t> v) {
+    EXPECT_GE(v.data(), data.data());
+    EXPECT_LE(v.data() + v.size(), data.data() + data.size());
+  });
+
+  auto &label = out[view.FeatureIndex("image/class/label")];
+  EXPECT_EQ(label.kind, ExampleView::kInt64);
+  EXPECT_EQ(Int64s(label), (std::vector<int64_t>{0, 1, -1, 1l << 40}));
+  // no values of a different kind
+  EXPECT_TRUE(Bytes(label).empty());
+
+  auto &bbox = out[view.FeatureIndex("image/object/bbox/xmin")];
+  EXPECT_EQ(bbox.kind, ExampleView::kFloat);
+  EXPECT_EQ(Floats(bbox), xmin);
+
+  auto &empty = out[view.FeatureIndex("empty")];
+  EXPECT_TRUE(empty.found);
+  EXPECT_EQ(ExampleView::NumValues(empty), 0);
+
+  EXPECT_FALSE(out[view.FeatureIndex("missing")].found);
+  EXPECT_EQ(view.FeatureIndex("skipped"), -1);
+}
+
+TEST(TFExampleView, UnpackedAndRepeated) {
+  std::vector<std::string> names = {"x", "y"};
+  ExampleView view(names);
+  std::vector<ExampleView::FeatureView> out;
+
+  // unpacked lists; a list of another kind replaces the previous one, lists of the same kind
+  // are concatenated
+  auto data = MakeExample({
+    {"x", Message().Bytes(3, Message().Varint(1, 1).Varint(1, 300))
+                   .Bytes(2, Message().Fixed32(1, 1.0f))
+                   .Bytes(2, Message().Fixed32(1, 2.0f))},
+    {"y", Message().Bytes(3, Message().Varint(1, 7))},
+  });
+  ASSERT_TRUE(view.Parse(data.data(), data.size(), out));
+  EXPECT_EQ(out[0].kind, ExampleView::kFloat);
+  EXPECT_EQ(Floats(out[0]), (std::vector<float>{1.0f, 2.0f}));
+  EXPECT_EQ(Int64s(out[1]), std::vector<int64_t>{7});
+
+  // a repeated key replaces the previous value, repeated messages are merged
+  auto second = MakeExample({{"x", Message().Bytes(3, Message().Varint(1, 1).Varint(1, 300))}});
+  data.insert(data.end(), second.begin(), second.end());
+  ASSERT_TRUE(view.Parse(data.data(), data.size(), out));
+  EXPECT_EQ(out[0].kind, ExampleView::kInt64);
+  EXPECT_EQ(Int64s(out[0]), (std::vector<int64_t>{1, 300}));
+  EXPECT_EQ(Int64s(out[1]), std::vector<int64_t>{7});
+}
+
+TEST(TFExampleView, InvalidData) {
+  auto data = MakeExample({{"a", Message().Bytes(1, Message().Bytes(1, "abc"))}});
+  std::vector<std::string> names = {"a"};
+  ExampleView view(names);
+  std::vector<ExampleView::FeatureView> out;
+  for (size_t size = 1; size < data.size(); size++)
+    EXPECT_FALSE(view.Parse(data.data(), size, out)) << size;
+  std::vector<uint8_t> garbage = {0xff, 0xff, 0xff};
+  EXPECT_FALSE(view.Parse(garbage.data(), garbage.size(), out));
+  EXPECT_TRUE(view.Parse(data.data(), 0, out));
+  EXPECT_FALSE(out[0].found);
+}
+
+}  // namespace dali
@@ -17,6 +17,8 @@
 
 #ifdef DALI_BUILD_PROTO3
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 #include <string>
 #include <exception>
@@ -27,7 +29,7 @@
 #include "dali/pipeline/operator/op_spec.h"
 #include "dali/operators/reader/parser/parser.h"
 #include "dali/operators/reader/parser/tf_feature.h"
-#include "dali/operators/reader/parser/example.pb.h"
+#include "dali/operators/reader/parser/tf_example_view.h"
 
 namespace dali {
 
@@ -35,20 +37,25 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
  public:
   using FeatureType = TFUtil::FeatureType;
   using Feature = TFUtil::Feature;
+  using ExampleView = TFUtil::ExampleView;
 
   explicit TFRecordParser(const OpSpec& spec) :
-    Parser<Tensor<CPUBackend>>(spec) {
-    feature_names_ = spec.GetRepeatedArgument<string>("feature_names");
-    features_ = spec.GetRepeatedArgument<Feature>("features");
+    Parser<Tensor<CPUBackend>>(spec),
+    feature_names_(spec.GetRepeatedArgument<string>("feature_names")),
+    features_(spec.GetRepeatedArgument<Feature>("features")),
+    example_view_(feature_names_),
+    thread_features_(std::max(1, spec.GetArgument<int>("num_threads"))) {
     DALI_ENFORCE(feature_names_.size() == features_.size(),
         "Number of features needs to match number of feature names.");
     DALI_ENFORCE(features_.size() > 0,
         "No features provided");
+    for (auto &name : feature_names_)
+      feature_idx_.push_back(example_view_.FeatureIndex(name));
   }
 
-  void Parse(const Tensor<CPUBackend>& data, SampleWorkspace* ws) override {
-    tensorflow::Example example;
+  DISABLE_COPY_MOVE_ASSIGN(TFRecordParser);
 
+  void Parse(const Tensor<CPUBackend>& data, SampleWorkspace* ws) override {
     uint64_t length;
     uint32_t crc;
 
@@ -58,16 +65,29 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
 
     // Omit length and crc
     raw_data = raw_data + sizeof(length) + sizeof(crc);
-    DALI_ENFORCE(example.ParseFromArray(raw_data, length),
+    // The samples are parsed in parallel, by the threads of the thread pool; each thread
+    // reuses its own list of the feature views, so that no allocation is made per record
+    std::vector<ExampleView::FeatureView> local_features;
+    int thread_idx = ws->thread_idx();
+    auto &features = thread_idx >= 0 && thread_idx < static_cast<int>(thread_features_.size())
+                   ? thread_features_[thread_idx]
+                   : local_features;
+    const uint64_t header_size = sizeof(length) + sizeof(crc);
+    DALI_ENFORCE(length <= static_cast<uint64_t>(data.nbytes()) - header_size &&
+                 example_view_.Parse(raw_data, length, features),
       make_string("Error while parsing TFRecord file: ", data.GetSourceInfo(),
                   " (raw data length: ", length, "bytes)."));
+    // When the record was read from a memory-mapped file, the `bytes` features are not copied -
+    // the outputs alias the mapping and keep it alive
+    bool alias_record = data.shares_data();
 
     for (size_t i = 0; i < features_.size(); ++i) {
       auto& output = ws->Output<CPUBackend>(i);
+      // the output may still alias the previous record
+      if (output.shares_data())
+        output.Reset();
       Feature& f = features_[i];
-      std::string& name = feature_names_[i];
-      auto& feature = example.features().feature();
-      auto it = feature.find(name);
+      auto& encoded_feature = features[feature_idx_[i]];
       // set type
       switch (f.GetType()) {
         case FeatureType::int64:
@@ -80,49 +100,62 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
             output.set_type(DALI_FLOAT);
           break;
       }
-      if (it == feature.end()) {
+      if (!encoded_feature.found) {
         output.Resize({});
         output.SetSourceInfo(data.GetSourceInfo());
         continue;
       }
-      auto& encoded_feature = it->second;
       if (f.HasShape() && f.GetType() != FeatureType::string) {
         output.Resize(f.Shape());
       }
       ssize_t number_of_elms = 0;
       switch (f.GetType()) {
         case FeatureType::int64:
-          number_of_elms = encoded_feature.int64_list().value().size();
+          number_of_elms = encoded_feature.kind == ExampleView::kInt64
+                         ? ExampleView::NumValues(encoded_feature) : 0;
           if (!f.HasShape()) {
             output.Resize(InferShape(f, number_of_elms));
           }
           DALI_ENFORCE(number_of_elms <= output.size(), make_string("Output tensor shape is too "
                        "small: [", output.shape(), "]. Expected at least ", number_of_elms,
                        " elements."));
-          std::memcpy(output.mutable_data<int64_t>(),
-              encoded_feature.int64_list().value().data(),
-              encoded_feature.int64_list().value().size()*sizeof(int64_t));
+          ExampleView::CopyInt64(encoded_feature, output.mutable_data<int64_t>());
           break;
-        case FeatureType::string:
+        case FeatureType::string: {
           if (!f.HasShape() || volume(f.Shape()) > 1) {
             DALI_FAIL("Tensors of strings are not supported.");
           }
-          output.Resize({static_cast<Index>(encoded_feature.bytes_list().value(0).size())});
-          std::memcpy(output.mutable_data<uint8_t>(),
-              encoded_feature.bytes_list().value(0).c_str(),
-              encoded_feature.bytes_list().value(0).size()*sizeof(uint8_t));
+          span<const uint8_t> value;
+          bool has_value = false;
+          ExampleView::ForEachBytes(encoded_feature, [&](span<const uint8_t> v) {
+            if (!has_value)
+              value = v;
+            has_value = true;
+          });
+          DALI_ENFORCE(has_value, make_string("Feature \"", feature_names_[i], "\" in ",
+                       data.GetSourceInfo(), " contains no value."));
+          auto size = static_cast<Index>(value.size());
+          if (alias_record && size > 0 && !output.is_pinned()) {
+            std::shared_ptr<void> ptr(data.get_data_ptr(),
+                                      const_cast<uint8_t*>(value.data()));
+            output.ShareData(ptr, size, false, {size}, DALI_UINT8, output.device_id(),
+                             output.order());
+          } else {
+            output.Resize({size});
+            std::memcpy(output.mutable_data<uint8_t>(), value.data(), size * sizeof(uint8_t));
+          }
           break;
+        }
         case FeatureType::float32:
-          number_of_elms = encoded_feature.float_list().value().size();
+          number_of_elms = encoded_feature.kind == ExampleView::kFloat
+                         ? ExampleView::NumValues(encoded_feature) : 0;
           if (!f.HasShape()) {
             output.Resize(InferShape(f, number_of_elms));
           }
           DALI_ENFORCE(number_of_elms <= output.size(), make_string("Output tensor shape is too "
                        "small: [", output.shape(), "]. Expected at least ", number_of_elms,
                        " elements."));
-          std::memcpy(output.mutable_data<float>(),
-              encoded_feature.float_list().value().data(),
-              number_of_elms * sizeof(float));
+          ExampleView::CopyFloats(encoded_feature, output.mutable_data<float>());
           break;
       }
       output.SetSourceInfo(data.GetSourceInfo());
@@ -132,6 +165,11 @@ class TFRecordParser : public Parser<Tensor<CPUBackend>> {
  private:
   std::vector<std::string> feature_names_;
   std::vector<Feature> features_;
+  ExampleView example_view_;
+  // index of the output's feature in the result of example_view_.Parse
+  std::vector<int> feature_idx_;
+  // the parsed feature views, per thread
+  std::vector<std::vector<ExampleView::FeatureView>> thread_features_;
 
   std::vector<Index> InferShape(Feature& feature, size_t feature_size) {
     if (feature.HasPartialShape()) {
@@ -16,18 +16,20 @@
 #define DALI_OPERATORS_READER_READER_OP_H_
 
 #include <atomic>
-#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 #include <unordered_map>
 
-#include "dali/core/nvtx.h"
+#include "dali/core/trace.h"
 #include "dali/operators/reader/loader/loader.h"
 #include "dali/operators/reader/parser/parser.h"
 #include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/util/lock_free_queue.h"
 
 namespace dali {
 
@@ -60,8 +62,6 @@ class DataReader : public Operator<Backend> {
         prefetched_batch_queue_(prefetch_queue_depth_),
         curr_batch_consumer_(0),
         curr_batch_producer_(0),
-        consumer_cycle_(false),
-        producer_cycle_(false),
         device_id_(-1),
         samples_processed_(0) {
           if (std::is_same<Backend, GPUBackend>::value) {
@@ -81,14 +81,20 @@ class DataReader : public Operator<Backend> {
   // perform the prefetching operation
   virtual void Prefetch() {
     // We actually prepare the next batch
-    DomainTimeRange tr("[DALI][DataReader] Prefetch #" + to_string(curr_batch_producer_),
-                       DomainTimeRange::kRed);
+    TraceScope tr(TraceEvent::ReaderPrefetch, curr_batch_producer_);
     auto &curr_batch = prefetched_batch_queue_[curr_batch_producer_];
     curr_batch.clear();
     curr_batch.reserve(max_batch_size_);
-    for (int i = 0; i < max_batch_size_; ++i) {
-      curr_batch.push_back(loader_->ReadOne(i == 0));
+    try {
+      for (int i = 0; i < max_batch_size_; ++i) {
+        curr_batch.push_back(loader_->ReadOne(i == 0));
+      }
+    } catch (...) {
+      // don't leave any reads in flight - they use the loader
+      loader_->WaitForReads(false);
+      throw;
     }
+    loader_->WaitForReads();
   }
 
   // Main prefetch work loop
@@ -99,6 +105,8 @@ class DataReader : public Operator<Backend> {
     while (!finished_) {
       try {
         Prefetch();
+        if (loader_ && loader_->CheckpointingEnabled())
+          RecordState(batches_produced_.load(std::memory_order_relaxed) + 1);
       } catch (const std::exception& e) {
         ProducerStop(std::current_exception());
         return;
@@ -113,6 +121,8 @@ class DataReader : public Operator<Backend> {
     std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
     // if thread hasn't been started yet, start it
     if (prefetch_thread_.joinable()) return;
+    if (loader_ && loader_->CheckpointingEnabled())
+      RecordState(0);
     prefetch_thread_ = std::thread(&DataReader::PrefetchWorker, this);
   }
 
@@ -120,7 +130,6 @@ class DataReader : public Operator<Backend> {
   void StopPrefetchThread() {
     ProducerStop();
     if (prefetch_thread_.joinable()) {
-      producer_.notify_one();
       // join the prefetch thread and destroy it
       prefetch_thread_.join();
       prefetch_thread_ = {};
@@ -139,8 +148,7 @@ class DataReader : public Operator<Backend> {
   // CPUBackend operators
   void Run(HostWorkspace &ws) override {
     // consume batch
-    DomainTimeRange tr("[DALI][DataReader] Run #" + to_string(curr_batch_consumer_),
-                       DomainTimeRange::kViolet);
+    TraceScope tr(TraceEvent::ReaderRun, curr_batch_consumer_);
 
     // This is synchronous call for CPU Backend
     Operator<Backend>::Run(ws);
@@ -198,6 +206,43 @@ class DataReader : public Operator<Backend> {
     return ret;
   }
 
+  std::string GetReaderState(int64_t iteration) override {
+    DALI_ENFORCE(loader_ && loader_->CheckpointingEnabled(), make_string(
+                 "The state of reader ", spec_.name(), " is available only when "
+                 "`enable_checkpointing` is set."));
+    {
+      std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
+      if (!prefetch_thread_.joinable()) {
+        DALI_ENFORCE(iteration == 0, "The reader hasn't read anything yet.");
+        return loader_->SaveState();
+      }
+    }
+    std::lock_guard<std::mutex> lock(state_history_mutex_);
+    for (auto &entry : state_history_) {
+      if (entry.first == iteration)
+        return entry.second;
+    }
+    DALI_FAIL(make_string("The state of reader ", spec_.name(), " after ", iteration,
+              " iterations is no longer available. The state can be saved only for the "
+              "iterations close to the ones being prefetched."));
+  }
+
+  void RestoreReaderState(const std::string &state) override {
+    DALI_ENFORCE(loader_ && loader_->CheckpointingEnabled(), make_string(
+                 "The state of reader ", spec_.name(), " can be restored only when "
+                 "`enable_checkpointing` is set."));
+    std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
+    DALI_ENFORCE(!prefetch_thread_.joinable(),
+                 "The state of the reader can be restored only before the pipeline is run.");
+    loader_->RestoreState(state);
+  }
+
+  void ReshardReader(int num_shards, int shard_id, int64_t at_sample) override {
+    DALI_ENFORCE(loader_, make_string("Reader ", spec_.name(), " cannot be resharded."));
+    std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
+    loader_->Reshard(num_shards, shard_id, at_sample, prefetch_thread_.joinable());
+  }
+
   inline std::vector<std::shared_ptr<LoadTarget>>& GetCurrBatch() {
     return prefetched_batch_queue_[curr_batch_consumer_];
   }
@@ -270,67 +315,77 @@ class DataReader : public Operator<Backend> {
     }
   }
 
+  /*
+   * The prefetch queue is a single-producer single-consumer ring: the prefetch thread owns
+   * curr_batch_producer_, the operator owns curr_batch_consumer_ and they only communicate
+   * through the batches_produced_ and batches_consumed_ counters. A side parks only when
+   * the queue is full (producer) or empty (consumer).
+   */
+
+  // the state of the loader after `iteration` batches, taken by the producer
+  void RecordState(int64_t iteration) {
+    auto state = loader_->SaveState();
+    std::lock_guard<std::mutex> lock(state_history_mutex_);
+    state_history_.emplace_back(iteration, std::move(state));
+    if (state_history_.size() > kMaxStateHistory)
+      state_history_.pop_front();
+  }
+
   void ProducerStop(std::exception_ptr error = nullptr) {
-    {
-      std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
-      finished_ = true;
-      if (error)
-        prefetch_error_ = error;
-    }
-    consumer_.notify_all();
+    // the error is published by the store to finished_
+    if (error)
+      prefetch_error_ = error;
+    finished_ = true;
+    consumer_.Notify();
+    producer_.Notify();
   }
 
   void ProducerAdvanceQueue() {
-    {
-      std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
-      AdvanceIndex(curr_batch_producer_, producer_cycle_);
-    }
-    consumer_.notify_all();
+    AdvanceIndex(curr_batch_producer_);
+    batches_produced_.fetch_add(1, std::memory_order_release);
+    consumer_.Notify();
   }
 
   void ProducerWait() {
-    std::unique_lock<std::mutex> lock(prefetch_access_mutex_);
-    producer_.wait(lock, [&]() { return finished_ || !IsPrefetchQueueFull(); });
+    producer_.Wait([&]() { return finished_ || !IsPrefetchQueueFull(); });
   }
 
   void ConsumerWait() {
-    DomainTimeRange tr("[DALI][DataReader] ConsumerWait #" + to_string(curr_batch_consumer_),
-                 DomainTimeRange::kMagenta);
-    std::unique_lock<std::mutex> prefetch_lock(prefetch_access_mutex_);
-    consumer_.wait(prefetch_lock, [this]() { return finished_ || !IsPrefetchQueueEmpty(); });
-    if (prefetch_error_) std::rethrow_exception(prefetch_error_);
+    TraceScope tr(TraceEvent::ReaderConsumerWait, curr_batch_consumer_);
+    consumer_.Wait([this]() { return finished_ || !IsPrefetchQueueEmpty(); });
+    if (finished_ && prefetch_error_) std::rethrow_exception(prefetch_error_);
   }
 
   void ConsumerAdvanceQueue() {
-    {
-      std::lock_guard<std::mutex> lock(prefetch_access_mutex_);
-      AdvanceIndex(curr_batch_consumer_, consumer_cycle_);
-    }
-    producer_.notify_one();
+    AdvanceIndex(curr_batch_consumer_);
+    batches_consumed_.fetch_add(1, std::memory_order_release);
+    producer_.Notify();
   }
 
-  void AdvanceIndex(int& index, bool& cycle) {
+  void AdvanceIndex(int& index) {
     index = (index + 1) % prefetch_queue_depth_;
-    if (index == 0) cycle = !cycle;
   }
 
-  bool IsPrefetchQueueEmpty() {
-    return curr_batch_producer_ == curr_batch_consumer_ && consumer_cycle_ == producer_cycle_;
+  bool IsPrefetchQueueEmpty() const {
+    return batches_produced_.load(std::memory_order_acquire) ==
+           batches_consumed_.load(std::memory_order_acquire);
   }
 
-  bool IsPrefetchQueueFull() {
-    return curr_batch_producer_ == curr_batch_consumer_ && consumer_cycle_ != producer_cycle_;
+  bool IsPrefetchQueueFull() const {
+    return batches_produced_.load(std::memory_order_acquire) -
+           batches_consumed_.load(std::memory_order_acquire) >=
+           static_cast<uint64_t>(prefetch_queue_depth_);
   }
 
   USE_OPERATOR_MEMBERS();
 
   std::thread prefetch_thread_;
 
-  // mutex to control access to the producer
+  // mutex guarding the start of the prefetch thread
   std::mutex prefetch_access_mutex_;
 
-  // signals for producer and consumer
-  std::condition_variable producer_, consumer_;
+  // parking of the producer (when the queue is full) and the consumer (when it's empty)
+  Parker producer_, consumer_;
 
   // signal that the prefetch thread has finished
   std::atomic<bool> finished_;
@@ -342,8 +397,8 @@ class DataReader : public Operator<Backend> {
   std::vector<BatchQueueElement> prefetched_batch_queue_;
   int curr_batch_consumer_;
   int curr_batch_producer_;
-  bool consumer_cycle_;
-  bool producer_cycle_;
+  std::atomic<uint64_t> batches_produced_{0};
+  std::atomic<uint64_t> batches_consumed_{0};
   int device_id_;
 
   // keep track of how many samples have been processed over all threads.
@@ -352,6 +407,11 @@ class DataReader : public Operator<Backend> {
   // stores any catched exceptions in the prefetch worker
   std::exception_ptr prefetch_error_;
 
+  // the states of the loader after the recently produced batches (`enable_checkpointing`)
+  static constexpr size_t kMaxStateHistory = 64;
+  std::mutex state_history_mutex_;
+  std::deque<std::pair<int64_t, std::string>> state_history_;
+
   // Loader
   std::unique_ptr<Loader<Backend, LoadTarget>> loader_;
 
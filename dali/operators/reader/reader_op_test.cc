@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include <chrono>
 #include <cstdio>
+#include <fstream>
 #include <string>
 #include <thread>
 #include <utility>
@@ -246,6 +247,45 @@ TYPED_TEST(ReaderTest, SequenceTest) {
   return;
 }
 
+TYPED_TEST(ReaderTest, FileReaderContiguousOutputs) {
+  const int batch_size = 4;
+  const std::string file_root = testing::dali_extra_path() + "/db/single/jpeg";
+  Pipeline pipe(batch_size, 2, 0);
+
+  pipe.AddOperator(
+      OpSpec("readers__File")
+      .AddArg("file_root", file_root)
+      .AddOutput("files", "cpu")
+      .AddOutput("labels", "cpu"));
+
+  std::vector<std::pair<string, string>> outputs = {{"files", "cpu"}, {"labels", "cpu"}};
+  pipe.Build(outputs);
+
+  DeviceWorkspace ws;
+  for (int i = 0; i < 3; ++i) {
+    pipe.RunCPU();
+    pipe.RunGPU();
+    pipe.Outputs(&ws);
+    auto &files = ws.Output<CPUBackend>(0);
+    auto &labels = ws.Output<CPUBackend>(1);
+    ASSERT_EQ(files.num_samples(), batch_size);
+    ASSERT_EQ(labels.num_samples(), batch_size);
+    EXPECT_TRUE(files.IsContiguous());
+    EXPECT_TRUE(labels.IsContiguous());
+    EXPECT_EQ(labels.type(), DALI_INT32);
+    for (int sample = 0; sample < batch_size; sample++) {
+      std::ifstream f(file_root + "/" + files.GetMeta(sample).GetSourceInfo(),
+                      std::ios::binary | std::ios::ate);
+      ASSERT_TRUE(f.good());
+      EXPECT_EQ(files.tensor_shape(sample), TensorShape<>{static_cast<int64_t>(f.tellg())});
+      // every file is a JPEG
+      EXPECT_EQ(files.tensor<uint8_t>(sample)[0], 0xFF);
+      EXPECT_EQ(files.tensor<uint8_t>(sample)[1], 0xD8);
+      EXPECT_GE(labels.tensor<int>(sample)[0], 0);
+    }
+  }
+}
+
 class TestLoader : public Loader<CPUBackend, Tensor<CPUBackend>> {
  public:
   explicit TestLoader(const OpSpec& spec) :
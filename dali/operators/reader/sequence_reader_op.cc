@@ -1,4 +1,4 @@
-// Copyright (c) 2018, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2018-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -33,6 +33,10 @@ an extracted video stream. This stream is represented by one file for each frame
 sorted lexicographically. Sequences do not cross the stream boundary and only complete sequences
 are considered, so there is no padding.
 
+The frames of a sequence are read concurrently when ``num_read_threads`` is greater than 1, and
+the frames shared by consecutive, overlapping sequences (``step`` smaller than the span of
+a sequence) are read once, unless ``random_shuffle`` is set.
+
 Example directory structure::
 
   - file_root
@@ -72,6 +76,12 @@ represent streams.)code",
                     R"code(Distance between consecutive frames in a sequence.)code", 1, false)
     .AddOptionalArg("image_type",
                     R"code(The color space of input and output image.)code", DALI_RGB, false)
+    .AddOptionalArg("file_filter",
+                    R"code(A glob string to filter the names of the frame files in the stream
+directories.
+
+Only the files with the known image extensions are considered, regardless of the filter.)code",
+                    "*")
     .AddParent("LoaderBase")
     .AllowSequences();
 
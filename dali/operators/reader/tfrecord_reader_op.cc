@@ -40,12 +40,12 @@ DALI_SCHEMA(readers___TFRecordBase)
   .AddArg("path",
       R"code(List of paths to TFRecord files.)code",
       DALI_STRING_VEC)
-  .AddArg("index_path",
+  .AddOptionalArg("index_path",
       R"code(List of paths to index files. There should be one index file for every TFRecord file.
 
 The index files can be obtained from TFRecord files by using the ``tfrecord2idx`` script
-that is distributed with DALI.)code",
-      DALI_STRING_VEC);
+that is distributed with DALI. Required unless ``streaming`` is used; ignored otherwise.)code",
+      std::vector<std::string>());
 
 // Internal readers._tfrecord schema.
 DALI_SCHEMA(readers___TFRecord)
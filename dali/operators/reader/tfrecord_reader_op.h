@@ -19,6 +19,7 @@
 
 #include "dali/operators/reader/reader_op.h"
 #include "dali/operators/reader/loader/indexed_file_loader.h"
+#include "dali/operators/reader/loader/tfrecord_stream_loader.h"
 #include "dali/operators/reader/parser/tfrecord_parser.h"
 
 namespace dali {
@@ -27,7 +28,10 @@ class TFRecordReader : public DataReader<CPUBackend, Tensor<CPUBackend>> {
  public:
   explicit TFRecordReader(const OpSpec& spec)
   : DataReader<CPUBackend, Tensor<CPUBackend>>(spec) {
-    loader_ = InitLoader<IndexedFileLoader>(spec);
+    if (spec.GetArgument<bool>("streaming"))
+      loader_ = InitLoader<TFRecordStreamLoader>(spec);
+    else
+      loader_ = InitLoader<IndexedFileLoader>(spec);
     parser_.reset(new TFRecordParser(spec));
     DALI_ENFORCE(!skip_cached_images_,
       "TFRecordReader doesn't support `skip_cached_images` option");
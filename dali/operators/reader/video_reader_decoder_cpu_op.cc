@@ -13,6 +13,7 @@
 // limitations under the License.
 #include "dali/operators/reader/video_reader_decoder_cpu_op.h"
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -20,10 +21,34 @@ namespace dali {
 
 VideoReaderDecoderCpu::VideoReaderDecoderCpu(const OpSpec &spec)
     : DataReader<CPUBackend, VideoSampleCpu>(spec),
-      has_labels_(spec.HasArgument("labels")) {
+      has_labels_(spec.HasArgument("labels")),
+      thread_pool_(spec.GetArgument<int>("num_threads"), CPU_ONLY_DEVICE_ID, false,
+                   "VideoReaderDecoderCpu") {
       loader_ = InitLoader<VideoLoaderDecoderCpu>(spec);
 }
 
+void VideoReaderDecoderCpu::Prefetch() {
+  DataReader<CPUBackend, VideoSampleCpu>::Prefetch();
+
+  auto &current_batch = prefetched_batch_queue_[curr_batch_producer_];
+
+  // Each file has its own decoder, so the samples from different files are decoded
+  // at the same time. The samples from the same file are decoded one after another.
+  std::map<FramesDecoder *, std::vector<VideoSampleCpu *>> samples_per_file;
+  for (auto &sample : current_batch) {
+    samples_per_file[sample->video_file_].push_back(sample.get());
+  }
+  for (auto &file_samples : samples_per_file) {
+    auto &samples = file_samples.second;
+    thread_pool_.AddWork([&samples](int) {
+      for (auto *sample : samples) {
+        sample->Decode();
+      }
+    });
+  }
+  thread_pool_.RunAll();
+}
+
 void VideoReaderDecoderCpu::RunImpl(SampleWorkspace &ws) {
   const auto &sample = GetSample(ws.data_idx());
   auto &video_output = ws.template Output<CPUBackend>(0);
@@ -52,6 +77,10 @@ The video streams can be in most of the container file formats. FFmpeg is used t
 containers and returns a batch of sequences of ``sequence_length`` frames with shape
 ``(N, F, H, W, C)``, where ``N`` is the batch size, and ``F`` is the number of frames).
 
+The samples from different files are decoded in parallel, with the threads of the pipeline
+(``num_threads``). In the CPU variant, when there are more threads than samples in a batch,
+FFmpeg uses the remaining ones to decode the frames of each file.
+
 .. note::
   Containers which do not support indexing, like MPEG, require DALI to build the index.
 DALI will go through the video and mark keyframes to be able to seek effectively,
@@ -73,6 +102,19 @@ When the value is less than 0, ``step`` is set to ``sequence_length``.)code",
       -1)
   .AddOptionalArg("stride",
       R"code(Distance between consecutive frames in the sequence.)code", 1u, false)
+  .AddOptionalArg("align_to_keyframes",
+      R"code(If set to True, each sequence starts at the first keyframe within ``step`` frames
+from its regular start, if there is one.
+
+Decoding a sequence has to start at the preceding keyframe, so the sequences which start
+at keyframes are read without decoding and discarding the frames before them.)code", false)
+  .AddOptionalArg("index_cache_dir",
+      R"code(Path to a directory where the frame indices of the video files are stored.
+
+Building the index requires reading the whole video file. With this option, the index of
+each file is built once and then read from the directory, as long as the path, the size and
+the modification time of the file don't change. If empty, the indices are not stored.)code",
+      std::string())
   .AddParent("LoaderBase");
 
 }  // namespace dali
@@ -17,17 +17,23 @@
 
 #include "dali/operators/reader/reader_op.h"
 #include "dali/operators/reader/loader/video/video_loader_decoder_cpu.h"
+#include "dali/pipeline/util/thread_pool.h"
 
 namespace dali {
-class VideoReaderDecoderCpu : public DataReader<CPUBackend, VideoSample<CPUBackend>> {
+class VideoReaderDecoderCpu : public DataReader<CPUBackend, VideoSampleCpu> {
  public:
   explicit VideoReaderDecoderCpu(const OpSpec &spec);
 
+  void Prefetch() override;
+
  protected:
   void RunImpl(SampleWorkspace &ws) override;
 
  private:
   bool has_labels_ = false;
+
+  /// Decodes the samples from different files at the same time
+  ThreadPool thread_pool_;
 };
 
 }  // namespace dali
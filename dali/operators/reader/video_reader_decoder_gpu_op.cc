@@ -13,6 +13,8 @@
 // limitations under the License.
 #include "dali/operators/reader/video_reader_decoder_gpu_op.h"
 
+#include <algorithm>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -20,7 +22,10 @@ namespace dali {
 
 VideoReaderDecoderGpu::VideoReaderDecoderGpu(const OpSpec &spec)
     : DataReader<GPUBackend, VideoSampleGpu>(spec),
-      has_labels_(spec.HasArgument("labels")) {
+      has_labels_(spec.HasArgument("labels")),
+      thread_pool_(spec.GetArgument<int>("num_threads"), spec.GetArgument<int>("device_id"),
+                   false, "VideoReaderDecoderGpu"),
+      stream_(CUDAStreamPool::instance().Get(spec.GetArgument<int>("device_id"))) {
       loader_ = InitLoader<VideoLoaderDecoderGpu>(spec);
 }
 
@@ -28,9 +33,35 @@ void VideoReaderDecoderGpu::Prefetch() {
   DataReader<GPUBackend, VideoSampleGpu>::Prefetch();
 
   auto &current_batch = prefetched_batch_queue_[curr_batch_producer_];
+
+  // Each file has its own decoder, so the samples from different files are decoded
+  // at the same time. The samples from the same file are decoded one after another.
+  std::map<FramesDecoderGpu *, std::vector<VideoSampleGpu *>> samples_per_file;
+  for (auto &sample : current_batch) {
+    samples_per_file[sample->video_file_].push_back(sample.get());
+  }
+  for (auto &file_samples : samples_per_file) {
+    auto &samples = file_samples.second;
+    thread_pool_.AddWork([&samples](int) {
+      for (auto *sample : samples) {
+        sample->Decode();
+      }
+    });
+  }
+  thread_pool_.RunAll();
+
+  // Convert all the frames of the batch with one kernel
+  frames_.clear();
+  int max_width = 0, max_height = 0;
   for (auto &sample : current_batch) {
-    sample->Decode();
+    sample->AddFramesToConvert(frames_);
+    max_width = std::max(max_width, sample->video_file_->Width());
+    max_height = std::max(max_height, sample->video_file_->Height());
   }
+  frames_gpu_.from_host(frames_, cudaStream_t(stream_));
+  yuv_to_rgb_batch(frames_gpu_.data(), frames_.size(), max_width, max_height, stream_);
+  CUDA_CALL(cudaGetLastError());
+  CUDA_CALL(cudaStreamSynchronize(stream_));
 }
 
 bool VideoReaderDecoderGpu::SetupImpl(
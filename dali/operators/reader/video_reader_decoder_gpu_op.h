@@ -17,8 +17,11 @@
 
 #include <vector>
 
+#include "dali/core/cuda_stream_pool.h"
+#include "dali/core/dev_buffer.h"
 #include "dali/operators/reader/reader_op.h"
 #include "dali/operators/reader/loader/video/video_loader_decoder_gpu.h"
+#include "dali/pipeline/util/thread_pool.h"
 
 namespace dali {
 class VideoReaderDecoderGpu : public DataReader<GPUBackend, VideoSampleGpu> {
@@ -35,6 +38,12 @@ class VideoReaderDecoderGpu : public DataReader<GPUBackend, VideoSampleGpu> {
 
  private:
   bool has_labels_ = false;
+
+  /// Decodes the samples from different files at the same time
+  ThreadPool thread_pool_;
+  CUDAStreamLease stream_;
+  std::vector<YuvToRgbSample> frames_;
+  DeviceBuffer<YuvToRgbSample> frames_gpu_;
 };
 
 }  // namespace dali
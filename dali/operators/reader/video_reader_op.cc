@@ -24,8 +24,7 @@
 namespace dali {
 
 void VideoReader::Prefetch() {
-  DomainTimeRange tr("[DALI][VideoReader] Prefetch #" + to_string(curr_batch_producer_),
-                      DomainTimeRange::kRed);
+  TraceScope tr(TraceEvent::ReaderPrefetch, curr_batch_producer_, "VideoReader");
   DataReader<GPUBackend, SequenceWrapper>::Prefetch();
   auto &curr_batch = prefetched_batch_queue_[curr_batch_producer_];
   auto &curr_tensor_list = prefetched_batch_tensors_[curr_batch_producer_];
@@ -53,10 +52,20 @@ void VideoReader::Prefetch() {
                                curr_tensor_list.order());
     sample->sequence.set_device_id(curr_tensor_list.device_id());
     sample->sequence.SetMeta(curr_tensor_list.GetMeta(data_idx));
-    sample->read_sample_f();
-    // data has been read, decouple sequence from the wrapped memory
-    sample->sequence.Reset();
+    auto read = [&sample]() {
+      sample->read_sample_f();
+      // data has been read, decouple sequence from the wrapped memory
+      sample->sequence.Reset();
+    };
+    if (read_pool_) {
+      // each sequence is decoded by the first decoder that gets free
+      read_pool_->AddWork([read](int) { read(); });
+    } else {
+      read();
+    }
   }
+  if (read_pool_)
+    read_pool_->RunAll();
   // make sure that frames have been processed
   for (int data_idx = 0; data_idx < curr_tensor_list.num_samples(); ++data_idx) {
     auto &sample = curr_batch[data_idx];
@@ -126,6 +135,24 @@ When the value is less than 0, ``step`` is set to ``sequence_length``.)code",
   .AddOptionalArg("channels",
       R"code(Number of channels.)code",
       3)
+  .AddOptionalArg("num_decoders",
+      R"code(The number of decoders which decode different sequences at the same time.
+
+Each decoder has its own file reading thread. Values greater than 1 allow the reader to use
+multiple NVDEC engines of the GPU (if present), at the cost of the additional GPU memory for
+the decode surfaces of each decoder.)code",
+      1)
+  .AddOptionalArg("frame_cache_size",
+      R"code(The size, in bytes, of the GPU memory used to keep the frames shared by
+the overlapping sequences (when ``step`` is smaller than the span of a sequence).
+
+The frames of a sequence which are also a part of the next sequence from the same file
+are kept, so that they're copied instead of being decoded again. When the cache is full,
+the least recently used frames are evicted. With the sliding window sampling and without
+shuffling, a size of two sequences per decoder is enough to decode each frame once.
+
+0 means that the cache is not used.)code",
+      static_cast<int64_t>(0))
   .AddOptionalArg("additional_decode_surfaces",
       R"code(Additional decode surfaces to use beyond minimum required.
 
@@ -18,9 +18,11 @@
 #include <string>
 #include <vector>
 #include <algorithm>
+#include <memory>
 
 #include "dali/operators/reader/loader/video_loader.h"
 #include "dali/operators/reader/reader_op.h"
+#include "dali/pipeline/util/thread_pool.h"
 
 namespace dali {
 namespace detail {
@@ -55,7 +57,8 @@ class VideoReader : public DataReader<GPUBackend, SequenceWrapper> {
         enable_timestamps_(spec.GetArgument<bool>("enable_timestamps")),
         count_(spec.GetArgument<int>("sequence_length")),
         channels_(spec.GetArgument<int>("channels")),
-        dtype_(spec.GetArgument<DALIDataType>("dtype")) {
+        dtype_(spec.GetArgument<DALIDataType>("dtype")),
+        num_decoders_(spec.GetArgument<int>("num_decoders")) {
     DALIImageType image_type(spec.GetArgument<DALIImageType>("image_type"));
 
     bool has_labels_arg = spec.TryGetRepeatedArgument(labels_, "labels");
@@ -95,6 +98,10 @@ class VideoReader : public DataReader<GPUBackend, SequenceWrapper> {
 
     // TODO(spanev): Factor out the constructor body to make VideoReader compatible with lazy_init.
     loader_ = InitLoader<VideoLoader>(spec, filenames_);
+    // the sequences are read in parallel only when there is more than one decoder to feed
+    if (num_decoders_ > 1)
+      read_pool_ = std::make_unique<ThreadPool>(num_decoders_, spec.GetArgument<int>("device_id"),
+                                                false, "VideoReader read pool");
 
     label_shape_ = uniform_list_shape(max_batch_size_, {1});
 
@@ -222,6 +229,9 @@ class VideoReader : public DataReader<GPUBackend, SequenceWrapper> {
   bool can_use_frames_timestamps_ = false;
   bool output_labels_ = false;
 
+  int num_decoders_;
+  std::unique_ptr<ThreadPool> read_pool_;
+
   USE_READER_OPERATOR_MEMBERS(GPUBackend, SequenceWrapper);
 };
 
@@ -36,6 +36,10 @@ the batch size, and F the number of frames in the sequence.
 
 This operator combines the features of :meth:`nvidia.dali.fn.video_reader` and :meth:`nvidia.dali.fn.resize`.
 
+When the linear interpolation is used without antialiasing (``antialias=False``) and
+the resize parameters are constants, the frames are resized by the decoder while they are
+converted to RGB, without the full resolution intermediate frames.
+
 .. note::
   The decoder supports only constant frame-rate videos.
 )code")
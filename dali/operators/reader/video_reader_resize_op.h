@@ -33,15 +33,63 @@ class VideoReaderResize : public VideoReader,
  public:
   explicit VideoReaderResize(const OpSpec &spec)
       : VideoReader(spec),
-        ResizeBase(spec) {
+        ResizeBase(spec),
+        resize_while_decoding_(CanResizeWhileDecoding(spec)) {
     ResizeBase::InitializeGPU(spec_.GetArgument<int>("minibatch_size"),
                               spec_.GetArgument<int64_t>("temp_buffer_hint"));
+    if (resize_while_decoding_) {
+      static_cast<VideoLoader &>(*loader_).SetFrameResize([this](SequenceWrapper &sequence) {
+        SetFrameResize(sequence);
+      });
+    }
   }
 
   inline ~VideoReaderResize() override = default;
 
  protected:
+  /**
+   * @brief Checks if the frames can be resized by the decoder, when they are converted to RGB
+   *
+   * The decoder samples the frames with bilinear interpolation, without antialiasing.
+   * The sizes must be known when the sequences are read, so the arguments have to be constants.
+   */
+  static bool CanResizeWhileDecoding(const OpSpec &spec) {
+    if (spec.NumArgumentInput() > 0)
+      return false;
+    auto interp = spec.GetArgument<DALIInterpType>("interp_type");
+    auto min_filter = spec.ArgumentDefined("min_filter")
+                          ? spec.GetArgument<DALIInterpType>("min_filter") : interp;
+    auto mag_filter = spec.ArgumentDefined("mag_filter")
+                          ? spec.GetArgument<DALIInterpType>("mag_filter") : interp;
+    return min_filter == DALI_INTERP_LINEAR && mag_filter == DALI_INTERP_LINEAR &&
+           !spec.GetArgument<bool>("antialias");
+  }
+
+  /**
+   * @brief Sets the output size and the source region of the frames of the sequence
+   *
+   * Called by the loader, from the prefetching thread.
+   */
+  void SetFrameResize(SequenceWrapper &sequence) {
+    auto shape = uniform_list_shape(1, TensorShape<>{
+        sequence.max_count, sequence.height, sequence.width, sequence.channels});
+    frame_resize_attr_.PrepareResizeParams(spec_, frame_resize_ws_, shape, "FHWC");
+    auto &params = frame_resize_attr_.params_[0];
+    sequence.resize_frames = true;
+    sequence.height = params.dst_size[0];
+    sequence.width = params.dst_size[1];
+    sequence.roi_y0 = params.src_lo[0];
+    sequence.roi_x0 = params.src_lo[1];
+    sequence.roi_y1 = params.src_hi[0];
+    sequence.roi_x1 = params.src_hi[1];
+  }
+
   void SetOutputShapeType(TensorList<GPUBackend> &output, DeviceWorkspace &ws) override {
+    if (resize_while_decoding_) {
+      // the frames have been resized by the decoder
+      VideoReader::SetOutputShapeType(output, ws);
+      return;
+    }
     input_shape_ = prefetched_batch_tensors_[curr_batch_consumer_].shape();
 
     resize_attr_.PrepareResizeParams(spec_, ws, input_shape_, "FHWC");
@@ -68,6 +116,10 @@ class VideoReaderResize : public VideoReader,
     TensorList<GPUBackend> &video_output,
     TensorList<GPUBackend> &video_batch,
     DeviceWorkspace &ws) override {
+    if (resize_while_decoding_) {
+      VideoReader::ProcessVideo(video_output, video_batch, ws);
+      return;
+    }
     TensorListShape<> input_shape(1, sequence_dim);
     for (int data_idx = 0; data_idx < video_batch.num_samples(); ++data_idx) {
       TensorList<GPUBackend> input;
@@ -93,6 +145,11 @@ class VideoReaderResize : public VideoReader,
  private:
   std::vector<kernels::ResamplingParams2D> resample_params_;
   TensorListShape<> input_shape_, output_shape_;
+
+  bool resize_while_decoding_ = false;
+  /// Used by the prefetching thread, separately from resize_attr_
+  ResizeAttr frame_resize_attr_;
+  ArgumentWorkspace frame_resize_ws_;
 };
 
 }  // namespace dali
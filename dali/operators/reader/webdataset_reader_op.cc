@@ -95,7 +95,8 @@ The index file can be generated using a dedicated script::
     <path_to_dali>/tools/wds2idx.py <path_to_archive> <path_to_index_file>
 
 If the index file is not provided, it will be automatically inferred from the tar file.
-Keep in mind though that it will add considerable startup time for big datasets.
+The archives are scanned in parallel and the inferred indices are stored (see ``cache_index``),
+so that only the first run pays the cost of scanning them.
 
 The format of the index file is::
 
@@ -127,7 +128,7 @@ Example: "left.png;right.jpg")code",
             R"code(The list of the index files corresponding to the respective webdataset archives.
 
 Has to be the same length as the ``paths`` argument. In case it is not provided,
-it will be inferred automatically from the webdataset archive.)code",
+it will be inferred automatically from the webdataset archive. Not used with ``streaming``.)code",
             std::vector<std::string>())
     .AddOptionalArg(
         "missing_component_behavior",
@@ -145,6 +146,19 @@ Moreover, the tar file should be constructed so that it will only output a sampl
 divisible by the size of the data type.)code",
                     DALI_DATA_TYPE_VEC,
                     nullptr)  // default is a vector of uint8
+    .AddOptionalArg("cache_index",
+            R"code(If set to True, the indices inferred from the archives (when ``index_paths``
+is not provided) are stored in ``index_cache_dir`` and read from there in the next runs.
+
+A stored index is used as long as the path, the size and the modification time of the archive
+don't change.)code",
+            true)
+    .AddOptionalArg("index_cache_dir",
+            R"code(Path to a directory where the inferred indices are stored (see ``cache_index``).
+
+If empty, ``$XDG_CACHE_HOME/dali/webdataset_index`` (by default
+``~/.cache/dali/webdataset_index``) is used.)code",
+            std::string())
     .AddParent("LoaderBase");
 
 DALI_REGISTER_OPERATOR(readers__Webdataset, WebdatasetReader, CPU);
@@ -0,0 +1,272 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/stat.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/core/convert.h"
+#include "dali/core/static_switch.h"
+#include "dali/operators/reader/loader/filesystem.h"
+#include "dali/operators/reader/zarr_reader_op.h"
+#include "dali/util/file.h"
+#include "dali/util/numpy.h"
+
+namespace dali {
+
+namespace {
+
+void Fill(void *data, int64_t n, DALIDataType type, double value) {
+  TYPE_SWITCH(type, type2id, T, NUMPY_ALLOWED_TYPES, (
+    std::fill_n(static_cast<T *>(data), n, ConvertSat<T>(value));
+  ), DALI_FAIL(make_string("Unsupported data type: ", type)));  // NOLINT
+}
+
+/**
+ * @brief Copies an N-D box of `extent` elements between two C-order arrays,
+ *        one innermost row at a time.
+ */
+void CopyBox(uint8_t *out, const int64_t *out_strides, const uint8_t *in,
+             const int64_t *in_strides, const int64_t *extent, int ndim, int64_t elem_size) {
+  if (ndim <= 1) {
+    std::memcpy(out, in, (ndim == 1 ? extent[0] : 1) * elem_size);
+    return;
+  }
+  for (int64_t i = 0; i < extent[0]; i++) {
+    CopyBox(out + i * out_strides[0] * elem_size, out_strides + 1,
+            in + i * in_strides[0] * elem_size, in_strides + 1, extent + 1, ndim - 1, elem_size);
+  }
+}
+
+bool ChunkExists(const std::string &path) {
+  struct stat st;
+  if (stat(path.c_str(), &st) == 0)
+    return true;
+  DALI_ENFORCE(errno == ENOENT, make_string("Cannot access the chunk \"", path, "\": ",
+                                            std::strerror(errno)));
+  return false;
+}
+
+}  // namespace
+
+ZarrReader::ZarrReader(const OpSpec& spec)
+    : DataReader<CPUBackend, ZarrArrayWrapper>(spec),
+      slice_attr_(spec, "roi_start", "rel_roi_start", "roi_end", "rel_roi_end", "roi_shape",
+                  "rel_roi_shape", "roi_axes", nullptr) {
+  bool shuffle_after_epoch = spec.GetArgument<bool>("shuffle_after_epoch");
+  loader_ = InitLoader<ZarrLoader>(spec, shuffle_after_epoch);
+  out_of_bounds_policy_ = GetOutOfBoundsPolicy(spec);
+  if (out_of_bounds_policy_ == OutOfBoundsPolicy::Pad) {
+    fill_value_ = spec.GetArgument<float>("fill_value");
+  }
+}
+
+bool ZarrReader::SetupImpl(std::vector<OutputDesc>& output_desc, const HostWorkspace& ws) {
+  // If necessary start prefetching thread and wait for a consumable batch
+  DataReader<CPUBackend, ZarrArrayWrapper>::SetupImpl(output_desc, ws);
+
+  int batch_size = GetCurrBatchSize();
+  const auto& arr_0 = GetSample(0);
+  DALIDataType output_type = arr_0.get_type();
+  int ndim = arr_0.get_shape().sample_dim();
+  TensorListShape<> sh(batch_size, ndim);
+
+  bool has_roi_args = slice_attr_.ProcessArguments<CPUBackend>(spec_, ws, batch_size, ndim);
+  rois_.resize(batch_size);
+  for (int i = 0; i < batch_size; i++) {
+    const auto& arr_i = GetSample(i);
+    const auto& arr_sh = arr_i.get_shape();
+    DALI_ENFORCE(
+        arr_sh.sample_dim() == ndim,
+        make_string("Inconsistent data: All samples in the batch must have the same number of "
+                    "dimensions. Got \"", arr_0.path, "\" with ", ndim, " dimensions and \"",
+                    arr_i.path, "\" with ", arr_sh.sample_dim(), " dimensions"));
+    DALI_ENFORCE(
+        arr_i.get_type() == output_type,
+        make_string("Inconsistent data: All samples in the batch must have the same data type. "
+                    "Got \"", arr_0.path, "\" with data type ", output_type, " and \"",
+                    arr_i.path, "\" with data type ", arr_i.get_type()));
+
+    auto& roi = rois_[i];
+    if (has_roi_args) {
+      roi = slice_attr_.GetCropWindowGenerator(i)(arr_sh, {});
+      ApplySliceBoundsPolicy(out_of_bounds_policy_, arr_sh, roi.anchor, roi.shape);
+    } else {
+      roi.anchor.resize(ndim);
+      for (int d = 0; d < ndim; d++)
+        roi.anchor[d] = 0;
+      roi.shape = arr_sh;
+    }
+    sh.set_tensor_shape(i, roi.shape);
+  }
+  output_desc.resize(1);
+  output_desc[0].shape = std::move(sh);
+  output_desc[0].type = output_type;
+  return true;
+}
+
+void ZarrReader::RunImpl(HostWorkspace &ws) {
+  auto &output = ws.Output<CPUBackend>(0);
+  auto &thread_pool = ws.GetThreadPool();
+  int nsamples = output.num_samples();
+  DALIDataType type = output.type();
+  int64_t elem_size = TypeTable::GetTypeInfo(type).size();
+
+  for (int i = 0; i < nsamples; i++) {
+    const auto &arr = GetSample(i);
+    const auto &meta = arr.meta;
+    const auto &roi = rois_[i];
+    int ndim = meta.shape.sample_dim();
+    auto *out = static_cast<uint8_t *>(output.raw_mutable_tensor(i));
+
+    // the part of the ROI within the array
+    SmallVector<int64_t, 6> lo, hi;
+    lo.resize(ndim);
+    hi.resize(ndim);
+    bool inside = true, empty = false;
+    for (int d = 0; d < ndim; d++) {
+      lo[d] = std::max<int64_t>(roi.anchor[d], 0);
+      hi[d] = std::min<int64_t>(roi.anchor[d] + roi.shape[d], meta.shape[d]);
+      inside &= lo[d] == roi.anchor[d] && hi[d] == roi.anchor[d] + roi.shape[d];
+      empty |= lo[d] >= hi[d];
+    }
+    if (!inside)
+      Fill(out, volume(roi.shape), type, fill_value_);
+    if (empty)
+      continue;
+
+    SmallVector<int64_t, 6> out_strides, chunk_strides, first_chunk, last_chunk;
+    out_strides.resize(ndim);
+    chunk_strides.resize(ndim);
+    first_chunk.resize(ndim);
+    last_chunk.resize(ndim);
+    int64_t out_stride = 1, chunk_stride = 1;
+    for (int d = ndim - 1; d >= 0; d--) {
+      out_strides[d] = out_stride;
+      chunk_strides[d] = chunk_stride;
+      out_stride *= roi.shape[d];
+      chunk_stride *= meta.chunks[d];
+      first_chunk[d] = lo[d] / meta.chunks[d];
+      last_chunk[d] = (hi[d] - 1) / meta.chunks[d];
+    }
+    int64_t chunk_size = volume(meta.chunks) * elem_size;
+
+    // Visits all the chunks intersecting the ROI; each one is read, decompressed and copied
+    // by a separate task.
+    SmallVector<int64_t, 6> chunk_idx = first_chunk;
+    for (;;) {
+      thread_pool.AddWork([&meta, &roi, &arr, out, ndim, elem_size, lo, hi, out_strides,
+                           chunk_strides, chunk_idx, chunk_size](int) {
+        auto path = filesystem::join_path(arr.path,
+                                          zarr::ChunkKey(make_cspan(chunk_idx),
+                                                         meta.dimension_separator));
+        std::vector<uint8_t> chunk(chunk_size);
+        // the chunks which contain only the fill value don't need to be stored
+        if (ChunkExists(path)) {
+          auto file = FileStream::Open(path, false, false);
+          std::vector<uint8_t> data(file->Size());
+          file->ReadBytes(data.data(), data.size());
+          file->Close();
+          zarr::DecompressChunk(meta.compressor, make_cspan(data), make_span(chunk), path);
+        } else {
+          Fill(chunk.data(), volume(meta.chunks), meta.type, meta.fill_value);
+        }
+
+        int64_t in_offset = 0, out_offset = 0;
+        SmallVector<int64_t, 6> extent;
+        extent.resize(ndim);
+        for (int d = 0; d < ndim; d++) {
+          int64_t chunk_start = chunk_idx[d] * meta.chunks[d];
+          int64_t start = std::max(lo[d], chunk_start);
+          int64_t end = std::min(hi[d], chunk_start + meta.chunks[d]);
+          extent[d] = end - start;
+          in_offset += (start - chunk_start) * chunk_strides[d];
+          out_offset += (start - roi.anchor[d]) * out_strides[d];
+        }
+        CopyBox(out + out_offset * elem_size, out_strides.data(),
+                chunk.data() + in_offset * elem_size, chunk_strides.data(), extent.data(), ndim,
+                elem_size);
+      }, chunk_size);
+
+      int d = ndim - 1;
+      for (; d >= 0; d--) {
+        if (++chunk_idx[d] <= last_chunk[d])
+          break;
+        chunk_idx[d] = first_chunk[d];
+      }
+      if (d < 0)
+        break;
+    }
+  }
+  thread_pool.RunAll();
+}
+
+DALI_REGISTER_OPERATOR(readers__Zarr, ZarrReader, CPU);
+
+DALI_SCHEMA(readers__Zarr)
+  .DocStr(R"(Reads the regions of interest of Zarr (v2) arrays.
+
+The arrays are stored in the chunks, each in a separate (optionally compressed) file. Only the
+chunks which intersect the region of interest are read and decompressed, in parallel, so reading
+a small part of a large array is as cheap as reading just that part.
+
+The supported compressors are ``zlib`` and ``gzip``; the chunks can also be stored uncompressed.
+The chunks which are missing are treated as filled with the ``fill_value`` of the array.
+
+This operator can be used in the following modes:
+
+1. Read all arrays from a directory indicated by ``file_root``, whose ``.zarray`` files match
+   given ``file_filter``.
+2. Read the array paths from a text file indicated in ``file_list`` argument.
+3. Read the arrays listed in ``files`` argument.
+
+The arrays are given by the paths of their directories or of their ``.zarray`` files.
+)")
+  .NumInput(0)
+  .NumOutput(1)  // (Arrays)
+  .AddOptionalArg<string>("file_root",
+      R"(Path to a directory that contains the arrays.
+
+If not using ``file_list`` or ``files``, this directory is traversed to discover the arrays.
+``file_root`` is required in this mode of operation.)",
+      nullptr)
+  .AddOptionalArg("file_filter",
+      R"(If a value is specified, the string is interpreted as glob string to filter the
+list of files in the sub-directories of the ``file_root``.
+
+This argument is ignored when the array paths are taken from ``file_list`` or ``files``.)",
+      "*.zarray")
+  .AddOptionalArg<string>("file_list",
+      R"(Path to a text file that contains the array paths (one per line)
+where the paths are relative to the location of that file or to ``file_root``, if specified.
+
+This argument is mutually exclusive with ``files``.)", nullptr)
+  .AddOptionalArg("shuffle_after_epoch",
+      R"(If set to True, the reader shuffles the entire dataset after each epoch.
+
+``stick_to_shard`` and ``random_shuffle`` cannot be used when this argument is set to True.)",
+      false)
+  .AddOptionalArg<vector<string>>("files", R"(A list of array paths to read the data from.
+
+If ``file_root`` is provided, the paths are treated as being relative to it.
+
+This argument is mutually exclusive with ``file_list``.)", nullptr)
+  .AddParent("ReaderROIBase")
+  .AddParent("LoaderBase");
+
+}  // namespace dali
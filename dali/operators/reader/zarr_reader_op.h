@@ -0,0 +1,59 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_READER_ZARR_READER_OP_H_
+#define DALI_OPERATORS_READER_ZARR_READER_OP_H_
+
+#include <vector>
+
+#include "dali/operators/generic/slice/slice_attr.h"
+#include "dali/operators/generic/slice/out_of_bounds_policy.h"
+#include "dali/operators/reader/loader/zarr_loader.h"
+#include "dali/operators/reader/reader_op.h"
+#include "dali/util/crop_window.h"
+
+namespace dali {
+
+/**
+ * @brief Reads the regions of interest of Zarr arrays
+ *
+ * The loader provides only the metadata of the arrays. The operator reads just the chunks
+ * which intersect the region of interest, decompressing them in the thread pool, one chunk
+ * per task, and copies their parts within the region to the output.
+ */
+class ZarrReader : public DataReader<CPUBackend, ZarrArrayWrapper> {
+ public:
+  explicit ZarrReader(const OpSpec& spec);
+
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc>& output_desc, const HostWorkspace& ws) override;
+  void RunImpl(HostWorkspace &ws) override;
+  using Operator<CPUBackend>::RunImpl;
+
+ private:
+  USE_READER_OPERATOR_MEMBERS(CPUBackend, ZarrArrayWrapper);
+
+  NamedSliceAttr slice_attr_;
+  std::vector<CropWindow> rois_;
+  OutOfBoundsPolicy out_of_bounds_policy_ = OutOfBoundsPolicy::Error;
+  float fill_value_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_READER_ZARR_READER_OP_H_
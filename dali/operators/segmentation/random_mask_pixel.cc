@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,15 +15,11 @@
 #include <random>
 #include <utility>
 #include "dali/core/static_switch.h"
-#include "dali/pipeline/operator/operator.h"
-#include "dali/pipeline/util/batch_rng.h"
+#include "dali/operators/segmentation/random_mask_pixel.h"
 #include "dali/operators/segmentation/utils/searchable_rle_mask.h"
 #include "dali/kernels/common/utils.h"
 #include "dali/core/boundary.h"
 
-#define MASK_SUPPORTED_TYPES (uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, \
-                              uint64_t, int64_t, float, bool)
-
 namespace dali {
 
 DALI_SCHEMA(segmentation__RandomMaskPixel)
@@ -34,6 +30,7 @@ Based on run-time argument ``foreground``, it returns either only foreground pix
 Pixels are classificed as foreground either when their value exceeds a given ``threshold`` or when
 it's equal to a specific ``value``.
 )")
+    .Nondeterministic()
     .AddOptionalArg<int>("value",
       R"code(All pixels equal to this value are interpreted as foreground.
 
@@ -50,65 +47,72 @@ This argument is mutually exclusive with ``value`` argument.
 
 If 0, the pixel position is sampled uniformly from all available pixels.)code",
       0, true)
-    .NumInput(1)
-    .NumOutput(1);
-
-class RandomMaskPixelCPU : public Operator<CPUBackend> {
- public:
-  explicit RandomMaskPixelCPU(const OpSpec &spec);
-  bool CanInferOutputs() const override { return true; }
-  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<CPUBackend> &ws) override;
-  void RunImpl(workspace_t<CPUBackend> &ws) override;
-
- private:
-  template <typename T>
-  void RunImplTyped(workspace_t<CPUBackend> &ws);
-
-  BatchRNG<std::mt19937> rngs_;
-  std::vector<SearchableRLEMask> rle_;
+    .AddOptionalArg("output_count",
+      R"code(If True, the number of foreground pixels in each sample is returned as the second
+output, e.g. to balance the classes.
 
-  std::vector<int> foreground_;
-  std::vector<int> value_;
-  std::vector<float> threshold_;
-
-  bool has_value_ = false;
-
-  USE_OPERATOR_MEMBERS();
-};
+The pixels are counted regardless of ``foreground``.)code",
+      false)
+    .NumInput(1)
+    .OutputFn([](const OpSpec &spec) {
+      return 1 + spec.GetArgument<bool>("output_count");
+    });
 
-RandomMaskPixelCPU::RandomMaskPixelCPU(const OpSpec &spec)
-    : Operator<CPUBackend>(spec),
+template <typename Backend>
+RandomMaskPixel<Backend>::RandomMaskPixel(const OpSpec &spec)
+    : Operator<Backend>(spec),
       rngs_(spec.GetArgument<int64_t>("seed"), spec.GetArgument<int64_t>("max_batch_size")),
-      has_value_(spec.ArgumentDefined("value")) {
+      has_value_(spec.ArgumentDefined("value")),
+      output_count_(spec.GetArgument<bool>("output_count")) {
   if (has_value_) {
     DALI_ENFORCE(!spec.ArgumentDefined("threshold"),
                  "Arguments ``value`` and ``threshold`` can not be provided together");
   }
 }
 
-bool RandomMaskPixelCPU::SetupImpl(std::vector<OutputDesc> &output_desc,
-                                    const workspace_t<CPUBackend> &ws) {
-  const auto &in_masks = ws.template Input<CPUBackend>(0);
+template <typename Backend>
+bool RandomMaskPixel<Backend>::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                         const workspace_t<Backend> &ws) {
+  const auto &in_masks = ws.template Input<Backend>(0);
   int nsamples = in_masks.num_samples();
   auto in_masks_shape = in_masks.shape();
   int ndim = in_masks_shape.sample_dim();
-  output_desc.resize(1);
+  output_desc.resize(output_count_ ? 2 : 1);
   output_desc[0].shape = uniform_list_shape(nsamples, {ndim});
   output_desc[0].type = DALI_INT64;
+  if (output_count_) {
+    output_desc[1].shape = uniform_list_shape(nsamples, TensorShape<0>());
+    output_desc[1].type = DALI_INT64;
+  }
 
   foreground_.resize(nsamples);
   value_.clear();
   threshold_.clear();
 
-  GetPerSampleArgument(foreground_, "foreground", ws, nsamples);
+  this->GetPerSampleArgument(foreground_, "foreground", ws, nsamples);
   if (spec_.ArgumentDefined("value")) {
-    GetPerSampleArgument(value_, "value", ws, nsamples);
+    this->GetPerSampleArgument(value_, "value", ws, nsamples);
   } else {
-    GetPerSampleArgument(threshold_, "threshold", ws, nsamples);
+    this->GetPerSampleArgument(threshold_, "threshold", ws, nsamples);
   }
   return true;
 }
 
+template class RandomMaskPixel<CPUBackend>;
+template class RandomMaskPixel<GPUBackend>;
+
+class RandomMaskPixelCPU : public RandomMaskPixel<CPUBackend> {
+ public:
+  explicit RandomMaskPixelCPU(const OpSpec &spec) : RandomMaskPixel<CPUBackend>(spec) {}
+  void RunImpl(workspace_t<CPUBackend> &ws) override;
+
+ private:
+  template <typename T>
+  void RunImplTyped(workspace_t<CPUBackend> &ws);
+
+  std::vector<SearchableRLEMask> rle_;
+};
+
 template <typename T>
 void RandomMaskPixelCPU::RunImplTyped(workspace_t<CPUBackend> &ws) {
   const auto &in_masks = ws.template Input<CPUBackend>(0);
@@ -118,6 +122,9 @@ void RandomMaskPixelCPU::RunImplTyped(workspace_t<CPUBackend> &ws) {
   int ndim = in_masks_shape.sample_dim();
   auto masks_view = view<const T>(in_masks);
   auto pixel_pos_view = view<int64_t>(out_pixel_pos);
+  OutListCPU<int64_t, 0> count_view;
+  if (output_count_)
+    count_view = view<int64_t, 0>(ws.template Output<CPUBackend>(1));
   auto& thread_pool = ws.GetThreadPool();
 
   rle_.resize(thread_pool.NumThreads());
@@ -129,7 +136,7 @@ void RandomMaskPixelCPU::RunImplTyped(workspace_t<CPUBackend> &ws) {
         auto mask = masks_view[sample_idx];
         auto pixel_pos = pixel_pos_view[sample_idx];
         const auto &mask_sh = mask.shape;
-        if (foreground_[sample_idx]) {
+        if (NeedsForeground(sample_idx)) {
           int64_t flat_idx = -1;
           auto &rle_mask = rle_[thread_id];
           rle_mask.Clear();
@@ -146,7 +153,9 @@ void RandomMaskPixelCPU::RunImplTyped(workspace_t<CPUBackend> &ws) {
             rle_mask.Init(
                 mask, [threshold](const T &x) { return x > threshold; });
           }
-          if (rle_mask.count() > 0) {
+          if (output_count_)
+            count_view.data[sample_idx][0] = rle_mask.count();
+          if (foreground_[sample_idx] && rle_mask.count() > 0) {
             auto dist = std::uniform_int_distribution<int64_t>(0, rle_mask.count() - 1);
             flat_idx = rle_mask.find(dist(rng));
           }
@@ -0,0 +1,59 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_SEGMENTATION_RANDOM_MASK_PIXEL_H_
+#define DALI_OPERATORS_SEGMENTATION_RANDOM_MASK_PIXEL_H_
+
+#include <random>
+#include <vector>
+#include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/util/batch_rng.h"
+
+#define MASK_SUPPORTED_TYPES (uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, \
+                              uint64_t, int64_t, float, bool)
+
+namespace dali {
+
+template <typename Backend>
+class RandomMaskPixel : public Operator<Backend> {
+ public:
+  explicit RandomMaskPixel(const OpSpec &spec);
+  bool CanInferOutputs() const override { return true; }
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override;
+
+ protected:
+  /**
+   * @brief Whether the foreground pixels of the sample need to be found
+   *
+   * They are needed to sample a foreground pixel or to output their number.
+   */
+  bool NeedsForeground(int sample_idx) const {
+    return foreground_[sample_idx] || output_count_;
+  }
+
+  BatchRNG<std::mt19937> rngs_;
+
+  std::vector<int> foreground_;
+  std::vector<int> value_;
+  std::vector<float> threshold_;
+
+  bool has_value_ = false;
+  bool output_count_ = false;
+
+  USE_OPERATOR_MEMBERS();
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_SEGMENTATION_RANDOM_MASK_PIXEL_H_
@@ -0,0 +1,316 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/cuda_utils.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+#include "dali/kernels/common/utils.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/reduce/reduce_common.cuh"
+#include "dali/operators/segmentation/random_mask_pixel.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+namespace random_mask_pixel {
+
+template <typename T>
+struct IsForeground {
+  DALI_HOST_DEV bool operator()(T x) const {
+    return use_value ? x == value : x > threshold;
+  }
+
+  T value;
+  float threshold;
+  bool use_value;
+};
+
+template <typename T>
+struct CountDesc {
+  const T *mask;
+  /// The number of pixels to count; 0, if the foreground of the sample is not needed
+  int64_t size;
+  /// The number of pixels counted by one block
+  int64_t chunk;
+  IsForeground<T> is_foreground;
+  /// The counts of the chunks
+  int64_t *counts;
+};
+
+template <typename T>
+struct SelectDesc {
+  const T *mask;
+  /// The chunk which contains the selected pixel
+  int64_t start, end;
+  /// The index of the selected pixel among the foreground pixels of the chunk
+  int64_t rank;
+  IsForeground<T> is_foreground;
+  const int64_t *strides;
+  int ndim;
+  int64_t *out;
+};
+
+static constexpr int kBlockSize = 256;
+static constexpr int kMinPixelsPerBlock = 4096;
+static constexpr int kMaxBlocksPerSample = 1024;
+
+/**
+ * @brief Counts the foreground pixels in the chunks of the samples
+ *
+ * The block (x, y) counts the pixels in the chunk x of the sample y. The block must be (32, pow2).
+ */
+template <typename T>
+__global__ void CountForegroundKernel(const CountDesc<T> *descs) {
+  auto desc = descs[blockIdx.y];
+  int64_t start = blockIdx.x * desc.chunk;
+  int64_t end = cuda_min(start + desc.chunk, desc.size);
+  int tid = threadIdx.x + threadIdx.y * blockDim.x;
+  int nthreads = blockDim.x * blockDim.y;
+  int64_t count = 0;
+  for (int64_t i = start + tid; i < end; i += nthreads)
+    count += desc.is_foreground(desc.mask[i]);
+  if (kernels::BlockReduce(count, kernels::reductions::sum()))
+    desc.counts[blockIdx.x] = count;
+}
+
+/**
+ * @brief Finds the foreground pixel of the given rank in a chunk and writes its coordinates
+ *
+ * One block processes one sample. The pixels are ranked with a prefix count over tiles
+ * of `blockDim.x` pixels, in the order in which they are found on the CPU.
+ */
+template <typename T>
+__global__ void SelectPixelKernel(const SelectDesc<T> *descs) {
+  auto desc = descs[blockIdx.x];
+  __shared__ int warp_counts[32];
+  __shared__ int64_t base;
+  if (threadIdx.x == 0)
+    base = 0;
+  __syncthreads();
+
+  int lane = threadIdx.x & 31, warp = threadIdx.x >> 5;
+  int nwarps = blockDim.x >> 5;
+  for (int64_t tile = desc.start; tile < desc.end; tile += blockDim.x) {
+    int64_t i = tile + threadIdx.x;
+    bool fg = i < desc.end && desc.is_foreground(desc.mask[i]);
+    unsigned mask = __ballot_sync(0xffffffffu, fg);
+    if (lane == 0)
+      warp_counts[warp] = __popc(mask);
+    __syncthreads();
+
+    if (fg) {
+      int64_t rank = base + __popc(mask & ((1u << lane) - 1));
+      for (int w = 0; w < warp; w++)
+        rank += warp_counts[w];
+      if (rank == desc.rank) {
+        int64_t flat_idx = i;
+        for (int d = 0; d < desc.ndim - 1; d++) {
+          desc.out[d] = flat_idx / desc.strides[d];
+          flat_idx = flat_idx % desc.strides[d];
+        }
+        desc.out[desc.ndim - 1] = flat_idx;
+      }
+    }
+    __syncthreads();
+    if (threadIdx.x == 0) {
+      for (int w = 0; w < nwarps; w++)
+        base += warp_counts[w];
+    }
+    __syncthreads();
+    if (base > desc.rank)
+      break;
+  }
+}
+
+}  // namespace random_mask_pixel
+
+/**
+ * @brief The GPU variant of RandomMaskPixel
+ *
+ * The foreground pixels are counted in chunks of the samples on the GPU. Only the counts are
+ * copied to the host, where the pixel is drawn in the same way (and with the same random draws)
+ * as in the CPU operator. Then, the pixel is found in its chunk with a prefix count.
+ */
+class RandomMaskPixelGPU : public RandomMaskPixel<GPUBackend> {
+ public:
+  explicit RandomMaskPixelGPU(const OpSpec &spec) : RandomMaskPixel<GPUBackend>(spec) {
+    host_pixel_pos_.set_pinned(true);
+    host_count_.set_pinned(true);
+    copy_event_ = CUDAEvent::Create(spec.GetArgument<int>("device_id"));
+  }
+
+  void RunImpl(DeviceWorkspace &ws) override;
+
+ private:
+  template <typename T>
+  void RunImplTyped(DeviceWorkspace &ws);
+
+  /**
+   * @return false, if none of the pixels of the sample can be foreground
+   */
+  template <typename T>
+  bool GetPredicate(random_mask_pixel::IsForeground<T> &is_foreground, int sample_idx) const {
+    if (has_value_) {
+      T value = static_cast<T>(value_[sample_idx]);
+      // the value is not representable by T, so we fall back to pick a random pixel
+      if (static_cast<int>(value) != value_[sample_idx])
+        return false;
+      is_foreground = {value, 0.0f, true};
+    } else {
+      is_foreground = {T(), threshold_[sample_idx], false};
+    }
+    return true;
+  }
+
+  TensorList<CPUBackend> host_pixel_pos_, host_count_;
+  /// Recorded after the outputs are copied from the host buffers, before they are overwritten
+  CUDAEvent copy_event_;
+  bool copy_pending_ = false;
+};
+
+template <typename T>
+void RandomMaskPixelGPU::RunImplTyped(DeviceWorkspace &ws) {
+  using namespace random_mask_pixel;  // NOLINT
+  const auto &in_masks = ws.Input<GPUBackend>(0);
+  int nsamples = in_masks.num_samples();
+  auto in_masks_shape = in_masks.shape();
+  int ndim = in_masks_shape.sample_dim();
+  cudaStream_t stream = ws.stream();
+  kernels::DynamicScratchpad scratch({}, AccessOrder(stream));
+
+  // the results are copied asynchronously - wait until the previous copy is done
+  if (copy_pending_) {
+    CUDA_CALL(cudaEventSynchronize(copy_event_));
+    copy_pending_ = false;
+  }
+  auto &out_pixel_pos = ws.Output<GPUBackend>(0);
+  host_pixel_pos_.Resize(out_pixel_pos.shape(), DALI_INT64);
+  auto pixel_pos_view = view<int64_t, 1>(host_pixel_pos_);
+  OutListCPU<int64_t, 0> count_view;
+  if (output_count_) {
+    host_count_.Resize(ws.Output<GPUBackend>(1).shape(), DALI_INT64);
+    count_view = view<int64_t, 0>(host_count_);
+  }
+
+  std::vector<CountDesc<T>> count_descs(nsamples);
+  int64_t max_size = 0;
+  for (int i = 0; i < nsamples; i++) {
+    auto &desc = count_descs[i];
+    desc = {in_masks.tensor<T>(i), 0, 0, {}, nullptr};
+    if (NeedsForeground(i) && GetPredicate(desc.is_foreground, i)) {
+      desc.size = in_masks_shape.tensor_size(i);
+      max_size = std::max(max_size, desc.size);
+    }
+  }
+
+  int nblocks = 0;
+  const int64_t *counts = nullptr;
+  if (max_size > 0) {
+    nblocks = std::min<int64_t>(div_ceil(max_size, kMinPixelsPerBlock), kMaxBlocksPerSample);
+    int64_t *counts_gpu = scratch.AllocateGPU<int64_t>(nsamples * nblocks);
+    for (int i = 0; i < nsamples; i++) {
+      count_descs[i].chunk = div_ceil(count_descs[i].size, nblocks);
+      count_descs[i].counts = counts_gpu + i * nblocks;
+    }
+    auto *count_descs_gpu = scratch.ToGPU(stream, count_descs);
+    dim3 grid(nblocks, nsamples);
+    dim3 block(32, kBlockSize / 32);
+    CountForegroundKernel<<<grid, block, 0, stream>>>(count_descs_gpu);
+    CUDA_CALL(cudaGetLastError());
+
+    int64_t *counts_cpu = scratch.AllocatePinned<int64_t>(nsamples * nblocks);
+    CUDA_CALL(cudaMemcpyAsync(counts_cpu, counts_gpu, nsamples * nblocks * sizeof(int64_t),
+                              cudaMemcpyDeviceToHost, stream));
+    CUDA_CALL(cudaStreamSynchronize(stream));
+    counts = counts_cpu;
+  }
+
+  std::vector<int> selected;
+  std::vector<SelectDesc<T>> select_descs;
+  std::vector<int64_t> strides;
+  for (int i = 0; i < nsamples; i++) {
+    auto &rng = rngs_[i];
+    const auto &count_desc = count_descs[i];
+    auto mask_sh = in_masks_shape[i];
+    int64_t count = 0;
+    const int64_t *chunk_counts = counts ? counts + i * nblocks : nullptr;
+    if (count_desc.size > 0) {
+      for (int b = 0; b < nblocks; b++)
+        count += chunk_counts[b];
+    }
+    if (output_count_)
+      count_view.data[i][0] = count;
+
+    if (foreground_[i] && count > 0) {
+      auto dist = std::uniform_int_distribution<int64_t>(0, count - 1);
+      int64_t rank = dist(rng);
+      int b = 0;
+      while (rank >= chunk_counts[b])
+        rank -= chunk_counts[b++];
+      SelectDesc<T> desc;
+      desc.mask = count_desc.mask;
+      desc.start = b * count_desc.chunk;
+      desc.end = std::min(desc.start + count_desc.chunk, count_desc.size);
+      desc.rank = rank;
+      desc.is_foreground = count_desc.is_foreground;
+      desc.ndim = ndim;
+      select_descs.push_back(desc);
+      selected.push_back(i);
+      auto mask_strides = kernels::GetStrides(mask_sh);
+      strides.insert(strides.end(), mask_strides.begin(), mask_strides.end());
+      continue;
+    }
+    // Either foreground == 0 or no foreground pixels found. Get a random center
+    for (int d = 0; d < ndim; d++) {
+      pixel_pos_view.data[i][d] =
+          std::uniform_int_distribution<int64_t>(0, mask_sh[d] - 1)(rng);
+    }
+  }
+
+  out_pixel_pos.Copy(host_pixel_pos_, stream);
+  if (output_count_)
+    ws.Output<GPUBackend>(1).Copy(host_count_, stream);
+  CUDA_CALL(cudaEventRecord(copy_event_, stream));
+  copy_pending_ = true;
+
+  // the positions drawn on the host for the selected samples are overwritten
+  if (!select_descs.empty()) {
+    auto *strides_gpu = scratch.ToGPU(stream, strides);
+    for (size_t k = 0; k < select_descs.size(); k++) {
+      select_descs[k].strides = strides_gpu + k * ndim;
+      select_descs[k].out = out_pixel_pos.mutable_tensor<int64_t>(selected[k]);
+    }
+    auto *select_descs_gpu = scratch.ToGPU(stream, select_descs);
+    SelectPixelKernel<<<select_descs.size(), kBlockSize, 0, stream>>>(select_descs_gpu);
+    CUDA_CALL(cudaGetLastError());
+  }
+}
+
+void RandomMaskPixelGPU::RunImpl(DeviceWorkspace &ws) {
+  const auto &in_masks = ws.Input<GPUBackend>(0);
+  TYPE_SWITCH(in_masks.type(), type2id, T, MASK_SUPPORTED_TYPES, (
+    RunImplTyped<T>(ws);
+  ), (  // NOLINT
+    DALI_FAIL(make_string("Unexpected data type: ", in_masks.type()));
+  ));  // NOLINT
+}
+
+DALI_REGISTER_OPERATOR(segmentation__RandomMaskPixel, RandomMaskPixelGPU, GPU);
+
+}  // namespace dali
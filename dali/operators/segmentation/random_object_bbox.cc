@@ -45,6 +45,7 @@ The blobs may be further filtered according to ``k_largest`` and ``threshold``.
 The output is a bounding box of the selected blob in one of the formats described in ``format``.
 
 With probability 1-foreground_prob, the entire area of the input is returned.)")
+  .Nondeterministic()
   .NumInput(1)
   .OutputFn([](const OpSpec& spec) {
     int separate_corners = spec.GetArgument<string>("format") != "box";
@@ -109,11 +110,15 @@ of finding object blobs in previously seen inputs.
 Searching for blobs of connected pixels and finding boxes can take a long time. When the dataset
 has few items, but item size is big, you can use caching to save the boxes and reuse them when
 the same input is seen again. The inputs are compared based on 256-bit hash, which is much faster
-to compute than to recalculate the object boxes.)", false);
+to compute than to recalculate the object boxes.
 
-bool RandomObjectBBox::SetupImpl(vector<OutputDesc> &out_descs, const HostWorkspace &ws) {
-  out_descs.resize(spec_.NumOutput());
-  auto &input = ws.Input<CPUBackend>(0);
+Supported only by the CPU backend - the GPU backend finds the objects in each iteration.)", false);
+
+template <typename Backend>
+bool RandomObjectBBoxBase<Backend>::SetupImpl(vector<OutputDesc> &out_descs,
+                                              const workspace_t<Backend> &ws) {
+  out_descs.resize(this->spec_.NumOutput());
+  auto &input = ws.template Input<Backend>(0);
   int ndim = input.sample_dim();
   int N = input.num_samples();
 
@@ -133,15 +138,17 @@ bool RandomObjectBBox::SetupImpl(vector<OutputDesc> &out_descs, const HostWorksp
   return true;
 }
 
-void RandomObjectBBox::AcquireArgs(const HostWorkspace &ws, int N, int ndim) {
-  background_.Acquire(spec_, ws, N);
+template <typename Backend>
+void RandomObjectBBoxBase<Backend>::AcquireArgs(const ArgumentWorkspace &ws, int N, int ndim) {
+  auto &spec = this->spec_;
+  background_.Acquire(spec, ws, N);
   if (classes_.HasExplicitValue())
-    classes_.Acquire(spec_, ws, N);
-  foreground_prob_.Acquire(spec_, ws, N);
+    classes_.Acquire(spec, ws, N);
+  foreground_prob_.Acquire(spec, ws, N);
   if (weights_.HasExplicitValue())
-    weights_.Acquire(spec_, ws, N);
+    weights_.Acquire(spec, ws, N);
   if (threshold_.HasExplicitValue())
-    threshold_.Acquire(spec_, ws, N, TensorShape<1>{ndim});
+    threshold_.Acquire(spec, ws, N, TensorShape<1>{ndim});
 
   if (weights_.HasExplicitValue() && classes_.HasExplicitValue()) {
     DALI_ENFORCE(weights_.get().shape == classes_.get().shape, make_string(
@@ -236,48 +243,10 @@ void FilterByLabel(ThreadPool *tp,
 }
 
 
-template <typename Lo, typename Hi>
-void StoreBox(const OutListCPU<int, 1> &out1,
-              const OutListCPU<int, 1> &out2,
-              RandomObjectBBox::OutputFormat format,
-              int sample_idx, Lo &&start, Hi &&end) {
-  assert(dali::size(start) == dali::size(end));
-  int ndim = dali::size(start);
-  switch (format) {
-    case RandomObjectBBox::Out_Box:
-      for (int i = 0; i < ndim; i++) {
-        out1.data[sample_idx][i] = start[i];
-        out1.data[sample_idx][i + ndim] = end[i];
-      }
-      break;
-    case RandomObjectBBox::Out_AnchorShape:
-      for (int i = 0; i < ndim; i++) {
-        out1.data[sample_idx][i] = start[i];
-        out2.data[sample_idx][i] = end[i] - start[i];
-      }
-      break;
-    case RandomObjectBBox::Out_StartEnd:
-      for (int i = 0; i < ndim; i++) {
-        out1.data[sample_idx][i] = start[i];
-        out2.data[sample_idx][i] = end[i];
-      }
-      break;
-    default:
-      assert(!"Unreachable code");
-  }
-}
-
-template <typename Box>
-void StoreBox(const OutListCPU<int, 1> &out1,
-              const OutListCPU<int, 1> &out2,
-              RandomObjectBBox::OutputFormat format,
-              int sample_idx, Box &&box) {
-  StoreBox(out1, out2, format, sample_idx, box.lo, box.hi);
-}
-
-void RandomObjectBBox::ClassInfo::Init(const int *bg_ptr,
-                                       const InTensorCPU<int, 1> &cls_tv,
-                                       const InTensorCPU<float, 1> &weight_tv) {
+template <typename Backend>
+void RandomObjectBBoxBase<Backend>::ClassInfo::Init(const int *bg_ptr,
+                                                    const InTensorCPU<int, 1> &cls_tv,
+                                                    const InTensorCPU<float, 1> &weight_tv) {
   Reset();
   background = bg_ptr ? *bg_ptr : 0;
 
@@ -340,7 +309,8 @@ void RandomObjectBBox::ClassInfo::Init(const int *bg_ptr,
   }
 }
 
-void RandomObjectBBox::InitClassInfo(int sample_idx) {
+template <typename Backend>
+void RandomObjectBBoxBase<Backend>::InitClassInfo(int sample_idx) {
   const int *bg = background_.HasExplicitValue() ? background_[sample_idx].data : nullptr;
   InTensorCPU<int, 1> class_tv;
   InTensorCPU<float, 1> weight_tv;
@@ -349,8 +319,9 @@ void RandomObjectBBox::InitClassInfo(int sample_idx) {
   class_info_.Init(bg, class_tv, weight_tv);
 }
 
+template <typename Backend>
 template <int ndim>
-int RandomObjectBBox::PickBox(span<Box<ndim, int>> boxes, int sample_idx) {
+int RandomObjectBBoxBase<Backend>::PickBox(span<Box<ndim, int>> boxes, int sample_idx) {
   auto beg = boxes.begin();
   auto end = boxes.end();
   if (threshold_.HasExplicitValue()) {
@@ -403,36 +374,41 @@ void RandomObjectBBox::GetBoxes(SampleContext<BlobLabel> &ctx, int nblobs) {
   );  // NOLINT
 }
 
-template <typename BlobLabel>
-bool RandomObjectBBox::PickBox(SampleContext<BlobLabel> &ctx) {
-  int ndim = ctx.blobs.dim();
-  int nblobs = ctx.box_data.size() / (2 * ndim);
+template <typename Backend>
+int RandomObjectBBoxBase<Backend>::PickBox(vector<int> &box_data, int ndim, int sample_idx) {
+  int nblobs = box_data.size() / (2 * ndim);
   if (!nblobs)
-    return false;
+    return -1;
 
   VALUE_SWITCH(ndim, static_ndim, (1, 2, 3, 4, 5, 6),
     (
-      auto *box_data = reinterpret_cast<Box<static_ndim, int>*>(ctx.box_data.data());
-      auto boxes = make_span(box_data, nblobs);
-      int box_idx = PickBox(boxes, ctx.sample_idx);
-      if (box_idx >= 0) {
-        ctx.SelectBox(box_idx);
-        return true;
-      }
+      auto *boxes_ptr = reinterpret_cast<Box<static_ndim, int>*>(box_data.data());
+      return PickBox(make_span(boxes_ptr, nblobs), sample_idx);
     ), (  // NOLINT
       DALI_FAIL(make_string("Unsupported number of dimensions: ", ndim, "; must be 1..6"));
     )  // NOLINT
   );  // NOLINT
-  return false;
+  return -1;
 }
 
-void RandomObjectBBox::ClassInfo::Reset() {
+template <typename BlobLabel>
+bool RandomObjectBBox::PickBox(SampleContext<BlobLabel> &ctx) {
+  int box_idx = PickBox(ctx.box_data, ctx.blobs.dim(), ctx.sample_idx);
+  if (box_idx < 0)
+    return false;
+  ctx.SelectBox(box_idx);
+  return true;
+}
+
+template <typename Backend>
+void RandomObjectBBoxBase<Backend>::ClassInfo::Reset() {
   classes.clear();
   weights.clear();
   cdf.clear();
 }
 
-void RandomObjectBBox::ClassInfo::FromLabels(const LabelSet &labels) {
+template <typename Backend>
+void RandomObjectBBoxBase<Backend>::ClassInfo::FromLabels(const LabelSet &labels) {
   classes.clear();
   weights.clear();
   for (auto cls : labels) {
@@ -446,7 +422,8 @@ void RandomObjectBBox::ClassInfo::FromLabels(const LabelSet &labels) {
   std::sort(classes.begin(), classes.end());
 }
 
-void RandomObjectBBox::ClassInfo::DisableAbsentClasses(const LabelSet &labels) {
+template <typename Backend>
+void RandomObjectBBoxBase<Backend>::ClassInfo::DisableAbsentClasses(const LabelSet &labels) {
   for (int i = 0; i < static_cast<int>(classes.size()); i++) {
     if (!labels.count(classes[i]))
       weights[i] = 0;  // label not present - reduce its weight to 0
@@ -616,6 +593,9 @@ void RandomObjectBBox::RunImpl(HostWorkspace &ws) {
   tp.RunAll();
 }
 
+template class RandomObjectBBoxBase<CPUBackend>;
+template class RandomObjectBBoxBase<GPUBackend>;
+
 DALI_REGISTER_OPERATOR(segmentation__RandomObjectBBox, RandomObjectBBox, CPU);
 
 }  // namespace dali
@@ -17,6 +17,7 @@
 #define DALI_OPERATORS_SEGMENTATION_RANDOM_OBJECT_BBOX_H_
 
 #include <algorithm>
+#include <cassert>
 #include <string>
 #include <random>
 #include <unordered_set>
@@ -27,13 +28,19 @@
 #include "dali/pipeline/operator/arg_helper.h"
 #include "dali/pipeline/util/batch_rng.h"
 #include "dali/kernels/kernel_params.h"
+#include "dali/core/geom/box.h"
 #include "dali/kernels/common/fast_hash.h"
 
 namespace dali {
 
 using kernels::InTensorCPU;
+using kernels::OutListCPU;
 
-class RandomObjectBBox : public Operator<CPUBackend> {
+/**
+ * @brief The arguments and the box selection logic, shared by the CPU and GPU operators
+ */
+template <typename Backend>
+class RandomObjectBBoxBase : public Operator<Backend> {
  public:
   enum OutputFormat {
     Out_AnchorShape,
@@ -43,8 +50,8 @@ class RandomObjectBBox : public Operator<CPUBackend> {
 
   using hash_t = kernels::fast_hash_t;
 
-  explicit RandomObjectBBox(const OpSpec &spec) : Operator<CPUBackend>(spec),
-        rngs_(spec.GetArgument<int>("seed"), max_batch_size_),
+  explicit RandomObjectBBoxBase(const OpSpec &spec) : Operator<Backend>(spec),
+        rngs_(spec.GetArgument<int>("seed"), this->max_batch_size_),
         background_("background", spec),
         classes_("classes", spec),
         foreground_prob_("foreground_prob", spec),
@@ -70,9 +77,6 @@ class RandomObjectBBox : public Operator<CPUBackend> {
       DALI_ENFORCE(k_largest_ >= 1, make_string(
                    "``k_largest`` must be at least 1; got ", k_largest_));
     }
-
-    tmp_blob_storage_.set_pinned(false);
-    tmp_filtered_storage_.set_pinned(false);
   }
 
   static OutputFormat ParseOutputFormat(const std::string &format)  {
@@ -91,11 +95,10 @@ class RandomObjectBBox : public Operator<CPUBackend> {
     return true;
   }
 
-  bool SetupImpl(vector<OutputDesc> &out_descs, const HostWorkspace &ws) override;
-  void RunImpl(HostWorkspace &ws) override;
+  bool SetupImpl(vector<OutputDesc> &out_descs, const workspace_t<Backend> &ws) override;
 
- private:
-  void AcquireArgs(const HostWorkspace &ws, int N, int ndim);
+ protected:
+  void AcquireArgs(const ArgumentWorkspace &ws, int N, int ndim);
 
   bool HasClassLabelOutput() const {
     return class_output_idx_ >= 0;
@@ -169,6 +172,100 @@ class RandomObjectBBox : public Operator<CPUBackend> {
 
   void InitClassInfo(int sample_idx);
 
+  /**
+   * @brief Picks one of the boxes stored in `box_data`, filtered by `threshold` and `k_largest`
+   *
+   * @param box_data  the boxes, as `ndim` start coordinates followed by `ndim` end coordinates;
+   *                  the boxes may be reordered
+   * @return The index of the selected box in `box_data` or -1, if no box meets the threshold.
+   */
+  int PickBox(vector<int> &box_data, int ndim, int sample_idx);
+
+  template <int ndim>
+  int PickBox(span<Box<ndim, int>> boxes, int sample_idx);
+
+  template <typename Lo, typename Hi>
+  static void StoreBox(const OutListCPU<int, 1> &out1,
+                       const OutListCPU<int, 1> &out2,
+                       OutputFormat format,
+                       int sample_idx, Lo &&start, Hi &&end) {
+    assert(dali::size(start) == dali::size(end));
+    int ndim = dali::size(start);
+    switch (format) {
+      case Out_Box:
+        for (int i = 0; i < ndim; i++) {
+          out1.data[sample_idx][i] = start[i];
+          out1.data[sample_idx][i + ndim] = end[i];
+        }
+        break;
+      case Out_AnchorShape:
+        for (int i = 0; i < ndim; i++) {
+          out1.data[sample_idx][i] = start[i];
+          out2.data[sample_idx][i] = end[i] - start[i];
+        }
+        break;
+      case Out_StartEnd:
+        for (int i = 0; i < ndim; i++) {
+          out1.data[sample_idx][i] = start[i];
+          out2.data[sample_idx][i] = end[i];
+        }
+        break;
+      default:
+        assert(!"Unreachable code");
+    }
+  }
+
+  template <typename BoxType>
+  static void StoreBox(const OutListCPU<int, 1> &out1,
+                       const OutListCPU<int, 1> &out2,
+                       OutputFormat format,
+                       int sample_idx, BoxType &&box) {
+    StoreBox(out1, out2, format, sample_idx, box.lo, box.hi);
+  }
+
+  bool  ignore_class_ = false;
+  int   k_largest_ = -1;          // -1 means no k largest
+  int   class_output_idx_ = -1;   // -1 means no class output
+  BatchRNG<> rngs_;
+  ArgValue<int> background_;
+  ArgValue<int, 1> classes_;
+  ArgValue<float> foreground_prob_;
+  ArgValue<float, 1> weights_;
+  ArgValue<int, 1> threshold_;
+  OutputFormat format_;
+
+  bool use_cache_ = false;
+  struct CacheEntry {
+    LabelSet labels;
+    std::unordered_map<int, vector<int>> class_boxes;
+
+    bool Get(vector<int> &boxes, int label) const {
+      auto it = class_boxes.find(label);
+      if (it == class_boxes.end())
+        return false;
+      boxes = it->second;
+      return true;
+    }
+
+    void Put(int label, const vector<int> &boxes) {
+      class_boxes[label] = boxes;
+    }
+  };
+  std::unordered_map<hash_t, CacheEntry> cache_;
+};
+
+class RandomObjectBBox : public RandomObjectBBoxBase<CPUBackend> {
+ public:
+  explicit RandomObjectBBox(const OpSpec &spec) : RandomObjectBBoxBase<CPUBackend>(spec) {
+    tmp_blob_storage_.set_pinned(false);
+    tmp_filtered_storage_.set_pinned(false);
+  }
+
+  void RunImpl(HostWorkspace &ws) override;
+
+ private:
+  using RandomObjectBBoxBase<CPUBackend>::PickBox;
+
   void GetBgFgAndWeights(ClassVec &classes, WeightVec &weights, int &background, int sample_idx);
 
   void AllocateTempStorage(const TensorList<CPUBackend> &tls);
@@ -251,39 +348,6 @@ class RandomObjectBBox : public Operator<CPUBackend> {
 
   template <typename BlobLabel>
   bool PickBox(SampleContext<BlobLabel> &ctx);
-
-  template <int ndim>
-  int PickBox(span<Box<ndim, int>> boxes, int sample_idx);
-
-  bool  ignore_class_ = false;
-  int   k_largest_ = -1;          // -1 means no k largest
-  int   class_output_idx_ = -1;   // -1 means no class output
-  BatchRNG<> rngs_;
-  ArgValue<int> background_;
-  ArgValue<int, 1> classes_;
-  ArgValue<float> foreground_prob_;
-  ArgValue<float, 1> weights_;
-  ArgValue<int, 1> threshold_;
-  OutputFormat format_;
-
-  bool use_cache_ = false;
-  struct CacheEntry {
-    LabelSet labels;
-    std::unordered_map<int, vector<int>> class_boxes;
-
-    bool Get(vector<int> &boxes, int label) const {
-      auto it = class_boxes.find(label);
-      if (it == class_boxes.end())
-        return false;
-      boxes = it->second;
-      return true;
-    }
-
-    void Put(int label, const vector<int> &boxes) {
-      class_boxes[label] = boxes;
-    }
-  };
-  std::unordered_map<hash_t, CacheEntry> cache_;
 };
 
 }  // namespace dali
@@ -0,0 +1,201 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <array>
+#include <random>
+#include <tuple>
+#include <vector>
+#include "dali/core/cuda_event.h"
+#include "dali/core/static_switch.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/kernels/imgproc/structure/connected_components_gpu.cuh"
+#include "dali/operators/segmentation/random_object_bbox.h"
+#include "dali/pipeline/data/views.h"
+
+namespace dali {
+
+#define INPUT_TYPES (bool, uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t)
+
+/**
+ * @brief The GPU variant of RandomObjectBBox
+ *
+ * The blobs of all classes are labeled in one pass, with a parallel union-find on the GPU,
+ * and their boxes are calculated on the GPU as well. Only the boxes are copied to the host,
+ * where a box is selected in the same way (and with the same random draws) as in the CPU
+ * operator.
+ */
+class RandomObjectBBoxGPU : public RandomObjectBBoxBase<GPUBackend> {
+ public:
+  explicit RandomObjectBBoxGPU(const OpSpec &spec) : RandomObjectBBoxBase<GPUBackend>(spec) {
+    for (auto &out : host_outputs_)
+      out.set_pinned(true);
+    copy_event_ = CUDAEvent::Create(spec.GetArgument<int>("device_id"));
+  }
+
+  void RunImpl(DeviceWorkspace &ws) override;
+
+ private:
+  /**
+   * @brief Finds the blobs in the sample and their boxes
+   */
+  void FindObjects(const ConstSampleView<GPUBackend> &input, int background,
+                   cudaStream_t stream);
+
+  /**
+   * @brief Selects a box from the blobs found by FindObjects
+   *
+   * @return Whether a box was selected. If not, `class_label_` is the background.
+   */
+  bool PickForegroundBox(int sample_idx, int ndim);
+
+  void SelectBox(int index, int ndim) {
+    selected_lo_.resize(ndim);
+    selected_hi_.resize(ndim);
+    for (int d = 0; d < ndim; d++) {
+      selected_lo_[d] = box_data_[2*index*ndim + d];
+      selected_hi_[d] = box_data_[2*index*ndim + d + ndim];
+    }
+  }
+
+  /// The values and the boxes of all the blobs in the current sample, ordered as on the CPU
+  vector<int> object_values_, object_boxes_;
+  /// The candidate boxes of the selected class
+  vector<int> box_data_;
+  SmallVector<int, 6> selected_lo_, selected_hi_;
+  int class_label_ = 0;
+
+  std::array<TensorList<CPUBackend>, 3> host_outputs_;
+  /// Recorded after the outputs are copied from `host_outputs_`, before they are overwritten
+  CUDAEvent copy_event_;
+  bool copy_pending_ = false;
+};
+
+void RandomObjectBBoxGPU::FindObjects(const ConstSampleView<GPUBackend> &input, int background,
+                                      cudaStream_t stream) {
+  kernels::DynamicScratchpad scratch({}, AccessOrder(stream));
+  TYPE_SWITCH(input.type(), type2id, T, INPUT_TYPES, (
+    kernels::connected_components::FindObjectsGPU(
+        object_values_, object_boxes_, static_cast<const T *>(input.raw_data()), input.shape(),
+        static_cast<T>(background), scratch, stream);
+  ), (  // NOLINT
+    DALI_FAIL(make_string("Unsupported input type: ", input.type()));
+  ));  // NOLINT
+}
+
+bool RandomObjectBBoxGPU::PickForegroundBox(int sample_idx, int ndim) {
+  class_label_ = class_info_.background;
+  auto &rng = rngs_[sample_idx];
+  if (ignore_class_) {
+    box_data_ = object_boxes_;
+    int box_idx = PickBox(box_data_, ndim, sample_idx);
+    if (box_idx < 0)
+      return false;
+    SelectBox(box_idx, ndim);
+    return true;
+  }
+
+  LabelSet labels(object_values_.begin(), object_values_.end());
+  if (!classes_.HasExplicitValue() && !weights_.HasExplicitValue()) {
+    class_info_.FromLabels(labels);
+  } else {
+    class_info_.DisableAbsentClasses(labels);
+  }
+
+  int nobj = object_values_.size();
+  while (class_info_.CalculateCDF()) {
+    int class_idx;
+    std::tie(class_idx, class_label_) = class_info_.PickClassLabel(rng);
+    if (class_idx < 0)
+      return false;
+
+    box_data_.clear();
+    for (int i = 0; i < nobj; i++) {
+      if (object_values_[i] == class_label_)
+        box_data_.insert(box_data_.end(), &object_boxes_[2*i*ndim], &object_boxes_[2*(i+1)*ndim]);
+    }
+
+    int box_idx = PickBox(box_data_, ndim, sample_idx);
+    if (box_idx >= 0) {
+      SelectBox(box_idx, ndim);
+      return true;
+    }
+
+    // we couldn't find a satisfactory blob in this class, so let's exclude it and try again
+    class_info_.weights[class_idx] = 0;
+    class_label_ = class_info_.background;
+  }
+  return false;
+}
+
+void RandomObjectBBoxGPU::RunImpl(DeviceWorkspace &ws) {
+  auto &input = ws.Input<GPUBackend>(0);
+  int N = input.num_samples();
+  if (N == 0)
+    return;
+
+  int ndim = input.sample_dim();
+  cudaStream_t stream = ws.stream();
+
+  // the results are copied asynchronously - wait until the previous copy is done
+  if (copy_pending_) {
+    CUDA_CALL(cudaEventSynchronize(copy_event_));
+    copy_pending_ = false;
+  }
+  int num_outputs = ws.NumOutput();
+  for (int o = 0; o < num_outputs; o++)
+    host_outputs_[o].Resize(ws.Output<GPUBackend>(o).shape(), DALI_INT32);
+
+  OutListCPU<int, 1> out1 = view<int, 1>(host_outputs_[0]);
+  OutListCPU<int, 1> out2;
+  if (format_ != Out_Box)
+    out2 = view<int, 1>(host_outputs_[1]);
+  OutListCPU<int, 0> class_label_out;
+  if (HasClassLabelOutput())
+    class_label_out = view<int, 0>(host_outputs_[class_output_idx_]);
+
+  TensorShape<> default_anchor;
+  default_anchor.resize(ndim);
+
+  std::uniform_real_distribution<> foreground(0, 1);
+  for (int i = 0; i < N; i++) {
+    bool fg = foreground(rngs_[i]) < foreground_prob_[i].data[0];
+    bool found = false;
+    if (fg) {
+      InitClassInfo(i);
+      FindObjects(input[i], class_info_.background, stream);
+      found = PickForegroundBox(i, ndim);
+    } else if (HasClassLabelOutput()) {
+      InitClassInfo(i);
+      class_label_ = class_info_.background;
+    }
+
+    if (found)
+      StoreBox(out1, out2, format_, i, selected_lo_, selected_hi_);
+    else
+      StoreBox(out1, out2, format_, i, default_anchor, input.tensor_shape(i));
+
+    if (HasClassLabelOutput())
+      class_label_out.data[i][0] = class_label_;
+  }
+
+  for (int o = 0; o < num_outputs; o++)
+    ws.Output<GPUBackend>(o).Copy(host_outputs_[o], stream);
+  CUDA_CALL(cudaEventRecord(copy_event_, stream));
+  copy_pending_ = true;
+}
+
+DALI_REGISTER_OPERATOR(segmentation__RandomObjectBBox, RandomObjectBBoxGPU, GPU);
+
+}  // namespace dali
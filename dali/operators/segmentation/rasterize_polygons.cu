@@ -0,0 +1,348 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cfloat>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/geom/box.h"
+#include "dali/core/geom/mat.h"
+#include "dali/core/static_switch.h"
+#include "dali/core/util.h"
+#include "dali/kernels/dynamic_scratchpad.h"
+#include "dali/operators/geometry/mt_transform_attr.h"
+#include "dali/pipeline/operator/common.h"
+#include "dali/pipeline/operator/operator.h"
+
+#define RASTERIZE_OUTPUT_TYPES (uint8_t, int16_t, int32_t)
+
+namespace dali {
+
+DALI_SCHEMA(segmentation__RasterizePolygons)
+  .DocStr(R"code(Rasterizes polygon masks into a pixelwise mask.
+
+The inputs are ``polygons`` and ``vertices``, in the format returned by
+:meth:`nvidia.dali.fn.readers.coco` with ``polygon_masks=True`` and by
+:meth:`nvidia.dali.fn.segmentation.select_masks`. An optional third input, ``labels``, holds
+the values of the masks - the pixels covered by the polygons of the mask ``i`` are set to
+``labels[i]``. Without it, they are set to 1. The other pixels are set to 0.
+
+The vertices are mapped to the output with the affine transform given as ``MT`` (or ``M`` and
+``T``), e.g. one returned by :meth:`nvidia.dali.fn.transforms.crop` or by a combination of
+transforms. This way, the masks are rasterized only inside the final crop or resize window, at
+the final resolution, instead of being rasterized at full resolution and then processed.
+
+A pixel is covered by a polygon if its center is inside the polygon, according to
+the even-odd rule. Where the polygons of different masks overlap, the polygon which comes
+later wins. Polygons with fewer than 3 vertices, or with vertex indices or mask indices out of
+range, are ignored.
+
+The output has the shape given by ``size`` and the layout *HWC*, with one channel.
+
+This operator is supported only on the GPU.)code")
+  .NumInput(2, 3)
+  .NumOutput(1)
+  .InputDox(0, "polygons", "2D TensorList of int",
+            R"code(Polygons, described by 3 columns - ``[mask_idx, start_vertex_idx, end_vertex_idx]``.
+
+``[start_vertex_idx, end_vertex_idx)`` is the range of the vertices of the polygon.)code")
+  .InputDox(1, "vertices", "2D TensorList of float",
+            R"code(Vertices, stored as ``[x, y]`` pairs.)code")
+  .InputDox(2, "labels", "1D TensorList of int",
+            R"code(Optional. The values of the masks, indexed with ``mask_idx``.)code")
+  .AddArg("size", R"code(The height and the width of the output.)code", DALI_INT_VEC, true)
+  .AddOptionalTypeArg("dtype", R"code(The type of the output.)code", DALI_INT32)
+  .AddParent("MTTransformAttr");
+
+namespace rasterize_polygons {
+
+template <typename T>
+struct SampleDesc {
+  T *out;
+  int height, width;
+  const ivec3 *polygons;
+  int npolygons;
+  const vec2 *vertices;
+  int nvertices;
+  /// The labels of the masks; nullptr, if the masks are not labeled
+  const int *labels;
+  int nlabels;
+  mat2 M;
+  vec2 T;
+  /// The vertices, mapped to the output
+  vec2 *out_vertices;
+  /// The bounds of the polygons in the output; empty for the ignored polygons
+  Box<2, float> *bounds;
+};
+
+constexpr int kTileW = 32;
+constexpr int kTileH = 8;
+constexpr int kBlockSize = kTileW * kTileH;
+
+/**
+ * @brief Maps the vertices of the polygons to the output and calculates their bounds
+ *
+ * One thread processes one polygon.
+ */
+template <typename T>
+__global__ void TransformPolygonsKernel(const SampleDesc<T> *samples) {
+  const auto &sample = samples[blockIdx.y];
+  for (int p = blockIdx.x * blockDim.x + threadIdx.x; p < sample.npolygons;
+       p += gridDim.x * blockDim.x) {
+    ivec3 polygon = sample.polygons[p];
+    int mask_idx = polygon[0], start = polygon[1], end = polygon[2];
+    Box<2, float> bounds(vec2(FLT_MAX), vec2(-FLT_MAX));
+    bool valid = start >= 0 && end <= sample.nvertices && end - start >= 3 && mask_idx >= 0 &&
+                 (!sample.labels || mask_idx < sample.nlabels);
+    if (valid) {
+      const auto &M = sample.M;
+      for (int v = start; v < end; v++) {
+        vec2 in = sample.vertices[v];
+        // explicit rounding, so that the results don't depend on the contraction to FMA
+        vec2 out;
+        for (int d = 0; d < 2; d++)
+          out[d] = __fadd_rn(__fadd_rn(__fmul_rn(M(d, 0), in.x), __fmul_rn(M(d, 1), in.y)),
+                             sample.T[d]);
+        sample.out_vertices[v] = out;
+        for (int d = 0; d < 2; d++) {
+          bounds.lo[d] = fminf(bounds.lo[d], out[d]);
+          bounds.hi[d] = fmaxf(bounds.hi[d], out[d]);
+        }
+      }
+    }
+    sample.bounds[p] = bounds;
+  }
+}
+
+/**
+ * @brief Checks if the point is inside the polygon, with the even-odd rule
+ */
+__device__ bool Inside(vec2 point, const vec2 *vertices, int nvertices) {
+  bool inside = false;
+  for (int i = 0, j = nvertices - 1; i < nvertices; j = i++) {
+    vec2 a = vertices[i], b = vertices[j];
+    if ((a.y > point.y) != (b.y > point.y)) {
+      float t = __fdiv_rn(__fsub_rn(point.y, a.y), __fsub_rn(b.y, a.y));
+      float x = __fadd_rn(a.x, __fmul_rn(t, __fsub_rn(b.x, a.x)));
+      if (point.x < x)
+        inside = !inside;
+    }
+  }
+  return inside;
+}
+
+/**
+ * @brief Rasterizes the polygons in tiles of kTileW x kTileH pixels
+ *
+ * The block (x, y, z) processes the tile (x, y) of the sample z. The polygons which overlap
+ * the tile are gathered in shared memory, in their original order, and only these are tested.
+ */
+template <typename T>
+__global__ void RasterizeKernel(const SampleDesc<T> *samples) {
+  const auto &sample = samples[blockIdx.z];
+  int x0 = blockIdx.x * kTileW, y0 = blockIdx.y * kTileH;
+  if (x0 >= sample.width || y0 >= sample.height)
+    return;
+
+  __shared__ int candidates[kBlockSize];
+  __shared__ int warp_counts[kBlockSize / 32];
+  int x = x0 + threadIdx.x, y = y0 + threadIdx.y;
+  bool in_bounds = x < sample.width && y < sample.height;
+  vec2 center(x + 0.5f, y + 0.5f);
+  // the extent of the pixel centers of the tile
+  Box<2, float> tile(vec2(x0 + 0.5f, y0 + 0.5f),
+                     vec2(cuda_min(x0 + kTileW, sample.width) - 0.5f,
+                          cuda_min(y0 + kTileH, sample.height) - 0.5f));
+
+  int tid = threadIdx.x + threadIdx.y * kTileW;
+  int lane = tid & 31, warp = tid >> 5;
+  T value = 0;
+  for (int start = 0; start < sample.npolygons; start += kBlockSize) {
+    int p = start + tid;
+    bool overlaps = false;
+    if (p < sample.npolygons) {
+      auto bounds = sample.bounds[p];
+      overlaps = bounds.lo.x <= tile.hi.x && bounds.hi.x >= tile.lo.x &&
+                 bounds.lo.y <= tile.hi.y && bounds.hi.y >= tile.lo.y;
+    }
+    unsigned mask = __ballot_sync(0xffffffffu, overlaps);
+    if (lane == 0)
+      warp_counts[warp] = __popc(mask);
+    __syncthreads();
+
+    int ncandidates = 0;
+    for (int w = 0; w < kBlockSize / 32; w++) {
+      if (w == warp && overlaps)
+        candidates[ncandidates + __popc(mask & ((1u << lane) - 1))] = p;
+      ncandidates += warp_counts[w];
+    }
+    __syncthreads();
+
+    if (in_bounds) {
+      for (int c = 0; c < ncandidates; c++) {
+        ivec3 polygon = sample.polygons[candidates[c]];
+        if (Inside(center, sample.out_vertices + polygon[1], polygon[2] - polygon[1]))
+          value = sample.labels ? static_cast<T>(sample.labels[polygon[0]]) : T(1);
+      }
+    }
+    __syncthreads();
+  }
+  if (in_bounds)
+    sample.out[y * sample.width + x] = value;
+}
+
+}  // namespace rasterize_polygons
+
+class RasterizePolygonsGPU : public Operator<GPUBackend>, private MTTransformAttr {
+ public:
+  explicit RasterizePolygonsGPU(const OpSpec &spec)
+      : Operator<GPUBackend>(spec), MTTransformAttr(spec),
+        dtype_(spec.GetArgument<DALIDataType>("dtype")) {}
+
+  bool CanInferOutputs() const override { return true; }
+
+ protected:
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const DeviceWorkspace &ws) override;
+  void RunImpl(DeviceWorkspace &ws) override;
+
+ private:
+  template <typename T>
+  void RunImplTyped(DeviceWorkspace &ws);
+
+  bool HasLabels(const DeviceWorkspace &ws) const {
+    return ws.NumInput() > 2;
+  }
+
+  TensorListShape<2> size_;
+  DALIDataType dtype_;
+};
+
+bool RasterizePolygonsGPU::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                     const DeviceWorkspace &ws) {
+  const auto &polygons = ws.Input<GPUBackend>(0);
+  const auto &vertices = ws.Input<GPUBackend>(1);
+  int nsamples = polygons.num_samples();
+  DALI_ENFORCE(polygons.type() == DALI_INT32,
+               make_string("Expected int32 polygons, got ", polygons.type(), "."));
+  DALI_ENFORCE(vertices.type() == DALI_FLOAT,
+               make_string("Expected float vertices, got ", vertices.type(), "."));
+  DALI_ENFORCE(vertices.num_samples() == nsamples,
+               "The number of samples in ``polygons`` and ``vertices`` must be the same.");
+  DALI_ENFORCE(polygons.sample_dim() == 2 && vertices.sample_dim() == 2,
+               "``polygons`` and ``vertices`` must be 2D tensors.");
+  for (int i = 0; i < nsamples; i++) {
+    DALI_ENFORCE(polygons.tensor_shape_span(i)[1] == 3,
+                 make_string("``polygons`` must have the shape (N, 3), got ",
+                             polygons.tensor_shape(i), " in the sample ", i, "."));
+    DALI_ENFORCE(vertices.tensor_shape_span(i)[1] == 2,
+                 make_string("Only 2D vertices are supported, got the shape ",
+                             vertices.tensor_shape(i), " in the sample ", i, "."));
+  }
+  if (HasLabels(ws)) {
+    const auto &labels = ws.Input<GPUBackend>(2);
+    DALI_ENFORCE(labels.type() == DALI_INT32,
+                 make_string("Expected int32 labels, got ", labels.type(), "."));
+    DALI_ENFORCE(labels.num_samples() == nsamples && labels.sample_dim() == 1,
+                 "``labels`` must be a batch of 1D tensors with the same number of samples as "
+                 "``polygons``.");
+  }
+
+  GetShapeArgument(size_, spec_, "size", ws, nsamples);
+  SetTransformDims(2, 2);
+  ProcessTransformArgs(spec_, ws, nsamples);
+
+  output_desc.resize(1);
+  output_desc[0].type = dtype_;
+  output_desc[0].shape.resize(nsamples, 3);
+  for (int i = 0; i < nsamples; i++) {
+    auto size = size_[i];
+    DALI_ENFORCE(size[0] >= 0 && size[1] >= 0,
+                 make_string("The output size must not be negative, got ", size, "."));
+    output_desc[0].shape.set_tensor_shape(i, {size[0], size[1], 1});
+  }
+  return true;
+}
+
+template <typename T>
+void RasterizePolygonsGPU::RunImplTyped(DeviceWorkspace &ws) {
+  using namespace rasterize_polygons;  // NOLINT
+  const auto &polygons = ws.Input<GPUBackend>(0);
+  const auto &vertices = ws.Input<GPUBackend>(1);
+  auto &output = ws.Output<GPUBackend>(0);
+  output.SetLayout("HWC");
+  int nsamples = polygons.num_samples();
+  cudaStream_t stream = ws.stream();
+  kernels::DynamicScratchpad scratch({}, AccessOrder(stream));
+
+  auto matrices = GetMatrices<2, 2>();
+  auto translations = GetTranslations<2>();
+  int64_t total_vertices = vertices.shape().num_elements() / 2;
+  int64_t total_polygons = polygons.shape().num_elements() / 3;
+  auto *out_vertices = scratch.AllocateGPU<vec2>(total_vertices);
+  auto *bounds = scratch.AllocateGPU<Box<2, float>>(total_polygons);
+
+  std::vector<SampleDesc<T>> samples(nsamples);
+  int max_polygons = 0, max_height = 0, max_width = 0;
+  int64_t vertex_offset = 0, polygon_offset = 0;
+  for (int i = 0; i < nsamples; i++) {
+    auto &sample = samples[i];
+    sample.out = output.mutable_tensor<T>(i);
+    sample.height = size_[i][0];
+    sample.width = size_[i][1];
+    sample.polygons = reinterpret_cast<const ivec3 *>(polygons.tensor<int>(i));
+    sample.npolygons = polygons.tensor_shape_span(i)[0];
+    sample.vertices = reinterpret_cast<const vec2 *>(vertices.tensor<float>(i));
+    sample.nvertices = vertices.tensor_shape_span(i)[0];
+    sample.labels = nullptr;
+    sample.nlabels = 0;
+    if (HasLabels(ws)) {
+      const auto &labels = ws.Input<GPUBackend>(2);
+      sample.labels = labels.tensor<int>(i);
+      sample.nlabels = labels.tensor_shape_span(i)[0];
+    }
+    sample.M = matrices[i];
+    sample.T = translations[i];
+    sample.out_vertices = out_vertices + vertex_offset;
+    sample.bounds = bounds + polygon_offset;
+    vertex_offset += sample.nvertices;
+    polygon_offset += sample.npolygons;
+    max_polygons = std::max(max_polygons, sample.npolygons);
+    max_height = std::max(max_height, sample.height);
+    max_width = std::max(max_width, sample.width);
+  }
+  if (max_height == 0 || max_width == 0)
+    return;
+
+  auto *samples_gpu = scratch.ToGPU(stream, samples);
+  if (max_polygons > 0) {
+    dim3 grid(std::min(div_ceil(max_polygons, 256), 1024), nsamples);
+    TransformPolygonsKernel<<<grid, 256, 0, stream>>>(samples_gpu);
+    CUDA_CALL(cudaGetLastError());
+  }
+  dim3 grid(div_ceil(max_width, kTileW), div_ceil(max_height, kTileH), nsamples);
+  dim3 block(kTileW, kTileH);
+  RasterizeKernel<<<grid, block, 0, stream>>>(samples_gpu);
+  CUDA_CALL(cudaGetLastError());
+}
+
+void RasterizePolygonsGPU::RunImpl(DeviceWorkspace &ws) {
+  TYPE_SWITCH(dtype_, type2id, T, RASTERIZE_OUTPUT_TYPES, (
+    RunImplTyped<T>(ws);
+  ), (  // NOLINT
+    DALI_FAIL(make_string("Unsupported output type: ", dtype_));
+  ));  // NOLINT
+}
+
+DALI_REGISTER_OPERATOR(segmentation__RasterizePolygons, RasterizePolygonsGPU, GPU);
+
+}  // namespace dali
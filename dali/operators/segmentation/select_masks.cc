@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -85,14 +85,15 @@ The operator accepts vertices with arbitrary number of coordinates.)code")
 in ``mask_ids`` input.)code",
       false);
 
-bool SelectMasksCPU::SetupImpl(std::vector<OutputDesc> &output_desc,
-                              const workspace_t<CPUBackend> &ws) {
-  const auto &in_mask_ids = ws.template Input<CPUBackend>(0);
+template <typename Backend>
+bool SelectMasks<Backend>::SetupImpl(std::vector<OutputDesc> &output_desc,
+                                     const workspace_t<Backend> &ws) {
+  const auto &in_mask_ids = ws.template Input<Backend>(0);
   auto in_mask_ids_shape = in_mask_ids.shape();
   DALI_ENFORCE(in_mask_ids.type() == DALI_INT32, "``mask_ids`` input is expected to be int32");
   DALI_ENFORCE(in_mask_ids_shape.sample_dim() == 1, "``mask_ids`` input is expected to be 1D");
 
-  const auto &in_polygons = ws.template Input<CPUBackend>(1);
+  const auto &in_polygons = ws.template Input<Backend>(1);
   auto in_polygons_shape = in_polygons.shape();
   DALI_ENFORCE(in_polygons.type() == DALI_INT32,
                "``polygons`` input is expected to be int32");
@@ -100,7 +101,7 @@ bool SelectMasksCPU::SetupImpl(std::vector<OutputDesc> &output_desc,
                make_string("``polygons`` input is expected to be 2D. Got ",
                            in_polygons_shape.sample_dim(), "D"));
 
-  const auto &in_vertices = ws.template Input<CPUBackend>(2);
+  const auto &in_vertices = ws.template Input<Backend>(2);
   auto in_vertices_shape = in_vertices.shape();
   DALI_ENFORCE(in_vertices_shape.sample_dim() == 2,
                make_string("``vertices`` input is expected to be 2D. Got ",
@@ -126,8 +127,9 @@ bool SelectMasksCPU::SetupImpl(std::vector<OutputDesc> &output_desc,
                              sh[1], " columns."));
   }
 
-  const auto &in_mask_ids_view = view<const int32_t, 1>(in_mask_ids);
-  const auto &in_polygons_view = view<const int32_t, 2>(in_polygons);
+  TensorListView<StorageCPU, const int32_t, 1> in_mask_ids_view;
+  TensorListView<StorageCPU, const int32_t, 2> in_polygons_view;
+  GetHostInputs(in_mask_ids_view, in_polygons_view, ws);
 
   auto out_polygons_shape = in_polygons_shape;
   auto out_vertices_shape = in_vertices_shape;
@@ -191,6 +193,16 @@ bool SelectMasksCPU::SetupImpl(std::vector<OutputDesc> &output_desc,
   return true;
 }
 
+template class SelectMasks<CPUBackend>;
+template class SelectMasks<GPUBackend>;
+
+void SelectMasksCPU::GetHostInputs(TensorListView<StorageCPU, const int32_t, 1> &mask_ids,
+                                   TensorListView<StorageCPU, const int32_t, 2> &polygons,
+                                   const workspace_t<CPUBackend> &ws) {
+  mask_ids = view<const int32_t, 1>(ws.template Input<CPUBackend>(0));
+  polygons = view<const int32_t, 2>(ws.template Input<CPUBackend>(1));
+}
+
 template <typename T>
 void SelectMasksCPU::RunImplTyped(workspace_t<CPUBackend> &ws) {
   // Inputs were already validated and input 0 was already parsed in SetupImpl
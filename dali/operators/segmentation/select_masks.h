@@ -1,4 +1,4 @@
-// Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,30 +21,36 @@
 #include "dali/core/common.h"
 #include "dali/core/span.h"
 #include "dali/core/tensor_shape.h"
+#include "dali/pipeline/data/views.h"
 #include "dali/pipeline/operator/operator.h"
 
 namespace dali {
 
 
-class SelectMasksCPU : public Operator<CPUBackend> {
+template <typename Backend>
+class SelectMasks : public Operator<Backend> {
  public:
-  explicit SelectMasksCPU(const OpSpec &spec)
-      : Operator<CPUBackend>(spec), reindex_masks_(spec.GetArgument<bool>("reindex_masks")) {}
+  explicit SelectMasks(const OpSpec &spec)
+      : Operator<Backend>(spec), reindex_masks_(spec.GetArgument<bool>("reindex_masks")) {}
 
-  ~SelectMasksCPU() override = default;
-  DISABLE_COPY_MOVE_ASSIGN(SelectMasksCPU);
+  ~SelectMasks() override = default;
+  DISABLE_COPY_MOVE_ASSIGN(SelectMasks);
 
  protected:
   bool CanInferOutputs() const override {
     return true;
   }
 
-  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<CPUBackend> &ws) override;
-  void RunImpl(workspace_t<CPUBackend> &ws) override;
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const workspace_t<Backend> &ws) override;
 
- private:
-  template <typename T>
-  void RunImplTyped(workspace_t<CPUBackend> &ws);
+  /**
+   * @brief Provides the views of the ``mask_ids`` and ``polygons`` inputs on the host
+   *
+   * The data must stay valid until the next call.
+   */
+  virtual void GetHostInputs(TensorListView<StorageCPU, const int32_t, 1> &mask_ids,
+                             TensorListView<StorageCPU, const int32_t, 2> &polygons,
+                             const workspace_t<Backend> &ws) = 0;
 
   struct PolygonDesc {
     int new_mask_id = -1;
@@ -65,6 +71,22 @@ class SelectMasksCPU : public Operator<CPUBackend> {
   bool reindex_masks_;
 };
 
+class SelectMasksCPU : public SelectMasks<CPUBackend> {
+ public:
+  explicit SelectMasksCPU(const OpSpec &spec) : SelectMasks<CPUBackend>(spec) {}
+
+ protected:
+  void GetHostInputs(TensorListView<StorageCPU, const int32_t, 1> &mask_ids,
+                     TensorListView<StorageCPU, const int32_t, 2> &polygons,
+                     const workspace_t<CPUBackend> &ws) override;
+
+  void RunImpl(workspace_t<CPUBackend> &ws) override;
+
+ private:
+  template <typename T>
+  void RunImplTyped(workspace_t<CPUBackend> &ws);
+};
+
 }  // namespace dali
 
 #endif  // DALI_OPERATORS_SEGMENTATION_SELECT_MASKS_H_
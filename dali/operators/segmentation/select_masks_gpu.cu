@@ -0,0 +1,104 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include "dali/core/cuda_error.h"
+#include "dali/kernels/common/scatter_gather.h"
+#include "dali/operators/segmentation/select_masks.h"
+
+namespace dali {
+
+/**
+ * @brief The GPU variant of SelectMasks
+ *
+ * The ``mask_ids`` and ``polygons`` inputs, which are needed to calculate the output shapes,
+ * are copied to the host, where the polygons are selected. The output polygons are calculated
+ * on the host as well, while the vertices are copied on the GPU, with a batched copy.
+ */
+class SelectMasksGPU : public SelectMasks<GPUBackend> {
+ public:
+  explicit SelectMasksGPU(const OpSpec &spec) : SelectMasks<GPUBackend>(spec) {
+    for (auto &in : host_inputs_)
+      in.set_pinned(true);
+    host_polygons_.set_pinned(true);
+  }
+
+ protected:
+  void GetHostInputs(TensorListView<StorageCPU, const int32_t, 1> &mask_ids,
+                     TensorListView<StorageCPU, const int32_t, 2> &polygons,
+                     const workspace_t<GPUBackend> &ws) override;
+
+  void RunImpl(workspace_t<GPUBackend> &ws) override;
+
+ private:
+  /// Copies of the ``mask_ids`` and ``polygons`` inputs
+  std::array<TensorList<CPUBackend>, 2> host_inputs_;
+  /// The output polygons, before they are copied to the GPU
+  TensorList<CPUBackend> host_polygons_;
+  kernels::ScatterGatherGPU vertices_copy_;
+};
+
+void SelectMasksGPU::GetHostInputs(TensorListView<StorageCPU, const int32_t, 1> &mask_ids,
+                                   TensorListView<StorageCPU, const int32_t, 2> &polygons,
+                                   const workspace_t<GPUBackend> &ws) {
+  // The copy follows the copy of the output polygons of the previous iteration in the stream,
+  // so `host_polygons_` can be reused once this copy is done.
+  for (int i = 0; i < 2; i++)
+    host_inputs_[i].Copy(ws.Input<GPUBackend>(i), ws.stream());
+  CUDA_CALL(cudaStreamSynchronize(ws.stream()));
+  mask_ids = view<const int32_t, 1>(host_inputs_[0]);
+  polygons = view<const int32_t, 2>(host_inputs_[1]);
+}
+
+void SelectMasksGPU::RunImpl(workspace_t<GPUBackend> &ws) {
+  // Inputs were already validated and the polygons were already selected in SetupImpl
+  const auto &in_vertices = ws.Input<GPUBackend>(2);
+  auto &out_polygons = ws.Output<GPUBackend>(0);
+  auto &out_vertices = ws.Output<GPUBackend>(1);
+  int nsamples = in_vertices.num_samples();
+  size_t element_size = in_vertices.type_info().size();
+
+  host_polygons_.Resize(out_polygons.shape(), DALI_INT32);
+  auto out_polygons_view = view<int32_t, 2>(host_polygons_);
+  vertices_copy_.Reset();
+  for (int i = 0; i < nsamples; i++) {
+    const auto &selected_masks = samples_[i].selected_masks;
+    const auto &polygons = samples_[i].polygons;
+    auto *out_polygons_data = out_polygons_view.tensor_data(i);
+    int64_t vertex_size = in_vertices.tensor_shape_span(i)[1] * element_size;
+    const auto *in_vertices_data = static_cast<const uint8_t *>(in_vertices.raw_tensor(i));
+    auto *out_vertices_data = static_cast<uint8_t *>(out_vertices.raw_mutable_tensor(i));
+    int64_t out_vertex_i = 0;
+    for (int64_t k = 0; k < selected_masks.size(); k++) {
+      int mask_id = selected_masks[k];
+      auto it = polygons.find(mask_id);
+      assert(it != polygons.end());
+      const auto &poly = it->second;
+      int64_t nvertices = poly.end_vertex - poly.start_vertex;
+      *out_polygons_data++ = poly.new_mask_id;
+      *out_polygons_data++ = out_vertex_i;  // start vertex
+      *out_polygons_data++ = out_vertex_i + nvertices;  // end vertex
+      vertices_copy_.AddCopy(out_vertices_data + out_vertex_i * vertex_size,
+                             in_vertices_data + poly.start_vertex * vertex_size,
+                             nvertices * vertex_size);
+      out_vertex_i += nvertices;
+    }
+  }
+  vertices_copy_.Run(ws.stream());
+  out_polygons.Copy(host_polygons_, ws.stream());
+}
+
+DALI_REGISTER_OPERATOR(segmentation__SelectMasks, SelectMasksGPU, GPU);
+
+}  // namespace dali
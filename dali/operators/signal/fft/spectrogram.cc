@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 #include "dali/operators/signal/fft/spectrogram.h"
+#include "dali/operators/signal/stream_state.h"
 #include "dali/kernels/kernel_manager.h"
 #include "dali/kernels/signal/window/extract_windows_cpu.h"
 #include "dali/kernels/signal/window/window_functions.h"
@@ -31,7 +32,14 @@ DALI_SCHEMA(Spectrogram)
   .DocStr(R"(Produces a spectrogram from a 1D signal (for example, audio).
 
 Input data is expected to be one channel (shape being ``(nsamples,)``, ``(nsamples, 1)``, or
-``(1, nsamples)``) of type float32.)")
+``(1, nsamples)``) of type float32.
+
+When ``stream_id`` is given, the input samples are consecutive chunks of the streams and the
+output contains only the windows that end within the current chunk. The samples which are not
+yet covered by a window are kept and prepended to the next chunk of the stream. In this mode,
+``center_windows`` must be False, ``window_step`` must not exceed ``window_length`` and
+each chunk, together with the samples kept from the previous one, must contain at least
+one window.)")
   .NumInput(1)
   .NumOutput(1)
   .AddOptionalArg<int>("nfft",
@@ -82,7 +90,16 @@ is padded with zeros.
 )",
     true)
   .AddOptionalArg("layout", R"(Output layout: "ft" (frequency-major) or "tf" (time-major).)",
-    TensorLayout("ft"));
+    TensorLayout("ft"))
+  .AddParent("SignalStreamAttr");
+
+void CheckSpectrogramStreamingArgs(bool center_windows, int window_length, int window_step) {
+  DALI_ENFORCE(!center_windows,
+    "`center_windows` must be False when the signal is processed in chunks (`stream_id`).");
+  DALI_ENFORCE(window_step <= window_length, make_string(
+    "`window_step` (", window_step, ") must not exceed `window_length` (", window_length,
+    ") when the signal is processed in chunks (`stream_id`)."));
+}
 
 template <bool time_major>
 struct SpectrogramImplCpu : OpImplBase<CPUBackend> {
@@ -122,6 +139,15 @@ struct SpectrogramImplCpu : OpImplBase<CPUBackend> {
 
   kernels::KernelManager kmgr_fft_;
   kernels::signal::fft::FftArgs fft_args_;
+
+  struct StreamState {
+    std::vector<InputType> tail;  ///< the samples not yet covered by a window
+    void clear() { tail.clear(); }
+  };
+  OpSpec spec_;
+  StreamStates<StreamState> streams_;
+  std::vector<int64_t> signal_lengths_;
+  std::vector<std::vector<InputType>> stream_signals_;
 };
 
 namespace {
@@ -152,7 +178,9 @@ SpectrogramImplCpu<time_major>::SpectrogramImplCpu(const OpSpec &spec)
     : window_length_(spec.GetArgument<int>("window_length"))
     , window_step_(spec.GetArgument<int>("window_step"))
     , power_(spec.GetArgument<int>("power"))
-    , window_fn_(spec.GetRepeatedArgument<float>("window_fn")) {
+    , window_fn_(spec.GetRepeatedArgument<float>("window_fn"))
+    , spec_(spec)
+    , streams_(spec) {
   DALI_ENFORCE(window_length_ > 0, make_string("Invalid window length: ", window_length_));
   DALI_ENFORCE(window_step_ > 0, make_string("Invalid window step: ", window_step_));
   nfft_ = spec.HasArgument("nfft") ? spec.GetArgument<int>("nfft") : window_length_;
@@ -174,6 +202,8 @@ SpectrogramImplCpu<time_major>::SpectrogramImplCpu(const OpSpec &spec)
     padding_ = Padding::None;
     window_center_ = 0;
   }
+  if (streams_.enabled())
+    CheckSpectrogramStreamingArgs(padding_ != Padding::None, window_length_, window_step_);
 }
 
 template <bool time_major>
@@ -208,9 +238,18 @@ bool SpectrogramImplCpu<time_major>::SetupImpl(std::vector<OutputDesc> &out_desc
   constexpr int axis = 0;
   window_args_ = {window_length_, window_center_, window_step_, axis, padding_};
 
+  // In the streaming mode, the signal is the current chunk preceded by the samples
+  // of the previous chunk not yet covered by a window
+  if (streams_.enabled())
+    streams_.Acquire(spec_, ws, nsamples);
+  signal_lengths_.resize(nsamples);
   for (int sample_id = 0; sample_id < in_shape.num_samples(); sample_id++) {
     int64_t signal_length = in_shape[sample_id].num_elements();
-    DALI_ENFORCE(window_args_.num_windows(signal_length) > 0,
+    if (streams_.enabled())
+      signal_length += streams_[sample_id].tail.size();
+    signal_lengths_[sample_id] = signal_length;
+    DALI_ENFORCE(window_args_.num_windows(signal_length) > 0 &&
+                 (!streams_.enabled() || signal_length >= window_length_),
       make_string("Signal is too short (", signal_length, ") for sample ", sample_id));
   }
 
@@ -228,7 +267,7 @@ bool SpectrogramImplCpu<time_major>::SetupImpl(std::vector<OutputDesc> &out_desc
   auto view_window_fn = make_tensor_cpu<1>(window_fn_.data(), window_length_);
   for (int i = 0; i < nsamples; i++) {
     auto view_signal_1d = make_tensor_cpu<1>(input.template tensor<const InputType>(i),
-                                             {input.tensor_shape(i).num_elements()});
+                                             {signal_lengths_[i]});
 
     auto &windows_req =
       kmgr_window_.Setup<WindowKernel>(
@@ -259,6 +298,7 @@ void SpectrogramImplCpu<time_major>::RunImpl(workspace_t<CPUBackend> &ws) {
   auto& thread_pool = ws.GetThreadPool();
   auto view_window_fn = make_tensor_cpu<1>(window_fn_.data(), window_length_);
   output.SetLayout(layout_);
+  stream_signals_.resize(thread_pool.NumThreads());
 
   for (int i = 0; i < nsamples; i++) {
     thread_pool.AddWork(
@@ -269,8 +309,22 @@ void SpectrogramImplCpu<time_major>::RunImpl(workspace_t<CPUBackend> &ws) {
         win_out.set_type<InputType>();
         win_out.Resize(window_out_desc_[0].shape.tensor_shape(i));
 
-        auto view_signal_1d = make_tensor_cpu<1>(input.tensor<const InputType>(i),
-                                                 {input.tensor_shape(i).num_elements()});
+        const InputType *signal = input.tensor<const InputType>(i);
+        int64_t signal_length = signal_lengths_[i];
+        if (streams_.enabled()) {
+          auto &tail = streams_[i].tail;
+          auto &stream_signal = stream_signals_[thread_id];
+          stream_signal.assign(tail.begin(), tail.end());
+          stream_signal.insert(stream_signal.end(), signal,
+                               signal + input.tensor_shape(i).num_elements());
+          assert(static_cast<int64_t>(stream_signal.size()) == signal_length);
+          // The samples following the last window are kept for the next chunk
+          int64_t consumed = window_args_.num_windows(signal_length) * window_step_;
+          tail.assign(stream_signal.begin() + consumed, stream_signal.end());
+          signal = stream_signal.data();
+        }
+
+        auto view_signal_1d = make_tensor_cpu<1>(signal, {signal_length});
         kmgr_window_.Run<WindowKernel>(
           i, ctx,
           view<InputType, WindowsDims>(win_out),
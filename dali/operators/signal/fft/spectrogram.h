@@ -24,6 +24,15 @@
 
 namespace dali {
 
+/**
+ * @brief Checks the arguments for the signal processed in chunks (with `stream_id`)
+ *
+ * Only the windows which lie entirely within the signal can be produced chunk by chunk,
+ * so the windows cannot be centered. The samples skipped by `window_step` would not be kept
+ * for the next chunk, so the windows must not leave gaps.
+ */
+void CheckSpectrogramStreamingArgs(bool center_windows, int window_length, int window_step);
+
 template <typename Backend>
 class DLL_PUBLIC Spectrogram : public Operator<Backend> {
  public:
@@ -15,6 +15,10 @@
 #include <memory>
 #include <vector>
 #include "dali/operators/signal/fft/spectrogram.h"
+#include "dali/operators/signal/stream_state.h"
+#include "dali/core/dev_buffer.h"
+#include "dali/kernels/common/scatter_gather.h"
+#include "dali/kernels/dynamic_scratchpad.h"
 #include "dali/kernels/kernel_manager.h"
 #include "dali/kernels/signal/fft/stft_gpu.h"
 #include "dali/kernels/signal/window/window_functions.h"
@@ -31,7 +35,7 @@ using kernels::signal::Padding;
 using namespace kernels::signal::fft;  // NOLINT
 
 struct SpectrogramOpImplGPU : public OpImplBase<GPUBackend> {
-  explicit SpectrogramOpImplGPU(const OpSpec &spec) {
+  explicit SpectrogramOpImplGPU(const OpSpec &spec) : spec(spec), streams(spec) {
     args.window_length = spec.GetArgument<int>("window_length");
     args.window_step = spec.GetArgument<int>("window_step");
     args.nfft = spec.HasArgument("nfft") ? spec.GetArgument<int>("nfft") : args.window_length;
@@ -70,6 +74,8 @@ struct SpectrogramOpImplGPU : public OpImplBase<GPUBackend> {
       args.padding = Padding::None;
       args.window_center = 0;
     }
+    if (streams.enabled())
+      CheckSpectrogramStreamingArgs(center, args.window_length, args.window_step);
 
     kmgr.Resize<SpectrogramGPU>(1);
   }
@@ -125,7 +131,20 @@ struct SpectrogramOpImplGPU : public OpImplBase<GPUBackend> {
       axis = 0;
     }
 
-    auto req = kmgr.Setup<SpectrogramGPU>(0, ctx, in_shape_1D, args);
+    // In the streaming mode, the signal is the current chunk preceded by the samples
+    // of the previous chunk not yet covered by a window
+    signal_shape_1D = in_shape_1D;
+    if (streams.enabled()) {
+      streams.Acquire(spec, ws, in_shape.num_samples());
+      for (int i = 0; i < in_shape.num_samples(); i++) {
+        int64_t signal_length = in_shape_1D[i][0] + streams[i].length;
+        DALI_ENFORCE(signal_length >= args.window_length,
+          make_string("Signal is too short (", signal_length, ") for sample ", i));
+        signal_shape_1D.tensor_shape_span(i)[0] = signal_length;
+      }
+    }
+
+    auto req = kmgr.Setup<SpectrogramGPU>(0, ctx, signal_shape_1D, args);
     output_desc.resize(1);
     output_desc[0] = { req.output_shapes[0], DALI_FLOAT };
 
@@ -142,7 +161,40 @@ struct SpectrogramOpImplGPU : public OpImplBase<GPUBackend> {
     auto out_view_2D = view<float, 2>(out);
     KernelContext ctx;
     ctx.gpu.stream = ws.stream();
-    kmgr.Run<SpectrogramGPU>(0, ctx, out_view_2D, in_view_1D, gpu_window);
+    if (!streams.enabled()) {
+      kmgr.Run<SpectrogramGPU>(0, ctx, out_view_2D, in_view_1D, gpu_window);
+      return;
+    }
+
+    kernels::DynamicScratchpad scratchpad({}, ctx.gpu.stream);
+    auto signal_view_1D =
+        scratchpad.AllocTensorList<mm::memory_kind::device, float>(signal_shape_1D);
+    int nsamples = in_view_1D.num_samples();
+    for (int i = 0; i < nsamples; i++) {
+      auto &state = streams[i];
+      if (state.length > 0)
+        copy.AddCopy(signal_view_1D.data[i], state.tail.data(), state.length * sizeof(float));
+      copy.AddCopy(signal_view_1D.data[i] + state.length, in_view_1D.data[i],
+                   in_view_1D.shape[i][0] * sizeof(float));
+    }
+    copy.Run(ctx.gpu.stream);
+
+    kmgr.Run<SpectrogramGPU>(0, ctx, out_view_2D, signal_view_1D, gpu_window);
+
+    // The samples following the last window are kept for the next chunk
+    for (int i = 0; i < nsamples; i++) {
+      auto &state = streams[i];
+      int64_t signal_length = signal_view_1D.shape[i][0];
+      int64_t consumed = args.num_windows(signal_length) * args.window_step;
+      state.length = signal_length - consumed;
+      assert(state.length < args.window_length);
+      if (state.tail.empty())
+        state.tail.resize(args.window_length, ctx.gpu.stream);
+      if (state.length > 0)
+        copy.AddCopy(state.tail.data(), signal_view_1D.data[i] + consumed,
+                     state.length * sizeof(float));
+    }
+    copy.Run(ctx.gpu.stream);
   }
 
   void CopyWindowToDevice(cudaStream_t stream) {
@@ -155,6 +207,17 @@ struct SpectrogramOpImplGPU : public OpImplBase<GPUBackend> {
                               cudaMemcpyHostToDevice, stream));
   }
 
+  struct StreamState {
+    DeviceBuffer<float> tail;  ///< the samples not yet covered by a window
+    int64_t length = 0;
+    void clear() { length = 0; }
+  };
+
+  OpSpec spec;
+  StreamStates<StreamState> streams;
+  TensorListShape<1> signal_shape_1D;
+  kernels::ScatterGatherGPU copy;
+
   KernelManager kmgr;
   StftArgs args;
   vector<float> cpu_window;
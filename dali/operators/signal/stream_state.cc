@@ -0,0 +1,36 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "dali/operators/signal/stream_state.h"
+#include "dali/pipeline/operator/op_schema.h"
+
+namespace dali {
+
+DALI_SCHEMA(SignalStreamAttr)
+  .DocStr(R"code(Attributes of the signal operators processing streams in chunks.
+
+It should be added as parent to the operators that keep the state of a stream between chunks.)code")
+  .AddOptionalArg<int>("stream_id",
+    R"code(Identifier of the stream that the sample is a chunk of.
+
+If given, the samples are processed as consecutive chunks of their streams: the state at
+the end of a chunk is carried over to the next chunk with the same ``stream_id``, so that
+the chunks are processed exactly once and the result is the same as if the whole stream was
+processed at once. A batch can contain at most one chunk of each stream.)code", nullptr, true)
+  .AddOptionalArg("stream_reset",
+    R"code(If True, the sample starts a new stream and the state of the previous chunks with
+the same ``stream_id`` is discarded.
+
+It is ignored when ``stream_id`` is not given.)code", false, true);
+
+}  // namespace dali
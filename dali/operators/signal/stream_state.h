@@ -0,0 +1,103 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef DALI_OPERATORS_SIGNAL_STREAM_STATE_H_
+#define DALI_OPERATORS_SIGNAL_STREAM_STATE_H_
+
+#include <map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "dali/core/error_handling.h"
+#include "dali/pipeline/operator/common.h"
+#include "dali/pipeline/operator/op_spec.h"
+
+namespace dali {
+
+/**
+ * @brief The states of the streams processed in chunks by a signal operator
+ *
+ * When the `stream_id` argument is given, each sample is a chunk of the stream with that ID,
+ * and the state at the end of a chunk (e.g. the filter memory or the samples not yet
+ * covered by a window) is carried over to the next chunk of the same stream, so that every
+ * chunk is processed exactly once. The `stream_reset` argument starts a new stream.
+ *
+ * The State type should be default constructible and have a `clear()` method, which puts it
+ * in the state of a new stream. The states of the reset streams are reused for the new ones.
+ */
+template <typename State>
+class StreamStates {
+ public:
+  explicit StreamStates(const OpSpec &spec) : enabled_(spec.ArgumentDefined("stream_id")) {}
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+  /**
+   * @brief Assigns the states of their streams to the samples of the current batch
+   */
+  void Acquire(const OpSpec &spec, const ArgumentWorkspace &ws, int nsamples) {
+    assert(enabled_);
+    GetPerSampleArgument(ids_, "stream_id", spec, ws, nsamples);
+    if (spec.ArgumentDefined("stream_reset"))
+      GetPerSampleArgument(reset_, "stream_reset", spec, ws, nsamples);
+    else
+      reset_.assign(nsamples, false);
+
+    batch_ids_.clear();
+    sample_states_.resize(nsamples);
+    for (int i = 0; i < nsamples; i++) {
+      int id = ids_[i];
+      DALI_ENFORCE(batch_ids_.insert(id).second, make_string(
+          "A batch can contain only one chunk of a stream. Got more than one chunk with "
+          "`stream_id` = ", id, "."));
+      auto it = states_.find(id);
+      if (it != states_.end() && reset_[i]) {
+        free_.push_back(std::move(it->second));
+        states_.erase(it);
+        it = states_.end();
+      }
+      if (it == states_.end()) {
+        State state;
+        if (!free_.empty()) {
+          state = std::move(free_.back());
+          free_.pop_back();
+        }
+        state.clear();
+        it = states_.emplace(id, std::move(state)).first;
+      }
+      sample_states_[i] = &it->second;
+    }
+  }
+
+  /**
+   * @brief The state of the stream of a sample in the current batch
+   */
+  State &operator[](int sample_idx) {
+    return *sample_states_[sample_idx];
+  }
+
+ private:
+  bool enabled_ = false;
+  std::vector<int> ids_;
+  std::vector<bool> reset_;
+  std::unordered_set<int> batch_ids_;
+  std::map<int, State> states_;
+  std::vector<State> free_;
+  std::vector<State *> sample_states_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_SIGNAL_STREAM_STATE_H_
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -31,6 +31,7 @@ meets a randomly selected threshold between 0-1.
 When the IoU falls below the threshold, a new random crop is generated up to num_attempts.
 As an input, the operator accepts image, bounding boxes and labels. At the output cropped image,
 cropped and valid bounding boxes and valid labels are returned.)code")
+  .Nondeterministic()
   .NumInput(3)   // [img, bbox, label]
   .NumOutput(3)  // [img, bbox, label]
   .AddOptionalArg("num_attempts", R"code(Number of attempts.)code", 1)
@@ -75,21 +76,10 @@ namespace detail {
 // input in ltrb format
 // box1 is [N, 4], box2 is [M, 4]
 // calculate IoU of every box1 vs. every box2 : O(N^2)
-Tensor<CPUBackend> cpu_iou(const Tensor<CPUBackend>& box1,
-                           const Tensor<CPUBackend>& box2) {
-  Tensor<CPUBackend> ious;
-  ious.set_pinned(false);
-
-  int N = box1.dim(0);
+std::vector<float> cpu_iou(const float *box1_data, int N, const float *box2_data) {
   // Note: We know M=1 in this use-case
   // int M = box2.dim(0);
-  const int M = 1;
-
-  const float* box1_data = box1.data<float>();
-  const float* box2_data = box2.data<float>();
-
-  ious.Resize({N, 1}, DALI_FLOAT);
-  float *ious_data = ious.mutable_data<float>();
+  std::vector<float> ious(N);
 
   std::vector<std::pair<float, float>> lt, rb;
 
@@ -99,7 +89,7 @@ Tensor<CPUBackend> cpu_iou(const Tensor<CPUBackend>& box1,
    * rb = torch.min(be1[:,:,2:], be2[:,:,2:])
    */
   for (int i = 0; i < N; ++i) {
-    const float *b1 = box1_data + i * box1.dim(1);
+    const float *b1 = box1_data + i * 4;
     const float *b2 = box2_data;
 
     // want the maximum top, left
@@ -148,7 +138,7 @@ Tensor<CPUBackend> cpu_iou(const Tensor<CPUBackend>& box1,
   for (int i = 0; i < N; ++i) {
     // index into N*M arrays
     auto idx = i;
-    ious_data[idx] = intersect[idx] / (area1[i] + area2 - intersect[idx]);
+    ious[idx] = intersect[idx] / (area1[i] + area2 - intersect[idx]);
   }
   return ious;
 }
@@ -176,48 +166,27 @@ void crop(const Tensor<CPUBackend>& img, vector<int> bounds, Tensor<CPUBackend>&
 
 }  // namespace detail
 
-template <>
-void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace &ws) {
-  // [H, W, C], dtype=uint8_t
-  const auto& img = ws.Input<CPUBackend>(0);
-  // [N] : [ltrb, ... ], dtype=float
-  const auto& bboxes = ws.Input<CPUBackend>(1);
-  const auto& labels = ws.Input<CPUBackend>(2);
-  int sample = ws.data_idx();
-
-  auto N = bboxes.dim(0);
-  const float* bbox_data = bboxes.data<float>();
-
-  const int* label_data = labels.data<int>();
-
+template <typename Backend>
+bool SSDRandomCrop<Backend>::FindCrop(CropResult &crop, int sample, const float *bbox_data,
+                                      const int *label_data, int N, int htot, int wtot) {
+  auto &rng = rngs_[sample];
   // [1x4]
-  Tensor<CPUBackend> crop_attempt;
-  crop_attempt.set_pinned(false);
-  crop_attempt.Resize({1, 4}, DALI_FLOAT);
-  float *crop_ptr = crop_attempt.mutable_data<float>();
+  float crop_ptr[4];
   // iterate until a suitable crop has been found
   while (true) {
-    auto opt_idx = int_dis_(rngs_[sample]);
+    auto opt_idx = int_dis_(rng);
     auto option = sample_options_[opt_idx];
 
     if (option.no_crop()) {
-      // copy directly to output without modification
-      ws.Output<CPUBackend>(0).Copy(img);
-      ws.Output<CPUBackend>(1).Copy(bboxes);
-      ws.Output<CPUBackend>(2).Copy(labels);
-      return;
+      return false;
     }
 
-    // input is HWC ordering
-    auto htot = img.dim(0);
-    auto wtot = img.dim(1);
-
     auto min_iou = option.min_iou();
 
     // make num_attempts_ tries to get a valid crop
     for (int i = 0; i < num_attempts_; ++i) {
-      auto w = float_dis_(rngs_[sample]);
-      auto h = float_dis_(rngs_[sample]);
+      auto w = float_dis_(rng);
+      auto h = float_dis_(rng);
       // aspect ratio check
       if ((w / h < 0.5) || (w / h > 2.)) {
         continue;
@@ -225,8 +194,8 @@ void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace &ws) {
 
       // need RNG generators for left, top
       std::uniform_real_distribution<float> l_dis(0., 1. - w), t_dis(0., 1. - h);
-      double left = l_dis(rngs_[sample]);
-      double top = t_dis(rngs_[sample]);
+      double left = l_dis(rng);
+      double top = t_dis(rng);
 
       double right = left + w;
       double bottom = top + h;
@@ -237,15 +206,13 @@ void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace &ws) {
       crop_ptr[3] = bottom;
 
       // returns ious : [N, M]
-
-      Tensor<CPUBackend> ious = detail::cpu_iou(bboxes, crop_attempt);
-      const float *ious_data = ious.data<float>();
+      auto ious = detail::cpu_iou(bbox_data, N, crop_ptr);
 
       // make sure all the calculated IoUs are in the range (min_iou, max_iou)
       // Note: ious has size N*M, but M = 1 in this case
       bool fail = false;
       for (int j = 0; j < N * 1; ++j) {
-        if (ious_data[j] < min_iou) fail = true;
+        if (ious[j] < min_iou) fail = true;
       }
       // generate a new crop
       if (fail) {
@@ -271,18 +238,8 @@ void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace &ws) {
         continue;
       }
 
-      // now we know how many output bboxes there will be, we can allocate
-      // the output.
-      auto &img_out = ws.Output<CPUBackend>(0);
-      img_out.SetLayout(img.GetLayout());
-      auto &bbox_out = ws.Output<CPUBackend>(1);
-      auto &label_out = ws.Output<CPUBackend>(2);
-
-      bbox_out.Resize({valid_bboxes, 4}, DALI_FLOAT);
-      auto *bbox_out_data = bbox_out.mutable_data<float>();
-
-      label_out.Resize({valid_bboxes}, DALI_INT32);
-      auto *label_out_data = label_out.mutable_data<int>();
+      crop.boxes.resize(valid_bboxes * 4);
+      crop.labels.resize(valid_bboxes);
 
       // copy valid bboxes to output and transform them
       for (int j = 0; j < valid_bboxes; ++j) {
@@ -290,10 +247,10 @@ void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace &ws) {
 
         // this bbox is being preserved
         const auto *bbox_i = bbox_data + idx * 4;
-        auto *bbox_o = bbox_out_data + j * 4;
+        auto *bbox_o = crop.boxes.data() + j * 4;
 
         // bbox_o[4] = bbox_i[4];
-        label_out_data[j] = label_data[idx];
+        crop.labels[j] = label_data[idx];
 
         // scaling
         double minus[] = {left, top, left, top};
@@ -311,16 +268,63 @@ void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace &ws) {
       const int top_idx = std::llround(top * htot);
       const int right_idx = std::llround(right * wtot);
       const int bottom_idx = std::llround(bottom * htot);
-
-      // perform the crop
-      detail::crop(img, {left_idx, top_idx, right_idx, bottom_idx},
-                   img_out);
-
-      return;
+      crop.window = {left_idx, top_idx, right_idx - left_idx, bottom_idx - top_idx};
+      return true;
     }  // end num_attempts loop
   }  // end sample loop
 }
 
+template bool SSDRandomCrop<CPUBackend>::FindCrop(CropResult &, int, const float *, const int *,
+                                                  int, int, int);
+template bool SSDRandomCrop<GPUBackend>::FindCrop(CropResult &, int, const float *, const int *,
+                                                  int, int, int);
+
+template <>
+void SSDRandomCrop<CPUBackend>::RunImpl(SampleWorkspace &ws) {
+  // [H, W, C], dtype=uint8_t
+  const auto& img = ws.Input<CPUBackend>(0);
+  // [N] : [ltrb, ... ], dtype=float
+  const auto& bboxes = ws.Input<CPUBackend>(1);
+  const auto& labels = ws.Input<CPUBackend>(2);
+  int sample = ws.data_idx();
+
+  auto N = bboxes.dim(0);
+  const float* bbox_data = bboxes.data<float>();
+
+  const int* label_data = labels.data<int>();
+
+  // input is HWC ordering
+  auto htot = img.dim(0);
+  auto wtot = img.dim(1);
+
+  CropResult crop;
+  if (!FindCrop(crop, sample, bbox_data, label_data, N, htot, wtot)) {
+    // copy directly to output without modification
+    ws.Output<CPUBackend>(0).Copy(img);
+    ws.Output<CPUBackend>(1).Copy(bboxes);
+    ws.Output<CPUBackend>(2).Copy(labels);
+    return;
+  }
+
+  // now we know how many output bboxes there will be, we can allocate
+  // the output.
+  auto &img_out = ws.Output<CPUBackend>(0);
+  img_out.SetLayout(img.GetLayout());
+  auto &bbox_out = ws.Output<CPUBackend>(1);
+  auto &label_out = ws.Output<CPUBackend>(2);
+
+  int valid_bboxes = crop.labels.size();
+  bbox_out.Resize({valid_bboxes, 4}, DALI_FLOAT);
+  std::copy(crop.boxes.begin(), crop.boxes.end(), bbox_out.mutable_data<float>());
+
+  label_out.Resize({valid_bboxes}, DALI_INT32);
+  std::copy(crop.labels.begin(), crop.labels.end(), label_out.mutable_data<int>());
+
+  // perform the crop
+  const auto &window = crop.window;
+  detail::crop(img, {window.x, window.y, window.x + window.w, window.y + window.h}, img_out);
+}
+
 template <>
 void SSDRandomCrop<CPUBackend>::SetupSharedSampleParams(SampleWorkspace &ws) {
   return;
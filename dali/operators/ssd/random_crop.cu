@@ -0,0 +1,116 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <vector>
+#include "dali/core/cuda_error.h"
+#include "dali/core/format.h"
+#include "dali/operators/ssd/random_crop.h"
+
+namespace dali {
+
+/*
+ * The boxes and the labels are small, so they are copied to the host, where the crop windows
+ * are drawn in the same way as in the CPU operator. The images stay on the GPU and only
+ * the windows are copied to the output.
+ */
+template <>
+void SSDRandomCrop<GPUBackend>::RunImpl(DeviceWorkspace &ws) {
+  const auto &images = ws.Input<GPUBackend>(0);
+  const auto &bboxes = ws.Input<GPUBackend>(1);
+  const auto &labels = ws.Input<GPUBackend>(2);
+  auto stream = ws.stream();
+  int nsamples = images.num_samples();
+
+  DALI_ENFORCE(images.type() == DALI_UINT8 && images.sample_dim() == 3,
+               make_string("Expected HWC uint8 images, got ", images.sample_dim(), "D ",
+                           images.type(), " data."));
+  DALI_ENFORCE(bboxes.type() == DALI_FLOAT, "Bounding box in wrong format");
+  DALI_ENFORCE(labels.type() == DALI_INT32,
+               make_string("Expected int32 labels, got ", labels.type(), "."));
+
+  // The copies follow the copies of the outputs of the previous iteration in the stream,
+  // so the host buffers can be reused once they are done.
+  host_bboxes_.Copy(bboxes, stream);
+  host_labels_.Copy(labels, stream);
+  CUDA_CALL(cudaStreamSynchronize(stream));
+
+  auto images_shape = images.shape();
+  auto out_images_shape = images_shape;
+  auto out_bboxes_shape = bboxes.shape();
+  auto out_labels_shape = labels.shape();
+  std::vector<CropResult> crops(nsamples);
+  std::vector<bool> cropped(nsamples);
+  for (int i = 0; i < nsamples; i++) {
+    auto sh = images_shape.tensor_shape_span(i);
+    int nboxes = out_bboxes_shape.tensor_shape_span(i)[0];
+    cropped[i] = FindCrop(crops[i], i, host_bboxes_.tensor<float>(i),
+                          host_labels_.tensor<int>(i), nboxes, sh[0], sh[1]);
+    if (!cropped[i])
+      continue;
+    const auto &window = crops[i].window;
+    int valid_bboxes = crops[i].labels.size();
+    out_images_shape.set_tensor_shape(i, {window.h, window.w, sh[2]});
+    out_bboxes_shape.set_tensor_shape(i, {valid_bboxes, 4});
+    out_labels_shape.tensor_shape_span(i)[0] = valid_bboxes;
+  }
+
+  host_bboxes_out_.Resize(out_bboxes_shape, DALI_FLOAT);
+  host_labels_out_.Resize(out_labels_shape, DALI_INT32);
+  for (int i = 0; i < nsamples; i++) {
+    auto *bboxes_out = host_bboxes_out_.mutable_tensor<float>(i);
+    auto *labels_out = host_labels_out_.mutable_tensor<int>(i);
+    if (cropped[i]) {
+      std::copy(crops[i].boxes.begin(), crops[i].boxes.end(), bboxes_out);
+      std::copy(crops[i].labels.begin(), crops[i].labels.end(), labels_out);
+    } else {
+      const auto *bboxes_in = host_bboxes_.tensor<float>(i);
+      const auto *labels_in = host_labels_.tensor<int>(i);
+      std::copy(bboxes_in, bboxes_in + volume(out_bboxes_shape[i]), bboxes_out);
+      std::copy(labels_in, labels_in + volume(out_labels_shape[i]), labels_out);
+    }
+  }
+  ws.Output<GPUBackend>(1).Copy(host_bboxes_out_, stream);
+  ws.Output<GPUBackend>(2).Copy(host_labels_out_, stream);
+
+  auto &images_out = ws.Output<GPUBackend>(0);
+  images_out.Resize(out_images_shape, DALI_UINT8);
+  images_out.SetLayout(images.GetLayout());
+  for (int i = 0; i < nsamples; i++) {
+    const auto *in = images.tensor<uint8_t>(i);
+    auto *out = images_out.mutable_tensor<uint8_t>(i);
+    if (!cropped[i]) {
+      CUDA_CALL(cudaMemcpyAsync(out, in, volume(images_shape[i]), cudaMemcpyDeviceToDevice,
+                                stream));
+      continue;
+    }
+    auto sh = images_shape.tensor_shape_span(i);
+    int64_t C = sh[2];
+    int64_t in_pitch = sh[1] * C;
+    const auto &window = crops[i].window;
+    int64_t out_pitch = window.w * C;
+    CUDA_CALL(cudaMemcpy2DAsync(out, out_pitch, in + window.y * in_pitch + window.x * C,
+                                in_pitch, out_pitch, window.h, cudaMemcpyDeviceToDevice,
+                                stream));
+  }
+}
+
+template <>
+void SSDRandomCrop<GPUBackend>::SetupSharedSampleParams(DeviceWorkspace &ws) {
+  return;
+}
+
+DALI_REGISTER_OPERATOR(SSDRandomCrop, SSDRandomCrop<GPUBackend>, GPU);
+
+}  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -68,6 +68,27 @@ class SSDRandomCrop : public Operator<Backend> {
     int w, h;
   };
 
+  struct CropResult {
+    /// The crop window, in pixels
+    CropInfo window;
+    /// The boxes left in the window (in ltrb format, relative to the window) and their labels
+    std::vector<float> boxes;
+    std::vector<int> labels;
+  };
+
+  /**
+   * @brief Draws the crop window of a sample
+   *
+   * @param bbox_data  the boxes of the sample, in ltrb format
+   * @param label_data the labels of the boxes
+   * @param N          the number of boxes
+   * @param htot       the height of the image
+   * @param wtot       the width of the image
+   * @return false, if the sample is not cropped
+   */
+  bool FindCrop(CropResult &crop, int sample, const float *bbox_data, const int *label_data,
+                int N, int htot, int wtot);
+
   struct SampleOption {
     bool no_crop_ = false;
     float min_iou_ = FLT_MAX;
@@ -91,6 +112,10 @@ class SSDRandomCrop : public Operator<Backend> {
   BatchRNG<std::mt19937> rngs_;
   std::uniform_int_distribution<> int_dis_;
   std::uniform_real_distribution<float> float_dis_;
+
+  // GPU only: the boxes and labels are processed on the host
+  TensorList<CPUBackend> host_bboxes_, host_labels_;
+  TensorList<CPUBackend> host_bboxes_out_, host_labels_out_;
 };
 
 }  // namespace dali
@@ -0,0 +1,86 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <limits>
+#include <tuple>
+#include <vector>
+#include "dali/operators/util/cast_samples.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/error_handling.h"
+#include "dali/core/static_switch.h"
+#include "dali/kernels/common/cast.cuh"
+#include "dali/kernels/dynamic_scratchpad.h"
+
+#define CAST_SAMPLES_TYPES \
+  (uint8_t, int8_t, uint16_t, int16_t, uint32_t, int32_t, uint64_t, int64_t, float16, bfloat16, \
+  double)
+
+namespace dali {
+
+namespace {
+
+constexpr int kBlockSize = 256;
+constexpr int kBlockVolumeScale = 4;
+
+template <typename Out, typename In>
+void LaunchCast(const kernels::CastSampleDesc *samples, const kernels::CastSampleBlockDesc *params,
+                unsigned nsamples, unsigned nblocks, cudaStream_t stream) {
+  kernels::BinSearchCastKernel<Out, In>
+      <<<nblocks, kBlockSize, 0, stream>>>(samples, params, nsamples, kBlockVolumeScale);
+  CUDA_CALL(cudaGetLastError());
+}
+
+}  // namespace
+
+void CastSamplesGPU(DALIDataType out_type, DALIDataType in_type,
+                    span<const CastSample> samples, cudaStream_t stream) {
+  DALI_ENFORCE(out_type == DALI_FLOAT || in_type == DALI_FLOAT, make_string(
+      "Only conversions from and to float are supported. Got: ", in_type, " -> ", out_type));
+  std::vector<kernels::CastSampleDesc> descs;
+  std::vector<kernels::CastSampleBlockDesc> params;
+  descs.reserve(samples.size());
+  params.reserve(samples.size());
+  unsigned nblocks = 0;
+  const int64_t block_volume = kBlockSize * kBlockVolumeScale;
+  for (auto &sample : samples) {
+    // the kernel assigns the blocks to the last sample starting at a given block - the empty
+    // samples would take the blocks of the following ones
+    if (sample.size == 0)
+      continue;
+    DALI_ENFORCE(sample.size <= std::numeric_limits<unsigned>::max(), make_string(
+        "Too many elements in a sample: ", sample.size));
+    descs.push_back({sample.output, sample.input});
+    params.push_back({nblocks, static_cast<unsigned>(sample.size)});
+    nblocks += (sample.size + block_volume - 1) / block_volume;
+  }
+  if (descs.empty())
+    return;
+
+  kernels::DynamicScratchpad scratchpad({}, stream);
+  kernels::CastSampleDesc *descs_gpu;
+  kernels::CastSampleBlockDesc *params_gpu;
+  std::tie(descs_gpu, params_gpu) = scratchpad.ToContiguousGPU(stream, descs, params);
+  unsigned nsamples = descs.size();
+  if (out_type == DALI_FLOAT) {
+    TYPE_SWITCH(in_type, type2id, In, CAST_SAMPLES_TYPES, (
+      LaunchCast<float, In>(descs_gpu, params_gpu, nsamples, nblocks, stream);
+    ), (DALI_FAIL(make_string("Unsupported input type: ", in_type))));  // NOLINT
+  } else {
+    TYPE_SWITCH(out_type, type2id, Out, CAST_SAMPLES_TYPES, (
+      LaunchCast<Out, float>(descs_gpu, params_gpu, nsamples, nblocks, stream);
+    ), (DALI_FAIL(make_string("Unsupported output type: ", out_type))));  // NOLINT
+  }
+}
+
+}  // namespace dali
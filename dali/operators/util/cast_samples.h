@@ -0,0 +1,47 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_UTIL_CAST_SAMPLES_H_
+#define DALI_OPERATORS_UTIL_CAST_SAMPLES_H_
+
+#include <cuda_runtime.h>
+#include <cstdint>
+#include "dali/core/api_helper.h"
+#include "dali/core/span.h"
+#include "dali/pipeline/data/types.h"
+
+namespace dali {
+
+struct CastSample {
+  void *output;
+  const void *input;
+  int64_t size;  // the number of elements
+};
+
+/**
+ * @brief Converts a batch of samples between float and another numeric type, with saturation.
+ *
+ * This is the generic path of the operators which instantiate their kernels only for the hot
+ * types (see dali/core/hot_types.h) - the other types are converted to float, processed by the
+ * float kernel and (for the outputs) converted back. The conversion kernels are instantiated
+ * only here, once for all such operators.
+ *
+ * Either `in_type` or `out_type` must be DALI_FLOAT.
+ */
+DLL_PUBLIC void CastSamplesGPU(DALIDataType out_type, DALIDataType in_type,
+                               span<const CastSample> samples, cudaStream_t stream);
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_UTIL_CAST_SAMPLES_H_
@@ -0,0 +1,70 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "dali/core/cuda_stream.h"
+#include "dali/core/dev_buffer.h"
+#include "dali/operators/util/cast_samples.h"
+
+namespace dali {
+namespace test {
+
+TEST(CastSamplesGPU, ToFloatAndBack) {
+  CUDAStream stream = CUDAStream::Create(true);
+  std::vector<uint16_t> in0 = { 0, 1, 1000, 65535 };
+  std::vector<uint16_t> in1(3000);
+  for (size_t i = 0; i < in1.size(); i++)
+    in1[i] = i * 7;
+  DeviceBuffer<uint16_t> in0_gpu, in1_gpu;
+  in0_gpu.from_host(in0, stream);
+  in1_gpu.from_host(in1, stream);
+  DeviceBuffer<float> f0_gpu, f1_gpu;
+  f0_gpu.resize(in0.size());
+  f1_gpu.resize(in1.size());
+
+  std::vector<CastSample> to_float = {
+    { f0_gpu.data(), in0_gpu.data(), static_cast<int64_t>(in0.size()) },
+    { nullptr, nullptr, 0 },  // an empty sample
+    { f1_gpu.data(), in1_gpu.data(), static_cast<int64_t>(in1.size()) },
+  };
+  CastSamplesGPU(DALI_FLOAT, DALI_UINT16, make_cspan(to_float), stream);
+
+  std::vector<float> f0(in0.size()), f1(in1.size());
+  copyD2H(f0.data(), f0_gpu.data(), f0.size(), stream);
+  copyD2H(f1.data(), f1_gpu.data(), f1.size(), stream);
+  CUDA_CALL(cudaStreamSynchronize(stream));
+  for (size_t i = 0; i < in0.size(); i++)
+    EXPECT_EQ(f0[i], in0[i]);
+  for (size_t i = 0; i < in1.size(); i++)
+    EXPECT_EQ(f1[i], in1[i]);
+
+  // saturating float -> int8
+  DeviceBuffer<int8_t> out_gpu;
+  out_gpu.resize(in0.size());
+  std::vector<CastSample> from_float = {
+    { out_gpu.data(), f0_gpu.data(), static_cast<int64_t>(in0.size()) },
+  };
+  CastSamplesGPU(DALI_INT8, DALI_FLOAT, make_cspan(from_float), stream);
+  std::vector<int8_t> out(in0.size());
+  copyD2H(out.data(), out_gpu.data(), out.size(), stream);
+  CUDA_CALL(cudaStreamSynchronize(stream));
+  EXPECT_EQ(out, (std::vector<int8_t>{ 0, 1, 127, 127 }));
+
+  EXPECT_THROW(CastSamplesGPU(DALI_INT8, DALI_UINT16, make_cspan(from_float), stream),
+               std::exception);
+}
+
+}  // namespace test
+}  // namespace dali
@@ -0,0 +1,194 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_OPERATORS_UTIL_PHILOX_DIST_H_
+#define DALI_OPERATORS_UTIL_PHILOX_DIST_H_
+
+#include <math.h>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include "dali/core/force_inline.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/philox.h"
+
+/**
+ * @file
+ *
+ * Distributions driven by the counter-based Philox4x32_10 generator.
+ *
+ * Unlike `std::` distributions and curand, these use the same algorithms on the host and on
+ * the device, so that the same generator gives the same values (up to the accuracy of the math
+ * functions, for the normal and Poisson distributions) on both backends.
+ */
+
+namespace dali {
+
+namespace detail {
+
+DALI_HOST_DEV DALI_FORCEINLINE float dist_sqrt(float x) { return sqrtf(x); }
+DALI_HOST_DEV DALI_FORCEINLINE double dist_sqrt(double x) { return sqrt(x); }
+DALI_HOST_DEV DALI_FORCEINLINE float dist_log(float x) { return logf(x); }
+DALI_HOST_DEV DALI_FORCEINLINE double dist_log(double x) { return log(x); }
+DALI_HOST_DEV DALI_FORCEINLINE float dist_cos(float x) { return cosf(x); }
+DALI_HOST_DEV DALI_FORCEINLINE double dist_cos(double x) { return cos(x); }
+
+}  // namespace detail
+
+/**
+ * @brief Returns a uniformly distributed number in [0, 1)
+ *
+ * Uses 24 random bits for float and 53 bits for double.
+ */
+template <typename T>
+DALI_HOST_DEV DALI_FORCEINLINE T philox_uniform01(Philox4x32_10 &rng);
+
+template <>
+DALI_HOST_DEV DALI_FORCEINLINE float philox_uniform01<float>(Philox4x32_10 &rng) {
+  return (rng() >> 8) * 5.9604644775390625e-8f;  // 2^-24
+}
+
+template <>
+DALI_HOST_DEV DALI_FORCEINLINE double philox_uniform01<double>(Philox4x32_10 &rng) {
+  uint64_t hi = rng() >> 5, lo = rng() >> 6;  // 27 + 26 bits
+  return ((hi << 26) | lo) * 1.1102230246251565e-16;  // 2^-53
+}
+
+template <typename T>
+struct philox_uniform_dist {
+  static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+    "Unexpected data type");
+
+  DALI_HOST_DEV philox_uniform_dist() = default;
+
+  DALI_HOST_DEV philox_uniform_dist(T start, T end)
+      : range_start_(start), range_end_(end), range_size_(end - start) {
+    assert(end > start);
+  }
+
+  DALI_HOST_DEV inline T operator()(Philox4x32_10 &rng) const {
+    T val;
+    do {
+      // the rounding can produce the end of the range
+      val = range_start_ + philox_uniform01<T>(rng) * range_size_;
+    } while (val >= range_end_);
+    return val;
+  }
+
+ private:
+  T range_start_ = 0, range_end_ = 1, range_size_ = 1;
+};
+
+/**
+ * @brief Draws one of the given values, with equal probabilities
+ *
+ * The number of values must be less than 2^32.
+ */
+template <typename T>
+struct philox_uniform_values_dist {
+  DALI_HOST_DEV philox_uniform_values_dist() = default;
+
+  DALI_HOST_DEV philox_uniform_values_dist(const T *values, int64_t nvalues)
+      : values_(values), nvalues_(nvalues) {}
+
+  DALI_HOST_DEV inline T operator()(Philox4x32_10 &rng) const {
+    auto idx = (static_cast<uint64_t>(rng()) * static_cast<uint64_t>(nvalues_)) >> 32;
+    return values_[idx];
+  }
+
+ private:
+  const T *values_ = nullptr;  // in the memory accessible by the backend
+  int64_t nvalues_ = 0;
+};
+
+/**
+ * @brief Normal distribution, generated with the Box-Muller transform
+ */
+template <typename T>
+struct philox_normal_dist {
+  static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+    "Unexpected data type");
+
+  T mean = 0, stddev = 1;
+
+  DALI_HOST_DEV inline T operator()(Philox4x32_10 &rng) const {
+    T u1 = 1 - philox_uniform01<T>(rng);  // (0, 1], so that the logarithm is finite
+    T u2 = philox_uniform01<T>(rng);
+    T r = detail::dist_sqrt(-2 * detail::dist_log(u1));
+    return mean + stddev * r * detail::dist_cos(static_cast<T>(2 * M_PI) * u2);
+  }
+};
+
+struct philox_bernoulli_dist {
+  explicit DALI_HOST_DEV philox_bernoulli_dist(float probability = 0.5f)
+      : probability_(probability) {}
+
+  DALI_HOST_DEV inline bool operator()(Philox4x32_10 &rng) const {
+    return philox_uniform01<float>(rng) < probability_;
+  }
+
+ private:
+  float probability_ = 0.5f;
+};
+
+/**
+ * @brief Poisson distribution
+ *
+ * Uses the multiplication method for small lambdas and the transformed rejection method
+ * (PTRS, W. Hormann, 1993) for lambda >= 10.
+ */
+struct philox_poisson_dist {
+  explicit DALI_HOST_DEV philox_poisson_dist(float lambda = 1)
+      : lambda_(lambda) {}
+
+  DALI_HOST_DEV inline uint32_t operator()(Philox4x32_10 &rng) const {
+    if (!(lambda_ > 0))
+      return 0;
+    if (lambda_ < 10) {
+      float limit = expf(-lambda_);
+      float p = philox_uniform01<float>(rng);
+      uint32_t k = 0;
+      while (p > limit) {
+        k++;
+        p *= philox_uniform01<float>(rng);
+      }
+      return k;
+    }
+    float slam = sqrtf(lambda_), loglam = logf(lambda_);
+    float b = 0.931f + 2.53f * slam;
+    float a = -0.059f + 0.02483f * b;
+    float invalpha = 1.1239f + 1.1328f / (b - 3.4f);
+    float vr = 0.9277f - 3.6224f / (b - 2);
+    for (;;) {
+      float u = philox_uniform01<float>(rng) - 0.5f;
+      float v = philox_uniform01<float>(rng);
+      float us = 0.5f - fabsf(u);
+      float k = floorf((2 * a / us + b) * u + lambda_ + 0.43f);
+      if (us >= 0.07f && v <= vr)
+        return k;
+      if (k < 0 || (us < 0.013f && v > us))
+        continue;
+      if (logf(v) + logf(invalpha) - logf(a / (us * us) + b) <=
+          -lambda_ + k * loglam - lgammaf(k + 1))
+        return k;
+    }
+  }
+
+ private:
+  float lambda_ = 1;
+};
+
+}  // namespace dali
+
+#endif  // DALI_OPERATORS_UTIL_PHILOX_DIST_H_
@@ -556,7 +556,8 @@ class DLL_PUBLIC Buffer {
     set_order(order);
 
     // Fill the remaining members in the order as they appear in class.
-    type_ = TypeTable::GetTypeInfo(type);
+    if (type_.id() != type)
+      type_ = TypeTable::GetTypeInfo(type);
     data_ = ptr;
     allocate_ = {};
     size_ = size;
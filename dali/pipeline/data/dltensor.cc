@@ -19,6 +19,12 @@ namespace dali {
 
 DLDataType GetDLType(DALIDataType type) {
   DLDataType dl_type{};
+  if (type == DALI_BFLOAT16) {
+    dl_type.code = kDLBfloat;
+    dl_type.bits = 16;
+    dl_type.lanes = 1;
+    return dl_type;
+  }
   DALI_TYPE_SWITCH_WITH_FP16(type, T,
       dl_type.bits = sizeof(T) * 8;
       dl_type.lanes = 1;
@@ -102,6 +108,11 @@ DALIDataType DLToDALIType(const DLDataType &dl_type) {
       }
       break;
     }
+    case kDLBfloat: {
+      if (dl_type.bits == 16)
+        return DALI_BFLOAT16;
+      break;
+    }
   }
   DALI_FAIL("Could not convert DLPack tensor of unsupported type " + to_string(dl_type));
 }
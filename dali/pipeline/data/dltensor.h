@@ -73,6 +73,27 @@ std::vector<DLMTensorPtr> GetDLTensorListView(TensorList<Backend> &tensor_list)
   return dl_tensors;
 }
 
+/**
+ * @brief Returns a flat, 1D view of the values of all the samples in a batch which is
+ *        contiguous in memory.
+ *
+ * The samples of a contiguous batch are stored back to back, so together with the offsets of
+ * the samples (the prefix sums of their volumes) the view describes a ragged batch without
+ * any padding.
+ */
+template <typename Backend>
+DLMTensorPtr GetDLTensorListValuesView(TensorList<Backend> &tensor_list) {
+  DALI_ENFORCE(tensor_list.IsContiguousInMemory(),
+               "Only a batch which is contiguous in memory can be viewed as a single buffer.");
+  TensorShape<> shape = {tensor_list.shape().num_elements()};
+  void *data = tensor_list.num_samples() > 0 ? tensor_list.raw_mutable_tensor(0) : nullptr;
+  return MakeDLTensor(data,
+                      tensor_list.type(),
+                      std::is_same<Backend, GPUBackend>::value,
+                      tensor_list.device_id(),
+                      std::make_unique<DLTensorResource>(shape));
+}
+
 DLL_PUBLIC DALIDataType DLToDALIType(const DLDataType &dl_type);
 
 }  // namespace dali
@@ -107,6 +107,22 @@ TEST(DLMTensorPtr, GPUList) {
   ASSERT_EQ(dlm_tensors[1]->dl_tensor.device.device_id, tlist.device_id());
 }
 
+TEST(DLMTensorPtr, GPUListValues) {
+  TensorList<GPUBackend> tlist;
+  tlist.Resize({{7, 3}, {2, 3}, {0, 3}, {5, 3}}, DALI_INT16);
+  ASSERT_TRUE(tlist.IsContiguousInMemory());
+  DLMTensorPtr dlm_tensor = GetDLTensorListValuesView(tlist);
+  ASSERT_EQ(dlm_tensor->dl_tensor.ndim, 1);
+  ASSERT_EQ(dlm_tensor->dl_tensor.shape[0], (7 + 2 + 0 + 5) * 3);
+  ASSERT_EQ(dlm_tensor->dl_tensor.data, tlist.raw_tensor(0));
+  ASSERT_EQ(dlm_tensor->dl_tensor.dtype.code, kDLInt);
+  ASSERT_EQ(dlm_tensor->dl_tensor.dtype.bits, sizeof(int16_t) * 8);
+  ASSERT_EQ(dlm_tensor->dl_tensor.device.device_type, kDLCUDA);
+  ASSERT_EQ(dlm_tensor->dl_tensor.device.device_id, tlist.device_id());
+  // the samples are stored back to back
+  ASSERT_EQ(tlist.raw_tensor(3), static_cast<const int16_t *>(tlist.raw_tensor(0)) + 9 * 3);
+}
+
 struct TestDLTensorResource: public DLTensorResource {
   TestDLTensorResource(TensorShape<> shape, bool &called)
   : DLTensorResource(std::move(shape))
@@ -0,0 +1,120 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/data/ipc_buffer.h"
+#include <utility>
+#include "dali/core/device_guard.h"
+#include "dali/core/mm/memory_kind.h"
+#include "dali/pipeline/data/copy_to_external.h"
+
+#if DALI_USE_CUDA_VM_MAP
+
+namespace dali {
+
+IpcDeviceBuffer::IpcDeviceBuffer(mm::cuvm::CUMem mem, int device_id)
+: mem_(std::move(mem)), device_id_(device_id) {
+  va_ = mm::cuvm::CUMemAddressRange::Reserve(mem_.size());
+  mm::cuvm::Map(va_.ptr(), mem_.handle(), mem_.size());
+}
+
+IpcDeviceBuffer::~IpcDeviceBuffer() {
+  if (va_) {
+    DeviceGuard dg(device_id_);
+    mm::cuvm::Unmap(va_.ptr(), mem_.size());
+  }
+}
+
+std::shared_ptr<IpcDeviceBuffer> IpcDeviceBuffer::Create(size_t size, int device_id) {
+  DeviceGuard dg(device_id);
+  CUDA_CALL(cudaGetDevice(&device_id));
+  auto mem = mm::cuvm::CUMem::Create(size, mm::cuvm::ShareableDeviceMemProp(device_id));
+  return std::shared_ptr<IpcDeviceBuffer>(new IpcDeviceBuffer(std::move(mem), device_id));
+}
+
+std::shared_ptr<IpcDeviceBuffer> IpcDeviceBuffer::Import(int fd, size_t size, int device_id) {
+  DeviceGuard dg(device_id);
+  CUDA_CALL(cudaGetDevice(&device_id));
+  auto mem = mm::cuvm::CUMem::ImportFd(fd, size);
+  return std::shared_ptr<IpcDeviceBuffer>(new IpcDeviceBuffer(std::move(mem), device_id));
+}
+
+int IpcDeviceBuffer::Export() const {
+  return mem_.ExportFd();
+}
+
+IpcEvent IpcEvent::Create(int device_id) {
+  IpcEvent ev;
+  DeviceGuard dg(device_id);
+  CUDA_CALL(cudaGetDevice(&ev.device_id_));
+  ev.event_ = CUDAEvent::CreateWithFlags(cudaEventInterprocess | cudaEventDisableTiming);
+  CUDA_CALL(cudaIpcGetEventHandle(&ev.handle_, ev.event_));
+  return ev;
+}
+
+IpcEvent IpcEvent::Open(const cudaIpcEventHandle_t &handle, int device_id) {
+  IpcEvent ev;
+  DeviceGuard dg(device_id);
+  CUDA_CALL(cudaGetDevice(&ev.device_id_));
+  cudaEvent_t event;
+  CUDA_CALL(cudaIpcOpenEventHandle(&event, handle));
+  ev.event_ = CUDAEvent(event);
+  ev.handle_ = handle;
+  return ev;
+}
+
+void IpcEvent::Record(cudaStream_t stream) {
+  CUDA_CALL(cudaEventRecord(event_, stream));
+}
+
+void IpcEvent::Wait(cudaStream_t stream) {
+  CUDA_CALL(cudaStreamWaitEvent(stream, event_, 0));
+}
+
+void IpcEvent::Synchronize() {
+  CUDA_CALL(cudaEventSynchronize(event_));
+}
+
+size_t IpcBatchBytes(const TensorList<GPUBackend> &batch) {
+  return batch.shape().num_elements() * TypeTable::GetTypeInfo(batch.type()).size();
+}
+
+void CopyToIpcBuffer(IpcDeviceBuffer &buffer, size_t offset,
+                     const TensorList<GPUBackend> &batch, cudaStream_t stream) {
+  size_t bytes = IpcBatchBytes(batch);
+  DALI_ENFORCE(offset + bytes <= buffer.size(), make_string(
+      "The batch of ", bytes, " bytes doesn't fit in the buffer of ", buffer.size(),
+      " bytes at offset ", offset, "."));
+  if (bytes == 0)
+    return;
+  void *dst = static_cast<char *>(buffer.data()) + offset;
+  CopyToExternal<mm::memory_kind::device>(dst, batch, AccessOrder(stream), true);
+}
+
+void ShareIpcBuffer(TensorList<GPUBackend> &batch,
+                    const std::shared_ptr<IpcDeviceBuffer> &buffer, size_t offset,
+                    const TensorListShape<> &shape, DALIDataType type,
+                    const TensorLayout &layout, cudaStream_t stream) {
+  size_t bytes = shape.num_elements() * TypeTable::GetTypeInfo(type).size();
+  DALI_ENFORCE(offset + bytes <= buffer->size(), make_string(
+      "The batch of ", bytes, " bytes exceeds the buffer of ", buffer->size(),
+      " bytes at offset ", offset, "."));
+  void *ptr = static_cast<char *>(buffer->data()) + offset;
+  // the deleter keeps the buffer alive
+  batch.ShareData(std::shared_ptr<void>(ptr, [buffer](void *) {}), bytes, false, shape, type,
+                  buffer->device_id(), AccessOrder(stream), layout);
+}
+
+}  // namespace dali
+
+#endif  // DALI_USE_CUDA_VM_MAP
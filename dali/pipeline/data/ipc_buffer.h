@@ -0,0 +1,127 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_DATA_IPC_BUFFER_H_
+#define DALI_PIPELINE_DATA_IPC_BUFFER_H_
+
+#include <cuda_runtime_api.h>
+#include <memory>
+#include "dali/core/api_helper.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/mm/cu_vm.h"
+#include "dali/core/tensor_layout.h"
+#include "dali/core/tensor_shape.h"
+#include "dali/pipeline/data/backend.h"
+#include "dali/pipeline/data/tensor_list.h"
+
+#if DALI_USE_CUDA_VM_MAP
+
+namespace dali {
+
+/**
+ * @brief Device memory which can be mapped by other processes
+ *
+ * The physical memory is allocated with the CUDA virtual memory management API, with a POSIX
+ * file descriptor requested as its shareable handle, and mapped to a virtual address range of
+ * this process. The descriptor returned by Export can be passed to another process
+ * (e.g. over a Unix socket) which maps the same memory with Import.
+ */
+class DLL_PUBLIC IpcDeviceBuffer {
+ public:
+  /**
+   * @brief Allocates an exportable buffer of at least `size` bytes on the device
+   */
+  static std::shared_ptr<IpcDeviceBuffer> Create(size_t size, int device_id);
+
+  /**
+   * @brief Maps the buffer exported by another process
+   *
+   * @param fd   The descriptor obtained with Export; it is not closed by this function.
+   * @param size The size of the exported buffer
+   */
+  static std::shared_ptr<IpcDeviceBuffer> Import(int fd, size_t size, int device_id);
+
+  ~IpcDeviceBuffer();
+
+  /**
+   * @brief Returns a new file descriptor of the buffer, which must be closed by the caller
+   */
+  int Export() const;
+
+  void *data() const noexcept { return reinterpret_cast<void *>(va_.ptr()); }
+  size_t size() const noexcept { return mem_.size(); }
+  int device_id() const noexcept { return device_id_; }
+
+ private:
+  IpcDeviceBuffer(mm::cuvm::CUMem mem, int device_id);
+
+  mm::cuvm::CUMem mem_;
+  mm::cuvm::CUMemAddressRange va_;
+  int device_id_;
+};
+
+/**
+ * @brief A CUDA event which can be waited for in other processes
+ *
+ * The producer creates the event and passes its handle to the consumers, which open it.
+ * The event is recorded by the producer after the work writing a buffer and the consumers
+ * make their streams wait for it.
+ */
+class DLL_PUBLIC IpcEvent {
+ public:
+  static IpcEvent Create(int device_id);
+  static IpcEvent Open(const cudaIpcEventHandle_t &handle, int device_id);
+
+  const cudaIpcEventHandle_t &handle() const noexcept { return handle_; }
+  int device_id() const noexcept { return device_id_; }
+
+  void Record(cudaStream_t stream);
+  void Wait(cudaStream_t stream);
+  /** Blocks the calling thread until the work preceding the last Record is complete. */
+  void Synchronize();
+
+ private:
+  CUDAEvent event_;
+  cudaIpcEventHandle_t handle_{};
+  int device_id_ = -1;
+};
+
+/**
+ * @brief Returns the number of bytes occupied by the samples of the batch, stored densely
+ */
+DLL_PUBLIC size_t IpcBatchBytes(const TensorList<GPUBackend> &batch);
+
+/**
+ * @brief Copies the samples of the batch densely to the buffer, starting at `offset`
+ *
+ * The copy is issued on `stream`, after the work pending on the batch.
+ */
+DLL_PUBLIC void CopyToIpcBuffer(IpcDeviceBuffer &buffer, size_t offset,
+                                const TensorList<GPUBackend> &batch, cudaStream_t stream);
+
+/**
+ * @brief Makes the batch a view of the samples stored densely in the buffer at `offset`
+ *
+ * The batch keeps the buffer alive. The data is considered ready for `stream`.
+ */
+DLL_PUBLIC void ShareIpcBuffer(TensorList<GPUBackend> &batch,
+                               const std::shared_ptr<IpcDeviceBuffer> &buffer, size_t offset,
+                               const TensorListShape<> &shape, DALIDataType type,
+                               const TensorLayout &layout, cudaStream_t stream);
+
+}  // namespace dali
+
+#endif  // DALI_USE_CUDA_VM_MAP
+
+#endif  // DALI_PIPELINE_DATA_IPC_BUFFER_H_
@@ -0,0 +1,85 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/data/ipc_buffer.h"
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <numeric>
+#include <vector>
+#include "dali/core/cuda_stream.h"
+
+#if DALI_USE_CUDA_VM_MAP
+
+namespace dali {
+namespace test {
+
+TEST(IpcDeviceBuffer, ExportImportBatch) {
+  if (!mm::cuvm::IsSupported())
+    GTEST_SKIP() << "CUDA Virtual Memory API not supported on this machine";
+  int device_id = 0;
+  CUDA_CALL(cudaGetDevice(&device_id));
+  CUDAStream stream = CUDAStream::Create(true);
+
+  TensorListShape<> shape = {{3, 5}, {2, 7}, {0, 4}, {4, 1}};
+  TensorList<CPUBackend> cpu;
+  cpu.Resize(shape, DALI_INT32);
+  int value = 0;
+  for (int i = 0; i < shape.num_samples(); i++) {
+    int *data = cpu.mutable_tensor<int>(i);
+    std::iota(data, data + shape.tensor_size(i), value);
+    value += shape.tensor_size(i);
+  }
+  // non-contiguous on the GPU
+  TensorList<GPUBackend> gpu;
+  gpu.set_order(stream.get());
+  gpu.SetContiguity(BatchContiguity::Noncontiguous);
+  gpu.Copy(cpu, stream.get());
+
+  auto exported = IpcDeviceBuffer::Create(1000, device_id);
+  EXPECT_GE(exported->size(), 1000u);
+  size_t offset = 256;
+  ASSERT_EQ(IpcBatchBytes(gpu), value * sizeof(int));
+  CopyToIpcBuffer(*exported, offset, gpu, stream);
+  IpcEvent event = IpcEvent::Create(device_id);
+  event.Record(stream);
+
+  int fd = exported->Export();
+  ASSERT_GE(fd, 0);
+  auto imported = IpcDeviceBuffer::Import(fd, exported->size(), device_id);
+  close(fd);
+  EXPECT_NE(imported->data(), exported->data());
+
+  TensorList<GPUBackend> view;
+  event.Wait(stream);
+  ShareIpcBuffer(view, imported, offset, shape, DALI_INT32, "HW", stream);
+  EXPECT_EQ(view.shape(), shape);
+  EXPECT_EQ(view.GetLayout(), "HW");
+  TensorList<CPUBackend> out;
+  out.Copy(view, stream.get());
+  CUDA_CALL(cudaStreamSynchronize(stream));
+  for (int i = 0; i < shape.num_samples(); i++) {
+    for (int64_t j = 0; j < shape.tensor_size(i); j++)
+      EXPECT_EQ(out.tensor<int>(i)[j], cpu.tensor<int>(i)[j]) << "sample " << i << " at " << j;
+  }
+
+  // the view keeps the imported buffer alive
+  imported.reset();
+  exported.reset();
+  EXPECT_EQ(view.shape(), shape);
+}
+
+}  // namespace test
+}  // namespace dali
+
+#endif  // DALI_USE_CUDA_VM_MAP
@@ -16,10 +16,25 @@
 #define DALI_PIPELINE_DATA_META_H_
 
 #include <string>
+#include "dali/core/tensor_shape.h"
 #include "dali/pipeline/data/types.h"
 
 namespace dali {
 
+/**
+ * @brief The properties of an encoded image, parsed before it's decoded (e.g. by the reader)
+ *
+ * The fields correspond to imgcodec::ImageInfo.
+ */
+struct EncodedImageInfo {
+  /// @brief The shape of the image (HWC), as stored in the file; empty if not parsed
+  TensorShape<> shape;
+  /// @brief EXIF orientation - the rotation angle, CCW, in degrees
+  int rotate = 0;
+  /// @brief EXIF orientation - horizontal and vertical mirroring
+  bool flip_x = false, flip_y = false;
+};
+
 class DALIMeta {
  public:
   DALIMeta() = default;
@@ -43,6 +58,19 @@ class DALIMeta {
     source_info_ = source_info;
   }
 
+  /**
+   * @brief The key of the sample in the caches (e.g. the decoder cache)
+   *
+   * The source info, unless a content-based key was set by the reader (`content_hash`).
+   */
+  inline const std::string &GetCacheKey() const {
+    return cache_key_.empty() ? source_info_ : cache_key_;
+  }
+
+  inline void SetCacheKey(const std::string &cache_key) {
+    cache_key_ = cache_key;
+  }
+
   inline void SetSkipSample(bool skip_sample) {
     skip_sample_ = skip_sample;
   }
@@ -51,10 +79,24 @@ class DALIMeta {
     return skip_sample_;
   }
 
+  inline bool HasImageInfo() const {
+    return image_info_.shape.sample_dim() > 0;
+  }
+
+  inline const EncodedImageInfo &GetImageInfo() const {
+    return image_info_;
+  }
+
+  inline void SetImageInfo(const EncodedImageInfo &image_info) {
+    image_info_ = image_info;
+  }
+
  private:
   TensorLayout layout_;
   std::string source_info_;
+  std::string cache_key_;
   bool skip_sample_ = false;
+  EncodedImageInfo image_info_;
 };
 
 }  // namespace dali
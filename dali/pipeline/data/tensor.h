@@ -116,7 +116,9 @@ class Tensor : public Buffer<Backend> {
     order.wait(order_);
     this->SetLayout(other.GetLayout());
     this->SetSourceInfo(other.GetSourceInfo());
+    this->SetCacheKey(other.GetMeta().GetCacheKey());
     this->SetSkipSample(other.ShouldSkipSample());
+    this->SetImageInfo(other.GetImageInfo());
     type_.template Copy<Backend, InBackend>(this->raw_mutable_data(),
         other.raw_data(), this->size(), order.stream());
     order_.wait(order);
@@ -232,8 +234,11 @@ class Tensor : public Buffer<Backend> {
     if (order)
       this->set_order(order);
 
-    // Save our new pointer and bytes. Reset our type, shape, and size
-    type_ = TypeTable::GetTypeInfo(type);
+    // Save our new pointer and bytes. Reset our type, shape, and size.
+    // The type lookup is skipped when the type doesn't change - the views of the samples
+    // of a contiguous batch are recreated this way for every batch.
+    if (type_.id() != type)
+      type_ = TypeTable::GetTypeInfo(type);
     data_ = ptr;
     size_ = new_size;
     num_bytes_ = bytes;
@@ -433,6 +438,10 @@ class Tensor : public Buffer<Backend> {
     meta_.SetSourceInfo(source_info);
   }
 
+  inline void SetCacheKey(const string &cache_key) {
+    meta_.SetCacheKey(cache_key);
+  }
+
   inline void SetSkipSample(bool skip_sample) {
     meta_.SetSkipSample(skip_sample);
   }
@@ -441,6 +450,14 @@ class Tensor : public Buffer<Backend> {
     return meta_.ShouldSkipSample();
   }
 
+  inline const EncodedImageInfo &GetImageInfo() const {
+    return meta_.GetImageInfo();
+  }
+
+  inline void SetImageInfo(const EncodedImageInfo &image_info) {
+    meta_.SetImageInfo(image_info);
+  }
+
  protected:
   TensorShape<> shape_ = { 0 };
   DALIMeta meta_;
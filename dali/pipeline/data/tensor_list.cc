@@ -734,15 +734,17 @@ void TensorList<Backend>::recreate_views() {
   // precondition: type, shape are configured
   uint8_t *sample_ptr = static_cast<uint8_t *>(contiguous_buffer_.raw_mutable_data());
   int64_t num_samples = shape().num_samples();
+  auto buffer_owner = contiguous_buffer_.get_data_ptr();
+  size_t type_size = type_info().size();
   for (int64_t i = 0; i < num_samples; i++) {
     // or any other way
     auto tensor_size = shape().tensor_size(i);
 
-    std::shared_ptr<void> sample_alias(contiguous_buffer_.get_data_ptr(), sample_ptr);
-    tensors_[i].ShareData(sample_alias, tensor_size * type_info().size(), is_pinned(), shape()[i],
-                          type(), device_id(), order());
+    std::shared_ptr<void> sample_alias(buffer_owner, sample_ptr);
+    tensors_[i].ShareData(sample_alias, tensor_size * type_size, is_pinned(),
+                          shape_[i], type(), device_id(), order());
     tensors_[i].SetLayout(GetLayout());
-    sample_ptr += tensor_size * type_info().size();
+    sample_ptr += tensor_size * type_size;
   }
 }
 
@@ -797,6 +799,20 @@ void TensorList<Backend>::DoMakeNoncontiguous() {
 }
 
 
+template <typename Backend>
+void TensorList<Backend>::release_data(int keep_tensors) {
+  contiguous_buffer_.reset();
+  buffer_bkp_.reset();
+  // The sample Tensors in range are about to be overwritten - keeping them avoids destroying
+  // and recreating the per-sample objects (with their metadata) for every shared batch.
+  // The remaining ones must not keep the old data alive.
+  for (size_t i = keep_tensors; i < tensors_.size(); i++) {
+    if (tensors_[i].has_data())
+      tensors_[i].Reset();
+  }
+}
+
+
 template <typename Backend>
 void TensorList<Backend>::Reset() {
   contiguous_buffer_.reset();
@@ -865,7 +881,7 @@ void TensorList<Backend>::ShareData(const TensorList<Backend> &tl) {
 
   // if the data is the same, there's no point in resetting the buffer (and possibly synchronizing)
   if (!same_data)
-    Reset();
+    release_data(tl.num_samples());
 
   buffer_bkp_.reset();  // TODO(michalz): perhaps we should copy it from the source, too?
 
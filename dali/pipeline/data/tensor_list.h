@@ -664,6 +664,15 @@ class DLL_PUBLIC TensorList {
    */
   void DoMakeNoncontiguous();
 
+  /**
+   * @brief Releases the data of the batch before sharing another one, keeping the sample
+   * Tensor objects for reuse.
+   *
+   * @param keep_tensors the number of the sample Tensors which are going to be overwritten;
+   * the remaining ones are reset, so that they don't keep the old data alive.
+   */
+  void release_data(int keep_tensors);
+
   /**
    * @brief After RunImpl(SampleWorkspace&) operated on individual samples without propagating
    * the allocation metadata back to the the batch structure, take that metadata from the samples
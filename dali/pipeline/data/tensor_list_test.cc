@@ -1624,6 +1624,42 @@ TYPED_TEST(TensorListSuite, EmptyShareNonContiguous) {
   }
 }
 
+TYPED_TEST(TensorListSuite, ShareDataRepeatedly) {
+  TensorList<TypeParam> contiguous, noncontiguous;
+  contiguous.SetContiguity(BatchContiguity::Contiguous);
+  noncontiguous.SetContiguity(BatchContiguity::Noncontiguous);
+  contiguous.Resize(uniform_list_shape(5, {10, 3}), DALI_FLOAT);
+  noncontiguous.Resize(uniform_list_shape(3, {7}), DALI_INT16);
+  auto owner_use_count = [&]() {
+    return unsafe_owner(contiguous).use_count() - 1;  // not counting the returned pointer
+  };
+  auto use_count = owner_use_count();
+
+  TensorList<TypeParam> target;
+  for (int iter = 0; iter < 2; iter++) {
+    target.ShareData(contiguous);
+    ASSERT_TRUE(target.IsContiguous());
+    ASSERT_EQ(target.type(), DALI_FLOAT);
+    ASSERT_EQ(target.shape(), contiguous.shape());
+    for (int i = 0; i < contiguous.num_samples(); i++) {
+      ASSERT_EQ(target.raw_tensor(i), contiguous.raw_tensor(i));
+      ASSERT_EQ(target.tensor_shape(i), contiguous.tensor_shape(i));
+    }
+    ASSERT_GT(owner_use_count(), use_count);
+
+    target.ShareData(noncontiguous);
+    ASSERT_FALSE(target.IsContiguous());
+    ASSERT_EQ(target.type(), DALI_INT16);
+    ASSERT_EQ(target.shape(), noncontiguous.shape());
+    for (int i = 0; i < noncontiguous.num_samples(); i++) {
+      ASSERT_EQ(target.raw_tensor(i), noncontiguous.raw_tensor(i));
+      ASSERT_EQ(target.tensor_shape(i), noncontiguous.tensor_shape(i));
+    }
+    // the samples which are no longer in the batch must not keep the previous data alive
+    ASSERT_EQ(owner_use_count(), use_count);
+  }
+}
+
 template <typename Backend, typename F>
 void test_moving_props(const bool is_pinned, const TensorLayout layout,
                        const TensorListShape<> shape, const int sample_dim, const DALIDataType type,
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -44,17 +44,39 @@ ScatterGatherPool& ScatterGatherPoolInstance() {
   return scatter_gather_pool_;
 }
 
+/**
+ * @brief Batched copies use the scatter-gather kernel when requested or when both sides are
+ *        in the device memory - with a copy per sample, batches of many small samples are
+ *        launch-bound. In the latter case the method is Default, so that a couple of (coalesced)
+ *        ranges still go through cudaMemcpyAsync.
+ */
+template <typename DstBackend, typename SrcBackend>
+bool UseBatchedCopyKernel(bool use_copy_kernel, kernels::ScatterGatherGPU::Method &method) {
+  constexpr bool is_host_to_host = std::is_same<DstBackend, CPUBackend>::value &&
+                                   std::is_same<SrcBackend, CPUBackend>::value;
+  constexpr bool is_device_to_device = std::is_same<DstBackend, GPUBackend>::value &&
+                                       std::is_same<SrcBackend, GPUBackend>::value;
+  if (is_host_to_host)
+    return false;
+  if (use_copy_kernel) {
+    method = kernels::ScatterGatherGPU::Method::Kernel;
+    return true;
+  }
+  method = kernels::ScatterGatherGPU::Method::Default;
+  return is_device_to_device;
+}
+
 void ScatterGatherCopy(void **dsts, const void **srcs, const Index *sizes, int n, int element_size,
-                       cudaStream_t stream) {
+                       cudaStream_t stream, kernels::ScatterGatherGPU::Method method) {
   auto sc = ScatterGatherPoolInstance().Get(stream, kMaxSizePerBlock);
   for (int i = 0; i < n; i++) {
     sc->AddCopy(dsts[i], srcs[i], sizes[i] * element_size);
   }
-  sc->Run(stream, true, kernels::ScatterGatherGPU::Method::Kernel);
+  sc->Run(stream, true, method);
 }
 
 void ScatterGatherCopy(void *dst, const void **srcs, const Index *sizes, int n, int element_size,
-                       cudaStream_t stream) {
+                       cudaStream_t stream, kernels::ScatterGatherGPU::Method method) {
   auto sc = ScatterGatherPoolInstance().Get(stream, kMaxSizePerBlock);
   auto *sample_dst = reinterpret_cast<uint8_t*>(dst);
   for (int i = 0; i < n; i++) {
@@ -62,11 +84,11 @@ void ScatterGatherCopy(void *dst, const void **srcs, const Index *sizes, int n,
     sc->AddCopy(sample_dst, srcs[i], nbytes);
     sample_dst += nbytes;
   }
-  sc->Run(stream, true, kernels::ScatterGatherGPU::Method::Kernel);
+  sc->Run(stream, true, method);
 }
 
 void ScatterGatherCopy(void **dsts, const void *src, const Index *sizes, int n, int element_size,
-                       cudaStream_t stream) {
+                       cudaStream_t stream, kernels::ScatterGatherGPU::Method method) {
   auto sc = ScatterGatherPoolInstance().Get(stream, kMaxSizePerBlock);
   auto *sample_src = reinterpret_cast<const uint8_t*>(src);
   for (int i = 0; i < n; i++) {
@@ -74,7 +96,7 @@ void ScatterGatherCopy(void **dsts, const void *src, const Index *sizes, int n,
     sc->AddCopy(dsts[i], sample_src, nbytes);
     sample_src += nbytes;
   }
-  sc->Run(stream, true, kernels::ScatterGatherGPU::Method::Kernel);
+  sc->Run(stream, true, method);
 }
 
 }  // namespace detail
@@ -117,10 +139,9 @@ template void TypeInfo::Copy<GPUBackend, GPUBackend>(void *dst,
 template <typename DstBackend, typename SrcBackend>
 void TypeInfo::Copy(void **dsts, const void** srcs, const Index* sizes, int n,
                     cudaStream_t stream, bool use_copy_kernel) const {
-  constexpr bool is_host_to_host = std::is_same<DstBackend, CPUBackend>::value &&
-                                   std::is_same<SrcBackend, CPUBackend>::value;
-  if (!is_host_to_host && use_copy_kernel) {
-    detail::ScatterGatherCopy(dsts, srcs, sizes, n, size(), stream);
+  kernels::ScatterGatherGPU::Method method;
+  if (detail::UseBatchedCopyKernel<DstBackend, SrcBackend>(use_copy_kernel, method)) {
+    detail::ScatterGatherCopy(dsts, srcs, sizes, n, size(), stream, method);
   } else {
     for (int i = 0; i < n; i++) {
       Copy<DstBackend, SrcBackend>(dsts[i], srcs[i], sizes[i], stream);
@@ -144,10 +165,9 @@ template void TypeInfo::Copy<GPUBackend, GPUBackend>(void **dsts,
 template <typename DstBackend, typename SrcBackend>
 void TypeInfo::Copy(void *dst, const void** srcs, const Index* sizes, int n,
                     cudaStream_t stream, bool use_copy_kernel) const {
-  constexpr bool is_host_to_host = std::is_same<DstBackend, CPUBackend>::value &&
-                                   std::is_same<SrcBackend, CPUBackend>::value;
-  if (!is_host_to_host && use_copy_kernel) {
-    detail::ScatterGatherCopy(dst, srcs, sizes, n, size(), stream);
+  kernels::ScatterGatherGPU::Method method;
+  if (detail::UseBatchedCopyKernel<DstBackend, SrcBackend>(use_copy_kernel, method)) {
+    detail::ScatterGatherCopy(dst, srcs, sizes, n, size(), stream, method);
   } else {
     auto sample_dst = static_cast<uint8_t*>(dst);
     for (int i = 0; i < n; i++) {
@@ -174,10 +194,9 @@ template void TypeInfo::Copy<GPUBackend, GPUBackend>(void *dst,
 template <typename DstBackend, typename SrcBackend>
 void TypeInfo::Copy(void **dsts, const void* src, const Index* sizes, int n,
                     cudaStream_t stream, bool use_copy_kernel) const {
-  constexpr bool is_host_to_host = std::is_same<DstBackend, CPUBackend>::value &&
-                                   std::is_same<SrcBackend, CPUBackend>::value;
-  if (!is_host_to_host && use_copy_kernel) {
-    detail::ScatterGatherCopy(dsts, src, sizes, n, size(), stream);
+  kernels::ScatterGatherGPU::Method method;
+  if (detail::UseBatchedCopyKernel<DstBackend, SrcBackend>(use_copy_kernel, method)) {
+    detail::ScatterGatherCopy(dsts, src, sizes, n, size(), stream, method);
   } else {
     auto sample_src = reinterpret_cast<const uint8_t*>(src);
     for (int i = 0; i < n; i++) {
@@ -27,6 +27,7 @@
 #include <vector>
 #include "dali/core/common.h"
 #include "dali/core/spinlock.h"
+#include "dali/core/bfloat16.h"
 #include "dali/core/float16.h"
 #include "dali/core/cuda_utils.h"
 #include "dali/core/error_handling.h"
@@ -124,6 +125,7 @@ enum DALIDataType : int {
   DALI_PYTHON_OBJECT     = 24,
   DALI_TENSOR_LAYOUT_VEC = 25,
   DALI_DATA_TYPE_VEC     = 26,
+  DALI_BFLOAT16          = 27,
   DALI_DATATYPE_END      = 1000
 };
 
@@ -159,6 +161,9 @@ inline const char *GetBuiltinTypeName(DALIDataType t) {
     case DALI_FLOAT16:
       return "float16";
       break;
+    case DALI_BFLOAT16:
+      return "bfloat16";
+      break;
     case DALI_FLOAT:
       return "float";
       break;
@@ -225,6 +230,7 @@ inline std::ostream &operator<<(std::ostream &, DALIDataType dtype);
 constexpr bool IsFloatingPoint(DALIDataType type) {
   switch (type) {
     case DALI_FLOAT16:
+    case DALI_BFLOAT16:
     case DALI_FLOAT:
     case DALI_FLOAT64:
       return true;
@@ -253,6 +259,7 @@ constexpr bool IsIntegral(DALIDataType type) {
 constexpr bool IsSigned(DALIDataType type) {
   switch (type) {
     case DALI_FLOAT16:
+    case DALI_BFLOAT16:
     case DALI_FLOAT:
     case DALI_FLOAT64:
     case DALI_INT8:
@@ -568,6 +575,7 @@ DALI_REGISTER_TYPE(int16_t,        DALI_INT16);
 DALI_REGISTER_TYPE(int32_t,        DALI_INT32);
 DALI_REGISTER_TYPE(int64_t,        DALI_INT64);
 DALI_REGISTER_TYPE(float16,        DALI_FLOAT16);
+DALI_REGISTER_TYPE(bfloat16,       DALI_BFLOAT16);
 DALI_REGISTER_TYPE(float,          DALI_FLOAT);
 DALI_REGISTER_TYPE(double,         DALI_FLOAT64);
 DALI_REGISTER_TYPE(bool,           DALI_BOOL);
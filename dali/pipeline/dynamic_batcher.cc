@@ -0,0 +1,197 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/pipeline/dynamic_batcher.h"
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include "dali/core/cuda_event_pool.h"
+#include "dali/core/device_guard.h"
+#include "dali/core/format.h"
+#include "dali/core/small_vector.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief Copies the samples [begin, begin + num_samples) of the output to a new batch,
+ *        in `order`.
+ */
+template <typename Backend>
+std::shared_ptr<TensorList<Backend>> CopySamples(const TensorList<Backend> &output, int begin,
+                                                 int num_samples, AccessOrder order) {
+  TensorList<Backend> samples(num_samples);
+  samples.SetupLike(output);
+  for (int i = 0; i < num_samples; i++)
+    samples.SetSample(i, output, begin + i);
+  auto copy = std::make_shared<TensorList<Backend>>();
+  copy->set_pinned(output.is_pinned());
+  copy->set_order(order, false);
+  copy->Copy(samples, order);
+  return copy;
+}
+
+}  // namespace
+
+DynamicBatcher::DynamicBatcher(Pipeline *pipeline, int max_batch_size,
+                               std::chrono::microseconds max_delay)
+    : pipeline_(pipeline),
+      max_batch_size_(max_batch_size > 0 ? max_batch_size : pipeline->max_batch_size()),
+      max_delay_(max_delay) {
+  DALI_ENFORCE(max_batch_size_ <= pipeline->max_batch_size(),
+               make_string("The batch size of the batcher (", max_batch_size_,
+                           ") can't exceed the maximum batch size of the pipeline (",
+                           pipeline->max_batch_size(), ")."));
+  thread_ = std::thread([this]() { Loop(); });
+}
+
+DynamicBatcher::~DynamicBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+std::future<DeviceWorkspace> DynamicBatcher::Submit(Inputs inputs, AccessOrder order) {
+  DALI_ENFORCE(static_cast<int>(inputs.size()) == pipeline_->num_inputs(),
+               make_string("The request must provide all ", pipeline_->num_inputs(),
+                           " inputs of the pipeline, got ", inputs.size(), "."));
+  Request request;
+  request.batch_size = -1;
+  for (int i = 0; i < pipeline_->num_inputs(); i++) {
+    auto it = inputs.find(pipeline_->input_name(i));
+    DALI_ENFORCE(it != inputs.end(),
+                 make_string("The request doesn't provide the input \"",
+                             pipeline_->input_name(i), "\"."));
+    int n = it->second.num_samples();
+    DALI_ENFORCE(request.batch_size < 0 || n == request.batch_size,
+                 "All the inputs of a request must have the same number of samples.");
+    request.batch_size = n;
+  }
+  DALI_ENFORCE(request.batch_size > 0 && request.batch_size <= max_batch_size_,
+               make_string("The number of samples in a request must be between 1 and ",
+                           max_batch_size_, ", got ", request.batch_size, "."));
+  request.inputs = std::move(inputs);
+  request.arrival = std::chrono::steady_clock::now();
+  request.order = order;
+  auto result = request.result.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queued_samples_ += request.batch_size;
+    queue_.push(std::move(request));
+  }
+  cv_.notify_all();
+  return result;
+}
+
+void DynamicBatcher::Loop() {
+  for (;;) {
+    std::vector<Request> requests;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [&]() { return stop_ || !queue_.empty(); });
+      if (queue_.empty())
+        return;
+      // wait for a full batch, but not longer than the oldest request can wait
+      auto deadline = queue_.front().arrival + max_delay_;
+      cv_.wait_until(lock, deadline, [&]() {
+        return stop_ || queued_samples_ >= max_batch_size_;
+      });
+      int batch_size = 0;
+      while (!queue_.empty() && batch_size + queue_.front().batch_size <= max_batch_size_) {
+        batch_size += queue_.front().batch_size;
+        requests.push_back(std::move(queue_.front()));
+        queue_.pop();
+      }
+      queued_samples_ -= batch_size;
+    }
+    try {
+      RunBatch(requests);
+    } catch (...) {
+      for (auto &request : requests)
+        request.result.set_exception(std::current_exception());
+    }
+  }
+}
+
+void DynamicBatcher::RunBatch(std::vector<Request> &requests) {
+  int batch_size = 0;
+  for (auto &request : requests)
+    batch_size += request.batch_size;
+
+  // the samples of the consecutive requests are concatenated - the batches only share them
+  for (int i = 0; i < pipeline_->num_inputs(); i++) {
+    const auto &name = pipeline_->input_name(i);
+    const auto &first = requests[0].inputs[name];
+    TensorList<CPUBackend> batch(batch_size);
+    batch.SetupLike(first);
+    int sample_idx = 0;
+    for (auto &request : requests) {
+      const auto &input = request.inputs[name];
+      DALI_ENFORCE(input.type() == first.type() &&
+                   input.sample_dim() == first.sample_dim() &&
+                   input.GetLayout() == first.GetLayout(),
+                   make_string("The input \"", name, "\" of the requests run together must have "
+                               "the same type, dimensionality and layout."));
+      for (int j = 0; j < request.batch_size; j++)
+        batch.SetSample(sample_idx++, input, j);
+    }
+    pipeline_->SetExternalInput(name, batch, AccessOrder::host(), true);
+  }
+
+  pipeline_->RunCPU();
+  pipeline_->RunGPU();
+  DeviceWorkspace ws;
+  pipeline_->ShareOutputs(&ws);
+  num_batches_++;
+
+  std::vector<DeviceWorkspace> results(requests.size());
+  SmallVector<AccessOrder, 4> copy_orders;
+  for (int out_idx = 0; out_idx < ws.NumOutput(); out_idx++) {
+    int begin = 0;
+    for (size_t r = 0; r < requests.size(); r++) {
+      if (ws.OutputIsType<CPUBackend>(out_idx)) {
+        const auto &output = ws.Output<CPUBackend>(out_idx);
+        results[r].AddOutput(CopySamples(output, begin, requests[r].batch_size, output.order()));
+      } else {
+        const auto &output = ws.Output<GPUBackend>(out_idx);
+        auto order = requests[r].order ? requests[r].order : output.order();
+        results[r].AddOutput(CopySamples(output, begin, requests[r].batch_size, order));
+        if (std::find(copy_orders.begin(), copy_orders.end(), order) == copy_orders.end())
+          copy_orders.push_back(order);
+      }
+      begin += requests[r].batch_size;
+    }
+  }
+  // the copies must be complete before the outputs are reused and returned; an event is
+  // awaited rather than the stream, which can also run the other work of the client
+  for (auto &order : copy_orders) {
+    DeviceGuard dg(order.device_id());
+    auto &pool = CUDAEventPool::instance();
+    auto event = pool.Get(order.device_id());
+    CUDA_CALL(cudaEventRecord(event, order.stream()));
+    CUDA_CALL(cudaEventSynchronize(event));
+    pool.Put(std::move(event), order.device_id());
+  }
+  pipeline_->ReleaseOutputs();
+
+  for (size_t r = 0; r < requests.size(); r++)
+    requests[r].result.set_value(std::move(results[r]));
+}
+
+}  // namespace dali
@@ -0,0 +1,109 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_PIPELINE_DYNAMIC_BATCHER_H_
+#define DALI_PIPELINE_DYNAMIC_BATCHER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dali/pipeline/pipeline.h"
+
+namespace dali {
+
+/**
+ * @brief Runs the requests submitted concurrently (e.g. by an inference server) in batches
+ *        of the pipeline.
+ *
+ * The requests waiting for the pipeline are coalesced into one batch of up to
+ * `max_batch_size` samples. The batch is run as soon as it's full or when the oldest request
+ * waited for `max_delay` - so that the small requests raise the utilization without adding
+ * more than `max_delay` to their latency. The outputs of the batch are split back into
+ * the outputs of the requests.
+ *
+ * The batcher takes over running the pipeline, which must be built and must not be run
+ * by anyone else while the batcher exists.
+ */
+class DLL_PUBLIC DynamicBatcher {
+ public:
+  /// The batches for the external inputs of the pipeline, by their names
+  using Inputs = std::map<std::string, TensorList<CPUBackend>>;
+
+  /**
+   * @param pipeline        the pipeline to run; all its inputs must be external sources
+   * @param max_batch_size  the largest number of samples run together; if not positive,
+   *                        the maximum batch size of the pipeline
+   * @param max_delay       how long the oldest request can wait for the others
+   */
+  DynamicBatcher(Pipeline *pipeline, int max_batch_size, std::chrono::microseconds max_delay);
+
+  ~DynamicBatcher();
+
+  DynamicBatcher(const DynamicBatcher &) = delete;
+  DynamicBatcher &operator=(const DynamicBatcher &) = delete;
+
+  /**
+   * @brief Queues a request for the pipeline.
+   *
+   * All the inputs must be provided, with the same number of samples (at most the maximum
+   * batch size). The result holds the outputs of the pipeline for the samples of the request,
+   * in their own buffers; if the batch fails, it holds the error.
+   *
+   * The GPU outputs are copied in `order` (e.g. the stream of the client), if set, and
+   * associated with it - otherwise in the order of the outputs of the pipeline.
+   */
+  std::future<DeviceWorkspace> Submit(Inputs inputs, AccessOrder order = {});
+
+  /// The number of batches run so far
+  int64_t num_batches() const {
+    return num_batches_;
+  }
+
+ private:
+  struct Request {
+    Inputs inputs;
+    int batch_size = 0;
+    std::chrono::steady_clock::time_point arrival;
+    AccessOrder order;
+    std::promise<DeviceWorkspace> result;
+  };
+
+  void Loop();
+  void RunBatch(std::vector<Request> &requests);
+
+  Pipeline *pipeline_;
+  int max_batch_size_;
+  std::chrono::microseconds max_delay_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::queue<Request> queue_;
+  int queued_samples_ = 0;
+  bool stop_ = false;
+  std::atomic<int64_t> num_batches_{0};
+  std::thread thread_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_DYNAMIC_BATCHER_H_
@@ -0,0 +1,101 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "dali/pipeline/dynamic_batcher.h"
+
+namespace dali {
+
+namespace {
+
+std::unique_ptr<Pipeline> GetCopyPipeline(int max_batch_size) {
+  auto pipe = std::make_unique<Pipeline>(max_batch_size, 2, CPU_ONLY_DEVICE_ID);
+  pipe->AddExternalInput("data");
+  pipe->AddOperator(OpSpec("Copy")
+                        .AddArg("device", "cpu")
+                        .AddInput("data", "cpu")
+                        .AddOutput("out", "cpu"));
+  pipe->Build({{"out", "cpu"}});
+  return pipe;
+}
+
+DynamicBatcher::Inputs GetRequest(int num_samples, int value) {
+  TensorList<CPUBackend> data;
+  data.Resize(uniform_list_shape(num_samples, {value + 1}), DALI_INT32);
+  for (int i = 0; i < num_samples; i++)
+    for (int j = 0; j <= value; j++)
+      data.mutable_tensor<int>(i)[j] = value * 100 + i;
+  DynamicBatcher::Inputs inputs;
+  inputs["data"] = std::move(data);
+  return inputs;
+}
+
+void CheckResult(const DeviceWorkspace &ws, int num_samples, int value) {
+  ASSERT_EQ(ws.NumOutput(), 1);
+  const auto &out = ws.Output<CPUBackend>(0);
+  ASSERT_EQ(out.num_samples(), num_samples);
+  for (int i = 0; i < num_samples; i++) {
+    ASSERT_EQ(out.tensor_shape(i), TensorShape<>(value + 1));
+    for (int j = 0; j <= value; j++)
+      EXPECT_EQ(out.tensor<int>(i)[j], value * 100 + i);
+  }
+}
+
+}  // namespace
+
+TEST(DynamicBatcherTest, CoalesceRequests) {
+  auto pipe = GetCopyPipeline(8);
+  DynamicBatcher batcher(pipe.get(), 6, std::chrono::seconds(10));
+  std::vector<std::future<DeviceWorkspace>> results;
+  // the requests fill the batch, so they don't wait for the deadline
+  for (int r = 0; r < 3; r++)
+    results.push_back(batcher.Submit(GetRequest(r + 1, r)));
+  for (int r = 0; r < 3; r++)
+    CheckResult(results[r].get(), r + 1, r);
+  EXPECT_EQ(batcher.num_batches(), 1);
+}
+
+TEST(DynamicBatcherTest, Deadline) {
+  auto pipe = GetCopyPipeline(8);
+  DynamicBatcher batcher(pipe.get(), 8, std::chrono::milliseconds(10));
+  auto result = batcher.Submit(GetRequest(2, 3));
+  CheckResult(result.get(), 2, 3);
+  EXPECT_EQ(batcher.num_batches(), 1);
+  // the requests above the batch size go to the next batch
+  auto result1 = batcher.Submit(GetRequest(5, 1));
+  auto result2 = batcher.Submit(GetRequest(5, 2));
+  CheckResult(result1.get(), 5, 1);
+  CheckResult(result2.get(), 5, 2);
+  EXPECT_EQ(batcher.num_batches(), 3);
+}
+
+TEST(DynamicBatcherTest, InvalidRequests) {
+  auto pipe = GetCopyPipeline(4);
+  DynamicBatcher batcher(pipe.get(), 0, std::chrono::milliseconds(1));
+  EXPECT_THROW(batcher.Submit(GetRequest(5, 0)), std::exception);
+  auto inputs = GetRequest(1, 0);
+  inputs["other"] = std::move(GetRequest(1, 0)["data"]);
+  EXPECT_THROW(batcher.Submit(std::move(inputs)), std::exception);
+  DynamicBatcher::Inputs wrong_name;
+  wrong_name["other"] = std::move(GetRequest(1, 0)["data"]);
+  EXPECT_THROW(batcher.Submit(std::move(wrong_name)), std::exception);
+}
+
+}  // namespace dali
@@ -35,10 +35,11 @@ class DLL_PUBLIC AsyncSeparatedPipelinedExecutor : public SeparatedPipelinedExec
   DLL_PUBLIC inline AsyncSeparatedPipelinedExecutor(
       int batch_size, int num_thread, int device_id, size_t bytes_per_sample_hint,
       bool set_affinity = false, int max_num_stream = -1, int default_cuda_stream_priority = 0,
-      QueueSizes prefetch_queue_depth = QueueSizes{2, 2})
+      QueueSizes prefetch_queue_depth = QueueSizes{2, 2},
+      ThreadPoolType thread_pool_type = ThreadPoolType::SharedQueue)
       : SeparatedPipelinedExecutor(batch_size, num_thread, device_id, bytes_per_sample_hint,
                                    set_affinity, max_num_stream, default_cuda_stream_priority,
-                                   prefetch_queue_depth),
+                                   prefetch_queue_depth, thread_pool_type),
         cpu_thread_(device_id, set_affinity, "CPU executor"),
         mixed_thread_(device_id, set_affinity, "Mixed executor"),
         gpu_thread_(device_id, set_affinity, "GPU executor") {}
@@ -0,0 +1,198 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/executor/bottleneck_analyzer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+namespace dali {
+
+const char *to_string(Bottleneck bottleneck) {
+  switch (bottleneck) {
+    case Bottleneck::Consumer:
+      return "consumer";
+    case Bottleneck::IO:
+      return "io";
+    case Bottleneck::CPU:
+      return "cpu";
+    case Bottleneck::Mixed:
+      return "mixed";
+    case Bottleneck::GPU:
+      return "gpu";
+    default:
+      return "unknown";
+  }
+}
+
+namespace {
+
+bool StageFromName(const std::string &name, OpType &stage) {
+  auto has_prefix = [&](const char *prefix) {
+    return name.compare(0, strlen(prefix), prefix) == 0;
+  };
+  if (has_prefix("CPU_"))
+    stage = OpType::CPU;
+  else if (has_prefix("MIXED_"))
+    stage = OpType::MIXED;
+  else if (has_prefix("GPU_"))
+    stage = OpType::GPU;
+  else
+    return false;
+  return true;
+}
+
+int64_t Delta(const TimeHistogram &curr, const TimeHistogram *prev) {
+  return prev ? curr.total_ns - prev->total_ns : curr.total_ns;
+}
+
+}  // namespace
+
+void BottleneckAnalyzer::SetReaders(std::unordered_set<std::string> readers) {
+  std::lock_guard<std::mutex> lck(mutex_);
+  readers_ = std::move(readers);
+}
+
+void BottleneckAnalyzer::AddConsumerSample(int ready_outputs, int64_t wait_ns) {
+  std::lock_guard<std::mutex> lck(mutex_);
+  consumer_wait_ns_ += std::max<int64_t>(wait_ns, 0);
+  ready_outputs_sum_ += ready_outputs;
+  consumer_samples_++;
+}
+
+bool BottleneckAnalyzer::UpdateDue(int64_t now_ns) const {
+  std::lock_guard<std::mutex> lck(mutex_);
+  return prev_update_ns_ < 0 || now_ns - prev_update_ns_ >= interval_ns_;
+}
+
+void BottleneckAnalyzer::Update(const ExecutorTimingStats &stats, int64_t now_ns) {
+  std::lock_guard<std::mutex> lck(mutex_);
+  if (prev_update_ns_ < 0 || now_ns <= prev_update_ns_) {
+    // the first update only sets the beginning of the window
+    prev_stats_ = stats;
+    prev_update_ns_ = now_ns;
+    consumer_wait_ns_ = consumer_samples_ = ready_outputs_sum_ = 0;
+    return;
+  }
+
+  constexpr int kNumStages = static_cast<int>(OpType::COUNT);
+  BottleneckReport report;
+  double window_ns = now_ns - prev_update_ns_;
+  report.window_s = window_ns * 1e-9;
+  report.consumer_wait_fraction = consumer_wait_ns_ / window_ns;
+  if (consumer_samples_)
+    report.ready_outputs = static_cast<double>(ready_outputs_sum_) / consumer_samples_;
+
+  std::array<int64_t, kNumStages> run_ns = {}, wait_ns = {};
+  for (int s = 0; s < kNumStages; s++) {
+    const auto &curr = stats.stages[s];
+    const auto &prev = prev_stats_.stages[s];
+    run_ns[s] = curr.run_time.total_ns - prev.run_time.total_ns;
+    wait_ns[s] = curr.queue_wait.total_ns - prev.queue_wait.total_ns;
+    report.iterations = std::max(report.iterations, curr.run_time.count - prev.run_time.count);
+    report.stage_wait_fraction[s] = wait_ns[s] / window_ns;
+  }
+  const auto &cpu_curr = stats.stages[static_cast<int>(OpType::CPU)];
+  const auto &cpu_prev = prev_stats_.stages[static_cast<int>(OpType::CPU)];
+  int64_t capacity = cpu_curr.thread_pool_capacity_ns - cpu_prev.thread_pool_capacity_ns;
+  if (capacity > 0)
+    report.thread_pool_utilization =
+        static_cast<double>(cpu_curr.thread_pool_busy_ns - cpu_prev.thread_pool_busy_ns) /
+        capacity;
+
+  // The time of the operators in this window
+  std::vector<std::pair<int64_t, OperatorBottleneckInfo>> op_times;
+  std::array<int64_t, kNumStages> op_total_ns = {}, gpu_total_ns = {};
+  int64_t reader_ns = 0;
+  for (const auto &entry : stats.operators) {
+    OperatorBottleneckInfo info;
+    info.name = entry.first;
+    if (!StageFromName(info.name, info.stage))
+      continue;
+    auto prev_it = prev_stats_.operators.find(entry.first);
+    const OperatorTimingStats *prev =
+        prev_it != prev_stats_.operators.end() ? &prev_it->second : nullptr;
+    int64_t host_ns = Delta(entry.second.host_time, prev ? &prev->host_time : nullptr);
+    int64_t gpu_ns = Delta(entry.second.gpu_time, prev ? &prev->gpu_time : nullptr);
+    int64_t op_ns = std::max(host_ns, gpu_ns);
+    if (op_ns <= 0)
+      continue;
+    int s = static_cast<int>(info.stage);
+    op_total_ns[s] += op_ns;
+    gpu_total_ns[s] += gpu_ns;
+    if (readers_.count(info.name))
+      reader_ns += op_ns;
+    op_times.emplace_back(op_ns, std::move(info));
+  }
+  int cpu = static_cast<int>(OpType::CPU);
+  if (op_total_ns[cpu] > 0)
+    report.io_fraction = static_cast<double>(reader_ns) / op_total_ns[cpu];
+
+  if (report.iterations > 0) {
+    for (int s = 0; s < kNumStages; s++) {
+      // The host only issues the work of the GPU operators, which can take longer on the device
+      report.stage_time_s[s] = std::max(run_ns[s], gpu_total_ns[s]) * 1e-9 / report.iterations;
+    }
+
+    int slowest = cpu;
+    for (auto stage : {OpType::MIXED, OpType::GPU}) {
+      int s = static_cast<int>(stage);
+      if (report.stage_time_s[s] > report.stage_time_s[slowest])
+        slowest = s;
+    }
+    if (consumer_samples_ > 0 && report.consumer_wait_fraction < kConsumerWaitThreshold) {
+      report.verdict = Bottleneck::Consumer;
+    } else if (slowest == cpu) {
+      report.verdict = report.io_fraction > kIOThreshold ? Bottleneck::IO : Bottleneck::CPU;
+    } else {
+      report.verdict = slowest == static_cast<int>(OpType::MIXED) ? Bottleneck::Mixed
+                                                                  : Bottleneck::GPU;
+    }
+
+    for (auto &op : op_times) {
+      int s = static_cast<int>(op.second.stage);
+      op.second.stage_share = static_cast<double>(op.first) / op_total_ns[s];
+      bool on_critical_path = report.verdict != Bottleneck::Consumer && s == slowest;
+      if (on_critical_path)
+        op.second.critical_path_share = op.second.stage_share;
+    }
+  }
+
+  std::sort(op_times.begin(), op_times.end(), [](const auto &a, const auto &b) {
+    if (a.second.critical_path_share != b.second.critical_path_share)
+      return a.second.critical_path_share > b.second.critical_path_share;
+    return a.first > b.first;
+  });
+  report.operators.reserve(op_times.size());
+  for (auto &op : op_times)
+    report.operators.push_back(std::move(op.second));
+
+  report_ = std::move(report);
+  prev_stats_ = stats;
+  prev_update_ns_ = now_ns;
+  consumer_wait_ns_ = consumer_samples_ = ready_outputs_sum_ = 0;
+}
+
+BottleneckReport BottleneckAnalyzer::GetReport() const {
+  std::lock_guard<std::mutex> lck(mutex_);
+  return report_;
+}
+
+int64_t BottleneckAnalyzer::now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace dali
@@ -0,0 +1,136 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_BOTTLENECK_ANALYZER_H_
+#define DALI_PIPELINE_EXECUTOR_BOTTLENECK_ANALYZER_H_
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "dali/core/api_helper.h"
+#include "dali/pipeline/executor/executor_stats.h"
+
+namespace dali {
+
+/// The part of the pipeline which limits the throughput
+enum class Bottleneck {
+  Unknown = 0,   ///< not enough iterations were observed
+  Consumer = 1,  ///< the pipeline produces the batches faster than they are requested
+  IO = 2,        ///< the readers (loading and prefetching the data) in the CPU stage
+  CPU = 3,       ///< the operators of the CPU stage
+  Mixed = 4,     ///< the mixed operators (usually the decoder)
+  GPU = 5,       ///< the operators of the GPU stage
+};
+
+DLL_PUBLIC const char *to_string(Bottleneck bottleneck);
+
+struct DLL_PUBLIC OperatorBottleneckInfo {
+  /// Operator name, prefixed with the stage (as in ExecutorMetaMap)
+  std::string name;
+  OpType stage;
+  /// The time of the operator divided by the time of all the operators of its stage
+  double stage_share = 0;
+  /// The share of the operator in the time of the bottleneck stage; 0 outside of that stage
+  double critical_path_share = 0;
+};
+
+struct DLL_PUBLIC BottleneckReport {
+  Bottleneck verdict = Bottleneck::Unknown;
+  /// The number of iterations and the duration of the window the report is based on
+  int64_t iterations = 0;
+  double window_s = 0;
+  /// The part of the window spent by the consumer waiting for the outputs
+  double consumer_wait_fraction = 0;
+  /// The average number of the ready outputs, sampled when the consumer requests one
+  double ready_outputs = 0;
+  /// The time of running a stage per iteration, in seconds; indexed with OpType
+  std::array<double, static_cast<int>(OpType::COUNT)> stage_time_s = {};
+  /// The part of the window spent by a stage waiting for buffers; indexed with OpType
+  std::array<double, static_cast<int>(OpType::COUNT)> stage_wait_fraction = {};
+  /// The part of the capacity of the CPU thread pool spent executing work
+  double thread_pool_utilization = 0;
+  /// The share of the readers in the time of the CPU operators
+  double io_fraction = 0;
+  std::vector<OperatorBottleneckInfo> operators;
+};
+
+/**
+ * @brief Finds the part of the pipeline limiting the throughput, based on the timing statistics
+ *        gathered by the executor over a sliding window.
+ *
+ * The executor samples the state of the output queue whenever the consumer requests a batch
+ * and periodically passes the (cumulative) timing statistics to the analyzer. The verdict is
+ * based on the difference from the previous update:
+ *  - if the consumer rarely waits for the outputs, the pipeline is ahead of it - Consumer;
+ *  - otherwise the stage with the longest time per iteration limits the throughput; the time of
+ *    the mixed and GPU stages is the longer of the host time and the GPU time of their operators,
+ *  - the CPU stage is reported as IO if most of its time is spent in the readers.
+ *
+ * The critical path share of an operator is its share in the time of the bottleneck stage.
+ */
+class DLL_PUBLIC BottleneckAnalyzer {
+ public:
+  /// Below this part of the window spent waiting, the consumer is considered the bottleneck
+  static constexpr double kConsumerWaitThreshold = 0.1;
+  /// The part of the CPU operators time spent in the readers, which makes the CPU stage IO bound
+  static constexpr double kIOThreshold = 0.5;
+
+  explicit BottleneckAnalyzer(double interval_s = 1.0) : interval_ns_(interval_s * 1e9) {}
+
+  /**
+   * @brief Sets the names (prefixed as in ExecutorMetaMap) of the reader operators
+   */
+  void SetReaders(std::unordered_set<std::string> readers);
+
+  /**
+   * @brief Records the state of the output queue when the consumer requests a batch.
+   *
+   * @param ready_outputs the number of outputs ready at the time of the request
+   * @param wait_ns       the time the consumer waited for the output
+   */
+  void AddConsumerSample(int ready_outputs, int64_t wait_ns);
+
+  /**
+   * @brief Returns true if the interval has elapsed since the last update
+   */
+  bool UpdateDue(int64_t now_ns) const;
+
+  /**
+   * @brief Computes a new report from the statistics gathered since the previous update.
+   */
+  void Update(const ExecutorTimingStats &stats, int64_t now_ns);
+
+  BottleneckReport GetReport() const;
+
+  static int64_t now_ns();
+
+ private:
+  int64_t interval_ns_;
+  mutable std::mutex mutex_;
+  std::unordered_set<std::string> readers_;
+  ExecutorTimingStats prev_stats_;
+  int64_t prev_update_ns_ = -1;
+  int64_t consumer_wait_ns_ = 0;
+  int64_t consumer_samples_ = 0;
+  int64_t ready_outputs_sum_ = 0;
+  BottleneckReport report_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_BOTTLENECK_ANALYZER_H_
@@ -0,0 +1,128 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dali/pipeline/executor/bottleneck_analyzer.h"
+
+namespace dali {
+
+namespace {
+
+constexpr int64_t kMs = 1000000;
+
+/**
+ * @brief Adds `iters` iterations to the statistics, with the given time per iteration
+ *        of the stages and the operators.
+ */
+void AddIterations(ExecutorTimingStats &stats, int iters, int64_t cpu_ns, int64_t mixed_ns,
+                   int64_t gpu_ns, int64_t reader_ns, int64_t decoder_gpu_ns) {
+  for (int i = 0; i < iters; i++) {
+    stats.stages[static_cast<int>(OpType::CPU)].run_time.Add(cpu_ns);
+    stats.stages[static_cast<int>(OpType::MIXED)].run_time.Add(mixed_ns);
+    stats.stages[static_cast<int>(OpType::GPU)].run_time.Add(gpu_ns);
+    stats.operators["CPU_reader"].host_time.Add(reader_ns);
+    stats.operators["CPU_augment"].host_time.Add(cpu_ns - reader_ns);
+    stats.operators["MIXED_decoder"].host_time.Add(mixed_ns);
+    stats.operators["MIXED_decoder"].gpu_time.Add(decoder_gpu_ns);
+    stats.operators["GPU_resize"].host_time.Add(gpu_ns);
+  }
+}
+
+const OperatorBottleneckInfo *FindOp(const BottleneckReport &report, const std::string &name) {
+  for (auto &op : report.operators)
+    if (op.name == name)
+      return &op;
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(BottleneckAnalyzer, NoIterations) {
+  BottleneckAnalyzer analyzer(1.0);
+  ExecutorTimingStats stats;
+  EXPECT_TRUE(analyzer.UpdateDue(0));
+  analyzer.Update(stats, 0);
+  EXPECT_FALSE(analyzer.UpdateDue(100 * kMs));
+  EXPECT_TRUE(analyzer.UpdateDue(1000 * kMs));
+  analyzer.Update(stats, 1000 * kMs);
+  EXPECT_EQ(analyzer.GetReport().verdict, Bottleneck::Unknown);
+}
+
+TEST(BottleneckAnalyzer, Stages) {
+  BottleneckAnalyzer analyzer(1.0);
+  analyzer.SetReaders({"CPU_reader"});
+  ExecutorTimingStats stats;
+  AddIterations(stats, 5, 50 * kMs, 1 * kMs, 1 * kMs, 1 * kMs, 1 * kMs);
+  analyzer.Update(stats, 0);
+
+  // the CPU stage is the slowest, but the reader takes only a part of it
+  AddIterations(stats, 10, 20 * kMs, 5 * kMs, 2 * kMs, 4 * kMs, 6 * kMs);
+  for (int i = 0; i < 10; i++)
+    analyzer.AddConsumerSample(0, 15 * kMs);
+  analyzer.Update(stats, 200 * kMs);
+  auto report = analyzer.GetReport();
+  EXPECT_EQ(report.verdict, Bottleneck::CPU);
+  EXPECT_EQ(report.iterations, 10);
+  EXPECT_NEAR(report.consumer_wait_fraction, 0.75, 1e-9);
+  EXPECT_NEAR(report.stage_time_s[static_cast<int>(OpType::CPU)], 0.020, 1e-9);
+  // the GPU time of the decoder is longer than the host time of the mixed stage
+  EXPECT_NEAR(report.stage_time_s[static_cast<int>(OpType::MIXED)], 0.006, 1e-9);
+  EXPECT_NEAR(report.io_fraction, 0.2, 1e-9);
+  ASSERT_FALSE(report.operators.empty());
+  EXPECT_EQ(report.operators[0].name, "CPU_augment");
+  EXPECT_NEAR(report.operators[0].critical_path_share, 0.8, 1e-9);
+  auto *decoder = FindOp(report, "MIXED_decoder");
+  ASSERT_NE(decoder, nullptr);
+  EXPECT_NEAR(decoder->stage_share, 1.0, 1e-9);
+  EXPECT_EQ(decoder->critical_path_share, 0);
+
+  // the readers dominate the CPU stage
+  AddIterations(stats, 10, 20 * kMs, 5 * kMs, 2 * kMs, 15 * kMs, 6 * kMs);
+  analyzer.AddConsumerSample(0, 100 * kMs);
+  analyzer.Update(stats, 400 * kMs);
+  EXPECT_EQ(analyzer.GetReport().verdict, Bottleneck::IO);
+
+  // the decoder
+  AddIterations(stats, 10, 2 * kMs, 5 * kMs, 2 * kMs, 1 * kMs, 18 * kMs);
+  analyzer.AddConsumerSample(0, 100 * kMs);
+  analyzer.Update(stats, 600 * kMs);
+  report = analyzer.GetReport();
+  EXPECT_EQ(report.verdict, Bottleneck::Mixed);
+  EXPECT_EQ(report.operators[0].name, "MIXED_decoder");
+  EXPECT_NEAR(report.operators[0].critical_path_share, 1.0, 1e-9);
+
+  // the GPU stage
+  AddIterations(stats, 10, 2 * kMs, 2 * kMs, 12 * kMs, 1 * kMs, 1 * kMs);
+  analyzer.AddConsumerSample(0, 100 * kMs);
+  analyzer.Update(stats, 800 * kMs);
+  EXPECT_EQ(analyzer.GetReport().verdict, Bottleneck::GPU);
+}
+
+TEST(BottleneckAnalyzer, Consumer) {
+  BottleneckAnalyzer analyzer(1.0);
+  ExecutorTimingStats stats;
+  analyzer.Update(stats, 0);
+  AddIterations(stats, 10, 20 * kMs, 5 * kMs, 2 * kMs, 4 * kMs, 6 * kMs);
+  for (int i = 0; i < 10; i++)
+    analyzer.AddConsumerSample(2, 0);
+  analyzer.Update(stats, 1000 * kMs);
+  auto report = analyzer.GetReport();
+  EXPECT_EQ(report.verdict, Bottleneck::Consumer);
+  EXPECT_NEAR(report.ready_outputs, 2.0, 1e-9);
+  for (auto &op : report.operators)
+    EXPECT_EQ(op.critical_path_share, 0);
+}
+
+}  // namespace dali
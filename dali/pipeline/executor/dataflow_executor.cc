@@ -0,0 +1,90 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <vector>
+
+#include "dali/pipeline/executor/dataflow_executor.h"
+#include "dali/pipeline/executor/lanes.h"
+
+namespace dali {
+
+void CPUDataflowSchedule::Build(const OpGraph &graph, int num_threads) {
+  DALI_ENFORCE(num_threads > 0, "The number of threads must be positive");
+  int nops = graph.NumOp(OpType::CPU);
+  std::vector<std::set<int>> deps(nops);
+
+  for (int op = 0; op < nops; op++) {
+    auto &node = graph.Node(OpType::CPU, op);
+    for (OpNodeId parent : node.parents) {
+      if (graph.NodeType(parent) == OpType::CPU)
+        deps[op].insert(graph.Node(parent).partition_index);
+    }
+  }
+
+  // Order the CPU consumers of each tensor - they might modify the input layout while running
+  for (int t = 0; t < graph.NumTensor(); t++) {
+    std::vector<int> consumers;
+    for (auto &consumer : graph.Tensor(t).consumers) {
+      if (graph.NodeType(consumer.node) == OpType::CPU)
+        consumers.push_back(graph.Node(consumer.node).partition_index);
+    }
+    std::sort(consumers.begin(), consumers.end());
+    consumers.erase(std::unique(consumers.begin(), consumers.end()), consumers.end());
+    for (size_t i = 1; i < consumers.size(); i++)
+      deps[consumers[i]].insert(consumers[i - 1]);
+  }
+
+  dependencies_.clear();
+  dependents_.clear();
+  dependencies_.resize(nops);
+  dependents_.resize(nops);
+  for (int op = 0; op < nops; op++) {
+    for (int dep : deps[op]) {
+      assert(dep < op && "The CPU partition should be topologically sorted");
+      dependencies_[op].push_back(dep);
+      dependents_[dep].push_back(op);
+    }
+  }
+
+  lane_ = CoverWithLanes(dependencies_);
+  int nlanes = 0;
+  for (int lane : lane_)
+    nlanes = std::max(nlanes, lane + 1);
+  std::vector<int> lane_size(nlanes, 0);
+  for (int lane : lane_)
+    lane_size[lane]++;
+
+  // Distribute the threads proportionally to the number of operators in the lane,
+  // with at least one thread per lane
+  lane_threads_.assign(nlanes, 1);
+  if (nlanes == 0)
+    return;
+  int assigned = 0;
+  for (int l = 0; l < nlanes; l++) {
+    lane_threads_[l] = std::max(1, num_threads * lane_size[l] / nops);
+    assigned += lane_threads_[l];
+  }
+  std::vector<int> by_size(nlanes);
+  std::iota(by_size.begin(), by_size.end(), 0);
+  std::stable_sort(by_size.begin(), by_size.end(), [&](int a, int b) {
+    return lane_size[a] > lane_size[b];
+  });
+  for (int i = 0; assigned < num_threads; i = (i + 1) % nlanes, assigned++)
+    lane_threads_[by_size[i]]++;
+}
+
+}  // namespace dali
@@ -0,0 +1,201 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_DATAFLOW_EXECUTOR_H_
+#define DALI_PIPELINE_EXECUTOR_DATAFLOW_EXECUTOR_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/core/format.h"
+#include "dali/pipeline/executor/async_pipelined_executor.h"
+#include "dali/pipeline/executor/async_separated_pipelined_executor.h"
+#include "dali/pipeline/graph/op_graph.h"
+#include "dali/pipeline/util/thread_pool.h"
+
+namespace dali {
+
+/**
+ * @brief Static schedule of the CPU stage used by the dataflow execution.
+ *
+ * The CPU operators are identified by their index in the CPU partition of the OpGraph
+ * (which is a topological order).
+ *
+ * The operators are covered with chains (lanes) - within a lane, each operator is an ancestor
+ * of the next one, so operators from the same lane never run concurrently and can share
+ * a thread pool. Each lane receives a thread budget - a share of the total number of threads
+ * proportional to the number of operators in that lane.
+ *
+ * Operators consuming the same tensor are additionally ordered, because the executor may
+ * temporarily modify the layout of the inputs when running an operator.
+ */
+class DLL_PUBLIC CPUDataflowSchedule {
+ public:
+  DLL_PUBLIC void Build(const OpGraph &graph, int num_threads);
+
+  DLL_PUBLIC int NumOps() const {
+    return dependencies_.size();
+  }
+
+  /**
+   * @brief CPU operators that must be completed before `op` can be started
+   */
+  DLL_PUBLIC const std::vector<int> &Dependencies(int op) const {
+    return dependencies_[op];
+  }
+
+  /**
+   * @brief CPU operators that depend on `op`
+   */
+  DLL_PUBLIC const std::vector<int> &Dependents(int op) const {
+    return dependents_[op];
+  }
+
+  DLL_PUBLIC int Lane(int op) const {
+    return lane_[op];
+  }
+
+  DLL_PUBLIC int NumLanes() const {
+    return lane_threads_.size();
+  }
+
+  DLL_PUBLIC int LaneThreads(int lane) const {
+    return lane_threads_[lane];
+  }
+
+ private:
+  std::vector<std::vector<int>> dependencies_, dependents_;
+  std::vector<int> lane_;
+  std::vector<int> lane_threads_;
+};
+
+/**
+ * @brief Extends an asynchronous executor with dataflow execution of the CPU stage.
+ *
+ * Instead of running the CPU operators one after another, each using the whole thread pool,
+ * an operator is dispatched as soon as all the operators it depends on have finished.
+ * Independent branches of the graph (e.g. image and label processing) run concurrently,
+ * each using its own thread pool with a share of the threads (see CPUDataflowSchedule).
+ *
+ * When the CPU stage is a single chain of operators, the execution is the same as in
+ * the base executor.
+ */
+template <typename AsyncExecutor>
+class DLL_PUBLIC DataflowExecutorImpl : public AsyncExecutor {
+ public:
+  DLL_PUBLIC inline DataflowExecutorImpl(int batch_size, int num_thread, int device_id,
+                                         size_t bytes_per_sample_hint, bool set_affinity = false,
+                                         int max_num_stream = -1,
+                                         int default_cuda_stream_priority = 0,
+                                         QueueSizes prefetch_queue_depth = QueueSizes{2, 2},
+                                         ThreadPoolType thread_pool_type =
+                                             ThreadPoolType::SharedQueue)
+      : AsyncExecutor(batch_size, num_thread, device_id, bytes_per_sample_hint, set_affinity,
+                      max_num_stream, default_cuda_stream_priority, prefetch_queue_depth,
+                      thread_pool_type),
+        num_threads_(num_thread),
+        set_affinity_(set_affinity),
+        thread_pool_type_(thread_pool_type) {}
+
+  DLL_PUBLIC ~DataflowExecutorImpl() override {
+    // The worker threads of the base executor must be stopped before the thread pools
+    // used by the CPU stage are destroyed
+    this->Shutdown();
+  }
+
+  DLL_PUBLIC void Build(OpGraph *graph, vector<string> output_names) override {
+    AsyncExecutor::Build(graph, std::move(output_names));
+    schedule_.Build(*this->graph_, num_threads_);
+    lane_pools_.clear();
+    op_runner_.reset();
+    int nlanes = schedule_.NumLanes();
+    if (nlanes <= 1)
+      return;
+    for (int lane = 0; lane < nlanes; lane++) {
+      lane_pools_.emplace_back(std::make_unique<ThreadPool>(
+          schedule_.LaneThreads(lane), this->device_id_, set_affinity_,
+          make_string("Lane", lane), thread_pool_type_));
+    }
+    op_runner_ = std::make_unique<ThreadPool>(nlanes, this->device_id_, false, "Dataflow");
+    pending_deps_ = std::make_unique<std::atomic<int>[]>(schedule_.NumOps());
+  }
+
+  DLL_PUBLIC const CPUDataflowSchedule &Schedule() const {
+    return schedule_;
+  }
+
+ protected:
+  std::vector<ThreadPool *> CPUThreadPools() override {
+    if (!op_runner_)
+      return AsyncExecutor::CPUThreadPools();
+    std::vector<ThreadPool *> pools;
+    for (auto &pool : lane_pools_)
+      pools.push_back(pool.get());
+    return pools;
+  }
+
+  void RunCPUOps(const QueueIdxs &cpu_idxs, int batch_size) override {
+    if (!op_runner_) {
+      AsyncExecutor::RunCPUOps(cpu_idxs, batch_size);
+      return;
+    }
+    int nops = schedule_.NumOps();
+    for (int op = 0; op < nops; op++)
+      pending_deps_[op] = schedule_.Dependencies(op).size();
+    for (int op = 0; op < nops; op++) {
+      if (schedule_.Dependencies(op).empty())
+        Dispatch(op, cpu_idxs, batch_size);
+    }
+    op_runner_->WaitForWork();
+  }
+
+ private:
+  void Dispatch(int op, const QueueIdxs &cpu_idxs, int batch_size) {
+    // prefer the operators that come first in topological order
+    int64_t priority = schedule_.NumOps() - op;
+    op_runner_->AddWork([this, op, cpu_idxs, batch_size](int) {
+      if (this->exec_error_)
+        return;
+      this->RunCPUOp(op, cpu_idxs, batch_size, lane_pools_[schedule_.Lane(op)].get());
+      // the dependents of a failed operator are never run
+      if (this->exec_error_)
+        return;
+      for (int next : schedule_.Dependents(op)) {
+        if (--pending_deps_[next] == 0)
+          Dispatch(next, cpu_idxs, batch_size);
+      }
+    }, priority, true);
+  }
+
+  int num_threads_;
+  bool set_affinity_;
+  ThreadPoolType thread_pool_type_;
+  CPUDataflowSchedule schedule_;
+  std::vector<std::unique_ptr<ThreadPool>> lane_pools_;
+  // runs the operators - one thread per lane, as there are never more concurrent operators
+  std::unique_ptr<ThreadPool> op_runner_;
+  std::unique_ptr<std::atomic<int>[]> pending_deps_;
+};
+
+using AsyncDataflowPipelinedExecutor = DataflowExecutorImpl<AsyncPipelinedExecutor>;
+using AsyncSeparatedDataflowPipelinedExecutor =
+    DataflowExecutorImpl<AsyncSeparatedPipelinedExecutor>;
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_DATAFLOW_EXECUTOR_H_
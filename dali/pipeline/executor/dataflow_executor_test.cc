@@ -0,0 +1,157 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dali/pipeline/executor/dataflow_executor.h"
+#include "dali/pipeline/operator/builtin/external_source.h"
+#include "dali/test/dali_test_utils.h"
+
+namespace dali {
+
+namespace {
+
+OpSpec PrepareSpec(OpSpec spec, int batch_size, int num_threads) {
+  spec.AddArg("max_batch_size", batch_size)
+      .AddArg("num_threads", num_threads);
+  return spec;
+}
+
+/**
+ * @brief Builds a graph with two independent CPU branches:
+ *        src -> copy1 -> copy2 -> out_a
+ *        src -> copy3 -> out_b
+ */
+void BuildTwoBranchGraph(OpGraph &graph, int batch_size, int num_threads) {
+  auto add = [&](OpSpec spec) {
+    graph.AddOp(PrepareSpec(std::move(spec), batch_size, num_threads), "");
+  };
+  add(OpSpec("ExternalSource")
+      .AddArg("device", "cpu")
+      .AddArg("device_id", 0)
+      .AddOutput("data", "cpu"));
+  add(OpSpec("Copy")
+      .AddArg("device", "cpu")
+      .AddInput("data", "cpu")
+      .AddOutput("a1", "cpu"));
+  add(OpSpec("Copy")
+      .AddArg("device", "cpu")
+      .AddInput("a1", "cpu")
+      .AddOutput("a2", "cpu"));
+  add(OpSpec("Copy")
+      .AddArg("device", "cpu")
+      .AddInput("data", "cpu")
+      .AddOutput("b1", "cpu"));
+  add(OpSpec("MakeContiguous")
+      .AddArg("device", "mixed")
+      .AddInput("a2", "cpu")
+      .AddOutput("out_a", "cpu"));
+  add(OpSpec("MakeContiguous")
+      .AddArg("device", "mixed")
+      .AddInput("b1", "cpu")
+      .AddOutput("out_b", "cpu"));
+}
+
+}  // namespace
+
+TEST(CPUDataflowSchedule, TwoBranches) {
+  OpGraph graph;
+  BuildTwoBranchGraph(graph, 4, 8);
+  CPUDataflowSchedule schedule;
+  schedule.Build(graph, 8);
+
+  ASSERT_EQ(schedule.NumOps(), 4);
+  EXPECT_TRUE(schedule.Dependencies(0).empty());
+  ASSERT_EQ(schedule.Dependencies(1), std::vector<int>({0}));
+  ASSERT_EQ(schedule.Dependencies(2), std::vector<int>({1}));
+  // op 3 consumes the same tensor as op 1, so they are ordered
+  ASSERT_EQ(schedule.Dependencies(3), std::vector<int>({0, 1}));
+
+  ASSERT_EQ(schedule.NumLanes(), 2);
+  EXPECT_EQ(schedule.Lane(0), schedule.Lane(1));
+  EXPECT_EQ(schedule.Lane(1), schedule.Lane(2));
+  EXPECT_NE(schedule.Lane(2), schedule.Lane(3));
+
+  int total_threads = 0;
+  for (int l = 0; l < schedule.NumLanes(); l++) {
+    EXPECT_GE(schedule.LaneThreads(l), 1);
+    total_threads += schedule.LaneThreads(l);
+  }
+  EXPECT_EQ(total_threads, 8);
+  EXPECT_GT(schedule.LaneThreads(schedule.Lane(0)), schedule.LaneThreads(schedule.Lane(3)));
+}
+
+TEST(CPUDataflowSchedule, Chain) {
+  OpGraph graph;
+  auto add = [&](OpSpec spec) {
+    graph.AddOp(PrepareSpec(std::move(spec), 4, 3), "");
+  };
+  add(OpSpec("ExternalSource")
+      .AddArg("device", "cpu")
+      .AddArg("device_id", 0)
+      .AddOutput("data", "cpu"));
+  add(OpSpec("Copy")
+      .AddArg("device", "cpu")
+      .AddInput("data", "cpu")
+      .AddOutput("a1", "cpu"));
+  CPUDataflowSchedule schedule;
+  schedule.Build(graph, 3);
+  ASSERT_EQ(schedule.NumLanes(), 1);
+  EXPECT_EQ(schedule.LaneThreads(0), 3);
+}
+
+template <typename ExecutorType>
+class DataflowExecutorTest : public ::testing::Test {};
+
+using DataflowExecutorTypes =
+    ::testing::Types<AsyncDataflowPipelinedExecutor, AsyncSeparatedDataflowPipelinedExecutor>;
+
+TYPED_TEST_SUITE(DataflowExecutorTest, DataflowExecutorTypes);
+
+TYPED_TEST(DataflowExecutorTest, RunTwoBranches) {
+  const int batch_size = 8, num_threads = 4;
+  TypeParam exe(batch_size, num_threads, 0, 1);
+  exe.Init();
+
+  OpGraph graph;
+  BuildTwoBranchGraph(graph, batch_size, num_threads);
+  exe.Build(&graph, {"out_a_cpu", "out_b_cpu"});
+  ASSERT_EQ(exe.Schedule().NumLanes(), 2);
+
+  auto *src_op =
+      dynamic_cast<ExternalSource<CPUBackend> *>(graph.Node(OpType::CPU, 0).op.get());
+  ASSERT_NE(src_op, nullptr);
+  TensorList<CPUBackend> tl;
+  test::MakeRandomBatch(tl, batch_size);
+
+  for (int iter = 0; iter < 3; iter++) {
+    src_op->SetDataSource(tl);
+    exe.RunCPU();
+    exe.RunMixed();
+    exe.RunGPU();
+
+    DeviceWorkspace ws;
+    exe.Outputs(&ws);
+    ASSERT_EQ(ws.NumOutput(), 2);
+    for (int out = 0; out < 2; out++) {
+      ASSERT_TRUE(ws.OutputIsType<CPUBackend>(out));
+      test::CheckResults(ws, batch_size, 0, tl, out);
+    }
+  }
+}
+
+}  // namespace dali
@@ -13,13 +13,20 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <iterator>
 #include <mutex>
 #include <set>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "dali/core/mm/memory_trace.h"
+#include "dali/core/trace.h"
 #include "dali/pipeline/executor/executor.h"
 #include "dali/pipeline/executor/queue_metadata.h"
 #include "dali/pipeline/graph/op_graph_storage.h"
@@ -28,6 +35,25 @@
 
 namespace dali {
 
+namespace {
+
+std::atomic<int> next_executor_metrics_id{0};
+
+/**
+ * @brief Returns a batch sharing the samples [begin, end) of `batch`
+ */
+template <typename Backend>
+std::shared_ptr<TensorList<Backend>> SliceSamples(const TensorList<Backend> &batch, int begin,
+                                                  int end) {
+  auto slice = std::make_shared<TensorList<Backend>>(end - begin);
+  slice->SetupLike(batch);
+  for (int i = begin; i < end; i++)
+    slice->SetSample(i - begin, batch, i);
+  return slice;
+}
+
+}  // namespace
+
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::PreRun() {
   auto batch_size = InferBatchSize(batch_size_providers_);
@@ -38,9 +64,53 @@ void Executor<WorkspacePolicy, QueuePolicy>::PreRun() {
 
 template <typename WorkspacePolicy, typename QueuePolicy>
 Executor<WorkspacePolicy, QueuePolicy>::~Executor() {
+  // the collector reads the queues
+  queue_metrics_.reset();
   Shutdown();
 }
 
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::SetupMetrics() {
+  if (metrics_id_ < 0)
+    metrics_id_ = next_executor_metrics_id++;
+  metrics::Labels labels = {{"pipeline", std::to_string(metrics_id_)}};
+  batches_metric_ = &metrics::GetCounter("dali_pipeline_batches_total",
+                                         "The number of batches produced by the pipeline", labels);
+
+  cpu_reader_metrics_.clear();
+  cpu_reader_metrics_.resize(graph_->NumOp(OpType::CPU));
+  for (int i = 0; i < graph_->NumOp(OpType::CPU); i++) {
+    auto &node = graph_->Node(OpType::CPU, i);
+    if (!node.op || !static_cast<bool>(node.op->GetReaderMeta()))
+      continue;
+    auto reader_labels = labels;
+    reader_labels.emplace_back("reader", node.instance_name);
+    cpu_reader_metrics_[i].samples = &metrics::GetCounter(
+        "dali_reader_samples_total", "The number of samples produced by the reader",
+        reader_labels);
+    cpu_reader_metrics_[i].bytes = &metrics::GetCounter(
+        "dali_reader_bytes_total", "The size of the outputs produced by the reader",
+        reader_labels);
+  }
+
+  queue_metrics_ = metrics::CollectorHandle([this, labels](auto &samples) {
+    auto sizes = QueuePolicy::GetCurrentQueueSizes();
+    auto stage_labels = [&](const char *stage) {
+      auto ret = labels;
+      ret.emplace_back("stage", stage);
+      return ret;
+    };
+    const char *depth_help = "The number of buffers used by the executor stages";
+    samples.push_back({"dali_executor_queue_depth", depth_help, metrics::MetricType::Gauge,
+                       stage_labels("cpu"), static_cast<double>(sizes.cpu_size)});
+    samples.push_back({"dali_executor_queue_depth", depth_help, metrics::MetricType::Gauge,
+                       stage_labels("gpu"), static_cast<double>(sizes.gpu_size)});
+    samples.push_back({"dali_executor_ready_outputs",
+                       "The number of outputs ready to be consumed", metrics::MetricType::Gauge,
+                       labels, static_cast<double>(QueuePolicy::NumReadyOutputs())});
+  });
+}
+
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::Shutdown() {
   try {
@@ -55,10 +125,14 @@ template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::SyncDevice() {
   if (device_id_ != CPU_ONLY_DEVICE_ID) {
     DeviceGuard dg(device_id_);
-    if (mixed_op_stream_)
-      CUDA_DTOR_CALL(cudaStreamSynchronize(mixed_op_stream_));
-    if (gpu_op_stream_)
-      CUDA_DTOR_CALL(cudaStreamSynchronize(gpu_op_stream_));
+    for (auto *streams : { mixed_op_streams_, gpu_op_streams_ }) {
+      for (int i = 0; i < 2; i++) {
+        if (streams[i])
+          CUDA_DTOR_CALL(cudaStreamSynchronize(streams[i]));
+      }
+    }
+    for (auto &stream : gpu_lane_streams_)
+      CUDA_DTOR_CALL(cudaStreamSynchronize(stream));
   }
 }
 
@@ -84,11 +158,13 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunCPUImpl() {
     }
   }
 
-  DomainTimeRange tr("[DALI][Executor] RunCPU");
+  TraceScope tr(TraceEvent::ExecutorRunCPU);
 
   DeviceGuard g(device_id_);
 
+  auto acquire_start = std::chrono::steady_clock::now();
   auto cpu_idxs = QueuePolicy::AcquireIdxs(OpType::CPU);
+  int64_t queue_wait_ns = ElapsedNs(acquire_start);
   if (exec_error_ || QueuePolicy::IsStopSignaled() ||
       !QueuePolicy::template AreValid<OpType::CPU>(cpu_idxs)) {
     QueuePolicy::ReleaseIdxs(OpType::CPU, cpu_idxs);
@@ -98,37 +174,86 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunCPUImpl() {
   auto batch_size = batch_sizes_cpu_.front();
   batch_sizes_cpu_.pop();
 
+  bool timing = enable_timing_stats_;
+  std::vector<ThreadPool *> thread_pools;
+  int64_t busy_start_ns = 0;
+  int num_threads = 0;
+  if (timing) {
+    thread_pools = CPUThreadPools();
+    for (auto *tp : thread_pools) {
+      tp->EnableBusyTimeMeasurement();
+      busy_start_ns += tp->BusyTimeNs();
+      num_threads += tp->NumThreads();
+    }
+  }
+  auto run_start = std::chrono::steady_clock::now();
+
+  RunCPUOps(cpu_idxs, batch_size);
+
+  if (timing) {
+    int64_t run_ns = ElapsedNs(run_start);
+    int64_t busy_ns = -busy_start_ns;
+    for (auto *tp : thread_pools)
+      busy_ns += tp->BusyTimeNs();
+    AddStageTime(OpType::CPU, queue_wait_ns, run_ns, busy_ns, run_ns * num_threads);
+  }
+
+  // Pass the work to the mixed stage
+  QueuePolicy::ReleaseIdxs(OpType::CPU, cpu_idxs);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunCPUOps(const QueueIdxs &cpu_idxs,
+                                                       int batch_size) {
   // Run the cpu-ops in the thread
   // Process each CPU Op in batch
   for (int cpu_op_id = 0; cpu_op_id < graph_->NumOp(OpType::CPU) && !exec_error_; ++cpu_op_id) {
-    OpNode &op_node = graph_->Node(OpType::CPU, cpu_op_id);
-    auto ws = ws_policy_.template GetWorkspace<OpType::CPU>(cpu_idxs, *graph_, cpu_op_id);
+    RunCPUOp(cpu_op_id, cpu_idxs, batch_size);
+  }
+}
 
-    ws.SetBatchSizes(batch_size);
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunCPUOp(int cpu_op_id, const QueueIdxs &cpu_idxs,
+                                                      int batch_size, ThreadPool *thread_pool) {
+  OpNode &op_node = graph_->Node(OpType::CPU, cpu_op_id);
+  auto ws = ws_policy_.template GetWorkspace<OpType::CPU>(cpu_idxs, *graph_, cpu_op_id);
 
-    DomainTimeRange tr("[DALI][CPU op] " + op_node.instance_name, DomainTimeRange::kBlue1);
+  ws.SetBatchSizes(batch_size);
+  if (thread_pool)
+    ws.SetThreadPool(thread_pool);
 
-    try {
-      RunHelper(op_node, ws);
-      FillStats(cpu_memory_stats_, ws, "CPU_" + op_node.instance_name, cpu_memory_stats_mutex_);
-    } catch (std::exception &e) {
-      HandleError("CPU", op_node, e.what());
-    } catch (...) {
-      HandleError();
+  TraceScope tr(TraceEvent::CPUOp, -1, op_node.trace_name);
+
+  try {
+    auto start = std::chrono::steady_clock::now();
+    RunHelper(op_node, ws);
+    if (enable_timing_stats_)
+      AddOpHostTime("CPU_" + op_node.instance_name, ElapsedNs(start));
+    auto &reader_metrics = cpu_reader_metrics_[cpu_op_id];
+    if (reader_metrics.samples && ws.NumOutput() > 0) {
+      reader_metrics.samples->Add(ws.template Output<CPUBackend>(0).num_samples());
+      int64_t bytes = 0;
+      for (int i = 0; i < ws.NumOutput(); i++)
+        bytes += ws.template Output<CPUBackend>(i).nbytes();
+      reader_metrics.bytes->Add(bytes);
     }
+    FillStats(cpu_memory_stats_, ws, "CPU_" + op_node.instance_name, cpu_memory_stats_mutex_);
+  } catch (std::exception &e) {
+    HandleError("CPU", op_node, e.what());
+  } catch (...) {
+    HandleError();
   }
-
-  // Pass the work to the mixed stage
-  QueuePolicy::ReleaseIdxs(OpType::CPU, cpu_idxs);
 }
 
 
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::RunMixedImpl() {
-  DomainTimeRange tr("[DALI][Executor] RunMixed");
+  TraceScope tr(TraceEvent::ExecutorRunMixed);
   DeviceGuard g(device_id_);
 
+  auto acquire_start = std::chrono::steady_clock::now();
   auto mixed_idxs = QueuePolicy::AcquireIdxs(OpType::MIXED);
+  int64_t queue_wait_ns = ElapsedNs(acquire_start);
   if (exec_error_ || QueuePolicy::IsStopSignaled() ||
      !QueuePolicy::template AreValid<OpType::MIXED>(mixed_idxs)) {
     QueuePolicy::ReleaseIdxs(OpType::MIXED, mixed_idxs);
@@ -137,28 +262,49 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunMixedImpl() {
 
   // Enforce our assumed dependency between consecutive
   // iterations of a stage of the pipeline.
-
   if (device_id_ != CPU_ONLY_DEVICE_ID)
-    CUDA_CALL(cudaEventSynchronize(mixed_stage_event_));
+    SelectStageStream(OpType::MIXED);
 
   auto batch_size = batch_sizes_mixed_.front();
   batch_sizes_mixed_.pop();
 
+  bool timing = enable_timing_stats_;
+  auto run_start = std::chrono::steady_clock::now();
+
   for (int i = 0; i < graph_->NumOp(OpType::MIXED) && !exec_error_; ++i) {
     OpNode &op_node = graph_->Node(OpType::MIXED, i);
     try {
+      if (device_id_ != CPU_ONLY_DEVICE_ID)
+        WaitForPreviousRun(OpType::MIXED, i);
       auto ws = ws_policy_.template GetWorkspace<OpType::MIXED>(mixed_idxs, *graph_, i);
 
       ws.SetBatchSizes(batch_size);
+      if (ws.has_stream())
+        ws.set_stream(MixedOpStream());
 
-      DomainTimeRange tr("[DALI][Mixed op] " + op_node.instance_name, DomainTimeRange::kOrange);
+      TraceScope tr(TraceEvent::MixedOp, -1, op_node.trace_name);
+      TraceDeviceScope gpu_tr;
+      if (ws.has_stream())
+        gpu_tr.Start(TraceEvent::MixedOpDevice, ws.stream(), -1, op_node.trace_name);
+      GPUOpTimingEvents *gpu_timing = nullptr;
+      if (timing && device_id_ != CPU_ONLY_DEVICE_ID && ws.has_stream()) {
+        gpu_timing = StartGPUTiming(OpType::MIXED, i, mixed_idxs[OpType::MIXED],
+                                    "MIXED_" + op_node.instance_name, ws.stream());
+      }
+      auto start = std::chrono::steady_clock::now();
       RunHelper(op_node, ws);
+      if (timing)
+        AddOpHostTime("MIXED_" + op_node.instance_name, ElapsedNs(start));
+      if (gpu_timing)
+        StopGPUTiming(gpu_timing, ws.stream());
       FillStats(mixed_memory_stats_, ws, "MIXED_" + op_node.instance_name,
                 mixed_memory_stats_mutex_);
       if (device_id_ != CPU_ONLY_DEVICE_ID) {
         if (ws.has_stream() && ws.has_event()) {
             CUDA_CALL(cudaEventRecord(ws.event(), ws.stream()));
         }
+        if (ws.has_stream())
+          RecordRunDone(OpType::MIXED, i, ws.stream());
         CUDA_CALL(cudaGetLastError());
       }
     } catch (std::exception &e) {
@@ -173,72 +319,179 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunMixedImpl() {
       // Record event that will allow to call the callback after whole run of this pipeline is
       // finished.
       CUDA_CALL(
-          cudaEventRecord(mixed_callback_events_[mixed_idxs[OpType::MIXED]], mixed_op_stream_));
+          cudaEventRecord(mixed_callback_events_[mixed_idxs[OpType::MIXED]], MixedOpStream()));
     }
 
     if (!mixed_output_events_.empty()) {
       int queue_id = mixed_idxs[OpType::MIXED];
-      CUDA_CALL(cudaEventRecord(mixed_output_events_.GetEvent(queue_id), mixed_op_stream_));
+      CUDA_CALL(cudaEventRecord(mixed_output_events_.GetEvent(queue_id), MixedOpStream()));
     }
 
     // We know that this is the proper stream, we do not need to look it up in any workspace
-    CUDA_CALL(cudaEventRecord(mixed_stage_event_, mixed_op_stream_));
+    CUDA_CALL(cudaEventRecord(mixed_stage_event_, MixedOpStream()));
   } else {
     if (callback_) {
       callback_();
     }
   }
 
+  if (timing)
+    AddStageTime(OpType::MIXED, queue_wait_ns, ElapsedNs(run_start));
+
   // Pass the work to the gpu stage
-  QueuePolicy::ReleaseIdxs(OpType::MIXED, mixed_idxs, mixed_op_stream_);
+  QueuePolicy::ReleaseIdxs(OpType::MIXED, mixed_idxs, MixedOpStream());
 }
 
 
 template <typename WorkspacePolicy, typename QueuePolicy>
-void Executor<WorkspacePolicy, QueuePolicy>::RunGPUImpl() {
-  DomainTimeRange tr("[DALI][Executor] RunGPU");
+void Executor<WorkspacePolicy, QueuePolicy>::SetupGPULanes() {
+  int nops = graph_->NumOp(OpType::GPU);
+  std::vector<std::vector<int>> deps(nops);
+  for (int op = 0; op < nops; op++) {
+    for (OpNodeId parent : graph_->Node(OpType::GPU, op).parents) {
+      if (graph_->NodeType(parent) == OpType::GPU)
+        deps[op].push_back(graph_->Node(parent).partition_index);
+    }
+  }
 
-  auto gpu_idxs = QueuePolicy::AcquireIdxs(OpType::GPU);
-  if (exec_error_ || QueuePolicy::IsStopSignaled() ||
-      !QueuePolicy::template AreValid<OpType::GPU>(gpu_idxs)) {
-    QueuePolicy::ReleaseIdxs(OpType::GPU, gpu_idxs);
+  auto lanes = CoverWithLanes(deps);
+  int nlanes = 0;
+  for (int lane : lanes)
+    nlanes = std::max(nlanes, lane + 1);
+  // one of the streams is used by the mixed stage
+  if (max_num_stream_ > 0)
+    nlanes = std::min(nlanes, std::max(max_num_stream_ - 1, 1));
+  if (nlanes <= 1)
     return;
+  // The operators are issued in topological order, so the lanes can share a stream
+  for (int &lane : lanes)
+    lane %= nlanes;
+
+  gpu_op_lane_ = std::move(lanes);
+  gpu_op_cross_lane_deps_.resize(nops);
+  gpu_op_events_.assign(nops, nullptr);
+  for (int op = 0; op < nops; op++) {
+    for (int dep : deps[op]) {
+      if (gpu_op_lane_[dep] == gpu_op_lane_[op])
+        continue;
+      gpu_op_cross_lane_deps_[op].push_back(dep);
+      if (!gpu_op_events_[dep])
+        gpu_op_events_[dep] = event_pool_.GetEvent();
+    }
   }
+  for (int l = 1; l < nlanes; l++) {
+    gpu_lane_streams_.push_back(CUDAStreamPool::instance().Get(device_id_));
+    gpu_lane_join_events_.push_back(event_pool_.GetEvent());
+  }
+}
 
-  // short path for pure CPU pipeline
-  if (device_id_ == CPU_ONLY_DEVICE_ID) {
-    // We do not release, but handle to used outputs
-    QueuePolicy::QueueOutputIdxs(gpu_idxs, gpu_op_stream_);
-    return;
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::PrepareGPUWorkspace(DeviceWorkspace &ws, int gpu_op_id,
+                                                                 int batch_size) {
+  ws.SetBatchSizes(batch_size);
+  // the stage stream may change between the iterations (see SelectStageStream)
+  ws.set_stream(GPULaneStream(gpu_op_lane_.empty() ? 0 : gpu_op_lane_[gpu_op_id]));
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::SelectStageStream(OpType stage) {
+  if (!single_stream_ && gpu_op_streams_[1]) {
+    // The releases of the outputs are waited for in both streams (see ReleaseOutputs).
+    int urgent = QueuePolicy::NumReadyOutputs() == 0;
+    if (stage == OpType::MIXED)
+      mixed_op_stream_ = static_cast<cudaStream_t>(mixed_op_streams_[urgent]);
+    else
+      gpu_op_stream_ = static_cast<cudaStream_t>(gpu_op_streams_[urgent]);
   }
-  DeviceGuard g(device_id_);
+  // The previous iteration may still be running, possibly in the other stream
+  if (stage == OpType::MIXED)
+    CUDA_CALL(cudaStreamWaitEvent(MixedOpStream(), mixed_stage_event_, 0));
+  else
+    CUDA_CALL(cudaStreamWaitEvent(gpu_op_stream_, gpu_stage_event_, 0));
+}
 
-  // Enforce our assumed dependency between consecutive
-  // iterations of a stage of the pipeline.
-  CUDA_CALL(cudaEventSynchronize(gpu_stage_event_));
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::WaitForPreviousRun(OpType stage, int op_id) {
+  auto &events = stage == OpType::MIXED ? mixed_op_done_events_ : gpu_op_done_events_;
+  CUDA_CALL(cudaEventSynchronize(events[op_id]));
+}
 
-  auto batch_size = batch_sizes_gpu_.front();
-  batch_sizes_gpu_.pop();
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RecordRunDone(OpType stage, int op_id,
+                                                           cudaStream_t stream) {
+  auto &events = stage == OpType::MIXED ? mixed_op_done_events_ : gpu_op_done_events_;
+  CUDA_CALL(cudaEventRecord(events[op_id], stream));
+}
 
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::ForkGPULanes() {
+  if (gpu_lane_streams_.empty())
+    return;
+  CUDA_CALL(cudaEventRecord(gpu_lane_fork_event_, gpu_op_stream_));
+  for (auto &stream : gpu_lane_streams_)
+    CUDA_CALL(cudaStreamWaitEvent(stream, gpu_lane_fork_event_, 0));
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::JoinGPULanes() {
+  for (size_t l = 0; l < gpu_lane_streams_.size(); l++) {
+    CUDA_CALL(cudaEventRecord(gpu_lane_join_events_[l], gpu_lane_streams_[l]));
+    CUDA_CALL(cudaStreamWaitEvent(gpu_op_stream_, gpu_lane_join_events_[l], 0));
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunGPUOps(const QueueIdxs &gpu_idxs, int batch_size) {
+  // the lanes are ordered after the previous iteration through gpu_op_stream_
+  ForkGPULanes();
   for (int i = 0; i < graph_->NumOp(OpType::GPU) && !exec_error_; ++i) {
+    if (!gpu_op_micro_chain_.empty() && gpu_op_micro_chain_[i] >= 0) {
+      int chain_idx = gpu_op_micro_chain_[i];
+      RunMicroBatchChain(chain_idx, gpu_idxs, batch_size);
+      i = gpu_micro_chains_[chain_idx].last;
+      continue;
+    }
     OpNode &op_node = graph_->Node(OpType::GPU, i);
     try {
+      WaitForPreviousRun(OpType::GPU, i);
       auto ws = ws_policy_.template GetWorkspace<OpType::GPU>(gpu_idxs, *graph_, i);
 
-      ws.SetBatchSizes(batch_size);
-
-      auto parent_events = ws.ParentEvents();
+      PrepareGPUWorkspace(ws, i, batch_size);
+      if (!gpu_op_lane_.empty()) {
+        for (int dep : gpu_op_cross_lane_deps_[i]) {
+          CUDA_CALL(cudaStreamWaitEvent(ws.stream(), gpu_op_events_[dep], 0));
+        }
+      }
 
-      for (auto &event : parent_events) {
-        CUDA_CALL(cudaStreamWaitEvent(ws.stream(), event, 0));
+      // The inputs from the mixed stage are already ordered if they were computed in this stream
+      if (ws.stream() != MixedOpStream()) {
+        for (auto &event : ws.ParentEvents()) {
+          CUDA_CALL(cudaStreamWaitEvent(ws.stream(), event, 0));
+        }
       }
 
-      DomainTimeRange tr("[DALI][GPU op] " + op_node.instance_name, DomainTimeRange::knvGreen);
+      TraceScope tr(TraceEvent::GPUOp, -1, op_node.trace_name);
+      TraceDeviceScope gpu_tr(TraceEvent::GPUOpDevice, ws.stream(), -1, op_node.trace_name);
+      bool timing = enable_timing_stats_;
+      GPUOpTimingEvents *gpu_timing = nullptr;
+      if (timing) {
+        gpu_timing = StartGPUTiming(OpType::GPU, i, gpu_idxs[OpType::GPU],
+                                    "GPU_" + op_node.instance_name, ws.stream());
+      }
+      auto start = std::chrono::steady_clock::now();
       RunHelper(op_node, ws);
+      if (timing) {
+        AddOpHostTime("GPU_" + op_node.instance_name, ElapsedNs(start));
+        StopGPUTiming(gpu_timing, ws.stream());
+      }
       FillStats(gpu_memory_stats_, ws, "GPU_" + op_node.instance_name, gpu_memory_stats_mutex_);
       if (ws.has_event()) {
         CUDA_CALL(cudaEventRecord(ws.event(), ws.stream()));
       }
+      RecordRunDone(OpType::GPU, i, ws.stream());
+      if (!gpu_op_events_.empty() && gpu_op_events_[i]) {
+        CUDA_CALL(cudaEventRecord(gpu_op_events_[i], ws.stream()));
+      }
       CUDA_CALL(cudaGetLastError());
     } catch (std::exception &e) {
       HandleError("GPU", op_node, e.what());
@@ -246,6 +499,666 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunGPUImpl() {
       HandleError();
     }
   }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunMicroBatchChain(int chain_idx,
+                                                                const QueueIdxs &gpu_idxs,
+                                                                int batch_size) {
+  const auto &chain = gpu_micro_chains_[chain_idx];
+  int nops = chain.last - chain.first + 1;
+  int micro_batch_size = gpu_micro_batch_size_;
+  OpNode *op_node = nullptr;
+  try {
+    std::vector<DeviceWorkspace> workspaces;
+    workspaces.reserve(nops);
+    // The number of samples processed by each operator - within the branches of a conditional,
+    // consecutive operators can process different parts of the batch
+    SmallVector<int, 8> op_batch_sizes;
+    int num_sub_batches = 1;
+    for (int i = chain.first; i <= chain.last; i++) {
+      op_node = &graph_->Node(OpType::GPU, i);
+      WaitForPreviousRun(OpType::GPU, i);
+      workspaces.push_back(ws_policy_.template GetWorkspace<OpType::GPU>(gpu_idxs, *graph_, i));
+      auto &ws = workspaces.back();
+      PrepareGPUWorkspace(ws, i, batch_size);
+      if (ws.stream() != MixedOpStream()) {
+        for (auto &event : ws.ParentEvents()) {
+          CUDA_CALL(cudaStreamWaitEvent(ws.stream(), event, 0));
+        }
+      }
+      TensorNodeId first_input = op_node->parent_tensors[0];
+      int micro = gpu_tensor_micro_batch_[first_input];
+      int n;
+      if (micro >= 0 && gpu_micro_tensors_[micro].internal) {
+        const auto &producer = graph_->Node(graph_->Tensor(first_input).producer.node);
+        n = op_batch_sizes[producer.partition_index - chain.first];
+      } else {
+        n = ws.GetInputBatchSize(0);
+      }
+      op_batch_sizes.push_back(n);
+      num_sub_batches = std::max(num_sub_batches, div_ceil(n, micro_batch_size));
+    }
+
+    AccessOrder order(static_cast<cudaStream_t>(workspaces[0].stream()));
+    for (int i = chain.first; i <= chain.last; i++) {
+      for (TensorNodeId tid : graph_->Node(OpType::GPU, i).children_tensors) {
+        auto &tensor = gpu_micro_tensors_[gpu_tensor_micro_batch_[tid]];
+        if (tensor.internal)
+          continue;
+        tensor.parts.clear();
+        tensor.buffer.reset();
+        tensor.capacity = tensor.used = tensor.total_bytes = 0;
+        if (tensor.max_total_bytes > 0) {
+          Tensor<GPUBackend> buffer;
+          buffer.set_device_id(device_id_);
+          buffer.set_order(order);
+          buffer.Resize({tensor.max_total_bytes}, DALI_UINT8);
+          tensor.buffer = buffer.get_data_ptr();
+          tensor.capacity = tensor.max_total_bytes;
+        }
+      }
+    }
+
+    bool timing = enable_timing_stats_;
+    SmallVector<int64_t, 8> host_times;
+    host_times.resize(nops, 0);
+    for (int sub = 0; sub < num_sub_batches && !exec_error_; sub++) {
+      int begin = sub * micro_batch_size;
+      for (int k = 0; k < nops; k++) {
+        int n = op_batch_sizes[k];
+        // every operator is run at least once, to produce its (possibly empty) outputs
+        if (begin >= n && sub > 0)
+          continue;
+        int end = std::min(begin + micro_batch_size, n);
+        op_node = &graph_->Node(OpType::GPU, chain.first + k);
+        const auto &spec = op_node->spec;
+        DeviceWorkspace ws = workspaces[k];
+        for (int in = 0; in < spec.NumRegularInput(); in++) {
+          int micro = gpu_tensor_micro_batch_[op_node->parent_tensors[in]];
+          if (micro >= 0 && gpu_micro_tensors_[micro].internal)
+            ws.SetInput(in, gpu_micro_tensors_[micro].sub_batch);
+          else if (ws.InputIsType<CPUBackend>(in))
+            ws.SetInput(in, SliceSamples(ws.Input<CPUBackend>(in), begin, end));
+          else
+            ws.SetInput(in, SliceSamples(ws.Input<GPUBackend>(in), begin, end));
+        }
+        const ArgumentWorkspace &arguments = workspaces[k];
+        for (auto &arg : arguments)
+          ws.AddArgumentInput(arg.first, SliceSamples(*arg.second.tvec, begin, end));
+        for (int out = 0; out < ws.NumOutput(); out++) {
+          int micro = gpu_tensor_micro_batch_[op_node->children_tensors[out]];
+          auto &tensor = gpu_micro_tensors_[micro];
+          if (tensor.internal) {
+            ws.SetOutput(out, tensor.sub_batch);
+          } else {
+            auto part = std::make_shared<TensorList<GPUBackend>>();
+            part->set_device_id(device_id_);
+            tensor.parts.push_back(part);
+            ws.SetOutput(out, std::move(part));
+          }
+        }
+
+        TraceScope tr(TraceEvent::GPUOp, -1, op_node->trace_name);
+        TraceDeviceScope gpu_tr(TraceEvent::GPUOpDevice, ws.stream(), -1, op_node->trace_name);
+        auto start = std::chrono::steady_clock::now();
+        RunHelper(*op_node, ws);
+        if (timing)
+          host_times[k] += ElapsedNs(start);
+        FillStats(gpu_memory_stats_, ws, "GPU_" + op_node->instance_name,
+                  gpu_memory_stats_mutex_);
+        CUDA_CALL(cudaGetLastError());
+      }
+    }
+
+    for (int k = 0; k < nops; k++) {
+      op_node = &graph_->Node(OpType::GPU, chain.first + k);
+      auto &ws = workspaces[k];
+      for (int out = 0; out < ws.NumOutput(); out++) {
+        int micro = gpu_tensor_micro_batch_[op_node->children_tensors[out]];
+        auto &tensor = gpu_micro_tensors_[micro];
+        if (tensor.internal || tensor.parts.empty())
+          continue;
+        int num_samples = 0;
+        for (auto &part : tensor.parts)
+          num_samples += part->num_samples();
+        auto &output = ws.Output<GPUBackend>(out);
+        output.Reset();
+        output.SetupLike(*tensor.parts[0]);
+        output.SetSize(num_samples);
+        int s = 0;
+        for (auto &part : tensor.parts) {
+          for (int j = 0; j < part->num_samples(); j++)
+            output.SetSample(s++, *part, j);
+        }
+        // the memory is kept alive by the samples of the output
+        tensor.parts.clear();
+        tensor.buffer.reset();
+        tensor.max_total_bytes = std::max(tensor.max_total_bytes, tensor.total_bytes);
+      }
+      if (timing)
+        AddOpHostTime("GPU_" + op_node->instance_name, host_times[k]);
+      if (ws.has_event()) {
+        CUDA_CALL(cudaEventRecord(ws.event(), ws.stream()));
+      }
+      RecordRunDone(OpType::GPU, chain.first + k, ws.stream());
+    }
+  } catch (std::exception &e) {
+    HandleError("GPU", *op_node, e.what());
+  } catch (...) {
+    HandleError();
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::AllocateMicroBatchOutput(
+    TensorList<GPUBackend> &output, int micro_tensor, const OutputDesc &desc, AccessOrder order) {
+  auto &tensor = gpu_micro_tensors_[micro_tensor];
+  if (tensor.internal) {
+    // reused by all the sub-batches - grows to the largest one
+    output.Resize(desc.shape, desc.type);
+    return;
+  }
+  int64_t bytes = desc.shape.num_elements() * TypeTable::GetTypeInfo(desc.type).size();
+  tensor.total_bytes += bytes;
+  if (tensor.buffer && tensor.used + bytes <= tensor.capacity) {
+    // the parts are placed back to back, so that the whole output is contiguous in memory
+    shared_ptr<void> part(tensor.buffer, static_cast<uint8_t *>(tensor.buffer.get()) + tensor.used);
+    output.ShareData(part, bytes, false, desc.shape, desc.type, device_id_, order,
+                     output.GetLayout());
+    tensor.used += bytes;
+  } else {
+    output.Resize(desc.shape, desc.type);
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::PlanMicroBatches(const std::vector<int> &queue_sizes) {
+  auto output_ids = graph_->GetOutputs(output_names_, true);
+  std::set<TensorNodeId> pipeline_outputs(output_ids.begin(), output_ids.end());
+  int nops = graph_->NumOp(OpType::GPU);
+  auto micro_batchable = [&](int i) {
+    const OpNode &op_node = graph_->Node(OpType::GPU, i);
+    return op_node.spec.GetSchema().IsMicroBatchable() && op_node.op->CanInferOutputs() &&
+           op_node.spec.NumRegularInput() > 0;
+  };
+  std::vector<int> op_chain(nops, -1);
+  std::vector<int> tensor_micro(graph_->NumTensor(), -1);
+  for (int i = 0; i < nops; i++) {
+    if (!micro_batchable(i))
+      continue;
+    MicroBatchChain chain;
+    chain.first = i;
+    while (i + 1 < nops && micro_batchable(i + 1))
+      i++;
+    chain.last = i;
+    for (int op = chain.first; op <= chain.last; op++) {
+      op_chain[op] = gpu_micro_chains_.size();
+      for (TensorNodeId tid : graph_->Node(OpType::GPU, op).children_tensors) {
+        const TensorNode &tensor = graph_->Tensor(tid);
+        MicroBatchTensor micro;
+        micro.internal = queue_sizes[tid] == 1 && !pipeline_outputs.count(tid);
+        for (auto &consumer : tensor.consumers) {
+          const OpNode &consumer_node = graph_->Node(consumer.node);
+          micro.internal = micro.internal && consumer_node.op_type == OpType::GPU &&
+                           consumer_node.partition_index <= chain.last;
+        }
+        if (micro.internal) {
+          micro.sub_batch = std::make_shared<TensorList<GPUBackend>>();
+          micro.sub_batch->set_device_id(device_id_);
+        }
+        tensor_micro[tid] = gpu_micro_tensors_.size();
+        gpu_micro_tensors_.push_back(std::move(micro));
+      }
+    }
+    gpu_micro_chains_.push_back(chain);
+  }
+  if (gpu_micro_chains_.empty())
+    return;
+  gpu_op_micro_chain_ = std::move(op_chain);
+  gpu_tensor_micro_batch_ = std::move(tensor_micro);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::PlanGPUMemory(const std::vector<int> &queue_sizes) {
+  auto output_ids = graph_->GetOutputs(output_names_, true);
+  std::set<TensorNodeId> pipeline_outputs(output_ids.begin(), output_ids.end());
+  // The in-place joins are set up before their inputs are computed, which the sub-batches
+  // of the micro-batched chains can't be
+  if (gpu_micro_chains_.empty())
+    PlanInplaceJoins(queue_sizes, pipeline_outputs);
+  std::vector<LiveRange> ranges(graph_->NumTensor());
+  for (int i = 0; i < graph_->NumOp(OpType::GPU); i++) {
+    const OpNode &op_node = graph_->Node(OpType::GPU, i);
+    // The operators which don't infer the output shapes allocate the outputs on their own
+    if (!op_node.op->CanInferOutputs())
+      continue;
+    for (TensorNodeId tid : op_node.children_tensors) {
+      const TensorNode &tensor = graph_->Tensor(tid);
+      // The outputs of the pipeline and of the stage are kept after the stage is done
+      if (tensor.producer.storage_device != StorageDevice::GPU || queue_sizes[tid] != 1 ||
+          pipeline_outputs.count(tid))
+        continue;
+      if (!gpu_tensor_inplace_join_.empty() && gpu_tensor_inplace_join_[tid] >= 0)
+        continue;
+      if (!gpu_tensor_micro_batch_.empty() && gpu_tensor_micro_batch_[tid] >= 0)
+        continue;
+      LiveRange range{i, i};
+      bool shareable = true;
+      for (auto &consumer : tensor.consumers) {
+        const OpNode &consumer_node = graph_->Node(consumer.node);
+        // An operator which doesn't infer its outputs may pass its input through to them,
+        // which would extend the lifetime of the input
+        if (consumer_node.op_type != OpType::GPU || !consumer_node.op->CanInferOutputs()) {
+          shareable = false;
+          break;
+        }
+        range.last = std::max(range.last, consumer_node.partition_index);
+      }
+      if (shareable)
+        ranges[tid] = range;
+    }
+  }
+
+  gpu_tensor_arena_ = AssignArenas(ranges);
+  int num_arenas = 0;
+  for (int arena : gpu_tensor_arena_)
+    num_arenas = std::max(num_arenas, arena + 1);
+  if (num_arenas == 0) {
+    gpu_tensor_arena_.clear();
+    return;
+  }
+  gpu_arenas_.resize(num_arenas);
+  for (auto &arena : gpu_arenas_)
+    arena.set_device_id(device_id_);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::PlanInplaceJoins(
+    const std::vector<int> &queue_sizes, const std::set<TensorNodeId> &pipeline_outputs) {
+  // The output of a join must be allocated before its inputs are computed
+  for (int i = 0; i < graph_->NumOp(OpType::GPU); i++) {
+    if (!graph_->Node(OpType::GPU, i).op->CanInferOutputs())
+      return;
+  }
+
+  std::vector<int> tensor_join(graph_->NumTensor(), -1);
+  for (int i = 0; i < graph_->NumOp(OpType::GPU); i++) {
+    const OpNode &op_node = graph_->Node(OpType::GPU, i);
+    if (!IsOutermostJoin(op_node.spec))
+      continue;
+    InplaceJoin join;
+    join.join = op_node.id;
+    join.output = op_node.children_tensors[0];
+    // the output can't be an input of an earlier join placed in-place
+    bool inplace = tensor_join[join.output] < 0;
+    for (int in = 0; in < op_node.spec.NumRegularInput() && inplace; in++) {
+      TensorNodeId tid = graph_->TensorId(op_node.spec.Input(in));
+      const TensorNode &tensor = graph_->Tensor(tid);
+      inplace = tensor.producer.storage_device == StorageDevice::GPU &&
+                graph_->Node(tensor.producer.node).op_type == OpType::GPU &&
+                tensor.consumers.size() == 1 && queue_sizes[tid] == 1 &&
+                !pipeline_outputs.count(tid) && tensor_join[tid] < 0;
+      join.inputs.push_back(tid);
+    }
+    if (!inplace)
+      continue;
+    int join_idx = gpu_inplace_joins_.size();
+    tensor_join[join.output] = join_idx;
+    for (TensorNodeId tid : join.inputs)
+      tensor_join[tid] = join_idx;
+    gpu_inplace_joins_.push_back(std::move(join));
+  }
+  if (!gpu_inplace_joins_.empty())
+    gpu_tensor_inplace_join_ = std::move(tensor_join);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::PlaceInplaceJoinInputs(int join_idx,
+                                                                    DeviceWorkspace &ws,
+                                                                    AccessOrder order) {
+  auto &join = gpu_inplace_joins_[join_idx];
+  join.buffer.reset();
+  join.bytes = 0;
+  int ninputs = join.inputs.size();
+  // The inputs are already set up - their shapes are in the descriptions of their producers
+  SmallVector<const OutputDesc *, 8> descs;
+  for (TensorNodeId tid : join.inputs) {
+    auto &producer = graph_->Tensor(tid).producer;
+    descs.push_back(&graph_->Node(producer.node).output_desc[producer.index]);
+  }
+  bool compatible = true;
+  for (int in = 1; in < ninputs; in++) {
+    compatible = compatible && descs[in]->type == descs[0]->type &&
+                 descs[in]->shape.num_samples() == descs[0]->shape.num_samples() &&
+                 descs[in]->shape.sample_dim() == descs[0]->shape.sample_dim();
+  }
+
+  std::vector<std::vector<int64_t>> sample_bytes(ninputs), offsets;
+  int64_t total_bytes = 0;
+  if (compatible) {
+    size_t type_size = TypeTable::GetTypeInfo(descs[0]->type).size();
+    for (int in = 0; in < ninputs; in++) {
+      int nsamples = descs[in]->shape.num_samples();
+      sample_bytes[in].resize(nsamples);
+      for (int s = 0; s < nsamples; s++)
+        sample_bytes[in][s] = descs[in]->shape.tensor_size(s) * type_size;
+    }
+    offsets = JoinedSampleOffsets(sample_bytes, total_bytes);
+  }
+
+  if (!compatible || total_bytes == 0) {
+    // The join will report the error, if any - just allocate the inputs as usual
+    for (int in = 0; in < ninputs; in++) {
+      auto &input = ws.UnsafeMutableInput<GPUBackend>(in);
+      if (input.shares_data())
+        input.Reset();
+      input.Resize(descs[in]->shape, descs[in]->type);
+    }
+    return;
+  }
+
+  Tensor<GPUBackend> buffer;
+  buffer.set_device_id(device_id_);
+  buffer.set_order(order);
+  buffer.Resize({total_bytes}, DALI_UINT8);
+  join.buffer = buffer.get_data_ptr();
+  join.bytes = total_bytes;
+  auto *base = static_cast<uint8_t *>(join.buffer.get());
+  for (int in = 0; in < ninputs; in++) {
+    auto &input = ws.UnsafeMutableInput<GPUBackend>(in);
+    auto &desc = *descs[in];
+    input.Reset();
+    input.set_type(desc.type);
+    input.set_sample_dim(desc.shape.sample_dim());
+    input.SetSize(desc.shape.num_samples());
+    for (int s = 0; s < desc.shape.num_samples(); s++) {
+      shared_ptr<void> sample(join.buffer, base + offsets[in][s]);
+      input.SetSample(s, sample, sample_bytes[in][s], input.is_pinned(),
+                      desc.shape.tensor_shape(s), desc.type, device_id_, order);
+    }
+  }
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::AllocateInplaceJoin(TensorList<GPUBackend> &output,
+                                                                 int join_idx,
+                                                                 const OutputDesc &desc,
+                                                                 AccessOrder order) {
+  auto &join = gpu_inplace_joins_[join_idx];
+  int64_t bytes = desc.shape.num_elements() * TypeTable::GetTypeInfo(desc.type).size();
+  if (join.buffer && bytes == join.bytes) {
+    output.ShareData(join.buffer, join.bytes, false, desc.shape, desc.type, device_id_, order,
+                     output.GetLayout());
+  } else {
+    if (output.shares_data())
+      output.Reset();
+    output.Resize(desc.shape, desc.type);
+  }
+  // the buffer is kept alive by the output and the inputs of the join
+  join.buffer.reset();
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::AllocateFromArena(TensorList<GPUBackend> &output,
+                                                               int arena_idx,
+                                                               const OutputDesc &desc,
+                                                               AccessOrder order) {
+  auto &arena = gpu_arenas_[arena_idx];
+  size_t bytes = desc.shape.num_elements() * TypeTable::GetTypeInfo(desc.type).size();
+  // The sizes change between the iterations - the arena grows to the largest one seen so far.
+  // The previous allocation is kept alive by the outputs which still point to it.
+  if (bytes > arena.capacity() || !arena.has_data())
+    arena.reserve(std::max<size_t>(bytes, 1), order);
+  output.ShareData(arena.get_data_ptr(), arena.capacity(), false, desc.shape, desc.type,
+                   device_id_, order, output.GetLayout());
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+bool Executor<WorkspacePolicy, QueuePolicy>::CanCaptureGPUStage() const {
+  if (graph_->NumOp(OpType::GPU) == 0 || !gpu_micro_chains_.empty())
+    return false;
+  for (int i = 0; i < graph_->NumOp(OpType::GPU); i++) {
+    const OpNode &op_node = graph_->Node(OpType::GPU, i);
+    if (!op_node.spec.GetSchema().IsCUDAGraphSafe() || !op_node.op->CanInferOutputs())
+      return false;
+    // The contents of CPU inputs (including argument inputs) may change between iterations
+    for (int in = 0; in < op_node.spec.NumInput(); in++) {
+      if (op_node.spec.InputDevice(in) == "cpu")
+        return false;
+    }
+  }
+  return true;
+}
+
+namespace {
+
+void AppendGraphSignature(std::vector<int64_t> &signature, const TensorList<GPUBackend> &tl) {
+  const auto &shape = tl.shape();
+  signature.push_back(tl.type());
+  signature.push_back(shape.sample_dim());
+  signature.push_back(shape.num_samples());
+  signature.insert(signature.end(), shape.shapes.begin(), shape.shapes.end());
+  for (int s = 0; s < tl.num_samples(); s++)
+    signature.push_back(reinterpret_cast<intptr_t>(tl.raw_tensor(s)));
+}
+
+void AppendGraphSignature(std::vector<int64_t> &signature, const DeviceWorkspace &ws) {
+  for (int i = 0; i < ws.NumInput(); i++)
+    AppendGraphSignature(signature, ws.Input<GPUBackend>(i));
+  for (int i = 0; i < ws.NumOutput(); i++)
+    AppendGraphSignature(signature, ws.Output<GPUBackend>(i));
+}
+
+}  // namespace
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+bool Executor<WorkspacePolicy, QueuePolicy>::SetupGPUOps(const QueueIdxs &gpu_idxs,
+                                                         int batch_size,
+                                                         std::vector<int64_t> *signature) {
+  for (int i = 0; i < graph_->NumOp(OpType::GPU); ++i) {
+    OpNode &op_node = graph_->Node(OpType::GPU, i);
+    try {
+      WaitForPreviousRun(OpType::GPU, i);
+      auto ws = ws_policy_.template GetWorkspace<OpType::GPU>(gpu_idxs, *graph_, i);
+      PrepareGPUWorkspace(ws, i, batch_size);
+
+      // The inputs from the mixed stage are waited for before any GPU operator is run
+      if (!single_stream_) {
+        for (auto &event : ws.ParentEvents()) {
+          CUDA_CALL(cudaStreamWaitEvent(gpu_op_stream_, event, 0));
+        }
+      }
+
+      TraceScope tr(TraceEvent::GPUOp, -1, op_node.trace_name);
+      if (!gpu_tensor_inplace_join_.empty() && !op_node.children_tensors.empty()) {
+        int join = gpu_tensor_inplace_join_[op_node.children_tensors[0]];
+        if (join >= 0 && gpu_inplace_joins_[join].join == op_node.id)
+          PlaceInplaceJoinInputs(join, ws, AccessOrder(ws.stream()));
+      }
+      auto empty_layout_in_idxs = SetDefaultInputLayouts(op_node, ws);
+      SetupOutputs(op_node, ws);
+      RestoreInputLayouts(ws, empty_layout_in_idxs);
+      FillStats(gpu_memory_stats_, ws, "GPU_" + op_node.instance_name, gpu_memory_stats_mutex_);
+      if (signature)
+        AppendGraphSignature(*signature, ws);
+    } catch (std::exception &e) {
+      HandleError("GPU", op_node, e.what());
+      return false;
+    } catch (...) {
+      HandleError();
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunGPUStageGraph(const QueueIdxs &gpu_idxs,
+                                                              int batch_size) {
+  std::vector<int64_t> signature;
+  if (!SetupGPUOps(gpu_idxs, batch_size, &signature))
+    return;
+
+  auto &stage_graph = gpu_stage_graphs_[gpu_idxs[OpType::GPU]];
+  if (stage_graph.signature == signature && stage_graph.exec) {
+    CUDA_CALL(cudaGraphLaunch(stage_graph.exec, gpu_op_stream_));
+    return;
+  }
+
+  // Capture only when the setup is the same as in the previous iteration that used
+  // these buffers - the first iteration may need to allocate memory.
+  bool capture = stage_graph.signature == signature;
+  stage_graph.exec.reset();
+  stage_graph.signature = std::move(signature);
+  if (!capture) {
+    RunPreparedGPUOps(gpu_idxs, batch_size, false);
+    return;
+  }
+
+  std::string capture_error;
+  {
+    DomainTimeRange tr("[DALI][Executor] Capture GPU stage");
+    try {
+      CUDA_CALL(cudaStreamBeginCapture(gpu_op_stream_, cudaStreamCaptureModeThreadLocal));
+      RunPreparedGPUOps(gpu_idxs, batch_size, true);
+      cudaGraph_t captured = nullptr;
+      CUDA_CALL(cudaStreamEndCapture(gpu_op_stream_, &captured));
+      CUDAGraph graph(captured);
+      stage_graph.exec = CUDAGraphExec::Instantiate(graph);
+    } catch (std::exception &e) {
+      capture_error = e.what();
+    } catch (...) {
+      capture_error = "Unknown exception";
+    }
+  }
+  if (capture_error.empty()) {
+    CUDA_CALL(cudaGraphLaunch(stage_graph.exec, gpu_op_stream_));
+    return;
+  }
+
+  cudaStreamCaptureStatus status = cudaStreamCaptureStatusNone;
+  if (cudaStreamIsCapturing(gpu_op_stream_, &status) == cudaSuccess &&
+      status != cudaStreamCaptureStatusNone) {
+    cudaGraph_t captured = nullptr;
+    cudaStreamEndCapture(gpu_op_stream_, &captured);
+    CUDAGraph discard(captured);
+  }
+  cudaGetLastError();  // clear the error left by the failed capture
+  DALI_WARN(make_string("Failed to capture the GPU stage in a CUDA graph. Falling back to "
+                        "launching the operators one by one. Reason:\n", capture_error));
+  gpu_stage_graphs_.clear();
+  RunPreparedGPUOps(gpu_idxs, batch_size, false);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunPreparedGPUOps(const QueueIdxs &gpu_idxs,
+                                                               int batch_size, bool capture) {
+  ForkGPULanes();
+  for (int i = 0; i < graph_->NumOp(OpType::GPU) && !exec_error_; ++i) {
+    OpNode &op_node = graph_->Node(OpType::GPU, i);
+    try {
+      auto ws = ws_policy_.template GetWorkspace<OpType::GPU>(gpu_idxs, *graph_, i);
+      PrepareGPUWorkspace(ws, i, batch_size);
+      if (!gpu_op_lane_.empty()) {
+        for (int dep : gpu_op_cross_lane_deps_[i]) {
+          CUDA_CALL(cudaStreamWaitEvent(ws.stream(), gpu_op_events_[dep], 0));
+        }
+      }
+
+      TraceScope tr(TraceEvent::GPUOp, -1, op_node.trace_name);
+      // The events can't be queried while being captured
+      bool timing = enable_timing_stats_ && !capture;
+      TraceDeviceScope gpu_tr;
+      if (!capture)
+        gpu_tr.Start(TraceEvent::GPUOpDevice, ws.stream(), -1, op_node.trace_name);
+      GPUOpTimingEvents *gpu_timing = nullptr;
+      if (timing) {
+        gpu_timing = StartGPUTiming(OpType::GPU, i, gpu_idxs[OpType::GPU],
+                                    "GPU_" + op_node.instance_name, ws.stream());
+      }
+      auto start = std::chrono::steady_clock::now();
+      auto empty_layout_in_idxs = SetDefaultInputLayouts(op_node, ws);
+      {
+        DomainTimeRange run_tr("[DALI][Executor] Run");
+        op_node.op->Run(ws);
+      }
+      RestoreInputLayouts(ws, empty_layout_in_idxs);
+      if (timing) {
+        AddOpHostTime("GPU_" + op_node.instance_name, ElapsedNs(start));
+        StopGPUTiming(gpu_timing, ws.stream());
+      }
+      if (!capture && ws.has_event()) {
+        CUDA_CALL(cudaEventRecord(ws.event(), ws.stream()));
+      }
+      if (!capture)
+        RecordRunDone(OpType::GPU, i, ws.stream());
+      if (!gpu_op_events_.empty() && gpu_op_events_[i]) {
+        CUDA_CALL(cudaEventRecord(gpu_op_events_[i], ws.stream()));
+      }
+      CUDA_CALL(cudaGetLastError());
+    } catch (std::exception &e) {
+      if (capture)
+        throw;
+      HandleError("GPU", op_node, e.what());
+    } catch (...) {
+      if (capture)
+        throw;
+      HandleError();
+    }
+  }
+  // the lanes must be joined before the capture ends
+  JoinGPULanes();
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::RunGPUImpl() {
+  TraceScope tr(TraceEvent::ExecutorRunGPU);
+
+  auto acquire_start = std::chrono::steady_clock::now();
+  auto gpu_idxs = QueuePolicy::AcquireIdxs(OpType::GPU);
+  int64_t queue_wait_ns = ElapsedNs(acquire_start);
+  if (exec_error_ || QueuePolicy::IsStopSignaled() ||
+      !QueuePolicy::template AreValid<OpType::GPU>(gpu_idxs)) {
+    QueuePolicy::ReleaseIdxs(OpType::GPU, gpu_idxs);
+    return;
+  }
+
+  // short path for pure CPU pipeline
+  if (device_id_ == CPU_ONLY_DEVICE_ID) {
+    // We do not release, but handle to used outputs
+    batches_metric_->Add();
+    QueuePolicy::QueueOutputIdxs(gpu_idxs, gpu_op_stream_);
+    return;
+  }
+  DeviceGuard g(device_id_);
+
+  // Enforce our assumed dependency between consecutive
+  // iterations of a stage of the pipeline.
+  SelectStageStream(OpType::GPU);
+  if (!gpu_stage_graphs_.empty()) {
+    // A captured stage reads the host buffers of the operators when it's launched and doesn't
+    // record the per-operator events - wait for the whole previous iteration.
+    CUDA_CALL(cudaEventSynchronize(gpu_stage_event_));
+  }
+
+  auto batch_size = batch_sizes_gpu_.front();
+  batch_sizes_gpu_.pop();
+
+  bool timing = enable_timing_stats_;
+  auto run_start = std::chrono::steady_clock::now();
+
+  if (!gpu_stage_graphs_.empty()) {
+    RunGPUStageGraph(gpu_idxs, batch_size);
+  } else if (!gpu_inplace_joins_.empty()) {
+    if (SetupGPUOps(gpu_idxs, batch_size, nullptr))
+      RunPreparedGPUOps(gpu_idxs, batch_size, false);
+  } else {
+    RunGPUOps(gpu_idxs, batch_size);
+  }
+  // Join the remaining lanes, so that the events and callbacks recorded
+  // in gpu_op_stream_ cover the whole stage
+  JoinGPULanes();
 
   // Update the ready queue to signal that all the work
   // in the `gpu_idxs` set of output buffers has been
@@ -268,10 +1181,54 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunGPUImpl() {
   // We know that this is the proper stream, we do not need to look it up in any workspace
   CUDA_CALL(cudaEventRecord(gpu_stage_event_, gpu_op_stream_));
 
+  if (timing)
+    AddStageTime(OpType::GPU, queue_wait_ns, ElapsedNs(run_start));
+
   // We do not release, but handle to used outputs
+  batches_metric_->Add();
   QueuePolicy::QueueOutputIdxs(gpu_idxs, gpu_op_stream_);
 }
 
+template <typename WorkspacePolicy, typename QueuePolicy>
+typename Executor<WorkspacePolicy, QueuePolicy>::GPUOpTimingEvents *
+Executor<WorkspacePolicy, QueuePolicy>::StartGPUTiming(OpType stage, int op_id, int queue_idx,
+                                                       const std::string &op_name,
+                                                       cudaStream_t stream) {
+  auto &stage_events = stage == OpType::MIXED ? mixed_op_timing_events_ : gpu_op_timing_events_;
+  int depth = stage_queue_depths_[stage];
+  if (stage_events.empty())
+    stage_events.resize(graph_->NumOp(stage) * depth);
+  auto &events = stage_events[op_id * depth + queue_idx];
+  if (events.pending) {
+    events.pending = false;
+    cudaError_t status = cudaEventQuery(events.end);
+    if (status == cudaSuccess) {
+      float ms = 0;
+      CUDA_CALL(cudaEventElapsedTime(&ms, events.start, events.end));
+      std::lock_guard<std::mutex> lck(timing_stats_mutex_);
+      timing_stats_.operators[op_name].gpu_time.Add(static_cast<int64_t>(ms * 1e6));
+    } else if (status == cudaErrorNotReady) {
+      // The buffers are reused before the work was completed - skip the measurement
+      cudaGetLastError();
+    } else {
+      CUDA_CALL(status);
+    }
+  }
+  if (!events.start) {
+    events.start = CUDAEvent::CreateWithFlags(cudaEventDefault, device_id_);
+    events.end = CUDAEvent::CreateWithFlags(cudaEventDefault, device_id_);
+  }
+  CUDA_CALL(cudaEventRecord(events.start, stream));
+  return &events;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::StopGPUTiming(GPUOpTimingEvents *events,
+                                                           cudaStream_t stream) {
+  CUDA_CALL(cudaEventRecord(events->end, stream));
+  events->pending = true;
+}
+
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::RunCPU() {
   try {
@@ -308,15 +1265,48 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunGPU() {
 template <typename WorkspacePolicy, typename QueuePolicy>
 template <typename Workspace>
 void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspace &ws) {
+  mm::alloc_trace_owner trace_owner(op_node.instance_name.c_str());
+  auto empty_layout_in_idxs = SetDefaultInputLayouts(op_node, ws);
+  SetupOutputs(op_node, ws);
+  {
+    DomainTimeRange tr("[DALI][Executor] Run");
+    op_node.op->Run(ws);
+  }
+  RestoreInputLayouts(ws, empty_layout_in_idxs);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+template <typename Workspace>
+SmallVector<int, 16> Executor<WorkspacePolicy, QueuePolicy>::SetDefaultInputLayouts(
+    OpNode &op_node, Workspace &ws) {
+  const auto &spec = op_node.op->GetSpec();
+  const auto &schema = spec.GetSchema();
+  SmallVector<int, 16> empty_layout_in_idxs;
+  for (int i = 0; i < spec.NumRegularInput(); i++) {
+    bool had_empty_layout = false;
+    if (ws.template InputIsType<CPUBackend>(i)) {
+      had_empty_layout =
+          SetDefaultLayoutIfNeeded(ws.template UnsafeMutableInput<CPUBackend>(i), schema, i);
+    } else {
+      had_empty_layout =
+          SetDefaultLayoutIfNeeded(ws.template UnsafeMutableInput<GPUBackend>(i), schema, i);
+    }
+    if (had_empty_layout) empty_layout_in_idxs.push_back(i);
+  }
+  return empty_layout_in_idxs;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+template <typename Workspace>
+void Executor<WorkspacePolicy, QueuePolicy>::SetupOutputs(OpNode &op_node, Workspace &ws) {
   auto &output_desc = op_node.output_desc;
   auto &op = *op_node.op;
   output_desc.clear();
   const auto &spec = op.GetSpec();
-  const auto &schema = spec.GetSchema();
-  SmallVector<int, 16> empty_layout_in_idxs;
 
-  cudaStream_t prev_stage_stream = ws.has_stream() && ws.stream() == gpu_op_stream_
-    ? mixed_op_stream_ : gpu_op_stream_;
+  cudaStream_t gpu_op_stream = gpu_op_stream_;
+  cudaStream_t prev_stage_stream = ws.has_stream() && ws.stream() == gpu_op_stream
+    ? MixedOpStream() : gpu_op_stream;
 
   auto order = ws.has_stream() ? AccessOrder(ws.stream()) : AccessOrder::host();
   auto set_order = [&](auto &output) {
@@ -333,6 +1323,17 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspac
     }
   }
 
+  // The operators process as many samples as they get - in the branches of a conditional
+  // (see _conditional__Split) it's only a part of the batch
+  if (ws.NumInput() > 0) {
+    ws.SetBatchSizes(ws.GetInputBatchSize(0));
+  } else {
+    const ArgumentWorkspace &argument_ws = ws;
+    auto arg = begin(argument_ws);
+    if (arg != end(argument_ws))
+      ws.SetBatchSizes(arg->second.tvec->num_samples());
+  }
+
   for (int i = 0; i < ws.NumInput(); i++) {
     DALI_ENFORCE(
         ws.GetInputBatchSize(i) <= max_batch_size_,
@@ -345,17 +1346,9 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspac
                              ws.GetRequestedBatchSize(i), " <= ", max_batch_size_));
   }
 
-  for (int i = 0; i < spec.NumRegularInput(); i++) {
-    bool had_empty_layout = false;
-    if (ws.template InputIsType<CPUBackend>(i)) {
-      had_empty_layout =
-          SetDefaultLayoutIfNeeded(ws.template UnsafeMutableInput<CPUBackend>(i), schema, i);
-    } else {
-      had_empty_layout =
-          SetDefaultLayoutIfNeeded(ws.template UnsafeMutableInput<GPUBackend>(i), schema, i);
-    }
-    if (had_empty_layout) empty_layout_in_idxs.push_back(i);
-  }
+  auto &host_arena = host_arenas_[op_node.id];
+  host_arena->reset();
+  ws.SetHostArena(host_arena.get());
 
   bool should_allocate = false;
   {
@@ -374,8 +1367,20 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspac
                     "CanInferOutputs should always return true.");
       for (int i = 0; i < ws.NumOutput(); i++) {
         auto &desc = output_desc[i];
+        TensorNodeId tid = op_node.children_tensors[i];
+        int arena = gpu_tensor_arena_.empty() ? -1 : gpu_tensor_arena_[tid];
+        int join = gpu_tensor_inplace_join_.empty() ? -1 : gpu_tensor_inplace_join_[tid];
+        int micro = gpu_tensor_micro_batch_.empty() ? -1 : gpu_tensor_micro_batch_[tid];
         if (ws.template OutputIsType<CPUBackend>(i)) {
           ws.template Output<CPUBackend>(i).Resize(desc.shape, desc.type);
+        } else if (micro >= 0) {
+          AllocateMicroBatchOutput(ws.template Output<GPUBackend>(i), micro, desc, order);
+        } else if (join >= 0) {
+          // The inputs of the join are allocated when the join is set up
+          if (gpu_inplace_joins_[join].output == tid)
+            AllocateInplaceJoin(ws.template Output<GPUBackend>(i), join, desc, order);
+        } else if (arena >= 0) {
+          AllocateFromArena(ws.template Output<GPUBackend>(i), arena, desc, order);
         } else {
           ws.template Output<GPUBackend>(i).Resize(desc.shape, desc.type);
         }
@@ -387,11 +1392,12 @@ void Executor<WorkspacePolicy, QueuePolicy>::RunHelper(OpNode &op_node, Workspac
                     "always return false.");
     }
   }
-  {
-    DomainTimeRange tr("[DALI][Executor] Run");
-    op.Run(ws);
-  }
+}
 
+template <typename WorkspacePolicy, typename QueuePolicy>
+template <typename Workspace>
+void Executor<WorkspacePolicy, QueuePolicy>::RestoreInputLayouts(
+    Workspace &ws, const SmallVector<int, 16> &empty_layout_in_idxs) {
   for (int i : empty_layout_in_idxs) {
     if (ws.template InputIsType<CPUBackend>(i)) {
       auto &in = ws.template UnsafeMutableInput<CPUBackend>(i);
@@ -15,21 +15,34 @@
 #ifndef DALI_PIPELINE_EXECUTOR_EXECUTOR_H_
 #define DALI_PIPELINE_EXECUTOR_EXECUTOR_H_
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <queue>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 
 #include "dali/core/common.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/cuda_graph.h"
 #include "dali/core/cuda_stream_pool.h"
 #include "dali/core/error_handling.h"
+#include "dali/core/metrics.h"
+#include "dali/core/mm/default_resources.h"
 #include "dali/core/nvtx.h"
+#include "dali/core/small_vector.h"
 #include "dali/pipeline/data/backend.h"
+#include "dali/pipeline/executor/bottleneck_analyzer.h"
+#include "dali/pipeline/executor/executor_stats.h"
+#include "dali/pipeline/executor/lanes.h"
+#include "dali/pipeline/executor/memory_planner.h"
 #include "dali/pipeline/executor/queue_metadata.h"
 #include "dali/pipeline/executor/queue_policy.h"
 #include "dali/pipeline/executor/workspace_policy.h"
@@ -77,11 +90,23 @@ class DLL_PUBLIC ExecutorBase {
   DLL_PUBLIC virtual void RunMixed() = 0;
   DLL_PUBLIC virtual void RunGPU() = 0;
   DLL_PUBLIC virtual void Outputs(DeviceWorkspace *ws) = 0;
-  DLL_PUBLIC virtual void ShareOutputs(DeviceWorkspace *ws) = 0;
-  DLL_PUBLIC virtual void ReleaseOutputs() = 0;
+  DLL_PUBLIC virtual void ShareOutputs(DeviceWorkspace *ws, AccessOrder order = {}) = 0;
+  DLL_PUBLIC virtual void ReleaseOutputs(AccessOrder consumer_order = {}) = 0;
   DLL_PUBLIC virtual void SetCompletionCallback(ExecutorCallback cb) = 0;
   DLL_PUBLIC virtual void EnableMemoryStats(bool enable_memory_stats = false) = 0;
+  DLL_PUBLIC virtual void EnableGPUMultiStream(bool enable_gpu_multi_stream = false) = 0;
+  DLL_PUBLIC virtual void EnableGPUGraphCapture(bool enable_gpu_graph_capture = false) = 0;
+  DLL_PUBLIC virtual void EnableGPUMemoryPlanning(bool enable_gpu_memory_planning = false) = 0;
+  DLL_PUBLIC virtual void EnableGPUMicroBatching(int micro_batch_size) = 0;
+  DLL_PUBLIC virtual void SetUrgentStreamPriority(int priority) = 0;
+  DLL_PUBLIC virtual void EnableAdaptiveQueueDepth(QueueSizes min_queue_depth) = 0;
+  DLL_PUBLIC virtual QueueSizes GetCurrentQueueSizes() const = 0;
   DLL_PUBLIC virtual ExecutorMetaMap GetExecutorMeta() = 0;
+  DLL_PUBLIC virtual void EnableTimingStats(bool enable_timing_stats = false) = 0;
+  DLL_PUBLIC virtual ExecutorTimingStats GetTimingStats() = 0;
+  DLL_PUBLIC virtual void EnableBottleneckAnalysis(double interval_s) = 0;
+  DLL_PUBLIC virtual BottleneckReport GetBottleneckReport() = 0;
+  DLL_PUBLIC virtual HostArenaStatsMap GetHostArenaStats() = 0;
   DLL_PUBLIC virtual void Shutdown() = 0;
 
  protected:
@@ -104,15 +129,20 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
   DLL_PUBLIC inline Executor(int max_batch_size, int num_thread, int device_id,
                              size_t bytes_per_sample_hint, bool set_affinity = false,
                              int max_num_stream = -1, int default_cuda_stream_priority = 0,
-                             QueueSizes prefetch_queue_depth = QueueSizes{2, 2})
+                             QueueSizes prefetch_queue_depth = QueueSizes{2, 2},
+                             ThreadPoolType thread_pool_type = ThreadPoolType::SharedQueue)
       : max_batch_size_(max_batch_size),
         device_id_(device_id),
+        max_num_stream_(max_num_stream),
+        default_cuda_stream_priority_(default_cuda_stream_priority),
+        urgent_cuda_stream_priority_(default_cuda_stream_priority),
         bytes_per_sample_hint_(bytes_per_sample_hint),
         callback_(nullptr),
         event_pool_(),
-        thread_pool_(num_thread, device_id, set_affinity, "Executor"),
+        thread_pool_(num_thread, device_id, set_affinity, "Executor", thread_pool_type),
         exec_error_(false),
         queue_sizes_(prefetch_queue_depth),
+        min_queue_sizes_(prefetch_queue_depth),
         enable_memory_stats_(false) {
     DALI_ENFORCE(max_batch_size_ > 0, "Max batch size must be greater than 0.");
 
@@ -124,16 +154,150 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
   DLL_PUBLIC void EnableMemoryStats(bool enable_memory_stats = false) override {
     enable_memory_stats_ = enable_memory_stats;
   }
+  /**
+   * @brief Gathers the execution time of the operators and the stages.
+   *
+   * Can be enabled at any time. The GPU time of an operator is measured with a pair of CUDA events
+   * and is read when the same buffers are used again, so that the execution doesn't block.
+   * The GPU time is not measured for the iterations which replay a captured CUDA graph, nor for
+   * the operators run in sub-batches (see EnableGPUMicroBatching).
+   */
+  DLL_PUBLIC void EnableTimingStats(bool enable_timing_stats = false) override {
+    enable_timing_stats_ = enable_timing_stats;
+  }
+  /**
+   * @brief Periodically finds the part of the pipeline which limits the throughput.
+   *
+   * Enables the timing statistics. The report is updated when the outputs are requested,
+   * at most once per `interval_s` seconds; a non-positive interval disables the analysis.
+   */
+  DLL_PUBLIC void EnableBottleneckAnalysis(double interval_s) override;
+  DLL_PUBLIC BottleneckReport GetBottleneckReport() override;
+  /**
+   * @brief Runs independent branches of the GPU stage on separate CUDA streams.
+   *
+   * Must be called before Build. The number of streams used by the GPU stage is limited
+   * by `max_num_stream` (if positive) - one stream is always reserved for the mixed stage.
+   */
+  DLL_PUBLIC void EnableGPUMultiStream(bool enable_gpu_multi_stream = false) override {
+    enable_gpu_multi_stream_ = enable_gpu_multi_stream;
+  }
+  /**
+   * @brief Captures the GPU stage in a CUDA graph and replays it, as long as the shapes
+   *        and addresses of the inputs and outputs of the GPU operators don't change.
+   *
+   * Must be called before Build. The capture is only used if all the GPU operators are marked
+   * as CUDA graph safe in their schema and don't take any CPU inputs. Otherwise, or if the
+   * capture fails, the GPU operators are launched one by one, as usual.
+   */
+  DLL_PUBLIC void EnableGPUGraphCapture(bool enable_gpu_graph_capture = false) override {
+    enable_gpu_graph_capture_ = enable_gpu_graph_capture;
+  }
+  /**
+   * @brief Sets the priority of the stage streams for the iterations the consumer waits for.
+   *
+   * Must be called before Build. If different from the default stream priority, the mixed
+   * and GPU stages get a second stream with this priority (lower number - higher priority,
+   * as in `cudaStreamCreateWithPriority`). An iteration of a stage is issued to it when there
+   * are no ready outputs, i.e. the consumer is (or soon will be) waiting for this iteration;
+   * the iterations prefetched ahead use the streams with the default priority.
+   * The additional lanes of the GPU stage (see EnableGPUMultiStream) keep the default priority.
+   */
+  DLL_PUBLIC void SetUrgentStreamPriority(int priority) override {
+    urgent_cuda_stream_priority_ = priority;
+  }
+  /**
+   * @brief Lets the intermediate outputs of the GPU stage with non-overlapping lifetimes
+   *        share memory.
+   *
+   * Must be called before Build. Only the outputs which are produced and consumed by GPU
+   * operators that can infer their output shapes, and which are not outputs of the pipeline,
+   * are shared. Each group of such outputs uses one arena, grown when an output doesn't fit.
+   * Not used with the GPU multi-stream mode, where the lifetimes of the outputs on different
+   * streams can overlap.
+   *
+   * Also, if all the GPU operators can infer their output shapes, the inputs of `Cat` and
+   * `Stack` along the outermost axis, which are produced by GPU operators and not used
+   * elsewhere, are placed directly in the joined output (see PlanInplaceJoins) - the join
+   * doesn't copy anything then.
+   */
+  DLL_PUBLIC void EnableGPUMemoryPlanning(bool enable_gpu_memory_planning = false) override {
+    enable_gpu_memory_planning_ = enable_gpu_memory_planning;
+  }
+  /**
+   * @brief Runs the chains of micro-batchable GPU operators in sub-batches of at most
+   *        `micro_batch_size` samples; 0 disables the micro-batching.
+   *
+   * Must be called before Build. A chain is a run of consecutive (in the order of execution)
+   * GPU operators marked as MicroBatchable in their schema, which can infer their output shapes.
+   * The whole chain is run for one sub-batch before the next one is started (see
+   * RunMicroBatchChain), so the outputs consumed only within the chain, as well as
+   * the temporary memory of the operators, are sized for a sub-batch rather than for the batch.
+   * The remaining outputs of the chain are assembled from the outputs of the sub-batches,
+   * without copying.
+   * Not used with the GPU multi-stream mode; the chains prevent the capture of the GPU stage
+   * in a CUDA graph and the in-place joins (see EnableGPUMemoryPlanning).
+   */
+  DLL_PUBLIC void EnableGPUMicroBatching(int micro_batch_size) override {
+    DALI_ENFORCE(micro_batch_size >= 0, make_string(
+        "The micro-batch size must not be negative, got: ", micro_batch_size));
+    gpu_micro_batch_size_ = micro_batch_size;
+  }
+  /**
+   * @brief Adapts the number of buffers used by the stages between `min_queue_depth`
+   *        and the prefetch queue depth, based on the time the stages spend waiting for each other.
+   *
+   * Must be called before Build. The executor starts with the full prefetch queue depth.
+   * The buffers taken out of use have their memory released and are reallocated when used again.
+   * Requires an asynchronous executor - otherwise the thread scheduling the work could block
+   * waiting for a buffer that is only released by itself.
+   */
+  DLL_PUBLIC void EnableAdaptiveQueueDepth(QueueSizes min_queue_depth) override {
+    DALI_ENFORCE(min_queue_depth.cpu_size > 0 && min_queue_depth.gpu_size > 0,
+                 "Only positive queue sizes allowed");
+    DALI_ENFORCE(min_queue_depth.cpu_size <= queue_sizes_.cpu_size &&
+                 min_queue_depth.gpu_size <= queue_sizes_.gpu_size,
+                 make_string("The minimum queue depth {", min_queue_depth.cpu_size, ", ",
+                             min_queue_depth.gpu_size, "} exceeds the prefetch queue depth {",
+                             queue_sizes_.cpu_size, ", ", queue_sizes_.gpu_size, "}."));
+    min_queue_sizes_ = min_queue_depth;
+  }
+  /**
+   * @brief Returns the number of buffers currently used by the CPU and GPU stages
+   */
+  DLL_PUBLIC QueueSizes GetCurrentQueueSizes() const override {
+    return QueuePolicy::GetCurrentQueueSizes();
+  }
   DLL_PUBLIC void Build(OpGraph *graph, vector<string> output_names) override;
   DLL_PUBLIC void Init() override {}
   DLL_PUBLIC void RunCPU() override;
   DLL_PUBLIC void RunMixed() override;
   DLL_PUBLIC void RunGPU() override;
   DLL_PUBLIC void Outputs(DeviceWorkspace *ws) override;
-  DLL_PUBLIC void ShareOutputs(DeviceWorkspace *ws) override;
-  DLL_PUBLIC void ReleaseOutputs() override;
+  /**
+   * @brief Fills the workspace with the outputs of the pipeline
+   *
+   * If `order` is a CUDA stream, the GPU outputs are ready for the work scheduled on it
+   * after this call and the host doesn't wait for them. Otherwise, the host waits.
+   * The i-th parent event of the workspace is recorded after the i-th output is computed
+   * (it's null for the CPU outputs).
+   */
+  DLL_PUBLIC void ShareOutputs(DeviceWorkspace *ws, AccessOrder order = {}) override;
+  /**
+   * @brief Releases the outputs returned by ShareOutputs
+   *
+   * If `consumer_order` is a CUDA stream, the buffers are not overwritten before the work
+   * scheduled on that stream so far has finished, without blocking the host.
+   */
+  DLL_PUBLIC void ReleaseOutputs(AccessOrder consumer_order = {}) override;
   DLL_PUBLIC void SetCompletionCallback(ExecutorCallback cb) override;
   DLL_PUBLIC ExecutorMetaMap GetExecutorMeta() override;
+  DLL_PUBLIC ExecutorTimingStats GetTimingStats() override;
+  /**
+   * @brief Returns the usage of the host arenas of the operators; gathered when the memory
+   *        statistics are enabled.
+   */
+  DLL_PUBLIC HostArenaStatsMap GetHostArenaStats() override;
   DLL_PUBLIC void Shutdown() override;
 
   DLL_PUBLIC void ShutdownQueue() {
@@ -144,10 +308,189 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
 
  protected:
   DLL_PUBLIC void RunCPUImpl();
+  /**
+   * @brief Runs all the CPU operators for one iteration, using the workspaces
+   *        associated with `cpu_idxs`.
+   *
+   * The default implementation runs the operators one by one, in topological order.
+   */
+  DLL_PUBLIC virtual void RunCPUOps(const QueueIdxs &cpu_idxs, int batch_size);
+  /**
+   * @brief Runs a single CPU operator, identified by its index in the CPU partition.
+   *
+   * @param thread_pool if not null, replaces the thread pool used by the operator
+   */
+  DLL_PUBLIC void RunCPUOp(int cpu_op_id, const QueueIdxs &cpu_idxs, int batch_size,
+                           ThreadPool *thread_pool = nullptr);
+  /**
+   * @brief Thread pools used by the CPU operators - for measuring their utilization
+   */
+  DLL_PUBLIC virtual std::vector<ThreadPool *> CPUThreadPools() {
+    return {&thread_pool_};
+  }
   DLL_PUBLIC void RunMixedImpl();
   DLL_PUBLIC void RunGPUImpl();
   DLL_PUBLIC void SyncDevice();
 
+  /**
+   * @brief Assigns the GPU operators to streams, so that independent branches of the GPU
+   *        stage can run concurrently.
+   *
+   * The GPU partition is covered with lanes (see CoverWithLanes) and each lane is mapped
+   * to a stream; lane 0 uses the GPU stage stream. An event is recorded after each operator
+   * with a dependent on a different stream, so the dependent can wait for it.
+   */
+  void SetupGPULanes();
+
+  /**
+   * @brief Runs all the GPU operators for one iteration, one by one.
+   */
+  void RunGPUOps(const QueueIdxs &gpu_idxs, int batch_size);
+
+  /**
+   * @brief Sets the batch size and the stream of the workspace of a GPU operator
+   */
+  void PrepareGPUWorkspace(DeviceWorkspace &ws, int gpu_op_id, int batch_size);
+
+  /**
+   * @brief Makes the streams used by the lanes other than 0 wait for gpu_op_stream_
+   */
+  void ForkGPULanes();
+
+  /**
+   * @brief Makes gpu_op_stream_ wait for the work issued to the other lanes
+   */
+  void JoinGPULanes();
+
+  /**
+   * @brief Assigns the intermediate outputs of the GPU stage to shared arenas
+   *        (see AssignArenas), based on the range of GPU operators that use them.
+   */
+  void PlanGPUMemory(const std::vector<int> &queue_sizes);
+
+  /**
+   * @brief Finds the joins whose inputs can be written directly to their output.
+   *
+   * The whole GPU stage is then set up before it's run (SetupGPUOps), so that the output of
+   * a join can be allocated before its producers run. The inputs must be produced by GPU
+   * operators, consumed only by the join and not be the outputs of the pipeline or of
+   * another join placed in-place.
+   */
+  void PlanInplaceJoins(const std::vector<int> &queue_sizes,
+                        const std::set<TensorNodeId> &pipeline_outputs);
+
+  /**
+   * @brief Allocates the output of the join and points the samples of its inputs
+   *        at their place in it; called before the join is set up.
+   */
+  void PlaceInplaceJoinInputs(int join_idx, DeviceWorkspace &ws, AccessOrder order);
+
+  /**
+   * @brief Allocates the output of a join planned in-place - in the memory prepared by
+   *        PlaceInplaceJoinInputs, if it matches the output
+   */
+  void AllocateInplaceJoin(TensorList<GPUBackend> &output, int join_idx, const OutputDesc &desc,
+                           AccessOrder order);
+
+  /**
+   * @brief Points a GPU output at the memory of its arena, growing the arena if needed
+   */
+  void AllocateFromArena(TensorList<GPUBackend> &output, int arena, const OutputDesc &desc,
+                         AccessOrder order);
+
+  /**
+   * @brief Finds the chains of GPU operators which are run in sub-batches
+   *        (see EnableGPUMicroBatching) and classifies their outputs.
+   */
+  void PlanMicroBatches(const std::vector<int> &queue_sizes);
+
+  /**
+   * @brief Runs the operators of a chain for all the sub-batches of the current iteration.
+   *
+   * The inputs coming from outside of the chain are sliced into sub-batches (the slices share
+   * the samples of the inputs). For each sub-batch, all the operators of the chain are run
+   * in order; an output consumed only within the chain is kept in one batch, reused by all
+   * the sub-batches. The other outputs are allocated, sub-batch after sub-batch, in a buffer
+   * sized for the largest total seen so far and the samples of the full output are pointed
+   * at them at the end - the output is contiguous in memory if the buffer was large enough.
+   */
+  void RunMicroBatchChain(int chain_idx, const QueueIdxs &gpu_idxs, int batch_size);
+
+  /**
+   * @brief Allocates the output of a sub-batch of an operator of a micro-batched chain
+   */
+  void AllocateMicroBatchOutput(TensorList<GPUBackend> &output, int micro_tensor,
+                                const OutputDesc &desc, AccessOrder order);
+
+  /**
+   * @brief Checks if the GPU stage of the graph can be captured in a CUDA graph
+   */
+  bool CanCaptureGPUStage() const;
+
+  /**
+   * @brief Sets up all the GPU operators for one iteration, before any of them is run,
+   *        optionally gathering the signature of the stage (see RunGPUStageGraph).
+   *
+   * @return false, if the setup failed and the error was reported
+   */
+  bool SetupGPUOps(const QueueIdxs &gpu_idxs, int batch_size, std::vector<int64_t> *signature);
+
+  /**
+   * @brief Runs the GPU stage using a CUDA graph.
+   *
+   * First, all the GPU operators are set up and their outputs allocated. If the result
+   * (shapes, types and addresses of the inputs and outputs) matches the one captured
+   * for this set of buffers, the graph is replayed. If it matches the previous iteration
+   * with these buffers, the operators are captured in a new graph, which is then launched.
+   * Otherwise, the operators are run one by one and the result is remembered.
+   */
+  void RunGPUStageGraph(const QueueIdxs &gpu_idxs, int batch_size);
+
+  /**
+   * @brief Runs the GPU operators that have already been set up.
+   *
+   * @param capture if true, the errors are propagated instead of being reported by HandleError
+   */
+  void RunPreparedGPUOps(const QueueIdxs &gpu_idxs, int batch_size, bool capture);
+
+  /**
+   * @brief The stream of the mixed stage; the GPU stage stream if the stages share one.
+   */
+  cudaStream_t MixedOpStream() const {
+    return single_stream_ ? static_cast<cudaStream_t>(gpu_op_stream_)
+                          : static_cast<cudaStream_t>(mixed_op_stream_);
+  }
+
+  /**
+   * @brief Chooses the stream for the next iteration of the mixed or GPU stage,
+   *        based on whether the consumer waits for the outputs (see SetUrgentStreamPriority),
+   *        and orders it after the previous iteration of the stage.
+   *
+   * The host doesn't wait for the previous iteration - see WaitForPreviousRun.
+   */
+  void SelectStageStream(OpType stage);
+
+  /**
+   * @brief Blocks the host until the work issued by the operator in its previous run
+   *        is complete.
+   *
+   * The operators reuse their own host buffers (e.g. the sources of the asynchronous copies)
+   * in every iteration, so an operator can't be set up again before its previous run has
+   * finished on the device. Waiting for each operator separately, instead of for the whole
+   * stage, lets the host prepare the next iteration while the previous one is still running.
+   */
+  void WaitForPreviousRun(OpType stage, int op_id);
+
+  /**
+   * @brief Records the event waited for by WaitForPreviousRun after the operator's work
+   */
+  void RecordRunDone(OpType stage, int op_id, cudaStream_t stream);
+
+  cudaStream_t GPULaneStream(int lane) const {
+    return lane == 0 ? static_cast<cudaStream_t>(gpu_op_stream_)
+                     : static_cast<cudaStream_t>(gpu_lane_streams_[lane - 1]);
+  }
+
   template <typename T>
   inline void GetMaxSizesCont(T &in, size_t &max_out_size, size_t &max_reserved_size) {
     auto out_size = in.nbytes();
@@ -214,9 +557,71 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
           stats[i].reserved = std::max(reserved_size, stats[i].reserved);
           stats[i].max_reserved = std::max(max_reserved_size, stats[i].max_reserved);
         }
+        if (auto *arena = ws.HostArena()) {
+          std::lock_guard<std::mutex> arena_lck(host_arena_stats_mutex_);
+          host_arena_stats_[op_name] = arena->stats();
+        }
       }
   }
 
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  static int64_t ElapsedNs(TimePoint start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+  }
+
+  /**
+   * @brief Adds the host time of running an operator to the timing statistics
+   */
+  void AddOpHostTime(const std::string &op_name, int64_t ns) {
+    std::lock_guard<std::mutex> lck(timing_stats_mutex_);
+    timing_stats_.operators[op_name].host_time.Add(ns);
+  }
+
+  void AddStageTime(OpType stage, int64_t queue_wait_ns, int64_t run_ns,
+                    int64_t thread_pool_busy_ns = 0, int64_t thread_pool_capacity_ns = 0) {
+    std::lock_guard<std::mutex> lck(timing_stats_mutex_);
+    auto &stats = timing_stats_.stages[static_cast<int>(stage)];
+    stats.queue_wait.Add(queue_wait_ns);
+    stats.run_time.Add(run_ns);
+    stats.thread_pool_busy_ns += thread_pool_busy_ns;
+    stats.thread_pool_capacity_ns += thread_pool_capacity_ns;
+  }
+
+  /**
+   * @brief Creates the counters updated by the executor and registers the collector
+   *        of the queue depths, labeled with the id of the executor.
+   */
+  void SetupMetrics();
+
+  /// The names (as in the timing statistics) of the reader operators
+  std::unordered_set<std::string> GetReaderNames() const;
+
+  /**
+   * @brief Passes the state of the outputs queue to the bottleneck analyzer (if enabled) and
+   *        updates the analysis, when due.
+   */
+  void UpdateBottleneckAnalysis(int ready_outputs, int64_t wait_ns);
+
+  struct GPUOpTimingEvents {
+    CUDAEvent start, end;
+    bool pending = false;
+  };
+
+  /**
+   * @brief Records the event starting the measurement of the GPU time of an operator.
+   *
+   * If the events for this operator and buffer hold a previous measurement which has already
+   * completed, it's added to the statistics first.
+   *
+   * @return the events to be passed to StopGPUTiming
+   */
+  GPUOpTimingEvents *StartGPUTiming(OpType stage, int op_id, int queue_idx,
+                                    const std::string &op_name, cudaStream_t stream);
+
+  void StopGPUTiming(GPUOpTimingEvents *events, cudaStream_t stream);
+
   void HandleError(const std::string &stage, const OpNode &op_node, const std::string &message) {
     // handle internal Operator names that start with underscore
     const auto &op_name =
@@ -264,6 +669,11 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
 
   void SetupOutputQueuesForGraph();
 
+  /**
+   * @brief Frees the memory of the output buffers that were taken out of use by the queue policy
+   */
+  void ReleaseParkedBuffers();
+
   class EventList {
    public:
     inline EventList() = default;
@@ -283,7 +693,8 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
    private:
     vector<cudaEvent_t> events_;
   };
-  int max_batch_size_, device_id_;
+  int max_batch_size_, device_id_, max_num_stream_;
+  int default_cuda_stream_priority_, urgent_cuda_stream_priority_;
   size_t bytes_per_sample_hint_;
 
   std::mutex cpu_memory_stats_mutex_;
@@ -292,6 +703,10 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
 
   cudaEvent_t mixed_stage_event_ = {};
   cudaEvent_t gpu_stage_event_ = {};
+  // op id -> event recorded after the last run of the mixed/GPU operator
+  std::vector<cudaEvent_t> mixed_op_done_events_, gpu_op_done_events_;
+  // recorded in the stream of the consumer of the released outputs
+  cudaEvent_t outputs_released_event_ = {};
 
   vector<string> output_names_;
 
@@ -336,8 +751,16 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
   mutable std::mutex errors_mutex_;
   bool exec_error_;
   QueueSizes queue_sizes_;
+  QueueSizes min_queue_sizes_;
   std::vector<tensor_data_store_queue_t> tensor_to_store_queue_;
-  CUDAStreamLease mixed_op_stream_, gpu_op_stream_;
+  // The streams of the stages: [0] - with the default priority, [1] - with the urgent priority,
+  // if it's different (see SetUrgentStreamPriority)
+  CUDAStreamLease mixed_op_streams_[2], gpu_op_streams_[2];
+  // The streams used by the current iteration of the stages (read by the other stages)
+  std::atomic<cudaStream_t> mixed_op_stream_{}, gpu_op_stream_{};
+  // If true, the mixed stage runs in gpu_op_stream_ and mixed_op_stream_ is not used, so that
+  // the GPU operators don't need to wait for the events of their inputs from the mixed stage
+  bool single_stream_ = false;
   // MixedOpId -> queue_idx -> cudaEvent_t
   // To introduce dependency from MIXED to GPU Ops
   MixedOpEventMap mixed_op_events_;
@@ -347,18 +770,126 @@ class DLL_PUBLIC Executor : public ExecutorBase, public QueuePolicy {
   std::vector<cudaEvent_t> mixed_callback_events_;
 
   std::atomic<bool> enable_memory_stats_;
+
+  bool enable_gpu_multi_stream_ = false;
+  // GPU op partition index -> lane; empty if all the GPU ops run on gpu_op_stream_
+  std::vector<int> gpu_op_lane_;
+  // GPU op partition index -> GPU ops on other lanes that it has to wait for
+  std::vector<std::vector<int>> gpu_op_cross_lane_deps_;
+  // GPU op partition index -> event recorded after the op, if it has cross-lane dependents
+  std::vector<cudaEvent_t> gpu_op_events_;
+  // streams for the lanes other than 0 and the events used to join them with gpu_op_stream_
+  std::vector<CUDAStreamLease> gpu_lane_streams_;
+  std::vector<cudaEvent_t> gpu_lane_join_events_;
+  cudaEvent_t gpu_lane_fork_event_ = {};
+
+  bool enable_gpu_graph_capture_ = false;
+  struct GPUStageGraph {
+    // shapes, types and addresses of the inputs and outputs of all the GPU operators
+    std::vector<int64_t> signature;
+    CUDAGraphExec exec;
+  };
+  // GPU queue index -> the graph of the GPU stage; empty if the GPU stage is not captured
+  std::vector<GPUStageGraph> gpu_stage_graphs_;
+
+  bool enable_gpu_memory_planning_ = false;
+  // tensor id -> arena index (-1 if the tensor has its own buffer); empty if not planned
+  std::vector<int> gpu_tensor_arena_;
+  std::vector<Tensor<GPUBackend>> gpu_arenas_;
+
+  struct InplaceJoin {
+    OpNodeId join = -1;
+    TensorNodeId output = -1;
+    /// The inputs, in the order of the join inputs
+    std::vector<TensorNodeId> inputs;
+    /// The memory of the output, prepared by PlaceInplaceJoinInputs for the current iteration
+    shared_ptr<void> buffer;
+    int64_t bytes = 0;
+  };
+  std::vector<InplaceJoin> gpu_inplace_joins_;
+  // tensor id -> the in-place join whose input or output it is (-1 if none); empty if not planned
+  std::vector<int> gpu_tensor_inplace_join_;
+
+  int gpu_micro_batch_size_ = 0;
+  struct MicroBatchChain {
+    /// The range of the GPU operators (partition indices) run in sub-batches
+    int first = 0, last = 0;
+  };
+  std::vector<MicroBatchChain> gpu_micro_chains_;
+  struct MicroBatchTensor {
+    /// If true, the tensor is consumed only within its chain and is stored in `sub_batch`
+    bool internal = false;
+    std::shared_ptr<TensorList<GPUBackend>> sub_batch;
+    /// The outputs of the sub-batches of the current iteration (only for external tensors)
+    std::vector<std::shared_ptr<TensorList<GPUBackend>>> parts;
+    /// The buffer for the parts in the current iteration and the number of bytes used
+    shared_ptr<void> buffer;
+    int64_t capacity = 0, used = 0;
+    /// The size of the whole output in the current iteration and the largest one seen
+    int64_t total_bytes = 0, max_total_bytes = 0;
+  };
+  std::vector<MicroBatchTensor> gpu_micro_tensors_;
+  // GPU op partition index -> micro-batched chain (-1 if none); empty if there are no chains
+  std::vector<int> gpu_op_micro_chain_;
+  // tensor id -> index in gpu_micro_tensors_ (-1 if none); empty if there are no chains
+  std::vector<int> gpu_tensor_micro_batch_;
+
+  // OpNodeId -> the arena for the temporary host allocations of the operator
+  std::vector<std::unique_ptr<mm::host_arena_resource>> host_arenas_;
+  std::mutex host_arena_stats_mutex_;
+  HostArenaStatsMap host_arena_stats_;
+
   ExecutorMetaMap cpu_memory_stats_, mixed_memory_stats_, gpu_memory_stats_;
 
+  std::atomic<bool> enable_timing_stats_{false};
+  std::mutex timing_stats_mutex_;
+  ExecutorTimingStats timing_stats_;
+  // (op partition index * stage queue depth + queue idx) -> events; created on first use and
+  // accessed only by the thread running the stage
+  std::vector<GPUOpTimingEvents> mixed_op_timing_events_, gpu_op_timing_events_;
+
+  struct ReaderMetrics {
+    metrics::Counter *samples = nullptr;
+    metrics::Counter *bytes = nullptr;
+  };
+  /// The value of the `pipeline` label of the metrics; assigned at the first Build
+  int metrics_id_ = -1;
+  metrics::Counter *batches_metric_ = nullptr;
+  // CPU OpPartitionId -> the counters of the reader; null for the other operators
+  std::vector<ReaderMetrics> cpu_reader_metrics_;
+  metrics::CollectorHandle queue_metrics_;
+
+  std::mutex bottleneck_analyzer_mutex_;
+  std::shared_ptr<BottleneckAnalyzer> bottleneck_analyzer_;
+
 
   /// Graph nodes, which define batch size for the entire graph
   std::vector<BatchSizeProvider *> batch_size_providers_;
 
   WorkspacePolicy ws_policy_;
 
- private:
   template <typename Workspace>
   void RunHelper(OpNode &op_node, Workspace &ws);
 
+  /**
+   * @brief Sets the default layouts of the inputs with no layout
+   *
+   * @return the indices of the inputs that need to have their layout restored after the
+   *         operator is run
+   */
+  template <typename Workspace>
+  SmallVector<int, 16> SetDefaultInputLayouts(OpNode &op_node, Workspace &ws);
+
+  template <typename Workspace>
+  void RestoreInputLayouts(Workspace &ws, const SmallVector<int, 16> &empty_layout_in_idxs);
+
+  /**
+   * @brief Runs the operator's Setup and allocates the outputs, if their shapes are known
+   */
+  template <typename Workspace>
+  void SetupOutputs(OpNode &op_node, Workspace &ws);
+
+ private:
   void RethrowError() const {
     std::lock_guard<std::mutex> errors_lock(errors_mutex_);
     // TODO(klecki): collect all errors
@@ -407,6 +938,73 @@ ExecutorMetaMap Executor<WorkspacePolicy, QueuePolicy>::GetExecutorMeta() {
   return ret;
 }
 
+template <typename WorkspacePolicy, typename QueuePolicy>
+ExecutorTimingStats Executor<WorkspacePolicy, QueuePolicy>::GetTimingStats() {
+  ExecutorTimingStats stats;
+  {
+    std::lock_guard<std::mutex> lck(timing_stats_mutex_);
+    stats = timing_stats_;
+  }
+  auto &cpu = stats.stages[static_cast<int>(OpType::CPU)];
+  for (auto *tp : CPUThreadPools()) {
+    cpu.num_threads += tp->NumThreads();
+    cpu.shared_pool_threads = std::max(cpu.shared_pool_threads, tp->NumSharedWorkers());
+  }
+  return stats;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::EnableBottleneckAnalysis(double interval_s) {
+  std::shared_ptr<BottleneckAnalyzer> analyzer;
+  if (interval_s > 0) {
+    analyzer = std::make_shared<BottleneckAnalyzer>(interval_s);
+    if (graph_)
+      analyzer->SetReaders(GetReaderNames());
+    enable_timing_stats_ = true;
+  }
+  std::lock_guard<std::mutex> lck(bottleneck_analyzer_mutex_);
+  bottleneck_analyzer_ = std::move(analyzer);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+BottleneckReport Executor<WorkspacePolicy, QueuePolicy>::GetBottleneckReport() {
+  std::lock_guard<std::mutex> lck(bottleneck_analyzer_mutex_);
+  return bottleneck_analyzer_ ? bottleneck_analyzer_->GetReport() : BottleneckReport{};
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+std::unordered_set<std::string> Executor<WorkspacePolicy, QueuePolicy>::GetReaderNames() const {
+  std::unordered_set<std::string> readers;
+  for (int i = 0; i < graph_->NumOp(OpType::CPU); i++) {
+    auto &node = graph_->Node(OpType::CPU, i);
+    if (node.op && static_cast<bool>(node.op->GetReaderMeta()))
+      readers.insert("CPU_" + node.instance_name);
+  }
+  return readers;
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::UpdateBottleneckAnalysis(int ready_outputs,
+                                                                      int64_t wait_ns) {
+  std::shared_ptr<BottleneckAnalyzer> analyzer;
+  {
+    std::lock_guard<std::mutex> lck(bottleneck_analyzer_mutex_);
+    analyzer = bottleneck_analyzer_;
+  }
+  if (!analyzer)
+    return;
+  analyzer->AddConsumerSample(ready_outputs, wait_ns);
+  int64_t now = BottleneckAnalyzer::now_ns();
+  if (analyzer->UpdateDue(now))
+    analyzer->Update(GetTimingStats(), now);
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+HostArenaStatsMap Executor<WorkspacePolicy, QueuePolicy>::GetHostArenaStats() {
+  std::lock_guard<std::mutex> lck(host_arena_stats_mutex_);
+  return host_arena_stats_;
+}
+
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::Build(OpGraph *graph, vector<string> output_names) {
   DALI_ENFORCE(graph != nullptr, "Input graph is nullptr.");
@@ -438,14 +1036,69 @@ void Executor<WorkspacePolicy, QueuePolicy>::Build(OpGraph *graph, vector<string
   // Setup stream and events that will be used for execution
   if (device_id_ != CPU_ONLY_DEVICE_ID) {
     DeviceGuard g(device_id_);
-    mixed_op_stream_ = CUDAStreamPool::instance().Get(device_id_);
-    gpu_op_stream_ = CUDAStreamPool::instance().Get(device_id_);
+    bool urgent = urgent_cuda_stream_priority_ != default_cuda_stream_priority_;
+    for (int i = 0; i < (urgent ? 2 : 1); i++) {
+      int priority = i ? urgent_cuda_stream_priority_ : default_cuda_stream_priority_;
+      if (!single_stream_)
+        mixed_op_streams_[i] = CUDAStreamPool::instance().Get(device_id_, priority);
+      gpu_op_streams_[i] = CUDAStreamPool::instance().Get(device_id_, priority);
+    }
+    // With a single stream, the consumer waits for every iteration
+    int initial = urgent && single_stream_ ? 1 : 0;
+    mixed_op_stream_ = static_cast<cudaStream_t>(mixed_op_streams_[initial]);
+    gpu_op_stream_ = static_cast<cudaStream_t>(gpu_op_streams_[initial]);
     mixed_op_events_ =
         CreateEventsForMixedOps(event_pool_, *graph_, stage_queue_depths_[OpType::MIXED]);
 
     // Create events used to synchronize stages using gpu with themselves
     mixed_stage_event_ = event_pool_.GetEvent();
     gpu_stage_event_ = event_pool_.GetEvent();
+    outputs_released_event_ = event_pool_.GetEvent();
+    mixed_op_done_events_.resize(graph_->NumOp(OpType::MIXED));
+    for (auto &event : mixed_op_done_events_)
+      event = event_pool_.GetEvent();
+    gpu_op_done_events_.resize(graph_->NumOp(OpType::GPU));
+    for (auto &event : gpu_op_done_events_)
+      event = event_pool_.GetEvent();
+
+    gpu_op_lane_.clear();
+    gpu_op_cross_lane_deps_.clear();
+    gpu_op_events_.clear();
+    gpu_lane_streams_.clear();
+    gpu_lane_join_events_.clear();
+    if (enable_gpu_multi_stream_)
+      SetupGPULanes();
+    if (!gpu_lane_streams_.empty())
+      gpu_lane_fork_event_ = event_pool_.GetEvent();
+
+    gpu_micro_chains_.clear();
+    gpu_micro_tensors_.clear();
+    gpu_op_micro_chain_.clear();
+    gpu_tensor_micro_batch_.clear();
+    // The sub-batches of a chain reuse the buffers, which relies on the order of a single stream
+    if (gpu_micro_batch_size_ > 0 && gpu_op_lane_.empty())
+      PlanMicroBatches(queue_sizes);
+
+    gpu_stage_graphs_.clear();
+    if (enable_gpu_graph_capture_ && CanCaptureGPUStage())
+      gpu_stage_graphs_.resize(stage_queue_depths_[OpType::GPU]);
+
+    gpu_tensor_arena_.clear();
+    gpu_arenas_.clear();
+    gpu_inplace_joins_.clear();
+    gpu_tensor_inplace_join_.clear();
+    // The lifetimes are based on the order of the operators, which holds only within a stream
+    if (enable_gpu_memory_planning_ && gpu_op_lane_.empty())
+      PlanGPUMemory(queue_sizes);
+  }
+
+  host_arenas_.clear();
+  host_arenas_.resize(graph_->NumOp());
+  for (int i = 0; i < graph_->NumOp(); i++) {
+    // the hint is the peak usage observed by a previous instance of the pipeline
+    size_t arena_hint = graph_->Node(i).spec.template GetArgument<int>("host_arena_size_hint");
+    host_arenas_[i] = std::make_unique<mm::host_arena_resource>(
+        mm::GetDefaultResource<mm::memory_kind::host>(), std::max<size_t>(arena_hint, 0x10000));
   }
 
   PrepinData(tensor_to_store_queue_, *graph_);
@@ -460,19 +1113,64 @@ void Executor<WorkspacePolicy, QueuePolicy>::Build(OpGraph *graph, vector<string
   // during execution (this is necessary for
   // asynchronous executors that can overlap work issue)
   ws_policy_.InitializeWorkspaceStore(*graph_, device_id_, tensor_to_store_queue_, &thread_pool_,
-                                      mixed_op_stream_, gpu_op_stream_, mixed_op_events_,
+                                      MixedOpStream(), gpu_op_stream_, mixed_op_events_,
                                       queue_sizes_);
 
   // Producer-consumer queues info
   SetupOutputQueuesForGraph();
 
   DiscoverBatchSizeProviders();
+
+  SetupMetrics();
+
+  {
+    std::lock_guard<std::mutex> lck(bottleneck_analyzer_mutex_);
+    if (bottleneck_analyzer_)
+      bottleneck_analyzer_->SetReaders(GetReaderNames());
+  }
 }
 
 
 template <typename WorkspacePolicy, typename QueuePolicy>
-void Executor<WorkspacePolicy, QueuePolicy>::ReleaseOutputs() {
+void Executor<WorkspacePolicy, QueuePolicy>::ReleaseOutputs(AccessOrder consumer_order) {
+  if (consumer_order.is_device() && device_id_ != CPU_ONLY_DEVICE_ID) {
+    // The stages overwrite the outputs only in their stage streams
+    // (the other GPU lanes are forked from gpu_op_stream_).
+    DeviceGuard g(device_id_);
+    CUDA_CALL(cudaEventRecord(outputs_released_event_, consumer_order.stream()));
+    for (auto *streams : { mixed_op_streams_, gpu_op_streams_ }) {
+      for (int i = 0; i < 2; i++) {
+        if (streams[i])
+          CUDA_CALL(cudaStreamWaitEvent(streams[i], outputs_released_event_, 0));
+      }
+    }
+  }
   QueuePolicy::ReleaseOutputIdxs();
+  ReleaseParkedBuffers();
+}
+
+template <typename WorkspacePolicy, typename QueuePolicy>
+void Executor<WorkspacePolicy, QueuePolicy>::ReleaseParkedBuffers() {
+  auto parked = QueuePolicy::TakeParkedIdxs();
+  if (std::all_of(parked.begin(), parked.end(), [](auto &idxs) { return idxs.empty(); }))
+    return;
+  DeviceGuard g(device_id_);
+  // Only the outputs of the pipeline have more than one buffer
+  for (auto tid : graph_->GetOutputs(output_names_, true)) {
+    auto &tensor = graph_->Tensor(tid);
+    auto op_type = graph_->Node(tensor.producer.node).op_type;
+    auto &idxs = parked[static_cast<int>(op_type)];
+    VALUE_SWITCH(tensor.producer.storage_device, storage_dev_static,
+        (StorageDevice::GPU, StorageDevice::CPU),
+    (
+      VALUE_SWITCH(op_type, op_type_static, (OpType::CPU, OpType::MIXED, OpType::GPU),
+      (
+        auto &queue = get_queue<op_type_static, storage_dev_static>(tensor_to_store_queue_[tid]);
+        for (int idx : idxs)
+          queue[idx]->Reset();
+      ), DALI_FAIL("Invalid op type"));  // NOLINT(whitespace/parens)
+    ), DALI_FAIL("Invalid storage device"));  // NOLINT(whitespace/parens)
+  }
 }
 
 template <typename WorkspacePolicy, typename QueuePolicy>
@@ -482,7 +1180,8 @@ void Executor<WorkspacePolicy, QueuePolicy>::Outputs(DeviceWorkspace *ws) {
 }
 
 template <typename WorkspacePolicy, typename QueuePolicy>
-void Executor<WorkspacePolicy, QueuePolicy>::ShareOutputs(DeviceWorkspace *ws) {
+void Executor<WorkspacePolicy, QueuePolicy>::ShareOutputs(DeviceWorkspace *ws,
+                                                          AccessOrder order) {
   DALI_ENFORCE(ws != nullptr, "Workspace is nullptr");
   DeviceGuard g(device_id_);
   ws->Clear();
@@ -490,6 +1189,8 @@ void Executor<WorkspacePolicy, QueuePolicy>::ShareOutputs(DeviceWorkspace *ws) {
   if (exec_error_ || QueuePolicy::IsStopSignaled())
     RethrowError();
 
+  int ready_outputs = QueuePolicy::NumReadyOutputs();
+  auto wait_start = std::chrono::steady_clock::now();
   auto output_idx = QueuePolicy::UseOutputIdxs();
 
   if (exec_error_ || QueuePolicy::IsStopSignaled())
@@ -511,6 +1212,13 @@ void Executor<WorkspacePolicy, QueuePolicy>::ShareOutputs(DeviceWorkspace *ws) {
         ws->AddOutput(queue[stage_output_idx]);
       ), DALI_FAIL("Invalid op type"));  // NOLINT(whitespace/parens)
     ), DALI_FAIL("Invalid storage device"));  // NOLINT(whitespace/parens)
+    // The parent event i signals the completion of the output i (none for the CPU outputs)
+    cudaEvent_t ready_event = nullptr;
+    if (storage_dev == StorageDevice::GPU && op_type == OpType::MIXED)
+      ready_event = mixed_output_events_.GetEvent(output_idx[OpType::MIXED]);
+    else if (storage_dev == StorageDevice::GPU && op_type == OpType::GPU)
+      ready_event = gpu_output_events_.GetEvent(output_idx[OpType::GPU]);
+    ws->AddParentEvent(ready_event);
   }
 
   // Mostly a sanity check - we don't want to return a non-contiguous batch to Python.
@@ -528,7 +1236,7 @@ void Executor<WorkspacePolicy, QueuePolicy>::ShareOutputs(DeviceWorkspace *ws) {
   // We than need to wait for GPU outputs from Mixed & GPU stages that are computed asynchronously.
   // If the output event list is not empty, it means that there are outputs on GPU that we
   // have to wait for.
-  AccessOrder sync_order = ws->has_stream() ? AccessOrder(ws->stream()) : AccessOrder::host();
+  AccessOrder sync_order = order.is_device() ? order : AccessOrder::host();
 
   if (!mixed_output_events_.empty()) {
     auto queue_idx = output_idx[OpType::MIXED];
@@ -538,6 +1246,8 @@ void Executor<WorkspacePolicy, QueuePolicy>::ShareOutputs(DeviceWorkspace *ws) {
     auto queue_idx = output_idx[OpType::GPU];
     sync_order.wait(gpu_output_events_.GetEvent(queue_idx));
   }
+
+  UpdateBottleneckAnalysis(ready_outputs, ElapsedNs(wait_start));
 }
 
 template <typename WorkspacePolicy, typename QueuePolicy>
@@ -743,6 +1453,21 @@ void Executor<WorkspacePolicy, QueuePolicy>::PresizeData(
             (StorageDevice::CPU, StorageDevice::GPU),
         (
           auto& queue = get_queue<op_type_static, dev_static>(tensor_to_store_queue[tensor.id]);
+          int arena = gpu_tensor_arena_.empty() ? -1 : gpu_tensor_arena_[tensor.id];
+          // the inputs of the in-place joins point into the output of the join, which shares
+          // a buffer allocated in each iteration
+          if (!gpu_tensor_inplace_join_.empty() && gpu_tensor_inplace_join_[tensor.id] >= 0)
+            continue;
+          // the micro-batched outputs are allocated per sub-batch and may be non-contiguous
+          if (!gpu_tensor_micro_batch_.empty() && gpu_tensor_micro_batch_[tensor.id] >= 0)
+            continue;
+          if (arena >= 0) {
+            // the arena is reserved for the largest of its tensors; they don't need their own
+            if (hint)
+              gpu_arenas_[arena].reserve(hint * max_batch_size_,
+                                         AccessOrder(static_cast<cudaStream_t>(gpu_op_stream_)));
+            continue;
+          }
           for (auto storage : queue) {
             // Historically, the Mixed stage (as well as GPU stage) always returned contiguous
             // outputs. Because, Mixed uses its own overloads of Run rather than RunImpl,
@@ -773,7 +1498,7 @@ std::vector<int> Executor<WorkspacePolicy, QueuePolicy>::GetMemoryHints(const Op
 
 template <typename WorkspacePolicy, typename QueuePolicy>
 void Executor<WorkspacePolicy, QueuePolicy>::SetupOutputQueuesForGraph() {
-  QueuePolicy::InitializeQueues(stage_queue_depths_);
+  QueuePolicy::InitializeQueues(stage_queue_depths_, QueuePolicy::GetQueueSizes(min_queue_sizes_));
 }
 
 using SimpleExecutor = Executor<AOT_WS_Policy<UniformQueuePolicy>, UniformQueuePolicy>;
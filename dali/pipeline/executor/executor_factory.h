@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019, 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -21,12 +21,36 @@
 #include "dali/pipeline/executor/pipelined_executor.h"
 #include "dali/pipeline/executor/async_pipelined_executor.h"
 #include "dali/pipeline/executor/async_separated_pipelined_executor.h"
+#include "dali/pipeline/executor/dataflow_executor.h"
+#include "dali/pipeline/executor/low_latency_executor.h"
 
 namespace dali {
 
 template <typename... Ts>
 std::unique_ptr<ExecutorBase> GetExecutor(bool pipelined, bool separated, bool async,
-                                          Ts... args) {
+                                          bool dataflow, bool low_latency, Ts... args) {
+  if (low_latency) {
+    if (!async && !separated && !pipelined && !dataflow)
+      return std::unique_ptr<ExecutorBase>{new LowLatencyExecutor(args...)};
+    std::stringstream error;
+    error << std::boolalpha;
+    error << "Low latency execution requires a synchronous, non-pipelined executor, got "
+          << "pipelined = " << pipelined << ", separated = " << separated << ", async = " << async
+          << ", dataflow = " << dataflow << std::endl;
+    DALI_FAIL(error.str());
+  }
+  if (dataflow) {
+    if (async && separated && pipelined) {
+      return std::unique_ptr<ExecutorBase>{new AsyncSeparatedDataflowPipelinedExecutor(args...)};
+    } else if (async && !separated && pipelined) {
+      return std::unique_ptr<ExecutorBase>{new AsyncDataflowPipelinedExecutor(args...)};
+    }
+    std::stringstream error;
+    error << std::boolalpha;
+    error << "Dataflow execution requires asynchronous pipelined executor, got pipelined = "
+          << pipelined << ", async = " << async << std::endl;
+    DALI_FAIL(error.str());
+  }
   if (async && separated && pipelined) {
     return std::unique_ptr<ExecutorBase>{new AsyncSeparatedPipelinedExecutor(args...)};
   } else if (async && !separated && pipelined) {
@@ -0,0 +1,104 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_EXECUTOR_STATS_H_
+#define DALI_PIPELINE_EXECUTOR_EXECUTOR_STATS_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "dali/core/common.h"
+#include "dali/core/mm/arena_resource.h"
+
+namespace dali {
+
+/**
+ * @brief Histogram of durations, with logarithmic buckets.
+ *
+ * Bucket 0 counts the durations shorter than 1 us, bucket i > 0 the durations
+ * in [2^(i-1), 2^i) us; the last bucket also counts all the longer durations.
+ */
+struct DLL_PUBLIC TimeHistogram {
+  static constexpr int kNumBuckets = 32;
+
+  static int Bucket(int64_t ns) {
+    int64_t us = ns / 1000;
+    int bucket = 0;
+    while (us > 0 && bucket < kNumBuckets - 1) {
+      us >>= 1;
+      bucket++;
+    }
+    return bucket;
+  }
+
+  void Add(int64_t ns) {
+    ns = std::max<int64_t>(ns, 0);
+    min_ns = count ? std::min(min_ns, ns) : ns;
+    max_ns = std::max(max_ns, ns);
+    total_ns += ns;
+    count++;
+    buckets[Bucket(ns)]++;
+  }
+
+  int64_t count = 0;
+  int64_t total_ns = 0;
+  int64_t min_ns = 0;
+  int64_t max_ns = 0;
+  std::array<int64_t, kNumBuckets> buckets = {};
+};
+
+struct DLL_PUBLIC OperatorTimingStats {
+  /// Host wall time of running the operator (including the setup and output allocation)
+  TimeHistogram host_time;
+  /// Time between the CUDA events recorded around the operator; only for mixed and GPU operators
+  TimeHistogram gpu_time;
+};
+
+struct DLL_PUBLIC StageTimingStats {
+  /// Time spent by the stage waiting for the buffers (queue indices) to work on
+  TimeHistogram queue_wait;
+  /// Host wall time of running (issuing the work of) the stage
+  TimeHistogram run_time;
+  /// Time spent by the threads of the CPU thread pool(s) executing work; only for the CPU stage
+  int64_t thread_pool_busy_ns = 0;
+  /// The number of threads multiplied by the run time of the stage; only for the CPU stage
+  int64_t thread_pool_capacity_ns = 0;
+  /// The number of threads of the CPU thread pool(s); only for the CPU stage
+  int num_threads = 0;
+  /**
+   * @brief The number of the process-wide worker threads the CPU thread pool(s) run on
+   *
+   * Non-zero only with ThreadPoolType::ProcessShared; only for the CPU stage.
+   */
+  int shared_pool_threads = 0;
+};
+
+/// Operator name (prefixed with the stage, as in ExecutorMetaMap) -> timing
+using OperatorTimingMap = std::unordered_map<std::string, OperatorTimingStats>;
+
+struct DLL_PUBLIC ExecutorTimingStats {
+  OperatorTimingMap operators;
+  /// Indexed with OpType
+  std::array<StageTimingStats, static_cast<int>(OpType::COUNT)> stages;
+};
+
+/// Operator name (prefixed with the stage, as in ExecutorMetaMap) -> usage of its host arena
+using HostArenaStatsMap = std::unordered_map<std::string, mm::arena_stats>;
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_EXECUTOR_STATS_H_
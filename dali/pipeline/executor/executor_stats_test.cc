@@ -0,0 +1,51 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include "dali/pipeline/executor/executor_stats.h"
+
+namespace dali {
+
+TEST(TimeHistogram, Bucket) {
+  EXPECT_EQ(TimeHistogram::Bucket(0), 0);
+  EXPECT_EQ(TimeHistogram::Bucket(999), 0);
+  EXPECT_EQ(TimeHistogram::Bucket(1000), 1);
+  EXPECT_EQ(TimeHistogram::Bucket(1999), 1);
+  EXPECT_EQ(TimeHistogram::Bucket(2000), 2);
+  EXPECT_EQ(TimeHistogram::Bucket(3999), 2);
+  EXPECT_EQ(TimeHistogram::Bucket(4000), 3);
+  EXPECT_EQ(TimeHistogram::Bucket(1024 * 1000), 11);
+  EXPECT_EQ(TimeHistogram::Bucket(INT64_MAX), TimeHistogram::kNumBuckets - 1);
+}
+
+TEST(TimeHistogram, Add) {
+  TimeHistogram h;
+  h.Add(5000);
+  h.Add(1500);
+  h.Add(100);
+  EXPECT_EQ(h.count, 3);
+  EXPECT_EQ(h.total_ns, 6600);
+  EXPECT_EQ(h.min_ns, 100);
+  EXPECT_EQ(h.max_ns, 5000);
+  EXPECT_EQ(h.buckets[0], 1);
+  EXPECT_EQ(h.buckets[1], 1);
+  EXPECT_EQ(h.buckets[3], 1);
+  int64_t total = 0;
+  for (auto b : h.buckets)
+    total += b;
+  EXPECT_EQ(total, h.count);
+}
+
+}  // namespace dali
@@ -22,6 +22,8 @@
 #include "dali/pipeline/executor/pipelined_executor.h"
 #include "dali/pipeline/executor/async_pipelined_executor.h"
 #include "dali/pipeline/executor/async_separated_pipelined_executor.h"
+#include "dali/pipeline/executor/dataflow_executor.h"
+#include "dali/pipeline/executor/low_latency_executor.h"
 #include "dali/test/dali_test_utils.h"
 #include "dali/test/tensor_test_utils.h"
 
@@ -77,7 +79,9 @@ class ExecutorTest : public GenericDecoderTest<RGB> {
 
 using ExecutorTypes =
     ::testing::Types<SimpleExecutor, PipelinedExecutor, SeparatedPipelinedExecutor,
-                     AsyncPipelinedExecutor, AsyncSeparatedPipelinedExecutor>;
+                     AsyncPipelinedExecutor, AsyncSeparatedPipelinedExecutor,
+                     AsyncDataflowPipelinedExecutor, AsyncSeparatedDataflowPipelinedExecutor,
+                     LowLatencyExecutor>;
 
 TYPED_TEST_SUITE(ExecutorTest, ExecutorTypes);
 
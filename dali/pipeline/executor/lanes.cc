@@ -0,0 +1,58 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cassert>
+#include <vector>
+
+#include "dali/pipeline/executor/lanes.h"
+
+namespace dali {
+
+std::vector<int> CoverWithLanes(const std::vector<std::vector<int>> &dependencies) {
+  int nops = dependencies.size();
+
+  // The operators are in topological order, so the ancestors can be computed in a single pass
+  std::vector<std::vector<bool>> is_ancestor(nops, std::vector<bool>(nops, false));
+  for (int op = 0; op < nops; op++) {
+    for (int dep : dependencies[op]) {
+      assert(dep < op && "The operators should be topologically sorted");
+      is_ancestor[op][dep] = true;
+      for (int a = 0; a < dep; a++) {
+        if (is_ancestor[dep][a])
+          is_ancestor[op][a] = true;
+      }
+    }
+  }
+
+  // Greedy chain cover - append the operator to the lane whose last operator is the most
+  // recent ancestor or start a new lane, if there's none.
+  std::vector<int> lane(nops, -1);
+  std::vector<int> lane_last;
+  for (int op = 0; op < nops; op++) {
+    int best = -1;
+    for (int l = 0; l < static_cast<int>(lane_last.size()); l++) {
+      if (is_ancestor[op][lane_last[l]] && (best < 0 || lane_last[l] > lane_last[best]))
+        best = l;
+    }
+    if (best < 0) {
+      best = lane_last.size();
+      lane_last.push_back(op);
+    }
+    lane_last[best] = op;
+    lane[op] = best;
+  }
+  return lane;
+}
+
+}  // namespace dali
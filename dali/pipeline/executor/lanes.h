@@ -0,0 +1,40 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_LANES_H_
+#define DALI_PIPELINE_EXECUTOR_LANES_H_
+
+#include <vector>
+
+#include "dali/core/api_helper.h"
+
+namespace dali {
+
+/**
+ * @brief Covers a dependency graph of operators with chains (lanes).
+ *
+ * Within a lane, each operator is an ancestor of the next one, so the operators from the same
+ * lane never run concurrently and can share an execution resource (a thread pool, a stream).
+ *
+ * @param dependencies for each operator, the list of operators it directly depends on;
+ *                     the operators must be in topological order (each dependency of `op`
+ *                     is less than `op`)
+ * @return the lane index for each operator; the lanes are numbered from 0 in order of
+ *         their first operator
+ */
+DLL_PUBLIC std::vector<int> CoverWithLanes(const std::vector<std::vector<int>> &dependencies);
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_LANES_H_
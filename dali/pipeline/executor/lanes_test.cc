@@ -0,0 +1,46 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "dali/pipeline/executor/lanes.h"
+
+namespace dali {
+
+TEST(CoverWithLanes, Empty) {
+  EXPECT_TRUE(CoverWithLanes({}).empty());
+}
+
+TEST(CoverWithLanes, Chain) {
+  EXPECT_EQ(CoverWithLanes({{}, {0}, {1}, {2}}), std::vector<int>({0, 0, 0, 0}));
+}
+
+TEST(CoverWithLanes, Independent) {
+  EXPECT_EQ(CoverWithLanes({{}, {}, {}}), std::vector<int>({0, 1, 2}));
+}
+
+TEST(CoverWithLanes, Diamond) {
+  // 0 -> 1 -> 3, 0 -> 2 -> 3
+  auto lanes = CoverWithLanes({{}, {0}, {0}, {1, 2}});
+  EXPECT_EQ(lanes, std::vector<int>({0, 0, 1, 1}));
+}
+
+TEST(CoverWithLanes, TransitiveAncestor) {
+  // 3 depends on 0 only through 2 - it can follow 2, which is the most recent ancestor
+  auto lanes = CoverWithLanes({{}, {}, {0}, {2}, {1}});
+  EXPECT_EQ(lanes, std::vector<int>({0, 1, 0, 0, 1}));
+}
+
+}  // namespace dali
@@ -0,0 +1,52 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_LOW_LATENCY_EXECUTOR_H_
+#define DALI_PIPELINE_EXECUTOR_LOW_LATENCY_EXECUTOR_H_
+
+#include "dali/pipeline/executor/executor.h"
+
+namespace dali {
+
+/**
+ * @brief An executor for small batches, where the per-iteration overhead of the executor
+ * dominates the time of the operators.
+ *
+ * Like the SimpleExecutor, it runs the stages on the calling thread, one after another, and uses
+ * the thread pool only within the CPU operators. Moreover:
+ *  - there's a single buffer per output (the prefetch queue depth is ignored), so that an
+ *    iteration is never queued behind the previous ones;
+ *  - the mixed and the GPU stages run in one CUDA stream, so the GPU operators don't wait
+ *    for the events of their inputs from the mixed stage.
+ */
+class DLL_PUBLIC LowLatencyExecutor : public SimpleExecutor {
+ public:
+  DLL_PUBLIC inline LowLatencyExecutor(int max_batch_size, int num_thread, int device_id,
+                                       size_t bytes_per_sample_hint, bool set_affinity = false,
+                                       int max_num_stream = -1,
+                                       int default_cuda_stream_priority = 0,
+                                       QueueSizes prefetch_queue_depth = QueueSizes{1, 1},
+                                       ThreadPoolType thread_pool_type =
+                                           ThreadPoolType::SharedQueue)
+      : SimpleExecutor(max_batch_size, num_thread, device_id, bytes_per_sample_hint, set_affinity,
+                       max_num_stream, default_cuda_stream_priority, QueueSizes{1, 1},
+                       thread_pool_type) {
+    (void)prefetch_queue_depth;
+    single_stream_ = true;
+  }
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_LOW_LATENCY_EXECUTOR_H_
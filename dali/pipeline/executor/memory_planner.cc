@@ -0,0 +1,79 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "dali/pipeline/executor/memory_planner.h"
+
+namespace dali {
+
+std::vector<int> AssignArenas(const std::vector<LiveRange> &ranges) {
+  int nbuffers = ranges.size();
+  std::vector<int> order(nbuffers);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return ranges[a].first < ranges[b].first;
+  });
+
+  // Greedy interval coloring - in order of the producers, take the arena which was released
+  // most recently (it's the most likely to be already large enough) or add a new one.
+  std::vector<int> arena(nbuffers, -1);
+  std::vector<int> arena_last;
+  for (int b : order) {
+    if (ranges[b].first < 0)
+      continue;
+    int best = -1;
+    for (int a = 0; a < static_cast<int>(arena_last.size()); a++) {
+      if (arena_last[a] < ranges[b].first && (best < 0 || arena_last[a] > arena_last[best]))
+        best = a;
+    }
+    if (best < 0) {
+      best = arena_last.size();
+      arena_last.push_back(-1);
+    }
+    arena_last[best] = std::max(ranges[b].first, ranges[b].last);
+    arena[b] = best;
+  }
+  return arena;
+}
+
+bool IsOutermostJoin(const OpSpec &spec) {
+  bool stack = spec.name() == "Stack";
+  if (!stack && spec.name() != "Cat")
+    return false;
+  // `axis_name` denotes the concatenation axis, but only the new axis when stacking
+  if (!stack && spec.HasArgument("axis_name"))
+    return false;
+  return spec.NumRegularInput() > 1 && spec.GetArgument<int>("axis") == 0;
+}
+
+std::vector<std::vector<int64_t>> JoinedSampleOffsets(
+    const std::vector<std::vector<int64_t>> &sample_bytes, int64_t &total_bytes) {
+  std::vector<std::vector<int64_t>> offsets(sample_bytes.size());
+  int nsamples = sample_bytes.empty() ? 0 : sample_bytes[0].size();
+  for (auto &input_offsets : offsets)
+    input_offsets.resize(nsamples);
+  total_bytes = 0;
+  for (int s = 0; s < nsamples; s++) {
+    for (size_t i = 0; i < sample_bytes.size(); i++) {
+      offsets[i][s] = total_bytes;
+      total_bytes += sample_bytes[i][s];
+    }
+  }
+  return offsets;
+}
+
+}  // namespace dali
@@ -0,0 +1,66 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_EXECUTOR_MEMORY_PLANNER_H_
+#define DALI_PIPELINE_EXECUTOR_MEMORY_PLANNER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "dali/core/api_helper.h"
+#include "dali/pipeline/operator/op_spec.h"
+
+namespace dali {
+
+/**
+ * @brief The operators (by their index in the stage) using a buffer: from the one that
+ *        produces it to the last one that consumes it.
+ */
+struct LiveRange {
+  int first = -1, last = -1;
+};
+
+/**
+ * @brief Assigns the buffers to arenas, so that the buffers in the same arena are never
+ *        live at the same time.
+ *
+ * A buffer can reuse an arena only after the last consumer of the previous buffer in that
+ * arena - an operator never writes to the memory of its own inputs.
+ *
+ * @param ranges the live range of each buffer; the buffers with a negative `first` are not
+ *               assigned to any arena
+ * @return the arena index for each buffer (-1 if not assigned); the arenas are numbered from 0
+ */
+DLL_PUBLIC std::vector<int> AssignArenas(const std::vector<LiveRange> &ranges);
+
+/**
+ * @brief Checks if the operator joins its inputs along the outermost axis (`Cat` or `Stack`
+ *        with `axis` 0), so that each output sample consists of the respective input samples,
+ *        one after another.
+ */
+DLL_PUBLIC bool IsOutermostJoin(const OpSpec &spec);
+
+/**
+ * @brief Places the samples of the inputs of an outermost join in its contiguous output.
+ *
+ * @param sample_bytes the size of the samples of each input, in bytes
+ * @param total_bytes  the size of the output
+ * @return the offsets of the samples of each input in the output, in bytes
+ */
+DLL_PUBLIC std::vector<std::vector<int64_t>> JoinedSampleOffsets(
+    const std::vector<std::vector<int64_t>> &sample_bytes, int64_t &total_bytes);
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_EXECUTOR_MEMORY_PLANNER_H_
@@ -0,0 +1,76 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "dali/pipeline/executor/memory_planner.h"
+
+namespace dali {
+
+TEST(AssignArenas, Empty) {
+  EXPECT_TRUE(AssignArenas({}).empty());
+}
+
+TEST(AssignArenas, Chain) {
+  // 0 -> 1 -> 2 -> 3 - every other buffer can share the memory
+  auto arenas = AssignArenas({{0, 1}, {1, 2}, {2, 3}, {3, 4}});
+  EXPECT_EQ(arenas, std::vector<int>({0, 1, 0, 1}));
+}
+
+TEST(AssignArenas, Unplanned) {
+  auto arenas = AssignArenas({{0, 1}, {-1, -1}, {2, 3}});
+  EXPECT_EQ(arenas, std::vector<int>({0, -1, 0}));
+}
+
+TEST(AssignArenas, SameProducer) {
+  // the outputs of one operator are live at the same time, even if not consumed
+  auto arenas = AssignArenas({{0, 0}, {0, 0}, {1, 2}});
+  EXPECT_EQ(arenas, std::vector<int>({0, 1, 0}));
+}
+
+TEST(AssignArenas, LongLived) {
+  // buffer 0 is used by the last operator - the others can't reuse its arena
+  auto arenas = AssignArenas({{0, 5}, {1, 2}, {2, 3}, {3, 4}, {4, 5}});
+  EXPECT_EQ(arenas, std::vector<int>({0, 1, 2, 1, 2}));
+}
+
+TEST(AssignArenas, UnsortedProducers) {
+  auto arenas = AssignArenas({{3, 4}, {0, 2}, {1, 3}});
+  EXPECT_EQ(arenas, std::vector<int>({0, 0, 1}));
+}
+
+TEST(IsOutermostJoin, Specs) {
+  auto join = [](const std::string &name) {
+    return OpSpec(name).AddArg("device", "gpu").AddInput("a", "gpu").AddInput("b", "gpu");
+  };
+  EXPECT_TRUE(IsOutermostJoin(join("Cat")));
+  EXPECT_TRUE(IsOutermostJoin(join("Stack")));
+  EXPECT_TRUE(IsOutermostJoin(join("Stack").AddArg("axis_name", "C")));
+  EXPECT_FALSE(IsOutermostJoin(join("Cat").AddArg("axis", 1)));
+  EXPECT_FALSE(IsOutermostJoin(join("Stack").AddArg("axis", 2)));
+  EXPECT_FALSE(IsOutermostJoin(join("Cat").AddArg("axis_name", "H")));
+  EXPECT_FALSE(IsOutermostJoin(join("Copy")));
+  EXPECT_FALSE(IsOutermostJoin(OpSpec("Cat").AddArg("device", "gpu").AddInput("a", "gpu")));
+}
+
+TEST(JoinedSampleOffsets, Interleaved) {
+  int64_t total = -1;
+  auto offsets = JoinedSampleOffsets({{4, 8}, {2, 0}, {6, 10}}, total);
+  EXPECT_EQ(total, 30);
+  EXPECT_EQ(offsets, (std::vector<std::vector<int64_t>>{{0, 12}, {4, 20}, {6, 20}}));
+}
+
+}  // namespace dali
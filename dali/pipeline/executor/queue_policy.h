@@ -1,4 +1,4 @@
-// Copyright (c) 2019-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,8 +16,11 @@
 #define DALI_PIPELINE_EXECUTOR_QUEUE_POLICY_H_
 
 #include <cuda_runtime_api.h>
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <queue>
@@ -34,6 +37,8 @@ namespace dali {
 //   static StageQueues GetQueueSizes(QueueSizes init_sizes);
 //   // Initialize the policy during Executor::Build();
 //   void InitializeQueues(const StageQueues &stage_queue_depths);
+//   // Initialize the policy with depths adapted between min_depths and stage_queue_depths
+//   void InitializeQueues(const StageQueues &stage_queue_depths, const StageQueues &min_depths);
 //   // Acquire Queue indexes for given stage
 //   QueueIdxs AcquireIdxs(OpType stage);
 //   // Finish stage and release the indexes. Not called by the last stage, as it "returns" outputs
@@ -46,6 +51,12 @@ namespace dali {
 //   OutputIdxs UseOutputIdxs();
 //   // Release currently used output
 //   void ReleaseOutputIdxs();
+//   // Get the indexes of the buffers (per stage) that were taken out of use since the last call
+//   ParkedIdxs TakeParkedIdxs();
+//   // Get the number of buffers that are currently used for the CPU and GPU stages
+//   QueueSizes GetCurrentQueueSizes() const;
+//   // Get the number of outputs which are ready, but not yet used
+//   int NumReadyOutputs();
 //   // Wake all waiting threads and skip further execution due to stop signaled
 //   void SignalStop();
 //   // Returns true if we signaled stop previously
@@ -53,6 +64,138 @@ namespace dali {
 // };
 
 
+/**
+ * @brief Chooses the number of buffers used by a stage, based on the time spent waiting
+ *        by the producer (for a free buffer) and by the consumer (for a ready buffer).
+ *
+ * The waits are accumulated over a window of iterations. If both sides had to wait, the
+ * execution time is uneven and a deeper queue can absorb it - the depth is increased.
+ * If only the producer waited, the queue is always full and the depth is decreased.
+ * The depth is kept within [min_depth, max_depth]; if they are equal, nothing is measured.
+ */
+class QueueDepthController {
+ public:
+  static constexpr int kWindow = 16;
+  // Average wait per iteration that is considered significant
+  static constexpr int64_t kWaitThresholdNs = 100 * 1000;
+
+  void Initialize(int min_depth, int max_depth) {
+    DALI_ENFORCE(min_depth > 0 && min_depth <= max_depth,
+                 make_string("Invalid queue depth bounds: [", min_depth, ", ", max_depth, "]."));
+    min_depth_ = min_depth;
+    max_depth_ = max_depth;
+    depth_ = max_depth;
+    iterations_ = 0;
+    warmup_ = true;
+    producer_wait_ns_ = 0;
+    consumer_wait_ns_ = 0;
+  }
+
+  bool IsAdaptive() const {
+    return min_depth_ < max_depth_;
+  }
+
+  int Depth() const {
+    return depth_;
+  }
+
+  /**
+   * @brief Waits on the condition variable, accounting the time spent as producer's
+   *        or consumer's wait.
+   */
+  template <typename Predicate>
+  void Wait(std::condition_variable &cv, std::unique_lock<std::mutex> &lock, Predicate pred,
+            bool producer) {
+    if (!IsAdaptive() || pred()) {
+      cv.wait(lock, pred);
+      return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    cv.wait(lock, pred);
+    int64_t waited = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    (producer ? producer_wait_ns_ : consumer_wait_ns_) += waited;
+  }
+
+  /**
+   * @brief Called once per iteration. Returns the change of the depth: -1, 0 or 1.
+   */
+  int Update() {
+    if (!IsAdaptive() || ++iterations_ < kWindow)
+      return 0;
+    iterations_ = 0;
+    int64_t producer_wait = producer_wait_ns_.exchange(0);
+    int64_t consumer_wait = consumer_wait_ns_.exchange(0);
+    // The first window contains the prefetching, which is not representative
+    if (warmup_) {
+      warmup_ = false;
+      return 0;
+    }
+    bool producer_waited = producer_wait > kWindow * kWaitThresholdNs;
+    bool consumer_waited = consumer_wait > kWindow * kWaitThresholdNs;
+    if (producer_waited && consumer_waited && depth_ < max_depth_) {
+      depth_++;
+      return 1;
+    }
+    if (producer_waited && !consumer_waited && depth_ > min_depth_) {
+      depth_--;
+      return -1;
+    }
+    return 0;
+  }
+
+ private:
+  int min_depth_ = 1, max_depth_ = 1;
+  std::atomic<int> depth_ = {1};
+  int iterations_ = 0;
+  bool warmup_ = true;
+  std::atomic<int64_t> producer_wait_ns_ = {0}, consumer_wait_ns_ = {0};
+};
+
+/**
+ * @brief Buffers of a stage that are taken out of circulation when its queue depth decreases.
+ *
+ * The buffers are not removed immediately - the next released ones are parked instead of being
+ * returned to the free queue. Must be accessed under the lock of the corresponding free queue.
+ */
+struct ParkedBuffers {
+  // Returns true if the buffer should be parked instead of being returned to the free queue
+  bool Park(int idx) {
+    if (pending == 0)
+      return false;
+    pending--;
+    parked.push_back(idx);
+    newly_parked.push_back(idx);
+    return true;
+  }
+
+  // Returns the buffer that should be returned to the free queue or -1
+  int Unpark() {
+    if (pending > 0) {
+      pending--;
+      return -1;
+    }
+    assert(!parked.empty());
+    int idx = parked.back();
+    parked.pop_back();
+    newly_parked.erase(std::remove(newly_parked.begin(), newly_parked.end(), idx),
+                       newly_parked.end());
+    return idx;
+  }
+
+  std::vector<int> TakeNewlyParked() {
+    std::vector<int> ret;
+    std::swap(ret, newly_parked);
+    return ret;
+  }
+
+  int pending = 0;
+  std::vector<int> parked, newly_parked;
+};
+
+// Stage -> queue indexes
+using ParkedIdxs = std::array<std::vector<int>, static_cast<int>(OpType::COUNT)>;
+
 // Each stage requires ready buffers from previous stage and free buffers from current stage
 struct UniformQueuePolicy {
   static const int kInvalidIdx = -1;
@@ -64,6 +207,10 @@ struct UniformQueuePolicy {
   }
 
   void InitializeQueues(const StageQueues &stage_queue_depths) {
+    InitializeQueues(stage_queue_depths, stage_queue_depths);
+  }
+
+  void InitializeQueues(const StageQueues &stage_queue_depths, const StageQueues &min_depths) {
     DALI_ENFORCE(
         stage_queue_depths[OpType::CPU] == stage_queue_depths[OpType::MIXED] &&
             stage_queue_depths[OpType::MIXED] == stage_queue_depths[OpType::GPU],
@@ -73,15 +220,16 @@ struct UniformQueuePolicy {
     for (int i = 0; i < stage_queue_depths[OpType::CPU]; ++i) {
       free_queue_.push(i);
     }
+    depth_controller_.Initialize(min_depths[OpType::CPU], stage_queue_depths[OpType::CPU]);
   }
 
   QueueIdxs AcquireIdxs(OpType stage) {
     if (!HasPreviousStage(stage)) {
       // Block until there is a free buffer to use
       std::unique_lock<std::mutex> lock(free_mutex_);
-      free_cond_.wait(lock, [stage, this]() {
+      depth_controller_.Wait(free_cond_, lock, [stage, this]() {
         return !free_queue_.empty() || stage_work_stop_[static_cast<int>(stage)];
-      });
+      }, true);
       if (stage_work_stop_[static_cast<int>(stage)]) {
         return QueueIdxs{kInvalidIdx};  // We return anything due to exec error
       }
@@ -136,9 +284,9 @@ struct UniformQueuePolicy {
     // Block until the work for a batch has been issued.
     // Move the queue id from ready to in_use
     std::unique_lock<std::mutex> lock(ready_mutex_);
-    ready_cond_.wait(lock, [this]() {
+    depth_controller_.Wait(ready_cond_, lock, [this]() {
       return !ready_queue_.empty() || ready_stop_;
-    });
+    }, false);
     if (ready_stop_) {
       return OutputIdxs{kInvalidIdx};
     }
@@ -157,13 +305,39 @@ struct UniformQueuePolicy {
     if (!in_use_queue_.empty()) {
       {
         std::lock_guard<std::mutex> lock(free_mutex_);
-        free_queue_.push(in_use_queue_.front());
+        int idx = in_use_queue_.front();
         in_use_queue_.pop();
+        if (!parked_.Park(idx))
+          free_queue_.push(idx);
+        int change = depth_controller_.Update();
+        if (change < 0) {
+          parked_.pending++;
+        } else if (change > 0) {
+          int unparked = parked_.Unpark();
+          if (unparked != kInvalidIdx)
+            free_queue_.push(unparked);
+        }
       }
       free_cond_.notify_one();
     }
   }
 
+  ParkedIdxs TakeParkedIdxs() {
+    std::lock_guard<std::mutex> lock(free_mutex_);
+    // All the stages share the queue indexes
+    auto idxs = parked_.TakeNewlyParked();
+    return {{idxs, idxs, idxs}};
+  }
+
+  int NumReadyOutputs() {
+    std::lock_guard<std::mutex> lock(ready_mutex_);
+    return ready_queue_.size();
+  }
+
+  QueueSizes GetCurrentQueueSizes() const {
+    return QueueSizes(depth_controller_.Depth());
+  }
+
   void NotifyAll() {
     ready_cond_.notify_all();
     free_cond_.notify_all();
@@ -196,6 +370,10 @@ struct UniformQueuePolicy {
   std::mutex ready_mutex_, free_mutex_;
   std::condition_variable ready_cond_, free_cond_;
 
+  // The producer is the CPU stage, the consumer is the user
+  QueueDepthController depth_controller_;
+  ParkedBuffers parked_;
+
   static const int kOpCount = static_cast<int>(OpType::COUNT);
   std::array<std::queue<int>, kOpCount> stage_work_queue_;
   std::array<std::mutex, kOpCount> stage_work_mutex_;
@@ -225,11 +403,18 @@ struct SeparateQueuePolicy {
   }
 
   void InitializeQueues(const StageQueues &stage_queue_depths) {
+    InitializeQueues(stage_queue_depths, stage_queue_depths);
+  }
+
+  void InitializeQueues(const StageQueues &stage_queue_depths, const StageQueues &min_depths) {
     for (int stage = 0; stage < static_cast<int>(OpType::COUNT); stage++) {
       for (int i = 0; i < stage_queue_depths[static_cast<OpType>(stage)]; i++) {
         stage_free_[stage].push(i);
       }
     }
+    cpu_depth_controller_.Initialize(min_depths[OpType::CPU], stage_queue_depths[OpType::CPU]);
+    // Mixed and GPU buffers are released together, so they share the depth
+    gpu_depth_controller_.Initialize(min_depths[OpType::GPU], stage_queue_depths[OpType::GPU]);
   }
 
   QueueIdxs AcquireIdxs(OpType stage) {
@@ -242,9 +427,17 @@ struct SeparateQueuePolicy {
     if (HasPreviousStage(stage)) {
       previous_stage = static_cast<int>(PreviousStage(stage));
       std::unique_lock<std::mutex> ready_previous_lock(stage_ready_mutex_[previous_stage]);
-      stage_ready_cv_[previous_stage].wait(ready_previous_lock, [previous_stage, this]() {
+      auto ready_pred = [previous_stage, this]() {
         return !stage_ready_[previous_stage].empty() || stage_ready_stop_[previous_stage];
-      });
+      };
+      // The mixed stage is the consumer of the CPU queue, while the wait between the mixed
+      // and the GPU stages doesn't depend on the queue depth
+      if (previous_stage == static_cast<int>(OpType::CPU)) {
+        cpu_depth_controller_.Wait(stage_ready_cv_[previous_stage], ready_previous_lock,
+                                   ready_pred, false);
+      } else {
+        stage_ready_cv_[previous_stage].wait(ready_previous_lock, ready_pred);
+      }
       if (stage_ready_stop_[previous_stage]) {
         return QueueIdxs{kInvalidIdx};
       }
@@ -256,9 +449,10 @@ struct SeparateQueuePolicy {
     // There always is a current stage
     {
       std::unique_lock<std::mutex> free_current_lock(stage_free_mutex_[current_stage]);
-      stage_free_cv_[current_stage].wait(free_current_lock, [current_stage, this]() {
+      DepthController(stage).Wait(stage_free_cv_[current_stage], free_current_lock,
+                                  [current_stage, this]() {
         return !stage_free_[current_stage].empty() || stage_free_stop_[current_stage];
-      });
+      }, true);
       if (stage_free_stop_[current_stage]) {
         return QueueIdxs{kInvalidIdx};
       }
@@ -305,9 +499,9 @@ struct SeparateQueuePolicy {
     // Block until the work for a batch has been issued.
     // Move the queue id from ready to in_use
     std::unique_lock<std::mutex> ready_lock(ready_output_mutex_);
-    ready_output_cv_.wait(ready_lock, [this]() {
+    gpu_depth_controller_.Wait(ready_output_cv_, ready_lock, [this]() {
       return !ready_output_queue_.empty() || ready_stop_;
-    });
+    }, false);
     if (ready_stop_) {
       return OutputIdxs{kInvalidIdx, kInvalidIdx, kInvalidIdx};
     }
@@ -328,12 +522,32 @@ struct SeparateQueuePolicy {
       // python calls
       auto processed = in_use_queue_.front();
       in_use_queue_.pop();
-      ReleaseStageIdx(OpType::CPU, processed.cpu);
-      ReleaseStageIdx(OpType::MIXED, processed.mixed);
-      ReleaseStageIdx(OpType::GPU, processed.gpu);
+      int cpu_depth_change = cpu_depth_controller_.Update();
+      int gpu_depth_change = gpu_depth_controller_.Update();
+      ReleaseStageIdx(OpType::CPU, processed.cpu, cpu_depth_change);
+      ReleaseStageIdx(OpType::MIXED, processed.mixed, gpu_depth_change);
+      ReleaseStageIdx(OpType::GPU, processed.gpu, gpu_depth_change);
     }
   }
 
+  ParkedIdxs TakeParkedIdxs() {
+    ParkedIdxs result;
+    for (int stage = 0; stage < static_cast<int>(OpType::COUNT); stage++) {
+      std::lock_guard<std::mutex> free_lock(stage_free_mutex_[stage]);
+      result[stage] = stage_parked_[stage].TakeNewlyParked();
+    }
+    return result;
+  }
+
+  int NumReadyOutputs() {
+    std::lock_guard<std::mutex> lock(ready_output_mutex_);
+    return ready_output_queue_.size();
+  }
+
+  QueueSizes GetCurrentQueueSizes() const {
+    return QueueSizes(cpu_depth_controller_.Depth(), gpu_depth_controller_.Depth());
+  }
+
   void NotifyAll() {
     ready_output_cv_.notify_all();
     free_cond_.notify_all();
@@ -372,12 +586,25 @@ struct SeparateQueuePolicy {
   }
 
  private:
-  void ReleaseStageIdx(OpType stage, int idx) {
+  QueueDepthController &DepthController(OpType stage) {
+    return stage == OpType::CPU ? cpu_depth_controller_ : gpu_depth_controller_;
+  }
+
+  void ReleaseStageIdx(OpType stage, int idx, int depth_change = 0) {
     auto released_stage = static_cast<int>(stage);
-    // We release the consumed buffer
+    // We release the consumed buffer, unless the queue is being shrunk
     {
       std::lock_guard<std::mutex> free_lock(stage_free_mutex_[released_stage]);
-      stage_free_[released_stage].push(idx);
+      auto &parked = stage_parked_[released_stage];
+      if (!parked.Park(idx))
+        stage_free_[released_stage].push(idx);
+      if (depth_change < 0) {
+        parked.pending++;
+      } else if (depth_change > 0) {
+        int unparked = parked.Unpark();
+        if (unparked != kInvalidIdx)
+          stage_free_[released_stage].push(unparked);
+      }
     }
     // We freed buffer, so we notfiy the released stage it can continue it's work
     stage_free_cv_[released_stage].notify_one();
@@ -417,6 +644,11 @@ struct SeparateQueuePolicy {
 
   std::queue<OutputIdxs> ready_output_queue_;
   std::queue<OutputIdxs> in_use_queue_;
+
+  // The CPU queue is consumed by the mixed stage, the mixed and GPU queues by the user.
+  QueueDepthController cpu_depth_controller_, gpu_depth_controller_;
+  // Guarded by the corresponding stage_free_mutex_
+  std::array<ParkedBuffers, kOpCount> stage_parked_;
 };
 
 
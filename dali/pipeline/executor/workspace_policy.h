@@ -15,11 +15,15 @@
 #ifndef DALI_PIPELINE_EXECUTOR_WORKSPACE_POLICY_H_
 #define DALI_PIPELINE_EXECUTOR_WORKSPACE_POLICY_H_
 
+#include <algorithm>
 #include <vector>
 #include <memory>
+#include <string>
+#include <utility>
 
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
+#include "dali/core/small_vector.h"
 #include "dali/pipeline/executor/queue_metadata.h"
 #include "dali/pipeline/graph/op_graph.h"
 #include "dali/pipeline/graph/op_graph_storage.h"
@@ -109,10 +113,17 @@ void SetupInputOutput(op_type_to_workspace_t<op_type> &ws, const OpGraph &graph,
     ), DALI_FAIL("Unexpected op_type"));  // NOLINT(whitespace/parens)
   }
 
-  // Argument inputs can be handled genericaly
-  for (const auto &arg_pair : node.spec.ArgumentInputs()) {
+  // Argument inputs can be handled genericaly.
+  // They're added in the order of their input indices, so that they can be accessed
+  // by OpSpec::ArgumentInputSlot.
+  SmallVector<std::pair<int, const std::string *>, 8> arg_inputs;
+  for (const auto &arg_pair : node.spec.ArgumentInputs())
+    arg_inputs.emplace_back(arg_pair.second, &arg_pair.first);
+  std::sort(arg_inputs.begin(), arg_inputs.end());
+  for (const auto &arg_input : arg_inputs) {
     // Get each argument input and add them to this op's workspace.
-    auto input_index = arg_pair.second;
+    auto input_index = arg_input.first;
+    const std::string &arg_name = *arg_input.second;
     auto tid = node.parent_tensors[input_index];
     auto &parent_node = graph.Node(graph.Tensor(tid).producer.node);
     auto parent_op_type = parent_node.op_type;
@@ -123,7 +134,7 @@ void SetupInputOutput(op_type_to_workspace_t<op_type> &ws, const OpGraph &graph,
 
     auto add_arg_input = [&](auto &queue) {
       auto tensor = queue[idxs[parent_op_type]];
-      ws.AddArgumentInput(arg_pair.first, tensor);
+      ws.AddArgumentInput(arg_name, tensor);
     };
     switch (parent_op_type) {
       case OpType::CPU:
@@ -0,0 +1,329 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/graph/device_placement.h"
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+namespace {
+
+constexpr double kEps = 1e-9;
+
+OpType NodeDevice(const OpSpec &spec) {
+  auto device = spec.GetArgument<std::string>("device");
+  if (device == "gpu")
+    return OpType::GPU;
+  if (device == "mixed")
+    return OpType::MIXED;
+  return OpType::CPU;
+}
+
+struct Consumer {
+  int node;
+  int input;
+};
+
+struct StageEstimate {
+  double cpu_s = 0, gpu_s = 0;
+  int transfers = 0;
+
+  double longest() const {
+    return std::max(cpu_s, gpu_s);
+  }
+
+  double total() const {
+    return cpu_s + gpu_s;
+  }
+};
+
+class Placer {
+ public:
+  Placer(std::vector<PlacementNode> &nodes, const std::set<std::string> &cpu_outputs,
+         const OperatorCostMap &costs, const PlacementOptions &options)
+      : nodes_(nodes), cpu_outputs_(cpu_outputs), options_(options) {
+    DALI_ENFORCE(options_.gpu_speedup > 0, make_string(
+        "The GPU speedup of the operators must be positive; got ", options_.gpu_speedup));
+    int n = nodes_.size();
+    device_.resize(n);
+    consumers_.resize(n);
+    cpu_s_.resize(n, 0);
+    gpu_s_.resize(n, 0);
+    gpu_modeled_.resize(n, false);
+    keys_ = PlacementKeys(nodes_);
+    std::map<std::string, int> producers;
+    std::map<int, int> group_sizes;
+    for (int i = 0; i < n; i++) {
+      auto &spec = nodes_[i].spec;
+      device_[i] = NodeDevice(spec);
+      for (int in = 0; in < spec.NumInput(); in++) {
+        auto it = producers.find(spec.InputName(in));
+        if (it != producers.end())
+          consumers_[it->second].push_back({i, in});
+      }
+      for (int out = 0; out < spec.NumOutput(); out++)
+        producers[spec.OutputName(out)] = i;
+      group_sizes[nodes_[i].logical_id]++;
+
+      auto cost_it = costs.find(keys_[i]);
+      OperatorCost cost = cost_it != costs.end() ? cost_it->second : OperatorCost{};
+      cpu_s_[i] = std::max(cost.cpu_s, 0.0);
+      if (cost.gpu_s >= 0) {
+        gpu_s_[i] = cost.gpu_s;
+      } else if (device_[i] == OpType::CPU) {
+        gpu_s_[i] = cpu_s_[i] / options_.gpu_speedup;
+        gpu_modeled_[i] = true;
+      }
+    }
+    for (int i = 0; i < n; i++)
+      in_group_.push_back(group_sizes[nodes_[i].logical_id] > 1);
+  }
+
+  PlacementReport Run() {
+    int n = nodes_.size();
+    // The reasons why the operators can't be moved; an operator is blocked also when any of its
+    // CPU consumers is, so the ones which can be moved form a suffix of the CPU part of the graph
+    std::vector<std::string> blocked(n);
+    for (int i = n - 1; i >= 0; i--) {
+      if (device_[i] != OpType::CPU)
+        continue;
+      blocked[i] = StructuralReason(i);
+      for (auto &c : consumers_[i]) {
+        if (blocked[i].empty() && device_[c.node] == OpType::CPU && !blocked[c.node].empty())
+          blocked[i] = make_string("consumed by \"", nodes_[c.node].instance_name,
+                                   "\", which stays on the CPU");
+      }
+    }
+
+    std::vector<bool> moved(n, false);
+    std::vector<std::string> reasons(n);
+    auto current = Estimate(moved);
+    auto before = current;
+    for (int step = 1; ; step++) {
+      int best = -1;
+      auto best_estimate = current;
+      for (int i = 0; i < n; i++) {
+        if (device_[i] != OpType::CPU || moved[i] || !blocked[i].empty())
+          continue;
+        auto candidate = moved;
+        for (int c : Closure(i, moved))
+          candidate[c] = true;
+        auto estimate = Estimate(candidate);
+        if (estimate.longest() < best_estimate.longest() - kEps ||
+            (best >= 0 && estimate.longest() <= best_estimate.longest() + kEps &&
+             estimate.total() < best_estimate.total() - kEps)) {
+          best = i;
+          best_estimate = estimate;
+        }
+      }
+      if (best < 0)
+        break;
+      for (int c : Closure(best, moved)) {
+        moved[c] = true;
+        reasons[c] = c == best
+            ? make_string("moved to the GPU in step ", step)
+            : make_string("moved to the GPU in step ", step, ", along with \"",
+                          nodes_[best].instance_name, "\"");
+      }
+      current = best_estimate;
+    }
+
+    PlacementReport report;
+    report.enabled = true;
+    report.cpu_time_before_s = before.cpu_s;
+    report.gpu_time_before_s = before.gpu_s;
+    report.transfers_before = before.transfers;
+    report.cpu_time_after_s = current.cpu_s;
+    report.gpu_time_after_s = current.gpu_s;
+    report.transfers_after = current.transfers;
+    for (int i = 0; i < n; i++) {
+      if (device_[i] != OpType::CPU)
+        continue;
+      PlacementDecision decision;
+      decision.instance_name = nodes_[i].instance_name;
+      decision.key = keys_[i];
+      decision.moved = moved[i];
+      decision.cpu_s = cpu_s_[i];
+      decision.gpu_s = gpu_s_[i];
+      decision.gpu_modeled = gpu_modeled_[i];
+      if (moved[i])
+        decision.reason = reasons[i];
+      else if (!blocked[i].empty())
+        decision.reason = blocked[i];
+      else
+        decision.reason = "moving it doesn't shorten the longer of the CPU and the GPU stage";
+      report.decisions.push_back(std::move(decision));
+
+      if (moved[i]) {
+        auto &spec = nodes_[i].spec;
+        spec.SetArg("device", "gpu");
+        for (int in = 0; in < spec.NumInput(); in++) {
+          if (!spec.IsArgumentInput(in))
+            spec.MutableInput(in).device = "gpu";
+        }
+        for (int out = 0; out < spec.NumOutput(); out++)
+          spec.MutableOutput(out).device = "gpu";
+      }
+    }
+    return report;
+  }
+
+ private:
+  std::string StructuralReason(int i) const {
+    auto &spec = nodes_[i].spec;
+    if (!GPUOperatorRegistry::Registry().IsRegistered(spec.name()))
+      return "no GPU implementation";
+    if (spec.NumRegularInput() == 0)
+      return "a source operator";
+    if (spec.GetSchema().IsNoPrune())
+      return "the schema doesn't allow moving it (NoPrune)";
+    if (in_group_[i])
+      return "runs in sync with other instances";
+    for (int out = 0; out < spec.NumOutput(); out++) {
+      if (cpu_outputs_.count(spec.OutputName(out)))
+        return make_string("its output \"", spec.OutputName(out), "\" is requested on the CPU");
+    }
+    for (auto &c : consumers_[i]) {
+      auto &consumer = nodes_[c.node];
+      if (consumer.spec.IsArgumentInput(c.input))
+        return make_string("its output is an argument input of \"", consumer.instance_name, "\"");
+      if (device_[c.node] == OpType::MIXED ||
+          (device_[c.node] == OpType::GPU && consumer.spec.InputDevice(c.input) != "gpu"))
+        return make_string("consumed on the CPU by \"", consumer.instance_name, "\"");
+    }
+    return {};
+  }
+
+  /// The operator `i` and all its CPU consumers, direct or not, which are not moved yet
+  std::vector<int> Closure(int i, const std::vector<bool> &moved) const {
+    std::vector<int> result = {i};
+    std::vector<bool> visited(nodes_.size(), false);
+    visited[i] = true;
+    for (size_t k = 0; k < result.size(); k++) {
+      for (auto &c : consumers_[result[k]]) {
+        if (device_[c.node] == OpType::CPU && !moved[c.node] && !visited[c.node]) {
+          visited[c.node] = true;
+          result.push_back(c.node);
+        }
+      }
+    }
+    return result;
+  }
+
+  StageEstimate Estimate(const std::vector<bool> &moved) const {
+    StageEstimate estimate;
+    int n = nodes_.size();
+    for (int i = 0; i < n; i++) {
+      if (device_[i] == OpType::CPU && !moved[i]) {
+        estimate.cpu_s += cpu_s_[i];
+        // the CPU outputs consumed on the GPU are copied once, regardless of the consumers
+        for (int out = 0; out < nodes_[i].spec.NumOutput(); out++) {
+          auto name = nodes_[i].spec.OutputName(out);
+          for (auto &c : consumers_[i]) {
+            auto &consumer = nodes_[c.node].spec;
+            bool on_gpu = moved[c.node] ||
+                (device_[c.node] == OpType::GPU && consumer.InputDevice(c.input) == "gpu");
+            if (on_gpu && !consumer.IsArgumentInput(c.input) &&
+                consumer.InputName(c.input) == name) {
+              estimate.transfers++;
+              break;
+            }
+          }
+        }
+      } else if (device_[i] == OpType::GPU || moved[i]) {
+        estimate.gpu_s += gpu_s_[i];
+      }
+    }
+    estimate.gpu_s += estimate.transfers * options_.transfer_cost_s;
+    return estimate;
+  }
+
+  std::vector<PlacementNode> &nodes_;
+  const std::set<std::string> &cpu_outputs_;
+  PlacementOptions options_;
+  std::vector<std::string> keys_;
+  std::vector<OpType> device_;
+  std::vector<std::vector<Consumer>> consumers_;
+  std::vector<double> cpu_s_, gpu_s_;
+  std::vector<bool> gpu_modeled_;
+  std::vector<bool> in_group_;
+};
+
+}  // namespace
+
+std::vector<std::string> PlacementKeys(const std::vector<PlacementNode> &nodes) {
+  std::map<std::string, int> counts;
+  std::vector<std::string> keys;
+  for (auto &node : nodes) {
+    std::string name = node.spec.name();
+    keys.push_back(make_string(name, "#", counts[name]++));
+  }
+  return keys;
+}
+
+OperatorCostMap OperatorCosts(const std::vector<PlacementNode> &nodes,
+                              const ExecutorTimingStats &stats) {
+  auto keys = PlacementKeys(nodes);
+  auto mean_s = [](const TimeHistogram &h) {
+    return h.count ? h.total_ns * 1e-9 / h.count : -1.0;
+  };
+  OperatorCostMap costs;
+  for (size_t i = 0; i < nodes.size(); i++) {
+    auto device = NodeDevice(nodes[i].spec);
+    if (device == OpType::MIXED)
+      continue;
+    auto prefix = device == OpType::CPU ? "CPU_" : "GPU_";
+    auto it = stats.operators.find(prefix + nodes[i].instance_name);
+    if (it == stats.operators.end())
+      continue;
+    auto &cost = costs[keys[i]];
+    if (device == OpType::CPU)
+      cost.cpu_s = mean_s(it->second.host_time);
+    else
+      cost.gpu_s = mean_s(it->second.gpu_time);
+  }
+  return costs;
+}
+
+PlacementReport PlaceOperators(std::vector<PlacementNode> &nodes,
+                               const std::set<std::string> &cpu_outputs,
+                               const OperatorCostMap &costs, const PlacementOptions &options) {
+  return Placer(nodes, cpu_outputs, costs, options).Run();
+}
+
+std::string to_string(const PlacementReport &report) {
+  if (!report.enabled)
+    return "The automatic placement of the operators is disabled.";
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3);
+  ss << "Estimated time per iteration: CPU stage " << report.cpu_time_before_s * 1e3 << " ms -> "
+     << report.cpu_time_after_s * 1e3 << " ms, GPU stage " << report.gpu_time_before_s * 1e3
+     << " ms -> " << report.gpu_time_after_s * 1e3 << " ms; CPU to GPU copies "
+     << report.transfers_before << " -> " << report.transfers_after << "\n";
+  for (auto &d : report.decisions) {
+    ss << "  \"" << d.instance_name << "\" (" << d.key << "): "
+       << (d.moved ? "GPU" : "CPU") << " - " << d.reason << "; CPU " << d.cpu_s * 1e3
+       << " ms, GPU " << d.gpu_s * 1e3 << " ms" << (d.gpu_modeled ? " (estimated)" : "") << "\n";
+  }
+  return ss.str();
+}
+
+}  // namespace dali
@@ -0,0 +1,120 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_GRAPH_DEVICE_PLACEMENT_H_
+#define DALI_PIPELINE_GRAPH_DEVICE_PLACEMENT_H_
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dali/core/api_helper.h"
+#include "dali/core/common.h"
+#include "dali/pipeline/executor/executor_stats.h"
+#include "dali/pipeline/operator/op_spec.h"
+
+namespace dali {
+
+/// The time of running an operator per iteration, in seconds; negative if unknown
+struct DLL_PUBLIC OperatorCost {
+  double cpu_s = -1;
+  double gpu_s = -1;
+};
+
+/// Placement key (see PlacementKeys) -> cost of the operator
+using OperatorCostMap = std::unordered_map<std::string, OperatorCost>;
+
+struct DLL_PUBLIC PlacementOptions {
+  /// The GPU time of an operator which wasn't measured on the GPU is its CPU time divided by this
+  double gpu_speedup = 10;
+  /// The time of copying a tensor from the CPU to the GPU, in seconds per iteration
+  double transfer_cost_s = 1e-4;
+};
+
+/// An operator of the pipeline, in the order in which the operators were added
+struct DLL_PUBLIC PlacementNode {
+  std::string instance_name;
+  OpSpec spec;
+  /// The instances with the same logical id run in sync and are never moved
+  int logical_id = -1;
+};
+
+struct DLL_PUBLIC PlacementDecision {
+  std::string instance_name;
+  /// See PlacementKeys
+  std::string key;
+  bool moved = false;
+  double cpu_s = 0;
+  double gpu_s = 0;
+  /// The GPU time is estimated from the CPU time
+  bool gpu_modeled = false;
+  std::string reason;
+};
+
+struct DLL_PUBLIC PlacementReport {
+  bool enabled = false;
+  /// The estimated time of the CPU and the GPU stage per iteration, in seconds
+  double cpu_time_before_s = 0, cpu_time_after_s = 0;
+  double gpu_time_before_s = 0, gpu_time_after_s = 0;
+  /// The number of the tensors copied from the CPU to the GPU
+  int transfers_before = 0, transfers_after = 0;
+  /// One per CPU operator
+  std::vector<PlacementDecision> decisions;
+};
+
+DLL_PUBLIC std::string to_string(const PlacementReport &report);
+
+/**
+ * @brief Returns the keys identifying the operators across the instances of the same pipeline:
+ *        the schema name and the number of the preceding operators with that schema,
+ *        e.g. `Resize#1`.
+ *
+ * The instance names can't be used, as they are generated from a global counter.
+ */
+DLL_PUBLIC std::vector<std::string> PlacementKeys(const std::vector<PlacementNode> &nodes);
+
+/**
+ * @brief Computes the cost of the operators from the timing statistics of the executor
+ *        (the mean host time of the CPU operators and the mean GPU time of the GPU ones).
+ */
+DLL_PUBLIC OperatorCostMap OperatorCosts(const std::vector<PlacementNode> &nodes,
+                                         const ExecutorTimingStats &stats);
+
+/**
+ * @brief Moves the CPU operators to the GPU, where it shortens the longer of the CPU and the GPU
+ *        stage, changing the devices in their specs.
+ *
+ * An operator can be moved only if it has a GPU implementation, it's not a source, nor NoPrune,
+ * and all the consumers of its outputs are GPU operators taking GPU inputs or the operators
+ * moved along with it - so the moved operators form a suffix of the CPU part of the graph
+ * and the CPU to GPU copies are placed at the cut between the two parts. Also, its outputs must
+ * not be used as argument inputs or requested as CPU outputs of the pipeline.
+ *
+ * The estimated time of a stage is the sum of the costs of its operators; each tensor copied
+ * from the CPU to the GPU adds `transfer_cost_s` to the GPU stage. The operators are moved
+ * greedily: in each step, the operator which, with all its CPU consumers, shortens the longer
+ * of the stages the most is moved, until no move helps.
+ *
+ * @param nodes       the operators, in a topological order; their specs are updated
+ * @param cpu_outputs the names of the pipeline outputs requested on the CPU
+ */
+DLL_PUBLIC PlacementReport PlaceOperators(std::vector<PlacementNode> &nodes,
+                                          const std::set<std::string> &cpu_outputs,
+                                          const OperatorCostMap &costs,
+                                          const PlacementOptions &options = {});
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_GRAPH_DEVICE_PLACEMENT_H_
@@ -0,0 +1,134 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "dali/pipeline/graph/device_placement.h"
+
+namespace dali {
+
+namespace {
+
+PlacementNode Node(const std::string &name, const std::string &schema, const std::string &device,
+                   const std::string &input, const std::string &input_device) {
+  OpSpec spec(schema);
+  spec.AddArg("device", device);
+  if (!input.empty())
+    spec.AddInput(input, input_device);
+  spec.AddOutput(name, device == "cpu" ? "cpu" : "gpu");
+  return {name, spec, -1};
+}
+
+const PlacementDecision *FindDecision(const PlacementReport &report, const std::string &name) {
+  for (auto &d : report.decisions)
+    if (d.instance_name == name)
+      return &d;
+  return nullptr;
+}
+
+}  // namespace
+
+TEST(DevicePlacement, Keys) {
+  std::vector<PlacementNode> nodes = {
+    Node("src", "ExternalSource", "cpu", "", ""),
+    Node("a", "Copy", "cpu", "src", "cpu"),
+    Node("b", "Cast", "cpu", "a", "cpu"),
+    Node("c", "Copy", "gpu", "b", "gpu"),
+  };
+  EXPECT_EQ(PlacementKeys(nodes),
+            (std::vector<std::string>{"ExternalSource#0", "Copy#0", "Cast#0", "Copy#1"}));
+}
+
+TEST(DevicePlacement, MovesCheapestCut) {
+  std::vector<PlacementNode> nodes = {
+    Node("src", "ExternalSource", "cpu", "", ""),
+    Node("a", "Copy", "cpu", "src", "cpu"),
+    Node("b", "Cast", "cpu", "a", "cpu"),
+    Node("c", "Copy", "gpu", "b", "gpu"),
+  };
+  OperatorCostMap costs;
+  costs["Copy#0"] = {8e-3, -1};
+  costs["Cast#0"] = {1e-3, -1};
+  costs["Copy#1"] = {-1, 1e-3};
+  PlacementOptions options;
+  options.gpu_speedup = 10;
+  options.transfer_cost_s = 1e-4;
+  auto report = PlaceOperators(nodes, {}, costs, options);
+
+  ASSERT_TRUE(report.enabled);
+  EXPECT_NEAR(report.cpu_time_before_s, 9e-3, 1e-9);
+  EXPECT_NEAR(report.gpu_time_before_s, 1.1e-3, 1e-9);
+  EXPECT_NEAR(report.cpu_time_after_s, 0, 1e-9);
+  EXPECT_NEAR(report.gpu_time_after_s, 2e-3, 1e-9);
+  EXPECT_EQ(report.transfers_before, 1);
+  EXPECT_EQ(report.transfers_after, 1);
+
+  auto *src = FindDecision(report, "src");
+  auto *a = FindDecision(report, "a");
+  auto *b = FindDecision(report, "b");
+  ASSERT_TRUE(src && a && b);
+  EXPECT_FALSE(src->moved);
+  EXPECT_TRUE(a->moved);
+  EXPECT_TRUE(a->gpu_modeled);
+  EXPECT_NEAR(a->gpu_s, 8e-4, 1e-9);
+  EXPECT_EQ(a->reason, "moved to the GPU in step 1");
+  EXPECT_TRUE(b->moved);
+  EXPECT_EQ(b->reason, "moved to the GPU in step 1, along with \"a\"");
+  EXPECT_EQ(FindDecision(report, "c"), nullptr);
+
+  EXPECT_EQ(nodes[0].spec.GetArgument<std::string>("device"), "cpu");
+  for (int i : {1, 2}) {
+    EXPECT_EQ(nodes[i].spec.GetArgument<std::string>("device"), "gpu");
+    EXPECT_EQ(nodes[i].spec.InputDevice(0), "gpu");
+    EXPECT_EQ(nodes[i].spec.OutputDevice(0), "gpu");
+  }
+}
+
+TEST(DevicePlacement, KeepsWhenNotBeneficial) {
+  std::vector<PlacementNode> nodes = {
+    Node("src", "ExternalSource", "cpu", "", ""),
+    Node("a", "Copy", "cpu", "src", "cpu"),
+    Node("c", "Copy", "gpu", "a", "gpu"),
+  };
+  OperatorCostMap costs;
+  costs["Copy#0"] = {1e-3, 5e-3};
+  costs["Copy#1"] = {-1, 4e-3};
+  auto report = PlaceOperators(nodes, {}, costs);
+  auto *a = FindDecision(report, "a");
+  ASSERT_TRUE(a);
+  EXPECT_FALSE(a->moved);
+  EXPECT_FALSE(a->gpu_modeled);
+  EXPECT_EQ(nodes[1].spec.GetArgument<std::string>("device"), "cpu");
+}
+
+TEST(DevicePlacement, Blocked) {
+  std::vector<PlacementNode> nodes = {
+    Node("src", "ExternalSource", "cpu", "", ""),
+    Node("a", "Copy", "cpu", "src", "cpu"),
+    Node("b", "Copy", "cpu", "a", "cpu"),
+  };
+  OperatorCostMap costs;
+  costs["Copy#0"] = {10e-3, -1};
+  costs["Copy#1"] = {10e-3, -1};
+  auto report = PlaceOperators(nodes, {"b"}, costs);
+  EXPECT_EQ(FindDecision(report, "src")->reason, "a source operator");
+  EXPECT_EQ(FindDecision(report, "b")->reason, "its output \"b\" is requested on the CPU");
+  EXPECT_EQ(FindDecision(report, "a")->reason, "consumed by \"b\", which stays on the CPU");
+  for (auto &d : report.decisions)
+    EXPECT_FALSE(d.moved);
+}
+
+}  // namespace dali
@@ -14,8 +14,10 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 #include "dali/core/error_handling.h"
+#include "dali/core/trace.h"
 #include "dali/pipeline/graph/op_graph.h"
 
 #include "dali/pipeline/operator/op_schema.h"
@@ -95,6 +97,7 @@ OpNode& OpGraph::PlaceNewOp(OpType op_type, const OpSpec &op_spec, std::string i
   node.id = op_nodes_.size() - 1;
   node.spec = op_spec;
   node.instance_name = std::move(instance_name);
+  node.trace_name = Tracer::instance().Intern(node.instance_name);
   node.op_type = op_type;
   auto new_partition_id = NumOp(op_type);
   node.partition_index = new_partition_id;
@@ -414,7 +417,8 @@ void OpGraph::RemoveOp(OpNodeId id) {
     auto &sibling_consumers = tensor_nodes_[t].consumers;
     for (size_t i = 0; i < sibling_consumers.size(); i++) {
       if (sibling_consumers[i].node == id) {
-        RemoveVectorElement(sibling_consumers, i);
+        // the element swapped in from the back needs to be checked as well
+        RemoveVectorElement(sibling_consumers, i--);
       }
     }
   }
@@ -654,6 +658,236 @@ TensorNodeId OpGraph::FollowPassThroughUp(OpNodeId op, TensorNodeId passed_throu
 }
 
 
+OpNodeId OpGraph::PointwiseFusableProducer(OpNodeId cast_id) const {
+  auto &cast = Node(cast_id);
+  if (cast.spec.GetSchema().name() != "Cast" || cast.parent_tensors.size() != 1)
+    return -1;
+  auto &tensor = Tensor(cast.parent_tensors[0]);
+  if (tensor.consumers.size() != 1)
+    return -1;
+  auto &producer = Node(tensor.producer.node);
+  const auto &schema = producer.spec.GetSchema();
+  if (!schema.IsPointwiseFusable() || producer.op_type != cast.op_type ||
+      producer.children_tensors.size() != 1 || producer.spec.GetArgument<bool>("preserve"))
+    return -1;
+  // The intermediate type must be float - otherwise, the values are already rounded
+  if (!producer.spec.HasArgument("dtype") ||
+      producer.spec.GetArgument<DALIDataType>("dtype") != DALI_FLOAT)
+    return -1;
+  auto cast_type = cast.spec.GetArgument<DALIDataType>("dtype");
+  const auto &types = schema.PointwiseFusableOutputTypes();
+  if (std::find(types.begin(), types.end(), cast_type) == types.end())
+    return -1;
+  return producer.id;
+}
+
+int OpGraph::FusePointwiseOps() {
+  int fused = 0;
+  for (OpNodeId cast_id = 0; cast_id < NumOp(); cast_id++) {
+    OpNodeId producer_id = PointwiseFusableProducer(cast_id);
+    if (producer_id < 0)
+      continue;
+    auto &producer = Node(producer_id);
+    auto &cast = Node(cast_id);
+    DALI_ENFORCE(!producer.op && !cast.op,
+                 "The operators must be fused before they are instantiated.");
+
+    // The producer, with the type of the Cast and the outputs of the Cast
+    OpSpec spec(producer.spec.name());
+    for (auto &arg : producer.spec.Arguments())
+      spec.SetInitializedArg(arg.first, arg.second);
+    spec.SetArg("dtype", cast.spec.GetArgument<DALIDataType>("dtype"));
+    for (int i = 0; i < producer.spec.NumInput(); i++) {
+      if (producer.spec.IsArgumentInput(i))
+        spec.AddArgumentInput(producer.spec.ArgumentInputName(i), producer.spec.InputName(i));
+      else
+        spec.AddInput(producer.spec.InputName(i), producer.spec.InputDevice(i));
+    }
+    for (int i = 0; i < cast.spec.NumOutput(); i++)
+      spec.AddOutput(cast.spec.OutputName(i), cast.spec.OutputDevice(i));
+
+    // Detach the Cast from the producer...
+    Tensor(cast.parent_tensors[0]).consumers.clear();
+    producer.children.erase(cast_id);
+    cast.parents.erase(producer_id);
+
+    // ...and connect it to the inputs of the producer, keeping the outputs of the Cast
+    cast.spec = std::move(spec);
+    cast.parent_tensors = producer.parent_tensors;
+    for (int i = 0; i < static_cast<int>(cast.parent_tensors.size()); i++) {
+      auto &input = Tensor(cast.parent_tensors[i]);
+      TensorMeta meta;
+      meta.node = cast_id;
+      meta.index = i;
+      meta.storage_device = ParseStorageDevice(cast.spec.InputDevice(i));
+      input.consumers.push_back(meta);
+      cast.parents.insert(input.producer.node);
+      Node(input.producer.node).children.insert(cast_id);
+    }
+
+    // The producer is now dangling; the ids of the subsequent ops are decremented
+    RemoveOp(producer_id);
+    fused++;
+    cast_id--;
+  }
+  return fused;
+}
+
+namespace {
+
+bool CanBePruned(const OpSpec &spec) {
+  return !spec.GetArgument<bool>("preserve") && !spec.GetSchema().IsNoPrune();
+}
+
+bool CanBeMerged(const OpSpec &spec) {
+  return spec.NumRegularInput() > 0 && CanBePruned(spec) &&
+         !spec.GetSchema().IsNondeterministic();
+}
+
+}  // namespace
+
+bool OpGraph::ProducesAnyOf(const OpNode &node, const std::vector<string> &names) const {
+  for (auto t : node.children_tensors) {
+    if (std::find(names.begin(), names.end(), Tensor(t).name) != names.end())
+      return true;
+  }
+  return false;
+}
+
+int OpGraph::PruneUnusedOps(const std::vector<string> &output_names) {
+  int pruned = 0;
+  // Removing a consumer may make its producers unused - visiting the ops in the reverse
+  // topological order handles the whole unused branches in one pass
+  for (OpNodeId id = NumOp() - 1; id >= 0; id--) {
+    auto &node = Node(id);
+    DALI_ENFORCE(!node.op, "The operators must be pruned before they are instantiated.");
+    if (!node.children.empty() || !CanBePruned(node.spec) || ProducesAnyOf(node, output_names))
+      continue;
+    // Only the ops after `id`, which were already visited, are renumbered
+    RemoveOp(id);
+    pruned++;
+  }
+  return pruned;
+}
+
+bool OpGraph::ComputeSameOutputs(const OpNode &a, const OpNode &b) const {
+  const auto &sa = a.spec, &sb = b.spec;
+  if (a.op_type != b.op_type || sa.name() != sb.name() || a.parent_tensors != b.parent_tensors ||
+      sa.NumOutput() != sb.NumOutput())
+    return false;
+  for (int i = 0; i < sa.NumInput(); i++) {
+    if (sa.InputDevice(i) != sb.InputDevice(i) || sa.IsArgumentInput(i) != sb.IsArgumentInput(i))
+      return false;
+    if (sa.IsArgumentInput(i) && sa.ArgumentInputName(i) != sb.ArgumentInputName(i))
+      return false;
+  }
+  for (int i = 0; i < sa.NumOutput(); i++) {
+    if (sa.OutputDevice(i) != sb.OutputDevice(i))
+      return false;
+  }
+  // Every op gets a different seed, which is irrelevant for the deterministic ones
+  const auto &args_a = sa.Arguments(), &args_b = sb.Arguments();
+  auto num_compared = [](const auto &args) {
+    return args.size() - args.count("seed");
+  };
+  if (num_compared(args_a) != num_compared(args_b))
+    return false;
+  for (auto &arg : args_a) {
+    if (arg.first == "seed")
+      continue;
+    auto it = args_b.find(arg.first);
+    if (it == args_b.end() || !arg.second->Equals(*it->second))
+      return false;
+  }
+  return true;
+}
+
+int OpGraph::EliminateCommonSubexpressions(const std::vector<string> &output_names) {
+  int merged = 0;
+  // The ops are in the topological order, so the inputs of `dup_id` are already deduplicated
+  for (OpNodeId dup_id = 0; dup_id < NumOp(); dup_id++) {
+    auto &dup = Node(dup_id);
+    DALI_ENFORCE(!dup.op, "The operators must be merged before they are instantiated.");
+    if (!CanBeMerged(dup.spec) || ProducesAnyOf(dup, output_names))
+      continue;
+    OpNodeId keep_id = 0;
+    for (; keep_id < dup_id; keep_id++) {
+      if (CanBeMerged(Node(keep_id).spec) && ComputeSameOutputs(Node(keep_id), dup))
+        break;
+    }
+    if (keep_id == dup_id)
+      continue;
+    auto &keep = Node(keep_id);
+
+    // Move the consumers of the duplicate to the corresponding outputs of the kept op
+    for (int o = 0; o < static_cast<int>(dup.children_tensors.size()); o++) {
+      auto &dup_tensor = Tensor(dup.children_tensors[o]);
+      auto &keep_tensor = Tensor(keep.children_tensors[o]);
+      for (auto &edge : dup_tensor.consumers) {
+        auto &consumer = Node(edge.node);
+        consumer.parent_tensors[edge.index] = keep_tensor.id;
+        consumer.spec.MutableInput(edge.index).name = keep.spec.OutputName(o);
+        keep_tensor.consumers.push_back(edge);
+      }
+      dup_tensor.consumers.clear();
+    }
+    for (auto child_id : dup.children) {
+      auto &child = Node(child_id);
+      child.parents.erase(dup_id);
+      child.parents.insert(keep_id);
+      keep.children.insert(child_id);
+    }
+    dup.children.clear();
+
+    // The duplicate is now dangling; the ids of the subsequent ops are decremented
+    RemoveOp(dup_id);
+    merged++;
+    dup_id--;
+  }
+  return merged;
+}
+
+
+std::set<OpNodeId> OpGraph::WithAncestors(OpNodeId id) const {
+  std::set<OpNodeId> visited = {id};
+  std::vector<OpNodeId> stack = {id};
+  while (!stack.empty()) {
+    auto &node = Node(stack.back());
+    stack.pop_back();
+    for (auto parent : node.parents) {
+      if (visited.insert(parent).second)
+        stack.push_back(parent);
+    }
+  }
+  return visited;
+}
+
+int OpGraph::BypassNondeterministicCaches() {
+  std::set<std::string> bypassed;
+  for (auto &store : op_nodes_) {
+    if (store.spec.GetSchema().name() != "experimental__CacheStore")
+      continue;
+    DALI_ENFORCE(!store.op, "The caches must be bypassed before the operators are instantiated.");
+    auto name = store.spec.GetArgument<std::string>("cache_name");
+    auto key_ops = WithAncestors(Tensor(store.parent_tensors[1]).producer.node);
+    for (auto id : WithAncestors(Tensor(store.parent_tensors[0]).producer.node)) {
+      auto &node = Node(id);
+      if (key_ops.count(id) || !node.spec.GetSchema().IsNondeterministic())
+        continue;
+      if (bypassed.insert(name).second)
+        DALI_WARN("The cache \"", name, "\" is bypassed: the cached samples are computed by "
+                  "the nondeterministic operator \"", node.instance_name, "\".");
+      break;
+    }
+  }
+  for (auto &lookup : op_nodes_) {
+    if (lookup.spec.GetSchema().name() == "experimental__CacheLookup" &&
+        bypassed.count(lookup.spec.GetArgument<std::string>("cache_name")))
+      lookup.spec.SetArg("bypass", true);
+  }
+  return static_cast<int>(bypassed.size());
+}
+
 bool OpGraph::HasConsumersInOtherStage(const TensorNode &tensor, OpType this_stage) const {
   for (const auto& cons_edge : tensor.consumers) {
     // We found a consumer from different stage, this tensor is a stage output
@@ -78,6 +78,8 @@ struct OpNode {
   std::vector<OutputDesc> output_desc;
 
   std::string instance_name;
+  /// The instance name, interned for the traced ranges of the operator
+  const char *trace_name = nullptr;
   OpType op_type = OpType::COUNT;
   OpPartitionId partition_index = -1;
 };
@@ -347,6 +349,61 @@ class DLL_PUBLIC OpGraph {
    */
   DLL_PUBLIC void SetupMakeContiguousPassThrough(const std::vector<string>& output_names);
 
+  /**
+   * @brief Fuses the Casts which follow pointwise operators into these operators.
+   *
+   * A Cast which is the only consumer of the float output of an operator marked as
+   * PointwiseFusable in its schema is replaced with the operator, producing the type of the Cast
+   * directly. Both versions compute in float and convert with saturation, so the results
+   * are the same, but the intermediate float tensor is neither written nor read.
+   *
+   * Must be called before the operators are instantiated.
+   *
+   * @return The number of the fused operators.
+   */
+  DLL_PUBLIC int FusePointwiseOps();
+
+  /**
+   * @brief Removes the operators whose outputs are neither consumed by other operators,
+   * nor listed in `output_names`.
+   *
+   * The operators marked as NoPrune in their schema and the ones with the `preserve` argument
+   * set are kept. The removal is repeated, so whole unused branches are removed.
+   *
+   * Must be called before the operators are instantiated.
+   *
+   * @return The number of the removed operators.
+   */
+  DLL_PUBLIC int PruneUnusedOps(const std::vector<string> &output_names);
+
+  /**
+   * @brief Merges the operators which compute the same thing: the ones with the same schema,
+   * device, arguments and inputs. The consumers of the outputs of a duplicate are moved to
+   * the outputs of the first such operator and the duplicate is removed.
+   *
+   * The `seed` is not compared, so the operators which are Nondeterministic in their schema
+   * are never merged. Neither are the sources (the operators without regular inputs),
+   * the ones which can't be pruned, nor the ones producing any of `output_names`.
+   *
+   * Must be called before the operators are instantiated.
+   *
+   * @return The number of the removed operators.
+   */
+  DLL_PUBLIC int EliminateCommonSubexpressions(const std::vector<string> &output_names);
+
+  /**
+   * @brief Disables the caches (see experimental__CacheLookup) whose samples are computed by
+   * a nondeterministic operator, setting the `bypass` argument of their lookups.
+   *
+   * The operators computing the samples stored by a CacheStore are the ancestors of its data
+   * input which are not the ancestors of its keys input (e.g. the reader), nor produce it.
+   *
+   * Must be called before the operators are instantiated.
+   *
+   * @return The number of the disabled caches.
+   */
+  DLL_PUBLIC int BypassNondeterministicCaches();
+
  private:
   // Should be called only once for each tensor
   void GenerateDOTFromGraph(const TensorNode& current_node, std::ofstream& ofs, bool show_tensors,
@@ -366,6 +423,26 @@ class DLL_PUBLIC OpGraph {
    */
   TensorNodeId FollowPassThroughUp(OpNodeId op, TensorNodeId passed_through) const;
 
+  /**
+   * @brief Checks if the Cast `cast_id` can be fused into the producer of its input.
+   *
+   * @return The id of the producer or -1, if it cannot be fused.
+   */
+  OpNodeId PointwiseFusableProducer(OpNodeId cast_id) const;
+
+  /**
+   * @brief Checks if the ops `a` and `b` compute the same outputs (see
+   *        EliminateCommonSubexpressions)
+   */
+  bool ComputeSameOutputs(const OpNode &a, const OpNode &b) const;
+
+  bool ProducesAnyOf(const OpNode &node, const std::vector<string> &names) const;
+
+  /**
+   * @brief Returns the op with the given id and all its ancestors
+   */
+  std::set<OpNodeId> WithAncestors(OpNodeId id) const;
+
   /**
    * @brief Recalculate OpNodes partitioning
    *
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -523,6 +523,251 @@ TEST_F(OpGraphTest, TestOpRemoval) {
   ASSERT_EQ(meta[0].storage_device, StorageDevice::CPU);
 }
 
+TEST_F(OpGraphTest, TestPointwiseFusion) {
+  OpGraph graph;
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("external_data", "cpu")), "src");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ColorTwist")
+          .AddArg("device", "cpu")
+          .AddArg("dtype", DALI_FLOAT)
+          .AddArg("hue", 10.0f)
+          .AddInput("external_data", "cpu")
+          .AddOutput("twisted", "cpu")), "twist");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Cast")
+          .AddArg("device", "cpu")
+          .AddArg("dtype", DALI_UINT8)
+          .AddInput("twisted", "cpu")
+          .AddOutput("cast", "cpu")), "cast");
+
+  // the float output of Hsv is also used by Copy - it must stay
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Hsv")
+          .AddArg("device", "cpu")
+          .AddArg("dtype", DALI_FLOAT)
+          .AddInput("external_data", "cpu")
+          .AddOutput("hsv", "cpu")), "hsv");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Cast")
+          .AddArg("device", "cpu")
+          .AddArg("dtype", DALI_UINT8)
+          .AddInput("hsv", "cpu")
+          .AddOutput("hsv_cast", "cpu")), "hsv_cast");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "cpu")
+          .AddInput("hsv", "cpu")
+          .AddOutput("hsv_copy", "cpu")), "copy");
+
+  ASSERT_EQ(graph.FusePointwiseOps(), 1);
+  ASSERT_EQ(graph.NumOp(OpType::CPU), 5);
+  ASSERT_EQ(graph.NumTensor(), 5);
+  ASSERT_FALSE(graph.TensorExists("twisted_cpu"));
+
+  auto &fused = graph.Node(1);
+  ASSERT_EQ(fused.id, 1);
+  ASSERT_EQ(fused.instance_name, "cast");
+  ASSERT_EQ(fused.spec.name(), "ColorTwist");
+  ASSERT_EQ(fused.spec.GetArgument<DALIDataType>("dtype"), DALI_UINT8);
+  ASSERT_EQ(fused.spec.GetArgument<float>("hue"), 10.0f);
+  ASSERT_EQ(fused.parents, std::set<OpNodeId>{0});
+  ASSERT_TRUE(fused.children.empty());
+  ASSERT_EQ(fused.parent_tensors, std::vector<TensorNodeId>{0});
+  ASSERT_EQ(graph.TensorSourceID(fused.spec.Output(0)), 1);
+  ASSERT_EQ(graph.Tensor(fused.children_tensors[0]).name, "cast_cpu");
+
+  auto &src = graph.Node(0);
+  ASSERT_EQ(src.children, (std::set<OpNodeId>{1, 2}));
+  auto consumers = graph.TensorConsumerMeta("external_data_cpu");
+  ASSERT_EQ(consumers.size(), 2);
+  std::vector<OpNodeId> cons = {consumers[0].node, consumers[1].node};
+  std::sort(cons.begin(), cons.end());
+  ASSERT_EQ(cons, (std::vector<OpNodeId>{1, 2}));
+
+  ASSERT_EQ(graph.Node(2).spec.name(), "Hsv");
+  ASSERT_EQ(graph.Node(2).spec.GetArgument<DALIDataType>("dtype"), DALI_FLOAT);
+  ASSERT_EQ(graph.Node(3).spec.name(), "Cast");
+  ASSERT_EQ(graph.Node(3).parents, std::set<OpNodeId>{2});
+  ASSERT_EQ(graph.Node(4).spec.name(), "Copy");
+}
+
+TEST_F(OpGraphTest, TestEliminateCommonSubexpressions) {
+  OpGraph graph;
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("data", "cpu")), "src");
+
+  // the seeds differ, but Copy is deterministic
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "cpu")
+          .AddArg("seed", 1)
+          .AddInput("data", "cpu")
+          .AddOutput("copy1", "cpu")), "copy1");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "cpu")
+          .AddArg("seed", 2)
+          .AddInput("data", "cpu")
+          .AddOutput("copy2", "cpu")), "copy2");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Cast")
+          .AddArg("device", "cpu")
+          .AddArg("dtype", DALI_UINT8)
+          .AddInput("copy1", "cpu")
+          .AddOutput("cast1", "cpu")), "cast1");
+
+  // the same as cast1, once its input is deduplicated
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Cast")
+          .AddArg("device", "cpu")
+          .AddArg("dtype", DALI_UINT8)
+          .AddInput("copy2", "cpu")
+          .AddOutput("cast2", "cpu")), "cast2");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Cast")
+          .AddArg("device", "cpu")
+          .AddArg("dtype", DALI_FLOAT)
+          .AddInput("copy2", "cpu")
+          .AddOutput("cast3", "cpu")), "cast3");
+
+  // random - never merged
+  for (const char *name : {"noise1", "noise2"}) {
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("noise__Gaussian")
+            .AddArg("device", "cpu")
+            .AddArg("seed", 3)
+            .AddInput("copy1", "cpu")
+            .AddOutput(name, "cpu")), name);
+  }
+
+  // cast2 is a pipeline output, so it stays
+  ASSERT_EQ(graph.EliminateCommonSubexpressions({"cast2_cpu"}), 1);
+  ASSERT_EQ(graph.NumOp(OpType::CPU), 7);
+  ASSERT_FALSE(graph.TensorExists("copy2_cpu"));
+
+  auto &copy = graph.Node(1);
+  ASSERT_EQ(copy.instance_name, "copy1");
+  ASSERT_EQ(copy.children, (std::set<OpNodeId>{2, 3, 4, 5, 6}));
+  ASSERT_EQ(graph.TensorConsumerMeta("copy1_cpu").size(), 5);
+  ASSERT_EQ(graph.Node(0).children, std::set<OpNodeId>{1});
+
+  auto &cast2 = graph.Node(3);
+  ASSERT_EQ(cast2.instance_name, "cast2");
+  ASSERT_EQ(cast2.spec.Input(0), "copy1_cpu");
+  ASSERT_EQ(cast2.parents, std::set<OpNodeId>{1});
+  ASSERT_EQ(cast2.parent_tensors, std::vector<TensorNodeId>{copy.children_tensors[0]});
+
+  ASSERT_EQ(graph.EliminateCommonSubexpressions({}), 1);
+  ASSERT_EQ(graph.NumOp(OpType::CPU), 6);
+  ASSERT_FALSE(graph.TensorExists("cast2_cpu"));
+  ASSERT_EQ(graph.Node(3).instance_name, "cast3");
+  ASSERT_EQ(graph.Node(4).instance_name, "noise1");
+  ASSERT_EQ(graph.Node(5).instance_name, "noise2");
+}
+
+TEST_F(OpGraphTest, TestPruneUnusedOps) {
+  OpGraph graph;
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("data", "cpu")), "src");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "cpu")
+          .AddInput("data", "cpu")
+          .AddOutput("copy", "cpu")), "copy");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Cast")
+          .AddArg("device", "cpu")
+          .AddArg("dtype", DALI_UINT8)
+          .AddInput("copy", "cpu")
+          .AddOutput("cast", "cpu")), "cast");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "cpu")
+          .AddArg("preserve", true)
+          .AddInput("data", "cpu")
+          .AddOutput("preserved", "cpu")), "preserved");
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("Copy")
+          .AddArg("device", "cpu")
+          .AddInput("data", "cpu")
+          .AddOutput("out", "cpu")), "out");
+
+  ASSERT_EQ(graph.PruneUnusedOps({"out_cpu"}), 2);
+  ASSERT_EQ(graph.NumOp(OpType::CPU), 3);
+  ASSERT_FALSE(graph.TensorExists("copy_cpu"));
+  ASSERT_FALSE(graph.TensorExists("cast_cpu"));
+  ASSERT_EQ(graph.Node(1).instance_name, "preserved");
+  ASSERT_EQ(graph.Node(2).instance_name, "out");
+  ASSERT_EQ(graph.Node(0).children, (std::set<OpNodeId>{1, 2}));
+  ASSERT_EQ(graph.TensorConsumerMeta("data_cpu").size(), 2);
+}
+
+TEST_F(OpGraphTest, TestBypassNondeterministicCaches) {
+  OpGraph graph;
+
+  graph.AddOp(this->PrepareSpec(
+          OpSpec("ExternalSource")
+          .AddArg("device", "cpu")
+          .AddOutput("keys", "cpu")), "src");
+
+  // the same cached part of the graph, once deterministic and once random
+  for (std::string cache : {"det", "rand"}) {
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("experimental__CacheLookup")
+            .AddArg("device", "cpu")
+            .AddArg("cache_name", cache)
+            .AddInput("keys", "cpu")
+            .AddOutput("hit_" + cache, "cpu")), "lookup_" + cache);
+
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("_conditional__Split")
+            .AddArg("device", "cpu")
+            .AddInput("keys", "cpu")
+            .AddArgumentInput("predicate", "hit_" + cache)
+            .AddOutput("cached_" + cache, "cpu")
+            .AddOutput("new_" + cache, "cpu")), "split_" + cache);
+
+    graph.AddOp(this->PrepareSpec(
+            OpSpec(cache == "det" ? "Copy" : "noise__Gaussian")
+            .AddArg("device", "cpu")
+            .AddInput("new_" + cache, "cpu")
+            .AddOutput("data_" + cache, "cpu")), "compute_" + cache);
+
+    graph.AddOp(this->PrepareSpec(
+            OpSpec("experimental__CacheStore")
+            .AddArg("device", "cpu")
+            .AddArg("cache_name", cache)
+            .AddInput("data_" + cache, "cpu")
+            .AddInput("new_" + cache, "cpu")
+            .AddOutput("stored_" + cache, "cpu")), "store_" + cache);
+  }
+
+  ASSERT_EQ(graph.BypassNondeterministicCaches(), 1);
+  EXPECT_FALSE(graph.Node("lookup_det").spec.GetArgument<bool>("bypass"));
+  EXPECT_TRUE(graph.Node("lookup_rand").spec.GetArgument<bool>("bypass"));
+}
+
 TEST_F(OpGraphTest, TestFailureCPUOpGPUInput) {
   OpGraph graph;
 
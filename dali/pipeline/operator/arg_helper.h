@@ -96,7 +96,8 @@ class ArgValue {
   ArgValue(std::string arg_name, const OpSpec &spec)
       : arg_name_(std::move(arg_name)) {
     has_explicit_const_ = spec.HasArgument(arg_name_);
-    has_arg_input_ = spec.HasTensorArgument(arg_name_);
+    arg_slot_ = spec.ArgumentInputSlot(arg_name_);
+    has_arg_input_ = arg_slot_ >= 0;
     assert(!(has_explicit_const_ && has_arg_input_));
 
     ReadConstant(spec, false);  // not raising errors here
@@ -149,7 +150,7 @@ class ArgValue {
                ArgValueFlags flags = ArgValue_Default) {
     assert(!(flags & ArgValue_EnforceUniform) || is_uniform(expected_shape));
     if (has_arg_input_) {
-      view_ = view<const T, ndim>(ws.ArgumentInput(arg_name_));
+      SetInputView(ws.ArgumentInput(arg_slot_, arg_name_));
       if (flags & ArgValue_AllowEmpty) {
         for (int i = 0; i < nsamples; i++) {
           auto sh_span = view_.shape.tensor_shape_span(i);
@@ -174,7 +175,7 @@ class ArgValue {
         data_.resize(std::max(expected_len, 1_i64), data_[0]);
         view_ = TLV(data_.data(), expected_shape);
       } else if (orig_constant_sz_ == 0 && (flags & ArgValue_AllowEmpty)) {
-        view_ = constant_view(nsamples, data_.data(), TensorShape<ndim>{});
+        SetConstantView(nsamples, data_.data(), TensorShape<ndim>{});
       } else {
         if (!is_uniform(expected_shape)) {
           DALI_FAIL(make_string("Can't interpret argument ", arg_name_,
@@ -187,7 +188,7 @@ class ArgValue {
               make_string("Argument \"", arg_name_, "\" expected shape ", expected_sample_sh,
                           " but got ", orig_constant_sz_,
                           " values, which can't be interpreted as the expected shape."));
-        view_ = constant_view(nsamples, data_.data(), expected_sample_sh);
+        SetConstantView(nsamples, data_.data(), expected_sample_sh);
       }
     }
   }
@@ -206,7 +207,7 @@ class ArgValue {
                const TensorShape<ndim> &expected_shape,
                ArgValueFlags flags = ArgValue_Default) {
     if (has_arg_input_) {
-      view_ = view<const T, ndim>(ws.ArgumentInput(arg_name_));
+      SetInputView(ws.ArgumentInput(arg_slot_, arg_name_));
       span<const int64_t> expected_sh_span(&expected_shape[0], expected_shape.size());
       if (flags & ArgValue_AllowEmpty) {
         for (int i = 0; i < nsamples; i++) {
@@ -230,15 +231,15 @@ class ArgValue {
       if (orig_constant_sz_ == 1 && expected_len != 1) {
         // broadcast single values to whatever shape, including empty tensors
         data_.resize(std::max(expected_len, 1_i64), data_[0]);
-        view_ = constant_view(nsamples, data_.data(), expected_shape);
+        SetConstantView(nsamples, data_.data(), expected_shape);
       } else if (orig_constant_sz_ == 0 && (flags & ArgValue_AllowEmpty)) {
-        view_ = constant_view(nsamples, data_.data(), TensorShape<ndim>{});
+        SetConstantView(nsamples, data_.data(), TensorShape<ndim>{});
       } else {
         DALI_ENFORCE(orig_constant_sz_ == volume(expected_shape),
               make_string("Argument \"", arg_name_, "\" expected shape ", expected_shape,
                           " but got ", orig_constant_sz_,
                           " values, which can't be interpreted as the expected shape."));
-        view_ = constant_view(nsamples, data_.data(), expected_shape);
+        SetConstantView(nsamples, data_.data(), expected_shape);
       }
     }
   }
@@ -260,7 +261,7 @@ class ArgValue {
                ArgValueFlags flags = ArgValue_Default,
                ShapeFromSizeFn &&shape_from_size = {}) {
     if (has_arg_input_) {
-      view_ = view<const T, ndim>(ws.ArgumentInput(arg_name_));
+      SetInputView(ws.ArgumentInput(arg_slot_, arg_name_));
       if (flags & ArgValue_EnforceUniform) {
         DALI_ENFORCE(is_uniform(view_.shape),
           make_string("Expected uniform shape for argument \"", arg_name_,
@@ -271,7 +272,7 @@ class ArgValue {
         ReadConstant(spec);  // just to raise the appropriate error
 
       auto sh = shape_from_size(orig_constant_sz_);
-      view_ = constant_view(nsamples, data_.data(), std::move(sh));
+      SetConstantView(nsamples, data_.data(), std::move(sh));
     }
   }
 
@@ -338,16 +339,36 @@ class ArgValue {
   }
 
   /**
-   * @brief Creates a TensorListView out of a constant arguments by assigning the same
+   * @brief Makes the view a TensorListView of a constant argument by assigning the same
    *        data pointer to all the samples. This way, the user code can be shared regardless
    *        of whether the source of the data was a build time constant or an argument input.
+   *
+   * The storage of the view is reused, so acquiring a constant argument in every iteration
+   * doesn't allocate memory.
+   */
+  void SetConstantView(int nsamples, const T* sample, const TensorShape<ndim>& shape) {
+    view_.data.assign(nsamples, sample);
+    view_.shape.resize(nsamples, shape.sample_dim());
+    for (int i = 0; i < nsamples; i++)
+      view_.shape.set_tensor_shape(i, shape);
+  }
+
+  /**
+   * @brief Makes the view point to the argument input, reusing the storage of the view.
    */
-  TLV constant_view(int nsamples, const T* sample, const TensorShape<ndim>& shape) {
-    std::vector<const T*> ptrs(nsamples, sample);
-    return TLV(std::move(ptrs), uniform_list_shape(nsamples, shape));
+  void SetInputView(const TensorList<CPUBackend> &input) {
+    const auto &shape = input.shape();
+    detail::enforce_dim_in_view<ndim>(shape);
+    int nsamples = shape.num_samples();
+    view_.data.resize(nsamples);
+    for (int i = 0; i < nsamples; i++)
+      view_.data[i] = input.template tensor<T>(i);
+    view_.shape.resize(nsamples, shape.sample_dim());
+    view_.shape.shapes = shape.shapes;
   }
 
   std::string arg_name_;
+  int arg_slot_ = -1;
 
   std::vector<T> data_;
   TLV view_;
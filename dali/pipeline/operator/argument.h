@@ -131,6 +131,12 @@ class Argument {
 
   virtual DALIDataType GetTypeId() const = 0;
 
+  /**
+   * @brief Tells whether the other argument has the same type and value (the names are not
+   *        compared)
+   */
+  virtual bool Equals(const Argument &other) const = 0;
+
   virtual void SerializeToProtobuf(DaliProtoPriv* arg) = 0;
 
   template <typename T>
@@ -174,6 +180,11 @@ class ArgumentInst : public Argument {
     return val.GetTypeId();
   }
 
+  bool Equals(const Argument &other) const override {
+    auto *o = dynamic_cast<const ArgumentInst *>(&other);
+    return o && val.Get() == o->val.Get();
+  }
+
   void SerializeToProtobuf(DaliProtoPriv* arg) override {
     arg->set_name(Argument::ToString());
     dali::SerializeToProtobuf(val.Get(), arg);
@@ -203,6 +214,11 @@ class ArgumentInst<std::vector<T>> : public Argument {
     return val.GetTypeId();
   }
 
+  bool Equals(const Argument &other) const override {
+    auto *o = dynamic_cast<const ArgumentInst *>(&other);
+    return o && val.Get() == o->val.Get();
+  }
+
   void SerializeToProtobuf(DaliProtoPriv* arg) override {
     const std::vector<T>& vec = val.Get();
     arg->set_name(Argument::ToString());
@@ -28,6 +28,7 @@ DALI_SCHEMA(Copy)
   .NumInput(1)
   .NumOutput(1)
   .AllowSequences()
-  .SupportVolumetric();
+  .SupportVolumetric()
+  .CUDAGraphSafe();
 
 }  // namespace dali
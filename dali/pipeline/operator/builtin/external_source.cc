@@ -69,6 +69,7 @@ DALI_SCHEMA(ExternalSource)
 
   This operator can be used with C and C++ APIs by either directly specyfing it with OpSpec
   or by the Pipeline::AddExternalInput method.)code")
+  .Nondeterministic()
   .NumInput(0)
   .NumOutput(1)
   .AddOptionalArg("blocking",
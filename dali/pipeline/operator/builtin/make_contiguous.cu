@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "dali/core/exec/engine.h"
 #include "dali/core/nvtx.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/operator/builtin/make_contiguous.h"
@@ -54,10 +55,11 @@ void MakeContiguousMixed::Run(MixedWorkspace &ws) {
            "Copy between backends is needed, executor cannot mark this MakeContiguous as "
            "PassThrough node.");
     auto &output = ws.Output<GPUBackend>(0);
-    if (coalesced) {
+    // Small samples are gathered to make one copy instead of many tiny ones; pageable memory
+    // is staged, so that the copy is asynchronous instead of going through the driver's buffer.
+    if (coalesced || !input.is_pinned()) {
       DomainTimeRange tr("[DALI][MakeContiguousMixed] H2D coalesced", DomainTimeRange::kBlue);
-      cpu_output_buff.Copy(input);
-      output.Copy(cpu_output_buff, ws.stream());
+      StagedCopy(output, input, ws.stream());
     } else {
       DomainTimeRange tr("[DALI][MakeContiguousMixed] H2D non coalesced", DomainTimeRange::kGreen);
       output.Copy(input, ws.stream());
@@ -66,6 +68,35 @@ void MakeContiguousMixed::Run(MixedWorkspace &ws) {
   }
 }
 
+void MakeContiguousMixed::StagedCopy(TensorList<GPUBackend> &output,
+                                     const TensorList<CPUBackend> &input,
+                                     cudaStream_t stream) {
+  output.set_order(stream);
+  output.Resize(input.shape(), input.type(), BatchContiguity::Contiguous);
+  output.SetLayout(input.GetLayout());
+  int batch_size = input.num_samples();
+  for (int i = 0; i < batch_size; i++)
+    output.SetMeta(i, input.GetMeta(i));
+
+  size_t type_size = input.type_info().size();
+  size_t total_bytes = input.shape().num_elements() * type_size;
+  if (total_bytes == 0)
+    return;
+  char *staging = staging_.Acquire(total_bytes);
+  size_t offset = 0;
+  for (int i = 0; i < batch_size; i++) {
+    size_t sample_bytes = volume(input.tensor_shape_span(i)) * type_size;
+    gather_.AddCopy(staging + offset, input.raw_tensor(i), sample_bytes);
+    offset += sample_bytes;
+  }
+  assert(offset == total_bytes);
+  SequentialExecutionEngine engine;
+  gather_.Run(engine);
+  CUDA_CALL(cudaMemcpyAsync(unsafe_raw_mutable_data(output), staging, total_bytes,
+                            cudaMemcpyHostToDevice, stream));
+  staging_.Release(stream);
+}
+
 void MakeContiguousGPU::RunImpl(DeviceWorkspace &ws) {
   const auto& input = ws.template Input<GPUBackend>(0);
   auto& output = ws.template Output<GPUBackend>(0);
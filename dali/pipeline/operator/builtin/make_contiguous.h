@@ -23,6 +23,8 @@
 #include "dali/pipeline/operator/operator.h"
 #include "dali/pipeline/operator/common.h"
 #include "dali/core/common.h"
+#include "dali/kernels/common/scatter_gather.h"
+#include "dali/pipeline/util/pinned_staging_ring.h"
 #include "dali/pipeline/workspace/device_workspace.h"
 
 // Found by benchmarking coalesced vs non coalesced on diff size images
@@ -85,7 +87,6 @@ class MakeContiguousBase : public Operator<Backend> {
 
  protected:
   USE_OPERATOR_MEMBERS();
-  TensorList<CPUBackend> cpu_output_buff;
   bool coalesced = true;
   int bytes_per_sample_hint = 0;
   bool pass_through_ = false;
@@ -111,6 +112,17 @@ class MakeContiguousMixed : public MakeContiguousBase<MixedBackend> {
   void Run(MixedWorkspace &ws) override;
 
   DISABLE_COPY_MOVE_ASSIGN(MakeContiguousMixed);
+
+ private:
+  /**
+   * @brief Gathers the samples into a pinned staging buffer and copies them to the device
+   *        with a single asynchronous copy.
+   */
+  void StagedCopy(TensorList<GPUBackend> &output, const TensorList<CPUBackend> &input,
+                  cudaStream_t stream);
+
+  PinnedStagingRing staging_;
+  kernels::ScatterGatherCPU gather_{kernels::ScatterGatherCPU::kAnyBlockSize};
 };
 
 class MakeContiguousCPU : public MakeContiguousBase<CPUBackend> {
@@ -0,0 +1,97 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "dali/pipeline/operator/builtin/native_source.h"
+#include <string>
+#include <vector>
+
+namespace dali {
+
+DALI_DEFINE_OPTYPE_REGISTRY(NativeSource, NativeSource);
+
+void NativeSource::RunBatch(HostWorkspace &ws, const SourceBatchInfo &info) {
+  auto &tp = ws.GetThreadPool();
+  for (int i = 0; i < info.batch_size; i++) {
+    tp.AddWork([this, &ws, &info, i](int thread_idx) {
+      RunSample(ws, info, i, thread_idx);
+    });
+  }
+  tp.RunAll();
+}
+
+NativeSourceOp::NativeSourceOp(const OpSpec &spec) : Operator<CPUBackend>(spec) {
+  auto name = spec.GetArgument<std::string>("source");
+  try {
+    source_ = NativeSourceRegistry::Registry().Create(name, spec);
+  } catch (DALIException &) {
+    DALI_FAIL(make_string("The native source \"", name, "\" is not registered. Make sure that "
+                          "the plugin which implements it is loaded."));
+  }
+  int num_outputs = spec.GetArgument<int>("num_outputs");
+  bool listed_layouts = spec.TryGetRepeatedArgument(layouts_, "output_layouts");
+  if (!listed_layouts && spec.HasArgument("output_layouts")) {
+    auto layout = spec.GetArgument<TensorLayout>("output_layouts");
+    layouts_ = std::vector<TensorLayout>(num_outputs, layout);
+  }
+  DALI_ENFORCE(static_cast<int>(layouts_.size()) <= num_outputs,
+               make_string("The length of the ``output_layouts`` (=", layouts_.size(),
+                           ") is greater than the number of outputs (=", num_outputs, ")."));
+}
+
+bool NativeSourceOp::SetupImpl(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) {
+  info_.batch_size = max_batch_size_;
+  output_desc.resize(spec_.NumOutput());
+  source_->Setup(output_desc, info_);
+  for (auto &desc : output_desc) {
+    DALI_ENFORCE(desc.shape.num_samples() == info_.batch_size,
+                 make_string("The native source must describe ", info_.batch_size,
+                             " samples, got ", desc.shape.num_samples(), "."));
+  }
+  return true;
+}
+
+void NativeSourceOp::RunImpl(HostWorkspace &ws) {
+  for (size_t i = 0; i < layouts_.size(); i++)
+    ws.Output<CPUBackend>(i).SetLayout(layouts_[i]);
+  source_->RunBatch(ws, info_);
+  info_.iteration++;
+  info_.first_sample += info_.batch_size;
+}
+
+DALI_REGISTER_OPERATOR(experimental__NativeSource, NativeSourceOp, CPU);
+
+DALI_SCHEMA(experimental__NativeSource)
+  .DocStr(R"code(Produces data with a source implemented in C++.
+
+The source is a class derived from ``dali::NativeSource`` and registered with
+``DALI_REGISTER_NATIVE_SOURCE`` in a plugin library, which must be loaded (with
+:meth:`nvidia.dali.plugin_manager.load_library`) before the pipeline is built.
+The samples are produced in the thread pool of the pipeline, without the Python interpreter.)code")
+  .NumInput(0)
+  .OutputFn([](const OpSpec &spec) { return spec.GetArgument<int>("num_outputs"); })
+  .AddArg("source", R"code(The name under which the source is registered.)code", DALI_STRING)
+  .AddOptionalArg("source_params",
+      R"code(A string passed to the source, e.g. the path to the data.
+
+The meaning of the string is defined by the source.)code", std::string())
+  .AddOptionalArg("num_outputs", R"code(The number of outputs of the source.)code", 1)
+  .AddOptionalArg<std::vector<TensorLayout>>("output_layouts",
+      R"code(Tensor data layouts for the outputs.
+
+This argument can be a list that contains a distinct layout for each output. If the list has
+fewer than num_outputs elements, only the first outputs have the layout set and the rest of the
+outputs have no layout assigned.)code", nullptr);
+
+}  // namespace dali
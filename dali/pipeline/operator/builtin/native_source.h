@@ -0,0 +1,122 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_PIPELINE_OPERATOR_BUILTIN_NATIVE_SOURCE_H_
+#define DALI_PIPELINE_OPERATOR_BUILTIN_NATIVE_SOURCE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/pipeline/operator/operator.h"
+#include "dali/pipeline/operator/operator_factory.h"
+
+namespace dali {
+
+/**
+ * @brief Describes the batch requested from a NativeSource
+ */
+struct SourceBatchInfo {
+  /// The number of the iteration, counted from the start of the pipeline
+  int64_t iteration = 0;
+  /// The index of the first sample of the batch, counted from the start of the pipeline
+  int64_t first_sample = 0;
+  int batch_size = 0;
+};
+
+/**
+ * @brief A data source implemented in C++, usually in a plugin library
+ *
+ * The sources are registered with DALI_REGISTER_NATIVE_SOURCE and run by the
+ * `experimental.native_source` operator, which selects the source by the registered name.
+ * A plugin with sources is loaded like any other plugin, with `nvidia.dali.plugin_manager`.
+ *
+ * Each iteration, the operator calls `Setup`, allocates the outputs and then calls
+ * `RunSample` for each sample in the operator's thread pool. A batch source (e.g. one that
+ * reads all the records of the batch with a single read) overrides `RunBatch` instead.
+ *
+ * The constructor receives the OpSpec of the operator - the source can use `source_params`
+ * (an opaque string, e.g. a path to the data) and the common operator arguments.
+ */
+class DLL_PUBLIC NativeSource {
+ public:
+  virtual ~NativeSource() = default;
+
+  /**
+   * @brief Describes the outputs (shapes and types) of the next batch
+   *
+   * @param output_desc  the descriptions of the outputs, resized to the number of outputs
+   *                     of the operator; the shapes have `info.batch_size` samples
+   */
+  virtual void Setup(std::vector<OutputDesc> &output_desc, const SourceBatchInfo &info) = 0;
+
+  /**
+   * @brief Fills the sample `sample_idx` of all the outputs
+   *
+   * Called concurrently in the operator's thread pool.
+   */
+  virtual void RunSample(HostWorkspace &ws, const SourceBatchInfo &info, int sample_idx,
+                         int thread_idx) {
+    DALI_FAIL("The source must implement either RunSample or RunBatch.");
+  }
+
+  /**
+   * @brief Fills the outputs of the whole batch
+   *
+   * By default, runs `RunSample` for each sample in the thread pool of the workspace.
+   */
+  virtual void RunBatch(HostWorkspace &ws, const SourceBatchInfo &info);
+};
+
+DALI_DECLARE_OPTYPE_REGISTRY(NativeSource, NativeSource);
+
+/**
+ * @brief Registers a NativeSource under the given name
+ *
+ * The class must be constructible from `const OpSpec &`.
+ */
+#define DALI_REGISTER_NATIVE_SOURCE(SourceName, SourceType)                    \
+  DALI_DEFINE_OPTYPE_REGISTERER(SourceName, SourceType, ::dali::NativeSource, \
+                                ::dali::NativeSource, "CPU")
+
+/**
+ * @brief Runs a NativeSource selected with the `source` argument
+ */
+class NativeSourceOp : public Operator<CPUBackend> {
+ public:
+  explicit NativeSourceOp(const OpSpec &spec);
+
+  DISABLE_COPY_MOVE_ASSIGN(NativeSourceOp);
+
+ protected:
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) override;
+
+  void RunImpl(HostWorkspace &ws) override;
+
+ private:
+  std::unique_ptr<NativeSource> source_;
+  SourceBatchInfo info_;
+  std::vector<TensorLayout> layouts_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_OPERATOR_BUILTIN_NATIVE_SOURCE_H_
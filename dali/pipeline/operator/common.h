@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "dali/core/error_handling.h"
+#include "dali/core/mm/arena_resource.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/core/tensor_shape_print.h"
 #include "dali/pipeline/data/views.h"
@@ -27,8 +28,8 @@
 #include "dali/pipeline/workspace/workspace.h"
 
 namespace dali {
-template <typename T>
-inline void GetSingleOrRepeatedArg(const OpSpec &spec, vector<T> &result,
+template <typename T, typename Allocator>
+inline void GetSingleOrRepeatedArg(const OpSpec &spec, vector<T, Allocator> &result,
                                    const std::string &argName, size_t repeat_count = 2) {
   if (!spec.TryGetRepeatedArgument(result, argName)) {
     T scalar = spec.GetArgument<T>(argName);
@@ -44,40 +45,124 @@ inline void GetSingleOrRepeatedArg(const OpSpec &spec, vector<T> &result,
       to_string(result.size()) + " given.");
 }
 
+/**
+ * @brief A scalar argument of an operator, resolved when the operator is constructed.
+ *
+ * The handle keeps the constant value of the argument (explicit or default) and the slot of
+ * the argument input (see OpSpec::ArgumentInputSlot), so that the per-sample values can be
+ * obtained in every iteration without hashing the argument name.
+ *
+ * If the argument is neither provided nor has a default value, IsDefined() is false and
+ * the handle must not be used to get the value.
+ */
+template <typename T>
+class ArgHandle {
+ public:
+  ArgHandle() = default;
+
+  ArgHandle(std::string name, const OpSpec &spec)
+      : name_(std::move(name)), slot_(spec.ArgumentInputSlot(name_)) {
+    defined_ = IsArgumentInput() || spec.HasArgument(name_);
+    if (IsArgumentInput())
+      return;
+    const auto &schema = spec.GetSchema();
+    // the handles can be created by base classes shared by operators with different arguments
+    if (defined_ || (schema.HasArgument(name_, true) && schema.HasArgumentDefaultValue(name_)))
+      value_ = spec.GetArgument<T>(name_);
+  }
+
+  const std::string &name() const {
+    return name_;
+  }
+
+  /**
+   * @brief true if the value is provided explicitly (as a constant or as an argument input) -
+   *        an equivalent of `spec.ArgumentDefined(name)`
+   */
+  bool IsDefined() const {
+    return defined_;
+  }
+
+  bool IsArgumentInput() const {
+    return slot_ >= 0;
+  }
+
+  /**
+   * @brief The argument input; valid only if IsArgumentInput()
+   */
+  const TensorList<CPUBackend> &Input(const ArgumentWorkspace &ws) const {
+    assert(IsArgumentInput());
+    return ws.ArgumentInput(slot_, name_);
+  }
+
+  /**
+   * @brief The value of the argument for the given sample - an equivalent of
+   *        `spec.GetArgument<T>(name, &ws, sample_idx)`
+   */
+  T Get(const ArgumentWorkspace &ws, int sample_idx) const {
+    if (!IsArgumentInput())
+      return value_;
+    const auto &input = Input(ws);
+    DALI_ENFORCE(IsType<T>(input.type()), make_string(
+        "Unexpected type of argument \"", name_, "\". Expected ",
+        TypeTable::GetTypeName<T>(), " and got ", input.type()));
+    DALI_ENFORCE(volume(input.tensor_shape_span(sample_idx)) == 1, make_string(
+        "Unexpected shape of argument \"", name_, "\". Expected a scalar or a tensor "
+        "containing one element per sample. Got:\n", input.shape()));
+    return input.template tensor<T>(sample_idx)[0];
+  }
+
+ private:
+  std::string name_;
+  int slot_ = -1;
+  bool defined_ = false;
+  T value_{};
+};
+
+namespace detail {
+
+template <typename T>
+void CopyPerSampleArgument(std::vector<T> &output, const std::string &argument_name,
+                           const TensorList<CPUBackend> &arg, int batch_size) {
+  decltype(auto) shape = arg.shape();
+  int N = shape.num_samples();
+  if (N == 1) {
+    bool is_valid_shape = volume(shape.tensor_shape(0)) == batch_size;
+
+    DALI_ENFORCE(is_valid_shape, make_string("`", argument_name, "` must be a 1xN or Nx1 (N = ",
+                                             batch_size, ") tensor list. Got: ", shape));
+
+    output.resize(batch_size);
+    auto *data = arg.template tensor<T>(0);
+
+    for (int i = 0; i < batch_size; i++) {
+      output[i] = data[i];
+    }
+  } else {
+    bool is_valid_shape = N == batch_size &&
+                          is_uniform(shape) &&
+                          volume(shape.tensor_shape_span(0)) == 1;
+    DALI_ENFORCE(is_valid_shape,
+      make_string("`", argument_name, "` must be a 1xN or Nx1 (N = ", batch_size,
+                  ") tensor list. Got: ", shape));
+
+    output.resize(batch_size);
+    for (int i = 0; i < batch_size; i++) {
+      output[i] = arg.template tensor<T>(i)[0];
+    }
+  }
+}
+
+}  // namespace detail
+
 template <typename T>
 void GetPerSampleArgument(std::vector<T> &output, const std::string &argument_name,
                           const OpSpec &spec, const ArgumentWorkspace &ws, int batch_size) {
   DALI_ENFORCE(batch_size >= 0,
                make_string("Invalid batch size. Expected nonnegative, actual: ", batch_size));
   if (spec.HasTensorArgument(argument_name)) {
-    const auto &arg = ws.ArgumentInput(argument_name);
-    decltype(auto) shape = arg.shape();
-    int N = shape.num_samples();
-    if (N == 1) {
-      bool is_valid_shape = volume(shape.tensor_shape(0)) == batch_size;
-
-      DALI_ENFORCE(is_valid_shape, make_string("`", argument_name, "` must be a 1xN or Nx1 (N = ",
-                                               batch_size, ") tensor list. Got: ", shape));
-
-      output.resize(batch_size);
-      auto *data = arg.template tensor<T>(0);
-
-      for (int i = 0; i < batch_size; i++) {
-        output[i] = data[i];
-      }
-    } else {
-      bool is_valid_shape = N == batch_size &&
-                            is_uniform(shape) &&
-                            volume(shape.tensor_shape_span(0)) == 1;
-      DALI_ENFORCE(is_valid_shape,
-        make_string("`", argument_name, "` must be a 1xN or Nx1 (N = ", batch_size,
-                    ") tensor list. Got: ", shape));
-
-      output.resize(batch_size);
-      for (int i = 0; i < batch_size; i++) {
-        output[i] = arg.template tensor<T>(i)[0];
-      }
-    }
+    detail::CopyPerSampleArgument(output, argument_name, ws.ArgumentInput(argument_name),
+                                  batch_size);
   } else {
     output.clear();
     output.resize(batch_size, spec.GetArgument<T>(argument_name));
@@ -85,6 +170,24 @@ void GetPerSampleArgument(std::vector<T> &output, const std::string &argument_na
   assert(output.size() == static_cast<size_t>(batch_size));
 }
 
+/**
+ * @brief An equivalent of GetPerSampleArgument(output, arg.name(), spec, ws, batch_size),
+ *        which doesn't look up the argument by name.
+ */
+template <typename T>
+void GetPerSampleArgument(std::vector<T> &output, const ArgHandle<T> &arg,
+                          const ArgumentWorkspace &ws, int batch_size) {
+  DALI_ENFORCE(batch_size >= 0,
+               make_string("Invalid batch size. Expected nonnegative, actual: ", batch_size));
+  if (arg.IsArgumentInput()) {
+    detail::CopyPerSampleArgument(output, arg.name(), arg.Input(ws), batch_size);
+  } else {
+    output.clear();
+    output.resize(batch_size, arg.Get(ws, 0));
+  }
+  assert(output.size() == static_cast<size_t>(batch_size));
+}
+
 /**
  * @brief Fill the result span with the argument which can be provided as:
  * * ArgumentInput - {result.size()}-shaped Tensor
@@ -124,7 +227,7 @@ void GetGeneralizedArg(span<T> result, const std::string &name, int sample_idx,
     }
     return;
   }
-  std::vector<T> tmp;
+  mm::arena_vector<T> tmp{mm::arena_allocator<T>(ws.HostArena())};
   // we already handled the argument input, this handles spec-related arguments only
   GetSingleOrRepeatedArg(spec, tmp, name, argument_length);
   memcpy(result.data(), tmp.data(), sizeof(T) * argument_length);
@@ -175,13 +278,14 @@ std::pair<int, int> GetShapeLikeArgument(std::vector<ExtentType> &out_shape, con
     }
   } else {
     // If the argument is specified as a vector, it represents a uniform tensor list shape.
-    std::vector<ArgumentType> tsvec;
+    mm::arena_vector<ArgumentType> tsvec{mm::arena_allocator<ArgumentType>(ws.HostArena())};
     if (ndim >= 0) {
       // we have the luxury of knowing ndim ahead of time, so we can broadcast a scalar
-      GetSingleOrRepeatedArg<ArgumentType>(spec, tsvec, argument_name, ndim);
+      GetSingleOrRepeatedArg(spec, tsvec, argument_name, ndim);
     } else {
       // in dynamic use case, we get the dimensionality from the number of values
-      tsvec = spec.GetRepeatedArgument<ArgumentType>(argument_name);
+      if (!spec.TryGetRepeatedArgument(tsvec, argument_name))
+        (void) spec.GetRepeatedArgument<ArgumentType>(argument_name);  // let it throw
       ndim = tsvec.size();
     }
     out_shape.resize(batch_size * ndim);
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2017-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -22,6 +22,10 @@ namespace dali {
 
 DALI_SCHEMA(PipelineCommonTest).AddOptionalArg("size", "size", std::vector<float>{}, true);
 
+DALI_SCHEMA(PipelineCommonArgHandleTest)
+  .AddOptionalArg("flip", "flip", 1, true)
+  .AddOptionalArg("angle", "angle", 0.0f, true);
+
 TEST(PipelineCommon, GetShapeLikeArgumentScalar) {
   OpSpec spec("PipelineCommonTest");
   ArgumentWorkspace ws;
@@ -132,4 +136,49 @@ TEST(PipelineCommon, GetShapeLikeArgumentInput) {
   }
 }
 
+TEST(PipelineCommon, ArgHandle) {
+  OpSpec spec("PipelineCommonArgHandleTest");
+  ArgumentWorkspace ws;
+  int N = 3;
+  spec.SetArg("max_batch_size", N);
+  spec.AddArgumentInput("angle", "angle");
+
+  ArgHandle<int> flip("flip", spec);
+  ArgHandle<float> angle("angle", spec);
+  EXPECT_FALSE(flip.IsArgumentInput());
+  EXPECT_FALSE(flip.IsDefined());
+  EXPECT_TRUE(angle.IsArgumentInput());
+  EXPECT_TRUE(angle.IsDefined());
+  EXPECT_EQ(spec.ArgumentInputSlot("angle"), 0);
+  EXPECT_EQ(spec.ArgumentInputSlot("flip"), -1);
+
+  auto input = std::make_shared<TensorList<CPUBackend>>();
+  input->set_pinned(false);
+  input->Resize(TensorListShape<0>(N), DALI_FLOAT);
+  for (int sample_idx = 0; sample_idx < N; sample_idx++)
+    *input->mutable_tensor<float>(sample_idx) = sample_idx * 10.0f;
+
+  // the argument is not at its slot - it's found by name
+  auto other = std::make_shared<TensorList<CPUBackend>>();
+  ws.AddArgumentInput("other", other);
+  ws.AddArgumentInput("angle", input);
+
+  vector<float> angles;
+  GetPerSampleArgument(angles, angle, ws, N);
+  vector<int> flips;
+  GetPerSampleArgument(flips, flip, ws, N);
+  ASSERT_EQ(angles.size(), N);
+  ASSERT_EQ(flips.size(), N);
+  for (int i = 0; i < N; i++) {
+    EXPECT_EQ(angles[i], i * 10.0f);
+    EXPECT_EQ(angle.Get(ws, i), i * 10.0f);
+    EXPECT_EQ(flips[i], 1);
+    EXPECT_EQ(flip.Get(ws, i), 1);
+  }
+
+  ws.Clear();
+  ws.AddArgumentInput("angle", input);
+  EXPECT_EQ(&angle.Input(ws), input.get());
+}
+
 }  // namespace dali
@@ -191,6 +191,8 @@ class DLL_PUBLIC EagerOperator {
   int max_batch_size_;
   size_t num_outputs_;
   workspace_t<Backend> ws_;
+  // the outputs of the last call, kept to reuse their memory
+  std::vector<std::shared_ptr<WSOutputType>> output_buffers_;
   OpSpec op_spec_;
   std::string name_;
   std::unique_ptr<OperatorBase> op_;
@@ -294,8 +296,13 @@ EagerOperator<Backend>::RunImpl(
   std::vector<OutputDesc> output_desc{};
   std::vector<std::shared_ptr<TensorList<OutBackend>>> outputs(num_outputs_);
 
+  output_buffers_.resize(num_outputs_);
   for (size_t i = 0; i < num_outputs_; ++i) {
-    auto tensor_out = std::make_shared<WSOutputType>();
+    auto &tensor_out = output_buffers_[i];
+    // The buffer returned in the previous call can be reused, unless it's still referenced
+    if (!tensor_out || tensor_out.use_count() > 1) {
+      tensor_out = std::make_shared<WSOutputType>();
+    }
     if (ws_.has_stream()) {
       tensor_out->set_order(ws_.stream());
     }
@@ -17,6 +17,7 @@
 #include <string>
 #include "dali/pipeline/operator/op_spec.h"
 #include "dali/core/python_util.h"
+#include "dali/plugin/plugin_manager.h"
 
 namespace dali {
 
@@ -37,16 +38,17 @@ OpSchema& SchemaRegistry::RegisterSchema(const std::string &name) {
 }
 
 const OpSchema& SchemaRegistry::GetSchema(const std::string &name) {
-  auto &schema_map = registry();
-  auto it = schema_map.find(name);
-  DALI_ENFORCE(it != schema_map.end(), "Schema for operator '" +
+  auto *schema = TryGetSchema(name);
+  DALI_ENFORCE(schema != nullptr, "Schema for operator '" +
       name + "' not registered");
-  return it->second;
+  return *schema;
 }
 
 const OpSchema* SchemaRegistry::TryGetSchema(const std::string &name) {
   auto &schema_map = registry();
   auto it = schema_map.find(name);
+  if (it == schema_map.end() && PluginManager::LoadDeferredLibrary(name))
+    it = schema_map.find(name);
   return it != schema_map.end() ? &it->second : nullptr;
 }
 
@@ -244,6 +246,16 @@ bool OpSchema::HasOptionalArgument(const std::string &name, const bool local_onl
   return ret;
 }
 
+bool OpSchema::IsNondeterministic() const {
+  if (nondeterministic_)
+    return true;
+  for (const auto &p : parents_) {
+    if (SchemaRegistry::GetSchema(p).IsNondeterministic())
+      return true;
+  }
+  return false;
+}
+
 bool OpSchema::HasInternalArgument(const std::string &name, const bool local_only) const {
   bool ret = internal_arguments_.find(name) != internal_arguments_.end();
   if (ret || local_only) {
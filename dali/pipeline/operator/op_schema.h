@@ -79,6 +79,7 @@ class DLL_PUBLIC OpSchema {
     AddInternalArg("device", "Device on which the Op is run", std::string("cpu"));
     AddInternalArg("inplace", "Whether Op can be run in place", false);
     AddInternalArg("default_cuda_stream_priority", "Default cuda stream priority", 0);
+    AddInternalArg("host_arena_size_hint", "Initial size of the host arena, in bytes", 0);
 
     AddOptionalArg("seed", R"code(Random seed.
 
@@ -645,6 +646,57 @@ used with DALIDataType, to avoid confusion with `AddOptionalArg<type>(name, doc,
     return *this;
   }
 
+  /**
+   * @brief Notes that the outputs of this operator don't depend only on its inputs and
+   * arguments - it's random, keeps a state between the iterations or has side effects.
+   *
+   * Two instances of such an operator are never merged, even if their specs are identical.
+   * The property is inherited by the schemas which list this one as a parent.
+   */
+  DLL_PUBLIC inline OpSchema& Nondeterministic() {
+    nondeterministic_ = true;
+    return *this;
+  }
+
+  /**
+   * @brief Notes that the GPU implementation of this operator can be captured in a CUDA graph
+   * and replayed.
+   *
+   * When the shapes and addresses of the inputs and outputs don't change between iterations,
+   * the Run of such an operator must issue the same work on the workspace stream, without
+   * allocating memory (which rules out DynamicScratchpad), synchronizing with the host or
+   * depending on any other host-side state.
+   */
+  DLL_PUBLIC inline OpSchema& CUDAGraphSafe() {
+    cuda_graph_safe_ = true;
+    return *this;
+  }
+
+  /**
+   * @brief Notes that the GPU implementation of this operator can process a batch in parts.
+   *
+   * Each sample of the outputs must depend only on the corresponding samples of the inputs
+   * and arguments - not on the other samples or on the index of the sample in the batch.
+   * The executor may then run the operator for sub-batches of the batch (see
+   * Executor::EnableGPUMicroBatching), with inputs which are not contiguous.
+   */
+  DLL_PUBLIC inline OpSchema& MicroBatchable() {
+    micro_batchable_ = true;
+    return *this;
+  }
+
+  /**
+   * @brief Notes that this operator is pointwise, computes its output in float and converts it,
+   * with saturation, to the output type selected with the ``dtype`` argument.
+   *
+   * When the ``dtype`` of such an operator is float, a Cast which follows it can be fused into
+   * the operator by setting its ``dtype`` to the type of the Cast (if it's one of output_types).
+   */
+  DLL_PUBLIC inline OpSchema& PointwiseFusable(std::vector<DALIDataType> output_types) {
+    pointwise_fusable_output_types_ = std::move(output_types);
+    return *this;
+  }
+
   /**
    * @brief Informs that the data passes though this operator unchanged, only
    *        the metadata is affected.
@@ -829,6 +881,24 @@ used with DALIDataType, to avoid confusion with `AddOptionalArg<type>(name, doc,
     return no_prune_;
   }
 
+  DLL_PUBLIC bool IsNondeterministic() const;
+
+  DLL_PUBLIC inline bool IsCUDAGraphSafe() const {
+    return cuda_graph_safe_;
+  }
+
+  DLL_PUBLIC inline bool IsMicroBatchable() const {
+    return micro_batchable_;
+  }
+
+  DLL_PUBLIC inline bool IsPointwiseFusable() const {
+    return !pointwise_fusable_output_types_.empty();
+  }
+
+  DLL_PUBLIC inline const std::vector<DALIDataType> &PointwiseFusableOutputTypes() const {
+    return pointwise_fusable_output_types_;
+  }
+
   DLL_PUBLIC inline bool IsSerializable() const {
     return serializable_;
   }
@@ -1010,6 +1080,14 @@ used with DALIDataType, to avoid confusion with `AddOptionalArg<type>(name, doc,
 
   bool no_prune_ = false;
 
+  bool nondeterministic_ = false;
+
+  bool cuda_graph_safe_ = false;
+
+  bool micro_batchable_ = false;
+
+  std::vector<DALIDataType> pointwise_fusable_output_types_;
+
   bool serializable_ = true;
 
   std::map<int, int> passthrough_map_;
@@ -1033,6 +1111,12 @@ used with DALIDataType, to avoid confusion with `AddOptionalArg<type>(name, doc,
 class SchemaRegistry {
  public:
   DLL_PUBLIC static OpSchema& RegisterSchema(const std::string &name);
+  /**
+   * @brief Returns the schema of the operator `name`
+   *
+   * If the schema is not registered, but the operator is provided by a deferred library
+   * (see PluginManager::RegisterDeferredLibrary), the library is loaded first.
+   */
   DLL_PUBLIC static const OpSchema& GetSchema(const std::string &name);
   DLL_PUBLIC static const OpSchema* TryGetSchema(const std::string &name);
 
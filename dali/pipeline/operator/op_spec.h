@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <memory>
 #include <set>
+#include <iterator>
 #include <type_traits>
 
 #include "dali/core/common.h"
@@ -316,6 +317,22 @@ class DLL_PUBLIC OpSpec {
     return arg_it != argument_inputs_.end();
   }
 
+  /**
+   * @brief Returns the position of the tensor argument among the argument inputs, ordered by
+   *        their input indices, or -1 if the argument is not a tensor argument.
+   *
+   * The executor adds the argument inputs to the workspace in this order, so the slot can be
+   * resolved once (at operator construction) and used with ArgumentWorkspace::ArgumentInput
+   * to avoid looking up the argument by name in every iteration.
+   */
+  DLL_PUBLIC int ArgumentInputSlot(const std::string &name) const {
+    auto arg_it = argument_inputs_.find(name);
+    if (arg_it == argument_inputs_.end())
+      return -1;
+    auto idx_it = argument_inputs_indexes_.find(arg_it->second);
+    return std::distance(argument_inputs_indexes_.begin(), idx_it);
+  }
+
   /**
    * @brief Checks the spec to see if an argument has been specified by one of two possible ways
    */
@@ -140,6 +140,30 @@ class DLL_PUBLIC OperatorBase {
     return {};
   }
 
+  /**
+   * @brief For reader Ops with `enable_checkpointing`, returns the state of the reader
+   * after the given number of batches was returned
+   */
+  DLL_PUBLIC virtual std::string GetReaderState(int64_t) {
+    DALI_FAIL(make_string("Operator ", spec_.name(), " has no state to save."));
+  }
+
+  /**
+   * @brief For reader Ops with `enable_checkpointing`, restores the state obtained with
+   * GetReaderState. Must be called before the operator is run.
+   */
+  DLL_PUBLIC virtual void RestoreReaderState(const std::string &) {
+    DALI_FAIL(make_string("Operator ", spec_.name(), " has no state to restore."));
+  }
+
+  /**
+   * @brief For reader Ops, changes the sharding of the dataset while reading.
+   * See Loader::Reshard.
+   */
+  DLL_PUBLIC virtual void ReshardReader(int, int, int64_t) {
+    DALI_FAIL(make_string("Operator ", spec_.name(), " is not a reader that can be resharded."));
+  }
+
   DLL_PUBLIC const OpSpec& GetSpec() const {
     return spec_;
   }
@@ -199,6 +223,17 @@ class DLL_PUBLIC OperatorBase {
     dali::GetPerSampleArgument(output, argument_name, spec_, ws, batch_size);
   }
 
+  /**
+   * @brief Fill output vector with per-sample argument values, using an argument handle
+   *        created at operator construction.
+   */
+  template<typename T>
+  void GetPerSampleArgument(std::vector<T> &output, const ArgHandle<T> &arg,
+                            const ArgumentWorkspace &ws, int batch_size) {
+    DALI_ENFORCE(batch_size > 0, "Default batch size (-1) is not supported anymore");
+    dali::GetPerSampleArgument(output, arg, ws, batch_size);
+  }
+
   // TODO(mszolucha): remove these two to allow i2i variable batch size, when all ops are ready
   template <typename Backend>
   DLL_PUBLIC void EnforceUniformInputBatchSize(const workspace_t<Backend> &ws) const;
@@ -1,4 +1,4 @@
-// Copyright (c) 2017-2018, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2017-2018, 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -25,6 +25,7 @@
 #include "dali/core/common.h"
 #include "dali/core/error_handling.h"
 #include "dali/pipeline/operator/op_schema.h"
+#include "dali/plugin/plugin_manager.h"
 
 namespace dali {
 
@@ -48,11 +49,17 @@ class OperatorRegistry {
 
   std::unique_ptr<OpType> Create(
       const std::string &name, const OpSpec &spec, const std::string *devName = NULL) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto creator_it = registry_.find(name);
-    DALI_ENFORCE(creator_it != registry_.end(),
+    Creator creator = GetCreator(name);
+    // The operators of a deferred library are registered when it's loaded, on first use
+    if (!creator && PluginManager::LoadDeferredLibrary(name))
+      creator = GetCreator(name);
+    DALI_ENFORCE(creator != nullptr,
         "Operator \"" + name + "\" not registered" + (devName? (" for " + *devName) : "") + ".");
-    return registry_[name](spec);
+    return creator(spec);
+  }
+
+  bool IsRegistered(const std::string &name) {
+    return static_cast<bool>(GetCreator(name));
   }
 
   vector<std::string> RegisteredNames(bool internal_ops) {
@@ -66,6 +73,12 @@ class OperatorRegistry {
   }
 
  private:
+  Creator GetCreator(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto creator_it = registry_.find(name);
+    return creator_it != registry_.end() ? creator_it->second : Creator();
+  }
+
   CreatorRegistry registry_;
   std::mutex mutex_;
 };
@@ -0,0 +1,139 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_OPERATOR_SAMPLE_PARALLEL_OPERATOR_H_
+#define DALI_PIPELINE_OPERATOR_SAMPLE_PARALLEL_OPERATOR_H_
+
+#include <algorithm>
+#include <vector>
+#include "dali/core/util.h"
+#include "dali/pipeline/operator/operator.h"
+
+namespace dali {
+
+/**
+ * @brief Base class for CPU operators which process the samples independently
+ *
+ * Unlike the default RunImpl, which schedules the samples in the order of the batch, the samples
+ * are scheduled largest-first, according to the cost reported by SampleCost (by default, the
+ * total volume of the outputs, as returned by SetupImpl). This way a single large sample does not
+ * end up being processed last, while the other threads are idle.
+ *
+ * A sample can additionally be split into ranges of rows (see NumRows), processed by separate
+ * tasks. A sample is split when it's more expensive than an even share of the batch cost
+ * per thread, but the tasks are never cheaper than `min_task_cost_`.
+ *
+ * Derived classes implement RunSample, which processes a range of rows of a single sample.
+ */
+class SampleParallelOperator : public Operator<CPUBackend> {
+ public:
+  inline explicit SampleParallelOperator(const OpSpec &spec) : Operator<CPUBackend>(spec) {}
+
+  using Operator<CPUBackend>::Setup;
+  using Operator<CPUBackend>::RunImpl;
+
+  bool Setup(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) override {
+    bool inferred = Operator<CPUBackend>::Setup(output_desc, ws);
+    output_shapes_.clear();
+    if (inferred) {
+      for (auto &desc : output_desc)
+        output_shapes_.push_back(desc.shape);
+    }
+    return inferred;
+  }
+
+  void RunImpl(HostWorkspace &ws) override {
+    int nsamples = ws.NumInput() > 0 ? ws.GetInputBatchSize(0) : max_batch_size_;
+    auto &thread_pool = ws.GetThreadPool();
+
+    costs_.resize(nsamples);
+    int64_t total_cost = 0;
+    for (int i = 0; i < nsamples; i++) {
+      costs_[i] = std::max<int64_t>(SampleCost(ws, i), 0);
+      total_cost += costs_[i];
+    }
+    int64_t max_task_cost = std::max<int64_t>(
+        min_task_cost_, div_ceil(total_cost, std::max(thread_pool.NumThreads(), 1)));
+
+    for (int i = 0; i < nsamples; i++) {
+      int64_t rows = std::max<int64_t>(NumRows(ws, i), 0);
+      int64_t ntasks = 1;
+      if (rows > 1)
+        ntasks = std::min(rows, std::max<int64_t>(div_ceil(costs_[i], max_task_cost), 1));
+      for (int64_t t = 0; t < ntasks; t++) {
+        int64_t begin = rows * t / ntasks;
+        int64_t end = rows * (t + 1) / ntasks;
+        // the priority is the cost of the task, so the largest tasks are picked up first
+        int64_t task_cost = rows > 0 ? costs_[i] * (end - begin) / rows : costs_[i];
+        thread_pool.AddWork([this, &ws, i, begin, end](int tid) {
+          RunSample(ws, i, begin, end, tid);
+        }, task_cost);
+      }
+    }
+    thread_pool.RunAll();
+  }
+
+ protected:
+  /**
+   * @brief Processes the rows [row_begin, row_end) of the sample `sample_idx`
+   *
+   * Different ranges of rows of the same sample can be processed concurrently.
+   */
+  virtual void RunSample(HostWorkspace &ws, int sample_idx,
+                         int64_t row_begin, int64_t row_end, int thread_idx) = 0;
+
+  /**
+   * @brief The relative cost of processing a sample
+   *
+   * By default, the total volume of the outputs, if they were set up by SetupImpl, or the total
+   * volume of the inputs, otherwise.
+   */
+  virtual int64_t SampleCost(const HostWorkspace &ws, int sample_idx) const {
+    int64_t cost = 0;
+    if (!output_shapes_.empty()) {
+      for (auto &shape : output_shapes_)
+        cost += volume(shape.tensor_shape_span(sample_idx));
+    } else {
+      for (int i = 0; i < ws.NumInput(); i++) {
+        if (ws.InputIsType<CPUBackend>(i))
+          cost += volume(ws.Input<CPUBackend>(i).tensor_shape_span(sample_idx));
+      }
+    }
+    return cost;
+  }
+
+  /**
+   * @brief The number of rows which can be processed independently
+   *
+   * The default value of 1 disables the splitting of the samples. Operators which can process
+   * a part of a sample, e.g. a range of the outermost dimension of the output, should return
+   * the extent of that range.
+   */
+  virtual int64_t NumRows(const HostWorkspace &ws, int sample_idx) const {
+    return 1;
+  }
+
+  /// @brief The minimum cost of a part of a split sample
+  int64_t min_task_cost_ = 1 << 16;
+
+  /// @brief The output shapes returned by SetupImpl; empty, if the outputs were not inferred
+  std::vector<TensorListShape<>> output_shapes_;
+
+ private:
+  std::vector<int64_t> costs_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_OPERATOR_SAMPLE_PARALLEL_OPERATOR_H_
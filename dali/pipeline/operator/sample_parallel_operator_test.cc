@@ -0,0 +1,111 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+#include "dali/pipeline/operator/sample_parallel_operator.h"
+
+namespace dali {
+namespace testing {
+
+namespace {
+
+using Task = std::tuple<int, int64_t, int64_t>;  // sample, row_begin, row_end
+
+class TaskRecorder : public SampleParallelOperator {
+ public:
+  explicit TaskRecorder(const OpSpec &spec) : SampleParallelOperator(spec) {
+    min_task_cost_ = 1;
+  }
+
+  bool CanInferOutputs() const override {
+    return true;
+  }
+
+  bool SetupImpl(std::vector<OutputDesc> &output_desc, const HostWorkspace &ws) override {
+    auto &in = ws.Input<CPUBackend>(0);
+    output_desc.resize(1);
+    output_desc[0] = {in.shape(), in.type()};
+    return true;
+  }
+
+  std::vector<Task> tasks;
+
+ protected:
+  int64_t NumRows(const HostWorkspace &ws, int sample_idx) const override {
+    return ws.Input<CPUBackend>(0).tensor_shape_span(sample_idx)[0];
+  }
+
+  void RunSample(HostWorkspace &ws, int sample_idx,
+                 int64_t row_begin, int64_t row_end, int thread_idx) override {
+    std::lock_guard<std::mutex> guard(mtx_);
+    tasks.emplace_back(sample_idx, row_begin, row_end);
+  }
+
+ private:
+  std::mutex mtx_;
+};
+
+std::vector<Task> RunTasks(const TensorListShape<> &shape, int num_threads) {
+  auto spec = OpSpec("Copy")
+    .AddArg("num_threads", num_threads)
+    .AddArg("max_batch_size", shape.num_samples())
+    .AddArg("device", "cpu");
+  TaskRecorder op(spec);
+  ThreadPool tp(num_threads, CPU_ONLY_DEVICE_ID, false, "SampleParallelOperator test");
+  HostWorkspace ws;
+  ws.SetThreadPool(&tp);
+  auto in = std::make_shared<TensorList<CPUBackend>>();
+  auto out = std::make_shared<TensorList<CPUBackend>>();
+  in->Resize(shape, DALI_UINT8);
+  out->Resize(shape, DALI_UINT8);
+  ws.AddInput(in);
+  ws.AddOutput(out);
+
+  std::vector<OutputDesc> output_desc;
+  EXPECT_TRUE(op.Setup(output_desc, ws));
+  op.Run(ws);
+  return op.tasks;
+}
+
+}  // namespace
+
+TEST(SampleParallelOperator, LargestFirst) {
+  // a single thread has the whole batch as its share - no splitting
+  auto tasks = RunTasks({{10, 10}, {1000, 100}, {20, 10}, {5, 1}}, 1);
+  std::vector<Task> expected = {{1, 0, 1000}, {2, 0, 20}, {0, 0, 10}, {3, 0, 5}};
+  EXPECT_EQ(tasks, expected);
+}
+
+TEST(SampleParallelOperator, SplitLargeSamples) {
+  TensorListShape<> shape = {{10, 10}, {1000, 100}, {20, 10}, {1, 1000}};
+  auto tasks = RunTasks(shape, 4);
+  std::sort(tasks.begin(), tasks.end());
+
+  // the large sample is split into 4 tasks, as it takes almost the whole batch
+  std::vector<Task> expected = {
+    {0, 0, 10},
+    {1, 0, 250}, {1, 250, 500}, {1, 500, 750}, {1, 750, 1000},
+    {2, 0, 20},
+    {3, 0, 1}
+  };
+  EXPECT_EQ(tasks, expected);
+}
+
+}  // namespace testing
+}  // namespace dali
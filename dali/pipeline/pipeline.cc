@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <limits>
 #include <memory>
 
 #include "dali/pipeline/executor/async_pipelined_executor.h"
@@ -450,11 +451,29 @@ void Pipeline::Build(std::vector<PipelineOutputDesc> output_descs) {
   DALI_ENFORCE(num_outputs > 0,
                make_string("User specified incorrect number of outputs (", num_outputs, ")."));
 
+  if (auto_placement_)
+    PlaceOperatorsAutomatically();
+
   executor_ =
-      GetExecutor(pipelined_execution_, separated_execution_, async_execution_, max_batch_size_,
-                  num_threads_, device_id_, bytes_per_sample_hint_, set_affinity_, max_num_stream_,
-                  default_cuda_stream_priority_, prefetch_queue_depth_);
+      GetExecutor(pipelined_execution_, separated_execution_, async_execution_,
+                  dataflow_execution_, low_latency_execution_, max_batch_size_, num_threads_,
+                  device_id_, bytes_per_sample_hint_, set_affinity_, max_num_stream_,
+                  default_cuda_stream_priority_, prefetch_queue_depth_, thread_pool_type_);
   executor_->EnableMemoryStats(enable_memory_stats_);
+  executor_->EnableTimingStats(enable_timing_stats_);
+  if (bottleneck_analysis_interval_s_ > 0)
+    executor_->EnableBottleneckAnalysis(bottleneck_analysis_interval_s_);
+  executor_->EnableGPUMultiStream(gpu_multi_stream_);
+  executor_->EnableGPUGraphCapture(gpu_graph_capture_);
+  executor_->EnableGPUMemoryPlanning(gpu_memory_planning_);
+  executor_->EnableGPUMicroBatching(gpu_micro_batch_size_);
+  if (urgent_cuda_stream_priority_)
+    executor_->SetUrgentStreamPriority(*urgent_cuda_stream_priority_);
+  if (adaptive_queue_depth_) {
+    DALI_ENFORCE(async_execution_ && pipelined_execution_,
+                 "Adaptive queue depth requires asynchronous pipelined execution.");
+    executor_->EnableAdaptiveQueueDepth(min_prefetch_queue_depth_);
+  }
   executor_->Init();
 
   // Creating the graph
@@ -541,6 +560,13 @@ void Pipeline::Build(std::vector<PipelineOutputDesc> output_descs) {
     }
   }
 
+  // Casts following the pointwise operators are absorbed by these operators
+  graph_.FusePointwiseOps();
+  // The unused and the duplicated operators are not even instantiated
+  graph_.PruneUnusedOps(outputs);
+  graph_.EliminateCommonSubexpressions(outputs);
+  graph_.BypassNondeterministicCaches();
+
   graph_.InstantiateOperators();
 
   // Load the final graph into the executor
@@ -569,6 +595,7 @@ void Pipeline::RunCPU() {
   DALI_ENFORCE(built_,
       "\"Build()\" must be called prior to executing the pipeline.");
   executor_->RunCPU();
+  iterations_scheduled_++;
 }
 
 void Pipeline::RunGPU() {
@@ -603,6 +630,7 @@ void Pipeline::Outputs(DeviceWorkspace *ws) {
   DALI_ENFORCE(built_, "\"Build()\" must be called prior to executing the pipeline.");
   try {
     executor_->Outputs(ws);
+    outputs_returned_++;
   } catch (std::exception &e) {
     throw std::runtime_error(make_string("Critical error in pipeline:\n", std::string(e.what()),
                                          "\nCurrent pipeline object is no longer valid."));
@@ -613,10 +641,11 @@ void Pipeline::Outputs(DeviceWorkspace *ws) {
   ValidateOutputs(*ws);
 }
 
-void Pipeline::ShareOutputs(DeviceWorkspace *ws) {
+void Pipeline::ShareOutputs(DeviceWorkspace *ws, AccessOrder order) {
   DALI_ENFORCE(built_, "\"Build()\" must be called prior to executing the pipeline.");
   try {
-    executor_->ShareOutputs(ws);
+    executor_->ShareOutputs(ws, order);
+    outputs_returned_++;
   } catch (std::exception &e) {
     throw std::runtime_error(make_string("Critical error in pipeline:\n", std::string(e.what()),
                                          "\nCurrent pipeline object is no longer valid."));
@@ -627,11 +656,57 @@ void Pipeline::ShareOutputs(DeviceWorkspace *ws) {
   ValidateOutputs(*ws);
 }
 
-void Pipeline::ReleaseOutputs() {
+namespace {
+
+template <typename Backend>
+std::shared_ptr<TensorList<Backend>> CopyOutput(const TensorList<Backend> &output) {
+  auto copy = std::make_shared<TensorList<Backend>>();
+  copy->set_pinned(output.is_pinned());
+  copy->Copy(output, output.order());
+  return copy;
+}
+
+}  // namespace
+
+void Pipeline::OutputsOf(int64_t iteration, DeviceWorkspace *ws) {
+  DALI_ENFORCE(iteration >= 0 && iteration < iterations_scheduled_,
+               make_string("The iteration ", iteration, " was not scheduled (",
+                           iterations_scheduled_, " iterations were scheduled so far)."));
+  auto stashed = stashed_outputs_.find(iteration);
+  if (stashed != stashed_outputs_.end()) {
+    *ws = std::move(stashed->second);
+    stashed_outputs_.erase(stashed);
+    return;
+  }
+  DALI_ENFORCE(iteration >= outputs_returned_,
+               make_string("The outputs of the iteration ", iteration, " were already returned."));
+  while (outputs_returned_ <= iteration) {
+    int64_t current = outputs_returned_;
+    DeviceWorkspace shared, copied;
+    ShareOutputs(&shared);
+    for (int i = 0; i < shared.NumOutput(); i++) {
+      if (shared.OutputIsType<CPUBackend>(i)) {
+        copied.AddOutput(CopyOutput(shared.Output<CPUBackend>(i)));
+      } else {
+        const auto &output = shared.Output<GPUBackend>(i);
+        copied.AddOutput(CopyOutput(output));
+        // the copy must be complete before the buffer is reused
+        AccessOrder::host().wait(output.order());
+      }
+    }
+    ReleaseOutputs();
+    if (current == iteration)
+      *ws = std::move(copied);
+    else
+      stashed_outputs_[current] = std::move(copied);
+  }
+}
+
+void Pipeline::ReleaseOutputs(AccessOrder consumer_order) {
   DALI_ENFORCE(built_,
       "\"Build()\" must be called prior to executing the pipeline.");
     try {
-      executor_->ReleaseOutputs();
+      executor_->ReleaseOutputs(consumer_order);
     } catch (std::exception &e) {
       throw std::runtime_error("Critical error in pipeline:\n"
           + std::string(e.what())
@@ -671,6 +746,41 @@ void Pipeline::SetupGPUInput(std::map<string, EdgeMeta>::iterator it) {
   it->second.has_gpu = true;
 }
 
+void Pipeline::PlaceOperatorsAutomatically() {
+  if (device_id_ == CPU_ONLY_DEVICE_ID)
+    return;
+  std::vector<PlacementNode> nodes;
+  for (auto &def : op_specs_for_serialization_)
+    nodes.push_back({def.instance_name, def.spec, def.logical_id});
+  std::set<std::string> cpu_outputs;
+  for (auto &out : output_descs_) {
+    if (out.device == "cpu")
+      cpu_outputs.insert(out.name);
+  }
+  placement_report_ = PlaceOperators(nodes, cpu_outputs, placement_costs_, placement_options_);
+  bool any_moved = false;
+  for (auto &decision : placement_report_.decisions)
+    any_moved |= decision.moved;
+  if (!any_moved)
+    return;
+
+  // The copies to the GPU and the edges depend on the devices - add the operators from scratch
+  op_specs_.clear();
+  op_specs_for_serialization_.clear();
+  logical_ids_.clear();
+  edge_names_.clear();
+  ext_input_names_.clear();
+  for (auto &node : nodes)
+    AddOperator(node.spec, node.instance_name, node.logical_id);
+}
+
+OperatorCostMap Pipeline::GetOperatorCosts() {
+  std::vector<PlacementNode> nodes;
+  for (auto &def : op_specs_for_serialization_)
+    nodes.push_back({def.instance_name, def.spec, def.logical_id});
+  return OperatorCosts(nodes, GetExecutorTimingStats());
+}
+
 void Pipeline::PrepareOpSpec(OpSpec *spec, int logical_id) {
   if (logical_id_to_seed_.find(logical_id) == logical_id_to_seed_.end()) {
     logical_id_to_seed_[logical_id] = seed_[current_seed_];
@@ -719,7 +829,8 @@ void SerializeToProtobuf(dali_proto::OpDef *op, const string &inst_name, const O
     // loading a serialized pipeline
     if (a.first == "max_batch_size" ||
         a.first == "num_threads" ||
-        a.first == "bytes_per_sample_hint") {
+        a.first == "bytes_per_sample_hint" ||
+        a.first == "host_arena_size_hint") {
       continue;
     }
 
@@ -730,7 +841,58 @@ void SerializeToProtobuf(dali_proto::OpDef *op, const string &inst_name, const O
   }
 }
 
-string Pipeline::SerializeToProtobuf() const {
+/**
+ * @brief Stores the largest output samples and the host arena peak usage of the operator,
+ *        observed by the executor, in `bytes_per_sample_hint` and `host_arena_size_hint`
+ */
+void SerializeMemoryHints(dali_proto::OpDef *op, const string &inst_name, const OpSpec &spec,
+                          const ExecutorMetaMap &memory_stats,
+                          const HostArenaStatsMap &arena_stats) {
+  // the statistics are keyed by the stage and the instance name
+  const std::vector<ExecutorMeta> *outputs_meta = nullptr;
+  const mm::arena_stats *arena = nullptr;
+  for (const char *stage : {"CPU_", "MIXED_", "GPU_"}) {
+    auto stats_name = stage + inst_name;
+    auto meta_it = memory_stats.find(stats_name);
+    if (meta_it != memory_stats.end())
+      outputs_meta = &meta_it->second;
+    auto arena_it = arena_stats.find(stats_name);
+    if (arena_it != arena_stats.end())
+      arena = &arena_it->second;
+  }
+
+  auto clamp_hint = [](size_t bytes) {
+    return static_cast<int>(std::min<size_t>(bytes, std::numeric_limits<int>::max()));
+  };
+
+  if (outputs_meta && !outputs_meta->empty()) {
+    std::vector<int> hints;
+    GetSingleOrRepeatedArg(spec, hints, "bytes_per_sample_hint", spec.NumOutput());
+    for (size_t i = 0; i < hints.size() && i < outputs_meta->size(); i++)
+      hints[i] = std::max(hints[i], clamp_hint((*outputs_meta)[i].max_real_size));
+    dali_proto::Argument *arg = op->add_args();
+    DaliProtoPriv arg_wrap(arg);
+    Argument::Store("bytes_per_sample_hint", hints)->SerializeToProtobuf(&arg_wrap);
+  }
+  if (arena && arena->peak_bytes > 0) {
+    dali_proto::Argument *arg = op->add_args();
+    DaliProtoPriv arg_wrap(arg);
+    Argument::Store("host_arena_size_hint", clamp_hint(arena->peak_bytes))
+        ->SerializeToProtobuf(&arg_wrap);
+  }
+}
+
+string Pipeline::SerializeToProtobuf(bool memory_hints) const {
+  DALI_ENFORCE(!memory_hints || (built_ && enable_memory_stats_),
+               "Serializing the memory hints requires a built pipeline with the executor memory "
+               "statistics enabled.");
+  ExecutorMetaMap memory_stats;
+  HostArenaStatsMap arena_stats;
+  if (memory_hints) {
+    memory_stats = executor_->GetExecutorMeta();
+    arena_stats = executor_->GetHostArenaStats();
+  }
+
   dali_proto::PipelineDef pipe;
   pipe.set_num_threads(this->num_threads());
   pipe.set_batch_size(this->max_batch_size());
@@ -748,6 +910,8 @@ string Pipeline::SerializeToProtobuf() const {
                                                     + spec.name());
 
     dali::SerializeToProtobuf(op_def, p.instance_name, spec, p.logical_id);
+    if (memory_hints)
+      SerializeMemoryHints(op_def, p.instance_name, spec, memory_stats, arena_stats);
   }
 
   // loop over outputs used to create the graph
@@ -794,6 +958,22 @@ ReaderMeta Pipeline::GetReaderMeta(std::string name) {
   return meta;
 }
 
+std::string Pipeline::GetReaderState(const std::string &name) {
+  DALI_ENFORCE(built_, "\"Build()\" must be called prior to getting the reader state.");
+  return GetOperatorNode(name)->op->GetReaderState(outputs_returned_);
+}
+
+void Pipeline::RestoreReaderState(const std::string &name, const std::string &state) {
+  DALI_ENFORCE(built_, "\"Build()\" must be called prior to restoring the reader state.");
+  GetOperatorNode(name)->op->RestoreReaderState(state);
+}
+
+void Pipeline::ReshardReader(const std::string &name, int num_shards, int shard_id,
+                             int64_t at_sample) {
+  DALI_ENFORCE(built_, "\"Build()\" must be called prior to resharding a reader.");
+  GetOperatorNode(name)->op->ReshardReader(num_shards, shard_id, at_sample);
+}
+
 const TensorLayout& Pipeline::GetInputLayout(const std::string &name) {
   const auto *node = GetOperatorNode(name);
   if (node->op_type == OpType::CPU) {
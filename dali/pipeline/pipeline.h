@@ -19,6 +19,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <optional>
 #include <random>
 #include <set>
 #include <string>
@@ -32,6 +33,7 @@
 #include "dali/pipeline/data/tensor.h"
 #include "dali/pipeline/data/tensor_list.h"
 #include "dali/pipeline/executor/executor.h"
+#include "dali/pipeline/graph/device_placement.h"
 #include "dali/pipeline/graph/op_graph.h"
 #include "dali/pipeline/pipeline_output_desc.h"
 #include "dali/pipeline/operator/builtin/external_source.h"
@@ -263,14 +265,104 @@ class DLL_PUBLIC Pipeline {
    * @param pipelined_execution Use pipelined execution
    * @param separated_execution Use separated queues
    * @param async_execution Use worker threads for RunX() functions
+   * @param dataflow_execution Run independent CPU operators concurrently, as soon as their
+   *                           inputs are ready. Requires pipelined and asynchronous execution.
+   * @param low_latency_execution Minimize the latency of an iteration, for small batches: the stages
+   *                              run back-to-back in the calling thread, with one buffer per
+   *                              output and one CUDA stream. Requires synchronous, non-pipelined
+   *                              execution.
    */
   DLL_PUBLIC void SetExecutionTypes(bool pipelined_execution = true,
-                                    bool separated_execution = false, bool async_execution = true) {
+                                    bool separated_execution = false, bool async_execution = true,
+                                    bool dataflow_execution = false,
+                                    bool low_latency_execution = false) {
     DALI_ENFORCE(!built_, "Alterations to the pipeline after "
         "\"Build()\" has been called are not allowed - cannot change execution type.");
     pipelined_execution_ = pipelined_execution;
     separated_execution_ = separated_execution;
     async_execution_ = async_execution;
+    dataflow_execution_ = dataflow_execution;
+    low_latency_execution_ = low_latency_execution;
+  }
+
+  /**
+   * @brief Set the scheduling strategy of the thread pool used by the CPU operators
+   *
+   * Must be called before Build()
+   *
+   * @param thread_pool_type ThreadPoolType::WorkStealing reduces the contention when there are
+   *                         many threads and many small tasks, at the cost of honoring the task
+   *                         priorities only approximately. ThreadPoolType::ProcessShared runs
+   *                         the work on the worker threads shared by all the pipelines in the
+   *                         process, with at most num_threads tasks of this pipeline at a time.
+   */
+  DLL_PUBLIC void SetThreadPoolType(ThreadPoolType thread_pool_type) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed - cannot change thread pool type.");
+    thread_pool_type_ = thread_pool_type;
+  }
+
+  /**
+   * @brief Set if independent branches of the GPU stage should run on separate CUDA streams
+   *
+   * Must be called before Build(). The number of streams is limited by `max_num_stream`.
+   */
+  DLL_PUBLIC void SetGPUMultiStream(bool gpu_multi_stream) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed - cannot change GPU stream assignment.");
+    gpu_multi_stream_ = gpu_multi_stream;
+  }
+
+  /**
+   * @brief Set if the GPU stage should be captured in a CUDA graph and replayed
+   *
+   * Must be called before Build(). The graph is only used when all the GPU operators support it
+   * and is re-captured when the shapes of their inputs or outputs change.
+   */
+  DLL_PUBLIC void SetGPUGraphCapture(bool gpu_graph_capture) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed - cannot change CUDA graph capture.");
+    gpu_graph_capture_ = gpu_graph_capture;
+  }
+
+  /**
+   * @brief Set the CUDA stream priority of the iterations that the consumer waits for
+   *
+   * Must be called before Build(). The iterations of the mixed and GPU stages which are
+   * prefetched ahead keep using `default_cuda_stream_priority`, while the iteration issued
+   * when no outputs are ready runs in a stream with this priority.
+   */
+  DLL_PUBLIC void SetUrgentStreamPriority(int priority) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed - cannot change stream priorities.");
+    urgent_cuda_stream_priority_ = priority;
+  }
+
+  /**
+   * @brief Set if the intermediate outputs of the GPU stage should share memory
+   *
+   * Must be called before Build(). The outputs whose lifetimes don't overlap use the same
+   * arena, which reduces the peak GPU memory usage of deep pipelines.
+   */
+  DLL_PUBLIC void SetGPUMemoryPlanning(bool gpu_memory_planning) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed - cannot change GPU memory planning.");
+    gpu_memory_planning_ = gpu_memory_planning;
+  }
+
+  /**
+   * @brief Set the size of the sub-batches in which the micro-batchable GPU operators are run
+   *
+   * Must be called before Build(). The chains of consecutive GPU operators which support it
+   * process the batch in parts of at most `micro_batch_size` samples, which caps the memory
+   * used by their intermediate outputs and temporary buffers. 0 disables the micro-batching.
+   */
+  DLL_PUBLIC void SetGPUMicroBatchSize(int micro_batch_size) {
+    DALI_ENFORCE(!built_, "Alterations to the pipeline after "
+        "\"Build()\" has been called are not allowed - cannot change the micro-batch size.");
+    DALI_ENFORCE(micro_batch_size >= 0, make_string(
+        "The micro-batch size must not be negative, got: ", micro_batch_size));
+    gpu_micro_batch_size_ = micro_batch_size;
   }
 
   /**
@@ -297,6 +389,97 @@ class DLL_PUBLIC Pipeline {
     }
   }
 
+  /**
+   * @brief Set if the DALI pipeline should gather the execution time statistics of the operators
+   *        and the stages
+   *
+   * @param enable_timing_stats If statistics should be gathered
+   */
+  DLL_PUBLIC void EnableExecutorTimingStats(bool enable_timing_stats = true) {
+    enable_timing_stats_ = enable_timing_stats;
+    if (executor_) {
+      // the bottleneck analysis needs the timing statistics
+      executor_->EnableTimingStats(enable_timing_stats_ || bottleneck_analysis_interval_s_ > 0);
+    }
+  }
+
+  /**
+   * @brief Set if the executor should periodically find the part of the pipeline which limits
+   *        the throughput; enables the timing statistics
+   *
+   * @param interval_s The interval between the updates of the report, in seconds;
+   *                   non-positive value disables the analysis
+   */
+  DLL_PUBLIC void EnableBottleneckAnalysis(double interval_s = 1.0) {
+    bottleneck_analysis_interval_s_ = interval_s;
+    if (executor_) {
+      executor_->EnableBottleneckAnalysis(interval_s);
+      executor_->EnableTimingStats(enable_timing_stats_ || interval_s > 0);
+    }
+  }
+
+  /**
+   * @brief Obtains the latest report of the bottleneck analysis
+   */
+  DLL_PUBLIC BottleneckReport GetBottleneckReport() {
+    if (executor_) {
+      return executor_->GetBottleneckReport();
+    } else {
+      return {};
+    }
+  }
+
+  /**
+   * @brief Obtains the execution time statistics
+   */
+  DLL_PUBLIC ExecutorTimingStats GetExecutorTimingStats() {
+    if (executor_) {
+      return executor_->GetTimingStats();
+    } else {
+      return {};
+    }
+  }
+
+  /**
+   * @brief Obtains the usage of the host arenas of the operators
+   */
+  DLL_PUBLIC HostArenaStatsMap GetHostArenaStats() {
+    if (executor_) {
+      return executor_->GetHostArenaStats();
+    } else {
+      return {};
+    }
+  }
+
+  /**
+   * @brief Moves the CPU operators to the GPU when the pipeline is built, where, according to
+   *        the costs, it shortens the longer of the CPU and the GPU stage (see PlaceOperators).
+   *
+   * Ignored in the CPU-only pipelines.
+   *
+   * @param costs The costs of the operators, usually obtained with GetOperatorCosts from another
+   *              instance of this pipeline
+   */
+  DLL_PUBLIC void EnableAutoPlacement(OperatorCostMap costs, PlacementOptions options = {}) {
+    DALI_ENFORCE(!built_, "The placement of the operators must be enabled before the build.");
+    auto_placement_ = true;
+    placement_costs_ = std::move(costs);
+    placement_options_ = options;
+  }
+
+  /**
+   * @brief Returns the costs of the operators, based on the execution time statistics, in
+   *        a form accepted by EnableAutoPlacement
+   */
+  DLL_PUBLIC OperatorCostMap GetOperatorCosts();
+
+  /**
+   * @brief Returns the decisions made by the automatic placement of the operators
+   */
+  DLL_PUBLIC const PlacementReport &GetPlacementReport() const {
+    return placement_report_;
+  }
+
   /**
    * @brief Set queue sizes for Pipeline using Separated Queues
    *
@@ -315,6 +498,38 @@ class DLL_PUBLIC Pipeline {
     prefetch_queue_depth_ = QueueSizes(cpu_size, gpu_size);
   }
 
+  /**
+   * @brief Set the lower bounds for the queue sizes, making the queue depths adaptive
+   *
+   * Must be called before Build(). The queue sizes set with SetQueueSizes become the upper
+   * bounds and the executor adjusts the depths between them, based on the time the stages
+   * spend waiting for each other. Requires asynchronous pipelined execution.
+   *
+   * @param cpu_size
+   * @param gpu_size
+   */
+  DLL_PUBLIC void SetMinQueueSizes(int cpu_size, int gpu_size) {
+    DALI_ENFORCE(!built_,
+                 "Alterations to the pipeline after "
+                 "\"Build()\" has been called are not allowed - cannot set queue sizes.");
+    DALI_ENFORCE(separated_execution_ || (cpu_size == gpu_size),
+                 "Setting different queue sizes for non-separated execution is not allowed");
+    DALI_ENFORCE(cpu_size > 0 && gpu_size > 0, "Only positive queue sizes allowed");
+    min_prefetch_queue_depth_ = QueueSizes(cpu_size, gpu_size);
+    adaptive_queue_depth_ = true;
+  }
+
+  /**
+   * @brief Returns the queue sizes currently used by the executor
+   */
+  DLL_PUBLIC QueueSizes GetCurrentQueueSizes() const {
+    if (executor_) {
+      return executor_->GetCurrentQueueSizes();
+    } else {
+      return prefetch_queue_depth_;
+    }
+  }
+
   /** @{ */
   /**
    * @brief Set descriptors of the outputs of the pipeline. Used to update the graph without
@@ -361,21 +576,52 @@ class DLL_PUBLIC Pipeline {
    * This method blocks until the next batch is complete. RunCPU, RunMixed and RunGPU
    * must be called prior to calling this or this method will result in
    * deadlock.
+   * If `order` is a CUDA stream, the method doesn't wait for the GPU outputs - they are
+   * ready for the work scheduled in `order` after the call.
    */
-  DLL_PUBLIC void ShareOutputs(DeviceWorkspace *ws);
+  DLL_PUBLIC void ShareOutputs(DeviceWorkspace *ws, AccessOrder order = {});
 
   /**
    * @brief Release buffers returned by the Output call
    * This method is meant for cases where buffers are coppied out
    * or consumed in any other way, so it is possible to set them free
    * before next Outputs call
+   * If `consumer_order` is a CUDA stream, the buffers can be still in use by the work
+   * scheduled in it - they are not overwritten before that work completes.
    */
-  DLL_PUBLIC void ReleaseOutputs();
+  DLL_PUBLIC void ReleaseOutputs(AccessOrder consumer_order = {});
+
+  /**
+   * @brief Returns the number of iterations scheduled so far (with RunCPU).
+   *
+   * The iterations are identified by consecutive numbers, starting from 0, in the order
+   * in which they were scheduled.
+   */
+  DLL_PUBLIC int64_t NumScheduledIterations() const {
+    return iterations_scheduled_;
+  }
+
+  /**
+   * @brief Fills the workspace with the copies of the outputs of the given iteration.
+   *
+   * The iterations are computed in order, but their outputs can be requested in any order:
+   * the outputs of the earlier iterations that weren't requested yet are copied out, so that
+   * their buffers can be reused by the next iterations, and kept until requested.
+   * The outputs of an iteration can be obtained only once. This method shouldn't be mixed
+   * with Outputs and ShareOutputs.
+   */
+  DLL_PUBLIC void OutputsOf(int64_t iteration, DeviceWorkspace *ws);
 
   /**
    * @brief serializes the pipe to a protobuf
+   *
+   * @param memory_hints If true, the sizes observed so far are stored in the operators
+   *                     (as `bytes_per_sample_hint` of the outputs and the initial size of
+   *                     the host arena), so that the deserialized pipeline preallocates them
+   *                     when built and its first iterations don't grow the buffers.
+   *                     Requires the executor memory statistics to be enabled.
    */
-  DLL_PUBLIC string SerializeToProtobuf() const;
+  DLL_PUBLIC string SerializeToProtobuf(bool memory_hints = false) const;
 
   /**
    * @brief Save graph in DOT direct graph format
@@ -402,6 +648,32 @@ class DLL_PUBLIC Pipeline {
    */
   DLL_PUBLIC ReaderMeta GetReaderMeta(std::string name);
 
+  /**
+   * @brief Returns the state of the reader with given name (see `enable_checkpointing`), as of
+   * the outputs returned so far
+   */
+  DLL_PUBLIC std::string GetReaderState(const std::string &name);
+
+  /**
+   * @brief Restores the state of the reader with given name, saved with GetReaderState
+   *
+   * Must be called after the pipeline is built and before it's run.
+   */
+  DLL_PUBLIC void RestoreReaderState(const std::string &name, const std::string &state);
+
+  /**
+   * @brief Changes the sharding of the dataset read by the reader with given name, without
+   * rebuilding the pipeline (e.g. when the number of workers of an elastic training changes)
+   *
+   * With a negative `at_sample`, the reader switches to the new shard at the end of the part
+   * of the epoch it reads. Otherwise, the epoch is cut after `at_sample` samples of each
+   * part of it and the samples not read by any of the shards are split among the new ones.
+   * All the readers of the dataset need to be resharded with the same arguments, except
+   * for the `shard_id`.
+   */
+  DLL_PUBLIC void ReshardReader(const std::string &name, int num_shards, int shard_id,
+                                int64_t at_sample = -1);
+
   /**
    * @brief Get the data layout required by the external input with a given name.
    */
@@ -538,6 +810,12 @@ class DLL_PUBLIC Pipeline {
   // Helper to add pipeline meta-data
   void PrepareOpSpec(OpSpec *spec, int logical_id);
 
+  /**
+   * @brief Applies PlaceOperators to the operators and adds them again, so that the copies to
+   *        the GPU are inserted where needed
+   */
+  void PlaceOperatorsAutomatically();
+
   void PropagateMemoryHint(OpNode &node);
 
   inline void AddToOpSpecs(const std::string &inst_name, const OpSpec &spec, int logical_id);
@@ -598,14 +876,35 @@ class DLL_PUBLIC Pipeline {
   bool pipelined_execution_;
   bool separated_execution_;
   bool async_execution_;
+  bool dataflow_execution_ = false;
+  bool low_latency_execution_ = false;
   size_t bytes_per_sample_hint_;
   int set_affinity_;
   int max_num_stream_;
   int default_cuda_stream_priority_;
   int next_logical_id_ = 0;
+  // the number of iterations whose outputs were returned, for GetReaderState
+  int64_t outputs_returned_ = 0;
+  int64_t iterations_scheduled_ = 0;
+  // the copies of the outputs of the iterations skipped by OutputsOf
+  std::map<int64_t, DeviceWorkspace> stashed_outputs_;
   int next_internal_logical_id_ = -1;
   QueueSizes prefetch_queue_depth_;
+  bool adaptive_queue_depth_ = false;
+  QueueSizes min_prefetch_queue_depth_;
   bool enable_memory_stats_ = false;
+  bool enable_timing_stats_ = false;
+  double bottleneck_analysis_interval_s_ = 0;
+  ThreadPoolType thread_pool_type_ = ThreadPoolType::SharedQueue;
+  bool gpu_multi_stream_ = false;
+  bool gpu_graph_capture_ = false;
+  bool gpu_memory_planning_ = false;
+  int gpu_micro_batch_size_ = 0;
+  std::optional<int> urgent_cuda_stream_priority_;
+  bool auto_placement_ = false;
+  OperatorCostMap placement_costs_;
+  PlacementOptions placement_options_;
+  PlacementReport placement_report_;
 
   std::vector<int64_t> seed_;
   int original_seed_;
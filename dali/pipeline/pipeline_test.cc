@@ -489,6 +489,94 @@ TEST_F(PipelineTestOnce, TestPresize) {
   ASSERT_EQ(tmp[1], 2 * sizeof(size_t));
 }
 
+TEST_F(PipelineTestOnce, TestSerializeMemoryHints) {
+  const int batch_size = 1;
+  const int num_thread = 1;
+
+  Pipeline pipe(batch_size, num_thread, 0);
+  pipe.EnableExecutorMemoryStats();
+  pipe.AddExternalInput("data");
+  pipe.AddOperator(
+      OpSpec("DummyPresizeOp")
+      .AddArg("device", "gpu")
+      .AddInput("data", "gpu")
+      .AddOutput("out", "gpu"));
+  vector<std::pair<string, string>> outputs = {{"out", "gpu"}};
+
+  // the hints can be gathered only when the pipeline runs
+  EXPECT_THROW(pipe.SerializeToProtobuf(true), std::exception);
+
+  TensorList<CPUBackend> data;
+  test::MakeRandomBatch(data, batch_size);
+
+  // Returns the capacity of the output buffer in the first iteration of the pipeline
+  auto first_capacity = [&](Pipeline &p) {
+    p.SetExternalInput("data", data);
+    DeviceWorkspace ws;
+    p.RunCPU();
+    p.RunGPU();
+    p.Outputs(&ws);
+    size_t tmp[2];
+    CUDA_CALL(cudaDeviceSynchronize());
+    CUDA_CALL(cudaMemcpy(&tmp, ws.Output<GPUBackend>(0).tensor<size_t>(0),
+              sizeof(size_t) * 2, cudaMemcpyDefault));
+    return tmp[0];
+  };
+
+  pipe.Build(outputs);
+  EXPECT_EQ(first_capacity(pipe), 0);
+
+  auto serialized = pipe.SerializeToProtobuf(true);
+  Pipeline loaded_pipe(serialized, batch_size, num_thread, 0);
+  loaded_pipe.Build(outputs);
+  // the output was preallocated for the observed size of the sample
+  EXPECT_GE(first_capacity(loaded_pipe), 2 * sizeof(size_t));
+}
+
+TEST_F(PipelineTestOnce, TestOutputsOfIteration) {
+  const int batch_size = 2;
+  const int num_thread = 1;
+
+  Pipeline pipe(batch_size, num_thread, 0);
+  pipe.AddExternalInput("data");
+  pipe.AddOperator(
+      OpSpec("Copy")
+      .AddArg("device", "cpu")
+      .AddInput("data", "cpu")
+      .AddOutput("copied", "cpu"));
+  vector<std::pair<string, string>> outputs = {{"copied", "cpu"}};
+  pipe.Build(outputs);
+
+  const int iters = 3;
+  for (int iter = 0; iter < iters; iter++) {
+    TensorList<CPUBackend> data;
+    data.Resize(uniform_list_shape(batch_size, {1}), DALI_INT32);
+    for (int i = 0; i < batch_size; i++)
+      *data.mutable_tensor<int>(i) = iter * 10 + i;
+    pipe.SetExternalInput("data", data);
+    EXPECT_EQ(pipe.NumScheduledIterations(), iter);
+    pipe.RunCPU();
+    pipe.RunGPU();
+  }
+  EXPECT_EQ(pipe.NumScheduledIterations(), iters);
+
+  auto check = [&](int iter) {
+    DeviceWorkspace ws;
+    pipe.OutputsOf(iter, &ws);
+    ASSERT_EQ(ws.NumOutput(), 1);
+    auto &out = ws.Output<CPUBackend>(0);
+    ASSERT_EQ(out.num_samples(), batch_size);
+    for (int i = 0; i < batch_size; i++)
+      EXPECT_EQ(*out.tensor<int>(i), iter * 10 + i);
+  };
+  // the outputs of the earlier iterations are kept until requested
+  check(2);
+  check(0);
+  check(1);
+  EXPECT_THROW(check(1), std::exception);
+  EXPECT_THROW(check(iters), std::exception);
+}
+
 TYPED_TEST(PipelineTest, TestSeedSet) {
   int num_thread = TypeParam::nt;
   int batch_size = this->jpegs_.nImages();
@@ -0,0 +1,81 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/shared_pipeline.h"
+#include <map>
+#include <mutex>
+#include <utility>
+#include "dali/core/format.h"
+
+namespace dali {
+
+namespace {
+
+struct SharedPipelineEntry {
+  SharedPipeline::Params params;
+  std::weak_ptr<SharedPipeline> pipeline;
+};
+
+using SharedPipelineKey = std::pair<std::string, int>;
+
+// the pipelines held by the clients, by the serialized pipeline and the device
+std::mutex shared_pipelines_mutex;
+std::map<SharedPipelineKey, SharedPipelineEntry> shared_pipelines;
+
+}  // namespace
+
+SharedPipeline::SharedPipeline(const std::string &serialized_pipe, const Params &params)
+    : params_(params) {
+  pipeline_ = std::make_unique<Pipeline>(serialized_pipe, params.max_batch_size,
+                                         params.num_threads, params.device_id);
+  pipeline_->Build();
+  batcher_ = std::make_unique<DynamicBatcher>(pipeline_.get(), params.batcher_batch_size,
+                                              params.max_delay);
+}
+
+std::shared_ptr<SharedPipeline> SharedPipeline::Get(const std::string &serialized_pipe,
+                                                    const Params &params) {
+  SharedPipelineKey key(serialized_pipe, params.device_id);
+  std::lock_guard<std::mutex> lock(shared_pipelines_mutex);
+  auto &entry = shared_pipelines[key];
+  if (auto pipeline = entry.pipeline.lock()) {
+    DALI_ENFORCE(entry.params == params,
+                 make_string("The pipeline shared on the device ", params.device_id,
+                             " was created with different parameters."));
+    return pipeline;
+  }
+  // the pipelines are built while holding the lock, so a pipeline is never built twice
+  std::shared_ptr<SharedPipeline> pipeline;
+  try {
+    // the entry is removed with the pipeline, unless it's been replaced by a new one
+    pipeline = std::shared_ptr<SharedPipeline>(
+        new SharedPipeline(serialized_pipe, params), [key](SharedPipeline *p) {
+          {
+            std::lock_guard<std::mutex> lock(shared_pipelines_mutex);
+            auto it = shared_pipelines.find(key);
+            if (it != shared_pipelines.end() && it->second.pipeline.expired())
+              shared_pipelines.erase(it);
+          }
+          delete p;
+        });
+  } catch (...) {
+    shared_pipelines.erase(key);
+    throw;
+  }
+  entry.params = params;
+  entry.pipeline = pipeline;
+  return pipeline;
+}
+
+}  // namespace dali
@@ -0,0 +1,97 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_SHARED_PIPELINE_H_
+#define DALI_PIPELINE_SHARED_PIPELINE_H_
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+#include "dali/pipeline/dynamic_batcher.h"
+#include "dali/pipeline/pipeline.h"
+
+namespace dali {
+
+/**
+ * @brief A pipeline shared by the clients in the process which would otherwise create
+ *        identical ones, e.g. the instances of a model in an inference server.
+ *
+ * The clients asking for the same serialized pipeline on the same device get the same
+ * instance, so they share its thread pool, operators (e.g. the decoders with their nvJPEG
+ * handles) and memory, and their requests are run together by its DynamicBatcher.
+ * The pipelines on different devices are separate, each with its own executor.
+ * The pipeline is destroyed when the last client releases it.
+ */
+class DLL_PUBLIC SharedPipeline {
+ public:
+  struct Params {
+    int max_batch_size = -1;
+    int num_threads = -1;
+    int device_id = -1;
+    /// the largest number of samples of the requests run together (see DynamicBatcher)
+    int batcher_batch_size = 0;
+    /// how long the oldest request can wait for the others (see DynamicBatcher)
+    std::chrono::microseconds max_delay{0};
+
+    bool operator==(const Params &other) const {
+      return max_batch_size == other.max_batch_size && num_threads == other.num_threads &&
+             device_id == other.device_id && batcher_batch_size == other.batcher_batch_size &&
+             max_delay == other.max_delay;
+    }
+  };
+
+  /**
+   * @brief Returns the pipeline `serialized_pipe` on the device `params.device_id`, creating
+   *        and building it if no client holds it.
+   *
+   * The clients of a pipeline must ask for it with the same parameters.
+   */
+  static std::shared_ptr<SharedPipeline> Get(const std::string &serialized_pipe,
+                                             const Params &params);
+
+  SharedPipeline(const SharedPipeline &) = delete;
+  SharedPipeline &operator=(const SharedPipeline &) = delete;
+
+  /**
+   * @brief Queues a request of a client - see DynamicBatcher::Submit.
+   *
+   * The GPU outputs are copied in `order`, which should be the stream of the client, so that
+   * the clients don't wait for each other's work.
+   */
+  std::future<DeviceWorkspace> Submit(DynamicBatcher::Inputs inputs, AccessOrder order = {}) {
+    return batcher_->Submit(std::move(inputs), order);
+  }
+
+  const Pipeline &pipeline() const {
+    return *pipeline_;
+  }
+
+  const DynamicBatcher &batcher() const {
+    return *batcher_;
+  }
+
+ private:
+  SharedPipeline(const std::string &serialized_pipe, const Params &params);
+
+  Params params_;
+  std::unique_ptr<Pipeline> pipeline_;
+  // destroyed before the pipeline it runs
+  std::unique_ptr<DynamicBatcher> batcher_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_SHARED_PIPELINE_H_
@@ -0,0 +1,98 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/pipeline/shared_pipeline.h"
+
+namespace dali {
+
+namespace {
+
+std::string GetSerializedCopyPipeline() {
+  Pipeline pipe(8, 2, CPU_ONLY_DEVICE_ID);
+  pipe.AddExternalInput("data");
+  pipe.AddOperator(OpSpec("Copy")
+                       .AddArg("device", "cpu")
+                       .AddInput("data", "cpu")
+                       .AddOutput("out", "cpu"));
+  pipe.Build({{"out", "cpu"}});
+  return pipe.SerializeToProtobuf();
+}
+
+SharedPipeline::Params GetParams() {
+  SharedPipeline::Params params;
+  params.max_batch_size = 8;
+  params.num_threads = 2;
+  params.device_id = CPU_ONLY_DEVICE_ID;
+  params.batcher_batch_size = 6;
+  params.max_delay = std::chrono::seconds(10);
+  return params;
+}
+
+DynamicBatcher::Inputs GetRequest(int num_samples, int value) {
+  TensorList<CPUBackend> data;
+  data.Resize(uniform_list_shape(num_samples, {1}), DALI_INT32);
+  for (int i = 0; i < num_samples; i++)
+    data.mutable_tensor<int>(i)[0] = value * 100 + i;
+  DynamicBatcher::Inputs inputs;
+  inputs["data"] = std::move(data);
+  return inputs;
+}
+
+}  // namespace
+
+TEST(SharedPipelineTest, SharedByClients) {
+  auto serialized = GetSerializedCopyPipeline();
+  auto client1 = SharedPipeline::Get(serialized, GetParams());
+  auto client2 = SharedPipeline::Get(serialized, GetParams());
+  EXPECT_EQ(client1, client2);
+
+  // the requests of the clients are run together
+  std::vector<std::future<DeviceWorkspace>> results;
+  for (int r = 0; r < 3; r++)
+    results.push_back((r % 2 ? client2 : client1)->Submit(GetRequest(r + 1, r)));
+  for (int r = 0; r < 3; r++) {
+    auto ws = results[r].get();
+    const auto &out = ws.Output<CPUBackend>(0);
+    ASSERT_EQ(out.num_samples(), r + 1);
+    for (int i = 0; i <= r; i++)
+      EXPECT_EQ(out.tensor<int>(i)[0], r * 100 + i);
+  }
+  EXPECT_EQ(client1->batcher().num_batches(), 1);
+
+  auto params = GetParams();
+  params.batcher_batch_size = 4;
+  EXPECT_THROW(SharedPipeline::Get(serialized, params), std::exception);
+}
+
+TEST(SharedPipelineTest, ReleasedWithLastClient) {
+  auto serialized = GetSerializedCopyPipeline();
+  auto client = SharedPipeline::Get(serialized, GetParams());
+  std::weak_ptr<SharedPipeline> released = client;
+  client.reset();
+  EXPECT_TRUE(released.expired());
+  // a new pipeline is created, also with other parameters
+  auto params = GetParams();
+  params.batcher_batch_size = 4;
+  client = SharedPipeline::Get(serialized, params);
+  EXPECT_NE(client, nullptr);
+}
+
+}  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -106,4 +106,18 @@ void CopyWithStride<CPUBackend>(void *output, const void *input,
                        shape, ndim, 0, deepest_contiguous);
 }
 
+template <>
+void CopyWithStride<CPUBackend>(void *const *outputs, const void *const *inputs,
+                                const Index *const *in_strides,
+                                const Index *const *shapes,
+                                int nsamples,
+                                int ndim,
+                                size_t item_size,
+                                cudaStream_t stream) {
+  for (int i = 0; i < nsamples; i++) {
+    CopyWithStride<CPUBackend>(outputs[i], inputs[i], in_strides ? in_strides[i] : nullptr,
+                               shapes[i], ndim, item_size, stream);
+  }
+}
+
 }  // namespace dali
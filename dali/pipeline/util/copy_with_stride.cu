@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,11 +16,33 @@
 #include <cuda_runtime.h>
 #include <dali/core/util.h>
 #include <dali/core/dev_array.h>
+#include <tuple>
+#include <vector>
+#include "dali/core/cuda_utils.h"
+#include "dali/core/error_handling.h"
+#include "dali/kernels/common/scatter_gather.h"
+#include "dali/kernels/dynamic_scratchpad.h"
 
 namespace dali {
 
 constexpr int MAX_DIMS = 15;
 
+/**
+ * @brief Returns the offset (in bytes) in the strided input of the byte at `out_idx` in
+ *        the dense output
+ */
+__device__ inline Index InputOffset(Index out_idx, const Index *out_strides,
+                                    const Index *in_strides, int ndim) {
+  Index in_idx = 0;
+  Index elem_offset = out_idx;
+  for (int dim = 0; dim < ndim; ++dim) {
+    auto n = elem_offset / out_strides[dim];
+    in_idx += n * in_strides[dim];
+    elem_offset -= n * out_strides[dim];
+  }
+  return in_idx + elem_offset;
+}
+
 __global__ void CopyWithStrideKernel(uint8_t *output, const uint8_t *input, Index size,
                                      DeviceArray<Index, MAX_DIMS> out_strides,
                                      DeviceArray<Index, MAX_DIMS> in_strides,
@@ -28,16 +50,62 @@ __global__ void CopyWithStrideKernel(uint8_t *output, const uint8_t *input, Inde
   auto out_idx = blockIdx.x * blockDim.x + threadIdx.x;
   if (out_idx >= size)
     return;
-  Index in_idx = 0;
-  Index elem_offset = out_idx;
-  for (int dim = 0; dim < ndim; ++dim) {
-    auto n = elem_offset / out_strides[dim];
-    in_idx += n * in_strides[dim];
-    elem_offset -= n * out_strides[dim];
+  output[out_idx] = input[InputOffset(out_idx, out_strides.data(), in_strides.data(), ndim)];
+}
+
+namespace {
+
+constexpr int kBatchCopyBlockSize = 256;
+// The number of the output bytes written by a block of the batched copy
+constexpr Index kBatchCopyBytesPerBlock = 4 * kBatchCopyBlockSize;
+
+struct StridedCopySampleDesc {
+  uint8_t *output;
+  const uint8_t *input;
+  Index size;
+  int ndim;
+  Index out_strides[MAX_DIMS];
+  Index in_strides[MAX_DIMS];
+};
+
+struct StridedCopyBlockDesc {
+  int sample_idx;
+  Index start;
+};
+
+__global__ void CopyWithStrideBatchKernel(const StridedCopySampleDesc *samples,
+                                          const StridedCopyBlockDesc *blocks) {
+  auto block = blocks[blockIdx.x];
+  const auto &sample = samples[block.sample_idx];
+  Index end = cuda_min(block.start + kBatchCopyBytesPerBlock, sample.size);
+  for (Index out_idx = block.start + threadIdx.x; out_idx < end; out_idx += blockDim.x) {
+    sample.output[out_idx] =
+        sample.input[InputOffset(out_idx, sample.out_strides, sample.in_strides, sample.ndim)];
   }
-  output[out_idx] = input[in_idx + elem_offset];
 }
 
+/**
+ * @brief Merges the dimensions which are dense with respect to each other
+ *
+ * @return the number of the remaining dimensions
+ */
+int CollapseDims(Index *shape, Index *strides, int ndim) {
+  int out_ndim = 0;
+  for (int i = 0; i < ndim; i++) {
+    if (out_ndim > 0 && strides[out_ndim - 1] == strides[i] * shape[i]) {
+      shape[out_ndim - 1] *= shape[i];
+      strides[out_ndim - 1] = strides[i];
+    } else {
+      shape[out_ndim] = shape[i];
+      strides[out_ndim] = strides[i];
+      out_ndim++;
+    }
+  }
+  return out_ndim;
+}
+
+}  // namespace
+
 template <>
 void CopyWithStride<GPUBackend>(void *output, const void *input,
                                 const Index *in_strides,
@@ -66,4 +134,61 @@ void CopyWithStride<GPUBackend>(void *output, const void *input,
        size, out_strides, in_strides_arr, ndim);
 }
 
+template <>
+void CopyWithStride<GPUBackend>(void *const *outputs, const void *const *inputs,
+                                const Index *const *in_strides,
+                                const Index *const *shapes,
+                                int nsamples,
+                                int ndim,
+                                size_t item_size,
+                                cudaStream_t stream) {
+  DALI_ENFORCE(ndim <= MAX_DIMS, make_string("Strided copy supports up to ", MAX_DIMS,
+                                             " dimensions, got: ", ndim, "."));
+  // the dense samples are copied with the scatter-gather kernel, the strided ones with
+  // a single launch of the strided kernel
+  kernels::ScatterGatherGPU dense_copies;
+  std::vector<StridedCopySampleDesc> samples;
+  std::vector<StridedCopyBlockDesc> blocks;
+  for (int i = 0; i < nsamples; i++) {
+    Index size = volume(shapes[i], shapes[i] + ndim) * item_size;
+    if (size == 0)
+      continue;
+    StridedCopySampleDesc desc;
+    desc.output = static_cast<uint8_t *>(outputs[i]);
+    desc.input = static_cast<const uint8_t *>(inputs[i]);
+    desc.size = size;
+    Index shape[MAX_DIMS];
+    int sample_ndim = 0;
+    if (in_strides && in_strides[i]) {
+      std::copy(shapes[i], shapes[i] + ndim, shape);
+      std::copy(in_strides[i], in_strides[i] + ndim, desc.in_strides);
+      sample_ndim = CollapseDims(shape, desc.in_strides, ndim);
+    }
+    if (sample_ndim == 0 ||
+        (sample_ndim == 1 && desc.in_strides[0] == static_cast<Index>(item_size))) {
+      dense_copies.AddCopy(desc.output, desc.input, size);
+      continue;
+    }
+    desc.ndim = sample_ndim;
+    desc.out_strides[sample_ndim - 1] = item_size;
+    for (int d = sample_ndim - 2; d >= 0; --d)
+      desc.out_strides[d] = desc.out_strides[d + 1] * shape[d + 1];
+    int sample_idx = samples.size();
+    samples.push_back(desc);
+    for (Index start = 0; start < size; start += kBatchCopyBytesPerBlock)
+      blocks.push_back({sample_idx, start});
+  }
+
+  dense_copies.Run(stream);
+  if (blocks.empty())
+    return;
+  kernels::DynamicScratchpad scratchpad({}, stream);
+  StridedCopySampleDesc *samples_dev;
+  StridedCopyBlockDesc *blocks_dev;
+  std::tie(samples_dev, blocks_dev) = scratchpad.ToContiguousGPU(stream, samples, blocks);
+  CopyWithStrideBatchKernel<<<blocks.size(), kBatchCopyBlockSize, 0, stream>>>
+      (samples_dev, blocks_dev);
+  CUDA_CALL(cudaGetLastError());
+}
+
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+// Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -29,6 +29,27 @@ DLL_PUBLIC void CopyWithStride(void *output, const void *input,
                                size_t item_size,
                                cudaStream_t stream = 0);
 
+/**
+ * @brief Copies a batch of (possibly strided) samples to dense outputs
+ *
+ * The GPU variant copies the whole batch with a single kernel launch (plus a launch of
+ * the scatter-gather kernel for the samples which are dense), instead of one per sample.
+ *
+ * @param outputs    the output buffers, one per sample
+ * @param inputs     the input buffers, one per sample
+ * @param in_strides the strides of the inputs, in bytes; if null, all the inputs are dense;
+ *                   a null entry means that the respective input is dense
+ * @param shapes     the shapes of the samples, each with `ndim` extents
+ */
+template <typename Backend>
+DLL_PUBLIC void CopyWithStride(void *const *outputs, const void *const *inputs,
+                               const Index *const *in_strides,
+                               const Index *const *shapes,
+                               int nsamples,
+                               int ndim,
+                               size_t item_size,
+                               cudaStream_t stream = 0);
+
 }  // namespace dali
 
 #endif  // DALI_PIPELINE_UTIL_COPY_WITH_STRIDE_H_
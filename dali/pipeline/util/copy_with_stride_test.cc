@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 #include <memory>
+#include <vector>
 #include "dali/pipeline/util/copy_with_stride.h"
 #include "dali/core/dev_buffer.h"
 
@@ -109,4 +110,43 @@ TEST(CopyWithStrideTest, SimpleCopyGPU) {
                                              7, 8}));
 }
 
+TEST(CopyWithStrideTest, BatchGPU) {
+  // each sample is a 3x4 int matrix, either dense or taken from every other row
+  // of a 6x4 one; the non-dense samples have the columns in reverse order
+  const int nsamples = 1000;
+  const int ndim = 2;
+  std::vector<int> h_data(nsamples * 24);
+  for (size_t i = 0; i < h_data.size(); i++)
+    h_data[i] = i;
+  DeviceBuffer<int> data, out;
+  data.from_host(h_data);
+  out.resize(nsamples * 12);
+
+  Index shape[] = {3, 4};
+  Index strided[] = {8 * sizeof(int), -static_cast<Index>(sizeof(int))};
+  std::vector<void *> outputs(nsamples);
+  std::vector<const void *> inputs(nsamples);
+  std::vector<const Index *> shapes(nsamples, shape);
+  std::vector<const Index *> strides(nsamples);
+  for (int i = 0; i < nsamples; i++) {
+    outputs[i] = out.data() + i * 12;
+    bool dense = i % 3 == 0;
+    inputs[i] = data.data() + i * 24 + (dense ? 0 : 3);
+    strides[i] = dense ? nullptr : strided;
+  }
+  CopyWithStride<GPUBackend>(outputs.data(), inputs.data(), strides.data(), shapes.data(),
+                             nsamples, ndim, sizeof(int));
+
+  std::vector<int> h_out(nsamples * 12);
+  CUDA_CALL(cudaMemcpy(h_out.data(), out, h_out.size() * sizeof(int), cudaMemcpyDeviceToHost));
+  for (int i = 0; i < nsamples; i++) {
+    for (int y = 0; y < 3; y++) {
+      for (int x = 0; x < 4; x++) {
+        int expected = i % 3 == 0 ? i * 24 + y * 4 + x : i * 24 + y * 8 + 3 - x;
+        ASSERT_EQ(h_out[i * 12 + y * 4 + x], expected) << "sample " << i;
+      }
+    }
+  }
+}
+
 }  // namespace dali
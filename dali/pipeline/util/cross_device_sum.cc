@@ -0,0 +1,59 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "dali/pipeline/util/cross_device_sum.h"
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include "dali/core/format.h"
+
+namespace dali {
+
+namespace {
+
+struct CrossDeviceSumRegistry {
+  std::mutex mtx;
+  std::unordered_map<std::string, CrossDeviceSum> groups;
+
+  static CrossDeviceSumRegistry &instance() {
+    static CrossDeviceSumRegistry registry;
+    return registry;
+  }
+};
+
+}  // namespace
+
+void SetCrossDeviceSum(const std::string &group, CrossDeviceSum sum) {
+  auto &registry = CrossDeviceSumRegistry::instance();
+  std::lock_guard<std::mutex> guard(registry.mtx);
+  if (sum)
+    registry.groups[group] = std::move(sum);
+  else
+    registry.groups.erase(group);
+}
+
+CrossDeviceSum GetCrossDeviceSum(const std::string &group) {
+  auto &registry = CrossDeviceSumRegistry::instance();
+  std::lock_guard<std::mutex> guard(registry.mtx);
+  auto it = registry.groups.find(group);
+  if (it == registry.groups.end())
+    throw std::invalid_argument(make_string(
+        "No cross-device reduction is registered for the group \"", group, "\". The framework "
+        "must register it (e.g. with `nvidia.dali.backend.SetCrossDeviceSum`) before the "
+        "pipeline runs."));
+  return it->second;
+}
+
+}  // namespace dali
@@ -0,0 +1,53 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_CROSS_DEVICE_SUM_H_
+#define DALI_PIPELINE_UTIL_CROSS_DEVICE_SUM_H_
+
+#include <cuda_runtime_api.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include "dali/core/api_helper.h"
+
+namespace dali {
+
+/**
+ * @brief Sums a device buffer of doubles, in place, across the devices of a group.
+ *
+ * DALI doesn't manage the communication between the devices - the function is provided by
+ * the framework (plugin), typically as an `ncclAllReduce` on the communicator of
+ * the data-parallel group. It's called on the device and with the stream of the operator
+ * and it must only enqueue the work on that stream.
+ */
+using CrossDeviceSum = std::function<void(double *data, size_t count, cudaStream_t stream)>;
+
+/**
+ * @brief Registers the function summing the buffers across the devices of the named group.
+ *
+ * Replaces the function registered previously for the group. An empty function removes
+ * the registration.
+ */
+DLL_PUBLIC void SetCrossDeviceSum(const std::string &group, CrossDeviceSum sum);
+
+/**
+ * @brief Returns the function registered for the group
+ *
+ * @throws std::invalid_argument if there's no function registered for the group
+ */
+DLL_PUBLIC CrossDeviceSum GetCrossDeviceSum(const std::string &group);
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_CROSS_DEVICE_SUM_H_
@@ -0,0 +1,34 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include "dali/pipeline/util/cross_device_sum.h"
+
+namespace dali {
+
+TEST(CrossDeviceSum, Registry) {
+  EXPECT_THROW(GetCrossDeviceSum("test_group"), std::invalid_argument);
+  size_t calls = 0;
+  SetCrossDeviceSum("test_group", [&](double *, size_t count, cudaStream_t) {
+    calls += count;
+  });
+  GetCrossDeviceSum("test_group")(nullptr, 3, 0);
+  EXPECT_EQ(calls, 3);
+  EXPECT_THROW(GetCrossDeviceSum("other_group"), std::invalid_argument);
+  SetCrossDeviceSum("test_group", {});
+  EXPECT_THROW(GetCrossDeviceSum("test_group"), std::invalid_argument);
+}
+
+}  // namespace dali
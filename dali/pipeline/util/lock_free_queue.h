@@ -0,0 +1,185 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_PIPELINE_UTIL_LOCK_FREE_QUEUE_H_
+#define DALI_PIPELINE_UTIL_LOCK_FREE_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "dali/core/common.h"
+#include "dali/core/error_handling.h"
+
+namespace dali {
+
+/**
+ * @brief Blocks a thread until a condition, which is changed and checked without a lock,
+ *        becomes true.
+ *
+ * The waiting thread spins for a short while and only then parks on a condition variable.
+ * Notify is a single atomic load when there's no parked thread, so the side that changes
+ * the condition doesn't touch the mutex in the common case.
+ *
+ * The condition must be set (with a sequentially consistent or release store) before
+ * calling Notify.
+ */
+class Parker {
+ public:
+  template <typename Predicate>
+  void Wait(Predicate &&pred) {
+    for (int i = 0; i < kSpins; i++) {
+      if (pred())
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    parked_.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    cv_.wait(lock, pred);
+    parked_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  void Notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (parked_.load(std::memory_order_seq_cst) == 0)
+      return;
+    // Taking the lock guarantees that the waiter either sees the new state when checking
+    // the predicate or is already waiting on the condition variable
+    { std::lock_guard<std::mutex> lock(mutex_); }
+    cv_.notify_all();
+  }
+
+ private:
+  static constexpr int kSpins = 64;
+  std::atomic<int> parked_{0};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+/**
+ * @brief Bounded, lock-free, multi-producer multi-consumer queue
+ *
+ * Each cell carries a sequence number telling whether it's ready to be written or read
+ * in the current lap, so producers and consumers only contend on their respective counters.
+ * The capacity is rounded up to a power of 2.
+ *
+ * TryPush and TryPop never block - they fail when the queue is full or empty, respectively.
+ */
+template <typename T>
+class MPMCBoundedQueue {
+ public:
+  explicit MPMCBoundedQueue(size_t min_capacity = 1) {
+    Reset(min_capacity);
+  }
+
+  /**
+   * @brief Discards the contents and changes the capacity; not thread safe.
+   */
+  void Reset(size_t min_capacity) {
+    DALI_ENFORCE(min_capacity > 0, "The capacity of the queue must be positive");
+    size_t capacity = 1;
+    while (capacity < min_capacity)
+      capacity <<= 1;
+    mask_ = capacity - 1;
+    cells_ = std::make_unique<Cell[]>(capacity);
+    for (size_t i = 0; i < capacity; i++)
+      cells_[i].seq.store(i, std::memory_order_relaxed);
+    push_pos_.store(0, std::memory_order_relaxed);
+    pop_pos_.store(0, std::memory_order_relaxed);
+  }
+
+  size_t capacity() const {
+    return mask_ + 1;
+  }
+
+  bool TryPush(T &&value) {
+    size_t pos = push_pos_.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+      if (diff == 0) {
+        if (push_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        return false;  // full
+      } else {
+        pos = push_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::move(value);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool TryPop(T &value) {
+    size_t pos = pop_pos_.load(std::memory_order_relaxed);
+    Cell *cell;
+    for (;;) {
+      cell = &cells_[pos & mask_];
+      size_t seq = cell->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+      if (diff == 0) {
+        if (pop_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        return false;  // empty
+      } else {
+        pos = pop_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    value = std::move(cell->value);
+    cell->value = T();
+    cell->seq.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Removes (and destroys) all the elements
+   */
+  void clear() {
+    T value;
+    while (TryPop(value))
+      value = T();
+  }
+
+  /**
+   * @brief Approximate number of elements, exact when there are no concurrent operations
+   */
+  size_t size() const {
+    size_t push = push_pos_.load(std::memory_order_acquire);
+    size_t pop = pop_pos_.load(std::memory_order_acquire);
+    return push > pop ? push - pop : 0;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> seq{0};
+    T value{};
+  };
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t mask_ = 0;
+  // keep the counters in separate cache lines, they are modified by different threads
+  alignas(64) std::atomic<size_t> push_pos_{0};
+  alignas(64) std::atomic<size_t> pop_pos_{0};
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_LOCK_FREE_QUEUE_H_
@@ -0,0 +1,117 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "dali/pipeline/util/lock_free_queue.h"
+
+namespace dali {
+
+namespace test {
+
+TEST(MPMCBoundedQueue, Basic) {
+  MPMCBoundedQueue<std::unique_ptr<int>> q(5);
+  ASSERT_EQ(q.capacity(), 8u);
+  std::unique_ptr<int> out;
+  EXPECT_FALSE(q.TryPop(out));
+
+  for (int lap = 0; lap < 3; lap++) {
+    for (int i = 0; i < 8; i++)
+      ASSERT_TRUE(q.TryPush(std::make_unique<int>(i)));
+    auto extra = std::make_unique<int>(42);
+    EXPECT_FALSE(q.TryPush(std::move(extra)));
+    // a failed push doesn't take the ownership
+    ASSERT_NE(extra, nullptr);
+    EXPECT_EQ(q.size(), 8u);
+
+    for (int i = 0; i < 8; i++) {
+      ASSERT_TRUE(q.TryPop(out));
+      EXPECT_EQ(*out, i);
+    }
+    EXPECT_FALSE(q.TryPop(out));
+    EXPECT_EQ(q.size(), 0u);
+  }
+
+  ASSERT_TRUE(q.TryPush(std::make_unique<int>(1)));
+  q.clear();
+  EXPECT_FALSE(q.TryPop(out));
+}
+
+TEST(MPMCBoundedQueue, MultipleThreads) {
+  const int kThreads = 4, kPerThread = 10000;
+  MPMCBoundedQueue<int> q(64);
+  std::vector<std::atomic<int>> seen(kThreads * kPerThread);
+  for (auto &s : seen)
+    s = 0;
+  std::atomic<int> popped{0};
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kPerThread; i++) {
+        int value = t * kPerThread + i;
+        while (!q.TryPush(std::move(value)))
+          std::this_thread::yield();
+      }
+    });
+    threads.emplace_back([&]() {
+      int value;
+      while (popped < kThreads * kPerThread) {
+        if (q.TryPop(value)) {
+          seen[value]++;
+          popped++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+
+  for (auto &s : seen)
+    EXPECT_EQ(s, 1);
+}
+
+TEST(Parker, ProducerConsumer) {
+  const int kDepth = 2, kItems = 10000;
+  std::atomic<int> produced{0}, consumed{0};
+  Parker producer, consumer;
+  std::vector<int> ring(kDepth, -1);
+
+  std::thread producer_thread([&]() {
+    for (int i = 0; i < kItems; i++) {
+      producer.Wait([&]() { return produced - consumed < kDepth; });
+      ring[i % kDepth] = i;
+      produced++;
+      consumer.Notify();
+    }
+  });
+
+  for (int i = 0; i < kItems; i++) {
+    consumer.Wait([&]() { return produced > consumed; });
+    EXPECT_EQ(ring[i % kDepth], i);
+    consumed++;
+    producer.Notify();
+  }
+  producer_thread.join();
+}
+
+}  // namespace test
+
+}  // namespace dali
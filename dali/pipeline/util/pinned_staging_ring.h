@@ -0,0 +1,99 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_PIPELINE_UTIL_PINNED_STAGING_RING_H_
+#define DALI_PIPELINE_UTIL_PINNED_STAGING_RING_H_
+
+#include <cuda_runtime_api.h>
+#include <vector>
+#include "dali/core/common.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/cuda_event.h"
+#include "dali/core/mm/memory.h"
+
+namespace dali {
+
+/**
+ * @brief A ring of pinned host buffers for staging the host-to-device copies.
+ *
+ * The data is gathered into the buffer returned by Acquire and copied to the device
+ * asynchronously; Release records the completion of that copy. A buffer is reused only
+ * after its copy is complete, so the host waits only when the copies lag behind
+ * by the whole ring.
+ */
+class PinnedStagingRing {
+ public:
+  static constexpr int kDefaultNumBuffers = 3;
+
+  explicit PinnedStagingRing(int num_buffers = kDefaultNumBuffers) : buffers_(num_buffers) {}
+
+  ~PinnedStagingRing() {
+    for (auto &b : buffers_) {
+      if (b.pending)
+        CUDA_DTOR_CALL(cudaEventSynchronize(b.copied));
+    }
+  }
+
+  int num_buffers() const noexcept {
+    return buffers_.size();
+  }
+
+  /**
+   * @brief Returns the next buffer in the ring, with at least `bytes` of capacity.
+   *
+   * Waits for the copy previously issued from this buffer to complete.
+   */
+  char *Acquire(size_t bytes) {
+    auto &b = buffers_[current_];
+    if (b.pending) {
+      CUDA_CALL(cudaEventSynchronize(b.copied));
+      b.pending = false;
+    }
+    if (b.capacity < bytes) {
+      b.data.reset();
+      b.data = mm::alloc_raw_unique<char, mm::memory_kind::pinned>(bytes);
+      b.capacity = bytes;
+    }
+    return b.data.get();
+  }
+
+  /**
+   * @brief Records the completion of the copy from the acquired buffer, scheduled on `stream`,
+   *        and advances the ring.
+   */
+  void Release(cudaStream_t stream) {
+    auto &b = buffers_[current_];
+    if (!b.copied)
+      b.copied = CUDAEvent::CreateWithFlags(cudaEventDisableTiming);
+    CUDA_CALL(cudaEventRecord(b.copied, stream));
+    b.pending = true;
+    current_ = (current_ + 1) % buffers_.size();
+  }
+
+ private:
+  struct Buffer {
+    mm::uptr<char> data;
+    size_t capacity = 0;
+    CUDAEvent copied;
+    bool pending = false;
+  };
+
+  std::vector<Buffer> buffers_;
+  int current_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_PIPELINE_UTIL_PINNED_STAGING_RING_H_
@@ -0,0 +1,55 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+#include "dali/core/cuda_stream.h"
+#include "dali/core/dev_buffer.h"
+#include "dali/pipeline/util/pinned_staging_ring.h"
+
+namespace dali {
+
+namespace test {
+
+TEST(PinnedStagingRing, ReusesBuffersAfterCopy) {
+  PinnedStagingRing ring(2);
+  auto stream = CUDAStream::Create(true);
+  DeviceBuffer<int> dev;
+  std::vector<int> host;
+  std::vector<char *> buffers;
+  for (int iter = 0; iter < 6; iter++) {
+    size_t n = 1000 * (iter + 1);
+    dev.resize(n, stream);
+    int *staging = reinterpret_cast<int *>(ring.Acquire(n * sizeof(int)));
+    buffers.push_back(reinterpret_cast<char *>(staging));
+    std::iota(staging, staging + n, iter);
+    CUDA_CALL(cudaMemcpyAsync(dev.data(), staging, n * sizeof(int), cudaMemcpyHostToDevice,
+                              stream));
+    ring.Release(stream);
+    host.resize(n);
+    CUDA_CALL(cudaMemcpyAsync(host.data(), dev.data(), n * sizeof(int), cudaMemcpyDeviceToHost,
+                              stream));
+    CUDA_CALL(cudaStreamSynchronize(stream));
+    for (size_t i = 0; i < n; i++)
+      ASSERT_EQ(host[i], static_cast<int>(iter + i)) << "at " << i << " in iteration " << iter;
+  }
+  // the buffers are used in turns
+  EXPECT_NE(buffers[0], buffers[1]);
+}
+
+}  // namespace test
+
+}  // namespace dali
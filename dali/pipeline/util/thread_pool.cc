@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <utility>
 #include "dali/pipeline/util/thread_pool.h"
@@ -22,29 +25,143 @@
 #include "dali/core/cuda_utils.h"
 #include "dali/core/device_guard.h"
 #include "dali/core/nvtx.h"
+#include "dali/core/trace.h"
+#include "dali/core/os/numa.h"
 
 namespace dali {
 
-ThreadPool::ThreadPool(int num_thread, int device_id, bool set_affinity, const char* name)
-    : threads_(num_thread), running_(true), work_complete_(true), started_(false)
+std::shared_ptr<SharedThreadPoolWorkers> SharedThreadPoolWorkers::Get() {
+  static std::mutex instance_mutex;
+  static std::weak_ptr<SharedThreadPoolWorkers> instance;
+  std::lock_guard<std::mutex> lock(instance_mutex);
+  auto workers = instance.lock();
+  if (!workers) {
+    int num_threads = 0;
+    if (const char *env = std::getenv("DALI_SHARED_THREAD_POOL_SIZE"))
+      num_threads = std::atoi(env);
+    if (num_threads <= 0)
+      num_threads = std::max<int>(std::thread::hardware_concurrency(), 1);
+    workers = std::make_shared<SharedThreadPoolWorkers>(num_threads);
+    instance = workers;
+  }
+  return workers;
+}
+
+SharedThreadPoolWorkers::SharedThreadPoolWorkers(int num_threads) : threads_(num_threads) {
+  DALI_ENFORCE(num_threads > 0, "Thread pool must have non-zero size");
+  for (int i = 0; i < num_threads; ++i)
+    threads_[i] = std::thread(&SharedThreadPoolWorkers::WorkerLoop, this, i);
+}
+
+SharedThreadPoolWorkers::~SharedThreadPoolWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    assert(pools_.empty() && "The shared workers must outlive the pools using them");
+    running_ = false;
+  }
+  condition_.notify_all();
+  for (auto &thread : threads_)
+    thread.join();
+}
+
+std::vector<std::thread::id> SharedThreadPoolWorkers::GetThreadIds() const {
+  std::vector<std::thread::id> tids;
+  tids.reserve(threads_.size());
+  for (const auto &thread : threads_)
+    tids.emplace_back(thread.get_id());
+  return tids;
+}
+
+void SharedThreadPoolWorkers::Register(ThreadPool *pool) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  pools_.push_back(pool);
+}
+
+void SharedThreadPoolWorkers::Unregister(ThreadPool *pool) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  pools_.erase(std::remove(pools_.begin(), pools_.end(), pool), pools_.end());
+  if (next_pool_ >= pools_.size())
+    next_pool_ = 0;
+}
+
+bool SharedThreadPoolWorkers::TryPop(ThreadPool *&pool, int &slot, ThreadPool::Work &work) {
+  size_t npools = pools_.size();
+  for (size_t i = 0; i < npools; i++) {
+    size_t idx = (next_pool_ + i) % npools;
+    ThreadPool *p = pools_[idx];
+    if (!p->started_ || p->work_queue_.empty() || p->free_slots_.empty())
+      continue;
+    // the next worker starts with the next pool, so that each pool gets its share of the workers
+    next_pool_ = (idx + 1) % npools;
+    pool = p;
+    slot = p->free_slots_.back();
+    p->free_slots_.pop_back();
+    work = std::move(p->work_queue_.top().second);
+    p->work_queue_.pop();
+    return true;
+  }
+  return false;
+}
+
+void SharedThreadPoolWorkers::WorkerLoop(int thread_id) {
+  SetThreadName(make_string("[DALI][TP", thread_id, "]Shared").c_str());
+  int current_device = CPU_ONLY_DEVICE_ID;
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    ThreadPool *pool = nullptr;
+    int slot = -1;
+    ThreadPool::Work work;
+    condition_.wait(lock, [&] { return !running_ || TryPop(pool, slot, work); });
+    if (!running_)
+      break;
+    lock.unlock();
+    pool->RunSharedWork(slot, work, current_device);
+    lock.lock();
+    pool->free_slots_.push_back(slot);
+    lock.unlock();
+    // the pool may be destroyed as soon as the last task is done
+    pool->SharedWorkDone();
+    // no need to wake up other workers - this one looks for work right away
+    lock.lock();
+  }
+}
+
+ThreadPool::ThreadPool(int num_thread, int device_id, bool set_affinity, const char* name,
+                       ThreadPoolType type)
+    : threads_(type == ThreadPoolType::ProcessShared ? 0 : num_thread), num_threads_(num_thread)
+    , device_id_(device_id), type_(type), running_(true), work_complete_(true), started_(false)
     , active_threads_(0) {
   DALI_ENFORCE(num_thread > 0, "Thread pool must have non-zero size");
+  if (type_ == ThreadPoolType::WorkStealing)
+    local_queues_.reset(new LocalQueue[num_thread]);
+  // The error queues must exist before the threads are started
+  tl_errors_.resize(num_thread);
 #if NVML_ENABLED
   // only for the CPU pipeline
   if (device_id != CPU_ONLY_DEVICE_ID) {
     nvml::Init();
   }
 #endif
+  if (type_ == ThreadPoolType::ProcessShared) {
+    free_slots_.resize(num_thread);
+    // the lowest indices are used first
+    for (int i = 0; i < num_thread; ++i)
+      free_slots_[i] = num_thread - 1 - i;
+    shared_workers_ = SharedThreadPoolWorkers::Get();
+    shared_workers_->Register(this);
+    return;
+  }
   // Start the threads in the main loop
   for (int i = 0; i < num_thread; ++i) {
     threads_[i] = std::thread(std::bind(&ThreadPool::ThreadMain, this, i, device_id, set_affinity,
                                         make_string("[DALI][TP", i, "]", name)));
   }
-  tl_errors_.resize(num_thread);
 }
 
 ThreadPool::~ThreadPool() {
   WaitForWork(false);
+  if (shared_workers_)
+    shared_workers_->Unregister(this);
 
   std::unique_lock<std::mutex> lock(mutex_);
   running_ = false;
@@ -60,6 +177,14 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::AddWork(Work work, int64_t priority, bool start_immediately) {
+  if (type_ == ThreadPoolType::WorkStealing) {
+    AddWorkStealing(std::move(work), priority, start_immediately);
+    return;
+  }
+  if (type_ == ThreadPoolType::ProcessShared) {
+    AddWorkShared(std::move(work), priority, start_immediately);
+    return;
+  }
   bool started_before = false;
   {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -76,14 +201,86 @@ void ThreadPool::AddWork(Work work, int64_t priority, bool start_immediately) {
   }
 }
 
+void ThreadPool::AddWorkStealing(Work work, int64_t priority, bool start_immediately) {
+  // Count the task before it becomes visible, so that WaitForWork can't observe
+  // an empty pool while the task is still being executed.
+  outstanding_.fetch_add(1);
+  auto &local = local_queues_[next_queue_.fetch_add(1) % threads_.size()];
+  {
+    std::lock_guard<std::mutex> lock(local.mutex);
+    local.queue.push({priority, std::move(work)});
+  }
+  bool started_before = ws_started_.load();
+  if (start_immediately && !started_before)
+    ws_started_ = true;
+  // queued_ must be incremented before sleeping_ is read - a worker going to sleep
+  // increments sleeping_ before checking queued_, so at least one side sees the other
+  queued_.fetch_add(1);
+  if ((started_before || start_immediately) && sleeping_.load() > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!started_before)
+      condition_.notify_all();
+    else
+      condition_.notify_one();
+  }
+}
+
+void ThreadPool::AddWorkShared(Work work, int64_t priority, bool start_immediately) {
+  outstanding_.fetch_add(1);
+  bool started;
+  {
+    std::lock_guard<std::mutex> lock(shared_workers_->mutex_);
+    work_queue_.push({priority, std::move(work)});
+    started_ |= start_immediately;
+    started = started_;
+  }
+  if (started)
+    shared_workers_->condition_.notify_one();
+}
+
+void ThreadPool::RunSharedWork(int slot, Work &work, int &current_device) {
+  // the workers run the tasks of the pools of different devices
+  if (device_id_ >= 0 && device_id_ != current_device) {
+    try {
+      CUDA_CALL(cudaSetDevice(device_id_));
+      current_device = device_id_;
+    } catch (std::exception &e) {
+      work = {};
+      std::lock_guard<std::mutex> lock(mutex_);
+      tl_errors_[slot].push(e.what());
+    }
+  }
+  if (work)
+    RunWork(slot, work);
+  // the task (and the state it holds) is destroyed before the pool can be considered idle
+  work = {};
+}
+
+void ThreadPool::SharedWorkDone() {
+  // notified under the lock, so that the pool is not destroyed before the notification
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (outstanding_.fetch_sub(1) == 1)
+    completed_.notify_all();
+}
+
 // Blocks until all work issued to the thread pool is complete
 void ThreadPool::WaitForWork(bool checkForErrors) {
   std::unique_lock<std::mutex> lock(mutex_);
-  completed_.wait(lock, [this] { return this->work_complete_; });
-  started_ = false;
+  if (type_ == ThreadPoolType::WorkStealing) {
+    completed_.wait(lock, [this] { return outstanding_.load() == 0; });
+    ws_started_ = false;
+    started_ = false;
+  } else if (type_ == ThreadPoolType::ProcessShared) {
+    completed_.wait(lock, [this] { return outstanding_.load() == 0; });
+    std::lock_guard<std::mutex> shared_lock(shared_workers_->mutex_);
+    started_ = false;
+  } else {
+    completed_.wait(lock, [this] { return this->work_complete_; });
+    started_ = false;
+  }
   if (checkForErrors) {
     // Check for errors
-    for (size_t i = 0; i < threads_.size(); ++i) {
+    for (size_t i = 0; i < tl_errors_.size(); ++i) {
       if (!tl_errors_[i].empty()) {
         // Throw the first error that occurred
         string error = make_string("Error in thread ", i, ": ", tl_errors_[i].front());
@@ -95,21 +292,32 @@ void ThreadPool::WaitForWork(bool checkForErrors) {
 }
 
 void ThreadPool::RunAll(bool wait) {
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    started_ = true;
+  if (type_ == ThreadPoolType::ProcessShared) {
+    {
+      std::lock_guard<std::mutex> lock(shared_workers_->mutex_);
+      started_ = true;
+    }
+    shared_workers_->condition_.notify_all();
+  } else {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      started_ = true;
+      ws_started_ = true;
+    }
+    condition_.notify_all();  // other threads will be waken up if needed
   }
-  condition_.notify_all();  // other threads will be waken up if needed
   if (wait) {
     WaitForWork();
   }
 }
 
 int ThreadPool::NumThreads() const {
-  return threads_.size();
+  return num_threads_;
 }
 
 std::vector<std::thread::id> ThreadPool::GetThreadIds() const {
+  if (shared_workers_)
+    return shared_workers_->GetThreadIds();
   std::vector<std::thread::id> tids;
   tids.reserve(threads_.size());
   for (const auto &thread : threads_)
@@ -140,12 +348,45 @@ void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity,
       nvml::SetCPUAffinity(core);
     }
 #endif
+    // the threads run on the CPUs closest to the device - so should their memory
+    if (set_affinity && device_id != CPU_ONLY_DEVICE_ID && !std::getenv("DALI_AFFINITY_MASK"))
+      numa::SetPreferredNode(numa::DeviceNode(device_id));
+  } catch (std::exception &e) {
+    tl_errors_[thread_id].push(e.what());
+  } catch (...) {
+    tl_errors_[thread_id].push("Caught unknown exception");
+  }
+
+  if (type_ == ThreadPoolType::WorkStealing)
+    WorkStealingLoop(thread_id);
+  else
+    SharedQueueLoop(thread_id);
+}
+
+void ThreadPool::RunWork(int thread_id, Work &work) {
+  // If an error occurs, we save it in tl_errors_. When
+  // WaitForWork is called, we will check for any errors
+  // in the threads and return an error if one occured.
+  bool measure = measure_busy_time_.load(std::memory_order_relaxed);
+  auto start = measure ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+  TraceScope tr(TraceEvent::ThreadPoolTask);
+  try {
+    work(thread_id);
   } catch (std::exception &e) {
+    std::lock_guard<std::mutex> lock(mutex_);
     tl_errors_[thread_id].push(e.what());
   } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
     tl_errors_[thread_id].push("Caught unknown exception");
   }
+  if (measure) {
+    auto busy = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    busy_time_ns_.fetch_add(busy, std::memory_order_relaxed);
+  }
+}
 
+void ThreadPool::SharedQueueLoop(int thread_id) {
   while (running_) {
     // Block on the condition to wait for work
     std::unique_lock<std::mutex> lock(mutex_);
@@ -162,20 +403,7 @@ void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity,
     // Unlock the lock
     lock.unlock();
 
-    // If an error occurs, we save it in tl_errors_. When
-    // WaitForWork is called, we will check for any errors
-    // in the threads and return an error if one occured.
-    try {
-      work(thread_id);
-    } catch (std::exception &e) {
-      lock.lock();
-      tl_errors_[thread_id].push(e.what());
-      lock.unlock();
-    } catch (...) {
-      lock.lock();
-      tl_errors_[thread_id].push("Caught unknown exception");
-      lock.unlock();
-    }
+    RunWork(thread_id, work);
 
     // Mark this thread as idle & check for complete work
     lock.lock();
@@ -188,4 +416,44 @@ void ThreadPool::ThreadMain(int thread_id, int device_id, bool set_affinity,
   }
 }
 
+bool ThreadPool::TryPop(int thread_id, Work &work) {
+  int nthreads = threads_.size();
+  // Start with own queue, then visit the others - each thief starts at a different victim
+  for (int i = 0; i < nthreads; i++) {
+    auto &local = local_queues_[(thread_id + i) % nthreads];
+    std::lock_guard<std::mutex> lock(local.mutex);
+    if (local.queue.empty())
+      continue;
+    work = std::move(local.queue.top().second);
+    local.queue.pop();
+    queued_.fetch_sub(1);
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::WorkStealingLoop(int thread_id) {
+  for (;;) {
+    Work work;
+    if (ws_started_.load() && TryPop(thread_id, work)) {
+      RunWork(thread_id, work);
+      // The last task notifies the waiting thread; the notification is issued
+      // under the lock so that it's not lost between the predicate check and the wait.
+      if (outstanding_.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        completed_.notify_all();
+      }
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    sleeping_.fetch_add(1);
+    condition_.wait(lock, [this] {
+      return !running_ || (ws_started_.load() && queued_.load() > 0);
+    });
+    sleeping_.fetch_sub(1);
+    if (!running_) break;
+  }
+}
+
 }  // namespace dali
@@ -15,6 +15,7 @@
 #ifndef DALI_PIPELINE_UTIL_THREAD_POOL_H_
 #define DALI_PIPELINE_UTIL_THREAD_POOL_H_
 
+#include <atomic>
 #include <cstdlib>
 #include <utility>
 #include <condition_variable>
@@ -23,21 +24,111 @@
 #include <queue>
 #include <thread>
 #include <vector>
+#include <memory>
 #include <string>
 #include "dali/core/common.h"
 
 
 namespace dali {
 
+/**
+ * @brief Scheduling strategy used by the ThreadPool
+ */
+enum class ThreadPoolType : int {
+  /**
+   * @brief All the workers pick the tasks from a single priority queue.
+   *
+   * Priorities are honored strictly, but every AddWork and every task pick-up contends
+   * for the same lock.
+   */
+  SharedQueue = 0,
+  /**
+   * @brief Each worker owns a priority queue; idle workers steal from the others.
+   *
+   * The tasks are distributed among the queues in a round-robin fashion. Priorities are honored
+   * within each queue only, so the global order of execution is approximate.
+   */
+  WorkStealing = 1,
+  /**
+   * @brief The pool doesn't own threads - its tasks are run by a set of workers shared by all
+   *        the pools of this type in the process (see SharedThreadPoolWorkers).
+   *
+   * Limits the number of threads when several pipelines run in one process. The pool runs at
+   * most `num_thread` tasks at a time and the tasks receive thread indices in [0, num_thread).
+   * Thread affinity is not set.
+   */
+  ProcessShared = 2,
+};
+
+class ThreadPool;
+
+/**
+ * @brief Worker threads running the tasks of the ThreadPoolType::ProcessShared pools
+ *
+ * The workers visit the pools in a round-robin fashion and take one task at a time, so each
+ * pool with pending work gets its fair share of the workers. Within a pool, the tasks are
+ * picked by priority.
+ */
+class DLL_PUBLIC SharedThreadPoolWorkers {
+ public:
+  /**
+   * @brief Returns the workers shared in the process, starting them if needed
+   *
+   * The number of workers is the number of CPUs, unless set with the
+   * DALI_SHARED_THREAD_POOL_SIZE environment variable. The workers are stopped when the last
+   * pool using them is destroyed.
+   */
+  DLL_PUBLIC static std::shared_ptr<SharedThreadPoolWorkers> Get();
+
+  DLL_PUBLIC explicit SharedThreadPoolWorkers(int num_threads);
+
+  DLL_PUBLIC ~SharedThreadPoolWorkers();
+
+  DLL_PUBLIC int NumThreads() const {
+    return threads_.size();
+  }
+
+  DLL_PUBLIC std::vector<std::thread::id> GetThreadIds() const;
+
+  DISABLE_COPY_MOVE_ASSIGN(SharedThreadPoolWorkers);
+
+ private:
+  friend class ThreadPool;
+
+  void Register(ThreadPool *pool);
+  void Unregister(ThreadPool *pool);
+
+  void WorkerLoop(int thread_id);
+
+  /**
+   * @brief Takes a task from the next pool which has one and can run more tasks;
+   *        called with mutex_ held
+   *
+   * @return true, if a task was obtained
+   */
+  bool TryPop(ThreadPool *&pool, int &slot, std::function<void(int)> &work);
+
+  vector<std::thread> threads_;
+  vector<ThreadPool *> pools_;
+  // the pool visited first by the next worker looking for work
+  size_t next_pool_ = 0;
+  bool running_ = true;
+  // guards the list of the pools and their queues
+  std::mutex mutex_;
+  std::condition_variable condition_;
+};
+
 class DLL_PUBLIC ThreadPool {
  public:
   // Basic unit of work that our threads do
   typedef std::function<void(int)> Work;
 
-  DLL_PUBLIC ThreadPool(int num_thread, int device_id, bool set_affinity, const char* name);
+  DLL_PUBLIC ThreadPool(int num_thread, int device_id, bool set_affinity, const char* name,
+                        ThreadPoolType type = ThreadPoolType::SharedQueue);
 
-  DLL_PUBLIC ThreadPool(int num_thread, int device_id, bool set_affinity, const std::string& name)
-      : ThreadPool(num_thread, device_id, set_affinity, name.c_str()) {}
+  DLL_PUBLIC ThreadPool(int num_thread, int device_id, bool set_affinity, const std::string& name,
+                        ThreadPoolType type = ThreadPoolType::SharedQueue)
+      : ThreadPool(num_thread, device_id, set_affinity, name.c_str(), type) {}
 
   DLL_PUBLIC ~ThreadPool();
 
@@ -67,13 +158,72 @@ class DLL_PUBLIC ThreadPool {
 
   DLL_PUBLIC std::vector<std::thread::id> GetThreadIds() const;
 
+  DLL_PUBLIC ThreadPoolType Type() const {
+    return type_;
+  }
+
+  /**
+   * @brief Number of the workers running the tasks of a ThreadPoolType::ProcessShared pool
+   *        (shared with the other such pools); 0 for the other types
+   */
+  DLL_PUBLIC int NumSharedWorkers() const {
+    return shared_workers_ ? shared_workers_->NumThreads() : 0;
+  }
+
+  /**
+   * @brief Enables measuring the total time spent by the threads executing the work.
+   */
+  DLL_PUBLIC void EnableBusyTimeMeasurement(bool enable = true) {
+    measure_busy_time_ = enable;
+  }
+
+  /**
+   * @brief Total time (in nanoseconds) spent by all the threads executing the work,
+   *        since the measurement was enabled.
+   */
+  DLL_PUBLIC int64_t BusyTimeNs() const {
+    return busy_time_ns_.load(std::memory_order_relaxed);
+  }
+
   DISABLE_COPY_MOVE_ASSIGN(ThreadPool);
 
  private:
   DLL_PUBLIC void ThreadMain(int thread_id, int device_id, bool set_affinity,
                              const std::string &name);
 
+  void SharedQueueLoop(int thread_id);
+  void WorkStealingLoop(int thread_id);
+
+  void AddWorkStealing(Work work, int64_t priority, bool start_immediately);
+  void AddWorkShared(Work work, int64_t priority, bool start_immediately);
+
+  /**
+   * @brief Runs a task of a ThreadPoolType::ProcessShared pool in a shared worker
+   *
+   * @param current_device the device of the worker's thread, updated if it's changed
+   */
+  void RunSharedWork(int slot, Work &work, int &current_device);
+
+  /**
+   * @brief Marks a task of a ThreadPoolType::ProcessShared pool as complete
+   */
+  void SharedWorkDone();
+
+  /**
+   * @brief Tries to obtain a task - first from the thread's own queue, then from the others.
+   *
+   * @return true, if a task was obtained
+   */
+  bool TryPop(int thread_id, Work &work);
+
+  void RunWork(int thread_id, Work &work);
+
+  friend class SharedThreadPoolWorkers;
+
   vector<std::thread> threads_;
+  int num_threads_;
+  int device_id_;
+  ThreadPoolType type_;
 
   using PrioritizedWork = std::pair<int64_t, Work>;
   struct SortByPriority {
@@ -81,7 +231,39 @@ class DLL_PUBLIC ThreadPool {
       return a.first < b.first;
     }
   };
-  std::priority_queue<PrioritizedWork, std::vector<PrioritizedWork>, SortByPriority> work_queue_;
+  using WorkQueue =
+      std::priority_queue<PrioritizedWork, std::vector<PrioritizedWork>, SortByPriority>;
+  WorkQueue work_queue_;
+
+  /**
+   * @brief Per-thread queue used by the work-stealing pool
+   *
+   * Aligned to a cache line, so that the owner and the thieves don't suffer from false sharing
+   * of neighbouring queues' locks.
+   */
+  struct alignas(64) LocalQueue {
+    std::mutex mutex;
+    WorkQueue queue;
+  };
+  std::unique_ptr<LocalQueue[]> local_queues_;
+  // round-robin counter used to select the queue for new tasks
+  std::atomic<uint32_t> next_queue_{0};
+  // number of tasks that were added, but not picked up yet
+  std::atomic<int64_t> queued_{0};
+  // number of tasks that were added, but not completed yet
+  std::atomic<int64_t> outstanding_{0};
+  // number of workers sleeping on condition_
+  std::atomic<int> sleeping_{0};
+  std::atomic<bool> ws_started_{false};
+
+  // used by the ThreadPoolType::ProcessShared pool; work_queue_, started_ and free_slots_
+  // are guarded by the mutex of the shared workers
+  std::shared_ptr<SharedThreadPoolWorkers> shared_workers_;
+  // the thread indices not used by the running tasks
+  vector<int> free_slots_;
+
+  std::atomic<bool> measure_busy_time_{false};
+  std::atomic<int64_t> busy_time_ns_{0};
 
   bool running_;
   bool work_complete_;
@@ -15,6 +15,10 @@
 #include "dali/pipeline/util/thread_pool.h"
 #include <gtest/gtest.h>
 #include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace dali {
 
@@ -87,6 +91,181 @@ TEST(ThreadPool, CheckName) {
                       std::min(sizeof(full_thread_pool_name), sizeof(read_thread_pool_name)) - 1));
 }
 
+TEST(ThreadPool, WorkStealingAddWork) {
+  ThreadPool tp(16, 0, false, "ThreadPool test", ThreadPoolType::WorkStealing);
+  EXPECT_EQ(tp.Type(), ThreadPoolType::WorkStealing);
+  std::atomic<int> count{0};
+  auto increase = [&count](int thread_id) { count++; };
+  for (int i = 0; i < 64; i++) {
+    tp.AddWork(increase);
+  }
+  ASSERT_EQ(count, 0);
+  tp.RunAll();
+  ASSERT_EQ(count, 64);
+}
+
+TEST(ThreadPool, WorkStealingAddWorkImmediateStart) {
+  ThreadPool tp(16, 0, false, "ThreadPool test", ThreadPoolType::WorkStealing);
+  std::atomic<int> count{0};
+  auto increase = [&count](int thread_id) { count++; };
+  for (int iter = 0; iter < 100; iter++) {
+    for (int i = 0; i < 1000; i++) {
+      tp.AddWork(increase, 0, true);
+    }
+    tp.WaitForWork();
+    ASSERT_EQ(count, (iter + 1) * 1000);
+  }
+}
+
+TEST(ThreadPool, WorkStealingNestedWork) {
+  ThreadPool tp(4, 0, false, "ThreadPool test", ThreadPoolType::WorkStealing);
+  std::atomic<int> count{0};
+  for (int i = 0; i < 16; i++) {
+    tp.AddWork([&](int) {
+      for (int j = 0; j < 16; j++)
+        tp.AddWork([&](int) { count++; }, 0, true);
+    });
+  }
+  tp.RunAll();
+  ASSERT_EQ(count, 16 * 16);
+}
+
+TEST(ThreadPool, WorkStealingPrioritySingleThread) {
+  // with one thread there's only one queue, so the priorities are honored strictly
+  ThreadPool tp(1, 0, false, "ThreadPool test", ThreadPoolType::WorkStealing);
+  std::vector<int> order;
+  for (int i = 0; i < 10; i++)
+    tp.AddWork([&order, i](int) { order.push_back(i); }, i);
+  tp.RunAll();
+  ASSERT_EQ(order.size(), 10u);
+  for (int i = 0; i < 10; i++)
+    EXPECT_EQ(order[i], 9 - i);
+}
+
+TEST(ThreadPool, WorkStealingError) {
+  ThreadPool tp(4, 0, false, "ThreadPool test", ThreadPoolType::WorkStealing);
+  std::atomic<int> count{0};
+  for (int i = 0; i < 64; i++) {
+    tp.AddWork([&count, i](int) {
+      count++;
+      if (i == 13)
+        throw std::runtime_error("Test error");
+    });
+  }
+  EXPECT_THROW(tp.RunAll(), std::runtime_error);
+  EXPECT_EQ(count, 64);
+}
+
+TEST(ThreadPool, ProcessSharedAddWork) {
+  ThreadPool tp1(4, 0, false, "ThreadPool test", ThreadPoolType::ProcessShared);
+  ThreadPool tp2(2, 0, false, "ThreadPool test", ThreadPoolType::ProcessShared);
+  EXPECT_EQ(tp1.NumThreads(), 4);
+  EXPECT_EQ(tp2.NumThreads(), 2);
+  EXPECT_GT(tp1.NumSharedWorkers(), 0);
+  EXPECT_EQ(tp1.GetThreadIds(), tp2.GetThreadIds());
+  std::atomic<int> count1{0}, count2{0};
+  for (int i = 0; i < 64; i++) {
+    tp1.AddWork([&count1](int thread_id) {
+      EXPECT_LT(thread_id, 4);
+      count1++;
+    });
+    tp2.AddWork([&count2](int thread_id) {
+      EXPECT_LT(thread_id, 2);
+      count2++;
+    });
+  }
+  ASSERT_EQ(count1, 0);
+  tp1.RunAll();
+  ASSERT_EQ(count1, 64);
+  ASSERT_EQ(count2, 0);
+  tp2.RunAll();
+  ASSERT_EQ(count2, 64);
+}
+
+TEST(ThreadPool, ProcessSharedConcurrencyLimit) {
+  ThreadPool tp(2, 0, false, "ThreadPool test", ThreadPoolType::ProcessShared);
+  std::atomic<int> running{0}, max_running{0};
+  std::vector<int> used(2);
+  for (int i = 0; i < 16; i++) {
+    tp.AddWork([&](int thread_id) {
+      int n = ++running;
+      int prev = max_running.load();
+      while (n > prev && !max_running.compare_exchange_weak(prev, n)) {}
+      // the thread index is not used by any other running task
+      EXPECT_EQ(used[thread_id]++, 0);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      used[thread_id]--;
+      running--;
+    });
+  }
+  tp.RunAll();
+  EXPECT_LE(max_running, 2);
+}
+
+TEST(ThreadPool, ProcessSharedIndependentPools) {
+  ThreadPool slow(1, 0, false, "ThreadPool test", ThreadPoolType::ProcessShared);
+  ThreadPool fast(2, 0, false, "ThreadPool test", ThreadPoolType::ProcessShared);
+  if (slow.NumSharedWorkers() < 2)
+    GTEST_SKIP() << "Needs at least 2 shared workers";
+  std::atomic<bool> release{false};
+  slow.AddWork([&](int) {
+    while (!release)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }, 0, true);
+  // waiting for the other pool doesn't wait for the task of the slow one
+  std::atomic<int> count{0};
+  for (int i = 0; i < 16; i++)
+    fast.AddWork([&count](int) { count++; });
+  fast.RunAll();
+  EXPECT_EQ(count, 16);
+  release = true;
+  slow.WaitForWork();
+}
+
+TEST(ThreadPool, ProcessSharedNestedWork) {
+  ThreadPool tp(4, 0, false, "ThreadPool test", ThreadPoolType::ProcessShared);
+  std::atomic<int> count{0};
+  for (int i = 0; i < 16; i++) {
+    tp.AddWork([&](int) {
+      for (int j = 0; j < 16; j++)
+        tp.AddWork([&](int) { count++; }, 0, true);
+    });
+  }
+  tp.RunAll();
+  ASSERT_EQ(count, 16 * 16);
+}
+
+TEST(ThreadPool, ProcessSharedError) {
+  ThreadPool tp(4, 0, false, "ThreadPool test", ThreadPoolType::ProcessShared);
+  std::atomic<int> count{0};
+  for (int i = 0; i < 64; i++) {
+    tp.AddWork([&count, i](int) {
+      count++;
+      if (i == 13)
+        throw std::runtime_error("Test error");
+    });
+  }
+  EXPECT_THROW(tp.RunAll(), std::runtime_error);
+  EXPECT_EQ(count, 64);
+  // the pool is usable after the error
+  tp.AddWork([&count](int) { count++; });
+  tp.RunAll();
+  EXPECT_EQ(count, 65);
+}
+
+TEST(ThreadPool, BusyTime) {
+  ThreadPool tp(2, 0, false, "ThreadPool test");
+  tp.AddWork([](int) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+  tp.RunAll();
+  EXPECT_EQ(tp.BusyTimeNs(), 0);
+
+  tp.EnableBusyTimeMeasurement();
+  for (int i = 0; i < 4; i++)
+    tp.AddWork([](int) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); });
+  tp.RunAll();
+  EXPECT_GE(tp.BusyTimeNs(), 4 * 5 * 1000000);
+}
+
 }  // namespace test
 
 }  // namespace dali
@@ -19,9 +19,11 @@
 #include <utility>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 #include "dali/core/common.h"
+#include "dali/core/mm/arena_resource.h"
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/pipeline/data/tensor_list.h"
@@ -49,30 +51,78 @@ class ArgumentWorkspace {
 
   inline void Clear() {
     argument_inputs_.clear();
+    argument_input_slots_.clear();
   }
 
+  /**
+   * @brief Adds (or replaces) the argument input.
+   *
+   * The arguments are stored in the order in which they were first added - if they're added
+   * in the order of OpSpec::ArgumentInputSlot, they can be accessed by slot.
+   */
   void AddArgumentInput(const std::string& arg_name, shared_ptr<TensorList<CPUBackend>> input) {
-    argument_inputs_[arg_name] = { std::move(input) };
+    auto it = argument_input_slots_.find(arg_name);
+    if (it != argument_input_slots_.end()) {
+      argument_inputs_[it->second].second = { std::move(input) };
+    } else {
+      argument_input_slots_.emplace(arg_name, argument_inputs_.size());
+      argument_inputs_.emplace_back(arg_name, ArgumentInputDesc{ std::move(input) });
+    }
   }
 
   const TensorList<CPUBackend>& ArgumentInput(const std::string& arg_name) const {
-    auto it = argument_inputs_.find(arg_name);
-    DALI_ENFORCE(it != argument_inputs_.end(), "Argument \"" + arg_name + "\" not found.");
-    return *it->second.tvec;
+    auto it = argument_input_slots_.find(arg_name);
+    DALI_ENFORCE(it != argument_input_slots_.end(), "Argument \"" + arg_name + "\" not found.");
+    return *argument_inputs_[it->second].second.tvec;
+  }
+
+  /**
+   * @brief Returns the argument input at the given slot (see OpSpec::ArgumentInputSlot),
+   *        without hashing the name.
+   *
+   * If the argument at the slot has a different name (e.g. the arguments were added in
+   * a different order), the argument is looked up by name.
+   */
+  const TensorList<CPUBackend>& ArgumentInput(int slot, const std::string& arg_name) const {
+    if (slot >= 0 && slot < static_cast<int>(argument_inputs_.size()) &&
+        argument_inputs_[slot].first == arg_name)
+      return *argument_inputs_[slot].second.tvec;
+    return ArgumentInput(arg_name);
   }
 
   TensorList<CPUBackend>& UnsafeMutableArgumentInput(const std::string& arg_name) {
     return const_cast<TensorList<CPUBackend>&>(ArgumentInput(arg_name));
   }
 
+  /**
+   * @brief Returns the arena for the temporary host allocations of the operator, or nullptr.
+   *
+   * The arena is available only in the thread which set it (usually the executor thread which
+   * calls Setup and Run of the operator); other threads, e.g. the ones of the thread pool,
+   * get nullptr. The arena is reset before the operator is set up, so the memory taken from it
+   * must not be used in the following iterations.
+   */
+  mm::host_arena_resource *HostArena() const {
+    return host_arena_thread_ == std::this_thread::get_id() ? host_arena_ : nullptr;
+  }
+
+  void SetHostArena(mm::host_arena_resource *arena) {
+    host_arena_ = arena;
+    host_arena_thread_ = std::this_thread::get_id();
+  }
+
  protected:
   struct ArgumentInputDesc {
     std::shared_ptr<TensorList<CPUBackend>> tvec;
   };
 
   // Argument inputs
-  using argument_input_storage_t = std::unordered_map<std::string, ArgumentInputDesc>;
+  using argument_input_storage_t = std::vector<std::pair<std::string, ArgumentInputDesc>>;
   argument_input_storage_t argument_inputs_;
+  std::unordered_map<std::string, int> argument_input_slots_;
+
+  mm::host_arena_resource *host_arena_ = nullptr;
+  std::thread::id host_arena_thread_;
 
  public:
   using const_iterator = argument_input_storage_t::const_iterator;
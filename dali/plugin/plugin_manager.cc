@@ -1,4 +1,4 @@
-// Copyright (c) 2018, 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2018, 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -13,11 +13,36 @@
 // limitations under the License.
 
 #include <dlfcn.h>
+#include <map>
+#include <memory>
+#include <mutex>
 #include "dali/plugin/plugin_manager.h"
 #include "dali/core/error_handling.h"
 
 namespace dali {
 
+namespace {
+
+struct DeferredLibrary {
+  std::string path;
+  bool global_symbols = false;
+  bool loaded = false;
+};
+
+struct DeferredLibraries {
+  // Recursive, because loading a library runs its static initializers, which may look up
+  // the schemas of other (possibly deferred) operators
+  std::recursive_mutex mutex;
+  std::map<std::string, std::shared_ptr<DeferredLibrary>> by_op;
+};
+
+DeferredLibraries &GetDeferredLibraries() {
+  static DeferredLibraries libs;
+  return libs;
+}
+
+}  // namespace
+
 void PluginManager::LoadLibrary(const std::string& lib_path, bool global_symbols) {
     // dlopen is thread safe
     int flags = global_symbols ? RTLD_GLOBAL : RTLD_LOCAL;
@@ -26,4 +51,34 @@ void PluginManager::LoadLibrary(const std::string& lib_path, bool global_symbols
     DALI_ENFORCE(handle != nullptr, "Failed to load library: " + std::string(dlerror()));
 }
 
+void PluginManager::RegisterDeferredLibrary(const std::string& lib_path,
+                                            const std::vector<std::string>& op_names,
+                                            bool global_symbols) {
+    auto &libs = GetDeferredLibraries();
+    auto lib = std::make_shared<DeferredLibrary>();
+    lib->path = lib_path;
+    lib->global_symbols = global_symbols;
+    std::lock_guard<std::recursive_mutex> g(libs.mutex);
+    for (auto &name : op_names)
+        libs.by_op[name] = lib;
+}
+
+bool PluginManager::LoadDeferredLibrary(const std::string& op_name) {
+    auto &libs = GetDeferredLibraries();
+    std::lock_guard<std::recursive_mutex> g(libs.mutex);
+    auto it = libs.by_op.find(op_name);
+    if (it == libs.by_op.end() || it->second->loaded)
+        return false;
+    auto lib = it->second;
+    // Marked before loading, so that a lookup made by the library itself doesn't recurse
+    lib->loaded = true;
+    try {
+        LoadLibrary(lib->path, lib->global_symbols);
+    } catch (...) {
+        lib->loaded = false;
+        throw;
+    }
+    return true;
+}
+
 }  // namespace dali
@@ -1,4 +1,4 @@
-// Copyright (c) 2018, 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2018, 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,6 +16,7 @@
 #define DALI_PLUGIN_PLUGIN_MANAGER_H_
 
 #include <string>
+#include <vector>
 #include "dali/core/common.h"
 
 namespace dali {
@@ -31,6 +32,27 @@ class DLL_PUBLIC PluginManager {
      * @throws std::runtime_error if the library could not be loaded
      */
     static DLL_PUBLIC void LoadLibrary(const std::string& lib_path, bool global_symbols = false);
+
+    /**
+     * @brief Register a library to be loaded on first use of one of its operators
+     * @remarks Nothing is loaded until an operator (or its schema) listed in `op_names` is
+     *          looked up and not found, which keeps the startup time and the memory footprint of
+     *          the pipelines that don't use them low.
+     * @param [in] lib_path path to the library
+     * @param [in] op_names schema names of the operators registered by the library
+     * @param [in] global_symbols see LoadLibrary
+     */
+    static DLL_PUBLIC void RegisterDeferredLibrary(const std::string& lib_path,
+                                                   const std::vector<std::string>& op_names,
+                                                   bool global_symbols = false);
+
+    /**
+     * @brief Load the deferred library which provides the operator `op_name`
+     * @return true if a library was loaded, false if there's no deferred library for this
+     *         operator or it was already loaded
+     * @throws std::runtime_error if the library could not be loaded
+     */
+    static DLL_PUBLIC bool LoadDeferredLibrary(const std::string& op_name);
 };
 
 }  // namespace dali
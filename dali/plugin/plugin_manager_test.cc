@@ -41,3 +41,20 @@ TEST(PluginManagerTest, LoadingSameLibraryTwiceShouldBeOk) {
             dali::PluginManager::LoadLibrary(DummyPluginLibPath()) );
     }
 }
+
+TEST(PluginManagerTest, DeferredLibraryFail) {
+    dali::PluginManager::RegisterDeferredLibrary(kNonExistingLibName, {"NotADaliOperator"});
+    EXPECT_FALSE(dali::PluginManager::LoadDeferredLibrary("NotRegisteredAnywhere"));
+    // a failed load is not remembered, so every use reports the error
+    for (int i = 0; i < 2; i++) {
+        EXPECT_THROW(
+            dali::PluginManager::LoadDeferredLibrary("NotADaliOperator"),
+            std::runtime_error);
+    }
+}
+
+TEST(PluginManagerTest, DeferredLibraryOK) {
+    dali::PluginManager::RegisterDeferredLibrary(DummyPluginLibPath(), {"TestDeferredDummy"});
+    EXPECT_TRUE(dali::PluginManager::LoadDeferredLibrary("TestDeferredDummy"));
+    EXPECT_FALSE(dali::PluginManager::LoadDeferredLibrary("TestDeferredDummy"));
+}
@@ -15,9 +15,15 @@
 #include <cuda_runtime_api.h>
 #include <dlfcn.h>
 #include <sstream>
+#include "dali/c_api.h"
 #include "dali/core/common.h"
 #include "dali/core/cuda_utils.h"
 #include "dali/core/device_guard.h"
+#include "dali/core/metrics.h"
+#include "dali/core/mm/default_resources.h"
+#include "dali/core/mm/memory_budget.h"
+#include "dali/core/mm/memory_trace.h"
+#include "dali/core/trace.h"
 #if SHM_WRAPPER_ENABLED
 #include "dali/core/os/shared_mem.h"
 #endif
@@ -27,6 +33,7 @@
 #include "dali/operators/reader/parser/tfrecord_parser.h"
 #include "dali/pipeline/data/copy_to_external.h"
 #include "dali/pipeline/data/dltensor.h"
+#include "dali/pipeline/data/ipc_buffer.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/pipeline/data/tensor_list.h"
 #include "dali/pipeline/init.h"
@@ -1065,6 +1072,18 @@ void ExposeTensorList(py::module &m) {
 
       This function can only be called if `is_dense_tensor` returns `True`.
       )code")
+    .def("as_dlpack_values",
+        [](TensorList<CPUBackend> &tl) {
+          return TensorListValuesToDLPackView(tl);
+        },
+      R"code(
+      Returns a DLPack capsule with a flat, 1D view of the values of all the samples.
+
+      The samples of a batch which is contiguous in memory (e.g. a pipeline output) are stored
+      back to back, so the values together with the offsets of the samples (the prefix sums of
+      their volumes) describe a ragged batch without any padding. The view doesn't own the data
+      - it is valid only as long as this `TensorList` is not modified or reused.
+      )code")
     .def("data_ptr",
         [](TensorList<CPUBackend> &tl) {
           return py::reinterpret_borrow<py::object>(
@@ -1264,6 +1283,18 @@ void ExposeTensorList(py::module &m) {
 
       This function can only be called if `is_dense_tensor` returns `True`.
       )code")
+    .def("as_dlpack_values",
+        [](TensorList<GPUBackend> &tl) {
+          return TensorListValuesToDLPackView(tl);
+        },
+      R"code(
+      Returns a DLPack capsule with a flat, 1D view of the values of all the samples.
+
+      The samples of a batch which is contiguous in memory (e.g. a pipeline output) are stored
+      back to back, so the values together with the offsets of the samples (the prefix sums of
+      their volumes) describe a ragged batch without any padding. The view doesn't own the data
+      - it is valid only as long as this `TensorList` is not modified or reused.
+      )code")
     .def("data_ptr",
         [](TensorList<GPUBackend> &tl) {
           return py::reinterpret_borrow<py::object>(
@@ -1389,6 +1420,235 @@ void ExposeBufferPolicyFunctions(py::module &m) {
   m.def("RestrictPinnedMemUsage", RestrictPinnedMemUsage);
 }
 
+py::dict MemoryBudgetToDict(const mm::memory_budget &budget) {
+  py::dict d;
+  size_t limit = budget.limit();
+  d["limit"] = limit == mm::memory_budget::unlimited ? py::object(py::none())
+                                                     : py::object(py::int_(limit));
+  d["used"] = budget.used();
+  d["peak"] = budget.peak();
+  py::dict components;
+  for (auto &stat : budget.stats()) {
+    py::dict c;
+    c["current"] = stat.current;
+    c["peak"] = stat.peak;
+    components[stat.component.c_str()] = c;
+  }
+  d["components"] = components;
+  return d;
+}
+
+size_t MemoryBudgetLimit(py::object limit) {
+  if (limit.is_none())
+    return mm::memory_budget::unlimited;
+  auto value = limit.cast<int64_t>();
+  if (value < 0)
+    throw py::value_error("The memory budget must not be negative.");
+  return value;
+}
+
+void ExposeMemoryBudgetFunctions(py::module &m) {
+  m.def("SetDeviceMemoryBudget", [](py::object limit, int device_id) {
+    mm::GetDeviceMemoryBudget(device_id).set_limit(MemoryBudgetLimit(limit));
+  }, py::arg("limit"), py::arg("device_id") = -1);
+  m.def("SetPinnedMemoryBudget", [](py::object limit) {
+    mm::GetPinnedMemoryBudget().set_limit(MemoryBudgetLimit(limit));
+  }, py::arg("limit"));
+  m.def("GetDeviceMemoryBudgetStats", [](int device_id) {
+    return MemoryBudgetToDict(mm::GetDeviceMemoryBudget(device_id));
+  }, py::arg("device_id") = -1);
+  m.def("GetPinnedMemoryBudgetStats", []() {
+    return MemoryBudgetToDict(mm::GetPinnedMemoryBudget());
+  });
+  m.def("ReleaseUnusedMemory", []() {
+    return mm::ReleaseUnusedMemory();
+  },
+  R"code(Returns the memory held, but not used, by the default device and pinned memory pools
+to the system and returns the number of bytes released.)code");
+  m.def("GetPoolFreeStats", []() {
+    py::list ret;
+    for (auto &stat : mm::GetPoolFreeStats()) {
+      py::dict d;
+      d["pool"] = stat.pool;
+      d["free_bytes"] = stat.free.free_bytes;
+      d["free_blocks"] = stat.free.free_blocks;
+      d["largest_block"] = stat.free.largest_block;
+      d["fragmentation"] = stat.free.fragmentation();
+      ret.append(d);
+    }
+    return ret;
+  },
+  R"code(Returns the statistics of the free memory held by the default device and pinned memory
+pools - the ``fragmentation`` is the part of the free memory outside of the largest free block.)code");
+}
+
+void ExposeAllocationTraceFunctions(py::module &m) {
+  m.def("StartAllocationTrace", [](size_t capacity) {
+    mm::alloc_tracer::instance().start(capacity);
+  }, py::arg("capacity") = mm::alloc_tracer::kDefaultCapacity,
+  R"code(Starts recording the allocations and deallocations of the DALI buffers, keeping
+the last ``capacity`` events.)code");
+  m.def("StopAllocationTrace", []() {
+    mm::alloc_tracer::instance().stop();
+  });
+  m.def("GetAllocationTrace", []() {
+    std::stringstream ss;
+    mm::alloc_tracer::instance().write_chrome_trace(ss);
+    return ss.str();
+  },
+  R"code(Returns the recorded allocation trace as a Chrome trace event JSON string, which can be
+viewed in ``chrome://tracing`` or Perfetto.)code");
+}
+
+void ExposeTraceFunctions(py::module &m) {
+  m.def("StartTrace", [](int64_t max_thread_events) {
+    Tracer::instance().Start(max_thread_events);
+  }, py::arg("max_thread_events") = Tracer::kDefaultMaxThreadEvents,
+  R"code(Discards the previous trace and starts tracing the executor stages, the operators
+(on the host and on the device), the thread pool tasks, the readers and the decoders.
+
+Each thread keeps at most ``max_thread_events`` events.)code");
+  m.def("StopTrace", []() {
+    Tracer::instance().Stop();
+  });
+  m.def("GetTrace", []() {
+    std::stringstream ss;
+    {
+      py::gil_scoped_release interpreter_unlock{};
+      Tracer::instance().WriteChromeTrace(ss);
+    }
+    return ss.str();
+  },
+  R"code(Returns the trace recorded since the last ``StartTrace`` as a Chrome trace event JSON
+string, which can be viewed in ``chrome://tracing`` or Perfetto.
+
+The device ranges are resolved when the trace is returned, which waits for their completion.)code");
+}
+
+void ExposeMetricsFunctions(py::module &m) {
+  m.def("GetMetrics", []() {
+    std::stringstream ss;
+    {
+      py::gil_scoped_release interpreter_unlock{};
+      metrics::MetricsRegistry::instance().WritePrometheus(ss);
+    }
+    return ss.str();
+  },
+  R"code(Returns the current values of the DALI metrics in the Prometheus text exposition format.
+
+The metrics include the number of batches produced by each pipeline, the number of samples and
+bytes produced by the readers, the number of decoding failures per image format, the memory
+allocated per kind, the free memory held by the pools and the queue depths of the executors.)code");
+}
+
+void ExposeDeviceAllocatorFunctions(py::module &m) {
+  m.def("SetDeviceAllocator", [](uintptr_t alloc_fn, uintptr_t free_fn, int device_id) {
+    daliSetDeviceAllocator(device_id, reinterpret_cast<daliDeviceAllocFn>(alloc_fn),
+                           reinterpret_cast<daliDeviceFreeFn>(free_fn));
+  }, py::arg("alloc_fn"), py::arg("free_fn"), py::arg("device_id") = -1,
+  R"code(Makes DALI allocate the device memory with an external, stream-ordered allocator.
+
+The functions are passed as addresses and must have the following signatures::
+
+    void *alloc_fn(size_t size, int device_id, cudaStream_t stream);
+    void free_fn(void *ptr, size_t size, int device_id, cudaStream_t stream);
+
+Passing 0 for both restores the default memory pool. Call this function before DALI allocates
+any device memory on the device.)code");
+  m.def("GetDeviceAllocator", []() {
+    return py::make_tuple(reinterpret_cast<uintptr_t>(&daliDeviceAlloc),
+                          reinterpret_cast<uintptr_t>(&daliDeviceFree));
+  },
+  R"code(Returns the addresses of the stream-ordered allocation and deallocation functions
+which allocate from the DALI's default device memory resource, with the signatures accepted by
+:meth:`SetDeviceAllocator`.
+
+The functions are exported from the DALI library as ``daliDeviceAlloc`` and ``daliDeviceFree``,
+so they can be used by the pluggable allocators of the frameworks, e.g.
+``torch.cuda.memory.CUDAPluggableAllocator(<path to libdali.so>, "daliDeviceAlloc",
+"daliDeviceFree")``, to serve the framework and DALI with a single memory pool.)code");
+}
+
+void ExposeCrossDeviceSum(py::module &m) {
+  m.def("SetCrossDeviceSum", [](const std::string &group, uintptr_t sum_fn, uintptr_t user_data) {
+    daliSetCrossDeviceSum(group.c_str(), reinterpret_cast<daliCrossDeviceSumFn>(sum_fn),
+                          reinterpret_cast<void *>(user_data));
+  }, py::arg("group"), py::arg("sum_fn"), py::arg("user_data") = 0,
+  R"code(Registers the reduction across the devices of the named group, used by the operators
+which combine the statistics of the whole data-parallel batch, e.g. :meth:`nvidia.dali.fn.normalize`
+with ``batch=True`` and ``cross_device_group``.
+
+The function is passed as an address and must have the following signature::
+
+    void sum_fn(double *data, size_t count, cudaStream_t stream, void *user_data);
+
+It must sum the device buffer ``data`` in place across the devices of the group, enqueuing
+the work on ``stream`` - typically with ``ncclAllReduce`` on the communicator of the
+data-parallel group, passed as ``user_data``. Passing 0 as ``sum_fn`` removes the registration.)code");
+}
+
+void ExposeIpc(py::module &m) {
+#if DALI_USE_CUDA_VM_MAP
+  auto stream_from_py = [](const py::object &cuda_stream) {
+    return cuda_stream.is_none() ? cudaStream_t(0)
+                                 : static_cast<cudaStream_t>(ctypes_void_ptr(cuda_stream));
+  };
+  py::class_<IpcDeviceBuffer, std::shared_ptr<IpcDeviceBuffer>>(m, "IpcDeviceBuffer",
+      R"code(Device memory which can be mapped by other processes, with a POSIX file descriptor
+passed e.g. with ``multiprocessing.reduction.send_handle``.)code")
+    .def_static("create", &IpcDeviceBuffer::Create, "size"_a, "device_id"_a = -1,
+      R"code(Allocates an exportable buffer of at least `size` bytes.)code")
+    .def_static("import_fd", &IpcDeviceBuffer::Import, "fd"_a, "size"_a, "device_id"_a = -1,
+      R"code(Maps the buffer exported by another process. The descriptor is not closed.)code")
+    .def("export_fd", &IpcDeviceBuffer::Export,
+      R"code(Returns a new file descriptor of the buffer, to be closed by the caller.)code")
+    .def_property_readonly("size", &IpcDeviceBuffer::size)
+    .def_property_readonly("device_id", &IpcDeviceBuffer::device_id)
+    .def("copy_from",
+        [stream_from_py](IpcDeviceBuffer &buffer, size_t offset, const TensorList<GPUBackend> &tl,
+                         py::object cuda_stream) {
+          CopyToIpcBuffer(buffer, offset, tl, stream_from_py(cuda_stream));
+        },
+      "offset"_a, "tensor_list"_a, "cuda_stream"_a = py::none(),
+      R"code(Copies the samples of a `TensorListGPU` densely to the buffer, on `cuda_stream`.)code")
+    .def("as_tensor_list",
+        [stream_from_py](const std::shared_ptr<IpcDeviceBuffer> &buffer, size_t offset,
+                         const std::vector<std::vector<int64_t>> &shapes, DALIDataType dtype,
+                         const std::string &layout, py::object cuda_stream) {
+          auto tl = std::make_shared<TensorList<GPUBackend>>();
+          ShareIpcBuffer(*tl, buffer, offset, TensorListShape<>(shapes), dtype, layout,
+                         stream_from_py(cuda_stream));
+          return tl;
+        },
+      "offset"_a, "shapes"_a, "dtype"_a, "layout"_a = "", "cuda_stream"_a = py::none(),
+      R"code(Returns a `TensorListGPU` which is a view of the samples stored densely
+at `offset`. The view keeps the buffer alive.)code");
+  m.def("IpcBatchBytes", &IpcBatchBytes, "tensor_list"_a,
+      R"code(The number of bytes occupied by the samples of a `TensorListGPU`.)code");
+  py::class_<IpcEvent>(m, "IpcEvent",
+      R"code(A CUDA event which can be waited for in other processes.)code")
+    .def_static("create", &IpcEvent::Create, "device_id"_a = -1)
+    .def_static("open", [](py::bytes handle, int device_id) {
+          std::string bytes = handle;
+          DALI_ENFORCE(bytes.size() == sizeof(cudaIpcEventHandle_t), "Invalid event handle.");
+          cudaIpcEventHandle_t h;
+          memcpy(&h, bytes.data(), sizeof(h));
+          return IpcEvent::Open(h, device_id);
+        }, "handle"_a, "device_id"_a = -1)
+    .def("handle", [](const IpcEvent &event) {
+          return py::bytes(reinterpret_cast<const char *>(&event.handle()),
+                           sizeof(cudaIpcEventHandle_t));
+        })
+    .def("record", [stream_from_py](IpcEvent &event, py::object cuda_stream) {
+          event.Record(stream_from_py(cuda_stream));
+        }, "cuda_stream"_a = py::none())
+    .def("wait", [stream_from_py](IpcEvent &event, py::object cuda_stream) {
+          event.Wait(stream_from_py(cuda_stream));
+        }, "cuda_stream"_a = py::none())
+    .def("synchronize", &IpcEvent::Synchronize, py::call_guard<py::gil_scoped_release>());
+#endif  // DALI_USE_CUDA_VM_MAP
+}
+
 py::dict DeprecatedArgMetaToDict(const DeprecatedArgDef & meta) {
   py::dict d;
   d["msg"] = meta.msg;
@@ -1431,6 +1691,144 @@ py::dict ExecutorMetaToDict(const ExecutorMetaMap &meta) {
   return d;
 }
 
+py::dict TimeHistogramToDict(const TimeHistogram &histogram) {
+  py::dict d;
+  d["count"] = histogram.count;
+  d["total_ns"] = histogram.total_ns;
+  d["min_ns"] = histogram.min_ns;
+  d["max_ns"] = histogram.max_ns;
+  py::list buckets;
+  for (auto b : histogram.buckets)
+    buckets.append(b);
+  d["buckets"] = buckets;
+  return d;
+}
+
+void AddTimingStatsToDict(py::dict &d, const OperatorTimingMap &timing) {
+  for (const auto &stat : timing) {
+    auto key = py::str(stat.first);
+    if (!d.contains(key))
+      d[key] = py::dict();
+    auto op_dict = d[key].cast<py::dict>();
+    op_dict["host_time"] = TimeHistogramToDict(stat.second.host_time);
+    if (stat.second.gpu_time.count > 0)
+      op_dict["gpu_time"] = TimeHistogramToDict(stat.second.gpu_time);
+  }
+}
+
+void AddHostArenaStatsToDict(py::dict &d, const HostArenaStatsMap &arena_stats) {
+  for (const auto &stat : arena_stats) {
+    auto key = py::str(stat.first);
+    if (!d.contains(key))
+      d[key] = py::dict();
+    auto op_dict = d[key].cast<py::dict>();
+    op_dict["host_arena_allocations"] = stat.second.allocations;
+    op_dict["host_arena_upstream_allocations"] = stat.second.upstream_allocations;
+    op_dict["host_arena_peak_bytes"] = stat.second.peak_bytes;
+  }
+}
+
+py::dict StageTimingStatsToDict(const ExecutorTimingStats &timing) {
+  py::dict d;
+  // indexed with OpType
+  const char *stage_names[] = {"gpu", "cpu", "mixed"};
+  for (auto stage : {OpType::CPU, OpType::MIXED, OpType::GPU}) {
+    const auto &stats = timing.stages[static_cast<int>(stage)];
+    py::dict stage_dict;
+    stage_dict["queue_wait"] = TimeHistogramToDict(stats.queue_wait);
+    stage_dict["run_time"] = TimeHistogramToDict(stats.run_time);
+    if (stage == OpType::CPU) {
+      stage_dict["thread_pool_busy_ns"] = stats.thread_pool_busy_ns;
+      stage_dict["thread_pool_capacity_ns"] = stats.thread_pool_capacity_ns;
+      stage_dict["num_threads"] = stats.num_threads;
+      stage_dict["shared_pool_threads"] = stats.shared_pool_threads;
+    }
+    d[stage_names[static_cast<int>(stage)]] = stage_dict;
+  }
+  return d;
+}
+
+py::dict BottleneckReportToDict(const BottleneckReport &report) {
+  py::dict d;
+  // indexed with OpType
+  const char *stage_names[] = {"gpu", "cpu", "mixed"};
+  d["verdict"] = to_string(report.verdict);
+  d["iterations"] = report.iterations;
+  d["window_s"] = report.window_s;
+  d["consumer_wait_fraction"] = report.consumer_wait_fraction;
+  d["ready_outputs"] = report.ready_outputs;
+  d["thread_pool_utilization"] = report.thread_pool_utilization;
+  d["io_fraction"] = report.io_fraction;
+  py::dict stages;
+  for (auto stage : {OpType::CPU, OpType::MIXED, OpType::GPU}) {
+    py::dict stage_dict;
+    stage_dict["time_s"] = report.stage_time_s[static_cast<int>(stage)];
+    stage_dict["wait_fraction"] = report.stage_wait_fraction[static_cast<int>(stage)];
+    stages[stage_names[static_cast<int>(stage)]] = stage_dict;
+  }
+  d["stages"] = stages;
+  py::list operators;
+  for (const auto &op : report.operators) {
+    py::dict op_dict;
+    op_dict["name"] = op.name;
+    op_dict["stage"] = stage_names[static_cast<int>(op.stage)];
+    op_dict["stage_share"] = op.stage_share;
+    op_dict["critical_path_share"] = op.critical_path_share;
+    operators.append(op_dict);
+  }
+  d["operators"] = operators;
+  return d;
+}
+
+py::dict PlacementReportToDict(const PlacementReport &report) {
+  py::dict d;
+  d["enabled"] = report.enabled;
+  d["summary"] = to_string(report);
+  d["cpu_time_s"] = py::make_tuple(report.cpu_time_before_s, report.cpu_time_after_s);
+  d["gpu_time_s"] = py::make_tuple(report.gpu_time_before_s, report.gpu_time_after_s);
+  d["transfers"] = py::make_tuple(report.transfers_before, report.transfers_after);
+  py::list operators;
+  for (const auto &decision : report.decisions) {
+    py::dict op_dict;
+    op_dict["name"] = decision.instance_name;
+    op_dict["key"] = decision.key;
+    op_dict["device"] = decision.moved ? "gpu" : "cpu";
+    op_dict["reason"] = decision.reason;
+    op_dict["cpu_s"] = decision.cpu_s;
+    op_dict["gpu_s"] = decision.gpu_s;
+    op_dict["gpu_estimated"] = decision.gpu_modeled;
+    operators.append(op_dict);
+  }
+  d["operators"] = operators;
+  return d;
+}
+
+py::dict OperatorCostsToDict(const OperatorCostMap &costs) {
+  py::dict d;
+  auto to_py = [](double s) -> py::object {
+    return s >= 0 ? py::object(py::float_(s)) : py::object(py::none());
+  };
+  for (const auto &cost : costs)
+    d[cost.first.c_str()] = py::make_tuple(to_py(cost.second.cpu_s), to_py(cost.second.gpu_s));
+  return d;
+}
+
+OperatorCostMap OperatorCostsFromDict(const py::dict &d) {
+  OperatorCostMap costs;
+  for (const auto &item : d) {
+    auto cost_tuple = item.second.cast<py::tuple>();
+    DALI_ENFORCE(cost_tuple.size() == 2, "The cost of an operator must be given as a pair of "
+                 "the CPU and the GPU time, in seconds (or None, if unknown).");
+    OperatorCost cost;
+    if (!cost_tuple[0].is_none())
+      cost.cpu_s = cost_tuple[0].cast<double>();
+    if (!cost_tuple[1].is_none())
+      cost.gpu_s = cost_tuple[1].cast<double>();
+    costs[item.first.cast<std::string>()] = cost;
+  }
+  return costs;
+}
+
 template <typename Backend>
 void ExposeEagerOperator(py::module &m, const char *name) {
   py::class_<EagerOperator<Backend>>(m, name)
@@ -1490,11 +1888,26 @@ PYBIND11_MODULE(backend_impl, m) {
   m.def("Init", &DALIInit);
 
   ExposeBufferPolicyFunctions(m);
+  ExposeMemoryBudgetFunctions(m);
+  ExposeDeviceAllocatorFunctions(m);
+  ExposeCrossDeviceSum(m);
+  ExposeIpc(m);
+  ExposeAllocationTraceFunctions(m);
+  ExposeTraceFunctions(m);
+  ExposeMetricsFunctions(m);
 
   m.def("LoadLibrary", &PluginManager::LoadLibrary,
     py::arg("lib_path"),
     py::arg("global_symbols") = false);
 
+  m.def("RegisterDeferredLibrary", &PluginManager::RegisterDeferredLibrary,
+    py::arg("lib_path"),
+    py::arg("op_names"),
+    py::arg("global_symbols") = false);
+
+  m.def("LoadDeferredLibrary", &PluginManager::LoadDeferredLibrary,
+    py::arg("op_name"));
+
   m.def("GetCxx11AbiFlag", &GetCxx11AbiFlag);
 
   m.def("IsDriverInitialized", [] {
@@ -1588,6 +2001,7 @@ PYBIND11_MODULE(backend_impl, m) {
     .value("INT32",         DALI_INT32)
     .value("INT64",         DALI_INT64)
     .value("FLOAT16",       DALI_FLOAT16)
+    .value("BFLOAT16",      DALI_BFLOAT16)
     .value("FLOAT",         DALI_FLOAT)
     .value("FLOAT64",       DALI_FLOAT64)
     .value("BOOL",          DALI_BOOL)
@@ -1727,26 +2141,120 @@ PYBIND11_MODULE(backend_impl, m) {
          })
     .def("Build", [](Pipeline *p) { p->Build(); } )
     .def("SetExecutionTypes",
-        [](Pipeline *p, bool exec_pipelined, bool exec_separated, bool exec_async) {
-          p->SetExecutionTypes(exec_pipelined, exec_separated, exec_async);
+        [](Pipeline *p, bool exec_pipelined, bool exec_separated, bool exec_async,
+           bool exec_dataflow, bool exec_low_latency) {
+          p->SetExecutionTypes(exec_pipelined, exec_separated, exec_async, exec_dataflow,
+                               exec_low_latency);
         },
         "exec_pipelined"_a = true,
         "exec_separated"_a = false,
-        "exec_async"_a = true)
+        "exec_async"_a = true,
+        "exec_dataflow"_a = false,
+        "exec_low_latency"_a = false)
+    .def("SetThreadPoolType",
+        [](Pipeline *p, const std::string &thread_pool_type) {
+          if (thread_pool_type == "shared_queue") {
+            p->SetThreadPoolType(ThreadPoolType::SharedQueue);
+          } else if (thread_pool_type == "work_stealing") {
+            p->SetThreadPoolType(ThreadPoolType::WorkStealing);
+          } else if (thread_pool_type == "process_shared") {
+            p->SetThreadPoolType(ThreadPoolType::ProcessShared);
+          } else {
+            DALI_FAIL(make_string("Unknown thread pool type: \"", thread_pool_type,
+                                  "\". Supported values are: \"shared_queue\", "
+                                  "\"work_stealing\" and \"process_shared\"."));
+          }
+        },
+        "thread_pool_type"_a = "shared_queue")
+    .def("SetGPUMultiStream",
+        [](Pipeline *p, bool gpu_multi_stream) {
+          p->SetGPUMultiStream(gpu_multi_stream);
+        },
+        "gpu_multi_stream"_a = true)
+    .def("SetGPUGraphCapture",
+        [](Pipeline *p, bool gpu_graph_capture) {
+          p->SetGPUGraphCapture(gpu_graph_capture);
+        },
+        "gpu_graph_capture"_a = true)
+    .def("SetGPUMemoryPlanning",
+        [](Pipeline *p, bool gpu_memory_planning) {
+          p->SetGPUMemoryPlanning(gpu_memory_planning);
+        },
+        "gpu_memory_planning"_a = true)
+    .def("SetGPUMicroBatchSize",
+        [](Pipeline *p, int micro_batch_size) {
+          p->SetGPUMicroBatchSize(micro_batch_size);
+        },
+        "micro_batch_size"_a)
+    .def("SetUrgentStreamPriority",
+        [](Pipeline *p, int priority) {
+          p->SetUrgentStreamPriority(priority);
+        },
+        "priority"_a)
     .def("EnableExecutorMemoryStats",
         [](Pipeline *p, bool enable_memory_stats) {
           p->EnableExecutorMemoryStats(enable_memory_stats);
         },
         "enable_memory_stats"_a = true)
+    .def("EnableExecutorTimingStats",
+        [](Pipeline *p, bool enable_timing_stats) {
+          p->EnableExecutorTimingStats(enable_timing_stats);
+        },
+        "enable_timing_stats"_a = true)
     .def("executor_statistics",
         [](Pipeline *p) {
           auto ret = p->GetExecutorMeta();
-          return ExecutorMetaToDict(ret);
+          auto d = ExecutorMetaToDict(ret);
+          AddTimingStatsToDict(d, p->GetExecutorTimingStats().operators);
+          AddHostArenaStatsToDict(d, p->GetHostArenaStats());
+          return d;
+        })
+    .def("executor_stage_statistics",
+        [](Pipeline *p) {
+          return StageTimingStatsToDict(p->GetExecutorTimingStats());
+        })
+    .def("EnableBottleneckAnalysis",
+        [](Pipeline *p, double interval_s) {
+          p->EnableBottleneckAnalysis(interval_s);
+        },
+        "interval_s"_a = 1.0)
+    .def("bottleneck_report",
+        [](Pipeline *p) {
+          return BottleneckReportToDict(p->GetBottleneckReport());
+        })
+    .def("EnableAutoPlacement",
+        [](Pipeline *p, py::dict costs, double gpu_speedup, double transfer_cost_s) {
+          PlacementOptions options;
+          options.gpu_speedup = gpu_speedup;
+          options.transfer_cost_s = transfer_cost_s;
+          p->EnableAutoPlacement(OperatorCostsFromDict(costs), options);
+        },
+        "costs"_a, "gpu_speedup"_a = PlacementOptions().gpu_speedup,
+        "transfer_cost_s"_a = PlacementOptions().transfer_cost_s)
+    .def("operator_costs",
+        [](Pipeline *p) {
+          return OperatorCostsToDict(p->GetOperatorCosts());
+        })
+    .def("placement_report",
+        [](Pipeline *p) {
+          return PlacementReportToDict(p->GetPlacementReport());
         })
     .def("SetQueueSizes",
         [](Pipeline *p, int cpu_size, int gpu_size) {
           p->SetQueueSizes(cpu_size, gpu_size);
         })
+    .def("SetMinQueueSizes",
+        [](Pipeline *p, int cpu_size, int gpu_size) {
+          p->SetMinQueueSizes(cpu_size, gpu_size);
+        })
+    .def("current_queue_sizes",
+        [](Pipeline *p) {
+          auto sizes = p->GetCurrentQueueSizes();
+          py::dict d;
+          d["cpu_size"] = sizes.cpu_size;
+          d["gpu_size"] = sizes.gpu_size;
+          return d;
+        })
     .def("SetOutputDescs",
         [](Pipeline *p, const std::vector<OutputDesc>& outputs) {
           std::vector<PipelineOutputDesc> out_desc;
@@ -1773,9 +2281,12 @@ PYBIND11_MODULE(backend_impl, m) {
           return outs;
         }, py::return_value_policy::take_ownership)
     .def("ShareOutputs",
-        [](Pipeline *p) {
+        [](Pipeline *p, py::object cuda_stream) {
           DeviceWorkspace ws;
-          p->ShareOutputs(&ws);
+          AccessOrder order = AccessOrder::host();
+          if (!cuda_stream.is_none())
+            order = AccessOrder(static_cast<cudaStream_t>(ctypes_void_ptr(cuda_stream)));
+          p->ShareOutputs(&ws, order);
 
           py::tuple outs(ws.NumOutput());
           for (int i = 0; i < ws.NumOutput(); ++i) {
@@ -1786,11 +2297,14 @@ PYBIND11_MODULE(backend_impl, m) {
             }
           }
           return outs;
-        }, py::return_value_policy::take_ownership)
+        }, "cuda_stream"_a = py::none(), py::return_value_policy::take_ownership)
     .def("ReleaseOutputs",
-        [](Pipeline *p) {
-          p->ReleaseOutputs();
-        })
+        [](Pipeline *p, py::object cuda_stream) {
+          AccessOrder order = AccessOrder::host();
+          if (!cuda_stream.is_none())
+            order = AccessOrder(static_cast<cudaStream_t>(ctypes_void_ptr(cuda_stream)));
+          p->ReleaseOutputs(order);
+        }, "cuda_stream"_a = py::none())
     .def("batch_size", &Pipeline::batch_size)
     .def("num_threads", &Pipeline::num_threads)
     .def("device_id", &Pipeline::device_id)
@@ -1875,10 +2389,10 @@ PYBIND11_MODULE(backend_impl, m) {
     .def("SetPyObjDependency",
       [](Pipeline *p, py::object obj) {}, "obj"_a, py::keep_alive<1, 2>())
     .def("SerializeToProtobuf",
-        [](Pipeline *p) -> py::bytes {
-          string s = p->SerializeToProtobuf();
+        [](Pipeline *p, bool memory_hints) -> py::bytes {
+          string s = p->SerializeToProtobuf(memory_hints);
           return s;
-          }, py::return_value_policy::take_ownership)
+          }, "memory_hints"_a = false, py::return_value_policy::take_ownership)
     .def("SaveGraphToDotFile", &Pipeline::SaveGraphToDotFile,
         "path"_a,
         "show_tensors"_a = false,
@@ -1898,7 +2412,21 @@ PYBIND11_MODULE(backend_impl, m) {
           DALI_ENFORCE(meta,
               "Operator " + op_name + "  not found or does not expose valid metadata.");
           return ReaderMetaToDict(meta);
-        });
+        })
+    .def("reader_state",
+        [](Pipeline* p, const std::string& op_name) {
+          return py::bytes(p->GetReaderState(op_name));
+        })
+    .def("restore_reader_state",
+        [](Pipeline* p, const std::string& op_name, const py::bytes &state) {
+          p->RestoreReaderState(op_name, state);
+        })
+    .def("reshard_reader",
+        [](Pipeline* p, const std::string& op_name, int num_shards, int shard_id,
+           int64_t at_sample) {
+          p->ReshardReader(op_name, num_shards, shard_id, at_sample);
+        },
+        "op_name"_a, "num_shards"_a, "shard_id"_a, "at_sample"_a = -1);
 
 #define DALI_OPSPEC_ADDARG(T) \
     .def("AddArg", \
@@ -2005,6 +2533,7 @@ PYBIND11_MODULE(backend_impl, m) {
     .def("IsDocHidden", &OpSchema::IsDocHidden)
     .def("IsDocPartiallyHidden", &OpSchema::IsDocPartiallyHidden)
     .def("IsNoPrune", &OpSchema::IsNoPrune)
+    .def("IsNondeterministic", &OpSchema::IsNondeterministic)
     .def("IsDeprecated", &OpSchema::IsDeprecated)
     .def("DeprecatedInFavorOf", &OpSchema::DeprecatedInFavorOf)
     .def("DeprecationMessage", &OpSchema::DeprecationMessage)
@@ -568,6 +568,7 @@ class _PipelineDebug(_pipeline.Pipeline):
         self._next_logical_id = 0
         self._seed_upper_bound = (1 << 31) - 1
         self._operators = {}
+        self._external_source_contexts = {}
         self._operators_built = False
         self._cur_iter_batch_info = _IterBatchInfo(-1, None)  # Used for variable batch sizes.
 
@@ -671,11 +672,21 @@ class _PipelineDebug(_pipeline.Pipeline):
         else:
             self._cur_iter_batch_info.check_external_source(len(data.get()), cur_context)
 
+    def _op_key(self, frame):
+        """Identifies the operator by its call site and position in the iteration.
+
+        Reading the frame attributes directly is much faster than ``inspect.getframeinfo``,
+        which looks up the source code on each call."""
+        code = frame.f_code
+        return (code.co_filename, frame.f_lineno, code.co_name, self._cur_operator_id)
+
     def _external_source(self, name=None, **kwargs):
         self._cur_operator_id += 1
         cur_frame = inspect.currentframe().f_back.f_back
-        key = inspect.getframeinfo(cur_frame)[:3] + (self._cur_operator_id, )
+        key = self._op_key(cur_frame)
         if not self._operators_built:
+            self._external_source_contexts[key] = ''.join(
+                traceback.format_stack(cur_frame, limit=1))
             es = _ExternalSourceDebug(batch_size=self._max_batch_size,
                                       device_id=self._device_id, name=name, **kwargs)
 
@@ -687,8 +698,7 @@ class _PipelineDebug(_pipeline.Pipeline):
 
         if key in self._external_sources:
             data = self._external_sources[key]._fetch(self._epoch_idx)
-            self._check_external_source_batch_size(
-                data, ''.join(traceback.format_stack(cur_frame, limit=1)))
+            self._check_external_source_batch_size(data, self._external_source_contexts[key])
             return data
         else:
             raise RuntimeError("Unexpected operator 'ExternalSource'. Debug mode does not support"
@@ -732,9 +742,9 @@ class _PipelineDebug(_pipeline.Pipeline):
     def _wrap_op_call(self, op_class, op_name, *inputs, **kwargs):
         self._cur_operator_id += 1
         cur_frame = inspect.currentframe().f_back.f_back
-        cur_context = ''.join(traceback.format_stack(cur_frame, limit=1))
-        key = inspect.getframeinfo(cur_frame)[:3] + (self._cur_operator_id, )
+        key = self._op_key(cur_frame)
         if not self._operators_built:
+            cur_context = ''.join(traceback.format_stack(cur_frame, limit=1))
             self._create_op(op_class, op_name, key, cur_context, inputs, kwargs)
 
         if key in self._operators:
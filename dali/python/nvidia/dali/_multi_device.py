@@ -0,0 +1,199 @@
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import nvidia.dali.backend as _b
+import nvidia.dali.types as _types
+from nvidia.dali.external_source import _is_external_source
+
+
+def _is_cpu_op(op):
+    return op._op.device == "cpu"
+
+
+def _split_graph(ops, outputs):
+    """Splits the operators into the CPU part and the mixed/GPU part of the graph.
+
+    Returns the CPU operators, the mixed/GPU operators and the names of the CPU tensors
+    passed from the CPU part to the other one (consumed by the mixed/GPU operators or requested
+    as the outputs of the pipeline), in the order of appearance.
+    """
+    cpu_ops = [op for op in ops if _is_cpu_op(op)]
+    device_ops = [op for op in ops if not _is_cpu_op(op)]
+    cut = []
+
+    def add_cut(data_node):
+        if data_node.device == "cpu" and data_node.name not in cut:
+            cut.append(data_node.name)
+
+    for op in device_ops:
+        for inp in op.inputs:
+            for data_node in (inp if isinstance(inp, list) else [inp]):
+                add_cut(data_node)
+    for out in outputs:
+        add_cut(out)
+    return cpu_ops, device_ops, cut
+
+
+def _add_ops(pipe, ops):
+    related_logical_id = {}
+    for op in ops:
+        if op.relation_id not in related_logical_id:
+            related_logical_id[op.relation_id] = pipe.AddOperator(op.spec, op.name)
+        else:
+            pipe.AddOperator(op.spec, op.name, related_logical_id[op.relation_id])
+
+
+class _MultiDeviceBackend(object):
+    """Runs the graph of a Pipeline on multiple GPUs, with a shared CPU stage.
+
+    The CPU operators run once, in a CPU-only backend pipeline, on a batch of
+    ``max_batch_size * len(device_ids)`` samples. The tensors passed to the mixed and GPU
+    operators are split into per-device sub-batches and fed to the per-device backend pipelines,
+    which run the mixed and GPU operators on their own devices and CUDA streams.
+
+    Exposes the same interface as the backend Pipeline, so that the Python Pipeline can use it
+    in place of one. The outputs contain one tuple of `TensorList` objects per device.
+    The remaining methods (reader metadata, executor statistics, etc.) refer to the shared
+    CPU pipeline.
+    """
+
+    def __init__(self, pipeline):
+        self._device_ids = list(pipeline._device_ids)
+        num_devices = len(self._device_ids)
+        for op in pipeline._ops:
+            if _is_external_source(op):
+                raise ValueError(
+                    "ExternalSource is not supported in a pipeline running on multiple devices. "
+                    "The samples must be produced by the operators of the pipeline, e.g. readers.")
+        if pipeline._exec_separated or not (pipeline._exec_pipelined and pipeline._exec_async):
+            raise ValueError(
+                "A pipeline running on multiple devices requires `exec_pipelined` and `exec_async` "
+                "set to True and `prefetch_queue_depth` given as an int.")
+        if pipeline._placement_costs is not None:
+            raise ValueError(
+                "`placement_costs` cannot be used in a pipeline running on multiple devices.")
+        cpu_ops, device_ops, cut = _split_graph(pipeline._ops, pipeline._graph_outputs)
+        if not cut:
+            raise ValueError(
+                "The pipeline has no CPU stage which could be shared by multiple devices.")
+        self._cut = cut
+        # The names of the ExternalSource operators feeding the cut tensors to the device pipelines
+        self._input_names = [f"__MultiDeviceInput_{i}" for i in range(len(cut))]
+
+        self._cpu_pipe = self._create_pipe(pipeline, pipeline._max_batch_size * num_devices,
+                                           _types.CPU_ONLY_DEVICE_ID, pipeline._seed,
+                                           pipeline._cpu_queue_size)
+        if pipeline._bottleneck_analysis_interval is not None:
+            self._cpu_pipe.EnableBottleneckAnalysis(pipeline._bottleneck_analysis_interval)
+        _add_ops(self._cpu_pipe, cpu_ops)
+
+        _b.check_cuda_runtime()
+        self._device_pipes = []
+        for i, device_id in enumerate(self._device_ids):
+            seed = pipeline._seed
+            if seed is not None and seed != -1:
+                seed = seed + 1 + i
+            # the per-device stage runs one iteration ahead of the consumer
+            pipe = self._create_pipe(pipeline, pipeline._max_batch_size, device_id, seed, 2)
+            for name, input_name in zip(cut, self._input_names):
+                spec = _b.OpSpec("ExternalSource")
+                spec.AddArg("device", "cpu")
+                spec.AddOutput(name, "cpu")
+                pipe.AddOperator(spec, input_name)
+            _add_ops(pipe, device_ops)
+            self._device_pipes.append(pipe)
+
+        self._cpu_batches = 0  # the CPU iterations not yet passed to the device pipelines
+        self._device_batches = 0  # the device iterations scheduled, but not returned yet
+
+    @staticmethod
+    def _create_pipe(pipeline, batch_size, device_id, seed, queue_size):
+        pipe = _b.Pipeline(batch_size,
+                           pipeline._num_threads,
+                           device_id,
+                           seed if seed is not None else -1,
+                           True,
+                           queue_size,
+                           True,
+                           pipeline._bytes_per_sample,
+                           pipeline._set_affinity,
+                           pipeline._max_streams,
+                           pipeline._default_cuda_stream_priority)
+        pipe.SetExecutionTypes(True, False, True, pipeline._exec_dataflow, False)
+        pipe.SetQueueSizes(queue_size, queue_size)
+        pipe.EnableExecutorMemoryStats(pipeline._enable_memory_stats)
+        pipe.EnableExecutorTimingStats(pipeline._enable_timing_stats)
+        pipe.SetThreadPoolType(pipeline._thread_pool_type)
+        pipe.SetGPUMultiStream(pipeline._exec_gpu_multistream)
+        pipe.SetGPUGraphCapture(pipeline._exec_cuda_graph)
+        pipe.SetGPUMemoryPlanning(pipeline._exec_memory_planning)
+        pipe.SetGPUMicroBatchSize(pipeline._exec_micro_batch_size)
+        if pipeline._urgent_cuda_stream_priority is not None:
+            pipe.SetUrgentStreamPriority(pipeline._urgent_cuda_stream_priority)
+        return pipe
+
+    def Build(self, build_args):
+        self._cpu_pipe.Build([(name, "cpu", _types.NO_TYPE, -1) for name in self._cut])
+        for pipe in self._device_pipes:
+            pipe.Build(build_args)
+
+    def RunCPU(self):
+        self._cpu_pipe.RunCPU()
+
+    def RunGPU(self):
+        self._cpu_pipe.RunGPU()
+        self._cpu_batches += 1
+
+    def _schedule_devices(self):
+        """Splits the next batch of the CPU stage among the devices and runs their stages."""
+        cut_outputs = self._cpu_pipe.ShareOutputs()
+        num_samples = len(cut_outputs[0])
+        num_devices = len(self._device_pipes)
+        try:
+            for i, pipe in enumerate(self._device_pipes):
+                begin = i * num_samples // num_devices
+                end = (i + 1) * num_samples // num_devices
+                for input_name, tl in zip(self._input_names, cut_outputs):
+                    # copies the samples, so the CPU buffers can be released right away
+                    pipe.SetExternalTensorInput(input_name, [tl[j] for j in range(begin, end)])
+                pipe.RunCPU()
+                pipe.RunGPU()
+        finally:
+            self._cpu_pipe.ReleaseOutputs()
+        self._cpu_batches -= 1
+        self._device_batches += 1
+
+    def ShareOutputs(self, cuda_stream=None):
+        if self._device_batches == 0:
+            self._schedule_devices()
+        outputs = tuple(pipe.ShareOutputs(cuda_stream) for pipe in self._device_pipes)
+        self._device_batches -= 1
+        # let the devices compute the next iteration while this one is consumed
+        if self._cpu_batches > 0:
+            self._schedule_devices()
+        return outputs
+
+    def ReleaseOutputs(self, cuda_stream=None):
+        for pipe in self._device_pipes:
+            pipe.ReleaseOutputs(cuda_stream)
+
+    def Outputs(self):
+        self.ReleaseOutputs()
+        return self.ShareOutputs()
+
+    def device_pipelines(self):
+        return self._device_pipes
+
+    def __getattr__(self, name):
+        return getattr(self._cpu_pipe, name)
@@ -1,4 +1,4 @@
-# Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -15,6 +15,7 @@
 import os
 from nvidia.dali._multiproc import shared_mem
 from nvidia.dali._multiproc.messages import ShmMessageDesc
+from nvidia.dali._multiproc.struct_message import Structure
 from nvidia.dali._utils.external_source_impl import \
         assert_cpu_sample_data_type as _assert_cpu_sample_data_type, \
         sample_to_numpy as _sample_to_numpy
@@ -22,6 +23,9 @@ import pickle
 
 
 np = None
+# describes an array in the binary batch meta data, see `BatchMetaHeader`
+_array_meta_dtype_desc = [('offset', '<u8'), ('ndim', '<u4'), ('dtype', 'S16')]
+_array_meta_dtype = None
 
 
 def _div_ceil(a, b):
@@ -36,12 +40,14 @@ def _align_up(x, alignment):
 
 def import_numpy():
     global np
+    global _array_meta_dtype
     if np is None:
         try:
             import numpy as np
         except ImportError:
             raise RuntimeError('Could not import numpy. Please make sure you have numpy '
                                'installed before you use parallel mode.')
+        _array_meta_dtype = np.dtype(_array_meta_dtype_desc)
 
 
 _sample_error_msg = (
@@ -106,7 +112,8 @@ class BufShmChunk:
 class SampleMeta:
     """Metadata describing serialized sample in a memory buffer.
 
-    It is passed through memory, stored after sample it describes."""
+    Used for the samples with nesting that cannot be described by the binary `BatchMetaHeader`,
+    the list of `SampleMeta` is pickled and stored after the batch it describes."""
 
     def __init__(self, offset, shape, dtype, nbytes):
         self.shape = shape
@@ -119,17 +126,32 @@ class SampleMeta:
         return cls(offset, np_array.shape, np_array.dtype, np_array.nbytes)
 
 
+class BatchMetaHeader(Structure):
+    """Header of the binary batch meta data. It is followed by `num_arrays` records of
+    `_array_meta_dtype` (sample-major order of the arrays) and by the `shapes_len` extents
+    (int64) of the concatenated shapes of the arrays.
+
+    `sample_kind` is one of `SAMPLE_ARRAY`, `SAMPLE_TUPLE`, `SAMPLE_LIST`, in the latter two
+    cases every sample consists of `num_outputs` arrays."""
+    _fields = (("sample_kind", "i"), ("num_outputs", "i"), ("num_arrays", "Q"), ("shapes_len", "Q"))
+
+    SAMPLE_ARRAY = 0
+    SAMPLE_TUPLE = 1
+    SAMPLE_LIST = 2
+
+
 class SharedBatchMeta:
-    """Describes offset within shared memory chunk and size of serialized list of
-       `SampleMeta` instances"""
+    """Describes offset within shared memory chunk and size of the serialized batch meta data,
+       which is either binary (`BatchMetaHeader`) or a pickled list of `SampleMeta` instances"""
 
-    def __init__(self, meta_offset, meta_size):
+    def __init__(self, meta_offset, meta_size, binary=False):
         self.meta_offset = meta_offset
         self.meta_size = meta_size
+        self.binary = binary
 
     @classmethod
     def from_writer(cls, writer):
-        return cls(writer.data_size, writer.meta_data_size)
+        return cls(writer.data_size, writer.meta_data_size, writer.binary_meta)
 
 
 def deserialize_sample(buffer: BufShmChunk, sample):
@@ -154,8 +176,39 @@ def deserialize_sample_meta(buffer: BufShmChunk, shared_batch_meta: SharedBatchM
     return samples_meta
 
 
+def _deserialize_binary_batch(buffer: BufShmChunk, shared_batch_meta: SharedBatchMeta):
+    sbm = shared_batch_meta
+    meta_buf = buffer.buf[sbm.meta_offset:sbm.meta_offset + sbm.meta_size]
+    header = BatchMetaHeader().unpack_from(meta_buf, 0)
+    records_offset = header.get_size()
+    records = np.frombuffer(meta_buf, dtype=_array_meta_dtype, count=header.num_arrays,
+                            offset=records_offset)
+    shapes = []
+    if header.shapes_len > 0:
+        shapes = np.frombuffer(meta_buf, dtype=np.int64, count=header.shapes_len,
+                               offset=records_offset + records.nbytes).tolist()
+    data = buffer.buf
+    dtypes = {}
+    arrays = []
+    shape_start = 0
+    for offset, ndim, dtype_str in records.tolist():
+        dtype = dtypes.get(dtype_str)
+        if dtype is None:
+            dtype = dtypes[dtype_str] = np.dtype(dtype_str.decode())
+        shape = shapes[shape_start:shape_start + ndim]
+        shape_start += ndim
+        arrays.append(np.ndarray(shape, dtype=dtype, buffer=data, offset=offset))
+    if header.sample_kind == BatchMetaHeader.SAMPLE_ARRAY:
+        return arrays
+    sample_type = tuple if header.sample_kind == BatchMetaHeader.SAMPLE_TUPLE else list
+    num_outputs = header.num_outputs
+    return [sample_type(arrays[i:i + num_outputs]) for i in range(0, len(arrays), num_outputs)]
+
+
 def deserialize_batch(buffer: BufShmChunk, shared_batch_meta: SharedBatchMeta):
-    """Deserialize samples from the smem buffer and SampleMeta descriptions.
+    """Deserialize samples from the smem buffer and the batch meta data.
+
+    The arrays are views of the shared memory chunk, no data is copied.
 
     Parameters
     ----------
@@ -169,6 +222,10 @@ def deserialize_batch(buffer: BufShmChunk, shared_batch_meta: SharedBatchMeta):
     List of (idx, numpy array) or (idx, tuple of numpy arrays)
         List of indexed deserialized samples
     """
+    if shared_batch_meta.meta_size == 0:
+        return []
+    if shared_batch_meta.binary:
+        return _deserialize_binary_batch(buffer, shared_batch_meta)
     samples = deserialize_sample_meta(buffer, shared_batch_meta)
     return [deserialize_sample(buffer, sample) for sample in samples]
 
@@ -204,6 +261,30 @@ def _apply_to_sample(func, sample, *args, nest_with_sample=0):
         return func(sample, *args)
 
 
+def _sample_layout(batch):
+    """Returns (sample_kind, num_outputs) of the batch if its samples can be described
+    by the `BatchMetaHeader`, i.e. all of them are arrays or all of them are tuples (lists)
+    of the same number of arrays. Returns None otherwise."""
+    first = batch[0]
+    if isinstance(first, np.ndarray):
+        if all(isinstance(sample, np.ndarray) for sample in batch):
+            return BatchMetaHeader.SAMPLE_ARRAY, 0
+        return None
+    if not isinstance(first, (tuple, list)):
+        return None
+    sample_type = type(first)
+    num_outputs = len(first)
+    if num_outputs == 0:
+        return None
+    for sample in batch:
+        if type(sample) is not sample_type or len(sample) != num_outputs:
+            return None
+        if not all(isinstance(part, np.ndarray) for part in sample):
+            return None
+    kind = BatchMetaHeader.SAMPLE_TUPLE if sample_type is tuple else BatchMetaHeader.SAMPLE_LIST
+    return kind, num_outputs
+
+
 class SharedBatchWriter:
     """SharedBatchWriter can serialize and write batch into given shared
     memory chunk (``shm_chunk``).
@@ -218,6 +299,7 @@ class SharedBatchWriter:
         self.data_size = 0
         self.meta_data_size = 0
         self.total_size = 0
+        self.binary_meta = False
         # hint how much space should be left in case of the resize at the end of the shm chunk
         # after batch data to accommodate meta data of the task
         self.min_trailing_offset = min_trailing_offset
@@ -236,10 +318,29 @@ class SharedBatchWriter:
         meta = [_apply_to_sample(make_meta, sample) for sample in samples]
         return meta, data_size
 
-    def _add_array_to_batch(self, np_array, meta, memview):
-        sample_size = meta.nbytes
-        offset = meta.offset
-        buffer = memview[offset:(offset + sample_size)]
+    def _prepare_binary_meta(self, arrays, sample_kind, num_outputs):
+        """Calculate the offsets of the `arrays` and serialize the binary meta data"""
+        offsets = []
+        data_size = 0
+        for array in arrays:
+            offset = _align_up(data_size, self.SAMPLE_ALIGNMENT)
+            offsets.append(offset)
+            data_size = offset + array.nbytes
+        records = np.empty(len(arrays), dtype=_array_meta_dtype)
+        records['offset'] = offsets
+        records['ndim'] = [array.ndim for array in arrays]
+        records['dtype'] = [array.dtype.str.encode() for array in arrays]
+        shapes = np.array([extent for array in arrays for extent in array.shape], dtype=np.int64)
+        header = BatchMetaHeader(sample_kind, num_outputs, len(arrays), len(shapes))
+        serialized_meta = bytearray(header.get_size())
+        header.pack_into(serialized_meta, 0)
+        serialized_meta += records.tobytes()
+        serialized_meta += shapes.tobytes()
+        return serialized_meta, offsets, data_size
+
+    @staticmethod
+    def _add_array_to_batch(np_array, offset, memview):
+        buffer = memview[offset:(offset + np_array.nbytes)]
         shared_array = np.ndarray(
             np_array.shape, dtype=np_array.dtype, buffer=buffer)
         shared_array.ravel()[:] = np_array.ravel()[:]
@@ -249,17 +350,35 @@ class SharedBatchWriter:
             return
         batch = [_apply_to_sample(lambda x: _sample_to_numpy(x, _sample_error_msg), sample)
                  for sample in batch]
-        meta, data_size = self._prepare_samples_meta(batch)
-        serialized_meta = pickle.dumps(meta)
+        layout = _sample_layout(batch)
+        if layout is not None:
+            sample_kind, _ = layout
+            if sample_kind == BatchMetaHeader.SAMPLE_ARRAY:
+                arrays = batch
+            else:
+                arrays = [array for sample in batch for array in sample]
+            serialized_meta, offsets, data_size = self._prepare_binary_meta(arrays, *layout)
+            self.binary_meta = True
+        else:
+            meta, data_size = self._prepare_samples_meta(batch)
+            serialized_meta = pickle.dumps(meta)
+            arrays = []
+            offsets = []
+
+            def collect(np_array, sample_meta):
+                arrays.append(np_array)
+                offsets.append(sample_meta.offset)
+
+            for sample, sample_meta in zip(batch, meta):
+                _apply_to_sample(collect, sample, sample_meta, nest_with_sample=1)
         self.meta_data_size = len(serialized_meta)
         self.data_size = _align_up(data_size, self.SAMPLE_ALIGNMENT)
         self.total_size = _align_up(self.data_size + self.meta_data_size, self.SAMPLE_ALIGNMENT)
         if self.shm_chunk.capacity < self.total_size:
             resize_shm_chunk(self.shm_chunk, self.total_size + self.min_trailing_offset)
         memview = self.shm_chunk.buf
-        for sample, sample_meta in zip(batch, meta):
-            _apply_to_sample(self._add_array_to_batch, sample, sample_meta, memview,
-                             nest_with_sample=1)
+        for array, offset in zip(arrays, offsets):
+            self._add_array_to_batch(array, offset, memview)
         # copy meta data at the end of shared memory chunk
         buffer = memview[self.data_size:(self.data_size + self.meta_data_size)]
         buffer[:] = serialized_meta
@@ -89,8 +89,10 @@ class SharedBatchDispatcher(Dispatcher):
         1. Binary encoded samples from the batch (underlying data of numpy arrays),
            aimed to be used as initialization buffers for arrays with no additional copy
            or deserialization.
-        2. Pickled list of meta-data of each sample, such as the sample's binary data offset in
-           the chunk, a shape and a type of the array.
+        2. Meta-data of the samples, such as the sample's binary data offset in the chunk,
+           a shape and a type of the array. It is a binary `BatchMetaHeader` followed by
+           the arrays' descriptions, unless the nesting of the samples is irregular - then it is
+           a pickled list of `SampleMeta`.
         3. Pickled CompletedTask instance (that contains offset and size of the serialized list
            from the second point).
         Returns `ShmMessageDesc` instance, that describes shared memory chunk and placement
@@ -39,6 +39,8 @@ _stateful_operators = {
     'ROIRandomCrop',
     'RandomBBoxCrop',
     'RandomResizedCrop',
+    'experimental__RandomResizedCropMirrorNormalize',
+    'experimental__RandomResizedMultiCrop',
     'ResizeCropMirror',
     'random__CoinFlip',
     'random__Normal',
@@ -73,6 +75,9 @@ _excluded_operators = {
     'DLTensorPythonFunction',
     'TorchPythonFunction',
     'NumbaFunction',
+    'experimental__CacheLookup',
+    'experimental__CacheFetch',
+    'experimental__CacheStore',
 }
 
 
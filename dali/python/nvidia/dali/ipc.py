@@ -0,0 +1,344 @@
+# Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Sharing the outputs of a pipeline with other processes on the same GPU.
+
+An :class:`OutputExporter` runs a pipeline in a data loading process and serves its outputs to
+:class:`OutputImporter` objects in other processes (e.g. the training processes sharing the GPU
+or its MIG slices), connected through a Unix socket. The GPU outputs are stored in device memory
+allocated with the CUDA virtual memory management API, which the consumers map into their
+address space, so they read the outputs without copying them. The readiness of the data and
+the end of its use by the consumers are signalled with CUDA IPC events.
+"""
+
+import ctypes
+import os
+import select
+import socket
+from multiprocessing import reduction
+
+import nvidia.dali.backend as _b
+import nvidia.dali.types as _types
+from nvidia.dali.remote import _recv_batch, _recv_json, _send_batch, _send_json
+
+_STREAM = 0  # the legacy default stream
+
+
+class _Slot:
+    """A set of buffers holding the GPU outputs of one iteration."""
+
+    def __init__(self, index, device_id):
+        self.index = index
+        self.event = _b.IpcEvent.create(device_id)  # recorded after the outputs are copied
+        self.buffers = []  # (id, IpcDeviceBuffer) per GPU output
+        self.owner = None  # the connection the slot is lent to
+        self.release_event = None  # recorded by the consumer after its last use of the slot
+        self.consumers = set()  # the connections which know the event of the slot
+
+
+class OutputExporter:
+    """Serves the outputs of a pipeline to :class:`OutputImporter` objects in other processes.
+
+    Each request of a consumer is served with the next iteration of the pipeline, so the
+    consumers share the stream of batches (e.g. like the ranks of data-parallel training).
+    The GPU outputs are copied on the GPU to one of `num_slots` sets of exportable buffers
+    and the consumers use them in place; the CPU outputs are sent through the socket.
+    A slot is reused after the consumer releases it and the work it scheduled on the data
+    is complete, so `num_slots` should exceed the number of the consumers.
+
+    Parameters
+    ----------
+    pipeline : Pipeline
+        A built pipeline, running on a single GPU. It's run with :meth:`Pipeline.schedule_run`,
+        :meth:`Pipeline.share_outputs` and :meth:`Pipeline.release_outputs`.
+    address : str
+        The path of the Unix socket to listen on.
+    num_slots : int, optional, default = 4
+        The number of the iterations which can be held by the consumers at the same time.
+    """
+
+    def __init__(self, pipeline, address, num_slots=4):
+        if not isinstance(pipeline.device_id, int):
+            raise ValueError("The outputs can only be exported from a pipeline running on "
+                             "a single GPU.")
+        if num_slots < 1:
+            raise ValueError(f"`num_slots` must be positive. Got: {num_slots}.")
+        self._pipe = pipeline
+        self._device_id = pipeline.device_id
+        self._slots = [_Slot(i, self._device_id) for i in range(num_slots)]
+        self._next_buffer_id = 0
+        self._sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self._sock.bind(address)
+        self._sock.listen()
+        self._address = address
+        self._conns = []
+        self._known = {}  # the ids of the buffers imported by each connection
+        self._pending = []  # the connections waiting for a free slot
+        self._scheduled = False
+        self._closed = False
+
+    def serve(self):
+        """Serves the consumers until :meth:`close` is called."""
+        if not self._scheduled:
+            self._pipe.schedule_run()
+            self._scheduled = True
+        while not self._closed:
+            try:
+                ready, _, _ = select.select([self._sock] + self._conns, [], [])
+            except (OSError, ValueError):
+                if self._closed:
+                    break
+                raise
+            for conn in ready:
+                if conn is self._sock:
+                    try:
+                        new_conn, _ = self._sock.accept()
+                    except OSError:
+                        break
+                    self._conns.append(new_conn)
+                    self._known[new_conn] = set()
+                else:
+                    self._handle_request(conn)
+            self._serve_pending()
+
+    def close(self):
+        """Stops serving and closes the connections."""
+        self._closed = True
+        for conn in self._conns:
+            conn.close()
+        self._conns = []
+        try:
+            self._sock.shutdown(socket.SHUT_RDWR)
+        except OSError:
+            pass
+        self._sock.close()
+        if os.path.exists(self._address):
+            os.unlink(self._address)
+
+    def _disconnect(self, conn):
+        self._conns.remove(conn)
+        del self._known[conn]
+        self._pending = [c for c in self._pending if c is not conn]
+        for slot in self._slots:
+            slot.consumers.discard(conn)
+            if slot.owner is conn:
+                slot.owner = None
+                slot.release_event = None
+        conn.close()
+
+    def _handle_request(self, conn):
+        try:
+            request = _recv_json(conn)
+        except (ConnectionError, OSError, ValueError):
+            self._disconnect(conn)
+            return
+        for release in request.get("release", []):
+            slot = self._slots[release["slot"]]
+            if slot.owner is not conn:
+                continue
+            slot.owner = None
+            event = release.get("event")
+            slot.release_event = (_b.IpcEvent.open(bytes.fromhex(event), self._device_id)
+                                  if event is not None else None)
+        if request.get("next"):
+            self._pending.append(conn)
+
+    def _serve_pending(self):
+        while self._pending:
+            slot = next((s for s in self._slots if s.owner is None), None)
+            if slot is None:
+                return
+            conn = self._pending.pop(0)
+            try:
+                self._send_iteration(conn, slot)
+            except (ConnectionError, OSError):
+                self._disconnect(conn)
+
+    def _buffer(self, slot, i, size):
+        if i < len(slot.buffers) and slot.buffers[i][1].size >= size:
+            return slot.buffers[i]
+        if i < len(slot.buffers):
+            # the buffer is unmapped when it's dropped, so the last copy to it must be complete
+            slot.event.synchronize()
+        # leave some room for the samples to grow
+        buffer = (self._next_buffer_id, _b.IpcDeviceBuffer.create(size + size // 4,
+                                                                  self._device_id))
+        self._next_buffer_id += 1
+        if i < len(slot.buffers):
+            slot.buffers[i] = buffer
+        else:
+            slot.buffers.append(buffer)
+        return buffer
+
+    def _send_iteration(self, conn, slot):
+        try:
+            outputs = self._pipe.share_outputs(cuda_stream=_STREAM)
+        except Exception as e:
+            _send_json(conn, {"error": str(e)})
+            return
+        try:
+            if slot.release_event is not None:
+                # don't overwrite the data before the consumer is done with it
+                slot.release_event.wait(_STREAM)
+                slot.release_event = None
+            descs = []
+            cpu_outputs = []
+            num_gpu = 0
+            for out in outputs:
+                if isinstance(out, _b.TensorListGPU):
+                    size = _b.IpcBatchBytes(out)
+                    buffer_id, buffer = self._buffer(slot, num_gpu, size)
+                    num_gpu += 1
+                    buffer.copy_from(0, out, _STREAM)
+                    descs.append({"device": "gpu",
+                                  "buffer": buffer_id,
+                                  "shapes": [list(s) for s in out.shape()],
+                                  "dtype": int(out.dtype),
+                                  "layout": out.layout()})
+                else:
+                    descs.append({"device": "cpu"})
+                    cpu_outputs.append(out)
+            slot.event.record(_STREAM)
+        finally:
+            self._pipe.release_outputs(cuda_stream=_STREAM)
+        self._pipe.schedule_run()
+
+        slot.owner = conn
+        # the consumer imports the buffers it hasn't seen yet and drops the replaced ones
+        buffers = {i: b for s in self._slots for i, b in s.buffers}
+        known = self._known[conn]
+        new_buffers = [(i, b) for i, b in slot.buffers if i not in known]
+        retired = [i for i in known if i not in buffers]
+        known.difference_update(retired)
+        known.update(i for i, _ in new_buffers)
+        event = None
+        if conn not in slot.consumers:
+            slot.consumers.add(conn)
+            event = slot.event.handle().hex()
+        _send_json(conn, {"slot": slot.index,
+                          "event": event,
+                          "outputs": descs,
+                          "buffers": [{"id": i, "size": b.size} for i, b in new_buffers],
+                          "retired": retired})
+        for _, buffer in new_buffers:
+            fd = buffer.export_fd()
+            try:
+                reduction.send_handle(conn, fd, os.getpid())
+            finally:
+                os.close(fd)
+        if cpu_outputs:
+            _send_batch(conn, cpu_outputs)
+
+
+class OutputImporter:
+    """Receives the outputs of a pipeline served by an :class:`OutputExporter` in another
+    process on the same GPU.
+
+    The GPU outputs are returned as :class:`TensorListGPU` objects which are views of the memory
+    of the exporting process. They remain valid until the next call to :meth:`next` or
+    :meth:`release`.
+
+    Parameters
+    ----------
+    address : str
+        The path of the Unix socket of the exporter.
+    device_id : int, optional, default = None
+        The GPU of the exporter; the current device if not set.
+    """
+
+    def __init__(self, address, device_id=None):
+        self._device_id = -1 if device_id is None else device_id
+        self._sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self._sock.connect(address)
+        self._buffers = {}
+        self._slot_events = {}  # the events recorded by the exporter, per slot
+        self._release_events = {}  # the events recorded by this process, per slot
+        self._held = None  # the slot and the stream of the outputs returned last
+
+    def _release_request(self):
+        if self._held is None:
+            return []
+        slot, cuda_stream = self._held
+        self._held = None
+        event = self._release_events.get(slot)
+        handle = None
+        if event is None:
+            event = _b.IpcEvent.create(self._device_id)
+            self._release_events[slot] = event
+            handle = event.handle().hex()
+        event.record(cuda_stream)
+        return [{"slot": slot, "event": handle}]
+
+    def release(self):
+        """Returns the outputs obtained with the last call to :meth:`next` to the exporter."""
+        release = self._release_request()
+        if release:
+            _send_json(self._sock, {"release": release})
+
+    def next(self, cuda_stream=None):
+        """Returns the outputs of the next iteration of the pipeline.
+
+        Releases the outputs returned by the previous call.
+
+        Parameters
+        ----------
+        cuda_stream : optional, ``cudaStream_t`` or an object convertible to ``cudaStream_t``
+            The stream on which the outputs are used; the legacy default stream if not set.
+            The GPU outputs are ready for the work scheduled on it after the call and
+            the exporter doesn't overwrite them before the work scheduled on it until the outputs
+            are released is complete.
+        """
+        raw_stream = _types._raw_cuda_stream(cuda_stream)
+        stream = ctypes.c_void_p(raw_stream if raw_stream is not None else _STREAM)
+        _send_json(self._sock, {"release": self._release_request(), "next": True})
+        reply = _recv_json(self._sock)
+        if "error" in reply:
+            raise RuntimeError(f"The exporting pipeline failed: {reply['error']}")
+        for buffer_id in reply["retired"]:
+            self._buffers.pop(buffer_id, None)
+        for buffer in reply["buffers"]:
+            fd = reduction.recv_handle(self._sock)
+            try:
+                self._buffers[buffer["id"]] = _b.IpcDeviceBuffer.import_fd(fd, buffer["size"],
+                                                                           self._device_id)
+            finally:
+                os.close(fd)
+        slot = reply["slot"]
+        if reply["event"] is not None:
+            self._slot_events[slot] = _b.IpcEvent.open(bytes.fromhex(reply["event"]),
+                                                       self._device_id)
+        self._slot_events[slot].wait(stream)
+        self._held = (slot, stream)
+        descs = reply["outputs"]
+        cpu_outputs = iter(_recv_batch(self._sock) if any(d["device"] == "cpu" for d in descs)
+                           else [])
+        outputs = []
+        for desc in descs:
+            if desc["device"] == "gpu":
+                buffer = self._buffers[desc["buffer"]]
+                outputs.append(buffer.as_tensor_list(0, desc["shapes"],
+                                                     _types.DALIDataType(desc["dtype"]),
+                                                     desc["layout"], stream))
+            else:
+                samples = next(cpu_outputs)
+                outputs.append(_b.TensorListCPU(samples, samples[0].layout() if samples else ""))
+        return outputs
+
+    def close(self):
+        """Releases the outputs and closes the connection."""
+        try:
+            self.release()
+        except OSError:
+            pass
+        self._sock.close()
@@ -807,15 +807,52 @@ def Reload():
     _load_ops()
 
 
+# (module name, attribute name) -> schema name of an operator from a deferred library
+_deferred_attrs = {}
+
+
+def _deferred_getattr(module):
+    """Creates the module's ``__getattr__``, which loads the deferred library providing
+    the missing attribute and wraps its operators."""
+    def __getattr__(name):
+        op_reg_name = _deferred_attrs.get((module.__name__, name))
+        if op_reg_name is not None and _b.LoadDeferredLibrary(op_reg_name):
+            Reload()
+        if name in module.__dict__:
+            return module.__dict__[name]
+        raise AttributeError(f"module '{module.__name__}' has no attribute '{name}'")
+
+    return __getattr__
+
+
+def _add_deferred_ops(op_reg_names):
+    """Makes the operators of a deferred library available as ``ops`` classes and ``fn``
+    functions; the library is loaded when one of them is first accessed."""
+    ops_module = sys.modules[__name__]
+    fn_module = sys.modules[_functional.__name__]
+    for op_reg_name in op_reg_names:
+        _, submodule, op_name = _process_op_name(op_reg_name)
+        for root, attr in ((ops_module, op_name),
+                           (fn_module, _functional._to_snake_case(op_name))):
+            module = _internal.get_submodule(root, submodule)
+            _deferred_attrs[(module.__name__, attr)] = op_reg_name
+            if '__getattr__' not in module.__dict__:
+                module.__getattr__ = _deferred_getattr(module)
+
+
 class _TFRecordReaderImpl():
     """ custom wrappers around ops """
 
-    def __init__(self, path, index_path, features, **kwargs):
+    def __init__(self, path, index_path=None, features=None, **kwargs):
+        if features is None:
+            raise TypeError("The `features` argument is required.")
         if isinstance(path, list):
             self._path = path
         else:
             self._path = [path]
-        if isinstance(index_path, list):
+        if index_path is None:
+            self._index_path = []
+        elif isinstance(index_path, list):
             self._index_path = index_path
         else:
             self._index_path = [index_path]
@@ -984,6 +1021,18 @@ def _dlpack_from_array(array):
     return nvidia.dali.python_function_plugin.ArrayToDLTensor(array)
 
 
+def _dlpack_from_gpu_array(array, to_dlpack):
+    """Exports a GPU array to DLPack, so that it can be consumed on DALI's stream.
+
+    With the stream-aware ``__dlpack__`` protocol, the producer orders DALI's stream after the
+    pending work on the array (e.g. issued on another stream), without a host synchronization.
+    """
+    stream = nvidia.dali.python_function_plugin.current_dali_stream()
+    if stream and hasattr(array, "__dlpack__"):
+        return array.__dlpack__(stream=stream)
+    return to_dlpack(array)
+
+
 class PythonFunction(PythonFunctionBase):
     schema_name = "PythonFunction"
     global _cpu_ops
@@ -1070,13 +1119,15 @@ class PythonFunction(PythonFunctionBase):
         def wrapped_func(*inputs):
             return PythonFunction._cupy_stream_wrapper(function, *inputs)
 
+        def to_dlpack(t):
+            return _dlpack_from_gpu_array(t, lambda x: x.toDlpack())
+
         if batch_processing:
             return PythonFunction.function_wrapper_batch(wrapped_func, num_outputs, cupy.fromDlpack,
-                                                         lambda t: t.toDlpack(), *dlpack_inputs)
+                                                         to_dlpack, *dlpack_inputs)
         else:
             return PythonFunction.function_wrapper_per_sample(wrapped_func, num_outputs,
-                                                              cupy.fromDlpack,
-                                                              lambda t: t.toDlpack(),
+                                                              cupy.fromDlpack, to_dlpack,
                                                               *dlpack_inputs)
 
     def __init__(self, function, num_outputs=1, device='cpu', batch_processing=False, **kwargs):
@@ -1306,28 +1357,107 @@ def _generate_input_desc(categories_idx, integers, reals):
     return input_desc
 
 
+# The arithmetic operators applied to the results of other arithmetic operators are fused into
+# one ArithmeticGenericOp, evaluating the whole expression, up to this number of function nodes.
+_max_fused_arithm_nodes = 16
+
+
+class _ArithmExpr:
+    """
+    Expression evaluated by ArithmeticGenericOp - the function `name` applied to `args`,
+    which are the input edges, constants or nested expressions.
+    """
+
+    def __init__(self, name, args):
+        self.name = name
+        self.args = args
+        self.num_nodes = 1 + sum(arg.num_nodes for arg in args if isinstance(arg, _ArithmExpr))
+
+
+def _is_same_edge(edge, other):
+    return edge.name == other.name and edge.device == other.device
+
+
+def _fusable_arithm_expr(edge, dev, edges):
+    """
+    Return the expression of the arithmetic operator producing the `edge`, if it can be
+    evaluated as a part of the expression consuming it, otherwise None.
+    The edges used more than once are not inlined, as that would evaluate them repeatedly.
+    """
+    expr = getattr(edge.source, "_arithm_expr", None)
+    if expr is None or edge.source._arithm_device != dev:
+        return None
+    if sum(_is_same_edge(edge, other) for other in edges) > 1:
+        return None
+    return expr
+
+
+def _generate_expr_desc(expr, edges, integers, reals):
+    """
+    Generate the expression_desc for ArithmeticGenericOp, collecting the inputs and constants
+    of the expression.
+    """
+    input_descs = []
+    for arg in expr.args:
+        if isinstance(arg, _ArithmExpr):
+            input_descs.append(_generate_expr_desc(arg, edges, integers, reals))
+        elif isinstance(arg, _DataNode):
+            idx = next((i for i, edge in enumerate(edges) if _is_same_edge(edge, arg)), None)
+            if idx is None:
+                idx = len(edges)
+                edges.append(arg)
+            input_descs.append("&{}".format(idx))
+        elif _is_integer_like(arg):
+            input_descs.append("${}:{}".format(len(integers), _to_type_desc(arg)))
+            integers.append(arg)
+        else:
+            input_descs.append("${}:{}".format(len(reals), _to_type_desc(arg)))
+            reals.append(arg)
+    return "{}({})".format(expr.name, " ".join(input_descs))
+
+
 def _arithm_op(name, *inputs):
     """
     Create arguments for ArithmeticGenericOp and call it with supplied inputs.
     Select the `gpu` device if at least one of the inputs is `gpu`, otherwise `cpu`.
+
+    The inputs produced by other arithmetic operators on the same device are replaced with
+    their expressions, so that the whole expression is evaluated at once, without
+    the intermediate results being stored in memory.
     """
     categories_idxs, edges, integers, reals = _group_inputs(inputs)
-    input_desc = _generate_input_desc(categories_idxs, integers, reals)
-    expression_desc = "{}({})".format(name, input_desc)
     dev = _choose_device(edges)
+    # If we are on gpu, we must mark all inputs as gpu
+    if dev == "gpu":
+        edges = list(edge.gpu() for edge in edges)
+    args = []
+    num_nodes = 1
+    for category, idx in categories_idxs:
+        if category == "edge":
+            arg = edges[idx]
+            expr = _fusable_arithm_expr(arg, dev, edges)
+            if expr is not None and num_nodes + expr.num_nodes <= _max_fused_arithm_nodes:
+                arg = expr
+                num_nodes += expr.num_nodes
+        elif category == "integer":
+            arg = integers[idx]
+        else:
+            arg = reals[idx]
+        args.append(arg)
+    expr = _ArithmExpr(name, args)
+    dev_inputs, integers, reals = [], [], []
+    expression_desc = _generate_expr_desc(expr, dev_inputs, integers, reals)
     # Create "instance" of operator
     op = ArithmeticGenericOp(       # noqa: F821
         device=dev,
         expression_desc=expression_desc,
-        integer_constants=integers,
-        real_constants=reals)
-    # If we are on gpu, we must mark all inputs as gpu
-    if dev == "gpu":
-        dev_inputs = list(edge.gpu() for edge in edges)
-    else:
-        dev_inputs = edges
+        integer_constants=integers or None,
+        real_constants=reals or None)
     # Call it immediately
-    return op(*dev_inputs)
+    result = op(*dev_inputs)
+    result.source._arithm_expr = expr
+    result.source._arithm_device = dev
+    return result
 
 
 def cpu_ops():
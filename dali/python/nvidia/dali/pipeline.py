@@ -63,10 +63,29 @@ Parameters
     Negative values for this parameter are invalid - the default
     value may only be used with serialized pipeline (the value
     stored in serialized pipeline is used instead).
-`device_id` : int, optional, default = -1
+`device_id` : int or list of int, optional, default = -1
     Id of GPU used by the pipeline.
     A None value for this parameter means that DALI should not use GPU nor CUDA runtime.
     This limits the pipeline to only CPU operators but allows it to run on any CPU capable machine.
+
+    If a list of ids is given, the pipeline drives all these GPUs with a single, shared CPU stage.
+    The CPU operators (e.g. the readers) run once per iteration, on a batch of
+    ``batch_size * len(device_id)`` samples, which is then split into per-GPU sub-batches
+    of ``batch_size`` samples. The mixed and GPU operators run separately on each GPU, on its
+    own CUDA streams. The outputs of the pipeline are returned as a tuple with one list of
+    outputs per GPU, in the order of `device_id`. ``ExternalSource`` and `placement_costs`
+    are not supported in this mode.
+`remote_workers` : list of str or list of (str, int), optional, default = None
+    Addresses (``"host:port"`` or ``(host, port)``) of :class:`nvidia.dali.remote.RemoteWorker`
+    processes which run the CPU stage of the pipeline (the readers and the CPU operators) in
+    place of this process - e.g. on CPU-only machines, when the CPU stage of the GPU node is
+    the bottleneck. The CPU stage is serialized and sent to the workers when the pipeline is
+    built; the tensors consumed by the mixed and GPU operators (or returned by the pipeline)
+    are streamed back over TCP. The workers take turns in producing the batches and each of them
+    reads its part of the shard of the readers. Each worker sends at most
+    `prefetch_queue_depth` batches ahead of the ones consumed by this pipeline.
+    ``ExternalSource`` and `placement_costs` are not supported in this mode and `device_id`
+    must be a single GPU.
 `seed` : int, optional, default = -1
     Seed used for random number generation. Leaving the default value
     for this parameter results in random seed.
@@ -101,13 +120,90 @@ Parameters
 `max_streams` : int, optional, default = -1
     Limit the number of CUDA streams used by the executor.
     Value of -1 does not impose a limit.
-    This parameter is currently unused (and behavior of
-    unrestricted number of streams is assumed).
+    Currently it only limits the number of streams used with `exec_gpu_multistream`.
 `default_cuda_stream_priority` : int, optional, default = 0
     CUDA stream priority used by DALI. See `cudaStreamCreateWithPriority` in CUDA documentation
+`urgent_cuda_stream_priority` : int, optional, default = None
+    CUDA stream priority of the iterations of the mixed and GPU stages that the consumer waits
+    for, i.e. the ones issued when there are no ready outputs in the prefetch queue. The
+    iterations prefetched ahead use `default_cuda_stream_priority`, so that they compete less
+    with the GPU work of the consumer (e.g. the training step). Lower numbers mean higher
+    priority. If None, all the iterations use `default_cuda_stream_priority`.
 `enable_memory_stats`: bool, optional, default = 1
     If DALI should print operator output buffer statistics.
     Usefull for `bytes_per_sample_hint` operator parameter.
+`enable_timing_stats`: bool, optional, default = False
+    If DALI should gather the execution time statistics of the operators and the executor stages.
+    See :meth:`executor_statistics` and :meth:`executor_stage_statistics`.
+`bottleneck_analysis_interval`: float, optional, default = None
+    If set, the executor finds the part of the pipeline which limits the throughput, updating
+    the verdict at most once per this many seconds. Enables the gathering of the timing
+    statistics. See :meth:`bottleneck_report`.
+`placement_costs`: dict, optional, default = None
+    If set, the CPU operators are moved to the GPU when the pipeline is built, where it's
+    estimated to shorten the longer of the CPU and the GPU stage. Only the operators with a GPU
+    implementation, whose outputs are consumed only on the GPU, can be moved; the copies to
+    the GPU are inserted where the data crosses to the GPU. The costs of the operators are usually
+    obtained with :meth:`operator_costs` from a run of the same pipeline with
+    ``enable_timing_stats``; the GPU time of the operators not measured on the GPU is assumed
+    to be 10 times shorter than the CPU time. See :meth:`placement_report`.
+`thread_pool_type`: str, optional, default = "shared_queue"
+    Scheduling strategy of the thread pool used by the CPU operators. Supported values:
+
+      * ``"shared_queue"`` - all the threads pick the work from one queue, honoring the priorities
+      * ``"work_stealing"`` - each thread has its own queue and idle threads steal the work from
+        the others. Reduces the contention when using many threads and operators that schedule
+        a large number of small tasks; the priorities are honored only approximately.
+      * ``"process_shared"`` - the work is run by a set of worker threads shared by all the
+        pipelines in the process that use this setting. Each pipeline runs at most
+        `num_threads` tasks at a time and the workers serve the pipelines in turns, so that
+        running many pipelines in one process (e.g. training and validation for several GPUs)
+        doesn't oversubscribe the CPU cores. The number of the workers is the number of
+        the CPU cores, unless set with the ``DALI_SHARED_THREAD_POOL_SIZE`` environment variable.
+`exec_dataflow`: bool, optional, default = False
+    Whether to run independent CPU operators concurrently. An operator is started as soon as
+    all of its inputs are ready and the CPU threads are divided between independent branches
+    of the graph. Requires both `exec_pipelined` and `exec_async` to be set to True.
+`exec_low_latency`: bool, optional, default = False
+    Whether to minimize the latency of an iteration, e.g. for inference with small batches.
+    The stages are run one after another in the calling thread, with a single buffer per output
+    (`prefetch_queue_depth` is ignored) and with the mixed and GPU stages in one CUDA stream.
+    Requires both `exec_pipelined` and `exec_async` to be set to False.
+`exec_gpu_multistream`: bool, optional, default = False
+    Whether to run independent branches of the GPU stage on separate CUDA streams, so that
+    the GPU operators that don't depend on each other can overlap. The number of streams is
+    limited by `max_streams`.
+`exec_cuda_graph`: bool, optional, default = False
+    Whether to capture the GPU stage in a CUDA graph and replay it in the following iterations,
+    which reduces the CPU overhead of launching the GPU work. The graph is captured again
+    whenever the shapes of the inputs or outputs of the GPU operators change. It is only used if
+    all the GPU operators in the pipeline support it and don't take any CPU inputs - otherwise
+    the GPU operators are launched as usual.
+`exec_memory_planning`: bool, optional, default = False
+    Whether the intermediate outputs of the GPU stage, whose lifetimes don't overlap, should
+    share memory. This reduces the peak GPU memory usage of deep pipelines. Only the outputs
+    consumed by GPU operators which can infer their output shapes are shared and the pipeline
+    outputs are never shared. Not used together with `exec_gpu_multistream`.
+    If all the GPU operators can infer their output shapes, the GPU inputs of ``cat`` and
+    ``stack`` along the outermost axis (``axis=0``), which aren't used elsewhere, are also
+    written by their producers directly to the joined output, so that the join doesn't copy
+    the data (e.g. in multi-crop pipelines).
+`exec_micro_batch_size`: int, optional, default = 0
+    If positive, the chains of consecutive GPU operators which support it (e.g. ``resize``,
+    ``warp_affine`` and ``crop_mirror_normalize``) are run in sub-batches of at most this many
+    samples: the whole chain processes one sub-batch before the next one is started. The outputs
+    consumed only within a chain and the temporary memory of its operators are then sized for a
+    sub-batch rather than for the whole batch, which caps the peak GPU memory usage for large
+    batches. Not used together with `exec_gpu_multistream`; a pipeline with such a chain
+    doesn't use `exec_cuda_graph` and the in-place joins of `exec_memory_planning`.
+`min_prefetch_queue_depth`: int or {"cpu_size": int, "gpu_size": int}, optional, default = None
+    If set, the depths of the prefetch queues are adjusted at run time, between
+    `min_prefetch_queue_depth` and `prefetch_queue_depth`, based on the time the stages
+    spend waiting for each other: the depth grows when the execution time is uneven and shrinks
+    when the pipeline keeps ahead of the consumer, releasing the memory of the unused buffers.
+    Must have the same form as `prefetch_queue_depth` and not exceed it.
+    Requires both `exec_pipelined` and `exec_async` to be set to True.
+    The currently used depths are returned by :meth:`current_prefetch_queue_depth`.
 `py_num_workers`: int, optional, default = 1
     The number of Python workers that will process ``ExternalSource`` callbacks.
     The pool starts only if there is at least one ExternalSource with ``parallel`` set to True.
@@ -188,14 +284,45 @@ Parameters
                  default_cuda_stream_priority=0,
                  *,
                  enable_memory_stats=False,
+                 enable_timing_stats=False,
+                 bottleneck_analysis_interval=None,
+                 placement_costs=None,
+                 thread_pool_type="shared_queue",
+                 exec_dataflow=False,
+                 exec_low_latency=False,
+                 exec_gpu_multistream=False,
+                 exec_cuda_graph=False,
+                 exec_memory_planning=False,
+                 exec_micro_batch_size=0,
+                 urgent_cuda_stream_priority=None,
+                 min_prefetch_queue_depth=None,
                  py_num_workers=1,
                  py_start_method="fork",
                  py_callback_pickler=None,
                  output_dtype=None,
-                 output_ndim=None):
+                 output_ndim=None,
+                 remote_workers=None):
         self._sinks = []
         self._max_batch_size = batch_size
         self._num_threads = num_threads
+        if isinstance(device_id, (list, tuple)):
+            if len(device_id) == 0 or any(not isinstance(d, int) or d < 0 for d in device_id):
+                raise ValueError(
+                    f"`device_id` must be a non-empty list of GPU ids. Got: {device_id}.")
+            if len(set(device_id)) != len(device_id):
+                raise ValueError(f"`device_id` must not contain duplicates. Got: {device_id}.")
+            self._device_ids = list(device_id)
+            device_id = device_id[0]
+        else:
+            self._device_ids = None
+        if remote_workers is not None:
+            if not remote_workers:
+                raise ValueError("`remote_workers` must be a non-empty list of addresses.")
+            if self._device_ids is not None:
+                raise ValueError("`remote_workers` cannot be used with multiple devices.")
+            self._remote_workers = list(remote_workers)
+        else:
+            self._remote_workers = None
         self._device_id = device_id
         self._seed = seed
         self._exec_pipelined = exec_pipelined
@@ -241,6 +368,30 @@ Parameters
         self._parallel_input_callbacks = None
         self._seq_input_callbacks = None
         self._enable_memory_stats = enable_memory_stats
+        self._enable_timing_stats = enable_timing_stats
+        self._bottleneck_analysis_interval = bottleneck_analysis_interval
+        self._placement_costs = placement_costs
+        if thread_pool_type not in ("shared_queue", "work_stealing", "process_shared"):
+            raise ValueError(
+                f"`thread_pool_type` must be one of \"shared_queue\", \"work_stealing\" or "
+                f"\"process_shared\". Got: {thread_pool_type}.")
+        self._thread_pool_type = thread_pool_type
+        if exec_dataflow and not (exec_pipelined and exec_async):
+            raise ValueError(
+                "`exec_dataflow` requires both `exec_pipelined` and `exec_async` to be True.")
+        self._exec_dataflow = exec_dataflow
+        if exec_low_latency and (exec_pipelined or exec_async or exec_dataflow):
+            raise ValueError(
+                "`exec_low_latency` requires both `exec_pipelined` and `exec_async` to be False.")
+        self._exec_low_latency = exec_low_latency
+        self._exec_gpu_multistream = exec_gpu_multistream
+        self._exec_cuda_graph = exec_cuda_graph
+        self._exec_memory_planning = exec_memory_planning
+        if exec_micro_batch_size < 0:
+            raise ValueError(
+                f"`exec_micro_batch_size` must not be negative, got {exec_micro_batch_size}.")
+        self._exec_micro_batch_size = exec_micro_batch_size
+        self._urgent_cuda_stream_priority = urgent_cuda_stream_priority
         self._prefetch_queue_depth = prefetch_queue_depth
         if type(prefetch_queue_depth) is dict:
             self._exec_separated = True
@@ -252,6 +403,23 @@ Parameters
             self._gpu_queue_size = prefetch_queue_depth
         else:
             raise TypeError("Expected prefetch_queue_depth to be either int or Dict[int, int]")
+        self._min_prefetch_queue_depth = min_prefetch_queue_depth
+        if min_prefetch_queue_depth is not None:
+            if not (exec_pipelined and exec_async):
+                raise ValueError("`min_prefetch_queue_depth` requires both `exec_pipelined` and "
+                                 "`exec_async` to be True.")
+            if type(min_prefetch_queue_depth) is not type(prefetch_queue_depth):
+                raise TypeError("Expected min_prefetch_queue_depth to have the same type as "
+                                "prefetch_queue_depth")
+            if type(min_prefetch_queue_depth) is dict:
+                self._min_cpu_queue_size = min_prefetch_queue_depth["cpu_size"]
+                self._min_gpu_queue_size = min_prefetch_queue_depth["gpu_size"]
+            else:
+                self._min_cpu_queue_size = min_prefetch_queue_depth
+                self._min_gpu_queue_size = min_prefetch_queue_depth
+            if (self._min_cpu_queue_size > self._cpu_queue_size
+                    or self._min_gpu_queue_size > self._gpu_queue_size):
+                raise ValueError("`min_prefetch_queue_depth` cannot exceed `prefetch_queue_depth`.")
 
         # Assign and validate output_dtype
         if isinstance(output_dtype, (list, tuple)):
@@ -313,7 +481,10 @@ Parameters
 
     @property
     def device_id(self):
-        """Id of the GPU used by the pipeline or None for CPU-only pipelines."""
+        """Id of the GPU used by the pipeline or None for CPU-only pipelines.
+        The list of ids, for a pipeline running on multiple GPUs."""
+        if self._device_ids is not None:
+            return list(self._device_ids)
         return None if self._device_id == types.CPU_ONLY_DEVICE_ID else self._device_id
 
     @property
@@ -346,6 +517,23 @@ Parameters
         """Depth (or depths) of the prefetch queue, as specified in the ``__init__`` arguments."""
         return self._prefetch_queue_depth
 
+    @property
+    def min_prefetch_queue_depth(self):
+        """Lower bound of the adaptive prefetch queue depth (or depths), as specified in
+        the ``__init__`` arguments. None if the depth is fixed."""
+        return self._min_prefetch_queue_depth
+
+    def current_prefetch_queue_depth(self):
+        """Returns the depth (or depths, in the same form as ``prefetch_queue_depth``) of
+        the prefetch queue currently used by the executor. It differs from
+        ``prefetch_queue_depth`` only when ``min_prefetch_queue_depth`` is set."""
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        sizes = self._pipe.current_queue_sizes()
+        if self._exec_separated:
+            return sizes
+        return sizes["cpu_size"]
+
     @property
     def default_cuda_stream_priority(self):
         """Default priority of the CUDA streams used by this pipeline."""
@@ -356,6 +544,51 @@ Parameters
         """If True, memory usage statistics are gathered."""
         return self._enable_memory_stats
 
+    @property
+    def enable_timing_stats(self):
+        """If True, execution time statistics are gathered."""
+        return self._enable_timing_stats
+
+    @property
+    def exec_dataflow(self):
+        """If true, independent CPU operators are run concurrently."""
+        return self._exec_dataflow
+
+    @property
+    def exec_low_latency(self):
+        """If true, the pipeline is run in the low latency mode."""
+        return self._exec_low_latency
+
+    @property
+    def exec_gpu_multistream(self):
+        """If true, independent GPU operators are run on separate CUDA streams."""
+        return self._exec_gpu_multistream
+
+    @property
+    def exec_cuda_graph(self):
+        """If true, the GPU stage is captured in a CUDA graph, when possible."""
+        return self._exec_cuda_graph
+
+    @property
+    def exec_memory_planning(self):
+        """If true, the intermediate outputs of the GPU stage share memory, when possible."""
+        return self._exec_memory_planning
+
+    @property
+    def exec_micro_batch_size(self):
+        """The size of the sub-batches of the micro-batched GPU operators (0 if not used)."""
+        return self._exec_micro_batch_size
+
+    @property
+    def urgent_cuda_stream_priority(self):
+        """CUDA stream priority of the iterations the consumer waits for (None if not used)."""
+        return self._urgent_cuda_stream_priority
+
+    @property
+    def thread_pool_type(self):
+        """Scheduling strategy of the thread pool used by the CPU operators."""
+        return self._thread_pool_type
+
     @property
     def py_num_workers(self):
         """The number of Python worker processes used by parallel ```external_source```."""
@@ -429,11 +662,137 @@ Parameters
             * ``max_reserved_memory_size`` - list of maximum memory sizes per tensor that is
               reserved for each of the operator outputs. Index in the list corresponds to
               the output index.
+
+            * ``host_arena_allocations`` - the number of temporary host allocations made by
+              the operator from its per-iteration arena.
+
+            * ``host_arena_upstream_allocations`` - the number of times the arena had to
+              allocate a memory block. It stops growing once the arena is large enough for
+              an iteration.
+
+            * ``host_arena_peak_bytes`` - the largest amount of arena memory used by the operator
+              in a single iteration.
+
+        When ``enable_timing_stats`` is set, there are also the following keys, each describing
+        a histogram of durations - a dictionary with ``count``, ``total_ns``, ``min_ns``,
+        ``max_ns`` and ``buckets``. The bucket 0 counts the durations shorter than 1 us,
+        the bucket ``i`` the durations in ``[2^(i-1), 2^i)`` us and the last one all the longer
+        durations.
+
+            * ``host_time`` - wall time of running the operator, including its setup.
+
+            * ``gpu_time`` - time of the operator measured with CUDA events. Only for mixed
+              and GPU operators.
         """
         if not self._built:
             raise RuntimeError("Pipeline must be built first.")
         return self._pipe.executor_statistics()
 
+    def executor_stage_statistics(self):
+        """Returns the execution time statistics of the executor stages, gathered when
+        ``enable_timing_stats`` is set, as a dictionary with ``cpu``, ``mixed`` and ``gpu`` keys.
+
+        Available keys for each stage:
+
+            * ``queue_wait`` - histogram (see :meth:`executor_statistics`) of the time the stage
+              waited for the buffers to work on.
+
+            * ``run_time`` - histogram of the wall time of running (issuing the work of) the stage.
+
+            * ``thread_pool_busy_ns`` - total time the CPU threads spent executing the work of
+              the operators. Only for the CPU stage.
+
+            * ``thread_pool_capacity_ns`` - the number of CPU threads multiplied by the total run
+              time of the CPU stage; the ratio of ``thread_pool_busy_ns`` to this value is
+              the utilization of the thread pool. Only for the CPU stage.
+
+            * ``num_threads`` - the number of threads of the CPU thread pool(s). Only for
+              the CPU stage.
+
+            * ``shared_pool_threads`` - the number of the process-wide worker threads, shared
+              with the other pipelines, that run the CPU stage; 0 unless ``thread_pool_type``
+              is ``"process_shared"``. Only for the CPU stage.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        return self._pipe.executor_stage_statistics()
+
+    def bottleneck_report(self):
+        """Returns the latest verdict of the bottleneck analysis, enabled with
+        ``bottleneck_analysis_interval``, as a dictionary.
+
+        The verdict is based on the timing statistics gathered since the previous update:
+        if the consumer of the outputs rarely waits for them, the pipeline is ahead of it;
+        otherwise the stage with the longest time per iteration limits the throughput.
+
+        Available keys:
+
+            * ``verdict`` - ``"consumer"`` (the pipeline is faster than the outputs are
+              requested), ``"io"`` (the CPU stage, most of its time spent in the readers),
+              ``"cpu"``, ``"mixed"``, ``"gpu"`` or ``"unknown"`` (no iterations observed yet).
+
+            * ``iterations``, ``window_s`` - the number of iterations and the duration of
+              the window the verdict is based on.
+
+            * ``consumer_wait_fraction`` - the part of the window spent waiting for the outputs.
+
+            * ``ready_outputs`` - the average number of outputs ready when one was requested.
+
+            * ``thread_pool_utilization`` - the part of the CPU threads' capacity spent working.
+
+            * ``io_fraction`` - the share of the readers in the time of the CPU operators.
+
+            * ``stages`` - a dictionary with ``cpu``, ``mixed`` and ``gpu`` keys, with the time
+              of the stage per iteration (``time_s``; the longer of the host and the GPU time)
+              and the part of the window it waited for the buffers (``wait_fraction``).
+
+            * ``operators`` - a list of dictionaries with ``name``, ``stage``, ``stage_share``
+              (the share of the operator in the time of its stage) and ``critical_path_share``
+              (the share in the time of the bottleneck stage, 0 for the other stages), sorted
+              by the contribution to the critical path.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        return self._pipe.bottleneck_report()
+
+    def operator_costs(self):
+        """Returns the time per iteration of the operators, based on the statistics gathered
+        when ``enable_timing_stats`` is set, in the form accepted by ``placement_costs``.
+
+        The keys identify the operators in any instance of this pipeline: the name of the operator
+        and the number of the preceding operators of the same kind (e.g. ``"Resize#1"``).
+        The values are pairs of the mean CPU and GPU time in seconds, with ``None`` if the time
+        wasn't measured on that device. The costs measured for the CPU and the GPU variant of
+        a pipeline can be merged.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        return self._pipe.operator_costs()
+
+    def placement_report(self):
+        """Returns the decisions of the automatic placement of the operators, enabled with
+        ``placement_costs``, as a dictionary.
+
+        Available keys:
+
+            * ``enabled`` - whether the placement was done.
+
+            * ``summary`` - a human-readable version of the report.
+
+            * ``cpu_time_s``, ``gpu_time_s`` - the estimated time of the CPU and the GPU stage
+              per iteration, before and after the placement.
+
+            * ``transfers`` - the number of tensors copied to the GPU, before and after.
+
+            * ``operators`` - a list of dictionaries, one for each CPU operator, with ``name``,
+              ``key`` (see :meth:`operator_costs`), ``device`` (the device it runs on), ``reason``,
+              ``cpu_s``, ``gpu_s`` (its costs) and ``gpu_estimated`` (whether the GPU time was
+              estimated from the CPU time).
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        return self._pipe.placement_report()
+
     def reader_meta(self, name=None):
         """Returns provided reader metadata as a dictionary. If no name is provided if provides
         a dictionary with data for all readers as {reader_name : meta}
@@ -464,6 +823,71 @@ Parameters
             return self._pipe.reader_meta(name)
         return self._pipe.reader_meta()
 
+    def reader_state(self, name):
+        """Returns the state of the reader as of the outputs returned so far, as bytes.
+
+        The reader must have ``enable_checkpointing`` set. A pipeline with the same definition
+        can continue with the batches that would follow, after the state is restored with
+        :meth:`restore_reader_state`.
+
+        Parameters
+        ----------
+        name : str
+            The reader whose state is returned.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        return self._pipe.reader_state(name)
+
+    def restore_reader_state(self, name, state):
+        """Restores the state of the reader, obtained with :meth:`reader_state`.
+
+        It must be called after the pipeline is built and before it's run.
+
+        Parameters
+        ----------
+        name : str
+            The reader whose state is restored.
+        state : bytes
+            The state returned by :meth:`reader_state`.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        self._pipe.restore_reader_state(name, state)
+
+    def reshard_reader(self, name, num_shards, shard_id, at_sample=-1):
+        """Changes the sharding of the dataset read by the reader, without rebuilding
+        the pipeline - e.g. when the number of workers of an elastic training changes.
+
+        By default, the reader switches to the new shard when it finishes the part of
+        the current epoch it reads. With ``at_sample``, the epoch is cut instead: each of the
+        shards reads ``at_sample`` samples of its part of the epoch and the samples which none
+        of them has read are split among the new shards, so that no sample is skipped or
+        repeated within the epoch.
+
+        All the readers of the dataset need to be resharded with the same ``num_shards`` and
+        ``at_sample`` and the cut must lie ahead of the samples which any of them has read,
+        including the prefetched ones. A pipeline which doesn't take part in the new sharding
+        only needs to return its first ``at_sample`` samples of the epoch part. Resharding is
+        supported by the file, COCO, TFRecord, MXNet and packed readers, without
+        ``enable_checkpointing``.
+
+        Parameters
+        ----------
+        name : str
+            The reader to reshard.
+        num_shards : int
+            The new number of shards.
+        shard_id : int
+            The new shard read by this pipeline.
+        at_sample : int, optional, default = -1
+            The number of samples of the current part of the epoch read by each of the shards
+            before the new sharding is used; -1 means the whole part.
+        """
+        if not self._built:
+            raise RuntimeError("Pipeline must be built first.")
+        self._pipe.reshard_reader(name, num_shards, shard_id, at_sample)
+
     @staticmethod
     def current():
         """Returns the instance of the current pipeline set by :meth:`push_current`."""
@@ -688,6 +1112,18 @@ Parameters
         self._py_pool_started = True
 
     def _init_pipeline_backend(self):
+        if self._device_ids is not None:
+            from nvidia.dali._multi_device import _MultiDeviceBackend
+            self._pipe = _MultiDeviceBackend(self)
+            self._backend_prepared = True
+            self._names_and_devices = [(e.name, e.device) for e in self._graph_outputs]
+            return
+        if self._remote_workers is not None:
+            from nvidia.dali.remote import _RemoteBackend
+            self._pipe = _RemoteBackend(self)
+            self._backend_prepared = True
+            self._names_and_devices = [(e.name, e.device) for e in self._graph_outputs]
+            return
         device_id = self._device_id if self._device_id is not None else types.CPU_ONLY_DEVICE_ID
         if device_id != types.CPU_ONLY_DEVICE_ID:
             b.check_cuda_runtime()
@@ -702,9 +1138,24 @@ Parameters
                                 self._set_affinity,
                                 self._max_streams,
                                 self._default_cuda_stream_priority)
-        self._pipe.SetExecutionTypes(self._exec_pipelined, self._exec_separated, self._exec_async)
+        self._pipe.SetExecutionTypes(self._exec_pipelined, self._exec_separated, self._exec_async,
+                                     self._exec_dataflow, self._exec_low_latency)
         self._pipe.SetQueueSizes(self._cpu_queue_size, self._gpu_queue_size)
+        if self._min_prefetch_queue_depth is not None:
+            self._pipe.SetMinQueueSizes(self._min_cpu_queue_size, self._min_gpu_queue_size)
         self._pipe.EnableExecutorMemoryStats(self._enable_memory_stats)
+        self._pipe.EnableExecutorTimingStats(self._enable_timing_stats)
+        if self._bottleneck_analysis_interval is not None:
+            self._pipe.EnableBottleneckAnalysis(self._bottleneck_analysis_interval)
+        if self._placement_costs is not None:
+            self._pipe.EnableAutoPlacement(self._placement_costs)
+        self._pipe.SetThreadPoolType(self._thread_pool_type)
+        self._pipe.SetGPUMultiStream(self._exec_gpu_multistream)
+        self._pipe.SetGPUGraphCapture(self._exec_cuda_graph)
+        self._pipe.SetGPUMemoryPlanning(self._exec_memory_planning)
+        self._pipe.SetGPUMicroBatchSize(self._exec_micro_batch_size)
+        if self._urgent_cuda_stream_priority is not None:
+            self._pipe.SetUrgentStreamPriority(self._urgent_cuda_stream_priority)
 
         # Add the ops to the graph and build the backend
         related_logical_id = {}
@@ -977,7 +1428,7 @@ Parameters
         _show_deprecation_warning("_run", "schedule_run")
         self.schedule_run()
 
-    def share_outputs(self):
+    def share_outputs(self, cuda_stream=None):
         """Returns the outputs of the pipeline.
 
         Main difference to :meth:`outputs`
@@ -991,6 +1442,12 @@ Parameters
         and :meth:`schedule_run`
         Should not be mixed with :meth:`run` in the same pipeline.
 
+        Args:
+            cuda_stream (optional, `cudaStream_t` or an object convertible to `cudaStream_t`,
+                e.g. `cupy.cuda.Stream`, `torch.cuda.Stream`):
+                If provided, the function doesn't wait for the GPU outputs to be computed.
+                Instead, they are ready for the work scheduled on `cuda_stream` after the call.
+
         :return:
             A list of `TensorList` objects for respective pipeline outputs
         """
@@ -999,7 +1456,7 @@ Parameters
                 raise StopIteration
             self._batches_to_consume -= 1
             self._gpu_batches_to_consume -= 1
-            return self._pipe.ShareOutputs()
+            return self._pipe.ShareOutputs(_raw_stream_ptr(cuda_stream))
 
     # for the backward compatibility
     def _share_outputs(self):
@@ -1007,7 +1464,7 @@ Parameters
         _show_deprecation_warning("_share_outputs", "share_outputs")
         self.share_outputs()
 
-    def release_outputs(self):
+    def release_outputs(self, cuda_stream=None):
         """Release buffers returned by share_outputs calls.
 
         It helps in case when output call result is consumed (copied)
@@ -1017,11 +1474,19 @@ Parameters
         results have been consumed.
         Needs to be used together with :meth:`schedule_run`
         and :meth:`share_outputs`
-        Should not be mixed with :meth:`run` in the same pipeline"""
+        Should not be mixed with :meth:`run` in the same pipeline
+
+        Args:
+            cuda_stream (optional, `cudaStream_t` or an object convertible to `cudaStream_t`,
+                e.g. `cupy.cuda.Stream`, `torch.cuda.Stream`):
+                The stream on which the work that uses the GPU outputs (e.g. a copy) was
+                scheduled. DALI doesn't overwrite the buffers before that work completes
+                and the function doesn't wait for it.
+        """
         with self._check_api_type_scope(types.PipelineAPIType.SCHEDULED):
             if not self._built:
                 raise RuntimeError("Pipeline must be built first.")
-            return self._pipe.ReleaseOutputs()
+            return self._pipe.ReleaseOutputs(_raw_stream_ptr(cuda_stream))
 
     # for the backward compatibility
     def _release_outputs(self):
@@ -1144,7 +1609,7 @@ Parameters
         """
         return self._batches_to_consume == 0
 
-    def serialize(self, define_graph=None, filename=None):
+    def serialize(self, define_graph=None, filename=None, memory_hints=False):
         """Serialize the pipeline to a Protobuf string.
 
         Additionally, you can pass file name, so that serialized pipeline will be written there.
@@ -1158,6 +1623,12 @@ Parameters
                 :meth:`set_outputs`.
         filename : str
                 File, from where serialized pipeline will be writeen.
+        memory_hints : bool
+                If True, the output and the host scratch memory sizes observed in the iterations
+                run so far are saved with the operators, so that a pipeline deserialized from
+                the result preallocates them when built and its first iterations run at
+                the steady-state latency.
+                Requires a built pipeline with ``enable_memory_stats=True``.
         kwargs : dict
                 Refer to Pipeline constructor for full list of arguments.
         """
@@ -1165,12 +1636,16 @@ Parameters
             raise TypeError("Provided `define_graph` argument is not callable."
                             + (" Didn't you want to write `.serialize(filename=...)`?"
                                if isinstance(define_graph, str) else ""))
+        if self._device_ids is not None:
+            raise RuntimeError("A pipeline running on multiple devices cannot be serialized.")
+        if self._remote_workers is not None:
+            raise RuntimeError("A pipeline with remote workers cannot be serialized.")
         if not self._py_graph_built:
             self._build_graph(define_graph)
         if not self._backend_prepared:
             self._init_pipeline_backend()
             self._pipe.SetOutputDescs(self._generate_build_args())
-        ret = self._pipe.SerializeToProtobuf()
+        ret = self._pipe.SerializeToProtobuf(memory_hints)
         if filename is not None:
             with open(filename, 'wb') as pipeline_file:
                 pipeline_file.write(ret)
@@ -1225,9 +1700,25 @@ Parameters
         if pipeline.device_id != types.CPU_ONLY_DEVICE_ID:
             b.check_cuda_runtime()
         pipeline._pipe.SetExecutionTypes(pipeline._exec_pipelined, pipeline._exec_separated,
-                                         pipeline._exec_async)
+                                         pipeline._exec_async, pipeline._exec_dataflow,
+                                         pipeline._exec_low_latency)
         pipeline._pipe.SetQueueSizes(pipeline._cpu_queue_size, pipeline._gpu_queue_size)
+        if pipeline._min_prefetch_queue_depth is not None:
+            pipeline._pipe.SetMinQueueSizes(pipeline._min_cpu_queue_size,
+                                            pipeline._min_gpu_queue_size)
         pipeline._pipe.EnableExecutorMemoryStats(pipeline._enable_memory_stats)
+        pipeline._pipe.EnableExecutorTimingStats(pipeline._enable_timing_stats)
+        if pipeline._bottleneck_analysis_interval is not None:
+            pipeline._pipe.EnableBottleneckAnalysis(pipeline._bottleneck_analysis_interval)
+        if pipeline._placement_costs is not None:
+            pipeline._pipe.EnableAutoPlacement(pipeline._placement_costs)
+        pipeline._pipe.SetThreadPoolType(pipeline._thread_pool_type)
+        pipeline._pipe.SetGPUMultiStream(pipeline._exec_gpu_multistream)
+        pipeline._pipe.SetGPUGraphCapture(pipeline._exec_cuda_graph)
+        pipeline._pipe.SetGPUMemoryPlanning(pipeline._exec_memory_planning)
+        pipeline._pipe.SetGPUMicroBatchSize(pipeline._exec_micro_batch_size)
+        if pipeline._urgent_cuda_stream_priority is not None:
+            pipeline._pipe.SetUrgentStreamPriority(pipeline._urgent_cuda_stream_priority)
         pipeline._backend_prepared = True
         pipeline._pipe.Build()
         pipeline._built = True
@@ -1253,9 +1744,24 @@ Parameters
                                 self._set_affinity,
                                 self._max_streams,
                                 self._default_cuda_stream_priority)
-        self._pipe.SetExecutionTypes(self._exec_pipelined, self._exec_separated, self._exec_async)
+        self._pipe.SetExecutionTypes(self._exec_pipelined, self._exec_separated, self._exec_async,
+                                     self._exec_dataflow, self._exec_low_latency)
         self._pipe.SetQueueSizes(self._cpu_queue_size, self._gpu_queue_size)
+        if self._min_prefetch_queue_depth is not None:
+            self._pipe.SetMinQueueSizes(self._min_cpu_queue_size, self._min_gpu_queue_size)
         self._pipe.EnableExecutorMemoryStats(self._enable_memory_stats)
+        self._pipe.EnableExecutorTimingStats(self._enable_timing_stats)
+        if self._bottleneck_analysis_interval is not None:
+            self._pipe.EnableBottleneckAnalysis(self._bottleneck_analysis_interval)
+        if self._placement_costs is not None:
+            self._pipe.EnableAutoPlacement(self._placement_costs)
+        self._pipe.SetThreadPoolType(self._thread_pool_type)
+        self._pipe.SetGPUMultiStream(self._exec_gpu_multistream)
+        self._pipe.SetGPUGraphCapture(self._exec_cuda_graph)
+        self._pipe.SetGPUMemoryPlanning(self._exec_memory_planning)
+        self._pipe.SetGPUMicroBatchSize(self._exec_micro_batch_size)
+        if self._urgent_cuda_stream_priority is not None:
+            self._pipe.SetUrgentStreamPriority(self._urgent_cuda_stream_priority)
         self._backend_prepared = True
         self._pipe.Build()
         self._built = True
@@ -1353,6 +1859,12 @@ Parameters
                 for (name, dev), dtype, ndim in zip(self._names_and_devices, dtypes, ndims)]
 
 
+def _raw_stream_ptr(cuda_stream):
+    """Converts a stream object to a ctypes pointer (or None) accepted by the backend."""
+    cuda_stream = types._raw_cuda_stream(cuda_stream)
+    return None if cuda_stream is None else ctypes.c_void_p(cuda_stream)
+
+
 def _discriminate_args(func, **func_kwargs):
     """Split args on those applicable to Pipeline constructor and the decorated function."""
     func_argspec = inspect.getfullargspec(func)
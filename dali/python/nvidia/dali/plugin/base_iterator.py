@@ -294,7 +294,7 @@ class _DaliBaseIterator(object):
         try:
             for p in self._pipes:
                 with p._check_api_type_scope(types.PipelineAPIType.ITERATOR):
-                    outputs.append(p.share_outputs())
+                    outputs.append(p.share_outputs(cuda_stream=self._output_stream(p)))
         except StopIteration as e:
             # in case ExternalSource returns StopIteration
             if self._size < 0 and self._auto_reset == "yes":
@@ -303,6 +303,14 @@ class _DaliBaseIterator(object):
         self._check_batch_size(outputs)
         return outputs
 
+    def _output_stream(self, pipe):
+        """
+        Returns the stream on which the outputs of `pipe` are consumed. If it is not None,
+        the GPU outputs are shared and released in the order of this stream (without waiting
+        for them on the host); otherwise the outputs are complete when they are shared.
+        """
+        return None
+
     def _check_batch_size(self, outs):
         if not isinstance(outs, Iterable):
             outs = [outs]
@@ -327,7 +335,7 @@ class _DaliBaseIterator(object):
         for p in self._pipes:
             with p._check_api_type_scope(types.PipelineAPIType.ITERATOR):
                 if release_outputs:
-                    p.release_outputs()
+                    p.release_outputs(cuda_stream=self._output_stream(p))
                 p.schedule_run()
 
     def _advance_and_check_drop_last(self):
@@ -13,6 +13,10 @@
 # limitations under the License.
 
 from distutils.version import LooseVersion
+import hashlib
+import json
+import os
+import types as py_types
 
 from nvidia.dali import backend as _b
 from nvidia.dali.pipeline import Pipeline
@@ -60,6 +64,88 @@ if 'float16' in dir(numba_types):
 minimal_numba_version = LooseVersion('0.55.2')
 
 
+# Compiled GPU kernels, by the cache key; keeps the CUDA modules loaded for the process lifetime
+_gpu_kernels = {}
+
+
+def _kernel_cache_dir():
+    default = os.path.join(os.path.expanduser("~"), ".cache", "dali", "numba")
+    return os.environ.get("DALI_NUMBA_CACHE_DIR", default)
+
+
+def _update_digest(h, value, visited):
+    """Hashes the value a compiled function depends on: the code of the functions,
+    including the device functions and closures it refers to, and the constants."""
+    fn = getattr(value, "py_func", value)  # Numba dispatchers wrap the Python function
+    code = getattr(fn, "__code__", None)
+    if code is not None:
+        if id(code) in visited:
+            return
+        visited.add(id(code))
+        _update_code_digest(h, code, getattr(fn, "__globals__", {}), visited)
+        for cell in getattr(fn, "__closure__", None) or ():
+            _update_digest(h, cell.cell_contents, visited)
+    elif isinstance(value, np.ndarray):
+        h.update(repr((value.dtype, value.shape)).encode())
+        h.update(value.tobytes())
+    elif isinstance(value, (bool, int, float, complex, str, bytes, tuple, np.generic)):
+        h.update(repr(value).encode())
+    elif isinstance(value, py_types.ModuleType):
+        h.update(value.__name__.encode())
+    else:
+        h.update(type(value).__qualname__.encode())
+
+
+def _update_code_digest(h, code, globals_, visited):
+    h.update(code.co_code)
+    h.update(repr(code.co_names).encode())
+    for const in code.co_consts:
+        if isinstance(const, py_types.CodeType):
+            _update_code_digest(h, const, globals_, visited)
+        else:
+            h.update(repr(const).encode())
+    for name in code.co_names:
+        if name in globals_:
+            _update_digest(h, globals_[name], visited)
+
+
+def _kernel_cache_key(run_fn, cuda_arguments, nvvm_options):
+    h = hashlib.sha256()
+    _update_digest(h, run_fn, set())
+    device = cuda.get_current_device()
+    h.update(repr((cuda_arguments, sorted(nvvm_options.items()), nb.__version__,
+                   device.compute_capability, cuda.runtime.get_version())).encode())
+    return h.hexdigest()
+
+
+def _load_cached_kernel(cache_dir, key):
+    from numba.cuda.cudadrv.driver import CudaAPIError
+    try:
+        with open(os.path.join(cache_dir, key + ".json")) as f:
+            name = json.load(f)["name"]
+        with open(os.path.join(cache_dir, key + ".cubin"), "rb") as f:
+            cubin = f.read()
+        module = cuda.current_context().create_module_image(cubin)
+        return module, module.get_function(name)
+    except (OSError, ValueError, KeyError, CudaAPIError):
+        return None
+
+
+def _store_cached_kernel(cache_dir, key, cubin, name):
+    # Written to a temporary file and renamed, so that concurrent processes never see partial files
+    try:
+        os.makedirs(cache_dir, exist_ok=True)
+        files = [(".cubin", cubin, "wb"), (".json", json.dumps({"name": name}), "w")]
+        for ext, data, mode in files:
+            path = os.path.join(cache_dir, key + ext)
+            tmp_path = f"{path}.{os.getpid()}.tmp"
+            with open(tmp_path, mode) as f:
+                f.write(data)
+            os.replace(tmp_path, path)
+    except OSError:
+        pass
+
+
 @nb.extending.intrinsic
 def address_as_void_pointer(typingctx, src):
     from numba.core import types, cgutils
@@ -171,7 +257,7 @@ class NumbaFunction(metaclass=ops._DaliOperatorMeta):
 
         return setup_fn_address
 
-    def _get_run_fn_gpu(self, run_fn, types, dims):
+    def _get_run_fn_gpu(self, run_fn, types, dims, batch_processing=False):
         nvvm_options = {
             'debug': False,
             'lineinfo': False,
@@ -181,18 +267,32 @@ class NumbaFunction(metaclass=ops._DaliOperatorMeta):
 
         cuda_arguments = []
         for dali_type, ndim in zip(types, dims):
+            # in batch mode, the outermost dimension is the sample index
+            if batch_processing:
+                ndim += 1
             cuda_arguments.append(numba_types.Array(_to_numba[dali_type], ndim, 'C'))
 
-        cres = cuda.compiler.compile_cuda(run_fn, numba_types.void, cuda_arguments)
-        tgt_ctx = cres.target_context
-        code = run_fn.__code__
-        filename = code.co_filename
-        linenum = code.co_firstlineno
-        lib, kernel = tgt_ctx.prepare_cuda_kernel(cres.library, cres.fndesc,
-                                                  True, nvvm_options,
-                                                  filename, linenum)
-        handle = lib.get_cufunc().handle
-        return handle.value
+        key = _kernel_cache_key(run_fn, cuda_arguments, nvvm_options)
+        if key in _gpu_kernels:
+            return _gpu_kernels[key][1].handle.value
+
+        cache_dir = _kernel_cache_dir()
+        cached = _load_cached_kernel(cache_dir, key) if cache_dir else None
+        if cached is None:
+            cres = cuda.compiler.compile_cuda(run_fn, numba_types.void, cuda_arguments)
+            tgt_ctx = cres.target_context
+            code = run_fn.__code__
+            filename = code.co_filename
+            linenum = code.co_firstlineno
+            lib, kernel = tgt_ctx.prepare_cuda_kernel(cres.library, cres.fndesc,
+                                                      True, nvvm_options,
+                                                      filename, linenum)
+            cufunc = lib.get_cufunc()
+            if cache_dir:
+                _store_cached_kernel(cache_dir, key, lib.get_cubin(), cufunc.name)
+            cached = (lib, cufunc)
+        _gpu_kernels[key] = cached
+        return cached[1].handle.value
 
     def _get_run_fn_cpu(self, run_fn, out_types, in_types, outs_ndim, ins_ndim, batch_processing):
         out0_lambda, out1_lambda, out2_lambda, out3_lambda, out4_lambda, out5_lambda = \
@@ -380,8 +480,6 @@ class NumbaFunction(metaclass=ops._DaliOperatorMeta):
                                        "Python 3.7 or newer is required")
 
         if device == 'gpu':
-            assert batch_processing is False, ("Currently batch processing for GPU "
-                                               "is not supported.")
             assert len(blocks) == 3, ("`blocks` array should contain 3 numbers, "
                                       f"while received: {len(blocks)}")
             for i, block_dim in enumerate(blocks):
@@ -419,7 +517,8 @@ class NumbaFunction(metaclass=ops._DaliOperatorMeta):
         if device == 'gpu':
             self.run_fn = self._get_run_fn_gpu(run_fn,
                                                in_types + out_types,
-                                               ins_ndim + outs_ndim)
+                                               ins_ndim + outs_ndim,
+                                               batch_processing)
             self.setup_fn = None
         else:
             self.run_fn = self._get_run_fn_cpu(run_fn,
@@ -27,6 +27,7 @@ to_torch_type = {
     types.DALIDataType.FLOAT:   torch.float32,
     types.DALIDataType.FLOAT64: torch.float64,
     types.DALIDataType.FLOAT16: torch.float16,
+    types.DALIDataType.BFLOAT16: torch.bfloat16,
     types.DALIDataType.UINT8:   torch.uint8,
     types.DALIDataType.INT8:    torch.int8,
     types.DALIDataType.INT16:   torch.int16,
@@ -71,6 +72,76 @@ def feed_ndarray(dali_tensor, arr, cuda_stream=None):
     return arr
 
 
+def _ragged_layout(shapes):
+    """
+    Returns the shape of the values and the offsets of the samples of a ragged batch.
+
+    If all the samples have at least one dimension and the same inner extents, the samples are
+    concatenated along the outermost dimension and the offsets are expressed in its units.
+    Otherwise, the values are flat and the offsets are expressed in elements.
+    """
+    inner = [tuple(shape[1:]) for shape in shapes]
+    if len(shapes) > 0 and all(len(shape) > 0 and i == inner[0] for shape, i in zip(shapes, inner)):
+        lengths = [shape[0] for shape in shapes]
+        values_shape = [sum(lengths), *inner[0]]
+    else:
+        lengths = [int(np.prod(shape)) for shape in shapes]
+        values_shape = [sum(lengths)]
+    offsets = np.zeros(len(shapes) + 1, dtype=np.int64)
+    np.cumsum(lengths, out=offsets[1:])
+    return values_shape, offsets
+
+
+def to_ragged(dali_tensor_list, cuda_stream=None, copy=True):
+    """
+    Converts a DALI TensorList with samples of different lengths to a ragged PyTorch batch,
+    without padding the samples to a common shape.
+
+    Returns a tuple ``(values, offsets)``, where ``values`` holds the samples stored back to back
+    and the sample ``i`` is ``values[offsets[i]:offsets[i + 1]]`` (a CSR-like layout, as expected
+    e.g. by ``torch.nested`` with the jagged layout). If the samples have the same extents in all
+    but the outermost dimension (e.g. sequences of feature vectors), they are concatenated along
+    the outermost dimension and the offsets are expressed in its units. Otherwise, the values are
+    flat and the offsets are expressed in elements. The offsets are placed on the device of the
+    values.
+
+    Parameters
+    ----------
+    `dali_tensor_list` : nvidia.dali.backend.TensorListCPU or nvidia.dali.backend.TensorListGPU
+                    Batch to convert. It must be contiguous in memory, as the pipeline outputs are.
+    `cuda_stream` : torch.cuda.Stream, cudaStream_t or any value that can be cast to cudaStream_t.
+                    CUDA stream to be used for the copy. If not provided, PyTorch's current
+                    stream is used.
+    `copy` : bool, optional, default = True
+                    Whether the values are copied to a newly allocated PyTorch tensor. If False,
+                    the values are a zero-copy DLPack view of the DALI batch, valid only until
+                    the pipeline outputs are released or the pipeline is run again.
+    """
+    values_shape, offsets = _ragged_layout(dali_tensor_list.shape())
+    view = torch_dlpack.from_dlpack(dali_tensor_list.as_dlpack_values())
+    if not copy:
+        values = view.view(values_shape)
+    else:
+        values = torch.empty(values_shape, dtype=view.dtype, device=view.device)
+        c_type_pointer = ctypes.c_void_p(values.data_ptr())
+        if values.is_cuda:
+            if cuda_stream is None:
+                cuda_stream = torch.cuda.current_stream(device=values.device)
+            stream = ctypes.c_void_p(types._raw_cuda_stream(cuda_stream))
+            dali_tensor_list.copy_to_external(c_type_pointer, stream, non_blocking=True)
+        else:
+            dali_tensor_list.copy_to_external(c_type_pointer)
+    return values, torch.from_numpy(offsets).to(values.device)
+
+
+def _first_samples(data, num_samples):
+    """Returns the first `num_samples` samples of a dense or ragged (values, offsets) batch"""
+    if isinstance(data, tuple):
+        values, offsets = data
+        return values[0:int(offsets[num_samples])], offsets[0:num_samples + 1]
+    return data[0:num_samples]
+
+
 class DALIGenericIterator(_DaliBaseIterator):
     """
     General DALI iterator for PyTorch. It can return any number of
@@ -139,6 +210,10 @@ class DALIGenericIterator(_DaliBaseIterator):
     prepare_first_batch : bool, optional, default = True
                 Whether DALI should buffer the first batch right after the creation of the iterator,
                 so one batch is already prepared when the iterator is prompted for the data
+    ragged_outputs : list of str, optional, default = None
+                Names (from ``output_map``) of the outputs with samples of different lengths,
+                e.g. sequences. Instead of being padded to a dense tensor, each of them is
+                returned as a tuple ``(values, offsets)`` - see :meth:`to_ragged`.
 
     Example
     -------
@@ -173,12 +248,16 @@ class DALIGenericIterator(_DaliBaseIterator):
                  dynamic_shape=False,
                  last_batch_padded=False,
                  last_batch_policy=LastBatchPolicy.FILL,
-                 prepare_first_batch=True):
+                 prepare_first_batch=True,
+                 ragged_outputs=None):
 
         # check the assert first as _DaliBaseIterator would run the prefetch
         assert len(set(output_map)) == len(output_map), "output_map names should be distinct"
         self._output_categories = set(output_map)
         self.output_map = output_map
+        self._ragged_outputs = set(ragged_outputs or [])
+        assert self._ragged_outputs <= self._output_categories, \
+            "ragged_outputs should be a subset of output_map"
 
         _DaliBaseIterator.__init__(self,
                                    pipelines,
@@ -202,6 +281,13 @@ class DALIGenericIterator(_DaliBaseIterator):
                        "if `last_batch_policy` is set to PARTIAL and the requested batch size is " \
                        "greater than the shard size."
 
+    def _output_stream(self, pipe):
+        # The outputs are copied to the torch tensors on torch's current stream, so
+        # they don't need to be waited for on the host.
+        if pipe.device_id is None:
+            return None
+        return torch.cuda.current_stream(device=torch.device('cuda', pipe.device_id))
+
     def __next__(self):
         self._ever_consumed = True
         if self._first_batch is not None:
@@ -225,6 +311,8 @@ class DALIGenericIterator(_DaliBaseIterator):
             category_tensors = dict()
             category_shapes = dict()
             for category, out in category_outputs.items():
+                if category in self._ragged_outputs:
+                    continue
                 category_tensors[category] = out.as_tensor()
                 category_shapes[category] = category_tensors[category].shape()
 
@@ -233,7 +321,7 @@ class DALIGenericIterator(_DaliBaseIterator):
             torch_gpu_device = None
             torch_cpu_device = torch.device('cpu')
             # check category and device
-            for category in self._output_categories:
+            for category in category_tensors:
                 category_torch_type[category] = to_torch_type[category_tensors[category].dtype]
                 if type(category_tensors[category]) is TensorGPU:
                     if not torch_gpu_device:
@@ -243,7 +331,7 @@ class DALIGenericIterator(_DaliBaseIterator):
                     category_device[category] = torch_cpu_device
 
             pyt_tensors = dict()
-            for category in self._output_categories:
+            for category in category_tensors:
                 pyt_tensors[category] = torch.empty(category_shapes[category],
                                                     dtype=category_torch_type[category],
                                                     device=category_device[category])
@@ -259,6 +347,10 @@ class DALIGenericIterator(_DaliBaseIterator):
                 else:
                     feed_ndarray(tensor, pyt_tensors[category])
 
+            # The ragged outputs are copied without padding
+            for category in self._ragged_outputs:
+                pyt_tensors[category] = to_ragged(category_outputs[category])
+
         self._schedule_runs()
 
         self._advance_and_check_drop_last()
@@ -270,7 +362,7 @@ class DALIGenericIterator(_DaliBaseIterator):
                 for batch, to_copy in zip(data_batches, left):
                     batch = batch.copy()
                     for category in self._output_categories:
-                        batch[category] = batch[category][0:to_copy]
+                        batch[category] = _first_samples(batch[category], to_copy)
                     output.append(batch)
                 return output
 
@@ -294,7 +386,7 @@ class DALIGenericIterator(_DaliBaseIterator):
                 output = data_batches[0:numGPUs_tograb]
                 output[-1] = output[-1].copy()
                 for category in self._output_categories:
-                    output[-1][category] = output[-1][category][0:data_fromlastGPU]
+                    output[-1][category] = _first_samples(output[-1][category], data_fromlastGPU)
                 return output
 
         return data_batches
@@ -424,44 +516,63 @@ class TorchPythonFunction(ops.PythonFunctionBase):
     ops.register_cpu_op('TorchPythonFunction')
     ops.register_gpu_op('TorchPythonFunction')
 
+    # With an external stream, the function runs directly on DALI's stream, so neither DALI's
+    # work before the call nor the function's work after it has to be waited for on the host.
+    _use_dali_stream = hasattr(torch.cuda, "ExternalStream")
+
     def _torch_stream_wrapper(self, function, *ins):
+        if self._use_dali_stream:
+            stream = torch.cuda.ExternalStream(ops.PythonFunction.current_stream().ptr,
+                                               device=self.device_id)
+            with torch.cuda.stream(stream):
+                return function(*ins)
         with torch.cuda.stream(self.stream):
             out = function(*ins)
         self.stream.synchronize()
         return out
 
     def torch_wrapper(self, batch_processing, function, device, *args):
-        func = function if device == 'cpu' else \
-               lambda *ins: self._torch_stream_wrapper(function, *ins)
+        if device == 'cpu':
+            func = function
+            to_dlpack = torch_dlpack.to_dlpack
+        else:
+            def func(*ins):
+                return self._torch_stream_wrapper(function, *ins)
+
+            def to_dlpack(t):
+                return ops._dlpack_from_gpu_array(t, torch_dlpack.to_dlpack)
         if batch_processing:
             return ops.PythonFunction.function_wrapper_batch(func,
                                                              self.num_outputs,
-                                                             torch.utils.dlpack.from_dlpack,
-                                                             torch.utils.dlpack.to_dlpack,
+                                                             torch_dlpack.from_dlpack,
+                                                             to_dlpack,
                                                              *args)
         else:
             return ops.PythonFunction.function_wrapper_per_sample(func,
                                                                   self.num_outputs,
                                                                   torch_dlpack.from_dlpack,
-                                                                  torch_dlpack.to_dlpack,
+                                                                  to_dlpack,
                                                                   *args)
 
     def __call__(self, *inputs, **kwargs):
         pipeline = Pipeline.current()
         if pipeline is None:
             Pipeline._raise_no_current_pipeline("TorchPythonFunction")
-        if self.stream is None:
+        self.device_id = pipeline.device_id
+        if self.stream is None and not self._use_dali_stream:
             self.stream = torch.cuda.Stream(device=pipeline.device_id)
         return super(TorchPythonFunction, self).__call__(*inputs, **kwargs)
 
     def __init__(self, function, num_outputs=1, device='cpu', batch_processing=False, **kwargs):
         self.stream = None
+        self.device_id = None
         super(TorchPythonFunction, self).__init__(impl_name="DLTensorPythonFunctionImpl",
                                                   function=lambda *ins:
                                                   self.torch_wrapper(batch_processing,
                                                                      function, device,
                                                                      *ins),
                                                   num_outputs=num_outputs, device=device,
+                                                  synchronize_stream=not self._use_dali_stream,
                                                   batch_processing=batch_processing, **kwargs)
 
 
@@ -1,4 +1,4 @@
-# Copyright (c) 2018, 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2018, 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -33,3 +33,23 @@ def load_library(library_path: str, global_symbols: bool = False):
     """
     b.LoadLibrary(library_path, global_symbols)
     ops.Reload()
+
+
+def register_deferred_library(library_path: str, op_names, global_symbols: bool = False):
+    """Registers a DALI plugin to be loaded on first use of one of its operators.
+
+    Nothing is loaded until one of the operators is accessed (e.g. as ``fn.my_op``) or used in
+    a pipeline, so the libraries that are not needed don't slow down the startup.
+
+    Args:
+        library_path: Path to the plugin library (relative or absolute)
+        op_names: Schema names of the operators provided by the library, e.g.
+            ``["CustomDummy", "readers__MyReader"]``
+        global_symbols: See :meth:`load_library`.
+
+    Returns:
+        None.
+    """
+    op_names = list(op_names)
+    b.RegisterDeferredLibrary(library_path, op_names, global_symbols)
+    ops._add_deferred_ops(op_names)
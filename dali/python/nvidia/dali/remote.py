@@ -0,0 +1,468 @@
+# Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Running the CPU stage of a pipeline on remote machines.
+
+A :class:`RemoteWorker` runs on a CPU node and serves the CPU stage (the readers and the CPU
+operators) of the pipelines created with the ``remote_workers`` argument on the GPU nodes.
+The GPU node sends the serialized CPU stage to each of the workers, which build and run it and
+stream the batches back over TCP. The GPU node feeds them to the mixed and GPU operators.
+
+A worker can be started with::
+
+    python -m nvidia.dali.remote --port 5555 --num_threads 16
+
+The workers run the pipelines they are sent, so they should only be reachable from
+the trusted GPU nodes.
+"""
+
+import argparse
+import json
+import queue
+import select
+import socket
+import struct
+import threading
+import weakref
+
+import numpy as np
+
+import nvidia.dali.backend as _b
+import nvidia.dali.types as _types
+from nvidia.dali._multi_device import _add_ops, _split_graph, _MultiDeviceBackend
+from nvidia.dali.external_source import _is_external_source
+
+_PROTOCOL_VERSION = 1
+_ALIGNMENT = 64
+_size_struct = struct.Struct("<Q")
+# sent by the GPU node for each batch it consumes
+_ACK = b"\x01"
+
+
+def _recv_exactly(sock, buf):
+    view = memoryview(buf)
+    while len(view):
+        n = sock.recv_into(view)
+        if n == 0:
+            raise ConnectionError("The connection was closed.")
+        view = view[n:]
+    return buf
+
+
+def _send_bytes(sock, data):
+    sock.sendall(_size_struct.pack(len(data)))
+    sock.sendall(data)
+
+
+def _recv_bytes(sock):
+    size, = _size_struct.unpack(_recv_exactly(sock, bytearray(_size_struct.size)))
+    return _recv_exactly(sock, bytearray(size))
+
+
+def _send_json(sock, obj):
+    _send_bytes(sock, json.dumps(obj).encode())
+
+
+def _recv_json(sock):
+    return json.loads(_recv_bytes(sock).decode())
+
+
+def _align(offset):
+    return (offset + _ALIGNMENT - 1) // _ALIGNMENT * _ALIGNMENT
+
+
+def _send_batch(sock, outputs):
+    """Sends the outputs of an iteration: a JSON description of the outputs, followed by
+    the shapes of all the samples and the data of the samples, each aligned to 64 bytes."""
+    descs = []
+    shapes = []
+    samples = []
+    for tl in outputs:
+        arrays = [np.asarray(tl[i]) for i in range(len(tl))]
+        ndim = arrays[0].ndim if arrays else 0
+        descs.append({"dtype": arrays[0].dtype.str if arrays else "|u1",
+                      "layout": tl.layout(),
+                      "ndim": ndim,
+                      "num_samples": len(arrays)})
+        shapes.append(np.array([a.shape for a in arrays], dtype=np.int64).reshape(-1))
+        samples += arrays
+    shapes = np.concatenate(shapes) if shapes else np.zeros(0, dtype=np.int64)
+    offset = _align(shapes.nbytes)
+    offsets = []
+    for a in samples:
+        offsets.append(offset)
+        offset = _align(offset + a.nbytes)
+    _send_json(sock, {"outputs": descs})
+    sock.sendall(_size_struct.pack(offset))
+    sock.sendall(shapes.tobytes())
+    end = shapes.nbytes
+    for a, sample_offset in zip(samples, offsets):
+        if sample_offset > end:
+            sock.sendall(bytes(sample_offset - end))
+        sock.sendall(np.ascontiguousarray(a).reshape(-1).view(np.uint8))
+        end = sample_offset + a.nbytes
+    if offset > end:
+        sock.sendall(bytes(offset - end))
+
+
+def _recv_batch(sock):
+    """Receives a batch sent with `_send_batch`. Returns a list of lists of samples (TensorCPU)
+    per output, the samples being views of a single buffer."""
+    header = _recv_json(sock)
+    if "error" in header:
+        raise RuntimeError(header["error"])
+    size, = _size_struct.unpack(_recv_exactly(sock, bytearray(_size_struct.size)))
+    buf = _recv_exactly(sock, bytearray(size))
+    descs = header["outputs"]
+    num_dims = sum(d["ndim"] * d["num_samples"] for d in descs)
+    shapes = np.frombuffer(buf, dtype=np.int64, count=num_dims)
+    offset = _align(shapes.nbytes)
+    dim = 0
+    outputs = []
+    for desc in descs:
+        dtype = np.dtype(desc["dtype"])
+        ndim = desc["ndim"]
+        samples = []
+        for _ in range(desc["num_samples"]):
+            shape = tuple(int(extent) for extent in shapes[dim:dim + ndim])
+            dim += ndim
+            count = int(np.prod(shape, dtype=np.int64))
+            array = np.frombuffer(buf, dtype=dtype, count=count, offset=offset).reshape(shape)
+            samples.append(_b.TensorCPU(array, desc["layout"]))
+            offset = _align(offset + array.nbytes)
+        outputs.append(samples)
+    return outputs
+
+
+def _receive_batches(sock, batches):
+    """Puts the batches received from a worker into the `batches` queue, until the connection
+    is closed. An error is put into the queue as an exception object."""
+    try:
+        while True:
+            batches.put(_recv_batch(sock))
+    except Exception as e:
+        batches.put(e)
+
+
+class RemoteWorker:
+    """Serves the CPU stage of the pipelines running on the GPU nodes.
+
+    The worker accepts one connection at a time. For each connection, it builds the CPU stage
+    sent by the GPU node as a CPU-only pipeline and runs it, sending at most as many batches
+    ahead as the depth of the CPU prefetch queue of the pipeline on the GPU node - the GPU node
+    acknowledges each batch it consumes.
+
+    When a pipeline uses several workers, each of them runs the whole CPU stage and the GPU node
+    takes the batches from the workers in turns. The readers of the CPU stage are resharded
+    (see :meth:`nvidia.dali.Pipeline.reshard_reader`), so that each of the workers reads its
+    part of the shard of the GPU node.
+
+    Parameters
+    ----------
+    host : str, optional, default = ""
+        The address to listen on. The default value means all the interfaces.
+    port : int, optional, default = 0
+        The port to listen on. 0 means any free port, see :attr:`port`.
+    num_threads : int, optional, default = None
+        The number of the CPU threads of the pipelines. If not set, the `num_threads` of
+        the pipeline on the GPU node is used.
+    """
+
+    def __init__(self, host="", port=0, num_threads=None):
+        self._num_threads = num_threads
+        self._sock = socket.create_server((host, port))
+        self._closed = False
+
+    @property
+    def port(self):
+        """The port the worker listens on."""
+        return self._sock.getsockname()[1]
+
+    def serve(self, max_connections=None):
+        """Serves the connections, one at a time, until :meth:`close` is called or
+        `max_connections` connections have been served."""
+        served = 0
+        while not self._closed and (max_connections is None or served < max_connections):
+            try:
+                conn, _ = self._sock.accept()
+            except OSError:
+                if self._closed:
+                    break
+                raise
+            with conn:
+                conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+                self._serve_connection(conn)
+            served += 1
+
+    def close(self):
+        """Stops accepting new connections."""
+        self._closed = True
+        try:
+            self._sock.shutdown(socket.SHUT_RDWR)
+        except OSError:
+            pass
+        self._sock.close()
+
+    def _serve_connection(self, conn):
+        try:
+            config = _recv_json(conn)
+            serialized = bytes(_recv_bytes(conn))
+        except (ConnectionError, OSError, ValueError):
+            return
+        try:
+            if config.get("version") != _PROTOCOL_VERSION:
+                raise RuntimeError(f"Unsupported protocol version: {config.get('version')}. "
+                                   f"The worker supports version {_PROTOCOL_VERSION}.")
+            depth = config["prefetch_queue_depth"]
+            num_threads = self._num_threads or config["num_threads"]
+            pipe = _b.Pipeline(serialized, config["batch_size"], num_threads,
+                               _types.CPU_ONLY_DEVICE_ID, True, depth, True)
+            pipe.Build()
+            reader_meta = pipe.reader_meta()
+            num_workers = config["num_workers"]
+            if num_workers > 1:
+                worker_index = config["worker_index"]
+                for name, meta in reader_meta.items():
+                    pipe.reshard_reader(name, meta["number_of_shards"] * num_workers,
+                                        meta["shard_id"] * num_workers + worker_index, 0)
+            _send_json(conn, {"reader_meta": reader_meta})
+        except Exception as e:
+            _send_json(conn, {"error": str(e)})
+            return
+        try:
+            self._run(conn, pipe, depth)
+        except (ConnectionError, OSError):
+            pass
+
+    def _run(self, conn, pipe, depth):
+        for _ in range(depth):
+            pipe.RunCPU()
+            pipe.RunGPU()
+        credits = 0
+        while True:
+            # wait for the GPU node to consume a batch only when it has `depth` batches already
+            timeout = None if credits == 0 else 0
+            while select.select([conn], [], [], timeout)[0]:
+                acks = conn.recv(4096)
+                if not acks:
+                    return
+                credits += len(acks)
+                timeout = 0
+            try:
+                outputs = pipe.ShareOutputs()
+            except Exception as e:
+                _send_json(conn, {"error": str(e)})
+                return
+            try:
+                _send_batch(conn, outputs)
+            finally:
+                pipe.ReleaseOutputs()
+            credits -= 1
+            pipe.RunCPU()
+            pipe.RunGPU()
+
+
+def _parse_address(address):
+    if isinstance(address, str):
+        host, sep, port = address.rpartition(":")
+        if not sep or not host:
+            raise ValueError(f"The address of a remote worker must be given as \"host:port\". "
+                             f"Got: \"{address}\".")
+        return host, int(port)
+    host, port = address
+    return host, int(port)
+
+
+def _close_connections(socks):
+    for sock in socks:
+        try:
+            sock.shutdown(socket.SHUT_RDWR)
+        except OSError:
+            pass
+        sock.close()
+
+
+class _RemoteBackend:
+    """Runs the CPU stage of a Pipeline on remote workers (see :class:`RemoteWorker`).
+
+    The CPU operators are serialized, as a CPU-only pipeline, and sent to the workers. The
+    tensors passed from the CPU stage to the mixed and GPU operators are received from the
+    workers, in turns, and fed to a local pipeline with the mixed and GPU operators through
+    ExternalSource operators.
+
+    Exposes the same interface as the backend Pipeline, so that the Python Pipeline can use it
+    in place of one. The reader metadata are those reported by the first worker; the remaining
+    methods refer to the local pipeline.
+    """
+
+    def __init__(self, pipeline):
+        self._addresses = [_parse_address(address) for address in pipeline._remote_workers]
+        for op in pipeline._ops:
+            if _is_external_source(op):
+                raise ValueError(
+                    "ExternalSource is not supported in a pipeline with remote workers. "
+                    "The samples must be produced by the operators of the pipeline, e.g. readers.")
+        if pipeline._exec_separated or not (pipeline._exec_pipelined and pipeline._exec_async):
+            raise ValueError(
+                "A pipeline with remote workers requires `exec_pipelined` and `exec_async` "
+                "set to True and `prefetch_queue_depth` given as an int.")
+        if pipeline._placement_costs is not None:
+            raise ValueError("`placement_costs` cannot be used in a pipeline with remote workers.")
+        cpu_ops, device_ops, cut = _split_graph(pipeline._ops, pipeline._graph_outputs)
+        if not cut:
+            raise ValueError("The pipeline has no CPU stage which could run on remote workers.")
+        self._cut = cut
+        self._input_names = [f"__RemoteInput_{i}" for i in range(len(cut))]
+        self._batch_size = pipeline._max_batch_size
+        self._num_threads = pipeline._num_threads
+        self._queue_depth = max(pipeline._cpu_queue_size, 1)
+
+        # each worker runs the CPU stage with a different seed
+        self._serialized = []
+        for i in range(len(self._addresses)):
+            seed = pipeline._seed
+            if seed is not None and seed != -1:
+                seed = seed + i
+            cpu_pipe = _b.Pipeline(self._batch_size, self._num_threads,
+                                   _types.CPU_ONLY_DEVICE_ID,
+                                   seed if seed is not None else -1)
+            _add_ops(cpu_pipe, cpu_ops)
+            cpu_pipe.SetOutputDescs([(name, "cpu", _types.NO_TYPE, -1) for name in cut])
+            self._serialized.append(cpu_pipe.SerializeToProtobuf())
+
+        device_id = pipeline._device_id
+        if device_id is None:
+            device_id = _types.CPU_ONLY_DEVICE_ID
+        else:
+            _b.check_cuda_runtime()
+        self._pipe = _MultiDeviceBackend._create_pipe(pipeline, self._batch_size, device_id,
+                                                      pipeline._seed, 2)
+        for name, input_name in zip(cut, self._input_names):
+            spec = _b.OpSpec("ExternalSource")
+            spec.AddArg("device", "cpu")
+            spec.AddOutput(name, "cpu")
+            self._pipe.AddOperator(spec, input_name)
+        _add_ops(self._pipe, device_ops)
+
+        self._socks = []
+        self._batches = []
+        self._reader_meta = {}
+        self._next_worker = 0
+        self._remote_batches = 0  # the iterations requested, but not fed to the local pipeline
+        self._local_batches = 0  # the iterations fed to the local pipeline, but not returned yet
+        weakref.finalize(self, _close_connections, self._socks)
+
+    def _connect(self):
+        num_workers = len(self._addresses)
+        for i, address in enumerate(self._addresses):
+            sock = socket.create_connection(address)
+            sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            self._socks.append(sock)
+            _send_json(sock, {"version": _PROTOCOL_VERSION,
+                              "batch_size": self._batch_size,
+                              "num_threads": self._num_threads,
+                              "prefetch_queue_depth": self._queue_depth,
+                              "worker_index": i,
+                              "num_workers": num_workers})
+            _send_bytes(sock, self._serialized[i])
+        for i, sock in enumerate(self._socks):
+            reply = _recv_json(sock)
+            if "error" in reply:
+                host, port = self._addresses[i]
+                raise RuntimeError(
+                    f"Remote worker {host}:{port} failed to build the pipeline: {reply['error']}")
+            if i == 0:
+                self._reader_meta = reply["reader_meta"]
+            # the worker sends the batches ahead, up to the depth of the prefetch queue
+            sock.sendall(_ACK * self._queue_depth)
+            batches = queue.Queue()
+            self._batches.append(batches)
+            threading.Thread(target=_receive_batches, args=(sock, batches), daemon=True).start()
+
+    def Build(self, build_args):
+        self._pipe.Build(build_args)
+        self._connect()
+
+    def RunCPU(self):
+        pass
+
+    def RunGPU(self):
+        self._remote_batches += 1
+
+    def _schedule(self):
+        """Feeds the next batch received from the workers to the local pipeline and runs it."""
+        worker = self._next_worker
+        batch = self._batches[worker].get()
+        if isinstance(batch, Exception):
+            host, port = self._addresses[worker]
+            raise RuntimeError(f"Remote worker {host}:{port} failed: {batch}") from batch
+        for input_name, samples in zip(self._input_names, batch):
+            self._pipe.SetExternalTensorInput(input_name, samples)
+        # the samples are copied, so the worker can send another batch
+        self._socks[worker].sendall(_ACK)
+        self._next_worker = (worker + 1) % len(self._batches)
+        self._pipe.RunCPU()
+        self._pipe.RunGPU()
+        self._remote_batches -= 1
+        self._local_batches += 1
+
+    def ShareOutputs(self, cuda_stream=None):
+        if self._local_batches == 0:
+            self._schedule()
+        outputs = self._pipe.ShareOutputs(cuda_stream)
+        self._local_batches -= 1
+        # let the local pipeline compute the next iteration while this one is consumed
+        if self._remote_batches > 0:
+            self._schedule()
+        return outputs
+
+    def ReleaseOutputs(self, cuda_stream=None):
+        self._pipe.ReleaseOutputs(cuda_stream)
+
+    def Outputs(self):
+        self.ReleaseOutputs()
+        return self.ShareOutputs()
+
+    def reader_meta(self, name=None):
+        if name is None:
+            return dict(self._reader_meta)
+        if name not in self._reader_meta:
+            raise RuntimeError(f"Operator {name}  not found or does not expose valid metadata.")
+        return dict(self._reader_meta[name])
+
+    def close(self):
+        _close_connections(self._socks)
+
+    def __getattr__(self, name):
+        return getattr(self._pipe, name)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Serves the CPU stage of the DALI pipelines created with `remote_workers`.")
+    parser.add_argument("--host", default="", help="The address to listen on (default: all).")
+    parser.add_argument("--port", type=int, required=True, help="The port to listen on.")
+    parser.add_argument("--num_threads", type=int, default=None,
+                        help="The number of the CPU threads of the pipelines "
+                             "(default: as requested by the GPU node).")
+    args = parser.parse_args()
+    worker = RemoteWorker(args.host, args.port, args.num_threads)
+    try:
+        worker.serve()
+    finally:
+        worker.close()
+
+
+if __name__ == "__main__":
+    main()
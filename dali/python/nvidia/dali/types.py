@@ -418,6 +418,7 @@ _type_name_to_dali_type = {
     'ulong':   DALIDataType.UINT64,
     'half':    DALIDataType.FLOAT16,
     'float16': DALIDataType.FLOAT16,
+    'bfloat16': DALIDataType.BFLOAT16,
     'float':   DALIDataType.FLOAT,
     'float32': DALIDataType.FLOAT,
     'float64': DALIDataType.FLOAT64,
@@ -67,4 +67,31 @@ TEST_F(DummyTest, TestPluginGPU) {
   this->TestPlugin("gpu");
 }
 
+TEST_F(DummyTest, TestNativeSource) {
+  LoadDummyPlugin();
+  const int batch_size = 3;
+  dali::Pipeline pipe(batch_size, 2, 0);
+  pipe.AddOperator(
+      dali::OpSpec("experimental__NativeSource")
+      .AddArg("source", "CustomDummySource")
+      .AddArg("output_layouts", dali::TensorLayout("X"))
+      .AddOutput("out", "cpu"));
+  pipe.Build({{"out", "cpu"}});
+  for (int iter = 0; iter < 2; iter++) {
+    pipe.RunCPU();
+    pipe.RunGPU();
+    dali::DeviceWorkspace ws;
+    pipe.Outputs(&ws);
+    auto &out = ws.Output<dali::CPUBackend>(0);
+    ASSERT_EQ(out.num_samples(), batch_size);
+    EXPECT_EQ(out.GetLayout(), "X");
+    for (int i = 0; i < batch_size; i++) {
+      int idx = iter * batch_size + i;
+      ASSERT_EQ(out.tensor_shape(i), dali::TensorShape<>(idx % 4 + 1));
+      for (int j = 0; j < idx % 4 + 1; j++)
+        EXPECT_EQ(out.tensor<int32_t>(i)[j], idx);
+    }
+  }
+}
+
 }  // namespace other_ns
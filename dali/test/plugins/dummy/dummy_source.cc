@@ -0,0 +1,50 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <vector>
+#include "dali/pipeline/operator/builtin/native_source.h"
+
+namespace other_ns {
+
+/**
+ * @brief Produces 1D int32 samples with (index % 4 + 1) elements, filled with the index
+ *        of the sample in the pipeline's run
+ */
+class DummySource : public ::dali::NativeSource {
+ public:
+  explicit DummySource(const ::dali::OpSpec &spec) {}
+
+  void Setup(std::vector<::dali::OutputDesc> &output_desc,
+             const ::dali::SourceBatchInfo &info) override {
+    auto &shape = output_desc[0].shape;
+    shape.resize(info.batch_size, 1);
+    for (int i = 0; i < info.batch_size; i++)
+      shape.tensor_shape_span(i)[0] = (info.first_sample + i) % 4 + 1;
+    output_desc[0].type = ::dali::DALI_INT32;
+  }
+
+  void RunSample(::dali::HostWorkspace &ws, const ::dali::SourceBatchInfo &info, int sample_idx,
+                 int thread_idx) override {
+    auto &output = ws.Output<::dali::CPUBackend>(0);
+    auto *data = output.mutable_tensor<int32_t>(sample_idx);
+    int64_t n = output.tensor_shape_span(sample_idx)[0];
+    for (int64_t j = 0; j < n; j++)
+      data[j] = info.first_sample + sample_idx;
+  }
+};
+
+}  // namespace other_ns
+
+DALI_REGISTER_NATIVE_SOURCE(CustomDummySource, ::other_ns::DummySource);
@@ -200,3 +200,58 @@ def test_audio_decoder_correctness():
     dtype = types.INT16
     for fmt in ['wav', 'flac', 'ogg']:
         yield check_audio_decoder_correctness, fmt, dtype
+
+
+def test_audio_decoder_offset_duration():
+    batch_size = 3
+    offsets = [0.1, 0.5, 0.0]
+    durations = [0.2, -1.0, 0.3]
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=3)
+    def audio_decoder_pipe():
+        encoded, _ = fn.readers.file(files=names)
+        full, rate = fn.decoders.audio(encoded, dtype=types.INT16)
+        offset = fn.external_source(lambda: [np.array(o, dtype=np.float32) for o in offsets])
+        duration = fn.external_source(lambda: [np.array(d, dtype=np.float32) for d in durations])
+        part, _ = fn.decoders.audio(encoded, dtype=types.INT16, offset=offset, duration=duration)
+        return full, rate, part
+
+    pipe = audio_decoder_pipe()
+    pipe.build()
+    full, rate, part = pipe.run()
+    for s in range(batch_size):
+        sr = int(np.array(rate[s]))
+        begin = int(offsets[s] * sr)
+        end = begin + int(durations[s] * sr) if durations[s] >= 0 else len(np.array(full[s]))
+        np.testing.assert_equal(np.array(part[s]), np.array(full[s])[begin:end])
+
+
+def check_audio_decoder_mixed(sample_rate, downmix, dtype):
+    batch_size = 3
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=3)
+    def audio_decoder_pipe(device):
+        encoded, _ = fn.readers.file(files=names)
+        decoded, rate = fn.decoders.audio(encoded, device=device, sample_rate=sample_rate,
+                                          downmix=downmix, dtype=dtype)
+        return decoded, rate
+
+    ref_pipe = audio_decoder_pipe("cpu")
+    pipe = audio_decoder_pipe("mixed")
+    ref_pipe.build()
+    pipe.build()
+    for _ in range(2):
+        ref, ref_rate = ref_pipe.run()
+        out, rate = pipe.run()
+        out, rate = out.as_cpu(), rate.as_cpu()
+        for s in range(batch_size):
+            np.testing.assert_equal(np.array(rate[s]), np.array(ref_rate[s]))
+            atol = 1e-3 if dtype == types.FLOAT else 1
+            np.testing.assert_allclose(np.array(out[s]), np.array(ref[s]), atol=atol)
+
+
+def test_audio_decoder_mixed():
+    for sample_rate in [rate1, rate2]:
+        for downmix in [False, True]:
+            for dtype in [types.FLOAT, types.INT16]:
+                yield check_audio_decoder_mixed, sample_rate, downmix, dtype
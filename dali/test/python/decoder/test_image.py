@@ -204,6 +204,63 @@ def test_FastDCT():
                 yield check_FastDCT_body, batch_size, img_type, device
 
 
+def test_decode_size_hint():
+    data_path = os.path.join(test_data_root, good_path, 'jpeg')
+    hint = [96, 128]
+
+    @pipeline_def(batch_size=8, num_threads=3, device_id=0)
+    def pipe():
+        encoded, _ = fn.readers.file(file_root=data_path)
+        full = fn.decoders.image(encoded, device='cpu')
+        scaled = fn.decoders.image(encoded, device='cpu', decode_size_hint=hint)
+        return full, scaled
+
+    p = pipe()
+    p.build()
+    for _ in range(3):
+        full, scaled = p.run()
+        for i in range(len(full)):
+            full_shape = full.at(i).shape
+            scaled_shape = scaled.at(i).shape
+            assert scaled_shape[2] == full_shape[2]
+            ratios = [r for r in [1, 2, 4, 8]
+                      if all(math.ceil(full_shape[d] / r) == scaled_shape[d] for d in range(2))]
+            assert ratios, f"{scaled_shape} is not a scaled down {full_shape}"
+            if ratios[0] > 1:
+                assert all(scaled_shape[d] >= hint[d] for d in range(2))
+            else:
+                # the image is not large enough to be scaled down
+                assert any(full_shape[d] // 2 < hint[d] for d in range(2))
+
+
+def check_image_resize(img_type, resize_args, eps):
+    data_path = os.path.join(test_data_root, good_path, img_type)
+
+    @pipeline_def(batch_size=8, num_threads=3, device_id=0)
+    def fused_pipe():
+        encoded, _ = fn.readers.file(file_root=data_path)
+        return fn.decoders.image_resize(encoded, device='cpu', **resize_args)
+
+    @pipeline_def(batch_size=8, num_threads=3, device_id=0)
+    def reference_pipe():
+        encoded, _ = fn.readers.file(file_root=data_path)
+        decoded = fn.decoders.image(encoded, device='cpu')
+        return fn.resize(decoded, **resize_args)
+
+    compare_pipelines(fused_pipe(), reference_pipe(), batch_size=8, N_iterations=3, eps=eps)
+
+
+def test_image_resize():
+    for img_type in test_good_path:
+        # the JPEG images are scaled down in the DCT domain, so they differ from the reference
+        eps = 8 if img_type == 'jpeg' else 1e-5
+        for resize_args in [{'resize_shorter': 64},
+                            {'size': (48, 80)},
+                            {'resize_x': 100, 'roi_start': (0.2, 0.1), 'roi_end': (0.8, 0.9),
+                             'roi_relative': True}]:
+            yield check_image_resize, img_type, resize_args, eps
+
+
 def test_image_decoder_memory_stats():
     device = 'mixed'
     img_type = 'jpeg'
@@ -232,6 +289,14 @@ def img_decoder_pipe(device, out_type, files):
     return decoded
 
 
+@pipeline_def(batch_size=batch_size_test, device_id=0, num_threads=4)
+def imgcodec_decoder_pipe(device, out_type, files):
+    encoded, _ = fn.readers.file(files=files)
+    decoded = fn.experimental.decoders.image(encoded, device=device, output_type=out_type,
+                                             adjust_orientation=False)
+    return decoded
+
+
 def _testimpl_image_decoder_consistency(img_out_type, file_fmt, path, subdir='*', ext=None):
     eps = 1
     if file_fmt == 'jpeg' or file_fmt == 'mixed':
@@ -258,6 +323,76 @@ def test_image_decoder_consistency():
             yield _testimpl_image_decoder_consistency, out_img_type, file_fmt, path, subdir, ext
 
 
+def _testimpl_imgcodec_decoder_consistency(device, file_fmt, path):
+    eps = 4 if file_fmt in ['jpeg', 'mixed'] else 1
+    files = get_img_files(os.path.join(test_data_root, path))
+    compare_pipelines(
+        img_decoder_pipe(device, out_type=types.RGB, files=files),
+        imgcodec_decoder_pipe(device, out_type=types.RGB, files=files),
+        batch_size=batch_size_test, N_iterations=3, eps=eps)
+
+
+def test_imgcodec_decoder_consistency():
+    # several iterations, so that the split between the decoders is tuned
+    for device in ['cpu', 'mixed']:
+        for file_fmt in ['jpeg', 'mixed', 'png', 'bmp']:
+            path = os.path.join(good_path, file_fmt)
+            yield _testimpl_imgcodec_decoder_consistency, device, file_fmt, path
+
+
+def _testimpl_imgcodec_decoder_postprocessing(file_fmt, output_layout, mirror):
+    files = get_img_files(os.path.join(test_data_root, good_path, file_fmt))
+    mean = [0.485, 0.456, 0.406]
+    std = [0.229, 0.224, 0.225]
+
+    @pipeline_def(batch_size=batch_size_test, device_id=0, num_threads=4)
+    def fused_pipe():
+        encoded, _ = fn.readers.file(files=files)
+        return fn.experimental.decoders.image(encoded, device='mixed', dtype=types.FLOAT,
+                                              output_layout=output_layout, mean=mean, std=std,
+                                              mirror=mirror, adjust_orientation=False)
+
+    @pipeline_def(batch_size=batch_size_test, device_id=0, num_threads=4)
+    def reference_pipe():
+        encoded, _ = fn.readers.file(files=files)
+        decoded = fn.experimental.decoders.image(encoded, device='mixed',
+                                                 adjust_orientation=False)
+        # the decoder takes the values in the range of the output type, CMN - of the input
+        return fn.crop_mirror_normalize(decoded, dtype=types.FLOAT, output_layout=output_layout,
+                                        mean=[m * 255 for m in mean],
+                                        std=[s * 255 for s in std], mirror=mirror)
+
+    compare_pipelines(fused_pipe(), reference_pipe(), batch_size=batch_size_test,
+                      N_iterations=3, eps=1e-4)
+
+
+def test_imgcodec_decoder_postprocessing():
+    for file_fmt in ['jpeg', 'png', 'tiff', 'bmp']:
+        for output_layout in ['HWC', 'CHW']:
+            for mirror in [False, True]:
+                yield _testimpl_imgcodec_decoder_postprocessing, file_fmt, output_layout, mirror
+
+
+def _testimpl_parse_image_info(file_fmt, device):
+    data_path = os.path.join(test_data_root, good_path, file_fmt)
+
+    @pipeline_def(batch_size=batch_size_test, device_id=0, num_threads=4)
+    def pipe(parse_image_info):
+        encoded, _ = fn.readers.file(file_root=data_path, parse_image_info=parse_image_info)
+        decoded = fn.experimental.decoders.image(encoded, device=device)
+        return fn.peek_image_shape(encoded), decoded
+
+    # the shapes parsed by the reader are the same as the ones parsed by the operators
+    compare_pipelines(pipe(parse_image_info=True), pipe(parse_image_info=False),
+                      batch_size=batch_size_test, N_iterations=3)
+
+
+def test_parse_image_info():
+    for file_fmt in ['jpeg', 'png', 'bmp']:
+        for device in ['cpu', 'mixed']:
+            yield _testimpl_parse_image_info, file_fmt, device
+
+
 def _testimpl_image_decoder_tiff_with_alpha_16bit(device, out_type, path, ext):
     @pipeline_def(batch_size=1, device_id=0, num_threads=1)
     def pipe(device, out_type, files):
@@ -16,6 +16,7 @@ from nvidia.dali.pipeline import Pipeline, DataNode
 import nvidia.dali.ops as ops
 import nvidia.dali.types as types
 import nvidia.dali.math as math
+import nvidia.dali.fn as fn
 from nvidia.dali.tensors import TensorListGPU
 import numpy as np
 from nose.tools import assert_equals
@@ -793,3 +794,40 @@ def test_prohibit_min_max():
                          " be used for truth evaluation in regular Python context."))
 def test_bool_raises():
     bool(DataNode("dummy"))
+
+
+def check_nested_expression(device):
+    batch_size = 4
+    rng = np.random.default_rng(42)
+    x_data = [rng.uniform(-10, 10, (100, 30)).astype(np.float32) for _ in range(batch_size)]
+    y_data = [rng.uniform(-10, 10, (100, 30)).astype(np.float32) for _ in range(batch_size)]
+    i_data = [rng.integers(-100, 100, (100, 30), dtype=np.int32) for _ in range(batch_size)]
+
+    pipe = Pipeline(batch_size=batch_size, num_threads=3, device_id=0)
+    with pipe:
+        x, y, i = fn.external_source(source=lambda: (x_data, y_data, i_data), num_outputs=3,
+                                     device=device)
+        # evaluated in float
+        out_float = math.clamp((x * 2 - y) / 3 + math.sqrt(math.abs(y)), -5, 5)
+        # with integer and boolean nodes
+        out_int = (x > y) * i + (i * 3 - 1)
+        pipe.set_outputs(out_float, out_int)
+    pipe.build()
+    # The nested arithmetic operators are fused
+    arithm_ops = [op for op in pipe._ops if type(op._op).__name__ == "ArithmeticGenericOp"]
+    assert_equals(len(arithm_ops), 2)
+
+    out_float, out_int = pipe.run()
+    if device == "gpu":
+        out_float, out_int = out_float.as_cpu(), out_int.as_cpu()
+    for s in range(batch_size):
+        x, y, i = x_data[s], y_data[s], i_data[s]
+        ref_float = np.clip((x * 2 - y) / 3 + np.sqrt(np.abs(y)), -5, 5)
+        ref_int = (x > y) * i + (i * 3 - 1)
+        np.testing.assert_allclose(out_float.at(s), ref_float, rtol=1e-6, atol=1e-6)
+        np.testing.assert_array_equal(out_int.at(s), ref_int)
+
+
+def test_nested_expression():
+    for device in ["cpu", "gpu"]:
+        yield check_nested_expression, device
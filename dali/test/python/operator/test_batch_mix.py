@@ -0,0 +1,95 @@
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import numpy as np
+import random
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+from nvidia.dali import pipeline_def
+from nose_utils import assert_raises
+
+random.seed(1234)
+
+
+def sample_value(i):
+    return (i + 1) * 10
+
+
+def make_batch(batch_size, dtype):
+    # each image is filled with a value identifying the sample, the labels are one-hot
+    images, labels = [], []
+    for i in range(batch_size):
+        h, w = random.randint(10, 100), random.randint(10, 100)
+        images.append(np.full((h, w, 3), sample_value(i), dtype=dtype))
+        labels.append(np.eye(batch_size, dtype=np.float32)[i])
+    return images, labels
+
+
+@pipeline_def(batch_size=8, num_threads=3, device_id=0, seed=1234)
+def batch_mix_pipe(in_images, in_labels, **kwargs):
+    images = fn.external_source(source=lambda: in_images, device='gpu', layout='HWC')
+    labels = fn.external_source(source=lambda: in_labels, device='gpu')
+    return fn.experimental.batch_mix(images, labels, **kwargs)
+
+
+def check_batch_mix(dtype, mode, probability):
+    batch_size = 8
+    images, labels = make_batch(batch_size, dtype)
+    pipe = batch_mix_pipe(images, labels, mode=mode, probability=probability,
+                          area_range=[0.1, 0.5])
+    pipe.build()
+    for _ in range(3):
+        out_images, out_labels = pipe.run()
+        out_images, out_labels = out_images.as_cpu(), out_labels.as_cpu()
+        for i in range(batch_size):
+            img, label = np.array(out_images[i]), np.array(out_labels[i])
+            assert img.shape == images[i].shape
+            np.testing.assert_allclose(np.sum(label), 1, atol=1e-5)
+            # the label weights are the fractions of the image covered by each source
+            covered = 0
+            for j in range(batch_size):
+                fraction = np.mean(np.abs(img.astype(np.float32) - sample_value(j)) < 1e-3)
+                np.testing.assert_allclose(fraction, label[j], atol=1e-5)
+                covered += fraction
+            np.testing.assert_allclose(covered, 1, atol=1e-5)
+            if probability == 0:
+                np.testing.assert_array_equal(img, images[i])
+
+
+def test_batch_mix():
+    for dtype in [np.uint8, np.float32]:
+        for mode in ['cutmix', 'mosaic']:
+            for probability in [0, 0.5, 1]:
+                yield check_batch_mix, dtype, mode, probability
+
+
+def test_batch_mix_images_only():
+    @pipeline_def(batch_size=4, num_threads=3, device_id=0)
+    def pipe():
+        images = fn.random.uniform(range=[0, 255], shape=[20, 30, 3], dtype=types.UINT8)
+        return fn.experimental.batch_mix(images.gpu(), mode='mosaic')
+
+    p = pipe()
+    p.build()
+    out, = p.run()
+    assert np.array(out.as_cpu()[0]).shape == (20, 30, 3)
+
+
+def test_batch_mix_wrong_mode():
+    images, labels = make_batch(8, np.uint8)
+    pipe = batch_mix_pipe(images, labels, mode='mixup')
+    with assert_raises(RuntimeError, glob='Unknown mode: "mixup"'):
+        pipe.build()
+        pipe.run()
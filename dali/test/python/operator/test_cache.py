@@ -0,0 +1,80 @@
+# Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import tempfile
+import nvidia.dali.fn as fn
+from nvidia.dali import pipeline_def
+from test_utils import check_batch, get_dali_extra_path
+
+batch_size = 8
+images_dir = os.path.join(get_dali_extra_path(), 'db', 'single', 'jpeg')
+
+
+@pipeline_def(batch_size=batch_size, num_threads=4, device_id=0)
+def cache_pipe(device, cache_name, random_size=False, **cache_args):
+    jpegs, _ = fn.readers.file(file_root=images_dir, name="Reader")
+    size = fn.random.uniform(range=[100, 200]) if random_size else 150
+    decoder_device = "mixed" if device == "gpu" else "cpu"
+
+    def decode_and_resize(jpegs, size):
+        images = fn.decoders.image(jpegs, device=decoder_device, hw_decoder_load=0)
+        return fn.resize(images, resize_x=size, resize_y=size)
+
+    hit = fn.experimental.cache_lookup(jpegs, cache_name=cache_name, **cache_args)
+    cached_jpegs, new_jpegs = fn._conditional.split(jpegs, predicate=hit)
+    if random_size:
+        _, new_size = fn._conditional.split(size, predicate=hit)
+    else:
+        new_size = size
+    # only the samples which are not in the cache are decoded and resized
+    images = decode_and_resize(new_jpegs, new_size)
+    images = fn.experimental.cache_store(images, new_jpegs, cache_name=cache_name)
+    cached = fn.experimental.cache_fetch(cached_jpegs, cache_name=cache_name, device=device)
+    images = fn._conditional.merge(cached, images, predicate=hit)
+    return hit, images, decode_and_resize(jpegs, size)
+
+
+def _test_cache(device):
+    with tempfile.TemporaryDirectory() as disk_path:
+        # the images don't fit in the GPU or host memory alone
+        pipe = cache_pipe(device, f"test_cache_{device}", gpu_size=1, host_size=1,
+                          disk_size=64, disk_path=disk_path)
+        pipe.build()
+        iters = (pipe.epoch_size("Reader") + batch_size - 1) // batch_size
+        for epoch in range(3):
+            for _ in range(iters):
+                hit, images, ref = pipe.run()
+                if device == "gpu":
+                    images, ref = images.as_cpu(), ref.as_cpu()
+                check_batch(images, ref, batch_size, max_allowed_error=1,
+                            expected_layout="HWC")
+                # the lookups of the next epoch may run before the last samples are stored
+                if epoch == 2:
+                    assert all(hit.as_array())
+        del pipe
+
+
+def test_cache():
+    for device in ["cpu", "gpu"]:
+        yield _test_cache, device
+
+
+def test_cache_bypassed_when_random():
+    pipe = cache_pipe("cpu", "test_cache_random", random_size=True, host_size=64)
+    pipe.build()
+    for _ in range(2 * pipe.epoch_size("Reader") // batch_size + 1):
+        hit, images, ref = pipe.run()
+        assert not any(hit.as_array())
+        check_batch(images, ref, batch_size, max_allowed_error=1)
@@ -177,3 +177,41 @@ def test_operator_cast_empty_volumes():
                 ]:
                     yield (_test_operator_cast, ndim, batch_size, in_type, out_type, device,
                            empty_volume_policy)
+
+
+def ref_round_bfloat16(x):
+    # round float32 to the nearest bfloat16, with ties to even, and convert back to float32
+    bits = x.astype(np.float32).view(np.uint32).astype(np.uint64)
+    bits = (bits + 0x7fff + ((bits >> 16) & 1)) >> 16 << 16
+    return bits.astype(np.uint32).view(np.float32)
+
+
+@nottest
+def _test_cast_bfloat16(device):
+    batch_size = 8
+
+    def src():
+        return [rng.uniform(-1000, 1000, size=(10, 20)).astype(np.float32)
+                for _ in range(batch_size)]
+
+    @pipeline_def(batch_size=batch_size, num_threads=4,
+                  device_id=types.CPU_ONLY_DEVICE_ID if device == 'cpu' else 0)
+    def cast_pipe():
+        inp = fn.external_source(src)
+        inp_dev = inp.gpu() if device == 'gpu' else inp
+        bf16 = fn.cast(inp_dev, dtype=types.BFLOAT16)
+        return inp, fn.cast(bf16, dtype=types.FLOAT)
+
+    pipe = cast_pipe()
+    pipe.build()
+    for _ in range(3):
+        inp, out = pipe.run()
+        if device == 'gpu':
+            out = out.as_cpu()
+        for i in range(batch_size):
+            assert np.array_equal(np.array(out[i]), ref_round_bfloat16(np.array(inp[i])))
+
+
+def test_cast_bfloat16():
+    for device in ['cpu', 'gpu']:
+        yield _test_cast_bfloat16, device
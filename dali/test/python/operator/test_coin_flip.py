@@ -1,4 +1,4 @@
-# Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+# Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -74,3 +74,29 @@ def test_coin_flip():
         ]:
             for probability in [None, 0.7, 0.5, 0.0, 1.0]:
                 yield check_coin_flip, device, batch_size, max_shape, probability, use_shape_like_in
+
+
+def check_cpu_gpu_equal(op, batch_size, **kwargs):
+    pipe = Pipeline(batch_size=batch_size, device_id=0, num_threads=3, seed=4321)
+    with pipe:
+        shape = dali.fn.random.uniform(range=[1000, 5000], shape=[1], dtype=dali.types.INT32)
+        cpu = op(device='cpu', shape=shape, seed=1234, **kwargs)
+        gpu = op(device='gpu', shape=shape, seed=1234, **kwargs)
+        pipe.set_outputs(cpu, gpu)
+    pipe.build()
+    for _ in range(3):
+        cpu, gpu = pipe.run()
+        gpu = gpu.as_cpu()
+        for i in range(batch_size):
+            np.testing.assert_array_equal(np.array(cpu[i]), np.array(gpu[i]))
+
+
+def test_cpu_gpu_equal():
+    # The random number generator is counter-based, so the backends produce the same values
+    batch_size = 4
+    for op, kwargs in [
+        (dali.fn.random.coin_flip, {'probability': 0.3}),
+        (dali.fn.random.uniform, {'range': [-1, 1]}),
+        (dali.fn.random.uniform, {'values': [0, 1, 2, 3, 4]}),
+    ]:
+        yield check_cpu_gpu_equal, op, batch_size, kwargs
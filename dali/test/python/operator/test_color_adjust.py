@@ -0,0 +1,129 @@
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+from nvidia.dali import pipeline_def
+
+from nose_utils import assert_raises
+from sequences_test_utils import ArgCb, video_suite_helper
+from test_utils import RandomDataIterator
+
+batch_size = 8
+
+
+def check_outputs(out, ref, abs_err):
+    for i in range(batch_size):
+        a = np.array(out.at(i), dtype=np.float32)
+        b = np.array(ref.at(i), dtype=np.float32)
+        assert np.allclose(a, b, atol=abs_err), f"max diff: {np.max(np.abs(a - b))}"
+
+
+def test_chain_equivalence():
+    """The fused adjustment matches the chain of the operators run with float intermediates"""
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0, seed=1234)
+    def pipe(device):
+        imgs = fn.external_source(
+            source=RandomDataIterator(batch_size, shape=(31, 47, 3), dtype=np.uint8))
+        if device == "gpu":
+            imgs = imgs.gpu()
+        hue = fn.random.uniform(range=[-30, 30])
+        sat = fn.random.uniform(range=[0, 2])
+        val = fn.random.uniform(range=[0.5, 1.5])
+        bri = fn.random.uniform(range=[0.5, 1.5])
+        con = fn.random.uniform(range=[0.5, 1.5])
+        shift = fn.random.uniform(range=[-0.1, 0.1])
+        fused = fn.experimental.color_adjust(imgs, hue=hue, saturation=sat, value=val,
+                                             brightness=bri, contrast=con, brightness_shift=shift,
+                                             contrast_center=128)
+        chained = fn.hsv(imgs, hue=hue, saturation=sat, value=val, dtype=types.FLOAT)
+        chained = fn.brightness_contrast(chained, brightness=bri, contrast=con,
+                                         brightness_shift=shift, contrast_center=128,
+                                         dtype=types.UINT8)
+        return fused, chained
+
+    for device in ["cpu", "gpu"]:
+        p = pipe(device)
+        p.build()
+        for _ in range(2):
+            fused, chained = p.run()
+            if device == "gpu":
+                fused, chained = fused.as_cpu(), chained.as_cpu()
+            check_outputs(fused, chained, 1)
+
+
+def ref_gamma_ycbcr(img, gamma):
+    x = np.clip(img.astype(np.float32) / 255, 0, 1) ** gamma * 255
+    m = np.array([[0.299, 0.587, 0.114],
+                  [-0.16873589, -0.33126411, 0.5],
+                  [0.5, -0.41868759, -0.08131241]])
+    out = np.matmul(x, m.transpose()) + np.array([0, 128, 128])
+    return np.round(np.clip(out, 0, 255))
+
+
+def test_gamma_and_color_space():
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0, seed=1234)
+    def pipe():
+        imgs = fn.external_source(
+            source=RandomDataIterator(batch_size, shape=(20, 30, 3), dtype=np.uint8))
+        bgr = fn.color_space_conversion(imgs, image_type=types.RGB, output_type=types.BGR)
+        gamma = fn.random.uniform(range=[0.4, 2.5])
+        outs = [fn.experimental.color_adjust(inp, gamma=gamma, image_type=types.BGR,
+                                             output_image_type=types.YCbCr)
+                for inp in [bgr, bgr.gpu()]]
+        return (imgs, gamma, *outs)
+
+    p = pipe()
+    p.build()
+    for _ in range(2):
+        imgs, gamma, out_cpu, out_gpu = p.run()
+        out_gpu = out_gpu.as_cpu()
+        for i in range(batch_size):
+            ref = ref_gamma_ycbcr(imgs.at(i), gamma.at(i))
+            for out in [out_cpu, out_gpu]:
+                assert np.allclose(out.at(i), ref, atol=1)
+
+
+def test_wrong_args():
+    @pipeline_def(batch_size=1, num_threads=1, device_id=0)
+    def pipe(**kwargs):
+        data = fn.constant(idata=255, shape=(10, 10, 3), dtype=types.UINT8)
+        return fn.experimental.color_adjust(data, **kwargs)
+
+    with assert_raises(RuntimeError, glob="must be an RGB or BGR image"):
+        p = pipe(image_type=types.GRAY)
+        p.build()
+    with assert_raises(RuntimeError, glob="`gamma` must be positive"):
+        p = pipe(gamma=0.)
+        p.build()
+        p.run()
+
+
+def test_video():
+    def hue(sample_desc):
+        return np.float32(360 * sample_desc.rng.random())
+
+    def gamma(sample_desc):
+        return np.float32(0.5 + sample_desc.rng.random())
+
+    video_test_cases = [
+        (fn.experimental.color_adjust, {}, [ArgCb("hue", hue, True)]),
+        (fn.experimental.color_adjust, {"saturation": 0.5}, [
+            ArgCb("hue", hue, False),
+            ArgCb("gamma", gamma, True),
+        ]),
+    ]
+
+    yield from video_suite_helper(video_test_cases, test_channel_first=False)
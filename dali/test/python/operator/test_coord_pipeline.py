@@ -0,0 +1,139 @@
+# Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+from nvidia.dali import pipeline_def
+
+from nose_utils import assert_raises
+from test_utils import as_array
+
+rng = np.random.default_rng(1234)
+
+
+def make_boxes(batch_size, ndim, ltrb):
+    batch = []
+    for _ in range(batch_size):
+        n = rng.integers(0, 20)
+        start = rng.uniform(0, 200, size=(n, ndim))
+        size = rng.uniform(0, 100, size=(n, ndim))
+        batch.append(np.concatenate([start, start + size if ltrb else size], axis=1)
+                     .astype(np.float32))
+    return batch
+
+
+def make_points(batch_size, ndim):
+    return [rng.uniform(0, 300, size=(rng.integers(0, 20), ndim)).astype(np.float32)
+            for _ in range(batch_size)]
+
+
+def ref_points(points, M, T, normalize, flip, center, clip):
+    out = points @ M.T + T
+    out = out / normalize
+    out = np.where(flip, 2 * center - out, out)
+    if clip:
+        out = np.clip(out, 0, 1)
+    return out
+
+
+def ref_boxes(boxes, M, T, normalize, flip, center, clip, ltrb):
+    ndim = boxes.shape[1] // 2
+    lo = boxes[:, :ndim]
+    hi = boxes[:, ndim:] if ltrb else lo + boxes[:, ndim:]
+    corners = []
+    for c in range(1 << ndim):
+        corner = np.where([(c >> d) & 1 for d in range(ndim)], hi, lo)
+        corners.append(ref_points(corner, M, T, normalize, flip, center, clip))
+    out_lo = np.min(corners, axis=0)
+    out_hi = np.max(corners, axis=0)
+    return np.concatenate([out_lo, out_hi if ltrb else out_hi - out_lo], axis=1)
+
+
+def check_coord_pipeline(device, ndim, boxes, ltrb, use_matrix, clip, batch_size=5):
+    M = rng.uniform(0.5, 2, size=(ndim, ndim)).astype(np.float32)
+    if not use_matrix:
+        M = np.diag(np.diag(M))
+    T = rng.uniform(-20, 20, size=ndim).astype(np.float32)
+    normalize = rng.uniform(100, 400, size=ndim).astype(np.float32)
+    center = rng.uniform(0.3, 0.7, size=ndim).astype(np.float32)
+    data = make_boxes(batch_size, ndim, ltrb) if boxes else make_points(batch_size, ndim)
+    flips = [rng.integers(0, 2, size=ndim).astype(np.int32) for _ in range(batch_size)]
+
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def pipe():
+        coords = fn.external_source(source=lambda: data, batch=True, device=device)
+        flip = fn.external_source(source=lambda: flips, batch=True)
+        return fn.coord_pipeline(coords, M=M.flatten(), T=T, normalize=normalize, flip=flip,
+                                 flip_center=center, clip=clip, boxes=boxes, ltrb=ltrb)
+
+    p = pipe()
+    p.build()
+    out, = p.run()
+    for i in range(batch_size):
+        if boxes:
+            ref = ref_boxes(data[i], M, T, normalize, flips[i], center, clip, ltrb)
+        else:
+            ref = ref_points(data[i], M, T, normalize, flips[i], center, clip)
+        np.testing.assert_allclose(as_array(out[i]), ref, rtol=1e-4, atol=1e-4)
+
+
+def test_coord_pipeline():
+    for device in ["cpu", "gpu"]:
+        for ndim in [1, 2, 3]:
+            for boxes, ltrb in [(False, True), (True, True), (True, False)]:
+                for use_matrix in [False, True]:
+                    for clip in [False, True]:
+                        yield check_coord_pipeline, device, ndim, boxes, ltrb, use_matrix, clip
+
+
+def test_same_as_chain():
+    batch_size = 4
+    data = make_boxes(batch_size, 2, True)
+
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def pipe():
+        boxes = fn.external_source(source=lambda: data, batch=True, device="gpu")
+        flip = fn.random.coin_flip(seed=42)
+        relative = fn.coord_transform(boxes, M=1 / 200)
+        flipped = fn.bb_flip(relative, ltrb=True, horizontal=flip)
+        fused = fn.coord_pipeline(boxes, boxes=True, normalize=200,
+                                  flip=fn.stack(flip, fn.cast(0, dtype=types.INT32)))
+        return flipped, fused
+
+    p = pipe()
+    p.build()
+    chain, fused = p.run()
+    for i in range(batch_size):
+        np.testing.assert_allclose(as_array(chain[i]), as_array(fused[i]), rtol=1e-5, atol=1e-6)
+
+
+def test_wrong_args():
+    @pipeline_def(batch_size=1, num_threads=3, device_id=0)
+    def pipe(**kwargs):
+        coords = fn.external_source(source=lambda: [np.zeros((3, 4), np.float32)], batch=True)
+        return fn.coord_pipeline(coords, **kwargs)
+
+    with assert_raises(RuntimeError, glob="must keep the number of dimensions"):
+        p = pipe(boxes=True, M=[1, 0])
+        p.build()
+        p.run()
+    with assert_raises(RuntimeError, glob="Unsupported number of dimensions of the points"):
+        p = pipe()
+        p.build()
+        p.run()
+    with assert_raises(RuntimeError, glob="must not be 0"):
+        p = pipe(boxes=True, normalize=[1, 0])
+        p.build()
+        p.run()
@@ -0,0 +1,105 @@
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+import zlib
+from nose import SkipTest
+from nvidia.dali import pipeline_def
+
+from nose_utils import assert_raises
+
+batch_size = 8
+sample_shape = (64, 80)
+
+
+def compress_deflate(data):
+    compressor = zlib.compressobj(wbits=-15)
+    return compressor.compress(data) + compressor.flush()
+
+
+def compress_lz4(data):
+    import lz4.block
+    return lz4.block.compress(data, store_size=False)
+
+
+def compress_zstd(data):
+    import zstandard
+    return zstandard.ZstdCompressor().compress(data)
+
+
+compressors = {
+    "deflate": compress_deflate,
+    "lz4": compress_lz4,
+    "zstd": compress_zstd,
+}
+
+
+def make_batch(seed):
+    rng = np.random.default_rng(seed)
+    # few distinct values, so that the data compresses
+    return [rng.integers(0, 4, size=sample_shape).astype(np.float16) for _ in range(batch_size)]
+
+
+def check_decompress(codec, with_shape):
+    if not hasattr(fn.experimental, "decompress"):
+        raise SkipTest("DALI was built without nvCOMP")
+    compress = compressors[codec]
+    try:
+        compress(b"")
+    except ImportError:
+        raise SkipTest(f"No Python module to compress the data with {codec}")
+    ref = make_batch(123)
+
+    def source():
+        return [np.frombuffer(compress(x.tobytes()), dtype=np.uint8) for x in ref]
+
+    @pipeline_def(batch_size=batch_size, num_threads=1, device_id=0)
+    def pipe():
+        data = fn.external_source(source=source, batch=True, cycle=False)
+        shape_arg = {"shape": list(sample_shape)} if with_shape else {}
+        return fn.experimental.decompress(data.gpu(), codec=codec, dtype=types.FLOAT16,
+                                          **shape_arg)
+
+    p = pipe()
+    p.build()
+    out, = p.run()
+    out = out.as_cpu()
+    for i in range(batch_size):
+        expected = ref[i] if with_shape else ref[i].flatten()
+        np.testing.assert_array_equal(out.at(i), expected)
+
+
+def test_decompress():
+    for codec in compressors:
+        for with_shape in [True, False]:
+            yield check_decompress, codec, with_shape
+
+
+def test_wrong_shape():
+    if not hasattr(fn.experimental, "decompress"):
+        raise SkipTest("DALI was built without nvCOMP")
+
+    @pipeline_def(batch_size=1, num_threads=1, device_id=0)
+    def pipe():
+        data = fn.external_source(
+            source=lambda: [np.frombuffer(compress_deflate(b"\0" * 100), dtype=np.uint8)],
+            batch=True)
+        return fn.experimental.decompress(data.gpu(), codec="deflate", shape=[200])
+
+    p = pipe()
+    p.build()
+    with assert_raises(RuntimeError, glob="*decompresses to 100 bytes*"):
+        p.run()
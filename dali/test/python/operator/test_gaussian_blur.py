@@ -160,6 +160,12 @@ def test_gaussian_blur_cpu_gpu():
         yield check_gaussian_blur_cpu_gpu, 10, None, window_size
 
 
+def test_gaussian_blur_cpu_gpu_large_window():
+    # the large windows are convolved in the frequency domain on the GPU
+    for sigma, window_size in [(20.0, None), (None, [101, 15]), (None, 301)]:
+        yield check_gaussian_blur_cpu_gpu, 4, sigma, window_size
+
+
 @attr('slow')
 def slow_test_gaussian_blur_cpu_gpu():
     for sigma in [1.0, [1.0, 2.0], None]:
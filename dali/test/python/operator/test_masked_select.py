@@ -0,0 +1,107 @@
+# Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http:#www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import nvidia.dali.fn as fn
+from nvidia.dali import pipeline_def
+
+from nose_utils import assert_raises
+
+batch_size = 9
+
+
+def get_data(shapes, dtypes, max_len, seed, p=0.5):
+    """Returns a batch of masks and a batch of data for each of ``shapes`` (the inner extents)"""
+    rng = np.random.default_rng(seed)
+    masks = []
+    data = [[] for _ in shapes]
+    for i in range(batch_size):
+        n = 0 if i == 3 else int(rng.integers(1, max_len))
+        masks.append(rng.random(n) < p)
+        for k, (shape, dtype) in enumerate(zip(shapes, dtypes)):
+            data[k].append(rng.integers(-100, 100, size=(n, *shape)).astype(dtype))
+    # a mask without any selected elements and one with all of them
+    masks[1][:] = False
+    masks[2][:] = True
+    return masks, data
+
+
+@pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+def masked_select_pipe(device, masks, data):
+    mask = fn.external_source(source=lambda: masks, batch=True)
+    inputs = [fn.external_source(source=lambda d=d: d, batch=True) for d in data]
+    if device == "gpu":
+        mask = mask.gpu()
+        inputs = [x.gpu() for x in inputs]
+    out = fn.masked_select(mask, *inputs)
+    return tuple(out) if isinstance(out, list) else (out,)
+
+
+def as_cpu(batch):
+    return batch.as_cpu() if hasattr(batch, "as_cpu") else batch
+
+
+def check_masked_select(device, shapes, dtypes, max_len):
+    masks, data = get_data(shapes, dtypes, max_len, seed=len(shapes) * max_len)
+    pipe = masked_select_pipe(device, masks, data)
+    pipe.build()
+    outs = pipe.run()
+    assert len(outs) == len(data)
+    for out, batch in zip(outs, data):
+        out = as_cpu(out)
+        for i in range(batch_size):
+            ref = batch[i][masks[i]]
+            sample = np.array(out[i])
+            assert sample.dtype == ref.dtype
+            assert sample.shape == ref.shape, f"{sample.shape} vs {ref.shape}"
+            assert np.array_equal(sample, ref)
+
+
+def test_masked_select():
+    # boxes and labels
+    for device in ["cpu", "gpu"]:
+        yield check_masked_select, device, [(4,), ()], [np.float32, np.int32], 50
+
+
+def test_masked_select_row_sizes():
+    # the rows of 3 bytes, of 400 bytes (copied by warps on the GPU) and empty rows
+    shapes = [(3,), (10, 10), (0,), (2,)]
+    dtypes = [np.uint8, np.float32, np.float32, np.int64]
+    for device in ["cpu", "gpu"]:
+        yield check_masked_select, device, shapes, dtypes, 30
+
+
+def test_masked_select_long():
+    # the masks span many tiles of the GPU implementation
+    for device in ["cpu", "gpu"]:
+        yield check_masked_select, device, [(), (2,)], [np.int16, np.float64], 20000
+
+
+def check_error(device, masks, data, glob):
+    pipe = masked_select_pipe(device, masks, data)
+    pipe.build()
+    with assert_raises(RuntimeError, glob=glob):
+        pipe.run()
+
+
+def test_masked_select_errors():
+    masks = [np.ones(5, dtype=bool)] * batch_size
+    data = [[np.zeros((5, 2), dtype=np.float32)] * batch_size]
+    for device in ["cpu", "gpu"]:
+        yield (check_error, device, [np.ones(5, dtype=np.uint8)] * batch_size, data,
+               "The mask must be of type bool*")
+        yield (check_error, device, [np.ones((5, 1), dtype=bool)] * batch_size, data,
+               "The mask must be 1D*")
+        yield (check_error, device, masks, [[np.zeros((4, 2), dtype=np.float32)] * batch_size],
+               "*outermost extent of the input 1 doesn't match the length of the mask*")
@@ -14,6 +14,7 @@
 
 from nvidia.dali.pipeline import Pipeline
 import nvidia.dali.ops as ops
+import nvidia.dali.fn as fn
 import numpy as np
 from functools import partial
 from test_utils import compare_pipelines
@@ -149,3 +150,36 @@ def test_operator_mel_filter_bank_vs_python():
                         yield check_operator_mel_filter_bank_vs_python, device, batch_size, shape, \
                             nfilter, sample_rate, freq_low, freq_high, normalize, mel_formula, \
                             layout
+
+
+def check_mel_filter_bank_to_decibels(device, batch_size, shape, layout):
+    f_axis = layout.find('f')
+    min_shape = [1 for _ in shape]
+    min_shape[f_axis] = shape[f_axis]
+    iterator = RandomlyShapedDataIterator(
+        batch_size, min_shape=min_shape, max_shape=shape, dtype=np.float32)
+    pipe = Pipeline(batch_size, 1, 0)
+    with pipe:
+        data = fn.external_source(source=iterator, layout=layout)
+        if device == 'gpu':
+            data = data.gpu()
+        mel = fn.mel_filter_bank(data, device=device, nfilter=64, sample_rate=16000.0)
+        separate = fn.to_decibels(mel, multiplier=20.0, reference=0.5, cutoff_db=-60.0)
+        fused = fn.mel_filter_bank(data, device=device, nfilter=64, sample_rate=16000.0,
+                                   to_decibels=True, decibels_multiplier=20.0,
+                                   decibels_reference=0.5, decibels_cutoff=-60.0)
+        pipe.set_outputs(separate, fused)
+    pipe.build()
+    for _ in range(3):
+        separate, fused = pipe.run()
+        if device == 'gpu':
+            separate, fused = separate.as_cpu(), fused.as_cpu()
+        for s in range(batch_size):
+            np.testing.assert_allclose(np.array(separate[s]), np.array(fused[s]),
+                                       rtol=1e-4, atol=1e-3)
+
+
+def test_mel_filter_bank_to_decibels():
+    for device in ['cpu', 'gpu']:
+        for shape, layout in [((257, 100), 'ft'), ((100, 257), 'tf')]:
+            yield check_mel_filter_bank_to_decibels, device, 3, shape, layout
@@ -14,8 +14,11 @@
 
 from nvidia.dali.pipeline import Pipeline
 from nvidia.dali import backend
+import nvidia.dali.fn as fn
 import nvidia.dali.ops as ops
 import numpy as np
+import ctypes
+from nose_utils import assert_raises
 from test_utils import dali_type
 
 
@@ -438,3 +441,50 @@ def test_types():
             for in_type in [None, np.uint8, np.int16, np.float32]:
                 yield _run_test, device, batch_size, dim, axes, None, False, \
                     out_type, in_type, shift, scale
+
+
+def test_cross_device_group():
+    # A group of one device - the sum across the devices is an identity, but it must be called
+    # exactly once per iteration with all the power sums (count, sum, sum of squares).
+    calls = []
+    sum_fn_type = ctypes.CFUNCTYPE(None, ctypes.c_void_p, ctypes.c_size_t, ctypes.c_void_p,
+                                   ctypes.c_void_p)
+    sum_fn = sum_fn_type(lambda data, count, stream, user_data: calls.append(count))
+    backend.SetCrossDeviceSum("test_group", ctypes.cast(sum_fn, ctypes.c_void_p).value)
+    batch_size = 6
+    axes = [0, 1]
+    try:
+        data = [generate_data(3, batch_size, True, axes) for _ in range(2)]
+        for mean, stddev in [(None, None), (None, 2.0), (1.0, None)]:
+            pipe = Pipeline(batch_size=batch_size, num_threads=3, device_id=0)
+            with pipe:
+                inp = fn.external_source(source=data, cycle=True, device="gpu")
+                pipe.set_outputs(fn.normalize(inp, axes=axes, batch=True, mean=mean,
+                                              stddev=stddev, ddof=1, epsilon=1e-3,
+                                              cross_device_group="test_group"))
+            pipe.build()
+            for it in range(2):
+                calls.clear()
+                out, = pipe.run()
+                assert calls == [3 * data[it][0].shape[2]], calls
+                ref = batch_norm(data[it], axes, mean, stddev, ddof=1, eps=1e-3)
+                check_float(to_list(out.as_cpu()), ref)
+    finally:
+        backend.SetCrossDeviceSum("test_group", 0)
+
+
+def test_cross_device_group_errors():
+    def run(device="gpu", **kwargs):
+        pipe = Pipeline(batch_size=1, num_threads=1, device_id=0)
+        with pipe:
+            data = fn.random.uniform(shape=[10, 3], device=device)
+            pipe.set_outputs(fn.normalize(data, axes=[0], **kwargs))
+        pipe.build()
+        pipe.run()
+
+    with assert_raises(RuntimeError, glob="*can be used only with batch normalization*"):
+        run(cross_device_group="test_group")
+    with assert_raises(RuntimeError, glob="*supported only by the GPU operator*"):
+        run(device="cpu", batch=True, cross_device_group="test_group")
+    with assert_raises(RuntimeError, glob="*not_registered*"):
+        run(batch=True, cross_device_group="not_registered")
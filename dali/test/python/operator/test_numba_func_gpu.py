@@ -17,10 +17,12 @@ import numpy as np
 import nvidia.dali.fn as fn
 import nvidia.dali.types as dali_types
 import os
+import tempfile
 from distutils.version import LooseVersion
 from nose import SkipTest, with_setup
 from numba import cuda
 from nvidia.dali import pipeline_def
+from nvidia.dali.plugin.numba import experimental as numba_experimental
 from nvidia.dali.plugin.numba.fn.experimental import numba_function
 
 from nose_utils import raises
@@ -56,6 +58,13 @@ def set_consecutive_values_sample(inp, out):
         out[x][y] = y + x * inp.shape[1]
 
 
+def add_sample_idx_batch(inp, out):
+    x, y = cuda.grid(2)
+    sample_idx = cuda.blockIdx.z
+    if sample_idx < out.shape[0] and x < out.shape[1] and y < out.shape[2]:
+        out[sample_idx][x][y] = inp[sample_idx][x][y] + sample_idx
+
+
 def get_data(shapes, dtype):
     return [np.ones(shape, dtype=dtype) for shape in shapes]
 
@@ -121,11 +130,44 @@ def test_numba_func():
 
 
 @with_setup(check_env_compatibility)
-@raises(AssertionError, glob='Currently batch processing for GPU is not supported.')
-def test_batch_processing_assertion():
-    _testimpl_numba_func([(10, 5)], np.uint8, set_all_values_to_255_sample, [dali_types.UINT8],
-                         [dali_types.UINT8], [2], [2], [1, 1, 1], [10, 5, 1], None, True,
-                         [np.full((10, 5), 255, dtype=np.uint8)])
+def test_numba_func_batch_processing():
+    # the whole batch is processed by a single launch, one block per sample
+    for batch_size in [1, 4]:
+        shapes = [(10, 5)] * batch_size
+        expected_out = [np.full((10, 5), 1 + i, dtype=np.float32) for i in range(batch_size)]
+        yield _testimpl_numba_func, shapes, np.float32, add_sample_idx_batch, \
+            [dali_types.FLOAT], [dali_types.FLOAT], [2], [2], [1, 1, batch_size], [10, 5, 1], \
+            None, True, expected_out
+
+
+@with_setup(check_env_compatibility)
+def test_numba_func_kernel_cache():
+    shapes = [(20, 10), (20, 10)]
+    expected_out = [np.arange(20 * 10, dtype=np.float32).reshape((20, 10))] * 2
+    args = (shapes, np.float32, set_consecutive_values_sample, [dali_types.FLOAT],
+            [dali_types.FLOAT], [2], [2], [1, 1, 1], [20, 10, 1], None, False, expected_out)
+    old_dir = os.environ.get("DALI_NUMBA_CACHE_DIR")
+    compile_cuda = cuda.compiler.compile_cuda
+    with tempfile.TemporaryDirectory() as cache_dir:
+        os.environ["DALI_NUMBA_CACHE_DIR"] = cache_dir
+        try:
+            numba_experimental._gpu_kernels.clear()
+            _testimpl_numba_func(*args)
+            assert any(name.endswith(".cubin") for name in os.listdir(cache_dir))
+
+            # a new process would load the kernel from the disk, without compiling it
+            def no_compile(*args, **kwargs):
+                assert False, "The kernel should be loaded from the cache"
+            numba_experimental._gpu_kernels.clear()
+            cuda.compiler.compile_cuda = no_compile
+            _testimpl_numba_func(*args)
+        finally:
+            cuda.compiler.compile_cuda = compile_cuda
+            numba_experimental._gpu_kernels.clear()
+            if old_dir is None:
+                del os.environ["DALI_NUMBA_CACHE_DIR"]
+            else:
+                os.environ["DALI_NUMBA_CACHE_DIR"] = old_dir
 
 
 @with_setup(check_env_compatibility)
@@ -13,7 +13,10 @@
 # limitations under the License.
 from functools import partial
 
+from nvidia.dali import pipeline_def
+from nvidia.dali.backend import TensorListGPU
 from nvidia.dali.pipeline import Pipeline
+import nvidia.dali.fn as fn
 import nvidia.dali.ops as ops
 import nvidia.dali.types as types
 from test_utils import check_batch
@@ -208,3 +211,59 @@ def test_empty_string_axis_name():
 def test_axis_name_no_initial_layout_multi_dim():
     np.random.seed(42)
     check_one_hot_operator(random_3d_tensors_batch, axis=-1, axis_name="O")
+
+
+def check_one_hot_sparse(device, axis, label_smoothing):
+    @pipeline_def(batch_size=batch_size, num_threads=2, device_id=0)
+    def pipe():
+        data = fn.external_source(source=random_3d_tensors_batch)
+        labels = data.gpu() if device == 'gpu' else data
+        # a few labels out of range
+        labels = labels - 1
+        dense = fn.one_hot(labels, num_classes=num_classes, axis=axis, on_value=5, off_value=-1,
+                           label_smoothing=label_smoothing)
+        indices, values = fn.one_hot(labels, num_classes=num_classes, axis=axis, on_value=5,
+                                     off_value=-1, label_smoothing=label_smoothing, sparse=True)
+        return data, dense, indices, values
+
+    p = pipe()
+    p.build()
+    data, dense, indices, values = [as_array_list(out) for out in p.run()]
+    spread = 6 * label_smoothing
+    on_value = 5 - spread + spread / num_classes
+    off_value = -1 + spread / num_classes
+    for i in range(batch_size):
+        labels = data[i] - 1
+        ref = np.full(insert_as_axis(labels.shape, num_classes, axis % 4, 3), off_value,
+                      dtype=np.float32)
+        out_of_range = labels < 0
+        onehot = np.moveaxis(np.eye(num_classes, dtype=bool)[np.maximum(labels, 0)], -1, axis)
+        onehot &= ~np.expand_dims(out_of_range, axis)
+        ref[onehot] = on_value
+        np.testing.assert_allclose(dense[i], ref, rtol=1e-6, atol=1e-6)
+        assert indices[i].shape == (labels.size,) and indices[i].dtype == np.int64
+        assert values[i].shape == (labels.size,)
+        reconstructed = np.full(ref.size, off_value, dtype=np.float32)
+        reconstructed[indices[i]] = values[i]
+        np.testing.assert_allclose(reconstructed.reshape(ref.shape), ref, rtol=1e-6, atol=1e-6)
+        np.testing.assert_allclose(values[i][out_of_range.flatten()], off_value,
+                                   rtol=1e-6, atol=1e-6)
+
+
+def as_array_list(out):
+    if isinstance(out, TensorListGPU):
+        out = out.as_cpu()
+    return [np.array(out[i]) for i in range(len(out))]
+
+
+def test_one_hot_sparse_and_label_smoothing():
+    np.random.seed(42)
+    for device in ['cpu', 'gpu']:
+        for axis in [-1, 0, 2]:
+            for label_smoothing in [0, 0.1]:
+                yield check_one_hot_sparse, device, axis, label_smoothing
+
+
+@raises(RuntimeError, glob='`label_smoothing` must be in range')
+def test_wrong_label_smoothing():
+    check_one_hot_sparse('cpu', -1, 1.5)
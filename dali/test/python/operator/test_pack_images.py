@@ -0,0 +1,122 @@
+# Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import nvidia.dali.fn as fn
+from nvidia.dali import pipeline_def
+
+from nose_utils import assert_raises
+
+batch_size = 12
+canvas_size = (100, 120)
+
+
+def get_data():
+    rng = np.random.default_rng(1234)
+    images = []
+    for i in range(batch_size):
+        h, w = rng.integers(1, 100), rng.integers(1, 120)
+        images.append(rng.integers(0, 255, size=(h, w, 3), dtype=np.uint8))
+    # an empty image is not placed anywhere
+    images[3] = np.zeros((0, 10, 3), dtype=np.uint8)
+    return images
+
+
+@pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+def pack_pipe(device, source=get_data):
+    images = fn.external_source(source=source, layout="HWC", cycle=True)
+    if device == "gpu":
+        images = images.gpu()
+    return images, *fn.experimental.pack_images(images, canvas_size=canvas_size)
+
+
+def as_cpu(batch):
+    return batch.as_cpu() if hasattr(batch, "as_cpu") else batch
+
+
+def check_pack_images(device):
+    pipe = pack_pipe(device)
+    pipe.build()
+    images, canvases, placements = (as_cpu(out) for out in pipe.run())
+    coverage = {}
+    num_canvases = 0
+    for i in range(batch_size):
+        image = np.array(images[i])
+        canvas_idx, y, x, h, w = np.array(placements[i])
+        assert (h, w) == image.shape[:2]
+        if h == 0 or w == 0:
+            assert canvas_idx == -1
+            continue
+        assert y >= 0 and x >= 0 and y + h <= canvas_size[0] and x + w <= canvas_size[1]
+        num_canvases = max(num_canvases, canvas_idx + 1)
+        canvas = np.array(canvases[canvas_idx])
+        assert np.array_equal(canvas[y:y + h, x:x + w], image)
+        covered = coverage.setdefault(canvas_idx, np.zeros(canvas_size, dtype=np.int32))
+        covered[y:y + h, x:x + w] += 1
+    for i in range(batch_size):
+        canvas = np.array(canvases[i])
+        if i < num_canvases:
+            assert canvas.shape == canvas_size + (3,)
+            assert np.all(coverage[i] <= 1), "The images overlap"
+            assert np.all(canvas[coverage[i] == 0] == 0), "The uncovered area is not zeroed"
+        else:
+            assert canvas.shape == (0, 0, 3)
+
+
+def test_pack_images():
+    for device in ["cpu", "gpu"]:
+        yield check_pack_images, device
+
+
+def test_tight_packing():
+    def get_quarters():
+        return [np.ones((50, 60, 1), dtype=np.uint8)] * batch_size
+
+    for device in ["cpu", "gpu"]:
+        pipe = pack_pipe(device, source=get_quarters)
+        pipe.build()
+        _, canvases, placements = (as_cpu(out) for out in pipe.run())
+        # four images fill a canvas
+        num_canvases = batch_size // 4
+        for i in range(batch_size):
+            assert np.array(placements[i])[0] == i // 4
+            shape = canvas_size + (1,) if i < num_canvases else (0, 0, 1)
+            assert np.array(canvases[i]).shape == shape
+        for i in range(num_canvases):
+            assert np.all(np.array(canvases[i]) == 1)
+
+
+def test_cpu_vs_gpu():
+    cpu_pipe = pack_pipe("cpu")
+    gpu_pipe = pack_pipe("gpu")
+    cpu_pipe.build()
+    gpu_pipe.build()
+    for _ in range(2):
+        cpu_out = cpu_pipe.run()
+        gpu_out = gpu_pipe.run()
+        for cpu_batch, gpu_batch in zip(cpu_out[1:], gpu_out[1:]):
+            gpu_batch = gpu_batch.as_cpu()
+            for i in range(batch_size):
+                assert np.array_equal(np.array(cpu_batch[i]), np.array(gpu_batch[i]))
+
+
+def test_image_too_large():
+    def get_large():
+        return [np.zeros((101, 10, 3), dtype=np.uint8)] * batch_size
+
+    for device in ["cpu", "gpu"]:
+        pipe = pack_pipe(device, source=get_large)
+        pipe.build()
+        with assert_raises(RuntimeError, glob="doesn't fit in the canvas"):
+            pipe.run()
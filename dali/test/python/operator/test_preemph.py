@@ -12,7 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from nvidia.dali.pipeline import Pipeline
+from nvidia.dali.pipeline import Pipeline, pipeline_def
 import nvidia.dali.ops as ops
 import nvidia.dali.fn as fn
 import numpy as np
@@ -105,3 +105,56 @@ def test_preemphasis_operator():
                 for coef, per_sample_coeff in [(0.97, False), (0.0, False), (None, True)]:
                     yield (check_preemphasis_operator, device, batch_size, border, coef,
                            per_sample_coeff)
+
+
+def generate_stream_chunks(batch_size, n_iters, min_len, max_len, reset_iter):
+    """Chunks of `batch_size` streams, in a different order in each iteration; the odd streams
+    start anew in `reset_iter`"""
+    rng = np.random.default_rng(SEED)
+    chunks, ids, resets = [], [], []
+    for it in range(n_iters):
+        order = rng.permutation(batch_size)
+        chunks.append([rng.uniform(-1, 1, size=rng.integers(min_len, max_len)).astype(np.float32)
+                       for _ in range(batch_size)])
+        ids.append([np.array(s, dtype=np.int32) for s in order])
+        resets.append([np.array(it == reset_iter and s % 2 == 1) for s in order])
+    return chunks, ids, resets
+
+
+def check_preemphasis_streaming(device, border):
+    batch_size = 4
+    n_iters = 6
+    coeff = 0.9
+    # extra iterations for the prefetching
+    chunks, ids, resets = generate_stream_chunks(batch_size, n_iters + 2, 2, 300, reset_iter=3)
+
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0, prefetch_queue_depth=1)
+    def pipe():
+        data, stream_id, reset = fn.external_source(
+            source=lambda i: (chunks[i], ids[i], resets[i]), num_outputs=3)
+        data = data.gpu() if device == 'gpu' else data
+        return fn.preemphasis_filter(data, border=border, preemph_coeff=coeff,
+                                     stream_id=stream_id, stream_reset=reset)
+
+    p = pipe()
+    p.build()
+    history = {}
+    for it in range(n_iters):
+        out, = p.run()
+        if device == 'gpu':
+            out = out.as_cpu()
+        for k in range(batch_size):
+            stream = int(ids[it][k])
+            if resets[it][k] or stream not in history:
+                history[stream] = []
+            history[stream].append(chunks[it][k])
+            ref = preemph_func(border, coeff, np.concatenate(history[stream]))
+            ref = ref[-len(chunks[it][k]):]
+            assert np.allclose(out.at(k), ref, atol=1e-6), \
+                f"iteration {it}, stream {stream}: max diff {np.max(np.abs(out.at(k) - ref))}"
+
+
+def test_preemphasis_streaming():
+    for device in ['cpu', 'gpu']:
+        for border in ['zero', 'clamp', 'reflect']:
+            yield check_preemphasis_streaming, device, border
@@ -0,0 +1,79 @@
+# Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import numpy as np
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+import test_utils
+from nvidia.dali import pipeline_def
+
+audio_files = test_utils.get_files(os.path.join('db', 'audio', 'wav'), 'wav')
+
+
+@pipeline_def(batch_size=8, num_threads=3, device_id=0, seed=42)
+def trim_pipe(dtype, coeff, border, **nonsilence_args):
+    raw, _ = fn.readers.file(files=audio_files)
+    audio, _ = fn.decoders.audio(raw, dtype=dtype, downmix=True)
+    audio = audio.gpu()
+    fused = fn.experimental.preemphasis_trim(audio, preemph_coeff=coeff, border=border,
+                                             **nonsilence_args)
+    filtered = fn.preemphasis_filter(audio, preemph_coeff=coeff, border=border)
+    begin, length = fn.nonsilent_region(filtered, **nonsilence_args)
+    chained = fn.slice(filtered, begin, length, axes=[0])
+    return fused, chained
+
+
+def check_chain_equivalence(dtype, coeff, border, window_length, cutoff_db, reference_power):
+    nonsilence_args = {'window_length': window_length, 'cutoff_db': cutoff_db,
+                       'reset_interval': -1}
+    if reference_power is not None:
+        nonsilence_args['reference_power'] = reference_power
+    pipe = trim_pipe(dtype, coeff, border, **nonsilence_args)
+    pipe.build()
+    for _ in range(2):
+        fused, chained = pipe.run()
+        fused, chained = fused.as_cpu(), chained.as_cpu()
+        for i in range(len(fused)):
+            out = np.array(fused[i])
+            ref = np.array(chained[i])
+            assert out.shape == ref.shape, f"sample {i}: {out.shape} vs {ref.shape}"
+            np.testing.assert_allclose(out, ref, rtol=1e-5, atol=1e-5)
+
+
+def test_chain_equivalence():
+    """The fused operator matches preemphasis_filter -> nonsilent_region -> slice"""
+    for dtype in [types.FLOAT, types.INT16]:
+        for border in ['zero', 'clamp', 'reflect']:
+            for window_length, cutoff_db, reference_power in [(512, -60, None),
+                                                              (1024, -20, None),
+                                                              (256, -30, 0.0003)]:
+                if dtype == types.INT16 and reference_power is not None:
+                    reference_power *= 2 ** 30
+                yield check_chain_equivalence, dtype, 0.97, border, window_length, cutoff_db, \
+                    reference_power
+
+
+def test_silent_input():
+    @pipeline_def(batch_size=4, num_threads=1, device_id=0)
+    def pipe():
+        data = fn.constant(fdata=0., shape=[1000], device="gpu")
+        return fn.experimental.preemphasis_trim(data, reference_power=1.)
+
+    p = pipe()
+    p.build()
+    out, = p.run()
+    out = out.as_cpu()
+    for i in range(len(out)):
+        assert np.array(out[i]).shape == (0,)
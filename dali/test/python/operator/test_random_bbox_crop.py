@@ -123,7 +123,8 @@ class RandomBBoxCropSynthDataPipeline(Pipeline):
     def define_graph(self):
         inputs = fn.external_source(source=self.bbox_source,
                                     num_outputs=self.bbox_source.num_outputs)
-        outputs = self.bbox_crop(*inputs)
+        op_inputs = [inp.gpu() for inp in inputs] if self.device == 'gpu' else inputs
+        outputs = self.bbox_crop(*op_inputs)
         return [inputs[0], *outputs]
 
 
@@ -423,3 +424,49 @@ def _testimpl_random_bbox_crop_square(use_input_shape):
 def test_random_bbox_crop_square():
     for use_input_shape in [False, True]:
         yield _testimpl_random_bbox_crop_square, use_input_shape
+
+
+def check_random_bbox_crop_gpu(batch_size, ndim, use_labels, args):
+    bbox_layout = "xyzXYZ" if ndim == 3 else "xyXY"
+    niter = 10
+    pipes = []
+    for device in ['cpu', 'gpu']:
+        bbox_source = BBoxDataIterator(niter, batch_size, ndim, produce_labels=use_labels)
+        pipe = RandomBBoxCropSynthDataPipeline(device=device, batch_size=batch_size,
+                                               bbox_source=bbox_source,
+                                               bbox_layout=bbox_layout,
+                                               output_bbox_indices=True,
+                                               **args)
+        pipe.build()
+        pipes.append(pipe)
+    for _ in range(niter):
+        cpu_outputs, gpu_outputs = [pipe.run() for pipe in pipes]
+        # skipping the input boxes
+        for cpu_out, gpu_out in zip(cpu_outputs[1:], gpu_outputs[1:]):
+            gpu_out = gpu_out.as_cpu()
+            for sample in range(batch_size):
+                np.testing.assert_array_equal(cpu_out.at(sample), gpu_out.at(sample))
+
+
+def test_random_bbox_crop_gpu():
+    args_list = {
+        2: [
+            {},
+            {'aspect_ratio': [1.0, 1.0], 'scaling': [0.5, 0.8]},
+            {'allow_no_crop': True, 'all_boxes_above_threshold': True},
+            {'threshold_type': 'overlap', 'thresholds': [0.5, 1.0]},
+            {'scaling': None, 'aspect_ratio': None,
+             'input_shape': [400, 300], 'crop_shape': [150, 200]},
+        ],
+        3: [
+            {'aspect_ratio': [0.5, 2.0, 0.6, 2.1, 0.4, 1.9]},
+            {'threshold_type': 'overlap', 'all_boxes_above_threshold': True},
+            {'scaling': None, 'aspect_ratio': None,
+             'input_shape': [400, 300, 64], 'crop_shape': [100, 50, 32]},
+        ],
+    }
+    for batch_size in [1, 3]:
+        for ndim in [2, 3]:
+            for args in args_list[ndim]:
+                for use_labels in [True, False]:
+                    yield check_random_bbox_crop_gpu, batch_size, ndim, use_labels, args
@@ -479,6 +479,39 @@ def test_random_object_bbox_ignore_class():
                    5, ndim, dtype, format, bg, threshold, k_largest)
 
 
+@nottest
+def _test_random_object_bbox_gpu(max_batch_size, ndim, dtype, kwargs):
+    """Checks that the GPU operator selects the same boxes as the CPU one"""
+    pipe = dali.Pipeline(max_batch_size, 4, device_id=0, seed=4321)
+    with pipe:
+        inp = fn.external_source(batch_generator(max_batch_size, ndim, dtype))
+        cpu_outs = fn.segmentation.random_object_bbox(inp, seed=1234, **kwargs)
+        gpu_outs = fn.segmentation.random_object_bbox(inp.gpu(), seed=1234, **kwargs)
+        if not isinstance(cpu_outs, list):
+            cpu_outs, gpu_outs = [cpu_outs], [gpu_outs]
+        pipe.set_outputs(*cpu_outs, *gpu_outs)
+    pipe.build()
+
+    for _ in range(10):
+        outs = pipe.run()
+        n = len(outs) // 2
+        for cpu_out, gpu_out in zip(outs[:n], outs[n:]):
+            check_batch(cpu_out, gpu_out, max_batch_size)
+
+
+def test_random_object_bbox_gpu():
+    np.random.seed(1234)
+    types = [np.uint8, np.int16, np.int32, np.uint32]
+    for ndim in [1, 2, 3, 4]:
+        dtype = random.choice(types)
+        for kwargs in [{},
+                       {"ignore_class": True, "k_largest": 2},
+                       {"format": "box", "output_class": True, "classes": [1, 2, 3],
+                        "class_weights": [1, 2, 3], "foreground_prob": 0.8},
+                       {"format": "start_end", "threshold": [3] * ndim}]:
+            yield _test_random_object_bbox_gpu, 5, ndim, dtype, kwargs
+
+
 @nottest
 def _test_random_object_bbox_auto_bg(fg_labels, expected_bg):
     """Checks that a correct backgorund labels is chosen:
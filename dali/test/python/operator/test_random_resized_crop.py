@@ -180,3 +180,46 @@ def test_random_resized_crop():
                         output_type = dali.types.FLOAT if np.random.randint(0, 2) else None
                         yield _test_rrc, device, max_frames, layout, aspect, area, size, \
                             input_type, output_type
+
+
+def _test_rrc_mirror_normalize(output_layout, pad_output, output_type):
+    batch_size = 4
+    size = (96, 128)
+    mean = [0.485 * 255, 0.456 * 255, 0.406 * 255]
+    std = [0.229 * 255, 0.224 * 255, 0.225 * 255]
+    pipe = dali.pipeline.Pipeline(batch_size, 4, 0)
+    with pipe:
+        input = fn.external_source(
+            source=generator(batch_size, None, -1, dali.types.UINT8), layout="HWC").gpu()
+        mirror = fn.random.coin_flip(seed=42)
+        crop_args = dict(random_aspect_ratio=(0.75, 1.33), random_area=(0.1, 1.0), seed=4321)
+        fused = fn.experimental.random_resized_crop_mirror_normalize(
+            input, size=size, mirror=mirror, mean=mean, std=std, output_layout=output_layout,
+            pad_output=pad_output, dtype=output_type, **crop_args)
+        resized = fn.random_resized_crop(input, size=size, interp_type=dali.types.INTERP_LINEAR,
+                                         antialias=False, **crop_args)
+        ref = fn.crop_mirror_normalize(resized, mirror=mirror, mean=mean, std=std,
+                                       output_layout=output_layout, pad_output=pad_output,
+                                       dtype=dali.types.FLOAT)
+        pipe.set_outputs(fused, ref)
+    pipe.build()
+    eps = 1e-2 if output_type == dali.types.FLOAT16 else 2e-3
+    for _ in range(3):
+        fused, ref = pipe.run()
+        assert fused.layout() == output_layout
+        fused = fused.as_cpu()
+        ref = ref.as_cpu()
+        for i in range(batch_size):
+            out = np.array(fused[i]).astype(np.float32)
+            expected = np.array(ref[i])
+            assert out.shape == expected.shape, f"{out.shape} vs {expected.shape}"
+            # the reference is rounded to uint8 after resizing - allow for that in the error
+            max_err = np.max(np.abs(out - expected))
+            assert max_err <= 0.5 / min(std) + eps * np.max(np.abs(expected)), max_err
+
+
+def test_random_resized_crop_mirror_normalize():
+    for output_layout in ["CHW", "HWC"]:
+        for pad_output in [False, True]:
+            for output_type in [dali.types.FLOAT, dali.types.FLOAT16]:
+                yield _test_rrc_mirror_normalize, output_layout, pad_output, output_type
@@ -0,0 +1,108 @@
+# Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import nvidia.dali.fn as fn
+from nvidia.dali import pipeline_def
+
+from nose_utils import assert_raises
+from test_utils import check_batch
+
+batch_size = 5
+# all the images have the aspect ratio 4:3, so that a crop of the whole area covers the image
+image_sizes = [(60, 80), (30, 40), (90, 120)]
+
+
+def get_data():
+    rng = np.random.default_rng(42)
+    return [rng.integers(0, 255, size=image_sizes[i % len(image_sizes)] + (3,), dtype=np.uint8)
+            for i in range(batch_size)]
+
+
+@pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+def multi_crop_pipe(device, **kwargs):
+    images = fn.external_source(source=get_data, layout="HWC", cycle=True)
+    if device == "gpu":
+        images = images.gpu()
+    return fn.experimental.random_resized_multi_crop(images, **kwargs)
+
+
+def check_shapes(device):
+    num_crops = [2, 3]
+    pipe = multi_crop_pipe(device, num_crops=num_crops, size=[32, 24, 16, 12],
+                           random_area=[0.4, 1.0, 0.05, 0.4], seed=123)
+    pipe.build()
+    for _ in range(2):
+        outs = pipe.run()
+        assert len(outs) == sum(num_crops)
+        for k, out in enumerate(outs):
+            expected = (32, 24, 3) if k < num_crops[0] else (16, 12, 3)
+            assert out.layout() == "HWC"
+            for i in range(batch_size):
+                assert out[i].shape() == list(expected)
+
+
+def test_shapes():
+    for device in ["cpu", "gpu"]:
+        yield check_shapes, device
+
+
+def check_full_image_crops(device):
+    # the crops of the whole area are the whole images - the same as a plain resize
+    size = [20, 30]
+    pipe = multi_crop_pipe(device, num_crops=[3], size=size, random_area=[1, 1],
+                           random_aspect_ratio=[4 / 3, 4 / 3], seed=123)
+
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def ref_pipe():
+        images = fn.external_source(source=get_data, layout="HWC", cycle=True)
+        if device == "gpu":
+            images = images.gpu()
+        return fn.resize(images, size=size)
+
+    pipe.build()
+    ref = ref_pipe()
+    ref.build()
+    outs = pipe.run()
+    ref_out, = ref.run()
+    for out in outs:
+        check_batch(out, ref_out, batch_size, max_allowed_error=1)
+
+
+def test_full_image_crops():
+    for device in ["cpu", "gpu"]:
+        yield check_full_image_crops, device
+
+
+def check_seed(device):
+    kwargs = dict(num_crops=[2, 2], size=[16, 16], random_area=[0.1, 0.5], seed=42)
+    pipe1 = multi_crop_pipe(device, **kwargs)
+    pipe2 = multi_crop_pipe(device, **kwargs)
+    pipe1.build()
+    pipe2.build()
+    for _ in range(2):
+        for out1, out2 in zip(pipe1.run(), pipe2.run()):
+            check_batch(out1, out2, batch_size)
+
+
+def test_seed():
+    for device in ["cpu", "gpu"]:
+        yield check_seed, device
+
+
+def test_wrong_group_args():
+    pipe = multi_crop_pipe("cpu", num_crops=[2, 8], size=[224, 224],
+                           random_area=[0.4, 1.0, 0.05, 0.4, 0.1, 0.2])
+    with assert_raises(RuntimeError, glob="expects 2 values or 2 values per group"):
+        pipe.build()
@@ -590,6 +590,36 @@ def test_stitching():
                         yield _test_stitching, device, dim, channel_first, dtype, interp
 
 
+def _test_intra_sample_tiling(dim, interp, roi):
+    """A batch smaller than the number of threads is resized in tiles - the result must match
+    the one obtained with a single thread"""
+    def get_data():
+        rng = np.random.default_rng(1234)
+        shape = [40, 120, 160, 3] if dim == 3 else [1000, 1500, 3]
+        return [rng.integers(0, 256, size=shape, dtype=np.uint8)]
+
+    out_size = [25, 170, 230] if dim == 3 else [700, 900]
+    roi_args = dict(roi_start=[0.1] * dim, roi_end=[0.8] * dim, roi_relative=True) if roi else {}
+
+    @pipeline_def(batch_size=1, device_id=0, prefetch_queue_depth=1)
+    def pipe():
+        data = fn.external_source(source=get_data, layout=layout_str(dim, False), cycle=True)
+        return fn.resize(data, size=out_size, interp_type=interp, dtype=types.FLOAT, **roi_args)
+
+    single = pipe(num_threads=1)
+    tiled = pipe(num_threads=6)
+    single.build()
+    tiled.build()
+    check_batch(tiled.run()[0], single.run()[0], 1, 1e-5, 1e-3)
+
+
+def test_intra_sample_tiling():
+    for dim in [2, 3]:
+        for interp in [types.INTERP_LINEAR, types.INTERP_CUBIC, types.INTERP_LANCZOS3]:
+            for roi in [False, True]:
+                yield _test_intra_sample_tiling, dim, interp, roi
+
+
 def _test_empty_input(dim, device):
     batch_size = 8
     pipe = Pipeline(batch_size=batch_size, num_threads=8, device_id=0, seed=1234)
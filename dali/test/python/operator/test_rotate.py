@@ -23,6 +23,7 @@ import nvidia.dali.ops as ops
 import nvidia.dali.types as types
 import nvidia.dali as dali
 from test_utils import compare_pipelines
+from nose_utils import assert_raises
 from sequences_test_utils import (ArgData, ArgDesc, ArgCb, ParamsProvider, get_video_input_cases,
                                   sequence_suite_helper)
 
@@ -408,3 +409,56 @@ def test_3d_sequence():
                                                          ArgCb("axis", random_axis, True)])),
     ]
     yield from sequence_suite_helper(rng, input_cases, test_cases)
+
+
+def check_angle_input(ndim, keep_size):
+    batch_size = 6
+    rng = np.random.default_rng(1234)
+    shape = (20, 30, 3) if ndim == 2 else (10, 20, 30, 3)
+    size = None if keep_size else (35, 25) if ndim == 2 else (15, 20, 25)
+    axis = None if ndim == 2 else np.array([0.3, -1, 0.5], dtype=np.float32)
+
+    @dali.pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def pipe():
+        data = dali.fn.external_source(
+            source=lambda: [rng.integers(0, 255, shape, dtype=np.uint8)
+                            for _ in range(batch_size)], layout="HWC" if ndim == 2 else "DHWC")
+        angle = dali.fn.external_source(
+            source=lambda: [np.float32(rng.uniform(-180, 180)) for _ in range(batch_size)])
+        kwargs = {'keep_size': keep_size, 'size': size, 'axis': axis}
+        kwargs = {k: v for k, v in kwargs.items() if v is not None}
+        data = data.gpu()
+        ref = dali.fn.rotate(data, angle=angle, **kwargs)
+        # the angles are read by the operator in GPU memory
+        out_gpu = dali.fn.rotate(data, angle.gpu(), **kwargs)
+        out_cpu = dali.fn.rotate(data, angle, **kwargs)
+        return ref, out_gpu, out_cpu
+
+    p = pipe()
+    p.build()
+    for _ in range(2):
+        ref, out_gpu, out_cpu = (out.as_cpu() for out in p.run())
+        for i in range(batch_size):
+            r = np.int32(ref.at(i))
+            for out in [out_gpu, out_cpu]:
+                assert out.at(i).shape == r.shape
+                assert np.max(np.abs(np.int32(out.at(i)) - r)) <= 1
+
+
+def test_angle_input():
+    for ndim in [2, 3]:
+        for keep_size in [False, True]:
+            yield check_angle_input, ndim, keep_size
+
+
+def test_angle_input_size_inference():
+    @dali.pipeline_def(batch_size=2, num_threads=1, device_id=0)
+    def pipe():
+        data = dali.fn.constant(idata=1, shape=(10, 20, 3), dtype=types.UINT8, layout="HWC")
+        angle = dali.fn.constant(fdata=30.)
+        return dali.fn.rotate(data.gpu(), angle.gpu())
+
+    with assert_raises(RuntimeError, glob="*the output size cannot depend on them*"):
+        p = pipe()
+        p.build()
+        p.run()
@@ -1,4 +1,4 @@
-# Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -23,7 +23,7 @@ np.random.seed(4321)
 
 
 def check_random_mask_pixel(ndim=2, batch_size=3,
-                            min_extent=20, max_extent=50):
+                            min_extent=20, max_extent=50, device='cpu'):
     pipe = dali.pipeline.Pipeline(batch_size=batch_size, num_threads=4, device_id=0, seed=1234)
     with pipe:
         # Input mask
@@ -31,18 +31,24 @@ def check_random_mask_pixel(ndim=2, batch_size=3,
                                  dtype=types.INT32) for _ in range(ndim)]
         in_shape = fn.stack(*in_shape_dims)
         in_mask = fn.cast(fn.random.uniform(range=(0, 2), shape=in_shape), dtype=types.INT32)
+        mask = in_mask.gpu() if device == 'gpu' else in_mask
 
         #  > 0
-        fg_pixel1 = fn.segmentation.random_mask_pixel(in_mask, foreground=1)
+        fg_pixel1 = fn.segmentation.random_mask_pixel(mask, foreground=1)
         #  >= 0.99
-        fg_pixel2 = fn.segmentation.random_mask_pixel(in_mask, foreground=1, threshold=0.99)
+        fg_pixel2 = fn.segmentation.random_mask_pixel(mask, foreground=1, threshold=0.99)
         #  == 2
-        fg_pixel3 = fn.segmentation.random_mask_pixel(in_mask, foreground=1, value=2)
+        fg_pixel3 = fn.segmentation.random_mask_pixel(mask, foreground=1, value=2)
 
-        rnd_pixel = fn.segmentation.random_mask_pixel(in_mask, foreground=0)
+        rnd_pixel = fn.segmentation.random_mask_pixel(mask, foreground=0)
 
         coin_flip = fn.random.coin_flip(probability=0.7)
-        fg_biased = fn.segmentation.random_mask_pixel(in_mask, foreground=coin_flip)
+        fg_biased, fg_count = fn.segmentation.random_mask_pixel(mask, foreground=coin_flip,
+                                                                output_count=True)
+        if device == 'gpu':
+            fg_pixel1, fg_pixel2, fg_pixel3, rnd_pixel, fg_biased, fg_count = \
+                [x.cpu() for x in (fg_pixel1, fg_pixel2, fg_pixel3, rnd_pixel, fg_biased,
+                                   fg_count)]
 
         # Demo purposes: Taking a random pixel and produce a valid anchor to feed slice
         # We want to force the center adjustment, thus the large crop shape
@@ -52,7 +58,7 @@ def check_random_mask_pixel(ndim=2, batch_size=3,
         out_mask = fn.slice(in_mask, anchor, crop_shape, axes=tuple(range(ndim)))
 
     pipe.set_outputs(in_mask, fg_pixel1, fg_pixel2, fg_pixel3, rnd_pixel, coin_flip, fg_biased,
-                     anchor, crop_shape, out_mask)
+                     anchor, crop_shape, out_mask, fg_count)
     pipe.build()
     for iter in range(3):
         outputs = pipe.run()
@@ -67,11 +73,13 @@ def check_random_mask_pixel(ndim=2, batch_size=3,
             anchor = outputs[7].at(idx).tolist()
             crop_shape = outputs[8].at(idx).tolist()
             out_mask = outputs[9].at(idx)
+            fg_count = outputs[10].at(idx)
 
             assert in_mask[tuple(fg_pixel1)] > 0
             assert in_mask[tuple(fg_pixel2)] > 0.99
             assert in_mask[tuple(fg_pixel3)] == 2
             assert in_mask[tuple(fg_biased)] > 0 or not coin_flip
+            assert fg_count == np.count_nonzero(in_mask > 0)
 
             for d in range(ndim):
                 assert 0 <= anchor[d] and anchor[d] + crop_shape[d] <= in_mask.shape[d]
@@ -79,5 +87,6 @@ def check_random_mask_pixel(ndim=2, batch_size=3,
 
 
 def test_random_mask_pixel():
-    for ndim in (2, 3):
-        yield check_random_mask_pixel, ndim
+    for device in ('cpu', 'gpu'):
+        for ndim in (2, 3):
+            yield check_random_mask_pixel, ndim, 3, 20, 50, device
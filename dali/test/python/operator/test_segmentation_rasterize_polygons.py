@@ -0,0 +1,109 @@
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import nose_utils  # noqa:F401
+import numpy as np
+import random
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+from nvidia.dali import pipeline_def
+from segmentation_test_utils import make_batch_select_masks
+
+random.seed(1234)
+np.random.seed(4321)
+
+np_types = {types.UINT8: np.uint8, types.INT16: np.int16, types.INT32: np.int32}
+
+
+def transform_vertices(vertices, mt):
+    # the same order of float32 operations as in the operator
+    x, y = vertices[:, 0], vertices[:, 1]
+    out_x = (mt[0, 0] * x + mt[0, 1] * y) + mt[0, 2]
+    out_y = (mt[1, 0] * x + mt[1, 1] * y) + mt[1, 2]
+    return np.stack([out_x, out_y], axis=1)
+
+
+def inside(px, py, vertices):
+    result = np.zeros(px.shape, dtype=bool)
+    for i in range(len(vertices)):
+        a, b = vertices[i], vertices[i - 1]
+        crosses = (a[1] > py) != (b[1] > py)
+        with np.errstate(divide='ignore', invalid='ignore'):
+            t = (py - a[1]) / (b[1] - a[1])
+            x = a[0] + t * (b[0] - a[0])
+        result ^= crosses & (px < x)
+    return result
+
+
+def ref_rasterize(polygons, vertices, labels, mt, size, dtype):
+    h, w = size
+    out = np.zeros((h, w), dtype=dtype)
+    py, px = np.meshgrid(np.arange(h, dtype=np.float32) + np.float32(0.5),
+                         np.arange(w, dtype=np.float32) + np.float32(0.5), indexing='ij')
+    out_vertices = transform_vertices(vertices, mt)
+    for mask_idx, start, end in polygons:
+        if end - start < 3 or start < 0 or end > len(vertices) or mask_idx < 0:
+            continue
+        if labels is not None and mask_idx >= len(labels):
+            continue
+        covered = inside(px, py, out_vertices[start:end])
+        out[covered] = labels[mask_idx] if labels is not None else 1
+    return out[:, :, np.newaxis]
+
+
+def make_batch(batch_size):
+    polygons, vertices, _ = make_batch_select_masks(batch_size, npolygons_range=(1, 8),
+                                                    nvertices_range=(3, 20))
+    labels = [np.random.randint(1, 100, size=(len(p),), dtype=np.int32) for p in polygons]
+    sizes = [np.array([random.randint(1, 100), random.randint(1, 100)], dtype=np.int32)
+             for _ in range(batch_size)]
+    mts = []
+    for size in sizes:
+        # the vertices are in [0, 1] - scale them to roughly the size of the output,
+        # with some shear and a translation, so that the polygons are partially outside
+        mt = np.array([[size[1] * random.uniform(0.8, 1.5), random.uniform(-5, 5),
+                        random.uniform(-10, 10)],
+                       [random.uniform(-5, 5), size[0] * random.uniform(0.8, 1.5),
+                        random.uniform(-10, 10)]], dtype=np.float32)
+        mts.append(mt)
+    return polygons, vertices, labels, sizes, mts
+
+
+def check_rasterize_polygons(batch_size, use_labels, dtype):
+    batches = [make_batch(batch_size) for _ in range(3)]
+
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0)
+    def pipe():
+        polygons, vertices, labels, size, mt = fn.external_source(source=batches, num_outputs=5)
+        inputs = [polygons.gpu(), vertices.gpu()]
+        if use_labels:
+            inputs.append(labels.gpu())
+        return fn.segmentation.rasterize_polygons(*inputs, size=size, MT=mt, dtype=dtype)
+
+    p = pipe()
+    p.build()
+    for polygons, vertices, labels, sizes, mts in batches:
+        out, = p.run()
+        out = out.as_cpu()
+        for i in range(batch_size):
+            ref = ref_rasterize(polygons[i], vertices[i], labels[i] if use_labels else None,
+                                mts[i], sizes[i], np_types[dtype])
+            np.testing.assert_array_equal(np.array(out[i]), ref)
+
+
+def test_rasterize_polygons():
+    for use_labels in (False, True):
+        for dtype in (types.UINT8, types.INT32):
+            yield check_rasterize_polygons, 4, use_labels, dtype
@@ -1,4 +1,4 @@
-# Copyright (c) 2020, NVIDIA CORPORATION. All rights reserved.
+# Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -28,7 +28,8 @@ def check_select_masks(batch_size,
                        nvertices_range=(3, 40),
                        vertex_ndim=2,
                        vertex_dtype=np.float32,
-                       reindex_masks=False):
+                       reindex_masks=False,
+                       device='cpu'):
 
     def get_data_source(*args, **kwargs):
         return lambda: make_batch_select_masks(*args, **kwargs)
@@ -41,7 +42,7 @@ def check_select_masks(batch_size,
                                    nvertices_range=nvertices_range,
                                    vertex_ndim=vertex_ndim,
                                    vertex_dtype=vertex_dtype),
-            num_outputs=3, device='cpu'
+            num_outputs=3, device=device
         )
         out_polygons, out_vertices = fn.segmentation.select_masks(
             mask_ids, polygons, vertices, reindex_masks=reindex_masks
@@ -50,6 +51,8 @@ def check_select_masks(batch_size,
     pipe.build()
     for iter in range(3):
         outputs = pipe.run()
+        if device == 'gpu':
+            outputs = [out.as_cpu() for out in outputs]
         for idx in range(batch_size):
             in_polygons = outputs[0].at(idx)
             in_vertices = outputs[1].at(idx)
@@ -87,17 +90,20 @@ def check_select_masks(batch_size,
 def test_select_masks():
     npolygons_range = (1, 10)
     nvertices_range = (3, 40)
-    for batch_size in [1, 3]:
-        for vertex_ndim in [2, 3, 6]:
-            for vertex_dtype in [np.float, random.choice([np.int8, np.int16, np.int32, np.int64])]:
-                reindex_masks = random.choice([False, True])
-                yield (check_select_masks,
-                       batch_size,
-                       npolygons_range,
-                       nvertices_range,
-                       vertex_ndim,
-                       vertex_dtype,
-                       reindex_masks)
+    for device in ['cpu', 'gpu']:
+        for batch_size in [1, 3]:
+            for vertex_ndim in [2, 3, 6]:
+                for vertex_dtype in [np.float,
+                                     random.choice([np.int8, np.int16, np.int32, np.int64])]:
+                    reindex_masks = random.choice([False, True])
+                    yield (check_select_masks,
+                           batch_size,
+                           npolygons_range,
+                           nvertices_range,
+                           vertex_ndim,
+                           vertex_dtype,
+                           reindex_masks,
+                           device)
 
 
 @dali.pipeline_def(batch_size=1, num_threads=4, device_id=0, seed=1234)
@@ -16,6 +16,8 @@ from nvidia.dali.pipeline import Pipeline
 import nvidia.dali.ops as ops
 import nvidia.dali.types as types
 import nvidia.dali as dali
+import nvidia.dali.fn as fn
+from nvidia.dali import pipeline_def
 import numpy as np
 from functools import partial
 from test_utils import get_files
@@ -23,6 +25,7 @@ from test_utils import compare_pipelines
 from test_utils import RandomDataIterator
 from test_utils import ConstantDataIterator
 import librosa as librosa
+from nose_utils import assert_raises
 import math
 
 audio_files = get_files('db/audio/wav', 'wav')
@@ -223,7 +226,7 @@ class AudioSpectrogramPythonPipeline(Pipeline):
         audio, rate = self.decode(read)
         out = self.spectrogram(audio)
         if self.layout == "tf":
-            out = dali.fn.transpose(out, perm=[1, 0], transpose_layout=True)
+            out = fn.transpose(out, perm=[1, 0], transpose_layout=True)
 
         return out
 
@@ -257,3 +260,73 @@ def test_operator_decoder_and_spectrogram():
                     for center in [False, True] if nfft == window_length else [True]:
                         yield check_operator_decoder_and_spectrogram_vs_python, device, \
                             batch_size, nfft, window_length, window_step, center, layout
+
+
+def check_spectrogram_streaming(device, window_length, window_step):
+    batch_size = 4
+    n_iters = 6
+    reset_iter = 3
+    rng = np.random.default_rng(12345)
+    chunks, ids, resets = [], [], []
+    for it in range(n_iters + 2):  # extra iterations for the prefetching
+        order = rng.permutation(batch_size)
+        chunks.append([rng.uniform(-1, 1, size=rng.integers(window_length, 3 * window_length))
+                       .astype(np.float32) for _ in range(batch_size)])
+        ids.append([np.array(s, dtype=np.int32) for s in order])
+        resets.append([np.array(it == reset_iter and s % 2 == 1) for s in order])
+
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=0, prefetch_queue_depth=1)
+    def pipe():
+        data, stream_id, reset = fn.external_source(
+            source=lambda i: (chunks[i], ids[i], resets[i]), num_outputs=3)
+        data = data.gpu() if device == 'gpu' else data
+        return fn.spectrogram(data, window_length=window_length, window_step=window_step,
+                                   center_windows=False, stream_id=stream_id, stream_reset=reset)
+
+    p = pipe()
+    p.build()
+    history = {}
+    for it in range(n_iters):
+        out, = p.run()
+        if device == 'gpu':
+            out = out.as_cpu()
+        for k in range(batch_size):
+            stream = int(ids[it][k])
+            if resets[it][k] or stream not in history:
+                history[stream] = ([], 0)
+            signal, nwin = history[stream]
+            signal.append(chunks[it][k])
+            # the windows of the chunk continue those of the previous chunks of the stream
+            ref = spectrogram_func_librosa(None, window_length, window_step, None, False,
+                                           np.concatenate(signal))
+            assert ref.shape[1] == nwin + out.at(k).shape[1]
+            ref = ref[:, nwin:]
+            assert np.allclose(out.at(k), ref, rtol=1e-4, atol=1e-3), \
+                f"iteration {it}, stream {stream}: max diff {np.max(np.abs(out.at(k) - ref))}"
+            history[stream] = (signal, ref.shape[1] + nwin)
+
+
+def test_spectrogram_streaming():
+    for device in ['cpu', 'gpu']:
+        for window_length, window_step in [(64, 16), (50, 50), (33, 7)]:
+            yield check_spectrogram_streaming, device, window_length, window_step
+
+
+def test_spectrogram_streaming_wrong_args():
+    @pipeline_def(batch_size=2, num_threads=1, device_id=0)
+    def pipe(device, **kwargs):
+        data = fn.random.uniform(range=[-1, 1], shape=[1000])
+        data = data.gpu() if device == 'gpu' else data
+        return fn.spectrogram(data, stream_id=fn.constant(idata=0), **kwargs)
+
+    for device in ['cpu', 'gpu']:
+        with assert_raises(RuntimeError, glob="`center_windows` must be False*"):
+            p = pipe(device, window_length=100, window_step=50)
+            p.build()
+        with assert_raises(RuntimeError, glob="`window_step` (200) must not exceed*"):
+            p = pipe(device, window_length=100, window_step=200, center_windows=False)
+            p.build()
+        with assert_raises(RuntimeError, glob="A batch can contain only one chunk of a stream*"):
+            p = pipe(device, window_length=100, window_step=50, center_windows=False)
+            p.build()
+            p.run()
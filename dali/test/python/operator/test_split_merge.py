@@ -0,0 +1,94 @@
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import numpy as np
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+from nvidia.dali import pipeline_def
+from nose_utils import raises
+from test_utils import check_batch, as_array
+
+batch_size = 8
+
+
+def _sample(rng):
+    return rng.integers(0, 255, (rng.integers(1, 10), 3), dtype=np.uint8)
+
+
+@pipeline_def(batch_size=batch_size, num_threads=4, device_id=0)
+def split_merge_pipe(device, predicates):
+    rng = np.random.default_rng(42)
+    data = fn.external_source(source=lambda: [_sample(rng) for _ in range(batch_size)],
+                              layout="XY", device=device)
+    pred = fn.external_source(source=predicates, batch=False, dtype=types.BOOL)
+    true_branch, false_branch = fn._conditional.split(data, predicate=pred)
+    # each branch processes only its samples
+    true_branch = fn.cast(true_branch + 1, dtype=types.UINT8)
+    merged = fn._conditional.merge(true_branch, false_branch, predicate=pred)
+    return data, pred, true_branch, false_branch, merged
+
+
+def _test_split_merge(device, predicates):
+    pipe = split_merge_pipe(device, predicates)
+    pipe.build()
+    for _ in range(3):
+        data, pred, true_branch, false_branch, merged = pipe.run()
+        data = [as_array(data[i]) for i in range(batch_size)]
+        pred = [bool(as_array(pred[i])) for i in range(batch_size)]
+        true_ref = [d + 1 for d, p in zip(data, pred) if p]
+        false_ref = [d for d, p in zip(data, pred) if not p]
+        assert len(true_branch) == len(true_ref)
+        assert len(false_branch) == len(false_ref)
+        if true_ref:
+            check_batch(true_branch, true_ref, len(true_ref), expected_layout="XY")
+        if false_ref:
+            check_batch(false_branch, false_ref, len(false_ref), expected_layout="XY")
+        merged_ref = [d + 1 if p else d for d, p in zip(data, pred)]
+        check_batch(merged, merged_ref, batch_size, expected_layout="XY")
+
+
+def test_split_merge():
+    rng = np.random.default_rng(1234)
+
+    def random_predicate(sample_info):
+        return np.array(rng.random() < 0.5)
+
+    def all_true(sample_info):
+        return np.array(True)
+
+    def all_false(sample_info):
+        return np.array(False)
+
+    for device in ["cpu", "gpu"]:
+        for predicates in [random_predicate, all_true, all_false]:
+            yield _test_split_merge, device, predicates
+
+
+@raises(RuntimeError, glob="The branches don't match the predicate")
+def test_merge_mismatched_predicate():
+
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0)
+    def pipe():
+        data = fn.random.uniform(range=[0, 1], shape=[2])
+        pred = fn.external_source(source=lambda i: np.array(i.idx_in_batch % 2 == 0),
+                                  batch=False, dtype=types.BOOL)
+        other = fn.external_source(source=lambda i: np.array(i.idx_in_batch % 3 == 0),
+                                   batch=False, dtype=types.BOOL)
+        true_branch, false_branch = fn._conditional.split(data, predicate=pred)
+        return fn._conditional.merge(true_branch, false_branch, predicate=other)
+
+    p = pipe()
+    p.build()
+    p.run()
@@ -0,0 +1,109 @@
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import numpy as np
+import random
+import nvidia.dali.fn as fn
+import nvidia.dali.types as types
+from nvidia.dali import pipeline_def
+from test_utils import check_batch
+
+random.seed(1234)
+np.random.seed(4321)
+
+
+def random_mt(in_size, out_size):
+    # rotates and scales the image around its center and moves it to the center of the output
+    angle = random.uniform(-np.pi, np.pi)
+    scale = random.uniform(0.5, 2)
+    c, s = np.cos(angle) * scale, np.sin(angle) * scale
+    m = np.array([[c, -s], [s, c]])
+    in_center = np.array([in_size[1], in_size[0]]) / 2
+    out_center = np.array([out_size[1], out_size[0]]) / 2
+    t = out_center - m @ in_center + np.random.uniform(-5, 5, size=2)
+    return np.concatenate([m, t[:, np.newaxis]], axis=1).astype(np.float32)
+
+
+def make_batch(batch_size):
+    images, masks, points, boxes, sizes, mts = [], [], [], [], [], []
+    for _ in range(batch_size):
+        h, w = random.randint(10, 100), random.randint(10, 100)
+        out_size = np.array([random.randint(10, 100), random.randint(10, 100)],
+                            dtype=np.float32)
+        images.append(np.random.randint(0, 256, size=(h, w, 3), dtype=np.uint8))
+        masks.append(np.random.randint(0, 5, size=(h, w, 1), dtype=np.int32))
+        npoints, nboxes = random.randint(0, 20), random.randint(0, 10)
+        points.append(np.random.uniform(0, 1, size=(npoints, 2)).astype(np.float32))
+        lt = np.random.uniform(0, 0.5, size=(nboxes, 2))
+        rb = lt + np.random.uniform(0, 0.5, size=(nboxes, 2))
+        boxes.append(np.concatenate([lt, rb], axis=1).astype(np.float32))
+        sizes.append(out_size)
+        mts.append(random_mt((h, w), out_size))
+    return images, masks, points, boxes, sizes, mts
+
+
+def ref_points(points, mt, in_scale, out_scale):
+    points = points.astype(np.float64) * in_scale
+    return (points @ mt[:, :2].T.astype(np.float64) + mt[:, 2]) / out_scale
+
+
+def ref_boxes(boxes, mt, in_scale, out_scale):
+    corners = [boxes[:, [x, y]] for x in (0, 2) for y in (1, 3)]
+    corners = np.stack([ref_points(c, mt, in_scale, out_scale) for c in corners])
+    return np.concatenate([corners.min(axis=0), corners.max(axis=0)], axis=1)
+
+
+def check_warp_affine_multi(batch_size, normalized_coords):
+    batches = [make_batch(batch_size) for _ in range(3)]
+
+    @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0)
+    def pipe():
+        images, masks, points, boxes, size, mt = fn.external_source(source=batches,
+                                                                    num_outputs=6)
+        images, masks = images.gpu(), masks.gpu()
+        outs = fn.experimental.warp_affine_multi(
+            images, masks, points.gpu(), boxes.gpu(), MT=mt, size=size, fill_value=0,
+            input_kinds=["image", "mask", "points", "boxes"],
+            normalized_coords=normalized_coords)
+        ref_image = fn.warp_affine(images, matrix=mt, inverse_map=False, size=size,
+                                   fill_value=0)
+        ref_mask = fn.warp_affine(masks, matrix=mt, inverse_map=False, size=size, fill_value=0,
+                                  interp_type=types.INTERP_NN)
+        return (*outs, ref_image, ref_mask)
+
+    p = pipe()
+    p.build()
+    for images, masks, points, boxes, sizes, mts in batches:
+        image, mask, out_points, out_boxes, ref_image, ref_mask = p.run()
+        check_batch(image, ref_image, batch_size, max_allowed_error=0)
+        check_batch(mask, ref_mask, batch_size, max_allowed_error=0)
+        out_points, out_boxes = out_points.as_cpu(), out_boxes.as_cpu()
+        for i in range(batch_size):
+            if normalized_coords:
+                in_scale = np.array([images[i].shape[1], images[i].shape[0]])
+                out_scale = np.array([sizes[i][1], sizes[i][0]])
+            else:
+                in_scale = out_scale = np.ones(2)
+            np.testing.assert_allclose(np.array(out_points[i]),
+                                       ref_points(points[i], mts[i], in_scale, out_scale),
+                                       rtol=1e-5, atol=1e-4)
+            np.testing.assert_allclose(np.array(out_boxes[i]),
+                                       ref_boxes(boxes[i], mts[i], in_scale, out_scale),
+                                       rtol=1e-5, atol=1e-4)
+
+
+def test_warp_affine_multi():
+    for normalized_coords in (False, True):
+        yield check_warp_affine_multi, 4, normalized_coords
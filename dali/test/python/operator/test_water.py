@@ -171,3 +171,35 @@ def test_water_vs_cv():
             for dtype in [types.UINT8, types.FLOAT]:
                 for prime_size in [False, True]:
                     yield check_water_vs_cv, device, batch_size, niter, dtype, prime_size
+
+
+def check_water_gpu_float16(batch_size, interp_type, prime_size):
+    @dali.pipeline_def(batch_size=batch_size, num_threads=3, device_id=0)
+    def pipe():
+        inputs, _ = fn.readers.caffe(path=caffe_db_folder)
+        images = fn.decoders.image(inputs, device="mixed", output_type=types.RGB)
+        if prime_size:
+            images = fn.resize(images, resize_x=101, resize_y=43)
+        outs = []
+        for dtype in [types.FLOAT16, types.FLOAT]:
+            out = fn.water(fn.cast(images, dtype=dtype), ampl_x=2.0, ampl_y=3.0,
+                           interp_type=interp_type)
+            outs.append(fn.cast(out, dtype=types.FLOAT))
+        return tuple(outs)
+
+    p = pipe()
+    p.build()
+    for _ in range(2):
+        out_half, out_float = p.run()
+        for i in range(batch_size):
+            a = np.array(out_half.as_cpu()[i])
+            b = np.array(out_float.as_cpu()[i])
+            # float16 has 3 significant digits; the values are in the [0, 255] range
+            assert np.allclose(a, b, atol=0.5), f"max diff: {np.max(np.abs(a - b))}"
+
+
+def test_water_gpu_float16():
+    for batch_size in [1, 3]:
+        for interp_type in [types.INTERP_NN, types.INTERP_LINEAR]:
+            for prime_size in [False, True]:
+                yield check_water_gpu_float16, batch_size, interp_type, prime_size
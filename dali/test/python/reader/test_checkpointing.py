@@ -0,0 +1,100 @@
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import glob
+import os
+
+import numpy as np
+import nvidia.dali.fn as fn
+import nvidia.dali.tfrecord as tfrec
+from nvidia.dali import pipeline_def
+
+from nose_utils import assert_raises
+from test_utils import get_dali_extra_path
+
+test_data_root = get_dali_extra_path()
+jpeg_folder = os.path.join(test_data_root, 'db', 'single', 'jpeg')
+tfrecord_db_folder = os.path.join(test_data_root, 'db', 'tfrecord')
+tfrecord = sorted(glob.glob(os.path.join(tfrecord_db_folder, '*[!i][!d][!x]')))
+tfrecord_idx = sorted(glob.glob(os.path.join(tfrecord_db_folder, '*idx')))
+
+batch_size = 8
+
+
+@pipeline_def(batch_size=batch_size, num_threads=2, device_id=None)
+def file_pipe(enable_checkpointing=True, **kwargs):
+    _, labels = fn.readers.file(file_root=jpeg_folder, enable_checkpointing=enable_checkpointing,
+                                seed=123, name="Reader", **kwargs)
+    return labels
+
+
+@pipeline_def(batch_size=batch_size, num_threads=2, device_id=None)
+def tfrecord_pipe(**kwargs):
+    inputs = fn.readers.tfrecord(
+        path=tfrecord, index_path=tfrecord_idx, enable_checkpointing=True, seed=123,
+        features={"image/class/label": tfrec.FixedLenFeature([1], tfrec.int64, -1)},
+        name="Reader", **kwargs)
+    return inputs["image/class/label"]
+
+
+def run(pipe, iterations):
+    return [np.array(pipe.run()[0].as_tensor()) for _ in range(iterations)]
+
+
+def check_restore(pipe_fn, skip, kwargs):
+    pipe = pipe_fn(**kwargs)
+    pipe.build()
+    run(pipe, skip)
+    state = pipe.reader_state("Reader")
+    expected = run(pipe, 20)
+
+    restored = pipe_fn(**kwargs)
+    restored.build()
+    restored.restore_reader_state("Reader", state)
+    for batch, expected_batch in zip(run(restored, 20), expected):
+        np.testing.assert_array_equal(batch, expected_batch)
+
+
+def test_restore():
+    for pipe_fn in [file_pipe, tfrecord_pipe]:
+        for kwargs in [{"random_shuffle": True, "initial_fill": 32},
+                       {"global_shuffle": True},
+                       {"num_shards": 3, "shard_id": 1, "pad_last_batch": True,
+                        "random_shuffle": True}]:
+            for skip in [0, 5, 100]:
+                yield check_restore, pipe_fn, skip, kwargs
+
+
+def test_checkpointing_errors():
+    pipe = file_pipe()
+    pipe.build()
+    pipe.run()
+    assert_raises(RuntimeError, pipe.restore_reader_state, "Reader", pipe.reader_state("Reader"),
+                  glob="*can be restored only before the pipeline is run*")
+
+    pipe = file_pipe(enable_checkpointing=False)
+    pipe.build()
+    assert_raises(RuntimeError, pipe.reader_state, "Reader",
+                  glob="*available only when `enable_checkpointing` is set*")
+
+    assert_raises(RuntimeError, file_pipe(shuffle_after_epoch=True).build,
+                  glob="*shuffle_after_epoch and enable_checkpointing cannot be both true*")
+
+    restored = file_pipe(random_shuffle=True, initial_fill=16)
+    restored.build()
+    pipe = file_pipe(random_shuffle=True, initial_fill=32)
+    pipe.build()
+    pipe.run()
+    assert_raises(RuntimeError, restored.restore_reader_state, "Reader",
+                  pipe.reader_state("Reader"), glob="*shuffling buffer of 32 samples*")
@@ -1,4 +1,4 @@
-# Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -225,3 +225,33 @@ def test_coco_reader_alias():
 
     for polygon_masks, pixelwise_masks in [(None, None), (True, None), (None, True)]:
         yield check_coco_reader_alias, polygon_masks, pixelwise_masks
+
+
+@pipeline_def(batch_size=4, device_id=0, num_threads=4)
+def coco_cache_pipe(file_root, annotations_file, polygon_masks, pixelwise_masks, ratio,
+                    annotations_cache=None):
+    return tuple(fn.readers.coco(file_root=file_root, annotations_file=annotations_file,
+                                 polygon_masks=polygon_masks, pixelwise_masks=pixelwise_masks,
+                                 ratio=ratio, image_ids=True,
+                                 annotations_cache=annotations_cache))
+
+
+def check_coco_reader_annotations_cache(polygon_masks, pixelwise_masks):
+    file_root = os.path.join(test_data_root, 'db', 'coco_pixelwise', 'images')
+    train_annotations = os.path.join(test_data_root, 'db', 'coco_pixelwise', 'instances.json')
+    with tempfile.TemporaryDirectory() as cache_dir:
+        cache = os.path.join(cache_dir, 'annotations.idx')
+        # the first reader builds the index, the second one maps it and the third one
+        # rebuilds it, because it was built with different arguments
+        for ratio in (False, False, True):
+            ref_pipe = coco_cache_pipe(file_root, train_annotations, polygon_masks,
+                                       pixelwise_masks, ratio)
+            cache_pipe = coco_cache_pipe(file_root, train_annotations, polygon_masks,
+                                         pixelwise_masks, ratio, cache)
+            compare_pipelines(ref_pipe, cache_pipe, 4, 5)
+            assert os.path.exists(cache)
+
+
+def test_coco_reader_annotations_cache():
+    for polygon_masks, pixelwise_masks in [(None, None), (True, None), (None, True)]:
+        yield check_coco_reader_annotations_cache, polygon_masks, pixelwise_masks
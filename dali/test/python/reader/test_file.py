@@ -210,3 +210,121 @@ def test_invalid_number_of_shards():
     pipe = get_test_pipe()
     assert_raises(RuntimeError, pipe.build,
                   glob="The number of input samples: *, needs to be at least equal to the requested number of shards:*.")  # noqa: E501
+
+
+def _test_file_reader_num_read_threads(shuffle, dont_use_mmap, pad_last_batch):
+    batch_size = 4
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4, seed=123)
+    def pipe(num_read_threads):
+        return fn.readers.file(file_root=g_root, files=g_files, random_shuffle=shuffle,
+                               initial_fill=5, dont_use_mmap=dont_use_mmap,
+                               pad_last_batch=pad_last_batch, num_read_threads=num_read_threads)
+
+    compare_pipelines(pipe(num_read_threads=1), pipe(num_read_threads=4), batch_size,
+                      3 * len(g_files) // batch_size)
+
+
+def test_file_reader_num_read_threads():
+    for shuffle in [False, True]:
+        for dont_use_mmap in [False, True]:
+            for pad_last_batch in [False, True]:
+                yield _test_file_reader_num_read_threads, shuffle, dont_use_mmap, pad_last_batch
+
+
+def test_file_reader_wrong_num_read_threads():
+    @pipeline_def(batch_size=1, device_id=0, num_threads=4)
+    def get_test_pipe():
+        return fn.readers.file(file_root=g_root, files=g_files, num_read_threads=0)
+
+    pipe = get_test_pipe()
+    assert_raises(RuntimeError, pipe.build, glob="*`num_read_threads` must be positive*")
+
+
+def test_file_reader_io_uring():
+    batch_size = 4
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4, seed=123)
+    def pipe(**kwargs):
+        return fn.readers.file(file_root=g_root, files=g_files, random_shuffle=True,
+                               initial_fill=5, **kwargs)
+
+    for use_o_direct in [False, True]:
+        for num_read_threads in [1, 4]:
+            compare_pipelines(pipe(), pipe(use_io_uring=True, use_o_direct=use_o_direct,
+                                           num_read_threads=num_read_threads),
+                              batch_size, 2 * len(g_files) // batch_size)
+
+
+def test_file_reader_o_direct_without_io_uring():
+    @pipeline_def(batch_size=1, device_id=0, num_threads=4)
+    def get_test_pipe():
+        return fn.readers.file(file_root=g_root, files=g_files, use_o_direct=True)
+
+    pipe = get_test_pipe()
+    assert_raises(RuntimeError, pipe.build, glob="*`use_o_direct` requires `use_io_uring`*")
+
+
+def test_file_reader_read_policy():
+    batch_size = 4
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4, seed=123)
+    def pipe(**kwargs):
+        return fn.readers.file(file_root=g_root, files=g_files, random_shuffle=True,
+                               initial_fill=5, **kwargs)
+
+    for kwargs in [{"file_access_pattern": "random", "drop_page_cache": True},
+                   {"file_access_pattern": "sequential", "readahead_batches": 2},
+                   {"drop_page_cache": True, "use_io_uring": True, "num_read_threads": 4}]:
+        compare_pipelines(pipe(), pipe(**kwargs), batch_size, 2 * len(g_files) // batch_size)
+
+
+def test_file_reader_wrong_access_pattern():
+    @pipeline_def(batch_size=1, device_id=0, num_threads=4)
+    def get_test_pipe():
+        return fn.readers.file(file_root=g_root, files=g_files, file_access_pattern="backwards")
+
+    pipe = get_test_pipe()
+    assert_raises(RuntimeError, pipe.build,
+                  glob="*`file_access_pattern` must be one of*got \"backwards\"*")
+
+
+def test_file_reader_shared_cache():
+    batch_size = 4
+    cache_name = "dali_test_file_reader_cache_{}".format(os.getpid())
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4, seed=123)
+    def pipe(**kwargs):
+        return fn.readers.file(file_root=g_root, files=g_files, random_shuffle=True,
+                               initial_fill=5, **kwargs)
+
+    try:
+        # the first pipeline fills the cache, the second one reads from it
+        for _ in range(2):
+            compare_pipelines(pipe(), pipe(shared_cache_name=cache_name, shared_cache_size=1),
+                              batch_size, 2 * len(g_files) // batch_size)
+        assert os.path.exists(os.path.join("/dev/shm", cache_name))
+    finally:
+        if os.path.exists(os.path.join("/dev/shm", cache_name)):
+            os.remove(os.path.join("/dev/shm", cache_name))
+
+
+def test_file_reader_shared_cache_no_size():
+    @pipeline_def(batch_size=1, device_id=0, num_threads=4)
+    def get_test_pipe():
+        return fn.readers.file(file_root=g_root, files=g_files, shared_cache_name="dali_no_size")
+
+    pipe = get_test_pipe()
+    assert_raises(RuntimeError, pipe.build, glob="*`shared_cache_size` must be positive*")
+
+
+def test_file_reader_parse_image_info_not_images():
+    batch_size = 3
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4)
+    def pipe(parse_image_info):
+        return fn.readers.file(file_root=g_root, files=g_files,
+                               parse_image_info=parse_image_info)
+
+    # the files which aren't images are passed as they are
+    compare_pipelines(pipe(True), pipe(False), batch_size, 2 * len(g_files) // batch_size)
@@ -145,6 +145,24 @@ def test_mxnet_reader_alias():
     compare_pipelines(new_pipe, legacy_pipe, batch_size_alias_test, 50)
 
 
+@pipeline_def(batch_size=batch_size_alias_test, device_id=0, num_threads=4)
+def mxnet_read_pipe(path, index_path, **kwargs):
+    files, labels = fn.readers.mxnet(path=path, index_path=index_path, **kwargs)
+    return files, labels
+
+
+def test_mxnet_reader_coalesced_reads():
+    recordio = [os.path.join(get_dali_extra_path(), 'db', 'recordio', 'train.rec')]
+    recordio_idx = [os.path.join(get_dali_extra_path(), 'db', 'recordio', 'train.idx')]
+    for shuffle in [False, True]:
+        for num_read_threads in [1, 4]:
+            mmap_pipe = mxnet_read_pipe(recordio, recordio_idx, random_shuffle=shuffle, seed=123)
+            # without mmap, the adjacent records are read together and split in memory
+            read_pipe = mxnet_read_pipe(recordio, recordio_idx, random_shuffle=shuffle, seed=123,
+                                        dont_use_mmap=True, num_read_threads=num_read_threads)
+            compare_pipelines(mmap_pipe, read_pipe, batch_size_alias_test, 10)
+
+
 @pipeline_def(batch_size=batch_size_alias_test, device_id=0, num_threads=4)
 def tfrecord_pipe(tfrecord_op, path, index_path):
     inputs = tfrecord_op(
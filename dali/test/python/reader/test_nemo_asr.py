@@ -317,3 +317,46 @@ def test_read_idxs():
             np.testing.assert_array_equal(np.array(idx1[s]), np.array(idx2[s]))
             idx = np.array(idx1[s])[0]
             assert idx >= 0 and idx < total_samples
+
+
+def test_bucket_by_size():
+    batch_size = 8
+    num_samples = 64
+    rng = np.random.default_rng(1234)
+    durations = rng.uniform(0.05, 2.4, num_samples)
+    manifest = os.path.join(tmp_dir.name, "nemo_asr_manifest_buckets.json")
+    with open(manifest, 'w') as f:
+        for duration in durations:
+            json.dump({'audio_filepath': names[1], 'duration': duration}, f)
+            f.write('\n')
+
+    @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4)
+    def pipe(bucket_by_size):
+        audio, idx = fn.readers.nemo_asr(manifest_filepaths=[manifest], read_sample_rate=False,
+                                         read_text=False, read_idxs=True,
+                                         bucket_by_size=bucket_by_size, bucket_pool_size=2)
+        return audio, idx
+
+    def spreads(p):
+        epoch_idxs = []
+        spread = 0
+        for _ in range(num_samples // batch_size):
+            _, idx = p.run()
+            batch_idxs = [int(np.array(idx[i])[0]) for i in range(batch_size)]
+            batch_durations = durations[batch_idxs]
+            spread += batch_durations.max() - batch_durations.min()
+            epoch_idxs += batch_idxs
+        return spread, epoch_idxs
+
+    p = pipe(True)
+    p.build()
+    ref = pipe(False)
+    ref.build()
+    prev_idxs = None
+    for _ in range(3):
+        spread, idxs = spreads(p)
+        ref_spread, _ = spreads(ref)
+        assert spread < ref_spread / 2, (spread, ref_spread)
+        assert sorted(idxs) == list(range(num_samples))
+        assert idxs != prev_idxs
+        prev_idxs = idxs
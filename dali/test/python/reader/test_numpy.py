@@ -641,3 +641,79 @@ def check_pad_last_sample(device):
 def test_pad_last_sample():
     for device in ["cpu", "gpu"] if is_gds_supported() else ["cpu"]:
         yield check_pad_last_sample, device
+
+
+def check_batch_io(use_batch_io, roi_start, roi_end, roi_axes):
+    # large enough to be read in several chunks
+    shapes = [(40, 128, 128), (33, 128, 130), (1, 10, 10), (64, 100, 100)]
+    batch_size = 3
+    with tempfile.TemporaryDirectory(prefix=gds_data_root) as test_data_root:
+        for i, sh in enumerate(shapes):
+            filename = os.path.join(test_data_root, "test_{:02d}.npy".format(i))
+            create_numpy_file(filename, sh, np.float32, i % 2 == 1)
+
+        @pipeline_def(batch_size=batch_size, device_id=0, num_threads=4)
+        def pipe():
+            kwargs = dict(file_root=test_data_root, shard_id=0, num_shards=1,
+                          roi_start=roi_start, roi_end=roi_end, roi_axes=roi_axes,
+                          out_of_bounds_policy="trim_to_shape")
+            data_cpu = fn.readers.numpy(device="cpu", **kwargs)
+            data_gpu = fn.readers.numpy(device="gpu", use_batch_io=use_batch_io, **kwargs)
+            return data_cpu, data_gpu
+
+        p = pipe()
+        p.build()
+        for _ in range(3):
+            out_cpu, out_gpu = p.run()
+            for i in range(batch_size):
+                assert_array_equal(to_array(out_cpu[i]), to_array(out_gpu[i]))
+
+
+def test_batch_io():
+    if not is_gds_supported():
+        return
+    for use_batch_io in [False, True]:
+        for roi_start, roi_end, roi_axes in [(None, None, None),
+                                             ([5], [30], [0]),
+                                             ([5], [30], [2]),
+                                             ([2, 10], [20, 50], [0, 1])]:
+            yield check_batch_io, use_batch_io, roi_start, roi_end, roi_axes
+
+
+def check_header_cache_file(device):
+    batch_size = 4
+    with tempfile.TemporaryDirectory(prefix=gds_data_root) as test_data_root:
+        names = ["test_{:02d}.npy".format(i) for i in range(batch_size)]
+        for i, name in enumerate(names):
+            create_numpy_file(os.path.join(test_data_root, name), (i + 1, 3), np.float32, False)
+        cache_file = os.path.join(test_data_root, "headers.idx")
+
+        def run():
+            @pipeline_def(batch_size=batch_size, device_id=0, num_threads=2)
+            def pipe():
+                return fn.readers.numpy(device=device, file_root=test_data_root, files=names,
+                                        header_cache_file=cache_file)
+
+            p = pipe()
+            p.build()
+            out, = p.run()
+            for i, name in enumerate(names):
+                assert_array_equal(to_array(out[i]), np.load(os.path.join(test_data_root, name)))
+            del p
+
+        run()
+        # the cache is written when the reader is destroyed
+        with open(cache_file) as f:
+            lines = f.read().splitlines()
+        assert lines[0] == "DALI numpy header cache 1"
+        assert sorted(line.split(" ")[-1] for line in lines[1:]) == \
+            sorted(os.path.join(test_data_root, name) for name in names)
+        run()
+        # a file which changed is parsed again
+        create_numpy_file(os.path.join(test_data_root, names[0]), (7, 3), np.float32, False)
+        run()
+
+
+def test_header_cache_file():
+    for device in ["cpu", "gpu"] if is_gds_supported() else ["cpu"]:
+        yield check_header_cache_file, device
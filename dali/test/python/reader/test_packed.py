@@ -0,0 +1,134 @@
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import nvidia.dali.fn as fn
+import os
+import tempfile
+from nvidia.dali import pipeline_def
+
+from nose_utils import assert_raises
+from test_utils import compare_pipelines, get_dali_extra_path
+
+from dali_pack import PackWriter, image_shape, list_file_root, pack
+
+images_dir = os.path.join(get_dali_extra_path(), 'db', 'single', 'jpeg')
+batch_size = 4
+
+
+@pipeline_def
+def file_pipe(file_list):
+    return fn.readers.file(file_list=file_list, file_root="/", name="Reader")
+
+
+@pipeline_def
+def packed_pipe(paths, index_paths, **kwargs):
+    return fn.readers.packed(path=paths, index_path=index_paths, name="Reader", **kwargs)
+
+
+def pack_images(tmp_dir, samples_per_file=None, image_info=False):
+    samples = list_file_root(images_dir)
+    outputs = pack(samples, os.path.join(tmp_dir, "data"), samples_per_file=samples_per_file,
+                   image_info=image_info, verbose=False)
+    file_list = os.path.join(tmp_dir, "file_list.txt")
+    with open(file_list, "w") as f:
+        for path, label in samples:
+            f.write(f"{path} {label}\n")
+    return samples, [data for data, _ in outputs], [index for _, index in outputs], file_list
+
+
+def check_same_as_file_reader(samples_per_file, kwargs):
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        samples, paths, index_paths, file_list = pack_images(tmp_dir, samples_per_file)
+        pipe = packed_pipe(paths, index_paths, batch_size=batch_size, num_threads=2, device_id=0,
+                           **kwargs)
+        ref_pipe = file_pipe(file_list, batch_size=batch_size, num_threads=2, device_id=0)
+        compare_pipelines(pipe, ref_pipe, batch_size, len(samples) // batch_size + 1)
+
+
+def test_same_as_file_reader():
+    for samples_per_file in [None, 7]:
+        for kwargs in [{}, {"dont_use_mmap": True},
+                       {"use_io_uring": True, "num_read_threads": 3},
+                       {"use_io_uring": True, "use_o_direct": True, "num_read_threads": 3},
+                       {"file_access_pattern": "sequential", "readahead_batches": 2,
+                        "drop_page_cache": True}]:
+            yield check_same_as_file_reader, samples_per_file, kwargs
+
+
+def test_global_shuffle():
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        samples, paths, index_paths, _ = pack_images(tmp_dir, 5)
+        pipe = packed_pipe(paths, index_paths, global_shuffle=True, shuffle_block_size=4,
+                           seed=123, batch_size=1, num_threads=1, device_id=0)
+        pipe.build()
+        read = set()
+        for _ in range(len(samples)):
+            image, label = pipe.run()
+            read.add((image.as_array()[0].tobytes(), int(label.as_array()[0][0])))
+        ref = set()
+        for path, label in samples:
+            with open(path, "rb") as f:
+                ref.add((f.read(), label))
+        assert read == ref
+
+
+def test_global_shuffle_shards():
+    num_shards = 3
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        samples, paths, index_paths, _ = pack_images(tmp_dir, 5)
+        read = []
+        for shard_id in range(num_shards):
+            # the shards, as if on different nodes, differ in `seed`, but share the permutation
+            pipe = packed_pipe(paths, index_paths, global_shuffle=True, global_shuffle_seed=42,
+                               num_shards=num_shards, shard_id=shard_id, dont_use_mmap=True,
+                               num_read_threads=4, seed=shard_id, batch_size=1, num_threads=1,
+                               device_id=0)
+            pipe.build()
+            shard_size = (len(samples) * (shard_id + 1) // num_shards -
+                          len(samples) * shard_id // num_shards)
+            for _ in range(shard_size):
+                image, label = pipe.run()
+                read.append((image.as_array()[0].tobytes(), int(label.as_array()[0][0])))
+        ref = []
+        for path, label in samples:
+            with open(path, "rb") as f:
+                ref.append((f.read(), label))
+        assert sorted(read) == sorted(ref)
+
+
+def test_image_shapes():
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        samples, paths, index_paths, _ = pack_images(tmp_dir, image_info=True)
+        pipe = packed_pipe(paths, index_paths, image_shapes=True, batch_size=batch_size,
+                           num_threads=1, device_id=0)
+        pipe.build()
+        for _ in range(len(samples) // batch_size):
+            images, _, shapes = pipe.run()
+            for i in range(batch_size):
+                ref_shape = image_shape(images.at(i).tobytes())
+                assert np.array_equal(shapes.at(i), ref_shape), f"{shapes.at(i)} != {ref_shape}"
+
+
+def test_wrong_index():
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        data_path = os.path.join(tmp_dir, "data.dpk")
+        index_path = os.path.join(tmp_dir, "data.idx")
+        with PackWriter(data_path, index_path) as writer:
+            writer.add(b"abc", 1)
+        with open(index_path, "a") as f:
+            f.write("100 3 1\n")
+        pipe = packed_pipe([data_path], [index_path], batch_size=1, num_threads=1, device_id=0)
+        with assert_raises(RuntimeError, glob="is not aligned to 4096 bytes"):
+            pipe.build()
@@ -0,0 +1,84 @@
+# Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+
+import numpy as np
+import nvidia.dali.fn as fn
+from nvidia.dali import pipeline_def
+
+from nose_utils import assert_raises
+from test_utils import get_dali_extra_path
+
+jpeg_folder = os.path.join(get_dali_extra_path(), 'db', 'single', 'jpeg')
+
+
+@pipeline_def(batch_size=1, num_threads=2, device_id=None)
+def file_pipe(**kwargs):
+    jpegs, _ = fn.readers.file(file_root=jpeg_folder, name="Reader", **kwargs)
+    return fn.get_property(jpegs, key="source_info")
+
+
+def read(pipe, n):
+    return [bytes(np.array(pipe.run()[0][0])).decode() for _ in range(n)]
+
+
+def part_size(shard_id, num_shards, size):
+    return size * (shard_id + 1) // num_shards - size * shard_id // num_shards
+
+
+def test_reshard_before_run():
+    pipe = file_pipe(num_shards=2, shard_id=0)
+    pipe.build()
+    pipe.reshard_reader("Reader", 3, 2)
+    meta = pipe.reader_meta("Reader")
+    assert meta["number_of_shards"] == 3 and meta["shard_id"] == 2
+    ref = file_pipe(num_shards=3, shard_id=2)
+    ref.build()
+    assert read(pipe, 10) == read(ref, 10)
+
+
+def test_reshard_at_epoch_end():
+    pipes = [file_pipe(num_shards=2, shard_id=i) for i in range(2)]
+    for pipe in pipes:
+        pipe.build()
+    size = pipes[0].reader_meta("Reader")["epoch_size"]
+    epoch = []
+    for i, pipe in enumerate(pipes):
+        epoch += read(pipe, 1)
+        # a worker joins - the readers switch to 3 shards with the next epoch
+        pipe.reshard_reader("Reader", 3, i)
+        epoch += read(pipe, part_size(i, 2, size) - 1)
+    assert len(set(epoch)) == size
+
+    joined = file_pipe(num_shards=3, shard_id=2)
+    joined.build()
+    next_epoch = []
+    for i, pipe in enumerate(pipes + [joined]):
+        next_epoch += read(pipe, part_size(i, 3, size))
+        assert pipe.reader_meta("Reader")["number_of_shards"] == 3
+    assert sorted(next_epoch) == sorted(epoch)
+
+
+def test_reshard_errors():
+    pipe = file_pipe(num_shards=2, shard_id=0)
+    with assert_raises(RuntimeError, glob="Pipeline must be built first"):
+        pipe.reshard_reader("Reader", 3, 0)
+    pipe.build()
+    with assert_raises(RuntimeError, glob="Invalid shard 3 out of 3"):
+        pipe.reshard_reader("Reader", 3, 3)
+    with assert_raises(RuntimeError, glob="*cannot be resharded*"):
+        pipe = file_pipe(num_shards=2, shard_id=0, enable_checkpointing=True)
+        pipe.build()
+        pipe.reshard_reader("Reader", 3, 0)
@@ -0,0 +1,98 @@
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import glob
+import os
+
+import nvidia.dali.fn as fn
+import nvidia.dali.tfrecord as tfrec
+from nose.tools import assert_equal
+from nvidia.dali import pipeline_def
+
+import webdataset_base as base
+from nose_utils import assert_raises
+from test_utils import compare_pipelines, get_dali_extra_path
+
+test_data_root = get_dali_extra_path()
+tfrecord_db_folder = os.path.join(test_data_root, 'db', 'tfrecord')
+tfrecord = sorted(glob.glob(os.path.join(tfrecord_db_folder, '*[!i][!d][!x]')))
+tfrecord_idx = sorted(glob.glob(os.path.join(tfrecord_db_folder, '*idx')))
+wds = [os.path.join(test_data_root, 'db', 'webdataset', 'MNIST', archive)
+       for archive in ['devel-0.tar', 'devel-1.tar', 'devel-2.tar']]
+
+batch_size = 16
+
+
+@pipeline_def(batch_size=batch_size, num_threads=1, device_id=None)
+def tfrecord_pipe(streaming, **kwargs):
+    inputs = fn.readers.tfrecord(
+        path=tfrecord, index_path=None if streaming else tfrecord_idx, streaming=streaming,
+        features={
+            "image/encoded": tfrec.FixedLenFeature((), tfrec.string, ""),
+            "image/class/label": tfrec.FixedLenFeature([1], tfrec.int64, -1)
+        }, name="Reader", **kwargs)
+    return inputs["image/encoded"], inputs["image/class/label"]
+
+
+@pipeline_def(batch_size=batch_size, num_threads=1, device_id=None)
+def wds_pipe(paths, index_paths=None, **kwargs):
+    return fn.readers.webdataset(paths=paths, index_paths=index_paths, ext=["jpg", "cls"],
+                                 name="Reader", **kwargs)
+
+
+def test_tfrecord_streaming():
+    for kwargs in [{}, {"stream_buffer_size": 1}, {"dont_use_mmap": True}]:
+        stream = tfrecord_pipe(True, **kwargs)
+        indexed = tfrecord_pipe(False)
+        compare_pipelines(stream, indexed, batch_size, 20)
+        stream.build()
+        assert_equal(stream.epoch_size("Reader"), -1)
+
+
+def test_webdataset_streaming():
+    index_files = [base.generate_temp_index_file(archive) for archive in wds]
+    # 3 archives of 1000 samples - goes through all of them and starts over
+    compare_pipelines(wds_pipe(wds, streaming=True),
+                      wds_pipe(wds, [idx.name for idx in index_files]),
+                      batch_size, 3000 // batch_size + 10)
+
+
+def test_webdataset_streaming_shards():
+    # the shards get whole archives
+    for shard_id in range(len(wds)):
+        compare_pipelines(wds_pipe(wds, streaming=True, num_shards=len(wds), shard_id=shard_id),
+                          wds_pipe([wds[shard_id]]),
+                          batch_size, 5)
+    assert_raises(RuntimeError, wds_pipe(wds, streaming=True, num_shards=4, shard_id=0).build,
+                  glob="*the dataset is sharded by files*")
+
+
+def test_streaming_shuffle():
+    # random_shuffle works as usual - the buffer is filled from the stream
+    pipe = wds_pipe(wds, streaming=True, random_shuffle=True, initial_fill=64, seed=123)
+    pipe.build()
+    labels = set()
+    for _ in range(10):
+        _, cls = pipe.run()
+        labels.update(bytes(cls.at(i)) for i in range(batch_size))
+    assert len(labels) > 1
+
+
+def test_streaming_argument_errors():
+    assert_raises(RuntimeError, wds_pipe(wds, streaming=True, global_shuffle=True).build,
+                  glob="*`global_shuffle` and `streaming` cannot be both true*")
+    assert_raises(RuntimeError, tfrecord_pipe(True, pad_last_batch=True).build,
+                  glob="*`pad_last_batch` and `streaming` cannot be both true*")
+    assert_raises(RuntimeError, tfrecord_pipe(True, stream_buffer_size=0).build,
+                  glob="*`stream_buffer_size` must be positive*")
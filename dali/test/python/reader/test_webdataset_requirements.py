@@ -13,6 +13,8 @@
 # limitations under the License.
 
 import os
+import shutil
+import tempfile
 from glob import glob
 import math
 import nvidia.dali as dali
@@ -318,3 +320,67 @@ def test_index_generation():
             test_batch_size,
             math.ceil(num_samples / num_shards / test_batch_size) * 2,
         )
+
+
+def test_index_cache():
+    global test_batch_size
+    num_samples = 3000
+    with tempfile.TemporaryDirectory() as data_dir, tempfile.TemporaryDirectory() as cache_dir:
+        tar_file_paths = []
+        for i in range(3):
+            src = os.path.join(get_dali_extra_path(), f"db/webdataset/MNIST/devel-{i}.tar")
+            tar_file_paths.append(shutil.copy(src, data_dir))
+
+        extract_dirs = [generate_temp_extract(tar_file_path) for tar_file_path in tar_file_paths]
+        equivalent_files = sum(
+            list(
+                sorted(glob(extract_dir.name + "/*"),
+                       key=lambda s: int(s[s.rfind("/") + 1: s.rfind(".")]))
+                for extract_dir in extract_dirs),
+            [],
+        )
+
+        def check():
+            compare_pipelines(
+                webdataset_raw_pipeline(
+                    tar_file_paths,
+                    [],
+                    ["jpg", "cls"],
+                    missing_component_behavior="error",
+                    index_cache_dir=cache_dir,
+                    batch_size=test_batch_size,
+                    device_id=0,
+                    num_threads=4,
+                ),
+                file_reader_pipeline(
+                    equivalent_files,
+                    ["jpg", "cls"],
+                    batch_size=test_batch_size,
+                    device_id=0,
+                    num_threads=1,
+                ),
+                test_batch_size,
+                math.ceil(num_samples / test_batch_size),
+            )
+
+        # the first run stores the indices, the next ones read them
+        check()
+        indices = sorted(glob(os.path.join(cache_dir, "*.idx")))
+        assert_equal(len(indices), len(tar_file_paths))
+        check()
+
+        # a modified archive is scanned again
+        def headers():
+            result = []
+            for index in indices:
+                with open(index) as f:
+                    result.append(f.readline())
+            return result
+
+        old_headers = headers()
+        mtime = os.path.getmtime(tar_file_paths[0])
+        os.utime(tar_file_paths[0], (mtime + 10, mtime + 10))
+        check()
+        assert_equal(sorted(glob(os.path.join(cache_dir, "*.idx"))), indices)
+        changed = [old != new for old, new in zip(old_headers, headers())]
+        assert_equal(sum(changed), 1)
@@ -0,0 +1,170 @@
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import itertools
+import json
+import os
+import tempfile
+import zlib
+
+import numpy as np
+import nvidia.dali.fn as fn
+from nvidia.dali import pipeline_def
+from numpy.testing import assert_array_equal
+
+from nose_utils import assert_raises
+
+rng = np.random.default_rng(12345)
+batch_size = 3
+
+
+def write_zarr_array(path, arr, chunks, compressor=None, fill_value=0, skip_chunks=(),
+                     dimension_separator="."):
+    """Writes a Zarr v2 array without the `zarr` module. The chunks in `skip_chunks` are not
+    stored, so they read as `fill_value`."""
+    os.makedirs(path)
+    meta = {
+        "zarr_format": 2,
+        "shape": list(arr.shape),
+        "chunks": list(chunks),
+        "dtype": arr.dtype.str,
+        "compressor": {"id": compressor, "level": 1} if compressor else None,
+        "fill_value": fill_value,
+        "order": "C",
+        "filters": None,
+        "dimension_separator": dimension_separator,
+    }
+    with open(os.path.join(path, ".zarray"), "w") as f:
+        json.dump(meta, f)
+    nchunks = [(s + c - 1) // c for s, c in zip(arr.shape, chunks)]
+    for idx in itertools.product(*[range(n) for n in nchunks]):
+        if idx in skip_chunks:
+            continue
+        # the chunks at the end of the array are stored whole
+        chunk = np.zeros(chunks, dtype=arr.dtype)
+        region = tuple(slice(i * c, (i + 1) * c) for i, c in zip(idx, chunks))
+        data = arr[region]
+        chunk[tuple(slice(0, s) for s in data.shape)] = data
+        raw = chunk.tobytes()
+        if compressor == "zlib":
+            raw = zlib.compress(raw)
+        elif compressor == "gzip":
+            co = zlib.compressobj(wbits=31)
+            raw = co.compress(raw) + co.flush()
+        chunk_path = os.path.join(path, dimension_separator.join(str(i) for i in idx))
+        os.makedirs(os.path.dirname(chunk_path), exist_ok=True)
+        with open(chunk_path, "wb") as f:
+            f.write(raw)
+
+
+def expected_array(arr, chunks, fill_value, skip_chunks):
+    arr = arr.copy()
+    for idx in skip_chunks:
+        arr[tuple(slice(i * c, (i + 1) * c) for i, c in zip(idx, chunks))] = fill_value
+    return arr
+
+
+def make_dataset(root, compressor, dimension_separator, dtype=np.float32):
+    shape, chunks = (37, 29, 3), (8, 10, 3)
+    skip_chunks = [(1, 1, 0)]
+    arrays = []
+    for i in range(batch_size):
+        arr = (rng.random(shape) * 100).astype(dtype)
+        write_zarr_array(os.path.join(root, f"arr{i}"), arr, chunks, compressor, fill_value=5,
+                         skip_chunks=skip_chunks, dimension_separator=dimension_separator)
+        arrays.append(expected_array(arr, chunks, 5, skip_chunks))
+    return arrays
+
+
+def run_reader(root, **kwargs):
+    @pipeline_def(batch_size=batch_size, num_threads=3, device_id=None)
+    def pipe():
+        return fn.readers.zarr(file_root=root, **kwargs)
+
+    p = pipe()
+    p.build()
+    out, = p.run()
+    return [np.array(out[i]) for i in range(batch_size)]
+
+
+def check_read_whole(compressor, dimension_separator):
+    with tempfile.TemporaryDirectory() as root:
+        arrays = make_dataset(root, compressor, dimension_separator)
+        out = run_reader(root)
+        for i in range(batch_size):
+            assert_array_equal(out[i], arrays[i])
+
+
+def test_read_whole():
+    for compressor in [None, "zlib", "gzip"]:
+        for dimension_separator in [".", "/"]:
+            yield check_read_whole, compressor, dimension_separator
+
+
+def check_read_roi(roi_start, roi_end, roi_axes):
+    with tempfile.TemporaryDirectory() as root:
+        arrays = make_dataset(root, "zlib", ".")
+        out = run_reader(root, roi_start=roi_start, roi_end=roi_end, roi_axes=roi_axes)
+        axes = roi_axes or range(len(roi_start))
+        for i in range(batch_size):
+            region = [slice(None)] * arrays[i].ndim
+            for a, s, e in zip(axes, roi_start, roi_end):
+                region[a] = slice(s, e)
+            assert_array_equal(out[i], arrays[i][tuple(region)])
+
+
+def test_read_roi():
+    for roi_start, roi_end, roi_axes in [
+            ([3, 7, 0], [20, 25, 3], []),   # several chunks
+            ([9, 11, 1], [10, 12, 2], []),  # a single element
+            ([8, 10], [16, 20], [0, 1]),    # exactly the missing chunk
+            ([5], [30], [1])]:
+        yield check_read_roi, roi_start, roi_end, roi_axes
+
+
+def test_read_roi_pad():
+    with tempfile.TemporaryDirectory() as root:
+        arrays = make_dataset(root, None, ".")
+        out = run_reader(root, roi_start=[-4, 20], roi_end=[10, 35], roi_axes=[0, 1],
+                         out_of_bounds_policy="pad", fill_value=-1)
+        for i in range(batch_size):
+            expected = np.full((14, 15, 3), -1, dtype=np.float32)
+            expected[4:, :9] = arrays[i][:10, 20:]
+            assert_array_equal(out[i], expected)
+
+
+def test_read_roi_out_of_bounds():
+    with tempfile.TemporaryDirectory() as root:
+        make_dataset(root, None, ".")
+        with assert_raises(RuntimeError, glob="*out of bounds*"):
+            run_reader(root, roi_start=[30], roi_end=[40], roi_axes=[0])
+
+
+def test_unsupported_compressor():
+    with tempfile.TemporaryDirectory() as root:
+        write_zarr_array(os.path.join(root, "arr"), np.zeros((4,), np.uint8), (2,))
+        with open(os.path.join(root, "arr", ".zarray")) as f:
+            meta = json.load(f)
+        meta["compressor"] = {"id": "blosc"}
+        with open(os.path.join(root, "arr", ".zarray"), "w") as f:
+            json.dump(meta, f)
+
+        @pipeline_def(batch_size=1, num_threads=1, device_id=None)
+        def pipe():
+            return fn.readers.zarr(file_root=root)
+
+        p = pipe()
+        with assert_raises(RuntimeError, glob="*Unsupported compressor*"):
+            p.build()
+            p.run()
@@ -319,3 +319,20 @@ def test_tensor_from_tensor_list_gpu():
         out += ts
     for i, t in enumerate(out):
         np.testing.assert_array_equal(np.array(t.as_cpu()), np.full((4,), i // 3))
+
+
+def test_memory_budget_stats():
+    from nvidia.dali import backend
+    a = np.full((1024, 1024), 1, dtype=np.float32)
+    t = tensors.TensorGPU(cp.array(a), "")
+    np.testing.assert_array_equal(np.array(t.as_cpu()), a)
+    stats = backend.GetDeviceMemoryBudgetStats()
+    assert stats["limit"] is None
+    assert stats["peak"] >= stats["used"]
+    for component in stats["components"].values():
+        assert component["peak"] >= component["current"]
+    backend.SetDeviceMemoryBudget(1 << 40)
+    assert backend.GetDeviceMemoryBudgetStats()["limit"] == 1 << 40
+    backend.SetDeviceMemoryBudget(None)
+    assert backend.GetDeviceMemoryBudgetStats()["limit"] is None
+    assert "components" in backend.GetPinnedMemoryBudgetStats()
@@ -147,6 +147,32 @@ def test_image_decoder_cpu():
         pipe.run()
 
 
+def test_cache_cpu():
+    pipe = Pipeline(batch_size=batch_size, num_threads=4, device_id=None)
+    with pipe:
+        input, _ = fn.readers.file(file_root=images_dir, shard_id=0, num_shards=1)
+        hit = fn.experimental.cache_lookup(input, cache_name="cpu_only", host_size=64)
+        cached_input, new_input = fn._conditional.split(input, predicate=hit)
+        decoded = fn.decoders.image(new_input, output_type=types.RGB)
+        decoded = fn.experimental.cache_store(decoded, new_input, cache_name="cpu_only")
+        cached = fn.experimental.cache_fetch(cached_input, cache_name="cpu_only")
+        pipe.set_outputs(fn._conditional.merge(cached, decoded, predicate=hit))
+    pipe.build()
+    for _ in range(3):
+        pipe.run()
+
+
+def test_imgcodec_decoder_cpu():
+    pipe = Pipeline(batch_size=batch_size, num_threads=4, device_id=None)
+    with pipe:
+        input, _ = fn.readers.file(file_root=images_dir, shard_id=0, num_shards=1)
+        decoded = fn.experimental.decoders.image(input, output_type=types.RGB)
+        pipe.set_outputs(decoded)
+    pipe.build()
+    for _ in range(3):
+        pipe.run()
+
+
 def check_single_input(op, input_layout="HWC", get_data=get_data, batch=True, cycle=None,
                        exec_async=True, exec_pipelined=True, **kwargs):
     pipe = Pipeline(batch_size=batch_size, num_threads=4, device_id=None, exec_async=exec_async,
@@ -204,6 +230,10 @@ def test_color_twist_cpu():
     check_single_input(fn.color_twist)
 
 
+def test_color_adjust_cpu():
+    check_single_input(fn.experimental.color_adjust, hue=10, gamma=1.5)
+
+
 def test_saturation_cpu():
     check_single_input(fn.saturation)
 
@@ -284,6 +314,16 @@ def test_image_decoder_random_crop_device():
         pipe.run()
 
 
+def test_image_decoder_resize_device():
+    pipe = Pipeline(batch_size=batch_size, num_threads=4, device_id=None)
+    input, _ = fn.readers.file(file_root=images_dir, shard_id=0, num_shards=1)
+    decoded = fn.decoders.image_resize(input, output_type=types.RGB, resize_shorter=32)
+    pipe.set_outputs(decoded)
+    pipe.build()
+    for _ in range(3):
+        pipe.run()
+
+
 def test_coin_flip_device():
     check_no_input(fn.random.coin_flip)
 
@@ -320,6 +360,11 @@ def test_random_resized_crop_cpu():
     check_single_input(fn.random_resized_crop, size=[5, 5])
 
 
+def test_random_resized_multi_crop_cpu():
+    check_single_input(fn.experimental.random_resized_multi_crop, num_crops=[1, 2],
+                       size=[5, 5, 3, 3])
+
+
 def test_expand_dims_cpu():
     check_single_input(fn.expand_dims, axes=1, new_axis_names="Z")
 
@@ -339,6 +384,10 @@ def test_multi_paste_cpu():
     check_single_input(fn.multi_paste, in_ids=np.array([0, 1]), output_size=test_data_shape)
 
 
+def test_pack_images_cpu():
+    check_single_input(fn.experimental.pack_images, canvas_size=[20, 40])
+
+
 def test_roi_random_crop_cpu():
     check_single_input(fn.roi_random_crop,
                        crop_shape=[x // 2 for x in test_data_shape],
@@ -534,6 +583,18 @@ def test_bb_flip_cpu():
     check_single_input(fn.bb_flip, get_data=get_data, input_layout=None)
 
 
+def test_coord_pipeline_cpu():
+    test_data_shape = [200, 4]
+
+    def get_data():
+        out = [(np.random.randint(0, 255, size=test_data_shape, dtype=np.uint8) / 255).astype(
+            dtype=np.float32) for _ in range(batch_size)]
+        return out
+
+    check_single_input(fn.coord_pipeline, get_data=get_data, input_layout=None, boxes=True,
+                       flip=[1, 0], clip=True)
+
+
 def test_warp_affine_cpu():
     warp_matrix = (0.1, 0.9, 10, 0.8, -0.2, -20)
     check_single_input(fn.warp_affine, matrix=warp_matrix)
@@ -978,6 +1039,17 @@ def test_cat_cpu():
         pipe.run()
 
 
+def test_masked_select_cpu():
+    pipe = Pipeline(batch_size=batch_size, num_threads=3, device_id=None)
+    data = fn.external_source(source=get_data, layout="HWC")
+    mask = fn.reductions.mean(data, axes=(1, 2)) > 127
+    out = fn.masked_select(mask, data)
+    pipe.set_outputs(out)
+    pipe.build()
+    for _ in range(3):
+        pipe.run()
+
+
 def test_stack_cpu():
     pipe = Pipeline(batch_size=batch_size, num_threads=3, device_id=None)
     data = fn.external_source(source=get_data, layout="HWC")
@@ -1090,7 +1162,9 @@ tested_methods = [
     "decoders.image_crop",
     "decoders.image_slice",
     "decoders.image_random_crop",
+    "decoders.image_resize",
     "decoders.audio",
+    "experimental.decoders.image",
     "external_source",
     "stack",
     "reductions.variance",
@@ -1146,6 +1220,7 @@ tested_methods = [
     "contrast",
     "hsv",
     "color_twist",
+    "experimental.color_adjust",
     "saturation",
     "shapes",
     "crop",
@@ -1167,10 +1242,13 @@ tested_methods = [
     "sphere",
     "erase",
     "random_resized_crop",
+    "experimental.random_resized_multi_crop",
     "ssd_random_crop",
     "bbox_paste",
     "coord_flip",
+    "coord_pipeline",
     "cat",
+    "masked_select",
     "bb_flip",
     "warp_affine",
     "normalize",
@@ -1204,6 +1282,7 @@ tested_methods = [
     "coord_transform",
     "grid_mask",
     "multi_paste",
+    "experimental.pack_images",
     "roi_random_crop",
     "segmentation.random_object_bbox",
     "tensor_subscript",
@@ -1240,17 +1319,25 @@ tested_methods = [
     "numba.fn.experimental.numba_function",
     "dl_tensor_python_function",
     "audio_resample",
+    "experimental.cache_lookup",
+    "experimental.cache_fetch",
+    "experimental.cache_store",
 ]
 
 excluded_methods = [
     "hidden.*",
     "jitter",  # not supported for CPU
+    "experimental.random_resized_crop_mirror_normalize",  # not supported for CPU
     "video_reader",  # not supported for CPU
     "video_reader_resize",  # not supported for CPU
     "readers.video",  # not supported for CPU
     "readers.video_resize",  # not supported for CPU
     "optical_flow",  # not supported for CPU
     "paste",  # not supported for CPU
+    "segmentation.rasterize_polygons",  # not supported for CPU
+    "experimental.warp_affine_multi",  # not supported for CPU
+    "experimental.batch_mix",  # not supported for CPU
+    "experimental.preemphasis_trim",  # not supported for CPU
     "experimental.audio_resample"  # Alias of audio_resample (already tested)
 ]
 
@@ -256,6 +256,7 @@ ops_image_default_args = [
     fn.brightness_contrast,
     fn.cat,
     fn.color_twist,
+    fn.experimental.color_adjust,
     fn.contrast,
     fn.copy,
     fn.crop_mirror_normalize,
@@ -316,6 +317,8 @@ ops_image_custom_args = [
     (fn.rotate, {'angle': 25}),
     (fn.transpose, {'perm': [2, 0, 1]}),
     (fn.warp_affine, {'matrix': (.1, .9, 10, .8, -.2, -20)}),
+    (fn.experimental.warp_affine_multi, {'MT': (.1, .9, 10, .8, -.2, -20), 'devices': ['gpu']}),
+    (fn.experimental.batch_mix, {'mode': 'mosaic', 'devices': ['gpu']}),
     (fn.expand_dims, {'axes': 1, 'new_axis_names': "Z"}),
     (fn.grid_mask, {'angle': 2.6810782, 'ratio': 0.38158387, 'tile': 51}),
     (numba_function, {
@@ -344,6 +347,7 @@ def test_ops_image_custom_args():
 float_array_ops = [
     (fn.power_spectrum, {'devices': ['cpu']}),
     (fn.preemphasis_filter, {}),
+    (fn.experimental.preemphasis_trim, {'devices': ['gpu']}),
     (fn.spectrogram, {'nfft': 60, 'window_length': 50, 'window_step': 25}),
     (fn.to_decibels, {}),
     (fn.audio_resample, {'devices': ['cpu'], 'scale': 1.2}),
@@ -358,10 +362,12 @@ def test_float_array_ops():
 random_ops = [
     (fn.jitter, {'devices': ['gpu']}),
     (fn.random_resized_crop, {'size': 69}),
+    (fn.experimental.random_resized_crop_mirror_normalize, {'devices': ['gpu'], 'size': 69}),
+    (fn.experimental.random_resized_multi_crop, {'num_crops': [1], 'size': 69}),
     (fn.noise.gaussian, {}),
     (fn.noise.shot, {}),
     (fn.noise.salt_and_pepper, {}),
-    (fn.segmentation.random_mask_pixel, {'devices': ['cpu']}),
+    (fn.segmentation.random_mask_pixel, {}),
     (fn.roi_random_crop, {'devices': ['cpu'], 'crop_shape': [10, 15, 3], 'roi_start': [25, 20, 0],
                           'roi_shape': [40, 30, 3]})
 ]
@@ -564,7 +570,7 @@ def test_random_object_bbox():
                   [0, 2, 0, 1],
                   [0, 2, 2, 1]])
     ]
-    run_pipeline(get_data, pipeline_fn=pipe, devices=['cpu'])
+    run_pipeline(get_data, pipeline_fn=pipe, devices=['cpu', 'gpu'])
 
 
 def test_math_ops():
@@ -702,7 +708,7 @@ def test_random_bbox_crop_op():
         return (bboxes, labels)
 
     input_data = [get_data(random.randint(5, 31)) for _ in range(13)]
-    run_pipeline(input_data, pipeline_fn=pipe, devices=["cpu"])
+    run_pipeline(input_data, pipeline_fn=pipe, devices=["cpu", "gpu"])
 
 
 def test_ssd_random_crop_op():
@@ -729,7 +735,7 @@ def test_ssd_random_crop_op():
         return (data, bboxes, labels)
 
     input_data = [get_data(random.randint(5, 31)) for _ in range(13)]
-    run_pipeline(input_data, pipeline_fn=pipe, devices=["cpu"])
+    run_pipeline(input_data, pipeline_fn=pipe, devices=["cpu", "gpu"])
 
 
 def test_reshape():
@@ -757,6 +763,12 @@ def test_bb_flip():
                    single_op_pipeline, operator_fn=fn.bb_flip)
 
 
+def test_coord_pipeline():
+    check_pipeline(generate_data(31, 13, custom_shape_generator(150, 250, 4, 4)),
+                   single_op_pipeline, operator_fn=fn.coord_pipeline, boxes=True, flip=[1, 0],
+                   normalize=2.0, clip=True)
+
+
 def test_1_hot():
     data = generate_data(31, 13, array_1d_shape_generator, lo=0, hi=255, dtype=np.uint8)
     check_pipeline(data, single_op_pipeline, operator_fn=fn.one_hot)
@@ -774,7 +786,31 @@ def test_bbox_paste():
         return pipe
 
     check_pipeline(generate_data(31, 13, custom_shape_generator(150, 250, 4, 4)), pipe, eps=.5,
-                   devices=['cpu'])
+                   devices=['cpu', 'gpu'])
+
+
+def test_pack_images():
+    def pipe(max_batch_size, input_data, device):
+        pipe = Pipeline(batch_size=max_batch_size, num_threads=4, device_id=0)
+        data = fn.external_source(source=input_data, cycle=False, device=device, layout="HWC")
+        canvases, placements = fn.experimental.pack_images(data, canvas_size=[400, 300])
+        pipe.set_outputs(canvases, placements)
+        return pipe
+
+    check_pipeline(generate_data(31, 13, image_like_shape_generator, lo=0, hi=255,
+                                 dtype=np.uint8), pipe)
+
+
+def test_masked_select():
+    def pipe(max_batch_size, input_data, device):
+        pipe = Pipeline(batch_size=max_batch_size, num_threads=4, device_id=0)
+        data = fn.external_source(source=input_data, cycle=False, device=device, layout="HWC")
+        mask = fn.reductions.mean(data, axes=(1, 2)) > 127
+        pipe.set_outputs(fn.masked_select(mask, data))
+        return pipe
+
+    check_pipeline(generate_data(31, 13, image_like_shape_generator, lo=0, hi=255,
+                                 dtype=np.uint8), pipe)
 
 
 def test_coord_flip():
@@ -944,6 +980,13 @@ def test_image_decoders():
         pipe.set_outputs(decoded)
         return pipe
 
+    def imgcodec_decoder_pipe(max_batch_size, input_data, device):
+        pipe = Pipeline(batch_size=max_batch_size, num_threads=4, device_id=0)
+        encoded = fn.external_source(source=input_data, cycle=False, device='cpu')
+        decoded = fn.experimental.decoders.image(encoded, device=device)
+        pipe.set_outputs(decoded)
+        return pipe
+
     def image_decoder_crop_pipe(max_batch_size, input_data, device):
         pipe = Pipeline(batch_size=max_batch_size, num_threads=4, device_id=0)
         encoded = fn.external_source(source=input_data, cycle=False, device='cpu')
@@ -967,6 +1010,13 @@ def test_image_decoders():
         pipe.set_outputs(decoded)
         return pipe
 
+    def image_decoder_resize_pipe(max_batch_size, input_data, device):
+        pipe = Pipeline(batch_size=max_batch_size, num_threads=4, device_id=0)
+        encoded = fn.external_source(source=input_data, cycle=False, device='cpu')
+        decoded = fn.decoders.image_resize(encoded, device=device, resize_shorter=32)
+        pipe.set_outputs(decoded)
+        return pipe
+
     def peek_image_shape_pipe(max_batch_size, input_data, device):
         pipe = Pipeline(batch_size=max_batch_size, num_threads=4, device_id=0)
         encoded = fn.external_source(source=input_data, cycle=False, device='cpu')
@@ -977,6 +1027,7 @@ def test_image_decoders():
     image_decoder_extensions = ['.jpg', '.bmp', '.png', '.pnm', '.jp2']
     image_decoder_pipes = [
         image_decoder_pipe,
+        imgcodec_decoder_pipe,
         image_decoder_crop_pipe,
         image_decoder_slice_pipe,
     ]
@@ -986,6 +1037,7 @@ def test_image_decoders():
         for pipe in image_decoder_pipes:
             yield test_decoders_check, pipe, data_path, ext, ['cpu', 'mixed']
         yield test_decoders_run, image_decoder_rcrop_pipe, data_path, ext, ['cpu', 'mixed']
+        yield test_decoders_check, image_decoder_resize_pipe, data_path, ext, ['cpu']
 
     yield test_decoders_check, peek_image_shape_pipe, data_path, '.jpg', ['cpu']
 
@@ -1027,7 +1079,7 @@ def test_segmentation_select_masks():
         return make_batch_select_masks(*args, **kwargs)
 
     def pipe(max_batch_size, input_data, device):
-        pipe = Pipeline(batch_size=max_batch_size, num_threads=4, device_id=None, seed=1234)
+        pipe = Pipeline(batch_size=max_batch_size, num_threads=4, device_id=0, seed=1234)
         with pipe:
             polygons, vertices, selected_masks = fn.external_source(
                 num_outputs=3, device=device, source=input_data
@@ -1041,7 +1093,25 @@ def test_segmentation_select_masks():
         get_data_source(random.randint(5, 31), vertex_ndim=2, npolygons_range=(1, 5),
                         nvertices_range=(3, 10))
         for _ in range(13)]
-    check_pipeline(input_data, pipeline_fn=pipe, devices=["cpu"])
+    check_pipeline(input_data, pipeline_fn=pipe, devices=["cpu", "gpu"])
+
+
+def test_segmentation_rasterize_polygons():
+    def pipe(max_batch_size, input_data, device):
+        pipe = Pipeline(batch_size=max_batch_size, num_threads=4, device_id=0, seed=1234)
+        with pipe:
+            polygons, vertices, _ = fn.external_source(
+                num_outputs=3, device=device, source=input_data
+            )
+            mask = fn.segmentation.rasterize_polygons(polygons, vertices, size=(30, 40),
+                                                      MT=[40, 0, 0, 0, 30, 0])
+        pipe.set_outputs(mask)
+        return pipe
+    input_data = [
+        make_batch_select_masks(random.randint(5, 31), vertex_ndim=2, npolygons_range=(1, 5),
+                                nvertices_range=(3, 10))
+        for _ in range(13)]
+    check_pipeline(input_data, pipeline_fn=pipe, devices=["gpu"])
 
 
 def test_optical_flow():
@@ -1123,13 +1193,17 @@ tested_methods = [
     "decoders.image_crop",
     "decoders.image_slice",
     "decoders.image_random_crop",
+    "decoders.image_resize",
     "decoders.audio",
+    "experimental.decoders.image",
     "peek_image_shape",
     "external_source",
     "brightness",
     "brightness_contrast",
     "cat",
+    "masked_select",
     "color_twist",
+    "experimental.color_adjust",
     "contrast",
     "copy",
     "crop_mirror_normalize",
@@ -1168,12 +1242,17 @@ tested_methods = [
     "rotate",
     "transpose",
     "warp_affine",
+    "experimental.warp_affine_multi",
+    "experimental.batch_mix",
     "power_spectrum",
     "preemphasis_filter",
+    "experimental.preemphasis_trim",
     "spectrogram",
     "to_decibels",
     "jitter",
     "random_resized_crop",
+    "experimental.random_resized_crop_mirror_normalize",
+    "experimental.random_resized_multi_crop",
     "cast",
     "copy",
     "crop",
@@ -1194,8 +1273,10 @@ tested_methods = [
     "constant",
     "mfcc",
     "bbox_paste",
+    "experimental.pack_images",
     "sequence_rearrange",
     "coord_flip",
+    "coord_pipeline",
     "lookup_table",
     "slice",
     "permute_batch",
@@ -1211,6 +1292,7 @@ tested_methods = [
     "random.normal",
     "arithmetic_generic_op",
     "segmentation.select_masks",
+    "segmentation.rasterize_polygons",
     "expand_dims",
     "tensor_subscript",
     "subscript_dim_check",
@@ -1291,6 +1373,9 @@ excluded_methods = [
     "readers.video_resize",          # readers do not support variable batch size yet
     "readers.webdataset",            # readers do not support variable batch size yet
     "experimental.readers.video",    # readers do not support variable batch size yet
+    "experimental.cache_lookup",     # the keys come from the readers (see above)
+    "experimental.cache_fetch",      # the keys come from the readers (see above)
+    "experimental.cache_store",      # the keys come from the readers (see above)
     "experimental.audio_resample"    # Alias of audio_resample (already tested)
 ]
 
@@ -305,6 +305,13 @@ def test_image_decoder():
                        output_type=types.RGB)
 
 
+def test_imgcodec_decoder():
+    check_single_input('experimental.decoders.image', pipe_fun=reader_op_pipeline,
+                       fn_source=images_dir,
+                       eager_source=PipelineInput(file_reader_pipeline, file_root=images_dir),
+                       output_type=types.RGB)
+
+
 def test_rotate():
     check_single_input('rotate', angle=25)
 
@@ -333,6 +340,10 @@ def test_color_twist():
     check_single_input('color_twist')
 
 
+def test_color_adjust():
+    check_single_input('experimental.color_adjust', hue=10, gamma=1.5)
+
+
 def test_saturation():
     check_single_input('saturation')
 
@@ -387,6 +398,12 @@ def test_image_decoder_crop_device():
                        output_type=types.RGB, crop=(10, 10))
 
 
+def test_image_decoder_resize_device():
+    check_single_input('decoders.image_resize', pipe_fun=reader_op_pipeline, fn_source=images_dir,
+                       eager_source=PipelineInput(file_reader_pipeline, file_root=images_dir),
+                       output_type=types.RGB, resize_shorter=32)
+
+
 def test_reshape():
     new_shape = sample_shape.copy()
     new_shape[0] //= 2
@@ -430,6 +447,10 @@ def test_multi_paste():
     check_single_input('multi_paste', in_ids=np.array([0, 1]), output_size=sample_shape)
 
 
+def test_pack_images():
+    check_single_input('experimental.pack_images', canvas_size=[40, 60])
+
+
 def test_nonsilent_region():
     data = [[rng.integers(0, 255, size=[200], dtype=np.uint8)
              for _ in range(batch_size)]] * data_size
@@ -560,6 +581,16 @@ def test_bb_flip():
                        eager_source=get_data.eager_source, layout=None)
 
 
+def test_coord_pipeline():
+    get_data = GetData([[(rng.integers(0, 255, size=[200, 4], dtype=np.uint8) /
+                       255).astype(dtype=np.float32) for _ in range(batch_size)]
+                       for _ in range(data_size)])
+
+    check_single_input('coord_pipeline', fn_source=get_data.fn_source,
+                       eager_source=get_data.eager_source, layout=None, boxes=True,
+                       flip=[1, 0], clip=True)
+
+
 def test_warp_affine():
     check_single_input('warp_affine', matrix=(0.1, 0.9, 10, 0.8, -0.2, -20))
 
@@ -893,6 +924,27 @@ def test_cat():
                                 eager_source=get_multi_data_eager(num_inputs))
 
 
+def masked_select_inputs():
+    data = fn.external_source(source=get_data, layout='HWC')
+    mask = fn.reductions.mean(data, axes=(1, 2)) > 127
+    return mask, data
+
+
+@pipeline_def(batch_size=batch_size, num_threads=4, device_id=None)
+def masked_select_pipeline():
+    return fn.masked_select(*masked_select_inputs())
+
+
+@pipeline_def(batch_size=batch_size, num_threads=4, device_id=None)
+def masked_select_input_pipeline():
+    return masked_select_inputs()
+
+
+def test_masked_select():
+    compare_eager_with_pipeline(masked_select_pipeline(), eager.masked_select,
+                                eager_source=PipelineInput(masked_select_input_pipeline))
+
+
 def test_stack():
     num_inputs = 3
     compare_eager_with_pipeline(multi_input_pipeline(fn.stack, num_inputs), eager_op=eager.stack,
@@ -1022,6 +1074,11 @@ def test_random_resized_crop():
     check_single_input_stateful('random_resized_crop', size=[5, 5])
 
 
+def test_random_resized_multi_crop():
+    check_single_input_stateful('experimental.random_resized_multi_crop', num_crops=[1, 2],
+                                size=[5, 5, 3, 3])
+
+
 def test_random_object_bbox():
     data = tensors.TensorListCPU([tensors.TensorCPU(
         np.int32([[1, 0, 0, 0],
@@ -1103,6 +1160,7 @@ def test_batch_permutation():
 
 tested_methods = [
     'decoders.image',
+    'experimental.decoders.image',
     'rotate',
     'brightness_contrast',
     'hue',
@@ -1110,6 +1168,7 @@ tested_methods = [
     'contrast',
     'hsv',
     'color_twist',
+    'experimental.color_adjust',
     'saturation',
     'shapes',
     'crop',
@@ -1123,6 +1182,7 @@ tested_methods = [
     'flip',
     'jpeg_compression_distortion',
     'decoders.image_crop',
+    'decoders.image_resize',
     'reshape',
     'reinterpret',
     'water',
@@ -1132,6 +1192,7 @@ tested_methods = [
     'coord_transform',
     'grid_mask',
     'multi_paste',
+    'experimental.pack_images',
     'nonsilent_region',
     'preemphasis_filter',
     'power_spectrum',
@@ -1144,6 +1205,7 @@ tested_methods = [
     'transpose',
     'decoders.audio',
     'coord_flip',
+    'coord_pipeline',
     'bb_flip',
     'warp_affine',
     'normalize',
@@ -1184,6 +1246,7 @@ tested_methods = [
     'reductions.std_dev',
     'reductions.variance',
     'cat',
+    'masked_select',
     'stack',
     'permute_batch',
     'squeeze',
@@ -1202,6 +1265,7 @@ tested_methods = [
     'roi_random_crop',
     'random_bbox_crop',
     'random_resized_crop',
+    'experimental.random_resized_multi_crop',
     'resize_crop_mirror',
     'random.coin_flip',
     'random.normal',
@@ -1212,12 +1276,14 @@ tested_methods = [
 excluded_methods = [
     'hidden.*',
     'jitter',                 # not supported for CPU
+    'experimental.random_resized_crop_mirror_normalize',  # not supported for CPU
     'video_reader',           # not supported for CPU
     'video_reader_resize',    # not supported for CPU
     'readers.video',          # not supported for CPU
     'readers.video_resize',   # not supported for CPU
     'optical_flow',           # not supported for CPU
     'paste',                  # not supported for CPU
+    'experimental.cache_*',   # not exposed in the eager mode
 ]
 
 
@@ -28,7 +28,18 @@ from test_utils import RandomlyShapedDataIterator
 from nose_utils import raises
 
 
-def check_serialize_deserialize(batch):
+def check_samples_equal(sample, deserialized_sample):
+    assert type(sample) is type(deserialized_sample)
+    if isinstance(sample, (tuple, list)):
+        assert len(sample) == len(deserialized_sample)
+        for part, deserialized_part in zip(sample, deserialized_sample):
+            check_samples_equal(part, deserialized_part)
+    else:
+        assert sample.dtype == deserialized_sample.dtype
+        np.testing.assert_array_equal(sample, deserialized_sample)
+
+
+def check_serialize_deserialize(batch, binary=True):
     shm_chunk = BufShmChunk.allocate("chunk_0", 100)
     with closing(shm_chunk) as shm_chunk:
         writer = SharedBatchWriter(shm_chunk, batch)
@@ -36,15 +47,34 @@ def check_serialize_deserialize(batch):
         deserialized_batch = deserialize_batch(shm_chunk, batch_meta)
         assert len(batch) == len(
             deserialized_batch), "Lengths before and after should be the same"
+        assert batch_meta.binary == binary, "Unexpected format of the batch meta data"
         for i in range(len(batch)):
-            np.testing.assert_array_equal(batch[i], deserialized_batch[i])
+            check_samples_equal(batch[i], deserialized_batch[i])
 
 
 def test_serialize_deserialize():
     for shapes in [[(10)], [(10, 20)], [(10, 20, 3)], [(1), (2)], [(2), (2, 3)],
                    [(2, 3, 4), (2, 3, 5), (3, 4, 5)], []]:
         for dtype in [np.int8, np.float, np.int32]:
-            yield check_serialize_deserialize, [np.full(s, 42, dtype=dtype) for s in shapes]
+            yield check_serialize_deserialize, [np.full(s, 42, dtype=dtype) for s in shapes], \
+                len(shapes) > 0
+
+
+def test_serialize_deserialize_multiple_outputs():
+    for sample_type in (tuple, list):
+        batch = [sample_type((np.full((i, 3), i, dtype=np.int16),
+                              np.array(i, dtype=np.float32),
+                              np.arange(i)))
+                 for i in range(5)]
+        yield check_serialize_deserialize, batch
+
+
+def test_serialize_deserialize_irregular_nesting():
+    batch = [(np.arange(3), (np.full((2, 2), 7), np.array(1, dtype=np.int8))),
+             (np.arange(2), (np.zeros(3),))]
+    yield check_serialize_deserialize, batch, False
+    batch = [(np.arange(3),), [np.arange(2)]]
+    yield check_serialize_deserialize, batch, False
 
 
 def test_serialize_deserialize_random():
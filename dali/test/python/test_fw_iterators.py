@@ -1665,6 +1665,52 @@ def test_pytorch_feed_ndarray():
                   glob="The element type of DALI Tensor/TensorList doesn't match "
                        "the element type of the target PyTorch Tensor:")
 
+
+@pipeline_def
+def ragged_test_pipeline(device):
+    def sequences(sample_info):
+        length = 1 + sample_info.idx_in_epoch % 5
+        return np.full((length, 3), sample_info.idx_in_epoch, dtype=np.float32)
+
+    seq = fn.external_source(source=sequences, batch=False)
+    flat = fn.reshape(seq, shape=[-1])
+    if device == "gpu":
+        seq, flat = seq.gpu(), flat.gpu()
+    return seq, flat
+
+
+def test_pytorch_iterator_ragged_outputs():
+    from nvidia.dali.plugin.pytorch import DALIGenericIterator as PyTorchIterator
+    batch_size = 4
+    for device in ["cpu", "gpu"]:
+        pipe = ragged_test_pipeline(device, batch_size=batch_size, num_threads=1, device_id=0)
+        it = PyTorchIterator(pipe, ["seq", "flat"], ragged_outputs=["seq", "flat"], size=10,
+                             last_batch_policy=LastBatchPolicy.PARTIAL)
+        idx = 0
+        for batch in it:
+            (values, offsets), (flat_values, flat_offsets) = batch[0]["seq"], batch[0]["flat"]
+            assert values.device == offsets.device
+            num_samples = len(offsets) - 1
+            for i in range(num_samples):
+                expected = np.full((1 + idx % 5, 3), idx, dtype=np.float32)
+                sample = values[offsets[i]:offsets[i + 1]].cpu().numpy()
+                assert np.array_equal(sample, expected), f"{sample} vs {expected}"
+                sample = flat_values[flat_offsets[i]:flat_offsets[i + 1]].cpu().numpy()
+                assert np.array_equal(sample, expected.flatten())
+                idx += 1
+        assert idx == 10
+
+
+def test_pytorch_to_ragged_view():
+    from nvidia.dali.plugin.pytorch import to_ragged
+    pipe = ragged_test_pipeline("gpu", batch_size=5, num_threads=1, device_id=0)
+    pipe.build()
+    seq, _ = pipe.run()
+    values, offsets = to_ragged(seq, copy=False)
+    assert list(values.shape) == [1 + 2 + 3 + 4 + 5, 3]
+    assert offsets.tolist() == [0, 1, 3, 6, 10, 15]
+    assert values.data_ptr() == seq.data_ptr()
+
 # last_batch_policy type check
 
 
@@ -0,0 +1,115 @@
+# Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import multiprocessing
+import numpy as np
+import nvidia.dali.fn as fn
+import os
+import tempfile
+import threading
+from nvidia.dali import pipeline_def
+from nvidia.dali.ipc import OutputExporter
+
+from test_utils import get_dali_extra_path
+
+jpeg_folder = os.path.join(get_dali_extra_path(), 'db', 'single', 'jpeg')
+batch_size = 4
+
+
+@pipeline_def(batch_size=batch_size, num_threads=2, device_id=0, seed=1234)
+def decoding_pipe(random_size=False):
+    jpegs, labels = fn.readers.file(file_root=jpeg_folder, name="Reader")
+    images = fn.decoders.image(jpegs, device="mixed")
+    size = fn.random.uniform(range=[32, 96]) if random_size else 64
+    images = fn.resize(images, resize_x=size, resize_y=48)
+    return images, labels.gpu(), labels
+
+
+def _consume(address, num_iters, queue):
+    from nvidia.dali.ipc import OutputImporter
+    importer = OutputImporter(address, device_id=0)
+    try:
+        for _ in range(num_iters):
+            outputs = importer.next()
+            queue.put([[np.array(s) for s in out.as_cpu()] if hasattr(out, "as_cpu")
+                       else [np.array(s) for s in out] for out in outputs])
+    finally:
+        importer.close()
+
+
+def _run_consumers(pipe, num_consumers, num_iters):
+    address = os.path.join(tempfile.mkdtemp(), "dali_outputs")
+    exporter = OutputExporter(pipe, address, num_slots=num_consumers + 1)
+    server = threading.Thread(target=exporter.serve, daemon=True)
+    server.start()
+    mp = multiprocessing.get_context("spawn")
+    queue = mp.Queue()
+    consumers = [mp.Process(target=_consume, args=(address, num_iters, queue))
+                 for _ in range(num_consumers)]
+    try:
+        for c in consumers:
+            c.start()
+        results = [queue.get(timeout=120) for _ in range(num_consumers * num_iters)]
+        for c in consumers:
+            c.join()
+            assert c.exitcode == 0
+    finally:
+        exporter.close()
+        server.join()
+    return results
+
+
+def _reference(num_iters, **kwargs):
+    pipe = decoding_pipe(**kwargs)
+    pipe.build()
+    return [[[np.array(s) for s in (out.as_cpu() if hasattr(out, "as_cpu") else out)]
+             for out in pipe.run()] for _ in range(num_iters)]
+
+
+def _check_same(ref, out):
+    assert len(ref) == len(out)
+    for ref_samples, out_samples in zip(ref, out):
+        assert len(ref_samples) == len(out_samples)
+        for r, o in zip(ref_samples, out_samples):
+            np.testing.assert_array_equal(r, o)
+
+
+def test_single_consumer():
+    num_iters = 10
+    for random_size in [False, True]:
+        pipe = decoding_pipe(random_size=random_size)
+        pipe.build()
+        results = _run_consumers(pipe, 1, num_iters)
+        ref = _reference(num_iters, random_size=random_size)
+        for ref_outputs, outputs in zip(ref, results):
+            for r, o in zip(ref_outputs, outputs):
+                _check_same(r, o)
+
+
+def test_consumers_share_the_iterations():
+    num_consumers = 2
+    num_iters = 6
+    pipe = decoding_pipe(random_size=True)
+    pipe.build()
+    results = _run_consumers(pipe, num_consumers, num_iters)
+    ref = _reference(num_consumers * num_iters, random_size=True)
+    # the consumers take the iterations in any order, so match them by the contents
+    def key(outputs):
+        return tuple(s.tobytes() for out in outputs for s in out)
+
+    ref = sorted(ref, key=key)
+    results = sorted(results, key=key)
+    for ref_outputs, outputs in zip(ref, results):
+        for r, o in zip(ref_outputs, outputs):
+            _check_same(r, o)
@@ -12,6 +12,8 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import os
+import tempfile
 from nvidia.dali.pipeline import Pipeline
 import nvidia.dali.ops as ops
 import nvidia.dali.types as types
@@ -34,15 +36,16 @@ def compare(tl1, tl2):
 
 
 class HybridDecoderPipeline(Pipeline):
-    def __init__(self, batch_size, num_threads, device_id, cache_size):
+    def __init__(self, batch_size, num_threads, device_id, cache_size, cache_dir="",
+                 policy="threshold", cache_host_size=0):
         super(HybridDecoderPipeline, self).__init__(batch_size, num_threads, device_id, seed=seed)
-        self.input = ops.readers.File(file_root=image_dir)
-        policy = None
-        if cache_size > 0:
-            policy = "threshold"
+        self.input = ops.readers.File(file_root=image_dir, random_shuffle=policy == "adaptive")
+        if cache_size == 0:
+            policy = None
         self.decode = ops.decoders.Image(device='mixed', output_type=types.RGB, cache_debug=False,
                                          cache_size=cache_size, cache_type=policy,
-                                         cache_batch_copy=True)
+                                         cache_batch_copy=True, cache_dir=cache_dir,
+                                         cache_host_size=cache_host_size)
 
     def define_graph(self):
         jpegs, labels = self.input(name="Reader")
@@ -70,6 +73,48 @@ def test_nvjpeg_cached():
         compare(ref_images, out_images)
 
 
+def check_nvjpeg_disk_cached(cache_size):
+    with tempfile.TemporaryDirectory() as cache_dir:
+        ref_pipe = HybridDecoderPipeline(batch_size, 1, 0, 0)
+        ref_pipe.build()
+        epoch_size = ref_pipe.epoch_size("Reader")
+        iters = (2 * epoch_size + batch_size - 1) // batch_size
+        # the second pipeline starts with the images stored on disk by the first one
+        for _ in range(2):
+            cached_pipe = HybridDecoderPipeline(batch_size, 1, 0, cache_size, cache_dir)
+            cached_pipe.build()
+            for i in range(iters):
+                ref_images, _ = ref_pipe.run()
+                out_images, _ = cached_pipe.run()
+                compare(ref_images, out_images)
+            del cached_pipe
+        assert os.path.getsize(os.path.join(cache_dir, "images.bin")) > 0
+
+
+def test_nvjpeg_disk_cached():
+    for cache_size in [0, 100]:
+        yield check_nvjpeg_disk_cached, cache_size
+
+
+def check_nvjpeg_adaptive_cached(cache_size, cache_host_size):
+    # the cache is smaller than the dataset, so the images are evicted (or moved to host memory)
+    ref_pipe = HybridDecoderPipeline(batch_size, 1, 0, 0, policy="adaptive")
+    ref_pipe.build()
+    cached_pipe = HybridDecoderPipeline(batch_size, 1, 0, cache_size, policy="adaptive",
+                                        cache_host_size=cache_host_size)
+    cached_pipe.build()
+    epoch_size = ref_pipe.epoch_size("Reader")
+    for i in range(0, (3 * epoch_size + batch_size - 1) // batch_size):
+        ref_images, _ = ref_pipe.run()
+        out_images, _ = cached_pipe.run()
+        compare(ref_images, out_images)
+
+
+def test_nvjpeg_adaptive_cached():
+    for cache_size, cache_host_size in [(4, 0), (4, 8), (100, 0)]:
+        yield check_nvjpeg_adaptive_cached, cache_size, cache_host_size
+
+
 def main():
     test_nvjpeg_cached()
 
@@ -26,12 +26,13 @@ import os
 import random
 from math import floor, ceil
 import sys
+import time
 import warnings
 from webdataset_base import generate_temp_index_file as generate_temp_wds_index
 
 from test_utils import (
     check_batch, as_array, compare_pipelines,
-    get_dali_extra_path, RandomDataIterator)
+    get_dali_extra_path, get_gpu_num, RandomDataIterator)
 from nose_utils import raises
 from nose_utils import assert_raises
 from nose.plugins.skip import SkipTest
@@ -1504,6 +1505,72 @@ def test_executor_meta():
             assert calc_avg_max(v["reserved_memory_size"]) == v["max_reserved_memory_size"]
 
 
+def test_executor_timing_stats():
+    batch_size = 8
+    iters = 10
+
+    def check_histogram(h, min_count=1):
+        assert h["count"] >= min_count
+        assert sum(h["buckets"]) == h["count"]
+        assert h["min_ns"] <= h["max_ns"]
+        assert h["total_ns"] >= h["max_ns"]
+
+    @pipeline_def(batch_size=batch_size, num_threads=2, device_id=0, enable_timing_stats=True)
+    def pdef():
+        data = fn.random.uniform(range=[0, 255], shape=[16, 16, 3], dtype=types.UINT8)
+        flipped = fn.flip(data.gpu(), horizontal=1)
+        return fn.cast(flipped, dtype=types.FLOAT)
+
+    pipe = pdef()
+    assert pipe.enable_timing_stats is True
+    pipe.build()
+    for _ in range(iters):
+        out, = pipe.run()
+        # synchronize, so the GPU timing of the previous iterations is ready to be collected
+        out.as_cpu()
+
+    meta = pipe.executor_statistics()
+    assert len(meta) > 0
+    for k, v in meta.items():
+        check_histogram(v["host_time"])
+        if k.startswith("GPU_"):
+            check_histogram(v["gpu_time"])
+        if k.startswith("CPU_"):
+            assert "gpu_time" not in v
+
+    stages = pipe.executor_stage_statistics()
+    assert set(stages.keys()) == {"cpu", "mixed", "gpu"}
+    for stage in stages.values():
+        check_histogram(stage["run_time"], iters)
+        check_histogram(stage["queue_wait"], iters)
+    cpu = stages["cpu"]
+    assert 0 <= cpu["thread_pool_busy_ns"] <= cpu["thread_pool_capacity_ns"]
+    assert cpu["thread_pool_capacity_ns"] > 0
+
+
+def test_executor_host_arena_stats():
+    batch_size = 4
+
+    @pipeline_def(batch_size=batch_size, num_threads=2, device_id=0, enable_memory_stats=True)
+    def pdef():
+        data = fn.random.uniform(range=[0, 255], shape=[16, 16, 3], dtype=types.UINT8)
+        return fn.resize(data, size=[8, 8])
+
+    pipe = pdef()
+    pipe.build()
+    for _ in range(5):
+        pipe.run()
+
+    meta = pipe.executor_statistics()
+    resize_meta = [v for k, v in meta.items() if "Resize" in k]
+    assert len(resize_meta) == 1
+    resize_meta = resize_meta[0]
+    assert resize_meta["host_arena_allocations"] > 0
+    assert resize_meta["host_arena_peak_bytes"] > 0
+    # the arena is allocated in the first iteration and reused in the following ones
+    assert resize_meta["host_arena_upstream_allocations"] == 1
+
+
 def test_bytes_per_sample_hint():
     import nvidia.dali.backend
     if nvidia.dali.backend.RestrictPinnedMemUsage():
@@ -1729,11 +1796,365 @@ def test_properties():
         assert pipe.py_num_workers == 3
         assert pipe.py_start_method == "fork"
         assert pipe.enable_memory_stats is False
+        assert pipe.thread_pool_type == "shared_queue"
+        assert pipe.exec_gpu_multistream is False
+        assert pipe.exec_cuda_graph is False
+        assert pipe.exec_memory_planning is False
+        assert pipe.exec_micro_batch_size == 0
+        assert pipe.min_prefetch_queue_depth is None
+        assert pipe.enable_timing_stats is False
         return np.float32([1, 2, 3])
 
     my_pipe(device_id=0, seed=1234, num_threads=3, set_affinity=True, py_num_workers=3)
 
 
+def test_work_stealing_thread_pool():
+    batch_size = 64
+
+    def get_pipe(thread_pool_type):
+        @pipeline_def(batch_size=batch_size, num_threads=8, device_id=None, seed=123,
+                      thread_pool_type=thread_pool_type)
+        def pipe():
+            data = fn.random.uniform(range=[0, 255], shape=[16, 16, 3], dtype=types.UINT8)
+            flipped = fn.flip(data, horizontal=1)
+            return data, fn.cast(flipped, dtype=types.FLOAT)
+        return pipe()
+
+    ref_pipe = get_pipe("shared_queue")
+    ws_pipe = get_pipe("work_stealing")
+    assert ws_pipe.thread_pool_type == "work_stealing"
+    ref_pipe.build()
+    ws_pipe.build()
+    for _ in range(5):
+        ref_out = ref_pipe.run()
+        ws_out = ws_pipe.run()
+        for ref, out in zip(ref_out, ws_out):
+            check_batch(out, ref, batch_size)
+
+
+def test_process_shared_thread_pool():
+    batch_size = 64
+
+    def get_pipe(thread_pool_type, num_threads):
+        @pipeline_def(batch_size=batch_size, num_threads=num_threads, device_id=None, seed=123,
+                      thread_pool_type=thread_pool_type, enable_timing_stats=True)
+        def pipe():
+            data = fn.random.uniform(range=[0, 255], shape=[16, 16, 3], dtype=types.UINT8)
+            flipped = fn.flip(data, horizontal=1)
+            return data, fn.cast(flipped, dtype=types.FLOAT)
+        return pipe()
+
+    ref_pipe = get_pipe("shared_queue", 4)
+    # two pipelines running on the same worker threads
+    shared_pipes = [get_pipe("process_shared", 4), get_pipe("process_shared", 2)]
+    ref_pipe.build()
+    for pipe in shared_pipes:
+        pipe.build()
+    for _ in range(5):
+        ref_out = ref_pipe.run()
+        for pipe in shared_pipes:
+            for ref, out in zip(ref_out, pipe.run()):
+                check_batch(out, ref, batch_size)
+    assert ref_pipe.executor_stage_statistics()["cpu"]["num_threads"] == 4
+    assert ref_pipe.executor_stage_statistics()["cpu"]["shared_pool_threads"] == 0
+    for pipe, num_threads in zip(shared_pipes, [4, 2]):
+        cpu = pipe.executor_stage_statistics()["cpu"]
+        assert cpu["num_threads"] == num_threads
+        assert cpu["shared_pool_threads"] > 0
+        assert cpu["thread_pool_busy_ns"] <= cpu["thread_pool_capacity_ns"]
+
+
+def test_dataflow_execution():
+    batch_size = 32
+
+    def get_pipe(exec_dataflow, prefetch_queue_depth):
+        @pipeline_def(batch_size=batch_size, num_threads=4, device_id=None, seed=123,
+                      exec_dataflow=exec_dataflow, prefetch_queue_depth=prefetch_queue_depth)
+        def pipe():
+            images = fn.random.uniform(range=[0, 255], shape=[32, 32, 3], dtype=types.UINT8)
+            labels = fn.random.uniform(range=[0, 10], shape=[1], dtype=types.INT32)
+            images = fn.flip(images, horizontal=1)
+            images = fn.cast(images, dtype=types.FLOAT)
+            labels = fn.cast(labels, dtype=types.INT64)
+            return images, labels
+        return pipe()
+
+    for prefetch_queue_depth in [2, {"cpu_size": 3, "gpu_size": 2}]:
+        ref_pipe = get_pipe(False, prefetch_queue_depth)
+        dataflow_pipe = get_pipe(True, prefetch_queue_depth)
+        assert dataflow_pipe.exec_dataflow
+        compare_pipelines(ref_pipe, dataflow_pipe, batch_size, 5)
+
+
+def test_dataflow_execution_requires_async():
+    with assert_raises(ValueError, glob="*`exec_dataflow` requires*"):
+        Pipeline(batch_size=1, num_threads=1, device_id=None, exec_async=False,
+                 exec_pipelined=False, exec_dataflow=True)
+
+
+def test_low_latency_execution():
+    batch_size = 2
+
+    def get_pipe(exec_low_latency):
+        @pipeline_def(batch_size=batch_size, num_threads=2, device_id=0, seed=123,
+                      exec_pipelined=False, exec_async=False, exec_low_latency=exec_low_latency)
+        def pipe():
+            images = fn.random.uniform(range=[0, 255], shape=[32, 32, 3], dtype=types.UINT8)
+            images = fn.flip(images.gpu(), horizontal=1)
+            return fn.cast(images, dtype=types.FLOAT)
+        return pipe()
+
+    ref_pipe = get_pipe(False)
+    low_latency_pipe = get_pipe(True)
+    assert low_latency_pipe.exec_low_latency
+    compare_pipelines(ref_pipe, low_latency_pipe, batch_size, 5)
+
+
+def test_low_latency_execution_requires_sync():
+    with assert_raises(ValueError, glob="*`exec_low_latency` requires*"):
+        Pipeline(batch_size=1, num_threads=1, device_id=0, exec_low_latency=True)
+
+
+def test_gpu_multistream_execution():
+    batch_size = 16
+
+    def get_pipe(exec_gpu_multistream, max_streams):
+        @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0, seed=123,
+                      exec_gpu_multistream=exec_gpu_multistream, max_streams=max_streams)
+        def pipe():
+            images = fn.random.uniform(range=[0, 255], shape=[32, 32, 3], dtype=types.UINT8)
+            images = images.gpu()
+            flipped = fn.flip(images, horizontal=1)
+            flipped = fn.cast(flipped, dtype=types.FLOAT)
+            normalized = fn.normalize(images, batch=True)
+            merged = fn.cat(flipped, normalized, axis=2)
+            return flipped, normalized, merged
+        return pipe()
+
+    for max_streams in [-1, 2, 3]:
+        ref_pipe = get_pipe(False, max_streams)
+        multistream_pipe = get_pipe(True, max_streams)
+        assert multistream_pipe.exec_gpu_multistream
+        compare_pipelines(ref_pipe, multistream_pipe, batch_size, 5)
+
+
+def test_cuda_graph_execution():
+    batch_size = 16
+
+    def get_pipe(exec_cuda_graph, graph_safe_only):
+        @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0, seed=123,
+                      exec_cuda_graph=exec_cuda_graph)
+        def pipe():
+            images = fn.random.uniform(range=[0, 255], shape=[16, 16, 3], dtype=types.UINT8)
+            images = images.gpu()
+            copy1 = fn.copy(images)
+            copy2 = fn.copy(copy1)
+            if graph_safe_only:
+                return copy1, copy2
+            return copy1, fn.flip(copy2, horizontal=1)
+        return pipe()
+
+    for graph_safe_only in [True, False]:
+        ref_pipe = get_pipe(False, graph_safe_only)
+        graph_pipe = get_pipe(True, graph_safe_only)
+        assert graph_pipe.exec_cuda_graph
+        compare_pipelines(ref_pipe, graph_pipe, batch_size, 20)
+
+
+def test_multi_device_pipeline():
+    batch_size = 4
+    iters = 5
+    device_ids = list(range(get_gpu_num()))
+    num_devices = len(device_ids)
+
+    @pipeline_def(num_threads=4, seed=123)
+    def pipe():
+        jpegs, labels = fn.readers.file(file_root=jpeg_folder, random_shuffle=False,
+                                        name="Reader")
+        images = fn.decoders.image(jpegs, device="mixed")
+        images = fn.resize(images, resize_x=64, resize_y=48)
+        return images, labels
+
+    ref_pipe = pipe(batch_size=batch_size * num_devices, device_id=0)
+    multi_pipe = pipe(batch_size=batch_size, device_id=device_ids)
+    ref_pipe.build()
+    multi_pipe.build()
+    assert multi_pipe.device_id == device_ids
+    assert multi_pipe.epoch_size("Reader") == ref_pipe.epoch_size("Reader")
+    for _ in range(iters):
+        ref_images, ref_labels = ref_pipe.run()
+        ref_images = ref_images.as_cpu()
+        per_device = multi_pipe.run()
+        assert len(per_device) == num_devices
+        for i, (images, labels) in enumerate(per_device):
+            assert len(images) == batch_size
+            begin = i * batch_size
+            check_batch(labels, [ref_labels.at(begin + j) for j in range(batch_size)])
+            check_batch(images.as_cpu(), [ref_images.at(begin + j) for j in range(batch_size)],
+                        max_allowed_error=1)
+
+
+def test_multi_device_pipeline_wrong_args():
+    @pipeline_def(batch_size=4, num_threads=4, device_id=[0])
+    def pipe_with_source():
+        return fn.external_source(source=lambda: [np.zeros(1)] * 4, batch=True)
+
+    with assert_raises(ValueError, glob="ExternalSource is not supported*multiple devices"):
+        pipe_with_source().build()
+    with assert_raises(ValueError, glob="must not contain duplicates"):
+        Pipeline(batch_size=4, num_threads=4, device_id=[0, 0])
+    with assert_raises(ValueError, glob="must be a non-empty list"):
+        Pipeline(batch_size=4, num_threads=4, device_id=[])
+
+
+def test_adaptive_prefetch_queue_depth():
+    batch_size = 8
+    iters = 80
+
+    def get_pipe(prefetch_queue_depth, min_prefetch_queue_depth):
+        @pipeline_def(batch_size=batch_size, num_threads=2, device_id=0, seed=123,
+                      prefetch_queue_depth=prefetch_queue_depth,
+                      min_prefetch_queue_depth=min_prefetch_queue_depth)
+        def pipe():
+            data = fn.random.uniform(range=[0, 255], shape=[16, 16, 3], dtype=types.UINT8)
+            return data, fn.copy(data.gpu())
+        p = pipe()
+        p.build()
+        return p
+
+    for depth, min_depth in [(3, 1), ({"cpu_size": 3, "gpu_size": 4},
+                                      {"cpu_size": 1, "gpu_size": 2})]:
+        ref_pipe = get_pipe(depth, None)
+        pipe = get_pipe(depth, min_depth)
+        assert pipe.min_prefetch_queue_depth == min_depth
+        assert pipe.current_prefetch_queue_depth() == depth
+        for _ in range(iters):
+            out = pipe.run()
+            ref = ref_pipe.run()
+            for o, r in zip(out, ref):
+                check_batch(o, r, batch_size)
+            # A slow consumer - the pipeline keeps the queues full and doesn't need them that deep
+            time.sleep(0.005)
+        assert pipe.current_prefetch_queue_depth() == min_depth
+
+
+def test_adaptive_prefetch_queue_depth_wrong_args():
+    with assert_raises(ValueError, glob="*`min_prefetch_queue_depth` requires both*"):
+        Pipeline(batch_size=1, num_threads=1, device_id=0, exec_async=False,
+                 min_prefetch_queue_depth=1)
+    with assert_raises(ValueError, glob="*cannot exceed `prefetch_queue_depth`*"):
+        Pipeline(batch_size=1, num_threads=1, device_id=0, prefetch_queue_depth=2,
+                 min_prefetch_queue_depth=3)
+    with assert_raises(TypeError, glob="*same type as prefetch_queue_depth*"):
+        Pipeline(batch_size=1, num_threads=1, device_id=0, prefetch_queue_depth=2,
+                 min_prefetch_queue_depth={"cpu_size": 1, "gpu_size": 1})
+
+
+def test_memory_planning_execution():
+    batch_size = 16
+
+    def get_pipe(exec_memory_planning):
+        @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0, seed=123,
+                      exec_memory_planning=exec_memory_planning)
+        def pipe():
+            images = fn.random.uniform(range=[0, 255], shape=[16, 16, 3], dtype=types.UINT8)
+            images = images.gpu()
+            # a chain of intermediates, which can reuse each other's memory
+            out = images
+            for _ in range(4):
+                out = fn.flip(fn.copy(out), horizontal=1)
+            side = fn.copy(images)
+            return out, fn.cast(side, dtype=types.FLOAT)
+        return pipe()
+
+    ref_pipe = get_pipe(False)
+    planned_pipe = get_pipe(True)
+    assert planned_pipe.exec_memory_planning
+    compare_pipelines(ref_pipe, planned_pipe, batch_size, 10)
+
+
+def test_memory_planning_inplace_join():
+    batch_size = 8
+
+    def get_pipe(exec_memory_planning):
+        @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0, seed=123,
+                      exec_memory_planning=exec_memory_planning)
+        def pipe():
+            images = fn.random.uniform(range=[0, 255], shape=[32, 32, 3], dtype=types.UINT8)
+            images = images.gpu()
+            crops = [fn.crop(images, crop=(16, 16), crop_pos_x=x, crop_pos_y=y)
+                     for x, y in [(0, 0), (1, 0), (0, 1), (1, 1)]]
+            views = [fn.flip(images, horizontal=1), fn.flip(images, vertical=1)]
+            # views[0] is used more than once, so the joins using it copy the data
+            return fn.stack(*crops), fn.cat(*views), fn.cat(views[0], fn.copy(images)), views[0]
+        return pipe()
+
+    ref_pipe = get_pipe(False)
+    planned_pipe = get_pipe(True)
+    compare_pipelines(ref_pipe, planned_pipe, batch_size, 10)
+
+
+def test_micro_batch_execution():
+    batch_size = 10
+
+    def get_pipe(**kwargs):
+        @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0, seed=123, **kwargs)
+        def pipe():
+            images = fn.random.uniform(range=[0, 255], shape=[32, 24, 3], dtype=types.UINT8)
+            sizes = fn.random.uniform(range=[8, 40], shape=[2])
+            decoded = fn.copy(images.gpu())
+            # resize -> warp_affine -> crop_mirror_normalize form a chain; the output of
+            # warp_affine is consumed only within it, the one of resize is also returned
+            resized = fn.resize(decoded, size=sizes)
+            warped = fn.warp_affine(resized, matrix=[1, 0.1, 0, 0.1, 1, 0])
+            normalized = fn.crop_mirror_normalize(warped, mean=[128], std=[64],
+                                                  mirror=fn.random.coin_flip())
+            return resized, normalized, fn.flip(normalized, horizontal=1)
+        return pipe()
+
+    for micro_batch_size in [1, 3, batch_size, 2 * batch_size]:
+        for kwargs in [{}, {"exec_memory_planning": True}]:
+            pipe = get_pipe(exec_micro_batch_size=micro_batch_size, **kwargs)
+            assert pipe.exec_micro_batch_size == micro_batch_size
+            compare_pipelines(get_pipe(), pipe, batch_size, 5)
+
+
+def test_micro_batch_size_validation():
+    with assert_raises(ValueError, glob="*must not be negative*"):
+        Pipeline(batch_size=1, num_threads=1, device_id=0, exec_micro_batch_size=-1)
+
+
+def test_urgent_stream_priority():
+    batch_size = 8
+
+    def get_pipe(urgent_priority, **kwargs):
+        @pipeline_def(batch_size=batch_size, num_threads=4, device_id=0, seed=123,
+                      urgent_cuda_stream_priority=urgent_priority, **kwargs)
+        def pipe():
+            images = fn.random.uniform(range=[0, 255], shape=[32, 32, 3], dtype=types.UINT8)
+            decoded = fn.copy(images.gpu())
+            resized = fn.resize(decoded, size=[20, 20])
+            return decoded, fn.flip(resized, horizontal=1)
+        return pipe()
+
+    exec_modes = [
+        {},
+        {"prefetch_queue_depth": {"cpu_size": 3, "gpu_size": 2}},
+        {"exec_pipelined": False, "exec_async": False, "exec_low_latency": True},
+    ]
+    for kwargs in exec_modes:
+        ref_pipe = get_pipe(None, **kwargs)
+        prioritized_pipe = get_pipe(-1, **kwargs)
+        assert ref_pipe.urgent_cuda_stream_priority is None
+        assert prioritized_pipe.urgent_cuda_stream_priority == -1
+        compare_pipelines(ref_pipe, prioritized_pipe, batch_size, 6)
+
+
+def test_wrong_thread_pool_type():
+    with assert_raises(ValueError, glob="*`thread_pool_type` must be either*"):
+        Pipeline(batch_size=1, num_threads=1, device_id=None, thread_pool_type="foo")
+
+
 def test_not_iterable():
     import nvidia.dali._utils.hacks as hacks
     import collections.abc
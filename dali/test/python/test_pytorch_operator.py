@@ -1,4 +1,4 @@
-# Copyright (c) 2019, NVIDIA CORPORATION. All rights reserved.
+# Copyright (c) 2019-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 #
 # Licensed under the Apache License, Version 2.0 (the "License");
 # you may not use this file except in compliance with the License.
@@ -124,3 +124,34 @@ def check_pytorch_operator_batch_processing(device):
 def test_pytorch_operator_batch_processing():
     for device in {'cpu', 'gpu'}:
         yield check_pytorch_operator_batch_processing, device
+
+
+def torch_transpose(tensor):
+    # a non-dense output - it can't be adopted and must be copied
+    return (tensor.float() * 2).permute(1, 0, 2), tensor.float() + 1
+
+
+class TorchPythonFunctionConsumerPipeline(CommonPipeline):
+    def __init__(self, function):
+        super().__init__()
+        self.torch_function = dalitorch.TorchPythonFunction(function=function, num_outputs=2,
+                                                            device='gpu')
+        self.cast = ops.Cast(device='gpu', dtype=types.FLOAT)
+
+    def define_graph(self):
+        images, labels = self.load()
+        transposed, shifted = self.torch_function(images.gpu())
+        # the outputs of the function are consumed by DALI operators
+        return images, self.cast(transposed), self.cast(shifted)
+
+
+def test_pytorch_operator_gpu_outputs_consumed():
+    pipe = TorchPythonFunctionConsumerPipeline(torch_transpose)
+    pipe.build()
+    for it in range(ITERS):
+        images, transposed, shifted = pipe.run()
+        transposed, shifted = transposed.as_cpu(), shifted.as_cpu()
+        for i in range(len(images)):
+            img = images.at(i).astype(numpy.float32)
+            assert numpy.array_equal(transposed.at(i), (img * 2).transpose(1, 0, 2))
+            assert numpy.array_equal(shifted.at(i), img + 1)
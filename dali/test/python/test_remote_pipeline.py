@@ -0,0 +1,114 @@
+# Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import numpy as np
+import nvidia.dali.fn as fn
+import os
+import threading
+from nvidia.dali import Pipeline, pipeline_def
+from nvidia.dali.remote import RemoteWorker
+
+from nose_utils import assert_raises
+from test_utils import compare_pipelines, get_dali_extra_path
+
+jpeg_folder = os.path.join(get_dali_extra_path(), 'db', 'single', 'jpeg')
+
+
+def start_workers(num_workers, max_connections=1):
+    workers = []
+    for _ in range(num_workers):
+        worker = RemoteWorker("localhost", 0)
+        threading.Thread(target=worker.serve, args=(max_connections,), daemon=True).start()
+        workers.append(worker)
+    return workers, [f"localhost:{worker.port}" for worker in workers]
+
+
+@pipeline_def(num_threads=2, device_id=0)
+def decoding_pipe():
+    jpegs, labels = fn.readers.file(file_root=jpeg_folder, name="Reader")
+    images = fn.decoders.image(jpegs, device="mixed")
+    images = fn.resize(images, resize_x=64, resize_y=48)
+    return images, labels
+
+
+def test_same_as_local():
+    batch_size = 4
+    workers, addresses = start_workers(1)
+    try:
+        ref_pipe = decoding_pipe(batch_size=batch_size)
+        remote_pipe = decoding_pipe(batch_size=batch_size, remote_workers=addresses)
+        ref_pipe.build()
+        remote_pipe.build()
+        assert remote_pipe.epoch_size("Reader") == ref_pipe.epoch_size("Reader")
+        compare_pipelines(ref_pipe, remote_pipe, batch_size, 10)
+    finally:
+        for worker in workers:
+            worker.close()
+
+
+def test_workers_share_the_shard():
+    num_workers = 2
+    workers, addresses = start_workers(num_workers)
+
+    @pipeline_def(batch_size=1, num_threads=2, device_id=0, prefetch_queue_depth=3,
+                  remote_workers=addresses)
+    def pipe():
+        jpegs, labels = fn.readers.file(file_root=jpeg_folder, name="Reader")
+        return jpegs, labels
+
+    try:
+        p = pipe()
+        p.build()
+        epoch_size = p.epoch_size("Reader")
+        # the workers take turns, so the whole epoch is read before any of them wraps around
+        num_samples = epoch_size // num_workers * num_workers
+        read = set()
+        for _ in range(num_samples):
+            jpegs, labels = p.run()
+            read.add((jpegs.at(0).tobytes(), int(np.array(labels.at(0))[0])))
+        assert len(read) == num_samples
+    finally:
+        for worker in workers:
+            worker.close()
+
+
+def test_remote_worker_errors():
+    workers, addresses = start_workers(1)
+
+    @pipeline_def(batch_size=4, num_threads=2, device_id=0, remote_workers=addresses)
+    def missing_files_pipe():
+        jpegs, labels = fn.readers.file(file_root="/this/path/does/not/exist")
+        return fn.decoders.image(jpegs, device="mixed"), labels
+
+    try:
+        with assert_raises(RuntimeError, glob="failed to build the pipeline"):
+            missing_files_pipe().build()
+    finally:
+        for worker in workers:
+            worker.close()
+
+
+def test_wrong_args():
+    @pipeline_def(batch_size=4, num_threads=2, device_id=0, remote_workers=["localhost:1"])
+    def pipe_with_source():
+        return fn.external_source(source=lambda: [np.zeros(1)] * 4, batch=True)
+
+    with assert_raises(ValueError, glob="ExternalSource is not supported*remote workers"):
+        pipe_with_source().build()
+    with assert_raises(ValueError, glob="must be a non-empty list"):
+        Pipeline(batch_size=4, num_threads=4, device_id=0, remote_workers=[])
+    with assert_raises(ValueError, glob="cannot be used with multiple devices"):
+        Pipeline(batch_size=4, num_threads=4, device_id=[0, 1], remote_workers=["localhost:1"])
+    with assert_raises(ValueError, glob="*\"host:port\"*"):
+        decoding_pipe(batch_size=4, remote_workers=["localhost"]).build()
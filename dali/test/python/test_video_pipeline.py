@@ -292,6 +292,42 @@ def test_stride_video_pipeline():
     del pipe
 
 
+def test_num_decoders_video_pipeline():
+    @pipeline_def(batch_size=BATCH_SIZE, num_threads=2, device_id=0)
+    def video_pipe(num_decoders):
+        return fn.readers.video(device="gpu", filenames=VIDEO_FILES, sequence_length=COUNT,
+                                num_decoders=num_decoders)
+
+    ref_pipe = video_pipe(num_decoders=1)
+    pipe = video_pipe(num_decoders=3)
+    ref_pipe.build()
+    pipe.build()
+    for _ in range(ITER):
+        ref, = ref_pipe.run()
+        out, = pipe.run()
+        # the sequences come from different decoders, but the batch keeps the reading order
+        for i in range(BATCH_SIZE):
+            np.testing.assert_array_equal(ref.as_cpu().at(i), out.as_cpu().at(i))
+
+
+def test_frame_cache_video_pipeline():
+    @pipeline_def(batch_size=BATCH_SIZE, num_threads=2, device_id=0)
+    def video_pipe(frame_cache_size):
+        return fn.readers.video(device="gpu", filenames=VIDEO_FILES, sequence_length=COUNT,
+                                step=2, stride=2, frame_cache_size=frame_cache_size)
+
+    ref_pipe = video_pipe(frame_cache_size=0)
+    # the overlapping frames are copied from the cache instead of being decoded again
+    pipe = video_pipe(frame_cache_size=64 << 20)
+    ref_pipe.build()
+    pipe.build()
+    for _ in range(ITER):
+        ref, = ref_pipe.run()
+        out, = pipe.run()
+        for i in range(BATCH_SIZE):
+            np.testing.assert_array_equal(ref.as_cpu().at(i), out.as_cpu().at(i))
+
+
 def test_multiple_resolution_videopipeline():
     pipe = VideoPipeRoot(batch_size=BATCH_SIZE, data=MUTLIPLE_RESOLUTION_ROOT)
     try:
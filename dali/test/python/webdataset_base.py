@@ -39,6 +39,7 @@ def webdataset_raw_pipeline(
     lazy_init=False,
     read_ahead=False,
     stick_to_shard=False,
+    **reader_kwargs,
 ):
     out = readers.webdataset(
         paths=paths,
@@ -55,6 +56,7 @@ def webdataset_raw_pipeline(
         pad_last_batch=pad_last_batch,
         lazy_init=lazy_init,
         read_ahead=read_ahead,
+        **reader_kwargs,
     )
     return out if not isinstance(out, list) else tuple(out)
 
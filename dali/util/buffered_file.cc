@@ -0,0 +1,94 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "dali/core/error_handling.h"
+#include "dali/util/buffered_file.h"
+
+namespace dali {
+
+BufferedFileStream::BufferedFileStream(std::unique_ptr<FileStream> stream, size_t buffer_size)
+    : FileStream(stream->path()), stream_(std::move(stream)), buffer_(buffer_size) {
+  DALI_ENFORCE(buffer_size > 0, "The read buffer cannot be empty");
+  offset_ = stream_->TellRead();
+}
+
+void BufferedFileStream::Close() {
+  if (stream_)
+    stream_->Close();
+}
+
+shared_ptr<void> BufferedFileStream::Get(size_t /*n_bytes*/) {
+  return {};
+}
+
+size_t BufferedFileStream::Read(void *buffer, size_t n_bytes) {
+  auto *dst = static_cast<uint8_t *>(buffer);
+  size_t total = 0;
+  while (n_bytes > 0) {
+    if (pos_ == valid_) {
+      offset_ += valid_;
+      pos_ = valid_ = 0;
+      if (n_bytes >= buffer_.size()) {
+        // no point in copying through the buffer
+        size_t n = stream_->Read(dst, n_bytes);
+        offset_ += n;
+        total += n;
+        if (n < n_bytes)
+          break;
+        return total;
+      }
+      valid_ = stream_->Read(buffer_.data(), buffer_.size());
+      if (valid_ == 0)
+        break;
+    }
+    size_t n = std::min(n_bytes, valid_ - pos_);
+    std::memcpy(dst, buffer_.data() + pos_, n);
+    pos_ += n;
+    dst += n;
+    n_bytes -= n;
+    total += n;
+  }
+  return total;
+}
+
+void BufferedFileStream::SeekRead(ptrdiff_t pos, int whence) {
+  if (whence == SEEK_CUR) {
+    pos += TellRead();
+  } else if (whence == SEEK_END) {
+    pos += Size();
+  } else {
+    DALI_ENFORCE(whence == SEEK_SET, "Invalid seek origin");
+  }
+  if (pos >= offset_ && pos <= offset_ + static_cast<ptrdiff_t>(valid_)) {
+    pos_ = pos - offset_;
+    return;
+  }
+  stream_->SeekRead(pos);
+  offset_ = pos;
+  pos_ = valid_ = 0;
+}
+
+ptrdiff_t BufferedFileStream::TellRead() const {
+  return offset_ + pos_;
+}
+
+size_t BufferedFileStream::Size() const {
+  return stream_->Size();
+}
+
+}  // namespace dali
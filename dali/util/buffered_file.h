@@ -0,0 +1,62 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_BUFFERED_FILE_H_
+#define DALI_UTIL_BUFFERED_FILE_H_
+
+#include <memory>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+/**
+ * @brief Reads a FileStream sequentially in large chunks
+ *
+ * Small reads are served from a buffer refilled with reads of `buffer_size` bytes, so reading
+ * a file record by record costs a few large reads of the underlying stream. Reads larger than
+ * the buffer bypass it. Seeking within the buffered data doesn't touch the underlying stream,
+ * which makes skipping over short pieces of data (e.g. tar headers' padding) cheap.
+ *
+ * The data is never mapped - Get returns an empty pointer.
+ */
+class DLL_PUBLIC BufferedFileStream : public FileStream {
+ public:
+  BufferedFileStream(std::unique_ptr<FileStream> stream, size_t buffer_size);
+
+  void Close() override;
+  shared_ptr<void> Get(size_t n_bytes) override;
+  size_t Read(void *buffer, size_t n_bytes) override;
+  void SeekRead(ptrdiff_t pos, int whence = SEEK_SET) override;
+  ptrdiff_t TellRead() const override;
+  size_t Size() const override;
+
+  ~BufferedFileStream() override {
+    Close();
+  }
+
+ private:
+  std::unique_ptr<FileStream> stream_;
+  std::vector<uint8_t> buffer_;
+  // the position of the buffer in the file; the underlying stream is at offset_ + valid_
+  int64_t offset_ = 0;
+  size_t valid_ = 0;
+  size_t pos_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_BUFFERED_FILE_H_
@@ -0,0 +1,142 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "dali/util/buffered_file.h"
+
+namespace dali {
+
+namespace {
+
+// Counts the reads of the underlying stream
+class MemFileStream : public FileStream {
+ public:
+  explicit MemFileStream(const std::vector<char> &data) : FileStream("mem"), data_(data) {}
+
+  void Close() override {}
+
+  shared_ptr<void> Get(size_t) override {
+    return {};
+  }
+
+  size_t Read(void *buffer, size_t n_bytes) override {
+    reads++;
+    n_bytes = std::min(n_bytes, data_.size() - pos_);
+    std::memcpy(buffer, data_.data() + pos_, n_bytes);
+    pos_ += n_bytes;
+    return n_bytes;
+  }
+
+  void SeekRead(ptrdiff_t pos, int whence = SEEK_SET) override {
+    ASSERT_EQ(whence, SEEK_SET);
+    seeks++;
+    pos_ = std::min<size_t>(pos, data_.size());
+  }
+
+  ptrdiff_t TellRead() const override {
+    return pos_;
+  }
+
+  size_t Size() const override {
+    return data_.size();
+  }
+
+  int reads = 0, seeks = 0;
+
+ private:
+  const std::vector<char> &data_;
+  size_t pos_ = 0;
+};
+
+std::vector<char> RandomContents(size_t size) {
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<char> data(size);
+  for (auto &c : data)
+    c = dist(rng);
+  return data;
+}
+
+}  // namespace
+
+TEST(BufferedFileStream, SequentialReads) {
+  auto contents = RandomContents(100000);
+  auto mem = std::make_unique<MemFileStream>(contents);
+  auto *underlying = mem.get();
+  BufferedFileStream stream(std::move(mem), 4096);
+  EXPECT_EQ(stream.path(), "mem");
+  EXPECT_EQ(stream.Size(), contents.size());
+
+  std::mt19937 rng(4321);
+  std::uniform_int_distribution<size_t> size_dist(0, 300);
+  std::vector<char> out;
+  while (out.size() < contents.size()) {
+    std::vector<char> buf(size_dist(rng));
+    size_t n = stream.Read(buf.data(), buf.size());
+    ASSERT_EQ(n, std::min(buf.size(), contents.size() - out.size()));
+    out.insert(out.end(), buf.begin(), buf.begin() + n);
+    ASSERT_EQ(stream.TellRead(), static_cast<ptrdiff_t>(out.size()));
+  }
+  EXPECT_EQ(out, contents);
+  char c;
+  EXPECT_EQ(stream.Read(&c, 1), 0u);
+  // the file was read in whole buffers, not in the small pieces
+  EXPECT_LE(underlying->reads, static_cast<int>(contents.size() / 4096 + 3));
+}
+
+TEST(BufferedFileStream, LargeReadsAndSeeks) {
+  auto contents = RandomContents(100000);
+  auto mem = std::make_unique<MemFileStream>(contents);
+  auto *underlying = mem.get();
+  BufferedFileStream stream(std::move(mem), 4096);
+
+  char c;
+  ASSERT_EQ(stream.Read(&c, 1), 1u);
+  EXPECT_EQ(c, contents[0]);
+  // a large read takes the buffered part and reads the rest directly
+  std::vector<char> buf(50000);
+  ASSERT_EQ(stream.Read(buf.data(), buf.size()), buf.size());
+  EXPECT_TRUE(std::equal(buf.begin(), buf.end(), contents.begin() + 1));
+  EXPECT_EQ(underlying->reads, 2);
+
+  // seeking within the buffered data doesn't touch the underlying stream
+  ASSERT_EQ(stream.Read(&c, 1), 1u);
+  ASSERT_EQ(stream.Read(buf.data(), 100), 100u);
+  int seeks = underlying->seeks;
+  stream.SeekRead(-50, SEEK_CUR);
+  EXPECT_EQ(stream.TellRead(), 50001 + 1 + 100 - 50);
+  ASSERT_EQ(stream.Read(buf.data(), 10), 10u);
+  EXPECT_TRUE(std::equal(buf.begin(), buf.begin() + 10, contents.begin() + 50052));
+  EXPECT_EQ(underlying->seeks, seeks);
+
+  // ...while the other seeks do
+  stream.SeekRead(99990);
+  EXPECT_EQ(underlying->seeks, seeks + 1);
+  ASSERT_EQ(stream.Read(buf.data(), buf.size()), 10u);
+  EXPECT_TRUE(std::equal(buf.begin(), buf.begin() + 10, contents.begin() + 99990));
+  stream.SeekRead(-5, SEEK_END);
+  EXPECT_EQ(stream.TellRead(), 99995);
+  ASSERT_EQ(stream.Read(buf.data(), 10), 5u);
+  stream.SeekRead(0);
+  ASSERT_EQ(stream.Read(&c, 1), 1u);
+  EXPECT_EQ(c, contents[0]);
+}
+
+}  // namespace dali
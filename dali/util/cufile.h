@@ -23,6 +23,10 @@
 #include "dali/core/common.h"
 #include "dali/util/file.h"
 
+namespace cufile {
+class CUFileHandle;
+}  // namespace cufile
+
 namespace dali {
 
 class DLL_PUBLIC CUFileStream : public FileStream {
@@ -58,6 +62,13 @@ class DLL_PUBLIC CUFileStream : public FileStream {
   virtual size_t ReadAtGPU(void *buffer, size_t n_bytes,
                            ptrdiff_t buffer_offset, int64 file_offset) = 0;
 
+  /**
+   * @brief The handle of the file, as registered with cuFile
+   *
+   * Used to submit the reads of many files at once, see CUFileBatchReader.
+   */
+  virtual const cufile::CUFileHandle &Handle() const = 0;
+
  protected:
   explicit CUFileStream(const std::string& path) : FileStream(path) {}
 };
@@ -0,0 +1,153 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/core/format.h"
+#include "dali/util/cufile_batch.h"
+#include "dali/util/cufile_helper.h"
+
+#if defined(CUFILE_BATCH_API_ENABLED) && CUFILE_BATCH_API_ENABLED
+#define DALI_HAS_CUFILE_BATCH 1
+#else
+#define DALI_HAS_CUFILE_BATCH 0
+#endif
+
+namespace dali {
+
+CUFileBatchReader::CUFileBatchReader(unsigned max_batch_size) : max_batch_size_(max_batch_size) {
+  DALI_ENFORCE(max_batch_size > 0, "The batch size must be positive");
+  pending_.reserve(max_batch_size);
+#if DALI_HAS_CUFILE_BATCH
+  CUfileBatchHandle_t batch;
+  if (cuFileBatchIOSetUp(&batch, max_batch_size).err == CU_FILE_SUCCESS)
+    batch_ = batch;
+#endif
+}
+
+CUFileBatchReader::~CUFileBatchReader() {
+#if DALI_HAS_CUFILE_BATCH
+  if (batch_)
+    cuFileBatchIODestroy(static_cast<CUfileBatchHandle_t>(batch_));
+#endif
+}
+
+bool CUFileBatchReader::IsAvailable() {
+#if DALI_HAS_CUFILE_BATCH
+  static bool available = []() {
+    CUfileBatchHandle_t batch;
+    if (cuFileBatchIOSetUp(&batch, 1).err != CU_FILE_SUCCESS)
+      return false;
+    cuFileBatchIODestroy(batch);
+    return true;
+  }();
+  return available;
+#else
+  return false;
+#endif
+}
+
+void CUFileBatchReader::Add(CUFileStream &stream, void *buffer_base, ptrdiff_t buffer_offset,
+                            int64 file_offset, size_t nbytes, int64_t user_id) {
+  DALI_ENFORCE(pending_.size() < max_batch_size_,
+               make_string("Cannot enqueue more than ", max_batch_size_, " reads."));
+  DALI_ENFORCE(file_offset >= 0 && static_cast<size_t>(file_offset) <= stream.Size(),
+               make_string("Invalid read offset ", file_offset, " in file ", stream.path()));
+  nbytes = std::min(nbytes, stream.Size() - file_offset);
+  pending_.push_back({ &stream, buffer_base, buffer_offset, file_offset, nbytes, user_id });
+}
+
+void CUFileBatchReader::Run(const Callback &on_complete) {
+  if (pending_.empty())
+    return;
+
+#if DALI_HAS_CUFILE_BATCH
+  if (batch_) {
+    auto batch = static_cast<CUfileBatchHandle_t>(batch_);
+    std::vector<CUfileIOParams_t> params;
+    params.reserve(pending_.size());
+    for (size_t i = 0; i < pending_.size(); i++) {
+      auto &r = pending_[i];
+      if (r.nbytes == 0) {
+        on_complete(r.user_id);
+        continue;
+      }
+      CUfileIOParams_t p = {};
+      p.mode = CUFILE_BATCH;
+      p.fh = r.stream->Handle().cufh;
+      p.opcode = CUFILE_READ;
+      p.cookie = reinterpret_cast<void *>(i);
+      p.u.batch.devPtr_base = r.buffer_base;
+      p.u.batch.devPtr_offset = r.buffer_offset;
+      p.u.batch.file_offset = r.file_offset;
+      p.u.batch.size = r.nbytes;
+      params.push_back(p);
+    }
+
+    unsigned nsubmitted = params.size();
+    if (nsubmitted > 0)
+      CUDA_CALL(cuFileBatchIOSubmit(batch, nsubmitted, params.data(), 0));
+
+    // Reap all the completions, even after a failure - the buffers must not be written to
+    // after we return.
+    std::vector<CUfileIOEvents_t> events(nsubmitted);
+    std::string error;
+    unsigned ncompleted = 0;
+    while (ncompleted < nsubmitted) {
+      unsigned nr = nsubmitted - ncompleted;
+      auto status = cuFileBatchIOGetStatus(batch, 1, &nr, events.data(), nullptr);
+      if (status.err != CU_FILE_SUCCESS) {
+        cuFileBatchIOCancel(batch);
+        pending_.clear();
+        CUDA_CALL(status);
+      }
+      for (unsigned j = 0; j < nr; j++) {
+        auto &r = pending_[reinterpret_cast<size_t>(events[j].cookie)];
+        if (events[j].status != CUFILE_COMPLETE) {
+          if (error.empty())
+            error = make_string("CUFile batch read failed for file ", r.stream->path(),
+                                " with status ", static_cast<int>(events[j].status));
+          continue;
+        }
+        if (error.empty()) {
+          if (events[j].ret < r.nbytes) {
+            // a short read - complete it synchronously
+            r.stream->ReadAtGPU(r.buffer_base, r.nbytes - events[j].ret,
+                                r.buffer_offset + events[j].ret, r.file_offset + events[j].ret);
+          }
+          on_complete(r.user_id);
+        }
+      }
+      ncompleted += nr;
+    }
+    pending_.clear();
+    if (!error.empty())
+      DALI_FAIL(error);
+    return;
+  }
+#endif
+
+  // the batch API is not available - read one by one
+  for (auto &r : pending_) {
+    if (r.nbytes > 0)
+      r.stream->ReadAtGPU(r.buffer_base, r.nbytes, r.buffer_offset, r.file_offset);
+    on_complete(r.user_id);
+  }
+  pending_.clear();
+}
+
+}  // namespace dali
@@ -0,0 +1,100 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_CUFILE_BATCH_H_
+#define DALI_UTIL_CUFILE_BATCH_H_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "dali/core/api_helper.h"
+#include "dali/core/common.h"
+#include "dali/util/cufile.h"
+
+namespace dali {
+
+/**
+ * @brief Reads many chunks, possibly from different files, to GPU memory with a single
+ *        cuFile batch submission
+ *
+ * The reads are accumulated with Add and submitted together by Run, so a single host thread
+ * keeps the whole batch in flight instead of issuing one blocking cuFileRead per chunk.
+ *
+ * At most `max_batch_size` reads can be pending - the caller is expected to call Run when
+ * `num_pending() == max_batch_size()`.
+ *
+ * The object is not thread safe.
+ */
+class DLL_PUBLIC CUFileBatchReader {
+ public:
+  /**
+   * @brief Called with the `user_id` of a read when it completes
+   */
+  using Callback = std::function<void(int64_t user_id)>;
+
+  explicit CUFileBatchReader(unsigned max_batch_size = 32);
+  ~CUFileBatchReader();
+
+  CUFileBatchReader(const CUFileBatchReader &) = delete;
+  CUFileBatchReader &operator=(const CUFileBatchReader &) = delete;
+
+  /**
+   * @brief Whether the cuFile batch API can be used - DALI was built with it and
+   *        the cuFile library in use supports it
+   */
+  static bool IsAvailable();
+
+  unsigned max_batch_size() const {
+    return max_batch_size_;
+  }
+
+  size_t num_pending() const {
+    return pending_.size();
+  }
+
+  /**
+   * @brief Enqueues a read of `nbytes` at `file_offset` to `buffer_base + buffer_offset`
+   *
+   * The read is clamped to the size of the file. The stream must stay open until Run returns.
+   */
+  void Add(CUFileStream &stream, void *buffer_base, ptrdiff_t buffer_offset,
+           int64 file_offset, size_t nbytes, int64_t user_id);
+
+  /**
+   * @brief Submits all the pending reads and waits for them to complete
+   *
+   * `on_complete` is called for each read as soon as its completion is reaped, while the others
+   * may still be in flight.
+   */
+  void Run(const Callback &on_complete);
+
+ private:
+  struct PendingRead {
+    CUFileStream *stream;
+    void *buffer_base;
+    ptrdiff_t buffer_offset;
+    int64 file_offset;
+    size_t nbytes;
+    int64_t user_id;
+  };
+
+  unsigned max_batch_size_;
+  void *batch_ = nullptr;
+  std::vector<PendingRead> pending_;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_CUFILE_BATCH_H_
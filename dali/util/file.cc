@@ -12,18 +12,37 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <fcntl.h>
+#include <algorithm>
 #include <string>
 
+#include "dali/core/error_handling.h"
 #include "dali/util/file.h"
+#include "dali/util/io_uring_file.h"
 #include "dali/util/mmaped_file.h"
+#include "dali/util/remote_uri.h"
 #include "dali/util/std_file.h"
+#if CURL_ENABLED
+#include "dali/util/http_file.h"
+#endif
 
 namespace dali {
 
 std::unique_ptr<FileStream> FileStream::Open(const std::string& uri, bool read_ahead,
-                                             bool use_mmap) {
+                                             bool use_mmap, bool use_io_uring,
+                                             bool use_o_direct, const FileReadPolicy &policy) {
   std::string processed_uri;
 
+  if (IsRemoteUri(uri)) {
+    // neither mapping nor io_uring apply to the objects read over HTTP
+#if CURL_ENABLED
+    return std::unique_ptr<FileStream>(new HttpFileStream(uri));
+#else
+    DALI_FAIL(make_string("Cannot open ", uri, ": DALI was built without remote file support "
+                          "(BUILD_CURL)."));
+#endif
+  }
+
   if (uri.find("file://") == 0) {
     processed_uri = uri.substr(std::string("file://").size());
   } else {
@@ -31,12 +50,62 @@ std::unique_ptr<FileStream> FileStream::Open(const std::string& uri, bool read_a
   }
 
   if (use_mmap) {
-    return std::unique_ptr<FileStream>(new MmapedFileStream(processed_uri, read_ahead));
+    return std::unique_ptr<FileStream>(new MmapedFileStream(processed_uri, read_ahead, policy));
+  } else if (use_io_uring) {
+    return std::unique_ptr<FileStream>(
+        new IOUringFileStream(processed_uri, use_o_direct, policy));
   } else {
-    return std::unique_ptr<FileStream>(new StdFileStream(processed_uri));
+    return std::unique_ptr<FileStream>(new StdFileStream(processed_uri, policy));
+  }
+}
+
+void FileStream::AdviseOpen(int fd) {
+  // the hints are best effort - the errors are ignored
+  switch (policy_.access_pattern) {
+    case FileReadPolicy::AccessPattern::Sequential:
+      posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+      break;
+    case FileReadPolicy::AccessPattern::Random:
+      posix_fadvise(fd, 0, 0, POSIX_FADV_RANDOM);
+      break;
+    default:
+      break;
   }
 }
 
+void FileStream::AdviseRead(int fd, int64_t offset, size_t n_bytes) {
+  if (n_bytes == 0)
+    return;
+  // only the whole pages in the range are dropped; the rest goes away in AdviseClose
+  if (policy_.drop_page_cache)
+    posix_fadvise(fd, offset, n_bytes, POSIX_FADV_DONTNEED);
+  int64_t from, length;
+  if (NextReadahead(offset, n_bytes, from, length))
+    posix_fadvise(fd, from, length, POSIX_FADV_WILLNEED);
+}
+
+void FileStream::AdviseClose(int fd) {
+  if (policy_.drop_page_cache)
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+}
+
+bool FileStream::NextReadahead(int64_t offset, size_t n_bytes, int64_t &from, int64_t &length) {
+  if (policy_.readahead_reads <= 0 || n_bytes == 0)
+    return false;
+  total_read_ += n_bytes;
+  num_reads_++;
+  int64_t window = total_read_ / num_reads_ * policy_.readahead_reads;
+  int64_t end = offset + n_bytes;
+  bool in_window = end <= readahead_end_ && readahead_end_ <= end + window;
+  if (in_window && readahead_end_ - end >= window / 2)
+    return false;
+  // after a seek outside of the window, start a new one at the current position
+  from = in_window ? readahead_end_ : end;
+  readahead_end_ = end + window;
+  length = readahead_end_ - from;
+  return length > 0;
+}
+
 bool FileStream::ReserveFileMappings(unsigned int num) {
   return MmapedFileStream::ReserveFileMappings(num);
 }
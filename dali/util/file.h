@@ -15,6 +15,7 @@
 #ifndef DALI_UTIL_FILE_H_
 #define DALI_UTIL_FILE_H_
 
+#include <cstdint>
 #include <cstdio>
 #include <memory>
 #include <string>
@@ -25,6 +26,32 @@
 
 namespace dali {
 
+/**
+ * @brief Hints on how a file is read, passed to the OS to control the page cache
+ */
+struct FileReadPolicy {
+  enum class AccessPattern {
+    Normal,      ///< the OS default
+    Sequential,  ///< the file is read from the beginning to the end (larger OS readahead)
+    Random       ///< the file is read at random offsets (no OS readahead)
+  };
+  AccessPattern access_pattern = AccessPattern::Normal;
+  /**
+   * @brief Drop the pages of the file from the page cache once they are read
+   *
+   * Keeps the dataset from evicting the data of the other processes. Ignored by the mapped
+   * files, as the outputs reference the mapped pages.
+   */
+  bool drop_page_cache = false;
+  /**
+   * @brief Keep this many reads ahead of the current position in the page cache
+   *
+   * The size of the window is the number of reads multiplied by the average size of a read
+   * so far. 0 leaves the readahead to the OS.
+   */
+  int readahead_reads = 0;
+};
+
 class DLL_PUBLIC FileStream : public InputStream {
  public:
   class MappingReserver {
@@ -69,18 +96,61 @@ class DLL_PUBLIC FileStream : public InputStream {
    private:
     unsigned int reserved;
   };
-  static std::unique_ptr<FileStream> Open(const std::string &uri, bool read_ahead, bool use_mmap);
+  /**
+   * @brief Opens a file
+   *
+   * @param use_mmap      map the file in memory
+   * @param use_io_uring  read via io_uring (see IOUringFileStream); ignored with use_mmap
+   * @param use_o_direct  bypass the page cache; only with use_io_uring
+   * @param policy        hints on how the file is read; ignored for the remote files
+   */
+  static std::unique_ptr<FileStream> Open(const std::string &uri, bool read_ahead, bool use_mmap,
+                                          bool use_io_uring = false, bool use_o_direct = false,
+                                          const FileReadPolicy &policy = {});
 
   virtual void Close() = 0;
   virtual shared_ptr<void> Get(size_t n_bytes) = 0;
   virtual ~FileStream() {}
 
+  const std::string &path() const {
+    return path_;
+  }
+
  protected:
   static bool ReserveFileMappings(unsigned int num);
   static void FreeFileMappings(unsigned int num);
-  explicit FileStream(const std::string &path) : path_(path) {}
+  explicit FileStream(const std::string &path, const FileReadPolicy &policy = {})
+      : path_(path), policy_(policy) {}
+
+  /**
+   * @brief Applies the access pattern of the policy to an open file
+   */
+  void AdviseOpen(int fd);
+  /**
+   * @brief Drops the read range from the page cache and advances the readahead window,
+   *        as requested by the policy
+   */
+  void AdviseRead(int fd, int64_t offset, size_t n_bytes);
+  /**
+   * @brief Drops the whole file from the page cache, if requested by the policy
+   */
+  void AdviseClose(int fd);
+  /**
+   * @brief Updates the readahead window after reading `n_bytes` at `offset`
+   *
+   * @return whether the range [`from`, `from` + `length`) should be prefetched; the window is
+   *         refilled only when less than half of it is left, so that the OS is not asked
+   *         on every read
+   */
+  bool NextReadahead(int64_t offset, size_t n_bytes, int64_t &from, int64_t &length);
 
   std::string path_;
+  FileReadPolicy policy_;
+
+ private:
+  int64_t readahead_end_ = 0;
+  int64_t total_read_ = 0;
+  int64_t num_reads_ = 0;
 };
 
 }  // namespace dali
@@ -0,0 +1,124 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "dali/util/file.h"
+#include "dali/util/std_file.h"
+
+namespace dali {
+
+namespace {
+
+class TempFile {
+ public:
+  explicit TempFile(const std::vector<char> &contents) {
+    char name[] = "/tmp/dali_file_testXXXXXX";
+    int fd = mkstemp(name);
+    EXPECT_GE(fd, 0);
+    path_ = name;
+    EXPECT_EQ(write(fd, contents.data(), contents.size()),
+              static_cast<ssize_t>(contents.size()));
+    close(fd);
+  }
+
+  ~TempFile() {
+    unlink(path_.c_str());
+  }
+
+  const std::string &path() const {
+    return path_;
+  }
+
+ private:
+  std::string path_;
+};
+
+std::vector<char> RandomContents(size_t size) {
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<char> data(size);
+  for (auto &c : data)
+    c = dist(rng);
+  return data;
+}
+
+class ReadaheadTestStream : public StdFileStream {
+ public:
+  using StdFileStream::StdFileStream;
+  using FileStream::NextReadahead;
+};
+
+}  // namespace
+
+TEST(FileStream, ReadPolicy) {
+  auto contents = RandomContents((1 << 20) + 1234);
+  TempFile file(contents);
+  FileReadPolicy policies[3];
+  policies[1].access_pattern = FileReadPolicy::AccessPattern::Sequential;
+  policies[1].drop_page_cache = true;
+  policies[1].readahead_reads = 8;
+  policies[2].access_pattern = FileReadPolicy::AccessPattern::Random;
+  policies[2].readahead_reads = 1;
+  for (auto &policy : policies) {
+    for (bool use_mmap : {false, true}) {
+      for (bool use_io_uring : {false, true}) {
+        auto stream = FileStream::Open(file.path(), false, use_mmap, use_io_uring, false, policy);
+        ASSERT_EQ(stream->Size(), contents.size());
+        std::vector<char> buf(contents.size());
+        // the reads of different sizes, the last one hitting the end of the file
+        size_t pos = 0;
+        for (size_t n = 1000; pos < contents.size(); n = n * 3 / 2) {
+          size_t expected = std::min(n, contents.size() - pos);
+          ASSERT_EQ(stream->Read(buf.data() + pos, n), expected);
+          pos += expected;
+        }
+        EXPECT_EQ(buf, contents);
+        stream->Close();
+      }
+    }
+  }
+}
+
+TEST(FileStream, ReadaheadWindow) {
+  TempFile file(RandomContents(1000));
+  FileReadPolicy policy;
+  policy.readahead_reads = 4;
+  ReadaheadTestStream stream(file.path(), policy);
+  int64_t from = -1, length = -1;
+  // the first read starts the window
+  ASSERT_TRUE(stream.NextReadahead(0, 100, from, length));
+  EXPECT_EQ(from, 100);
+  EXPECT_EQ(length, 400);
+  // no hints while more than half of the window is left
+  EXPECT_FALSE(stream.NextReadahead(100, 100, from, length));
+  EXPECT_FALSE(stream.NextReadahead(200, 100, from, length));
+  // the window is extended from where it ended
+  ASSERT_TRUE(stream.NextReadahead(300, 100, from, length));
+  EXPECT_EQ(from, 500);
+  EXPECT_EQ(length, 300);
+  // a seek backwards starts a new window
+  ASSERT_TRUE(stream.NextReadahead(0, 100, from, length));
+  EXPECT_EQ(from, 100);
+  EXPECT_EQ(length, 400);
+
+  ReadaheadTestStream no_readahead(file.path());
+  EXPECT_FALSE(no_readahead.NextReadahead(0, 100, from, length));
+}
+
+}  // namespace dali
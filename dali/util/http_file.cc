@@ -0,0 +1,440 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <curl/curl.h>
+#include <strings.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dali/core/error_handling.h"
+#include "dali/util/http_file.h"
+#include "dali/util/remote_uri.h"
+
+namespace dali {
+
+namespace {
+
+constexpr int kMaxRetries = 4;
+/// The first request of a stream, telling the size of the object - a whole image, usually
+constexpr size_t kProbeSize = 256 << 10;
+/// The smallest range fetched after a seek
+constexpr size_t kMinRandomRead = 64 << 10;
+
+size_t GetSizeEnv(const char *name, size_t default_value) {
+  const char *env = std::getenv(name);
+  int len = 0;
+  if (!env || !(len = strlen(env)))
+    return default_value;
+  for (int i = 0; i < len; i++) {
+    bool valid = std::isdigit(env[i]) || (i == len - 1 && (env[i] == 'k' || env[i] == 'M'));
+    DALI_ENFORCE(valid, make_string(
+        name, " must be a number, optionally followed by 'k' or 'M', got: ", env));
+  }
+  size_t s = atoll(env);
+  if (env[len - 1] == 'k')
+    s <<= 10;
+  else if (env[len - 1] == 'M')
+    s <<= 20;
+  DALI_ENFORCE(s > 0, make_string(name, " must be positive"));
+  return s;
+}
+
+size_t ChunkSize() {
+  static const size_t size = GetSizeEnv("DALI_HTTP_CHUNK_SIZE", 4 << 20);
+  return size;
+}
+
+size_t ReadaheadSize() {
+  static const size_t size = std::max(GetSizeEnv("DALI_HTTP_READAHEAD", 16 << 20), kProbeSize);
+  return size;
+}
+
+int MaxConnections() {
+  static const int n = GetSizeEnv("DALI_HTTP_MAX_CONNECTIONS", 8);
+  return n;
+}
+
+/**
+ * @brief The URL without the query, which may hold credentials (presigned URLs)
+ */
+std::string PrintableUrl(const std::string &url) {
+  return url.substr(0, url.find('?'));
+}
+
+/**
+ * @brief A request for [offset, offset + length) of the object, stored to `dst`
+ */
+struct RangeRequest {
+  uint8_t *dst;
+  size_t offset;
+  size_t length;
+  /// Number of bytes stored in `dst`
+  size_t done = 0;
+  /// Number of bytes of the response body received
+  size_t received = 0;
+  long status = 0;  // NOLINT(runtime/int)
+  /// The size of the object, if the response tells it
+  int64_t total = -1;
+  int attempts = 0;
+
+  bool complete() const {
+    return done == length;
+  }
+
+  void Restart() {
+    done = received = 0;
+    status = 0;
+    total = -1;
+  }
+};
+
+size_t HeaderCallback(char *buffer, size_t size, size_t nitems, void *userdata) {
+  auto &req = *static_cast<RangeRequest *>(userdata);
+  size_t n = size * nitems;
+  std::string line(buffer, n);
+  if (line.compare(0, 5, "HTTP/") == 0) {
+    // a new response (e.g. after a redirect)
+    req.Restart();
+    auto space = line.find(' ');
+    if (space != std::string::npos)
+      req.status = std::atol(line.c_str() + space + 1);
+  } else if (strncasecmp(line.c_str(), "content-range:", 14) == 0) {
+    // bytes <first>-<last>/<total> or bytes */<total>
+    auto slash = line.find('/');
+    if (slash != std::string::npos && line[slash + 1] != '*')
+      req.total = std::atoll(line.c_str() + slash + 1);
+  } else if (strncasecmp(line.c_str(), "content-length:", 15) == 0 && req.status == 200) {
+    req.total = std::atoll(line.c_str() + 15);
+  }
+  return n;
+}
+
+size_t WriteCallback(char *ptr, size_t size, size_t nmemb, void *userdata) {
+  auto &req = *static_cast<RangeRequest *>(userdata);
+  size_t n = size * nmemb;
+  // the position of the data in the object
+  size_t begin = req.status == 206 ? req.offset + req.received : req.received;
+  req.received += n;
+  if (req.status != 200 && req.status != 206)
+    return n;  // an error message
+  // the server may ignore the range and send the whole object
+  size_t want_begin = req.offset + req.done;
+  size_t want_end = req.offset + req.length;
+  size_t copy_begin = std::max(begin, want_begin);
+  size_t copy_end = std::min(begin + n, want_end);
+  if (copy_begin < copy_end) {
+    std::memcpy(req.dst + req.done, ptr + (copy_begin - begin), copy_end - copy_begin);
+    req.done += copy_end - copy_begin;
+  }
+  // stop the transfer of the data that is not needed
+  return req.complete() && begin + n > want_end ? 0 : n;
+}
+
+enum class Outcome {
+  Done, Retry, Fail
+};
+
+bool IsTransient(CURLcode result) {
+  switch (result) {
+    case CURLE_COULDNT_RESOLVE_HOST:
+    case CURLE_COULDNT_CONNECT:
+    case CURLE_OPERATION_TIMEDOUT:
+    case CURLE_SEND_ERROR:
+    case CURLE_RECV_ERROR:
+    case CURLE_GOT_NOTHING:
+    case CURLE_PARTIAL_FILE:
+    case CURLE_SSL_CONNECT_ERROR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief The connections (and the transfer handles) of the calling thread
+ */
+class CurlContext {
+ public:
+  static CurlContext &ThisThread() {
+    thread_local CurlContext ctx;
+    return ctx;
+  }
+
+  /**
+   * @brief Runs the requests, up to MaxConnections() at a time
+   */
+  void Run(const std::string &url, std::vector<RangeRequest> &requests) {
+    size_t next = 0;
+    std::vector<CURL *> active;
+    std::string error;
+    auto start = [&](RangeRequest &req) {
+      CURL *handle = AcquireHandle();
+      Setup(handle, url, req);
+      curl_multi_add_handle(multi_, handle);
+      active.push_back(handle);
+    };
+    while (next < requests.size() && static_cast<int>(active.size()) < MaxConnections())
+      start(requests[next++]);
+
+    while (!active.empty() && error.empty()) {
+      int running = 0;
+      CURLMcode mc = curl_multi_perform(multi_, &running);
+      if (mc != CURLM_OK) {
+        error = curl_multi_strerror(mc);
+        break;
+      }
+      CURLMsg *msg;
+      int left;
+      while ((msg = curl_multi_info_read(multi_, &left)) && error.empty()) {
+        if (msg->msg != CURLMSG_DONE)
+          continue;
+        CURL *handle = msg->easy_handle;
+        CURLcode result = msg->data.result;
+        RangeRequest *req;
+        curl_easy_getinfo(handle, CURLINFO_PRIVATE, reinterpret_cast<char **>(&req));
+        curl_multi_remove_handle(multi_, handle);
+        active.erase(std::find(active.begin(), active.end(), handle));
+        ReleaseHandle(handle);
+
+        std::string req_error;
+        auto outcome = Check(*req, result, req_error);
+        if (outcome == Outcome::Retry) {
+          if (++req->attempts <= kMaxRetries) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100 << req->attempts));
+            req->Restart();
+            start(*req);
+            continue;
+          }
+          error = make_string(req_error, " (after ", kMaxRetries, " retries)");
+        } else if (outcome == Outcome::Fail) {
+          error = req_error;
+        }
+        if (outcome == Outcome::Done && next < requests.size())
+          start(requests[next++]);
+      }
+      if (!active.empty() && error.empty())
+        curl_multi_wait(multi_, nullptr, 0, 1000, nullptr);
+    }
+
+    for (CURL *handle : active) {
+      curl_multi_remove_handle(multi_, handle);
+      ReleaseHandle(handle);
+    }
+    DALI_ENFORCE(error.empty(), make_string("Failed to read ", PrintableUrl(url), ": ", error));
+  }
+
+  ~CurlContext() {
+    for (CURL *handle : idle_)
+      curl_easy_cleanup(handle);
+    curl_multi_cleanup(multi_);
+    curl_slist_free_all(headers_);
+  }
+
+ private:
+  CurlContext() {
+    static std::once_flag init;
+    std::call_once(init, []() {
+      DALI_ENFORCE(curl_global_init(CURL_GLOBAL_DEFAULT) == CURLE_OK,
+                   "Failed to initialize libcurl");
+    });
+    multi_ = curl_multi_init();
+    DALI_ENFORCE(multi_ != nullptr, "Failed to initialize libcurl");
+    curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(MaxConnections()));  // NOLINT
+    if (const char *header = std::getenv("DALI_HTTP_HEADER")) {
+      if (*header)
+        headers_ = curl_slist_append(nullptr, header);
+    }
+  }
+
+  CURL *AcquireHandle() {
+    if (idle_.empty()) {
+      CURL *handle = curl_easy_init();
+      DALI_ENFORCE(handle != nullptr, "Failed to initialize libcurl");
+      return handle;
+    }
+    CURL *handle = idle_.back();
+    idle_.pop_back();
+    curl_easy_reset(handle);
+    return handle;
+  }
+
+  void ReleaseHandle(CURL *handle) {
+    idle_.push_back(handle);
+  }
+
+  void Setup(CURL *handle, const std::string &url, RangeRequest &req) {
+    std::string range = make_string(req.offset, "-", req.offset + req.length - 1);
+    curl_easy_setopt(handle, CURLOPT_URL, url.c_str());
+    // the string is copied
+    curl_easy_setopt(handle, CURLOPT_RANGE, range.c_str());
+    curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, 30L);
+    // abort the transfers that stall for a minute
+    curl_easy_setopt(handle, CURLOPT_LOW_SPEED_LIMIT, 1L);
+    curl_easy_setopt(handle, CURLOPT_LOW_SPEED_TIME, 60L);
+    curl_easy_setopt(handle, CURLOPT_HEADERFUNCTION, HeaderCallback);
+    curl_easy_setopt(handle, CURLOPT_HEADERDATA, &req);
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(handle, CURLOPT_WRITEDATA, &req);
+    curl_easy_setopt(handle, CURLOPT_PRIVATE, &req);
+    if (headers_)
+      curl_easy_setopt(handle, CURLOPT_HTTPHEADER, headers_);
+  }
+
+  static Outcome Check(const RangeRequest &req, CURLcode result, std::string &error) {
+    if (result == CURLE_WRITE_ERROR && req.complete())
+      result = CURLE_OK;  // stopped by WriteCallback
+    if (result != CURLE_OK) {
+      error = curl_easy_strerror(result);
+      return IsTransient(result) ? Outcome::Retry : Outcome::Fail;
+    }
+    if (req.status == 206 || req.status == 200 || req.status == 416) {
+      // 416 - the range starts past the end of the object
+      return Outcome::Done;
+    }
+    error = make_string("HTTP ", req.status);
+    return req.status == 429 || req.status >= 500 ? Outcome::Retry : Outcome::Fail;
+  }
+
+  CURLM *multi_ = nullptr;
+  std::vector<CURL *> idle_;
+  curl_slist *headers_ = nullptr;
+};
+
+}  // namespace
+
+HttpFileStream::HttpFileStream(const std::string &uri)
+    : FileStream(uri), url_(RemoteUriToUrl(uri)) {
+  // the first request tells the size of the object
+  std::vector<RangeRequest> requests(1);
+  window_.resize(ReadaheadSize());
+  requests[0].dst = window_.data();
+  requests[0].offset = 0;
+  requests[0].length = kProbeSize;
+  CurlContext::ThisThread().Run(url_, requests);
+  auto &req = requests[0];
+  // a shorter object is read whole
+  DALI_ENFORCE(req.total >= 0 || !req.complete(),
+               make_string("The size of ", uri, " is unknown - the server tells neither "
+                           "Content-Range nor Content-Length"));
+  size_ = req.total >= 0 ? req.total : req.done;
+  window_valid_ = req.done;
+}
+
+void HttpFileStream::Close() {
+  window_.clear();
+  window_.shrink_to_fit();
+  window_offset_ = window_valid_ = 0;
+}
+
+shared_ptr<void> HttpFileStream::Get(size_t n_bytes) {
+  if (pos_ + n_bytes > size_)
+    return {};
+  shared_ptr<uint8_t> data(new uint8_t[n_bytes], [](uint8_t *p) { delete[] p; });
+  if (Read(data.get(), n_bytes) != n_bytes)
+    return {};
+  return data;
+}
+
+size_t HttpFileStream::CopyFromWindow(uint8_t *dst, size_t n_bytes) {
+  if (pos_ < window_offset_ || pos_ >= window_offset_ + window_valid_)
+    return 0;
+  size_t n = std::min(n_bytes, window_offset_ + window_valid_ - pos_);
+  std::memcpy(dst, window_.data() + (pos_ - window_offset_), n);
+  pos_ += n;
+  return n;
+}
+
+size_t HttpFileStream::Read(void *buffer, size_t n_bytes) {
+  auto *dst = static_cast<uint8_t *>(buffer);
+  if (pos_ >= size_)
+    return 0;
+  n_bytes = std::min(n_bytes, size_ - pos_);
+  size_t total = CopyFromWindow(dst, n_bytes);
+  while (total < n_bytes) {
+    size_t remaining = n_bytes - total;
+    if (remaining >= ReadaheadSize()) {
+      // no point in copying through the window
+      size_t n = Fetch(dst + total, pos_, remaining);
+      pos_ += n;
+      total += n;
+      break;
+    }
+    if (window_.empty())
+      window_.resize(ReadaheadSize());
+    bool sequential = pos_ == window_offset_ + window_valid_;
+    size_t length = sequential ? window_.size()
+                               : std::min(window_.size(), std::max(remaining, kMinRandomRead));
+    window_offset_ = pos_;
+    window_valid_ = 0;  // in case the fetch fails
+    window_valid_ = Fetch(window_.data(), pos_, std::min(length, size_ - pos_));
+    size_t n = CopyFromWindow(dst + total, remaining);
+    if (n == 0)
+      break;
+    total += n;
+  }
+  return total;
+}
+
+size_t HttpFileStream::Fetch(uint8_t *dst, size_t offset, size_t length) {
+  std::vector<RangeRequest> requests;
+  size_t chunk = ChunkSize();
+  for (size_t start = 0; start < length; start += chunk) {
+    requests.emplace_back();
+    auto &req = requests.back();
+    req.dst = dst + start;
+    req.offset = offset + start;
+    req.length = std::min(chunk, length - start);
+  }
+  CurlContext::ThisThread().Run(url_, requests);
+  size_t total = 0;
+  for (auto &req : requests) {
+    total += req.done;
+    if (!req.complete())
+      break;  // the object is shorter than expected
+  }
+  return total;
+}
+
+void HttpFileStream::SeekRead(ptrdiff_t pos, int whence) {
+  if (whence == SEEK_CUR) {
+    pos += pos_;
+  } else if (whence == SEEK_END) {
+    pos += size_;
+  } else {
+    DALI_ENFORCE(whence == SEEK_SET, "Invalid seek origin");
+  }
+  DALI_ENFORCE(pos >= 0 && pos <= static_cast<ptrdiff_t>(size_), "Invalid seek");
+  pos_ = pos;
+}
+
+ptrdiff_t HttpFileStream::TellRead() const {
+  return pos_;
+}
+
+size_t HttpFileStream::Size() const {
+  return size_;
+}
+
+}  // namespace dali
@@ -0,0 +1,83 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_HTTP_FILE_H_
+#define DALI_UTIL_HTTP_FILE_H_
+
+#include <cstdio>
+#include <string>
+#include <memory>
+#include <vector>
+
+#include "dali/core/common.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+/**
+ * @brief A file stream reading an object from an object store (S3, GCS) or an HTTP server
+ *
+ * The data is fetched with HTTP range requests. A read is split into chunks
+ * (`DALI_HTTP_CHUNK_SIZE`, 4 MiB by default), which are all requested at once, over up to
+ * `DALI_HTTP_MAX_CONNECTIONS` (8) connections. Each thread keeps its own pool of connections,
+ * reused by all the streams it reads.
+ *
+ * Sequential reads are served from a readahead window (`DALI_HTTP_READAHEAD`, 16 MiB), refilled
+ * with parallel requests when the read goes past it. After a seek outside of the window, only
+ * the requested range is fetched, so random access doesn't download whole windows.
+ *
+ * The header set in `DALI_HTTP_HEADER` (for example, `Authorization: Bearer <token>`) is added
+ * to all the requests. Transient errors (connection errors, HTTP 429 and 5xx) are retried.
+ *
+ * @see RemoteUriToUrl for the supported URIs
+ */
+class DLL_PUBLIC HttpFileStream : public FileStream {
+ public:
+  explicit HttpFileStream(const std::string &uri);
+  void Close() override;
+  shared_ptr<void> Get(size_t n_bytes) override;
+  size_t Read(void *buffer, size_t n_bytes) override;
+  void SeekRead(ptrdiff_t pos, int whence = SEEK_SET) override;
+  ptrdiff_t TellRead() const override;
+  size_t Size() const override;
+
+  ~HttpFileStream() override {
+    Close();
+  }
+
+ private:
+  /**
+   * @brief Fetches [offset, offset + length) of the object to `dst`, with parallel requests
+   *
+   * @return The number of bytes fetched - less than `length` at the end of the object
+   */
+  size_t Fetch(uint8_t *dst, size_t offset, size_t length);
+
+  /**
+   * @brief Copies the part of the window at the current position to `dst`
+   */
+  size_t CopyFromWindow(uint8_t *dst, size_t n_bytes);
+
+  std::string url_;
+  size_t size_ = 0;
+  size_t pos_ = 0;
+  std::vector<uint8_t> window_;
+  /// The window holds [window_offset_, window_offset_ + window_valid_) of the object
+  size_t window_offset_ = 0;
+  size_t window_valid_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_HTTP_FILE_H_
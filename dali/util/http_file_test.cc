@@ -0,0 +1,249 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dali/util/file.h"
+#include "dali/util/http_file.h"
+
+namespace dali {
+
+namespace {
+
+/**
+ * @brief A minimal HTTP server, serving `data` at any path
+ */
+class TestServer {
+ public:
+  explicit TestServer(const std::vector<char> &data, bool support_ranges = true,
+                      int fail_first = 0)
+      : data_(data), support_ranges_(support_ranges), fail_first_(fail_first) {
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    EXPECT_EQ(bind(listen_fd_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)), 0);
+    EXPECT_EQ(listen(listen_fd_, 16), 0);
+    socklen_t len = sizeof(addr);
+    getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&addr), &len);
+    url_ = "http://127.0.0.1:" + std::to_string(ntohs(addr.sin_port)) + "/object";
+    acceptor_ = std::thread([this]() { Accept(); });
+  }
+
+  ~TestServer() {
+    shutdown(listen_fd_, SHUT_RDWR);
+    close(listen_fd_);
+    acceptor_.join();
+    // the client keeps the connections open
+    for (int fd : client_fds_)
+      shutdown(fd, SHUT_RDWR);
+    for (auto &t : connections_)
+      t.join();
+  }
+
+  const std::string &url() const {
+    return url_;
+  }
+
+  std::atomic<int> requests{0};
+  std::atomic<int> connections{0};
+
+ private:
+  void Accept() {
+    for (;;) {
+      int fd = accept(listen_fd_, nullptr, nullptr);
+      if (fd < 0)
+        return;
+      connections++;
+      client_fds_.push_back(fd);
+      connections_.emplace_back([this, fd]() { Serve(fd); });
+    }
+  }
+
+  void Serve(int fd) {
+    std::string in;
+    char buf[4096];
+    for (;;) {
+      size_t end;
+      while ((end = in.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) {
+          close(fd);
+          return;
+        }
+        in.append(buf, n);
+      }
+      std::string request = in.substr(0, end);
+      in.erase(0, end + 4);
+      Respond(fd, request);
+    }
+  }
+
+  void Respond(int fd, const std::string &request) {
+    int index = requests++;
+    std::string header;
+    size_t first = 0, last = data_.size() - 1;
+    auto range = request.find("Range: bytes=");
+    if (index < fail_first_) {
+      header = "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n";
+      first = 1;
+      last = 0;
+    } else if (range != std::string::npos && support_ranges_) {
+      first = std::atoll(request.c_str() + range + 13);
+      last = std::atoll(request.c_str() + request.find('-', range) + 1);
+      if (first >= data_.size()) {
+        header = "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Range: bytes */" +
+                 std::to_string(data_.size()) + "\r\nContent-Length: 0\r\n\r\n";
+        last = first - 1;
+      } else {
+        last = std::min(last, data_.size() - 1);
+        header = "HTTP/1.1 206 Partial Content\r\nContent-Range: bytes " + std::to_string(first) +
+                 "-" + std::to_string(last) + "/" + std::to_string(data_.size()) +
+                 "\r\nContent-Length: " + std::to_string(last - first + 1) + "\r\n\r\n";
+      }
+    } else {
+      header = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(data_.size()) +
+               "\r\n\r\n";
+    }
+    SendAll(fd, header.data(), header.size());
+    if (last + 1 > first)
+      SendAll(fd, data_.data() + first, last + 1 - first);
+  }
+
+  static void SendAll(int fd, const char *data, size_t size) {
+    while (size > 0) {
+      ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+      if (n <= 0)
+        return;
+      data += n;
+      size -= n;
+    }
+  }
+
+  const std::vector<char> &data_;
+  bool support_ranges_;
+  int fail_first_;
+  int listen_fd_;
+  std::string url_;
+  std::thread acceptor_;
+  std::vector<int> client_fds_;
+  std::vector<std::thread> connections_;
+};
+
+std::vector<char> RandomContents(size_t size) {
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<char> data(size);
+  for (auto &c : data)
+    c = dist(rng);
+  return data;
+}
+
+}  // namespace
+
+TEST(HttpFileStream, SequentialRead) {
+  auto contents = RandomContents(50 << 20);
+  TestServer server(contents);
+  auto stream = FileStream::Open(server.url(), false, true, false, false);
+  ASSERT_EQ(stream->Size(), contents.size());
+
+  std::vector<char> out;
+  std::mt19937 rng(4321);
+  std::uniform_int_distribution<size_t> size_dist(0, 3 << 20);
+  while (out.size() < contents.size()) {
+    std::vector<char> buf(size_dist(rng));
+    size_t n = stream->Read(buf.data(), buf.size());
+    ASSERT_EQ(n, std::min(buf.size(), contents.size() - out.size()));
+    out.insert(out.end(), buf.begin(), buf.begin() + n);
+    ASSERT_EQ(stream->TellRead(), static_cast<ptrdiff_t>(out.size()));
+  }
+  EXPECT_TRUE(out == contents);
+  char c;
+  EXPECT_EQ(stream->Read(&c, 1), 0u);
+  // read in whole chunks, over the pooled connections
+  EXPECT_LE(server.requests, 20);
+  EXPECT_LE(server.connections, 8);
+}
+
+TEST(HttpFileStream, RandomAccess) {
+  auto contents = RandomContents(10 << 20);
+  TestServer server(contents);
+  HttpFileStream stream(server.url());
+  std::mt19937 rng(4321);
+  std::uniform_int_distribution<size_t> pos_dist(0, contents.size());
+  for (int i = 0; i < 50; i++) {
+    size_t pos = pos_dist(rng);
+    size_t size = std::uniform_int_distribution<size_t>(0, 100000)(rng);
+    stream.SeekRead(pos);
+    auto data = stream.Get(size);
+    if (pos + size > contents.size()) {
+      EXPECT_EQ(data, nullptr);
+      continue;
+    }
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(std::memcmp(data.get(), contents.data() + pos, size), 0);
+    EXPECT_EQ(stream.TellRead(), static_cast<ptrdiff_t>(pos + size));
+  }
+  stream.SeekRead(-10, SEEK_END);
+  std::vector<char> buf(100);
+  EXPECT_EQ(stream.Read(buf.data(), buf.size()), 10u);
+  stream.Close();
+}
+
+TEST(HttpFileStream, SmallObject) {
+  auto contents = RandomContents(1000);
+  TestServer server(contents);
+  HttpFileStream stream(server.url());
+  EXPECT_EQ(stream.Size(), contents.size());
+  std::vector<char> buf(2000);
+  EXPECT_EQ(stream.Read(buf.data(), buf.size()), contents.size());
+  EXPECT_TRUE(std::equal(contents.begin(), contents.end(), buf.begin()));
+  // the whole object came with the first request
+  EXPECT_EQ(server.requests, 1);
+}
+
+TEST(HttpFileStream, NoRangeSupport) {
+  auto contents = RandomContents(1 << 20);
+  TestServer server(contents, false);
+  HttpFileStream stream(server.url());
+  EXPECT_EQ(stream.Size(), contents.size());
+  std::vector<char> buf(contents.size());
+  EXPECT_EQ(stream.Read(buf.data(), buf.size()), contents.size());
+  EXPECT_TRUE(buf == contents);
+}
+
+TEST(HttpFileStream, Retries) {
+  auto contents = RandomContents(1000);
+  TestServer flaky(contents, true, 2);
+  HttpFileStream stream(flaky.url());
+  EXPECT_EQ(stream.Size(), contents.size());
+
+  TestServer broken(contents, true, 100);
+  EXPECT_THROW(HttpFileStream{broken.url()}, std::exception);
+}
+
+}  // namespace dali
@@ -0,0 +1,421 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define DALI_HAS_IO_URING 1
+#endif
+#endif
+
+#include "dali/core/error_handling.h"
+#include "dali/util/io_uring_file.h"
+
+namespace dali {
+
+namespace {
+
+constexpr size_t kChunkSize = 256 << 10;
+constexpr int kQueueDepth = 32;
+/// Number of bounce buffers used for O_DIRECT reads
+constexpr int kNumBounceBuffers = 8;
+constexpr size_t kDirectAlignment = 4096;
+
+/**
+ * @brief A part of a read - from `offset` in the file to `dst`
+ */
+struct ReadRequest {
+  int fd;
+  char *dst;
+  int64_t offset;
+  size_t length;
+  /// The request is complete when this many bytes are read - less than `length` when
+  /// the request (aligned for O_DIRECT) goes past the end of the file
+  size_t min_length;
+  /// Index of the registered buffer `dst` points to, or -1
+  int buffer_index = -1;
+  /// Number of bytes read
+  size_t done = 0;
+};
+
+void ReadWithPread(ReadRequest &req) {
+  while (req.done < req.length) {
+    ssize_t n = pread(req.fd, req.dst + req.done, req.length - req.done, req.offset + req.done);
+    if (n < 0 && errno == EINTR)
+      continue;
+    DALI_ENFORCE(n >= 0, make_string("Read failed: ", std::strerror(errno)));
+    if (n == 0)
+      break;
+    req.done += n;
+  }
+}
+
+struct AlignedFree {
+  void operator()(void *p) const {
+    free(p);
+  }
+};
+
+class IOUring {
+ public:
+  IOUring() {
+#if DALI_HAS_IO_URING
+    available_ = Setup();
+#endif
+  }
+
+  ~IOUring() {
+#if DALI_HAS_IO_URING
+    if (sq_ring_ != MAP_FAILED && sq_ring_)
+      munmap(sq_ring_, sq_ring_size_);
+    if (cq_ring_ != MAP_FAILED && cq_ring_ && cq_ring_ != sq_ring_)
+      munmap(cq_ring_, cq_ring_size_);
+    if (sqes_ != MAP_FAILED && sqes_)
+      munmap(sqes_, sqes_size_);
+    if (ring_fd_ >= 0)
+      close(ring_fd_);
+#endif
+  }
+
+  bool available() const {
+    return available_;
+  }
+
+  /**
+   * @brief Completes all the requests, submitting as many of them at once as the ring allows
+   */
+  void ReadAll(ReadRequest *reqs, int count) {
+    if (!available_) {
+      for (int i = 0; i < count; i++)
+        ReadWithPread(reqs[i]);
+      return;
+    }
+#if DALI_HAS_IO_URING
+    // indices of the requests not completed yet
+    std::vector<int> pending(count);
+    for (int i = 0; i < count; i++)
+      pending[i] = i;
+    while (!pending.empty()) {
+      int n = std::min<int>(pending.size(), sq_entries_);
+      for (int i = 0; i < n; i++)
+        Prepare(reqs[pending[i]], pending[i]);
+      Submit(n);
+      std::vector<int> resubmit(pending.begin() + n, pending.end());
+      for (int i = 0; i < n; i++) {
+        auto cqe = Reap();
+        auto &req = reqs[cqe.first];
+        int res = cqe.second;
+        if (res == -EINTR || res == -EAGAIN) {
+          resubmit.push_back(cqe.first);
+          continue;
+        }
+        DALI_ENFORCE(res >= 0, make_string("Read failed: ", std::strerror(-res)));
+        req.done += res;
+        // a short read which is not the end of the file - read the rest
+        if (res > 0 && req.done < req.min_length)
+          resubmit.push_back(cqe.first);
+      }
+      pending.swap(resubmit);
+    }
+#endif
+  }
+
+  /**
+   * @brief Aligned bounce buffers for O_DIRECT reads; registered with the ring, if possible
+   */
+  char *BounceBuffer(int idx) {
+    if (!bounce_buffers_) {
+      void *p = nullptr;
+      DALI_ENFORCE(posix_memalign(&p, kDirectAlignment, kChunkSize * kNumBounceBuffers) == 0,
+                   "Cannot allocate the buffers for O_DIRECT reads");
+      bounce_buffers_.reset(p);
+      RegisterBounceBuffers();
+    }
+    return static_cast<char *>(bounce_buffers_.get()) + idx * kChunkSize;
+  }
+
+  bool BounceBuffersRegistered() const {
+    return buffers_registered_;
+  }
+
+ private:
+#if DALI_HAS_IO_URING
+  bool Setup() {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = syscall(__NR_io_uring_setup, kQueueDepth, &params);
+    if (ring_fd_ < 0)
+      return false;
+    sq_entries_ = params.sq_entries;
+    iovecs_.resize(sq_entries_);
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap)
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+    sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED)
+      return false;
+    if (single_mmap) {
+      cq_ring_ = sq_ring_;
+    } else {
+      cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring_fd_, IORING_OFF_CQ_RING);
+      if (cq_ring_ == MAP_FAILED)
+        return false;
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                 ring_fd_, IORING_OFF_SQES);
+    if (sqes_ == MAP_FAILED)
+      return false;
+
+    auto *sq = static_cast<char *>(sq_ring_);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    auto *cq = static_cast<char *>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  void Prepare(const ReadRequest &req, int user_data) {
+    unsigned tail = *sq_tail_;
+    unsigned idx = tail & sq_mask_;
+    auto &sqe = static_cast<io_uring_sqe *>(sqes_)[idx];
+    memset(&sqe, 0, sizeof(sqe));
+    sqe.fd = req.fd;
+    sqe.off = req.offset + req.done;
+    sqe.user_data = user_data;
+    auto &iov = iovecs_[idx];
+    iov.iov_base = req.dst + req.done;
+    iov.iov_len = req.length - req.done;
+    if (req.buffer_index >= 0 && buffers_registered_) {
+      sqe.opcode = IORING_OP_READ_FIXED;
+      sqe.addr = reinterpret_cast<uint64_t>(iov.iov_base);
+      sqe.len = iov.iov_len;
+      sqe.buf_index = req.buffer_index;
+    } else {
+      sqe.opcode = IORING_OP_READV;
+      sqe.addr = reinterpret_cast<uint64_t>(&iov);
+      sqe.len = 1;
+    }
+    sq_array_[idx] = idx;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  }
+
+  void Submit(int n) {
+    int submitted = 0;
+    while (submitted < n) {
+      int ret = syscall(__NR_io_uring_enter, ring_fd_, n - submitted, 0, 0, nullptr, 0);
+      if (ret < 0 && errno == EINTR)
+        continue;
+      DALI_ENFORCE(ret >= 0, make_string("io_uring submission failed: ", std::strerror(errno)));
+      submitted += ret;
+    }
+  }
+
+  /// Returns (user_data, result) of a completed request, waiting for it if necessary
+  std::pair<int, int> Reap() {
+    for (;;) {
+      unsigned head = *cq_head_;
+      if (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+        auto &cqe = cqes_[head & cq_mask_];
+        std::pair<int, int> ret(static_cast<int>(cqe.user_data), cqe.res);
+        __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+        return ret;
+      }
+      int ret = syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+      DALI_ENFORCE(ret >= 0 || errno == EINTR,
+                   make_string("Waiting for io_uring completion failed: ", std::strerror(errno)));
+    }
+  }
+#endif
+
+  void RegisterBounceBuffers() {
+#if DALI_HAS_IO_URING
+    if (!available_)
+      return;
+    iovec iovs[kNumBounceBuffers];
+    for (int i = 0; i < kNumBounceBuffers; i++) {
+      iovs[i].iov_base = static_cast<char *>(bounce_buffers_.get()) + i * kChunkSize;
+      iovs[i].iov_len = kChunkSize;
+    }
+    // this can fail, e.g. due to RLIMIT_MEMLOCK - then the buffers are used without registering
+    buffers_registered_ = syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS,
+                                  iovs, kNumBounceBuffers) == 0;
+#endif
+  }
+
+  bool available_ = false;
+  bool buffers_registered_ = false;
+  std::unique_ptr<void, AlignedFree> bounce_buffers_;
+#if DALI_HAS_IO_URING
+  int ring_fd_ = -1;
+  unsigned sq_entries_ = 0;
+  void *sq_ring_ = nullptr, *cq_ring_ = nullptr, *sqes_ = nullptr;
+  size_t sq_ring_size_ = 0, cq_ring_size_ = 0, sqes_size_ = 0;
+  unsigned *sq_tail_ = nullptr, *sq_array_ = nullptr;
+  unsigned sq_mask_ = 0;
+  unsigned *cq_head_ = nullptr, *cq_tail_ = nullptr;
+  unsigned cq_mask_ = 0;
+  io_uring_cqe *cqes_ = nullptr;
+  // the vectors of the READV requests in flight, indexed like the submission queue entries
+  std::vector<iovec> iovecs_;
+#endif
+};
+
+IOUring &ThreadRing() {
+  static thread_local IOUring ring;
+  return ring;
+}
+
+}  // namespace
+
+bool IOUringFileStream::IsAvailable() {
+  return ThreadRing().available();
+}
+
+IOUringFileStream::IOUringFileStream(const std::string& path, bool o_direct,
+                                     const FileReadPolicy &policy)
+    : FileStream(path, policy) {
+  if (o_direct) {
+    fd_ = open(path.c_str(), O_RDONLY | O_DIRECT);
+    // not all the file systems support O_DIRECT
+    o_direct_ = fd_ >= 0;
+  }
+  if (fd_ < 0)
+    fd_ = open(path.c_str(), O_RDONLY);
+  DALI_ENFORCE(fd_ >= 0, "Could not open file " + path + ": " + std::strerror(errno));
+  struct stat sb;
+  DALI_ENFORCE(fstat(fd_, &sb) == 0, "Unable to stat file " + path + ": " + std::strerror(errno));
+  size_ = sb.st_size;
+  // with O_DIRECT, the page cache is not used
+  if (!o_direct_)
+    AdviseOpen(fd_);
+}
+
+void IOUringFileStream::Close() {
+  if (fd_ >= 0) {
+    if (!o_direct_)
+      AdviseClose(fd_);
+    close(fd_);
+    fd_ = -1;
+  }
+}
+
+shared_ptr<void> IOUringFileStream::Get(size_t /*n_bytes*/) {
+  // the data is not mapped - there's nothing to share
+  return {};
+}
+
+void IOUringFileStream::SeekRead(ptrdiff_t pos, int whence) {
+  if (whence == SEEK_CUR)
+    pos += pos_;
+  else if (whence == SEEK_END)
+    pos += size_;
+  else
+    DALI_ENFORCE(whence == SEEK_SET, "Invalid seek origin");
+  DALI_ENFORCE(pos >= 0 && pos <= static_cast<ptrdiff_t>(size_), "Invalid seek");
+  pos_ = pos;
+}
+
+ptrdiff_t IOUringFileStream::TellRead() const {
+  return pos_;
+}
+
+size_t IOUringFileStream::Size() const {
+  return size_;
+}
+
+size_t IOUringFileStream::Read(void *buffer, size_t n_bytes) {
+  n_bytes = std::min(n_bytes, size_ - pos_);
+  if (n_bytes == 0)
+    return 0;
+  auto &ring = ThreadRing();
+  auto *dst = static_cast<char *>(buffer);
+  size_t n_read = 0;
+
+  if (!o_direct_) {
+    std::vector<ReadRequest> reqs;
+    for (size_t offset = 0; offset < n_bytes; offset += kChunkSize) {
+      size_t length = std::min(kChunkSize, n_bytes - offset);
+      reqs.push_back({fd_, dst + offset, static_cast<int64_t>(pos_ + offset), length, length});
+    }
+    ring.ReadAll(reqs.data(), reqs.size());
+    for (auto &req : reqs) {
+      n_read += req.done;
+      if (req.done < req.length)
+        break;
+    }
+  } else {
+    // O_DIRECT requires aligned offsets, lengths and buffers - read whole aligned blocks
+    // to the bounce buffers and copy the requested part
+    size_t begin = pos_, end = pos_ + n_bytes;
+    size_t aligned_begin = begin & ~(kDirectAlignment - 1);
+    size_t aligned_end = (end + kDirectAlignment - 1) & ~(kDirectAlignment - 1);
+    ReadRequest reqs[kNumBounceBuffers];
+    bool eof = false;
+    for (size_t chunk = aligned_begin; chunk < aligned_end && !eof;
+         chunk += kChunkSize * kNumBounceBuffers) {
+      int nreqs = 0;
+      for (size_t offset = chunk; offset < aligned_end && nreqs < kNumBounceBuffers;
+           offset += kChunkSize, nreqs++) {
+        size_t length = std::min(kChunkSize, aligned_end - offset);
+        reqs[nreqs] = {fd_, ring.BounceBuffer(nreqs), static_cast<int64_t>(offset), length,
+                       std::min(length, size_ - offset),
+                       ring.BounceBuffersRegistered() ? nreqs : -1};
+      }
+      ring.ReadAll(reqs, nreqs);
+      for (int i = 0; i < nreqs && !eof; i++) {
+        size_t chunk_begin = reqs[i].offset, chunk_end = chunk_begin + reqs[i].done;
+        size_t copy_begin = std::max(chunk_begin, begin), copy_end = std::min(chunk_end, end);
+        if (copy_end > copy_begin) {
+          memcpy(dst + (copy_begin - begin), reqs[i].dst + (copy_begin - chunk_begin),
+                 copy_end - copy_begin);
+          n_read += copy_end - copy_begin;
+        }
+        eof = reqs[i].done < reqs[i].min_length;
+      }
+    }
+  }
+  if (!o_direct_)
+    AdviseRead(fd_, pos_, n_read);
+  pos_ += n_read;
+  return n_read;
+}
+
+}  // namespace dali
@@ -0,0 +1,69 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_IO_URING_FILE_H_
+#define DALI_UTIL_IO_URING_FILE_H_
+
+#include <cstdio>
+#include <string>
+#include <memory>
+
+#include "dali/core/common.h"
+#include "dali/util/file.h"
+
+namespace dali {
+
+/**
+ * @brief A file stream reading via io_uring
+ *
+ * A read is split into chunks which are all submitted to the ring at once, so a single thread
+ * keeps many requests in flight. Each thread uses its own ring.
+ *
+ * With `o_direct`, the file is opened with O_DIRECT (bypassing the page cache) and the data is
+ * read through aligned bounce buffers, registered with the ring when possible. If the file
+ * system doesn't support O_DIRECT, the file is opened normally.
+ *
+ * When io_uring is not available (an old kernel, a restricted container), the stream falls back
+ * to plain pread.
+ */
+class DLL_PUBLIC IOUringFileStream : public FileStream {
+ public:
+  explicit IOUringFileStream(const std::string& path, bool o_direct = false,
+                             const FileReadPolicy &policy = {});
+  void Close() override;
+  shared_ptr<void> Get(size_t n_bytes) override;
+  size_t Read(void *buffer, size_t n_bytes) override;
+  void SeekRead(ptrdiff_t pos, int whence = SEEK_SET) override;
+  ptrdiff_t TellRead() const override;
+  size_t Size() const override;
+
+  /**
+   * @brief Whether io_uring can be used by the calling thread
+   */
+  static bool IsAvailable();
+
+  ~IOUringFileStream() override {
+    Close();
+  }
+
+ private:
+  int fd_ = -1;
+  bool o_direct_ = false;
+  size_t size_ = 0;
+  size_t pos_ = 0;
+};
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_IO_URING_FILE_H_
@@ -0,0 +1,122 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dali/util/io_uring_file.h"
+
+namespace dali {
+
+namespace {
+
+class TempFile {
+ public:
+  explicit TempFile(const std::vector<char> &contents) {
+    char name[] = "/tmp/dali_io_uring_testXXXXXX";
+    int fd = mkstemp(name);
+    EXPECT_GE(fd, 0);
+    path_ = name;
+    EXPECT_EQ(write(fd, contents.data(), contents.size()),
+              static_cast<ssize_t>(contents.size()));
+    close(fd);
+  }
+
+  ~TempFile() {
+    unlink(path_.c_str());
+  }
+
+  const std::string &path() const {
+    return path_;
+  }
+
+ private:
+  std::string path_;
+};
+
+std::vector<char> RandomContents(size_t size) {
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> dist(0, 255);
+  std::vector<char> data(size);
+  for (auto &c : data)
+    c = dist(rng);
+  return data;
+}
+
+void TestReads(bool o_direct) {
+  // not a multiple of the chunk size nor of the O_DIRECT alignment
+  auto contents = RandomContents((3 << 20) + 1234);
+  TempFile file(contents);
+  IOUringFileStream stream(file.path(), o_direct);
+  ASSERT_EQ(stream.Size(), contents.size());
+
+  std::mt19937 rng(4321);
+  std::uniform_int_distribution<size_t> pos_dist(0, contents.size());
+  for (int i = 0; i < 20; i++) {
+    size_t pos = pos_dist(rng);
+    size_t n = i == 0 ? contents.size() : pos_dist(rng);
+    stream.SeekRead(pos);
+    std::vector<char> buf(n);
+    size_t expected = std::min(n, contents.size() - pos);
+    ASSERT_EQ(stream.Read(buf.data(), n), expected);
+    EXPECT_EQ(stream.TellRead(), static_cast<ptrdiff_t>(pos + expected));
+    for (size_t j = 0; j < expected; j++)
+      ASSERT_EQ(buf[j], contents[pos + j]) << "at " << pos + j;
+  }
+
+  stream.SeekRead(0, SEEK_END);
+  char c;
+  EXPECT_EQ(stream.Read(&c, 1), 0u);
+  stream.SeekRead(-10, SEEK_CUR);
+  EXPECT_EQ(stream.TellRead(), static_cast<ptrdiff_t>(contents.size() - 10));
+}
+
+}  // namespace
+
+TEST(IOUringFileStream, Read) {
+  TestReads(false);
+}
+
+TEST(IOUringFileStream, ReadODirect) {
+  TestReads(true);
+}
+
+TEST(IOUringFileStream, MultipleThreads) {
+  auto contents = RandomContents(1 << 20);
+  TempFile file(contents);
+  std::vector<std::thread> threads;
+  std::vector<int> ok(4, 0);
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t]() {
+      IOUringFileStream stream(file.path(), t % 2);
+      std::vector<char> buf(contents.size());
+      ok[t] = stream.Read(buf.data(), buf.size()) == contents.size() && buf == contents;
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  for (int t = 0; t < 4; t++)
+    EXPECT_TRUE(ok[t]) << "thread " << t;
+}
+
+TEST(IOUringFileStream, OpenError) {
+  EXPECT_THROW(IOUringFileStream("/this/file/does/not/exist"), std::exception);
+}
+
+}  // namespace dali
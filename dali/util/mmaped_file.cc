@@ -74,7 +74,8 @@ static int get_max_vm_cnt() {
   return vm_cnt;
 }
 
-static void *file_map(const char *path, size_t *length, bool read_ahead) {
+static void *file_map(const char *path, size_t *length, bool read_ahead,
+                      dali::FileReadPolicy::AccessPattern access_pattern) {
   int fd = -1;
   struct stat s;
   void *p = nullptr;
@@ -100,6 +101,13 @@ static void *file_map(const char *path, size_t *length, bool read_ahead) {
     goto fail;
   }
 
+#if !defined(__AARCH64_QNX__) && !defined(__AARCH64_GNU__) && !defined(__aarch64__)
+  if (access_pattern == dali::FileReadPolicy::AccessPattern::Sequential)
+    madvise(p, *length, MADV_SEQUENTIAL);
+  else if (access_pattern == dali::FileReadPolicy::AccessPattern::Random)
+    madvise(p, *length, MADV_RANDOM);
+#endif
+
 fail:
   if (p == nullptr) {
     DALI_FAIL("File mapping failed: " + path);
@@ -125,14 +133,16 @@ static unsigned int dali_reserved_mv_cnt = 0;
 std::mutex mapped_files_mutex;
 std::map<std::string, MappedFile> mapped_files;
 
-MmapedFileStream::MmapedFileStream(const std::string& path, bool read_ahead) :
-  FileStream(path), length_(0), pos_(0), read_ahead_whole_file_(read_ahead) {
+MmapedFileStream::MmapedFileStream(const std::string& path, bool read_ahead,
+                                   const FileReadPolicy &policy) :
+  FileStream(path, policy), length_(0), pos_(0), read_ahead_whole_file_(read_ahead) {
   std::lock_guard<std::mutex> lock(mapped_files_mutex);
   std::weak_ptr<void> mapped_memory;
   std::tie(mapped_memory, length_) = mapped_files[path];
 
   if (!(p_ = mapped_memory.lock())) {
-    void *p = file_map(path.c_str(), &length_, read_ahead_whole_file_);
+    // the mapping is shared by all the streams of the file - the first one sets the pattern
+    void *p = file_map(path.c_str(), &length_, read_ahead_whole_file_, policy_.access_pattern);
     size_t length_tmp = length_;
     p_ = shared_ptr<void>(p, [=](void*) {
       // we are not touching mapped_files, weak_ptr is enough to check if
@@ -157,16 +167,25 @@ void MmapedFileStream::Close() {
   pos_ = 0;
 }
 
-inline uint8_t* ReadAheadHelper(std::shared_ptr<void> &p, size_t &pos,
-                                 size_t &n_bytes, bool read_ahead) {
-  auto tmp = static_cast<uint8_t*>(p.get()) + pos;
+uint8_t* MmapedFileStream::ReadAhead(size_t n_bytes) {
+  auto base = static_cast<uint8_t*>(p_.get());
+  auto tmp = base + pos_;
   // Ask OS to load memory content to RAM to avoid sluggish page fault during actual access to
   // mmaped memory
-  if (read_ahead) {
 #if !defined(__AARCH64_QNX__) && !defined(__AARCH64_GNU__) && !defined(__aarch64__)
+  if (!read_ahead_whole_file_) {
     madvise(tmp, n_bytes, MADV_WILLNEED);
-#endif
+    // the window ahead of the current position, aligned down to the page, as madvise requires
+    int64_t from, length;
+    if (NextReadahead(pos_, n_bytes, from, length)) {
+      int64_t page = sysconf(_SC_PAGESIZE);
+      int64_t aligned_from = from & ~(page - 1);
+      int64_t end = std::min<int64_t>(from + length, length_);
+      if (end > aligned_from)
+        madvise(base + aligned_from, end - aligned_from, MADV_WILLNEED);
+    }
   }
+#endif
   return tmp;
 }
 
@@ -189,7 +208,7 @@ shared_ptr<void> MmapedFileStream::Get(size_t n_bytes) {
     return nullptr;
   }
   auto tmp = p_;
-  shared_ptr<void> p(ReadAheadHelper(p_, pos_, n_bytes, !read_ahead_whole_file_),
+  shared_ptr<void> p(ReadAhead(n_bytes),
     [tmp](void*) {
     // This is an empty lambda, which is a custom deleter for
     // std::shared_ptr.
@@ -206,7 +225,7 @@ shared_ptr<void> MmapedFileStream::Get(size_t n_bytes) {
 
 size_t MmapedFileStream::Read(void *buffer, size_t n_bytes) {
   n_bytes = std::min(n_bytes, length_ - pos_);
-  memcpy(buffer, ReadAheadHelper(p_, pos_, n_bytes, !read_ahead_whole_file_), n_bytes);
+  memcpy(buffer, ReadAhead(n_bytes), n_bytes);
   pos_ += n_bytes;
   return n_bytes;
 }
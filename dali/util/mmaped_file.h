@@ -26,7 +26,12 @@ namespace dali {
 
 class MmapedFileStream : public FileStream {
  public:
-  explicit MmapedFileStream(const std::string& path, bool read_ahead);
+  /**
+   * @param policy  the access pattern and the readahead window are applied to the mapping;
+   *                the pages are never dropped from the page cache, as the data returned
+   *                by Get references them
+   */
+  MmapedFileStream(const std::string& path, bool read_ahead, const FileReadPolicy &policy = {});
   void Close() override;
   shared_ptr<void> Get(size_t n_bytes) override;
   static bool ReserveFileMappings(unsigned int num);
@@ -41,6 +46,8 @@ class MmapedFileStream : public FileStream {
   }
 
  private:
+  uint8_t *ReadAhead(size_t n_bytes);
+
   std::shared_ptr<void> p_;
   size_t length_;
   size_t pos_;
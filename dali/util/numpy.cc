@@ -15,6 +15,7 @@
 #include "dali/util/numpy.h"
 #include <string>
 #include <vector>
+#include "dali/kernels/transpose/transpose.h"
 #include "dali/pipeline/data/types.h"
 #include "dali/pipeline/data/views.h"
 
@@ -23,7 +23,6 @@
 #include "dali/pipeline/data/backend.h"
 #include "dali/pipeline/data/tensor.h"
 #include "dali/core/static_switch.h"
-#include "dali/kernels/transpose/transpose.h"
 
 #define NUMPY_ALLOWED_TYPES \
   (bool, uint8_t, uint16_t, uint32_t, uint64_t, int8_t, int16_t, int32_t, int64_t, float, float16, \
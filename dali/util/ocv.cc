@@ -20,6 +20,7 @@
 #include <tuple>
 #include "dali/core/error_handling.h"
 #include "dali/kernels/imgproc/color_manipulation/color_space_conversion_impl.h"
+#include "dali/kernels/imgproc/color_manipulation/color_transform_cpu.h"
 
 namespace dali {
 
@@ -70,40 +71,6 @@ static cv::ColorConversionCodes GetOpenCvColorConversionCode(
 template <DALIImageType input_type, DALIImageType output_type>
 void custom_conversion_pixel(const uint8_t* input, uint8_t* output);
 
-template <>
-inline void custom_conversion_pixel<DALI_RGB, DALI_YCbCr>(const uint8_t* input, uint8_t* output) {
-  vec<3, uint8_t> rgb = {input[0], input[1], input[2]};
-  output[0] = kernels::color::itu_r_bt_601::rgb_to_y<uint8_t>(rgb);
-  output[1] = kernels::color::itu_r_bt_601::rgb_to_cb<uint8_t>(rgb);
-  output[2] = kernels::color::itu_r_bt_601::rgb_to_cr<uint8_t>(rgb);
-}
-
-template <>
-inline void custom_conversion_pixel<DALI_BGR, DALI_YCbCr>(const uint8_t* input, uint8_t* output) {
-  vec<3, uint8_t> rgb = {input[2], input[1], input[0]};
-  output[0] = kernels::color::itu_r_bt_601::rgb_to_y<uint8_t>(rgb);
-  output[1] = kernels::color::itu_r_bt_601::rgb_to_cb<uint8_t>(rgb);
-  output[2] = kernels::color::itu_r_bt_601::rgb_to_cr<uint8_t>(rgb);
-}
-
-template <>
-inline void custom_conversion_pixel<DALI_YCbCr, DALI_RGB>(const uint8_t* input, uint8_t* output) {
-  vec<3, uint8_t> ycbcr{input[0], input[1], input[2]};
-  auto rgb = kernels::color::itu_r_bt_601::ycbcr_to_rgb<uint8_t>(ycbcr);
-  output[0] = rgb[0];
-  output[1] = rgb[1];
-  output[2] = rgb[2];
-}
-
-template <>
-inline void custom_conversion_pixel<DALI_YCbCr, DALI_BGR>(const uint8_t* input, uint8_t* output) {
-  vec<3, uint8_t> ycbcr{input[0], input[1], input[2]};
-  auto rgb = kernels::color::itu_r_bt_601::ycbcr_to_rgb<uint8_t>(ycbcr);
-  output[0] = rgb[2];
-  output[1] = rgb[1];
-  output[2] = rgb[0];
-}
-
 template <>
 inline void custom_conversion_pixel<DALI_GRAY, DALI_YCbCr>(const uint8_t* input, uint8_t* output) {
   output[0] = kernels::color::itu_r_bt_601::gray_to_y<uint8_t>(input[0]);
@@ -128,6 +95,29 @@ inline void custom_conversion(const cv::Mat& img, cv::Mat& output_img) {
   }
 }
 
+namespace {
+
+// The conversions of kernels::color::itu_r_bt_601 between 8-bit RGB and YCbCr, expressed
+// as affine transforms, so that they can be vectorized
+const mat3 kRgbToYCbCr = {{{0.25678823529f, 0.50412941176f, 0.09790588235f},
+                           {-0.14822289945f, -0.29099278682f, 0.43921568627f},
+                           {0.43921568627f, -0.36778831435f, -0.07142737192f}}};
+const vec3 kYCbCrOffset(16, 128, 128);
+constexpr float kYScale = 255.0f / 219;
+// rgb = kYCbCrToRgb * (ycbcr - kYCbCrOffset)
+const mat3 kYCbCrToRgb = {{{kYScale, 0.0f, 1.5960267848f},
+                           {kYScale, -0.39176228842f, -0.81296764538f},
+                           {kYScale, 2.0172321417f, 0.0f}}};
+const mat3 kSwapRB = {{{0.f, 0.f, 1.f}, {0.f, 1.f, 0.f}, {1.f, 0.f, 0.f}}};
+
+inline void affine_conversion(const cv::Mat& img, cv::Mat& output_img,
+                              const mat3 &M, const vec3 &T) {
+  kernels::color::TransformPixels3(output_img.data, img.data,
+                                   static_cast<int64_t>(img.rows) * img.cols, M, T);
+}
+
+}  // namespace
+
 void OpenCvColorConversion(DALIImageType input_type, const cv::Mat& input_img,
                            DALIImageType output_type, cv::Mat& output_img) {
   DALI_ENFORCE(input_img.elemSize() == static_cast<size_t>(NumberOfChannels(input_type)),
@@ -151,16 +141,17 @@ void OpenCvColorConversion(DALIImageType input_type, const cv::Mat& input_img,
   const ColorConversionPair kYCbCrToGray { DALI_YCbCr, DALI_GRAY };
 
   if ( conversion == kRGBToYCbCr ) {
-    custom_conversion<DALI_RGB, DALI_YCbCr>(input_img, output_img);
+    affine_conversion(input_img, output_img, kRgbToYCbCr, kYCbCrOffset);
     return;
   } else if ( conversion == kBGRToYCbCr ) {
-    custom_conversion<DALI_BGR, DALI_YCbCr>(input_img, output_img);
+    affine_conversion(input_img, output_img, kRgbToYCbCr * kSwapRB, kYCbCrOffset);
     return;
   } else if ( conversion == kYCbCrToRGB ) {
-    custom_conversion<DALI_YCbCr, DALI_RGB>(input_img, output_img);
+    affine_conversion(input_img, output_img, kYCbCrToRgb, -(kYCbCrToRgb * kYCbCrOffset));
     return;
   } else if ( conversion == kYCbCrToBGR ) {
-    custom_conversion<DALI_YCbCr, DALI_BGR>(input_img, output_img);
+    mat3 M = kSwapRB * kYCbCrToRgb;
+    affine_conversion(input_img, output_img, M, -(M * kYCbCrOffset));
     return;
   } else if ( conversion == kGrayToYCbCr ) {
     custom_conversion<DALI_GRAY, DALI_YCbCr>(input_img, output_img);
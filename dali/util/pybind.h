@@ -218,6 +218,11 @@ py::list TensorListToDLPackView(TensorList<Backend> &tensors) {
   return result;
 }
 
+template <typename Backend>
+py::capsule TensorListValuesToDLPackView(TensorList<Backend> &tensors) {
+  return DLTensorToCapsule(GetDLTensorListValuesView(tensors));
+}
+
 static DLManagedTensor* DLMTensorRawPtrFromCapsule(py::capsule &capsule, bool consume = true) {
   DALI_ENFORCE(std::string(capsule.name()) == DLTENSOR_NAME,
       "Invalid DLPack tensor capsule. Notice that a dl tensor can be consumed only once");
@@ -0,0 +1,89 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cctype>
+#include <cstdlib>
+#include <string>
+
+#include "dali/core/error_handling.h"
+#include "dali/util/remote_uri.h"
+
+namespace dali {
+
+namespace {
+
+bool StartsWith(const std::string &str, const char *prefix) {
+  return str.compare(0, std::char_traits<char>::length(prefix), prefix) == 0;
+}
+
+std::string PercentEncode(const std::string &key) {
+  static const char hex[] = "0123456789ABCDEF";
+  std::string out;
+  out.reserve(key.size());
+  for (unsigned char c : key) {
+    if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~' || c == '/') {
+      out += c;
+    } else {
+      out += '%';
+      out += hex[c >> 4];
+      out += hex[c & 15];
+    }
+  }
+  return out;
+}
+
+/**
+ * @brief Splits `scheme://bucket/key` into the bucket and the key
+ */
+void SplitBucketUri(const std::string &uri, size_t scheme_len, std::string &bucket,
+                    std::string &key) {
+  auto slash = uri.find('/', scheme_len);
+  DALI_ENFORCE(slash != std::string::npos && slash > scheme_len && slash + 1 < uri.size(),
+               make_string("Invalid object URI: ", uri, ". Expected <scheme>://<bucket>/<key>"));
+  bucket = uri.substr(scheme_len, slash - scheme_len);
+  key = uri.substr(slash + 1);
+}
+
+}  // namespace
+
+bool IsRemoteUri(const std::string &uri) {
+  return StartsWith(uri, "s3://") || StartsWith(uri, "gs://") ||
+         StartsWith(uri, "http://") || StartsWith(uri, "https://");
+}
+
+std::string RemoteUriToUrl(const std::string &uri) {
+  std::string bucket, key;
+  if (StartsWith(uri, "s3://")) {
+    SplitBucketUri(uri, 5, bucket, key);
+    const char *endpoint = std::getenv("DALI_S3_ENDPOINT");
+    if (endpoint && *endpoint) {
+      std::string url = endpoint;
+      if (url.back() != '/')
+        url += '/';
+      return url + bucket + "/" + PercentEncode(key);
+    }
+    const char *region = std::getenv("AWS_REGION");
+    std::string host = region && *region ? make_string(bucket, ".s3.", region, ".amazonaws.com")
+                                         : bucket + ".s3.amazonaws.com";
+    return "https://" + host + "/" + PercentEncode(key);
+  } else if (StartsWith(uri, "gs://")) {
+    SplitBucketUri(uri, 5, bucket, key);
+    return "https://storage.googleapis.com/" + bucket + "/" + PercentEncode(key);
+  }
+  DALI_ENFORCE(StartsWith(uri, "http://") || StartsWith(uri, "https://"),
+               make_string("Not a remote URI: ", uri));
+  return uri;
+}
+
+}  // namespace dali
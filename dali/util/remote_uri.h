@@ -0,0 +1,47 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_UTIL_REMOTE_URI_H_
+#define DALI_UTIL_REMOTE_URI_H_
+
+#include <string>
+
+#include "dali/core/api_helper.h"
+
+namespace dali {
+
+/**
+ * @brief Whether the URI refers to an object in an object store or on an HTTP server
+ *
+ * The recognized schemes are `s3://`, `gs://`, `http://` and `https://`.
+ */
+DLL_PUBLIC bool IsRemoteUri(const std::string &uri);
+
+/**
+ * @brief Translates a remote URI into the HTTP(S) URL of the object
+ *
+ * `s3://bucket/key` becomes `https://bucket.s3.amazonaws.com/key`
+ * (`https://bucket.s3.<region>.amazonaws.com/key` when `AWS_REGION` is set). When the
+ * `DALI_S3_ENDPOINT` environment variable is set, the path-style
+ * `<endpoint>/bucket/key` is used instead, which works with S3-compatible servers.
+ *
+ * `gs://bucket/key` becomes `https://storage.googleapis.com/bucket/key`.
+ *
+ * The keys are percent-encoded. HTTP(S) URLs are returned as they are.
+ */
+DLL_PUBLIC std::string RemoteUriToUrl(const std::string &uri);
+
+}  // namespace dali
+
+#endif  // DALI_UTIL_REMOTE_URI_H_
@@ -0,0 +1,53 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include "dali/util/remote_uri.h"
+
+namespace dali {
+
+TEST(RemoteUri, IsRemote) {
+  EXPECT_TRUE(IsRemoteUri("s3://bucket/key"));
+  EXPECT_TRUE(IsRemoteUri("gs://bucket/key"));
+  EXPECT_TRUE(IsRemoteUri("http://host/path"));
+  EXPECT_TRUE(IsRemoteUri("https://host/path"));
+  EXPECT_FALSE(IsRemoteUri("/data/s3://file"));
+  EXPECT_FALSE(IsRemoteUri("file:///data/file"));
+  EXPECT_FALSE(IsRemoteUri("relative/path"));
+}
+
+TEST(RemoteUri, ToUrl) {
+  unsetenv("DALI_S3_ENDPOINT");
+  unsetenv("AWS_REGION");
+  EXPECT_EQ(RemoteUriToUrl("s3://bucket/dir/shard-0.tar"),
+            "https://bucket.s3.amazonaws.com/dir/shard-0.tar");
+  EXPECT_EQ(RemoteUriToUrl("gs://bucket/a b+c.tfrecord"),
+            "https://storage.googleapis.com/bucket/a%20b%2Bc.tfrecord");
+  EXPECT_EQ(RemoteUriToUrl("https://host/path?X-Amz-Signature=abc"),
+            "https://host/path?X-Amz-Signature=abc");
+
+  setenv("AWS_REGION", "us-west-2", 1);
+  EXPECT_EQ(RemoteUriToUrl("s3://bucket/key"), "https://bucket.s3.us-west-2.amazonaws.com/key");
+  setenv("DALI_S3_ENDPOINT", "http://localhost:9000", 1);
+  EXPECT_EQ(RemoteUriToUrl("s3://bucket/key"), "http://localhost:9000/bucket/key");
+  unsetenv("DALI_S3_ENDPOINT");
+  unsetenv("AWS_REGION");
+
+  EXPECT_THROW(RemoteUriToUrl("s3://bucket"), std::exception);
+  EXPECT_THROW(RemoteUriToUrl("s3://bucket/"), std::exception);
+  EXPECT_THROW(RemoteUriToUrl("/local/file"), std::exception);
+}
+
+}  // namespace dali
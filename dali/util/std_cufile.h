@@ -42,6 +42,10 @@ class StdCUFileStream : public CUFileStream {
   void HandleIOError(int64 ret) const;
   size_t Size() const override;
 
+  const cufile::CUFileHandle &Handle() const override {
+    return f_;
+  }
+
   ~StdCUFileStream() override {
     Close();
   }
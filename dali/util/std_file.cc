@@ -24,13 +24,16 @@
 
 namespace dali {
 
-StdFileStream::StdFileStream(const std::string& path) : FileStream(path) {
+StdFileStream::StdFileStream(const std::string& path, const FileReadPolicy &policy)
+    : FileStream(path, policy) {
   fp_ = std::fopen(path.c_str(), "rb");
   DALI_ENFORCE(fp_ != nullptr, "Could not open file " + path + ": " + std::strerror(errno));
+  AdviseOpen(fileno(fp_));
 }
 
 void StdFileStream::Close() {
   if (fp_ != nullptr) {
+    AdviseClose(fileno(fp_));
     std::fclose(fp_);
     fp_ = nullptr;
   }
@@ -46,7 +49,9 @@ ptrdiff_t StdFileStream::TellRead() const {
 }
 
 size_t StdFileStream::Read(void *buffer, size_t n_bytes) {
+  int64_t offset = std::ftell(fp_);
   size_t n_read = std::fread(buffer, 1, n_bytes, fp_);
+  AdviseRead(fileno(fp_), offset, n_read);
   return n_read;
 }
 
@@ -26,7 +26,7 @@ namespace dali {
 
 class StdFileStream : public FileStream {
  public:
-  explicit StdFileStream(const std::string& path);
+  explicit StdFileStream(const std::string& path, const FileReadPolicy &policy = {});
   void Close() override;
   shared_ptr<void>  Get(size_t n_bytes) override;
   size_t Read(void * buffer, size_t n_bytes) override;
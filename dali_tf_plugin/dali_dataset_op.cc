@@ -299,8 +299,12 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
 
   Status CheckOutputDevices() {
     auto num_outputs = daliGetNumOutput(&pipeline_handle_);
+    stream_ordered_outputs_ = dataset()->device_type_ == device_type_t::GPU;
     for (auto i = 0; i < num_outputs; ++i) {
       auto dali_device_type = daliGetOutputDevice(&pipeline_handle_, i);
+      // the CPU outputs are overwritten by the CPU stage, which doesn't wait for the streams
+      if (dali_device_type != device_type_t::GPU)
+        stream_ordered_outputs_ = false;
 
       if (dali_device_type != dataset()->device_type_) {
         auto msg = dali::make_string(
@@ -554,7 +558,14 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
    */
   Status ProduceOutputs(IteratorContext *context, std::vector<Tensor> *out_tensors,
                         bool &end_of_sequence) {
-    TF_DALI_CALL(daliShareOutput(&pipeline_handle_));
+    // With the GPU placement and outputs, the outputs are handed over in the order of
+    // dataset()->stream_: the copies wait for the pipeline there and the pipeline doesn't
+    // overwrite the buffers before the copies are done - neither needs a host synchronization.
+    if (stream_ordered_outputs_) {
+      TF_DALI_CALL(daliShareOutputAsync(&pipeline_handle_, dataset()->stream_));
+    } else {
+      TF_DALI_CALL(daliShareOutput(&pipeline_handle_));
+    }
 
     auto num_outputs = 0;
     TF_DALI_CALL(num_outputs = daliGetNumOutput(&pipeline_handle_));
@@ -652,11 +663,12 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
               std::to_string(out_id));
       }
 
-      // Synchronize with the dataset()->stream_ when doing the last copy, so the outputs
-      // are fully finished before we release the output buffers for reuse.
+      // If the outputs are not stream-ordered, synchronize with the dataset()->stream_ when doing
+      // the last copy, so the outputs are fully finished before we release the output buffers
+      // for reuse.
       // if the OP runs on the CPU the output memory is not pinned and we don't need to sync
       unsigned int wait_flag = dataset()->device_type_ != device_type_t::CPU &&
-                               (out_id == num_outputs - 1) ?
+                               !stream_ordered_outputs_ && (out_id == num_outputs - 1) ?
                                   DALI_ext_force_sync :
                                   DALI_ext_default;
 
@@ -666,7 +678,11 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
 
     end_of_sequence = false;
 
-    TF_DALI_CALL(daliOutputRelease(&pipeline_handle_));
+    if (stream_ordered_outputs_) {
+      TF_DALI_CALL(daliOutputReleaseAsync(&pipeline_handle_, dataset()->stream_));
+    } else {
+      TF_DALI_CALL(daliOutputRelease(&pipeline_handle_));
+    }
     return Status::OK();
   }
 
@@ -875,6 +891,8 @@ class DALIDatasetOp::Dataset::Iterator : public DatasetIterator<Dataset> {
   InputState iterator_state_ = InputState::in_progress;
   daliPipelineHandle pipeline_handle_;
   bool enable_memory_stats_;
+  // all the outputs are on the GPU and are shared and released in the order of Dataset's stream
+  bool stream_ordered_outputs_ = false;
 };
 
 void DALIDatasetOp::MakeDataset(OpKernelContext *context, DatasetBase **output) {
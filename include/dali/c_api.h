@@ -48,6 +48,18 @@ typedef enum {
   DALI_BACKEND_MIXED = 2
 } dali_backend_t;
 
+/*
+ * Need to keep that in sync with Bottleneck from bottleneck_analyzer.h
+ */
+typedef enum {
+  DALI_BOTTLENECK_UNKNOWN = 0,
+  DALI_BOTTLENECK_CONSUMER = 1,
+  DALI_BOTTLENECK_IO = 2,
+  DALI_BOTTLENECK_CPU = 3,
+  DALI_BOTTLENECK_MIXED = 4,
+  DALI_BOTTLENECK_GPU = 5
+} dali_bottleneck_t;
+
 typedef enum {
   DALI_NO_TYPE  = -1,
   DALI_UINT8    =  0,
@@ -62,9 +74,27 @@ typedef enum {
   DALI_FLOAT    =  9,
   DALI_FLOAT64  =  10,
   DALI_BOOL     =  11,
+  DALI_BFLOAT16 =  27,
 } dali_data_type_t;
 
 
+/**
+ * @brief Description of a pipeline output, filled by `daliGetOutputDescs`.
+ *
+ * The pointers are valid until the output is released.
+ */
+typedef struct {
+  device_type_t device;    // device where the output is stored
+  dali_data_type_t dtype;  // type of the elements
+  int num_samples;         // number of samples in the batch
+  int ndim;                // number of dimensions of a sample
+  const int64_t *shape;    // num_samples * ndim extents of the consecutive samples
+  char layout[16];         // null-terminated layout, empty if not set
+  const void *data;        // contiguous data of the batch
+  size_t nbytes;           // size of the data, in bytes
+  cudaEvent_t ready_event;  // recorded when the output is computed, NULL for the CPU outputs
+} daliOutputDesc;
+
 /*
  * Need to keep that in sync with ReaderMeta from operator.h
  */
@@ -78,6 +108,22 @@ typedef struct {
 } daliReaderMetadata;
 
 
+#define DALI_TIME_HISTOGRAM_BUCKETS 32
+
+/*
+ * Need to keep that in sync with TimeHistogram from executor_stats.h
+ *
+ * Bucket 0 counts the durations shorter than 1 us, bucket i > 0 the durations in
+ * [2^(i-1), 2^i) us; the last bucket also counts all the longer durations.
+ */
+typedef struct {
+  int64_t count;
+  int64_t total_ns;
+  int64_t min_ns;
+  int64_t max_ns;
+  int64_t buckets[DALI_TIME_HISTOGRAM_BUCKETS];
+} daliTimeHistogram;
+
 /*
  * Need to keep that in sync with ExecutorMeta from executor.h
  */
@@ -88,8 +134,38 @@ typedef struct {
   size_t *max_real_size;       // the biggest size of the tensor in the batch
   size_t *reserved;            // reserved size of the operator output, user need to free the memory
   size_t *max_reserved;        // the biggest reserved memory size for the tensor in the batch
+  daliTimeHistogram host_time;  // wall time of running the operator, if timing stats are enabled
+  daliTimeHistogram gpu_time;   // time between CUDA events recorded around mixed and GPU operators
+  double critical_path_share;   // share in the time of the bottleneck stage, if analysis enabled
 } daliExecutorMetadata;
 
+/*
+ * Need to keep that in sync with StageTimingStats from executor_stats.h
+ */
+typedef struct {
+  daliTimeHistogram queue_wait;     // time spent waiting for the buffers
+  daliTimeHistogram run_time;       // wall time of running (issuing the work of) the stage
+  int64_t thread_pool_busy_ns;      // time spent by the CPU threads executing the operators
+  int64_t thread_pool_capacity_ns;  // number of CPU threads * run time of the CPU stage
+} daliExecutorStageStatistics;
+
+/*
+ * Need to keep that in sync with BottleneckReport from bottleneck_analyzer.h
+ *
+ * The stage arrays hold the values for the CPU, mixed and GPU stages, respectively.
+ */
+typedef struct {
+  dali_bottleneck_t verdict;       // the part of the pipeline limiting the throughput
+  int64_t iterations;              // number of iterations the report is based on
+  double window_s;                 // duration of the window the report is based on
+  double consumer_wait_fraction;   // part of the window the consumer waited for the outputs
+  double ready_outputs;            // average number of ready outputs when one was requested
+  double thread_pool_utilization;  // part of the capacity of the CPU threads spent working
+  double io_fraction;              // share of the readers in the time of the CPU operators
+  double stage_time_s[3];          // time of a stage per iteration (max of host and GPU time)
+  double stage_wait_fraction[3];   // part of the window a stage waited for the buffers
+} daliBottleneckReport;
+
 /**
  * @brief DALI initialization
  *
@@ -359,6 +435,20 @@ DLL_PUBLIC int daliGetExternalInputNdim(daliPipelineHandle *pipe_handle, const c
  */
 DLL_PUBLIC void daliRun(daliPipelineHandle *pipe_handle);
 
+/**
+ * @brief Start the execution of the pipeline and return the id of the scheduled iteration.
+ *
+ * The iterations are numbered consecutively from 0 in the order they are scheduled - including
+ * the ones scheduled by daliPrefetchUniform/daliPrefetchSeparate. The id can be used to obtain
+ * the outputs of the iteration with daliOutputOfIteration.
+ */
+DLL_PUBLIC int64_t daliRunWithId(daliPipelineHandle *pipe_handle);
+
+/**
+ * @brief Returns the number of iterations scheduled so far (the id of the next iteration).
+ */
+DLL_PUBLIC int64_t daliGetScheduledIterations(daliPipelineHandle *pipe_handle);
+
 /**
  * @brief Schedule first runs to fill buffers for Executor with UniformQueue policy.
  */
@@ -387,6 +477,40 @@ DLL_PUBLIC void daliShareOutput(daliPipelineHandle *pipe_handle);
  */
 DLL_PUBLIC void daliOutputRelease(daliPipelineHandle *pipe_handle);
 
+/**
+ * @brief Wait until the output of the given iteration is ready and make it available
+ * in the pipeline handle.
+ *
+ * The iterations are computed in order, but their outputs can be obtained in any order -
+ * the outputs of the earlier iterations, not obtained yet, are copied out and kept until
+ * requested, so that a slow consumer of one iteration doesn't stall the pipeline.
+ * The outputs of each iteration can be obtained only once. The returned outputs are owned
+ * by the handle, so daliOutputRelease must not be called for them. Don't mix this function
+ * with daliOutput and daliShareOutput.
+ *
+ * @param pipe_handle Pointer to pipeline handle.
+ * @param iteration The id of the iteration, as returned by daliRunWithId.
+ */
+DLL_PUBLIC void daliOutputOfIteration(daliPipelineHandle *pipe_handle, int64_t iteration);
+
+/**
+ * @brief Makes the output of the pipeline available for the work scheduled on `stream`.
+ * Doesn't release previously returned buffers.
+ *
+ * The host waits only until the output is scheduled - the GPU outputs are ready for the work
+ * scheduled on `stream` after the call, but can be still being computed.
+ */
+DLL_PUBLIC void daliShareOutputAsync(daliPipelineHandle *pipe_handle, cudaStream_t stream);
+
+/**
+ * @brief Releases buffer returned by last daliShareOutputAsync (or daliShareOutput) call,
+ *        which can be still in use by the work scheduled on `stream`.
+ *
+ * The pipeline doesn't overwrite the buffer before the work scheduled on `stream` so far
+ * completes. The host doesn't wait.
+ */
+DLL_PUBLIC void daliOutputReleaseAsync(daliPipelineHandle *pipe_handle, cudaStream_t stream);
+
 /**
  * @brief Returns 1 if the the output batch stored at position `n` in the pipeline can
  * be represented as dense, uniform tensor. Otherwise 0.
@@ -483,6 +607,14 @@ DLL_PUBLIC const char *daliGetOutputName(daliPipelineHandle *pipe_handle, int id
  */
 DLL_PUBLIC device_type_t daliGetOutputDevice(daliPipelineHandle *pipe_handle, int id);
 
+/**
+ * @brief Returns the pointer to the data of the output batch stored at position `output_idx`
+ *        in the pipeline.
+ *
+ * The output must be stored contiguously. The pointer is valid until the output is released.
+ */
+DLL_PUBLIC const void *daliOutputRawData(daliPipelineHandle *pipe_handle, int output_idx);
+
 /**
  * @brief Copy the output batch stored at position `output_idx` in the pipeline.
  * @remarks If the pipeline output is TensorList then it needs to be dense
@@ -498,6 +630,43 @@ DLL_PUBLIC void
 daliOutputCopy(daliPipelineHandle *pipe_handle, void *dst, int output_idx, device_type_t dst_type,
                cudaStream_t stream, unsigned int flags);
 
+/**
+ * @brief Describes all the outputs of the pipeline, obtained with daliShareOutput
+ *        or daliShareOutputAsync, at once.
+ * @param descs Array of daliGetNumOutput(pipe_handle) descriptors to fill.
+ *
+ * Doesn't allocate any memory - the descriptors point to the output buffers.
+ */
+DLL_PUBLIC void daliGetOutputDescs(daliPipelineHandle *pipe_handle, daliOutputDesc *descs);
+
+/**
+ * @brief Fills the offsets of the samples of the output stored at position `output_idx`,
+ *        in elements, relative to the beginning of its data.
+ * @param offsets Array of num_samples + 1 values to fill; the last one is the total number
+ *        of elements.
+ *
+ * The outputs are stored contiguously, with the samples back to back, so the data of the
+ * output (see daliOutputRawData and daliGetOutputDescs) and these offsets describe a ragged
+ * (variable-length) batch in a CSR-like way, without any padding: the sample `i` occupies
+ * the elements from `offsets[i]` to `offsets[i + 1]`.
+ */
+DLL_PUBLIC void daliOutputSampleOffsets(daliPipelineHandle *pipe_handle, int output_idx,
+                                        int64_t *offsets);
+
+/**
+ * @brief Copy all the outputs of the pipeline in a single stream-ordered operation.
+ * @param pipe_handle Pointer to pipeline handle
+ * @param dsts Pointers to the destination buffers, one per output, in the order of the outputs.
+ *        A nullptr dst pointer will skip the output.
+ * @param dst_type Device type associated with the destination buffers (0 - CPU, 1 - GPU)
+ * @param stream CUDA stream to use when copying the data to/from the GPU.
+ * @param flags Extra flags, check DALI_ext_force_sync, DALI_ext_pinned, DALI_use_copy_kernel.
+ *        With DALI_ext_force_sync, the host waits once, after all the copies are issued.
+ */
+DLL_PUBLIC void daliOutputCopyAll(daliPipelineHandle *pipe_handle, void **dsts,
+                                  device_type_t dst_type, cudaStream_t stream,
+                                  unsigned int flags);
+
 /**
  * @brief Copy the samples in output stored at position `output_idx` in the pipeline
  *        to scattered memory locations.
@@ -545,6 +714,53 @@ DLL_PUBLIC void daliLoadLibrary(const char *lib_path);
 DLL_PUBLIC void daliGetReaderMetadata(daliPipelineHandle* pipe_handle, const char *reader_name,
                                       daliReaderMetadata* meta);
 
+/**
+ * @brief Returns the state of the named reader, as of the outputs returned so far
+ *
+ * The reader needs `enable_checkpointing` set.
+ *  @param reader_name Name of the reader to query
+ *  @param state Pointer to be set to the state (binary data)
+ *  @param size Pointer to be set to the size of the state
+ * @remarks Caller is responsible to 'free' the memory returned
+ */
+DLL_PUBLIC void daliGetReaderState(daliPipelineHandle* pipe_handle, const char *reader_name,
+                                   char **state, size_t *size);
+
+/**
+ * @brief Returns the current values of the DALI metrics (of the whole process) in
+ *        the Prometheus text exposition format
+ *
+ *  @param text Pointer to be set to the null-terminated text
+ *  @param size Pointer to be set to the length of the text; can be NULL
+ * @remarks Caller is responsible to 'free' the memory returned
+ */
+DLL_PUBLIC void daliGetMetrics(char **text, size_t *size);
+
+/**
+ * @brief Restores the state of the named reader, returned by daliGetReaderState
+ *
+ * Must be called after the pipeline is built and before it's run.
+ *  @param reader_name Name of the reader
+ *  @param state The state
+ *  @param size The size of the state
+ */
+DLL_PUBLIC void daliRestoreReaderState(daliPipelineHandle* pipe_handle, const char *reader_name,
+                                       const char *state, size_t size);
+
+/**
+ * @brief Changes the sharding of the dataset read by the named reader, e.g. when the number
+ *        of workers of an elastic training changes
+ *
+ *  @param reader_name Name of the reader
+ *  @param num_shards The new number of shards
+ *  @param shard_id The new shard of this reader
+ *  @param at_sample The number of samples of the current part of the epoch read by each of
+ *                   the shards before the new sharding is used; -1 means the whole part,
+ *                   i.e. the new sharding starts with the next epoch
+ */
+DLL_PUBLIC void daliReshardReader(daliPipelineHandle* pipe_handle, const char *reader_name,
+                                  int num_shards, int shard_id, int64_t at_sample);
+
 /**
  * @brief Returns the backend of the operator with a given \p operator_name
  * @param operator_name Name of the operator to query
@@ -564,6 +780,45 @@ DLL_PUBLIC void daliGetExecutorMetadata(daliPipelineHandle* pipe_handle,
                                         daliExecutorMetadata **operator_meta,
                                         size_t *operator_meta_num);
 
+/**
+ * @brief Enables gathering the execution time statistics, reported by `daliGetExecutorMetadata`
+ *        and `daliGetExecutorStageStatistics`.
+ */
+DLL_PUBLIC void daliEnableExecutorTimingStats(daliPipelineHandle* pipe_handle, int enable);
+
+/**
+ * @brief Obtains the execution time statistics of the executor stages
+ *  @param stage_stats Pointer to an array of 3 elements, to be filled with the statistics
+ *                     of the CPU, mixed and GPU stages, respectively
+ */
+DLL_PUBLIC void daliGetExecutorStageStatistics(daliPipelineHandle* pipe_handle,
+                                               daliExecutorStageStatistics *stage_stats);
+
+/**
+ * @brief Enables the periodic analysis of the part of the pipeline which limits
+ *        the throughput; enables the timing statistics.
+ *  @param interval_s The interval between the updates of the report, in seconds;
+ *                    non-positive value disables the analysis
+ */
+DLL_PUBLIC void daliEnableBottleneckAnalysis(daliPipelineHandle* pipe_handle, double interval_s);
+
+/**
+ * @brief Obtains the latest report of the bottleneck analysis. The contribution of
+ *        the operators is reported in `critical_path_share` by `daliGetExecutorMetadata`.
+ */
+DLL_PUBLIC void daliGetBottleneckReport(daliPipelineHandle* pipe_handle,
+                                        daliBottleneckReport *report);
+
+/**
+ * @brief Obtains the number of buffers currently used by the executor for the CPU
+ *        and for the mixed and GPU stages. The numbers change over time only if the pipeline
+ *        uses adaptive prefetch queue depth.
+ *  @param cpu_size Pointer to the variable which receives the CPU stage queue depth
+ *  @param gpu_size Pointer to the variable which receives the mixed and GPU stages queue depth
+ */
+DLL_PUBLIC void daliGetCurrentQueueSizes(daliPipelineHandle* pipe_handle, int *cpu_size,
+                                         int *gpu_size);
+
 /**
  * @brief Frees executor metadata obtained from daliGetExecutorMetadata
  *  @param operator_meta Pointer to the memory with metadata allocated by the
@@ -573,6 +828,79 @@ DLL_PUBLIC void daliGetExecutorMetadata(daliPipelineHandle* pipe_handle,
 DLL_PUBLIC void daliFreeExecutorMetadata(daliExecutorMetadata *operator_meta,
                                          size_t operator_meta_num);
 
+/**
+ * @brief Stream-ordered device memory allocation and deallocation functions.
+ *
+ * The signatures match the ones used by the pluggable allocator interfaces of the frameworks
+ * (e.g. `torch.cuda.memory.CUDAPluggableAllocator`).
+ * The allocation function returns NULL if it is out of memory.
+ */
+typedef void *(*daliDeviceAllocFn)(size_t size, int device_id, cudaStream_t stream);
+typedef void (*daliDeviceFreeFn)(void *ptr, size_t size, int device_id, cudaStream_t stream);
+
+/**
+ * @brief Makes DALI allocate the device memory of the given device with an external allocator,
+ *        e.g. the caching allocator of a framework, so that a single pool serves both.
+ *
+ * Passing NULL functions restores the default DALI memory pool.
+ *  @param device_id Device index; if negative, current device is used
+ *  @remarks Call this function before DALI allocates any device memory on the device.
+ *           Don't combine it with using @see daliDeviceAlloc as the framework's allocator.
+ */
+DLL_PUBLIC void daliSetDeviceAllocator(int device_id, daliDeviceAllocFn alloc_fn,
+                                       daliDeviceFreeFn free_fn);
+
+/**
+ * @brief Allocates device memory from the DALI's default device memory resource
+ *        in a stream-ordered fashion.
+ *
+ * This function (along with @see daliDeviceFree) can be used as the allocator of a framework,
+ * so that DALI and the framework allocate from a single pool. The memory is aligned to at least
+ * 256 bytes.
+ *  @return Pointer to the allocated memory or NULL if out of memory
+ */
+DLL_PUBLIC void *daliDeviceAlloc(size_t size, int device_id, cudaStream_t stream);
+
+/**
+ * @brief Frees the memory allocated with @see daliDeviceAlloc on the given stream.
+ *
+ * The memory can be reused by the work submitted to `stream` immediately and by the work
+ * submitted to other streams after the work currently pending on `stream` completes.
+ *  @param size The size passed to `daliDeviceAlloc`
+ *  @param device_id The device_id passed to `daliDeviceAlloc`
+ */
+DLL_PUBLIC void daliDeviceFree(void *ptr, size_t size, int device_id, cudaStream_t stream);
+
+/**
+ * @brief Returns the memory held, but not used, by the DALI's default memory pools
+ *        to the system.
+ *
+ * Waits for the pending stream-ordered deallocations and releases the free memory of the default
+ * device and pinned memory pools - e.g. between the epochs or before an evaluation phase, so that
+ * the memory can be used by the framework.
+ *  @return The number of bytes released
+ */
+DLL_PUBLIC size_t daliReleaseUnusedMemory();
+
+/**
+ * @brief Sums a device buffer of doubles, in place, across the devices of a group,
+ *        e.g. with `ncclAllReduce`. The work must be enqueued on `stream`.
+ */
+typedef void (*daliCrossDeviceSumFn)(double *data, size_t count, cudaStream_t stream,
+                                     void *user_data);
+
+/**
+ * @brief Registers the reduction across the devices of the named group, used by the operators
+ *        which combine the statistics of the whole data-parallel batch
+ *        (e.g. Normalize with `batch=True` and `cross_device_group`).
+ *
+ * DALI doesn't manage the communication between the devices - the framework supplies it.
+ * Passing NULL as `sum_fn` removes the registration.
+ *  @param user_data Passed to `sum_fn`, e.g. the NCCL communicator
+ */
+DLL_PUBLIC void daliSetCrossDeviceSum(const char *group, daliCrossDeviceSumFn sum_fn,
+                                      void *user_data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,105 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_BFLOAT16_H_
+#define DALI_CORE_BFLOAT16_H_
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "dali/core/float16.h"
+#include "dali/core/force_inline.h"
+#include "dali/core/host_dev.h"
+
+namespace dali {
+
+/**
+ * @brief Brain floating point type (bfloat16) usable in host and device code
+ *
+ * bfloat16 has the exponent range of float (8 bits) and only 8 bits of precision - it's
+ * the upper half of an IEEE float. It is a storage type: the values are implicitly converted
+ * to float and all the arithmetic is done in float. The conversion from float rounds to
+ * the nearest value, ties to even, and keeps NaNs as (quiet) NaNs.
+ */
+struct bfloat16 {
+  bfloat16() = default;
+  bfloat16(const bfloat16 &) = default;
+
+  template <typename T, typename = std::enable_if_t<std::is_arithmetic<T>::value>>
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16(T x)  // NOLINT
+  : bits(from_float(static_cast<float>(x))) {}
+
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16(float16 x)  // NOLINT
+  : bits(from_float(static_cast<float>(x))) {}
+
+  DALI_HOST_DEV DALI_FORCEINLINE operator float() const noexcept {
+    return to_float(bits);
+  }
+
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16 operator-() const noexcept {
+    return from_bits(bits ^ 0x8000u);
+  }
+
+  DALI_HOST_DEV DALI_FORCEINLINE bfloat16 operator+() const noexcept {
+    return *this;
+  }
+
+  /**
+   * @brief Creates a bfloat16 with given binary representation
+   */
+  DALI_HOST_DEV DALI_FORCEINLINE static bfloat16 from_bits(uint16_t bits) noexcept {
+    bfloat16 ret;
+    ret.bits = bits;
+    return ret;
+  }
+
+  DALI_HOST_DEV DALI_FORCEINLINE static uint16_t from_float(float f) noexcept {
+    uint32_t u;
+#ifdef __CUDA_ARCH__
+    u = __float_as_uint(f);
+#else
+    std::memcpy(&u, &f, sizeof(u));
+#endif
+    if ((u & 0x7fffffffu) > 0x7f800000u)  // NaN - the payload could be truncated to zero
+      return (u >> 16) | 0x40u;
+    u += 0x7fffu + ((u >> 16) & 1);  // round to nearest, ties to even
+    return u >> 16;
+  }
+
+  DALI_HOST_DEV DALI_FORCEINLINE static float to_float(uint16_t bits) noexcept {
+    uint32_t u = static_cast<uint32_t>(bits) << 16;
+#ifdef __CUDA_ARCH__
+    return __uint_as_float(u);
+#else
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+#endif
+  }
+
+  uint16_t bits;
+};
+
+static_assert(sizeof(bfloat16) == 2 && std::is_trivially_copyable<bfloat16>::value,
+              "bfloat16 must be a 16-bit trivially copyable type");
+
+template <>
+struct is_arithmetic_or_half<bfloat16> : std::true_type {};
+
+template <>
+struct is_fp_or_half<bfloat16> : std::true_type {};
+
+}  // namespace dali
+
+#endif  // DALI_CORE_BFLOAT16_H_
@@ -23,6 +23,9 @@ namespace dali {
 
 /**
  * @brief A vector of bits with a utility for quickly searching for set/cleared bits.
+ *
+ * The bit `i` is stored in the word `word_idx(i)` at the position `bit_idx(i)` (counting from
+ * the LSB); the index helpers can be used in device code to work with the same layout on the GPU.
  */
 class bitmask {
  public:
@@ -31,11 +34,11 @@ class bitmask {
   static constexpr const int storage_bits = sizeof(bit_storage_t) * 8;
   static constexpr const int storage_bits_log = ilog2(storage_bits);
 
-  static constexpr int bit_idx(ptrdiff_t idx) {
+  DALI_HOST_DEV static constexpr int bit_idx(ptrdiff_t idx) {
     return idx & (storage_bits - 1);
   }
 
-  static constexpr ptrdiff_t word_idx(ptrdiff_t idx) {
+  DALI_HOST_DEV static constexpr ptrdiff_t word_idx(ptrdiff_t idx) {
     return idx >> storage_bits_log;
   }
 
@@ -74,6 +77,16 @@ class bitmask {
     return size_;
   }
 
+  /**
+   * @brief Counts the bits with given value
+   */
+  ptrdiff_t count(bool value = true) const {
+    ptrdiff_t ones = 0;
+    for (auto word : storage_)
+      ones += __builtin_popcountll(word);
+    return value ? ones : size_ - ones;
+  }
+
   /**
    * @brief Fill a range of bits with given value
    */
@@ -20,6 +20,7 @@
 #include <limits>
 #include <type_traits>
 #include "dali/core/host_dev.h"
+#include "dali/core/bfloat16.h"
 #include "dali/core/float16.h"
 
 namespace dali {
@@ -401,6 +402,65 @@ struct Converter<T, T> {
   constexpr T ConvertSatNorm(T value) { return value; }
 };
 
+DALI_HOST_DEV inline bfloat16 SaturateToBFloat16(float value) {
+  constexpr float bf16_max = 3.38953139e38f;  // the largest finite bfloat16
+  return bfloat16(value < -bf16_max ? -bf16_max : value > bf16_max ? bf16_max : value);
+}
+
+/// Converts to bfloat16 through float
+template <typename In>
+struct Converter<bfloat16, In> {
+  static DALI_HOST_DEV
+  constexpr bfloat16 Convert(In value) { return Converter<float, In>::Convert(value); }
+
+  static DALI_HOST_DEV
+  constexpr bfloat16 ConvertSat(In value) {
+    return SaturateToBFloat16(Converter<float, In>::ConvertSat(value));
+  }
+
+  static DALI_HOST_DEV
+  constexpr bfloat16 ConvertNorm(In value) { return Converter<float, In>::ConvertNorm(value); }
+
+  static DALI_HOST_DEV
+  constexpr bfloat16 ConvertSatNorm(In value) {
+    return SaturateToBFloat16(Converter<float, In>::ConvertSatNorm(value));
+  }
+};
+
+/// Converts from bfloat16 through float
+template <typename Out>
+struct Converter<Out, bfloat16> {
+  static DALI_HOST_DEV
+  constexpr Out Convert(bfloat16 value) { return Converter<Out, float>::Convert(value); }
+
+  static DALI_HOST_DEV
+  constexpr Out ConvertSat(bfloat16 value) { return Converter<Out, float>::ConvertSat(value); }
+
+  static DALI_HOST_DEV
+  constexpr Out ConvertNorm(bfloat16 value) { return Converter<Out, float>::ConvertNorm(value); }
+
+  static DALI_HOST_DEV
+  constexpr Out ConvertSatNorm(bfloat16 value) {
+    return Converter<Out, float>::ConvertSatNorm(value);
+  }
+};
+
+/// Pass-through conversion
+template <>
+struct Converter<bfloat16, bfloat16> {
+  static DALI_HOST_DEV
+  bfloat16 Convert(bfloat16 value) { return value; }
+
+  static DALI_HOST_DEV
+  bfloat16 ConvertSat(bfloat16 value) { return value; }
+
+  static DALI_HOST_DEV
+  bfloat16 ConvertNorm(bfloat16 value) { return value; }
+
+  static DALI_HOST_DEV
+  bfloat16 ConvertSatNorm(bfloat16 value) { return value; }
+};
+
 template <typename raw_out, typename raw_in>
 using converter_t = Converter<
   std::remove_cv_t<raw_out>,
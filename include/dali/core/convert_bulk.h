@@ -0,0 +1,95 @@
+// Copyright (c) 2026, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_CONVERT_BULK_H_
+#define DALI_CORE_CONVERT_BULK_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include "dali/core/api_helper.h"
+#include "dali/core/convert.h"
+#include "dali/core/float16.h"
+
+namespace dali {
+
+/**
+ * @brief Converts `n` floats to float16, with the same rounding as `float16(float)`
+ *
+ * Uses F16C (if supported by the CPU) or NEON vector conversions.
+ */
+DLL_PUBLIC void FloatToFloat16(float16 *out, const float *in, int64_t n);
+
+/**
+ * @brief Converts `n` float16 values to float
+ *
+ * Uses F16C (if supported by the CPU) or NEON vector conversions.
+ */
+DLL_PUBLIC void Float16ToFloat(float *out, const float16 *in, int64_t n);
+
+namespace detail {
+
+constexpr int64_t kConvertBulkChunk = 256;
+
+template <typename In>
+void IntegerToFloat16(float16 *out, const In *in, int64_t n) {
+  float tmp[kConvertBulkChunk];  // NOLINT
+  for (int64_t i = 0; i < n; i += kConvertBulkChunk) {
+    int64_t m = std::min(kConvertBulkChunk, n - i);
+    for (int64_t j = 0; j < m; j++)
+      tmp[j] = ConvertSat<float>(in[i + j]);
+    FloatToFloat16(out + i, tmp, m);
+  }
+}
+
+template <typename Out>
+void Float16ToArithmetic(Out *out, const float16 *in, int64_t n) {
+  float tmp[kConvertBulkChunk];  // NOLINT
+  for (int64_t i = 0; i < n; i += kConvertBulkChunk) {
+    int64_t m = std::min(kConvertBulkChunk, n - i);
+    Float16ToFloat(tmp, in + i, m);
+    for (int64_t j = 0; j < m; j++)
+      out[i + j] = ConvertSat<Out>(tmp[j]);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Converts an array with ConvertSat
+ *
+ * The conversions to and from float16 are vectorized (see FloatToFloat16 and Float16ToFloat);
+ * integers and float16 are converted through float, which gives the same results as ConvertSat.
+ */
+template <typename Out, typename In>
+void ConvertSatBulk(Out *out, const In *in, int64_t n) {
+  constexpr bool to_half = std::is_same<Out, float16>::value;
+  constexpr bool from_half = std::is_same<In, float16>::value;
+  if constexpr (to_half && std::is_same<In, float>::value) {
+    FloatToFloat16(out, in, n);
+  } else if constexpr (from_half && std::is_same<Out, float>::value) {
+    Float16ToFloat(out, in, n);
+  } else if constexpr (to_half && std::is_integral<In>::value) {
+    detail::IntegerToFloat16(out, in, n);
+  } else if constexpr (from_half && std::is_arithmetic<Out>::value) {
+    detail::Float16ToArithmetic(out, in, n);
+  } else {
+    for (int64_t i = 0; i < n; i++)
+      out[i] = ConvertSat<Out>(in[i]);
+  }
+}
+
+}  // namespace dali
+
+#endif  // DALI_CORE_CONVERT_BULK_H_
@@ -36,11 +36,13 @@ class DLL_PUBLIC CUDAStreamPool {
    *
    * @param device_id   CUDA runtime API device ordinal. If negative, calling thread's
    *                    current device is used.
+   * @param priority    The priority of the stream, as in `cudaStreamCreateWithPriority`.
+   *                    The streams of different priorities are pooled separately.
    *
-   * @return A CUDA stream wrapper object. If there were any streams in the pools, the
-   *         stream is taken from it, otherwise a new stream is created.
+   * @return A CUDA stream wrapper object. If there were any streams with the requested
+   *         priority in the pool, the stream is taken from it, otherwise a new stream is created.
    */
-  CUDAStreamLease Get(int device_id = -1);
+  CUDAStreamLease Get(int device_id = -1, int priority = 0);
 
   /**
    * @brief Places a stream for given device in the pool.
@@ -49,10 +51,12 @@ class DLL_PUBLIC CUDAStreamPool {
    *                  created. If negative, the device is obtained from the device context
    *                  associated with the stream.
    *
+   * @param priority  The priority with which the stream was created.
+   *
    * @remarks It is an error to misstate the device_id. Placing a stream with improper device_id
    *          will render the stream pool unusable.
    */
-  void Put(CUDAStream &&stream, int device_id = -1);
+  void Put(CUDAStream &&stream, int device_id = -1, int priority = 0);
 
   /**
    * @brief Removes all streams currently in the pool and deletes auxiliary data structures.
@@ -77,13 +81,14 @@ class DLL_PUBLIC CUDAStreamPool {
 
   void Init();
 
-  CUDAStream GetFromPool(int device_id);
+  CUDAStream GetFromPool(int device_id, int priority);
 
   struct StreamEntry {
     StreamEntry() = default;
-    explicit StreamEntry(CUDAStream stream, StreamEntry *next = nullptr)
-    : stream(std::move(stream)), next(next) {}
+    explicit StreamEntry(CUDAStream stream, int priority = 0, StreamEntry *next = nullptr)
+    : stream(std::move(stream)), priority(priority), next(next) {}
     CUDAStream stream;
+    int priority = 0;
     StreamEntry *next = nullptr;
   };
 
@@ -100,6 +105,17 @@ class DLL_PUBLIC CUDAStreamPool {
     return e;
   }
 
+  /**
+   * @brief Removes the first entry with given priority from the list
+   */
+  static StreamEntry *Pop(StreamEntry *&head, int priority) {
+    for (StreamEntry **pe = &head; *pe; pe = &(*pe)->next) {
+      if ((*pe)->priority == priority)
+        return Pop(*pe);
+    }
+    return nullptr;
+  }
+
   static void Push(StreamEntry *&head, StreamEntry *new_entry) {
     new_entry->next = head;
     head = new_entry;
@@ -131,6 +147,7 @@ class CUDAStreamLease {
       stream_ = std::move(other.stream_);
       owner_ = other.owner_;
       device_id_ = other.device_id_;
+      priority_ = other.priority_;
       other.owner_ = nullptr;
       other.device_id_ = -1;
     }
@@ -173,6 +190,13 @@ class CUDAStreamLease {
     return device_id_;
   }
 
+  /**
+   * @brief Returns the priority with which the stream was created.
+   */
+  int priority() const noexcept {
+    return priority_;
+  }
+
   /**
    * @brief Returns the owning pool object.
    */
@@ -186,7 +210,7 @@ class CUDAStreamLease {
   void reset() {
     if (owner_) {
       if (stream_) {
-        owner_->Put(std::move(stream_), device_id_);
+        owner_->Put(std::move(stream_), device_id_, priority_);
         owner_->lease_count_--;
       }
       owner_ = nullptr;
@@ -196,8 +220,8 @@ class CUDAStreamLease {
   }
 
  private:
-  CUDAStreamLease(CUDAStream &&stream, int device_id, CUDAStreamPool *owner)
-  : stream_(std::move(stream)), device_id_(device_id), owner_(owner) {
+  CUDAStreamLease(CUDAStream &&stream, int device_id, int priority, CUDAStreamPool *owner)
+  : stream_(std::move(stream)), device_id_(device_id), priority_(priority), owner_(owner) {
     assert(owner_ && stream_);
     ++owner->lease_count_;
   }
@@ -205,6 +229,7 @@ class CUDAStreamLease {
   friend class CUDAStreamPool;
   CUDAStream stream_;
   int device_id_ = -1;
+  int priority_ = 0;
   CUDAStreamPool *owner_ = nullptr;
 };
 
@@ -0,0 +1,76 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_HOT_TYPES_H_
+#define DALI_CORE_HOT_TYPES_H_
+
+#include "dali/core/static_switch.h"
+
+/**
+ * @file
+ *
+ * The type combinations for which the operators instantiate their specialized kernels.
+ *
+ * Operators which switch over a grid of input and output types (e.g. the normalization)
+ * instantiate a kernel for each pair of types, most of which are rarely used. When DALI is built
+ * with `BUILD_ALL_TYPE_COMBOS=OFF`, such operators instantiate their kernels only for the hot
+ * types listed below and handle the other types by converting them to (or from) float with
+ * CastSamplesGPU (dali/operators/util/cast_samples.h), instantiated once for all the operators.
+ * This reduces the size of the binaries (and the time it takes to load them) at the cost of
+ * an additional pass over the data for the rare types.
+ *
+ * The float type must be in both lists - it's the type to which the other types are converted.
+ */
+
+#ifndef ALL_TYPE_COMBOS_ENABLED
+#define ALL_TYPE_COMBOS_ENABLED 1
+#endif
+
+/// The input types which get specialized kernels
+#define DALI_HOT_INPUT_TYPES (uint8_t, float)
+
+/// The output types which get specialized kernels
+#define DALI_HOT_OUTPUT_TYPES (float, float16, bfloat16, uint8_t)
+
+/**
+ * @brief Selects the types for which the kernels are instantiated - all the supported types
+ *        or only the hot ones, depending on the build configuration.
+ *
+ * The hot types must be a subset of the supported ones.
+ */
+#if ALL_TYPE_COMBOS_ENABLED
+#define DALI_KERNEL_TYPES(all_types, hot_types) all_types
+#else
+#define DALI_KERNEL_TYPES(all_types, hot_types) hot_types
+#endif
+
+#define DALI_TYPE_IN_LIST_IMPL3(type_, id_, type_tag_) \
+  (id_) == type_tag_<BOOST_PP_REMOVE_PARENS(type_)>::value ||
+
+#define DALI_TYPE_IN_LIST_IMPL2(...) DALI_TYPE_IN_LIST_IMPL3(__VA_ARGS__)
+
+#define DALI_TYPE_IN_LIST_IMPL(r, args, type) DALI_TYPE_IN_LIST_IMPL2(type, DALI_REMOVE_PAREN(args))
+
+/**
+ * @brief An expression which is true if the type id is the id of one of the types in the list
+ *
+ * @param id_       - numerical id of the type
+ * @param type_tag_ - a class template usable as type_tag<type>::value, as in TYPE_SWITCH
+ * @param types     - parenthesised, comma-separated list of types
+ */
+#define DALI_TYPE_IN_LIST(id_, type_tag_, types) (BOOST_PP_SEQ_FOR_EACH( \
+    DALI_TYPE_IN_LIST_IMPL, (id_, type_tag_), BOOST_PP_VARIADIC_TO_SEQ(DALI_REMOVE_PAREN(types))) \
+    false)
+
+#endif  // DALI_CORE_HOT_TYPES_H_
@@ -0,0 +1,189 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_METRICS_H_
+#define DALI_CORE_METRICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "dali/core/api_helper.h"
+
+namespace dali {
+namespace metrics {
+
+enum class MetricType {
+  Counter,  ///< a monotonic total, e.g. the number of batches produced
+  Gauge,    ///< a current value, e.g. the memory in use
+};
+
+/// Label name -> value, e.g. {{"reader", "Reader"}}
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief A value updated cheaply from many threads.
+ *
+ * The value is split into cache line aligned shards and each thread updates its own shard
+ * with a relaxed atomic add, so that the threads don't contend for the same cache line.
+ * Reading the value sums the shards.
+ */
+class DLL_PUBLIC Counter {
+ public:
+  static constexpr int kNumShards = 16;
+
+  void Add(int64_t n = 1) noexcept {
+    shards_[ShardIndex()].value.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  int64_t Value() const noexcept {
+    int64_t total = 0;
+    for (auto &shard : shards_)
+      total += shard.value.load(std::memory_order_relaxed);
+    return total;
+  }
+
+ private:
+  static int ShardIndex() noexcept;
+
+  struct alignas(64) Shard {
+    std::atomic<int64_t> value{0};
+  };
+  Shard shards_[kNumShards];
+};
+
+/**
+ * @brief A value computed when the metrics are collected
+ */
+struct MetricSample {
+  std::string name;
+  std::string help;
+  MetricType type;
+  Labels labels;
+  double value;
+};
+
+/// Appends the current values of some metrics; called when the metrics are collected
+using Collector = std::function<void(std::vector<MetricSample> &samples)>;
+
+/**
+ * @brief The process-wide set of metrics, exported in the Prometheus text format.
+ *
+ * There are two kinds of metrics:
+ *  - the counters, updated in the hot paths; they are created on first use and live until
+ *    the end of the process, so that the callers can keep a reference to them;
+ *  - the collectors, which report the state of an object (e.g. the queue depths of
+ *    an executor) when the metrics are collected; they are removed by their owners.
+ */
+class DLL_PUBLIC MetricsRegistry {
+ public:
+  static MetricsRegistry &instance();
+
+  /**
+   * @brief Returns the counter with the given name and labels, creating it on first use.
+   *
+   * The type and the help string are taken from the first call for a given name. A gauge
+   * created this way is updated with `Add` (e.g. with the sizes of allocations and
+   * deallocations).
+   */
+  Counter &GetCounter(const std::string &name, const std::string &help, const Labels &labels = {},
+                      MetricType type = MetricType::Counter);
+
+  Counter &GetGauge(const std::string &name, const std::string &help, const Labels &labels = {}) {
+    return GetCounter(name, help, labels, MetricType::Gauge);
+  }
+
+  /**
+   * @brief Adds a collector and returns its id, to be passed to RemoveCollector
+   */
+  int AddCollector(Collector collector);
+
+  /**
+   * @brief Removes the collector; after the call returns, the collector is no longer called.
+   */
+  void RemoveCollector(int id);
+
+  /**
+   * @brief Returns the current values of all the metrics, grouped by name
+   */
+  std::vector<MetricSample> Collect() const;
+
+  /**
+   * @brief Writes the metrics in the Prometheus text exposition format
+   */
+  void WritePrometheus(std::ostream &os) const;
+
+  std::string Prometheus() const;
+
+ private:
+  MetricsRegistry();
+  ~MetricsRegistry();
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+inline Counter &GetCounter(const std::string &name, const std::string &help,
+                           const Labels &labels = {}) {
+  return MetricsRegistry::instance().GetCounter(name, help, labels);
+}
+
+inline Counter &GetGauge(const std::string &name, const std::string &help,
+                         const Labels &labels = {}) {
+  return MetricsRegistry::instance().GetGauge(name, help, labels);
+}
+
+/**
+ * @brief Removes the collector at the end of the scope
+ */
+class CollectorHandle {
+ public:
+  CollectorHandle() = default;
+  explicit CollectorHandle(Collector collector)
+      : id_(MetricsRegistry::instance().AddCollector(std::move(collector))) {}
+
+  ~CollectorHandle() {
+    reset();
+  }
+
+  CollectorHandle(CollectorHandle &&other) noexcept : id_(other.id_) {
+    other.id_ = -1;
+  }
+
+  CollectorHandle &operator=(CollectorHandle &&other) noexcept {
+    if (this != &other) {
+      reset();
+      id_ = other.id_;
+      other.id_ = -1;
+    }
+    return *this;
+  }
+
+  void reset() {
+    if (id_ >= 0)
+      MetricsRegistry::instance().RemoveCollector(id_);
+    id_ = -1;
+  }
+
+ private:
+  int id_ = -1;
+};
+
+}  // namespace metrics
+}  // namespace dali
+
+#endif  // DALI_CORE_METRICS_H_
@@ -0,0 +1,183 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_ARENA_RESOURCE_H_
+#define DALI_CORE_MM_ARENA_RESOURCE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "dali/core/mm/memory_resource.h"
+#include "dali/core/mm/detail/align.h"
+
+namespace dali {
+namespace mm {
+
+struct arena_stats {
+  /// The number of allocations served by the arena
+  size_t allocations = 0;
+  /// The number of blocks taken from the upstream resource
+  size_t upstream_allocations = 0;
+  /// The largest amount of memory used between two resets, in bytes
+  size_t peak_bytes = 0;
+};
+
+/**
+ * @brief Monotonic host resource whose memory is released in bulk and reused with `reset`.
+ *
+ * Intended for short-lived allocations which all end at a known point, e.g. the end of
+ * an iteration. If more than one block was used since the last reset, the blocks are replaced
+ * with a single block large enough to hold all of them - after a few resets, the allocations
+ * of the following iterations (with a similar demand) don't reach the upstream resource at all.
+ *
+ * The resource is not thread-safe.
+ */
+class host_arena_resource : public memory_resource<memory_kind::host> {
+ public:
+  explicit host_arena_resource(memory_resource<memory_kind::host> *upstream,
+                               size_t first_block_size = 0x10000)
+  : upstream_(upstream), next_block_size_(first_block_size) {}
+
+  host_arena_resource(const host_arena_resource &) = delete;
+  host_arena_resource &operator=(const host_arena_resource &) = delete;
+
+  ~host_arena_resource() {
+    free_blocks();
+  }
+
+  /**
+   * @brief Invalidates all the memory allocated from the arena since the last reset.
+   */
+  void reset() {
+    stats_.peak_bytes = std::max(stats_.peak_bytes, used_);
+    if (blocks_.size() > 1) {
+      size_t total = 0;
+      for (auto &block : blocks_)
+        total += block.second;
+      free_blocks();
+      add_block(total);
+    } else if (!blocks_.empty()) {
+      curr_ = blocks_[0].first;
+    }
+    used_ = 0;
+  }
+
+  arena_stats stats() const noexcept {
+    arena_stats ret = stats_;
+    ret.peak_bytes = std::max(ret.peak_bytes, used_);
+    return ret;
+  }
+
+  memory_resource<memory_kind::host> *get_upstream() const noexcept {
+    return upstream_;
+  }
+
+ protected:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    stats_.allocations++;
+    char *ret = detail::align_ptr(curr_, alignment);
+    if (!curr_ || ret + bytes > limit_) {
+      add_block(std::max(next_block_size_, bytes + alignment));
+      ret = detail::align_ptr(curr_, alignment);
+    }
+    used_ += ret + bytes - curr_;
+    curr_ = ret + bytes;
+    return ret;
+  }
+
+  // the memory is released in bulk by reset
+  void do_deallocate(void *data, size_t bytes, size_t alignment) override {}
+
+ private:
+  static constexpr size_t kBlockAlignment = 64;
+
+  void add_block(size_t size) {
+    char *base = static_cast<char *>(upstream_->allocate(size, kBlockAlignment));
+    blocks_.emplace_back(base, size);
+    stats_.upstream_allocations++;
+    curr_ = base;
+    limit_ = base + size;
+    next_block_size_ = std::max(next_block_size_, 2 * size);
+  }
+
+  void free_blocks() {
+    for (auto &block : blocks_)
+      upstream_->deallocate(block.first, block.second, kBlockAlignment);
+    blocks_.clear();
+    curr_ = limit_ = nullptr;
+  }
+
+  memory_resource<memory_kind::host> *upstream_ = nullptr;
+  std::vector<std::pair<char *, size_t>> blocks_;
+  char *curr_ = nullptr, *limit_ = nullptr;
+  size_t next_block_size_ = 0;
+  size_t used_ = 0;
+  arena_stats stats_;
+};
+
+/**
+ * @brief A standard library allocator which takes the memory from a `host_arena_resource`.
+ *
+ * The deallocation is a no-op - a container using this allocator must not outlive
+ * the next reset of the arena. If the arena is null, the allocator uses the global heap,
+ * so that the code using it works also without an arena.
+ */
+template <typename T>
+class arena_allocator {
+ public:
+  using value_type = T;
+
+  explicit arena_allocator(host_arena_resource *arena = nullptr) noexcept : arena_(arena) {}
+
+  template <typename U>
+  arena_allocator(const arena_allocator<U> &other) noexcept : arena_(other.arena()) {}  // NOLINT
+
+  T *allocate(size_t n) {
+    if (!arena_)
+      return static_cast<T *>(::operator new(n * sizeof(T)));
+    return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *ptr, size_t) noexcept {
+    if (!arena_)
+      ::operator delete(ptr);
+  }
+
+  host_arena_resource *arena() const noexcept {
+    return arena_;
+  }
+
+  template <typename U>
+  bool operator==(const arena_allocator<U> &other) const noexcept {
+    return arena_ == other.arena();
+  }
+
+  template <typename U>
+  bool operator!=(const arena_allocator<U> &other) const noexcept {
+    return arena_ != other.arena();
+  }
+
+ private:
+  host_arena_resource *arena_;
+};
+
+/// A vector with the memory allocated from a `host_arena_resource`
+template <typename T>
+using arena_vector = std::vector<T, arena_allocator<T>>;
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_ARENA_RESOURCE_H_
@@ -16,11 +16,14 @@
 #define DALI_CORE_MM_ASYNC_POOL_H_
 
 #include <algorithm>
+#include <atomic>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 #include "dali/core/mm/pool_resource.h"
+#include "dali/core/call_at_exit.h"
 #include "dali/core/mm/detail/free_list.h"
 #include "dali/core/small_vector.h"
 #include "dali/core/cuda_event_pool.h"
@@ -101,6 +104,45 @@ class async_pool_resource : public async_memory_resource<Kind> {
     synchronize_impl(true);
   }
 
+  /**
+   * @brief Returns the completed per-stream deallocations to the global pool and, if the global
+   *        pool supports it, the unused global pool blocks to the upstream resource.
+   *
+   * If the resource is busy (e.g. the function is called from within an allocation),
+   * nothing is released.
+   *
+   * @return The number of bytes returned to the upstream resource.
+   */
+  size_t release_unused() {
+    if (global_pool_owner_ == std::this_thread::get_id())
+      return 0;
+    std::unique_lock<LockType> guard(lock_, std::try_to_lock);
+    if (!guard.owns_lock())
+      return 0;
+    for (auto &kv : stream_free_)
+      free_ready(kv.second);
+    return release_unused_impl(global_pool_, 0);
+  }
+
+  /**
+   * @brief Returns the statistics of the free memory in the global pool, if it provides them
+   *
+   * The memory freed on the streams, but not yet returned to the global pool, is not included.
+   */
+  free_list_stats free_stats() {
+    std::lock_guard<LockType> guard(lock_);
+    return free_stats_impl(global_pool_, 0);
+  }
+
+  /**
+   * @brief The number of allocations made so far
+   *
+   * Used for detecting the periods in which the resource is not used.
+   */
+  uint64_t num_allocations() const noexcept {
+    return num_allocations_.load(std::memory_order_relaxed);
+  }
+
  private:
   void synchronize_impl(bool lock) {
     {
@@ -126,9 +168,16 @@ class async_pool_resource : public async_memory_resource<Kind> {
   void *do_allocate(size_t bytes, size_t alignment) override {
     adjust_size_and_alignment(bytes, alignment, true);
     std::lock_guard<LockType> guard(lock_);
+    count_allocation();
     return allocate_from_global_pool(bytes, alignment);
   }
 
+  void count_allocation() {
+    // only modified under the lock - no need for an atomic increment
+    num_allocations_.store(num_allocations_.load(std::memory_order_relaxed) + 1,
+                           std::memory_order_relaxed);
+  }
+
   void do_deallocate(void *mem, size_t bytes, size_t alignment) override {
     if (!mem || !bytes)
       return;
@@ -155,6 +204,7 @@ class async_pool_resource : public async_memory_resource<Kind> {
       return nullptr;
     adjust_size_and_alignment(bytes, alignment, true);
     std::lock_guard<LockType> guard(lock_);
+    count_allocation();
     auto it = stream_free_.find(stream.get());
     void *ptr;
     if (it != stream_free_.end()) {
@@ -169,6 +219,8 @@ class async_pool_resource : public async_memory_resource<Kind> {
    * @brief Allocates from the global pool, possibly releasing per-stream memory to the global pool.
    */
   void *allocate_from_global_pool(size_t bytes, size_t alignment) {
+    global_pool_owner_ = std::this_thread::get_id();
+    auto reset_owner = AtScopeExit([&]() { global_pool_owner_ = std::thread::id(); });
     void *ptr;
     if (num_pending_frees_ == 0) {
       // There are no pending per-stream frees - there's no hope of reclaiming anything.
@@ -575,6 +627,26 @@ class async_pool_resource : public async_memory_resource<Kind> {
    * reuse a part of the block on the same stream and return the rest to the global pool, with
    * the hope of reducing the number of calls to upstream and overall memory consumption.
    */
+  template <typename Pool>
+  static auto release_unused_impl(Pool &pool, int) -> decltype(pool.release_unused()) {
+    return pool.release_unused();
+  }
+
+  template <typename Pool>
+  static size_t release_unused_impl(Pool &, ...) {
+    return 0;
+  }
+
+  template <typename Pool>
+  static auto free_stats_impl(Pool &pool, int) -> decltype(pool.free_stats()) {
+    return pool.free_stats();
+  }
+
+  template <typename Pool>
+  static free_list_stats free_stats_impl(Pool &, ...) {
+    return {};
+  }
+
   static constexpr bool supports_splitting = detail::can_merge<GlobalPool>::value;
 
   static constexpr pool_options global_pool_options() {
@@ -582,7 +654,10 @@ class async_pool_resource : public async_memory_resource<Kind> {
   }
 
   GlobalPool global_pool_;
+  /// The thread which allocates from the global pool while holding `lock_`
+  std::atomic<std::thread::id> global_pool_owner_{};
 
+  std::atomic<uint64_t> num_allocations_{0};
   int num_pending_frees_ = 0;
   bool avoid_upstream_ = true;
 };
@@ -0,0 +1,113 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_CALLBACK_RESOURCE_H_
+#define DALI_CORE_MM_CALLBACK_RESOURCE_H_
+
+#include <cuda_runtime_api.h>
+#include <stdexcept>
+#include "dali/core/mm/memory_resource.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/device_guard.h"
+#include "dali/core/mm/detail/align.h"
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief A device memory resource which forwards the requests to an external, stream-ordered
+ *        allocator, e.g. the caching allocator of a deep learning framework.
+ *
+ * The memory allocated on a stream may be used on that stream immediately; the memory freed on
+ * a stream may be reused by the external allocator for the work subsequently issued on that
+ * stream. The synchronous requests use the default stream - the allocation waits for the work
+ * pending on it.
+ *
+ * The functions have the same signatures as the ones accepted by the pluggable allocator
+ * interfaces of the frameworks (e.g. `torch.cuda.memory.CUDAPluggableAllocator`).
+ */
+class callback_device_resource : public device_async_resource {
+ public:
+  /// Returns nullptr or throws when out of memory
+  using alloc_fn = void *(*)(size_t bytes, int device_id, cudaStream_t stream);
+  using free_fn = void (*)(void *ptr, size_t bytes, int device_id, cudaStream_t stream);
+
+  /**
+   * @param max_alignment The alignment guaranteed by the external allocator;
+   *                      requests with stricter alignment fail.
+   */
+  callback_device_resource(alloc_fn alloc, free_fn free, int device_id,
+                           size_t max_alignment = 256)
+  : alloc_(alloc), free_(free), device_id_(device_id), max_alignment_(max_alignment) {
+    if (!alloc_ || !free_)
+      throw std::invalid_argument("Both allocation and deallocation functions must be provided.");
+    if (device_id_ < 0)
+      CUDA_CALL(cudaGetDevice(&device_id_));
+  }
+
+  int device_id() const noexcept {
+    return device_id_;
+  }
+
+ private:
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    void *ptr = do_allocate_async(bytes, alignment, stream_view());
+    if (ptr)
+      CUDA_CALL(cudaStreamSynchronize(0));
+    return ptr;
+  }
+
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+    do_deallocate_async(ptr, bytes, alignment, stream_view());
+  }
+
+  void *do_allocate_async(size_t bytes, size_t alignment, stream_view stream) override {
+    if (bytes == 0)
+      return nullptr;
+    if (alignment > max_alignment_)
+      throw CUDABadAlloc(bytes);
+    DeviceGuard dg(device_id_);
+    void *ptr = alloc_(bytes, device_id_, stream.get());
+    if (!ptr)
+      throw CUDABadAlloc(bytes);
+    if (!detail::is_aligned(ptr, alignment)) {
+      free_(ptr, bytes, device_id_, stream.get());
+      throw CUDABadAlloc(bytes);
+    }
+    return ptr;
+  }
+
+  void do_deallocate_async(void *ptr, size_t bytes, size_t alignment,
+                           stream_view stream) override {
+    if (!ptr)
+      return;
+    DeviceGuard dg(device_id_);
+    free_(ptr, bytes, device_id_, stream.get());
+  }
+
+  bool do_is_equal(const memory_resource<memory_kind> &other) const noexcept override {
+    auto *cb = dynamic_cast<const callback_device_resource *>(&other);
+    return cb && cb->alloc_ == alloc_ && cb->free_ == free_ && cb->device_id_ == device_id_;
+  }
+
+  alloc_fn alloc_;
+  free_fn free_;
+  int device_id_;
+  size_t max_alignment_;
+};
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_CALLBACK_RESOURCE_H_
@@ -16,6 +16,7 @@
 #define DALI_CORE_MM_CU_VM_H_
 
 #include <cuda.h>
+#include <cstdint>
 #include <utility>  // This should be in ifdef, but cpplint can't see it there
 #if CUDA_VERSION >= 10020
 #define DALI_USE_CUDA_VM_MAP 1
@@ -160,6 +161,17 @@ inline CUmemAllocationProp DeviceMemProp(int device_ordinal = -1) {
   return prop;
 }
 
+/**
+ * @brief Gets CUmemAllocationProp for allocating memory on given device, which can be exported
+ *        to other processes as a POSIX file descriptor.
+ * @param device_ordinal device ordinal or -1 for current device.
+ */
+inline CUmemAllocationProp ShareableDeviceMemProp(int device_ordinal = -1) {
+  CUmemAllocationProp prop = DeviceMemProp(device_ordinal);
+  prop.requestedHandleTypes = CU_MEM_HANDLE_TYPE_POSIX_FILE_DESCRIPTOR;
+  return prop;
+}
+
 struct CUMemAllocation : std::pair<CUmemGenericAllocationHandle, size_t> {
   using std::pair<CUmemGenericAllocationHandle, size_t>::pair;
   constexpr CUmemGenericAllocationHandle &handle() noexcept { return first; }
@@ -217,6 +229,33 @@ class CUMem : public UniqueHandle<CUMemAllocation, CUMem> {
     return CUMem({ handle, size });
   }
 
+  /**
+   * @brief Imports a physical allocation exported by another process
+   *
+   * @param fd   The file descriptor obtained with ExportFd in the other process;
+   *             it can be closed after the call.
+   * @param size The size of the allocation, in bytes
+   */
+  static CUMem ImportFd(int fd, size_t size) {
+    CUmemGenericAllocationHandle handle;
+    CUDA_CALL(cuMemImportFromShareableHandle(
+        &handle, reinterpret_cast<void *>(static_cast<intptr_t>(fd)),
+        CU_MEM_HANDLE_TYPE_POSIX_FILE_DESCRIPTOR));
+    return CUMem({ handle, size });
+  }
+
+  /**
+   * @brief Exports the allocation as a POSIX file descriptor, owned by the caller
+   *
+   * The allocation must have been created with ShareableDeviceMemProp.
+   */
+  int ExportFd() const {
+    int fd = -1;
+    CUDA_CALL(cuMemExportToShareableHandle(&fd, handle(),
+                                           CU_MEM_HANDLE_TYPE_POSIX_FILE_DESCRIPTOR, 0));
+    return fd;
+  }
+
   static void DestroyHandle(CUMemAllocation handle) {
     CUDA_DTOR_CALL(cuMemRelease(handle.first));
   }
@@ -1,4 +1,4 @@
-// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -16,18 +16,22 @@
 #define DALI_CORE_MM_CUDA_VM_RESOURCE_H_
 
 #include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include "dali/core/mm/cu_vm.h"
 
 #if DALI_USE_CUDA_VM_MAP
 #include "dali/core/bitmask.h"
+#include "dali/core/call_at_exit.h"
 #include "dali/core/device_guard.h"
 #include "dali/core/format.h"
 #include "dali/core/spinlock.h"
+#include "dali/core/mm/memory_budget.h"
 #include "dali/core/mm/memory_resource.h"
 #include "dali/core/mm/detail/free_list.h"
 #include "dali/core/small_vector.h"
@@ -41,10 +45,18 @@ class VMResourceTest;
 
 class cuda_vm_resource : public memory_resource<memory_kind::device> {
  public:
+  /**
+   * @param budget  If not null, the physical memory blocks are charged to this budget;
+   *                the budget must outlive the resource.
+   */
   explicit cuda_vm_resource(int device_ordinal = -1,
                             size_t block_size = 0,
-                            size_t initial_va_size = 0) {
+                            size_t initial_va_size = 0,
+                            memory_budget *budget = nullptr) {
     device_ordinal_ = device_ordinal;
+    budget_ = budget;
+    if (budget_)
+      budget_component_ = budget_->add_component("virtual memory pool");
     if (block_size != 0 && !is_pow2(block_size))
       throw std::invalid_argument("block_size must be a power of 2");
     block_size_ = block_size;
@@ -71,6 +83,46 @@ class cuda_vm_resource : public memory_resource<memory_kind::device> {
     return ptr;
   }
 
+  /**
+   * @brief Unmaps and releases the physical blocks which are not used by any allocation.
+   *
+   * The virtual address space is kept, so the blocks can be mapped again when needed.
+   * If the resource is busy (e.g. the function is called from within an allocation),
+   * nothing is released.
+   *
+   * @return The number of bytes of physical memory released.
+   */
+  size_t release_unused() {
+    if (mapping_owner_ == std::this_thread::get_id())
+      return 0;
+    std::unique_lock<pool_lock_t> pool_guard(pool_lock_, std::try_to_lock);
+    if (!pool_guard.owns_lock())
+      return 0;
+    DeviceGuard dg(device_ordinal_);
+    mem_lock_guard mem_guard(mem_lock_);
+    int released = 0;
+    for (va_region &r : va_regions_) {
+      if (!r.available_blocks)
+        continue;
+      for (int block_idx = r.available.find(true);
+           block_idx < r.num_blocks();
+           block_idx = r.available.find(true, block_idx + 1)) {
+        char *block_ptr = r.block_ptr<char>(block_idx);
+        r.unmap_block(block_idx);  // the physical block is released with the returned handle
+        stat_.total_unmaps++;
+        free_mapped_.get_specific_block(block_ptr, block_size_);
+        stat_take_free(block_size_);
+        released++;
+      }
+    }
+    stat_.allocated_blocks -= released;
+    size_t bytes = released * block_size_;
+    if (budget_ && bytes)
+      budget_->release(budget_component_, bytes);
+    budget_charged_ -= bytes;
+    return bytes;
+  }
+
   struct Stat {
     int allocated_blocks;
     int peak_allocated_blocks;
@@ -98,6 +150,14 @@ class cuda_vm_resource : public memory_resource<memory_kind::device> {
     return stat_;
   }
 
+  /**
+   * @brief Returns the statistics of the free (mapped) memory in the resource
+   */
+  free_list_stats free_stats() {
+    lock_guard pool_guard(pool_lock_);
+    return free_mapped_.stats();
+  }
+
   void clear_stat() {
     lock_guard pool_guard(pool_lock_);
     stat_ = {};
@@ -163,6 +223,9 @@ class cuda_vm_resource : public memory_resource<memory_kind::device> {
     DeviceGuard dg(device_ordinal_);
     mem_lock_guard mem_guard(mem_lock_);
     void *va = get_va(size, alignment);
+    // the budget's pressure handlers may be called while mapping - see release_unused
+    mapping_owner_ = std::this_thread::get_id();
+    auto reset_owner = AtScopeExit([&]() { mapping_owner_ = std::thread::id(); });
     try {
       map_storage(va, size);
     } catch (const CUDABadAlloc &e) {
@@ -187,6 +250,9 @@ class cuda_vm_resource : public memory_resource<memory_kind::device> {
     for (auto &r : va_regions_)
       r.purge();
     va_ranges_.clear();
+    if (budget_ && budget_charged_)
+      budget_->release(budget_component_, budget_charged_);
+    budget_charged_ = 0;
   }
 
   void configure() {
@@ -360,6 +426,12 @@ class cuda_vm_resource : public memory_resource<memory_kind::device> {
   size_t block_size_ = 0;
   size_t total_mem_ = 0;
   int device_ordinal_ = -1;
+  memory_budget *budget_ = nullptr;
+  int budget_component_ = -1;
+  /// The bytes of physical memory charged to the budget
+  size_t budget_charged_ = 0;
+  /// The thread which maps the physical memory while holding `pool_lock_`
+  std::atomic<std::thread::id> mapping_owner_{};
 
   void adjust_params(size_t &size, size_t &alignment, bool check) {
     alignment = std::max(alignment, next_pow2(size >> 11));
@@ -632,12 +704,22 @@ class cuda_vm_resource : public memory_resource<memory_kind::device> {
     }
 
     int new_blocks = blocks_to_map - to_unmap.size();
+    size_t new_bytes = new_blocks * block_size_;
+    if (budget_ && new_bytes && !budget_->charge(budget_component_, new_bytes))
+      throw CUDABadAlloc(new_bytes);
     SmallVector<cuvm::CUMem, 256> free_blocks;
-    free_blocks.resize(blocks_to_map);
-    for (int i = to_unmap.size(); i < blocks_to_map; i++) {
-      // This can throw, but we should leave the object in a consistent state
-      free_blocks[i] = cuvm::CUMem::Create(block_size_, device_ordinal_);
+    try {
+      free_blocks.resize(blocks_to_map);
+      for (int i = to_unmap.size(); i < blocks_to_map; i++) {
+        // This can throw, but we should leave the object in a consistent state
+        free_blocks[i] = cuvm::CUMem::Create(block_size_, device_ordinal_);
+      }
+    } catch (...) {
+      if (budget_ && new_bytes)
+        budget_->release(budget_component_, new_bytes);
+      throw;
     }
+    budget_charged_ += new_bytes;
 
     int i = 0;
     for (auto &region_block : to_unmap) {
@@ -1,4 +1,4 @@
-// Copyright (c) 2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -17,12 +17,17 @@
 
 
 #include <memory>
+#include <string>
+#include <vector>
 #include "dali/core/api_helper.h"
+#include "dali/core/mm/free_list_stats.h"
 #include "dali/core/mm/memory_resource.h"
 
 namespace dali {
 namespace mm {
 
+class memory_budget;
+
 template <typename Kind>
 struct DefaultMemoryResourceType;
 
@@ -58,6 +63,11 @@ DLL_PUBLIC std::shared_ptr<default_memory_resource_t<Kind>> ShareDefaultResource
 
 /**
  * @brief Gets a pointer to the current memory resource for allocating memory of given kind.
+ *
+ * On NUMA systems, the default pinned memory resource depends on the current device -
+ * the memory is allocated on the NUMA node closest to the device. This can be disabled by
+ * setting the DALI_USE_NUMA_PINNED_MEM environment variable to 0. A resource set with
+ * SetDefaultResource is used for all devices.
  */
 template <typename Kind>
 DLL_PUBLIC default_memory_resource_t<Kind> *GetDefaultResource();
@@ -112,6 +122,64 @@ void SetDefaultDeviceResource(int device_id, device_async_resource *resource, bo
 DLL_PUBLIC
 void SetDefaultDeviceResource(int device_id, std::shared_ptr<device_async_resource> resource);
 
+/**
+ * @brief Gets the budget of the memory allocated by the default device memory pool.
+ *
+ * The limit is set with the DALI_DEVICE_MEM_BUDGET environment variable (a number of bytes,
+ * optionally followed by k, M or G); it's unlimited by default. When the budget is exhausted,
+ * or the device runs out of memory, the pressure handlers registered in the budget are called
+ * before the allocation fails.
+ *
+ * The budget applies only to the default memory pools - the resources set with
+ * SetDefaultDeviceResource and the ones used when the pool is disabled are not charged.
+ *
+ * @param device_id Device index; if negative, current device is used.
+ */
+DLL_PUBLIC
+memory_budget &GetDeviceMemoryBudget(int device_id = -1);
+
+/**
+ * @brief Gets the budget of the memory allocated by the default pinned memory pool(s).
+ *
+ * The limit is set with the DALI_PINNED_MEM_BUDGET environment variable.
+ *
+ * @see GetDeviceMemoryBudget
+ */
+DLL_PUBLIC
+memory_budget &GetPinnedMemoryBudget();
+
+/**
+ * @brief Returns the unused memory of the default device and pinned memory pools to the system.
+ *
+ * Waits for the pending stream-ordered deallocations and releases the free memory held by
+ * the pools - e.g. unmaps the free physical blocks of the virtual memory pool. The pools which
+ * are busy allocating at the time of the call are skipped.
+ *
+ * The pools can also release the unused memory automatically, after a period without
+ * allocations given (in seconds) in the DALI_MEM_TRIM_IDLE_TIME environment variable.
+ *
+ * @return The number of bytes released.
+ */
+DLL_PUBLIC
+size_t ReleaseUnusedMemory();
+
+/**
+ * @brief The free memory held by one of the default pools
+ */
+struct pool_free_stat {
+  std::string pool;
+  free_list_stats free;
+};
+
+/**
+ * @brief Returns the statistics of the free memory held by the default device and pinned
+ *        memory pools, e.g. to assess their fragmentation.
+ *
+ * Only the pools which have been created so far are reported.
+ */
+DLL_PUBLIC
+std::vector<pool_free_stat> GetPoolFreeStats();
+
 
 
 }  // namespace mm
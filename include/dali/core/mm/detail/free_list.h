@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -15,6 +15,7 @@
 #ifndef DALI_CORE_MM_DETAIL_FREE_LIST_H_
 #define DALI_CORE_MM_DETAIL_FREE_LIST_H_
 
+#include <algorithm>
 #include <cassert>
 #include <utility>
 #include <map>
@@ -24,6 +25,7 @@
 #include "dali/core/mm/detail/align.h"
 #include "dali/core/mm/detail/aux_alloc.h"
 #include "dali/core/mm/detail/aux_collections.h"
+#include "dali/core/mm/free_list_stats.h"
 
 namespace dali {
 namespace mm {
@@ -179,6 +181,17 @@ class best_fit_free_list {
     }
   };
 
+  free_list_stats stats() const {
+    free_list_stats s;
+    for (block *b = head_; b; b = b->next) {
+      size_t size = b->end - b->start;
+      s.free_bytes += size;
+      s.free_blocks++;
+      s.largest_block = std::max(s.largest_block, size);
+    }
+    return s;
+  }
+
   /**
    * @brief Obtains a best-fit block from the list of free blocks.
    *
@@ -542,6 +555,16 @@ class coalescing_free_tree {
     return nullptr;
   }
 
+  free_list_stats stats() const {
+    free_list_stats s;
+    for (auto &blk : by_addr_)
+      s.free_bytes += blk.second;
+    s.free_blocks = by_addr_.size();
+    if (!by_size_.empty())
+      s.largest_block = by_size_.rbegin()->first;
+    return s;
+  }
+
   /**
    * @brief Checks whether given range is present in the free tree
    */
@@ -775,6 +798,16 @@ class best_fit_free_tree {
   }
 
 
+  free_list_stats stats() const {
+    free_list_stats s;
+    for (auto &blk : by_addr_)
+      s.free_bytes += blk.second;
+    s.free_blocks = by_addr_.size();
+    if (!by_size_.empty())
+      s.largest_block = by_size_.rbegin()->first;
+    return s;
+  }
+
   /**
    * @brief Removes a block from the tree if _exactly_ this block is free - no splitting occurs
    */
@@ -0,0 +1,171 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_DETAIL_SIZE_CLASS_CACHE_H_
+#define DALI_CORE_MM_DETAIL_SIZE_CLASS_CACHE_H_
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+#include "dali/core/util.h"
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief Keeps free buffers for reuse, binned by size classes
+ *
+ * Each power of two is divided into `kClassesPerOctave` size classes of equal width. A buffer
+ * is kept in the largest class not exceeding its size, so that any request rounded up to that
+ * class can reuse it; a request is satisfied from its own class or a larger one, up to twice
+ * its size. When the total size of the buffers exceeds the capacity, the largest buffers
+ * are evicted.
+ *
+ * The cache does not own the memory - the evicted buffers are passed to a callback, which is
+ * expected to free them. The object is not thread-safe.
+ */
+class size_class_cache {
+ public:
+  struct block {
+    void *mem;
+    size_t size;
+  };
+
+  static constexpr int kClassesPerOctave = 4;
+  static constexpr int kMinClassLog2 = 8;
+  static constexpr size_t kMinClassSize = size_t(1) << kMinClassLog2;
+
+  explicit size_class_cache(size_t capacity = 0) : capacity_(capacity) {}
+
+  /**
+   * @brief The index of the smallest size class which can hold `size` bytes
+   */
+  static int class_index(size_t size) {
+    if (size <= kMinClassSize)
+      return 0;
+    int e = ilog2(size - 1);  // 2^e < size <= 2^(e+1)
+    size_t step = size_t(1) << (e - 2);
+    int k = div_ceil(size - (size_t(1) << e), step);
+    return (e - kMinClassLog2) * kClassesPerOctave + k;
+  }
+
+  /**
+   * @brief The index of the largest size class not exceeding `size`; -1 if there's none
+   */
+  static int floor_class_index(size_t size) {
+    if (size < kMinClassSize)
+      return -1;
+    int e = ilog2(size);  // 2^e <= size < 2^(e+1)
+    size_t step = size_t(1) << (e - 2);
+    int k = (size - (size_t(1) << e)) / step;
+    return (e - kMinClassLog2) * kClassesPerOctave + k;
+  }
+
+  /**
+   * @brief The size of the size class - the size to round the allocations up to
+   */
+  static size_t class_size(int index) {
+    int e = index / kClassesPerOctave + kMinClassLog2;
+    int k = index % kClassesPerOctave;
+    return (size_t(1) << e) + k * (size_t(1) << (e - 2));
+  }
+
+  /**
+   * @brief Takes a buffer of at least `size` bytes from the cache
+   *
+   * @return The buffer or {nullptr, 0} if there's no suitable one.
+   */
+  block get(size_t size) {
+    int first = class_index(size);
+    int last = std::min<int>(first + kClassesPerOctave, bins_.size() - 1);
+    for (int c = first; c <= last; c++) {
+      auto &bin = bins_[c];
+      if (!bin.empty()) {
+        block b = bin.back();
+        bin.pop_back();
+        assert(b.size >= size);
+        bytes_ -= b.size;
+        return b;
+      }
+    }
+    return {nullptr, 0};
+  }
+
+  /**
+   * @brief Puts a buffer into the cache and evicts the largest ones if the capacity is exceeded
+   *
+   * @param evict called with each block removed from the cache (possibly the one being put)
+   */
+  template <typename Evict>
+  void put(void *mem, size_t size, Evict &&evict) {
+    int c = floor_class_index(size);
+    if (c < 0 || size > capacity_) {
+      evict(block{mem, size});
+      return;
+    }
+    if (c >= static_cast<int>(bins_.size()))
+      bins_.resize(c + 1);
+    bins_[c].push_back({mem, size});
+    bytes_ += size;
+    if (bytes_ > peak_bytes_)
+      peak_bytes_ = bytes_;
+    trim(capacity_, evict);
+  }
+
+  /**
+   * @brief Evicts the largest buffers until the total size doesn't exceed `max_bytes`
+   */
+  template <typename Evict>
+  void trim(size_t max_bytes, Evict &&evict) {
+    for (int c = static_cast<int>(bins_.size()) - 1; c >= 0 && bytes_ > max_bytes; c--) {
+      auto &bin = bins_[c];
+      while (!bin.empty() && bytes_ > max_bytes) {
+        block b = bin.back();
+        bin.pop_back();
+        bytes_ -= b.size;
+        evict(b);
+      }
+    }
+  }
+
+  size_t bytes() const {
+    return bytes_;
+  }
+
+  size_t peak_bytes() const {
+    return peak_bytes_;
+  }
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+  template <typename Evict>
+  void set_capacity(size_t capacity, Evict &&evict) {
+    capacity_ = capacity;
+    trim(capacity_, evict);
+  }
+
+ private:
+  std::vector<std::vector<block>> bins_;
+  size_t bytes_ = 0;
+  size_t peak_bytes_ = 0;
+  size_t capacity_;
+};
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_DETAIL_SIZE_CLASS_CACHE_H_
@@ -0,0 +1,53 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_CORE_MM_FREE_LIST_STATS_H_
+#define DALI_CORE_MM_FREE_LIST_STATS_H_
+
+#include <algorithm>
+#include <cstddef>
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief The amount and layout of the free memory in a free list
+ */
+struct free_list_stats {
+  size_t free_bytes = 0;
+  size_t free_blocks = 0;
+  /// The size of the largest free block - the largest allocation that can be served
+  size_t largest_block = 0;
+
+  /**
+   * @brief The part of the free memory which is not in the largest free block;
+   *        0 when all the free memory is contiguous, close to 1 when it's scattered.
+   */
+  double fragmentation() const {
+    return free_bytes ? 1.0 - static_cast<double>(largest_block) / free_bytes : 0.0;
+  }
+
+  free_list_stats &operator+=(const free_list_stats &other) {
+    free_bytes += other.free_bytes;
+    free_blocks += other.free_blocks;
+    largest_block = std::max(largest_block, other.largest_block);
+    return *this;
+  }
+};
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_FREE_LIST_STATS_H_
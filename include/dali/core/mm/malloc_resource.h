@@ -1,4 +1,4 @@
-// Copyright (c) 2020-2021, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// Copyright (c) 2020-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 //
 // Licensed under the Apache License, Version 2.0 (the "License");
 // you may not use this file except in compliance with the License.
@@ -20,6 +20,7 @@
 #include "dali/core/mm/memory_resource.h"
 #include "dali/core/cuda_error.h"
 #include "dali/core/mm/detail/align.h"
+#include "dali/core/os/numa.h"
 
 namespace dali {
 namespace mm {
@@ -94,6 +95,8 @@ class cuda_malloc_memory_resource : public device_async_resource {
 
 /**
  * @brief A memory resource that directly calls cudaMallocHost and cudaFreeHost.
+ *
+ * If a NUMA node is given, the pages are preferably allocated on that node.
  */
 class pinned_malloc_memory_resource : public pinned_async_resource {
   const size_t kGuaranteedAlignment = 256;
@@ -104,8 +107,11 @@ class pinned_malloc_memory_resource : public pinned_async_resource {
     if (alignment <= kGuaranteedAlignment)
       alignment = 1;  // cudaMallocHost guarantees suffcient alignment - avoid overhead
 
-    return detail::aligned_alloc([](size_t size) {
+    return detail::aligned_alloc([this](size_t size) {
       void *mem = nullptr;
+      // cudaMallocHost touches the pages, so they're placed according to the calling thread's
+      // memory policy
+      numa::PreferredNodeScope node_scope(numa_node_);
       CUDA_CALL(cudaMallocHost(&mem, size | 1));  // |1 to prevent accidental coalescing
       return mem;
     }, bytes, alignment);
@@ -130,10 +136,21 @@ class pinned_malloc_memory_resource : public pinned_async_resource {
   }
 
   bool do_is_equal(const memory_resource<memory_kind> &other) const noexcept override {
-    return dynamic_cast<const pinned_malloc_memory_resource*>(&other) != nullptr;
+    auto *pinned = dynamic_cast<const pinned_malloc_memory_resource*>(&other);
+    return pinned != nullptr && pinned->numa_node_ == numa_node_;
   }
 
+  int numa_node_ = -1;
+
  public:
+  pinned_malloc_memory_resource() = default;
+  explicit pinned_malloc_memory_resource(int numa_node) : numa_node_(numa_node) {}
+
+  /// The preferred NUMA node of the allocated memory; -1 if not specified
+  int numa_node() const noexcept {
+    return numa_node_;
+  }
+
   static pinned_malloc_memory_resource &instance() {
     static pinned_malloc_memory_resource inst;
     return inst;
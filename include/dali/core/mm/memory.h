@@ -18,6 +18,7 @@
 #include <memory>
 #include <utility>
 #include "dali/core/mm/default_resources.h"
+#include "dali/core/mm/memory_trace.h"
 #include "dali/core/access_order.h"
 
 namespace dali {
@@ -71,6 +72,7 @@ Deleter GetDeleter(memory_resource<Kind> *resource, size_t size, size_t alignmen
   del.size = size;
   del.alignment = alignment;
   del.free = [](void *res_vptr, void *mem, size_t sz, size_t align) {
+    trace_free<Kind>(mem, sz, host_sync);
     static_cast<memory_resource<Kind>*>(res_vptr)->deallocate(mem, sz, align);
   };
   return del;
@@ -90,6 +92,7 @@ AsyncDeleter GetDeleter(async_memory_resource<Kind> *resource,
   del.release_on_stream = stream;
   del.free = [](void *res_vptr, void *mem, size_t sz, size_t align, cudaStream_t s) {
     auto *rsrc = static_cast<async_memory_resource<Kind>*>(res_vptr);
+    trace_free<Kind>(mem, sz, s);
     if (s != host_sync) {
       rsrc->deallocate_async(mem, sz, align, s);
     } else {
@@ -133,6 +136,7 @@ template <typename Kind>
 std::pair<void*, Deleter> alloc_raw(memory_resource<Kind> *mr,
                                     size_t bytes, size_t alignment = alignof(std::max_align_t)) {
   void *mem = mr->allocate(bytes, alignment);
+  trace_alloc<Kind>(mem, bytes, host_sync);
   return { mem, GetDeleter(mr, bytes, alignment) };
 }
 
@@ -272,6 +276,7 @@ std::pair<void*, AsyncDeleter> alloc_raw_async(async_memory_resource<Kind> *mr,
   void *mem = alloc_stream == host_sync
     ? mr->allocate(bytes, alignment)
     : mr->allocate_async(bytes, alignment, alloc_stream);
+  trace_alloc<Kind>(mem, bytes, alloc_stream);
   return { mem, GetDeleter(mr, bytes, alignment, dealloc_stream) };
 }
 
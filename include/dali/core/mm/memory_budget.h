@@ -0,0 +1,282 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_MM_MEMORY_BUDGET_H_
+#define DALI_CORE_MM_MEMORY_BUDGET_H_
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "dali/core/mm/memory_resource.h"
+#include "dali/core/cuda_error.h"
+#include "dali/core/util.h"
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief The memory charged to a budget by one component (e.g. a pool)
+ */
+struct memory_budget_stat {
+  std::string component;
+  size_t current = 0;
+  size_t peak = 0;
+};
+
+/**
+ * @brief A limit on the memory obtained from the system by a group of memory resources
+ *
+ * The resources charge the memory they obtain (e.g. the blocks allocated by a pool from
+ * the upstream) to the budget. When the limit would be exceeded, the budget calls the pressure
+ * handlers, in the order of their priority, until the charge fits - only then the allocation
+ * fails.
+ *
+ * The handlers are called without the budget's lock held, so they can release the memory
+ * charged to the same budget. They may be called from within an allocation and must not wait
+ * for one - e.g. they should use `try_lock` on the locks held while allocating.
+ */
+class memory_budget {
+ public:
+  static constexpr size_t unlimited = -1_uz;
+
+  /// Releases some memory; lower priority handlers are called first
+  using pressure_handler = std::function<void()>;
+
+  explicit memory_budget(size_t limit = unlimited) : limit_(limit) {}
+
+  memory_budget(const memory_budget &) = delete;
+  memory_budget &operator=(const memory_budget &) = delete;
+
+  size_t limit() const {
+    std::lock_guard<std::mutex> g(lock_);
+    return limit_;
+  }
+
+  /**
+   * @brief Sets the limit; the memory already charged stays allocated, even if it exceeds
+   *        the new limit.
+   */
+  void set_limit(size_t limit) {
+    std::lock_guard<std::mutex> g(lock_);
+    limit_ = limit;
+  }
+
+  size_t used() const {
+    std::lock_guard<std::mutex> g(lock_);
+    return used_;
+  }
+
+  size_t peak() const {
+    std::lock_guard<std::mutex> g(lock_);
+    return peak_;
+  }
+
+  /**
+   * @brief Registers a component and returns its index, used when charging the memory
+   */
+  int add_component(std::string name) {
+    std::lock_guard<std::mutex> g(lock_);
+    components_.push_back({std::move(name), 0, 0});
+    return components_.size() - 1;
+  }
+
+  /**
+   * @brief Returns the memory currently charged by each component and its high-water mark
+   */
+  std::vector<memory_budget_stat> stats() const {
+    std::lock_guard<std::mutex> g(lock_);
+    return components_;
+  }
+
+  /**
+   * @brief Adds a pressure handler and returns its id
+   */
+  int add_pressure_handler(pressure_handler handler, int priority = 0) {
+    std::lock_guard<std::mutex> g(lock_);
+    int id = next_handler_id_++;
+    handler_entry e = { priority, id, std::move(handler) };
+    auto pos = std::upper_bound(handlers_.begin(), handlers_.end(), e,
+      [](const handler_entry &a, const handler_entry &b) { return a.priority < b.priority; });
+    handlers_.insert(pos, std::move(e));
+    return id;
+  }
+
+  void remove_pressure_handler(int id) {
+    std::lock_guard<std::mutex> g(lock_);
+    handlers_.erase(std::remove_if(handlers_.begin(), handlers_.end(),
+      [id](const handler_entry &e) { return e.id == id; }), handlers_.end());
+  }
+
+  /**
+   * @brief Charges the memory to the component, provided that the limit is not exceeded.
+   */
+  bool try_charge(int component, size_t bytes) {
+    std::lock_guard<std::mutex> g(lock_);
+    if (bytes > limit_ || used_ > limit_ - bytes)
+      return false;
+    used_ += bytes;
+    peak_ = std::max(peak_, used_);
+    auto &c = components_[component];
+    c.current += bytes;
+    c.peak = std::max(c.peak, c.current);
+    return true;
+  }
+
+  /**
+   * @brief Charges the memory to the component, calling the pressure handlers if the limit
+   *        would be exceeded.
+   *
+   * @return true, if the memory was charged
+   */
+  bool charge(int component, size_t bytes) {
+    if (try_charge(component, bytes))
+      return true;
+    return relieve_pressure([&]() { return try_charge(component, bytes); });
+  }
+
+  void release(int component, size_t bytes) {
+    std::lock_guard<std::mutex> g(lock_);
+    assert(components_[component].current >= bytes && used_ >= bytes);
+    components_[component].current -= bytes;
+    used_ -= bytes;
+  }
+
+  /**
+   * @brief Calls the pressure handlers, one by one, until `retry` succeeds
+   *
+   * The handlers are not called recursively - if a handler allocates memory, the nested
+   * allocation fails without calling the handlers again.
+   *
+   * @return The result of the last call to `retry`, or false if no handler was called.
+   */
+  template <typename Retry>
+  bool relieve_pressure(Retry &&retry) {
+    static thread_local bool in_handler = false;
+    if (in_handler)
+      return false;
+    std::vector<pressure_handler> handlers;
+    {
+      std::lock_guard<std::mutex> g(lock_);
+      handlers.reserve(handlers_.size());
+      for (auto &e : handlers_)
+        handlers.push_back(e.handler);
+    }
+    for (auto &handler : handlers) {
+      in_handler = true;
+      try {
+        handler();
+      } catch (...) {
+        in_handler = false;
+        throw;
+      }
+      in_handler = false;
+      if (retry())
+        return true;
+    }
+    return false;
+  }
+
+ private:
+  struct handler_entry {
+    int priority, id;
+    pressure_handler handler;
+  };
+
+  mutable std::mutex lock_;
+  size_t limit_ = unlimited;
+  size_t used_ = 0, peak_ = 0;
+  std::vector<memory_budget_stat> components_;
+  std::vector<handler_entry> handlers_;
+  int next_handler_id_ = 0;
+};
+
+/**
+ * @brief Charges the memory allocated from the upstream resource to a memory budget.
+ *
+ * Used as the upstream of a pool. When the budget is exhausted, or the upstream runs out of
+ * memory, the pressure handlers of the budget are called before the allocation fails.
+ */
+template <typename Kind>
+class budget_resource : public memory_resource<Kind> {
+ public:
+  budget_resource(memory_resource<Kind> *upstream, memory_budget *budget, std::string component)
+  : upstream_(upstream), budget_(budget), component_(budget->add_component(std::move(component))) {}
+
+  memory_resource<Kind> *upstream() const noexcept {
+    return upstream_;
+  }
+
+  memory_budget *budget() const noexcept {
+    return budget_;
+  }
+
+ private:
+  static constexpr bool kHost = !std::is_same<Kind, memory_kind::device>::value;
+
+  void *do_allocate(size_t bytes, size_t alignment) override {
+    if (!bytes)
+      return nullptr;
+    if (!budget_->charge(component_, bytes))
+      throw CUDABadAlloc(bytes, kHost);
+    try {
+      return upstream_->allocate(bytes, alignment);
+    } catch (const std::bad_alloc &) {
+      // the system ran out of memory before the budget - the handlers may help, too
+    } catch (...) {
+      budget_->release(component_, bytes);
+      throw;
+    }
+    void *ptr = nullptr;
+    bool success = false;
+    try {
+      success = budget_->relieve_pressure([&]() {
+        try {
+          ptr = upstream_->allocate(bytes, alignment);
+          return true;
+        } catch (const std::bad_alloc &) {
+          return false;
+        }
+      });
+    } catch (...) {
+      budget_->release(component_, bytes);
+      throw;
+    }
+    if (!success) {
+      budget_->release(component_, bytes);
+      throw CUDABadAlloc(bytes, kHost);
+    }
+    return ptr;
+  }
+
+  void do_deallocate(void *ptr, size_t bytes, size_t alignment) override {
+    if (!ptr)
+      return;
+    upstream_->deallocate(ptr, bytes, alignment);
+    budget_->release(component_, bytes);
+  }
+
+  memory_resource<Kind> *upstream_;
+  memory_budget *budget_;
+  int component_;
+};
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_MEMORY_BUDGET_H_
@@ -0,0 +1,168 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef DALI_CORE_MM_MEMORY_TRACE_H_
+#define DALI_CORE_MM_MEMORY_TRACE_H_
+
+#include <cuda_runtime.h>
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+#include "dali/core/api_helper.h"
+#include "dali/core/metrics.h"
+#include "dali/core/mm/memory_kind.h"
+#include "dali/core/spinlock.h"
+
+namespace dali {
+namespace mm {
+
+/**
+ * @brief An allocation or a deallocation recorded by the allocation tracer
+ */
+struct alloc_trace_event {
+  enum event_type : uint8_t {
+    alloc = 0,
+    free = 1,
+  };
+
+  static constexpr int kMaxOwnerLength = 47;
+
+  /// Nanoseconds since the start of the trace
+  int64_t timestamp;
+  const void *ptr;
+  size_t size;
+  /// The stream of a stream-ordered (de)allocation; `AccessOrder::host_sync_stream()` otherwise
+  cudaStream_t stream;
+  memory_kind_id kind;
+  event_type type;
+  /// The name of the operator which made the (de)allocation, if known; truncated
+  char owner[kMaxOwnerLength + 1];
+};
+
+/**
+ * @brief Records the allocations made with the functions from `memory.h` (and, therefore,
+ *        the DALI buffers) in a ring buffer.
+ *
+ * When the tracing is not enabled, the only overhead is the check of an atomic flag.
+ * The trace can be dumped in the Chrome trace event format, with an instant event per
+ * (de)allocation and a counter of the traced memory in use per memory kind.
+ */
+class DLL_PUBLIC alloc_tracer {
+ public:
+  static constexpr size_t kDefaultCapacity = 1 << 16;
+
+  static alloc_tracer &instance();
+
+  static bool enabled() noexcept {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Clears the trace and starts recording
+   *
+   * @param capacity The number of the events kept; when exceeded, the oldest ones are dropped.
+   */
+  void start(size_t capacity = kDefaultCapacity);
+
+  void stop();
+
+  void record(alloc_trace_event::event_type type, memory_kind_id kind,
+              const void *ptr, size_t size, cudaStream_t stream);
+
+  /**
+   * @brief Returns the recorded events, oldest first
+   */
+  std::vector<alloc_trace_event> events() const;
+
+  /**
+   * @brief The number of the events dropped because the ring buffer was full
+   */
+  size_t dropped() const;
+
+  /**
+   * @brief Writes the trace as Chrome trace event JSON (chrome://tracing, Perfetto)
+   */
+  void write_chrome_trace(std::ostream &os) const;
+
+ private:
+  alloc_tracer() = default;
+
+  static std::atomic<bool> enabled_;
+
+  mutable spinlock lock_;
+  std::vector<alloc_trace_event> ring_;
+  size_t next_ = 0, total_ = 0;
+  int64_t start_time_ = 0;
+};
+
+/**
+ * @brief Attributes the allocations made by the calling thread in the scope to an owner
+ *        (e.g. an operator) in the allocation trace.
+ *
+ * The name must outlive the scope. When the tracing is not enabled, this is a no-op.
+ */
+class DLL_PUBLIC alloc_trace_owner {
+ public:
+  explicit alloc_trace_owner(const char *name) noexcept {
+    if (alloc_tracer::enabled()) {
+      active_ = true;
+      prev_ = current();
+      current() = name;
+    }
+  }
+
+  ~alloc_trace_owner() {
+    if (active_)
+      current() = prev_;
+  }
+
+  alloc_trace_owner(const alloc_trace_owner &) = delete;
+  alloc_trace_owner &operator=(const alloc_trace_owner &) = delete;
+
+  /// The owner of the allocations made by the calling thread; null if unknown
+  static const char *&current() noexcept;
+
+ private:
+  bool active_ = false;
+  const char *prev_ = nullptr;
+};
+
+/**
+ * @brief The gauge (`dali_memory_allocated_bytes`) of the memory of the given kind, allocated
+ *        with the functions from `memory.h`; updated regardless of the tracing.
+ */
+DLL_PUBLIC metrics::Counter &allocated_memory_metric(memory_kind_id kind);
+
+template <typename Kind>
+inline void trace_alloc(const void *ptr, size_t size, cudaStream_t stream) {
+  static metrics::Counter &allocated = allocated_memory_metric(kind2id_v<Kind>);
+  allocated.Add(size);
+  if (alloc_tracer::enabled())
+    alloc_tracer::instance().record(alloc_trace_event::alloc, kind2id_v<Kind>, ptr, size, stream);
+}
+
+template <typename Kind>
+inline void trace_free(const void *ptr, size_t size, cudaStream_t stream) {
+  static metrics::Counter &allocated = allocated_memory_metric(kind2id_v<Kind>);
+  allocated.Add(-static_cast<int64_t>(size));
+  if (alloc_tracer::enabled())
+    alloc_tracer::instance().record(alloc_trace_event::free, kind2id_v<Kind>, ptr, size, stream);
+}
+
+}  // namespace mm
+}  // namespace dali
+
+#endif  // DALI_CORE_MM_MEMORY_TRACE_H_
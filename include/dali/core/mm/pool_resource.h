@@ -15,11 +15,14 @@
 #ifndef DALI_CORE_MM_POOL_RESOURCE_H_
 #define DALI_CORE_MM_POOL_RESOURCE_H_
 
+#include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
 #include "dali/core/mm/memory_resource.h"
 #include "dali/core/mm/detail/free_list.h"
 #include "dali/core/small_vector.h"
+#include "dali/core/call_at_exit.h"
 #include "dali/core/device_guard.h"
 #include "dali/core/util.h"
 
@@ -131,6 +134,32 @@ class pool_resource_base : public memory_resource<Kind> {
     }
   }
 
+  /**
+   * @brief Returns the upstream blocks which are completely free to the upstream resource.
+   *
+   * If an upstream allocation is in progress, nothing is released - if the upstream allocation
+   * fails, the pool returns the free blocks itself (see `return_to_upstream_on_failure`).
+   *
+   * @return The number of bytes returned to the upstream resource.
+   */
+  size_t release_unused() {
+    if (upstream_owner_ == std::this_thread::get_id())
+      return 0;  // called from within an upstream allocation made by this pool
+    std::unique_lock<std::mutex> uguard(upstream_lock_, std::try_to_lock);
+    if (!uguard.owns_lock())
+      return 0;
+    return return_free_blocks();
+  }
+
+  /**
+   * @brief Returns the statistics of the free memory in the pool - e.g. to assess
+   *        its fragmentation
+   */
+  free_list_stats free_stats() {
+    lock_guard guard(lock_);
+    return free_list_.stats();
+  }
+
   constexpr const pool_options &options() const noexcept {
     return options_;
   }
@@ -144,6 +173,8 @@ class pool_resource_base : public memory_resource<Kind> {
       return ptr;
 
     upstream_lock_guard uguard(upstream_lock_);
+    upstream_owner_ = std::this_thread::get_id();
+    auto reset_owner = AtScopeExit([&]() { upstream_owner_ = std::thread::id(); });
     // try again to avoid upstream allocation stampede
     if (void *ptr = try_allocate_from_free(bytes, alignment))
       return ptr;
@@ -207,29 +238,8 @@ class pool_resource_base : public memory_resource<Kind> {
           // (the free list covers them completely), we can try to return them
           // to the upstream, with the hope that it will reorganize and succeed in
           // the subsequent allocation attempt.
-          int blocks_freed = 0;
-          SmallVector<bool, 32> removed;
-          removed.resize(blocks_.size(), false);
-          {
-            lock_guard guard(lock_);
-            for (int i = 0; i < static_cast<int>(blocks_.size()); i++) {
-              UpstreamBlock blk = blocks_[i];
-              removed[i] = free_list_.remove_if_in_list(blk.ptr, blk.bytes);
-              if (removed[i])
-                blocks_freed++;
-            }
-          }
-
-          if (!blocks_freed)
+          if (!return_free_blocks())
             throw;  // we freed nothing, so there's no point in retrying to allocate
-
-          for (int i = blocks_.size() - 1; i >= 0; i--) {
-            if (removed[i]) {
-              UpstreamBlock blk = blocks_[i];
-              upstream_->deallocate(blk.ptr, blk.bytes, blk.alignment);
-              blocks_.erase_at(i);
-            }
-          }
           // mark that we've tried, so we can fail fast the next time
           tried_return_to_upstream = true;
         }
@@ -249,6 +259,37 @@ class pool_resource_base : public memory_resource<Kind> {
     return new_block;
   }
 
+  /**
+   * @brief Returns the upstream blocks which are completely free to the upstream resource.
+   *
+   * The caller must hold `upstream_lock_`.
+   *
+   * @return The number of bytes returned.
+   */
+  size_t return_free_blocks() {
+    size_t bytes_freed = 0;
+    SmallVector<bool, 32> removed;
+    removed.resize(blocks_.size(), false);
+    {
+      lock_guard guard(lock_);
+      for (int i = 0; i < static_cast<int>(blocks_.size()); i++) {
+        UpstreamBlock blk = blocks_[i];
+        removed[i] = free_list_.remove_if_in_list(blk.ptr, blk.bytes);
+        if (removed[i])
+          bytes_freed += blk.bytes;
+      }
+    }
+
+    for (int i = blocks_.size() - 1; i >= 0; i--) {
+      if (removed[i]) {
+        UpstreamBlock blk = blocks_[i];
+        upstream_->deallocate(blk.ptr, blk.bytes, blk.alignment);
+        blocks_.erase_at(i);
+      }
+    }
+    return bytes_freed;
+  }
+
   size_t next_block_size(size_t upcoming_allocation_size) {
     size_t actual_block_size = std::max<size_t>(upcoming_allocation_size,
                                                 next_block_size_ * options_.growth_factor);
@@ -272,6 +313,8 @@ class pool_resource_base : public memory_resource<Kind> {
 
   // locking order: upstream_lock_, lock_
   std::mutex upstream_lock_;
+  /// The thread which allocates from the upstream while holding `upstream_lock_`
+  std::atomic<std::thread::id> upstream_owner_{};
   LockType lock_;
   pool_options options_;
   size_t next_block_size_ = 0;
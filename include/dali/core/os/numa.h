@@ -0,0 +1,72 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_OS_NUMA_H_
+#define DALI_CORE_OS_NUMA_H_
+
+#include "dali/core/api_helper.h"
+
+namespace dali {
+namespace numa {
+
+/**
+ * @brief Returns the number of NUMA nodes in the system; 1 if the system is not NUMA
+ *        or the topology can't be obtained.
+ */
+DLL_PUBLIC int NumNodes();
+
+/**
+ * @brief Returns the NUMA node to which the PCIe root of the CUDA device is attached,
+ *        or -1 if it's not known.
+ */
+DLL_PUBLIC int DeviceNode(int device_id);
+
+/**
+ * @brief Makes the calling thread allocate memory preferably from the given NUMA node.
+ *
+ * If the node runs out of memory, the memory is allocated from the other nodes.
+ * A negative node restores the default (local) policy.
+ *
+ * @return true, if the policy was set
+ */
+DLL_PUBLIC bool SetPreferredNode(int node);
+
+/**
+ * @brief Makes the calling thread allocate memory preferably from the given NUMA node
+ *        for the lifetime of the object and then restores the previous policy.
+ *
+ * Used to place the pages of the memory allocated (and pinned) by the CUDA runtime
+ * on a specific node. A negative node leaves the policy unchanged.
+ */
+class DLL_PUBLIC PreferredNodeScope {
+ public:
+  explicit PreferredNodeScope(int node);
+  ~PreferredNodeScope();
+
+  PreferredNodeScope(const PreferredNodeScope &) = delete;
+  PreferredNodeScope &operator=(const PreferredNodeScope &) = delete;
+
+ private:
+  static constexpr int kMaxNodes = 1024;
+  static constexpr int kMaskWords = kMaxNodes / (8 * sizeof(unsigned long));  // NOLINT
+
+  bool active_ = false;
+  int prev_mode_ = 0;
+  unsigned long prev_mask_[kMaskWords] = {};  // NOLINT
+};
+
+}  // namespace numa
+}  // namespace dali
+
+#endif  // DALI_CORE_OS_NUMA_H_
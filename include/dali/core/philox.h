@@ -0,0 +1,120 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_PHILOX_H_
+#define DALI_CORE_PHILOX_H_
+
+#include <cstdint>
+#include "dali/core/force_inline.h"
+#include "dali/core/host_dev.h"
+#include "dali/core/int_literals.h"
+
+namespace dali {
+
+/**
+ * @brief A step of the SplitMix64 generator - used for mixing seeds into keys
+ */
+DALI_HOST_DEV constexpr uint64_t splitmix64(uint64_t x) {
+  x += 0x9E3779B97F4A7C15_u64;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9_u64;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EB_u64;
+  return x ^ (x >> 31);
+}
+
+/**
+ * @brief Counter-based Philox4x32-10 random number generator
+ *
+ * The generator has no state other than a 64-bit key and a 128-bit counter, so it's cheap to
+ * construct - it can be created for each element of a tensor, on the host or on the device,
+ * and produces the same sequence on both. The upper half of the counter is the subsequence
+ * - e.g. the index of the element - and the lower half is advanced as the numbers are drawn.
+ *
+ * The generator satisfies the UniformRandomBitGenerator requirements, so it can be used
+ * with `std::` distributions - though these are not guaranteed to give the same results
+ * on the host and on the device.
+ */
+class Philox4x32_10 {
+ public:
+  using result_type = uint32_t;
+
+  DALI_HOST_DEV Philox4x32_10(uint64_t key, uint64_t subsequence, uint64_t offset = 0)
+      : key_{static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32)},
+        counter_{static_cast<uint32_t>(offset), static_cast<uint32_t>(offset >> 32),
+                 static_cast<uint32_t>(subsequence), static_cast<uint32_t>(subsequence >> 32)} {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+  /**
+   * @brief Returns the next 32 random bits
+   */
+  DALI_HOST_DEV DALI_FORCEINLINE uint32_t operator()() {
+    if (idx_ == 4) {
+      Block(out_, counter_, key_);
+      if (++counter_[0] == 0)
+        ++counter_[1];
+      idx_ = 0;
+    }
+    return out_[idx_++];
+  }
+
+  /**
+   * @brief Computes one block (4 words) of the output for given counter and key
+   */
+  DALI_HOST_DEV static void Block(uint32_t (&out)[4], const uint32_t (&counter)[4],
+                                  const uint32_t (&key)[2]) {
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int r = 0; r < 10; r++) {
+      uint32_t hi0, lo0, hi1, lo1;
+      MulHiLo(kM0, c0, hi0, lo0);
+      MulHiLo(kM1, c2, hi1, lo1);
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+      k0 += kW0;
+      k1 += kW1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+  }
+
+ private:
+  static constexpr uint32_t kM0 = 0xD2511F53u, kM1 = 0xCD9E8D57u;
+  static constexpr uint32_t kW0 = 0x9E3779B9u, kW1 = 0xBB67AE85u;
+
+  DALI_HOST_DEV DALI_FORCEINLINE static void MulHiLo(uint32_t a, uint32_t b,
+                                                    uint32_t &hi, uint32_t &lo) {
+  #ifdef __CUDA_ARCH__
+    hi = __umulhi(a, b);
+    lo = a * b;
+  #else
+    uint64_t product = static_cast<uint64_t>(a) * b;
+    hi = static_cast<uint32_t>(product >> 32);
+    lo = static_cast<uint32_t>(product);
+  #endif
+  }
+
+  uint32_t key_[2];
+  uint32_t counter_[4];
+  uint32_t out_[4] = {};
+  int idx_ = 4;
+};
+
+}  // namespace dali
+
+#endif  // DALI_CORE_PHILOX_H_
@@ -0,0 +1,292 @@
+// Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DALI_CORE_TRACE_H_
+#define DALI_CORE_TRACE_H_
+
+#include <cuda_runtime_api.h>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iosfwd>
+#include <string>
+#include "dali/core/api_helper.h"
+#include "dali/core/nvtx.h"
+
+namespace dali {
+
+/**
+ * @brief The kinds of the traced events
+ *
+ * The identifiers are compile-time constants, so that recording an event doesn't involve
+ * building its name. New events are added before `Count`, with an entry in `kTraceEventInfo`.
+ */
+enum class TraceEvent : uint16_t {
+  // executor
+  ExecutorRunCPU,
+  ExecutorRunMixed,
+  ExecutorRunGPU,
+  CPUOp,
+  MixedOp,
+  GPUOp,
+  MixedOpDevice,
+  GPUOpDevice,
+  // thread pool
+  ThreadPoolTask,
+  // readers
+  ReaderPrefetch,
+  ReaderRun,
+  ReaderConsumerWait,
+  LoaderReadOne,
+  LoaderFillBuffer,
+  // decoders
+  DecoderParse,
+  DecoderHost,
+  DecoderCuda,
+  DecoderHw,
+  DecoderHwDevice,
+  Count
+};
+
+struct TraceEventInfo {
+  const char *name;
+  const char *category;
+  uint32_t rgb;  ///< the color of the NVTX range
+};
+
+constexpr TraceEventInfo kTraceEventInfo[] = {
+  {"RunCPU", "executor", RangeBase::kBlue},
+  {"RunMixed", "executor", RangeBase::kBlue},
+  {"RunGPU", "executor", RangeBase::kBlue},
+  {"CPU op", "operator", RangeBase::kBlue1},
+  {"Mixed op", "operator", RangeBase::kOrange},
+  {"GPU op", "operator", RangeBase::knvGreen},
+  {"Mixed op (device)", "cuda", RangeBase::kOrange},
+  {"GPU op (device)", "cuda", RangeBase::knvGreen},
+  {"Task", "thread_pool", RangeBase::kCyan},
+  {"Prefetch", "reader", RangeBase::kRed},
+  {"Run", "reader", RangeBase::kViolet},
+  {"ConsumerWait", "reader", RangeBase::kMagenta},
+  {"ReadOne", "reader", RangeBase::kGreen1},
+  {"Filling initial buffer", "reader", RangeBase::kBlue1},
+  {"Parse", "decoder", RangeBase::kYellow},
+  {"Host decode", "decoder", RangeBase::kBlue1},
+  {"CUDA decode", "decoder", RangeBase::knvGreen},
+  {"HW decode", "decoder", RangeBase::kOrange},
+  {"HW decode (device)", "cuda", RangeBase::kOrange},
+};
+
+static_assert(sizeof(kTraceEventInfo) / sizeof(kTraceEventInfo[0]) ==
+              static_cast<size_t>(TraceEvent::Count),
+              "Each TraceEvent must have its info");
+
+constexpr const TraceEventInfo &GetTraceEventInfo(TraceEvent event) {
+  return kTraceEventInfo[static_cast<int>(event)];
+}
+
+/**
+ * @brief A traced range, as stored in the per-thread buffers
+ */
+struct TraceRecord {
+  /// Host steady clock, in nanoseconds; for device ranges, filled when the trace is exported
+  int64_t begin_ns, end_ns;
+  /// An event-specific number (e.g. an iteration or a sample index); negative if none
+  int64_t arg;
+  /// An interned string (see `Tracer::Intern`), e.g. an operator name; may be null
+  const char *detail;
+  /// For device ranges - the stream and the timing events recorded in it
+  cudaStream_t stream;
+  cudaEvent_t begin_event, end_event;
+  int device_id;  ///< negative for host ranges
+  TraceEvent event;
+};
+
+/**
+ * @brief Records the traced ranges of the calling threads and exports them as Chrome trace
+ *        event JSON (chrome://tracing, Perfetto).
+ *
+ * Each thread appends to its own buffer without locking; a buffer is registered once, when
+ * the thread records its first event. When the tracing is not enabled, a traced scope costs
+ * a check of an atomic flag.
+ *
+ * The tracing is enabled with `Start` or, for the whole process, by setting the
+ * `DALI_TRACE_FILE` environment variable to the path where the trace is written at exit.
+ *
+ * Device ranges are measured with CUDA events, which are resolved when the trace is exported.
+ * The first device range on each device synchronizes with its stream once, to align the device
+ * timeline with the host clock.
+ */
+class DLL_PUBLIC Tracer {
+ public:
+  /// The default limit of the events recorded by a thread
+  static constexpr int64_t kDefaultMaxThreadEvents = 1 << 20;
+
+  static Tracer &instance();
+
+  static bool enabled() noexcept {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  static int64_t now_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  /**
+   * @brief Discards the recorded events and starts recording
+   *
+   * @param max_thread_events  the number of events recorded by each thread, after which
+   *                           the events are dropped
+   */
+  void Start(int64_t max_thread_events = kDefaultMaxThreadEvents);
+
+  void Stop();
+
+  /**
+   * @brief Writes the events recorded since the last `Start` as Chrome trace event JSON
+   *
+   * The trace can be exported while still recording; the events recorded concurrently
+   * may or may not be included.
+   */
+  void WriteChromeTrace(std::ostream &os);
+
+  /**
+   * @brief Returns a pointer to a copy of the string, valid for the lifetime of the process
+   *
+   * The traced names are interned once (e.g. when an operator is instantiated), so that
+   * the records can point to them without copying.
+   */
+  const char *Intern(const std::string &str);
+
+  /// The number of events dropped because a thread buffer was full
+  int64_t dropped() const;
+
+  /// Records a range in the buffer of the calling thread
+  void Record(const TraceRecord &record);
+
+  /// The name of the calling thread in the trace (see `SetThreadName`)
+  void SetThreadName(const char *name);
+
+  /// Records the beginning of a device range in `stream`; returns false if not possible
+  bool BeginDeviceRange(TraceRecord &record, cudaStream_t stream);
+
+  void EndDeviceRange(TraceRecord &record) noexcept;
+
+ private:
+  Tracer();
+  ~Tracer();
+
+  static std::atomic<bool> enabled_;
+
+  class Impl;
+  Impl *impl_;
+};
+
+/**
+ * @brief Traces the execution of a scope on the host
+ *
+ * With NVTX enabled, the scope is also an NVTX range in the DALI domain; its message is
+ * formatted in a buffer on the stack, without allocating.
+ */
+class TraceScope {
+ public:
+  explicit TraceScope(TraceEvent event, int64_t arg = -1, const char *detail = nullptr)
+#if NVTX_ENABLED
+      : nvtx_(FormatNvtxName(nvtx_name_, event, arg, detail),
+              GetTraceEventInfo(event).rgb)
+#endif
+  {  // NOLINT
+    if (Tracer::enabled()) {
+      record_.begin_ns = Tracer::now_ns();
+      record_.arg = arg;
+      record_.detail = detail;
+      record_.event = event;
+    }
+  }
+
+  ~TraceScope() {
+    if (record_.begin_ns >= 0) {
+      record_.end_ns = Tracer::now_ns();
+      Tracer::instance().Record(record_);
+    }
+  }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+ private:
+#if NVTX_ENABLED
+  static const char *FormatNvtxName(char (&buf)[128], TraceEvent event, int64_t arg,
+                                    const char *detail) {
+    const auto &info = GetTraceEventInfo(event);
+    if (arg >= 0)
+      snprintf(buf, sizeof(buf), "[DALI][%s] %s%s%s #%lld", info.category, info.name,
+               detail ? " " : "", detail ? detail : "", static_cast<long long>(arg));  // NOLINT
+    else
+      snprintf(buf, sizeof(buf), "[DALI][%s] %s%s%s", info.category, info.name,
+               detail ? " " : "", detail ? detail : "");
+    return buf;
+  }
+
+  char nvtx_name_[128];
+  DomainTimeRange nvtx_;
+#endif
+  TraceRecord record_{-1, -1, -1, nullptr, 0, nullptr, nullptr, -1, TraceEvent::Count};
+};
+
+/**
+ * @brief Traces the execution of the work issued to a stream in the scope
+ *
+ * The time is measured with CUDA events recorded in the stream at the beginning and at the
+ * end of the scope.
+ */
+class TraceDeviceScope {
+ public:
+  TraceDeviceScope() = default;
+
+  TraceDeviceScope(TraceEvent event, cudaStream_t stream, int64_t arg = -1,
+                   const char *detail = nullptr) {
+    Start(event, stream, arg, detail);
+  }
+
+  /// Starts the range in a default-constructed scope, e.g. when the stream is optional
+  void Start(TraceEvent event, cudaStream_t stream, int64_t arg = -1,
+             const char *detail = nullptr) {
+    assert(!active_);
+    if (Tracer::enabled()) {
+      record_.arg = arg;
+      record_.detail = detail;
+      record_.event = event;
+      active_ = Tracer::instance().BeginDeviceRange(record_, stream);
+    }
+  }
+
+  ~TraceDeviceScope() {
+    if (active_)
+      Tracer::instance().EndDeviceRange(record_);
+  }
+
+  TraceDeviceScope(const TraceDeviceScope &) = delete;
+  TraceDeviceScope &operator=(const TraceDeviceScope &) = delete;
+
+ private:
+  bool active_ = false;
+  TraceRecord record_{-1, -1, -1, nullptr, 0, nullptr, nullptr, -1, TraceEvent::Count};
+};
+
+}  // namespace dali
+
+#endif  // DALI_CORE_TRACE_H_
@@ -22,6 +22,7 @@
 #include <string>
 #include <vector>
 #include "dali/core/any.h"
+#include "dali/core/small_vector.h"
 #include "dali/core/span.h"
 #include "dali/core/tensor_shape.h"
 #include "dali/imgcodec/image_format.h"
@@ -39,6 +40,26 @@ struct DecodeParams {
   DALIImageType format  = DALI_RGB;
   bool          planar  = false;
   bool          use_orientation = true;
+  /**
+   * @brief Per-channel normalization of the output: (value - mean) / stddev
+   *
+   * The values are in the dynamic range of `dtype` ([0, 1] for floating point types).
+   * An empty vector means no normalization, a single value applies to all the channels.
+   * Requires a floating point `dtype`.
+   */
+  SmallVector<float, 4> mean, stddev;
+  /** @brief Flips the output horizontally */
+  bool          mirror  = false;
+
+  /**
+   * @brief Whether the output needs more than the type and color space conversion
+   *
+   * The planar layout, normalization and mirroring are only supported for GPU outputs,
+   * where they are fused with the conversion.
+   */
+  bool needs_postprocessing() const {
+    return planar || mirror || !mean.empty() || !stddev.empty();
+  }
 };
 
 /**
@@ -83,6 +83,11 @@ class DLL_PUBLIC ImageFormat {
    */
   span<ImageDecoderFactory *const> Decoders() const;
 
+  /**
+   * @brief Returns the priorities of the decoders, in the order of Decoders()
+   */
+  span<const float> DecoderPriorities() const;
+
   /**
    * @brief Registers a new decoder associated with this format, with a set priority
    *
@@ -99,6 +104,7 @@ class DLL_PUBLIC ImageFormat {
   std::shared_ptr<ImageParser> parser_;
   std::multimap<float, std::shared_ptr<ImageDecoderFactory>> decoders_;
   std::vector<ImageDecoderFactory*> decoder_ptrs_;
+  std::vector<float> decoder_priorities_;
 };
 
 class DLL_PUBLIC ImageFormatRegistry {
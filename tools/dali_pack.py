@@ -0,0 +1,206 @@
+#!/usr/bin/python3
+# Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import argparse
+import io
+import os
+import struct
+import time
+
+# The layout of the packed dataset, read with `fn.readers.packed`:
+#  - the data file holds the samples, each starting at a multiple of the alignment (so that
+#    a sample can be read with O_DIRECT or GPUDirect Storage) and padded with zeros up to
+#    the next one; a sample is a 32-byte header followed by the contents of the file;
+#  - the index file has the header line "DALI_PACKED v1 <alignment> <number of samples>" and
+#    a line "<offset> <size> <label>" per sample, where the size includes the sample header.
+SAMPLE_MAGIC = 0x314b5044  # "DPK1"
+SAMPLE_HEADER = struct.Struct("<IiIII12x")  # magic, label, height, width, channels, reserved
+INDEX_MAGIC = "DALI_PACKED"
+INDEX_VERSION = "v1"
+
+# the same as in `fn.readers.file`
+IMAGE_EXTENSIONS = (".jpg", ".jpeg", ".png", ".bmp", ".tif", ".tiff", ".pnm", ".ppm", ".pgm",
+                    ".pbm", ".jp2", ".webp")
+
+
+def list_file_root(file_root):
+    """Lists the images in the subdirectories of `file_root`, like `fn.readers.file` does:
+    the label of an image is the index of its subdirectory, in the alphabetical order."""
+    classes = sorted(d for d in os.listdir(file_root)
+                     if os.path.isdir(os.path.join(file_root, d)))
+    samples = []
+    for label, cls in enumerate(classes):
+        for root, _, files in os.walk(os.path.join(file_root, cls)):
+            for name in files:
+                if name.lower().endswith(IMAGE_EXTENSIONS):
+                    samples.append((os.path.join(root, name), label))
+    samples.sort()
+    return samples
+
+
+def read_file_list(file_list, file_root=None):
+    """Reads the "<path> <label>" lines of a file list, as used by `fn.readers.file`"""
+    base = file_root if file_root is not None else os.path.dirname(os.path.abspath(file_list))
+    samples = []
+    with open(file_list) as f:
+        for line in f:
+            line = line.strip()
+            if not line:
+                continue
+            path, label = line.rsplit(maxsplit=1)
+            samples.append((os.path.join(base, path), int(label)))
+    return samples
+
+
+def image_shape(data):
+    """Returns the (height, width, channels) of an encoded image; zeros if it can't be read"""
+    try:
+        from PIL import Image
+        with Image.open(io.BytesIO(data)) as image:
+            width, height = image.size
+            return height, width, len(image.getbands())
+    except Exception:
+        return 0, 0, 0
+
+
+class PackWriter:
+    """Writes a data file and its index in the DALI packed format.
+
+    Example usage:
+    ----------
+    >> with PackWriter('data/train.dpk', 'data/train.idx') as writer:
+    >>     writer.add(jpeg_bytes, label)
+
+    Parameters
+    ----------
+    data_path : str
+        Path to the data file, that will be created/overwritten.
+    index_path : str
+        Path to the index file, that will be created/overwritten.
+    alignment : int
+        The alignment of the samples in the data file, in bytes.
+    """
+
+    def __init__(self, data_path, index_path, alignment=4096):
+        if alignment <= 0 or alignment % 512:
+            raise ValueError(f"The alignment must be a positive multiple of 512, got {alignment}")
+        self.index_path = index_path
+        self.alignment = alignment
+        self.entries = []
+        self.offset = 0
+        self.fdata = open(data_path, "wb")
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, exc_traceback):
+        self.close()
+
+    def add(self, data, label, shape=(0, 0, 0)):
+        """Appends a sample; `shape` is the (height, width, channels) of the image, if known"""
+        padding = -self.offset % self.alignment
+        if padding:
+            self.fdata.write(b"\0" * padding)
+            self.offset += padding
+        header = SAMPLE_HEADER.pack(SAMPLE_MAGIC, label, *shape)
+        self.fdata.write(header)
+        self.fdata.write(data)
+        size = len(header) + len(data)
+        self.entries.append((self.offset, size, label))
+        self.offset += size
+
+    def close(self):
+        """Pads the data file to the alignment and writes the index"""
+        if self.fdata.closed:
+            return
+        padding = -self.offset % self.alignment
+        self.fdata.write(b"\0" * padding)
+        self.fdata.close()
+        with open(self.index_path, "w") as fidx:
+            fidx.write(f"{INDEX_MAGIC} {INDEX_VERSION} {self.alignment} {len(self.entries)}\n")
+            for entry in self.entries:
+                fidx.write("%d %d %d\n" % entry)
+
+
+def pack(samples, output, alignment=4096, samples_per_file=None, image_info=False,
+         verbose=True):
+    """Packs the (path, label) samples into `output`.dpk and `output`.idx, or, if
+    `samples_per_file` is set, into `output`-00000.dpk, `output`-00000.idx and so on.
+
+    Returns the list of the (data file, index file) paths.
+    """
+    if samples_per_file is None:
+        parts = [("", samples)]
+    else:
+        parts = [(f"-{i // samples_per_file:05d}", samples[i:i + samples_per_file])
+                 for i in range(0, len(samples), samples_per_file)]
+    outputs = []
+    start_time = time.time()
+    count = 0
+    for suffix, part in parts:
+        data_path, index_path = output + suffix + ".dpk", output + suffix + ".idx"
+        with PackWriter(data_path, index_path, alignment) as writer:
+            for path, label in part:
+                with open(path, "rb") as f:
+                    data = f.read()
+                writer.add(data, label, image_shape(data) if image_info else (0, 0, 0))
+                count += 1
+                if verbose and count % 10000 == 0:
+                    print(f"time: {time.time() - start_time:.2f} count: {count}")
+        outputs.append((data_path, index_path))
+    if verbose:
+        print(f"time: {time.time() - start_time:.2f} count: {count} stage: done")
+    return outputs
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter,
+        description="Packs a dataset of images into the DALI packed format, "
+                    "for the use with the `fn.readers.packed`.")
+    parser.add_argument("input", help="the directory with a subdirectory per class, as used by "
+                                      "`fn.readers.file`, or a file list with \"<path> <label>\" "
+                                      "lines")
+    parser.add_argument("output", help="the prefix of the output files")
+    parser.add_argument("--file-root", help="the directory the paths in a file list are "
+                                            "relative to; by default, that of the list")
+    parser.add_argument("--alignment", type=int, default=4096,
+                        help="the alignment of the samples in the data files, in bytes")
+    parser.add_argument("--samples-per-file", type=int,
+                        help="split the dataset into files with this many samples")
+    parser.add_argument("--image-info", action="store_true",
+                        help="store the shapes of the images (requires Pillow)")
+    parser.add_argument("--shuffle", action="store_true",
+                        help="shuffle the samples before packing them, so that reading them "
+                             "in blocks (`global_shuffle`) gives a well-mixed order")
+    parser.add_argument("--seed", type=int, default=0, help="the seed of --shuffle")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    if os.path.isdir(args.input):
+        samples = list_file_root(args.input)
+    else:
+        samples = read_file_list(args.input, args.file_root)
+    if args.shuffle:
+        import random
+        random.Random(args.seed).shuffle(samples)
+    pack(samples, args.output, args.alignment, args.samples_per_file, args.image_info)
+
+
+if __name__ == "__main__":
+    main()
@@ -36,6 +36,8 @@ parser.add_argument('--height_hint', dest="height_hint", default=0, type=int)
 parser.add_argument('--hw_load', dest='hw_load',
                     help='HW decoder workload (e.g. 0.66 means 66% of the batch)', default=0.75,
                     type=float)
+parser.add_argument('--auto_hw_load', dest='auto_hw_load', action='store_true',
+                    help='tune the HW decoder workload at run time, starting from --hw_load')
 args = parser.parse_args()
 
 
@@ -47,7 +49,8 @@ def DecoderPipeline():
     device = 'mixed' if args.device == 'gpu' else 'cpu'
     jpegs, _ = fn.readers.file(file_root=args.images_dir)
     images = fn.decoders.image(jpegs, device=device, output_type=types.RGB,
-                               hw_decoder_load=args.hw_load, preallocate_width_hint=args.width_hint,
+                               hw_decoder_load=args.hw_load, auto_hw_decoder_load=args.auto_hw_load,
+                               preallocate_width_hint=args.width_hint,
                                preallocate_height_hint=args.height_hint)
     return images
 
@@ -61,6 +64,7 @@ def RN50Pipeline():
     jpegs, _ = fn.readers.file(file_root=args.images_dir)
     images = fn.decoders.image_random_crop(jpegs, device=device, output_type=types.RGB,
                                            hw_decoder_load=args.hw_load,
+                                           auto_hw_decoder_load=args.auto_hw_load,
                                            preallocate_width_hint=args.width_hint,
                                            preallocate_height_hint=args.height_hint)
     images = fn.resize(images, resize_x=224, resize_y=224)